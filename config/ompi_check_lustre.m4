@@ -90,6 +90,16 @@ EOF
             rm -f conftest.c conftest.o
             AC_MSG_RESULT([$ompi_check_lustre_struct_happy])])
 
+    # optional, composite (PFL) layouts and number of OSTs
+    AS_IF([test "$ompi_check_lustre_happy" = "yes"],
+          [CPPFLAGS="$CPPFLAGS $$1_CPPFLAGS"
+           LDFLAGS="$LDFLAGS $$1_LDFLAGS"
+           LIBS="$LIBS $$1_LIBS"
+           AC_CHECK_FUNCS([llapi_layout_comp_add llapi_get_obd_count])
+           CPPFLAGS="$check_lustre_save_CPPFLAGS"
+           LDFLAGS="$check_lustre_save_LDFLAGS"
+           LIBS="$check_lustre_save_LIBS"])
+
     AS_IF([test "$ompi_check_lustre_happy" = "yes"],
           [$2],
           [AS_IF([test -n "$with_lustre" && test "$with_lustre" != "no"],
@@ -52,6 +52,8 @@ AC_DEFUN([OMPI_CHECK_UCC],[
                      LDFLAGS=$coll_ucc_LDFLAGS
                      LIBS=$coll_ucc_LIBS
                      AC_CHECK_FUNCS(ucc_comm_free, [], [])
+                     AC_CHECK_DECLS([UCC_COLL_ARGS_FLAG_PERSISTENT], [], [],
+                                    [[#include <ucc/api/ucc.h>]])
                  ],
                  [])
 
@@ -66,8 +66,8 @@ AC_DEFINE_UNQUOTED([OMPI_WANT_MPI_INTERFACE_WARNING], [$OMPI_WANT_MPI_INTERFACE_
 AC_MSG_CHECKING([if want sparse process groups])
 AC_ARG_ENABLE([sparse-groups],
     [AS_HELP_STRING([--enable-sparse-groups],
-                   [enable sparse process groups (default: not enabled)])])
-if test "$enable_sparse_groups" = "yes"; then
+                   [enable sparse process groups (default: enabled)])])
+if test "$enable_sparse_groups" != "no"; then
     AC_MSG_RESULT([yes])
     GROUP_SPARSE=1
 else
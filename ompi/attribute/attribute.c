@@ -2,7 +2,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2014 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -231,6 +231,8 @@
 
 #include "ompi_config.h"
 
+#include <stdio.h>
+
 #include "opal/class/opal_bitmap.h"
 #include "opal/mca/threads/mutex.h"
 #include "opal/sys/atomic.h"
@@ -248,6 +250,10 @@
 
 #define ATTR_TABLE_SIZE 10
 
+/* number of keyvals with an inline slot on each object, keyvals are
+   allocated from 0 so the predefined ones and the first user ones fit */
+#define ATTR_INLINE_KEYS 64
+
 /* This is done so that I can have a consistent interface to my macros
    here */
 
@@ -406,6 +412,29 @@ typedef struct attribute_value_t {
     int av_sequence;
 } attribute_value_t;
 
+/*
+ * Translated values of an attribute, in an inline slot of the object
+ */
+typedef struct attribute_inline_t {
+    void *ai_c;
+    MPI_Aint ai_aint;
+    MPI_Fint ai_fint;
+    int ai_set;
+} attribute_inline_t;
+
+/*
+ * The attribute hash of an object. The attributes of the low keyvals are
+ * mirrored in an inline array that the get functions read without the
+ * attribute_lock, under a sequence lock: the writers (which all hold the
+ * attribute_lock) make ah_seq odd while they update a slot, a reader that
+ * sees ah_seq odd or changed retries with the lock.
+ */
+typedef struct ompi_attr_hash_t {
+    opal_hash_table_t super;
+    opal_atomic_int32_t ah_seq;
+    attribute_inline_t ah_inline[ATTR_INLINE_KEYS];
+} ompi_attr_hash_t;
+
 
 /*
  * Local functions
@@ -425,6 +454,12 @@ static MPI_Aint translate_to_aint(attribute_value_t *val);
 
 static int compare_attr_sequence(const void *attr1, const void *attr2);
 
+static void ompi_attr_hash_construct(ompi_attr_hash_t *hash);
+static void attr_inline_update(opal_hash_table_t *attr_hash, int key,
+                               attribute_value_t *attr);
+static bool attr_inline_get(opal_hash_table_t *attr_hash, int key,
+                            attribute_inline_t *value);
+
 
 /*
  * attribute_value_t class
@@ -435,6 +470,15 @@ static OBJ_CLASS_INSTANCE(attribute_value_t,
                           NULL);
 
 
+/*
+ * ompi_attr_hash_t class
+ */
+static OBJ_CLASS_INSTANCE(ompi_attr_hash_t,
+                          opal_hash_table_t,
+                          ompi_attr_hash_construct,
+                          NULL);
+
+
 /*
  * ompi_attribute_entry_t classes
  */
@@ -458,6 +502,8 @@ static unsigned int integer_pos = 12345;
  * MPI attributes are *not* high performance, so just use a One Big Lock
  * approach. However, this lock is released before a user provided callback is
  * triggered and acquired right after, allowing for recursive behaviors.
+ * The gets of the attributes found in the inline slots of an object don't
+ * take it (see ompi_attr_hash_t).
  */
 static opal_mutex_t attribute_lock;
 
@@ -476,6 +522,31 @@ static void attribute_value_construct(attribute_value_t *item)
 }
 
 
+/*
+ * ompi_attr_hash_t constructor function
+ */
+static void ompi_attr_hash_construct(ompi_attr_hash_t *hash)
+{
+    hash->ah_seq = 0;
+    memset(hash->ah_inline, 0, sizeof(hash->ah_inline));
+}
+
+
+int ompi_attr_hash_init(opal_hash_table_t **hash)
+{
+    *hash = (opal_hash_table_t *) OBJ_NEW(ompi_attr_hash_t);
+    if (NULL == *hash) {
+        fprintf(stderr, "Error while creating the local attribute list\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    if (OMPI_SUCCESS != opal_hash_table_init(*hash, ATTR_HASH_SIZE)) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    return MPI_SUCCESS;
+}
+
+
 /*
  * ompi_attribute_keyval_t constructor / destructor
  */
@@ -845,8 +916,15 @@ int ompi_attr_get_c(opal_hash_table_t *attr_hash, int key,
                     void **attribute, int *flag)
 {
     attribute_value_t *val = NULL;
+    attribute_inline_t value;
     int ret;
 
+    if (attr_inline_get(attr_hash, key, &value)) {
+        *attribute = value.ai_c;
+        *flag = 1;
+        return MPI_SUCCESS;
+    }
+
     OPAL_THREAD_LOCK(&attribute_lock);
 
     ret = get_value(attr_hash, key, &val, flag);
@@ -868,8 +946,15 @@ int ompi_attr_get_fint(opal_hash_table_t *attr_hash, int key,
                        MPI_Fint *attribute, int *flag)
 {
     attribute_value_t *val = NULL;
+    attribute_inline_t value;
     int ret;
 
+    if (attr_inline_get(attr_hash, key, &value)) {
+        *attribute = value.ai_fint;
+        *flag = 1;
+        return MPI_SUCCESS;
+    }
+
     OPAL_THREAD_LOCK(&attribute_lock);
 
     ret = get_value(attr_hash, key, &val, flag);
@@ -891,8 +976,15 @@ int ompi_attr_get_aint(opal_hash_table_t *attr_hash, int key,
                        MPI_Aint *attribute, int *flag)
 {
     attribute_value_t *val = NULL;
+    attribute_inline_t value;
     int ret;
 
+    if (attr_inline_get(attr_hash, key, &value)) {
+        *attribute = value.ai_aint;
+        *flag = 1;
+        return MPI_SUCCESS;
+    }
+
     OPAL_THREAD_LOCK(&attribute_lock);
 
     ret = get_value(attr_hash, key, &val, flag);
@@ -1083,6 +1175,7 @@ static int ompi_attr_delete_impl(ompi_attribute_type_t type, void *object,
         /* Ignore the return value at this point; it can't help any
            more */
         (void) opal_hash_table_remove_value_uint32(attr_hash, key);
+        attr_inline_update(attr_hash, key, NULL);
         OBJ_RELEASE(attr);
     }
 
@@ -1238,6 +1331,7 @@ static int set_value(ompi_attribute_type_t type, void *object,
         if (MPI_SUCCESS != ret) {
             return ret;
         }
+        attr_inline_update(*attr_hash, key, NULL);
         OBJ_RELEASE(old_attr);
         had_old = true;
     }
@@ -1255,6 +1349,7 @@ static int set_value(ompi_attribute_type_t type, void *object,
     new_attr->av_sequence = attr_sequence++;
 
     ret = opal_hash_table_set_value_uint32(*attr_hash, key, new_attr);
+    attr_inline_update(*attr_hash, key, (OMPI_SUCCESS == ret) ? new_attr : NULL);
 
     /* Increase the reference count of the object, only if there was no
        old atribute/no old entry in the object's key hash */
@@ -1412,6 +1507,64 @@ static MPI_Aint translate_to_aint(attribute_value_t *val)
     }
 }
 
+/*
+ * Mirror the attribute of key (NULL if it was deleted) in the inline slot
+ * of the object.  Assumes that you already hold the attribute_lock.
+ */
+static void attr_inline_update(opal_hash_table_t *attr_hash, int key,
+                               attribute_value_t *attr)
+{
+    ompi_attr_hash_t *hash = (ompi_attr_hash_t *) attr_hash;
+    attribute_inline_t *slot;
+
+    if ((key < 0) || (key >= ATTR_INLINE_KEYS)) {
+        return;
+    }
+    slot = &hash->ah_inline[key];
+
+    hash->ah_seq++;
+    opal_atomic_wmb();
+    if (NULL != attr) {
+        slot->ai_c = translate_to_c(attr);
+        slot->ai_aint = translate_to_aint(attr);
+        slot->ai_fint = translate_to_fint(attr);
+        slot->ai_set = 1;
+    } else {
+        slot->ai_set = 0;
+    }
+    opal_atomic_wmb();
+    hash->ah_seq++;
+}
+
+
+/*
+ * Read the inline slot of key without the attribute_lock. Returns false
+ * if the attribute is not there (or the slot is being written), the caller
+ * then looks in the hash under the lock: the flag = 0 and the invalid
+ * keyval answers require the keyval hash.
+ */
+static bool attr_inline_get(opal_hash_table_t *attr_hash, int key,
+                            attribute_inline_t *value)
+{
+    ompi_attr_hash_t *hash = (ompi_attr_hash_t *) attr_hash;
+    int32_t seq;
+
+    if ((NULL == hash) || (key < 0) || (key >= ATTR_INLINE_KEYS)) {
+        return false;
+    }
+
+    seq = hash->ah_seq;
+    if (seq & 1) {
+        return false;
+    }
+    opal_atomic_rmb();
+    *value = hash->ah_inline[key];
+    opal_atomic_rmb();
+
+    return (seq == hash->ah_seq) && value->ai_set;
+}
+
+
 /*
  * Comparator for qsort() to sort attributes in the order that they were set.
  */
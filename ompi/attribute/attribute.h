@@ -2,7 +2,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2005 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -183,22 +183,11 @@ typedef struct ompi_attribute_keyval_t ompi_attribute_keyval_t;
 
 /**
  * Convenient way to initialize the attribute hash table per MPI-Object
+ *
+ * The table is an ompi_attr_hash_t, see attribute.c: only this function
+ * may create the attribute hash of an object.
  */
-
-static inline
-int ompi_attr_hash_init(opal_hash_table_t **hash)
-{
-    *hash = OBJ_NEW(opal_hash_table_t);
-    if (NULL == *hash) {
-        fprintf(stderr, "Error while creating the local attribute list\n");
-        return OMPI_ERR_OUT_OF_RESOURCE;
-    }
-    if (OMPI_SUCCESS != opal_hash_table_init(*hash, ATTR_HASH_SIZE)) {
-        return OMPI_ERR_OUT_OF_RESOURCE;
-    }
-
-    return MPI_SUCCESS;
-}
+OMPI_DECLSPEC int ompi_attr_hash_init(opal_hash_table_t **hash);
 
 /**
  * Initialize the main attribute hash that stores the keyvals and meta data
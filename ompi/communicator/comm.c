@@ -52,11 +52,13 @@
 #include "ompi/communicator/communicator.h"
 #include "ompi/mca/pml/pml.h"
 #include "ompi/request/request.h"
+#include "ompi/runtime/params.h"
 
 /*
 ** sort-function for MPI_Comm_split
 */
 static int rankkeycompare(const void *, const void *);
+static int colorkeyrankcompare(const void *, const void *);
 
 /**
  * to fill the rest of the stuff for the communicator
@@ -402,6 +404,174 @@ int ompi_comm_create ( ompi_communicator_t *comm, ompi_group_t *group,
 /**********************************************************************/
 /**********************************************************************/
 
+/*
+ * Bucket exchange for the split of large intra-communicators. Instead of
+ * allgathering the (color, key) of every rank, each rank sends its key to
+ * the owner of its color (a hash of the color on the ranks of comm), the
+ * owners sort their buckets and send the ordered list of members back to
+ * each member, so a rank only handles O(size of its color) data. The owners
+ * cannot know how many contributions they will get: the exchange ends with
+ * a synchronous send followed by an ibarrier (a rank enters the barrier once
+ * its contribution is matched, the barrier completes once they all are).
+ *
+ * When the largest color exceeds ompi_comm_split_bucket_max_color the owners
+ * would have to send too much, *handled is set to false and the caller uses
+ * the allgather. Ranks with MPI_UNDEFINED get a group of themselves only.
+ */
+static int ompi_comm_split_buckets (ompi_communicator_t *comm, int color, int key,
+                                    int **ranks_out, int *size_out, bool *handled)
+{
+    int rank = ompi_comm_rank (comm), size = ompi_comm_size (comm);
+    ompi_request_t *sreq = MPI_REQUEST_NULL, *breq = MPI_REQUEST_NULL;
+    ompi_request_t **reqs = NULL;
+    int *bucket = NULL, *members = NULL, *ranks = NULL;
+    int nbucket = 0, max_bucket = 0, max_color = 0, nreqs = 0;
+    int myinfo[2] = {color, key}, owner = -1;
+    int flag, done = 0, barrier = 0;
+    ompi_status_public_t status;
+    size_t count;
+    int rc = OMPI_SUCCESS;
+
+    *handled = false;
+
+    if (MPI_UNDEFINED != color) {
+        owner = (int) (((uint32_t) color * 2654435761u) % (uint32_t) size);
+        rc = MCA_PML_CALL(isend(myinfo, 2, MPI_INT, owner, OMPI_COMM_SPLIT_BUCKET_TAG,
+                                MCA_PML_BASE_SEND_SYNCHRONOUS, comm, &sreq));
+        if (OMPI_SUCCESS != rc) {
+            return rc;
+        }
+    }
+
+    /* collect the (color, key, rank) of the colors I own */
+    while (!done) {
+        rc = MCA_PML_CALL(iprobe(MPI_ANY_SOURCE, OMPI_COMM_SPLIT_BUCKET_TAG, comm, &flag, &status));
+        if (OMPI_SUCCESS != rc) {
+            goto exit;
+        }
+        if (flag) {
+            if (nbucket == max_bucket) {
+                int *tmp;
+                max_bucket = (0 == max_bucket) ? 16 : 2 * max_bucket;
+                tmp = (int *) realloc (bucket, 3 * max_bucket * sizeof (int));
+                if (NULL == tmp) {
+                    rc = OMPI_ERR_OUT_OF_RESOURCE;
+                    goto exit;
+                }
+                bucket = tmp;
+            }
+            rc = MCA_PML_CALL(recv(bucket + 3 * nbucket, 2, MPI_INT, status.MPI_SOURCE,
+                                   OMPI_COMM_SPLIT_BUCKET_TAG, comm, MPI_STATUS_IGNORE));
+            if (OMPI_SUCCESS != rc) {
+                goto exit;
+            }
+            bucket[3 * nbucket + 2] = status.MPI_SOURCE;
+            nbucket++;
+            continue;
+        }
+        if (!barrier) {
+            rc = ompi_request_test (&sreq, &flag, MPI_STATUS_IGNORE);
+            if (OMPI_SUCCESS == rc && flag) {
+                rc = comm->c_coll->coll_ibarrier (comm, &breq, comm->c_coll->coll_ibarrier_module);
+                barrier = 1;
+            }
+        } else {
+            rc = ompi_request_test (&breq, &done, MPI_STATUS_IGNORE);
+        }
+        if (OMPI_SUCCESS != rc) {
+            goto exit;
+        }
+    }
+
+    /* sorted by color, then key, then rank: each color is a run of members in order */
+    if (nbucket > 1) {
+        qsort (bucket, nbucket, 3 * sizeof (int), colorkeyrankcompare);
+    }
+    for (int i = 0, run = 0; i < nbucket; i++) {
+        run = (0 < i && bucket[3 * i] == bucket[3 * (i - 1)]) ? run + 1 : 1;
+        max_color = (run > max_color) ? run : max_color;
+    }
+    rc = comm->c_coll->coll_allreduce (MPI_IN_PLACE, &max_color, 1, MPI_INT, MPI_MAX, comm,
+                                      comm->c_coll->coll_allreduce_module);
+    if (OMPI_SUCCESS != rc || max_color > (int) ompi_comm_split_bucket_max_color) {
+        goto exit;
+    }
+
+    /* send each member the list of its color */
+    if (0 < nbucket) {
+        members = (int *) malloc (nbucket * sizeof (int));
+        reqs = (ompi_request_t **) malloc (nbucket * sizeof (ompi_request_t *));
+        if (NULL == members || NULL == reqs) {
+            rc = OMPI_ERR_OUT_OF_RESOURCE;
+            goto exit;
+        }
+        for (int i = 0; i < nbucket; i++) {
+            members[i] = bucket[3 * i + 2];
+        }
+        for (int first = 0, last; first < nbucket; first = last) {
+            for (last = first + 1; last < nbucket && bucket[3 * last] == bucket[3 * first]; last++);
+            for (int i = first; i < last; i++) {
+                rc = MCA_PML_CALL(isend(members + first, last - first, MPI_INT, members[i],
+                                        OMPI_COMM_SPLIT_MEMBERS_TAG, MCA_PML_BASE_SEND_STANDARD,
+                                        comm, &reqs[nreqs]));
+                if (OMPI_SUCCESS != rc) {
+                    goto exit;
+                }
+                nreqs++;
+            }
+        }
+    }
+
+    if (MPI_UNDEFINED != color) {
+        rc = MCA_PML_CALL(probe(owner, OMPI_COMM_SPLIT_MEMBERS_TAG, comm, &status));
+        if (OMPI_SUCCESS != rc) {
+            goto exit;
+        }
+        count = status._ucount / sizeof (int);
+        ranks = (int *) malloc (count * sizeof (int));
+        if (NULL == ranks) {
+            rc = OMPI_ERR_OUT_OF_RESOURCE;
+            goto exit;
+        }
+        rc = MCA_PML_CALL(recv(ranks, (int) count, MPI_INT, owner, OMPI_COMM_SPLIT_MEMBERS_TAG,
+                               comm, MPI_STATUS_IGNORE));
+        if (OMPI_SUCCESS != rc) {
+            goto exit;
+        }
+    } else {
+        ranks = (int *) malloc (sizeof (int));
+        if (NULL == ranks) {
+            rc = OMPI_ERR_OUT_OF_RESOURCE;
+            goto exit;
+        }
+        ranks[0] = rank;
+        count = 1;
+    }
+
+    if (0 < nreqs) {
+        rc = ompi_request_wait_all (nreqs, reqs, MPI_STATUSES_IGNORE);
+        nreqs = 0;
+        if (OMPI_SUCCESS != rc) {
+            goto exit;
+        }
+    }
+
+    *ranks_out = ranks;
+    *size_out = (int) count;
+    *handled = true;
+    ranks = NULL;
+
+ exit:
+    if (0 < nreqs) {
+        (void) ompi_request_wait_all (nreqs, reqs, MPI_STATUSES_IGNORE);
+    }
+    free (ranks);
+    free (reqs);
+    free (members);
+    free (bucket);
+    return rc;
+}
+
 int ompi_comm_split_with_info( ompi_communicator_t* comm, int color, int key,
                                opal_info_t *info,
                                ompi_communicator_t **newcomm, bool pass_on_topo )
@@ -437,6 +607,19 @@ int ompi_comm_split_with_info( ompi_communicator_t* comm, int color, int key,
         allgatherfct = (ompi_comm_allgatherfct *)comm->c_coll->coll_allgather;
     }
 
+    if (!inter && 0 != ompi_comm_split_bucket_min_size
+        && size >= (int) ompi_comm_split_bucket_min_size) {
+        bool handled;
+
+        rc = ompi_comm_split_buckets (comm, color, key, &lranks, &my_size, &handled);
+        if ( OMPI_SUCCESS != rc ) {
+            goto exit;
+        }
+        if (handled) {
+            goto remote_info;
+        }
+    }
+
     results  = (int*) malloc ( 2 * size * sizeof(int));
     if ( NULL == results ) {
         return OMPI_ERR_OUT_OF_RESOURCE;
@@ -493,6 +676,7 @@ int ompi_comm_split_with_info( ompi_communicator_t* comm, int color, int key,
 
     /* Step 2: determine all the information for the remote group */
     /* --------------------------------------------------------- */
+ remote_info:
     if ( inter ) {
         remote_group = &ompi_mpi_group_null.group;
         rsize    = comm->c_remote_group->grp_proc_count;
@@ -1903,6 +2087,20 @@ static int rankkeycompare (const void *p, const void *q)
 }
 
 
+/* (color, key, rank) triplets of the split bucket exchange */
+static int colorkeyrankcompare (const void *p, const void *q)
+{
+    const int *a = (const int *) p, *b = (const int *) q;
+
+    for (int i = 0; i < 3; i++) {
+        if (a[i] != b[i]) {
+            return (a[i] < b[i]) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+
 /***********************************************************************
  * Counterpart of MPI_Cart/Graph_create. This will be called from the
  * top level MPI. The condition for INTER communicator is already
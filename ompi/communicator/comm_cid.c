@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2020 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2008 High Performance Computing Center Stuttgart,
@@ -33,6 +33,7 @@
 
 #include "ompi_config.h"
 
+#include "opal/class/opal_bitmap.h"
 #include "opal/mca/pmix/base/base.h"
 #include "opal/util/printf.h"
 
@@ -47,6 +48,7 @@
 #include "ompi/mca/coll/base/base.h"
 #include "ompi/request/request.h"
 #include "ompi/runtime/mpiruntime.h"
+#include "ompi/runtime/params.h"
 
 struct ompi_comm_cid_context_t;
 
@@ -78,6 +80,8 @@ struct ompi_comm_cid_context_t {
     int nextcid_epoch;
 #endif /* OPAL_ENABLE_FT_MPI */
     int start;
+    /** number of consecutive cids agreed upon, the extra ones are kept by comm */
+    int block;
     int flag, rflag;
     int local_leader;
     int remote_leader;
@@ -183,10 +187,93 @@ static int ompi_comm_ft_allreduce_intra_pmix_nb(int *inbuf, int *outbuf, int cou
 
 static opal_mutex_t ompi_cid_lock = OPAL_MUTEX_STATIC_INIT;
 
+/* cids reserved by a communicator for its future children: free in
+ * ompi_mpi_communicators but not available to the other communicators */
+static opal_bitmap_t ompi_comm_cid_reserved;
 
 int ompi_comm_cid_init (void)
 {
-    return OMPI_SUCCESS;
+    OBJ_CONSTRUCT(&ompi_comm_cid_reserved, opal_bitmap_t);
+    return opal_bitmap_init (&ompi_comm_cid_reserved, 64);
+}
+
+void ompi_comm_cid_finalize (void)
+{
+    OBJ_DESTRUCT(&ompi_comm_cid_reserved);
+}
+
+/* end of the reserved block of comm */
+static inline int ompi_comm_cid_block_end (ompi_communicator_t *comm)
+{
+    return comm->c_id_start_index + (int) ompi_comm_cid_block_size - 1;
+}
+
+/* Called with the cid lock held */
+static void ompi_comm_cid_release_block_locked (ompi_communicator_t *comm)
+{
+    if (MPI_UNDEFINED == comm->c_id_available) {
+        return;
+    }
+
+    for (int cid = comm->c_id_available ; cid < ompi_comm_cid_block_end (comm) ; ++cid) {
+        opal_bitmap_clear_bit (&ompi_comm_cid_reserved, cid);
+    }
+    comm->c_id_available = comm->c_id_start_index = MPI_UNDEFINED;
+}
+
+void ompi_comm_cid_release_block (ompi_communicator_t *comm)
+{
+    if (MPI_UNDEFINED == comm->c_id_available) {
+        return;
+    }
+
+    OPAL_THREAD_LOCK(&ompi_cid_lock);
+    ompi_comm_cid_release_block_locked (comm);
+    OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+}
+
+/* Take count consecutive cids starting at cid, none of them reserved */
+static bool ompi_comm_cid_try_get (unsigned int cid, int count, ompi_communicator_t *comm)
+{
+    for (int i = 0 ; i < count ; ++i) {
+        if ((cid + i) >= mca_pml.pml_max_contextid
+            || opal_bitmap_is_set_bit (&ompi_comm_cid_reserved, (int) (cid + i))
+            || !opal_pointer_array_test_and_set_item (&ompi_mpi_communicators, cid + i, comm)) {
+            while (i-- > 0) {
+                opal_pointer_array_set_item (&ompi_mpi_communicators, cid + i, NULL);
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+static void ompi_comm_cid_put (unsigned int cid, int count)
+{
+    for (int i = 0 ; i < count ; ++i) {
+        opal_pointer_array_set_item (&ompi_mpi_communicators, cid + i, NULL);
+    }
+}
+
+/* Hand out the next cid of the block reserved by comm, if any is left */
+static bool ompi_comm_cid_from_block (ompi_communicator_t *newcomm, ompi_communicator_t *comm)
+{
+    int cid;
+
+    OPAL_THREAD_LOCK(&ompi_cid_lock);
+    if (MPI_UNDEFINED == comm->c_id_available
+        || comm->c_id_available >= ompi_comm_cid_block_end (comm)) {
+        OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+        return false;
+    }
+
+    cid = comm->c_id_available++;
+    opal_bitmap_clear_bit (&ompi_comm_cid_reserved, cid);
+    newcomm->c_contextid = cid;
+    opal_pointer_array_set_item (&ompi_mpi_communicators, cid, newcomm);
+    OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+
+    return true;
 }
 
 static ompi_comm_cid_context_t *mca_comm_cid_context_alloc (ompi_communicator_t *newcomm, ompi_communicator_t *comm,
@@ -208,6 +295,7 @@ static ompi_comm_cid_context_t *mca_comm_cid_context_alloc (ompi_communicator_t
 
     /* Determine which implementation of allreduce we have to use
      * for the current mode. */
+    context->block = 1;
     switch (mode) {
     case OMPI_COMM_CID_INTRA:
         context->allreduce_fn = ompi_comm_allreduce_intra_nb;
@@ -285,11 +373,60 @@ static int ompi_comm_nextcid_check_flag (ompi_comm_request_t *request);
 static volatile int64_t ompi_comm_cid_lowest_id = INT64_MAX;
 #if OPAL_ENABLE_FT_MPI
 static int ompi_comm_cid_epoch = INT_MAX;
+
+int ompi_comm_cid_epoch_proposal (void)
+{
+    int epoch;
+
+    OPAL_THREAD_LOCK(&ompi_cid_lock);
+    epoch = ompi_comm_cid_epoch - 1;
+    OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+
+    return epoch;
+}
+
+bool ompi_comm_cid_block_available (ompi_communicator_t *comm)
+{
+    bool available;
+
+    OPAL_THREAD_LOCK(&ompi_cid_lock);
+    available = MPI_UNDEFINED != comm->c_id_available
+        && comm->c_id_available < ompi_comm_cid_block_end (comm);
+    OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+
+    return available;
+}
+
+bool ompi_comm_cid_shrink_from_block (ompi_communicator_t *newcomm, ompi_communicator_t *comm, int epoch)
+{
+    if (epoch <= 0 || !ompi_comm_cid_from_block (newcomm, comm)) {
+        return false;
+    }
+
+    OPAL_THREAD_LOCK(&ompi_cid_lock);
+    newcomm->c_epoch = INT_MAX - epoch;
+    ompi_comm_cid_epoch -= 1;
+    OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+
+    ompi_comm_cid_move_block (newcomm, comm);
+    return true;
+}
+
+void ompi_comm_cid_move_block (ompi_communicator_t *newcomm, ompi_communicator_t *comm)
+{
+    OPAL_THREAD_LOCK(&ompi_cid_lock);
+    ompi_comm_cid_release_block_locked (newcomm);
+    newcomm->c_id_start_index = comm->c_id_start_index;
+    newcomm->c_id_available = comm->c_id_available;
+    comm->c_id_available = comm->c_id_start_index = MPI_UNDEFINED;
+    OPAL_THREAD_UNLOCK(&ompi_cid_lock);
+}
 #endif /* OPAL_ENABLE_FT_MPI */
 
-int ompi_comm_nextcid_nb (ompi_communicator_t *newcomm, ompi_communicator_t *comm,
-                          ompi_communicator_t *bridgecomm, const void *arg0, const void *arg1,
-                          bool send_first, int mode, ompi_request_t **req)
+static int ompi_comm_nextcid_block_nb (ompi_communicator_t *newcomm, ompi_communicator_t *comm,
+                                       ompi_communicator_t *bridgecomm, const void *arg0,
+                                       const void *arg1, bool send_first, int mode, int block,
+                                       ompi_request_t **req)
 {
     ompi_comm_cid_context_t *context;
     ompi_comm_request_t *request;
@@ -300,6 +437,7 @@ int ompi_comm_nextcid_nb (ompi_communicator_t *newcomm, ompi_communicator_t *com
         return OMPI_ERR_OUT_OF_RESOURCE;
     }
 
+    context->block = block;
     context->start = ompi_mpi_communicators.lowest_free;
 
     request = ompi_comm_request_get ();
@@ -320,14 +458,51 @@ int ompi_comm_nextcid_nb (ompi_communicator_t *newcomm, ompi_communicator_t *com
     return OMPI_SUCCESS;
 }
 
+int ompi_comm_nextcid_nb (ompi_communicator_t *newcomm, ompi_communicator_t *comm,
+                          ompi_communicator_t *bridgecomm, const void *arg0, const void *arg1,
+                          bool send_first, int mode, ompi_request_t **req)
+{
+    return ompi_comm_nextcid_block_nb (newcomm, comm, bridgecomm, arg0, arg1, send_first,
+                                       mode, 1, req);
+}
+
 int ompi_comm_nextcid (ompi_communicator_t *newcomm, ompi_communicator_t *comm,
                        ompi_communicator_t *bridgecomm, const void *arg0, const void *arg1,
                        bool send_first, int mode)
 {
     ompi_request_t *req;
+    int block = 1;
     int rc;
 
-    rc = ompi_comm_nextcid_nb (newcomm, comm, bridgecomm, arg0, arg1, send_first, mode, &req);
+    /* Blocking creations from an intra-communicator happen in the same order
+     * on all its ranks, and each one completes before the next one starts.
+     * The agreement can therefore reserve a block of consecutive cids, and
+     * the following children of comm take them without any communication.
+     * Nonblocking creations may complete in a different order on different
+     * ranks, they neither use nor refill the block.
+     */
+    if (OMPI_COMM_CID_INTRA == mode && ompi_comm_cid_block_size > 1
+#if OPAL_ENABLE_FT_MPI
+        /* the epochs need an agreement for each cid */
+        && !ompi_ftmpi_enabled
+#endif /* OPAL_ENABLE_FT_MPI */
+        ) {
+        if (ompi_comm_cid_from_block (newcomm, comm)) {
+            return OMPI_SUCCESS;
+        }
+        block = (int) ompi_comm_cid_block_size;
+    }
+#if OPAL_ENABLE_FT_MPI
+    /* the shrunk communicator takes the rest of the block, and its own
+     * shrinks get their cid with the agreement on the failed processes,
+     * see ompi_comm_cid_shrink_from_block */
+    if (OMPI_COMM_CID_INTRA_FT == mode && ompi_comm_cid_block_size > 1) {
+        block = (int) ompi_comm_cid_block_size;
+    }
+#endif /* OPAL_ENABLE_FT_MPI */
+
+    rc = ompi_comm_nextcid_block_nb (newcomm, comm, bridgecomm, arg0, arg1, send_first, mode,
+                                     block, &req);
     if (OMPI_SUCCESS != rc) {
         return rc;
     }
@@ -346,7 +521,9 @@ static int ompi_comm_allreduce_getnextcid (ompi_comm_request_t *request)
     ompi_request_t *subreq;
     bool flag = false;
     int ret = OMPI_SUCCESS;
-    int participate = (context->newcomm->c_local_group->grp_my_rank != MPI_UNDEFINED);
+    /* with blocks all the ranks reserve, the parent must stay consistent everywhere */
+    int participate = (context->block > 1) ||
+        (context->newcomm->c_local_group->grp_my_rank != MPI_UNDEFINED);
 
     if (OPAL_THREAD_TRYLOCK(&ompi_cid_lock)) {
         return ompi_comm_request_schedule_append (request, ompi_comm_allreduce_getnextcid, NULL, 0);
@@ -366,8 +543,7 @@ static int ompi_comm_allreduce_getnextcid (ompi_comm_request_t *request)
         flag = false;
         context->nextlocal_cid = mca_pml.pml_max_contextid;
         for (unsigned int i = context->start ; i < mca_pml.pml_max_contextid ; ++i) {
-            flag = opal_pointer_array_test_and_set_item (&ompi_mpi_communicators, i,
-                                                         context->comm);
+            flag = ompi_comm_cid_try_get (i, context->block, context->comm);
             if (true == flag) {
                 context->nextlocal_cid = i;
                 break;
@@ -407,7 +583,7 @@ static int ompi_comm_allreduce_getnextcid (ompi_comm_request_t *request)
     return ompi_comm_request_schedule_append (request, ompi_comm_checkcid, &subreq, 1);
 err_exit:
     if (participate && flag) {
-        opal_pointer_array_test_and_set_item(&ompi_mpi_communicators, context->nextlocal_cid, NULL);
+        ompi_comm_cid_put (context->nextlocal_cid, context->block);
     }
     ompi_comm_cid_lowest_id = INT64_MAX;
     OPAL_THREAD_UNLOCK(&ompi_cid_lock);
@@ -420,11 +596,12 @@ static int ompi_comm_checkcid (ompi_comm_request_t *request)
     ompi_comm_cid_context_t *context = (ompi_comm_cid_context_t *) request->context;
     ompi_request_t *subreq;
     int ret;
-    int participate = (context->newcomm->c_local_group->grp_my_rank != MPI_UNDEFINED);
+    int participate = (context->block > 1) ||
+        (context->newcomm->c_local_group->grp_my_rank != MPI_UNDEFINED);
 
     if (OMPI_SUCCESS != request->super.req_status.MPI_ERROR) {
         if (participate) {
-            opal_pointer_array_set_item(&ompi_mpi_communicators, context->nextlocal_cid, NULL);
+            ompi_comm_cid_put (context->nextlocal_cid, context->block);
         }
         return request->super.req_status.MPI_ERROR;
     }
@@ -438,10 +615,9 @@ static int ompi_comm_checkcid (ompi_comm_request_t *request)
     } else {
         context->flag = (context->nextcid == context->nextlocal_cid);
         if ( participate && !context->flag) {
-            opal_pointer_array_set_item(&ompi_mpi_communicators, context->nextlocal_cid, NULL);
+            ompi_comm_cid_put (context->nextlocal_cid, context->block);
 
-            context->flag = opal_pointer_array_test_and_set_item (&ompi_mpi_communicators,
-                                                                  context->nextcid, context->comm);
+            context->flag = ompi_comm_cid_try_get (context->nextcid, context->block, context->comm);
         }
     }
 
@@ -458,7 +634,7 @@ static int ompi_comm_checkcid (ompi_comm_request_t *request)
         ompi_comm_request_schedule_append (request, ompi_comm_nextcid_check_flag, &subreq, 1);
     } else {
         if (participate && context->flag ) {
-            opal_pointer_array_test_and_set_item(&ompi_mpi_communicators, context->nextlocal_cid, NULL);
+            ompi_comm_cid_put (context->nextcid, context->block);
         }
         ompi_comm_cid_lowest_id = INT64_MAX;
     }
@@ -470,11 +646,12 @@ static int ompi_comm_checkcid (ompi_comm_request_t *request)
 static int ompi_comm_nextcid_check_flag (ompi_comm_request_t *request)
 {
     ompi_comm_cid_context_t *context = (ompi_comm_cid_context_t *) request->context;
-    int participate = (context->newcomm->c_local_group->grp_my_rank != MPI_UNDEFINED);
+    int participate = (context->block > 1) ||
+        (context->newcomm->c_local_group->grp_my_rank != MPI_UNDEFINED);
 
     if (OMPI_SUCCESS != request->super.req_status.MPI_ERROR) {
         if (participate) {
-            opal_pointer_array_set_item(&ompi_mpi_communicators, context->nextcid, NULL);
+            ompi_comm_cid_put (context->nextcid, context->block);
         }
         return request->super.req_status.MPI_ERROR;
     }
@@ -492,8 +669,7 @@ static int ompi_comm_nextcid_check_flag (ompi_comm_request_t *request)
             context->nextlocal_cid = mca_pml.pml_max_contextid;
             for (unsigned int i = context->start ; i < mca_pml.pml_max_contextid ; ++i) {
                 bool flag;
-                flag = opal_pointer_array_test_and_set_item (&ompi_mpi_communicators, i,
-                                                                context->comm);
+                flag = ompi_comm_cid_try_get (i, 1, context->comm);
                 if (true == flag) {
                     context->nextlocal_cid = i;
                     break;
@@ -510,6 +686,16 @@ static int ompi_comm_nextcid_check_flag (ompi_comm_request_t *request)
 #endif /* OPAL_ENABLE_FT_MPI */
         opal_pointer_array_set_item (&ompi_mpi_communicators, context->nextcid, context->newcomm);
 
+        if (context->block > 1) {
+            /* keep the rest of the block for the next children of comm */
+            ompi_comm_cid_release_block_locked (context->comm);
+            for (int i = 1 ; i < context->block ; ++i) {
+                opal_pointer_array_set_item (&ompi_mpi_communicators, context->nextcid + i, NULL);
+                opal_bitmap_set_bit (&ompi_comm_cid_reserved, context->nextcid + i);
+            }
+            context->comm->c_id_start_index = context->comm->c_id_available = context->nextcid + 1;
+        }
+
         /* unlock the cid generator */
         ompi_comm_cid_lowest_id = INT64_MAX;
         OPAL_THREAD_UNLOCK(&ompi_cid_lock);
@@ -520,7 +706,7 @@ static int ompi_comm_nextcid_check_flag (ompi_comm_request_t *request)
 
     if (participate && (0 != context->flag)) {
         /* we could use this cid, but other don't agree */
-        opal_pointer_array_set_item (&ompi_mpi_communicators, context->nextcid, NULL);
+        ompi_comm_cid_put (context->nextcid, context->block);
         context->start = context->nextcid + 1; /* that's where we can start the next round */
     }
 
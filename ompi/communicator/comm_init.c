@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2020 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -44,6 +44,7 @@
 #include "ompi/mca/coll/base/coll_tags.h"
 #include "ompi/mca/topo/base/base.h"
 #include "ompi/runtime/params.h"
+#include "ompi/runtime/ompi_spc.h"
 #include "ompi/communicator/communicator.h"
 #include "ompi/attribute/attribute.h"
 #include "ompi/dpm/dpm.h"
@@ -130,8 +131,8 @@ int ompi_comm_init(void)
     ompi_set_group_rank(group, ompi_proc_local());
 
     ompi_mpi_comm_world.comm.c_contextid    = 0;
-    ompi_mpi_comm_world.comm.c_id_start_index = 4;
-    ompi_mpi_comm_world.comm.c_id_available = 4;
+    ompi_mpi_comm_world.comm.c_id_start_index = MPI_UNDEFINED;
+    ompi_mpi_comm_world.comm.c_id_available = MPI_UNDEFINED;
     ompi_mpi_comm_world.comm.c_my_rank      = group->grp_my_rank;
     ompi_mpi_comm_world.comm.c_local_group  = group;
     ompi_mpi_comm_world.comm.c_remote_group = group;
@@ -184,8 +185,8 @@ int ompi_comm_init(void)
     OMPI_GROUP_SET_DENSE (group);
 
     ompi_mpi_comm_self.comm.c_contextid    = 1;
-    ompi_mpi_comm_self.comm.c_id_start_index = 20;
-    ompi_mpi_comm_self.comm.c_id_available = 20;
+    ompi_mpi_comm_self.comm.c_id_start_index = MPI_UNDEFINED;
+    ompi_mpi_comm_self.comm.c_id_available = MPI_UNDEFINED;
     ompi_mpi_comm_self.comm.c_my_rank      = group->grp_my_rank;
     ompi_mpi_comm_self.comm.c_local_group  = group;
     ompi_mpi_comm_self.comm.c_remote_group = group;
@@ -355,6 +356,7 @@ int ompi_comm_finalize(void)
     }
 
     OBJ_DESTRUCT (&ompi_mpi_communicators);
+    ompi_comm_cid_finalize ();
     OBJ_DESTRUCT (&ompi_comm_f_to_c_table);
 
     /* finalize communicator requests */
@@ -385,6 +387,9 @@ static void ompi_comm_construct(ompi_communicator_t* comm)
     comm->c_topo         = NULL;
     comm->c_coll         = NULL;
     comm->c_nbc_tag      = MCA_COLL_BASE_TAG_NONBLOCKING_BASE;
+#if SPC_ENABLE == 1
+    comm->c_spc          = NULL;
+#endif
 
     /* A keyhash will be created if/when an attribute is cached on
        this communicator */
@@ -403,6 +408,7 @@ static void ompi_comm_construct(ompi_communicator_t* comm)
     comm->coll_revoked        = false;
     comm->c_epoch             = 0;
     comm->agreement_specific  = NULL;
+    comm->rbcast_topo         = NULL;
 #endif
 }
 
@@ -466,12 +472,18 @@ static void ompi_comm_destruct(ompi_communicator_t* comm)
         comm->error_handler = NULL;
     }
 
+    SPC_COMM_FREE(comm);
+
 #if OPAL_ENABLE_FT_MPI
     if( NULL != comm->agreement_specific ) {
         OBJ_RELEASE( comm->agreement_specific );
     }
+    free( comm->rbcast_topo );
 #endif  /* OPAL_ENABLE_FT_MPI */
 
+    /* give back the cids reserved for the children */
+    ompi_comm_cid_release_block (comm);
+
     /* mark this cid as available */
     if ( MPI_UNDEFINED != (int)comm->c_contextid &&
          NULL != opal_pointer_array_get_item(&ompi_mpi_communicators,
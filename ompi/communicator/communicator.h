@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2020 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -165,9 +165,9 @@ struct ompi_communicator_t {
     uint32_t                  c_assertions; /* info assertions */
 
     int c_id_available; /* the currently available Cid for allocation
-               to a child*/
+               to a child (MPI_UNDEFINED if none is reserved) */
     int c_id_start_index; /* the starting index of the block of cids
-                 allocated to this communicator*/
+                 allocated to this communicator (see ompi_comm_cid_block_size) */
     uint32_t c_epoch;  /* Identifier used to differenciate between two communicators
                           using the same c_contextid (not at the same time, obviously) */
 
@@ -219,11 +219,18 @@ struct ompi_communicator_t {
      */
     opal_atomic_int32_t c_nbc_tag;
 
+#if SPC_ENABLE == 1
+    /* Per communicator SPC counters, allocated on the first update */
+    struct ompi_spc_comm_t *c_spc;
+#endif
+
 #if OPAL_ENABLE_FT_MPI
     /** MPI_ANY_SOURCE Failed Group Offset - OMPI_Comm_failure_get_acked */
     int                      any_source_offset;
     /** agreement caching info for topology and previous returned decisions */
     opal_object_t           *agreement_specific;
+    /** node layout for the topology aware reliable broadcast, built on first use */
+    struct ompi_comm_rbcast_topo_t *rbcast_topo;
     /** Are MPI_ANY_SOURCE operations enabled? - OMPI_Comm_failure_ack */
     bool                     any_source_enabled;
     /** Has this communicator been revoked - OMPI_Comm_revoke() */
@@ -957,6 +964,37 @@ extern int ompi_comm_num_dyncomm;
    flag ompi_mpi_thread_provided
 */
 OMPI_DECLSPEC int ompi_comm_cid_init ( void );
+void ompi_comm_cid_finalize (void);
+
+/**
+ * Give back the cids the communicator reserved for its children
+ */
+void ompi_comm_cid_release_block (ompi_communicator_t *comm);
+
+#if OPAL_ENABLE_FT_MPI
+/**
+ * The epoch this process proposes for the next cid
+ */
+int ompi_comm_cid_epoch_proposal (void);
+
+/**
+ * Whether comm has cids left in the block reserved for its children
+ */
+bool ompi_comm_cid_block_available (ompi_communicator_t *comm);
+
+/**
+ * Give newcomm, shrunk from comm, the next cid of the block of comm, with
+ * the agreed epoch, and move the rest of the block to newcomm. All the
+ * processes of newcomm must have agreed that comm has a block left and on
+ * the epoch. Returns false if there is no cid left in the block.
+ */
+bool ompi_comm_cid_shrink_from_block (ompi_communicator_t *newcomm, ompi_communicator_t *comm, int epoch);
+
+/**
+ * Move the cids reserved by comm to newcomm
+ */
+void ompi_comm_cid_move_block (ompi_communicator_t *newcomm, ompi_communicator_t *comm);
+#endif /* OPAL_ENABLE_FT_MPI */
 
 
 void ompi_comm_assert_subscribe (ompi_communicator_t *comm, int32_t assert_flag);
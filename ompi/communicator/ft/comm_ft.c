@@ -1,6 +1,6 @@
 /*
  * Copyright (c) 2010-2012 Oak Ridge National Labs.  All rights reserved.
- * Copyright (c) 2011-2020 The University of Tennessee and The University
+ * Copyright (c) 2011-2026 The University of Tennessee and The University
  *
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
@@ -114,10 +114,39 @@ int ompi_comm_failure_get_acked_internal(ompi_communicator_t* comm, ompi_group_t
     return exit_status;
 }
 
+/*
+ * The failed processes of group, from the state of the procs of the group
+ * instead of an intersection with ompi_group_all_failed_procs. A sentinel
+ * was never used here, but the proc may exist and be known as failed.
+ */
+static int ompi_comm_failed_group(ompi_group_t* group, ompi_group_t** failed_group)
+{
+    int i, n = 0, ret, *ranks;
+    ompi_proc_t* proc;
+
+    ranks = (int*)malloc((ompi_group_size(group) + 1) * sizeof(int));
+    if( NULL == ranks ) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    for( i = 0; i < ompi_group_size(group); i++ ) {
+        proc = ompi_group_get_proc_ptr_raw(group, i);
+        if( ompi_proc_is_sentinel(proc) ) {
+            proc = (ompi_proc_t*)ompi_proc_lookup(ompi_proc_sentinel_to_name((uintptr_t)proc));
+            if( NULL == proc ) continue;
+        }
+        if( !ompi_proc_is_active(proc) ) {
+            ranks[n++] = i;
+        }
+    }
+    ret = ompi_group_incl(group, n, ranks, failed_group);
+    free(ranks);
+    return ret;
+}
+
 int ompi_comm_shrink_internal(ompi_communicator_t* comm, ompi_communicator_t** newcomm)
 {
     int ret, exit_status = OMPI_SUCCESS;
-    int flag = 1;
+    int flags[2];
     ompi_group_t *failed_group = NULL, *comm_group = NULL, *alive_group = NULL, *alive_rgroup = NULL;
     ompi_communicator_t *newcomp = NULL;
     int mode;
@@ -133,23 +162,27 @@ int ompi_comm_shrink_internal(ompi_communicator_t* comm, ompi_communicator_t** n
                          "%s ompi: comm_shrink: Agreement on failed processes",
                          OMPI_NAME_PRINT(OMPI_PROC_MY_NAME) ));
     start = PMPI_Wtime();
-    opal_mutex_lock(&ompi_group_afp_mutex);
-    ompi_group_intersection(comm->c_remote_group, ompi_group_all_failed_procs, &failed_group);
-    opal_mutex_unlock(&ompi_group_afp_mutex);
+    ret = ompi_comm_failed_group(comm->c_remote_group, &failed_group);
+    if( OMPI_SUCCESS != ret ) {
+        exit_status = ret;
+        goto cleanup;
+    }
     stop = PMPI_Wtime();
     OPAL_OUTPUT_VERBOSE((10, ompi_ftmpi_output_handle,
                          "%s ompi: comm_shrink: group_inter: %g seconds",
                          OMPI_NAME_PRINT(OMPI_PROC_MY_NAME), stop-start));
     start = PMPI_Wtime();
     do {
-        /* We need to create the list of alive processes. Thus, we don't care about
-         * the value of flag, instead we are only using the globally consistent
-         * return value.
+        /* We need to create the list of alive processes, the globally
+         * consistent return value. The same agreement settles the epoch of
+         * the new cid, and whether comm still has a block of cids for it.
          */
-        ret = comm->c_coll->coll_agree( &flag,
-                                        1,
+        flags[0] = ompi_comm_cid_epoch_proposal();
+        flags[1] = !OMPI_COMM_IS_INTER(comm) && ompi_comm_cid_block_available(comm);
+        ret = comm->c_coll->coll_agree( flags,
+                                        2,
                                         &ompi_mpi_int.dt,
-                                        &ompi_mpi_op_band.op,
+                                        &ompi_mpi_op_min.op,
                                         &failed_group, true,
                                         comm,
                                         comm->c_coll->coll_agree_module);
@@ -222,19 +255,25 @@ int ompi_comm_shrink_internal(ompi_communicator_t* comm, ompi_communicator_t** n
                          "%s ompi: comm_shrink: Determine context id",
                          OMPI_NAME_PRINT(OMPI_PROC_MY_NAME) ));
     start = PMPI_Wtime();
-    ret = ompi_comm_nextcid( newcomp,  /* new communicator */
-                             comm,     /* old comm */
-                             NULL,     /* bridge comm */
-                             NULL,     /* local leader */
-                             NULL,     /* remote_leader */
-                             -1,       /* send_first */
-                             mode);    /* mode */
-    if( OMPI_SUCCESS != ret ) {
-        opal_output_verbose(1, ompi_ftmpi_output_handle,
-                            "%s ompi: comm_shrink: Determine context id failed with error %d",
-                            OMPI_NAME_PRINT(OMPI_PROC_MY_NAME), ret);
-        exit_status = ret;
-        goto cleanup;
+    if( !flags[1] || !ompi_comm_cid_shrink_from_block(newcomp, comm, flags[0]) ) {
+        ret = ompi_comm_nextcid( newcomp,  /* new communicator */
+                                 comm,     /* old comm */
+                                 NULL,     /* bridge comm */
+                                 NULL,     /* local leader */
+                                 NULL,     /* remote_leader */
+                                 -1,       /* send_first */
+                                 mode);    /* mode */
+        if( OMPI_SUCCESS != ret ) {
+            opal_output_verbose(1, ompi_ftmpi_output_handle,
+                                "%s ompi: comm_shrink: Determine context id failed with error %d",
+                                OMPI_NAME_PRINT(OMPI_PROC_MY_NAME), ret);
+            exit_status = ret;
+            goto cleanup;
+        }
+        if( OMPI_COMM_CID_INTRA_FT == mode ) {
+            /* the next shrinks take their cid from this block */
+            ompi_comm_cid_move_block(newcomp, comm);
+        }
     }
     stop = PMPI_Wtime();
     OPAL_OUTPUT_VERBOSE((10, ompi_ftmpi_output_handle,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2020 The University of Tennessee and The University
+ * Copyright (c) 2016-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  *
@@ -13,6 +13,11 @@
 #include "opal/mca/base/mca_base_var.h"
 #include "opal/mca/timer/base/base.h"
 #include "opal/mca/threads/threads.h"
+#include "opal/mca/pmix/pmix-internal.h"
+#include "opal/mca/shmem/base/base.h"
+#include "opal/class/opal_hash_table.h"
+#include "opal/util/printf.h"
+#include "opal/util/proc.h"
 
 #include "ompi/runtime/params.h"
 #include "ompi/communicator/communicator.h"
@@ -21,6 +26,7 @@
 #include "ompi/mca/bml/base/base.h"
 
 #include <math.h>
+#include <unistd.h>
 
 typedef struct {
     ompi_communicator_t* comm;
@@ -43,6 +49,19 @@ typedef struct {
     uint64_t hb_rdma_raddr; /* write-to remote flag address */
     mca_btl_base_registration_handle_t* hb_rdma_rreg;
     opal_mutex_t fd_mutex; /* protect the structure while we change observer */
+    /* hierarchical detector: the processes of a node beat in a shared
+     * segment watched by the agent of the node (its lowest live rank), and
+     * only the agents are on the heartbeat ring */
+    int hb_local_count; /* number of processes on my node */
+    int hb_local_index; /* my index among them */
+    int hb_local_agent; /* the index of the agent of my node */
+    int* hb_local_ranks; /* the ranks of the processes on my node, ascending */
+    int* hb_prev_local; /* for every rank, the previous rank on its node or -1 */
+    int64_t* hb_local_last; /* the last beat seen in each slot */
+    double* hb_local_rstamp; /* the date of the last change of each slot */
+    opal_atomic_int64_t* hb_local_beats; /* the shared slots, NULL until attached */
+    opal_shmem_ds_t hb_local_ds;
+    bool hb_local_owner; /* created the segment */
 } comm_detector_t;
 
 static comm_detector_t comm_world_detector = {
@@ -62,7 +81,11 @@ static comm_detector_t comm_world_detector = {
     .hb_rdma_flag_lreg = NULL,
     .hb_rdma_raddr = (int64_t)NULL,
     .hb_rdma_rreg = NULL,
-    .fd_mutex = OPAL_MUTEX_STATIC_INIT
+    .fd_mutex = OPAL_MUTEX_STATIC_INIT,
+    .hb_local_ranks = NULL,
+    .hb_prev_local = NULL,
+    .hb_local_beats = NULL,
+    .hb_local_owner = false
 };
 
 typedef struct fd_heartbeat_t {
@@ -77,14 +100,30 @@ typedef struct fd_heartbeat_req_t {
     char rdma_rreg[];
 } ompi_comm_heartbeat_req_t;
 
+typedef struct fd_local_attach_t {
+    ompi_comm_rbcast_message_t super;
+    int from;
+    uint32_t ds_size;
+    char ds[]; /* the opal_shmem_ds_t of the segment of the node */
+} ompi_comm_local_attach_t;
+
+/* beat of a process that left the detector in finalize */
+#define FD_LOCAL_DEPARTED (-1)
+
 static int fd_heartbeat_request(comm_detector_t* detector);
 static int fd_heartbeat_request_cb(ompi_communicator_t* comm, ompi_comm_heartbeat_req_t* msg);
 static int fd_heartbeat_rdma_put(comm_detector_t* detector);
 static int fd_heartbeat_send(comm_detector_t* detector);
 static int fd_heartbeat_recv_cb(ompi_communicator_t* comm, ompi_comm_heartbeat_message_t* msg);
+static bool fd_local_setup(comm_detector_t* detector);
+static bool fd_local_is_agent(comm_detector_t* detector, int rank);
+static void fd_local_event(comm_detector_t* detector, double stamp, double lastpeek);
+static int fd_local_attach_cb(ompi_communicator_t* comm, ompi_comm_local_attach_t* msg);
+static void fd_event_schedule(comm_detector_t* detector, double interval);
 
 static bool comm_detector_enable = false;
 static int comm_detector_use_rdma_hb = false;
+static bool comm_detector_hierarchical = false;
 static double comm_heartbeat_period = 3e0;
 static double comm_heartbeat_timeout = 1e1;
 static opal_event_base_t* fd_event_base = NULL;
@@ -97,6 +136,7 @@ static void* fd_progress(opal_object_t* obj);
 
 static int comm_heartbeat_recv_cb_type = -1;
 static int comm_heartbeat_request_cb_type = -1;
+static int comm_local_attach_cb_type = -1;
 
 /* rdma btl alignment */
 #define ALIGNMENT_MASK(x) ((x) ? (x) - 1 : 0)
@@ -132,6 +172,10 @@ int ompi_comm_failure_detector_register_params(void) {
                                   "Use rdma put to deposit heartbeats into the observer memory",
                                   MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
                                   OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY, &comm_detector_use_rdma_hb);
+    (void) mca_base_var_register ("ompi", "mpi", "ft", "detector_hierarchical",
+                                  "Watch the processes of a node through shared memory from one agent per node, and run the heartbeat ring between the agents only",
+                                  MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                  OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY, &comm_detector_hierarchical);
     return OMPI_SUCCESS;
 }
 
@@ -150,6 +194,11 @@ int ompi_comm_failure_detector_init(void) {
     ret = ompi_comm_rbcast_register_cb_type((ompi_comm_rbcast_cb_t)fd_heartbeat_request_cb);
     if( 0 > ret ) goto cleanup;
     comm_heartbeat_request_cb_type = ret;
+    if( comm_detector_hierarchical ) {
+        ret = ompi_comm_rbcast_register_cb_type((ompi_comm_rbcast_cb_t)fd_local_attach_cb);
+        if( 0 > ret ) goto cleanup;
+        comm_local_attach_cb_type = ret;
+    }
 
     if( comm_detector_use_thread ) {
         fd_event_base = opal_event_base_create();
@@ -195,6 +244,12 @@ int ompi_comm_failure_detector_finalize(void) {
     int observing;
     comm_detector_t* detector = &comm_world_detector;
 
+    /* Tell the agent of the node that we leave */
+    if( NULL != detector->hb_local_ranks && NULL != detector->hb_local_beats ) {
+        detector->hb_local_beats[detector->hb_local_index] = FD_LOCAL_DEPARTED;
+        opal_atomic_wmb();
+    }
+
     /* Tell our observer that we won't put anymore */
     if( MPI_PROC_NULL != detector->hb_observer ) {
         detector->hb_rdma_rank = detector->hb_observer;
@@ -246,6 +301,20 @@ int ompi_comm_failure_detector_finalize(void) {
         mca_bml_base_deregister_mem(detector->hb_rdma_bml_btl_observing, detector->hb_rdma_flag_lreg);
     }
 
+    /* the other processes of the node keep their mapping */
+    if( NULL != detector->hb_local_beats ) {
+        if( detector->hb_local_owner ) opal_shmem_unlink(&detector->hb_local_ds);
+        opal_shmem_segment_detach(&detector->hb_local_ds);
+        detector->hb_local_beats = NULL;
+    }
+    free(detector->hb_local_ranks);
+    free(detector->hb_prev_local);
+    free(detector->hb_local_last);
+    free(detector->hb_local_rstamp);
+    detector->hb_local_ranks = detector->hb_prev_local = NULL;
+    detector->hb_local_last = NULL;
+    detector->hb_local_rstamp = NULL;
+
     /* ignore heartbeats and heartbeats requests from now on */
     detector->hb_observer = detector->hb_observing = MPI_PROC_NULL;
 
@@ -264,6 +333,24 @@ int ompi_comm_start_detector(ompi_communicator_t* comm) {
     rank = ompi_comm_rank(comm);
     detector->hb_observing = (np+rank-1) % np;
     detector->hb_observer = (np+rank+1) % np;
+    if( comm_detector_hierarchical && fd_local_setup(detector) ) {
+        /* only the agents are on the ring */
+        if( detector->hb_local_agent != detector->hb_local_index ) {
+            detector->hb_observing = detector->hb_observer = MPI_PROC_NULL;
+        }
+        else {
+            while( !fd_local_is_agent(detector, detector->hb_observing) ) {
+                detector->hb_observing = (np+detector->hb_observing-1) % np;
+            }
+            while( !fd_local_is_agent(detector, detector->hb_observer) ) {
+                detector->hb_observer = (np+detector->hb_observer+1) % np;
+            }
+            if( rank == detector->hb_observer ) {
+                /* the only node */
+                detector->hb_observing = detector->hb_observer = MPI_PROC_NULL;
+            }
+        }
+    }
     detector->hb_period = comm_heartbeat_period;
     detector->hb_timeout = comm_heartbeat_timeout;
     if(comm_heartbeat_timeout <= comm_heartbeat_period) {
@@ -284,24 +371,32 @@ int ompi_comm_start_detector(ompi_communicator_t* comm) {
     OBJ_CONSTRUCT(&detector->fd_mutex, opal_mutex_t);
 
     detector->fd_event = opal_event_new(fd_event_base, -1, OPAL_EV_TIMEOUT | OPAL_EV_PERSIST, fd_event_cb, detector);
-    struct timeval tv;
     /* wake up the ev loop at 10x the heartbeat period to ensure
      * accurate heartbeat emission rate (otherwise random sampling
-     * would cause drifts in emissions). */
-    tv.tv_sec = (int)(detector->hb_period / 10.);
-    tv.tv_usec = (-tv.tv_sec + (detector->hb_period / 10.)) * 1e6;
+     * would cause drifts in emissions). The processes off the ring only
+     * beat in shared memory, once per period is enough. */
+    double interval = detector->hb_period / 10.;
+    if( MPI_PROC_NULL == detector->hb_observer && NULL != detector->hb_local_ranks ) {
+        interval = detector->hb_period;
+    }
     OPAL_OUTPUT_VERBOSE((2, ompi_ftmpi_output_handle,
                          "%s %s: Installing an event every %g for a detector with period %g %s",
                          OMPI_NAME_PRINT(OMPI_PROC_MY_NAME), __func__,
-                         detector->hb_period / 10., detector->hb_period,
+                         interval, detector->hb_period,
                          comm_detector_use_thread?"(in a thread)":""));
-    opal_event_add(detector->fd_event, &tv);
+    fd_event_schedule(detector, interval);
     if( 10e-6 > detector->hb_period ) {
         /* do not overpoll the event progress loop except if
          * super aggressive heartbeat rate is required */
         opal_progress_event_users_increment();
     }
 
+    if( MPI_PROC_NULL == detector->hb_observer ) {
+        /* a process off the ring, or the only agent */
+        detector->hb_rstamp = INFINITY;
+        return OMPI_SUCCESS;
+    }
+
     if( comm_detector_use_rdma_hb ) {
         fd_heartbeat_request(detector);
     }
@@ -333,6 +428,8 @@ static int fd_heartbeat_request(comm_detector_t* detector) {
         ompi_proc_t* proc = ompi_comm_peer_lookup(comm, rank);
         assert( NULL != proc );
         if( !ompi_proc_is_active(proc) ) continue;
+        /* with the hierarchical detector, only the agents are on the ring */
+        if( NULL != detector->hb_local_ranks && !fd_local_is_agent(detector, rank) ) continue;
 
         /* if everybody else is dead, I don't need to monitor myself. */
         if( rank == comm->c_my_rank ) {
@@ -471,7 +568,12 @@ static void fd_event_cb(int fd, short flags, void* pdetector)
                          detector->hb_observer, stamp-detector->hb_sstamp-detector->hb_period, 
                          stamp-lastpeek-detector->hb_period*10.));
 
-    if( (stamp - detector->hb_sstamp) > (detector->hb_period*.9) ) {
+    if( NULL != detector->hb_local_ranks ) {
+        fd_local_event(detector, stamp, lastpeek);
+    }
+
+    if( MPI_PROC_NULL != detector->hb_observer
+     && (stamp - detector->hb_sstamp) > (detector->hb_period*.9) ) {
         fd_heartbeat_send(detector);
     }
 
@@ -722,4 +824,261 @@ static int fd_heartbeat_recv_cb(ompi_communicator_t* comm, ompi_comm_heartbeat_m
     return false; /* never forward on the rbcast */
 }
 
+/*
+ * hierarchical detector
+ */
+
+static void fd_event_schedule(comm_detector_t* detector, double interval)
+{
+    struct timeval tv;
+
+    tv.tv_sec = (int)interval;
+    tv.tv_usec = (-tv.tv_sec + interval) * 1e6;
+    /* rescheduled if already added */
+    opal_event_add(detector->fd_event, &tv);
+}
+
+/* Create the segment of the node and send it to the other local processes */
+static void fd_local_create(comm_detector_t* detector)
+{
+    size_t size = detector->hb_local_count * sizeof(opal_atomic_int64_t);
+    ompi_comm_local_attach_t* msg;
+    opal_atomic_int64_t* beats;
+    size_t ds_size;
+    char* file;
+    int i, ret;
+
+    ret = opal_asprintf(&file, "%s" OPAL_PATH_SEP "ft_detector.%s.%u.%x",
+                        opal_process_info.job_session_dir, opal_process_info.nodename,
+                        geteuid(), OMPI_PROC_MY_NAME->jobid);
+    if( 0 > ret ) return;
+    opal_pmix_register_cleanup(file, false, false, false);
+    ret = opal_shmem_segment_create(&detector->hb_local_ds, file, size);
+    free(file);
+    if( OPAL_SUCCESS != ret ) {
+        /* the local processes are left to the RTE */
+        opal_output_verbose(1, ompi_ftmpi_output_handle,
+                            "%s %s: could not create the shared segment of the node, the local processes are not observed",
+                            OMPI_NAME_PRINT(OMPI_PROC_MY_NAME), __func__);
+        return;
+    }
+    beats = opal_shmem_segment_attach(&detector->hb_local_ds);
+    if( NULL == beats ) {
+        opal_shmem_unlink(&detector->hb_local_ds);
+        return;
+    }
+    memset((void*)beats, 0, size);
+    detector->hb_local_owner = true;
+    opal_atomic_wmb();
+    detector->hb_local_beats = beats;
+
+    ds_size = opal_shmem_sizeof_shmem_ds(&detector->hb_local_ds);
+    msg = calloc(sizeof(*msg)+ds_size, 1);
+    if( NULL == msg ) return;
+    msg->super.cid = detector->comm->c_contextid;
+    msg->super.epoch = detector->comm->c_epoch;
+    msg->super.type = comm_local_attach_cb_type;
+    msg->from = detector->comm->c_my_rank;
+    msg->ds_size = (uint32_t)ds_size;
+    memcpy(&msg->ds[0], &detector->hb_local_ds, ds_size);
+    for( i = 0; i < detector->hb_local_count; i++ ) {
+        if( i == detector->hb_local_index ) continue;
+        (void)ompi_comm_rbcast_send_msg(ompi_comm_peer_lookup(detector->comm, detector->hb_local_ranks[i]),
+                                        &msg->super, sizeof(*msg)+ds_size);
+    }
+    free(msg);
+}
 
+/* Find the processes on each node from the node ids of the modex. Returns
+ * false if they are not known, the ring is then flat. */
+static bool fd_local_setup(comm_detector_t* detector)
+{
+    ompi_communicator_t* comm = detector->comm;
+    int np = ompi_comm_size(comm), rank = ompi_comm_rank(comm);
+    uint32_t nodeid, mynodeid = 0, *pnodeid = &nodeid;
+    opal_process_name_t name;
+    opal_hash_table_t nodes;
+    void* last = NULL;
+    int i, count, ret;
+    double grace;
+
+    if( NULL != detector->hb_local_ranks ) return true;
+
+    detector->hb_prev_local = malloc(np * sizeof(int));
+    if( NULL == detector->hb_prev_local ) return false;
+
+    OBJ_CONSTRUCT(&nodes, opal_hash_table_t);
+    opal_hash_table_init(&nodes, 1024);
+
+    /* the last rank seen on each node, shifted by one */
+    name.jobid = OMPI_PROC_MY_NAME->jobid;
+    for( i = 0; i < np; i++ ) {
+        name.vpid = i;
+        OPAL_MODEX_RECV_VALUE(ret, PMIX_NODEID, &name, &pnodeid, PMIX_UINT32);
+        if( PMIX_SUCCESS != ret ) break;
+        if( OPAL_SUCCESS != opal_hash_table_get_value_uint32(&nodes, nodeid, &last) ) {
+            last = NULL;
+        }
+        detector->hb_prev_local[i] = (int)(intptr_t)last - 1;
+        opal_hash_table_set_value_uint32(&nodes, nodeid, (void*)(intptr_t)(i+1));
+        if( rank == i ) mynodeid = nodeid;
+    }
+    if( i == np ) {
+        (void)opal_hash_table_get_value_uint32(&nodes, mynodeid, &last);
+    }
+    OBJ_DESTRUCT(&nodes);
+    if( i != np ) {
+        opal_output_verbose(1, ompi_ftmpi_output_handle,
+                            "%s %s: the node ids are not known, the detector is not hierarchical",
+                            OMPI_NAME_PRINT(OMPI_PROC_MY_NAME), __func__);
+        free(detector->hb_prev_local);
+        detector->hb_prev_local = NULL;
+        return false;
+    }
+
+    count = 0;
+    for( i = (int)(intptr_t)last - 1; 0 <= i; i = detector->hb_prev_local[i] ) count++;
+    detector->hb_local_ranks = malloc(count * sizeof(int));
+    detector->hb_local_last = calloc(count, sizeof(int64_t));
+    detector->hb_local_rstamp = malloc(count * sizeof(double));
+    if( NULL == detector->hb_local_ranks || NULL == detector->hb_local_last
+     || NULL == detector->hb_local_rstamp ) {
+        free(detector->hb_local_ranks);
+        free(detector->hb_local_last);
+        free(detector->hb_local_rstamp);
+        free(detector->hb_prev_local);
+        detector->hb_local_ranks = detector->hb_prev_local = NULL;
+        detector->hb_local_last = NULL;
+        detector->hb_local_rstamp = NULL;
+        return false;
+    }
+    detector->hb_local_count = count;
+    /* the same slack for MPI_Init as the ring */
+    grace = PMPI_Wtime()+comm_heartbeat_timeout+1.+log((double)np);
+    for( i = (int)(intptr_t)last - 1; 0 <= i; i = detector->hb_prev_local[i] ) {
+        detector->hb_local_ranks[--count] = i;
+        detector->hb_local_rstamp[count] = grace;
+        if( rank == i ) detector->hb_local_index = count;
+    }
+    detector->hb_local_agent = 0;
+
+    if( 0 == detector->hb_local_index && 1 < detector->hb_local_count ) {
+        fd_local_create(detector);
+    }
+    return true;
+}
+
+/* The agent of a node is its lowest live rank */
+static bool fd_local_is_agent(comm_detector_t* detector, int rank)
+{
+    int prev;
+
+    if( !ompi_proc_is_active(ompi_comm_peer_lookup(detector->comm, rank)) ) return false;
+    for( prev = detector->hb_prev_local[rank]; 0 <= prev; prev = detector->hb_prev_local[prev] ) {
+        if( ompi_proc_is_active(ompi_comm_peer_lookup(detector->comm, prev)) ) return false;
+    }
+    return true;
+}
+
+/* Check the slot of local process i, returns true if it is dead */
+static bool fd_local_check(comm_detector_t* detector, int i, double stamp, double lastpeek)
+{
+    ompi_proc_t* proc = ompi_comm_peer_lookup(detector->comm, detector->hb_local_ranks[i]);
+    int64_t beat = detector->hb_local_beats[i];
+
+    if( !ompi_proc_is_active(proc) ) return true;
+    if( FD_LOCAL_DEPARTED == beat ) return false;
+    if( beat != detector->hb_local_last[i] ) {
+        detector->hb_local_last[i] = beat;
+        detector->hb_local_rstamp[i] = stamp;
+        return false;
+    }
+    if( stamp <= (detector->hb_local_rstamp[i] + detector->hb_timeout) ) return false;
+    if( (stamp - lastpeek) >= detector->hb_period
+     && lastpeek <= (detector->hb_local_rstamp[i] + detector->hb_timeout) ) {
+        /* we had event jitter, same slack as the ring */
+        return false;
+    }
+
+    opal_output_verbose(1, ompi_ftmpi_output_handle,
+                        "%s %s: evtimer triggered at stamp %g, local grace MISSED by %.1e, proc %d now suspected dead.",
+                        OMPI_NAME_PRINT(OMPI_PROC_MY_NAME), __func__, stamp-startdate,
+                        detector->hb_timeout - (stamp - detector->hb_local_rstamp[i]),
+                        detector->hb_local_ranks[i]);
+    /* mark this process dead and forward */
+    ompi_errhandler_proc_failed(proc);
+    return true;
+}
+
+/* The agent of the node failed, the lowest live process takes over */
+static void fd_local_elect(comm_detector_t* detector, double stamp)
+{
+    int np = ompi_comm_size(detector->comm);
+    int i;
+
+    for( i = 0; i < detector->hb_local_index; i++ ) {
+        if( ompi_proc_is_active(ompi_comm_peer_lookup(detector->comm, detector->hb_local_ranks[i])) ) break;
+    }
+    detector->hb_local_agent = i;
+    detector->hb_local_rstamp[i] = stamp;
+    if( i != detector->hb_local_index ) return;
+
+    opal_output_verbose(1, ompi_ftmpi_output_handle,
+                        "%s %s: evtimer triggered at stamp %g, taking over as the agent of the node.",
+                        OMPI_NAME_PRINT(OMPI_PROC_MY_NAME), __func__, stamp-startdate);
+    for( i = 0; i < detector->hb_local_count; i++ ) {
+        detector->hb_local_rstamp[i] = stamp;
+    }
+    fd_event_schedule(detector, detector->hb_period / 10.);
+    /* join the ring; the next agent sends us its request once it learns
+     * the failure */
+    detector->hb_observing = (np+ompi_comm_rank(detector->comm)-1) % np;
+    detector->hb_rdma_flag = -2;
+    fd_heartbeat_request(detector);
+}
+
+static void fd_local_event(comm_detector_t* detector, double stamp, double lastpeek)
+{
+    opal_atomic_int64_t* beats = detector->hb_local_beats;
+    int i;
+
+    if( NULL == beats ) return; /* not attached yet */
+
+    if( FD_LOCAL_DEPARTED != beats[detector->hb_local_index] ) {
+        (void)opal_atomic_add_fetch_64(&beats[detector->hb_local_index], 1);
+    }
+
+    if( detector->hb_local_agent == detector->hb_local_index ) {
+        for( i = 0; i < detector->hb_local_count; i++ ) {
+            if( i == detector->hb_local_index ) continue;
+            (void)fd_local_check(detector, i, stamp, lastpeek);
+        }
+        return;
+    }
+
+    if( fd_local_check(detector, detector->hb_local_agent, stamp, lastpeek) ) {
+        fd_local_elect(detector, stamp);
+    }
+}
+
+static int fd_local_attach_cb(ompi_communicator_t* comm, ompi_comm_local_attach_t* msg) {
+    comm_detector_t* detector = &comm_world_detector;
+    opal_atomic_int64_t* beats;
+
+    if( NULL != detector->hb_local_beats ) return false;
+
+    memcpy(&detector->hb_local_ds, &msg->ds[0], msg->ds_size);
+    beats = opal_shmem_segment_attach(&detector->hb_local_ds);
+    if( NULL == beats ) {
+        opal_output_verbose(1, ompi_ftmpi_output_handle,
+                            "%s %s: could not attach the shared segment of the node from %d, not observed locally",
+                            OMPI_NAME_PRINT(OMPI_PROC_MY_NAME), __func__, msg->from);
+        return false;
+    }
+    OPAL_OUTPUT_VERBOSE((2, ompi_ftmpi_output_handle,
+                         "%s %s: attached the shared segment of the node from %d",
+                         OMPI_NAME_PRINT(OMPI_PROC_MY_NAME), __func__, msg->from));
+    opal_atomic_wmb();
+    detector->hb_local_beats = beats;
+    return false; /* never forward on the rbcast */
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020 The University of Tennessee and The University
+ * Copyright (c) 2013-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  *
@@ -11,6 +11,8 @@
  * $HEADER$
  */
 #include "opal/mca/base/mca_base_var.h"
+#include "opal/class/opal_hash_table.h"
+#include "opal/mca/pmix/pmix-internal.h"
 
 #include "ompi/runtime/params.h"
 #include "ompi/group/group.h"
@@ -23,6 +25,7 @@
 
 static int ompi_comm_rbcast_null(ompi_communicator_t* comm, ompi_comm_rbcast_message_t* msg, size_t size) { return OMPI_SUCCESS; }
 static int ompi_comm_rbcast_bmg(ompi_communicator_t* comm, ompi_comm_rbcast_message_t* msg, size_t size);
+static int ompi_comm_rbcast_hbmg(ompi_communicator_t* comm, ompi_comm_rbcast_message_t* msg, size_t size);
 static int ompi_comm_rbcast_n2(ompi_communicator_t* comm, ompi_comm_rbcast_message_t* msg, size_t size);
 
        int (*ompi_comm_rbcast)      (ompi_communicator_t* comm, ompi_comm_rbcast_message_t* msg, size_t size) = ompi_comm_rbcast_null;
@@ -96,6 +99,203 @@ static int ompi_comm_rbcast_bmg(ompi_communicator_t* comm, ompi_comm_rbcast_mess
     return OMPI_SUCCESS;
 }
 
+/* The processes of a communicator grouped by node, in the index space of
+ * ompi_comm_rbcast_bmg. Allocated in one block, see ompi_comm_rbcast_topo. */
+typedef struct ompi_comm_rbcast_topo_t {
+    int nnodes;      /* 0 when the nodes are not known */
+    int* node_of;    /* node of each index */
+    int* node_start; /* first member of each node, nnodes+1 entries */
+    int* members;    /* the indices, grouped by node */
+} ompi_comm_rbcast_topo_t;
+
+static inline ompi_proc_t* ompi_comm_rbcast_peer(ompi_group_t* lgrp, ompi_group_t* hgrp, int idx) {
+    if(OPAL_LIKELY( idx < ompi_group_size(lgrp) )) {
+        return ompi_group_peer_lookup(lgrp, idx);
+    }
+    return ompi_group_peer_lookup(hgrp, idx-ompi_group_size(lgrp));
+}
+
+/* Get the node layout of comm, and build it on first use */
+static ompi_comm_rbcast_topo_t* ompi_comm_rbcast_topo(ompi_communicator_t* comm, int np,
+                                                      ompi_group_t* lgrp, ompi_group_t* hgrp) {
+    ompi_comm_rbcast_topo_t* topo = comm->rbcast_topo, * expected = NULL;
+    uint32_t nodeid, *pnodeid = &nodeid;
+    opal_process_name_t name;
+    opal_hash_table_t nodes;
+    void* value;
+    int i, n, ret;
+
+    if( NULL != topo ) return topo;
+
+    topo = malloc(sizeof(*topo) + (3*np+1)*sizeof(int));
+    if( NULL == topo ) return NULL;
+    topo->node_of    = (int*)(topo+1);
+    topo->node_start = topo->node_of + np;
+    topo->members    = topo->node_start + np + 1;
+    topo->nnodes     = 0;
+
+    OBJ_CONSTRUCT(&nodes, opal_hash_table_t);
+    opal_hash_table_init(&nodes, 64);
+    for( i = 0; i < np; i++ ) {
+        if( i < ompi_group_size(lgrp) ) {
+            name = ompi_group_get_proc_name(lgrp, i);
+        }
+        else {
+            name = ompi_group_get_proc_name(hgrp, i-ompi_group_size(lgrp));
+        }
+        OPAL_MODEX_RECV_VALUE(ret, PMIX_NODEID, &name, &pnodeid, PMIX_UINT32);
+        if( PMIX_SUCCESS != ret ) break;
+        if( OPAL_SUCCESS != opal_hash_table_get_value_uint32(&nodes, nodeid, &value) ) {
+            value = (void*)(intptr_t)topo->nnodes++;
+            opal_hash_table_set_value_uint32(&nodes, nodeid, value);
+        }
+        topo->node_of[i] = (int)(intptr_t)value;
+    }
+    OBJ_DESTRUCT(&nodes);
+
+    if( i < np ) {
+        /* no node ids, the plain binomial graph is used */
+        topo->nnodes = 0;
+    }
+    else {
+        /* counting sort of the indices by node; filling the members moves
+         * each node_start to the start of the next node, shift them back */
+        memset(topo->node_start, 0, (topo->nnodes+1)*sizeof(int));
+        for( i = 0; i < np; i++ ) topo->node_start[topo->node_of[i]+1]++;
+        for( n = 0; n < topo->nnodes; n++ ) topo->node_start[n+1] += topo->node_start[n];
+        for( i = 0; i < np; i++ ) topo->members[topo->node_start[topo->node_of[i]]++] = i;
+        for( n = topo->nnodes; n > 0; n-- ) topo->node_start[n] = topo->node_start[n-1];
+        topo->node_start[0] = 0;
+    }
+
+    if( !opal_atomic_compare_exchange_strong_ptr((opal_atomic_intptr_t*)&comm->rbcast_topo,
+                                                 (intptr_t*)&expected, (intptr_t)topo) ) {
+        /* another thread was faster */
+        free(topo);
+        topo = expected;
+    }
+    return topo;
+}
+
+/* Is the local rank mylocal the sender of the inter node link e? The link
+ * is sent by the first alive process of the node from local rank e. */
+static bool ompi_comm_rbcast_link_owner(ompi_comm_rbcast_topo_t* topo, ompi_group_t* lgrp, ompi_group_t* hgrp,
+                                        int node, int mylocal, int e) {
+    int j, l, size = topo->node_start[node+1] - topo->node_start[node];
+
+    for( j = 0; j < size; j++ ) {
+        l = (e+j)%size;
+        if( l == mylocal ) return true;
+        if( ompi_proc_is_active(ompi_comm_rbcast_peer(lgrp, hgrp, topo->members[topo->node_start[node]+l])) ) {
+            return false;
+        }
+    }
+    return false;
+}
+
+/* The alive process of node with the closest local rank from local, NULL
+ * if they are all dead */
+static ompi_proc_t* ompi_comm_rbcast_node_peer(ompi_comm_rbcast_topo_t* topo, ompi_group_t* lgrp, ompi_group_t* hgrp,
+                                               int node, int local) {
+    int j, size = topo->node_start[node+1] - topo->node_start[node];
+    ompi_proc_t* proc;
+
+    for( j = 0; j < size; j++ ) {
+        proc = ompi_comm_rbcast_peer(lgrp, hgrp, topo->members[topo->node_start[node]+(local+j)%size]);
+        if( ompi_proc_is_active(proc) ) return proc;
+    }
+    return NULL;
+}
+
+/* Broadcast a rbcast token in a BMG between the processes of my node, then
+ * in a BMG between the nodes: each link between two nodes is sent by a
+ * single process of the node, to the process of the same local rank on the
+ * other node, so that the nodes exchange the token over log(nnodes) links
+ * instead of log(np) links per process. The failure of some processes of a
+ * node changes the owner of their links; the ring between the nodes is cut
+ * only when all the processes of a node are dead. */
+static int ompi_comm_rbcast_hbmg(ompi_communicator_t* comm, ompi_comm_rbcast_message_t* msg, size_t size) {
+    int me, np, ret;
+    int i, d, e, s, node, mynode, local, mylocal;
+    ompi_group_t* lgrp, * hgrp = NULL;
+    ompi_comm_rbcast_topo_t* topo;
+    ompi_proc_t* proc;
+    int* members;
+
+    if( OMPI_COMM_IS_INTER(comm) ) {
+        int first = ompi_comm_determine_first_auto(comm);
+        np = ompi_comm_size(comm) + ompi_comm_remote_size(comm);
+        lgrp = first? comm->c_local_group: comm->c_remote_group;
+        hgrp = first? comm->c_remote_group: comm->c_local_group;
+        me = first? ompi_comm_rank(comm): ompi_comm_rank(comm)+ompi_comm_remote_size(comm);
+    }
+    else {
+        np = ompi_comm_size(comm);
+        lgrp = comm->c_local_group;
+        me = ompi_comm_rank(comm);
+    }
+
+    topo = ompi_comm_rbcast_topo(comm, np, lgrp, hgrp);
+    if( NULL == topo || 0 == topo->nnodes ) {
+        return ompi_comm_rbcast_bmg(comm, msg, size);
+    }
+
+    OPAL_OUTPUT_VERBOSE((5, ompi_ftmpi_output_handle,
+                         "%s %s: rbcast on communicator %3d:%d (%d nodes)",
+                         OMPI_NAME_PRINT(OMPI_PROC_MY_NAME), __func__, msg->cid, msg->epoch, topo->nnodes ));
+
+    mynode = topo->node_of[me];
+    members = topo->members + topo->node_start[mynode];
+    s = topo->node_start[mynode+1] - topo->node_start[mynode];
+    for( mylocal = 0; members[mylocal] != me; mylocal++ );
+
+    /* inside the node, same as ompi_comm_rbcast_bmg */
+    for(i = 1; i <= s/2; i *= 2) for(d = 1; d >= -1; d -= 2) {
+        local = (s+mylocal+d*i)%s;
+      redo_local:
+        if( local == mylocal ) continue;
+        proc = ompi_comm_rbcast_peer(lgrp, hgrp, members[local]);
+        if( ompi_proc_is_active(proc) ) {
+            ret = ompi_comm_rbcast_send_msg(proc, msg, size);
+            if(OPAL_LIKELY( OMPI_SUCCESS == ret )) {
+                continue;
+            }
+            if(OPAL_UNLIKELY( OMPI_ERR_UNREACH != ret )) {
+                return ret;
+            }
+        }
+        if( i == 1 ) {
+            local = (s+local+d)%s;
+            goto redo_local;
+        }
+    }
+
+    /* between the nodes, e numbers the links of my node */
+    e = 0;
+    for(i = 1; i <= topo->nnodes/2; i *= 2) for(d = 1; d >= -1; d -= 2, e++) {
+        if( !ompi_comm_rbcast_link_owner(topo, lgrp, hgrp, mynode, mylocal, e) ) continue;
+        node = (topo->nnodes+mynode+d*i)%topo->nnodes;
+      redo_node:
+        if( node == mynode ) continue;
+        proc = ompi_comm_rbcast_node_peer(topo, lgrp, hgrp, node, mylocal);
+        if( NULL != proc ) {
+            ret = ompi_comm_rbcast_send_msg(proc, msg, size);
+            if(OPAL_LIKELY( OMPI_SUCCESS == ret )) {
+                continue;
+            }
+            if(OPAL_UNLIKELY( OMPI_ERR_UNREACH != ret )) {
+                return ret;
+            }
+        }
+        if( i == 1 ) {
+            /* the whole node is dead, or unreachable from here */
+            node = (topo->nnodes+node+d)%topo->nnodes;
+            goto redo_node;
+        }
+    }
+    return OMPI_SUCCESS;
+}
+
 /* Broadcast a rbcast token to everybody (n^2 comms) */
 static int ompi_comm_rbcast_n2(ompi_communicator_t* comm, ompi_comm_rbcast_message_t* msg, size_t size) {
     int i, ret;
@@ -286,7 +486,7 @@ static int rbcast = 1;
 
 int ompi_comm_rbcast_register_params(void) {
     (void) mca_base_var_register ("ompi", "mpi", "ft", "reliable_bcast",
-                                  "Reliable Broadcast algorithm (1: Binomial Graph Diffusion; 2: N^2 full graph diffusion)",
+                                  "Reliable Broadcast algorithm (1: Binomial Graph Diffusion; 2: N^2 full graph diffusion; 3: Binomial Graph Diffusion inside and between the nodes)",
                                   MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
                                   OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY, &rbcast);
     return OMPI_SUCCESS;
@@ -306,6 +506,10 @@ int ompi_comm_rbcast_init(void) {
             ompi_comm_rbcast    = ompi_comm_rbcast_n2;
             ompi_comm_rbcast_fw = ompi_comm_rbcast_n2;
             break;
+        case 3:
+            ompi_comm_rbcast    = ompi_comm_rbcast_hbmg;
+            ompi_comm_rbcast_fw = ompi_comm_rbcast_hbmg;
+            break;
         default:
             return OMPI_ERR_BAD_PARAM;
     }
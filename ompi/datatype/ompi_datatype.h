@@ -115,7 +115,7 @@ typedef struct ompi_predefined_datatype_t ompi_predefined_datatype_t;
 /* Base convertor for all external32 operations */
 OMPI_DECLSPEC extern opal_convertor_t* ompi_mpi_external32_convertor;
 OMPI_DECLSPEC extern opal_convertor_t* ompi_mpi_local_convertor;
-extern struct opal_pointer_array_t ompi_datatype_f_to_c_table;
+OMPI_DECLSPEC extern struct opal_pointer_array_t ompi_datatype_f_to_c_table;
 
 OMPI_DECLSPEC int32_t ompi_datatype_init( void );
 OMPI_DECLSPEC int32_t ompi_datatype_finalize( void );
@@ -171,6 +171,93 @@ cyclic(const int *gsize_array, int dim, int ndims, int nprocs,
     return OMPI_SUCCESS;
 }
 
+/*
+ * Block distributions, and cyclic ones giving a single block or tiling their
+ * dimension, select a regular slab of the global array: the darray is then a
+ * subarray (the cyclic dimensions being split in two), which is described by
+ * a few nested vectors instead of a struct per dimension. Returns
+ * OMPI_ERR_NOT_SUPPORTED for the other distributions.
+ */
+static int
+darray_as_subarray(int ndims, int const* gsize_array, int const* distrib_array,
+                   int const* darg_array, int const* psize_array, const int *coords,
+                   int order, const ompi_datatype_t *oldtype, ompi_datatype_t **newtype)
+{
+    int *sizes, *subsizes, *starts, i, n = 0, rc = OMPI_ERR_NOT_SUPPORTED;
+    int nprocs, rank, blksize, mysize;
+
+    /* a tiling cyclic dimension takes 2 entries */
+    sizes = (int *) malloc(3 * 2 * ndims * sizeof(int));
+    if (NULL == sizes) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    subsizes = sizes + 2 * ndims;
+    starts = subsizes + 2 * ndims;
+
+    for (i = 0; i < ndims; i++) {
+        nprocs = psize_array[i];
+        rank = coords[i];
+        switch(distrib_array[i]) {
+        case MPI_DISTRIBUTE_NONE:
+            /* as in ompi_datatype_create_darray */
+            if (order != MPI_ORDER_C) {
+                nprocs = 1; rank = 0;
+            }
+            /* fall through */
+        case MPI_DISTRIBUTE_BLOCK:
+            if ((MPI_DISTRIBUTE_NONE == distrib_array[i]) ||
+                (MPI_DISTRIBUTE_DFLT_DARG == darg_array[i])) {
+                blksize = (gsize_array[i] + nprocs - 1) / nprocs;
+            } else {
+                blksize = darg_array[i];
+            }
+            if ((ptrdiff_t) blksize * rank >= gsize_array[i]) {
+                goto cleanup;
+            }
+            mysize = gsize_array[i] - blksize * rank;
+            sizes[n] = gsize_array[i];
+            subsizes[n] = blksize < mysize ? blksize : mysize;
+            starts[n] = blksize * rank;
+            n++;
+            break;
+        case MPI_DISTRIBUTE_CYCLIC:
+            blksize = (MPI_DISTRIBUTE_DFLT_DARG == darg_array[i]) ? 1 : darg_array[i];
+            if ((ptrdiff_t) blksize * rank >= gsize_array[i]) {
+                goto cleanup;
+            }
+            if ((ptrdiff_t) blksize * (rank + nprocs) >= gsize_array[i]) {
+                /* a single block for this process */
+                mysize = gsize_array[i] - blksize * rank;
+                sizes[n] = gsize_array[i];
+                subsizes[n] = blksize < mysize ? blksize : mysize;
+                starts[n] = blksize * rank;
+                n++;
+            } else if (0 == gsize_array[i] % (blksize * nprocs)) {
+                /* rounds of nprocs blocks, the outer entry counts the rounds */
+                int outer = n + (MPI_ORDER_C == order ? 0 : 1);
+                int inner = n + (MPI_ORDER_C == order ? 1 : 0);
+                sizes[outer] = subsizes[outer] = gsize_array[i] / (blksize * nprocs);
+                starts[outer] = 0;
+                sizes[inner] = blksize * nprocs;
+                subsizes[inner] = blksize;
+                starts[inner] = blksize * rank;
+                n += 2;
+            } else {
+                goto cleanup;
+            }
+            break;
+        default:
+            goto cleanup;
+        }
+    }
+
+    rc = ompi_datatype_create_subarray(n, sizes, subsizes, starts, order, oldtype, newtype);
+
+ cleanup:
+    free(sizes);
+    return rc;
+}
+
 int32_t ompi_datatype_create_darray(int size,
                                     int rank,
                                     int ndims,
@@ -213,6 +300,13 @@ int32_t ompi_datatype_create_darray(int size,
         }
     }
 
+    rc = darray_as_subarray(ndims, gsize_array, distrib_array, darg_array, psize_array,
+                            coords, order, oldtype, newtype);
+    if (OMPI_ERR_NOT_SUPPORTED != rc) {
+        goto cleanup;
+    }
+    rc = OMPI_SUCCESS;
+
     st_offsets = (ptrdiff_t *) malloc(ndims * sizeof(ptrdiff_t));
 
     /* duplicate type to here to 1) deal with constness without
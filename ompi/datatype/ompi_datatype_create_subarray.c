@@ -24,6 +24,7 @@
 
 #include "ompi_config.h"
 
+#include <limits.h>
 #include <stddef.h>
 
 #include "ompi/datatype/ompi_datatype.h"
@@ -37,7 +38,8 @@ int32_t ompi_datatype_create_subarray(int ndims,
                                       ompi_datatype_t** newtype)
 {
     ompi_datatype_t *last_type;
-    int32_t i, step, end_loop;
+    int32_t i, n, step, end_loop;
+    int *sizes, *subsizes, *starts;
     MPI_Aint size, displ, extent;
 
     /**
@@ -49,15 +51,9 @@ int32_t ompi_datatype_create_subarray(int ndims,
     ompi_datatype_type_extent( oldtype, &extent );
 
     /* If the ndims is zero then return the NULL datatype */
-    if( ndims < 2 ) {
-        if( 0 == ndims ) {
-            ompi_datatype_duplicate(&ompi_mpi_datatype_null.dt, newtype);
-            return MPI_SUCCESS;
-        }
-        ompi_datatype_create_contiguous( subsize_array[0], oldtype, &last_type );
-        size = size_array[0];
-        displ = start_array[0];
-        goto replace_subarray_type;
+    if( 0 == ndims ) {
+        ompi_datatype_duplicate(&ompi_mpi_datatype_null.dt, newtype);
+        return MPI_SUCCESS;
     }
 
     if( MPI_ORDER_C == order ) {
@@ -70,27 +66,63 @@ int32_t ompi_datatype_create_subarray(int ndims,
         end_loop = ndims;
     }
 
-    /* As we know that the ndims is at least 1 we can start by creating the
-     * first dimension data outside the loop, such that we dont have to create
+    /**
+     * Fold the dimensions, starting from the fastest varying one. A dimension
+     * is merged into the previous (faster) one when the latter is whole, or
+     * when a single index is selected along it: the type map is the same with
+     * fewer nested vectors, so that the description stays small and the commit
+     * finds the strided shape of the datatype.
+     */
+    sizes = (int*)malloc(3 * ndims * sizeof(int));
+    if( NULL == sizes ) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    subsizes = sizes + ndims;
+    starts = subsizes + ndims;
+    for( n = 0; i != end_loop; i += step ) {
+        if( (n > 0) && ((sizes[n-1] == subsizes[n-1]) || (1 == subsize_array[i])) &&
+            (size_array[i] <= (INT_MAX / sizes[n-1])) ) {
+            if( sizes[n-1] == subsizes[n-1] ) {
+                subsizes[n-1] *= subsize_array[i];
+            }
+            starts[n-1] += start_array[i] * sizes[n-1];
+            sizes[n-1] *= size_array[i];
+            continue;
+        }
+        sizes[n] = size_array[i];
+        subsizes[n] = subsize_array[i];
+        starts[n] = start_array[i];
+        n++;
+    }
+
+    if( 1 == n ) {
+        ompi_datatype_create_contiguous( subsizes[0], oldtype, &last_type );
+        size = sizes[0];
+        displ = starts[0];
+        goto replace_subarray_type;
+    }
+
+    /* As we know that there are at least 2 dimensions left we can start by
+     * creating the first 2 outside the loop, such that we dont have to create
      * a duplicate of the oldtype just to be able to free it.
      */
-    ompi_datatype_create_vector( subsize_array[i+step], subsize_array[i], size_array[i],
-                                 oldtype, newtype );
+    ompi_datatype_create_vector( subsizes[1], subsizes[0], sizes[0], oldtype, newtype );
 
     last_type = *newtype;
-    size = (MPI_Aint)size_array[i] * (MPI_Aint)size_array[i+step];
-    displ = (MPI_Aint)start_array[i] + (MPI_Aint)start_array[i+step] * (MPI_Aint)size_array[i];
-    for( i += 2 * step; i != end_loop; i += step ) {
-        ompi_datatype_create_hvector( subsize_array[i], 1, size * extent,
+    size = (MPI_Aint)sizes[0] * (MPI_Aint)sizes[1];
+    displ = (MPI_Aint)starts[0] + (MPI_Aint)starts[1] * (MPI_Aint)sizes[0];
+    for( i = 2; i < n; i++ ) {
+        ompi_datatype_create_hvector( subsizes[i], 1, size * extent,
                                       last_type, newtype );
         ompi_datatype_destroy( &last_type );
 
-        displ += size * start_array[i];
-        size *= size_array[i];
+        displ += size * starts[i];
+        size *= sizes[i];
         last_type = *newtype;
     }
 
  replace_subarray_type:
+    free(sizes);
     /**
       * We need to shift the content (useful data) of the datatype, so
       * we need to force the displacement to be moved. Therefore, we
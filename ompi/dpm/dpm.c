@@ -82,6 +82,20 @@ static OBJ_CLASS_INSTANCE(ompi_dpm_proct_caddy_t,
                           opal_list_item_t,
                           NULL, NULL);
 
+typedef struct {
+    volatile bool active;
+    pmix_status_t status;
+} ompi_dpm_connect_status_t;
+
+static void connect_release(pmix_status_t status, void *cbdata)
+{
+    ompi_dpm_connect_status_t *cstat = (ompi_dpm_connect_status_t*)cbdata;
+
+    cstat->status = status;
+    OPAL_POST_OBJECT(cstat);
+    cstat->active = false;
+}
+
 /*
  * Init the module
  */
@@ -119,8 +133,9 @@ int ompi_dpm_connect_accept(ompi_communicator_t *comm, int root,
     ompi_group_t *group=comm->c_local_group;
     ompi_proc_t **proc_list=NULL, **new_proc_list = NULL;
     int32_t i;
-    ompi_group_t *new_group_pointer;
+    ompi_group_t *new_group_pointer = NULL;
     ompi_dpm_proct_caddy_t *cd;
+    ompi_dpm_connect_status_t cstat;
 
     /* set default error return */
     *newcomm = MPI_COMM_NULL;
@@ -287,11 +302,7 @@ bcast_rportlen:
     members = opal_argv_split(rport, ':');
     free(rport);
 
-    /* add the list of remote procs to our list, and
-     * keep a list of them for later */
-    OBJ_CONSTRUCT(&ilist, opal_list_t);
-    OBJ_CONSTRUCT(&rlist, opal_list_t);
-
+    /* add the list of remote procs to our list of participants */
     for (i=0; NULL != members[i]; i++) {
         OPAL_PMIX_CONVERT_STRING_TO_PROCT(&pxproc, members[i]);
         plt = OBJ_NEW(opal_proclist_t);
@@ -306,46 +317,61 @@ bcast_rportlen:
                 /* just protect against the error */
                 OMPI_ERROR_LOG(OMPI_ERR_BAD_PARAM);
                 opal_argv_free(members);
-                OPAL_LIST_DESTRUCT(&ilist);
-                OPAL_LIST_DESTRUCT(&rlist);
                 OPAL_LIST_DESTRUCT(&mlist);
                 rc = OMPI_ERR_BAD_PARAM;
                 goto exit;
             }
-            rsize = strtoul(members[i+1], NULL, 10);
             ++i;
-            for (k=0; k < rsize; k++) {
-                pxproc.rank = k;
-                OPAL_PMIX_CONVERT_PROCT(rc, &pname, &pxproc);
-                if (OPAL_SUCCESS != rc) {
-                    OMPI_ERROR_LOG(rc);
-                    opal_argv_free(members);
-                    OPAL_LIST_DESTRUCT(&ilist);
-                    OPAL_LIST_DESTRUCT(&rlist);
-                    OPAL_LIST_DESTRUCT(&mlist);
-                    goto exit;
-                }
-                /* see if this needs to be added to our ompi_proc_t array */
-                proc = ompi_proc_find_and_add(&pname, &isnew);
-                if (isnew) {
-                    cd = OBJ_NEW(ompi_dpm_proct_caddy_t);
-                    cd->p = proc;
-                    opal_list_append(&ilist, &cd->super);
-                }
-                /* either way, add to the remote list */
-                cd = OBJ_NEW(ompi_dpm_proct_caddy_t);
-                cd->p = proc;
-                opal_list_append(&rlist, &cd->super);
-            }
-        } else {
+        }
+    }
+
+    /* convert the list of members to a pmix_proc_t array */
+    nprocs = opal_list_get_size(&mlist);
+    PMIX_PROC_CREATE(procs, nprocs);
+    n = 0;
+    OPAL_LIST_FOREACH(plt, &mlist, opal_proclist_t) {
+        memcpy(&procs[n], &plt->procid, sizeof(pmix_proc_t));
+        ++n;
+    }
+    OPAL_LIST_DESTRUCT(&mlist);
+
+    /* tell the host RTE to connect us - this will download
+     * all known data for the nspace's of participating procs
+     * so that add_procs will not result in a slew of lookups.
+     * The ompi_proc_t and the remote group do not need this
+     * data, they are built while the connect progresses */
+    PMIX_INFO_CONSTRUCT(&tinfo);
+    PMIX_INFO_LOAD(&tinfo, PMIX_TIMEOUT, &ompi_pmix_connect_timeout, PMIX_UINT32);
+    cstat.active = true;
+    pret = PMIx_Connect_nb(procs, nprocs, &tinfo, 1, connect_release, &cstat);
+    if (PMIX_SUCCESS != pret) {
+        cstat.active = false;
+        cstat.status = pret;
+    }
+
+    /* keep a list of the remote procs for later, and of the new ones
+     * to be added to the PML */
+    OBJ_CONSTRUCT(&ilist, opal_list_t);
+    OBJ_CONSTRUCT(&rlist, opal_list_t);
+
+    for (i=0; NULL != members[i]; i++) {
+        OPAL_PMIX_CONVERT_STRING_TO_PROCT(&pxproc, members[i]);
+        rsize = 1;
+        k = pxproc.rank;
+        if (PMIX_RANK_WILDCARD == pxproc.rank) {
+            /* the next entry is the number of procs in the job, checked above */
+            rsize = strtoul(members[++i], NULL, 10);
+            k = 0;
+        }
+        for (rsize += k; k < rsize; k++) {
+            pxproc.rank = k;
             OPAL_PMIX_CONVERT_PROCT(rc, &pname, &pxproc);
             if (OPAL_SUCCESS != rc) {
                 OMPI_ERROR_LOG(rc);
                 opal_argv_free(members);
                 OPAL_LIST_DESTRUCT(&ilist);
                 OPAL_LIST_DESTRUCT(&rlist);
-                OPAL_LIST_DESTRUCT(&mlist);
-                goto exit;
+                goto wait_connect;
             }
             /* see if this needs to be added to our ompi_proc_t array */
             proc = ompi_proc_find_and_add(&pname, &isnew);
@@ -362,29 +388,37 @@ bcast_rportlen:
     }
     opal_argv_free(members);
 
-    /* convert the list of members to a pmix_proc_t array */
-    nprocs = opal_list_get_size(&mlist);
-    PMIX_PROC_CREATE(procs, nprocs);
-    n = 0;
-    OPAL_LIST_FOREACH(plt, &mlist, opal_proclist_t) {
-        memcpy(&procs[n], &plt->procid, sizeof(pmix_proc_t));
-        ++n;
+    /* now deal with the remote group */
+    rsize = opal_list_get_size(&rlist);
+    new_group_pointer=ompi_group_allocate(rsize);
+    if (NULL == new_group_pointer) {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+        OPAL_LIST_DESTRUCT(&ilist);
+        OPAL_LIST_DESTRUCT(&rlist);
+        goto wait_connect;
     }
-    OPAL_LIST_DESTRUCT(&mlist);
+    /* assign group elements */
+    i=0;
+    OPAL_LIST_FOREACH(cd, &rlist, ompi_dpm_proct_caddy_t) {
+        new_group_pointer->grp_proc_pointers[i++] = cd->p;
+        /* retain the proc */
+        OBJ_RETAIN(cd->p);
+    }
+    OPAL_LIST_DESTRUCT(&rlist);
 
-    /* tell the host RTE to connect us - this will download
-     * all known data for the nspace's of participating procs
-     * so that add_procs will not result in a slew of lookups */
-    PMIX_INFO_CONSTRUCT(&tinfo);
-    PMIX_INFO_LOAD(&tinfo, PMIX_TIMEOUT, &ompi_pmix_connect_timeout, PMIX_UINT32);
-    pret = PMIx_Connect(procs, nprocs, &tinfo, 1);
+ wait_connect:
+    /* the participants, and the info, must be kept until the connect completes */
+    OMPI_LAZY_WAIT_FOR_COMPLETION(cstat.active);
     PMIX_INFO_DESTRUCT(&tinfo);
     PMIX_PROC_FREE(procs, nprocs);
-    rc = opal_pmix_convert_status(pret);
+    if (OMPI_SUCCESS != rc) {
+        goto exit;
+    }
+    rc = opal_pmix_convert_status(cstat.status);
     if (OPAL_SUCCESS != rc) {
         OMPI_ERROR_LOG(rc);
         OPAL_LIST_DESTRUCT(&ilist);
-        OPAL_LIST_DESTRUCT(&rlist);
+        OBJ_RELEASE(new_group_pointer);
         goto exit;
     }
     if (0 < opal_list_get_size(&ilist)) {
@@ -453,35 +487,23 @@ bcast_rportlen:
         if (NULL != peer_ranks) {
             free(peer_ranks);
         }
-        /* call add_procs on the new ones */
-        rc = MCA_PML_CALL(add_procs(new_proc_list, opal_list_get_size(&ilist)));
+        /* call add_procs on the new ones, unless the PML can add them
+         * on their first use */
+        rc = OMPI_SUCCESS;
+        if (!ompi_dpm_lazy_add_procs || mca_pml_base_requires_world()) {
+            rc = MCA_PML_CALL(add_procs(new_proc_list, opal_list_get_size(&ilist)));
+        }
         free(new_proc_list);
         new_proc_list = NULL;
         if (OMPI_SUCCESS != rc) {
             OMPI_ERROR_LOG(rc);
             OPAL_LIST_DESTRUCT(&ilist);
+            OBJ_RELEASE(new_group_pointer);
             goto exit;
         }
     }
     OPAL_LIST_DESTRUCT(&ilist);
 
-    /* now deal with the remote group */
-    rsize = opal_list_get_size(&rlist);
-    new_group_pointer=ompi_group_allocate(rsize);
-    if (NULL == new_group_pointer) {
-        rc = OMPI_ERR_OUT_OF_RESOURCE;
-        OPAL_LIST_DESTRUCT(&rlist);
-        goto exit;
-    }
-    /* assign group elements */
-    i=0;
-    OPAL_LIST_FOREACH(cd, &rlist, ompi_dpm_proct_caddy_t) {
-        new_group_pointer->grp_proc_pointers[i++] = cd->p;
-        /* retain the proc */
-        OBJ_RETAIN(cd->p);
-    }
-    OPAL_LIST_DESTRUCT(&rlist);
-
     /* set up communicator structure */
     rc = ompi_comm_set ( &newcomp,                 /* new comm */
                          comm,                     /* old comm */
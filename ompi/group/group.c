@@ -26,6 +26,7 @@
  */
 
 #include "ompi_config.h"
+#include "opal/class/opal_hash_table.h"
 #include "ompi/group/group.h"
 #include "ompi/constants.h"
 #include "ompi/proc/proc.h"
@@ -43,6 +44,139 @@ int ompi_group_free ( ompi_group_t **group )
     return OMPI_SUCCESS;
 }
 
+#if OMPI_GROUP_SPARSE
+/* from a sparse child to its parent */
+static int ompi_group_translate_ranks_to_parent (ompi_group_t *child, int n_ranks,
+                                                 const int *ranks1, int *ranks2)
+{
+    if(OMPI_GROUP_IS_SPORADIC(child)) {
+        return ompi_group_translate_ranks_sporadic_reverse
+            (child,n_ranks,ranks1,child->grp_parent_group_ptr,ranks2);
+    }
+    else if(OMPI_GROUP_IS_STRIDED(child)) {
+        return ompi_group_translate_ranks_strided_reverse
+            (child,n_ranks,ranks1,child->grp_parent_group_ptr,ranks2);
+    }
+    else if(OMPI_GROUP_IS_BITMAP(child)) {
+        return ompi_group_translate_ranks_bmap_reverse
+            (child,n_ranks,ranks1,child->grp_parent_group_ptr,ranks2);
+    }
+
+    /* unknown sparse group type */
+    assert (0);
+    return OMPI_ERR_BAD_PARAM;
+}
+
+/* from a parent to its sparse child */
+static int ompi_group_translate_ranks_to_child (ompi_group_t *child, int n_ranks,
+                                                const int *ranks1, int *ranks2)
+{
+    if(OMPI_GROUP_IS_SPORADIC(child)) {
+        return ompi_group_translate_ranks_sporadic
+            (child->grp_parent_group_ptr,n_ranks,ranks1,child,ranks2);
+    }
+    else if(OMPI_GROUP_IS_STRIDED(child)) {
+        return ompi_group_translate_ranks_strided
+            (child->grp_parent_group_ptr,n_ranks,ranks1,child,ranks2);
+    }
+    else if(OMPI_GROUP_IS_BITMAP(child)) {
+        return ompi_group_translate_ranks_bmap
+            (child->grp_parent_group_ptr,n_ranks,ranks1,child,ranks2);
+    }
+
+    /* unknown sparse group type */
+    assert (0);
+    return OMPI_ERR_BAD_PARAM;
+}
+
+/* number of sparse levels between group and its ancestor, -1 if not an ancestor */
+static int ompi_group_ancestor_depth (ompi_group_t *group, ompi_group_t *ancestor)
+{
+    int depth = 0;
+
+    for ( ; NULL != group ; group = group->grp_parent_group_ptr, ++depth) {
+        if (group == ancestor) {
+            return depth;
+        }
+    }
+    return -1;
+}
+
+/* Walk from group1 down to its descendant group2, one level at a time */
+static int ompi_group_translate_ranks_down (ompi_group_t *group1, int depth, int n_ranks,
+                                            const int *ranks1, ompi_group_t *group2, int *ranks2)
+{
+    ompi_group_t *child;
+    int rc;
+
+    for (int level = depth ; level > 0 ; --level) {
+        /* the child of the current ancestor on the way to group2 */
+        child = group2;
+        for (int i = 1 ; i < level ; ++i) {
+            child = child->grp_parent_group_ptr;
+        }
+        rc = ompi_group_translate_ranks_to_child (child, n_ranks, ranks1, ranks2);
+        if (OMPI_SUCCESS != rc) {
+            return rc;
+        }
+        /* ranks missing from a level stay MPI_UNDEFINED on the way down */
+        ranks1 = ranks2;
+    }
+    return OMPI_SUCCESS;
+}
+#endif  /* OMPI_GROUP_SPARSE */
+
+/* Above this many name comparisons the generic translation builds a hash
+ * table of group2 instead of scanning it for each rank */
+#define OMPI_GROUP_TRANSLATE_HASH_MIN (64 * 1024)
+
+static int ompi_group_translate_ranks_hash (ompi_group_t *group1, int n_ranks,
+                                            const int *ranks1, ompi_group_t *group2,
+                                            int *ranks2)
+{
+    opal_process_name_t name;
+    opal_hash_table_t table;
+    void *value;
+    int rc;
+
+    OBJ_CONSTRUCT(&table, opal_hash_table_t);
+    rc = opal_hash_table_init (&table, group2->grp_proc_count);
+    if (OPAL_SUCCESS != rc) {
+        OBJ_DESTRUCT(&table);
+        return rc;
+    }
+
+    /* walk group2 backward so the lowest rank wins, as in the linear scan */
+    for (int proc2 = group2->grp_proc_count - 1 ; proc2 >= 0 ; --proc2) {
+        name = ompi_group_get_proc_name (group2, proc2);
+        rc = opal_hash_table_set_value_ptr (&table, &name, sizeof (name),
+                                            (void *) (intptr_t) proc2);
+        if (OPAL_SUCCESS != rc) {
+            OBJ_DESTRUCT(&table);
+            return rc;
+        }
+    }
+
+    for (int proc = 0 ; proc < n_ranks ; ++proc) {
+        int rank = ranks1[proc];
+
+        if ( MPI_PROC_NULL == rank) {
+            ranks2[proc] = MPI_PROC_NULL;
+            continue;
+        }
+
+        name = ompi_group_get_proc_name (group1, rank);
+        if (OPAL_SUCCESS == opal_hash_table_get_value_ptr (&table, &name, sizeof (name), &value)) {
+            ranks2[proc] = (int) (intptr_t) value;
+        } else {
+            ranks2[proc] = MPI_UNDEFINED;
+        }
+    }
+
+    OBJ_DESTRUCT(&table);
+    return OMPI_SUCCESS;
+}
+
 int ompi_group_translate_ranks ( ompi_group_t *group1,
                                  int n_ranks, const int *ranks1,
                                  ompi_group_t *group2,
@@ -64,42 +198,47 @@ int ompi_group_translate_ranks ( ompi_group_t *group1,
      * find a match.
      */
     if( group1->grp_parent_group_ptr == group2 ) { /* from child to parent */
-        if(OMPI_GROUP_IS_SPORADIC(group1)) {
-            return ompi_group_translate_ranks_sporadic_reverse
-                (group1,n_ranks,ranks1,group2,ranks2);
-        }
-        else if(OMPI_GROUP_IS_STRIDED(group1)) {
-            return ompi_group_translate_ranks_strided_reverse
-                (group1,n_ranks,ranks1,group2,ranks2);
-        }
-        else if(OMPI_GROUP_IS_BITMAP(group1)) {
-            return ompi_group_translate_ranks_bmap_reverse
-                (group1,n_ranks,ranks1,group2,ranks2);
-        }
-
-        /* unknown sparse group type */
-        assert (0);
+        return ompi_group_translate_ranks_to_parent (group1, n_ranks, ranks1, ranks2);
     }
 
     if( group2->grp_parent_group_ptr == group1 ) { /* from parent to child*/
-        if(OMPI_GROUP_IS_SPORADIC(group2)) {
-            return ompi_group_translate_ranks_sporadic
-                (group1,n_ranks,ranks1,group2,ranks2);
-        }
-        else if(OMPI_GROUP_IS_STRIDED(group2)) {
-            return ompi_group_translate_ranks_strided
-                (group1,n_ranks,ranks1,group2,ranks2);
+        return ompi_group_translate_ranks_to_child (group2, n_ranks, ranks1, ranks2);
+    }
+
+    /* the same through several levels of sparse groups */
+    if (NULL != group1->grp_parent_group_ptr &&
+        0 < ompi_group_ancestor_depth (group1, group2)) {
+        int rc;
+
+        rc = ompi_group_translate_ranks_to_parent (group1, n_ranks, ranks1, ranks2);
+        if (OMPI_SUCCESS != rc) {
+            return rc;
         }
-        else if(OMPI_GROUP_IS_BITMAP(group2)) {
-            return ompi_group_translate_ranks_bmap
-                (group1,n_ranks,ranks1,group2,ranks2);
+        for (group1 = group1->grp_parent_group_ptr ; group1 != group2 ;
+             group1 = group1->grp_parent_group_ptr) {
+            rc = ompi_group_translate_ranks_to_parent (group1, n_ranks, ranks2, ranks2);
+            if (OMPI_SUCCESS != rc) {
+                return rc;
+            }
         }
+        return OMPI_SUCCESS;
+    }
 
-        /* unknown sparse group type */
-        assert (0);
+    if (NULL != group2->grp_parent_group_ptr) {
+        int depth = ompi_group_ancestor_depth (group2, group1);
+        if (0 < depth) {
+            return ompi_group_translate_ranks_down (group1, depth, n_ranks, ranks1,
+                                                    group2, ranks2);
+        }
     }
 #endif
 
+    if ((size_t) n_ranks * group2->grp_proc_count >= OMPI_GROUP_TRANSLATE_HASH_MIN &&
+        OMPI_SUCCESS == ompi_group_translate_ranks_hash (group1, n_ranks, ranks1,
+                                                         group2, ranks2)) {
+        return MPI_SUCCESS;
+    }
+
     /* loop over all ranks */
     for (int proc = 0; proc < n_ranks; ++proc) {
         ompi_process_name_t proc1_name, proc2_name;
@@ -193,7 +332,8 @@ int ompi_group_incl(ompi_group_t* group, int n, const int *ranks, ompi_group_t *
 
     method = 0;
 #if OMPI_GROUP_SPARSE
-    if (ompi_use_sparse_group_storage) {
+    /* small groups stay dense, their peer lookups are a single load */
+    if (ompi_use_sparse_group_storage && n >= (int) ompi_sparse_group_min_size) {
         int len [4];
 
         len[0] = ompi_group_calc_plist    ( n ,ranks );
@@ -559,18 +699,13 @@ int ompi_group_compare(ompi_group_t *group1,
 bool ompi_group_have_remote_peers (ompi_group_t *group)
 {
     for (int i = 0 ; i < group->grp_proc_count ; ++i) {
-        ompi_proc_t *proc = NULL;
-#if OMPI_GROUP_SPARSE
-        proc = ompi_group_peer_lookup (group, i);
-#else
-        proc = ompi_group_get_proc_ptr_raw (group, i);
+        ompi_proc_t *proc = ompi_group_get_proc_ptr_raw (group, i);
         if (ompi_proc_is_sentinel (proc)) {
             /* the proc must be stored in the group or cached in the proc
              * hash table if the process resides in the local node
              * (see ompi_proc_complete_init) */
             return true;
         }
-#endif
         if (!OPAL_PROC_ON_LOCAL_NODE(proc->super.proc_flags)) {
             return true;
         }
@@ -587,18 +722,13 @@ int ompi_group_count_local_peers (ompi_group_t *group)
 {
     int local_peers = 0;
     for (int i = 0 ; i < group->grp_proc_count ; ++i) {
-        ompi_proc_t *proc = NULL;
-#if OMPI_GROUP_SPARSE
-        proc = ompi_group_peer_lookup (group, i);
-#else
-        proc = ompi_group_get_proc_ptr_raw (group, i);
+        ompi_proc_t *proc = ompi_group_get_proc_ptr_raw (group, i);
         if (ompi_proc_is_sentinel (proc)) {
             /* the proc must be stored in the group or cached in the proc
              * hash table if the process resides in the local node
              * (see ompi_proc_complete_init) */
             continue;
         }
-#endif
         if (OPAL_PROC_ON_LOCAL_NODE(proc->super.proc_flags)) {
             local_peers++;
         }
@@ -44,10 +44,14 @@ BEGIN_C_DECLS
 
 #define BSIZE ((int)sizeof(unsigned char)*8)
 
+/** number of bytes of a bitmap group covered by each entry of grp_bitmap_counts */
+#define OMPI_GROUP_BITMAP_BLOCK 32
+
 struct ompi_group_sporadic_list_t
 {
   int rank_first;
   int length;
+  int child_first; /** rank in the child group of rank_first */
 };
 
 struct ompi_group_sporadic_data_t
@@ -55,6 +59,7 @@ struct ompi_group_sporadic_data_t
     struct ompi_group_sporadic_list_t  *grp_sporadic_list;
                                             /** list to hold the sporadic struct */
     int                        grp_sporadic_list_len;/** length of the structure*/
+    bool                       grp_sporadic_sorted; /** ranges in increasing rank_first order */
 };
 struct ompi_group_strided_data_t
 {
@@ -66,6 +71,8 @@ struct ompi_group_bitmap_data_t
 {
     unsigned char *grp_bitmap_array;     /* the bit map array for sparse groups of type BMAP */
     int            grp_bitmap_array_len; /* length of the bit array */
+    int           *grp_bitmap_counts;    /* bits set before each block of OMPI_GROUP_BITMAP_BLOCK
+                                            bytes, for constant time translations */
 };
 
 /**
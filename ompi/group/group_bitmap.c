@@ -37,14 +37,38 @@ int ompi_group_calc_bmap ( int n, int orig_size , const int *ranks) {
     }
 }
 
+/* number of bits set in each byte value */
+static const unsigned char ompi_group_bitmap_popcount[256] = {
+#define B2(n) n, n + 1, n + 1, n + 2
+#define B4(n) B2(n), B2(n + 1), B2(n + 1), B2(n + 2)
+#define B6(n) B4(n), B4(n + 1), B4(n + 1), B4(n + 2)
+    B6(0), B6(1), B6(1), B6(2)
+#undef B6
+#undef B4
+#undef B2
+};
+
+/* number of bits set in the bitmap before bit m */
+static int ompi_group_bitmap_rank (const struct ompi_group_bitmap_data_t *data, int m)
+{
+    int byte = m / BSIZE, i;
+    int count = data->grp_bitmap_counts[byte / OMPI_GROUP_BITMAP_BLOCK];
+
+    for (i = byte - byte % OMPI_GROUP_BITMAP_BLOCK ; i < byte ; i++) {
+        count += ompi_group_bitmap_popcount[data->grp_bitmap_array[i]];
+    }
+    return count + ompi_group_bitmap_popcount[data->grp_bitmap_array[byte] &
+                                              ((1 << (m % BSIZE)) - 1)];
+}
+
 /* from parent group to child group*/
 int ompi_group_translate_ranks_bmap ( ompi_group_t *parent_group,
                                       int n_ranks, const int *ranks1,
                                       ompi_group_t *child_group,
                                       int *ranks2)
 {
-    int i,count,j,k,m;
-    unsigned char tmp, tmp1;
+    const struct ompi_group_bitmap_data_t *data = &child_group->sparse_data.grp_bitmap;
+    int j,m;
     for (j=0 ; j<n_ranks ; j++) {
         if ( MPI_PROC_NULL == ranks1[j]) {
             ranks2[j] = MPI_PROC_NULL;
@@ -52,30 +76,13 @@ int ompi_group_translate_ranks_bmap ( ompi_group_t *parent_group,
         else {
             ranks2[j] = MPI_UNDEFINED;
             m = ranks1[j];
-            count = 0;
-            tmp = ( 1 << (m % BSIZE) );
+            if (m < 0 || m >= data->grp_bitmap_array_len * BSIZE) {
+                continue;  /* MPI_UNDEFINED from a previous level */
+            }
             /* check if the bit that correponds to the parent rank is set in the bitmap */
-            if ( tmp == (child_group->sparse_data.grp_bitmap.grp_bitmap_array[(int)(m/BSIZE)]
-                         & (1 << (m % BSIZE)))) {
-                /*
-                 * add up how many bits are set, till we get to the bit of parent
-                 * rank that we want. The rank in the child will be the sum of the bits
-                 * that are set on the way till we get to the correponding bit
-                 */
-                for (i=0 ; i<=(int)(m/BSIZE) ; i++) {
-                    for (k=0 ; k<BSIZE ; k++) {
-                        tmp1 = ( 1 << k);
-                        if ( tmp1 == ( child_group->sparse_data.grp_bitmap.grp_bitmap_array[i]
-                                       & (1 << k) ) ) {
-                            count++;
-                        }
-                        if( i==(int)(m/BSIZE) &&  k==m % BSIZE ) {
-                            ranks2[j] = count-1;
-                            i = (int)(m/BSIZE) + 1;
-                            break;
-                        }
-                    }
-                }
+            if (data->grp_bitmap_array[m / BSIZE] & (1 << (m % BSIZE))) {
+                /* the rank in the child is the number of bits set before it */
+                ranks2[j] = ompi_group_bitmap_rank (data, m);
             }
         }
     }
@@ -87,32 +94,45 @@ int ompi_group_translate_ranks_bmap_reverse ( ompi_group_t *child_group,
                                               ompi_group_t *parent_group,
                                               int *ranks2)
 {
-    int i,j,count,m,k;
-    unsigned char tmp;
+    const struct ompi_group_bitmap_data_t *data = &child_group->sparse_data.grp_bitmap;
+    int nblocks = ompi_group_div_ceil (data->grp_bitmap_array_len, OMPI_GROUP_BITMAP_BLOCK);
+    int i,j,m,k,lo,hi,count;
+    unsigned char bits;
     for (j=0 ; j<n_ranks ; j++) {
         if ( MPI_PROC_NULL == ranks1[j]) {
             ranks2[j] = MPI_PROC_NULL;
         }
         else {
             m = ranks1[j];
-            count = 0;
+            /* find the last block with less than m + 1 bits set before it */
+            lo = 0;
+            hi = nblocks;
+            while ((hi - lo) > 1) {
+                int mid = (lo + hi) / 2;
+                if (data->grp_bitmap_counts[mid] <= m) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
             /*
-             * Go through all the bits set in the bitmap up to the child rank.
+             * Go through the bits set in the block up to the child rank.
              * The parent rank will be the sum of all bits passed (set and unset)
              */
-            for (i=0 ; i<child_group->sparse_data.grp_bitmap.grp_bitmap_array_len ; i++) {
+            count = data->grp_bitmap_counts[lo];
+            for (i = lo * OMPI_GROUP_BITMAP_BLOCK ; i < data->grp_bitmap_array_len ; i++) {
+                bits = data->grp_bitmap_array[i];
+                if (count + ompi_group_bitmap_popcount[bits] <= m) {
+                    count += ompi_group_bitmap_popcount[bits];
+                    continue;
+                }
                 for (k=0 ; k<BSIZE ; k++) {
-                    tmp = ( 1 << k);
-                    if ( tmp == ( child_group->sparse_data.grp_bitmap.grp_bitmap_array[i]
-                                  & (1 << k) ) ) {
-                        count++;
-                    }
-                    if( m == count-1 ) {
+                    if ((bits & (1 << k)) && (m == count++)) {
                         ranks2[j] = i*BSIZE + k;
-                        i = child_group->sparse_data.grp_bitmap.grp_bitmap_array_len + 1;
                         break;
                     }
                 }
+                break;
             }
         }
     }
@@ -148,7 +168,7 @@ int ompi_group_incl_bmap(ompi_group_t* group, int n, const int *ranks,
                          ompi_group_t **new_group)
 {
     /* local variables */
-    int my_group_rank,i,bit_set;
+    int my_group_rank,i,bit_set,count;
     ompi_group_t *group_pointer, *new_group_pointer;
 
     group_pointer = (ompi_group_t *)group;
@@ -176,12 +196,23 @@ int ompi_group_incl_bmap(ompi_group_t* group, int n, const int *ranks,
             sparse_data.grp_bitmap.grp_bitmap_array[(int)(ranks[i]/BSIZE)] |= (1 << bit_set);
     }
 
+    /* count the bits set before each block */
+    count = 0;
+    for (i=0 ; i<new_group_pointer->sparse_data.grp_bitmap.grp_bitmap_array_len ; i++) {
+        if (0 == i % OMPI_GROUP_BITMAP_BLOCK) {
+            new_group_pointer->sparse_data.grp_bitmap.grp_bitmap_counts[i / OMPI_GROUP_BITMAP_BLOCK] =
+                count;
+        }
+        count += ompi_group_bitmap_popcount[new_group_pointer->
+                                            sparse_data.grp_bitmap.grp_bitmap_array[i]];
+    }
+
     new_group_pointer -> grp_parent_group_ptr = group_pointer;
 
+    /* the procs are held by the parent, sparse groups do not touch their
+     * reference counts (see ompi_group_destruct) */
     OBJ_RETAIN(new_group_pointer -> grp_parent_group_ptr);
-    ompi_group_increment_proc_count(new_group_pointer -> grp_parent_group_ptr);
 
-    ompi_group_increment_proc_count(new_group_pointer);
     my_group_rank=group_pointer->grp_my_rank;
 
     ompi_group_translate_ranks (group_pointer,1,&my_group_rank,
@@ -215,6 +215,10 @@ ompi_group_t *ompi_group_allocate_bmap(int orig_group_size , int group_size)
     new_group->sparse_data.grp_bitmap.grp_bitmap_array_len =
         ompi_group_div_ceil(orig_group_size,BSIZE);
 
+    new_group->sparse_data.grp_bitmap.grp_bitmap_counts = (int *)malloc
+        (sizeof(int) * ompi_group_div_ceil(new_group->sparse_data.grp_bitmap.grp_bitmap_array_len,
+                                           OMPI_GROUP_BITMAP_BLOCK));
+
     new_group->grp_proc_count = group_size;
 
     /* initialize our rank to MPI_UNDEFINED */
@@ -222,6 +226,13 @@ ompi_group_t *ompi_group_allocate_bmap(int orig_group_size , int group_size)
     new_group->grp_proc_pointers     = NULL;
     OMPI_GROUP_SET_BITMAP(new_group);
 
+    if (NULL == new_group->sparse_data.grp_bitmap.grp_bitmap_array ||
+        NULL == new_group->sparse_data.grp_bitmap.grp_bitmap_counts) {
+        /* the destructor releases whatever was allocated */
+        OBJ_RELEASE(new_group);
+        new_group = NULL;
+    }
+
  error_exit:
     /* return */
     return new_group;
@@ -309,6 +320,9 @@ static void ompi_group_destruct(ompi_group_t *group)
         if (NULL != group->sparse_data.grp_bitmap.grp_bitmap_array) {
             free(group->sparse_data.grp_bitmap.grp_bitmap_array);
         }
+        if (NULL != group->sparse_data.grp_bitmap.grp_bitmap_counts) {
+            free(group->sparse_data.grp_bitmap.grp_bitmap_counts);
+        }
     }
 
     if (NULL != group->grp_parent_group_ptr){
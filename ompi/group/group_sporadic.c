@@ -26,20 +26,53 @@
 #include "ompi/constants.h"
 #include "mpi.h"
 
+/* number of ranges of consecutive ranks in ranks */
+static int ompi_group_sporadic_ranges (int n, const int *ranks)
+{
+    int i, l = (0 < n) ? 1 : 0;
+    for (i=1 ; i<n ; i++) {
+        if(ranks[i] != ranks[i-1]+1) {
+            l++;
+        }
+    }
+    return l;
+}
+
 int ompi_group_calc_sporadic ( int n , const int *ranks)
 {
-    int i,l=0;
-    for (i=0 ; i<n ; i++) {
-        if(ranks[i] == ranks[i-1]+1) {
-            if(l==0) {
-                l++;
-            }
+    return sizeof(struct ompi_group_sporadic_list_t ) * ompi_group_sporadic_ranges (n, ranks);
+}
+
+/* index of the last range starting at or before the parent rank, or -1 */
+static int ompi_group_sporadic_find_parent (const struct ompi_group_sporadic_data_t *data, int rank)
+{
+    int lo = 0, hi = data->grp_sporadic_list_len;
+
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (data->grp_sporadic_list[mid].rank_first <= rank) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
-        else {
-            l++;
+    }
+    return lo - 1;
+}
+
+/* index of the range holding the child rank (the child ranks always increase) */
+static int ompi_group_sporadic_find_child (const struct ompi_group_sporadic_data_t *data, int rank)
+{
+    int lo = 0, hi = data->grp_sporadic_list_len;
+
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (data->grp_sporadic_list[mid].child_first <= rank) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
-    return sizeof(struct ompi_group_sporadic_list_t ) * l;
+    return lo - 1;
 }
 
 /* from parent group to child group*/
@@ -60,6 +93,19 @@ int ompi_group_translate_ranks_sporadic ( ompi_group_t *parent_group,
              * and the position in the current range
              */
             ranks2[j] = MPI_UNDEFINED;
+            if (child_group->sparse_data.grp_sporadic.grp_sporadic_sorted) {
+                const struct ompi_group_sporadic_list_t *range;
+
+                i = ompi_group_sporadic_find_parent (&child_group->sparse_data.grp_sporadic,
+                                                     ranks1[j]);
+                if (0 <= i) {
+                    range = &child_group->sparse_data.grp_sporadic.grp_sporadic_list[i];
+                    if (ranks1[j] < range->rank_first + range->length) {
+                        ranks2[j] = range->child_first + ranks1[j] - range->rank_first;
+                    }
+                }
+                continue;
+            }
             count = 0;
             for(i=0 ; i <child_group->sparse_data.grp_sporadic.grp_sporadic_list_len ; i++) {
                 if( child_group->sparse_data.grp_sporadic.grp_sporadic_list[i].rank_first
@@ -85,30 +131,21 @@ int ompi_group_translate_ranks_sporadic_reverse ( ompi_group_t *child_group,
                                                   ompi_group_t *parent_group,
                                                   int *ranks2)
 {
-    int i,j,count;
+    const struct ompi_group_sporadic_list_t *range;
+    int i,j;
 
     for (j=0 ; j<n_ranks ; j++) {
         if (MPI_PROC_NULL == ranks1[j]) {
             ranks2[j] = MPI_PROC_NULL;
         }
         else {
-            count = 0;
             /*
              * if the rank of the child is in the current range, the rank of the parent will be
              * the position in the current range of the sporadic list
              */
-            for (i=0 ; i<child_group->sparse_data.grp_sporadic.grp_sporadic_list_len ; i++) {
-                if ( ranks1[j] > ( count +
-                                   child_group->sparse_data.grp_sporadic.grp_sporadic_list[i].length
-                                   - 1) ) {
-                    count = count + child_group->sparse_data.grp_sporadic.grp_sporadic_list[i].length;
-                }
-                else {
-                    ranks2[j] = child_group->sparse_data.grp_sporadic.grp_sporadic_list[i].rank_first
-                        + (ranks1[j] - count);
-                    break;
-                }
-            }
+            i = ompi_group_sporadic_find_child (&child_group->sparse_data.grp_sporadic, ranks1[j]);
+            range = &child_group->sparse_data.grp_sporadic.grp_sporadic_list[i];
+            ranks2[j] = range->rank_first + (ranks1[j] - range->child_first);
         }
     }
     return OMPI_SUCCESS;
@@ -129,20 +166,9 @@ int ompi_group_incl_spor(ompi_group_t* group, int n, const int *ranks,
         return OMPI_SUCCESS;
     }
 
-    l=0;
     j=0;
     proc_count = 0;
-
-    for(i=0 ; i<n ; i++){
-        if(ranks[i] == ranks[i-1]+1) {
-            if(l==0) {
-                l++;
-            }
-        }
-        else {
-            l++;
-        }
-    }
+    l = ompi_group_sporadic_ranges (n, ranks);
 
     new_group_pointer = ompi_group_allocate_sporadic(l);
     if( NULL == new_group_pointer ) {
@@ -153,25 +179,34 @@ int ompi_group_incl_spor(ompi_group_t* group, int n, const int *ranks,
         sparse_data.grp_sporadic.grp_sporadic_list[j].rank_first = ranks[0];
     new_group_pointer ->
         sparse_data.grp_sporadic.grp_sporadic_list[j].length = 1;
+    new_group_pointer ->
+        sparse_data.grp_sporadic.grp_sporadic_list[j].child_first = 0;
+    new_group_pointer -> sparse_data.grp_sporadic.grp_sporadic_sorted = true;
 
     for(i=1 ; i<n ; i++){
         if(ranks[i] == ranks[i-1]+1) {
             new_group_pointer -> sparse_data.grp_sporadic.grp_sporadic_list[j].length ++;
         }
         else {
+            if (ranks[i] < ranks[i-1]) {
+                new_group_pointer -> sparse_data.grp_sporadic.grp_sporadic_sorted = false;
+            }
             j++;
             new_group_pointer ->
                 sparse_data.grp_sporadic.grp_sporadic_list[j].rank_first = ranks[i];
             new_group_pointer ->
                 sparse_data.grp_sporadic.grp_sporadic_list[j].length = 1;
+            new_group_pointer ->
+                sparse_data.grp_sporadic.grp_sporadic_list[j].child_first = i;
         }
     }
 
     new_group_pointer->sparse_data.grp_sporadic.grp_sporadic_list_len = j+1;
     new_group_pointer -> grp_parent_group_ptr = group_pointer;
 
+    /* the procs are held by the parent, sparse groups do not touch their
+     * reference counts (see ompi_group_destruct) */
     OBJ_RETAIN(new_group_pointer -> grp_parent_group_ptr);
-    ompi_group_increment_proc_count(new_group_pointer -> grp_parent_group_ptr);
 
     for(i=0 ; i<new_group_pointer->sparse_data.grp_sporadic.grp_sporadic_list_len ; i++) {
         proc_count = proc_count + new_group_pointer ->
@@ -179,7 +214,6 @@ int ompi_group_incl_spor(ompi_group_t* group, int n, const int *ranks,
     }
     new_group_pointer->grp_proc_count = proc_count;
 
-    ompi_group_increment_proc_count(new_group_pointer);
     my_group_rank=group_pointer->grp_my_rank;
 
     ompi_group_translate_ranks (group_pointer,1,&my_group_rank,
@@ -123,15 +123,15 @@ int ompi_group_incl_strided(ompi_group_t* group, int n, const int *ranks,
     }
     new_group_pointer -> grp_parent_group_ptr = group_pointer;
 
+    /* the procs are held by the parent, sparse groups do not touch their
+     * reference counts (see ompi_group_destruct) */
     OBJ_RETAIN(new_group_pointer -> grp_parent_group_ptr);
-    ompi_group_increment_proc_count(new_group_pointer -> grp_parent_group_ptr);
 
     new_group_pointer -> sparse_data.grp_strided.grp_strided_stride = stride;
     new_group_pointer -> sparse_data.grp_strided.grp_strided_offset = ranks[0];
     new_group_pointer -> sparse_data.grp_strided.grp_strided_last_element = ranks[n-1];
     new_group_pointer -> grp_proc_count = n;
 
-    ompi_group_increment_proc_count(new_group_pointer);
     my_group_rank = group_pointer->grp_my_rank;
     ompi_group_translate_ranks (new_group_pointer->grp_parent_group_ptr,1,&my_group_rank,
                                 new_group_pointer,&new_group_pointer->grp_my_rank);
@@ -59,6 +59,10 @@ struct mca_bml_base_btl_t {
     float     btl_weight;                            /**< BTL weight for scheduling */
     struct    mca_btl_base_module_t *btl;            /**< BTL module */
     struct    mca_btl_base_endpoint_t* btl_endpoint; /**< BTL addressing info */
+    double    btl_rdma_bandwidth;                    /**< observed RDMA bandwidth (Mbps), 0 until measured */
+    uint64_t  btl_rdma_last;                         /**< time of the last RDMA completion (usec) */
+    double    btl_probe_latency;                     /**< measured latency (usec), 0 until probed */
+    double    btl_probe_bandwidth;                   /**< measured bandwidth (Mbps), 0 until probed */
 };
 typedef struct mca_bml_base_btl_t mca_bml_base_btl_t;
 
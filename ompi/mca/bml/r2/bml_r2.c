@@ -29,6 +29,7 @@
 
 #include "ompi_config.h"
 
+#include <float.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -117,6 +118,12 @@ static int mca_bml_r2_add_btls( void )
           sizeof(struct mca_btl_base_module_t*),
           btl_exclusivity_compare);
     mca_bml_r2.btls_added = true;
+
+    /* let the BTLs with a registration hook know about the probe tag */
+    if (OMPI_SUCCESS != mca_bml_r2_probe_init()) {
+        mca_bml_r2.probe = false;
+    }
+
     return OMPI_SUCCESS;
 }
 
@@ -128,6 +135,53 @@ static int btl_bandwidth_compare(const void *v1, const void *v2)
     return b2->btl->btl_bandwidth - b1->btl->btl_bandwidth;
 }
 
+static int btl_probe_bandwidth_compare(const void *v1, const void *v2)
+{
+    mca_bml_base_btl_t *b1 = (mca_bml_base_btl_t*)v1,
+                       *b2 = (mca_bml_base_btl_t*)v2;
+
+    if (b1->btl_probe_bandwidth == b2->btl_probe_bandwidth) {
+        return 0;
+    }
+
+    return (b1->btl_probe_bandwidth < b2->btl_probe_bandwidth) ? 1 : -1;
+}
+
+/* true when bml_r2_probe measured all the btls of the array */
+static bool mca_bml_r2_btls_probed (mca_bml_base_btl_array_t *btl_array)
+{
+    const size_t array_length = mca_bml_base_btl_array_get_size (btl_array);
+
+    if (array_length < 2) {
+        return false;
+    }
+
+    for (size_t i = 0 ; i < array_length ; ++i) {
+        mca_bml_base_btl_t *bml_btl = mca_bml_base_btl_array_get_index (btl_array, i);
+        if (bml_btl->btl_probe_latency <= 0.0 || bml_btl->btl_probe_bandwidth <= 0.0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void mca_bml_r2_calculate_probe_bandwidth_latency (mca_bml_base_btl_array_t *btl_array, double *total_bandwidth, double *latency)
+{
+    const size_t array_length = mca_bml_base_btl_array_get_size (btl_array);
+
+    *latency = DBL_MAX;
+    *total_bandwidth = 0.;
+
+    for (size_t i = 0 ; i < array_length ; ++i) {
+        mca_bml_base_btl_t *bml_btl = mca_bml_base_btl_array_get_index (btl_array, i);
+        *total_bandwidth += bml_btl->btl_probe_bandwidth;
+        if (bml_btl->btl_probe_latency < *latency) {
+            *latency = bml_btl->btl_probe_latency;
+        }
+    }
+}
+
 static void mca_bml_r2_calculate_bandwidth_latency (mca_bml_base_btl_array_t *btl_array, double *total_bandwidth, uint32_t *latency)
 {
     const size_t array_length = mca_bml_base_btl_array_get_size (btl_array);
@@ -249,6 +303,10 @@ static int mca_bml_r2_endpoint_add_btl (struct ompi_proc_t *proc, mca_bml_base_e
                 bml_btl->btl_endpoint = btl_endpoint;
                 bml_btl->btl_weight = 0;
                 bml_btl->btl_flags = btl_flags;
+                bml_btl->btl_rdma_bandwidth = 0.0;
+                bml_btl->btl_rdma_last = 0;
+                bml_btl->btl_probe_latency = 0.0;
+                bml_btl->btl_probe_bandwidth = 0.0;
 
                 /**
                  * calculate the bitwise OR of the btl flags
@@ -281,6 +339,10 @@ static int mca_bml_r2_endpoint_add_btl (struct ompi_proc_t *proc, mca_bml_base_e
         bml_btl_rdma->btl_endpoint = btl_endpoint;
         bml_btl_rdma->btl_weight = 0;
         bml_btl_rdma->btl_flags = btl_flags;
+        bml_btl_rdma->btl_rdma_bandwidth = 0.0;
+        bml_btl_rdma->btl_rdma_last = 0;
+        bml_btl_rdma->btl_probe_latency = 0.0;
+        bml_btl_rdma->btl_probe_bandwidth = 0.0;
 
         if (bml_endpoint->btl_pipeline_send_length < btl->btl_rdma_pipeline_send_length) {
             bml_endpoint->btl_pipeline_send_length = btl->btl_rdma_pipeline_send_length;
@@ -298,9 +360,10 @@ static int mca_bml_r2_endpoint_add_btl (struct ompi_proc_t *proc, mca_bml_base_e
 
 static void mca_bml_r2_compute_endpoint_metrics (mca_bml_base_endpoint_t *bml_endpoint)
 {
-    double total_bandwidth = 0;
+    double total_bandwidth = 0, probe_latency = 0;
     uint32_t latency;
     size_t n_send, n_rdma;
+    bool probed;
 
     /* (1) determine the total bandwidth available across all btls
      *     note that we need to do this here, as we may already have btls configured
@@ -312,13 +375,20 @@ static void mca_bml_r2_compute_endpoint_metrics (mca_bml_base_endpoint_t *bml_en
     n_send = mca_bml_base_btl_array_get_size (&bml_endpoint->btl_send);
     n_rdma = mca_bml_base_btl_array_get_size (&bml_endpoint->btl_rdma);
 
+    /* rank the send btls by what bml_r2_probe measured to this peer, if it did */
+    probed = mca_bml_r2_btls_probed (&bml_endpoint->btl_send);
+
     /* sort BTLs in descending order according to bandwidth value */
     qsort (bml_endpoint->btl_send.bml_btls, n_send,
-           sizeof(mca_bml_base_btl_t), btl_bandwidth_compare);
+           sizeof(mca_bml_base_btl_t), probed ? btl_probe_bandwidth_compare : btl_bandwidth_compare);
 
     bml_endpoint->btl_rdma_index = 0;
 
     mca_bml_r2_calculate_bandwidth_latency (&bml_endpoint->btl_send, &total_bandwidth, &latency);
+    if (probed) {
+        mca_bml_r2_calculate_probe_bandwidth_latency (&bml_endpoint->btl_send, &total_bandwidth,
+                                                      &probe_latency);
+    }
 
     /* (1) set the weight of each btl as a percentage of overall bandwidth
      * (2) copy all btl instances at the highest priority ranking into the
@@ -328,10 +398,13 @@ static void mca_bml_r2_compute_endpoint_metrics (mca_bml_base_endpoint_t *bml_en
         mca_bml_base_btl_t *bml_btl =
             mca_bml_base_btl_array_get_index(&bml_endpoint->btl_send, n_index);
         mca_btl_base_module_t *btl = bml_btl->btl;
+        double bandwidth = probed ? bml_btl->btl_probe_bandwidth : btl->btl_bandwidth;
+        bool eager = probed ? (bml_btl->btl_probe_latency <= probe_latency * MCA_BML_R2_PROBE_LATENCY_SLACK)
+                            : (btl->btl_latency == latency);
 
         /* compute weighting factor for this r2 */
-        if(btl->btl_bandwidth > 0) {
-            bml_btl->btl_weight = (float)(btl->btl_bandwidth / total_bandwidth);
+        if(bandwidth > 0) {
+            bml_btl->btl_weight = (float)(bandwidth / total_bandwidth);
         } else {
             bml_btl->btl_weight = (float)(1.0 / n_send);
         }
@@ -339,7 +412,7 @@ static void mca_bml_r2_compute_endpoint_metrics (mca_bml_base_endpoint_t *bml_en
         /* check to see if this r2 is already in the array of r2s
          * used for first fragments - if not add it.
          */
-        if(btl->btl_latency == latency) {
+        if (eager) {
             mca_bml_base_btl_t* bml_btl_new =
                 mca_bml_base_btl_array_insert(&bml_endpoint->btl_eager);
             *bml_btl_new = *bml_btl;
@@ -442,6 +515,9 @@ static int mca_bml_r2_add_proc (struct ompi_proc_t *proc)
         return OMPI_ERR_UNREACH;
     }
 
+    /* measure the btls before they are ranked */
+    mca_bml_r2_probe_endpoints (&bml_endpoint, 1);
+
     /* compute metrics for registered btls */
     mca_bml_r2_compute_endpoint_metrics (bml_endpoint);
 
@@ -565,6 +641,26 @@ static int mca_bml_r2_add_procs( size_t nprocs,
 
     free(btl_endpoints);
 
+    /* measure the btls of the new peers before they are ranked */
+    if (mca_bml_r2.probe) {
+        mca_bml_base_endpoint_t **probe_endpoints =
+            (mca_bml_base_endpoint_t **) malloc (n_new_procs * sizeof (probe_endpoints[0]));
+        size_t n_probe = 0;
+
+        if (NULL != probe_endpoints) {
+            for (size_t p = 0; p < n_new_procs ; ++p) {
+                mca_bml_base_endpoint_t *bml_endpoint =
+                    (mca_bml_base_endpoint_t *) new_procs[p]->proc_endpoints[OMPI_PROC_ENDPOINT_TAG_BML];
+                if (NULL != bml_endpoint) {
+                    probe_endpoints[n_probe++] = bml_endpoint;
+                }
+            }
+
+            mca_bml_r2_probe_endpoints (probe_endpoints, n_probe);
+            free (probe_endpoints);
+        }
+    }
+
     /* iterate back through procs and compute metrics for registered r2s */
     for (size_t p = 0; p < n_new_procs ; ++p) {
         mca_bml_base_endpoint_t *bml_endpoint =
@@ -45,6 +45,12 @@ struct mca_bml_r2_module_t {
     mca_btl_base_component_progress_fn_t * btl_progress;
     bool btls_added;
     bool show_unreach_errors;
+
+    /* measured ranking of the send BTLs (bml_r2_probe.c) */
+    bool probe;
+    int probe_count;
+    size_t probe_size;
+    int probe_timeout;
 };
 
 typedef struct mca_bml_r2_module_t mca_bml_r2_module_t;
@@ -65,6 +71,27 @@ int mca_bml_r2_component_fini(void);
 
 int mca_bml_r2_finalize( void );
 
+/**
+ * Send BTLs whose measured latency is within this factor of the best one
+ * are used for first fragments, so that noise does not drop a rail.
+ */
+#define MCA_BML_R2_PROBE_LATENCY_SLACK 1.1
+
+/**
+ * Register the probe handler with the BTLs. Called when the BTLs are
+ * selected and again once they are added, for their registration hooks.
+ */
+int mca_bml_r2_probe_init(void);
+
+/**
+ * Measure the latency and bandwidth of the send BTLs of each endpoint that
+ * has more than one, with ping-pongs between the processes. The results
+ * are stored in btl_probe_latency and btl_probe_bandwidth of the
+ * btl_send entries and left at 0 for the BTLs that did not answer in
+ * time.
+ */
+void mca_bml_r2_probe_endpoints(mca_bml_base_endpoint_t **endpoints, size_t count);
+
 END_C_DECLS
 
 #endif /* OMPI_MCA_BML_R2_H */
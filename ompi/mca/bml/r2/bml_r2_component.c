@@ -64,6 +64,50 @@ static int mca_bml_r2_component_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_bml_r2.show_unreach_errors);
 
+    mca_bml_r2.probe = false;
+    (void) mca_base_component_var_register(&mca_bml_r2_component.bml_version,
+                                           "probe",
+                                           "Rank the BTLs that reach a peer by latency and bandwidth "
+                                           "measured with ping-pongs before the first use of the peer "
+                                           "instead of their static btl_latency and btl_bandwidth "
+                                           "(default: false)",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_bml_r2.probe);
+
+    mca_bml_r2.probe_count = 8;
+    (void) mca_base_component_var_register(&mca_bml_r2_component.bml_version,
+                                           "probe_count",
+                                           "Number of pings of each size sent on each BTL when "
+                                           "bml_r2_probe is set, the best round trip is kept (default: 8)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_bml_r2.probe_count);
+
+    mca_bml_r2.probe_size = 65536;
+    (void) mca_base_component_var_register(&mca_bml_r2_component.bml_version,
+                                           "probe_size",
+                                           "Size of the pings used to measure the bandwidth when "
+                                           "bml_r2_probe is set, capped to the eager limit of each "
+                                           "BTL (default: 65536)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_bml_r2.probe_size);
+
+    mca_bml_r2.probe_timeout = 100000;
+    (void) mca_base_component_var_register(&mca_bml_r2_component.bml_version,
+                                           "probe_timeout",
+                                           "Time in microseconds given to the peers to answer the "
+                                           "pings, the BTLs that did not answer keep the static "
+                                           "ranking (default: 100000)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_bml_r2.probe_timeout);
+
     return OMPI_SUCCESS;
 }
 
@@ -90,5 +134,11 @@ mca_bml_base_module_t* mca_bml_r2_component_init( int* priority,
 
     *priority = 100;
     mca_bml_r2.btls_added = false;
+
+    /* the peers may probe as soon as they know our BTLs */
+    if (OMPI_SUCCESS != mca_bml_r2_probe_init()) {
+        mca_bml_r2.probe = false;
+    }
+
     return &mca_bml_r2.super;
 }
@@ -0,0 +1,296 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Measured ranking of the send BTLs (bml_r2_probe).
+ *
+ * The static btl_latency and btl_bandwidth of the BTLs say little about
+ * the path to a given peer (the NIC the peer is close to, a slow link of a
+ * multi-rail node, ...). When bml_r2_probe is set, each BTL that can send
+ * to a peer with more than one such BTL is measured with ping-pongs on the
+ * MCA_BTL_TAG_BML tag before the first use of the peer: bml_r2_probe_count
+ * header only pings for the latency, then as many pings of
+ * bml_r2_probe_size bytes (capped to the eager limit of the BTL) for the
+ * bandwidth. The best round trip of each kind is kept. The peer answers
+ * from its receive callback, so it only has to progress. Whatever has not
+ * answered after bml_r2_probe_timeout microseconds keeps the static
+ * ranking.
+ */
+
+#include "ompi_config.h"
+
+#include <string.h>
+
+#include "opal/mca/btl/btl.h"
+#include "opal/mca/timer/base/base.h"
+#include "opal/runtime/opal_progress.h"
+#include "opal/util/output.h"
+#include "ompi/mca/bml/bml.h"
+#include "ompi/mca/bml/base/base.h"
+#include "ompi/proc/proc.h"
+#include "bml_r2.h"
+
+#define MCA_BML_R2_PROBE_PING 1
+#define MCA_BML_R2_PROBE_PONG 2
+
+struct mca_bml_r2_probe_hdr_t {
+    uint8_t type;
+    uint8_t padding[3];
+    uint32_t epoch;                 /**< probe of the sender of the ping */
+    uint32_t slot;                  /**< measurement of the sender of the ping */
+    uint32_t padding2;
+    uint64_t stamp;                 /**< time the ping was sent (cycles of its sender) */
+    opal_process_name_t name;       /**< sender of this message */
+};
+typedef struct mca_bml_r2_probe_hdr_t mca_bml_r2_probe_hdr_t;
+
+struct mca_bml_r2_probe_slot_t {
+    mca_bml_base_btl_t *bml_btl;    /**< btl_send entry being measured */
+    size_t large_size;              /**< size of the bandwidth pings, 0 if none */
+    int rounds;                     /**< pings to answer */
+    int round;                      /**< pings answered so far */
+    uint64_t min_small;             /**< best round trip of the latency pings (cycles) */
+    uint64_t min_large;             /**< best round trip of the bandwidth pings (cycles) */
+};
+typedef struct mca_bml_r2_probe_slot_t mca_bml_r2_probe_slot_t;
+
+static mca_bml_r2_probe_slot_t *mca_bml_r2_probe_slots = NULL;
+static uint32_t mca_bml_r2_probe_nslots = 0;
+static uint32_t mca_bml_r2_probe_epoch = 0;
+static opal_atomic_int32_t mca_bml_r2_probe_pending = 0;
+
+static int mca_bml_r2_probe_send (mca_btl_base_module_t *btl, struct mca_btl_base_endpoint_t *endpoint,
+                                  const mca_bml_r2_probe_hdr_t *hdr, size_t size)
+{
+    mca_btl_base_descriptor_t *des;
+    int rc;
+
+    des = btl->btl_alloc (btl, endpoint, MCA_BTL_NO_ORDER, size,
+                          MCA_BTL_DES_FLAGS_PRIORITY | MCA_BTL_DES_FLAGS_BTL_OWNERSHIP);
+    if (OPAL_UNLIKELY(NULL == des)) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    memcpy (des->des_segments[0].seg_addr.pval, hdr, sizeof (*hdr));
+
+    rc = btl->btl_send (btl, endpoint, des, MCA_BTL_TAG_BML);
+    if (OPAL_UNLIKELY(rc < 0 && OPAL_ERR_RESOURCE_BUSY != rc)) {
+        btl->btl_free (btl, des);
+        return rc;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int mca_bml_r2_probe_ping (uint32_t index)
+{
+    mca_bml_r2_probe_slot_t *slot = mca_bml_r2_probe_slots + index;
+    mca_bml_base_btl_t *bml_btl = slot->bml_btl;
+    mca_bml_r2_probe_hdr_t hdr = {.type = MCA_BML_R2_PROBE_PING, .epoch = mca_bml_r2_probe_epoch,
+                                  .slot = index, .name = ompi_proc_local_proc->super.proc_name};
+    size_t size = sizeof (hdr);
+
+    if (slot->round >= mca_bml_r2.probe_count) {
+        size = slot->large_size;
+    }
+
+    hdr.stamp = (uint64_t) opal_timer_base_get_cycles ();
+
+    return mca_bml_r2_probe_send (bml_btl->btl, bml_btl->btl_endpoint, &hdr, size);
+}
+
+/* endpoint of the btl to a peer the btl did not tell about */
+static struct mca_btl_base_endpoint_t *mca_bml_r2_probe_lookup (mca_btl_base_module_t *btl,
+                                                                opal_process_name_t name)
+{
+    ompi_proc_t *proc = (ompi_proc_t *) ompi_proc_lookup (name);
+    mca_bml_base_endpoint_t *bml_endpoint;
+    mca_bml_base_btl_t *bml_btl;
+
+    if (NULL == proc) {
+        return NULL;
+    }
+
+    bml_endpoint = (mca_bml_base_endpoint_t *) proc->proc_endpoints[OMPI_PROC_ENDPOINT_TAG_BML];
+    if (NULL == bml_endpoint) {
+        return NULL;
+    }
+
+    bml_btl = mca_bml_base_btl_array_find (&bml_endpoint->btl_send, btl);
+
+    return (NULL != bml_btl) ? bml_btl->btl_endpoint : NULL;
+}
+
+static void mca_bml_r2_probe_recv (mca_btl_base_module_t *btl,
+                                   const mca_btl_base_receive_descriptor_t *descriptor)
+{
+    const uint64_t now = (uint64_t) opal_timer_base_get_cycles ();
+    mca_bml_r2_probe_slot_t *slot;
+    mca_bml_r2_probe_hdr_t hdr;
+    uint64_t rtt;
+
+    if (OPAL_UNLIKELY(descriptor->des_segments[0].seg_len < sizeof (hdr))) {
+        return;
+    }
+
+    memcpy (&hdr, descriptor->des_segments[0].seg_addr.pval, sizeof (hdr));
+
+    if (MCA_BML_R2_PROBE_PING == hdr.type) {
+        struct mca_btl_base_endpoint_t *endpoint = descriptor->endpoint;
+
+        if (NULL == endpoint) {
+            endpoint = mca_bml_r2_probe_lookup (btl, hdr.name);
+            if (NULL == endpoint) {
+                /* the peer is not set up here yet, it gives up on this btl after its timeout */
+                return;
+            }
+        }
+
+        hdr.type = MCA_BML_R2_PROBE_PONG;
+        hdr.name = ompi_proc_local_proc->super.proc_name;
+        (void) mca_bml_r2_probe_send (btl, endpoint, &hdr, sizeof (hdr));
+        return;
+    }
+
+    if (hdr.epoch != mca_bml_r2_probe_epoch || hdr.slot >= mca_bml_r2_probe_nslots) {
+        /* late answer to an earlier probe */
+        return;
+    }
+
+    slot = mca_bml_r2_probe_slots + hdr.slot;
+    rtt = now - hdr.stamp;
+
+    if (slot->round < mca_bml_r2.probe_count) {
+        if (0 == slot->round || rtt < slot->min_small) {
+            slot->min_small = rtt;
+        }
+    } else if (mca_bml_r2.probe_count == slot->round || rtt < slot->min_large) {
+        slot->min_large = rtt;
+    }
+
+    if (++slot->round < slot->rounds && OMPI_SUCCESS == mca_bml_r2_probe_ping (hdr.slot)) {
+        return;
+    }
+
+    /* done, or the btl can not send the next ping */
+    (void) OPAL_THREAD_ADD_FETCH32(&mca_bml_r2_probe_pending, -1);
+}
+
+int mca_bml_r2_probe_init (void)
+{
+    if (!mca_bml_r2.probe) {
+        return OMPI_SUCCESS;
+    }
+
+    return mca_bml_r2.super.bml_register (MCA_BTL_TAG_BML, mca_bml_r2_probe_recv, NULL);
+}
+
+void mca_bml_r2_probe_endpoints (mca_bml_base_endpoint_t **endpoints, size_t count)
+{
+    const double freq = (double) opal_timer_base_get_freq () / 1000000.0;
+    mca_bml_r2_probe_slot_t *slots;
+    uint64_t start, timeout;
+    uint32_t nslots = 0;
+
+    if (!mca_bml_r2.probe || mca_bml_r2.probe_count <= 0) {
+        return;
+    }
+
+    for (size_t i = 0 ; i < count ; ++i) {
+        size_t n_send = mca_bml_base_btl_array_get_size (&endpoints[i]->btl_send);
+        if (n_send > 1) {
+            nslots += (uint32_t) n_send;
+        }
+    }
+
+    if (0 == nslots) {
+        return;
+    }
+
+    slots = (mca_bml_r2_probe_slot_t *) calloc (nslots, sizeof (slots[0]));
+    if (NULL == slots) {
+        return;
+    }
+
+    nslots = 0;
+    for (size_t i = 0 ; i < count ; ++i) {
+        size_t n_send = mca_bml_base_btl_array_get_size (&endpoints[i]->btl_send);
+
+        if (n_send < 2) {
+            continue;
+        }
+
+        for (size_t j = 0 ; j < n_send ; ++j) {
+            mca_bml_r2_probe_slot_t *slot = slots + nslots++;
+
+            slot->bml_btl = mca_bml_base_btl_array_get_index (&endpoints[i]->btl_send, j);
+            slot->large_size = mca_bml_r2.probe_size;
+            if (slot->large_size > slot->bml_btl->btl->btl_eager_limit) {
+                slot->large_size = slot->bml_btl->btl->btl_eager_limit;
+            }
+
+            slot->rounds = mca_bml_r2.probe_count;
+            if (slot->large_size > sizeof (mca_bml_r2_probe_hdr_t)) {
+                slot->rounds *= 2;
+            } else {
+                slot->large_size = 0;
+            }
+        }
+    }
+
+    mca_bml_r2_probe_slots = slots;
+    mca_bml_r2_probe_pending = (int32_t) nslots;
+    opal_atomic_wmb ();
+    mca_bml_r2_probe_nslots = nslots;
+
+    for (uint32_t i = 0 ; i < nslots ; ++i) {
+        if (OMPI_SUCCESS != mca_bml_r2_probe_ping (i)) {
+            (void) OPAL_THREAD_ADD_FETCH32(&mca_bml_r2_probe_pending, -1);
+        }
+    }
+
+    start = (uint64_t) opal_timer_base_get_cycles ();
+    timeout = (uint64_t) ((double) mca_bml_r2.probe_timeout * freq);
+    while (mca_bml_r2_probe_pending > 0
+           && (uint64_t) opal_timer_base_get_cycles () - start < timeout) {
+        opal_progress ();
+    }
+
+    /* the answers that arrive from now on belong to a finished probe */
+    mca_bml_r2_probe_nslots = 0;
+    ++mca_bml_r2_probe_epoch;
+    opal_atomic_wmb ();
+    mca_bml_r2_probe_slots = NULL;
+
+    for (uint32_t i = 0 ; i < nslots ; ++i) {
+        mca_bml_r2_probe_slot_t *slot = slots + i;
+        mca_bml_base_btl_t *bml_btl = slot->bml_btl;
+
+        if (slot->round < slot->rounds || 0 == slot->large_size
+            || slot->min_large <= slot->min_small) {
+            /* not (completely) measured, keep the static ranking */
+            continue;
+        }
+
+        /* half of the round trip for the latency, the large pings carry the extra bytes one way */
+        bml_btl->btl_probe_latency = (double) slot->min_small / freq / 2.0;
+        bml_btl->btl_probe_bandwidth = (double) (slot->large_size - sizeof (mca_bml_r2_probe_hdr_t)) * 8.0
+            / ((double) (slot->min_large - slot->min_small) / freq);
+
+        opal_output_verbose (10, ompi_bml_base_framework.framework_output,
+                             "bml:r2: probe of btl %s: latency %.2f usec, bandwidth %.0f Mbps",
+                             bml_btl->btl->btl_component->btl_version.mca_component_name,
+                             bml_btl->btl_probe_latency, bml_btl->btl_probe_bandwidth);
+    }
+
+    free (slots);
+}
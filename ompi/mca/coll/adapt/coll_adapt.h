@@ -94,6 +94,10 @@ typedef struct mca_coll_adapt_collective_fallback_s {
     union {
         mca_coll_base_module_reduce_fn_t   reduce;
         mca_coll_base_module_ireduce_fn_t ireduce;
+        mca_coll_base_module_allreduce_fn_t   allreduce;
+        mca_coll_base_module_iallreduce_fn_t iallreduce;
+        mca_coll_base_module_allgather_fn_t   allgather;
+        mca_coll_base_module_iallgather_fn_t iallgather;
     } previous_routine;
     mca_coll_base_module_t *previous_module;
 } mca_coll_adapt_collective_fallback_t;
@@ -102,6 +106,10 @@ typedef struct mca_coll_adapt_collective_fallback_s {
 typedef enum mca_coll_adapt_colltype {
     ADAPT_REDUCE  = 0,
     ADAPT_IREDUCE = 1,
+    ADAPT_ALLREDUCE  = 2,
+    ADAPT_IALLREDUCE = 3,
+    ADAPT_ALLGATHER  = 4,
+    ADAPT_IALLGATHER = 5,
     ADAPT_COLLCOUNT
 } mca_coll_adapt_colltype_t;
 
@@ -111,9 +119,17 @@ typedef enum mca_coll_adapt_colltype {
  */
 #define previous_reduce     previous_routines[ADAPT_REDUCE].previous_routine.reduce
 #define previous_ireduce    previous_routines[ADAPT_IREDUCE].previous_routine.ireduce
+#define previous_allreduce  previous_routines[ADAPT_ALLREDUCE].previous_routine.allreduce
+#define previous_iallreduce previous_routines[ADAPT_IALLREDUCE].previous_routine.iallreduce
+#define previous_allgather  previous_routines[ADAPT_ALLGATHER].previous_routine.allgather
+#define previous_iallgather previous_routines[ADAPT_IALLGATHER].previous_routine.iallgather
 
 #define previous_reduce_module     previous_routines[ADAPT_REDUCE].previous_module
 #define previous_ireduce_module    previous_routines[ADAPT_IREDUCE].previous_module
+#define previous_allreduce_module  previous_routines[ADAPT_ALLREDUCE].previous_module
+#define previous_iallreduce_module previous_routines[ADAPT_IALLREDUCE].previous_module
+#define previous_allgather_module  previous_routines[ADAPT_ALLGATHER].previous_module
+#define previous_iallgather_module previous_routines[ADAPT_IALLGATHER].previous_module
 
 
 /* Coll adapt module per communicator*/
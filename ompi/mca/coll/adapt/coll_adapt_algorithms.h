@@ -19,6 +19,8 @@ int ompi_coll_adapt_ibcast_register(void);
 int ompi_coll_adapt_ibcast_fini(void);
 int ompi_coll_adapt_bcast(BCAST_ARGS);
 int ompi_coll_adapt_ibcast(IBCAST_ARGS);
+int ompi_coll_adapt_ibcast_generic(IBCAST_ARGS, ompi_coll_tree_t * tree, size_t seg_size,
+                                   int ibcast_tag);
 
 /* Reduce */
 int ompi_coll_adapt_ireduce_register(void);
@@ -26,3 +28,10 @@ int ompi_coll_adapt_ireduce_fini(void);
 int ompi_coll_adapt_reduce(REDUCE_ARGS);
 int ompi_coll_adapt_ireduce(IREDUCE_ARGS);
 
+/* Allreduce, ireduce to rank 0 followed by an ibcast */
+int ompi_coll_adapt_allreduce(ALLREDUCE_ARGS);
+int ompi_coll_adapt_iallreduce(IALLREDUCE_ARGS);
+
+/* Allgather, one ibcast per rank */
+int ompi_coll_adapt_allgather(ALLGATHER_ARGS);
+int ompi_coll_adapt_iallgather(IALLGATHER_ARGS);
@@ -40,3 +40,6 @@ OBJ_CLASS_INSTANCE(ompi_coll_adapt_reduce_context_t, opal_free_list_item_t,
 OBJ_CLASS_INSTANCE(ompi_coll_adapt_constant_reduce_context_t, opal_object_t,
                    &adapt_constant_reduce_context_construct,
                    &adapt_constant_reduce_context_destruct);
+
+OBJ_CLASS_INSTANCE(ompi_coll_adapt_constant_composed_context_t, opal_object_t,
+                   NULL, NULL);
@@ -126,3 +126,22 @@ struct ompi_coll_adapt_reduce_context_s {
 };
 
 OBJ_CLASS_DECLARATION(ompi_coll_adapt_reduce_context_t);
+
+/* Context of the collectives composed of ireduce and ibcast requests */
+struct ompi_coll_adapt_constant_composed_context_s {
+    opal_object_t super;
+    void *buff;
+    int count;
+    ompi_datatype_t *datatype;
+    ompi_communicator_t *comm;
+    mca_coll_base_module_t *module;
+    /* Tags of the ibcast started once the ireduce completes */
+    int ibcast_tag;
+    /* Number of sub requests not completed yet */
+    opal_atomic_int32_t num_pending;
+    ompi_request_t *request;
+};
+
+typedef struct ompi_coll_adapt_constant_composed_context_s ompi_coll_adapt_constant_composed_context_t;
+
+OBJ_CLASS_DECLARATION(ompi_coll_adapt_constant_composed_context_t);
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "coll_adapt.h"
+#include "coll_adapt_algorithms.h"
+#include "coll_adapt_context.h"
+#include "ompi/constants.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
+
+/*
+ * MPI_Iallgather in the ADAPT module: every rank broadcasts its block of
+ * rbuf with the segmented, callback driven ibcast, over the cached tree
+ * rooted at itself. All the ibcasts progress independently, so a late
+ * rank only delays the delivery of its own block.
+ */
+
+/*
+ * Completion of one of the ibcasts: the last one completes the allgather
+ */
+static int iallgather_bcast_cb(ompi_request_t * req)
+{
+    ompi_coll_adapt_constant_composed_context_t *con =
+        (ompi_coll_adapt_constant_composed_context_t *) req->req_complete_cb_data;
+    ompi_request_t *temp_req = con->request;
+
+    if (MPI_SUCCESS != req->req_status.MPI_ERROR) {
+        temp_req->req_status.MPI_ERROR = req->req_status.MPI_ERROR;
+    }
+    req->req_free(&req);
+
+    if (0 == opal_atomic_sub_fetch_32(&con->num_pending, 1)) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                             "[%d]: iallgather complete\n", ompi_comm_rank(con->comm)));
+        OBJ_RELEASE(con);
+        ompi_request_complete(temp_req, 1);
+    }
+    /* Call back function return 1 to signal that request has been free'd */
+    return 1;
+}
+
+int ompi_coll_adapt_iallgather(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                               void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                               struct ompi_communicator_t *comm, ompi_request_t ** request,
+                               mca_coll_base_module_t * module)
+{
+    mca_coll_adapt_module_t *adapt_module = (mca_coll_adapt_module_t *) module;
+    ompi_coll_adapt_constant_composed_context_t *con;
+    ompi_coll_base_nbc_request_t *temp_request;
+    ptrdiff_t rlb, rext;
+    int rank, size, err = MPI_SUCCESS;
+
+    if (0 == rcount ||
+        OMPI_COLL_ADAPT_ALGORITHM_TUNED == mca_coll_adapt_component.adapt_ibcast_algorithm) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                    "ADAPT cannot handle this iallgather. It needs to fall back on another component\n"));
+        return adapt_module->previous_iallgather(sbuf, scount, sdtype, rbuf, rcount, rdtype,
+                                                 comm, request,
+                                                 adapt_module->previous_iallgather_module);
+    }
+
+    rank = ompi_comm_rank(comm);
+    size = ompi_comm_size(comm);
+    ompi_datatype_get_extent(rdtype, &rlb, &rext);
+
+    OPAL_OUTPUT_VERBOSE((10, mca_coll_adapt_component.adapt_output,
+                         "iallgather rcount %d, bcast algorithm %d\n",
+                         rcount, mca_coll_adapt_component.adapt_ibcast_algorithm));
+
+    /* Place the local block */
+    if (MPI_IN_PLACE != sbuf) {
+        err = ompi_datatype_sndrcv((void *) sbuf, scount, sdtype,
+                                   (char *) rbuf + (ptrdiff_t) rank * (ptrdiff_t) rcount * rext,
+                                   rcount, rdtype);
+        if (MPI_SUCCESS != err) {
+            return err;
+        }
+    }
+
+    /* Set up request */
+    temp_request = OBJ_NEW(ompi_coll_base_nbc_request_t);
+    OMPI_REQUEST_INIT(&temp_request->super, false);
+    temp_request->super.req_state = OMPI_REQUEST_ACTIVE;
+    temp_request->super.req_type = OMPI_REQUEST_COLL;
+    temp_request->super.req_free = ompi_coll_adapt_request_free;
+    temp_request->super.req_status.MPI_SOURCE = 0;
+    temp_request->super.req_status.MPI_TAG = 0;
+    temp_request->super.req_status.MPI_ERROR = 0;
+    temp_request->super.req_status._cancelled = 0;
+    temp_request->super.req_status._ucount = 0;
+    *request = (ompi_request_t*)temp_request;
+
+    con = OBJ_NEW(ompi_coll_adapt_constant_composed_context_t);
+    con->buff = rbuf;
+    con->count = rcount;
+    con->datatype = rdtype;
+    con->comm = comm;
+    con->module = module;
+    con->ibcast_tag = 0;
+    con->request = (ompi_request_t*)temp_request;
+    /* One per ibcast, plus one released once they are all started, so
+     * that ibcasts completing early cannot complete the request */
+    con->num_pending = size + 1;
+
+    /* Every process starts the ibcasts in the same order, which keeps
+     * their tags consistent */
+    for (int root = 0; root < size; root++) {
+        ompi_request_t *bcast_req = NULL;
+
+        err = ompi_coll_adapt_ibcast((char *) rbuf + (ptrdiff_t) root * (ptrdiff_t) rcount * rext,
+                                     rcount, rdtype, root, comm, &bcast_req, module);
+        if (MPI_SUCCESS != err) {
+            /* the ibcasts that are not started never complete */
+            temp_request->super.req_status.MPI_ERROR = err;
+            opal_atomic_sub_fetch_32(&con->num_pending, size - root);
+            break;
+        }
+        ompi_request_set_callback(bcast_req, iallgather_bcast_cb, con);
+    }
+
+    if (0 == opal_atomic_sub_fetch_32(&con->num_pending, 1)) {
+        OBJ_RELEASE(con);
+        ompi_request_complete(&temp_request->super, 1);
+    }
+
+    return err;
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/op/op.h"
+#include "coll_adapt.h"
+#include "coll_adapt_algorithms.h"
+#include "coll_adapt_context.h"
+#include "coll_adapt_topocache.h"
+#include "ompi/constants.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+
+/*
+ * MPI_Iallreduce in the ADAPT module is an ireduce to rank 0 followed, as
+ * soon as the ireduce completes locally, by an ibcast from rank 0. Both
+ * phases are the segmented, callback driven ireduce and ibcast, so a late
+ * peer only delays the segments it takes part in. Like ireduce it only
+ * works for commutative operations.
+ */
+
+/*
+ * Completion of the ibcast: complete the allreduce request
+ */
+static int iallreduce_bcast_cb(ompi_request_t * req)
+{
+    ompi_coll_adapt_constant_composed_context_t *con =
+        (ompi_coll_adapt_constant_composed_context_t *) req->req_complete_cb_data;
+    ompi_request_t *temp_req = con->request;
+
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                         "[%d]: iallreduce_bcast_cb\n", ompi_comm_rank(con->comm)));
+
+    if (MPI_SUCCESS != req->req_status.MPI_ERROR) {
+        temp_req->req_status.MPI_ERROR = req->req_status.MPI_ERROR;
+    }
+    req->req_free(&req);
+    OBJ_RELEASE(con);
+
+    ompi_request_complete(temp_req, 1);
+    /* Call back function return 1 to signal that request has been free'd */
+    return 1;
+}
+
+/*
+ * Completion of the ireduce: start the ibcast of the result, on the tags
+ * reserved when the allreduce started
+ */
+static int iallreduce_reduce_cb(ompi_request_t * req)
+{
+    ompi_coll_adapt_constant_composed_context_t *con =
+        (ompi_coll_adapt_constant_composed_context_t *) req->req_complete_cb_data;
+    ompi_request_t *bcast_req = NULL;
+    int err = req->req_status.MPI_ERROR;
+
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                         "[%d]: iallreduce_reduce_cb, start ibcast tag %d\n",
+                         ompi_comm_rank(con->comm), con->ibcast_tag));
+
+    req->req_free(&req);
+
+    if (MPI_SUCCESS == err) {
+        err = ompi_coll_adapt_ibcast_generic(con->buff, con->count, con->datatype, 0,
+                                             con->comm, &bcast_req, con->module,
+                                             adapt_module_cached_topology(con->module, con->comm, 0,
+                                                                          mca_coll_adapt_component.adapt_ibcast_algorithm),
+                                             mca_coll_adapt_component.adapt_ibcast_segment_size,
+                                             con->ibcast_tag);
+    }
+    if (MPI_SUCCESS != err) {
+        ompi_request_t *temp_req = con->request;
+        temp_req->req_status.MPI_ERROR = err;
+        OBJ_RELEASE(con);
+        ompi_request_complete(temp_req, 1);
+        return 1;
+    }
+
+    ompi_request_set_callback(bcast_req, iallreduce_bcast_cb, con);
+    return 1;
+}
+
+int ompi_coll_adapt_iallreduce(const void *sbuf, void *rbuf, int count, struct ompi_datatype_t *dtype,
+                               struct ompi_op_t *op, struct ompi_communicator_t *comm,
+                               ompi_request_t ** request, mca_coll_base_module_t * module)
+{
+    mca_coll_adapt_module_t *adapt_module = (mca_coll_adapt_module_t *) module;
+    ompi_coll_adapt_constant_composed_context_t *con;
+    ompi_coll_base_nbc_request_t *temp_request;
+    ompi_request_t *reduce_req = NULL;
+    const void *reduce_sbuf = sbuf;
+    size_t type_size;
+    int seg_count = count, num_segs, err;
+
+    /* Fall-back if operation is not commutative, or if one of the phases is not available */
+    if (!ompi_op_is_commute(op) || 0 == count ||
+        OMPI_COLL_ADAPT_ALGORITHM_TUNED == mca_coll_adapt_component.adapt_ireduce_algorithm ||
+        OMPI_COLL_ADAPT_ALGORITHM_TUNED == mca_coll_adapt_component.adapt_ibcast_algorithm) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
+                    "ADAPT cannot handle this iallreduce. It needs to fall back on another component\n"));
+        return adapt_module->previous_iallreduce(sbuf, rbuf, count, dtype, op,
+                                                 comm, request,
+                                                 adapt_module->previous_iallreduce_module);
+    }
+
+    OPAL_OUTPUT_VERBOSE((10, mca_coll_adapt_component.adapt_output,
+                         "iallreduce count %d, reduce algorithm %d, bcast algorithm %d\n",
+                         count, mca_coll_adapt_component.adapt_ireduce_algorithm,
+                         mca_coll_adapt_component.adapt_ibcast_algorithm));
+
+    /* Set up request */
+    temp_request = OBJ_NEW(ompi_coll_base_nbc_request_t);
+    OMPI_REQUEST_INIT(&temp_request->super, false);
+    temp_request->super.req_state = OMPI_REQUEST_ACTIVE;
+    temp_request->super.req_type = OMPI_REQUEST_COLL;
+    temp_request->super.req_free = ompi_coll_adapt_request_free;
+    temp_request->super.req_status.MPI_SOURCE = 0;
+    temp_request->super.req_status.MPI_TAG = 0;
+    temp_request->super.req_status.MPI_ERROR = 0;
+    temp_request->super.req_status._cancelled = 0;
+    temp_request->super.req_status._ucount = 0;
+    *request = (ompi_request_t*)temp_request;
+
+    con = OBJ_NEW(ompi_coll_adapt_constant_composed_context_t);
+    con->buff = rbuf;
+    con->count = count;
+    con->datatype = dtype;
+    con->comm = comm;
+    con->module = module;
+    con->request = (ompi_request_t*)temp_request;
+
+    /* MPI_IN_PLACE only has a meaning at the root of the ireduce */
+    if (MPI_IN_PLACE == sbuf && 0 != ompi_comm_rank(comm)) {
+        reduce_sbuf = rbuf;
+    }
+
+    err = ompi_coll_adapt_ireduce(reduce_sbuf, rbuf, count, dtype, op, 0, comm, &reduce_req, module);
+    if (MPI_SUCCESS != err) {
+        OBJ_RELEASE(con);
+        ompi_coll_adapt_request_free(request);
+        return err;
+    }
+
+    /* Reserve the ibcast tags now: every process reserves them in the same
+     * order with respect to its other non-blocking collectives */
+    ompi_datatype_type_size(dtype, &type_size);
+    COLL_BASE_COMPUTED_SEGCOUNT(mca_coll_adapt_component.adapt_ibcast_segment_size, type_size, seg_count);
+    num_segs = (count + seg_count - 1) / seg_count;
+    con->ibcast_tag = ompi_coll_base_nbc_reserve_tags(comm, num_segs);
+
+    ompi_request_set_callback(reduce_req, iallreduce_reduce_cb, con);
+
+    return MPI_SUCCESS;
+}
@@ -21,9 +21,6 @@
 #include "opal/sys/atomic.h"
 #include "ompi/mca/pml/ob1/pml_ob1.h"
 
-static int ompi_coll_adapt_ibcast_generic(IBCAST_ARGS,
-                                   ompi_coll_tree_t * tree, size_t seg_size);
-
 /*
  * Set up MCA parameters of MPI_Bcast and MPI_IBcast
  */
@@ -336,14 +333,14 @@ int ompi_coll_adapt_ibcast(void *buff, int count, struct ompi_datatype_t *dataty
 
     return ompi_coll_adapt_ibcast_generic(buff, count, datatype, root, comm, request, module,
                                           adapt_module_cached_topology(module, comm, root, mca_coll_adapt_component.adapt_ibcast_algorithm),
-                                          mca_coll_adapt_component.adapt_ibcast_segment_size);
+                                          mca_coll_adapt_component.adapt_ibcast_segment_size, 0);
 }
 
 
 int ompi_coll_adapt_ibcast_generic(void *buff, int count, struct ompi_datatype_t *datatype, int root,
                                    struct ompi_communicator_t *comm, ompi_request_t ** request,
                                    mca_coll_base_module_t * module, ompi_coll_tree_t * tree,
-                                   size_t seg_size)
+                                   size_t seg_size, int ibcast_tag)
 {
     int i, j, rank, err;
     /* The min of num_segs and SEND_NUM or RECV_NUM, in case the num_segs is less than SEND_NUM or RECV_NUM */
@@ -439,7 +436,8 @@ int ompi_coll_adapt_ibcast_generic(void *buff, int count, struct ompi_datatype_t
     con->mutex = mutex;
     con->request = (ompi_request_t*)temp_request;
     con->tree = tree;
-    con->ibcast_tag = ompi_coll_base_nbc_reserve_tags(comm, num_segs);
+    /* the tags may have been reserved when the ibcast is part of a larger collective */
+    con->ibcast_tag = (0 != ibcast_tag) ? ibcast_tag : ompi_coll_base_nbc_reserve_tags(comm, num_segs);
 
     OPAL_OUTPUT_VERBOSE((30, mca_coll_adapt_component.adapt_output,
                          "[%d]: Ibcast, root %d, tag %d\n", rank, root,
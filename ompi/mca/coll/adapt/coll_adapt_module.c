@@ -109,6 +109,10 @@ static int adapt_module_enable(mca_coll_base_module_t * module,
 
     ADAPT_SAVE_PREV_COLL_API(reduce);
     ADAPT_SAVE_PREV_COLL_API(ireduce);
+    ADAPT_SAVE_PREV_COLL_API(allreduce);
+    ADAPT_SAVE_PREV_COLL_API(iallreduce);
+    ADAPT_SAVE_PREV_COLL_API(allgather);
+    ADAPT_SAVE_PREV_COLL_API(iallgather);
 
     return OMPI_SUCCESS;
 }
@@ -161,9 +165,9 @@ mca_coll_base_module_t *ompi_coll_adapt_comm_query(struct ompi_communicator_t *
 
     /* All is good -- return a module */
     adapt_module->super.coll_module_enable = adapt_module_enable;
-    adapt_module->super.coll_allgather = NULL;
+    adapt_module->super.coll_allgather = ompi_coll_adapt_allgather;
     adapt_module->super.coll_allgatherv = NULL;
-    adapt_module->super.coll_allreduce = NULL;
+    adapt_module->super.coll_allreduce = ompi_coll_adapt_allreduce;
     adapt_module->super.coll_alltoall = NULL;
     adapt_module->super.coll_alltoallw = NULL;
     adapt_module->super.coll_barrier = NULL;
@@ -178,7 +182,8 @@ mca_coll_base_module_t *ompi_coll_adapt_comm_query(struct ompi_communicator_t *
     adapt_module->super.coll_scatterv = NULL;
     adapt_module->super.coll_ibcast = ompi_coll_adapt_ibcast;
     adapt_module->super.coll_ireduce = ompi_coll_adapt_ireduce;
-    adapt_module->super.coll_iallreduce = NULL;
+    adapt_module->super.coll_iallreduce = ompi_coll_adapt_iallreduce;
+    adapt_module->super.coll_iallgather = ompi_coll_adapt_iallgather;
 
     opal_output_verbose(10, ompi_coll_base_framework.framework_output,
                         "coll:adapt:comm_query (%d/%s): pick me! pick me!",
@@ -34,6 +34,46 @@
 #include "coll_base_topo.h"
 #include "coll_base_util.h"
 
+/*
+ * Final local shift of the Bruck algorithms: block i of rbuf holds the data
+ * of rank (rank + i) % size, move it to block (rank + i) % size.
+ */
+static int
+allgather_bruck_shift(void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                      ptrdiff_t rext, int rank, int size)
+{
+    char *free_buf = NULL, *shift_buf = NULL, *tmpsend, *tmprecv;
+    ptrdiff_t span, gap = 0;
+    int err;
+
+    span = opal_datatype_span(&rdtype->super, (int64_t)(size - rank) * rcount, &gap);
+
+    free_buf = (char*)calloc(span, sizeof(char));
+    if (NULL == free_buf) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    shift_buf = free_buf - gap;
+
+    /* 1. copy blocks [0 .. (size - rank - 1)] from rbuf to shift buffer */
+    err = ompi_datatype_copy_content_same_ddt(rdtype, ((ptrdiff_t)(size - rank) * (ptrdiff_t)rcount),
+                                              shift_buf, rbuf);
+    if (err < 0) { free(free_buf); return err; }
+
+    /* 2. move blocks [(size - rank) .. size] from rbuf to the begining of rbuf */
+    tmpsend = (char*) rbuf + (ptrdiff_t)(size - rank) * (ptrdiff_t)rcount * rext;
+    err = ompi_datatype_copy_content_same_ddt(rdtype, (ptrdiff_t)rank * (ptrdiff_t)rcount,
+                                              rbuf, tmpsend);
+    if (err < 0) { free(free_buf); return err; }
+
+    /* 3. copy blocks from shift buffer back to rbuf starting at block [rank]. */
+    tmprecv = (char*) rbuf + (ptrdiff_t)rank * (ptrdiff_t)rcount * rext;
+    err = ompi_datatype_copy_content_same_ddt(rdtype, (ptrdiff_t)(size - rank) * (ptrdiff_t)rcount,
+                                              tmprecv, shift_buf);
+
+    free(free_buf);
+    return (err < 0) ? err : MPI_SUCCESS;
+}
+
 /*
  * ompi_coll_base_allgather_intra_bruck
  *
@@ -164,35 +204,109 @@ int ompi_coll_base_allgather_intra_bruck(const void *sbuf, int scount,
        - copy blocks from shift buffer starting at block [rank] in rbuf.
     */
     if (0 != rank) {
-        char *free_buf = NULL, *shift_buf = NULL;
-        ptrdiff_t span, gap = 0;
+        err = allgather_bruck_shift(rbuf, rcount, rdtype, rext, rank, size);
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+    }
 
-        span = opal_datatype_span(&rdtype->super, (int64_t)(size - rank) * rcount, &gap);
+    return OMPI_SUCCESS;
 
-        free_buf = (char*)calloc(span, sizeof(char));
-        if (NULL == free_buf) {
-            line = __LINE__; err = OMPI_ERR_OUT_OF_RESOURCE; goto err_hndl;
-        }
-        shift_buf = free_buf - gap;
+ err_hndl:
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,  "%s:%4d\tError occurred %d, rank %2d",
+                 __FILE__, line, err, rank));
+    (void)line;  // silence compiler warning
+    return err;
+}
 
-        /* 1. copy blocks [0 .. (size - rank - 1)] from rbuf to shift buffer */
-        err = ompi_datatype_copy_content_same_ddt(rdtype, ((ptrdiff_t)(size - rank) * (ptrdiff_t)rcount),
-                                                  shift_buf, rbuf);
-        if (err < 0) { line = __LINE__; free(free_buf); goto err_hndl;  }
+/*
+ * ompi_coll_base_allgather_intra_k_bruck
+ *
+ * Function:     allgather using O(log_k(N)) steps.
+ * Accepts:      Same arguments as MPI_Allgather, radix
+ * Returns:      MPI_SUCCESS or error code
+ *
+ * Description:  k-port variant of the Bruck algorithm above. At the step of
+ *               distance d (1, k, k^2, ...) rank r sends the blocks it holds
+ *               [0 .. d) to the k - 1 ranks r - j * d and receives the
+ *               blocks of the ranks r + j * d at block j * d, for j in
+ *               [1 .. k), all at the same time. Each step multiplies the
+ *               number of blocks by k, so the allgather takes log_k(N)
+ *               steps instead of log_2(N), as long as the network sustains
+ *               k - 1 concurrent messages. A radix of 2 is the Bruck
+ *               algorithm.
+ *
+ * Memory requirements:  as the Bruck algorithm.
+ */
+int ompi_coll_base_allgather_intra_k_bruck(const void *sbuf, int scount,
+                                           struct ompi_datatype_t *sdtype,
+                                           void* rbuf, int rcount,
+                                           struct ompi_datatype_t *rdtype,
+                                           struct ompi_communicator_t *comm,
+                                           mca_coll_base_module_t *module,
+                                           int radix)
+{
+    int line = -1, rank, size, k, distance, nreqs = 0, err = 0;
+    ompi_request_t **reqs = NULL;
+    ptrdiff_t rlb, rext;
 
-        /* 2. move blocks [(size - rank) .. size] from rbuf to the begining of rbuf */
-        tmpsend = (char*) rbuf + (ptrdiff_t)(size - rank) * (ptrdiff_t)rcount * rext;
-        err = ompi_datatype_copy_content_same_ddt(rdtype, (ptrdiff_t)rank * (ptrdiff_t)rcount,
-                                                  rbuf, tmpsend);
-        if (err < 0) { line = __LINE__; free(free_buf); goto err_hndl;  }
+    size = ompi_comm_size(comm);
+    rank = ompi_comm_rank(comm);
 
-        /* 3. copy blocks from shift buffer back to rbuf starting at block [rank]. */
-        tmprecv = (char*) rbuf + (ptrdiff_t)rank * (ptrdiff_t)rcount * rext;
-        err = ompi_datatype_copy_content_same_ddt(rdtype, (ptrdiff_t)(size - rank) * (ptrdiff_t)rcount,
-                                                  tmprecv, shift_buf);
-        if (err < 0) { line = __LINE__; free(free_buf); goto err_hndl;  }
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                 "coll:base:allgather_intra_k_bruck rank %d radix %d", rank, radix));
 
-        free(free_buf);
+    k = (radix < 2) ? 2 : radix;
+    if (k > size) {
+        k = size;
+    }
+
+    err = ompi_datatype_get_extent (rdtype, &rlb, &rext);
+    if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+
+    /* Our block goes to block 0, as in the Bruck algorithm */
+    if (MPI_IN_PLACE != sbuf) {
+        err = ompi_datatype_sndrcv((char*)sbuf, scount, sdtype, rbuf, rcount, rdtype);
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl;  }
+    } else if (0 != rank) {
+        char *tmpsend = ((char*)rbuf) + (ptrdiff_t)rank * (ptrdiff_t)rcount * rext;
+        err = ompi_datatype_copy_content_same_ddt(rdtype, rcount, rbuf, tmpsend);
+        if (err < 0) { line = __LINE__; goto err_hndl; }
+    }
+
+    if (1 == size) {
+        return MPI_SUCCESS;
+    }
+
+    reqs = ompi_coll_base_comm_get_reqs(module->base_data, 2 * (k - 1));
+    if (NULL == reqs) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+
+    for (distance = 1; distance < size; distance *= k) {
+        nreqs = 0;
+        for (int j = 1; j < k && j * distance < size; ++j) {
+            int blockcount = (distance < size - j * distance) ? distance : size - j * distance;
+            int recvfrom = (rank + j * distance) % size;
+            char *tmprecv = (char*) rbuf + (ptrdiff_t)j * (ptrdiff_t)distance * (ptrdiff_t)rcount * rext;
+
+            err = MCA_PML_CALL(irecv(tmprecv, (ptrdiff_t)blockcount * rcount, rdtype, recvfrom,
+                                     MCA_COLL_BASE_TAG_ALLGATHER, comm, &reqs[nreqs++]));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+        for (int j = 1; j < k && j * distance < size; ++j) {
+            int blockcount = (distance < size - j * distance) ? distance : size - j * distance;
+            int sendto = (rank - j * distance + size) % size;
+
+            err = MCA_PML_CALL(isend(rbuf, (ptrdiff_t)blockcount * rcount, rdtype, sendto,
+                                     MCA_COLL_BASE_TAG_ALLGATHER,
+                                     MCA_PML_BASE_SEND_STANDARD, comm, &reqs[nreqs++]));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+
+        err = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+    }
+
+    if (0 != rank) {
+        err = allgather_bruck_shift(rbuf, rcount, rdtype, rext, rank, size);
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
     }
 
     return OMPI_SUCCESS;
@@ -201,6 +315,9 @@ int ompi_coll_base_allgather_intra_bruck(const void *sbuf, int scount,
     OPAL_OUTPUT((ompi_coll_base_framework.framework_output,  "%s:%4d\tError occurred %d, rank %2d",
                  __FILE__, line, err, rank));
     (void)line;  // silence compiler warning
+    if (NULL != reqs) {
+        ompi_coll_base_free_reqs(reqs, nreqs);
+    }
     return err;
 }
 
@@ -347,7 +347,7 @@ ompi_coll_base_allreduce_intra_ring(const void *sbuf, void *rbuf, int count,
     int ret, line, rank, size, k, recv_from, send_to, block_count, inbi;
     int early_segcount, late_segcount, split_rank, max_segcount;
     size_t typelng;
-    char *tmpsend = NULL, *tmprecv = NULL, *inbuf[2] = {NULL, NULL};
+    char *tmpsend = NULL, *tmprecv = NULL, *lbuf = NULL, *inbuf[2] = {NULL, NULL};
     ptrdiff_t true_lb, true_extent, lb, extent;
     ptrdiff_t block_offset, max_real_segsize;
     ompi_request_t *reqs[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
@@ -404,11 +404,11 @@ ompi_coll_base_allreduce_intra_ring(const void *sbuf, void *rbuf, int count,
         if (NULL == inbuf[1]) { ret = -1; line = __LINE__; goto error_hndl; }
     }
 
-    /* Handle MPI_IN_PLACE */
-    if (MPI_IN_PLACE != sbuf) {
-        ret = ompi_datatype_copy_content_same_ddt(dtype, count, (char*)rbuf, (char*)sbuf);
-        if (ret < 0) { line = __LINE__; goto error_hndl; }
-    }
+    /* There is no copy of sbuf into rbuf: each block is either reduced
+       exactly once from sbuf into rbuf, or received in the distribution
+       loop, so the local contribution is read from lbuf (sbuf, or rbuf
+       for MPI_IN_PLACE) by the 3 buffer reduction. */
+    lbuf = (MPI_IN_PLACE == sbuf) ? (char*)rbuf : (char*)sbuf;
 
     /* Computation loop */
 
@@ -440,7 +440,7 @@ ompi_coll_base_allreduce_intra_ring(const void *sbuf, void *rbuf, int count,
                     ((ptrdiff_t)rank * (ptrdiff_t)early_segcount) :
                     ((ptrdiff_t)rank * (ptrdiff_t)late_segcount + split_rank));
     block_count = ((rank < split_rank)? early_segcount : late_segcount);
-    tmpsend = ((char*)rbuf) + block_offset * extent;
+    tmpsend = lbuf + block_offset * extent;
     ret = MCA_PML_CALL(send(tmpsend, block_count, dtype, send_to,
                             MCA_COLL_BASE_TAG_ALLREDUCE,
                             MCA_PML_BASE_SEND_STANDARD, comm));
@@ -468,7 +468,8 @@ ompi_coll_base_allreduce_intra_ring(const void *sbuf, void *rbuf, int count,
                         ((ptrdiff_t)prevblock * late_segcount + split_rank));
         block_count = ((prevblock < split_rank)? early_segcount : late_segcount);
         tmprecv = ((char*)rbuf) + (ptrdiff_t)block_offset * extent;
-        ompi_op_reduce(op, inbuf[inbi ^ 0x1], tmprecv, block_count, dtype);
+        ompi_3buff_op_reduce(op, inbuf[inbi ^ 0x1], lbuf + (ptrdiff_t)block_offset * extent,
+                             tmprecv, block_count, dtype);
 
         /* send previous block to send_to */
         ret = MCA_PML_CALL(send(tmprecv, block_count, dtype, send_to,
@@ -489,7 +490,8 @@ ompi_coll_base_allreduce_intra_ring(const void *sbuf, void *rbuf, int count,
                     ((ptrdiff_t)recv_from * late_segcount + split_rank));
     block_count = ((recv_from < split_rank)? early_segcount : late_segcount);
     tmprecv = ((char*)rbuf) + (ptrdiff_t)block_offset * extent;
-    ompi_op_reduce(op, inbuf[inbi], tmprecv, block_count, dtype);
+    ompi_3buff_op_reduce(op, inbuf[inbi], lbuf + (ptrdiff_t)block_offset * extent,
+                         tmprecv, block_count, dtype);
 
     /* Distribution loop - variation of ring allgather */
     send_to = (rank + 1) % size;
@@ -626,7 +628,7 @@ ompi_coll_base_allreduce_intra_ring_segmented(const void *sbuf, void *rbuf, int
     int early_blockcount, late_blockcount, split_rank;
     int segcount, max_segcount, num_phases, phase, block_count, inbi;
     size_t typelng;
-    char *tmpsend = NULL, *tmprecv = NULL, *inbuf[2] = {NULL, NULL};
+    char *tmpsend = NULL, *tmprecv = NULL, *lbuf = NULL, *inbuf[2] = {NULL, NULL};
     ptrdiff_t block_offset, max_real_segsize;
     ompi_request_t *reqs[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
     ptrdiff_t lb, extent, gap;
@@ -692,11 +694,11 @@ ompi_coll_base_allreduce_intra_ring_segmented(const void *sbuf, void *rbuf, int
         if (NULL == inbuf[1]) { ret = -1; line = __LINE__; goto error_hndl; }
     }
 
-    /* Handle MPI_IN_PLACE */
-    if (MPI_IN_PLACE != sbuf) {
-        ret = ompi_datatype_copy_content_same_ddt(dtype, count, (char*)rbuf, (char*)sbuf);
-        if (ret < 0) { line = __LINE__; goto error_hndl; }
-    }
+    /* There is no copy of sbuf into rbuf: each segment of a block is either
+       reduced exactly once from sbuf into rbuf, or received in the distribution
+       loop, so the local contribution is read from lbuf (sbuf, or rbuf
+       for MPI_IN_PLACE) by the 3 buffer reduction. */
+    lbuf = (MPI_IN_PLACE == sbuf) ? (char*)rbuf : (char*)sbuf;
 
     /* Computation loop: for each phase, repeat ring allreduce computation loop */
     for (phase = 0; phase < num_phases; phase ++) {
@@ -742,7 +744,7 @@ ompi_coll_base_allreduce_intra_ring_segmented(const void *sbuf, void *rbuf, int
         phase_offset = ((phase < split_phase)?
                         ((ptrdiff_t)phase * (ptrdiff_t)early_phase_segcount) :
                         ((ptrdiff_t)phase * (ptrdiff_t)late_phase_segcount + split_phase));
-        tmpsend = ((char*)rbuf) + (ptrdiff_t)(block_offset + phase_offset) * extent;
+        tmpsend = lbuf + (ptrdiff_t)(block_offset + phase_offset) * extent;
         ret = MCA_PML_CALL(send(tmpsend, phase_count, dtype, send_to,
                                 MCA_COLL_BASE_TAG_ALLREDUCE,
                                 MCA_PML_BASE_SEND_STANDARD, comm));
@@ -779,7 +781,9 @@ ompi_coll_base_allreduce_intra_ring_segmented(const void *sbuf, void *rbuf, int
                             ((ptrdiff_t)phase * (ptrdiff_t)early_phase_segcount) :
                             ((ptrdiff_t)phase * (ptrdiff_t)late_phase_segcount + split_phase));
             tmprecv = ((char*)rbuf) + (ptrdiff_t)(block_offset + phase_offset) * extent;
-            ompi_op_reduce(op, inbuf[inbi ^ 0x1], tmprecv, phase_count, dtype);
+            ompi_3buff_op_reduce(op, inbuf[inbi ^ 0x1],
+                                 lbuf + (ptrdiff_t)(block_offset + phase_offset) * extent,
+                                 tmprecv, phase_count, dtype);
 
             /* send previous block to send_to */
             ret = MCA_PML_CALL(send(tmprecv, phase_count, dtype, send_to,
@@ -808,7 +812,9 @@ ompi_coll_base_allreduce_intra_ring_segmented(const void *sbuf, void *rbuf, int
                         ((ptrdiff_t)phase * (ptrdiff_t)early_phase_segcount) :
                         ((ptrdiff_t)phase * (ptrdiff_t)late_phase_segcount + split_phase));
         tmprecv = ((char*)rbuf) + (ptrdiff_t)(block_offset + phase_offset) * extent;
-        ompi_op_reduce(op, inbuf[inbi], tmprecv, phase_count, dtype);
+        ompi_3buff_op_reduce(op, inbuf[inbi],
+                             lbuf + (ptrdiff_t)(block_offset + phase_offset) * extent,
+                             tmprecv, phase_count, dtype);
     }
 
     /* Distribution loop - variation of ring allgather */
@@ -959,9 +965,11 @@ ompi_coll_base_allreduce_intra_basic_linear(const void *sbuf, void *rbuf, int co
  * a power of two, the total result vector must be sent to the r processes
  * that were removed in the first step.
  *
+ * Non-commutative operations: as in the reduce, the local reductions
+ * keep the order of the ranks within each block.
+ *
  * Limitations:
  *   count >= 2^{\floor{\log_2 p}}
- *   commutative operations only
  *   intra-communicators only
  *
  * Memory requirements (per process):
@@ -985,7 +993,7 @@ int ompi_coll_base_allreduce_intra_redscat_allgather(
     assert(nsteps >= 0);
     int nprocs_pof2 = 1 << nsteps;                              /* flp2(comm_size) */
 
-    if (count < nprocs_pof2 || !ompi_op_is_commute(op)) {
+    if (count < nprocs_pof2) {
         OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
                      "coll:base:allreduce_intra_redscat_allgather: rank %d/%d "
                      "count %d switching to basic linear allreduce",
@@ -1006,7 +1014,14 @@ int ompi_coll_base_allreduce_intra_redscat_allgather(
         return OMPI_ERR_OUT_OF_RESOURCE;
     tmp_buf = tmp_buf_raw - gap;
 
-    if (sbuf != MPI_IN_PLACE) {
+    /*
+     * The first reduction on each part of the vector reads the local
+     * contribution from lbuf and stores the result in rbuf, the parts
+     * that are never reduced locally are received in the allgather
+     * phase. Thus, but for a single process, sbuf is not copied to rbuf.
+     */
+    char *lbuf = (MPI_IN_PLACE == sbuf) ? (char *)rbuf : (char *)sbuf;
+    if (1 == comm_size && MPI_IN_PLACE != sbuf) {
         err = ompi_datatype_copy_content_same_ddt(dtype, count, (char *)rbuf,
                                                   (char *)sbuf);
         if (MPI_SUCCESS != err) { goto cleanup_and_return; }
@@ -1042,7 +1057,7 @@ int ompi_coll_base_allreduce_intra_redscat_allgather(
              * Send the left half of the input vector to the left neighbor,
              * Recv the right half of the input vector from the left neighbor
              */
-            err = ompi_coll_base_sendrecv(rbuf, count_lhalf, dtype, rank - 1,
+            err = ompi_coll_base_sendrecv(lbuf, count_lhalf, dtype, rank - 1,
                                           MCA_COLL_BASE_TAG_ALLREDUCE,
                                           (char *)tmp_buf + (ptrdiff_t)count_lhalf * extent,
                                           count_rhalf, dtype, rank - 1,
@@ -1051,8 +1066,10 @@ int ompi_coll_base_allreduce_intra_redscat_allgather(
             if (MPI_SUCCESS != err) { goto cleanup_and_return; }
 
             /* Reduce on the right half of the buffers (result in rbuf) */
-            ompi_op_reduce(op, (char *)tmp_buf + (ptrdiff_t)count_lhalf * extent,
-                           (char *)rbuf + count_lhalf * extent, count_rhalf, dtype);
+            ompi_coll_base_reduce_in_order(op, (char *)tmp_buf + (ptrdiff_t)count_lhalf * extent,
+                                           lbuf + (ptrdiff_t)count_lhalf * extent,
+                                           (char *)rbuf + (ptrdiff_t)count_lhalf * extent,
+                                           count_rhalf, dtype, true);
 
             /* Send the right half to the left neighbor */
             err = MCA_PML_CALL(send((char *)rbuf + (ptrdiff_t)count_lhalf * extent,
@@ -1070,7 +1087,7 @@ int ompi_coll_base_allreduce_intra_redscat_allgather(
              * Send the right half of the input vector to the right neighbor,
              * Recv the left half of the input vector from the right neighbor
              */
-            err = ompi_coll_base_sendrecv((char *)rbuf + (ptrdiff_t)count_lhalf * extent,
+            err = ompi_coll_base_sendrecv(lbuf + (ptrdiff_t)count_lhalf * extent,
                                           count_rhalf, dtype, rank + 1,
                                           MCA_COLL_BASE_TAG_ALLREDUCE,
                                           tmp_buf, count_lhalf, dtype, rank + 1,
@@ -1078,8 +1095,8 @@ int ompi_coll_base_allreduce_intra_redscat_allgather(
                                           MPI_STATUS_IGNORE, rank);
             if (MPI_SUCCESS != err) { goto cleanup_and_return; }
 
-            /* Reduce on the right half of the buffers (result in rbuf) */
-            ompi_op_reduce(op, tmp_buf, rbuf, count_lhalf, dtype);
+            /* Reduce on the left half of the buffers (result in rbuf) */
+            ompi_coll_base_reduce_in_order(op, tmp_buf, lbuf, rbuf, count_lhalf, dtype, false);
 
             /* Recv the right half from the right neighbor */
             err = MCA_PML_CALL(recv((char *)rbuf + (ptrdiff_t)count_lhalf * extent,
@@ -1089,6 +1106,8 @@ int ompi_coll_base_allreduce_intra_redscat_allgather(
             if (MPI_SUCCESS != err) { goto cleanup_and_return; }
 
             vrank = rank / 2;
+            /* The whole vector is in rbuf from now on */
+            lbuf = (char *)rbuf;
         }
     } else { /* rank >= 2 * nprocs_rem */
         vrank = rank - nprocs_rem;
@@ -1149,8 +1168,8 @@ int ompi_coll_base_allreduce_intra_redscat_allgather(
                 rindex[step] = sindex[step] + scount[step];
             }
 
-            /* Send part of data from the rbuf, recv into the tmp_buf */
-            err = ompi_coll_base_sendrecv((char *)rbuf + (ptrdiff_t)sindex[step] * extent,
+            /* Send part of data from the lbuf, recv into the tmp_buf */
+            err = ompi_coll_base_sendrecv(lbuf + (ptrdiff_t)sindex[step] * extent,
                                           scount[step], dtype, dest,
                                           MCA_COLL_BASE_TAG_ALLREDUCE,
                                           (char *)tmp_buf + (ptrdiff_t)rindex[step] * extent,
@@ -1159,10 +1178,13 @@ int ompi_coll_base_allreduce_intra_redscat_allgather(
                                           MPI_STATUS_IGNORE, rank);
             if (MPI_SUCCESS != err) { goto cleanup_and_return; }
 
-            /* Local reduce: rbuf[] = tmp_buf[] <op> rbuf[] */
-            ompi_op_reduce(op, (char *)tmp_buf + (ptrdiff_t)rindex[step] * extent,
-                           (char *)rbuf + (ptrdiff_t)rindex[step] * extent,
-                           rcount[step], dtype);
+            /* Local reduce: rbuf[] = tmp_buf[] <op> lbuf[], in the order of the ranks */
+            ompi_coll_base_reduce_in_order(op, (char *)tmp_buf + (ptrdiff_t)rindex[step] * extent,
+                                           lbuf + (ptrdiff_t)rindex[step] * extent,
+                                           (char *)rbuf + (ptrdiff_t)rindex[step] * extent,
+                                           rcount[step], dtype, dest < rank);
+            /* The next window is within the part just reduced into rbuf */
+            lbuf = (char *)rbuf;
 
             /* Move the current window to the received message */
             if (step + 1 < nsteps) {
@@ -1243,3 +1265,437 @@ int ompi_coll_base_allreduce_intra_redscat_allgather(
 }
 
 /* copied function (with appropriate renaming) ends here */
+
+/*
+ *   ompi_coll_base_allreduce_intra_reproducible
+ *
+ *   Function:       Bitwise reproducible allreduce
+ *   Accepts:        Same as MPI_Allreduce()
+ *   Returns:        MPI_SUCCESS or error code
+ *
+ *   Description:    Every element is reduced along the same binary tree over
+ *                   the ranks, whatever the count, the placement of the
+ *                   processes or the number of nodes: the first 2r ranks
+ *                   (r = p - p', p' = 2^{\floor{\log_2 p}}) are folded by
+ *                   pairs (2i, 2i + 1), then the p' blocks of contiguous
+ *                   ranks are combined pairwise by recursive doubling, the
+ *                   lower ranks first.  This is the order of the Rabenseifner
+ *                   algorithm, which executes it with reduce-scatter
+ *                   parallelism when count >= p'.  Smaller vectors go through
+ *                   a recursive doubling on the whole vector along the same
+ *                   tree, so both paths give the same bits.
+ *
+ *   Limitations:    The results only depend on the communicator size, and
+ *                   are the same for all the ranks as long as the operation
+ *                   is deterministic.
+ */
+int
+ompi_coll_base_allreduce_intra_reproducible(const void *sbuf, void *rbuf, int count,
+                                            struct ompi_datatype_t *dtype,
+                                            struct ompi_op_t *op,
+                                            struct ompi_communicator_t *comm,
+                                            mca_coll_base_module_t *module)
+{
+    int comm_size = ompi_comm_size(comm);
+    int rank = ompi_comm_rank(comm);
+    int nsteps = opal_hibit(comm_size, comm->c_cube_dim + 1);   /* ilog2(comm_size) */
+    int nprocs_pof2 = 1 << nsteps;                              /* flp2(comm_size) */
+    int nprocs_rem = comm_size - nprocs_pof2;
+    int err = MPI_SUCCESS, vrank;
+    ptrdiff_t dsize, gap = 0;
+    char *tmp_buf = NULL, *tmp_buf_raw = NULL;
+
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                 "coll:base:allreduce_intra_reproducible: rank %d/%d count %d",
+                 rank, comm_size, count));
+
+    if (count >= nprocs_pof2) {
+        return ompi_coll_base_allreduce_intra_redscat_allgather(sbuf, rbuf, count, dtype,
+                                                                op, comm, module);
+    }
+
+    if (MPI_IN_PLACE != sbuf) {
+        err = ompi_datatype_copy_content_same_ddt(dtype, count, (char *)rbuf, (char *)sbuf);
+        if (MPI_SUCCESS != err) { return err; }
+    }
+    if (1 == comm_size) {
+        return MPI_SUCCESS;
+    }
+
+    dsize = opal_datatype_span(&dtype->super, count, &gap);
+    tmp_buf_raw = (char *)malloc(dsize);
+    if (NULL == tmp_buf_raw) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    tmp_buf = tmp_buf_raw - gap;
+
+    /* Fold the pairs (2i, 2i + 1) of the first 2r ranks on the even ranks */
+    if (rank < 2 * nprocs_rem) {
+        if (rank % 2 != 0) {
+            err = MCA_PML_CALL(send(rbuf, count, dtype, rank - 1,
+                                    MCA_COLL_BASE_TAG_ALLREDUCE,
+                                    MCA_PML_BASE_SEND_STANDARD, comm));
+            if (MPI_SUCCESS != err) { goto cleanup_and_return; }
+            vrank = -1;
+        } else {
+            err = MCA_PML_CALL(recv(tmp_buf, count, dtype, rank + 1,
+                                    MCA_COLL_BASE_TAG_ALLREDUCE, comm,
+                                    MPI_STATUS_IGNORE));
+            if (MPI_SUCCESS != err) { goto cleanup_and_return; }
+            ompi_coll_base_reduce_in_order(op, tmp_buf, rbuf, rbuf, count, dtype, false);
+            vrank = rank / 2;
+        }
+    } else {
+        vrank = rank - nprocs_rem;
+    }
+
+    /* Recursive doubling on the whole vector, in the order of the ranks */
+    if (vrank >= 0) {
+        for (int mask = 1; mask < nprocs_pof2; mask <<= 1) {
+            int vdest = vrank ^ mask;
+            int dest = (vdest < nprocs_rem) ? vdest * 2 : vdest + nprocs_rem;
+
+            err = ompi_coll_base_sendrecv(rbuf, count, dtype, dest,
+                                          MCA_COLL_BASE_TAG_ALLREDUCE,
+                                          tmp_buf, count, dtype, dest,
+                                          MCA_COLL_BASE_TAG_ALLREDUCE, comm,
+                                          MPI_STATUS_IGNORE, rank);
+            if (MPI_SUCCESS != err) { goto cleanup_and_return; }
+            ompi_coll_base_reduce_in_order(op, tmp_buf, rbuf, rbuf, count, dtype, dest < rank);
+        }
+    }
+
+    /* Send the result to the folded odd ranks */
+    if (rank < 2 * nprocs_rem) {
+        if (rank % 2 != 0) {
+            err = MCA_PML_CALL(recv(rbuf, count, dtype, rank - 1,
+                                    MCA_COLL_BASE_TAG_ALLREDUCE, comm,
+                                    MPI_STATUS_IGNORE));
+        } else {
+            err = MCA_PML_CALL(send(rbuf, count, dtype, rank + 1,
+                                    MCA_COLL_BASE_TAG_ALLREDUCE,
+                                    MCA_PML_BASE_SEND_STANDARD, comm));
+        }
+    }
+
+  cleanup_and_return:
+    free(tmp_buf_raw);
+    return err;
+}
+
+/*
+ *   ompi_coll_base_allreduce_intra_swing
+ *
+ *   Function:       Swing allreduce (latency optimal variant)
+ *   Accepts:        Same as MPI_Allreduce()
+ *   Returns:        MPI_SUCCESS or error code
+ *
+ *   Description:    Same steps as recursive doubling, but in step s the
+ *                   even ranks exchange the whole vector with rank + rho(s)
+ *                   and the odd ranks with rank - rho(s) (modulo p), with
+ *                   rho(s) = (1 - (-2)^(s+1)) / 3 = 1, -1, 3, -5, 11, ...
+ *                   The peers are at most about 2^(s+1)/3 ranks away instead
+ *                   of 2^s, which shortens the paths on torus and dragonfly
+ *                   networks where consecutive ranks are close. Non power of
+ *                   two sizes are folded as in recursive doubling.
+ *
+ *   Limitations:    The ranks are not combined in rank order, so the
+ *                   operation has to be commutative. Non commutative
+ *                   operations fall back to recursive doubling.
+ */
+int
+ompi_coll_base_allreduce_intra_swing(const void *sbuf, void *rbuf, int count,
+                                     struct ompi_datatype_t *dtype,
+                                     struct ompi_op_t *op,
+                                     struct ompi_communicator_t *comm,
+                                     mca_coll_base_module_t *module)
+{
+    int ret, line, rank, size, adjsize, extra_ranks, newrank;
+    char *tmpbuf_free = NULL, *tmpbuf;
+    ptrdiff_t span, gap = 0;
+
+    size = ompi_comm_size(comm);
+    rank = ompi_comm_rank(comm);
+
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                 "coll:base:allreduce_intra_swing rank %d", rank));
+
+    if (!ompi_op_is_commute(op)) {
+        return ompi_coll_base_allreduce_intra_recursivedoubling(sbuf, rbuf, count, dtype,
+                                                                 op, comm, module);
+    }
+
+    if (MPI_IN_PLACE != sbuf) {
+        ret = ompi_datatype_copy_content_same_ddt(dtype, count, (char*)rbuf, (char*)sbuf);
+        if (ret < 0) { line = __LINE__; goto error_hndl; }
+    }
+
+    if (1 == size) {
+        return MPI_SUCCESS;
+    }
+
+    span = opal_datatype_span(&dtype->super, count, &gap);
+    tmpbuf_free = (char*) malloc(span);
+    if (NULL == tmpbuf_free) { ret = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto error_hndl; }
+    tmpbuf = tmpbuf_free - gap;
+
+    /* Determine nearest power of two less than or equal to size */
+    adjsize = opal_next_poweroftwo (size);
+    adjsize >>= 1;
+
+    /* Fold the extra ranks: the even ones give their data to rank + 1 */
+    extra_ranks = size - adjsize;
+    if (rank < (2 * extra_ranks)) {
+        if (0 == (rank % 2)) {
+            ret = MCA_PML_CALL(send(rbuf, count, dtype, (rank + 1),
+                                    MCA_COLL_BASE_TAG_ALLREDUCE,
+                                    MCA_PML_BASE_SEND_STANDARD, comm));
+            if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+            newrank = -1;
+        } else {
+            ret = MCA_PML_CALL(recv(tmpbuf, count, dtype, (rank - 1),
+                                    MCA_COLL_BASE_TAG_ALLREDUCE, comm,
+                                    MPI_STATUS_IGNORE));
+            if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+            ompi_op_reduce(op, tmpbuf, rbuf, count, dtype);
+            newrank = rank >> 1;
+        }
+    } else {
+        newrank = rank - extra_ranks;
+    }
+
+    for (int distance = 0x1, rho = 1; newrank >= 0 && distance < adjsize;
+         distance <<= 1, rho = 1 - 2 * rho) {
+        int newremote, remote;
+
+        /* rho is odd so the peer of an even rank is odd and symmetric */
+        newremote = (0 == (newrank % 2)) ? newrank + rho : newrank - rho;
+        newremote = ((newremote % adjsize) + adjsize) % adjsize;
+        remote = (newremote < extra_ranks) ? (newremote * 2 + 1) : (newremote + extra_ranks);
+
+        ret = ompi_coll_base_sendrecv_actual(rbuf, count, dtype, remote,
+                                             MCA_COLL_BASE_TAG_ALLREDUCE,
+                                             tmpbuf, count, dtype, remote,
+                                             MCA_COLL_BASE_TAG_ALLREDUCE,
+                                             comm, MPI_STATUS_IGNORE);
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+
+        ompi_op_reduce(op, tmpbuf, rbuf, count, dtype);
+    }
+
+    /* Give the result back to the folded ranks */
+    if (rank < (2 * extra_ranks)) {
+        if (0 == (rank % 2)) {
+            ret = MCA_PML_CALL(recv(rbuf, count, dtype, (rank + 1),
+                                    MCA_COLL_BASE_TAG_ALLREDUCE, comm,
+                                    MPI_STATUS_IGNORE));
+            if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+        } else {
+            ret = MCA_PML_CALL(send(rbuf, count, dtype, (rank - 1),
+                                    MCA_COLL_BASE_TAG_ALLREDUCE,
+                                    MCA_PML_BASE_SEND_STANDARD, comm));
+            if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+        }
+    }
+
+    free(tmpbuf_free);
+    return MPI_SUCCESS;
+
+ error_hndl:
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output, "%s:%4d\tRank %d Error occurred %d\n",
+                 __FILE__, line, rank, ret));
+    (void)line;  // silence compiler warning
+    if (NULL != tmpbuf_free) free(tmpbuf_free);
+    return ret;
+}
+
+/* first rank of the block of virtual rank v, q + 1 ranks in the first rem blocks, q after */
+#define RECMUL_BLOCK_START(v, q, rem) ((v) * (q) + (((v) < (rem)) ? (v) : (rem)))
+
+/*
+ *   ompi_coll_base_allreduce_intra_recursive_multiplying
+ *
+ *   Function:       Recursive multiplying (k-nomial) allreduce
+ *   Accepts:        Same as MPI_Allreduce(), radix
+ *   Returns:        MPI_SUCCESS or error code
+ *
+ *   Description:    Generalization of recursive doubling to a radix k. The
+ *                   p' = k^m ranks (k^m the largest power of k <= p) form
+ *                   groups of k ranks at distance 1, k, k^2, ... In each of
+ *                   the m steps a rank exchanges its whole vector with the
+ *                   k - 1 other ranks of its group at the same time, so the
+ *                   allreduce takes log_k(p') steps instead of log_2(p'),
+ *                   at the price of k - 1 times the bandwidth per step. When
+ *                   p is not a power of k, the ranks are split in p'
+ *                   contiguous blocks of floor(p / p') or ceil(p / p') < k
+ *                   ranks, and the last rank of each block stands for it.
+ *                   With a radix of 2 this is the fold of recursive doubling.
+ *
+ *                   The contributions of a group are reduced in rank order,
+ *                   so non commutative operations are supported and all the
+ *                   ranks get the same result.
+ *
+ *   Memory requirements (per process): k * count * typesize
+ */
+int
+ompi_coll_base_allreduce_intra_recursive_multiplying(const void *sbuf, void *rbuf,
+                                                     int count,
+                                                     struct ompi_datatype_t *dtype,
+                                                     struct ompi_op_t *op,
+                                                     struct ompi_communicator_t *comm,
+                                                     mca_coll_base_module_t *module,
+                                                     int radix)
+{
+    int ret, line, rank, size, k, pk, q, rem, newrank, first, last, nreqs = 0;
+    char *tmpbuf_free = NULL, **slots = NULL, *swap;
+    ompi_request_t **reqs = NULL;
+    ptrdiff_t span, gap = 0;
+
+    size = ompi_comm_size(comm);
+    rank = ompi_comm_rank(comm);
+
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                 "coll:base:allreduce_intra_recursive_multiplying rank %d radix %d", rank, radix));
+
+    /* Special case for size == 1 */
+    if (1 == size) {
+        if (MPI_IN_PLACE != sbuf) {
+            ret = ompi_datatype_copy_content_same_ddt(dtype, count, (char*)rbuf, (char*)sbuf);
+            if (ret < 0) { line = __LINE__; goto error_hndl; }
+        }
+        return MPI_SUCCESS;
+    }
+
+    k = (radix < 2) ? 2 : radix;
+    if (k > size) {
+        k = size;
+    }
+
+    /* largest power of the radix less than or equal to size, and the
+     * blocks of ranks each virtual rank stands for: the first rem blocks
+     * have q + 1 ranks, the other ones q */
+    for (pk = 1; pk <= size / k; pk *= k);
+    q = size / pk;
+    rem = size % pk;
+
+    /* one slot per member of a group, slots[k - 1] holds the running result */
+    span = opal_datatype_span(&dtype->super, count, &gap);
+    tmpbuf_free = (char*) malloc(span * k);
+    slots = (char**) malloc(sizeof(char*) * k);
+    if (NULL == tmpbuf_free || NULL == slots) { ret = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto error_hndl; }
+    for (int j = 0; j < k; ++j) {
+        slots[j] = tmpbuf_free + (ptrdiff_t) j * span - gap;
+    }
+
+    ret = ompi_datatype_copy_content_same_ddt(dtype, count, slots[k - 1],
+                                              (MPI_IN_PLACE == sbuf) ? (char*)rbuf : (char*)sbuf);
+    if (ret < 0) { line = __LINE__; goto error_hndl; }
+
+    reqs = ompi_coll_base_comm_get_reqs(module->base_data, 2 * (k - 1));
+    if (NULL == reqs) { ret = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto error_hndl; }
+
+    /* Fold the blocks: the ranks of a block give their data to its last rank */
+    newrank = (rank < rem * (q + 1)) ? rank / (q + 1) : rem + (rank - rem * (q + 1)) / q;
+    first = RECMUL_BLOCK_START(newrank, q, rem);
+    last = RECMUL_BLOCK_START(newrank + 1, q, rem) - 1;
+    if (rank != last) {
+        ret = MCA_PML_CALL(send(slots[k - 1], count, dtype, last,
+                                MCA_COLL_BASE_TAG_ALLREDUCE,
+                                MCA_PML_BASE_SEND_STANDARD, comm));
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+        newrank = -1;
+    } else if (first != last) {
+        /* at most k - 1 other ranks in a block, slots[0 .. k - 2] are free */
+        nreqs = 0;
+        for (int peer = first; peer < last; ++peer) {
+            ret = MCA_PML_CALL(irecv(slots[peer - first], count, dtype, peer,
+                                     MCA_COLL_BASE_TAG_ALLREDUCE, comm, &reqs[nreqs++]));
+            if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+        }
+        ret = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+
+        /* slots[k - 1] = slots[0] (op) ... (op) slots[last - first - 1] (op) slots[k - 1] */
+        for (int j = last - first - 1; j >= 0; --j) {
+            ompi_op_reduce(op, slots[j], slots[k - 1], count, dtype);
+        }
+    }
+
+    for (int distance = 1; newrank >= 0 && distance < pk; distance *= k) {
+        int digit = (newrank / distance) % k;
+
+        /* put our own contribution in the slot of our position in the group */
+        swap = slots[digit];
+        slots[digit] = slots[k - 1];
+        slots[k - 1] = swap;
+
+        nreqs = 0;
+        for (int j = 0; j < k; ++j) {
+            int newremote = newrank + (j - digit) * distance, remote;
+
+            if (j == digit) {
+                continue;
+            }
+            remote = RECMUL_BLOCK_START(newremote + 1, q, rem) - 1;
+            ret = MCA_PML_CALL(irecv(slots[j], count, dtype, remote,
+                                     MCA_COLL_BASE_TAG_ALLREDUCE, comm, &reqs[nreqs++]));
+            if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+        }
+        for (int j = 0; j < k; ++j) {
+            int newremote = newrank + (j - digit) * distance, remote;
+
+            if (j == digit) {
+                continue;
+            }
+            remote = RECMUL_BLOCK_START(newremote + 1, q, rem) - 1;
+            ret = MCA_PML_CALL(isend(slots[digit], count, dtype, remote,
+                                     MCA_COLL_BASE_TAG_ALLREDUCE,
+                                     MCA_PML_BASE_SEND_STANDARD, comm, &reqs[nreqs++]));
+            if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+        }
+
+        ret = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+
+        /* slots[k - 1] = slots[0] (op) slots[1] (op) ... (op) slots[k - 1] */
+        for (int j = k - 2; j >= 0; --j) {
+            ompi_op_reduce(op, slots[j], slots[k - 1], count, dtype);
+        }
+    }
+
+    /* Give the result back to the other ranks of the block */
+    if (rank != last) {
+        ret = MCA_PML_CALL(recv(rbuf, count, dtype, last,
+                                MCA_COLL_BASE_TAG_ALLREDUCE, comm,
+                                MPI_STATUS_IGNORE));
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+    } else {
+        nreqs = 0;
+        for (int peer = first; peer < last; ++peer) {
+            ret = MCA_PML_CALL(isend(slots[k - 1], count, dtype, peer,
+                                     MCA_COLL_BASE_TAG_ALLREDUCE,
+                                     MCA_PML_BASE_SEND_STANDARD, comm, &reqs[nreqs++]));
+            if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+        }
+        ret = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto error_hndl; }
+
+        ret = ompi_datatype_copy_content_same_ddt(dtype, count, (char*)rbuf, slots[k - 1]);
+        if (ret < 0) { line = __LINE__; goto error_hndl; }
+    }
+
+    free(slots);
+    free(tmpbuf_free);
+    return MPI_SUCCESS;
+
+ error_hndl:
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output, "%s:%4d\tRank %d Error occurred %d\n",
+                 __FILE__, line, rank, ret));
+    (void)line;  // silence compiler warning
+    if (NULL != reqs) {
+        ompi_coll_base_free_reqs(reqs, nreqs);
+    }
+    if (NULL != slots) free(slots);
+    if (NULL != tmpbuf_free) free(tmpbuf_free);
+    return ret;
+}
@@ -26,6 +26,8 @@
 
 #include "ompi_config.h"
 
+#include <stdlib.h>
+
 #include "mpi.h"
 #include "ompi/constants.h"
 #include "ompi/datatype/ompi_datatype.h"
@@ -292,3 +294,184 @@ ompi_coll_base_alltoallv_intra_basic_linear(const void *sbuf, const int *scounts
 
     return err;
 }
+
+/* peer of the sparse alltoallv and the number of bytes exchanged with it */
+typedef struct {
+    size_t bytes;
+    int peer;
+} alltoallv_sparse_peer_t;
+
+/* largest first */
+static int alltoallv_sparse_cmp(const void *a, const void *b)
+{
+    const alltoallv_sparse_peer_t *pa = (const alltoallv_sparse_peer_t *) a;
+    const alltoallv_sparse_peer_t *pb = (const alltoallv_sparse_peer_t *) b;
+
+    if (pa->bytes != pb->bytes) {
+        return (pa->bytes > pb->bytes) ? -1 : 1;
+    }
+    return pa->peer - pb->peer;
+}
+
+/*
+ * alltoallv_intra_sparse
+ *
+ * Function:       Linear alltoallv that only talks to the peers it
+ *                 exchanges data with.
+ * Accepts:        Same as MPI_Alltoallv(), and the maximum number of
+ *                 outstanding send requests (0 for no limit).
+ * Returns:        MPI_SUCCESS or error code
+ *
+ * Description:    The counts are matching on both sides, so a peer with a
+ *                 zero count is known locally and no message is exchanged
+ *                 with it. All the receives are posted first, then the
+ *                 sends, the largest first, with at most max_requests of
+ *                 them in flight. As every receive is posted before any
+ *                 send waits, the window can not deadlock.
+ *
+ *                 No message is exchanged for empty blocks, so all the
+ *                 processes of the communicator have to select this
+ *                 algorithm for the same call.
+ */
+int
+ompi_coll_base_alltoallv_intra_sparse(const void *sbuf, const int *scounts, const int *sdisps,
+                                      struct ompi_datatype_t *sdtype,
+                                      void *rbuf, const int *rcounts, const int *rdisps,
+                                      struct ompi_datatype_t *rdtype,
+                                      struct ompi_communicator_t *comm,
+                                      mca_coll_base_module_t *module,
+                                      int max_requests)
+{
+    int i, size, rank, err = MPI_SUCCESS, line = -1, nrecvs = 0, nsends = 0, nreqs = 0, window, next;
+    alltoallv_sparse_peer_t *peers = NULL, *speers;
+    size_t sdsize, rdsize;
+    ptrdiff_t sext, rext;
+    char *psnd, *prcv;
+    ompi_request_t **reqs = NULL;
+
+    if (MPI_IN_PLACE == sbuf) {
+        return mca_coll_base_alltoallv_intra_basic_inplace (rbuf, rcounts, rdisps,
+                                                             rdtype, comm, module);
+    }
+
+    size = ompi_comm_size(comm);
+    rank = ompi_comm_rank(comm);
+
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                 "coll:base:alltoallv_intra_sparse rank %d max_requests %d", rank, max_requests));
+
+    ompi_datatype_type_extent(sdtype, &sext);
+    ompi_datatype_type_extent(rdtype, &rext);
+    ompi_datatype_type_size(sdtype, &sdsize);
+    ompi_datatype_type_size(rdtype, &rdsize);
+
+    /* Simple optimization - handle send to self first */
+    if (0 != scounts[rank]) {
+        psnd = ((char *) sbuf) + (ptrdiff_t)sdisps[rank] * sext;
+        prcv = ((char *) rbuf) + (ptrdiff_t)rdisps[rank] * rext;
+        err = ompi_datatype_sndrcv(psnd, scounts[rank], sdtype,
+                                   prcv, rcounts[rank], rdtype);
+        if (MPI_SUCCESS != err) {
+            return err;
+        }
+    }
+
+    if (1 == size) {
+        return MPI_SUCCESS;
+    }
+
+    peers = (alltoallv_sparse_peer_t *) malloc(2 * size * sizeof(alltoallv_sparse_peer_t));
+    if (NULL == peers) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+    speers = peers + size;
+
+    for (i = 0; i < size; ++i) {
+        if (i == rank) {
+            continue;
+        }
+        if (0 != rcounts[i] && 0 != rdsize) {
+            peers[nrecvs].bytes = (size_t) rcounts[i] * rdsize;
+            peers[nrecvs++].peer = i;
+        }
+        if (0 != scounts[i] && 0 != sdsize) {
+            speers[nsends].bytes = (size_t) scounts[i] * sdsize;
+            speers[nsends++].peer = i;
+        }
+    }
+
+    if (0 == nrecvs + nsends) {
+        goto err_hndl;
+    }
+
+    qsort(peers, nrecvs, sizeof(alltoallv_sparse_peer_t), alltoallv_sparse_cmp);
+    qsort(speers, nsends, sizeof(alltoallv_sparse_peer_t), alltoallv_sparse_cmp);
+
+    window = (max_requests <= 0 || max_requests > nsends) ? nsends : max_requests;
+
+    reqs = ompi_coll_base_comm_get_reqs(module->base_data, nrecvs + window);
+    if (NULL == reqs) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+
+    /* Post all receives first, the largest ones match first */
+    for (i = 0; i < nrecvs; ++i) {
+        prcv = ((char *) rbuf) + (ptrdiff_t)rdisps[peers[i].peer] * rext;
+        err = MCA_PML_CALL(irecv(prcv, rcounts[peers[i].peer], rdtype,
+                                 peers[i].peer, MCA_COLL_BASE_TAG_ALLTOALLV, comm,
+                                 &reqs[nreqs]));
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        ++nreqs;
+    }
+
+    /* Then the first window of sends */
+    for (next = 0; next < window; ++next) {
+        psnd = ((char *) sbuf) + (ptrdiff_t)sdisps[speers[next].peer] * sext;
+        err = MCA_PML_CALL(isend(psnd, scounts[speers[next].peer], sdtype,
+                                 speers[next].peer, MCA_COLL_BASE_TAG_ALLTOALLV,
+                                 MCA_PML_BASE_SEND_STANDARD, comm, &reqs[nreqs]));
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        ++nreqs;
+    }
+
+    /* Refill the window as sends complete */
+    while (next < nsends) {
+        int completed;
+
+        err = ompi_request_wait_any(window, reqs + nrecvs, &completed, MPI_STATUS_IGNORE);
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+
+        psnd = ((char *) sbuf) + (ptrdiff_t)sdisps[speers[next].peer] * sext;
+        err = MCA_PML_CALL(isend(psnd, scounts[speers[next].peer], sdtype,
+                                 speers[next].peer, MCA_COLL_BASE_TAG_ALLTOALLV,
+                                 MCA_PML_BASE_SEND_STANDARD, comm, &reqs[nrecvs + completed]));
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        ++next;
+    }
+
+    err = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+    if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+
+    free(peers);
+    ompi_coll_base_free_reqs(reqs, nreqs);
+    return MPI_SUCCESS;
+
+ err_hndl:
+    if (MPI_SUCCESS != err) {
+        OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                     "%s:%4d\tError occurred %d, rank %2d", __FILE__, line, err, rank));
+        /* find a real error code */
+        if (MPI_ERR_IN_STATUS == err) {
+            for (i = 0; i < nreqs; i++) {
+                if (MPI_REQUEST_NULL == reqs[i]) continue;
+                if (MPI_ERR_PENDING == reqs[i]->req_status.MPI_ERROR) continue;
+                if (MPI_SUCCESS != reqs[i]->req_status.MPI_ERROR) {
+                    err = reqs[i]->req_status.MPI_ERROR;
+                    break;
+                }
+            }
+        }
+    }
+    (void)line;  // silence compiler warning
+    free(peers);
+    if (NULL != reqs) {
+        ompi_coll_base_free_reqs(reqs, nreqs);
+    }
+    return err;
+}
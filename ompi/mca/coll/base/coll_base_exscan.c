@@ -221,3 +221,214 @@ cleanup_and_return:
         free(tmprecv_raw);
     return err;
 }
+
+/*
+ * ompi_coll_base_exscan_intra_updown
+ *
+ * Function:  Segmented up/down tree algorithm for exclusive scan.
+ * Accepts:   Same as MPI_Exscan, plus the segment size
+ * Returns:   MPI_SUCCESS or error code
+ *
+ * Description:  Exclusive counterpart of ompi_coll_base_scan_intra_updown,
+ *               with the same communication pattern over the binary indexed
+ *               tree of the ranks (L = lowbit(r + 1)).
+ *               Up-sweep: r reduces the blocks [r - L + 1, r - 1] received
+ *               from r - 1, ..., r - L / 2 into recvbuf, and sends
+ *               recvbuf <op> sendbuf to r + L.
+ *               Down-sweep: r receives the prefix [0, r - L] from r - L
+ *               (none when r + 1 = L), which completes recvbuf, and sends
+ *               recvbuf <op> sendbuf to r + L / 2, ..., r + 1.
+ *               The order of operations is preserved so it can be used both
+ *               by commutative and non-commutative operations.
+ *
+ * Time complexity: (2\log_2(p) + s - 1)(\alpha + m/s\beta + 2m/s\gamma)
+ *                  for s segments
+ * Memory requirements (per process): up to 3 * count * typesize + segsize
+ * Limitations: intra-communicators only
+ */
+int
+ompi_coll_base_exscan_intra_updown(const void *sbuf, void *rbuf, int count,
+                                   struct ompi_datatype_t *dtype,
+                                   struct ompi_op_t *op,
+                                   struct ompi_communicator_t *comm,
+                                   mca_coll_base_module_t *module,
+                                   uint32_t segsize)
+{
+    int err = MPI_SUCCESS, line, rank, size, low, distance;
+    int segcount, num_segments, segindex, ndown = 0, nsends, nreqs = 0;
+    bool has_parent, has_prefix;
+    size_t typelng;
+    ptrdiff_t lb, extent, dsize, gap, realsegsize;
+    char *tmp_raw = NULL, *own_raw = NULL, *acc_raw = NULL, *inc_raw = NULL;
+    char *tmpbuf, *ownbuf, *accbuf, *incbuf = NULL;
+    ompi_request_t **reqs = NULL;
+
+    size = ompi_comm_size(comm);
+    rank = ompi_comm_rank(comm);
+
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                 "coll:base:exscan_intra_updown: rank %d/%d segsize %u",
+                 rank, size, segsize));
+
+    if (size < 2 || 0 == count) {
+        return MPI_SUCCESS;
+    }
+
+    ompi_datatype_type_size(dtype, &typelng);
+    ompi_datatype_get_extent(dtype, &lb, &extent);
+    segcount = count;
+    COLL_BASE_COMPUTED_SEGCOUNT(segsize, typelng, segcount);
+    num_segments = (count + segcount - 1) / segcount;
+    realsegsize = (ptrdiff_t) segcount * extent;
+
+    low = (rank + 1) & -(rank + 1);
+    has_parent = rank + low < size;
+    has_prefix = rank + 1 != low;
+    for (distance = low >> 1; distance > 0; distance >>= 1) {
+        if (rank + distance < size) {
+            ndown++;
+        }
+    }
+    nsends = ndown + (has_parent ? 1 : 0);
+
+    dsize = opal_datatype_span(&dtype->super, segcount, &gap);
+    tmp_raw = (char *) malloc(dsize);
+    if (NULL == tmp_raw) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+    tmpbuf = tmp_raw - gap;
+
+    /* The local contribution is needed after recvbuf has been written */
+    dsize = opal_datatype_span(&dtype->super, count, &gap);
+    ownbuf = (char *) sbuf;
+    if (MPI_IN_PLACE == sbuf && 0 < nsends) {
+        own_raw = (char *) malloc(dsize);
+        if (NULL == own_raw) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+        ownbuf = own_raw - gap;
+    }
+    /* [r - L + 1, r] for the parent, a leaf sends its own data */
+    accbuf = ownbuf;
+    if (has_parent && 1 < low) {
+        acc_raw = (char *) malloc(dsize);
+        if (NULL == acc_raw) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+        accbuf = acc_raw - gap;
+    }
+    /* [0, r] for the children, the block itself when it starts at rank 0 */
+    if (0 < ndown) {
+        if (has_parent && !has_prefix) {
+            incbuf = accbuf;
+        } else {
+            inc_raw = (char *) malloc(dsize);
+            if (NULL == inc_raw) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+            incbuf = inc_raw - gap;
+        }
+    }
+
+    /* the sends of two consecutive segments are in flight */
+    if (0 < nsends) {
+        reqs = ompi_coll_base_comm_get_reqs(module->base_data, 2 * nsends);
+        if (NULL == reqs) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+        nreqs = 2 * nsends;
+    }
+
+    for (segindex = 0; segindex < num_segments; segindex++) {
+        int scount = (segindex == num_segments - 1) ? count - segindex * segcount : segcount;
+        ptrdiff_t offset = (ptrdiff_t) segindex * realsegsize;
+        char *rseg = (char *) rbuf + offset, *oseg = ownbuf + offset;
+        char *aseg = accbuf + offset, *iseg = (NULL != incbuf) ? incbuf + offset : NULL;
+        ompi_request_t **sreqs = reqs + (segindex & 1) * nsends;
+
+        if (NULL != own_raw) {
+            err = ompi_datatype_copy_content_same_ddt(dtype, scount, oseg, rseg);
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+
+        /* Up-sweep: rseg = [r - L + 1, r - 1], nearest block first */
+        for (distance = 1; distance < low; distance <<= 1) {
+            err = MCA_PML_CALL(recv(1 == distance ? rseg : tmpbuf, scount, dtype,
+                                    rank - distance, MCA_COLL_BASE_TAG_EXSCAN,
+                                    comm, MPI_STATUS_IGNORE));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+            if (1 < distance) {
+                ompi_op_reduce(op, tmpbuf, rseg, scount, dtype);
+            }
+        }
+
+        /* reuse the requests of segment segindex - 2 */
+        if (0 < nsends) {
+            err = ompi_request_wait_all(nsends, sreqs, MPI_STATUSES_IGNORE);
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+        if (has_parent) {
+            if (1 < low) {
+                ompi_3buff_op_reduce(op, rseg, oseg, aseg, scount, dtype);
+            }
+            err = MCA_PML_CALL(isend(aseg, scount, dtype, rank + low,
+                                     MCA_COLL_BASE_TAG_EXSCAN,
+                                     MCA_PML_BASE_SEND_STANDARD, comm, sreqs++));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+
+        /* Down-sweep: rseg = [0, r - L] <op> rseg */
+        if (has_prefix) {
+            err = MCA_PML_CALL(recv(1 == low ? rseg : tmpbuf, scount, dtype,
+                                    rank - low, MCA_COLL_BASE_TAG_EXSCAN,
+                                    comm, MPI_STATUS_IGNORE));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+            if (1 < low) {
+                ompi_op_reduce(op, tmpbuf, rseg, scount, dtype);
+            }
+        }
+        if (0 == ndown) {
+            continue;
+        }
+        if (iseg != aseg) {
+            ompi_3buff_op_reduce(op, rseg, oseg, iseg, scount, dtype);
+        }
+        for (distance = low >> 1; distance > 0; distance >>= 1) {
+            if (rank + distance >= size) {
+                continue;
+            }
+            err = MCA_PML_CALL(isend(iseg, scount, dtype, rank + distance,
+                                     MCA_COLL_BASE_TAG_EXSCAN,
+                                     MCA_PML_BASE_SEND_STANDARD, comm, sreqs++));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+    }
+
+    if (0 < nsends) {
+        err = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+    }
+
+    free(tmp_raw);
+    if (NULL != own_raw) {
+        free(own_raw);
+    }
+    if (NULL != acc_raw) {
+        free(acc_raw);
+    }
+    if (NULL != inc_raw) {
+        free(inc_raw);
+    }
+    return MPI_SUCCESS;
+
+ err_hndl:
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output, "%s:%4d\tError occurred %d, rank %2d",
+                 __FILE__, line, err, rank));
+    (void)line;  // silence compiler warning
+    if (NULL != reqs) {
+        ompi_coll_base_free_reqs(reqs, nreqs);
+    }
+    if (NULL != tmp_raw) {
+        free(tmp_raw);
+    }
+    if (NULL != own_raw) {
+        free(own_raw);
+    }
+    if (NULL != acc_raw) {
+        free(acc_raw);
+    }
+    if (NULL != inc_raw) {
+        free(inc_raw);
+    }
+    return err;
+}
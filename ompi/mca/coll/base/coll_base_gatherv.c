@@ -0,0 +1,345 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/mca/coll/base/coll_tags.h"
+#include "ompi/mca/pml/pml.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "coll_base_util.h"
+
+/*
+ * ompi_coll_base_gatherv_intra_basic_linear
+ *
+ * Function:  Linear algorithm for gatherv, the root receives from
+ *            every rank in turn.
+ * Accepts:   Same as MPI_Gatherv
+ * Returns:   MPI_SUCCESS or error code
+ */
+int
+ompi_coll_base_gatherv_intra_basic_linear(const void *sbuf, int scount,
+                                          struct ompi_datatype_t *sdtype,
+                                          void *rbuf, const int *rcounts, const int *disps,
+                                          struct ompi_datatype_t *rdtype, int root,
+                                          struct ompi_communicator_t *comm,
+                                          mca_coll_base_module_t *module)
+{
+    int i, rank, size, err = MPI_SUCCESS;
+    char *ptmp;
+    ptrdiff_t lb, extent;
+
+    size = ompi_comm_size(comm);
+    rank = ompi_comm_rank(comm);
+
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                 "coll:base:gatherv_intra_basic_linear rank %d", rank));
+
+    if (rank != root) {
+        if (scount > 0) {
+            return MCA_PML_CALL(send(sbuf, scount, sdtype, root,
+                                     MCA_COLL_BASE_TAG_GATHERV,
+                                     MCA_PML_BASE_SEND_STANDARD, comm));
+        }
+        return MPI_SUCCESS;
+    }
+
+    ompi_datatype_get_extent(rdtype, &lb, &extent);
+
+    for (i = 0; i < size; ++i) {
+        ptmp = ((char *) rbuf) + (extent * disps[i]);
+
+        if (i == rank) {
+            if (MPI_IN_PLACE != sbuf && (0 < scount) && (0 < rcounts[i])) {
+                err = ompi_datatype_sndrcv(sbuf, scount, sdtype,
+                                           ptmp, rcounts[i], rdtype);
+            }
+        } else if (rcounts[i] > 0) {
+            err = MCA_PML_CALL(recv(ptmp, rcounts[i], rdtype, i,
+                                    MCA_COLL_BASE_TAG_GATHERV,
+                                    comm, MPI_STATUS_IGNORE));
+        }
+
+        if (MPI_SUCCESS != err) {
+            return err;
+        }
+    }
+
+    return MPI_SUCCESS;
+}
+
+/*
+ * Level of vrank in the k-nomial tree rooted at vrank 0: the subtree of
+ * vrank spans [vrank, vrank + mask) and its children are vrank + j * d,
+ * 0 < j < radix, for the powers d of radix below mask.
+ */
+static int gatherv_knomial_mask(int vrank, int size, int radix)
+{
+    int mask = 1;
+
+    while (mask < size && 0 == vrank % (mask * radix)) {
+        mask *= radix;
+    }
+    return mask;
+}
+
+/*
+ * ompi_coll_base_gatherv_intra_knomial
+ *
+ * Function:  K-nomial tree algorithm for gatherv.
+ * Accepts:   Same as MPI_Gatherv, plus the radix of the tree
+ * Returns:   MPI_SUCCESS or error code
+ *
+ * Description:  The ranks, renumbered from the root, form an in-order
+ *               k-nomial tree so that every subtree is a contiguous range
+ *               of virtual ranks. The blocks travel up the tree packed and
+ *               in virtual rank order, the root unpacks them with its
+ *               counts and displacements once they have arrived.
+ *               Only the root knows the size of every block: before the
+ *               data, each rank below the first level sends its parent the
+ *               size in bytes of the blocks of its subtree, which gives
+ *               the intermediate ranks the buffer and receive sizes.
+ *               The root receives from radix - 1 ranks per level instead
+ *               of p - 1 ranks, at the price of forwarding the blocks
+ *               log_radix(p) times, it is meant for large communicators
+ *               and small blocks.
+ * Memory requirements: the packed blocks of its subtree on the
+ *               intermediate ranks, those of the non-leaf children on the root
+ * Limitations: intra-communicators only, the blocks are staged in the
+ *               packed representation of the local node
+ */
+int
+ompi_coll_base_gatherv_intra_knomial(const void *sbuf, int scount,
+                                     struct ompi_datatype_t *sdtype,
+                                     void *rbuf, const int *rcounts, const int *disps,
+                                     struct ompi_datatype_t *rdtype, int root,
+                                     struct ompi_communicator_t *comm,
+                                     mca_coll_base_module_t *module,
+                                     int radix)
+{
+    int err = MPI_SUCCESS, line = -1, rank, vrank, size, mask, distance, j;
+    int nchildren = 0, nreqs = 0, child;
+    size_t stsize, rtsize;
+    uint64_t total = 0, *sizes = NULL;
+    char *tmpbuf = NULL;
+    ptrdiff_t lb, extent, offset;
+    ompi_request_t **reqs = NULL;
+
+    size = ompi_comm_size(comm);
+    rank = ompi_comm_rank(comm);
+
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                 "coll:base:gatherv_intra_knomial rank %d radix %d", rank, radix));
+
+    if (radix < 2) {
+        radix = 2;
+    }
+    vrank = (rank - root + size) % size;
+    mask = gatherv_knomial_mask(vrank, size, radix);
+
+    for (distance = 1; distance < mask; distance *= radix) {
+        for (j = 1; j < radix && vrank + j * distance < size; j++) {
+            nchildren++;
+        }
+    }
+
+    /* Leaves send their block straight from the user buffer */
+    if (0 == nchildren && rank != root) {
+        int vparent = vrank - vrank % (mask * radix);
+        ompi_datatype_type_size(sdtype, &stsize);
+        total = (uint64_t) scount * stsize;
+        if (0 != vparent) {
+            err = MCA_PML_CALL(send(&total, 1, MPI_UINT64_T, (vparent + root) % size,
+                                    MCA_COLL_BASE_TAG_GATHERV,
+                                    MCA_PML_BASE_SEND_STANDARD, comm));
+            if (MPI_SUCCESS != err) { return err; }
+        }
+        if (0 < total) {
+            err = MCA_PML_CALL(send(sbuf, scount, sdtype, (vparent + root) % size,
+                                    MCA_COLL_BASE_TAG_GATHERV,
+                                    MCA_PML_BASE_SEND_STANDARD, comm));
+        }
+        return err;
+    }
+
+    if (0 < nchildren) {
+        sizes = (uint64_t *) malloc(nchildren * sizeof(uint64_t));
+        reqs = ompi_coll_base_comm_get_reqs(module->base_data, nchildren);
+        if (NULL == sizes || NULL == reqs) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+    }
+    if (rank == root) {
+        ompi_datatype_type_size(rdtype, &rtsize);
+    }
+
+    /* Bytes of the subtree of each child, nearest child first. Every rank
+     * but the children of the root reports its own to its parent. */
+    child = 0;
+    for (distance = 1; distance < mask; distance *= radix) {
+        for (j = 1; j < radix && vrank + j * distance < size; j++, child++) {
+            int vchild = vrank + j * distance;
+            if (rank != root) {
+                err = MCA_PML_CALL(recv(&sizes[child], 1, MPI_UINT64_T, (vchild + root) % size,
+                                        MCA_COLL_BASE_TAG_GATHERV, comm, MPI_STATUS_IGNORE));
+                if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+                continue;
+            }
+            sizes[child] = 0;
+            for (int v = vchild; v < vchild + distance && v < size; v++) {
+                sizes[child] += (uint64_t) rcounts[(v + root) % size] * rtsize;
+            }
+        }
+    }
+
+    if (rank == root) {
+        ompi_datatype_get_extent(rdtype, &lb, &extent);
+
+        /* the leaves are received in place, the other subtrees packed */
+        child = 0;
+        for (distance = 1; distance < mask; distance *= radix) {
+            for (j = 1; j < radix && vrank + j * distance < size; j++, child++) {
+                if (1 < distance) {
+                    total += sizes[child];
+                }
+            }
+        }
+        if (0 < total) {
+            tmpbuf = (char *) malloc(total);
+            if (NULL == tmpbuf) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+        }
+
+        offset = 0;
+        child = 0;
+        for (distance = 1; distance < mask; distance *= radix) {
+            for (j = 1; j < radix && vrank + j * distance < size; j++, child++) {
+                int peer = (vrank + j * distance + root) % size;
+                if (0 == sizes[child]) {
+                    continue;
+                }
+                if (1 == distance) {
+                    err = MCA_PML_CALL(irecv((char *) rbuf + extent * disps[peer], rcounts[peer], rdtype,
+                                             peer, MCA_COLL_BASE_TAG_GATHERV, comm, &reqs[nreqs++]));
+                } else {
+                    err = MCA_PML_CALL(irecv(tmpbuf + offset, sizes[child], MPI_PACKED,
+                                             peer, MCA_COLL_BASE_TAG_GATHERV, comm, &reqs[nreqs++]));
+                    offset += sizes[child];
+                }
+                if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+            }
+        }
+
+        if (MPI_IN_PLACE != sbuf && 0 < scount && 0 < rcounts[rank]) {
+            err = ompi_datatype_sndrcv(sbuf, scount, sdtype,
+                                       (char *) rbuf + extent * disps[rank], rcounts[rank], rdtype);
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+
+        err = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+
+        /* unpack the blocks of the subtrees below the first level */
+        offset = 0;
+        for (distance = radix; distance < mask; distance *= radix) {
+            for (j = 1; j < radix && vrank + j * distance < size; j++) {
+                int vchild = vrank + j * distance;
+                for (int v = vchild; v < vchild + distance && v < size; v++) {
+                    int peer = (v + root) % size;
+                    int bytes = (int) (rcounts[peer] * rtsize);
+                    if (0 == bytes) {
+                        continue;
+                    }
+                    err = ompi_datatype_sndrcv(tmpbuf + offset, bytes, MPI_PACKED,
+                                               (char *) rbuf + extent * disps[peer], rcounts[peer], rdtype);
+                    if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+                    offset += bytes;
+                }
+            }
+        }
+    } else {
+        int vparent = vrank - vrank % (mask * radix);
+        int parent = (vparent + root) % size;
+
+        ompi_datatype_type_size(sdtype, &stsize);
+        total = (uint64_t) scount * stsize;
+        for (child = 0; child < nchildren; child++) {
+            total += sizes[child];
+        }
+        /* the root knows the sizes of its children subtrees */
+        if (0 != vparent) {
+            err = MCA_PML_CALL(send(&total, 1, MPI_UINT64_T, parent,
+                                    MCA_COLL_BASE_TAG_GATHERV,
+                                    MCA_PML_BASE_SEND_STANDARD, comm));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+        if (0 == total) {
+            goto cleanup;
+        }
+
+        tmpbuf = (char *) malloc(total);
+        if (NULL == tmpbuf) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+
+        /* own block first, then the subtrees in virtual rank order */
+        offset = (ptrdiff_t) scount * stsize;
+        child = 0;
+        for (distance = 1; distance < mask; distance *= radix) {
+            for (j = 1; j < radix && vrank + j * distance < size; j++, child++) {
+                if (0 == sizes[child]) {
+                    continue;
+                }
+                err = MCA_PML_CALL(irecv(tmpbuf + offset, sizes[child], MPI_PACKED,
+                                         (vrank + j * distance + root) % size,
+                                         MCA_COLL_BASE_TAG_GATHERV, comm, &reqs[nreqs++]));
+                if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+                offset += sizes[child];
+            }
+        }
+        if (0 < scount) {
+            err = ompi_datatype_sndrcv(sbuf, scount, sdtype, tmpbuf, (int) (scount * stsize), MPI_PACKED);
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+
+        err = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+
+        err = MCA_PML_CALL(send(tmpbuf, total, MPI_PACKED, parent,
+                                MCA_COLL_BASE_TAG_GATHERV,
+                                MCA_PML_BASE_SEND_STANDARD, comm));
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+    }
+
+ cleanup:
+    if (NULL != sizes) {
+        free(sizes);
+    }
+    if (NULL != tmpbuf) {
+        free(tmpbuf);
+    }
+    return MPI_SUCCESS;
+
+ err_hndl:
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output, "%s:%4d\tError occurred %d, rank %2d",
+                 __FILE__, line, err, rank));
+    (void)line;  // silence compiler warning
+    if (NULL != reqs) {
+        ompi_coll_base_free_reqs(reqs, nreqs);
+    }
+    if (NULL != sizes) {
+        free(sizes);
+    }
+    if (NULL != tmpbuf) {
+        free(tmpbuf);
+    }
+    return err;
+}
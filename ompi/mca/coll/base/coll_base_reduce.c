@@ -786,9 +786,13 @@ ompi_coll_base_reduce_intra_basic_linear(const void *sbuf, void *rbuf, int count
  * be removed in the first step, then the role of this process and process 0
  * are interchanged.
  *
+ * Non-commutative operations: the blocks of the vector always cover
+ * a contiguous range of ranks, so each local reduction combines the data
+ * of the lower ranks with the data of the higher ones, in this order.
+ * Reducing the received data first costs a copy of the reduced block.
+ *
  * Limitations:
  *   count >= 2^{\floor{\log_2 p}}
- *   commutative operations only
  *   intra-communicators only
  *
  * Memory requirements (per process):
@@ -815,7 +819,7 @@ int ompi_coll_base_reduce_intra_redscat_gather(
     assert(nsteps >= 0);
     int nprocs_pof2 = 1 << nsteps;                              /* flp2(comm_size) */
 
-    if (nprocs_pof2 < 2 || count < nprocs_pof2 || !ompi_op_is_commute(op)) {
+    if (nprocs_pof2 < 2 || count < nprocs_pof2) {
         OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
                      "coll:base:reduce_intra_redscat_gather: rank %d/%d count %d "
                      "switching to basic linear reduce", rank, comm_size, count));
@@ -893,8 +897,10 @@ int ompi_coll_base_reduce_intra_redscat_gather(
             if (MPI_SUCCESS != err) { goto cleanup_and_return; }
 
             /* Reduce on the right half of the buffers (result in rbuf) */
-            ompi_op_reduce(op, (char *)tmp_buf + (ptrdiff_t)count_lhalf * extent,
-                           (char *)rbuf + count_lhalf * extent, count_rhalf, dtype);
+            ompi_coll_base_reduce_in_order(op, (char *)tmp_buf + (ptrdiff_t)count_lhalf * extent,
+                                           (char *)rbuf + (ptrdiff_t)count_lhalf * extent,
+                                           (char *)rbuf + (ptrdiff_t)count_lhalf * extent,
+                                           count_rhalf, dtype, true);
 
             /* Send the right half to the left neighbor */
             err = MCA_PML_CALL(send((char *)rbuf + (ptrdiff_t)count_lhalf * extent,
@@ -920,8 +926,8 @@ int ompi_coll_base_reduce_intra_redscat_gather(
                                           MPI_STATUS_IGNORE, rank);
             if (MPI_SUCCESS != err) { goto cleanup_and_return; }
 
-            /* Reduce on the right half of the buffers (result in rbuf) */
-            ompi_op_reduce(op, tmp_buf, rbuf, count_lhalf, dtype);
+            /* Reduce on the left half of the buffers (result in rbuf) */
+            ompi_coll_base_reduce_in_order(op, tmp_buf, rbuf, rbuf, count_lhalf, dtype, false);
 
             /* Recv the right half from the right neighbor */
             err = MCA_PML_CALL(recv((char *)rbuf + (ptrdiff_t)count_lhalf * extent,
@@ -1002,10 +1008,11 @@ int ompi_coll_base_reduce_intra_redscat_gather(
                                           MPI_STATUS_IGNORE, rank);
             if (MPI_SUCCESS != err) { goto cleanup_and_return; }
 
-            /* Local reduce: rbuf[] = tmp_buf[] <op> rbuf[] */
-            ompi_op_reduce(op, (char *)tmp_buf + (ptrdiff_t)rindex[step] * extent,
-                           (char *)rbuf + (ptrdiff_t)rindex[step] * extent,
-                           rcount[step], dtype);
+            /* Local reduce: rbuf[] = tmp_buf[] <op> rbuf[], in the order of the ranks */
+            ompi_coll_base_reduce_in_order(op, (char *)tmp_buf + (ptrdiff_t)rindex[step] * extent,
+                                           (char *)rbuf + (ptrdiff_t)rindex[step] * extent,
+                                           (char *)rbuf + (ptrdiff_t)rindex[step] * extent,
+                                           rcount[step], dtype, dest < rank);
 
             /* Move the current window to the received message */
             if (step + 1 < nsteps) {
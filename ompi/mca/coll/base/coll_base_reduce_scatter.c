@@ -895,3 +895,168 @@ cleanup_and_return:
         free(tmpbuf[1]);
     return err;
 }
+
+/*
+ *   ompi_coll_base_reduce_scatter_intra_k_bruck
+ *
+ *   Function:       Radix k Bruck reduce_scatter
+ *   Accepts:        Same as MPI_Reduce_scatter(), radix
+ *   Returns:        MPI_SUCCESS or error code
+ *
+ *   Description:    Reverse of the k-port Bruck allgather. The input is
+ *                   rotated so that position i holds block (rank + i) % size.
+ *                   The steps go through the distances d = k^m, ..., k, 1 in
+ *                   decreasing order: rank r sends its positions
+ *                   [j * d .. j * d + d) to rank r + j * d and reduces the
+ *                   positions [0 .. d) received from rank r - j * d into its
+ *                   own, for j in [1 .. k), all exchanges of a step at the
+ *                   same time. Position 0 then holds the result of block
+ *                   rank. log_k(size) steps, any number of processes.
+ *
+ *   Limitations:    commutative operations only, the other ones take the
+ *                   non overlapping algorithm.
+ *
+ *   Memory requirements (per process): 2 * total count * typesize at most
+ */
+int
+ompi_coll_base_reduce_scatter_intra_k_bruck(const void *sbuf, void *rbuf,
+                                            const int *rcounts,
+                                            struct ompi_datatype_t *dtype,
+                                            struct ompi_op_t *op,
+                                            struct ompi_communicator_t *comm,
+                                            mca_coll_base_module_t *module,
+                                            int radix)
+{
+    int err = MPI_SUCCESS, line, rank, size, k, distance, nreqs = 0;
+    ptrdiff_t *rdispls = NULL, lb, extent, span, gap = 0, rank_disp = 0, rmax = 0;
+    char *tmpbuf_free = NULL, *recvbuf_free = NULL, *tmpbuf, *recvbuf, *src;
+    ompi_request_t **reqs = NULL;
+
+    size = ompi_comm_size(comm);
+    rank = ompi_comm_rank(comm);
+
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                 "coll:base:reduce_scatter_intra_k_bruck rank %d radix %d", rank, radix));
+
+    if (!ompi_op_is_commute(op)) {
+        return ompi_coll_base_reduce_scatter_intra_nonoverlapping(sbuf, rbuf, rcounts, dtype,
+                                                                  op, comm, module);
+    }
+
+    k = (radix < 2) ? 2 : radix;
+    if (k > size) {
+        k = size;
+    }
+
+    /* rdispls[i]: offset (in elements) of position i in the rotated buffer */
+    rdispls = (ptrdiff_t*) malloc(sizeof(ptrdiff_t) * (size + 1));
+    if (NULL == rdispls) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+    rdispls[0] = 0;
+    for (int i = 0; i < size; ++i) {
+        rdispls[i + 1] = rdispls[i] + rcounts[(rank + i) % size];
+    }
+    for (int i = 0; i < rank; ++i) {
+        rank_disp += rcounts[i];
+    }
+
+    if (0 == rdispls[size]) {
+        free(rdispls);
+        return MPI_SUCCESS;
+    }
+
+    src = (MPI_IN_PLACE == sbuf) ? (char*)rbuf : (char*)sbuf;
+    if (1 == size) {
+        if (MPI_IN_PLACE != sbuf) {
+            err = ompi_datatype_copy_content_same_ddt(dtype, rcounts[0], (char*)rbuf, src);
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+        free(rdispls);
+        return MPI_SUCCESS;
+    }
+
+    /* largest distance, and largest message received in a step */
+    for (distance = 1; distance < size / k + (0 != size % k); distance *= k);
+    for (int d = distance; d >= 1; d /= k) {
+        ptrdiff_t rsize = 0;
+        for (int j = 1; j < k && j * d < size; ++j) {
+            rsize += rdispls[(d < size - j * d) ? d : size - j * d];
+        }
+        if (rsize > rmax) {
+            rmax = rsize;
+        }
+    }
+
+    ompi_datatype_get_extent(dtype, &lb, &extent);
+    span = opal_datatype_span(&dtype->super, rdispls[size], &gap);
+    tmpbuf_free = (char*) malloc(span);
+    if (NULL == tmpbuf_free) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+    tmpbuf = tmpbuf_free - gap;
+    span = opal_datatype_span(&dtype->super, rmax, &gap);
+    recvbuf_free = (char*) malloc(span);
+    if (NULL == recvbuf_free) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+    recvbuf = recvbuf_free - gap;
+
+    /* rotate the input: blocks [rank .. size) first, then blocks [0 .. rank) */
+    err = ompi_datatype_copy_content_same_ddt(dtype, rdispls[size] - rank_disp, tmpbuf,
+                                              src + rank_disp * extent);
+    if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+    err = ompi_datatype_copy_content_same_ddt(dtype, rank_disp,
+                                              tmpbuf + (rdispls[size] - rank_disp) * extent, src);
+    if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+
+    reqs = ompi_coll_base_comm_get_reqs(module->base_data, 2 * (k - 1));
+    if (NULL == reqs) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+
+    for (; distance >= 1; distance /= k) {
+        ptrdiff_t roff = 0;
+
+        nreqs = 0;
+        for (int j = 1; j < k && j * distance < size; ++j) {
+            int cnt = (distance < size - j * distance) ? distance : size - j * distance;
+            int from = (rank - j * distance + size) % size;
+            int to = (rank + j * distance) % size;
+
+            /* the positions [0 .. cnt) of the peer are our positions [j * d .. j * d + cnt) */
+            err = MCA_PML_CALL(irecv(recvbuf + roff * extent, rdispls[cnt], dtype, from,
+                                     MCA_COLL_BASE_TAG_REDUCE_SCATTER, comm, &reqs[nreqs++]));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+            err = MCA_PML_CALL(isend(tmpbuf + rdispls[j * distance] * extent,
+                                     rdispls[j * distance + cnt] - rdispls[j * distance], dtype, to,
+                                     MCA_COLL_BASE_TAG_REDUCE_SCATTER,
+                                     MCA_PML_BASE_SEND_STANDARD, comm, &reqs[nreqs++]));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+            roff += rdispls[cnt];
+        }
+
+        err = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+
+        roff = 0;
+        for (int j = 1; j < k && j * distance < size; ++j) {
+            int cnt = (distance < size - j * distance) ? distance : size - j * distance;
+
+            ompi_op_reduce(op, recvbuf + roff * extent, tmpbuf, (int) rdispls[cnt], dtype);
+            roff += rdispls[cnt];
+        }
+    }
+
+    err = ompi_datatype_copy_content_same_ddt(dtype, rcounts[rank], (char*)rbuf, tmpbuf);
+    if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+
+    free(recvbuf_free);
+    free(tmpbuf_free);
+    free(rdispls);
+    return MPI_SUCCESS;
+
+ err_hndl:
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output, "%s:%4d\tRank %d Error occurred %d\n",
+                 __FILE__, line, rank, err));
+    (void)line;  // silence compiler warning
+    if (NULL != reqs) {
+        ompi_coll_base_free_reqs(reqs, nreqs);
+    }
+    if (NULL != recvbuf_free) free(recvbuf_free);
+    if (NULL != tmpbuf_free) free(tmpbuf_free);
+    if (NULL != rdispls) free(rdispls);
+    return err;
+}
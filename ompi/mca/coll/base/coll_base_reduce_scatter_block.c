@@ -890,3 +890,49 @@ cleanup_and_return:
         free(tmpbuf[1]);
     return err;
 }
+
+/*
+ * ompi_coll_base_reduce_scatter_block_intra_k_bruck
+ *
+ * Function:  Radix k Bruck reduce_scatter_block
+ * Accepts:   Same as MPI_Reduce_scatter_block, radix
+ * Returns:   MPI_SUCCESS or error code
+ *
+ * Description: ompi_coll_base_reduce_scatter_intra_k_bruck with the same
+ *              count for all the blocks: log_k(comm_size) steps of k - 1
+ *              concurrent exchanges, any number of processes.
+ *
+ * Limitations: commutative operations only, the other ones take the basic
+ *              linear algorithm.
+ */
+int
+ompi_coll_base_reduce_scatter_block_intra_k_bruck(
+    const void *sbuf, void *rbuf, int rcount, struct ompi_datatype_t *dtype,
+    struct ompi_op_t *op, struct ompi_communicator_t *comm,
+    mca_coll_base_module_t *module, int radix)
+{
+    int comm_size = ompi_comm_size(comm);
+    int *rcounts, err;
+
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                 "coll:base:reduce_scatter_block_intra_k_bruck: rank %d/%d radix %d",
+                 ompi_comm_rank(comm), comm_size, radix));
+
+    if (!ompi_op_is_commute(op)) {
+        return ompi_coll_base_reduce_scatter_block_basic_linear(sbuf, rbuf, rcount, dtype,
+                                                                op, comm, module);
+    }
+
+    rcounts = (int*) malloc(sizeof(int) * comm_size);
+    if (NULL == rcounts) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    for (int i = 0; i < comm_size; ++i) {
+        rcounts[i] = rcount;
+    }
+
+    err = ompi_coll_base_reduce_scatter_intra_k_bruck(sbuf, rbuf, rcounts, dtype, op,
+                                                      comm, module, radix);
+    free(rcounts);
+    return err;
+}
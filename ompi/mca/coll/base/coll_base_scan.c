@@ -228,3 +228,185 @@ cleanup_and_return:
         free(tmprecv_raw);
     return err;
 }
+
+/*
+ * ompi_coll_base_scan_intra_updown
+ *
+ * Function:  Segmented up/down tree algorithm for inclusive scan.
+ * Accepts:   Same as MPI_Scan, plus the segment size
+ * Returns:   MPI_SUCCESS or error code
+ *
+ * Description:  Work-efficient scan over the binary indexed tree of the
+ *               ranks, in the manner of the Blelloch up-sweep/down-sweep.
+ *               With L = lowbit(r + 1), rank r is in charge of the block
+ *               of ranks [r - L + 1, r].
+ *               Up-sweep: r receives the reductions of the blocks of size
+ *               1, 2, ..., L / 2 below its own rank from r - 1, r - 2, ...,
+ *               r - L / 2 and sends the reduction of its block to r + L.
+ *               Down-sweep: r receives the prefix [0, r - L] from r - L
+ *               (there is none when r + 1 = L), which completes its result,
+ *               and sends the result to r + L / 2, ..., r + 2, r + 1.
+ *               Every rank does at most 2 log2(p) reductions, the tree does
+ *               fewer than 2p of them, and the data is pipelined by segments
+ *               through the 2 log2(p) levels of the tree.
+ *               The order of operations is preserved so it can be used both
+ *               by commutative and non-commutative operations.
+ *
+ * Example for 8 processes (up-sweep, then down-sweep):
+ *    Up:    0 -> 1, 2 -> 3, 4 -> 5, 6 -> 7, 1 -> 3, 5 -> 7, 3 -> 7
+ *    Down:  3 -> 5, 3 -> 4, 1 -> 2, 5 -> 6
+ *
+ * Time complexity: (2\log_2(p) + s - 1)(\alpha + m/s\beta + m/s\gamma)
+ *                  for s segments
+ * Memory requirements (per process): count * typesize + segsize when the
+ *                  rank both sends up and receives a prefix, segsize otherwise
+ * Limitations: intra-communicators only
+ */
+int
+ompi_coll_base_scan_intra_updown(const void *sbuf, void *rbuf, int count,
+                                 struct ompi_datatype_t *dtype,
+                                 struct ompi_op_t *op,
+                                 struct ompi_communicator_t *comm,
+                                 mca_coll_base_module_t *module,
+                                 uint32_t segsize)
+{
+    int err = MPI_SUCCESS, line, rank, size, low, distance;
+    int segcount, num_segments, segindex, nsends = 0, nreqs = 0;
+    size_t typelng;
+    ptrdiff_t lb, extent, dsize, gap, realsegsize;
+    char *tmp_raw = NULL, *acc_raw = NULL, *tmpbuf, *accbuf;
+    ompi_request_t **reqs = NULL;
+
+    size = ompi_comm_size(comm);
+    rank = ompi_comm_rank(comm);
+
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                 "coll:base:scan_intra_updown: rank %d/%d segsize %u",
+                 rank, size, segsize));
+
+    if (MPI_IN_PLACE != sbuf) {
+        err = ompi_datatype_copy_content_same_ddt(dtype, count, (char *) rbuf, (char *) sbuf);
+        if (MPI_SUCCESS != err) { return err; }
+    }
+    if (size < 2 || 0 == count) {
+        return MPI_SUCCESS;
+    }
+
+    ompi_datatype_type_size(dtype, &typelng);
+    ompi_datatype_get_extent(dtype, &lb, &extent);
+    segcount = count;
+    COLL_BASE_COMPUTED_SEGCOUNT(segsize, typelng, segcount);
+    num_segments = (count + segcount - 1) / segcount;
+    realsegsize = (ptrdiff_t) segcount * extent;
+
+    low = (rank + 1) & -(rank + 1);
+    if (rank + low < size) {
+        nsends++;
+    }
+    for (distance = low >> 1; distance > 0; distance >>= 1) {
+        if (rank + distance < size) {
+            nsends++;
+        }
+    }
+
+    dsize = opal_datatype_span(&dtype->super, segcount, &gap);
+    tmp_raw = (char *) malloc(dsize);
+    if (NULL == tmp_raw) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+    tmpbuf = tmp_raw - gap;
+
+    /* The reduction of the block may still be on its way up when the
+     * prefix is added to it, it cannot live in rbuf in that case */
+    accbuf = (char *) rbuf;
+    if (rank + low < size && rank + 1 != low) {
+        dsize = opal_datatype_span(&dtype->super, count, &gap);
+        acc_raw = (char *) malloc(dsize);
+        if (NULL == acc_raw) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+        accbuf = acc_raw - gap;
+    }
+
+    /* the sends of two consecutive segments are in flight */
+    if (0 < nsends) {
+        reqs = ompi_coll_base_comm_get_reqs(module->base_data, 2 * nsends);
+        if (NULL == reqs) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+        nreqs = 2 * nsends;
+    }
+
+    for (segindex = 0; segindex < num_segments; segindex++) {
+        int scount = (segindex == num_segments - 1) ? count - segindex * segcount : segcount;
+        char *rseg = (char *) rbuf + (ptrdiff_t) segindex * realsegsize;
+        char *aseg = accbuf + (ptrdiff_t) segindex * realsegsize;
+        ompi_request_t **sreqs = reqs + (segindex & 1) * nsends;
+
+        if (accbuf != rbuf) {
+            err = ompi_datatype_copy_content_same_ddt(dtype, scount, aseg, rseg);
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+
+        /* Up-sweep: aseg = [r - L + 1, r - d] <op> aseg, nearest block first */
+        for (distance = 1; distance < low; distance <<= 1) {
+            err = MCA_PML_CALL(recv(tmpbuf, scount, dtype, rank - distance,
+                                    MCA_COLL_BASE_TAG_SCAN, comm, MPI_STATUS_IGNORE));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+            ompi_op_reduce(op, tmpbuf, aseg, scount, dtype);
+        }
+
+        /* reuse the requests of segment segindex - 2 */
+        if (0 < nsends) {
+            err = ompi_request_wait_all(nsends, sreqs, MPI_STATUSES_IGNORE);
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+        if (rank + low < size) {
+            err = MCA_PML_CALL(isend(aseg, scount, dtype, rank + low,
+                                     MCA_COLL_BASE_TAG_SCAN,
+                                     MCA_PML_BASE_SEND_STANDARD, comm, sreqs++));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+
+        /* Down-sweep: rseg = [0, r - L] <op> aseg */
+        if (rank + 1 != low) {
+            err = MCA_PML_CALL(recv(tmpbuf, scount, dtype, rank - low,
+                                    MCA_COLL_BASE_TAG_SCAN, comm, MPI_STATUS_IGNORE));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+            if (aseg != rseg) {
+                ompi_3buff_op_reduce(op, tmpbuf, aseg, rseg, scount, dtype);
+            } else {
+                ompi_op_reduce(op, tmpbuf, rseg, scount, dtype);
+            }
+        }
+        for (distance = low >> 1; distance > 0; distance >>= 1) {
+            if (rank + distance >= size) {
+                continue;
+            }
+            err = MCA_PML_CALL(isend(rseg, scount, dtype, rank + distance,
+                                     MCA_COLL_BASE_TAG_SCAN,
+                                     MCA_PML_BASE_SEND_STANDARD, comm, sreqs++));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+    }
+
+    if (0 < nsends) {
+        err = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+    }
+
+    free(tmp_raw);
+    if (NULL != acc_raw) {
+        free(acc_raw);
+    }
+    return MPI_SUCCESS;
+
+ err_hndl:
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output, "%s:%4d\tError occurred %d, rank %2d",
+                 __FILE__, line, err, rank));
+    (void)line;  // silence compiler warning
+    if (NULL != reqs) {
+        ompi_coll_base_free_reqs(reqs, nreqs);
+    }
+    if (NULL != tmp_raw) {
+        free(tmp_raw);
+    }
+    if (NULL != acc_raw) {
+        free(acc_raw);
+    }
+    return err;
+}
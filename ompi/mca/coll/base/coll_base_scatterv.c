@@ -0,0 +1,316 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/mca/coll/base/coll_tags.h"
+#include "ompi/mca/pml/pml.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "coll_base_util.h"
+
+/*
+ * ompi_coll_base_scatterv_intra_basic_linear
+ *
+ * Function:  Linear algorithm for scatterv, the root sends to every
+ *            rank in turn.
+ * Accepts:   Same as MPI_Scatterv
+ * Returns:   MPI_SUCCESS or error code
+ */
+int
+ompi_coll_base_scatterv_intra_basic_linear(const void *sbuf, const int *scounts,
+                                           const int *disps, struct ompi_datatype_t *sdtype,
+                                           void *rbuf, int rcount,
+                                           struct ompi_datatype_t *rdtype, int root,
+                                           struct ompi_communicator_t *comm,
+                                           mca_coll_base_module_t *module)
+{
+    int i, rank, size, err = MPI_SUCCESS;
+    char *ptmp;
+    ptrdiff_t lb, extent;
+
+    size = ompi_comm_size(comm);
+    rank = ompi_comm_rank(comm);
+
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                 "coll:base:scatterv_intra_basic_linear rank %d", rank));
+
+    if (rank != root) {
+        if (rcount > 0) {
+            return MCA_PML_CALL(recv(rbuf, rcount, rdtype, root,
+                                     MCA_COLL_BASE_TAG_SCATTERV,
+                                     comm, MPI_STATUS_IGNORE));
+        }
+        return MPI_SUCCESS;
+    }
+
+    ompi_datatype_get_extent(sdtype, &lb, &extent);
+
+    for (i = 0; i < size; ++i) {
+        ptmp = ((char *) sbuf) + (extent * disps[i]);
+
+        if (i == rank) {
+            if (MPI_IN_PLACE != rbuf && (0 < scounts[i]) && (0 < rcount)) {
+                err = ompi_datatype_sndrcv(ptmp, scounts[i], sdtype,
+                                           rbuf, rcount, rdtype);
+            }
+        } else if (scounts[i] > 0) {
+            err = MCA_PML_CALL(send(ptmp, scounts[i], sdtype, i,
+                                    MCA_COLL_BASE_TAG_SCATTERV,
+                                    MCA_PML_BASE_SEND_STANDARD, comm));
+        }
+
+        if (MPI_SUCCESS != err) {
+            return err;
+        }
+    }
+
+    return MPI_SUCCESS;
+}
+
+/*
+ * Level of vrank in the k-nomial tree rooted at vrank 0: the subtree of
+ * vrank spans [vrank, vrank + mask) and its children are vrank + j * d,
+ * 0 < j < radix, for the powers d of radix below mask.
+ */
+static int scatterv_knomial_mask(int vrank, int size, int radix)
+{
+    int mask = 1;
+
+    while (mask < size && 0 == vrank % (mask * radix)) {
+        mask *= radix;
+    }
+    return mask;
+}
+
+/*
+ * ompi_coll_base_scatterv_intra_knomial
+ *
+ * Function:  K-nomial tree algorithm for scatterv.
+ * Accepts:   Same as MPI_Scatterv, plus the radix of the tree
+ * Returns:   MPI_SUCCESS or error code
+ *
+ * Description:  The ranks, renumbered from the root, form an in-order
+ *               k-nomial tree so that every subtree is a contiguous range
+ *               of virtual ranks. The root packs the blocks of each subtree
+ *               in virtual rank order and sends them to the head of the
+ *               subtree, preceded by the size in bytes of every block of
+ *               the subtree (taken from its counts), which the
+ *               intermediate ranks forward together with the data of
+ *               their own children. The leaves receive their block
+ *               straight into the user buffer.
+ *               The farthest subtrees are served first. The root sends
+ *               to radix - 1 ranks per level instead of p - 1 ranks, at the
+ *               price of forwarding the blocks log_radix(p) times, it is
+ *               meant for large communicators and small blocks.
+ * Memory requirements: the packed blocks of its subtree on the
+ *               intermediate ranks, those of the largest subtree on the root
+ * Limitations: intra-communicators only, the blocks are staged in the
+ *               packed representation of the local node
+ */
+int
+ompi_coll_base_scatterv_intra_knomial(const void *sbuf, const int *scounts,
+                                      const int *disps, struct ompi_datatype_t *sdtype,
+                                      void *rbuf, int rcount,
+                                      struct ompi_datatype_t *rdtype, int root,
+                                      struct ompi_communicator_t *comm,
+                                      mca_coll_base_module_t *module,
+                                      int radix)
+{
+    int err = MPI_SUCCESS, line = -1, rank, vrank, size, mask, span, distance, j, v;
+    size_t tsize;
+    uint64_t total = 0, *sizes = NULL;
+    char *tmpbuf = NULL;
+    ptrdiff_t lb, extent, offset;
+
+    size = ompi_comm_size(comm);
+    rank = ompi_comm_rank(comm);
+
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
+                 "coll:base:scatterv_intra_knomial rank %d radix %d", rank, radix));
+
+    if (radix < 2) {
+        radix = 2;
+    }
+    vrank = (rank - root + size) % size;
+    mask = scatterv_knomial_mask(vrank, size, radix);
+    span = (mask < size - vrank) ? mask : size - vrank;
+
+    if (rank != root) {
+        int parent = (vrank - vrank % (mask * radix) + root) % size;
+
+        /* Leaves receive their block straight into the user buffer */
+        if (1 == span) {
+            ompi_datatype_type_size(rdtype, &tsize);
+            if (0 < rcount && 0 < tsize) {
+                err = MCA_PML_CALL(recv(rbuf, rcount, rdtype, parent,
+                                        MCA_COLL_BASE_TAG_SCATTERV,
+                                        comm, MPI_STATUS_IGNORE));
+            }
+            return err;
+        }
+
+        sizes = (uint64_t *) malloc(span * sizeof(uint64_t));
+        if (NULL == sizes) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+        err = MCA_PML_CALL(recv(sizes, span, MPI_UINT64_T, parent,
+                                MCA_COLL_BASE_TAG_SCATTERV, comm, MPI_STATUS_IGNORE));
+        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        for (v = 0; v < span; v++) {
+            total += sizes[v];
+        }
+        if (0 < total) {
+            tmpbuf = (char *) malloc(total);
+            if (NULL == tmpbuf) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+            err = MCA_PML_CALL(recv(tmpbuf, total, MPI_PACKED, parent,
+                                    MCA_COLL_BASE_TAG_SCATTERV, comm, MPI_STATUS_IGNORE));
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+
+        /* own block first, then the subtrees in virtual rank order */
+        if (0 < sizes[0]) {
+            err = ompi_datatype_sndrcv(tmpbuf, (int) sizes[0], MPI_PACKED, rbuf, rcount, rdtype);
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+
+        for (distance = mask / radix; distance > 0; distance /= radix) {
+            for (j = radix - 1; j > 0; j--) {
+                int vchild = vrank + j * distance, cspan = distance, peer;
+                uint64_t bytes = 0;
+                if (vchild >= size) {
+                    continue;
+                }
+                if (cspan > size - vchild) {
+                    cspan = size - vchild;
+                }
+                peer = (vchild + root) % size;
+                offset = 0;
+                for (v = 0; v < vchild - vrank; v++) {
+                    offset += sizes[v];
+                }
+                for (v = vchild - vrank; v < vchild - vrank + cspan; v++) {
+                    bytes += sizes[v];
+                }
+                if (1 < cspan) {
+                    err = MCA_PML_CALL(send(sizes + (vchild - vrank), cspan, MPI_UINT64_T, peer,
+                                            MCA_COLL_BASE_TAG_SCATTERV,
+                                            MCA_PML_BASE_SEND_STANDARD, comm));
+                    if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+                }
+                if (0 < bytes) {
+                    err = MCA_PML_CALL(send(tmpbuf + offset, bytes, MPI_PACKED, peer,
+                                            MCA_COLL_BASE_TAG_SCATTERV,
+                                            MCA_PML_BASE_SEND_STANDARD, comm));
+                    if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+                }
+            }
+        }
+    } else {
+        uint64_t max_bytes = 0;
+
+        ompi_datatype_type_size(sdtype, &tsize);
+        ompi_datatype_get_extent(sdtype, &lb, &extent);
+
+        /* room for the packed blocks and sizes of the largest subtree */
+        sizes = (uint64_t *) malloc(((mask / radix) > 0 ? mask / radix : 1) * sizeof(uint64_t));
+        if (NULL == sizes) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+        for (distance = radix; distance < mask; distance *= radix) {
+            for (j = 1; j < radix && vrank + j * distance < size; j++) {
+                uint64_t bytes = 0;
+                for (v = vrank + j * distance; v < vrank + (j + 1) * distance && v < size; v++) {
+                    bytes += (uint64_t) scounts[(v + root) % size] * tsize;
+                }
+                if (bytes > max_bytes) {
+                    max_bytes = bytes;
+                }
+            }
+        }
+        if (0 < max_bytes) {
+            tmpbuf = (char *) malloc(max_bytes);
+            if (NULL == tmpbuf) { err = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+        }
+
+        for (distance = mask / radix; distance > 0; distance /= radix) {
+            for (j = radix - 1; j > 0; j--) {
+                int vchild = vrank + j * distance, cspan = distance, peer;
+                if (vchild >= size) {
+                    continue;
+                }
+                if (cspan > size - vchild) {
+                    cspan = size - vchild;
+                }
+                peer = (vchild + root) % size;
+
+                /* the leaves get their block from the user buffer */
+                if (1 == cspan) {
+                    if (0 < scounts[peer] && 0 < tsize) {
+                        err = MCA_PML_CALL(send((char *) sbuf + extent * disps[peer], scounts[peer], sdtype,
+                                                peer, MCA_COLL_BASE_TAG_SCATTERV,
+                                                MCA_PML_BASE_SEND_STANDARD, comm));
+                        if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+                    }
+                    continue;
+                }
+
+                offset = 0;
+                for (v = 0; v < cspan; v++) {
+                    int r = (vchild + v + root) % size;
+                    sizes[v] = (uint64_t) scounts[r] * tsize;
+                    if (0 == sizes[v]) {
+                        continue;
+                    }
+                    err = ompi_datatype_sndrcv((char *) sbuf + extent * disps[r], scounts[r], sdtype,
+                                               tmpbuf + offset, (int) sizes[v], MPI_PACKED);
+                    if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+                    offset += sizes[v];
+                }
+                err = MCA_PML_CALL(send(sizes, cspan, MPI_UINT64_T, peer,
+                                        MCA_COLL_BASE_TAG_SCATTERV,
+                                        MCA_PML_BASE_SEND_STANDARD, comm));
+                if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+                if (0 < offset) {
+                    err = MCA_PML_CALL(send(tmpbuf, offset, MPI_PACKED, peer,
+                                            MCA_COLL_BASE_TAG_SCATTERV,
+                                            MCA_PML_BASE_SEND_STANDARD, comm));
+                    if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+                }
+            }
+        }
+
+        if (MPI_IN_PLACE != rbuf && 0 < scounts[rank] && 0 < rcount) {
+            err = ompi_datatype_sndrcv((char *) sbuf + extent * disps[rank], scounts[rank], sdtype,
+                                       rbuf, rcount, rdtype);
+            if (MPI_SUCCESS != err) { line = __LINE__; goto err_hndl; }
+        }
+    }
+
+    free(sizes);
+    if (NULL != tmpbuf) {
+        free(tmpbuf);
+    }
+    return MPI_SUCCESS;
+
+ err_hndl:
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output, "%s:%4d\tError occurred %d, rank %2d",
+                 __FILE__, line, err, rank));
+    (void)line;  // silence compiler warning
+    if (NULL != sizes) {
+        free(sizes);
+    }
+    if (NULL != tmpbuf) {
+        free(tmpbuf);
+    }
+    return err;
+}
@@ -21,6 +21,7 @@
 #include "ompi_config.h"
 
 #include "mpi.h"
+#include "opal/util/info.h"
 #include "ompi/constants.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/communicator/communicator.h"
@@ -127,6 +128,19 @@ int ompi_rounddown(int num, int factor)
     return num * factor;    /* floor(num / factor) * factor */
 }
 
+bool ompi_coll_base_comm_reproducible(struct ompi_communicator_t *comm)
+{
+    bool reproducible = false;
+    int flag;
+
+    if (NULL == comm->super.s_info) {
+        return false;
+    }
+    opal_info_get_bool(comm->super.s_info, "ompi_comm_coll_reproducible",
+                       &reproducible, &flag);
+    return flag && reproducible;
+}
+
 static void release_objs_callback(struct ompi_coll_base_nbc_request_t *request) {
     if (NULL != request->data.objs.objs[0]) {
         OBJ_RELEASE(request->data.objs.objs[0]);
@@ -136,6 +136,25 @@ ompi_coll_base_sendrecv( void* sendbuf, size_t scount, ompi_datatype_t* sdatatyp
                                            source, rtag, comm, status);
 }
 
+/**
+ * Local reduction of the data received from a peer with the local data,
+ * target = rbuf <op> lbuf if the peer holds the contribution of the lower
+ * ranks, lbuf <op> rbuf otherwise. The order only matters for the
+ * non-commutative operations, for which rbuf is overwritten when the local
+ * data comes first. target can be lbuf.
+ */
+static inline void
+ompi_coll_base_reduce_in_order( struct ompi_op_t *op, void *rbuf, void *lbuf, void *target,
+                                int count, ompi_datatype_t *dtype, bool rbuf_first )
+{
+    if (rbuf_first || ompi_op_is_commute(op)) {
+        ompi_3buff_op_reduce(op, rbuf, lbuf, target, count, dtype);
+        return;
+    }
+    ompi_op_reduce(op, lbuf, rbuf, count, dtype);
+    ompi_datatype_copy_content_same_ddt(dtype, count, (char *) target, (char *) rbuf);
+}
+
 /**
  * ompi_mirror_perm: Returns mirror permutation of nbits low-order bits
  *                   of x [*].
@@ -150,6 +169,14 @@ unsigned int ompi_mirror_perm(unsigned int x, int nbits);
  */
 int ompi_rounddown(int num, int factor);
 
+/*
+ * ompi_coll_base_comm_reproducible: Whether the communicator was created
+ *     with the ompi_comm_coll_reproducible info key set, asking for
+ *     reductions whose results do not depend on the placement of the
+ *     processes nor on the algorithm selection.
+ */
+bool ompi_coll_base_comm_reproducible(struct ompi_communicator_t *comm);
+
 /**
  * If necessary, retain op and store it in the
  * request object, which should be of type ompi_coll_base_nbc_request_t
@@ -31,6 +31,10 @@
 #define OMPI_COMM_ALLGATHER_TAG -7
 #define OMPI_COMM_BARRIER_TAG   -8
 #define OMPI_COMM_ALLREDUCE_TAG -9
+/* the bucket exchange of ompi_comm_split, a collective on the parent comm
+ * during which nothing else uses the tags above on it */
+#define OMPI_COMM_SPLIT_BUCKET_TAG OMPI_COMM_ALLGATHER_TAG
+#define OMPI_COMM_SPLIT_MEMBERS_TAG OMPI_COMM_ALLREDUCE_TAG
 
 #define MCA_COLL_BASE_TAG_BLOCKING_BASE -7
 #define MCA_COLL_BASE_TAG_ALLGATHER -10
@@ -60,8 +64,9 @@
 #define MCA_COLL_BASE_TAG_FT_END                 (MCA_COLL_BASE_TAG_FT_BASE - 3)
 
 #define MCA_COLL_BASE_TAG_UCC                    (MCA_COLL_BASE_TAG_FT_END - 1)
+#define MCA_COLL_BASE_TAG_MCAST                  (MCA_COLL_BASE_TAG_UCC - 1)
 
-#define MCA_COLL_BASE_TAG_STATIC_END             (MCA_COLL_BASE_TAG_UCC - 1)
+#define MCA_COLL_BASE_TAG_STATIC_END             (MCA_COLL_BASE_TAG_MCAST - 1)
 
 
 
@@ -168,7 +168,7 @@ mca_coll_basic_neighbor_allgatherv_dist_graph(const void *sbuf, int scount, stru
     int indegree, outdegree;
     ompi_request_t **reqs, **preqs;
     ptrdiff_t lb, extent;
-    int rc = MPI_SUCCESS, neighbor;
+    int rc = MPI_SUCCESS, neighbor, k;
 
     indegree = dist_graph->indegree;
     outdegree = dist_graph->outdegree;
@@ -181,18 +181,20 @@ mca_coll_basic_neighbor_allgatherv_dist_graph(const void *sbuf, int scount, stru
     reqs = preqs = ompi_coll_base_comm_get_reqs( module->base_data, indegree + outdegree);
     if( NULL == reqs ) { return OMPI_ERR_OUT_OF_RESOURCE; }
 
-    for (neighbor = 0; neighbor < indegree ; ++neighbor) {
+    for (k = 0; k < indegree ; ++k) {
+        neighbor = MCA_TOPO_BASE_DIST_GRAPH_IN(dist_graph, k);
         rc = MCA_PML_CALL(irecv((char *) rbuf + disps[neighbor] * extent, rcounts[neighbor], rdtype,
                                 inedges[neighbor], MCA_COLL_BASE_TAG_ALLGATHER, comm, preqs++));
         if (OMPI_SUCCESS != rc) break;
     }
 
     if (OMPI_SUCCESS != rc) {
-        ompi_coll_base_free_reqs(reqs, neighbor + 1);
+        ompi_coll_base_free_reqs(reqs, k + 1);
         return rc;
     }
 
-    for (neighbor = 0 ; neighbor < outdegree ; ++neighbor) {
+    for (k = 0 ; k < outdegree ; ++k) {
+        neighbor = MCA_TOPO_BASE_DIST_GRAPH_OUT(dist_graph, k);
         /* remove cast from const when the pml layer is updated to take
          * a const for the send buffer. */
         rc = MCA_PML_CALL(isend((void *) sbuf, scount, sdtype, outedges[neighbor],
@@ -202,7 +204,7 @@ mca_coll_basic_neighbor_allgatherv_dist_graph(const void *sbuf, int scount, stru
     }
 
     if (OMPI_SUCCESS != rc) {
-        ompi_coll_base_free_reqs(reqs, indegree + neighbor + 1);
+        ompi_coll_base_free_reqs(reqs, indegree + k + 1);
         return rc;
     }
 
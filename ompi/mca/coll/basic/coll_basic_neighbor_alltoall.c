@@ -207,7 +207,7 @@ mca_coll_basic_neighbor_alltoall_dist_graph(const void *sbuf, int scount,struct
 {
     const mca_topo_base_comm_dist_graph_2_2_0_t *dist_graph = comm->c_topo->mtc.dist_graph;
     ptrdiff_t lb, rdextent, sdextent;
-    int rc = MPI_SUCCESS, neighbor;
+    int rc = MPI_SUCCESS, neighbor, k;
     const int *inedges, *outedges;
     int indegree, outdegree;
     ompi_request_t **reqs, **preqs;
@@ -224,31 +224,33 @@ mca_coll_basic_neighbor_alltoall_dist_graph(const void *sbuf, int scount,struct
     reqs = preqs = ompi_coll_base_comm_get_reqs( module->base_data, indegree + outdegree);
     if( NULL == reqs ) { return OMPI_ERR_OUT_OF_RESOURCE; }
 
-    /* post receives first */
-    for (neighbor = 0; neighbor < indegree ; ++neighbor) {
-        rc = MCA_PML_CALL(irecv(rbuf, rcount, rdtype, inedges[neighbor],
+    /* post receives first, in the order of the topology plan */
+    for (k = 0; k < indegree ; ++k) {
+        neighbor = MCA_TOPO_BASE_DIST_GRAPH_IN(dist_graph, k);
+        rc = MCA_PML_CALL(irecv((char *) rbuf + (ptrdiff_t) neighbor * rdextent * rcount,
+                                rcount, rdtype, inedges[neighbor],
                                 MCA_COLL_BASE_TAG_ALLTOALL,
                                 comm, preqs++));
         if (OMPI_SUCCESS != rc) break;
-        rbuf = (char *) rbuf + rdextent * rcount;
     }
 
     if (OMPI_SUCCESS != rc) {
-        ompi_coll_base_free_reqs(reqs, neighbor + 1);
+        ompi_coll_base_free_reqs(reqs, k + 1);
         return rc;
     }
 
-    for (neighbor = 0 ; neighbor < outdegree ; ++neighbor) {
+    for (k = 0 ; k < outdegree ; ++k) {
+        neighbor = MCA_TOPO_BASE_DIST_GRAPH_OUT(dist_graph, k);
         /* remove cast from const when the pml layer is updated to take a const for the send buffer */
-        rc = MCA_PML_CALL(isend((void *) sbuf, scount, sdtype, outedges[neighbor],
+        rc = MCA_PML_CALL(isend((char *) sbuf + (ptrdiff_t) neighbor * sdextent * scount,
+                                scount, sdtype, outedges[neighbor],
                                 MCA_COLL_BASE_TAG_ALLTOALL, MCA_PML_BASE_SEND_STANDARD,
                                 comm, preqs++));
         if (OMPI_SUCCESS != rc) break;
-        sbuf = (char *) sbuf + sdextent * scount;
     }
 
     if (OMPI_SUCCESS != rc) {
-        ompi_coll_base_free_reqs(reqs, indegree + neighbor + 1);
+        ompi_coll_base_free_reqs(reqs, indegree + k + 1);
         return rc;
     }
 
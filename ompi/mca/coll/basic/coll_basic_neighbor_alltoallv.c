@@ -188,7 +188,7 @@ mca_coll_basic_neighbor_alltoallv_dist_graph(const void *sbuf, const int scounts
 {
     const mca_topo_base_comm_dist_graph_2_2_0_t *dist_graph = comm->c_topo->mtc.dist_graph;
     ptrdiff_t lb, rdextent, sdextent;
-    int rc = MPI_SUCCESS, neighbor;
+    int rc = MPI_SUCCESS, neighbor, k;
     const int *inedges, *outedges;
     int indegree, outdegree;
     ompi_request_t **reqs, **preqs;
@@ -205,19 +205,21 @@ mca_coll_basic_neighbor_alltoallv_dist_graph(const void *sbuf, const int scounts
     reqs = preqs = ompi_coll_base_comm_get_reqs( module->base_data, indegree + outdegree);
     if( NULL == reqs ) { return OMPI_ERR_OUT_OF_RESOURCE; }
 
-    /* post all receives first */
-    for (neighbor = 0; neighbor < indegree ; ++neighbor) {
+    /* post all receives first, in the order of the topology plan */
+    for (k = 0; k < indegree ; ++k) {
+        neighbor = MCA_TOPO_BASE_DIST_GRAPH_IN(dist_graph, k);
         rc = MCA_PML_CALL(irecv((char *) rbuf + rdisps[neighbor] * rdextent, rcounts[neighbor], rdtype,
                                 inedges[neighbor], MCA_COLL_BASE_TAG_ALLTOALL, comm, preqs++));
         if (OMPI_SUCCESS != rc) break;
     }
 
     if (OMPI_SUCCESS != rc) {
-        ompi_coll_base_free_reqs(reqs, neighbor + 1);
+        ompi_coll_base_free_reqs(reqs, k + 1);
         return rc;
     }
 
-    for (neighbor = 0 ; neighbor < outdegree ; ++neighbor) {
+    for (k = 0 ; k < outdegree ; ++k) {
+        neighbor = MCA_TOPO_BASE_DIST_GRAPH_OUT(dist_graph, k);
         /* remove cast from const when the pml layer is updated to take a const for the send buffer */
         rc = MCA_PML_CALL(isend((char *) sbuf + sdisps[neighbor] * sdextent, scounts[neighbor], sdtype,
                                 outedges[neighbor], MCA_COLL_BASE_TAG_ALLTOALL, MCA_PML_BASE_SEND_STANDARD,
@@ -226,7 +228,7 @@ mca_coll_basic_neighbor_alltoallv_dist_graph(const void *sbuf, const int scounts
     }
 
     if (OMPI_SUCCESS != rc) {
-        ompi_coll_base_free_reqs(reqs, indegree + neighbor + 1);
+        ompi_coll_base_free_reqs(reqs, indegree + k + 1);
         return rc;
     }
 
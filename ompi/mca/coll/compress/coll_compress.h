@@ -0,0 +1,147 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * The compress component interposes MPI_Allreduce and MPI_Allgather on
+ * MPI_FLOAT buffers and runs them over a ring whose messages travel in a
+ * compressed wire format.  The decoding of the incoming block is fused with
+ * the reduction and with the encoding of the block sent on the next step, so
+ * the payload is only walked once per step.  Everything else is forwarded to
+ * the underlying modules.
+ *
+ * The wire format is selected per communicator with the
+ * "ompi_comm_coll_compress" info key (given when the communicator is
+ * created, e.g. with MPI_Comm_dup_with_info), or for all communicators with
+ * the coll_compress_mode MCA parameter:
+ *   - "lossless": XOR of consecutive values, stored without their leading
+ *     zero bytes;
+ *   - "bf16": values are rounded to bfloat16 on the wire (lossy);
+ *   - "quantize": values are quantized on a uniform grid of twice the error
+ *     bound ("ompi_comm_coll_compress_error_bound" info key), and the grid
+ *     deltas are stored without their leading zero bytes (lossy, the bound
+ *     holds for each hop).
+ * In the lossy modes every rank ends up with the same values: the owner of
+ * a block keeps the decoded version of what it sent.
+ */
+
+#ifndef MCA_COLL_COMPRESS_EXPORT_H
+#define MCA_COLL_COMPRESS_EXPORT_H
+
+#include "ompi_config.h"
+
+#include "mpi.h"
+
+#include "opal/class/opal_object.h"
+#include "opal/mca/mca.h"
+
+#include "ompi/constants.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/mca/coll/base/base.h"
+#include "ompi/communicator/communicator.h"
+
+BEGIN_C_DECLS
+
+typedef enum {
+    MCA_COLL_COMPRESS_NONE = 0,
+    MCA_COLL_COMPRESS_LOSSLESS,
+    MCA_COLL_COMPRESS_BF16,
+    MCA_COLL_COMPRESS_QUANTIZE,
+} mca_coll_compress_mode_t;
+
+typedef struct mca_coll_compress_codec_t {
+    mca_coll_compress_mode_t mode;
+    /* Quantization step (twice the error bound) and its inverse */
+    double step;
+    double inv_step;
+} mca_coll_compress_codec_t;
+
+/* API functions */
+
+int mca_coll_compress_init_query(bool enable_progress_threads,
+                                 bool enable_mpi_threads);
+mca_coll_base_module_t
+*mca_coll_compress_comm_query(struct ompi_communicator_t *comm,
+                              int *priority);
+
+int mca_coll_compress_module_enable(mca_coll_base_module_t *module,
+                                    struct ompi_communicator_t *comm);
+
+int mca_coll_compress_allreduce(const void *sbuf, void *rbuf, int count,
+                                struct ompi_datatype_t *dtype,
+                                struct ompi_op_t *op,
+                                struct ompi_communicator_t *comm,
+                                mca_coll_base_module_t *module);
+
+int mca_coll_compress_allgather(const void *sbuf, int scount,
+                                struct ompi_datatype_t *sdtype,
+                                void *rbuf, int rcount,
+                                struct ompi_datatype_t *rdtype,
+                                struct ompi_communicator_t *comm,
+                                mca_coll_base_module_t *module);
+
+/* Codec */
+
+/* Largest encoded size of count values */
+size_t mca_coll_compress_bound(const mca_coll_compress_codec_t *codec, size_t count);
+
+/* Encode count values into out and return the encoded size.  In the lossy
+ * modes the values are replaced by their decoded version. */
+size_t mca_coll_compress_encode(const mca_coll_compress_codec_t *codec,
+                                float *buf, size_t count, uint8_t *out);
+
+/* Decode count values from in into buf, return the number of bytes read */
+size_t mca_coll_compress_decode(const mca_coll_compress_codec_t *codec,
+                                const uint8_t *in, size_t count, float *buf);
+
+/* Add the count values decoded from in to acc, and encode the sums into out
+ * in the same pass.  Return the number of bytes read, the encoded size is
+ * returned in outlen. */
+size_t mca_coll_compress_decode_sum_encode(const mca_coll_compress_codec_t *codec,
+                                           const uint8_t *in, size_t count,
+                                           float *acc, uint8_t *out,
+                                           size_t *outlen);
+
+/* Types */
+/* Module */
+
+typedef struct mca_coll_compress_module_t {
+    mca_coll_base_module_t super;
+
+    /* Pointers to the "real" collective functions */
+    mca_coll_base_comm_coll_t c_coll;
+
+    /* Wire format of this communicator */
+    mca_coll_compress_codec_t codec;
+} mca_coll_compress_module_t;
+
+OBJ_CLASS_DECLARATION(mca_coll_compress_module_t);
+
+/* Component */
+
+typedef struct mca_coll_compress_component_t {
+    mca_coll_base_component_2_4_0_t super;
+
+    int priority; /* Priority of this component */
+    char *mode;   /* Wire format of the communicators without info key */
+    double error_bound; /* Default error bound of the quantize mode */
+    size_t min_bytes;   /* Smaller payloads are not compressed */
+} mca_coll_compress_component_t;
+
+/* Globally exported variables */
+
+OMPI_MODULE_DECLSPEC extern mca_coll_compress_component_t mca_coll_compress_component;
+
+END_C_DECLS
+
+#endif /* MCA_COLL_COMPRESS_EXPORT_H */
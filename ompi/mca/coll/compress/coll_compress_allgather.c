@@ -0,0 +1,104 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/mca/pml/pml.h"
+#include "ompi/mca/coll/base/coll_tags.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "coll_compress.h"
+
+/*
+ *	allgather
+ *
+ *	Function:	- ring allgather with compressed messages
+ *	Accepts:	- same as MPI_Allgather()
+ *	Returns:	- MPI_SUCCESS or error code
+ *
+ *	Each block is encoded once by its owner, forwarded as received and
+ *	decoded in the receive buffer by every other rank.
+ */
+int
+mca_coll_compress_allgather(const void *sbuf, int scount,
+                            struct ompi_datatype_t *sdtype,
+                            void *rbuf, int rcount,
+                            struct ompi_datatype_t *rdtype,
+                            struct ompi_communicator_t *comm,
+                            mca_coll_base_module_t *module)
+{
+    mca_coll_compress_module_t *s = (mca_coll_compress_module_t*) module;
+    int ret, line, rank, size, k, block, send_to, recv_from;
+    uint8_t *tmp = NULL, *inbuf, *outbuf, *swap;
+    size_t bound, outlen;
+    float *blocks = (float*)rbuf;
+    ompi_request_t *req;
+
+    size = ompi_comm_size(comm);
+    if (MPI_FLOAT != rdtype || 0 == rcount ||
+        (MPI_IN_PLACE != sbuf && (MPI_FLOAT != sdtype || scount != rcount)) ||
+        (size_t)rcount * size * sizeof(float) < mca_coll_compress_component.min_bytes ||
+        (bound = mca_coll_compress_bound(&s->codec, rcount)) > INT_MAX) {
+        return s->c_coll.coll_allgather(sbuf, scount, sdtype, rbuf, rcount, rdtype,
+                                        comm, s->c_coll.coll_allgather_module);
+    }
+
+    rank = ompi_comm_rank(comm);
+    send_to = (rank + 1) % size;
+    recv_from = (rank + size - 1) % size;
+
+    if (MPI_IN_PLACE != sbuf) {
+        ret = ompi_datatype_copy_content_same_ddt(rdtype, rcount,
+                                                  (char*)(blocks + (size_t)rank * rcount),
+                                                  (char*)sbuf);
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hndl; }
+    }
+
+    tmp = (uint8_t*)malloc(2 * bound);
+    if (NULL == tmp) { ret = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+    inbuf = tmp;
+    outbuf = tmp + bound;
+
+    /* On step k, forward block (rank - k) and receive block (rank - k - 1) */
+    outlen = mca_coll_compress_encode(&s->codec, blocks + (size_t)rank * rcount,
+                                      rcount, outbuf);
+    for (k = 0; k < size - 1; k++) {
+        block = (rank - k - 1 + size) % size;
+        ret = MCA_PML_CALL(irecv(inbuf, (int)bound, MPI_BYTE, recv_from,
+                                 MCA_COLL_BASE_TAG_ALLGATHER, comm, &req));
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hndl; }
+        ret = MCA_PML_CALL(send(outbuf, (int)outlen, MPI_BYTE, send_to,
+                                MCA_COLL_BASE_TAG_ALLGATHER,
+                                MCA_PML_BASE_SEND_STANDARD, comm));
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hndl; }
+        ret = ompi_request_wait(&req, MPI_STATUS_IGNORE);
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hndl; }
+        outlen = mca_coll_compress_decode(&s->codec, inbuf, rcount,
+                                          blocks + (size_t)block * rcount);
+        swap = inbuf; inbuf = outbuf; outbuf = swap;
+    }
+
+    free(tmp);
+    return MPI_SUCCESS;
+
+ err_hndl:
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output, "%s:%4d\tError occurred %d, rank %2d",
+                 __FILE__, line, ret, ompi_comm_rank(comm)));
+    (void)line;  // silence compiler warning
+    if (NULL != tmp) free(tmp);
+    return ret;
+}
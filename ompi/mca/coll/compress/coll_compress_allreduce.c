@@ -0,0 +1,137 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/op/op.h"
+#include "ompi/mca/pml/pml.h"
+#include "ompi/mca/coll/base/coll_tags.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "coll_compress.h"
+
+/*
+ *	allreduce
+ *
+ *	Function:	- ring allreduce (reduce-scatter followed by allgather)
+ *	                  with compressed messages
+ *	Accepts:	- same as MPI_Allreduce()
+ *	Returns:	- MPI_SUCCESS or error code
+ *
+ *	On each step of the reduce-scatter the incoming block is decoded,
+ *	added to the local block, and the sum is encoded for the next step in
+ *	the same pass.  During the allgather the encoded blocks are forwarded
+ *	as received, and decoded in the receive buffer.
+ */
+int
+mca_coll_compress_allreduce(const void *sbuf, void *rbuf, int count,
+                            struct ompi_datatype_t *dtype,
+                            struct ompi_op_t *op,
+                            struct ompi_communicator_t *comm,
+                            mca_coll_base_module_t *module)
+{
+    mca_coll_compress_module_t *s = (mca_coll_compress_module_t*) module;
+    int ret, line, rank, size, k, block, split_rank, early_count, late_count;
+    int send_to, recv_from;
+    uint8_t *tmp = NULL, *inbuf, *outbuf, *swap;
+    size_t bound, outlen;
+    float *acc = (float*)rbuf;
+    ompi_request_t *req;
+
+    size = ompi_comm_size(comm);
+    if (MPI_FLOAT != dtype || MPI_SUM != op || count < size ||
+        (size_t)count * sizeof(float) < mca_coll_compress_component.min_bytes) {
+        return s->c_coll.coll_allreduce(sbuf, rbuf, count, dtype, op, comm,
+                                        s->c_coll.coll_allreduce_module);
+    }
+    COLL_BASE_COMPUTE_BLOCKCOUNT(count, size, split_rank, early_count, late_count);
+    bound = mca_coll_compress_bound(&s->codec, early_count);
+    if (bound > INT_MAX) {
+        return s->c_coll.coll_allreduce(sbuf, rbuf, count, dtype, op, comm,
+                                        s->c_coll.coll_allreduce_module);
+    }
+
+#define BLOCK_OFFSET(b) ((b) < split_rank ? (size_t)(b) * early_count : \
+                         (size_t)(b) * late_count + split_rank)
+#define BLOCK_COUNT(b)  ((b) < split_rank ? early_count : late_count)
+
+    rank = ompi_comm_rank(comm);
+    send_to = (rank + 1) % size;
+    recv_from = (rank + size - 1) % size;
+
+    if (MPI_IN_PLACE != sbuf) {
+        ret = ompi_datatype_copy_content_same_ddt(dtype, count, (char*)rbuf, (char*)sbuf);
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hndl; }
+    }
+
+    tmp = (uint8_t*)malloc(2 * bound);
+    if (NULL == tmp) { ret = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hndl; }
+    inbuf = tmp;
+    outbuf = tmp + bound;
+
+    /* Reduce-scatter: on step k, send block (rank - k) and reduce block
+     * (rank - k - 1), which is the one sent on the next step */
+    outlen = mca_coll_compress_encode(&s->codec, acc + BLOCK_OFFSET(rank),
+                                      BLOCK_COUNT(rank), outbuf);
+    for (k = 0; k < size - 1; k++) {
+        block = (rank - k - 1 + size) % size;
+        ret = MCA_PML_CALL(irecv(inbuf, (int)bound, MPI_BYTE, recv_from,
+                                 MCA_COLL_BASE_TAG_ALLREDUCE, comm, &req));
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hndl; }
+        ret = MCA_PML_CALL(send(outbuf, (int)outlen, MPI_BYTE, send_to,
+                                MCA_COLL_BASE_TAG_ALLREDUCE,
+                                MCA_PML_BASE_SEND_STANDARD, comm));
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hndl; }
+        ret = ompi_request_wait(&req, MPI_STATUS_IGNORE);
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hndl; }
+        (void)mca_coll_compress_decode_sum_encode(&s->codec, inbuf, BLOCK_COUNT(block),
+                                                  acc + BLOCK_OFFSET(block),
+                                                  outbuf, &outlen);
+    }
+
+    /* Allgather: outbuf holds the encoded block (rank + 1), which is fully
+     * reduced.  On step k, forward block (rank + 1 - k) and receive block
+     * (rank - k). */
+    for (k = 0; k < size - 1; k++) {
+        block = (rank - k + size) % size;
+        ret = MCA_PML_CALL(irecv(inbuf, (int)bound, MPI_BYTE, recv_from,
+                                 MCA_COLL_BASE_TAG_ALLREDUCE, comm, &req));
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hndl; }
+        ret = MCA_PML_CALL(send(outbuf, (int)outlen, MPI_BYTE, send_to,
+                                MCA_COLL_BASE_TAG_ALLREDUCE,
+                                MCA_PML_BASE_SEND_STANDARD, comm));
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hndl; }
+        ret = ompi_request_wait(&req, MPI_STATUS_IGNORE);
+        if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hndl; }
+        outlen = mca_coll_compress_decode(&s->codec, inbuf, BLOCK_COUNT(block),
+                                          acc + BLOCK_OFFSET(block));
+        swap = inbuf; inbuf = outbuf; outbuf = swap;
+    }
+
+#undef BLOCK_OFFSET
+#undef BLOCK_COUNT
+
+    free(tmp);
+    return MPI_SUCCESS;
+
+ err_hndl:
+    OPAL_OUTPUT((ompi_coll_base_framework.framework_output, "%s:%4d\tError occurred %d, rank %2d",
+                 __FILE__, line, ret, ompi_comm_rank(comm)));
+    (void)line;  // silence compiler warning
+    if (NULL != tmp) free(tmp);
+    return ret;
+}
@@ -0,0 +1,209 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Wire formats of the compress component.
+ *
+ * The lossless and quantize modes turn each value into a 32-bit word which
+ * is mostly made of leading zero bytes: the XOR with the previous value
+ * (sign, exponent and high mantissa bits of neighbouring values tend to be
+ * equal), or the zigzag encoded difference between consecutive grid indices.
+ * The words go by groups of four, behind a control byte holding a 2-bit tag
+ * per word which selects how many of its low-order bytes follow.  The bf16
+ * mode keeps the 16 high-order bits of each value, rounded to nearest even.
+ */
+
+#include "ompi_config.h"
+
+#include <string.h>
+#include <math.h>
+
+#include "coll_compress.h"
+
+/* Payload bytes of each tag, and tag of each number of significant bytes */
+static const uint8_t lossless_taglen[4] = {0, 2, 3, 4};
+static const uint8_t lossless_needtag[5] = {0, 1, 1, 2, 3};
+static const uint8_t quantize_taglen[4] = {0, 1, 2, 4};
+static const uint8_t quantize_needtag[5] = {0, 1, 2, 3, 3};
+
+/* Keep the grid indices in the range of a 32-bit word */
+#define COMPRESS_QUANTIZE_MAX 1073741824.0
+
+typedef union {
+    float f;
+    uint32_t u;
+} compress_bits_t;
+
+typedef struct {
+    uint8_t *ptr;
+    uint8_t *ctl;   /* control byte of the current group */
+    int slot;       /* position in the current group */
+    uint32_t prev;  /* previous value (or grid index) of the stream */
+} compress_stream_t;
+
+static inline void compress_stream_init(compress_stream_t *s, uint8_t *buf)
+{
+    s->ptr = buf;
+    s->ctl = NULL;
+    s->slot = 0;
+    s->prev = 0;
+}
+
+static inline void compress_put_word(compress_stream_t *s, uint32_t w,
+                                     const uint8_t *taglen, const uint8_t *needtag)
+{
+    int need, tag, b;
+
+    if (0 == s->slot) {
+        s->ctl = s->ptr++;
+        *s->ctl = 0;
+    }
+    need = (w > 0xffffff) ? 4 : (w > 0xffff) ? 3 : (w > 0xff) ? 2 : (0 != w);
+    tag = needtag[need];
+    *s->ctl |= (uint8_t)(tag << (2 * s->slot));
+    for (b = 0; b < taglen[tag]; b++) {
+        *s->ptr++ = (uint8_t)(w >> (8 * b));
+    }
+    s->slot = (s->slot + 1) & 3;
+}
+
+static inline uint32_t compress_get_word(compress_stream_t *s, const uint8_t *taglen)
+{
+    uint32_t w = 0;
+    int tag, b;
+
+    if (0 == s->slot) {
+        s->ctl = s->ptr++;
+    }
+    tag = (*s->ctl >> (2 * s->slot)) & 3;
+    for (b = 0; b < taglen[tag]; b++) {
+        w |= (uint32_t)(*s->ptr++) << (8 * b);
+    }
+    s->slot = (s->slot + 1) & 3;
+    return w;
+}
+
+/*
+ * Encode one value and return its decoded version
+ */
+static inline float compress_put(const mca_coll_compress_codec_t *codec,
+                                 compress_stream_t *s, float value)
+{
+    compress_bits_t v = {.f = value};
+    uint32_t w;
+
+    switch (codec->mode) {
+    case MCA_COLL_COMPRESS_LOSSLESS:
+        compress_put_word(s, v.u ^ s->prev, lossless_taglen, lossless_needtag);
+        s->prev = v.u;
+        return value;
+    case MCA_COLL_COMPRESS_BF16:
+        if ((v.u & 0x7fffffff) > 0x7f800000) {
+            w = (v.u >> 16) | 0x40;  /* keep NaNs quiet */
+        } else {
+            w = (v.u + 0x7fff + ((v.u >> 16) & 1)) >> 16;
+        }
+        *s->ptr++ = (uint8_t)w;
+        *s->ptr++ = (uint8_t)(w >> 8);
+        v.u = w << 16;
+        return v.f;
+    default: {
+        double q = nearbyint((double)value * codec->inv_step);
+        int32_t idx;
+
+        if (q > COMPRESS_QUANTIZE_MAX) {
+            q = COMPRESS_QUANTIZE_MAX;
+        } else if (!(q >= -COMPRESS_QUANTIZE_MAX)) {  /* also catches NaNs */
+            q = -COMPRESS_QUANTIZE_MAX;
+        }
+        idx = (int32_t)q;
+        w = (uint32_t)idx - s->prev;
+        compress_put_word(s, (w << 1) ^ (uint32_t)((int32_t)w >> 31),
+                          quantize_taglen, quantize_needtag);
+        s->prev = (uint32_t)idx;
+        return (float)(q * codec->step);
+    }
+    }
+}
+
+static inline float compress_get(const mca_coll_compress_codec_t *codec,
+                                 compress_stream_t *s)
+{
+    compress_bits_t v;
+    uint32_t w;
+
+    switch (codec->mode) {
+    case MCA_COLL_COMPRESS_LOSSLESS:
+        v.u = compress_get_word(s, lossless_taglen) ^ s->prev;
+        s->prev = v.u;
+        return v.f;
+    case MCA_COLL_COMPRESS_BF16:
+        v.u = ((uint32_t)s->ptr[0] << 16) | ((uint32_t)s->ptr[1] << 24);
+        s->ptr += 2;
+        return v.f;
+    default:
+        w = compress_get_word(s, quantize_taglen);
+        s->prev += (w >> 1) ^ (0 - (w & 1));
+        return (float)((double)(int32_t)s->prev * codec->step);
+    }
+}
+
+size_t mca_coll_compress_bound(const mca_coll_compress_codec_t *codec, size_t count)
+{
+    if (MCA_COLL_COMPRESS_BF16 == codec->mode) {
+        return 2 * count;
+    }
+    return 4 * count + (count + 3) / 4;
+}
+
+size_t mca_coll_compress_encode(const mca_coll_compress_codec_t *codec,
+                                float *buf, size_t count, uint8_t *out)
+{
+    compress_stream_t s;
+    size_t i;
+
+    compress_stream_init(&s, out);
+    for (i = 0; i < count; i++) {
+        buf[i] = compress_put(codec, &s, buf[i]);
+    }
+    return (size_t)(s.ptr - out);
+}
+
+size_t mca_coll_compress_decode(const mca_coll_compress_codec_t *codec,
+                                const uint8_t *in, size_t count, float *buf)
+{
+    compress_stream_t s;
+    size_t i;
+
+    compress_stream_init(&s, (uint8_t*)in);
+    for (i = 0; i < count; i++) {
+        buf[i] = compress_get(codec, &s);
+    }
+    return (size_t)(s.ptr - in);
+}
+
+size_t mca_coll_compress_decode_sum_encode(const mca_coll_compress_codec_t *codec,
+                                           const uint8_t *in, size_t count,
+                                           float *acc, uint8_t *out,
+                                           size_t *outlen)
+{
+    compress_stream_t rs, ws;
+    size_t i;
+
+    compress_stream_init(&rs, (uint8_t*)in);
+    compress_stream_init(&ws, out);
+    for (i = 0; i < count; i++) {
+        acc[i] = compress_put(codec, &ws, acc[i] + compress_get(codec, &rs));
+    }
+    *outlen = (size_t)(ws.ptr - out);
+    return (size_t)(rs.ptr - in);
+}
@@ -0,0 +1,112 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "coll_compress.h"
+
+/*
+ * Public string showing the coll ompi_compress component version number
+ */
+const char *mca_coll_compress_component_version_string =
+    "Open MPI compress collective MCA component version " OMPI_VERSION;
+
+/*
+ * Local function
+ */
+static int compress_register(void);
+
+/*
+ * Instantiate the public struct with all of our public information
+ * and pointers to our public functions in it
+ */
+
+mca_coll_compress_component_t mca_coll_compress_component = {
+    {
+        /* First, the mca_component_t struct containing meta information
+         * about the component itself */
+
+        .collm_version = {
+            MCA_COLL_BASE_VERSION_2_4_0,
+
+            /* Component name and version */
+            .mca_component_name = "compress",
+            MCA_BASE_MAKE_VERSION(component, OMPI_MAJOR_VERSION, OMPI_MINOR_VERSION,
+                                  OMPI_RELEASE_VERSION),
+
+            /* Component open and close functions */
+            .mca_register_component_params = compress_register,
+        },
+        .collm_data = {
+            /* The component is checkpoint ready */
+            MCA_BASE_METADATA_PARAM_CHECKPOINT
+        },
+
+        /* Initialization / querying functions */
+
+        .collm_init_query = mca_coll_compress_init_query,
+        .collm_comm_query = mca_coll_compress_comm_query,
+    },
+
+    /* compress-specific component information */
+
+    /* Priority: above the point to point collectives it forwards to, below
+     * cuda so that it only sees host buffers */
+    .priority = 77,
+    .error_bound = 1e-4,
+    .min_bytes = 64 * 1024,
+};
+
+
+static int compress_register(void)
+{
+    mca_base_component_t *c = &mca_coll_compress_component.super.collm_version;
+
+    (void) mca_base_component_var_register(c, "priority",
+                                           "Priority of the compress coll component; only relevant on the "
+                                           "communicators that use a compressed wire format",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_compress_component.priority);
+
+    mca_coll_compress_component.mode = "none";
+    (void) mca_base_component_var_register(c, "mode",
+                                           "Wire format of MPI_Allreduce (MPI_SUM) and MPI_Allgather on MPI_FLOAT "
+                                           "buffers for the communicators without the ompi_comm_coll_compress info "
+                                           "key: none, lossless, bf16 (lossy) or quantize (lossy, see error_bound)",
+                                           MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_compress_component.mode);
+
+    (void) mca_base_component_var_register(c, "error_bound",
+                                           "Largest absolute error added on each hop by the quantize mode, "
+                                           "when the communicator has no ompi_comm_coll_compress_error_bound "
+                                           "info key",
+                                           MCA_BASE_VAR_TYPE_DOUBLE, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_compress_component.error_bound);
+
+    (void) mca_base_component_var_register(c, "min_bytes",
+                                           "Payloads smaller than this many bytes are forwarded uncompressed "
+                                           "to the underlying collectives",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_compress_component.min_bytes);
+
+    return OMPI_SUCCESS;
+}
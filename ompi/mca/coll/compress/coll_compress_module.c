@@ -0,0 +1,203 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "mpi.h"
+
+#include "opal/util/output.h"
+#include "opal/util/info.h"
+
+#include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/mca/coll/base/base.h"
+#include "coll_compress.h"
+
+
+static void mca_coll_compress_module_construct(mca_coll_compress_module_t *module)
+{
+    memset(&(module->c_coll), 0, sizeof(module->c_coll));
+    module->codec.mode = MCA_COLL_COMPRESS_NONE;
+    module->codec.step = module->codec.inv_step = 0.0;
+}
+
+static void mca_coll_compress_module_destruct(mca_coll_compress_module_t *module)
+{
+    if (NULL != module->c_coll.coll_allreduce_module) {
+        OBJ_RELEASE(module->c_coll.coll_allreduce_module);
+    }
+    if (NULL != module->c_coll.coll_allgather_module) {
+        OBJ_RELEASE(module->c_coll.coll_allgather_module);
+    }
+}
+
+OBJ_CLASS_INSTANCE(mca_coll_compress_module_t, mca_coll_base_module_t,
+                   mca_coll_compress_module_construct,
+                   mca_coll_compress_module_destruct);
+
+
+/*
+ * Initial query function that is invoked during MPI_INIT, allowing
+ * this component to disqualify itself if it doesn't support the
+ * required level of thread support.
+ */
+int mca_coll_compress_init_query(bool enable_progress_threads,
+                                 bool enable_mpi_threads)
+{
+    /* Nothing to do */
+    return OMPI_SUCCESS;
+}
+
+
+static int compress_mode_from_string(const char *str)
+{
+    if (NULL == str || 0 == strcmp(str, "none") || 0 == strcmp(str, "off")) {
+        return MCA_COLL_COMPRESS_NONE;
+    }
+    if (0 == strcmp(str, "lossless")) {
+        return MCA_COLL_COMPRESS_LOSSLESS;
+    }
+    if (0 == strcmp(str, "bf16")) {
+        return MCA_COLL_COMPRESS_BF16;
+    }
+    if (0 == strcmp(str, "quantize")) {
+        return MCA_COLL_COMPRESS_QUANTIZE;
+    }
+    return -1;
+}
+
+/*
+ * The info keys of the communicator override the MCA parameters
+ */
+static void compress_comm_codec(struct ompi_communicator_t *comm,
+                                mca_coll_compress_codec_t *codec)
+{
+    double error_bound = mca_coll_compress_component.error_bound;
+    const char *mode_str = mca_coll_compress_component.mode;
+    opal_cstring_t *info_str = NULL;
+    int mode, flag;
+
+    if (NULL != comm->super.s_info) {
+        opal_info_get(comm->super.s_info, "ompi_comm_coll_compress",
+                      &info_str, &flag);
+        if (flag) {
+            mode_str = info_str->string;
+        }
+    }
+    mode = compress_mode_from_string(mode_str);
+    if (mode < 0) {
+        opal_output_verbose(1, ompi_coll_base_framework.framework_output,
+                            "coll:compress:comm_query (%d/%s): unknown wire format %s, using none",
+                            comm->c_contextid, comm->c_name, mode_str);
+        mode = MCA_COLL_COMPRESS_NONE;
+    }
+    if (NULL != info_str) {
+        OBJ_RELEASE(info_str);
+    }
+
+    if (MCA_COLL_COMPRESS_QUANTIZE == mode) {
+        if (NULL != comm->super.s_info) {
+            opal_info_get(comm->super.s_info, "ompi_comm_coll_compress_error_bound",
+                          &info_str, &flag);
+            if (flag) {
+                error_bound = strtod(info_str->string, NULL);
+                OBJ_RELEASE(info_str);
+            }
+        }
+        if (!(error_bound > 0.0)) {
+            opal_output_verbose(1, ompi_coll_base_framework.framework_output,
+                                "coll:compress:comm_query (%d/%s): the quantize mode requires a positive error bound",
+                                comm->c_contextid, comm->c_name);
+            mode = MCA_COLL_COMPRESS_NONE;
+        } else {
+            codec->step = 2.0 * error_bound;
+            codec->inv_step = 1.0 / codec->step;
+        }
+    }
+    codec->mode = (mca_coll_compress_mode_t)mode;
+}
+
+
+/*
+ * Invoked when there's a new communicator that has been created.
+ * Look at the communicator and decide which set of functions and
+ * priority we want to return.
+ */
+mca_coll_base_module_t *
+mca_coll_compress_comm_query(struct ompi_communicator_t *comm,
+                             int *priority)
+{
+    mca_coll_compress_module_t *compress_module;
+    mca_coll_compress_codec_t codec;
+
+    if (OMPI_COMM_IS_INTER(comm) || 1 == ompi_comm_size(comm)) {
+        return NULL;
+    }
+
+    compress_comm_codec(comm, &codec);
+    if (MCA_COLL_COMPRESS_NONE == codec.mode) {
+        return NULL;
+    }
+
+    compress_module = OBJ_NEW(mca_coll_compress_module_t);
+    if (NULL == compress_module) {
+        return NULL;
+    }
+    compress_module->codec = codec;
+
+    *priority = mca_coll_compress_component.priority;
+
+    compress_module->super.coll_module_enable = mca_coll_compress_module_enable;
+
+    compress_module->super.coll_allgather  = mca_coll_compress_allgather;
+    compress_module->super.coll_allreduce  = mca_coll_compress_allreduce;
+
+    return &(compress_module->super);
+}
+
+
+/*
+ * Init module on the communicator
+ */
+int mca_coll_compress_module_enable(mca_coll_base_module_t *module,
+                                    struct ompi_communicator_t *comm)
+{
+    bool good = true;
+    char *msg = NULL;
+    mca_coll_compress_module_t *s = (mca_coll_compress_module_t*) module;
+
+#define CHECK_AND_RETAIN(src, dst, name)                                                   \
+    if (NULL == (src)->c_coll->coll_ ## name ## _module) {                                 \
+        good = false;                                                                      \
+        msg = #name;                                                                       \
+    } else if (good) {                                                                     \
+        (dst)->c_coll.coll_ ## name ## _module = (src)->c_coll->coll_ ## name ## _module;  \
+        (dst)->c_coll.coll_ ## name = (src)->c_coll->coll_ ## name;                        \
+        OBJ_RETAIN((src)->c_coll->coll_ ## name ## _module);                               \
+    }
+
+    CHECK_AND_RETAIN(comm, s, allreduce);
+    CHECK_AND_RETAIN(comm, s, allgather);
+
+    /* All done */
+    if (good) {
+        return OMPI_SUCCESS;
+    }
+    opal_output_verbose(1, ompi_coll_base_framework.framework_output,
+                        "coll:compress:module_enable (%d/%s): no underlying %s",
+                        comm->c_contextid, comm->c_name, msg);
+    return OMPI_ERR_NOT_FOUND;
+}
@@ -71,6 +71,18 @@ mca_coll_cuda_reduce_scatter_block(const void *sbuf, void *rbuf, int rcount,
                                    struct ompi_communicator_t *comm,
                                    mca_coll_base_module_t *module);
 
+bool mca_coll_cuda_use_pipeline(struct mca_coll_cuda_module_t *s, int count,
+                                struct ompi_datatype_t *dtype,
+                                struct ompi_communicator_t *comm, bool all);
+
+int mca_coll_cuda_pipeline_reduce(const void *sbuf, void *rbuf, int count,
+                                  struct ompi_datatype_t *dtype,
+                                  struct ompi_op_t *op, int root,
+                                  struct ompi_communicator_t *comm,
+                                  struct mca_coll_cuda_module_t *s);
+
+void mca_coll_cuda_stage_release(struct mca_coll_cuda_module_t *s);
+
 /* Types */
 /* Module */
 
@@ -79,6 +91,10 @@ typedef struct mca_coll_cuda_module_t {
 
     /* Pointers to all the "real" collective functions */
     mca_coll_base_comm_coll_t c_coll;
+
+    /* Pinned host buffer of the segmented reductions */
+    char *stage;
+    size_t stage_size;
 } mca_coll_cuda_module_t;
 
 OBJ_CLASS_DECLARATION(mca_coll_cuda_module_t);
@@ -90,6 +106,7 @@ typedef struct mca_coll_cuda_component_t {
 
     int priority; /* Priority of this component */
     int disable_cuda_coll;  /* Force disable of the CUDA collective component */
+    size_t pipeline_segment_size; /* Segment of the pipelined reductions, 0 to disable */
 } mca_coll_cuda_component_t;
 
 /* Globally exported variables */
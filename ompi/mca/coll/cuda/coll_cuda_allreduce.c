@@ -39,6 +39,10 @@ mca_coll_cuda_allreduce(const void *sbuf, void *rbuf, int count,
     size_t bufsize;
     int rc;
 
+    if (mca_coll_cuda_use_pipeline(s, count, dtype, comm, true)) {
+        return mca_coll_cuda_pipeline_reduce(sbuf, rbuf, count, dtype, op, -1, comm, s);
+    }
+
     bufsize = opal_datatype_span(&dtype->super, count, &gap);
 
     if ((MPI_IN_PLACE != sbuf) && (opal_cuda_check_bufs((char *)sbuf, NULL))) {
@@ -67,7 +67,8 @@ mca_coll_cuda_component_t mca_coll_cuda_component = {
     /* cuda-specific component information */
 
     /* Priority: make it above all point to point collectives including self */
-    78,
+    .priority = 78,
+    .pipeline_segment_size = 1 << 20,
 };
 
 
@@ -87,5 +88,16 @@ static int cuda_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_coll_cuda_component.disable_cuda_coll);
 
+    (void) mca_base_component_var_register(&mca_coll_cuda_component.super.collm_version,
+                                           "pipeline_segment_size",
+                                           "Size in bytes of the segments the reductions (MPI_Reduce and MPI_Allreduce) of "
+                                           "contiguous buffers larger than twice this value are cut in, so that the copies "
+                                           "between device and host overlap with the reduction of the previous segment "
+                                           "(0 to stage the whole buffer at once)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_cuda_component.pipeline_segment_size);
+
     return OMPI_SUCCESS;
 }
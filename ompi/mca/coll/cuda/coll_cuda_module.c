@@ -34,6 +34,8 @@
 static void mca_coll_cuda_module_construct(mca_coll_cuda_module_t *module)
 {
     memset(&(module->c_coll), 0, sizeof(module->c_coll));
+    module->stage = NULL;
+    module->stage_size = 0;
 }
 
 static void mca_coll_cuda_module_destruct(mca_coll_cuda_module_t *module)
@@ -49,6 +51,13 @@ static void mca_coll_cuda_module_destruct(mca_coll_cuda_module_t *module)
         OBJ_RELEASE(module->c_coll.coll_exscan_module);
         OBJ_RELEASE(module->c_coll.coll_scan_module);
     }
+    if (NULL != module->c_coll.coll_iallreduce_module) {
+        OBJ_RELEASE(module->c_coll.coll_iallreduce_module);
+    }
+    if (NULL != module->c_coll.coll_ireduce_module) {
+        OBJ_RELEASE(module->c_coll.coll_ireduce_module);
+    }
+    mca_coll_cuda_stage_release(module);
 }
 
 OBJ_CLASS_INSTANCE(mca_coll_cuda_module_t, mca_coll_base_module_t,
@@ -143,6 +152,17 @@ int mca_coll_cuda_module_enable(mca_coll_base_module_t *module,
         CHECK_AND_RETAIN(comm, s, scan);
     }
 
+    /* Only used by the pipelined reductions, which are skipped without them */
+#define RETAIN_IF_AVAILABLE(src, dst, name)                                                \
+    if (good && NULL != (src)->c_coll->coll_ ## name ## _module) {                         \
+        (dst)->c_coll.coll_ ## name ## _module = (src)->c_coll->coll_ ## name ## _module;  \
+        (dst)->c_coll.coll_ ## name = (src)->c_coll->coll_ ## name;                        \
+        OBJ_RETAIN((src)->c_coll->coll_ ## name ## _module);                               \
+    }
+
+    RETAIN_IF_AVAILABLE(comm, s, iallreduce);
+    RETAIN_IF_AVAILABLE(comm, s, ireduce);
+
     /* All done */
     if (good) {
         return OMPI_SUCCESS;
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "coll_cuda.h"
+
+#include <stdlib.h>
+
+#include "ompi/op/op.h"
+#include "ompi/request/request.h"
+#include "opal/datatype/opal_convertor.h"
+#include "opal/mca/common/cuda/common_cuda.h"
+
+/*
+ * Segmented reductions of large buffers.
+ *
+ * Instead of one full copy to the host, the whole host collective and one
+ * full copy back, the buffer is cut in segments of
+ * coll_cuda_pipeline_segment_size bytes. Each segment is reduced with the
+ * non-blocking collective of the underlying module, and the copy of the
+ * next segment from the device (resp. the copy of the previous one back
+ * to the device) overlaps with the reduction of the current one. The host
+ * buffer is pinned and kept on the module between calls.
+ *
+ * The decision only depends on the signature of the reduction, never on
+ * where the buffers are, so all processes segment the same way. The ones
+ * with host buffers reduce them in place of the staging buffer.
+ */
+
+static char mca_coll_cuda_stage_msg[] = "coll/cuda staging buffer";
+
+static char *mca_coll_cuda_stage(mca_coll_cuda_module_t *s, size_t size)
+{
+    if (size <= s->stage_size) {
+        return s->stage;
+    }
+
+    if (NULL != s->stage) {
+        mca_common_cuda_unregister(s->stage, mca_coll_cuda_stage_msg);
+        free(s->stage);
+        s->stage_size = 0;
+    }
+
+    s->stage = (char *) malloc(size);
+    if (NULL == s->stage) {
+        return NULL;
+    }
+    mca_common_cuda_register(s->stage, size, mca_coll_cuda_stage_msg);
+    s->stage_size = size;
+
+    return s->stage;
+}
+
+void mca_coll_cuda_stage_release(mca_coll_cuda_module_t *s)
+{
+    if (NULL != s->stage) {
+        mca_common_cuda_unregister(s->stage, mca_coll_cuda_stage_msg);
+        free(s->stage);
+        s->stage = NULL;
+        s->stage_size = 0;
+    }
+}
+
+bool mca_coll_cuda_use_pipeline(mca_coll_cuda_module_t *s, int count,
+                                struct ompi_datatype_t *dtype,
+                                struct ompi_communicator_t *comm, bool all)
+{
+    size_t dsize;
+
+    if (0 == mca_coll_cuda_component.pipeline_segment_size || OMPI_COMM_IS_INTER(comm)
+        || NULL == (all ? (void *) s->c_coll.coll_iallreduce : (void *) s->c_coll.coll_ireduce)) {
+        return false;
+    }
+
+    ompi_datatype_type_size(dtype, &dsize);
+    if ((size_t) count * dsize <= 2 * mca_coll_cuda_component.pipeline_segment_size) {
+        return false;
+    }
+
+    return ompi_datatype_is_contiguous_memory_layout(dtype, count);
+}
+
+/* reduction of one segment, root < 0 for an allreduce */
+static int mca_coll_cuda_segment_start(mca_coll_cuda_module_t *s, const void *sbuf, void *rbuf,
+                                        int count, struct ompi_datatype_t *dtype,
+                                        struct ompi_op_t *op, int root,
+                                        struct ompi_communicator_t *comm, ompi_request_t **req)
+{
+    if (root < 0) {
+        return s->c_coll.coll_iallreduce(sbuf, rbuf, count, dtype, op, comm, req,
+                                         s->c_coll.coll_iallreduce_module);
+    }
+    return s->c_coll.coll_ireduce(sbuf, rbuf, count, dtype, op, root, comm, req,
+                                  s->c_coll.coll_ireduce_module);
+}
+
+int mca_coll_cuda_pipeline_reduce(const void *sbuf, void *rbuf, int count,
+                                  struct ompi_datatype_t *dtype,
+                                  struct ompi_op_t *op, int root,
+                                  struct ompi_communicator_t *comm,
+                                  mca_coll_cuda_module_t *s)
+{
+    const bool result = (root < 0) || (ompi_comm_rank(comm) == root);
+    ompi_request_t *reqs[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+    const char *src = (MPI_IN_PLACE == sbuf) ? (const char *) rbuf : (const char *) sbuf;
+    char *host = NULL;
+    size_t dsize;
+    ptrdiff_t lb, extent;
+    int seg, nseg, rc = OMPI_SUCCESS;
+
+    ompi_datatype_type_size(dtype, &dsize);
+    ompi_datatype_get_extent(dtype, &lb, &extent);
+
+    seg = (int) (mca_coll_cuda_component.pipeline_segment_size / dsize);
+    if (0 == seg) {
+        seg = 1;
+    }
+    nseg = (count + seg - 1) / seg;
+
+    if (opal_cuda_check_bufs((char *) src, NULL) || (result && opal_cuda_check_bufs(rbuf, NULL))) {
+        host = mca_coll_cuda_stage(s, (size_t) count * extent);
+        if (NULL == host) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        host -= lb;
+    }
+
+    for (int i = 0; i <= nseg; ++i) {
+        if (i < nseg) {
+            ptrdiff_t off = (ptrdiff_t) i * seg * extent;
+            int n = (count - i * seg < seg) ? count - i * seg : seg;
+
+            if (NULL != host) {
+                opal_cuda_memcpy_sync(host + lb + off, src + lb + off, (size_t) n * extent);
+                rc = mca_coll_cuda_segment_start(s, result ? MPI_IN_PLACE : host + off,
+                                                 result ? host + off : NULL, n, dtype, op, root,
+                                                 comm, &reqs[i % 2]);
+            } else {
+                rc = mca_coll_cuda_segment_start(s, (MPI_IN_PLACE == sbuf) ? MPI_IN_PLACE : src + off,
+                                                 result ? (char *) rbuf + off : NULL, n, dtype, op,
+                                                 root, comm, &reqs[i % 2]);
+            }
+            if (OMPI_SUCCESS != rc) {
+                break;
+            }
+        }
+
+        if (i > 0) {
+            ptrdiff_t off = (ptrdiff_t) (i - 1) * seg * extent;
+            int n = (count - (i - 1) * seg < seg) ? count - (i - 1) * seg : seg;
+
+            rc = ompi_request_wait(&reqs[(i - 1) % 2], MPI_STATUS_IGNORE);
+            if (OMPI_SUCCESS != rc) {
+                break;
+            }
+            if (NULL != host && result) {
+                opal_cuda_memcpy_sync((char *) rbuf + lb + off, host + lb + off, (size_t) n * extent);
+            }
+        }
+    }
+
+    if (OMPI_SUCCESS != rc) {
+        /* let the segment still in flight complete before giving the buffer back */
+        (void) ompi_request_wait_all(2, reqs, MPI_STATUSES_IGNORE);
+    }
+
+    return rc;
+}
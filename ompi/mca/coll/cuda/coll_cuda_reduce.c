@@ -40,6 +40,10 @@ mca_coll_cuda_reduce(const void *sbuf, void *rbuf, int count,
     size_t bufsize;
     int rc;
 
+    if (mca_coll_cuda_use_pipeline(s, count, dtype, comm, false)) {
+        return mca_coll_cuda_pipeline_reduce(sbuf, rbuf, count, dtype, op, root, comm, s);
+    }
+
     bufsize = opal_datatype_span(&dtype->super, count, &gap);
 
 
@@ -45,6 +45,7 @@ typedef enum mca_coll_ftagree_algorithm_t mca_coll_ftagree_algorithm_t;
 
 extern mca_coll_ftagree_algorithm_t mca_coll_ftagree_algorithm;
 extern int mca_coll_ftagree_era_rebuild;
+extern int mca_coll_ftagree_era_optimistic;
 
 /* Define this to enable testing random failures in various
  * places in Agree. This can be used to harden the agreement 
@@ -68,6 +69,11 @@ struct mca_coll_ftagree_t {
 
     /* Agreement Sequence Number */
     int agreement_seq_num;
+
+    /* A nonblocking agreement was started on the communicator: the
+     * failure-free path of ERA is not used anymore, as the agreements
+     * may not complete in the same order everywhere */
+    bool era_nonblocking;
 };
 typedef struct mca_coll_ftagree_t mca_coll_ftagree_t;
 OBJ_CLASS_DECLARATION(mca_coll_ftagree_t);
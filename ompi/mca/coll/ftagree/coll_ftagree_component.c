@@ -34,6 +34,7 @@ int mca_coll_ftagree_priority  = 0;
 mca_coll_ftagree_algorithm_t mca_coll_ftagree_algorithm = COLL_FTAGREE_EARLY_RETURNING;
 int mca_coll_ftagree_cur_era_topology = 1;
 int mca_coll_ftagree_era_rebuild = 0;
+int mca_coll_ftagree_era_optimistic = 1;
 #if defined(FTAGREE_DEBUG_FAILURE_INJECT)
 double mca_coll_ftagree_debug_inject_proba = 0.0;
 #endif
@@ -148,6 +149,14 @@ ftagree_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_coll_ftagree_era_rebuild);
 
+    mca_coll_ftagree_era_optimistic = 1;
+    (void) mca_base_component_var_register(&mca_coll_ftagree_component.collm_version,
+                                           "era_optimistic", "ERA runs blocking agreements as a plain reduction and broadcast over a binary tree while no failure is known on the communicator, and falls back to the full protocol if a failure is detected during the operation 0: always use the full protocol; 1: use the failure-free path when possible",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_ftagree_era_optimistic);
+
 #if defined(FTAGREE_DEBUG_FAILURE_INJECT)
     mca_coll_ftagree_rank_fault_proba = 0.0; /* by default, inject no faults */
     (void) mca_base_component_var_register(&mca_coll_ftagree_component.collm_version,
@@ -23,6 +23,7 @@
 #include "ompi/mca/bml/bml.h"
 #include "ompi/op/op.h"
 #include "ompi/mca/bml/base/base.h"
+#include "ompi/mca/pml/pml.h"
 
 #include "coll_ftagree.h"
 #include "coll_ftagree_era.h"
@@ -942,6 +943,7 @@ int mca_coll_ftagree_era_comm_init(ompi_communicator_t *comm, mca_coll_ftagree_m
 
     comm_ag_info = OBJ_NEW(mca_coll_ftagree_t);
     comm_ag_info->agreement_seq_num = 0;
+    comm_ag_info->era_nonblocking = false;
 
     module->agreement_info = comm_ag_info;
 
@@ -3161,6 +3163,330 @@ static int mca_coll_ftagree_era_complete_agreement(era_identifier_t agreement_id
     return ret;
 }
 
+/*
+ * Failure-free path of the blocking agreement (coll_ftagree_era_optimistic).
+ *
+ * As long as no failure has been agreed upon on the communicator, an
+ * agreement is nothing more than a reduction of the contributions on a
+ * binary tree followed by a broadcast of the result. This is done with
+ * point-to-point messages on the (revoke-exempt) agreement tag, under the
+ * agreement identifier the full protocol would use. Any process that knows
+ * of a failure, acknowledged a failure, or detects one during the operation
+ * floods an ABORT message on the tree; everybody then drains its
+ * communications and runs the full protocol on the same identifier.
+ * Because each process records the decision in era_passed_agreements, as
+ * era_decide does, processes that decided before the ABORT answer the full
+ * protocol of the others with that same decision.
+ *
+ * Each edge of the tree carries exactly one message in each direction: UP
+ * or ABORT from the child, DOWN or ABORT from the parent (a process that
+ * already sent UP has nothing to say to its parent anymore). Draining the
+ * communications after an ABORT thus never leaves a stray message behind
+ * for the next agreement.
+ */
+typedef enum {
+    ERA_FAST_UP = 1,
+    ERA_FAST_DOWN,
+    ERA_FAST_ABORT
+} era_fast_msg_type_t;
+
+typedef struct {
+    era_identifier_t agreement_id;
+    int32_t          type;
+    int32_t          ret;
+    uint16_t         min_aid;
+    uint16_t         max_aid;
+    uint32_t         padding;
+} era_fast_msg_header_t;
+
+/* Requests of the failure-free path: the receptions from the parent and the
+ * children, then the sends to the parent and to the children */
+#define ERA_FAST_RECV_PARENT 0
+#define ERA_FAST_RECV_CHILD  1
+#define ERA_FAST_SEND_PARENT 3
+#define ERA_FAST_SEND_CHILD  4
+#define ERA_FAST_NB_REQS     6
+
+static int era_fast_wait_any(ompi_request_t **reqs, int first, int last, int *rc)
+{
+    int i;
+
+    for(;;) {
+        for(i = first; i < last; i++) {
+            if( MPI_REQUEST_NULL == reqs[i] ) {
+                continue;
+            }
+            /* completes the request in error if the peer is known dead */
+            (void)ompi_request_is_failed(reqs[i]);
+            if( REQUEST_COMPLETE(reqs[i]) ) {
+                *rc = reqs[i]->req_status.MPI_ERROR;
+                ompi_request_free(&reqs[i]);
+                return i;
+            }
+        }
+        opal_progress();
+    }
+}
+
+static int era_fast_send(ompi_communicator_t *comm, int dst, void *buf, size_t size,
+                         ompi_request_t **req)
+{
+    return MCA_PML_CALL(isend(buf, size, MPI_BYTE, dst, ERA_TAG_AGREEMENT,
+                              MCA_PML_BASE_SEND_STANDARD, comm, req));
+}
+
+/**
+ * Returns OMPI_SUCCESS if the agreement was decided on the failure-free path,
+ * in which case *ret is its return code; OMPI_ERR_PROC_FAILED if the full
+ * protocol must be used instead.
+ */
+static int era_fast_agreement(void *contrib,
+                              int dt_count,
+                              ompi_datatype_t *dt,
+                              ompi_op_t *op,
+                              ompi_group_t **group, bool grp_update,
+                              ompi_communicator_t* comm,
+                              mca_coll_base_module_t *module,
+                              int *ret)
+{
+    ompi_request_t *reqs[ERA_FAST_NB_REQS];
+    era_fast_msg_header_t *hdr, *mine;
+    era_agreement_info_t *ci;
+    era_identifier_t agreement_id;
+    era_value_t agreement_value, *av;
+    era_rank_item_t *rl;
+    mca_coll_ftagree_t *ag_info;
+    int rank, size, parent, children[2], nb_children, nb_up, i, rc, idx;
+    size_t value_bytes, msg_size;
+    bool abort_sent = false, up_sent = false;
+    uint8_t *buffers;
+    void *value;
+
+    ag_info = ( (mca_coll_ftagree_module_t *)module )->agreement_info;
+    rank = ompi_comm_rank(comm);
+    size = ompi_comm_size(comm);
+
+    parent = (0 == rank) ? -1 : (rank - 1) / 2;
+    nb_children = 0;
+    for(i = 1; i <= 2; i++) {
+        if( 2 * rank + i < size ) {
+            children[nb_children++] = 2 * rank + i;
+        }
+    }
+
+    value_bytes = dt->super.size * dt_count;
+    msg_size = sizeof(era_fast_msg_header_t) + value_bytes;
+    /* one buffer per reception, then the accumulated value sent to the parent
+     * and the decision sent to the children */
+    buffers = (uint8_t*)malloc(5 * msg_size);
+    if( NULL == buffers ) {
+        return OMPI_ERR_PROC_FAILED;
+    }
+    mine = (era_fast_msg_header_t*)(buffers + 3 * msg_size);
+
+    opal_mutex_lock(&era_mutex);
+
+    /* Same numbering as mca_coll_ftagree_era_prepare_agreement */
+    if( ag_info->agreement_seq_num == UINT16_MAX ) {
+        ag_info->agreement_seq_num = 1;
+    } else {
+        ag_info->agreement_seq_num++;
+    }
+    agreement_id.ERAID_FIELDS.contextid   = comm->c_contextid;
+    agreement_id.ERAID_FIELDS.epoch       = comm->c_epoch;
+    agreement_id.ERAID_FIELDS.agreementid = (uint16_t)ag_info->agreement_seq_num;
+
+    OBJ_CONSTRUCT(&agreement_value, era_value_t);
+    era_agreement_value_set_gcrange(agreement_id, &agreement_value);
+
+    opal_mutex_unlock(&era_mutex);
+
+    OPAL_OUTPUT_VERBOSE((3, ompi_ftmpi_output_handle,
+                         "%s ftagree:agreement (ERA) Entering failure-free path of Agreement ID = (%d.%d).%d\n",
+                         OMPI_NAME_PRINT(OMPI_PROC_MY_NAME),
+                         agreement_id.ERAID_FIELDS.contextid,
+                         agreement_id.ERAID_FIELDS.epoch,
+                         agreement_id.ERAID_FIELDS.agreementid));
+
+    mine->agreement_id = agreement_id;
+    mine->type    = ERA_FAST_UP;
+    mine->ret     = MPI_SUCCESS;
+    mine->min_aid = agreement_value.header.min_aid;
+    mine->max_aid = agreement_value.header.max_aid;
+    mine->padding = 0;
+    memcpy(mine + 1, contrib, value_bytes);
+    OBJ_DESTRUCT(&agreement_value);
+
+    for(i = 0; i < ERA_FAST_NB_REQS; i++) {
+        reqs[i] = MPI_REQUEST_NULL;
+    }
+
+    if( -1 != parent ) {
+        rc = MCA_PML_CALL(irecv(buffers, msg_size, MPI_BYTE, parent, ERA_TAG_AGREEMENT,
+                                comm, &reqs[ERA_FAST_RECV_PARENT]));
+        if( OMPI_SUCCESS != rc ) goto abort;
+    }
+    for(i = 0; i < nb_children; i++) {
+        rc = MCA_PML_CALL(irecv(buffers + (1 + i) * msg_size, msg_size, MPI_BYTE, children[i],
+                                ERA_TAG_AGREEMENT, comm, &reqs[ERA_FAST_RECV_CHILD + i]));
+        if( OMPI_SUCCESS != rc ) goto abort;
+    }
+
+    /* A process that knows of a failure cannot contribute on this path. The
+     * receptions are posted anyway, for the answers to its ABORT */
+    if( ompi_group_size(*group) > 0 || ompi_group_size(ompi_group_all_failed_procs) > 0 ) {
+        goto abort;
+    }
+
+    /* Reduction of the contributions of the children */
+    for(nb_up = 0; nb_up < nb_children; nb_up++) {
+        idx = era_fast_wait_any(reqs, ERA_FAST_RECV_PARENT, ERA_FAST_RECV_CHILD + nb_children, &rc);
+        if( MPI_SUCCESS != rc || ERA_FAST_RECV_PARENT == idx ) {
+            /* the parent only talks now to abort */
+            goto abort;
+        }
+        hdr = (era_fast_msg_header_t*)(buffers + idx * msg_size);
+        assert(hdr->agreement_id.ERAID_KEY == agreement_id.ERAID_KEY);
+        if( ERA_FAST_UP != hdr->type ) {
+            goto abort;
+        }
+        if( value_bytes > 0 ) {
+            ompi_op_reduce(op, hdr + 1, mine + 1, dt_count, dt);
+        }
+        if( hdr->ret > mine->ret ) mine->ret = hdr->ret;
+        if( hdr->min_aid > mine->min_aid ) mine->min_aid = hdr->min_aid;
+        if( hdr->max_aid < mine->max_aid ) mine->max_aid = hdr->max_aid;
+    }
+
+    if( -1 != parent ) {
+        rc = era_fast_send(comm, parent, mine, msg_size, &reqs[ERA_FAST_SEND_PARENT]);
+        if( OMPI_SUCCESS != rc ) goto abort;
+        up_sent = true;
+
+        idx = era_fast_wait_any(reqs, ERA_FAST_RECV_PARENT, ERA_FAST_RECV_PARENT + 1, &rc);
+        hdr = (era_fast_msg_header_t*)buffers;
+        if( MPI_SUCCESS != rc || ERA_FAST_DOWN != hdr->type ) {
+            goto abort;
+        }
+        assert(hdr->agreement_id.ERAID_KEY == agreement_id.ERAID_KEY);
+        memcpy(mine, hdr, msg_size);
+    }
+
+    /* Decided */
+    mine->type = ERA_FAST_DOWN;
+    for(i = 0; i < nb_children; i++) {
+        /* a child that died before receiving the decision obtains it from
+         * era_passed_agreements through the full protocol */
+        (void)era_fast_send(comm, children[i], mine, msg_size, &reqs[ERA_FAST_SEND_CHILD + i]);
+    }
+
+    opal_mutex_lock(&era_mutex);
+
+    if( opal_hash_table_get_value_uint64(&era_passed_agreements, agreement_id.ERAID_KEY, &value) == OMPI_SUCCESS ) {
+        opal_output(0, "*** WARNING *** %s ftagree:agreement (ERA) removing old agreement (%d.%d).%d from history, due to cycling of identifiers\n",
+                    OMPI_NAME_PRINT(OMPI_PROC_MY_NAME),
+                    agreement_id.ERAID_FIELDS.contextid,
+                    agreement_id.ERAID_FIELDS.epoch,
+                    agreement_id.ERAID_FIELDS.agreementid);
+        opal_hash_table_remove_value_uint64(&era_passed_agreements, agreement_id.ERAID_KEY);
+        OBJ_RELEASE((era_value_t*)value);
+    }
+
+    av = OBJ_NEW(era_value_t);
+    av->header.ret         = mine->ret;
+    av->header.min_aid     = mine->min_aid;
+    av->header.max_aid     = mine->max_aid;
+    av->header.operand     = op->o_f_to_c_index;
+    av->header.dt_count    = dt_count;
+    av->header.datatype    = dt->d_f_to_c_index;
+    av->header.nb_new_dead = 0;
+    if( value_bytes > 0 ) {
+        av->bytes = (uint8_t*)malloc(value_bytes);
+        memcpy(av->bytes, mine + 1, value_bytes);
+    }
+    opal_hash_table_set_value_uint64(&era_passed_agreements, agreement_id.ERAID_KEY, av);
+
+    /* Processes that already fell back to the full protocol may have
+     * contacted us: give them the decision */
+    ci = era_lookup_agreement_info(agreement_id);
+    if( NULL != ci ) {
+        for(rl = (era_rank_item_t*)opal_list_get_first(&ci->gathered_info);
+            rl != (era_rank_item_t*)opal_list_get_end(&ci->gathered_info);
+            rl = (era_rank_item_t*)opal_list_get_next(&rl->super)) {
+            send_msg(comm, rl->rank, NULL, agreement_id, MSG_DOWN, av, 0, NULL);
+        }
+        for(rl = (era_rank_item_t*)opal_list_get_first(&ci->early_requesters);
+            rl != (era_rank_item_t*)opal_list_get_end(&ci->early_requesters);
+            rl = (era_rank_item_t*)opal_list_get_next(&rl->super)) {
+            send_msg(comm, rl->rank, NULL, agreement_id, MSG_DOWN, av, 0, NULL);
+        }
+        opal_hash_table_remove_value_uint64(&era_ongoing_agreements, agreement_id.ERAID_KEY);
+        OBJ_RELEASE(ci);
+    }
+
+    era_collect_passed_agreements(agreement_id, av->header.min_aid, av->header.max_aid);
+
+    opal_mutex_unlock(&era_mutex);
+
+    memcpy(contrib, mine + 1, value_bytes);
+    *ret = mine->ret;
+
+    if( grp_update ) {
+        OBJ_RELEASE(*group);
+        ompi_group_incl(comm->c_local_group, 0, NULL, group);
+    }
+
+    goto drain;
+
+ abort:
+    OPAL_OUTPUT_VERBOSE((3, ompi_ftmpi_output_handle,
+                         "%s ftagree:agreement (ERA) Leaving failure-free path of Agreement ID = (%d.%d).%d for the full protocol\n",
+                         OMPI_NAME_PRINT(OMPI_PROC_MY_NAME),
+                         agreement_id.ERAID_FIELDS.contextid,
+                         agreement_id.ERAID_FIELDS.epoch,
+                         agreement_id.ERAID_FIELDS.agreementid));
+    abort_sent = true;
+    mine->type = ERA_FAST_ABORT;
+    if( -1 != parent && !up_sent ) {
+        (void)era_fast_send(comm, parent, mine, sizeof(era_fast_msg_header_t), &reqs[ERA_FAST_SEND_PARENT]);
+    }
+    for(i = 0; i < nb_children; i++) {
+        (void)era_fast_send(comm, children[i], mine, sizeof(era_fast_msg_header_t), &reqs[ERA_FAST_SEND_CHILD + i]);
+    }
+
+ drain:
+    /* Every posted reception is matched by the single message of the peer
+     * (that the ABORT triggers if needed), or completes in error if the peer
+     * dies. */
+    for(i = 0; i < ERA_FAST_NB_REQS; i++) {
+        if( MPI_REQUEST_NULL != reqs[i] ) {
+            (void)era_fast_wait_any(reqs, i, i + 1, &rc);
+        }
+    }
+    free(buffers);
+
+    if( abort_sent ) {
+        /* The full protocol reuses that same identifier */
+        opal_mutex_lock(&era_mutex);
+        if( 1 == ag_info->agreement_seq_num ) {
+            ag_info->agreement_seq_num = UINT16_MAX;
+        } else {
+            ag_info->agreement_seq_num--;
+        }
+        opal_mutex_unlock(&era_mutex);
+        return OMPI_ERR_PROC_FAILED;
+    }
+
+    OPAL_OUTPUT_VERBOSE((3, ompi_ftmpi_output_handle,
+                         "%s ftagree:agreement (ERA) Leaving failure-free path of Agreement ID = (%d.%d).%d with ret = %d\n",
+                         OMPI_NAME_PRINT(OMPI_PROC_MY_NAME),
+                         agreement_id.ERAID_FIELDS.contextid,
+                         agreement_id.ERAID_FIELDS.epoch,
+                         agreement_id.ERAID_FIELDS.agreementid,
+                         *ret));
+    return OMPI_SUCCESS;
+}
+
 /*
  * mca_coll_ftagree_era_intra
  *
@@ -3168,18 +3494,39 @@ static int mca_coll_ftagree_era_complete_agreement(era_identifier_t agreement_id
  * Accepts:	- same as MPI_Comm_agree()
  * Returns:	- MPI_SUCCESS or an MPI error code
  */
-int mca_coll_ftagree_era_intra(void *contrib,
-                                         int dt_count,
-                                         ompi_datatype_t *dt,
-                                         ompi_op_t *op,
-                                         ompi_group_t **group, bool grp_update,
-                                         ompi_communicator_t* comm,
-                                         mca_coll_base_module_t *module)
+static int era_iagree_start(void *contrib,
+                            int dt_count,
+                            ompi_datatype_t *dt,
+                            ompi_op_t *op,
+                            ompi_group_t **group, bool grp_update,
+                            ompi_communicator_t* comm,
+                            ompi_request_t **request,
+                            mca_coll_base_module_t *module);
+
+static int era_agree_blocking(void *contrib,
+                              int dt_count,
+                              ompi_datatype_t *dt,
+                              ompi_op_t *op,
+                              ompi_group_t **group, bool grp_update,
+                              ompi_communicator_t* comm,
+                              mca_coll_base_module_t *module,
+                              bool optimistic)
 {
     int rc;
     ompi_request_t* req;
+    mca_coll_ftagree_t *ag_info = ( (mca_coll_ftagree_module_t *)module )->agreement_info;
 
-    rc = mca_coll_ftagree_iera_intra(contrib, dt_count, dt, op, group, grp_update, comm, &req, module);
+    /* The failure-free path requires the same view on all processes: no
+     * agreed failure yet, and agreements that complete in order */
+    if( optimistic && !ag_info->era_nonblocking &&
+        (NULL == AGS(comm) || 0 == AGS(comm)->afr_size) ) {
+        if( OMPI_SUCCESS == era_fast_agreement(contrib, dt_count, dt, op, group, grp_update,
+                                               comm, module, &rc) ) {
+            return rc;
+        }
+    }
+
+    rc = era_iagree_start(contrib, dt_count, dt, op, group, grp_update, comm, &req, module);
     if(OPAL_UNLIKELY( OMPI_SUCCESS != rc ))
         return rc;
     ompi_request_wait_completion(req);
@@ -3188,6 +3535,18 @@ int mca_coll_ftagree_era_intra(void *contrib,
     return rc;
 }
 
+int mca_coll_ftagree_era_intra(void *contrib,
+                                         int dt_count,
+                                         ompi_datatype_t *dt,
+                                         ompi_op_t *op,
+                                         ompi_group_t **group, bool grp_update,
+                                         ompi_communicator_t* comm,
+                                         mca_coll_base_module_t *module)
+{
+    return era_agree_blocking(contrib, dt_count, dt, op, group, grp_update, comm, module,
+                              mca_coll_ftagree_era_optimistic);
+}
+
 /*
  * mca_coll_ftagree_era_inter
  *
@@ -3237,7 +3596,8 @@ int mca_coll_ftagree_era_inter(void *contrib,
     shadowcomm->any_source_offset = comm->any_source_offset;
     shadowcomm->agreement_specific = comm->agreement_specific;
 
-    rc = mca_coll_ftagree_era_intra(contriblh, dt_count*2, dt, op, group, grp_update, shadowcomm, module);
+    /* The shadow communicator is unknown to the PML: no failure-free path */
+    rc = era_agree_blocking(contriblh, dt_count*2, dt, op, group, grp_update, shadowcomm, module, false);
 
     comm->agreement_specific = shadowcomm->agreement_specific;
     if( NULL != comm->agreement_specific ) OBJ_RETAIN(comm->agreement_specific);
@@ -3275,14 +3635,14 @@ static int era_iagree_req_complete_cb(struct ompi_request_t* request)
     return 0;
 }
 
-int mca_coll_ftagree_iera_intra(void *contrib,
-                                          int dt_count,
-                                          ompi_datatype_t *dt,
-                                          ompi_op_t *op,
-                                          ompi_group_t **group, bool grp_update,
-                                          ompi_communicator_t* comm,
-                                          ompi_request_t **request,
-                                          mca_coll_base_module_t *module)
+static int era_iagree_start(void *contrib,
+                            int dt_count,
+                            ompi_datatype_t *dt,
+                            ompi_op_t *op,
+                            ompi_group_t **group, bool grp_update,
+                            ompi_communicator_t* comm,
+                            ompi_request_t **request,
+                            mca_coll_base_module_t *module)
 {
     opal_free_list_item_t* item;
     era_iagree_request_t *req;
@@ -3332,6 +3692,19 @@ int mca_coll_ftagree_iera_intra(void *contrib,
     return OMPI_SUCCESS;
 }
 
+int mca_coll_ftagree_iera_intra(void *contrib,
+                                          int dt_count,
+                                          ompi_datatype_t *dt,
+                                          ompi_op_t *op,
+                                          ompi_group_t **group, bool grp_update,
+                                          ompi_communicator_t* comm,
+                                          ompi_request_t **request,
+                                          mca_coll_base_module_t *module)
+{
+    ( (mca_coll_ftagree_module_t *)module )->agreement_info->era_nonblocking = true;
+    return era_iagree_start(contrib, dt_count, dt, op, group, grp_update, comm, request, module);
+}
+
 #if 0
 // Per @bosilca and @jsquyres discussion 29 Apr 2021: there is
 // probably a memory leak in MPI_FINALIZE right now, because this
@@ -48,6 +48,8 @@
 
 #define COLL_HAN_LOW_MODULES 2
 #define COLL_HAN_UP_MODULES 2
+/* maximum number of node leaders of the inter-node phase */
+#define COLL_HAN_MAX_LEADERS 16
 
 struct mca_coll_han_bcast_args_s {
     mca_coll_task_t *cur_task;
@@ -169,6 +171,43 @@ struct mca_coll_han_allgather_s {
 };
 typedef struct mca_coll_han_allgather_s mca_coll_han_allgather_t;
 
+struct mca_coll_han_reduce_scatter_args_s {
+    mca_coll_task_t *cur_task;
+    ompi_communicator_t *up_comm;
+    ompi_communicator_t *low_comm;
+    void *sbuf;
+    void *rbuf;
+    ompi_op_t *op;
+    ompi_datatype_t *dtype;
+    const int *rcounts;
+    int *displs;
+    int *topo;
+    /* intermediary buffers and their allocated memory */
+    char *pack_buf;
+    char *pack_buf_free;
+    char *acc_buf[2];
+    char *acc_buf_free[2];
+    char *res_buf;
+    char *res_buf_free;
+    /* counts of the leaders for the current segment */
+    int *up_counts;
+    int *low_counts;
+    int *low_displs;
+    int seg_count;
+    int root_low_rank;
+    int num_segments;
+    int cur_seg;
+    int w_rank;
+    int w_size;
+    int low_size;
+    int up_rank;
+    int up_size;
+    int completed;
+    int err;
+    bool noop;
+};
+typedef struct mca_coll_han_reduce_scatter_args_s mca_coll_han_reduce_scatter_args_t;
+
 /**
  * Structure to hold the han coll component.  First it holds the
  * base coll component, and then holds a bunch of
@@ -213,10 +252,23 @@ typedef struct mca_coll_han_component_t {
     uint32_t han_scatter_up_module;
     /* low level module for scatter */
     uint32_t han_scatter_low_module;
+    /* segment size for reduce_scatter and reduce_scatter_block */
+    uint32_t han_reduce_scatter_segsize;
+    /* number of node leaders splitting the inter-node phase of the
+     * simple bcast and allreduce, when the dynamic rules do not say */
+    uint32_t han_leaders;
+    /* split the nodes by socket in the simple bcast and allreduce */
+    bool han_socket_level;
+    /* number of consecutive nodes per group of nodes, 0 for no groups
+     * unless the communicator has the ompi_comm_coll_han_group info key */
+    int han_group_size;
     /* whether we need reproducible results
      * (but disables topological optimisations)
      */
     bool han_reproducible;
+    /* provide the hierarchical ibcast, iallreduce and iallgather, and their
+     * persistent versions, on the global communicators */
+    bool han_nonblocking;
     bool use_simple_algorithm[COLLCOUNT];
 
     /* Dynamic configuration rules */
@@ -242,11 +294,21 @@ typedef struct mca_coll_han_single_collective_fallback_s {
         mca_coll_base_module_allgather_fn_t allgather;
         mca_coll_base_module_allgatherv_fn_t allgatherv;
         mca_coll_base_module_allreduce_fn_t allreduce;
+        mca_coll_base_module_alltoall_fn_t alltoall;
+        mca_coll_base_module_alltoallv_fn_t alltoallv;
         mca_coll_base_module_barrier_fn_t barrier;
         mca_coll_base_module_bcast_fn_t bcast;
         mca_coll_base_module_gather_fn_t gather;
         mca_coll_base_module_reduce_fn_t reduce;
+        mca_coll_base_module_reduce_scatter_fn_t reduce_scatter;
+        mca_coll_base_module_reduce_scatter_block_fn_t reduce_scatter_block;
         mca_coll_base_module_scatter_fn_t scatter;
+        mca_coll_base_module_iallgather_fn_t iallgather;
+        mca_coll_base_module_iallreduce_fn_t iallreduce;
+        mca_coll_base_module_ibcast_fn_t ibcast;
+        mca_coll_base_module_allgather_init_fn_t allgather_init;
+        mca_coll_base_module_allreduce_init_fn_t allreduce_init;
+        mca_coll_base_module_bcast_init_fn_t bcast_init;
     } module_fn;
     mca_coll_base_module_t* module;
 } mca_coll_han_single_collective_fallback_t;
@@ -260,11 +322,21 @@ typedef struct mca_coll_han_collectives_fallback_s {
     mca_coll_han_single_collective_fallback_t allgather;
     mca_coll_han_single_collective_fallback_t allgatherv;
     mca_coll_han_single_collective_fallback_t allreduce;
+    mca_coll_han_single_collective_fallback_t alltoall;
+    mca_coll_han_single_collective_fallback_t alltoallv;
     mca_coll_han_single_collective_fallback_t barrier;
     mca_coll_han_single_collective_fallback_t bcast;
     mca_coll_han_single_collective_fallback_t reduce;
+    mca_coll_han_single_collective_fallback_t reduce_scatter;
+    mca_coll_han_single_collective_fallback_t reduce_scatter_block;
     mca_coll_han_single_collective_fallback_t gather;
     mca_coll_han_single_collective_fallback_t scatter;
+    mca_coll_han_single_collective_fallback_t iallgather;
+    mca_coll_han_single_collective_fallback_t iallreduce;
+    mca_coll_han_single_collective_fallback_t ibcast;
+    mca_coll_han_single_collective_fallback_t allgather_init;
+    mca_coll_han_single_collective_fallback_t allreduce_init;
+    mca_coll_han_single_collective_fallback_t bcast_init;
 } mca_coll_han_collectives_fallback_t;
 
 /** Coll han module */
@@ -281,6 +353,16 @@ typedef struct mca_coll_han_module_t {
     struct ompi_communicator_t **cached_up_comms;
     int *cached_vranks;
     int *cached_topo;
+    /* intra-node ranks of the possible node leaders, the ones closest to
+     * distinct NICs first, the same on all the nodes */
+    int *cached_leaders;
+    int cached_nleaders;
+    /* optional socket and group levels, with for all the intra-node (resp.
+     * inter-node) ranks their rank at the intra and inter level */
+    bool use_socket_level;
+    bool use_group_level;
+    int *cached_socket_ranks;
+    int *cached_group_ranks;
     bool is_mapbycore;
     bool are_ppn_imbalanced;
 
@@ -292,6 +374,8 @@ typedef struct mca_coll_han_module_t {
     mca_coll_base_module_t *reproducible_reduce_module;
     mca_coll_base_module_allreduce_fn_t reproducible_allreduce;
     mca_coll_base_module_t *reproducible_allreduce_module;
+    /* the communicator has the ompi_comm_coll_reproducible info key */
+    bool reproducible_comm;
 
     /* Topological level of this communicator */
     TOPO_LVL_T topologic_level;
@@ -325,6 +409,12 @@ OBJ_CLASS_DECLARATION(mca_coll_han_module_t);
 #define previous_allreduce          fallback.allreduce.module_fn.allreduce
 #define previous_allreduce_module   fallback.allreduce.module
 
+#define previous_alltoall           fallback.alltoall.module_fn.alltoall
+#define previous_alltoall_module    fallback.alltoall.module
+
+#define previous_alltoallv          fallback.alltoallv.module_fn.alltoallv
+#define previous_alltoallv_module   fallback.alltoallv.module
+
 #define previous_barrier            fallback.barrier.module_fn.barrier
 #define previous_barrier_module     fallback.barrier.module
 
@@ -334,12 +424,36 @@ OBJ_CLASS_DECLARATION(mca_coll_han_module_t);
 #define previous_reduce             fallback.reduce.module_fn.reduce
 #define previous_reduce_module      fallback.reduce.module
 
+#define previous_reduce_scatter     fallback.reduce_scatter.module_fn.reduce_scatter
+#define previous_reduce_scatter_module fallback.reduce_scatter.module
+
+#define previous_reduce_scatter_block fallback.reduce_scatter_block.module_fn.reduce_scatter_block
+#define previous_reduce_scatter_block_module fallback.reduce_scatter_block.module
+
 #define previous_gather             fallback.gather.module_fn.gather
 #define previous_gather_module      fallback.gather.module
 
 #define previous_scatter            fallback.scatter.module_fn.scatter
 #define previous_scatter_module     fallback.scatter.module
 
+#define previous_iallgather         fallback.iallgather.module_fn.iallgather
+#define previous_iallgather_module  fallback.iallgather.module
+
+#define previous_iallreduce         fallback.iallreduce.module_fn.iallreduce
+#define previous_iallreduce_module  fallback.iallreduce.module
+
+#define previous_ibcast             fallback.ibcast.module_fn.ibcast
+#define previous_ibcast_module      fallback.ibcast.module
+
+#define previous_allgather_init     fallback.allgather_init.module_fn.allgather_init
+#define previous_allgather_init_module fallback.allgather_init.module
+
+#define previous_allreduce_init     fallback.allreduce_init.module_fn.allreduce_init
+#define previous_allreduce_init_module fallback.allreduce_init.module
+
+#define previous_bcast_init         fallback.bcast_init.module_fn.bcast_init
+#define previous_bcast_init_module  fallback.bcast_init.module
+
 
 /* macro to correctly load a fallback collective module */
 #define HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, COLL)                            \
@@ -364,6 +478,16 @@ OBJ_CLASS_DECLARATION(mca_coll_han_module_t);
         HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, allreduce);                 \
         HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, allgather);                 \
         HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, allgatherv);                \
+        HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, alltoall);                  \
+        HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, alltoallv);                 \
+        HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, reduce_scatter);            \
+        HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, reduce_scatter_block);      \
+        HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, iallgather);                \
+        HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, iallreduce);                \
+        HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, ibcast);                    \
+        HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, allgather_init);            \
+        HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, allreduce_init);            \
+        HAN_LOAD_FALLBACK_COLLECTIVE(HANM, COMM, bcast_init);                \
         han_module->enabled = false;  /* entire module set to pass-through from now on */ \
     } while(0)
 
@@ -409,6 +533,25 @@ mca_coll_han_get_ranks(int *vranks, int root, int low_size,
 
 const char* mca_coll_han_topo_lvl_to_str(TOPO_LVL_T topo_lvl);
 
+/* Optional socket and group levels */
+void mca_coll_han_levels_create(struct ompi_communicator_t *comm,
+                                mca_coll_han_module_t *han_module);
+int mca_coll_han_levels_reduce_low(const void *sbuf, void *rbuf, int count,
+                                   struct ompi_datatype_t *dtype, struct ompi_op_t *op,
+                                   mca_coll_han_module_t *han_module);
+int mca_coll_han_levels_allreduce_up(void *rbuf, int count,
+                                     struct ompi_datatype_t *dtype, struct ompi_op_t *op,
+                                     mca_coll_han_module_t *han_module);
+int mca_coll_han_levels_bcast_low(void *buff, int count, struct ompi_datatype_t *dtype,
+                                  int root_low_rank, mca_coll_han_module_t *han_module);
+int mca_coll_han_levels_bcast_up(void *buff, int count, struct ompi_datatype_t *dtype,
+                                 int root_up_rank, mca_coll_han_module_t *han_module);
+
+/* Number of node leaders to use for the inter-node phase of a collective */
+int mca_coll_han_get_leaders(COLLTYPE_T coll_id, size_t msg_size,
+                             struct ompi_communicator_t *comm,
+                             mca_coll_han_module_t *han_module);
+
 /** Dynamic component choice */
 /*
  * Get all the collective modules initialized on this communicator
@@ -428,6 +571,12 @@ int
 mca_coll_han_allreduce_intra_dynamic(ALLREDUCE_BASE_ARGS,
                                      mca_coll_base_module_t *module);
 int
+mca_coll_han_alltoall_intra_dynamic(ALLTOALL_BASE_ARGS,
+                                    mca_coll_base_module_t *module);
+int
+mca_coll_han_alltoallv_intra_dynamic(ALLTOALLV_BASE_ARGS,
+                                     mca_coll_base_module_t *module);
+int
 mca_coll_han_barrier_intra_dynamic(BARRIER_BASE_ARGS,
                                  mca_coll_base_module_t *module);
 int
@@ -440,6 +589,12 @@ int
 mca_coll_han_reduce_intra_dynamic(REDUCE_BASE_ARGS,
                                   mca_coll_base_module_t *module);
 int
+mca_coll_han_reduce_scatter_intra_dynamic(REDUCESCATTER_BASE_ARGS,
+                                          mca_coll_base_module_t *module);
+int
+mca_coll_han_reduce_scatter_block_intra_dynamic(REDUCESCATTERBLOCK_BASE_ARGS,
+                                                mca_coll_base_module_t *module);
+int
 mca_coll_han_scatter_intra_dynamic(SCATTER_BASE_ARGS,
                                    mca_coll_base_module_t *module);
 
@@ -573,4 +728,113 @@ mca_coll_han_allgather_intra_simple(const void *sbuf, int scount,
                                     struct ompi_communicator_t *comm,
                                     mca_coll_base_module_t *module);
 
+/* Alltoall */
+int
+mca_coll_han_alltoall_intra(const void *sbuf, int scount,
+                            struct ompi_datatype_t *sdtype,
+                            void *rbuf, int rcount,
+                            struct ompi_datatype_t *rdtype,
+                            struct ompi_communicator_t *comm,
+                            mca_coll_base_module_t *module);
+
+/* Alltoallv */
+int
+mca_coll_han_alltoallv_intra(const void *sbuf, const int *scounts,
+                             const int *sdispls,
+                             struct ompi_datatype_t *sdtype,
+                             void *rbuf, const int *rcounts,
+                             const int *rdispls,
+                             struct ompi_datatype_t *rdtype,
+                             struct ompi_communicator_t *comm,
+                             mca_coll_base_module_t *module);
+
+/* Reduce_scatter */
+int
+mca_coll_han_reduce_scatter_intra(const void *sbuf, void *rbuf,
+                                  const int *rcounts,
+                                  struct ompi_datatype_t *dtype,
+                                  struct ompi_op_t *op,
+                                  struct ompi_communicator_t *comm,
+                                  mca_coll_base_module_t *module);
+
+/* Reduce_scatter_block */
+int
+mca_coll_han_reduce_scatter_block_intra(const void *sbuf, void *rbuf,
+                                        int rcount,
+                                        struct ompi_datatype_t *dtype,
+                                        struct ompi_op_t *op,
+                                        struct ompi_communicator_t *comm,
+                                        mca_coll_base_module_t *module);
+
+/*
+ * Nonblocking and persistent collectives: the phases of the simple
+ * algorithms are tasks issued one after the other, each one posting a
+ * nonblocking (or starting a persistent) operation on a sub-communicator
+ * whose completion issues the next task.
+ */
+#define COLL_HAN_NBC_MAX_STEPS 4
+
+typedef struct mca_coll_han_nbc_request_s {
+    ompi_request_t super;
+    mca_coll_han_module_t *han_module;
+    struct ompi_communicator_t *comm;
+    struct ompi_info_t *info;
+
+    mca_coll_task_t tasks[COLL_HAN_NBC_MAX_STEPS];
+    int nsteps;
+    int step;
+    /* the persistent sub-requests are created once, when the request is */
+    bool creating;
+    ompi_request_t *sub_req;
+    ompi_request_t *persistent_reqs[COLL_HAN_NBC_MAX_STEPS];
+
+    /* arguments of the collective */
+    const void *sbuf;
+    void *rbuf;
+    int scount;
+    int rcount;
+    struct ompi_datatype_t *sdtype;
+    struct ompi_datatype_t *rdtype;
+    struct ompi_op_t *op;
+    int root_low_rank;
+    int root_up_rank;
+
+    /* intermediary buffers of the node leaders */
+    char *tmp_buf;
+    char *tmp_buf_start;
+    char *reorder_buf;
+    char *reorder_buf_start;
+    int *topo;
+} mca_coll_han_nbc_request_t;
+OBJ_CLASS_DECLARATION(mca_coll_han_nbc_request_t);
+
+int
+mca_coll_han_ibcast_intra(void *buff, int count, struct ompi_datatype_t *dtype, int root,
+                          struct ompi_communicator_t *comm, ompi_request_t **request,
+                          mca_coll_base_module_t *module);
+int
+mca_coll_han_iallreduce_intra(const void *sbuf, void *rbuf, int count,
+                              struct ompi_datatype_t *dtype, struct ompi_op_t *op,
+                              struct ompi_communicator_t *comm, ompi_request_t **request,
+                              mca_coll_base_module_t *module);
+int
+mca_coll_han_iallgather_intra(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                              void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                              struct ompi_communicator_t *comm, ompi_request_t **request,
+                              mca_coll_base_module_t *module);
+int
+mca_coll_han_bcast_init_intra(void *buff, int count, struct ompi_datatype_t *dtype, int root,
+                              struct ompi_communicator_t *comm, struct ompi_info_t *info,
+                              ompi_request_t **request, mca_coll_base_module_t *module);
+int
+mca_coll_han_allreduce_init_intra(const void *sbuf, void *rbuf, int count,
+                                  struct ompi_datatype_t *dtype, struct ompi_op_t *op,
+                                  struct ompi_communicator_t *comm, struct ompi_info_t *info,
+                                  ompi_request_t **request, mca_coll_base_module_t *module);
+int
+mca_coll_han_allgather_init_intra(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                                  void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                                  struct ompi_communicator_t *comm, struct ompi_info_t *info,
+                                  ompi_request_t **request, mca_coll_base_module_t *module);
+
 #endif                          /* MCA_COLL_HAN_EXPORT_H */
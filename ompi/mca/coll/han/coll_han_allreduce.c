@@ -404,6 +404,73 @@ int mca_coll_han_allreduce_t3_task(void *task_args)
     return OMPI_SUCCESS;
 }
 
+/*
+ * Allreduce with several leaders per node: each leader reduces a slice
+ * of the message inside the node, allreduces it with the same leader of
+ * the other nodes and shares the result inside its node. The inter-node
+ * phase goes through as many NICs as there are leaders.
+ */
+static int
+mca_coll_han_allreduce_multi_leader(const void *sbuf, void *rbuf, int count,
+                                    struct ompi_datatype_t *dtype,
+                                    struct ompi_op_t *op, int nleaders,
+                                    ompi_communicator_t *low_comm,
+                                    ompi_communicator_t *up_comm,
+                                    mca_coll_han_module_t *han_module)
+{
+    int low_rank = ompi_comm_rank(low_comm);
+    int seg_count = count / nleaders, rem = count % nleaders;
+    ptrdiff_t extent, lb, offset;
+    int k, ret, leader, tmp_count;
+
+    ompi_datatype_get_extent(dtype, &lb, &extent);
+
+    for (k = 0; k < nleaders; k++) {
+        leader = han_module->cached_leaders[k];
+        offset = extent * (k * seg_count + (k < rem ? k : rem));
+        tmp_count = seg_count + (k < rem ? 1 : 0);
+        if (MPI_IN_PLACE != sbuf) {
+            ret = low_comm->c_coll->coll_reduce((char *)sbuf + offset, (char *)rbuf + offset,
+                                                tmp_count, dtype, op, leader,
+                                                low_comm, low_comm->c_coll->coll_reduce_module);
+        } else if (low_rank == leader) {
+            ret = low_comm->c_coll->coll_reduce(MPI_IN_PLACE, (char *)rbuf + offset,
+                                                tmp_count, dtype, op, leader,
+                                                low_comm, low_comm->c_coll->coll_reduce_module);
+        } else {
+            ret = low_comm->c_coll->coll_reduce((char *)rbuf + offset, NULL,
+                                                tmp_count, dtype, op, leader,
+                                                low_comm, low_comm->c_coll->coll_reduce_module);
+        }
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+    }
+
+    for (k = 0; k < nleaders; k++) {
+        if (han_module->cached_leaders[k] == low_rank) {
+            offset = extent * (k * seg_count + (k < rem ? k : rem));
+            ret = up_comm->c_coll->coll_allreduce(MPI_IN_PLACE, (char *)rbuf + offset,
+                                                  seg_count + (k < rem ? 1 : 0), dtype, op,
+                                                  up_comm, up_comm->c_coll->coll_allreduce_module);
+            if (OMPI_SUCCESS != ret) {
+                return ret;
+            }
+        }
+    }
+
+    for (k = 0; k < nleaders; k++) {
+        offset = extent * (k * seg_count + (k < rem ? k : rem));
+        ret = low_comm->c_coll->coll_bcast((char *)rbuf + offset, seg_count + (k < rem ? 1 : 0),
+                                           dtype, han_module->cached_leaders[k],
+                                           low_comm, low_comm->c_coll->coll_bcast_module);
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+    }
+    return OMPI_SUCCESS;
+}
+
 /*
  * Short implementation of allreduce that only does hierarchical
  * communications without tasks.
@@ -420,7 +487,8 @@ mca_coll_han_allreduce_intra_simple(const void *sbuf,
     ompi_communicator_t *low_comm;
     ompi_communicator_t *up_comm;
     int root_low_rank = 0;
-    int low_rank;
+    int low_rank, nleaders;
+    size_t dtype_size;
     int ret;
     mca_coll_han_module_t *han_module = (mca_coll_han_module_t *)module;
 #if OPAL_ENABLE_DEBUG
@@ -451,24 +519,24 @@ mca_coll_han_allreduce_intra_simple(const void *sbuf,
     up_comm = han_module->sub_comm[INTER_NODE];
     low_rank = ompi_comm_rank(low_comm);
 
-    /* Low_comm reduce */
-    if (MPI_IN_PLACE == sbuf) {
-        if (low_rank == root_low_rank) {
-            ret = low_comm->c_coll->coll_reduce(MPI_IN_PLACE, (char *)rbuf,
-                count, dtype, op, root_low_rank,
-                low_comm, low_comm->c_coll->coll_reduce_module);
-        }
-        else {
-            ret = low_comm->c_coll->coll_reduce((char *)rbuf, NULL,
-                count, dtype, op, root_low_rank,
-                low_comm, low_comm->c_coll->coll_reduce_module);
-        }
+    ompi_datatype_type_size(dtype, &dtype_size);
+    nleaders = mca_coll_han_get_leaders(ALLREDUCE, dtype_size * count, comm, han_module);
+    if (nleaders > count) {
+        nleaders = count;
     }
-    else {
-        ret = low_comm->c_coll->coll_reduce((char *)sbuf, (char *)rbuf,
-                count, dtype, op, root_low_rank,
-                low_comm, low_comm->c_coll->coll_reduce_module);
+    if (nleaders > 1) {
+        ret = mca_coll_han_allreduce_multi_leader(sbuf, rbuf, count, dtype, op, nleaders,
+                                                  low_comm, up_comm, han_module);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+            OPAL_OUTPUT_VERBOSE((30, cs->han_output,
+                                 "HAN/ALLREDUCE: multi-leader allreduce failed.\n"));
+        }
+        /* Do not fallback either: the leaders may be in another collective */
+        return ret;
     }
+
+    /* Low_comm reduce (through the sockets if enabled) */
+    ret = mca_coll_han_levels_reduce_low(sbuf, rbuf, count, dtype, op, han_module);
     if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
         OPAL_OUTPUT_VERBOSE((30, cs->han_output,
                              "HAN/ALLREDUCE: low comm reduce failed. "
@@ -478,8 +546,7 @@ mca_coll_han_allreduce_intra_simple(const void *sbuf,
 
     /* Local roots perform a allreduce on the upper comm */
     if (low_rank == root_low_rank) {
-        ret = up_comm->c_coll->coll_allreduce(MPI_IN_PLACE, rbuf, count, dtype, op,
-                    up_comm, up_comm->c_coll->coll_allreduce_module);
+        ret = mca_coll_han_levels_allreduce_up(rbuf, count, dtype, op, han_module);
         if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
             OPAL_OUTPUT_VERBOSE((30, cs->han_output,
                              "HAN/ALLREDUCE: up comm allreduce failed. \n"));
@@ -494,8 +561,7 @@ mca_coll_han_allreduce_intra_simple(const void *sbuf,
     }
 
     /* Low_comm bcast */
-    ret = low_comm->c_coll->coll_bcast(rbuf, count, dtype,
-                root_low_rank, low_comm, low_comm->c_coll->coll_bcast_module);
+    ret = mca_coll_han_levels_bcast_low(rbuf, count, dtype, root_low_rank, han_module);
     if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
         OPAL_OUTPUT_VERBOSE((30, cs->han_output,
                              "HAN/ALLREDUCE: low comm bcast failed. "
@@ -510,47 +576,23 @@ mca_coll_han_allreduce_intra_simple(const void *sbuf,
                                           comm, han_module->previous_allreduce_module);
 }
 
-/* Find a fallback on reproducible algorithm
- * use tuned, or if impossible whatever available
+/* The reproducible allreduce reduces each element along a fixed binary tree
+ * over the ranks of the whole communicator, with reduce-scatter parallelism
+ * for the large vectors, so it does not depend on the topology
  */
 int
 mca_coll_han_allreduce_reproducible_decision(struct ompi_communicator_t *comm,
                                              mca_coll_base_module_t *module)
 {
-    int w_rank = ompi_comm_rank(comm);
     mca_coll_han_module_t *han_module = (mca_coll_han_module_t *)module;
 
-    /* populate previous modules_storage*/
-    mca_coll_han_get_all_coll_modules(comm, han_module);
-
-    /* try availability of reproducible modules*/
-    int fallbacks[] = {TUNED, BASIC};
-    int fallbacks_len = sizeof(fallbacks) / sizeof(*fallbacks);
-    int i;
-    for (i=0; i<fallbacks_len; i++) {
-        int fallback = fallbacks[i];
-        mca_coll_base_module_t *fallback_module
-            = han_module->modules_storage.modules[fallback].module_handler;
-        if (NULL != fallback_module && NULL != fallback_module->coll_allreduce) {
-            if (0 == w_rank) {
-                opal_output_verbose(30, mca_coll_han_component.han_output,
-                                    "coll:han:allreduce_reproducible: "
-                                    "fallback on %s\n",
-                                    available_components[fallback].component_name);
-            }
-            han_module->reproducible_allreduce_module = fallback_module;
-            han_module->reproducible_allreduce = fallback_module->coll_allreduce;
-            return OMPI_SUCCESS;
-        }
-    }
-    /* fallback of the fallback */
-    if (0 == w_rank) {
-        opal_output_verbose(5, mca_coll_han_component.han_output,
-                            "coll:han:allreduce_reproducible_decision: "
-                            "no reproducible fallback\n");
+    if (0 == ompi_comm_rank(comm)) {
+        opal_output_verbose(30, mca_coll_han_component.han_output,
+                            "coll:han:allreduce_reproducible: "
+                            "fixed binary tree over the ranks\n");
     }
-    han_module->reproducible_allreduce_module = han_module->previous_allreduce_module;
-    han_module->reproducible_allreduce = han_module->previous_allreduce;
+    han_module->reproducible_allreduce_module = module;
+    han_module->reproducible_allreduce = ompi_coll_base_allreduce_intra_reproducible;
     return OMPI_SUCCESS;
 }
 
@@ -0,0 +1,470 @@
+/*
+ * Copyright (c) 2018-2021 The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * This files contains the hierarchical implementations of alltoall and
+ * alltoallv.
+ *
+ * Both algorithms aggregate the traffic at the node level, so that only one
+ * message is exchanged per pair of nodes:
+ *   1. the node leaders gather the whole send buffers of their local peers
+ *      on the low (intra-node) sub-communicator,
+ *   2. each leader builds one block per remote node, containing everything
+ *      the local ranks send to the ranks of that node, and the leaders
+ *      exchange these blocks with an alltoall(v) on the up (inter-node)
+ *      sub-communicator,
+ *   3. the leaders reorder the received data by destination and scatter it
+ *      back on the low sub-communicator.
+ *
+ * The data is addressed through the topological position of the ranks
+ * (see coll_han_topo.c): position p = node * low_size + low_rank, and the
+ * corresponding rank in comm is topo[2 * p + 1].
+ */
+
+#include "coll_han.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/mca/coll/base/coll_tags.h"
+#include "ompi/mca/pml/pml.h"
+#include "opal/util/minmax.h"
+
+/*
+ * Alltoall: with the data of the low_size local ranks gathered on the node
+ * leader, the intermediary buffers are arrays of w_size * low_size blocks
+ * of rcount rdtype elements.
+ */
+int
+mca_coll_han_alltoall_intra(const void *sbuf, int scount,
+                            struct ompi_datatype_t *sdtype,
+                            void *rbuf, int rcount,
+                            struct ompi_datatype_t *rdtype,
+                            struct ompi_communicator_t *comm,
+                            mca_coll_base_module_t *module)
+{
+    mca_coll_han_module_t *han_module = (mca_coll_han_module_t *)module;
+
+    /* create the subcommunicators */
+    if( OMPI_SUCCESS != mca_coll_han_comm_create_new(comm, han_module) ) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle alltoall within this communicator. Fall back on another component\n"));
+        /* HAN cannot work with this communicator so fallback on all collectives */
+        HAN_LOAD_FALLBACK_COLLECTIVES(han_module, comm);
+        return comm->c_coll->coll_alltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype,
+                                           comm, comm->c_coll->coll_alltoall_module);
+    }
+    /* discovery topology */
+    int *topo = mca_coll_han_topo_init(comm, han_module, 2);
+
+    /* unbalanced case needs algo adaptation */
+    if (han_module->are_ppn_imbalanced) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle alltoall within this communicator (imbalance). Fall back on another component\n"));
+        /* Put back the fallback collective support and call it once. All
+         * future calls will then be automatically redirected.
+         */
+        HAN_LOAD_FALLBACK_COLLECTIVE(han_module, comm, alltoall);
+        return comm->c_coll->coll_alltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype,
+                                           comm, comm->c_coll->coll_alltoall_module);
+    }
+
+    ompi_communicator_t *low_comm = han_module->sub_comm[INTRA_NODE];
+    ompi_communicator_t *up_comm = han_module->sub_comm[INTER_NODE];
+    int w_size = ompi_comm_size(comm);
+    int low_rank = ompi_comm_rank(low_comm);
+    int low_size = ompi_comm_size(low_comm);
+    int up_size = ompi_comm_size(up_comm);
+    int root_low_rank = 0; // node leader will be 0 on each rank
+    int err;
+
+    /* The gather on the leaders completes before anything is written to
+     * rbuf, so the in place case only needs to use rbuf as the input. */
+    if (MPI_IN_PLACE == sbuf) {
+        sbuf = rbuf;
+        scount = rcount;
+        sdtype = rdtype;
+    }
+
+    ptrdiff_t rlb, rext;
+    ompi_datatype_get_extent(rdtype, &rlb, &rext);
+    ptrdiff_t block_size = rext * (ptrdiff_t)rcount;
+
+    char *gather_buf = NULL, *gather_buf_start = NULL;
+    char *reorder_buf = NULL, *reorder_buf_start = NULL;
+    if (low_rank == root_low_rank) {
+        ptrdiff_t rsize, rgap = 0;
+        /* Compute the size to receive all the local data, including datatypes empty gaps */
+        rsize = opal_datatype_span(&rdtype->super, (int64_t)rcount * w_size * low_size, &rgap);
+        gather_buf = (char *) malloc(rsize);
+        reorder_buf = (char *) malloc(rsize);
+        if (NULL == gather_buf || NULL == reorder_buf) {
+            err = OMPI_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+        gather_buf_start = gather_buf - rgap;
+        reorder_buf_start = reorder_buf - rgap;
+    }
+
+    /* 1. low gather of the full send buffers on node leaders:
+     * gather_buf[src_low][dst_rank] */
+    err = low_comm->c_coll->coll_gather((char *)sbuf, scount * w_size, sdtype,
+                                        gather_buf_start, rcount * w_size, rdtype,
+                                        root_low_rank, low_comm,
+                                        low_comm->c_coll->coll_gather_module);
+    if (OMPI_SUCCESS != err) {
+        goto cleanup;
+    }
+
+    if (low_rank == root_low_rank) {
+        /* 2a. group the blocks by destination node:
+         * reorder_buf[dst_node][src_low][dst_low] */
+        for (int dst_node = 0; dst_node < up_size; dst_node++) {
+            for (int src_low = 0; src_low < low_size; src_low++) {
+                for (int dst_low = 0; dst_low < low_size; dst_low++) {
+                    int dst_rank = topo[2 * (dst_node * low_size + dst_low) + 1];
+                    ptrdiff_t src_shift = block_size * ((ptrdiff_t)src_low * w_size + dst_rank);
+                    ptrdiff_t dest_shift = block_size *
+                        (((ptrdiff_t)dst_node * low_size + src_low) * low_size + dst_low);
+                    ompi_datatype_copy_content_same_ddt(rdtype, (ptrdiff_t)rcount,
+                                                        reorder_buf_start + dest_shift,
+                                                        gather_buf_start + src_shift);
+                }
+            }
+        }
+
+        /* 2b. inter node alltoall between node leaders, back into gather_buf:
+         * gather_buf[src_node][src_low][dst_low] */
+        err = up_comm->c_coll->coll_alltoall(reorder_buf_start, rcount * low_size * low_size, rdtype,
+                                             gather_buf_start, rcount * low_size * low_size, rdtype,
+                                             up_comm, up_comm->c_coll->coll_alltoall_module);
+        if (OMPI_SUCCESS != err) {
+            goto cleanup;
+        }
+
+        /* 2c. group the blocks by local destination, sorted by source rank:
+         * reorder_buf[dst_low][src_rank] */
+        for (int dst_low = 0; dst_low < low_size; dst_low++) {
+            for (int src_pos = 0; src_pos < w_size; src_pos++) {
+                int src_rank = topo[2 * src_pos + 1];
+                ptrdiff_t src_shift = block_size * ((ptrdiff_t)src_pos * low_size + dst_low);
+                ptrdiff_t dest_shift = block_size * ((ptrdiff_t)dst_low * w_size + src_rank);
+                ompi_datatype_copy_content_same_ddt(rdtype, (ptrdiff_t)rcount,
+                                                    reorder_buf_start + dest_shift,
+                                                    gather_buf_start + src_shift);
+            }
+        }
+    }
+
+    /* 3. low scatter: leaders send each local rank its receive buffer */
+    err = low_comm->c_coll->coll_scatter(reorder_buf_start, rcount * w_size, rdtype,
+                                         rbuf, rcount * w_size, rdtype,
+                                         root_low_rank, low_comm,
+                                         low_comm->c_coll->coll_scatter_module);
+
+ cleanup:
+    if (NULL != gather_buf) {
+        free(gather_buf);
+    }
+    if (NULL != reorder_buf) {
+        free(reorder_buf);
+    }
+    return err;
+}
+
+/*
+ * Alltoallv: the counts are different for each pair of processes and the
+ * datatypes are only required to share the same signature, so the data is
+ * moved around packed, in bytes. Each leader holds the matrix of byte counts
+ * between its local ranks and all the processes, which is enough to compute
+ * all the offsets in the intermediary buffers.
+ */
+int
+mca_coll_han_alltoallv_intra(const void *sbuf, const int *scounts,
+                             const int *sdispls,
+                             struct ompi_datatype_t *sdtype,
+                             void *rbuf, const int *rcounts,
+                             const int *rdispls,
+                             struct ompi_datatype_t *rdtype,
+                             struct ompi_communicator_t *comm,
+                             mca_coll_base_module_t *module)
+{
+    mca_coll_han_module_t *han_module = (mca_coll_han_module_t *)module;
+
+    /* create the subcommunicators */
+    if( OMPI_SUCCESS != mca_coll_han_comm_create_new(comm, han_module) ) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle alltoallv within this communicator. Fall back on another component\n"));
+        /* HAN cannot work with this communicator so fallback on all collectives */
+        HAN_LOAD_FALLBACK_COLLECTIVES(han_module, comm);
+        return comm->c_coll->coll_alltoallv(sbuf, scounts, sdispls, sdtype,
+                                            rbuf, rcounts, rdispls, rdtype,
+                                            comm, comm->c_coll->coll_alltoallv_module);
+    }
+    /* discovery topology */
+    int *topo = mca_coll_han_topo_init(comm, han_module, 2);
+
+    /* unbalanced case needs algo adaptation */
+    if (han_module->are_ppn_imbalanced) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle alltoallv within this communicator (imbalance). Fall back on another component\n"));
+        HAN_LOAD_FALLBACK_COLLECTIVE(han_module, comm, alltoallv);
+        return comm->c_coll->coll_alltoallv(sbuf, scounts, sdispls, sdtype,
+                                            rbuf, rcounts, rdispls, rdtype,
+                                            comm, comm->c_coll->coll_alltoallv_module);
+    }
+
+    ompi_communicator_t *low_comm = han_module->sub_comm[INTRA_NODE];
+    ompi_communicator_t *up_comm = han_module->sub_comm[INTER_NODE];
+    int w_size = ompi_comm_size(comm);
+    int low_rank = ompi_comm_rank(low_comm);
+    int low_size = ompi_comm_size(low_comm);
+    int up_size = ompi_comm_size(up_comm);
+    int root_low_rank = 0; // node leader will be 0 on each rank
+    int err = OMPI_SUCCESS;
+
+    /* leader only */
+    int *gather_sizes = NULL;      /* [src_low][dst_pos] bytes sent */
+    int *up_sizes = NULL;          /* [src_node][src_low][dst_low] bytes received */
+    int *low_counts = NULL, *low_displs = NULL;
+    int *up_scounts = NULL, *up_sdispls = NULL, *up_rcounts = NULL, *up_rdispls = NULL;
+    char *gather_buf = NULL, *up_sbuf = NULL, *up_rbuf = NULL, *scatter_buf = NULL;
+    /* all ranks */
+    int *my_sizes = NULL;
+    char *pack_buf = NULL;
+
+    if (MPI_IN_PLACE == sbuf) {
+        sbuf = rbuf;
+        scounts = rcounts;
+        sdispls = rdispls;
+        sdtype = rdtype;
+    }
+
+    size_t ssize, rsize;
+    ptrdiff_t lb, sext, rext;
+    ompi_datatype_type_size(sdtype, &ssize);
+    ompi_datatype_type_size(rdtype, &rsize);
+    ompi_datatype_get_extent(sdtype, &lb, &sext);
+    ompi_datatype_get_extent(rdtype, &lb, &rext);
+
+    /* 0. pack the send buffer by increasing topological position of the
+     * destination */
+    int pack_size = 0, unpack_size = 0;
+    my_sizes = (int *) malloc(sizeof(int) * w_size);
+    if (NULL == my_sizes) {
+        err = OMPI_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    for (int pos = 0; pos < w_size; pos++) {
+        int peer = topo[2 * pos + 1];
+        my_sizes[pos] = (int)(scounts[peer] * ssize);
+        pack_size += my_sizes[pos];
+        unpack_size += (int)(rcounts[peer] * rsize);
+    }
+    pack_buf = (char *) malloc(opal_max(pack_size, unpack_size) + 1);
+    if (NULL == pack_buf) {
+        err = OMPI_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    for (int pos = 0, offset = 0; pos < w_size; pos++) {
+        int peer = topo[2 * pos + 1];
+        if (0 == my_sizes[pos]) {
+            continue;
+        }
+        err = ompi_datatype_sndrcv((char *)sbuf + (ptrdiff_t)sdispls[peer] * sext,
+                                   scounts[peer], sdtype,
+                                   pack_buf + offset, my_sizes[pos], MPI_PACKED);
+        if (OMPI_SUCCESS != err) {
+            goto cleanup;
+        }
+        offset += my_sizes[pos];
+    }
+
+    if (low_rank == root_low_rank) {
+        gather_sizes = (int *) malloc(sizeof(int) * w_size * low_size);
+        up_sizes = (int *) malloc(sizeof(int) * up_size * low_size * low_size);
+        low_counts = (int *) malloc(sizeof(int) * low_size);
+        low_displs = (int *) malloc(sizeof(int) * low_size);
+        up_scounts = (int *) malloc(sizeof(int) * up_size);
+        up_sdispls = (int *) malloc(sizeof(int) * up_size);
+        up_rcounts = (int *) malloc(sizeof(int) * up_size);
+        up_rdispls = (int *) malloc(sizeof(int) * up_size);
+        if (NULL == gather_sizes || NULL == up_sizes || NULL == low_counts ||
+            NULL == low_displs || NULL == up_scounts || NULL == up_sdispls ||
+            NULL == up_rcounts || NULL == up_rdispls) {
+            err = OMPI_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+    }
+
+    /* 1a. low gather of the byte counts on node leaders */
+    err = low_comm->c_coll->coll_gather(my_sizes, w_size, MPI_INT,
+                                        gather_sizes, w_size, MPI_INT,
+                                        root_low_rank, low_comm,
+                                        low_comm->c_coll->coll_gather_module);
+    if (OMPI_SUCCESS != err) {
+        goto cleanup;
+    }
+
+    int total = 0;
+    if (low_rank == root_low_rank) {
+        for (int src_low = 0; src_low < low_size; src_low++) {
+            low_counts[src_low] = 0;
+            for (int pos = 0; pos < w_size; pos++) {
+                low_counts[src_low] += gather_sizes[src_low * w_size + pos];
+            }
+            low_displs[src_low] = total;
+            total += low_counts[src_low];
+        }
+        gather_buf = (char *) malloc(total + 1);
+        up_sbuf = (char *) malloc(total + 1);
+        if (NULL == gather_buf || NULL == up_sbuf) {
+            err = OMPI_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+    }
+
+    /* 1b. low gatherv of the packed data on node leaders */
+    err = low_comm->c_coll->coll_gatherv(pack_buf, pack_size, MPI_BYTE,
+                                         gather_buf, low_counts, low_displs, MPI_BYTE,
+                                         root_low_rank, low_comm,
+                                         low_comm->c_coll->coll_gatherv_module);
+    if (OMPI_SUCCESS != err) {
+        goto cleanup;
+    }
+
+    if (low_rank == root_low_rank) {
+        /* 2a. group the data by destination node:
+         * up_sbuf[dst_node][src_low][dst_low]. The data of each local rank
+         * is already sorted by destination, so each (dst_node, src_low)
+         * chunk is contiguous in gather_buf, and low_displs is used as the
+         * read cursor of each local rank. Fill up_sizes with the
+         * corresponding sub-matrices of counts. */
+        int offset = 0;
+        for (int dst_node = 0; dst_node < up_size; dst_node++) {
+            up_sdispls[dst_node] = offset;
+            for (int src_low = 0; src_low < low_size; src_low++) {
+                int chunk = 0;
+                for (int dst_low = 0; dst_low < low_size; dst_low++) {
+                    int size = gather_sizes[src_low * w_size + dst_node * low_size + dst_low];
+                    up_sizes[(dst_node * low_size + src_low) * low_size + dst_low] = size;
+                    chunk += size;
+                }
+                memcpy(up_sbuf + offset, gather_buf + low_displs[src_low], chunk);
+                low_displs[src_low] += chunk;
+                offset += chunk;
+            }
+            up_scounts[dst_node] = offset - up_sdispls[dst_node];
+        }
+        free(gather_buf);
+        gather_buf = NULL;
+
+        /* 2b. exchange the count sub-matrices between node leaders */
+        err = up_comm->c_coll->coll_alltoall(MPI_IN_PLACE, low_size * low_size, MPI_INT,
+                                             up_sizes, low_size * low_size, MPI_INT,
+                                             up_comm, up_comm->c_coll->coll_alltoall_module);
+        if (OMPI_SUCCESS != err) {
+            goto cleanup;
+        }
+        total = 0;
+        for (int src_node = 0; src_node < up_size; src_node++) {
+            up_rdispls[src_node] = total;
+            for (int i = 0; i < low_size * low_size; i++) {
+                total += up_sizes[src_node * low_size * low_size + i];
+            }
+            up_rcounts[src_node] = total - up_rdispls[src_node];
+        }
+        up_rbuf = (char *) malloc(total + 1);
+        scatter_buf = (char *) malloc(total + 1);
+        if (NULL == up_rbuf || NULL == scatter_buf) {
+            err = OMPI_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+
+        /* 2c. inter node alltoallv between node leaders */
+        err = up_comm->c_coll->coll_alltoallv(up_sbuf, up_scounts, up_sdispls, MPI_BYTE,
+                                              up_rbuf, up_rcounts, up_rdispls, MPI_BYTE,
+                                              up_comm, up_comm->c_coll->coll_alltoallv_module);
+        if (OMPI_SUCCESS != err) {
+            goto cleanup;
+        }
+        free(up_sbuf);
+        up_sbuf = NULL;
+
+        /* 2d. group the data by local destination, sorted by source
+         * position: scatter_buf[dst_low][src_pos]. low_displs is used as
+         * the write cursor of each local rank and restored afterwards. */
+        for (int dst_low = 0; dst_low < low_size; dst_low++) {
+            low_counts[dst_low] = 0;
+            for (int src_pos = 0; src_pos < w_size; src_pos++) {
+                low_counts[dst_low] += up_sizes[src_pos * low_size + dst_low];
+            }
+        }
+        offset = 0;
+        for (int dst_low = 0; dst_low < low_size; dst_low++) {
+            low_displs[dst_low] = offset;
+            offset += low_counts[dst_low];
+        }
+        offset = 0;
+        for (int src_pos = 0; src_pos < w_size; src_pos++) {
+            for (int dst_low = 0; dst_low < low_size; dst_low++) {
+                int size = up_sizes[src_pos * low_size + dst_low];
+                memcpy(scatter_buf + low_displs[dst_low], up_rbuf + offset, size);
+                low_displs[dst_low] += size;
+                offset += size;
+            }
+        }
+        for (int dst_low = 0; dst_low < low_size; dst_low++) {
+            low_displs[dst_low] -= low_counts[dst_low];
+        }
+    }
+
+    /* 3. low scatterv of the packed data back to the local ranks */
+    err = low_comm->c_coll->coll_scatterv(scatter_buf, low_counts, low_displs, MPI_BYTE,
+                                          pack_buf, unpack_size, MPI_BYTE,
+                                          root_low_rank, low_comm,
+                                          low_comm->c_coll->coll_scatterv_module);
+    if (OMPI_SUCCESS != err) {
+        goto cleanup;
+    }
+
+    /* 4. unpack into the receive buffer */
+    for (int pos = 0, offset = 0; pos < w_size; pos++) {
+        int peer = topo[2 * pos + 1];
+        int size = (int)(rcounts[peer] * rsize);
+        if (0 == size) {
+            continue;
+        }
+        err = ompi_datatype_sndrcv(pack_buf + offset, size, MPI_PACKED,
+                                   (char *)rbuf + (ptrdiff_t)rdispls[peer] * rext,
+                                   rcounts[peer], rdtype);
+        if (OMPI_SUCCESS != err) {
+            goto cleanup;
+        }
+        offset += size;
+    }
+
+ cleanup:
+    free(my_sizes);
+    free(pack_buf);
+    free(gather_sizes);
+    free(up_sizes);
+    free(low_counts);
+    free(low_displs);
+    free(up_scounts);
+    free(up_sdispls);
+    free(up_rcounts);
+    free(up_rdispls);
+    free(gather_buf);
+    free(up_sbuf);
+    free(up_rbuf);
+    free(scatter_buf);
+    return err;
+}
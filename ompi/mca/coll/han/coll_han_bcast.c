@@ -217,6 +217,60 @@ int mca_coll_han_bcast_t1_task(void *task_args)
     return OMPI_SUCCESS;
 }
 
+/*
+ * Bcast with several leaders per node: the node of the root shares the
+ * whole message, each of its leaders broadcasts a slice of it to the
+ * same leader of the other nodes, which then share their slice inside
+ * their node. The inter-node phase goes through as many NICs as there
+ * are leaders.
+ */
+static int
+mca_coll_han_bcast_multi_leader(void *buff, int count,
+                                struct ompi_datatype_t *dtype,
+                                int root_low_rank, int root_up_rank, int nleaders,
+                                ompi_communicator_t *low_comm,
+                                ompi_communicator_t *up_comm,
+                                mca_coll_han_module_t *han_module)
+{
+    int low_rank = ompi_comm_rank(low_comm);
+    int up_rank = ompi_comm_rank(up_comm);
+    int seg_count = count / nleaders, rem = count % nleaders;
+    ptrdiff_t extent, lb;
+    int k, err;
+
+    ompi_datatype_get_extent(dtype, &lb, &extent);
+
+    if (up_rank == root_up_rank) {
+        err = low_comm->c_coll->coll_bcast(buff, count, dtype, root_low_rank,
+                                           low_comm, low_comm->c_coll->coll_bcast_module);
+        if (OMPI_SUCCESS != err) {
+            return err;
+        }
+    }
+    for (k = 0; k < nleaders; k++) {
+        if (han_module->cached_leaders[k] == low_rank) {
+            err = up_comm->c_coll->coll_bcast((char *)buff + extent * (k * seg_count + (k < rem ? k : rem)),
+                                              seg_count + (k < rem ? 1 : 0), dtype, root_up_rank,
+                                              up_comm, up_comm->c_coll->coll_bcast_module);
+            if (OMPI_SUCCESS != err) {
+                return err;
+            }
+        }
+    }
+    if (up_rank != root_up_rank) {
+        for (k = 0; k < nleaders; k++) {
+            err = low_comm->c_coll->coll_bcast((char *)buff + extent * (k * seg_count + (k < rem ? k : rem)),
+                                               seg_count + (k < rem ? 1 : 0), dtype,
+                                               han_module->cached_leaders[k],
+                                               low_comm, low_comm->c_coll->coll_bcast_module);
+            if (OMPI_SUCCESS != err) {
+                return err;
+            }
+        }
+    }
+    return OMPI_SUCCESS;
+}
+
 /*
  * Short implementation of bcast that only does hierarchical
  * communications without tasks.
@@ -232,7 +286,8 @@ mca_coll_han_bcast_intra_simple(void *buff,
     /* create the subcommunicators */
     mca_coll_han_module_t *han_module = (mca_coll_han_module_t *)module;
     ompi_communicator_t *low_comm, *up_comm;
-    int err;
+    size_t dtype_size;
+    int err, nleaders;
 #if OPAL_ENABLE_DEBUG
     int w_rank = ompi_comm_rank(comm);
 #endif
@@ -276,9 +331,18 @@ mca_coll_han_bcast_intra_simple(void *buff,
                          "[%d]: root_low_rank %d root_up_rank %d\n",
                          w_rank, root_low_rank, root_up_rank));
 
+    ompi_datatype_type_size(dtype, &dtype_size);
+    nleaders = mca_coll_han_get_leaders(BCAST, dtype_size * count, comm, han_module);
+    if (nleaders > count) {
+        nleaders = count;
+    }
+    if (nleaders > 1) {
+        return mca_coll_han_bcast_multi_leader(buff, count, dtype, root_low_rank, root_up_rank,
+                                               nleaders, low_comm, up_comm, han_module);
+    }
+
     if (low_rank == root_low_rank) {
-        up_comm->c_coll->coll_bcast(buff, count, dtype, root_up_rank,
-                                    up_comm, up_comm->c_coll->coll_bcast_module);
+        mca_coll_han_levels_bcast_up(buff, count, dtype, root_up_rank, han_module);
 
         /* To remove when han has better sub-module selection.
            For now switching to ibcast enables to make runs with libnbc. */
@@ -288,8 +352,7 @@ mca_coll_han_bcast_intra_simple(void *buff,
         //ompi_request_wait(&req, MPI_STATUS_IGNORE);
 
     }
-    low_comm->c_coll->coll_bcast(buff, count, dtype, root_low_rank,
-                                 low_comm, low_comm->c_coll->coll_bcast_module);
+    mca_coll_han_levels_bcast_low(buff, count, dtype, root_low_rank, han_module);
 
     return OMPI_SUCCESS;
 }
@@ -40,7 +40,8 @@ ompi_coll_han_components available_components[COMPONENTS_COUNT] = {
     { TUNED, "tuned", NULL },
     { SM, "sm", NULL },
     { ADAPT, "adapt", NULL },
-    { HAN, "han", NULL }
+    { HAN, "han", NULL },
+    { MCAST, "mcast", NULL }
 };
 
 /*
@@ -141,6 +142,14 @@ const char* mca_coll_han_topo_lvl_to_str(TOPO_LVL_T topo_lvl)
             return "inter_node";
         case GLOBAL_COMMUNICATOR:
             return "global_communicator";
+        case INTRA_SOCKET:
+            return "intra_socket";
+        case INTER_SOCKET:
+            return "inter_socket";
+        case INTRA_GROUP:
+            return "intra_group";
+        case INTER_GROUP:
+            return "inter_group";
         case NB_TOPO_LVL:
         default:
             return "invalid topologic level";
@@ -273,6 +282,42 @@ static int han_register(void)
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY, &cs->han_scatter_low_module);
 
+    cs->han_reduce_scatter_segsize = 524288;
+    (void) mca_base_component_var_register(c, "reduce_scatter_segsize",
+                                           "segment size for reduce_scatter and reduce_scatter_block, "
+                                           "covering the same slice of all the blocks",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &cs->han_reduce_scatter_segsize);
+
+    cs->han_leaders = 1;
+    (void) mca_base_component_var_register(c, "leaders",
+                                           "number of processes per node taking part in the inter-node "
+                                           "phase of the simple bcast and allreduce, each one with a slice "
+                                           "of the message (the ones closest to distinct NICs first). "
+                                           "Can be set per message size in the dynamic rules",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &cs->han_leaders);
+
+    cs->han_socket_level = false;
+    (void) mca_base_component_var_register(c, "socket_level",
+                                           "whether the simple bcast and allreduce go through the "
+                                           "sockets of the nodes as an extra topological level",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &cs->han_socket_level);
+
+    cs->han_group_size = 0;
+    (void) mca_base_component_var_register(c, "group_size",
+                                           "number of consecutive nodes per group of nodes (e.g. behind "
+                                           "the same switch) in the simple bcast and allreduce, "
+                                           "0 for no group level unless the communicator has the "
+                                           "ompi_comm_coll_han_group info key set to the group of the process",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &cs->han_group_size);
+
     cs->han_reproducible = 0;
     (void) mca_base_component_var_register(c, "reproducible",
                                            "whether we need reproducible results "
@@ -282,6 +327,15 @@ static int han_register(void)
                                            OPAL_INFO_LVL_3,
                                            MCA_BASE_VAR_SCOPE_READONLY, &cs->han_reproducible);
 
+    cs->han_nonblocking = true;
+    (void) mca_base_component_var_register(c, "nonblocking",
+                                           "whether han provides the hierarchical ibcast, "
+                                           "iallreduce and iallgather, and their persistent "
+                                           "versions, 0 disable 1 enable, default 1",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &cs->han_nonblocking);
+
     /*
      * Simple algorithms MCA parameters :
      * using simple algorithms will just perform hierarchical communications.
@@ -306,7 +360,7 @@ static int han_register(void)
 
     /* Dynamic rules MCA parameters */
     memset(cs->mca_rules, 0,
-           COLLCOUNT * (GLOBAL_COMMUNICATOR+1) * sizeof(COMPONENT_T));
+           COLLCOUNT * NB_TOPO_LVL * sizeof(COMPONENT_T));
 
     for(coll = 0; coll < COLLCOUNT; coll++) {
         if(!mca_coll_han_is_coll_dynamic_implemented(coll)) {
@@ -318,6 +372,10 @@ static int han_register(void)
         cs->mca_rules[coll][INTRA_NODE] = TUNED;
         cs->mca_rules[coll][INTER_NODE] = BASIC;
         cs->mca_rules[coll][GLOBAL_COMMUNICATOR] = HAN;
+        cs->mca_rules[coll][INTRA_SOCKET] = TUNED;
+        cs->mca_rules[coll][INTER_SOCKET] = TUNED;
+        cs->mca_rules[coll][INTRA_GROUP] = BASIC;
+        cs->mca_rules[coll][INTER_GROUP] = BASIC;
     }
     /* Specific default values */
     cs->mca_rules[BARRIER][INTER_NODE] = TUNED;
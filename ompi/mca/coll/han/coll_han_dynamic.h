@@ -103,6 +103,7 @@ typedef enum COMPONENTS {
     SM,
     ADAPT,
     HAN,
+    MCAST,
     COMPONENTS_COUNT
 } COMPONENT_T;
 
@@ -120,6 +121,14 @@ typedef enum TOPO_LVL {
     INTER_NODE,
     /* Identifies the global communicator as a topologic level */
     GLOBAL_COMMUNICATOR,
+    /* Optional levels of the simple bcast and allreduce: the sockets
+     * inside a node and the groups of nodes (e.g. behind the same
+     * switch). They come after the global communicator to keep the
+     * identifiers of the rules files. */
+    INTRA_SOCKET,
+    INTER_SOCKET,
+    INTRA_GROUP,
+    INTER_GROUP,
     NB_TOPO_LVL
 } TOPO_LVL_T;
 
@@ -138,6 +147,10 @@ typedef struct msg_size_rule_s {
     /* Component to use on this specific configuration
      * and message size */
     COMPONENT_T component;
+
+    /* Number of node leaders of the inter-node phase,
+     * 0 to use the leaders MCA parameter */
+    int leaders;
 } msg_size_rule_t;
 
 /* Rule for a specific configuration
@@ -339,6 +339,7 @@ mca_coll_han_init_dynamic_rules(void)
                     msg_size_rules[l].configuration_size = conf_size;
                     msg_size_rules[l].msg_size = msg_size;
                     msg_size_rules[l].component = (COMPONENT_T)component;
+                    msg_size_rules[l].leaders = 0;
 
                     nb_entries++;
                     /* do we have the optional segment length */
@@ -365,6 +366,29 @@ mca_coll_han_init_dynamic_rules(void)
                             }
                         }
                     }
+                    /* do we have the optional number of node leaders */
+                    if( 1 == ompi_coll_base_file_peek_next_char_is(fptr, &fileline, '{') ) {
+                        long leaders;
+                        if( getnext_long(fptr, &leaders) || (leaders < 1) ||
+                            (1 != ompi_coll_base_file_peek_next_char_is(fptr, &fileline, '}')) ) {
+                            opal_output_verbose(5, mca_coll_han_component.han_output,
+                                                "coll:han:mca_coll_han_init_dynamic_rules "
+                                                "file %s line %d found an invalid number of node leaders "
+                                                "for collective %s component %s\n",
+                                                fname, fileline, coll_name, target_comp_name);
+                            free(target_comp_name);
+                            goto file_reading_error;
+                        }
+                        if( GLOBAL_COMMUNICATOR != topo_lvl ) {
+                            opal_output_verbose(5, mca_coll_han_component.han_output,
+                                                "coll:han:mca_coll_han_init_dynamic_rules "
+                                                "file %s line %d found a number of node leaders for a "
+                                                "collective on a sub-communicator for collective %s component %s. "
+                                                "This value will be ignored.\n",
+                                                fname, fileline, coll_name, target_comp_name);
+                        }
+                        msg_size_rules[l].leaders = (int)leaders;
+                    }
                     free(target_comp_name);
                 }
             }
@@ -609,10 +633,11 @@ void mca_coll_han_dump_dynamic_rules(void)
                     opal_output(mca_coll_han_component.han_output,
                                 "coll:han:dump_dynamic_rules %d collective %d (%s) "
                                 "topology level %d (%s) configuration size %d "
-                                "mesage size %d -> collective component %d (%s)\n",
+                                "mesage size %d -> collective component %d (%s) leaders %d\n",
                                 nb_entries, coll_id, mca_coll_base_colltype_to_str(coll_id),
                                 topo_lvl, mca_coll_han_topo_lvl_to_str(topo_lvl), conf_size,
-                                msg_size, component, available_components[component].component_name);
+                                msg_size, component, available_components[component].component_name,
+                                msg_size_rules[l].leaders);
 
                     nb_entries++;
                 }
@@ -54,7 +54,8 @@
  * Set of rules of level i+1
  *
  * A message size rule is built as follows:
- * Message_size Component
+ * Message_size Component [Segment lengths] {Leaders}
+ * where the segment lengths and the number of leaders are optional
  *
  * Rule properties are (by increasing level):
  *     - Collective identifier:
@@ -75,6 +76,11 @@
  *           the component identifier to use for this collective on this
  *           communicator with this message size. Components identifier are
  *           defined in coll_han_dynamic.h
+ *     - Leaders:
+ *           Only for the GLOBAL_COMMUNICATOR topologic level, the number of
+ *           processes per node taking part in the inter-node phase of the
+ *           simple bcast and allreduce, each one with a slice of the message.
+ *           It overrides the leaders MCA parameter for this message size.
  *
  * Here is an example of a dynamic rules file:
  * 2 # Collective count
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Optional topological levels around the intra-node and inter-node ones:
+ * the sockets inside a node, and the groups of nodes (e.g. the nodes behind
+ * the same switch, or the same electrical group of a dragonfly network).
+ *
+ * The levels are built like the existing ones. INTRA_SOCKET contains the
+ * processes of a node sharing a socket, and INTER_SOCKET the processes of
+ * the node with the same rank in their socket. INTRA_GROUP contains the
+ * processes of an inter-node communicator whose nodes are in the same
+ * group, and INTER_GROUP the ones with the same rank in their group.
+ * A level is only used if all the sockets (resp. groups) have the same
+ * size, so that the inter level connects all of them.
+ */
+
+#include "ompi_config.h"
+
+#include <stdlib.h>
+
+#include "mpi.h"
+#include "coll_han.h"
+#include "coll_han_dynamic.h"
+
+/*
+ * Split the intra comm into the processes with the same color, and the
+ * result by rank into the inter comm. ranks gets the ranks of all the
+ * processes of parent at both levels. Returns false, without any
+ * communicator, if the levels are not balanced on all of comm.
+ */
+static bool
+han_levels_split(struct ompi_communicator_t *comm,
+                 ompi_communicator_t *parent, int color,
+                 TOPO_LVL_T intra_lvl, TOPO_LVL_T inter_lvl,
+                 const char *intra_name, const char *inter_name,
+                 mca_coll_han_module_t *han_module, int **ranks)
+{
+    ompi_communicator_t **intra = &(han_module->sub_comm[intra_lvl]);
+    ompi_communicator_t **inter = &(han_module->sub_comm[inter_lvl]);
+    int parent_rank = ompi_comm_rank(parent);
+    int parent_size = ompi_comm_size(parent);
+    int my_ranks[2], check[3], size;
+    opal_info_t comm_info;
+
+    OBJ_CONSTRUCT(&comm_info, opal_info_t);
+    opal_info_set(&comm_info, "ompi_comm_coll_han_topo_level", intra_name);
+    if (INTRA_SOCKET == intra_lvl) {
+        ompi_comm_split_type(parent, OMPI_COMM_TYPE_SOCKET, parent_rank,
+                             &comm_info, intra);
+    } else {
+        ompi_comm_split_with_info(parent, color, parent_rank, &comm_info, intra, false);
+    }
+    opal_info_set(&comm_info, "ompi_comm_coll_han_topo_level", inter_name);
+    ompi_comm_split_with_info(parent, ompi_comm_rank(*intra), parent_rank,
+                              &comm_info, inter, false);
+    OBJ_DESTRUCT(&comm_info);
+
+    /* same size everywhere, and more than one process at both levels */
+    size = ompi_comm_size(*intra);
+    check[0] = size;
+    check[1] = -size;
+    check[2] = (size > 1 && size < parent_size) ? 0 : 1;
+    comm->c_coll->coll_allreduce(MPI_IN_PLACE, check, 3, MPI_INT, MPI_MAX,
+                                 comm, comm->c_coll->coll_allreduce_module);
+
+    *ranks = NULL;
+    if (check[0] == -check[1] && 0 == check[2]) {
+        *ranks = (int *)malloc(2 * parent_size * sizeof(int));
+    }
+    if (NULL != *ranks) {
+        my_ranks[0] = ompi_comm_rank(*intra);
+        my_ranks[1] = ompi_comm_rank(*inter);
+        parent->c_coll->coll_allgather(my_ranks, 2, MPI_INT, *ranks, 2, MPI_INT,
+                                       parent, parent->c_coll->coll_allgather_module);
+        return true;
+    }
+
+    ompi_comm_free(intra);
+    ompi_comm_free(inter);
+    *intra = NULL;
+    *inter = NULL;
+    return false;
+}
+
+/*
+ * Create the socket and group levels enabled by the MCA parameters or the
+ * communicator info. Called during the creation of the intra-node and
+ * inter-node sub-communicators, with the fallback collectives on comm.
+ */
+void
+mca_coll_han_levels_create(struct ompi_communicator_t *comm,
+                           mca_coll_han_module_t *han_module)
+{
+    ompi_communicator_t *low_comm = han_module->sub_comm[INTRA_NODE];
+    ompi_communicator_t *up_comm = han_module->sub_comm[INTER_NODE];
+    int enabled[2], group = -1;
+
+    enabled[0] = mca_coll_han_component.han_socket_level ? 1 : 0;
+
+    /* the group of the node is the one its first process sees */
+    if (NULL != comm->super.s_info) {
+        opal_cstring_t *info_str;
+        int flag;
+
+        opal_info_get(comm->super.s_info, "ompi_comm_coll_han_group", &info_str, &flag);
+        if (flag) {
+            group = atoi(info_str->string);
+            OBJ_RELEASE(info_str);
+        }
+    }
+    if (group < 0 && mca_coll_han_component.han_group_size > 0) {
+        group = ompi_comm_rank(up_comm) / mca_coll_han_component.han_group_size;
+    }
+    low_comm->c_coll->coll_bcast(&group, 1, MPI_INT, 0,
+                                 low_comm, low_comm->c_coll->coll_bcast_module);
+    enabled[1] = (group >= 0) ? 1 : 0;
+
+    /* all the processes must agree on the levels to create */
+    comm->c_coll->coll_allreduce(MPI_IN_PLACE, enabled, 2, MPI_INT, MPI_MIN,
+                                 comm, comm->c_coll->coll_allreduce_module);
+
+    if (enabled[0]) {
+        han_module->use_socket_level =
+            han_levels_split(comm, low_comm, 0, INTRA_SOCKET, INTER_SOCKET,
+                             "INTRA_SOCKET", "INTER_SOCKET",
+                             han_module, &han_module->cached_socket_ranks);
+    }
+    if (enabled[1]) {
+        han_module->use_group_level =
+            han_levels_split(comm, up_comm, group, INTRA_GROUP, INTER_GROUP,
+                             "INTRA_GROUP", "INTER_GROUP",
+                             han_module, &han_module->cached_group_ranks);
+    }
+    opal_output_verbose(30, mca_coll_han_component.han_output,
+                        "coll:han:levels socket level %s, group level %s\n",
+                        han_module->use_socket_level ? "used" : "not used",
+                        han_module->use_group_level ? "used" : "not used");
+}
+
+/*
+ * Reduce inside the node to its rank 0, through the sockets if enabled
+ */
+int
+mca_coll_han_levels_reduce_low(const void *sbuf, void *rbuf, int count,
+                               struct ompi_datatype_t *dtype, struct ompi_op_t *op,
+                               mca_coll_han_module_t *han_module)
+{
+    ompi_communicator_t *low_comm = han_module->sub_comm[INTRA_NODE];
+    ompi_communicator_t *sock_comm, *isock_comm;
+    int ret;
+
+    if (!han_module->use_socket_level) {
+        if (MPI_IN_PLACE != sbuf) {
+            return low_comm->c_coll->coll_reduce(sbuf, rbuf, count, dtype, op, 0,
+                                                 low_comm, low_comm->c_coll->coll_reduce_module);
+        }
+        return low_comm->c_coll->coll_reduce((0 == ompi_comm_rank(low_comm)) ? MPI_IN_PLACE : rbuf,
+                                             (0 == ompi_comm_rank(low_comm)) ? rbuf : NULL,
+                                             count, dtype, op, 0,
+                                             low_comm, low_comm->c_coll->coll_reduce_module);
+    }
+
+    /* the rank 0 of the node is the rank 0 of its socket and of the socket leaders */
+    sock_comm = han_module->sub_comm[INTRA_SOCKET];
+    isock_comm = han_module->sub_comm[INTER_SOCKET];
+    if (MPI_IN_PLACE != sbuf) {
+        ret = sock_comm->c_coll->coll_reduce(sbuf, rbuf, count, dtype, op, 0,
+                                             sock_comm, sock_comm->c_coll->coll_reduce_module);
+    } else {
+        ret = sock_comm->c_coll->coll_reduce((0 == ompi_comm_rank(sock_comm)) ? MPI_IN_PLACE : rbuf,
+                                             (0 == ompi_comm_rank(sock_comm)) ? rbuf : NULL,
+                                             count, dtype, op, 0,
+                                             sock_comm, sock_comm->c_coll->coll_reduce_module);
+    }
+    if (OMPI_SUCCESS != ret || 0 != ompi_comm_rank(sock_comm)) {
+        return ret;
+    }
+    return isock_comm->c_coll->coll_reduce((0 == ompi_comm_rank(isock_comm)) ? MPI_IN_PLACE : rbuf,
+                                           (0 == ompi_comm_rank(isock_comm)) ? rbuf : NULL,
+                                           count, dtype, op, 0,
+                                           isock_comm, isock_comm->c_coll->coll_reduce_module);
+}
+
+/*
+ * In place allreduce between the nodes, through the groups if enabled
+ */
+int
+mca_coll_han_levels_allreduce_up(void *rbuf, int count,
+                                 struct ompi_datatype_t *dtype, struct ompi_op_t *op,
+                                 mca_coll_han_module_t *han_module)
+{
+    ompi_communicator_t *up_comm = han_module->sub_comm[INTER_NODE];
+    ompi_communicator_t *group_comm, *igroup_comm;
+    int ret, group_rank;
+
+    if (!han_module->use_group_level) {
+        return up_comm->c_coll->coll_allreduce(MPI_IN_PLACE, rbuf, count, dtype, op,
+                                               up_comm, up_comm->c_coll->coll_allreduce_module);
+    }
+
+    group_comm = han_module->sub_comm[INTRA_GROUP];
+    igroup_comm = han_module->sub_comm[INTER_GROUP];
+    group_rank = ompi_comm_rank(group_comm);
+    ret = group_comm->c_coll->coll_reduce((0 == group_rank) ? MPI_IN_PLACE : rbuf,
+                                          (0 == group_rank) ? rbuf : NULL,
+                                          count, dtype, op, 0,
+                                          group_comm, group_comm->c_coll->coll_reduce_module);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+    if (0 == group_rank) {
+        ret = igroup_comm->c_coll->coll_allreduce(MPI_IN_PLACE, rbuf, count, dtype, op,
+                                                  igroup_comm, igroup_comm->c_coll->coll_allreduce_module);
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+    }
+    return group_comm->c_coll->coll_bcast(rbuf, count, dtype, 0,
+                                          group_comm, group_comm->c_coll->coll_bcast_module);
+}
+
+/*
+ * Bcast between the processes of the node, through the sockets if enabled
+ */
+int
+mca_coll_han_levels_bcast_low(void *buff, int count, struct ompi_datatype_t *dtype,
+                              int root_low_rank, mca_coll_han_module_t *han_module)
+{
+    ompi_communicator_t *low_comm = han_module->sub_comm[INTRA_NODE];
+    ompi_communicator_t *sock_comm, *isock_comm;
+    int root_sock_rank, ret;
+
+    if (!han_module->use_socket_level) {
+        return low_comm->c_coll->coll_bcast(buff, count, dtype, root_low_rank,
+                                            low_comm, low_comm->c_coll->coll_bcast_module);
+    }
+
+    sock_comm = han_module->sub_comm[INTRA_SOCKET];
+    isock_comm = han_module->sub_comm[INTER_SOCKET];
+    root_sock_rank = han_module->cached_socket_ranks[2 * root_low_rank];
+    if (ompi_comm_rank(sock_comm) == root_sock_rank) {
+        ret = isock_comm->c_coll->coll_bcast(buff, count, dtype,
+                                             han_module->cached_socket_ranks[2 * root_low_rank + 1],
+                                             isock_comm, isock_comm->c_coll->coll_bcast_module);
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+    }
+    return sock_comm->c_coll->coll_bcast(buff, count, dtype, root_sock_rank,
+                                         sock_comm, sock_comm->c_coll->coll_bcast_module);
+}
+
+/*
+ * Bcast between the nodes, through the groups if enabled
+ */
+int
+mca_coll_han_levels_bcast_up(void *buff, int count, struct ompi_datatype_t *dtype,
+                             int root_up_rank, mca_coll_han_module_t *han_module)
+{
+    ompi_communicator_t *up_comm = han_module->sub_comm[INTER_NODE];
+    ompi_communicator_t *group_comm, *igroup_comm;
+    int root_group_rank, ret;
+
+    if (!han_module->use_group_level) {
+        return up_comm->c_coll->coll_bcast(buff, count, dtype, root_up_rank,
+                                           up_comm, up_comm->c_coll->coll_bcast_module);
+    }
+
+    group_comm = han_module->sub_comm[INTRA_GROUP];
+    igroup_comm = han_module->sub_comm[INTER_GROUP];
+    root_group_rank = han_module->cached_group_ranks[2 * root_up_rank];
+    if (ompi_comm_rank(group_comm) == root_group_rank) {
+        ret = igroup_comm->c_coll->coll_bcast(buff, count, dtype,
+                                              han_module->cached_group_ranks[2 * root_up_rank + 1],
+                                              igroup_comm, igroup_comm->c_coll->coll_bcast_module);
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+    }
+    return group_comm->c_coll->coll_bcast(buff, count, dtype, root_group_rank,
+                                          group_comm, group_comm->c_coll->coll_bcast_module);
+}
@@ -16,6 +16,7 @@
 #include "mpi.h"
 #include "coll_han.h"
 #include "coll_han_dynamic.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
 
 
 /*
@@ -45,11 +46,21 @@ static void han_module_clear(mca_coll_han_module_t *han_module)
     CLEAN_PREV_COLL(han_module, allgather);
     CLEAN_PREV_COLL(han_module, allgatherv);
     CLEAN_PREV_COLL(han_module, allreduce);
+    CLEAN_PREV_COLL(han_module, alltoall);
+    CLEAN_PREV_COLL(han_module, alltoallv);
     CLEAN_PREV_COLL(han_module, barrier);
     CLEAN_PREV_COLL(han_module, bcast);
     CLEAN_PREV_COLL(han_module, reduce);
+    CLEAN_PREV_COLL(han_module, reduce_scatter);
+    CLEAN_PREV_COLL(han_module, reduce_scatter_block);
     CLEAN_PREV_COLL(han_module, gather);
     CLEAN_PREV_COLL(han_module, scatter);
+    CLEAN_PREV_COLL(han_module, iallgather);
+    CLEAN_PREV_COLL(han_module, iallreduce);
+    CLEAN_PREV_COLL(han_module, ibcast);
+    CLEAN_PREV_COLL(han_module, allgather_init);
+    CLEAN_PREV_COLL(han_module, allreduce_init);
+    CLEAN_PREV_COLL(han_module, bcast_init);
 
     han_module->reproducible_reduce = NULL;
     han_module->reproducible_reduce_module = NULL;
@@ -71,7 +82,14 @@ static void mca_coll_han_module_construct(mca_coll_han_module_t * module)
     module->cached_up_comms = NULL;
     module->cached_vranks = NULL;
     module->cached_topo = NULL;
+    module->cached_leaders = NULL;
+    module->cached_nleaders = 1;
+    module->use_socket_level = false;
+    module->use_group_level = false;
+    module->cached_socket_ranks = NULL;
+    module->cached_group_ranks = NULL;
     module->is_mapbycore = false;
+    module->reproducible_comm = false;
     module->storage_initialized = false;
     for( i = 0; i < NB_TOPO_LVL; i++ ) {
         module->sub_comm[i] = NULL;
@@ -135,6 +153,18 @@ mca_coll_han_module_destruct(mca_coll_han_module_t * module)
         free(module->cached_topo);
         module->cached_topo = NULL;
     }
+    if (module->cached_leaders != NULL) {
+        free(module->cached_leaders);
+        module->cached_leaders = NULL;
+    }
+    if (module->cached_socket_ranks != NULL) {
+        free(module->cached_socket_ranks);
+        module->cached_socket_ranks = NULL;
+    }
+    if (module->cached_group_ranks != NULL) {
+        free(module->cached_group_ranks);
+        module->cached_group_ranks = NULL;
+    }
     for(i=0 ; i<NB_TOPO_LVL ; i++) {
         if(NULL != module->sub_comm[i]) {
             ompi_comm_free(&(module->sub_comm[i]));
@@ -143,10 +173,20 @@ mca_coll_han_module_destruct(mca_coll_han_module_t * module)
 
     OBJ_RELEASE_IF_NOT_NULL(module->previous_allgather_module);
     OBJ_RELEASE_IF_NOT_NULL(module->previous_allreduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(module->previous_alltoall_module);
+    OBJ_RELEASE_IF_NOT_NULL(module->previous_alltoallv_module);
     OBJ_RELEASE_IF_NOT_NULL(module->previous_bcast_module);
     OBJ_RELEASE_IF_NOT_NULL(module->previous_gather_module);
     OBJ_RELEASE_IF_NOT_NULL(module->previous_reduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(module->previous_reduce_scatter_module);
+    OBJ_RELEASE_IF_NOT_NULL(module->previous_reduce_scatter_block_module);
     OBJ_RELEASE_IF_NOT_NULL(module->previous_scatter_module);
+    OBJ_RELEASE_IF_NOT_NULL(module->previous_iallgather_module);
+    OBJ_RELEASE_IF_NOT_NULL(module->previous_iallreduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(module->previous_ibcast_module);
+    OBJ_RELEASE_IF_NOT_NULL(module->previous_allgather_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(module->previous_allreduce_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(module->previous_bcast_init_module);
 
     han_module_clear(module);
 }
@@ -171,6 +211,29 @@ int mca_coll_han_init_query(bool enable_progress_threads,
 }
 
 
+/*
+ * The socket sub-communicators only have local processes, but han is still
+ * used there as the selector of the dynamic rules
+ */
+static bool han_comm_is_socket_level(struct ompi_communicator_t *comm)
+{
+    opal_cstring_t *info_str;
+    bool socket_level = false;
+    int flag;
+
+    if (NULL == comm->super.s_info) {
+        return false;
+    }
+    opal_info_get(comm->super.s_info, "ompi_comm_coll_han_topo_level",
+                  &info_str, &flag);
+    if (flag) {
+        socket_level = (0 == strcmp(info_str->string, "INTRA_SOCKET") ||
+                        0 == strcmp(info_str->string, "INTER_SOCKET"));
+        OBJ_RELEASE(info_str);
+    }
+    return socket_level;
+}
+
 /*
  * Invoked when there's a new communicator that has been created.
  * Look at the communicator and decide which set of functions and
@@ -197,7 +260,7 @@ mca_coll_han_comm_query(struct ompi_communicator_t * comm, int *priority)
                             comm->c_contextid, comm->c_name);
         return NULL;
     }
-    if( !ompi_group_have_remote_peers(comm->c_local_group) ) {
+    if( !ompi_group_have_remote_peers(comm->c_local_group) && !han_comm_is_socket_level(comm) ) {
         /* The group only contains local processes. Disable HAN for now */
         opal_output_verbose(10, ompi_coll_base_framework.framework_output,
                             "coll:han:comm_query (%d/%s): comm has only local processes; disqualifying myself",
@@ -231,33 +294,51 @@ mca_coll_han_comm_query(struct ompi_communicator_t * comm, int *priority)
         if (flag) {
             if (0 == strcmp(info_str->string, "INTER_NODE")) {
                 han_module->topologic_level = INTER_NODE;
+            } else if (0 == strcmp(info_str->string, "INTRA_SOCKET")) {
+                han_module->topologic_level = INTRA_SOCKET;
+            } else if (0 == strcmp(info_str->string, "INTER_SOCKET")) {
+                han_module->topologic_level = INTER_SOCKET;
+            } else if (0 == strcmp(info_str->string, "INTRA_GROUP")) {
+                han_module->topologic_level = INTRA_GROUP;
+            } else if (0 == strcmp(info_str->string, "INTER_GROUP")) {
+                han_module->topologic_level = INTER_GROUP;
             } else {
                 han_module->topologic_level = INTRA_NODE;
             }
             OBJ_RELEASE(info_str);
         }
     }
+    han_module->reproducible_comm = ompi_coll_base_comm_reproducible(comm);
 
     han_module->super.coll_module_enable = han_module_enable;
-    han_module->super.coll_alltoall   = NULL;
-    han_module->super.coll_alltoallv  = NULL;
     han_module->super.coll_alltoallw  = NULL;
     han_module->super.coll_exscan     = NULL;
     han_module->super.coll_gatherv    = NULL;
-    han_module->super.coll_reduce_scatter = NULL;
     han_module->super.coll_scan       = NULL;
     han_module->super.coll_scatterv   = NULL;
     han_module->super.coll_barrier    = mca_coll_han_barrier_intra_dynamic;
     han_module->super.coll_scatter    = mca_coll_han_scatter_intra_dynamic;
     han_module->super.coll_reduce     = mca_coll_han_reduce_intra_dynamic;
+    han_module->super.coll_reduce_scatter = mca_coll_han_reduce_scatter_intra_dynamic;
+    han_module->super.coll_reduce_scatter_block = mca_coll_han_reduce_scatter_block_intra_dynamic;
     han_module->super.coll_gather     = mca_coll_han_gather_intra_dynamic;
     han_module->super.coll_bcast      = mca_coll_han_bcast_intra_dynamic;
     han_module->super.coll_allreduce  = mca_coll_han_allreduce_intra_dynamic;
     han_module->super.coll_allgather  = mca_coll_han_allgather_intra_dynamic;
+    han_module->super.coll_alltoall   = mca_coll_han_alltoall_intra_dynamic;
+    han_module->super.coll_alltoallv  = mca_coll_han_alltoallv_intra_dynamic;
 
     if (GLOBAL_COMMUNICATOR == han_module->topologic_level) {
         /* We are on the global communicator, return topological algorithms */
         han_module->super.coll_allgatherv = NULL;
+        if (mca_coll_han_component.han_nonblocking) {
+            han_module->super.coll_ibcast         = mca_coll_han_ibcast_intra;
+            han_module->super.coll_iallreduce     = mca_coll_han_iallreduce_intra;
+            han_module->super.coll_iallgather     = mca_coll_han_iallgather_intra;
+            han_module->super.coll_bcast_init     = mca_coll_han_bcast_init_intra;
+            han_module->super.coll_allreduce_init = mca_coll_han_allreduce_init_intra;
+            han_module->super.coll_allgather_init = mca_coll_han_allgather_init_intra;
+        }
     } else {
         /* We are on a topologic sub-communicator, return only the selector */
         han_module->super.coll_allgatherv = mca_coll_han_allgatherv_intra_dynamic;
@@ -289,6 +370,24 @@ mca_coll_han_comm_query(struct ompi_communicator_t * comm, int *priority)
         OBJ_RETAIN(han_module->previous_ ## __api ## _module);  \
     } while(0)
 
+/*
+ * Same for the collectives han only provides when there is one below,
+ * they are left to the other components otherwise
+ */
+#define HAN_SAVE_PREV_COLL_API_OPTIONAL(__api)                          \
+    do {                                                                \
+        if (NULL == han_module->super.coll_ ## __api) {                 \
+            break;                                                      \
+        }                                                               \
+        if (!comm->c_coll->coll_ ## __api || !comm->c_coll->coll_ ## __api ## _module) { \
+            han_module->super.coll_ ## __api = NULL;                    \
+            break;                                                      \
+        }                                                               \
+        han_module->previous_ ## __api            = comm->c_coll->coll_ ## __api; \
+        han_module->previous_ ## __api ## _module = comm->c_coll->coll_ ## __api ## _module; \
+        OBJ_RETAIN(han_module->previous_ ## __api ## _module);          \
+    } while(0)
+
 /*
  * Init module on the communicator
  */
@@ -301,11 +400,21 @@ han_module_enable(mca_coll_base_module_t * module,
     HAN_SAVE_PREV_COLL_API(allgather);
     HAN_SAVE_PREV_COLL_API(allgatherv);
     HAN_SAVE_PREV_COLL_API(allreduce);
+    HAN_SAVE_PREV_COLL_API(alltoall);
+    HAN_SAVE_PREV_COLL_API(alltoallv);
     HAN_SAVE_PREV_COLL_API(barrier);
     HAN_SAVE_PREV_COLL_API(bcast);
     HAN_SAVE_PREV_COLL_API(gather);
     HAN_SAVE_PREV_COLL_API(reduce);
+    HAN_SAVE_PREV_COLL_API(reduce_scatter);
+    HAN_SAVE_PREV_COLL_API(reduce_scatter_block);
     HAN_SAVE_PREV_COLL_API(scatter);
+    HAN_SAVE_PREV_COLL_API_OPTIONAL(iallgather);
+    HAN_SAVE_PREV_COLL_API_OPTIONAL(iallreduce);
+    HAN_SAVE_PREV_COLL_API_OPTIONAL(ibcast);
+    HAN_SAVE_PREV_COLL_API_OPTIONAL(allgather_init);
+    HAN_SAVE_PREV_COLL_API_OPTIONAL(allreduce_init);
+    HAN_SAVE_PREV_COLL_API_OPTIONAL(bcast_init);
 
     /* set reproducible algos */
     mca_coll_han_reduce_reproducible_decision(comm, module);
@@ -317,10 +426,20 @@ handle_error:
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allgather_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allgatherv_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allreduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_alltoall_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_alltoallv_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_bcast_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_gather_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_reduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_reduce_scatter_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_reduce_scatter_block_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_scatter_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_iallgather_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_iallreduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_ibcast_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allgather_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allreduce_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_bcast_init_module);
 
     return OMPI_ERROR;
 }
@@ -337,11 +456,21 @@ mca_coll_han_module_disable(mca_coll_base_module_t * module,
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allgather_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allgatherv_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allreduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_alltoall_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_alltoallv_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_barrier_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_bcast_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_gather_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_reduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_reduce_scatter_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_reduce_scatter_block_module);
     OBJ_RELEASE_IF_NOT_NULL(han_module->previous_scatter_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_iallgather_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_iallreduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_ibcast_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allgather_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_allreduce_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(han_module->previous_bcast_init_module);
 
     han_module_clear(han_module);
 
@@ -0,0 +1,641 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Nonblocking and persistent versions of the simple bcast, allreduce and
+ * allgather.
+ *
+ * The phases of the blocking algorithms become tasks of a request, issued
+ * in order: a task either does some local work, or posts a nonblocking
+ * operation on the intra-node or inter-node communicator, whose completion
+ * callback issues the next task. The request completes with its last task.
+ *
+ * A persistent request creates the persistent operations of all its
+ * phases (and the intermediary buffers) once, when it is initialized, and
+ * every start only starts them again one after the other.
+ *
+ * The sub-communicators are still created by the first collective of the
+ * communicator, which is thus synchronizing.
+ */
+
+#include "ompi_config.h"
+
+#include <stdlib.h>
+
+#include "mpi.h"
+#include "coll_han.h"
+
+/*
+ * Post the operation of the current task on a sub-communicator: create it
+ * if the persistent request is being initialized, start it again if the
+ * persistent request is started, post the nonblocking one otherwise.
+ */
+#define HAN_NBC_ISSUE(REQ, COMM, COLL, ...)                                       \
+    ((REQ)->creating                                                              \
+     ? (COMM)->c_coll->coll_ ## COLL ## _init(__VA_ARGS__, (COMM), (REQ)->info,   \
+                                              &(REQ)->persistent_reqs[(REQ)->step], \
+                                              (COMM)->c_coll->coll_ ## COLL ## _init_module) \
+     : (REQ)->super.req_persistent                                                \
+     ? han_nbc_restart(REQ)                                                       \
+     : (COMM)->c_coll->coll_i ## COLL(__VA_ARGS__, (COMM), &(REQ)->sub_req,       \
+                                      (COMM)->c_coll->coll_i ## COLL ## _module))
+
+/* whether the sub-communicator provides the operation of a phase */
+#define HAN_NBC_PROVIDED(PERSISTENT, COMM, COLL)                                  \
+    ((PERSISTENT) ? NULL != (COMM)->c_coll->coll_ ## COLL ## _init                \
+                  : NULL != (COMM)->c_coll->coll_i ## COLL)
+
+static int han_nbc_advance(mca_coll_han_nbc_request_t *req);
+
+static void han_nbc_request_construct(mca_coll_han_nbc_request_t *req)
+{
+    req->han_module = NULL;
+    req->comm = NULL;
+    req->info = NULL;
+    req->nsteps = 0;
+    req->step = 0;
+    req->creating = false;
+    req->sub_req = NULL;
+    for (int i = 0; i < COLL_HAN_NBC_MAX_STEPS; i++) {
+        req->persistent_reqs[i] = NULL;
+    }
+    req->sbuf = NULL;
+    req->rbuf = NULL;
+    req->sdtype = NULL;
+    req->rdtype = NULL;
+    req->op = NULL;
+    req->tmp_buf = NULL;
+    req->tmp_buf_start = NULL;
+    req->reorder_buf = NULL;
+    req->reorder_buf_start = NULL;
+    req->topo = NULL;
+}
+
+OBJ_CLASS_INSTANCE(mca_coll_han_nbc_request_t, ompi_request_t,
+                   han_nbc_request_construct, NULL);
+
+static int han_nbc_request_free(ompi_request_t **request)
+{
+    mca_coll_han_nbc_request_t *req = (mca_coll_han_nbc_request_t *) *request;
+
+    if (!REQUEST_COMPLETE(&req->super)) {
+        return MPI_ERR_REQUEST;
+    }
+
+    for (int i = 0; i < req->nsteps; i++) {
+        if (NULL != req->persistent_reqs[i]) {
+            req->persistent_reqs[i]->req_free(&req->persistent_reqs[i]);
+        }
+        OBJ_DESTRUCT(&req->tasks[i]);
+    }
+    if (req->super.req_persistent) {
+        if (NULL != req->sdtype) {
+            OBJ_RELEASE(req->sdtype);
+        }
+        if (NULL != req->rdtype) {
+            OBJ_RELEASE(req->rdtype);
+        }
+        if (NULL != req->op) {
+            OBJ_RELEASE(req->op);
+        }
+    }
+    free(req->tmp_buf);
+    free(req->reorder_buf);
+
+    OMPI_REQUEST_FINI(&req->super);
+    req->super.req_state = OMPI_REQUEST_INVALID;
+    OBJ_RELEASE(req);
+    *request = MPI_REQUEST_NULL;
+    return OMPI_SUCCESS;
+}
+
+static int han_nbc_request_cancel(ompi_request_t *request, int complete)
+{
+    return MPI_ERR_REQUEST;
+}
+
+static int han_nbc_request_start(size_t count, ompi_request_t **requests)
+{
+    for (size_t i = 0; i < count; i++) {
+        mca_coll_han_nbc_request_t *req = (mca_coll_han_nbc_request_t *) requests[i];
+
+        req->step = 0;
+        req->super.req_status.MPI_ERROR = OMPI_SUCCESS;
+        req->super.req_complete = REQUEST_PENDING;
+        req->super.req_state = OMPI_REQUEST_ACTIVE;
+        han_nbc_advance(req);
+    }
+    return OMPI_SUCCESS;
+}
+
+static mca_coll_han_nbc_request_t *
+han_nbc_request_alloc(struct ompi_communicator_t *comm, mca_coll_han_module_t *han_module,
+                      bool persistent, struct ompi_info_t *info)
+{
+    mca_coll_han_nbc_request_t *req = OBJ_NEW(mca_coll_han_nbc_request_t);
+
+    if (NULL == req) {
+        return NULL;
+    }
+    OMPI_REQUEST_INIT(&req->super, persistent);
+    req->super.req_type = OMPI_REQUEST_COLL;
+    req->super.req_free = han_nbc_request_free;
+    req->super.req_cancel = han_nbc_request_cancel;
+    if (persistent) {
+        req->super.req_start = han_nbc_request_start;
+    }
+    req->super.req_status.MPI_SOURCE = 0;
+    req->super.req_status.MPI_TAG = 0;
+    req->super.req_status.MPI_ERROR = 0;
+    req->super.req_status._cancelled = 0;
+    req->super.req_status._ucount = 0;
+    req->han_module = han_module;
+    req->comm = comm;
+    req->info = info;
+    return req;
+}
+
+static void han_nbc_add_task(mca_coll_han_nbc_request_t *req, task_func_ptr func)
+{
+    assert(req->nsteps < COLL_HAN_NBC_MAX_STEPS);
+    init_task(&req->tasks[req->nsteps], func, req);
+    req->nsteps++;
+}
+
+/* start the persistent operation of the current task */
+static int han_nbc_restart(mca_coll_han_nbc_request_t *req)
+{
+    ompi_request_t *sub_req = req->persistent_reqs[req->step];
+    int ret;
+
+    ret = sub_req->req_start(1, &sub_req);
+    if (OMPI_SUCCESS == ret) {
+        req->sub_req = sub_req;
+    }
+    return ret;
+}
+
+/* completion of the operation of a task: issue the next ones */
+static int han_nbc_sub_complete(ompi_request_t *sub_req)
+{
+    mca_coll_han_nbc_request_t *req = (mca_coll_han_nbc_request_t *) sub_req->req_complete_cb_data;
+
+    if (MPI_SUCCESS != sub_req->req_status.MPI_ERROR) {
+        req->super.req_status.MPI_ERROR = sub_req->req_status.MPI_ERROR;
+        req->step = req->nsteps;
+    }
+    /* nobody waits for the sub-request, it is marked complete here so that
+     * it can be freed, or started again, before the callback returns */
+    sub_req->req_complete = REQUEST_COMPLETED;
+    if (!sub_req->req_persistent) {
+        sub_req->req_free(&sub_req);
+    }
+    han_nbc_advance(req);
+    return 1;
+}
+
+/*
+ * Issue the tasks from the current one until one has an operation in
+ * flight, and complete the request after the last one
+ */
+static int han_nbc_advance(mca_coll_han_nbc_request_t *req)
+{
+    int ret;
+
+    while (req->step < req->nsteps) {
+        req->sub_req = NULL;
+        ret = issue_task(&req->tasks[req->step]);
+        req->step++;
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+            OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                                 "HAN/NBC: step %d failed.\n", req->step - 1));
+            /* Do not fallback: the other processes may already be in the next phases */
+            req->super.req_status.MPI_ERROR = ret;
+            break;
+        }
+        if (NULL != req->sub_req) {
+            /* the callback is called right away if the operation is already complete */
+            ompi_request_set_callback(req->sub_req, han_nbc_sub_complete, req);
+            return OMPI_SUCCESS;
+        }
+    }
+
+    ompi_request_complete(&req->super, true);
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Return the request of a nonblocking collective with its first operation
+ * in flight, or create the operations of a persistent one
+ */
+static int han_nbc_launch(mca_coll_han_nbc_request_t *req, ompi_request_t **request)
+{
+    int ret;
+
+    if (!req->super.req_persistent) {
+        req->super.req_state = OMPI_REQUEST_ACTIVE;
+        *request = &req->super;
+        return han_nbc_advance(req);
+    }
+
+    req->creating = true;
+    for (req->step = 0; req->step < req->nsteps; req->step++) {
+        ret = issue_task(&req->tasks[req->step]);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+            req->creating = false;
+            han_nbc_request_free((ompi_request_t **) &req);
+            return ret;
+        }
+    }
+    req->creating = false;
+    *request = &req->super;
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Create the sub-communicators and gather the topology, returns false
+ * if han cannot be used on this communicator (the fallback collectives
+ * are then loaded)
+ */
+static bool han_nbc_comm_ready(struct ompi_communicator_t *comm,
+                               mca_coll_han_module_t *han_module)
+{
+    if (OMPI_SUCCESS != mca_coll_han_comm_create_new(comm, han_module)) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle nonblocking collectives with this communicator. "
+                             "Fall back on another component\n"));
+        HAN_LOAD_FALLBACK_COLLECTIVES(han_module, comm);
+        return false;
+    }
+    mca_coll_han_topo_init(comm, han_module, 2);
+    return true;
+}
+
+/*
+ * Bcast: the root's node leader broadcasts between the nodes, then all
+ * the node leaders on their node
+ */
+static int han_nbc_bcast_up(void *args)
+{
+    mca_coll_han_nbc_request_t *req = (mca_coll_han_nbc_request_t *) args;
+    ompi_communicator_t *up_comm = req->han_module->sub_comm[INTER_NODE];
+
+    return HAN_NBC_ISSUE(req, up_comm, bcast, req->rbuf, req->rcount, req->rdtype,
+                         req->root_up_rank);
+}
+
+static int han_nbc_bcast_low(void *args)
+{
+    mca_coll_han_nbc_request_t *req = (mca_coll_han_nbc_request_t *) args;
+    ompi_communicator_t *low_comm = req->han_module->sub_comm[INTRA_NODE];
+
+    return HAN_NBC_ISSUE(req, low_comm, bcast, req->rbuf, req->rcount, req->rdtype,
+                         req->root_low_rank);
+}
+
+static int
+han_nbc_bcast(void *buff, int count, struct ompi_datatype_t *dtype, int root,
+              struct ompi_communicator_t *comm, bool persistent, struct ompi_info_t *info,
+              ompi_request_t **request, mca_coll_han_module_t *han_module)
+{
+    mca_coll_han_nbc_request_t *req;
+    ompi_communicator_t *low_comm, *up_comm;
+
+    if (!han_nbc_comm_ready(comm, han_module)) {
+        return persistent
+            ? comm->c_coll->coll_bcast_init(buff, count, dtype, root, comm, info, request,
+                                            comm->c_coll->coll_bcast_init_module)
+            : comm->c_coll->coll_ibcast(buff, count, dtype, root, comm, request,
+                                        comm->c_coll->coll_ibcast_module);
+    }
+    low_comm = han_module->sub_comm[INTRA_NODE];
+    up_comm = han_module->sub_comm[INTER_NODE];
+    if (han_module->are_ppn_imbalanced
+        || !HAN_NBC_PROVIDED(persistent, low_comm, bcast)
+        || !HAN_NBC_PROVIDED(persistent, up_comm, bcast)) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle ibcast with this communicator. "
+                             "Fall back on another component\n"));
+        goto prev_bcast;
+    }
+
+    req = han_nbc_request_alloc(comm, han_module, persistent, info);
+    if (NULL == req) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    req->rbuf = buff;
+    req->rcount = count;
+    req->rdtype = dtype;
+    mca_coll_han_get_ranks(han_module->cached_vranks, root, ompi_comm_size(low_comm),
+                           &req->root_low_rank, &req->root_up_rank);
+    if (persistent) {
+        OBJ_RETAIN(dtype);
+    }
+
+    if (ompi_comm_rank(low_comm) == req->root_low_rank) {
+        han_nbc_add_task(req, han_nbc_bcast_up);
+    }
+    han_nbc_add_task(req, han_nbc_bcast_low);
+
+    return han_nbc_launch(req, request);
+
+ prev_bcast:
+    return persistent
+        ? han_module->previous_bcast_init(buff, count, dtype, root, comm, info, request,
+                                          han_module->previous_bcast_init_module)
+        : han_module->previous_ibcast(buff, count, dtype, root, comm, request,
+                                      han_module->previous_ibcast_module);
+}
+
+int
+mca_coll_han_ibcast_intra(void *buff, int count, struct ompi_datatype_t *dtype, int root,
+                          struct ompi_communicator_t *comm, ompi_request_t **request,
+                          mca_coll_base_module_t *module)
+{
+    return han_nbc_bcast(buff, count, dtype, root, comm, false, NULL, request,
+                         (mca_coll_han_module_t *) module);
+}
+
+int
+mca_coll_han_bcast_init_intra(void *buff, int count, struct ompi_datatype_t *dtype, int root,
+                              struct ompi_communicator_t *comm, struct ompi_info_t *info,
+                              ompi_request_t **request, mca_coll_base_module_t *module)
+{
+    return han_nbc_bcast(buff, count, dtype, root, comm, true, info, request,
+                         (mca_coll_han_module_t *) module);
+}
+
+/*
+ * Allreduce: reduce on the node leaders, allreduce between them, and
+ * bcast on the nodes
+ */
+static int han_nbc_allreduce_low(void *args)
+{
+    mca_coll_han_nbc_request_t *req = (mca_coll_han_nbc_request_t *) args;
+    ompi_communicator_t *low_comm = req->han_module->sub_comm[INTRA_NODE];
+    bool leader = (0 == ompi_comm_rank(low_comm));
+
+    if (MPI_IN_PLACE != req->sbuf) {
+        return HAN_NBC_ISSUE(req, low_comm, reduce, req->sbuf, req->rbuf, req->rcount,
+                             req->rdtype, req->op, 0);
+    }
+    return HAN_NBC_ISSUE(req, low_comm, reduce, leader ? MPI_IN_PLACE : req->rbuf,
+                         leader ? req->rbuf : NULL, req->rcount, req->rdtype, req->op, 0);
+}
+
+static int han_nbc_allreduce_up(void *args)
+{
+    mca_coll_han_nbc_request_t *req = (mca_coll_han_nbc_request_t *) args;
+    ompi_communicator_t *up_comm = req->han_module->sub_comm[INTER_NODE];
+
+    return HAN_NBC_ISSUE(req, up_comm, allreduce, MPI_IN_PLACE, req->rbuf, req->rcount,
+                         req->rdtype, req->op);
+}
+
+static int
+han_nbc_allreduce(const void *sbuf, void *rbuf, int count, struct ompi_datatype_t *dtype,
+                  struct ompi_op_t *op, struct ompi_communicator_t *comm, bool persistent,
+                  struct ompi_info_t *info, ompi_request_t **request,
+                  mca_coll_han_module_t *han_module)
+{
+    mca_coll_han_nbc_request_t *req;
+    ompi_communicator_t *low_comm, *up_comm;
+
+    /* Fallback to another component if the op cannot commute, or for reproducible results */
+    if (!ompi_op_is_commute(op) || mca_coll_han_component.han_reproducible) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle iallreduce with this operation. "
+                             "Fall back on another component\n"));
+        goto prev_allreduce;
+    }
+    if (!han_nbc_comm_ready(comm, han_module)) {
+        return persistent
+            ? comm->c_coll->coll_allreduce_init(sbuf, rbuf, count, dtype, op, comm, info, request,
+                                                comm->c_coll->coll_allreduce_init_module)
+            : comm->c_coll->coll_iallreduce(sbuf, rbuf, count, dtype, op, comm, request,
+                                            comm->c_coll->coll_iallreduce_module);
+    }
+    low_comm = han_module->sub_comm[INTRA_NODE];
+    up_comm = han_module->sub_comm[INTER_NODE];
+    if (!HAN_NBC_PROVIDED(persistent, low_comm, reduce)
+        || !HAN_NBC_PROVIDED(persistent, up_comm, allreduce)
+        || !HAN_NBC_PROVIDED(persistent, low_comm, bcast)) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle iallreduce with this communicator. "
+                             "Fall back on another component\n"));
+        goto prev_allreduce;
+    }
+
+    req = han_nbc_request_alloc(comm, han_module, persistent, info);
+    if (NULL == req) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    req->sbuf = sbuf;
+    req->rbuf = rbuf;
+    req->rcount = count;
+    req->rdtype = dtype;
+    req->op = op;
+    req->root_low_rank = 0;
+    if (persistent) {
+        OBJ_RETAIN(dtype);
+        OBJ_RETAIN(op);
+    }
+
+    han_nbc_add_task(req, han_nbc_allreduce_low);
+    if (0 == ompi_comm_rank(low_comm)) {
+        han_nbc_add_task(req, han_nbc_allreduce_up);
+    }
+    han_nbc_add_task(req, han_nbc_bcast_low);
+
+    return han_nbc_launch(req, request);
+
+ prev_allreduce:
+    return persistent
+        ? han_module->previous_allreduce_init(sbuf, rbuf, count, dtype, op, comm, info, request,
+                                              han_module->previous_allreduce_init_module)
+        : han_module->previous_iallreduce(sbuf, rbuf, count, dtype, op, comm, request,
+                                          han_module->previous_iallreduce_module);
+}
+
+int
+mca_coll_han_iallreduce_intra(const void *sbuf, void *rbuf, int count,
+                              struct ompi_datatype_t *dtype, struct ompi_op_t *op,
+                              struct ompi_communicator_t *comm, ompi_request_t **request,
+                              mca_coll_base_module_t *module)
+{
+    return han_nbc_allreduce(sbuf, rbuf, count, dtype, op, comm, false, NULL, request,
+                             (mca_coll_han_module_t *) module);
+}
+
+int
+mca_coll_han_allreduce_init_intra(const void *sbuf, void *rbuf, int count,
+                                  struct ompi_datatype_t *dtype, struct ompi_op_t *op,
+                                  struct ompi_communicator_t *comm, struct ompi_info_t *info,
+                                  ompi_request_t **request, mca_coll_base_module_t *module)
+{
+    return han_nbc_allreduce(sbuf, rbuf, count, dtype, op, comm, true, info, request,
+                             (mca_coll_han_module_t *) module);
+}
+
+/*
+ * Allgather: gather on the node leaders, allgather between them, reorder
+ * if the ranks are not mapped by core, and bcast on the nodes
+ */
+static int han_nbc_allgather_low(void *args)
+{
+    mca_coll_han_nbc_request_t *req = (mca_coll_han_nbc_request_t *) args;
+    ompi_communicator_t *low_comm = req->han_module->sub_comm[INTRA_NODE];
+    bool leader = (0 == ompi_comm_rank(low_comm));
+    ptrdiff_t rlb, rext;
+    char *send;
+
+    if (MPI_IN_PLACE != req->sbuf) {
+        return HAN_NBC_ISSUE(req, low_comm, gather, req->sbuf, req->scount, req->sdtype,
+                             req->tmp_buf_start, req->rcount, req->rdtype, 0);
+    }
+
+    ompi_datatype_get_extent(req->rdtype, &rlb, &rext);
+    send = (char *) req->rbuf + (ptrdiff_t) ompi_comm_rank(req->comm) * (ptrdiff_t) req->rcount * rext;
+    if (!leader) {
+        return HAN_NBC_ISSUE(req, low_comm, gather, send, req->rcount, req->rdtype,
+                             NULL, req->rcount, req->rdtype, 0);
+    }
+    if (!req->creating) {
+        ompi_datatype_copy_content_same_ddt(req->rdtype, req->rcount, req->tmp_buf_start, send);
+    }
+    return HAN_NBC_ISSUE(req, low_comm, gather, MPI_IN_PLACE, req->rcount, req->rdtype,
+                         req->tmp_buf_start, req->rcount, req->rdtype, 0);
+}
+
+static int han_nbc_allgather_up(void *args)
+{
+    mca_coll_han_nbc_request_t *req = (mca_coll_han_nbc_request_t *) args;
+    ompi_communicator_t *low_comm = req->han_module->sub_comm[INTRA_NODE];
+    ompi_communicator_t *up_comm = req->han_module->sub_comm[INTER_NODE];
+    int low_size = ompi_comm_size(low_comm);
+
+    return HAN_NBC_ISSUE(req, up_comm, allgather, req->tmp_buf_start, req->rcount * low_size,
+                         req->rdtype, req->reorder_buf_start, req->rcount * low_size,
+                         req->rdtype);
+}
+
+static int han_nbc_allgather_reorder(void *args)
+{
+    mca_coll_han_nbc_request_t *req = (mca_coll_han_nbc_request_t *) args;
+
+    if (!req->creating) {
+        ompi_coll_han_reorder_gather(req->reorder_buf_start, req->rbuf, req->rcount,
+                                     req->rdtype, req->comm, req->topo);
+    }
+    return OMPI_SUCCESS;
+}
+
+static int han_nbc_allgather_bcast(void *args)
+{
+    mca_coll_han_nbc_request_t *req = (mca_coll_han_nbc_request_t *) args;
+    ompi_communicator_t *low_comm = req->han_module->sub_comm[INTRA_NODE];
+    ompi_communicator_t *up_comm = req->han_module->sub_comm[INTER_NODE];
+    int count = req->rcount * ompi_comm_size(low_comm) * ompi_comm_size(up_comm);
+
+    return HAN_NBC_ISSUE(req, low_comm, bcast, req->rbuf, count, req->rdtype, 0);
+}
+
+static int
+han_nbc_allgather(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                  void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                  struct ompi_communicator_t *comm, bool persistent, struct ompi_info_t *info,
+                  ompi_request_t **request, mca_coll_han_module_t *han_module)
+{
+    mca_coll_han_nbc_request_t *req;
+    ompi_communicator_t *low_comm, *up_comm;
+    int low_size, up_size;
+
+    if (!han_nbc_comm_ready(comm, han_module)) {
+        return persistent
+            ? comm->c_coll->coll_allgather_init(sbuf, scount, sdtype, rbuf, rcount, rdtype,
+                                                comm, info, request,
+                                                comm->c_coll->coll_allgather_init_module)
+            : comm->c_coll->coll_iallgather(sbuf, scount, sdtype, rbuf, rcount, rdtype,
+                                            comm, request, comm->c_coll->coll_iallgather_module);
+    }
+    low_comm = han_module->sub_comm[INTRA_NODE];
+    up_comm = han_module->sub_comm[INTER_NODE];
+    if (han_module->are_ppn_imbalanced
+        || !HAN_NBC_PROVIDED(persistent, low_comm, gather)
+        || !HAN_NBC_PROVIDED(persistent, up_comm, allgather)
+        || !HAN_NBC_PROVIDED(persistent, low_comm, bcast)) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle iallgather with this communicator. "
+                             "Fall back on another component\n"));
+        goto prev_allgather;
+    }
+    low_size = ompi_comm_size(low_comm);
+    up_size = ompi_comm_size(up_comm);
+
+    req = han_nbc_request_alloc(comm, han_module, persistent, info);
+    if (NULL == req) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    req->sbuf = sbuf;
+    req->scount = (MPI_IN_PLACE == sbuf) ? rcount : scount;
+    req->sdtype = (MPI_IN_PLACE == sbuf) ? rdtype : sdtype;
+    req->rbuf = rbuf;
+    req->rdtype = rdtype;
+    req->root_low_rank = 0;
+    req->topo = mca_coll_han_topo_init(comm, han_module, 2);
+    if (persistent) {
+        OBJ_RETAIN(req->sdtype);
+        OBJ_RETAIN(rdtype);
+    }
+
+    if (0 == ompi_comm_rank(low_comm)) {
+        ptrdiff_t rsize, rgap = 0;
+
+        /* intermediary buffer on node leaders to gather on low comm */
+        rsize = opal_datatype_span(&rdtype->super, (int64_t) rcount * low_size, &rgap);
+        req->tmp_buf = (char *) malloc(rsize);
+        req->tmp_buf_start = req->tmp_buf - rgap;
+        if (!han_module->is_mapbycore) {
+            /* the unordered result of the allgather between the leaders */
+            rsize = opal_datatype_span(&rdtype->super, (int64_t) rcount * low_size * up_size, &rgap);
+            req->reorder_buf = (char *) malloc(rsize);
+            req->reorder_buf_start = req->reorder_buf - rgap;
+        } else {
+            req->reorder_buf_start = rbuf;
+        }
+        if (NULL == req->tmp_buf || (!han_module->is_mapbycore && NULL == req->reorder_buf)) {
+            req->super.req_complete = REQUEST_COMPLETED;
+            han_nbc_request_free((ompi_request_t **) &req);
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+    }
+
+    req->rcount = rcount;
+    han_nbc_add_task(req, han_nbc_allgather_low);
+    if (0 == ompi_comm_rank(low_comm)) {
+        han_nbc_add_task(req, han_nbc_allgather_up);
+        if (!han_module->is_mapbycore) {
+            han_nbc_add_task(req, han_nbc_allgather_reorder);
+        }
+    }
+    han_nbc_add_task(req, han_nbc_allgather_bcast);
+
+    return han_nbc_launch(req, request);
+
+ prev_allgather:
+    return persistent
+        ? han_module->previous_allgather_init(sbuf, scount, sdtype, rbuf, rcount, rdtype,
+                                              comm, info, request,
+                                              han_module->previous_allgather_init_module)
+        : han_module->previous_iallgather(sbuf, scount, sdtype, rbuf, rcount, rdtype,
+                                          comm, request, han_module->previous_iallgather_module);
+}
@@ -0,0 +1,384 @@
+/*
+ * Copyright (c) 2018-2021 The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * This files contains the hierarchical implementations of reduce_scatter
+ * and reduce_scatter_block.
+ * Only work with regular situation (each node has equal number of processes)
+ * and commutative operations.
+ *
+ * The message is split in segments, a segment being made of the same slice
+ * of seg_count elements in every block of the result (the block of rank r
+ * having rcounts[r] elements). Each segment goes through 3 steps:
+ *     lr: lower level (intra-node) reduce of the whole segment on the node
+ *         leader,
+ *     urs: upper level (inter-node) reduce_scatter between node leaders,
+ *         each leader getting the slices of its local ranks,
+ *     ls: lower level (intra-node) scatter of the slices.
+ * Inside a segment, the slices are stored by increasing topological position
+ * of their destination, so that the slices of the ranks of a node are
+ * contiguous.
+ *        | seg 0 | seg 1 | seg 2 |
+ * iter 0 |  lr   |       |       | task: t0, contains lr
+ * iter 1 | urs,ls|  lr   |       | task: t1, contains urs, lr and ls
+ * iter 2 |       | urs,ls|  lr   | task: t1, contains urs, lr and ls
+ * iter 3 |       |       | urs,ls| task: t1, contains urs and ls
+ * The nonblocking urs of a segment overlaps with the lr of the next one.
+ */
+
+#include "coll_han.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/mca/coll/base/coll_tags.h"
+#include "ompi/mca/pml/pml.h"
+#include "coll_han_trigger.h"
+#include "opal/util/minmax.h"
+
+static int mca_coll_han_reduce_scatter_t0_task(void *task_args);
+static int mca_coll_han_reduce_scatter_t1_task(void *task_args);
+
+/* Number of elements of the block of rank in the segment seg */
+static inline int
+han_reduce_scatter_slice(const mca_coll_han_reduce_scatter_args_t *t,
+                         int rank, int seg)
+{
+    int count = t->rcounts[rank] - seg * t->seg_count;
+
+    if (count <= 0) {
+        return 0;
+    }
+    return (count < t->seg_count) ? count : t->seg_count;
+}
+
+/*
+ * lr of the segment seg: copy the slices of the segment by topological
+ * order into pack_buf and reduce them on the node leader.
+ */
+static int
+han_reduce_scatter_low_reduce(mca_coll_han_reduce_scatter_args_t *t, int seg)
+{
+    ptrdiff_t extent, lb;
+    int count = 0;
+
+    ompi_datatype_get_extent(t->dtype, &lb, &extent);
+    for (int pos = 0; pos < t->w_size; pos++) {
+        int rank = t->topo[2 * pos + 1];
+        int slice = han_reduce_scatter_slice(t, rank, seg);
+        if (0 == slice) {
+            continue;
+        }
+        ompi_datatype_copy_content_same_ddt(t->dtype, slice,
+                                            t->pack_buf + extent * count,
+                                            (char *) t->sbuf + extent * ((ptrdiff_t) t->displs[rank] +
+                                                                         (ptrdiff_t) seg * t->seg_count));
+        count += slice;
+    }
+    return t->low_comm->c_coll->coll_reduce(t->pack_buf, t->noop ? NULL : t->acc_buf[seg % 2],
+                                            count, t->dtype, t->op, t->root_low_rank,
+                                            t->low_comm, t->low_comm->c_coll->coll_reduce_module);
+}
+
+static int
+mca_coll_han_reduce_scatter_pipeline(const void *sbuf, void *rbuf,
+                                     const int *rcounts,
+                                     struct ompi_datatype_t *dtype,
+                                     struct ompi_op_t *op,
+                                     struct ompi_communicator_t *comm,
+                                     mca_coll_han_module_t *han_module,
+                                     int *topo)
+{
+    ompi_communicator_t *low_comm = han_module->sub_comm[INTRA_NODE];
+    ompi_communicator_t *up_comm = han_module->sub_comm[INTER_NODE];
+    int w_size = ompi_comm_size(comm);
+    int low_rank = ompi_comm_rank(low_comm);
+    int low_size = ompi_comm_size(low_comm);
+    int up_size = ompi_comm_size(up_comm);
+    int root_low_rank = 0;
+    int max_count = 0, seg_count, num_segments, err = OMPI_SUCCESS;
+    size_t dtype_size;
+    ptrdiff_t span, gap = 0;
+    mca_coll_han_reduce_scatter_args_t t;
+
+    memset(&t, 0, sizeof(t));
+    for (int i = 0; i < w_size; i++) {
+        max_count = opal_max(max_count, rcounts[i]);
+    }
+    if (0 == max_count) {
+        return OMPI_SUCCESS;
+    }
+
+    /* The segment size applies to the whole segment, not to a single slice */
+    ompi_datatype_type_size(dtype, &dtype_size);
+    seg_count = max_count;
+    COLL_BASE_COMPUTED_SEGCOUNT(mca_coll_han_component.han_reduce_scatter_segsize,
+                                dtype_size * w_size, seg_count);
+    num_segments = (max_count + seg_count - 1) / seg_count;
+    OPAL_OUTPUT_VERBOSE((10, mca_coll_han_component.han_output,
+                         "In HAN Reduce_scatter seg_size %d seg_count %d max_count %d\n",
+                         mca_coll_han_component.han_reduce_scatter_segsize, seg_count, max_count));
+
+    t.up_comm = up_comm;
+    t.low_comm = low_comm;
+    t.sbuf = (MPI_IN_PLACE == sbuf) ? rbuf : (void *) sbuf;
+    t.rbuf = rbuf;
+    t.op = op;
+    t.dtype = dtype;
+    t.rcounts = rcounts;
+    t.topo = topo;
+    t.seg_count = seg_count;
+    t.num_segments = num_segments;
+    t.cur_seg = 0;
+    t.w_rank = ompi_comm_rank(comm);
+    t.w_size = w_size;
+    t.low_size = low_size;
+    t.root_low_rank = root_low_rank;
+    t.noop = (low_rank != root_low_rank);
+    t.completed = 0;
+
+    t.displs = (int *) malloc(sizeof(int) * w_size);
+    span = opal_datatype_span(&dtype->super, (int64_t) seg_count * w_size, &gap);
+    t.pack_buf_free = (char *) malloc(span);
+    if (NULL == t.displs || NULL == t.pack_buf_free) {
+        err = OMPI_ERR_OUT_OF_RESOURCE;
+        goto cleanup;
+    }
+    t.pack_buf = t.pack_buf_free - gap;
+    t.displs[0] = 0;
+    for (int i = 1; i < w_size; i++) {
+        t.displs[i] = t.displs[i - 1] + rcounts[i - 1];
+    }
+
+    if (!t.noop) {
+        /* accumulation buffers are alternated between 2 consecutive segments */
+        t.acc_buf_free[0] = (char *) malloc(span);
+        t.acc_buf_free[1] = (char *) malloc(span);
+        span = opal_datatype_span(&dtype->super, (int64_t) seg_count * low_size, &gap);
+        t.res_buf_free = (char *) malloc(span);
+        t.up_counts = (int *) malloc(sizeof(int) * up_size);
+        t.low_counts = (int *) malloc(sizeof(int) * low_size);
+        t.low_displs = (int *) malloc(sizeof(int) * low_size);
+        if (NULL == t.acc_buf_free[0] || NULL == t.acc_buf_free[1] ||
+            NULL == t.res_buf_free || NULL == t.up_counts ||
+            NULL == t.low_counts || NULL == t.low_displs) {
+            err = OMPI_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+        t.acc_buf[0] = t.acc_buf_free[0] + (t.pack_buf - t.pack_buf_free);
+        t.acc_buf[1] = t.acc_buf_free[1] + (t.pack_buf - t.pack_buf_free);
+        t.res_buf = t.res_buf_free - gap;
+        t.up_rank = ompi_comm_rank(up_comm);
+        t.up_size = up_size;
+    }
+
+    /* Create t0 task for the first segment */
+    mca_coll_task_t *t0 = OBJ_NEW(mca_coll_task_t);
+    t.cur_task = t0;
+    init_task(t0, mca_coll_han_reduce_scatter_t0_task, (void *) &t);
+    issue_task(t0);
+
+    while (t.completed != t.num_segments) {
+        /* Create t1 task for the current segment */
+        mca_coll_task_t *t1 = OBJ_NEW(mca_coll_task_t);
+        t.cur_task = t1;
+        init_task(t1, mca_coll_han_reduce_scatter_t1_task, (void *) &t);
+        issue_task(t1);
+        t.cur_seg++;
+    }
+    err = t.err;
+
+ cleanup:
+    free(t.displs);
+    free(t.pack_buf_free);
+    free(t.acc_buf_free[0]);
+    free(t.acc_buf_free[1]);
+    free(t.res_buf_free);
+    free(t.up_counts);
+    free(t.low_counts);
+    free(t.low_displs);
+    return err;
+}
+
+/* t0 task that performs the local reduction of the first segment */
+static int mca_coll_han_reduce_scatter_t0_task(void *task_args)
+{
+    mca_coll_han_reduce_scatter_args_t *t = (mca_coll_han_reduce_scatter_args_t *) task_args;
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                         "[%d] HAN Reduce_scatter:  t0 %d\n", t->w_rank, t->cur_seg));
+    OBJ_RELEASE(t->cur_task);
+    t->err = han_reduce_scatter_low_reduce(t, 0);
+    return t->err;
+}
+
+/*
+ * t1 task: urs and ls of the current segment, overlapped with the lr of the
+ * next segment
+ */
+static int mca_coll_han_reduce_scatter_t1_task(void *task_args)
+{
+    mca_coll_han_reduce_scatter_args_t *t = (mca_coll_han_reduce_scatter_args_t *) task_args;
+    ompi_request_t *ireduce_scatter_req = MPI_REQUEST_NULL;
+    int seg = t->cur_seg, ret;
+    ptrdiff_t extent, lb;
+
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                         "[%d] HAN Reduce_scatter:  t1 %d\n", t->w_rank, seg));
+    OBJ_RELEASE(t->cur_task);
+    ompi_datatype_get_extent(t->dtype, &lb, &extent);
+
+    if (!t->noop) {
+        /* urs of cur_seg */
+        for (int node = 0; node < t->up_size; node++) {
+            t->up_counts[node] = 0;
+            for (int low = 0; low < t->low_size; low++) {
+                int rank = t->topo[2 * (node * t->low_size + low) + 1];
+                t->up_counts[node] += han_reduce_scatter_slice(t, rank, seg);
+            }
+        }
+        ret = t->up_comm->c_coll->coll_ireduce_scatter(t->acc_buf[seg % 2], t->res_buf,
+                                                       t->up_counts, t->dtype, t->op,
+                                                       t->up_comm, &ireduce_scatter_req,
+                                                       t->up_comm->c_coll->coll_ireduce_scatter_module);
+        if (OMPI_SUCCESS != ret && OMPI_SUCCESS == t->err) {
+            t->err = ret;
+        }
+    }
+    /* lr of cur_seg+1 */
+    if (seg <= t->num_segments - 2) {
+        ret = han_reduce_scatter_low_reduce(t, seg + 1);
+        if (OMPI_SUCCESS != ret && OMPI_SUCCESS == t->err) {
+            t->err = ret;
+        }
+    }
+    if (!t->noop) {
+        ompi_request_wait(&ireduce_scatter_req, MPI_STATUS_IGNORE);
+        for (int low = 0, displ = 0; low < t->low_size; low++) {
+            int rank = t->topo[2 * (t->up_rank * t->low_size + low) + 1];
+            t->low_counts[low] = han_reduce_scatter_slice(t, rank, seg);
+            t->low_displs[low] = displ;
+            displ += t->low_counts[low];
+        }
+    }
+    /* ls of cur_seg */
+    ret = t->low_comm->c_coll->coll_scatterv(t->res_buf, t->low_counts, t->low_displs, t->dtype,
+                                             (char *) t->rbuf + extent * (ptrdiff_t) seg * t->seg_count,
+                                             han_reduce_scatter_slice(t, t->w_rank, seg), t->dtype,
+                                             t->root_low_rank, t->low_comm,
+                                             t->low_comm->c_coll->coll_scatterv_module);
+    if (OMPI_SUCCESS != ret && OMPI_SUCCESS == t->err) {
+        t->err = ret;
+    }
+
+    t->completed++;
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                         "[%d] HAN Reduce_scatter:  t1 %d total %d\n", t->w_rank, seg,
+                         t->completed));
+    return t->err;
+}
+
+int
+mca_coll_han_reduce_scatter_intra(const void *sbuf, void *rbuf,
+                                  const int *rcounts,
+                                  struct ompi_datatype_t *dtype,
+                                  struct ompi_op_t *op,
+                                  struct ompi_communicator_t *comm,
+                                  mca_coll_base_module_t *module)
+{
+    mca_coll_han_module_t *han_module = (mca_coll_han_module_t *)module;
+
+    /* Create the subcommunicators */
+    if( OMPI_SUCCESS != mca_coll_han_comm_create_new(comm, han_module) ) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle reduce_scatter with this communicator. Drop HAN support in this communicator and fall back on another component\n"));
+        /* HAN cannot work with this communicator so fallback on all collectives */
+        HAN_LOAD_FALLBACK_COLLECTIVES(han_module, comm);
+        return comm->c_coll->coll_reduce_scatter(sbuf, rbuf, rcounts, dtype, op,
+                                                 comm, comm->c_coll->coll_reduce_scatter_module);
+    }
+
+    /* No support for non-commutative operations */
+    if (!ompi_op_is_commute(op)) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle reduce_scatter with this operation. Fall back on another component\n"));
+        return han_module->previous_reduce_scatter(sbuf, rbuf, rcounts, dtype, op,
+                                                   comm, han_module->previous_reduce_scatter_module);
+    }
+
+    /* discovery topology */
+    int *topo = mca_coll_han_topo_init(comm, han_module, 2);
+
+    /* unbalanced case needs algo adaptation */
+    if (han_module->are_ppn_imbalanced) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle reduce_scatter with this communicator (imbalance). Fall back on another component\n"));
+        HAN_LOAD_FALLBACK_COLLECTIVE(han_module, comm, reduce_scatter);
+        return comm->c_coll->coll_reduce_scatter(sbuf, rbuf, rcounts, dtype, op,
+                                                 comm, comm->c_coll->coll_reduce_scatter_module);
+    }
+
+    return mca_coll_han_reduce_scatter_pipeline(sbuf, rbuf, rcounts, dtype, op,
+                                                comm, han_module, topo);
+}
+
+int
+mca_coll_han_reduce_scatter_block_intra(const void *sbuf, void *rbuf,
+                                        int rcount,
+                                        struct ompi_datatype_t *dtype,
+                                        struct ompi_op_t *op,
+                                        struct ompi_communicator_t *comm,
+                                        mca_coll_base_module_t *module)
+{
+    mca_coll_han_module_t *han_module = (mca_coll_han_module_t *)module;
+    int w_size = ompi_comm_size(comm), err;
+    int *rcounts;
+
+    /* Create the subcommunicators */
+    if( OMPI_SUCCESS != mca_coll_han_comm_create_new(comm, han_module) ) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle reduce_scatter_block with this communicator. Drop HAN support in this communicator and fall back on another component\n"));
+        /* HAN cannot work with this communicator so fallback on all collectives */
+        HAN_LOAD_FALLBACK_COLLECTIVES(han_module, comm);
+        return comm->c_coll->coll_reduce_scatter_block(sbuf, rbuf, rcount, dtype, op,
+                                                       comm, comm->c_coll->coll_reduce_scatter_block_module);
+    }
+
+    /* No support for non-commutative operations */
+    if (!ompi_op_is_commute(op)) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle reduce_scatter_block with this operation. Fall back on another component\n"));
+        return han_module->previous_reduce_scatter_block(sbuf, rbuf, rcount, dtype, op,
+                                                         comm, han_module->previous_reduce_scatter_block_module);
+    }
+
+    /* discovery topology */
+    int *topo = mca_coll_han_topo_init(comm, han_module, 2);
+
+    /* unbalanced case needs algo adaptation */
+    if (han_module->are_ppn_imbalanced) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle reduce_scatter_block with this communicator (imbalance). Fall back on another component\n"));
+        HAN_LOAD_FALLBACK_COLLECTIVE(han_module, comm, reduce_scatter_block);
+        return comm->c_coll->coll_reduce_scatter_block(sbuf, rbuf, rcount, dtype, op,
+                                                       comm, comm->c_coll->coll_reduce_scatter_block_module);
+    }
+
+    rcounts = (int *) malloc(sizeof(int) * w_size);
+    if (NULL == rcounts) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    for (int i = 0; i < w_size; i++) {
+        rcounts[i] = rcount;
+    }
+    err = mca_coll_han_reduce_scatter_pipeline(sbuf, rbuf, rcounts, dtype, op,
+                                               comm, han_module, topo);
+    free(rcounts);
+    return err;
+}
@@ -25,6 +25,8 @@
 #include "mpi.h"
 #include "coll_han.h"
 #include "coll_han_dynamic.h"
+#include "ompi/proc/proc.h"
+#include "opal/mca/hwloc/base/base.h"
 
 #define HAN_SUBCOM_SAVE_COLLECTIVE(FALLBACKS, COMM, HANM, COLL)                  \
     do {                                                                         \
@@ -40,6 +42,92 @@
         (COMM)->c_coll->coll_ ## COLL ## _module = (FALLBACKS).COLL.module;      \
     } while(0)
 
+/*
+ * Order the processes of the node as possible node leaders: the first
+ * process close to each NIC, then the others by intra-node rank. The
+ * leaders are only used if all the nodes found the same order (and the
+ * same number of processes), otherwise there is a single leader.
+ */
+static void mca_coll_han_leaders_create(struct ompi_communicator_t *comm,
+                                        mca_coll_han_module_t *han_module,
+                                        ompi_communicator_t *low_comm,
+                                        ompi_communicator_t *up_comm)
+{
+    int low_size = ompi_comm_size(low_comm);
+    int nleaders = (low_size < COLL_HAN_MAX_LEADERS) ? low_size : COLL_HAN_MAX_LEADERS;
+    int check[2 * (COLL_HAN_MAX_LEADERS + 2)], up_rank[2];
+    int nics[COLL_HAN_MAX_LEADERS], nnics = 0;
+    int *leaders, n = 0, i, j;
+    bool *taken;
+
+    han_module->cached_nleaders = 1;
+    leaders = (int *)malloc(low_size * sizeof(int));
+    taken = (bool *)calloc(low_size, sizeof(bool));
+    if (NULL == leaders || NULL == taken) {
+        free(leaders);
+        free(taken);
+        return;
+    }
+
+    for (i = 0; i < low_size && nnics < nleaders; i++) {
+        ompi_proc_t *proc = ompi_comm_peer_lookup(low_comm, i);
+        const opal_hwloc_base_local_proc_t *locality = NULL;
+
+        if (NULL != proc) {
+            locality = opal_hwloc_base_locality_lookup(&proc->super.proc_name);
+        }
+        if (NULL == locality || locality->nic < 0) {
+            continue;
+        }
+        for (j = 0; j < nnics && nics[j] != locality->nic; j++);
+        if (j == nnics) {
+            nics[nnics++] = locality->nic;
+            leaders[n++] = i;
+            taken[i] = true;
+        }
+    }
+    for (i = 0; i < low_size; i++) {
+        if (!taken[i]) {
+            leaders[n++] = i;
+        }
+    }
+    free(taken);
+
+    /* all the processes of a node must see it with the same inter-node rank */
+    up_rank[0] = ompi_comm_rank(up_comm);
+    up_rank[1] = -up_rank[0];
+    low_comm->c_coll->coll_allreduce(MPI_IN_PLACE, up_rank, 2, MPI_INT, MPI_MAX,
+                                     low_comm, low_comm->c_coll->coll_allreduce_module);
+
+    /* one max reduction of the values and of their opposites gives both
+     * their maximum and their minimum */
+    check[0] = low_size;
+    check[1] = (up_rank[0] == -up_rank[1]) ? 0 : 1;
+    for (i = 0; i < COLL_HAN_MAX_LEADERS; i++) {
+        check[i + 2] = (i < nleaders) ? leaders[i] : -1;
+    }
+    for (i = 0; i < COLL_HAN_MAX_LEADERS + 2; i++) {
+        check[COLL_HAN_MAX_LEADERS + 2 + i] = -check[i];
+    }
+    comm->c_coll->coll_allreduce(MPI_IN_PLACE, check, 2 * (COLL_HAN_MAX_LEADERS + 2),
+                                 MPI_INT, MPI_MAX, comm, comm->c_coll->coll_allreduce_module);
+    for (i = 0; i < COLL_HAN_MAX_LEADERS + 2; i++) {
+        if (check[i] != -check[COLL_HAN_MAX_LEADERS + 2 + i]) {
+            break;
+        }
+    }
+    if (i < COLL_HAN_MAX_LEADERS + 2) {
+        opal_output_verbose(30, mca_coll_han_component.han_output,
+                            "coll:han:leaders the nodes do not agree on the node leaders, "
+                            "only one leader per node will be used\n");
+        free(leaders);
+        return;
+    }
+
+    han_module->cached_leaders = leaders;
+    han_module->cached_nleaders = nleaders;
+}
+
 /*
  * Routine that creates the local hierarchical sub-communicators
  * Called each time a collective is called.
@@ -136,6 +224,11 @@ int mca_coll_han_comm_create_new(struct ompi_communicator_t *comm,
 
     up_rank = ompi_comm_rank(*up_comm);
 
+    /*
+     * The possible node leaders of the inter-node phase
+     */
+    mca_coll_han_leaders_create(comm, han_module, *low_comm, *up_comm);
+
     /*
      * Set my virtual rank number.
      * my rank # = <intra-node comm size> * <inter-node rank number>
@@ -164,6 +257,11 @@ int mca_coll_han_comm_create_new(struct ompi_communicator_t *comm,
      */
     han_module->cached_vranks = vranks;
 
+    /*
+     * The optional socket and group levels
+     */
+    mca_coll_han_levels_create(comm, han_module);
+
     /* Reset the saved collectives to point back to HAN */
     HAN_SUBCOM_LOAD_COLLECTIVE(fallbacks, comm, han_module, allgatherv);
     HAN_SUBCOM_LOAD_COLLECTIVE(fallbacks, comm, han_module, allgather);
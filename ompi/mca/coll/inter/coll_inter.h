@@ -40,6 +40,9 @@ BEGIN_C_DECLS
 OMPI_MODULE_DECLSPEC extern const mca_coll_base_component_2_4_0_t mca_coll_inter_component;
 extern int mca_coll_inter_priority_param;
 extern int mca_coll_inter_verbose_param;
+extern int mca_coll_inter_leaders_param;
+extern size_t mca_coll_inter_multi_leader_min_size;
+extern size_t mca_coll_inter_segment_size;
 
 
 /*
@@ -107,6 +110,25 @@ int mca_coll_inter_scatterv_inter(const void *sbuf, const int *scounts, const in
 				  struct ompi_communicator_t *comm,
                                   mca_coll_base_module_t *module);
 
+/*
+ * Multi-leader variants, used when mca_coll_inter_num_leaders() returns
+ * more than one leader pair for the size of the operation
+ */
+int mca_coll_inter_num_leaders(struct ompi_communicator_t *comm, size_t bytes);
+int mca_coll_inter_allreduce_inter_multi_leader(const void *sbuf, void *rbuf, int count,
+                                                struct ompi_datatype_t *dtype,
+                                                struct ompi_op_t *op,
+                                                struct ompi_communicator_t *comm,
+                                                mca_coll_base_module_t *module,
+                                                int k);
+int mca_coll_inter_allgather_inter_multi_leader(const void *sbuf, int scount,
+                                                struct ompi_datatype_t *sdtype,
+                                                void *rbuf, int rcount,
+                                                struct ompi_datatype_t *rdtype,
+                                                struct ompi_communicator_t *comm,
+                                                mca_coll_base_module_t *module,
+                                                int k);
+
 
 struct mca_coll_inter_module_t {
     mca_coll_base_module_t super;
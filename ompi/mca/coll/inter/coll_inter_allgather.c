@@ -48,14 +48,28 @@ mca_coll_inter_allgather_inter(const void *sbuf, int scount,
                                struct ompi_communicator_t *comm,
                                mca_coll_base_module_t *module)
 {
-    int rank, root = 0, size, rsize, err = OMPI_SUCCESS;
+    int rank, root = 0, size, rsize, err = OMPI_SUCCESS, k;
     char *ptmp_free = NULL, *ptmp = NULL;
     ptrdiff_t gap, span;
+    size_t sdsize, rdsize, bytes;
 
     rank = ompi_comm_rank(comm);
     size = ompi_comm_size(comm->c_local_comm);
     rsize = ompi_comm_remote_size(comm);
 
+    /* the larger of the two directions, the remote group computes the same */
+    ompi_datatype_type_size(sdtype, &sdsize);
+    ompi_datatype_type_size(rdtype, &rdsize);
+    bytes = sdsize * (size_t) scount * size;
+    if (rdsize * (size_t) rcount * rsize > bytes) {
+        bytes = rdsize * (size_t) rcount * rsize;
+    }
+    k = mca_coll_inter_num_leaders(comm, bytes);
+    if (k > 1) {
+        return mca_coll_inter_allgather_inter_multi_leader(sbuf, scount, sdtype, rbuf, rcount,
+                                                           rdtype, comm, module, k);
+    }
+
     /* Perform the gather locally at the root */
     if ( scount > 0 ) {
         span = opal_datatype_span(&sdtype->super, (int64_t)scount*(int64_t)size, &gap);
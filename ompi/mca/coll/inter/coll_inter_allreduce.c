@@ -47,9 +47,17 @@ mca_coll_inter_allreduce_inter(const void *sbuf, void *rbuf, int count,
                                struct ompi_communicator_t *comm,
                                mca_coll_base_module_t *module)
 {
-    int err, rank, root = 0;
+    int err, rank, root = 0, k;
     char *tmpbuf = NULL, *pml_buffer = NULL;
     ptrdiff_t gap, span;
+    size_t dsize;
+
+    ompi_datatype_type_size(dtype, &dsize);
+    k = mca_coll_inter_num_leaders(comm, dsize * (size_t) count);
+    if (k > 1) {
+        return mca_coll_inter_allreduce_inter_multi_leader(sbuf, rbuf, count, dtype, op,
+                                                           comm, module, k);
+    }
 
     rank = ompi_comm_rank(comm);
 
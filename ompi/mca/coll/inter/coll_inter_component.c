@@ -44,6 +44,9 @@ const char *mca_coll_inter_component_version_string =
  */
 int mca_coll_inter_priority_param = 40;
 int mca_coll_inter_verbose_param = 0;
+int mca_coll_inter_leaders_param = 4;
+size_t mca_coll_inter_multi_leader_min_size = 65536;
+size_t mca_coll_inter_segment_size = 262144;
 
 
 /*
@@ -103,6 +106,37 @@ static int inter_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_coll_inter_verbose_param);
 
+    mca_coll_inter_leaders_param = 4;
+    (void) mca_base_component_var_register(&mca_coll_inter_component.collm_version,
+                                           "leaders",
+                                           "Number of leader pairs sharing the traffic between the two groups "
+                                           "of allreduce and allgather (limited by the group sizes, 1 funnels "
+                                           "everything through rank 0 of each group)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_ALL,
+                                           &mca_coll_inter_leaders_param);
+
+    mca_coll_inter_multi_leader_min_size = 65536;
+    (void) mca_base_component_var_register(&mca_coll_inter_component.collm_version,
+                                           "multi_leader_min_size",
+                                           "Size in bytes of the payload from which allreduce and allgather use "
+                                           "several leader pairs (must be the same in both groups)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_ALL,
+                                           &mca_coll_inter_multi_leader_min_size);
+
+    mca_coll_inter_segment_size = 262144;
+    (void) mca_base_component_var_register(&mca_coll_inter_component.collm_version,
+                                           "segment_size",
+                                           "Size in bytes of the block of each leader in a chunk of the "
+                                           "pipelined multi-leader allreduce",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_ALL,
+                                           &mca_coll_inter_segment_size);
+
     return OMPI_SUCCESS;
 }
 
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Multi-leader intercommunicator collectives.
+ *
+ * The default algorithms funnel the whole payload through the link between
+ * local rank 0 and remote rank 0. The variants below split it across k
+ * leader pairs (local rank b talks to remote rank b, b < k) so that the
+ * exchanges between the groups proceed in parallel, then redistribute the
+ * pieces locally with an allgatherv. k is the smallest of
+ * coll_inter_leaders and the two group sizes, so both groups agree on it.
+ */
+
+#include "ompi_config.h"
+#include "coll_inter.h"
+
+#include <limits.h>
+#include <stdlib.h>
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/request/request.h"
+#include "ompi/op/op.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/mca/coll/base/coll_tags.h"
+#include "ompi/mca/pml/pml.h"
+
+int mca_coll_inter_num_leaders(struct ompi_communicator_t *comm, size_t bytes)
+{
+    int k = mca_coll_inter_leaders_param;
+
+    if (k < 2 || bytes < mca_coll_inter_multi_leader_min_size) {
+        return 1;
+    }
+
+    if (k > ompi_comm_size(comm->c_local_comm)) {
+        k = ompi_comm_size(comm->c_local_comm);
+    }
+    if (k > ompi_comm_remote_size(comm)) {
+        k = ompi_comm_remote_size(comm);
+    }
+
+    return k;
+}
+
+/* first rank of the group of size n handled by leader b out of k */
+static inline int mca_coll_inter_range_first(int n, int k, int b)
+{
+    return (int) (((int64_t) b * (int64_t) n) / k);
+}
+
+/* split the count elements of a chunk among the k leaders, 0 for the other ranks */
+static void mca_coll_inter_split(int count, int k, int size, int *counts, int *displs)
+{
+    int b, disp = 0;
+
+    for (b = 0; b < size; ++b) {
+        counts[b] = (b < k) ? count / k + (b < count % k ? 1 : 0) : 0;
+        if (NULL != displs) {
+            displs[b] = disp;
+        }
+        disp += counts[b];
+    }
+}
+
+/*
+ *	allreduce_inter_multi_leader
+ *
+ *	Function:	- allreduce through k leader pairs
+ *	Accepts:	- same as MPI_Allreduce(), plus the number of leaders
+ *	Returns:	- MPI_SUCCESS or error code
+ *
+ *	The payload is cut in chunks of k blocks of coll_inter_segment_size
+ *	bytes. Each chunk goes through three stages: a local reduce_scatter
+ *	that leaves block b reduced at leader b, the exchange of the block
+ *	with remote leader b, and a local allgatherv of the remote blocks.
+ *	The three stages of consecutive chunks overlap.
+ */
+int
+mca_coll_inter_allreduce_inter_multi_leader(const void *sbuf, void *rbuf, int count,
+                                            struct ompi_datatype_t *dtype,
+                                            struct ompi_op_t *op,
+                                            struct ompi_communicator_t *comm,
+                                            mca_coll_base_module_t *module,
+                                            int k)
+{
+    ompi_communicator_t *lcomm = comm->c_local_comm;
+    int rank = ompi_comm_rank(comm), size = ompi_comm_size(lcomm);
+    int err = OMPI_SUCCESS, chunk_count, nchunks, seg_count, c, nreqs;
+    int *rs_counts = NULL, *ex_counts = NULL, *ex_displs = NULL, *ag_counts = NULL, *ag_displs = NULL;
+    char *tmp_free = NULL, *tmp[2] = {NULL, NULL};
+    ompi_request_t *reqs[4];
+    ptrdiff_t extent, lb, gap, span;
+    size_t dsize;
+
+    ompi_datatype_type_size(dtype, &dsize);
+    ompi_datatype_get_extent(dtype, &lb, &extent);
+
+    seg_count = (0 == dsize) ? count : (int) (mca_coll_inter_segment_size / dsize);
+    if (seg_count < 1) {
+        seg_count = 1;
+    }
+    chunk_count = (seg_count > INT_MAX / k) ? INT_MAX : seg_count * k;
+    nchunks = (count + chunk_count - 1) / chunk_count;
+
+    rs_counts = (int *) malloc(5 * size * sizeof(int));
+    if (NULL == rs_counts) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    ex_counts = rs_counts + size;
+    ex_displs = ex_counts + size;
+    ag_counts = ex_displs + size;
+    ag_displs = ag_counts + size;
+
+    if (rank < k) {
+        /* one block of each of two chunks in flight */
+        span = opal_datatype_span(&dtype->super, seg_count, &gap);
+        tmp_free = (char *) malloc(2 * span);
+        if (NULL == tmp_free) {
+            err = OMPI_ERR_OUT_OF_RESOURCE;
+            goto exit;
+        }
+        tmp[0] = tmp_free - gap;
+        tmp[1] = tmp[0] + span;
+    }
+
+    for (c = 0; c < nchunks + 2; ++c) {
+        nreqs = 0;
+
+        /* stage 1: reduce chunk c, block b at leader b */
+        if (c < nchunks) {
+            ptrdiff_t start = (ptrdiff_t) c * chunk_count;
+            int ccount = (int) ((count - start < chunk_count) ? count - start : chunk_count);
+
+            mca_coll_inter_split(ccount, k, size, rs_counts, NULL);
+            err = lcomm->c_coll->coll_ireduce_scatter((char *) sbuf + start * extent,
+                                                      (rank < k) ? tmp[c % 2] : rbuf,
+                                                      rs_counts, dtype, op, lcomm, &reqs[nreqs++],
+                                                      lcomm->c_coll->coll_ireduce_scatter_module);
+            if (OMPI_SUCCESS != err) {
+                goto exit;
+            }
+        }
+
+        /* stage 2: exchange the block of chunk c - 1 with the remote leader */
+        if (c >= 1 && c - 1 < nchunks && rank < k) {
+            ptrdiff_t start = (ptrdiff_t) (c - 1) * chunk_count;
+            int ccount = (int) ((count - start < chunk_count) ? count - start : chunk_count);
+
+            mca_coll_inter_split(ccount, k, size, ex_counts, ex_displs);
+            err = MCA_PML_CALL(irecv((char *) rbuf + (start + ex_displs[rank]) * extent,
+                                     ex_counts[rank], dtype, rank, MCA_COLL_BASE_TAG_ALLREDUCE,
+                                     comm, &reqs[nreqs++]));
+            if (OMPI_SUCCESS != err) {
+                goto exit;
+            }
+            err = MCA_PML_CALL(isend(tmp[(c - 1) % 2], ex_counts[rank], dtype, rank,
+                                     MCA_COLL_BASE_TAG_ALLREDUCE, MCA_PML_BASE_SEND_STANDARD,
+                                     comm, &reqs[nreqs++]));
+            if (OMPI_SUCCESS != err) {
+                goto exit;
+            }
+        }
+
+        /* stage 3: give the remote result of chunk c - 2 to all local ranks */
+        if (c >= 2) {
+            ptrdiff_t start = (ptrdiff_t) (c - 2) * chunk_count;
+            int ccount = (int) ((count - start < chunk_count) ? count - start : chunk_count);
+
+            mca_coll_inter_split(ccount, k, size, ag_counts, ag_displs);
+            err = lcomm->c_coll->coll_iallgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                                                  (char *) rbuf + start * extent, ag_counts,
+                                                  ag_displs, dtype, lcomm, &reqs[nreqs++],
+                                                  lcomm->c_coll->coll_iallgatherv_module);
+            if (OMPI_SUCCESS != err) {
+                goto exit;
+            }
+        }
+
+        err = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+        if (OMPI_SUCCESS != err) {
+            goto exit;
+        }
+    }
+
+ exit:
+    if (NULL != tmp_free) {
+        free(tmp_free);
+    }
+    free(rs_counts);
+
+    return err;
+}
+
+/*
+ *	allgather_inter_multi_leader
+ *
+ *	Function:	- allgather through k leader pairs
+ *	Accepts:	- same as MPI_Allgather(), plus the number of leaders
+ *	Returns:	- MPI_SUCCESS or error code
+ *
+ *	Leader b collects the contributions of its range of local ranks,
+ *	exchanges them with remote leader b, which holds the matching range
+ *	of the remote group, and the local allgatherv spreads the ranges.
+ */
+int
+mca_coll_inter_allgather_inter_multi_leader(const void *sbuf, int scount,
+                                            struct ompi_datatype_t *sdtype,
+                                            void *rbuf, int rcount,
+                                            struct ompi_datatype_t *rdtype,
+                                            struct ompi_communicator_t *comm,
+                                            mca_coll_base_module_t *module,
+                                            int k)
+{
+    ompi_communicator_t *lcomm = comm->c_local_comm;
+    int rank = ompi_comm_rank(comm), size = ompi_comm_size(lcomm);
+    int rsize = ompi_comm_remote_size(comm);
+    int err = OMPI_SUCCESS, b, owner = 0, nreqs = 0, first = 0, last = 0;
+    int *counts = NULL, *displs = NULL;
+    ompi_request_t **reqs = NULL;
+    char *tmp_free = NULL, *tmp = NULL;
+    ptrdiff_t sextent, rextent, lb, gap, span;
+
+    ompi_datatype_get_extent(sdtype, &lb, &sextent);
+    ompi_datatype_get_extent(rdtype, &lb, &rextent);
+
+    counts = (int *) malloc(2 * size * sizeof(int));
+    if (NULL == counts) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    displs = counts + size;
+
+    for (b = 1; b < k && mca_coll_inter_range_first(size, k, b) <= rank; ++b) {
+        owner = b;
+    }
+
+    if (rank < k) {
+        first = mca_coll_inter_range_first(size, k, rank);
+        last = mca_coll_inter_range_first(size, k, rank + 1);
+    }
+
+    /* the contributions of the range, one send to the leader and one receive for each rank */
+    reqs = (ompi_request_t **) malloc((last - first + 3) * sizeof(ompi_request_t *));
+    if (NULL == reqs) {
+        err = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+
+    if (owner != rank) {
+        err = MCA_PML_CALL(isend(sbuf, scount, sdtype, owner, MCA_COLL_BASE_TAG_ALLGATHER,
+                                 MCA_PML_BASE_SEND_STANDARD, lcomm, &reqs[nreqs++]));
+        if (OMPI_SUCCESS != err) {
+            goto exit;
+        }
+    }
+
+    if (rank < k) {
+        span = opal_datatype_span(&sdtype->super, (int64_t) scount * (last - first), &gap);
+        tmp_free = (char *) malloc(span);
+        if (NULL == tmp_free) {
+            err = OMPI_ERR_OUT_OF_RESOURCE;
+            goto exit;
+        }
+        tmp = tmp_free - gap;
+
+        for (int r = first; r < last; ++r) {
+            char *slot = tmp + (ptrdiff_t) (r - first) * scount * sextent;
+
+            if (r == rank) {
+                err = ompi_datatype_sndrcv(sbuf, scount, sdtype, slot, scount, sdtype);
+            } else {
+                err = MCA_PML_CALL(irecv(slot, scount, sdtype, r, MCA_COLL_BASE_TAG_ALLGATHER,
+                                         lcomm, &reqs[nreqs++]));
+            }
+            if (OMPI_SUCCESS != err) {
+                goto exit;
+            }
+        }
+    }
+
+    err = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+    if (OMPI_SUCCESS != err) {
+        goto exit;
+    }
+    nreqs = 0;
+
+    /* leader b receives the range b of the remote group into its place in rbuf */
+    for (b = 0; b < size; ++b) {
+        int rfirst = (b < k) ? mca_coll_inter_range_first(rsize, k, b) : rsize;
+        int rlast = (b < k) ? mca_coll_inter_range_first(rsize, k, b + 1) : rsize;
+
+        counts[b] = rcount * (rlast - rfirst);
+        displs[b] = rcount * rfirst;
+    }
+
+    if (rank < k) {
+        err = MCA_PML_CALL(irecv((char *) rbuf + (ptrdiff_t) displs[rank] * rextent,
+                                 counts[rank], rdtype, rank, MCA_COLL_BASE_TAG_ALLGATHER,
+                                 comm, &reqs[nreqs++]));
+        if (OMPI_SUCCESS != err) {
+            goto exit;
+        }
+        err = MCA_PML_CALL(isend(tmp, scount * (last - first), sdtype, rank,
+                                 MCA_COLL_BASE_TAG_ALLGATHER, MCA_PML_BASE_SEND_STANDARD,
+                                 comm, &reqs[nreqs++]));
+        if (OMPI_SUCCESS != err) {
+            goto exit;
+        }
+        err = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+        if (OMPI_SUCCESS != err) {
+            goto exit;
+        }
+    }
+
+    if (rcount > 0) {
+        err = lcomm->c_coll->coll_allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                                             rbuf, counts, displs, rdtype, lcomm,
+                                             lcomm->c_coll->coll_allgatherv_module);
+    }
+
+ exit:
+    if (NULL != tmp_free) {
+        free(tmp_free);
+    }
+    if (NULL != reqs) {
+        free(reqs);
+    }
+    free(counts);
+
+    return err;
+}
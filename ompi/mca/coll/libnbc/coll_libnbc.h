@@ -30,6 +30,8 @@
 #include "ompi/mca/coll/coll.h"
 #include "ompi/mca/coll/base/coll_base_util.h"
 #include "opal/sys/atomic.h"
+#include "opal/class/opal_fifo.h"
+#include "opal/mca/threads/threads.h"
 
 BEGIN_C_DECLS
 
@@ -70,6 +72,8 @@ BEGIN_C_DECLS
 #define NBC_NUM_COLL 17
 
 extern bool libnbc_ibcast_skip_dt_decision;
+extern bool libnbc_persistent_plan;
+extern bool libnbc_progress_thread;
 extern int libnbc_iallgather_algorithm;
 extern int libnbc_iallreduce_algorithm;
 extern int libnbc_ibcast_algorithm;
@@ -77,6 +81,7 @@ extern int libnbc_ibcast_knomial_radix;
 extern int libnbc_iexscan_algorithm;
 extern int libnbc_ireduce_algorithm;
 extern int libnbc_iscan_algorithm;
+extern int libnbc_schedule_cache_size;
 
 struct ompi_coll_libnbc_component_t {
     mca_coll_base_component_2_4_0_t super;
@@ -84,16 +89,44 @@ struct ompi_coll_libnbc_component_t {
     opal_list_t active_requests;
     opal_atomic_int32_t active_comms;
     opal_mutex_t lock;                /* protect access to the active_requests list */
+    opal_fifo_t incoming_requests;    /* started requests, not yet in active_requests */
+    opal_thread_t progress_thread;
+    volatile int32_t progress_thread_running;
 };
 typedef struct ompi_coll_libnbc_component_t ompi_coll_libnbc_component_t;
 
 /* Globally exported variables */
 OMPI_MODULE_DECLSPEC extern ompi_coll_libnbc_component_t mca_coll_libnbc_component;
 
+/* the arguments a schedule was built for */
+typedef struct NBC_Sched_key {
+    int coll;               /* NBC_ALLREDUCE, ..., -1 for an empty cache entry */
+    const void *sendbuf;
+    const void *recvbuf;
+    int count;
+    MPI_Datatype datatype;
+    MPI_Op op;
+    int root;
+} NBC_Sched_key;
+
+/* a schedule kept by the communicator for the next calls with the same
+ * arguments, along with its temporary buffer which the schedule may point
+ * into: it can only be lent to one active request at a time */
+typedef struct NBC_Sched_cache_entry {
+    NBC_Sched_key key;
+    struct NBC_Schedule *schedule;
+    void *tmpbuf;
+    bool busy;
+    unsigned long last_use;
+} NBC_Sched_cache_entry;
+
 struct ompi_coll_libnbc_module_t {
     mca_coll_base_module_t super;
     opal_mutex_t mutex;
     bool comm_registered;
+    /* libnbc_schedule_cache_size entries, allocated on the first use */
+    NBC_Sched_cache_entry *sched_cache;
+    unsigned long sched_cache_clock;
 #ifdef NBC_CACHE_SCHEDULE
   void *NBC_Dict[NBC_NUM_COLL]; /* this should point to a struct
                                       hb_tree, but since this is a
@@ -112,6 +145,7 @@ struct NBC_Schedule {
     opal_object_t super;
     volatile int size;
     volatile int current_round_offset;
+    int capacity;  /* allocated size of data */
     char *data;
 };
 
@@ -119,6 +153,8 @@ typedef struct NBC_Schedule NBC_Schedule;
 
 OBJ_CLASS_DECLARATION(NBC_Schedule);
 
+struct NBC_Plan;
+
 struct ompi_coll_libnbc_request_t {
     ompi_coll_base_nbc_request_t super;
     MPI_Comm comm;
@@ -130,6 +166,9 @@ struct ompi_coll_libnbc_request_t {
     NBC_Comminfo *comminfo;
     NBC_Schedule *schedule;
     void *tmpbuf; /* temporary buffer e.g. used for Reduce */
+    struct NBC_Plan *plan; /* compiled schedule of a persistent request */
+    int plan_round;        /* current round in the plan */
+    NBC_Sched_cache_entry *cache_entry; /* owner of the schedule and tmpbuf, if cached */
     /* TODO: we should make a handle pointer to a state later (that the user
      * can move request handles) */
 };
@@ -156,6 +195,7 @@ typedef ompi_coll_libnbc_request_t NBC_Handle;
     } while (0)
 
 int ompi_coll_libnbc_progress(void);
+int ompi_coll_libnbc_progress_thread_start(void);
 
 int NBC_Init_comm(MPI_Comm comm, ompi_coll_libnbc_module_t *module);
 int NBC_Progress(NBC_Handle *handle);
@@ -31,9 +31,13 @@
 #include "coll_libnbc.h"
 #include "nbc_internal.h"
 
+#include <time.h>
+
 #include "mpi.h"
 #include "ompi/mca/coll/coll.h"
+#include "ompi/mca/coll/base/base.h"
 #include "ompi/communicator/communicator.h"
+#include "opal/runtime/opal_progress.h"
 
 /*
  * Public string showing the coll ompi_libnbc component version number
@@ -45,6 +49,9 @@ const char *mca_coll_libnbc_component_version_string =
 static int libnbc_priority = 10;
 static bool libnbc_in_progress = false;     /* protect from recursive calls */
 bool libnbc_ibcast_skip_dt_decision = true;
+bool libnbc_persistent_plan = true;
+bool libnbc_progress_thread = false;
+int libnbc_schedule_cache_size = 8;
 
 int libnbc_iallgather_algorithm = 0;             /* iallgather user forced algorithm */
 static mca_base_var_enum_value_t iallgather_algorithms[] = {
@@ -149,6 +156,9 @@ libnbc_open(void)
     OBJ_CONSTRUCT(&mca_coll_libnbc_component.requests, opal_free_list_t);
     OBJ_CONSTRUCT(&mca_coll_libnbc_component.active_requests, opal_list_t);
     OBJ_CONSTRUCT(&mca_coll_libnbc_component.lock, opal_mutex_t);
+    OBJ_CONSTRUCT(&mca_coll_libnbc_component.incoming_requests, opal_fifo_t);
+    OBJ_CONSTRUCT(&mca_coll_libnbc_component.progress_thread, opal_thread_t);
+    mca_coll_libnbc_component.progress_thread_running = 0;
     ret = opal_free_list_init (&mca_coll_libnbc_component.requests,
                                sizeof(ompi_coll_libnbc_request_t), 8,
                                OBJ_CLASS(ompi_coll_libnbc_request_t),
@@ -165,13 +175,21 @@ libnbc_open(void)
 static int
 libnbc_close(void)
 {
-    if (0 != mca_coll_libnbc_component.active_comms) {
+    if (mca_coll_libnbc_component.progress_thread_running) {
+        void *ret = NULL; /* not currently used */
+
+        mca_coll_libnbc_component.progress_thread_running = 0;
+        opal_atomic_wmb();
+        opal_thread_join(&mca_coll_libnbc_component.progress_thread, &ret);
+    } else if (0 != mca_coll_libnbc_component.active_comms) {
         opal_progress_unregister(ompi_coll_libnbc_progress);
     }
 
     OBJ_DESTRUCT(&mca_coll_libnbc_component.requests);
     OBJ_DESTRUCT(&mca_coll_libnbc_component.active_requests);
     OBJ_DESTRUCT(&mca_coll_libnbc_component.lock);
+    OBJ_DESTRUCT(&mca_coll_libnbc_component.incoming_requests);
+    OBJ_DESTRUCT(&mca_coll_libnbc_component.progress_thread);
 
     return OMPI_SUCCESS;
 }
@@ -212,6 +230,33 @@ libnbc_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &libnbc_ibcast_skip_dt_decision);
 
+    libnbc_persistent_plan = true;
+    (void) mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
+                                           "persistent_plan",
+                                           "Compile the schedule of a persistent collective (MPI_<collective>_init) once, into persistent point-to-point requests that each MPI_Start only re-arms. Set to 'false' to walk the schedule at every start.",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &libnbc_persistent_plan);
+
+    libnbc_progress_thread = false;
+    (void) mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
+                                           "progress_thread",
+                                           "Progress the schedules of the non-blocking collectives from a dedicated thread instead of from the MPI calls of the application. Only used with MPI_THREAD_MULTIPLE.",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &libnbc_progress_thread);
+
+    libnbc_schedule_cache_size = 8;
+    (void) mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
+                                           "schedule_cache_size",
+                                           "Number of schedules (with their temporary buffers) each communicator keeps for the next non-blocking collectives called with the same arguments, to skip building them again. 0 disables the cache.",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &libnbc_schedule_cache_size);
+
     libnbc_iallgather_algorithm = 0;
     (void) mca_base_var_enum_create("coll_libnbc_iallgather_algorithms", iallgather_algorithms, &new_enum);
     mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
@@ -292,7 +337,12 @@ static int
 libnbc_init_query(bool enable_progress_threads,
                   bool enable_mpi_threads)
 {
-    /* Nothing to do */
+    /* the progress thread drives the PML concurrently with the application */
+    if (libnbc_progress_thread && !enable_mpi_threads) {
+        opal_output_verbose(10, ompi_coll_base_framework.framework_output,
+                            "coll:libnbc: progress thread disabled, it requires MPI_THREAD_MULTIPLE");
+        libnbc_progress_thread = false;
+    }
     return OMPI_SUCCESS;
 }
 
@@ -424,9 +474,18 @@ int
 ompi_coll_libnbc_progress(void)
 {
     ompi_coll_libnbc_request_t* request, *next;
+    opal_list_item_t *item;
     int res;
     int completed = 0;
 
+    if (!opal_fifo_is_empty (&mca_coll_libnbc_component.incoming_requests)) {
+        OPAL_THREAD_LOCK(&mca_coll_libnbc_component.lock);
+        while (NULL != (item = opal_fifo_pop_atomic (&mca_coll_libnbc_component.incoming_requests))) {
+            opal_list_append (&mca_coll_libnbc_component.active_requests, item);
+        }
+        OPAL_THREAD_UNLOCK(&mca_coll_libnbc_component.lock);
+    }
+
     if (0 == opal_list_get_size (&mca_coll_libnbc_component.active_requests)) {
         /* no requests -- nothing to do. do not grab a lock */
         return 0;
@@ -475,24 +534,74 @@ ompi_coll_libnbc_progress(void)
 }
 
 
+/*
+ * Body of the progress thread: drive the active requests, and the PML
+ * underneath them, until the component is closed. Sleep while there is
+ * nothing to progress.
+ */
+static void *
+libnbc_progress_thread_engine(opal_object_t *obj)
+{
+    struct timespec idle = {0, 1000};
+
+    while (mca_coll_libnbc_component.progress_thread_running) {
+        if (0 == opal_list_get_size (&mca_coll_libnbc_component.active_requests) &&
+            opal_fifo_is_empty (&mca_coll_libnbc_component.incoming_requests)) {
+            nanosleep (&idle, NULL);
+            continue;
+        }
+        ompi_coll_libnbc_progress();
+        opal_progress();
+    }
+
+    return NULL;
+}
+
+
+int
+ompi_coll_libnbc_progress_thread_start(void)
+{
+    int ret = OMPI_SUCCESS;
+
+    OPAL_THREAD_LOCK(&mca_coll_libnbc_component.lock);
+    if (!mca_coll_libnbc_component.progress_thread_running) {
+        mca_coll_libnbc_component.progress_thread_running = 1;
+        mca_coll_libnbc_component.progress_thread.t_run = libnbc_progress_thread_engine;
+        mca_coll_libnbc_component.progress_thread.t_arg = NULL;
+        ret = opal_thread_start(&mca_coll_libnbc_component.progress_thread);
+        if (OPAL_SUCCESS != ret) {
+            opal_output_verbose(10, ompi_coll_base_framework.framework_output,
+                                "coll:libnbc: could not start the progress thread (%d)", ret);
+            mca_coll_libnbc_component.progress_thread_running = 0;
+        }
+    }
+    OPAL_THREAD_UNLOCK(&mca_coll_libnbc_component.lock);
+
+    return ret;
+}
+
+
 static void
 libnbc_module_construct(ompi_coll_libnbc_module_t *module)
 {
     OBJ_CONSTRUCT(&module->mutex, opal_mutex_t);
     module->comm_registered = false;
+    module->sched_cache = NULL;
+    module->sched_cache_clock = 0;
 }
 
 
 static void
 libnbc_module_destruct(ompi_coll_libnbc_module_t *module)
 {
+    NBC_Sched_cache_clear(module);
     OBJ_DESTRUCT(&module->mutex);
 
     /* if we ever were used for a collective op, do the progress cleanup. */
     if (true == module->comm_registered) {
         int32_t tmp =
             OPAL_THREAD_ADD_FETCH32(&mca_coll_libnbc_component.active_comms, -1);
-        if (0 == tmp) {
+        if (0 == tmp && !mca_coll_libnbc_component.progress_thread_running) {
             opal_progress_unregister(ompi_coll_libnbc_progress);
         }
     }
@@ -561,7 +670,12 @@ request_free(struct ompi_request_t **ompi_req)
         return MPI_ERR_REQUEST;
     }
 
-    OMPI_COLL_LIBNBC_REQUEST_RETURN(request);
+    if (request->super.super.req_persistent) {
+        /* release the schedule, and the plan with its requests */
+        NBC_Return_handle(request);
+    } else {
+        OMPI_COLL_LIBNBC_REQUEST_RETURN(request);
+    }
     *ompi_req = MPI_REQUEST_NULL;
 
     return OMPI_SUCCESS;
@@ -576,6 +690,8 @@ request_construct(ompi_coll_libnbc_request_t *request)
     request->super.super.req_start = request_start;
     request->super.super.req_free = request_free;
     request->super.super.req_cancel = request_cancel;
+    request->plan = NULL;
+    request->plan_round = 0;
 }
 
 
@@ -33,6 +33,9 @@
 
 /* only used in this file */
 static inline int NBC_Start_round(NBC_Handle *handle);
+static inline int NBC_Start_plan_round(NBC_Handle *handle);
+static int NBC_Plan_compile(NBC_Handle *handle);
+static void NBC_Plan_free(NBC_Plan *plan);
 
 /* #define NBC_TIMING */
 
@@ -46,11 +49,20 @@ void NBC_Print_times(double div) {
 }
 #endif
 
+/* initial capacity of the schedules: the size of the largest schedule built
+ * so far, up to NBC_SCHED_HWM_MAX, so that they seldom have to grow */
+#define NBC_SCHED_HWM_MAX 16384
+static volatile int nbc_schedule_hwm = 0;
+
 static void nbc_schedule_constructor (NBC_Schedule *schedule) {
   /* initial total size of the schedule */
   schedule->size = sizeof (int);
   schedule->current_round_offset = 0;
-  schedule->data = calloc (1, schedule->size);
+  schedule->capacity = nbc_schedule_hwm > schedule->size ? nbc_schedule_hwm : schedule->size;
+  schedule->data = malloc (schedule->capacity);
+  if (NULL != schedule->data) {
+    memset (schedule->data, 0, sizeof (int));
+  }
 }
 
 static void nbc_schedule_destructor (NBC_Schedule *schedule) {
@@ -63,18 +75,28 @@ OBJ_CLASS_INSTANCE(NBC_Schedule, opal_object_t, nbc_schedule_constructor,
 
 static int nbc_schedule_grow (NBC_Schedule *schedule, int additional) {
   void *tmp;
-  int size;
+  int size, capacity;
 
   /* get current size of schedule */
   size = nbc_schedule_get_size (schedule);
+  if (size + additional <= schedule->capacity) {
+    return OMPI_SUCCESS;
+  }
 
-  tmp = realloc (schedule->data, size + additional);
+  /* grow geometrically, the schedules are built one action at a time */
+  capacity = 2 * schedule->capacity;
+  if (capacity < size + additional) {
+    capacity = size + additional;
+  }
+
+  tmp = realloc (schedule->data, capacity);
   if (NULL == tmp) {
     NBC_Error ("Could not increase the size of NBC schedule");
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
 
   schedule->data = tmp;
+  schedule->capacity = capacity;
   return OMPI_SUCCESS;
 }
 
@@ -288,6 +310,11 @@ int NBC_Sched_commit(NBC_Schedule *schedule) {
   /* increase size of schedule */
   nbc_schedule_inc_size (schedule, 1);
 
+  /* racy, but any value in range does */
+  if (size + 1 > nbc_schedule_hwm && nbc_schedule_hwm < NBC_SCHED_HWM_MAX) {
+    nbc_schedule_hwm = (size + 1 < NBC_SCHED_HWM_MAX) ? size + 1 : NBC_SCHED_HWM_MAX;
+  }
+
   NBC_DEBUG(10, "closed schedule %p at byte %i\n", schedule, (int)(size + 1));
 
   return OMPI_SUCCESS;
@@ -298,12 +325,26 @@ int NBC_Sched_commit(NBC_Schedule *schedule) {
  * to be called *only* from the progress thread !!! */
 static inline void NBC_Free (NBC_Handle* handle) {
 
+  if (NULL != handle->plan) {
+    NBC_Plan_free (handle->plan);
+    handle->plan = NULL;
+  }
+
   if (NULL != handle->schedule) {
     /* release schedule */
     OBJ_RELEASE (handle->schedule);
     handle->schedule = NULL;
   }
 
+  /* the tmpbuf of a cached schedule stays with it */
+  if (NULL != handle->cache_entry) {
+    OPAL_THREAD_LOCK(&handle->comminfo->mutex);
+    handle->cache_entry->busy = false;
+    OPAL_THREAD_UNLOCK(&handle->comminfo->mutex);
+    handle->cache_entry = NULL;
+    handle->tmpbuf = NULL;
+  }
+
   /* if the nbc_I<collective> attached some data */
   /* problems with schedule cache here, see comment (TODO) in
    * nbc_internal.h */
@@ -356,7 +397,9 @@ int NBC_Progress(NBC_Handle *handle) {
                 handle->super.super.req_status.MPI_ERROR = subreq->req_status.MPI_ERROR;
             }
             handle->req_count--;
-            ompi_request_free(&subreq);
+            if (NULL == handle->plan) {
+                ompi_request_free(&subreq);
+            }
         } else {
             flag = false;
             break;
@@ -371,8 +414,10 @@ int NBC_Progress(NBC_Handle *handle) {
   if (flag) {
     /* reset handle for next round */
     if (NULL != handle->req_array) {
-      /* free request array */
-      free (handle->req_array);
+      /* free request array (the plan owns its persistent requests) */
+      if (NULL == handle->plan) {
+        free (handle->req_array);
+      }
       handle->req_array = NULL;
     }
 
@@ -389,6 +434,21 @@ int NBC_Progress(NBC_Handle *handle) {
       return res;
     }
 
+    if (NULL != handle->plan) {
+      if (++handle->plan_round == handle->plan->num_rounds) {
+        NBC_DEBUG(5, "NBC_Progress last plan round finished - we're done\n");
+        handle->nbc_complete = true;
+        return NBC_OK;
+      }
+
+      res = NBC_Start_plan_round(handle);
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        NBC_Error ("Error in NBC_Start_plan_round() (%i)", res);
+        return res;
+      }
+      return ret;
+    }
+
     /* adjust delim to start of current round */
     NBC_DEBUG(5, "NBC_Progress: going in schedule %p to row-offset: %li\n", handle->schedule, handle->row_offset);
     delim = handle->schedule->data + handle->row_offset;
@@ -603,6 +663,231 @@ static inline int NBC_Start_round(NBC_Handle *handle) {
   return OMPI_SUCCESS;
 }
 
+/* runs the local operations of the current plan round, then re-arms its
+ * persistent requests */
+static inline int NBC_Start_plan_round(NBC_Handle *handle) {
+  NBC_Plan_round *round = handle->plan->rounds + handle->plan_round;
+  int res;
+
+  NBC_DEBUG(10, "start_plan_round round %d : %i operations, %i requests\n", handle->plan_round,
+            round->num_actions, round->num_reqs);
+
+  for (int i = 0 ; i < round->num_actions ; ++i) {
+    NBC_Plan_action *action = round->actions + i;
+
+    switch(action->type) {
+      case OP:
+        ompi_op_reduce(action->op, (void *)action->buf1, action->buf2, action->count, action->datatype);
+        break;
+      case COPY:
+        res = NBC_Copy (action->buf1, action->count, action->datatype, action->buf2, action->tgtcount,
+                        action->tgttype, handle->comm);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+          return res;
+        }
+        break;
+      case UNPACK:
+        res = NBC_Unpack ((void *)action->buf1, action->count, action->datatype, action->buf2, handle->comm);
+        if (OMPI_SUCCESS != res) {
+          NBC_Error ("NBC_Unpack() failed (code: %i)", res);
+          return res;
+        }
+        break;
+      default:
+        NBC_Error ("NBC_Start_plan_round: bad type %li", (long)action->type);
+        return OMPI_ERROR;
+    }
+  }
+
+  if (round->num_reqs > 0) {
+    handle->req_array = round->reqs;
+    handle->req_count = round->num_reqs;
+    res = MCA_PML_CALL(start(round->num_reqs, round->reqs));
+    if (OMPI_SUCCESS != res) {
+      NBC_Error ("Error in MCA_PML_CALL(start(%i)) (%i)", round->num_reqs, res);
+      handle->req_array = NULL;
+      handle->req_count = 0;
+      return res;
+    }
+  }
+
+  /* same as NBC_Start_round: no progress from the first round */
+  if (handle->plan_round) {
+    res = NBC_Progress(handle);
+    if ((NBC_OK != res) && (NBC_CONTINUE != res)) {
+      return OMPI_ERROR;
+    }
+  }
+
+  return OMPI_SUCCESS;
+}
+
+static void NBC_Plan_free(NBC_Plan *plan) {
+  for (int i = 0 ; i < plan->num_reqs ; ++i) {
+    if (NULL != plan->reqs[i]) {
+      ompi_request_free(&plan->reqs[i]);
+    }
+  }
+  free (plan->reqs);
+  free (plan->actions);
+  free (plan->rounds);
+  free (plan);
+}
+
+/* compiles the schedule of a persistent request into a NBC_Plan: one walk
+ * to size the arrays, one to create the persistent requests (the tag of a
+ * persistent request never changes) and to resolve the tmpbuf offsets */
+static int NBC_Plan_compile(NBC_Handle *handle) {
+  int num_rounds = 0, num_actions = 0, num_reqs = 0, num, res;
+  MPI_Comm comm;
+  NBC_Fn_type type;
+  NBC_Args_send     sendargs;
+  NBC_Args_recv     recvargs;
+  NBC_Args_op         opargs;
+  NBC_Args_copy     copyargs;
+  NBC_Args_unpack unpackargs;
+  NBC_Plan *plan;
+  NBC_Plan_round *round;
+  NBC_Plan_action *action;
+  ompi_request_t **req;
+  char *ptr, *tmpbuf = (char *) handle->tmpbuf;
+
+  ptr = handle->schedule->data;
+  for (;;) {
+    NBC_GET_BYTES(ptr,num);
+    for (int i = 0 ; i < num ; ++i) {
+      memcpy (&type, ptr, sizeof (type));
+      switch(type) {
+        case SEND:
+          ptr += sizeof (NBC_Args_send);
+          num_reqs++;
+          break;
+        case RECV:
+          ptr += sizeof (NBC_Args_recv);
+          num_reqs++;
+          break;
+        case OP:
+          ptr += sizeof (NBC_Args_op);
+          num_actions++;
+          break;
+        case COPY:
+          ptr += sizeof (NBC_Args_copy);
+          num_actions++;
+          break;
+        case UNPACK:
+          ptr += sizeof (NBC_Args_unpack);
+          num_actions++;
+          break;
+        default:
+          NBC_Error ("NBC_Plan_compile: bad type %li", (long)type);
+          return OMPI_ERROR;
+      }
+    }
+    num_rounds++;
+    if (0 == *ptr) {
+      break;
+    }
+    ptr++;
+  }
+
+  plan = (NBC_Plan *) calloc (1, sizeof (NBC_Plan));
+  if (NULL == plan) {
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
+  plan->rounds = (NBC_Plan_round *) calloc (num_rounds, sizeof (NBC_Plan_round));
+  plan->actions = (NBC_Plan_action *) calloc (num_actions + 1, sizeof (NBC_Plan_action));
+  plan->reqs = (ompi_request_t **) calloc (num_reqs + 1, sizeof (ompi_request_t *));
+  if (NULL == plan->rounds || NULL == plan->actions || NULL == plan->reqs) {
+    NBC_Plan_free (plan);
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
+  plan->num_rounds = num_rounds;
+
+  action = plan->actions;
+  req = plan->reqs;
+  ptr = handle->schedule->data;
+  for (round = plan->rounds ; round < plan->rounds + num_rounds ; ++round, ++ptr) {
+    round->actions = action;
+    round->reqs = req;
+    NBC_GET_BYTES(ptr,num);
+    for (int i = 0 ; i < num ; ++i) {
+      memcpy (&type, ptr, sizeof (type));
+      switch(type) {
+        case SEND:
+          NBC_GET_BYTES(ptr,sendargs);
+          comm = sendargs.local ? handle->comm->c_local_comm : handle->comm;
+          res = MCA_PML_CALL(isend_init(sendargs.tmpbuf ? tmpbuf + (long)sendargs.buf : sendargs.buf,
+                                        sendargs.count, sendargs.datatype, sendargs.dest, handle->tag,
+                                        MCA_PML_BASE_SEND_STANDARD, comm, req));
+          if (OMPI_SUCCESS != res) {
+            NBC_Plan_free (plan);
+            return res;
+          }
+          plan->num_reqs++;
+          round->num_reqs++;
+          req++;
+          break;
+        case RECV:
+          NBC_GET_BYTES(ptr,recvargs);
+          comm = recvargs.local ? handle->comm->c_local_comm : handle->comm;
+          res = MCA_PML_CALL(irecv_init(recvargs.tmpbuf ? tmpbuf + (long)recvargs.buf : recvargs.buf,
+                                        recvargs.count, recvargs.datatype, recvargs.source, handle->tag,
+                                        comm, req));
+          if (OMPI_SUCCESS != res) {
+            NBC_Plan_free (plan);
+            return res;
+          }
+          plan->num_reqs++;
+          round->num_reqs++;
+          req++;
+          break;
+        case OP:
+          NBC_GET_BYTES(ptr,opargs);
+          action->type = OP;
+          action->buf1 = opargs.tmpbuf1 ? tmpbuf + (long)opargs.buf1 : opargs.buf1;
+          action->buf2 = opargs.tmpbuf2 ? tmpbuf + (long)opargs.buf2 : opargs.buf2;
+          action->count = opargs.count;
+          action->datatype = opargs.datatype;
+          action->op = opargs.op;
+          round->num_actions++;
+          action++;
+          break;
+        case COPY:
+          NBC_GET_BYTES(ptr,copyargs);
+          action->type = COPY;
+          action->buf1 = copyargs.tmpsrc ? tmpbuf + (long)copyargs.src : copyargs.src;
+          action->buf2 = copyargs.tmptgt ? tmpbuf + (long)copyargs.tgt : copyargs.tgt;
+          action->count = copyargs.srccount;
+          action->datatype = copyargs.srctype;
+          action->tgtcount = copyargs.tgtcount;
+          action->tgttype = copyargs.tgttype;
+          round->num_actions++;
+          action++;
+          break;
+        case UNPACK:
+          NBC_GET_BYTES(ptr,unpackargs);
+          action->type = UNPACK;
+          action->buf1 = unpackargs.tmpinbuf ? tmpbuf + (long)unpackargs.inbuf : unpackargs.inbuf;
+          action->buf2 = unpackargs.tmpoutbuf ? tmpbuf + (long)unpackargs.outbuf : unpackargs.outbuf;
+          action->count = unpackargs.count;
+          action->datatype = unpackargs.datatype;
+          round->num_actions++;
+          action++;
+          break;
+        default:
+          /* already checked above */
+          break;
+      }
+    }
+  }
+
+  NBC_DEBUG(5, "compiled schedule %p into %i rounds, %i requests, %i operations\n", handle->schedule,
+            num_rounds, num_reqs, num_actions);
+
+  handle->plan = plan;
+  return OMPI_SUCCESS;
+}
+
 void NBC_Return_handle(ompi_coll_libnbc_request_t *request) {
   NBC_Free (request);
   OMPI_COLL_LIBNBC_REQUEST_RETURN(request);
@@ -670,14 +955,24 @@ int NBC_Start(NBC_Handle *handle) {
   /* kick off first round */
   handle->super.super.req_state = OMPI_REQUEST_ACTIVE;
   handle->super.super.req_status.MPI_ERROR = OMPI_SUCCESS;
-  res = NBC_Start_round(handle);
+  if (NULL != handle->plan) {
+    handle->plan_round = 0;
+    res = NBC_Start_plan_round(handle);
+  } else {
+    res = NBC_Start_round(handle);
+  }
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
     return res;
   }
 
-  OPAL_THREAD_LOCK(&mca_coll_libnbc_component.lock);
-  opal_list_append(&mca_coll_libnbc_component.active_requests, (opal_list_item_t *)handle);
-  OPAL_THREAD_UNLOCK(&mca_coll_libnbc_component.lock);
+  if (mca_coll_libnbc_component.progress_thread_running) {
+    /* hand over to the progress thread, without taking its lock */
+    opal_fifo_push_atomic(&mca_coll_libnbc_component.incoming_requests, (opal_list_item_t *)handle);
+  } else {
+    OPAL_THREAD_LOCK(&mca_coll_libnbc_component.lock);
+    opal_list_append(&mca_coll_libnbc_component.active_requests, (opal_list_item_t *)handle);
+    OPAL_THREAD_UNLOCK(&mca_coll_libnbc_component.lock);
+  }
 
   return OMPI_SUCCESS;
 }
@@ -714,6 +1009,9 @@ int NBC_Schedule_request(NBC_Schedule *schedule, ompi_communicator_t *comm,
   handle->req_array = NULL;
   handle->comm = comm;
   handle->schedule = NULL;
+  handle->plan = NULL;
+  handle->plan_round = 0;
+  handle->cache_entry = NULL;
   handle->row_offset = 0;
   handle->nbc_complete = persistent ? true : false;
 
@@ -734,7 +1032,10 @@ int NBC_Schedule_request(NBC_Schedule *schedule, ompi_communicator_t *comm,
       int32_t tmp =
           OPAL_THREAD_ADD_FETCH32(&mca_coll_libnbc_component.active_comms, 1);
       if (tmp == 1) {
-          opal_progress_register(ompi_coll_libnbc_progress);
+          if (!libnbc_progress_thread ||
+              OMPI_SUCCESS != ompi_coll_libnbc_progress_thread_start()) {
+              opal_progress_register(ompi_coll_libnbc_progress);
+          }
       }
   }
 
@@ -749,9 +1050,150 @@ int NBC_Schedule_request(NBC_Schedule *schedule, ompi_communicator_t *comm,
   handle->schedule = schedule;
   *request = (ompi_request_t *) handle;
 
+  /* a persistent request is started again and again with the same
+   * arguments: resolve its schedule once. If that fails, every start
+   * walks the schedule instead. */
+  if (persistent && libnbc_persistent_plan) {
+    ret = NBC_Plan_compile(handle);
+    if (OMPI_SUCCESS != ret) {
+      NBC_DEBUG(1, "NBC_Plan_compile failed (%i), using the schedule\n", ret);
+    }
+  }
+
+  return OMPI_SUCCESS;
+}
+
+static bool nbc_sched_key_equal(const NBC_Sched_key *a, const NBC_Sched_key *b) {
+  return a->coll == b->coll && a->sendbuf == b->sendbuf && a->recvbuf == b->recvbuf &&
+         a->count == b->count && a->datatype == b->datatype && a->op == b->op &&
+         a->root == b->root;
+}
+
+static void nbc_sched_cache_evict(NBC_Sched_cache_entry *entry) {
+  if (entry->key.coll < 0) {
+    return;
+  }
+  OBJ_RELEASE(entry->schedule);
+  free(entry->tmpbuf);
+  if (NULL != entry->key.datatype) {
+    OBJ_RELEASE(entry->key.datatype);
+  }
+  if (NULL != entry->key.op) {
+    OBJ_RELEASE(entry->key.op);
+  }
+  entry->key.coll = -1;
+  entry->schedule = NULL;
+  entry->tmpbuf = NULL;
+}
+
+int NBC_Sched_cache_request(const NBC_Sched_key *key, ompi_communicator_t *comm,
+                            ompi_coll_libnbc_module_t *module, bool persistent,
+                            ompi_request_t **request) {
+  NBC_Sched_cache_entry *entry = NULL;
+  NBC_Handle *handle;
+  int res;
+
+  /* a persistent request keeps its schedule and tmpbuf for itself */
+  if (persistent || NULL == module->sched_cache) {
+    return OMPI_ERR_NOT_FOUND;
+  }
+
+  OPAL_THREAD_LOCK(&module->mutex);
+  for (int i = 0 ; i < libnbc_schedule_cache_size ; ++i) {
+    if (!module->sched_cache[i].busy && nbc_sched_key_equal(&module->sched_cache[i].key, key)) {
+      entry = &module->sched_cache[i];
+      entry->busy = true;
+      entry->last_use = ++module->sched_cache_clock;
+      break;
+    }
+  }
+  OPAL_THREAD_UNLOCK(&module->mutex);
+  if (NULL == entry) {
+    return OMPI_ERR_NOT_FOUND;
+  }
+
+  OBJ_RETAIN(entry->schedule);
+  res = NBC_Schedule_request(entry->schedule, comm, module, false, request, NULL);
+  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    OBJ_RELEASE(entry->schedule);
+    OPAL_THREAD_LOCK(&module->mutex);
+    entry->busy = false;
+    OPAL_THREAD_UNLOCK(&module->mutex);
+    return res;
+  }
+
+  handle = *(NBC_Handle **) request;
+  handle->tmpbuf = entry->tmpbuf;
+  handle->cache_entry = entry;
   return OMPI_SUCCESS;
 }
 
+int NBC_Schedule_request_cached(NBC_Schedule *schedule, const NBC_Sched_key *key,
+                                ompi_communicator_t *comm, ompi_coll_libnbc_module_t *module,
+                                bool persistent, ompi_request_t **request, void *tmpbuf) {
+  NBC_Sched_cache_entry *entry = NULL;
+  int res;
+
+  res = NBC_Schedule_request(schedule, comm, module, persistent, request, tmpbuf);
+  if (OMPI_SUCCESS != res || persistent || &ompi_request_empty == *request ||
+      0 >= libnbc_schedule_cache_size) {
+    return res;
+  }
+
+  OPAL_THREAD_LOCK(&module->mutex);
+  if (NULL == module->sched_cache) {
+    module->sched_cache = (NBC_Sched_cache_entry *) calloc(libnbc_schedule_cache_size,
+                                                           sizeof(NBC_Sched_cache_entry));
+    for (int i = 0 ; NULL != module->sched_cache && i < libnbc_schedule_cache_size ; ++i) {
+      module->sched_cache[i].key.coll = -1;
+    }
+  }
+  /* an empty entry, or else the least recently used one that is not lent */
+  for (int i = 0 ; NULL != module->sched_cache && i < libnbc_schedule_cache_size ; ++i) {
+    NBC_Sched_cache_entry *e = &module->sched_cache[i];
+    if (e->busy) {
+      continue;
+    }
+    if (e->key.coll < 0) {
+      entry = e;
+      break;
+    }
+    if (NULL == entry || e->last_use < entry->last_use) {
+      entry = e;
+    }
+  }
+  if (NULL != entry) {
+    nbc_sched_cache_evict(entry);
+    entry->key = *key;
+    if (NULL != key->datatype) {
+      OBJ_RETAIN(key->datatype);
+    }
+    if (NULL != key->op) {
+      OBJ_RETAIN(key->op);
+    }
+    OBJ_RETAIN(schedule);
+    entry->schedule = schedule;
+    entry->tmpbuf = tmpbuf;
+    entry->busy = true;
+    entry->last_use = ++module->sched_cache_clock;
+    ((NBC_Handle *) *request)->cache_entry = entry;
+  }
+  OPAL_THREAD_UNLOCK(&module->mutex);
+
+  return OMPI_SUCCESS;
+}
+
+void NBC_Sched_cache_clear(ompi_coll_libnbc_module_t *module) {
+  if (NULL == module->sched_cache) {
+    return;
+  }
+  for (int i = 0 ; i < libnbc_schedule_cache_size ; ++i) {
+    nbc_sched_cache_evict(&module->sched_cache[i]);
+  }
+  free(module->sched_cache);
+  module->sched_cache = NULL;
+}
+
 #ifdef NBC_CACHE_SCHEDULE
 void NBC_SchedCache_args_delete_key_dummy(void *k) {
     /* do nothing because the key and the data element are identical :-)
@@ -106,6 +106,13 @@ static int nbc_allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI
     return nbc_get_noop_request(persistent, request);
   }
 
+  /* same arguments as a previous call: reuse its schedule */
+  NBC_Sched_key key = {NBC_ALLREDUCE, sendbuf, recvbuf, count, datatype, op, 0};
+  res = NBC_Sched_cache_request(&key, comm, libnbc_module, persistent, request);
+  if (OMPI_ERR_NOT_FOUND != res) {
+    return res;
+  }
+
   span = opal_datatype_span(&datatype->super, count, &gap);
   tmpbuf = malloc (span);
   if (OPAL_UNLIKELY(NULL == tmpbuf)) {
@@ -214,7 +221,7 @@ static int nbc_allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI
   }
 #endif
 
-  res = NBC_Schedule_request (schedule, comm, libnbc_module, persistent, request, tmpbuf);
+  res = NBC_Schedule_request_cached (schedule, &key, comm, libnbc_module, persistent, request, tmpbuf);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
     OBJ_RELEASE(schedule);
     free(tmpbuf);
@@ -32,6 +32,13 @@ static int nbc_barrier_init(struct ompi_communicator_t *comm, ompi_request_t **
   rank = ompi_comm_rank (comm);
   p = ompi_comm_size (comm);
 
+  /* the schedule only depends on the communicator */
+  NBC_Sched_key key = {NBC_BARRIER, NULL, NULL, 0, NULL, NULL, 0};
+  res = NBC_Sched_cache_request(&key, comm, libnbc_module, persistent, request);
+  if (OMPI_ERR_NOT_FOUND != res) {
+    return res;
+  }
+
 #ifdef NBC_CACHE_SCHEDULE
   /* there only one argument set per communicator -> hang it directly at
    * the tree-position, NBC_Dict_size[...] is 0 for not initialized and
@@ -90,7 +97,7 @@ static int nbc_barrier_init(struct ompi_communicator_t *comm, ompi_request_t **
   OBJ_RETAIN(schedule);
 #endif
 
-  res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, NULL);
+  res = NBC_Schedule_request_cached(schedule, &key, comm, libnbc_module, persistent, request, NULL);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
     OBJ_RELEASE(schedule);
     return res;
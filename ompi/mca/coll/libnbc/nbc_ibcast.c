@@ -112,6 +112,12 @@ static int nbc_bcast_init(void *buffer, int count, MPI_Datatype datatype, int ro
     }
   }
 
+  NBC_Sched_key key = {NBC_BCAST, buffer, buffer, count, datatype, NULL, root};
+  res = NBC_Sched_cache_request(&key, comm, libnbc_module, persistent, request);
+  if (OMPI_ERR_NOT_FOUND != res) {
+    return res;
+  }
+
 #ifdef NBC_CACHE_SCHEDULE
   /* search schedule in communicator specific tree */
   search.buffer = buffer;
@@ -182,7 +188,7 @@ static int nbc_bcast_init(void *buffer, int count, MPI_Datatype datatype, int ro
   }
 #endif
 
-  res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, NULL);
+  res = NBC_Schedule_request_cached(schedule, &key, comm, libnbc_module, persistent, request, NULL);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
     OBJ_RELEASE(schedule);
     return res;
@@ -160,6 +160,36 @@ int NBC_Sched_unpack (void *inbuf, char tmpinbuf, int count, MPI_Datatype dataty
 int NBC_Sched_barrier (NBC_Schedule *schedule);
 int NBC_Sched_commit (NBC_Schedule *schedule);
 
+/* a persistent request's schedule compiled into flat arrays: the sends
+ * and receives of a round are persistent PML requests that every start
+ * only re-arms, and the local operations have their buffers resolved */
+typedef struct {
+  NBC_Fn_type type;       /* OP, COPY or UNPACK */
+  int count;              /* OP count, COPY srccount, UNPACK count */
+  int tgtcount;           /* COPY */
+  const void *buf1;       /* OP buf1, COPY src, UNPACK inbuf */
+  void *buf2;             /* OP buf2, COPY tgt, UNPACK outbuf */
+  MPI_Datatype datatype;  /* OP datatype, COPY srctype, UNPACK datatype */
+  MPI_Datatype tgttype;   /* COPY */
+  MPI_Op op;              /* OP */
+} NBC_Plan_action;
+
+typedef struct {
+  int num_actions;
+  NBC_Plan_action *actions;
+  int num_reqs;
+  ompi_request_t **reqs;
+} NBC_Plan_round;
+
+struct NBC_Plan {
+  int num_rounds;
+  NBC_Plan_round *rounds;
+  int num_reqs;
+  ompi_request_t **reqs;       /* all the persistent requests, by round */
+  NBC_Plan_action *actions;    /* all the local operations, by round */
+};
+typedef struct NBC_Plan NBC_Plan;
+
 #ifdef NBC_CACHE_SCHEDULE
 /* this is a dummy structure which is used to get the schedule out of
  * the collop specific structure. The schedule pointer HAS to be at the
@@ -267,6 +297,19 @@ int NBC_Schedule_request(NBC_Schedule *schedule, ompi_communicator_t *comm,
                          ompi_coll_libnbc_module_t *module, bool persistent,
                          ompi_request_t **request, void *tmpbuf);
 void NBC_Return_handle(ompi_coll_libnbc_request_t *request);
+
+/* the schedule cache of the communicator, for the non-persistent requests:
+ * NBC_Sched_cache_request starts a request from a cached schedule built for
+ * key, and returns OMPI_ERR_NOT_FOUND if there is none available;
+ * NBC_Schedule_request_cached is NBC_Schedule_request that also keeps the
+ * schedule and its tmpbuf in the cache for the next calls */
+int NBC_Sched_cache_request(const NBC_Sched_key *key, ompi_communicator_t *comm,
+                            ompi_coll_libnbc_module_t *module, bool persistent,
+                            ompi_request_t **request);
+int NBC_Schedule_request_cached(NBC_Schedule *schedule, const NBC_Sched_key *key,
+                                ompi_communicator_t *comm, ompi_coll_libnbc_module_t *module,
+                                bool persistent, ompi_request_t **request, void *tmpbuf);
+void NBC_Sched_cache_clear(ompi_coll_libnbc_module_t *module);
 static inline int NBC_Type_intrinsic(MPI_Datatype type);
 int NBC_Create_fortran_handle(int *fhandle, NBC_Handle **handle);
 
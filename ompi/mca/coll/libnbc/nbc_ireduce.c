@@ -125,6 +125,12 @@ static int nbc_reduce_init(const void* sendbuf, void* recvbuf, int count, MPI_Da
     }
   }
 
+  NBC_Sched_key key = {NBC_REDUCE, sendbuf, recvbuf, count, datatype, op, root};
+  res = NBC_Sched_cache_request(&key, comm, libnbc_module, persistent, request);
+  if (OMPI_ERR_NOT_FOUND != res) {
+    return res;
+  }
+
   /* allocate temporary buffers */
   if (alg == NBC_RED_REDSCAT_GATHER || alg == NBC_RED_BINOMIAL) {
     if (rank == root) {
@@ -227,7 +233,7 @@ static int nbc_reduce_init(const void* sendbuf, void* recvbuf, int count, MPI_Da
   }
 #endif
 
-  res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, tmpbuf);
+  res = NBC_Schedule_request_cached(schedule, &key, comm, libnbc_module, persistent, request, tmpbuf);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
     OBJ_RELEASE(schedule);
     free(tmpbuf);
@@ -0,0 +1,177 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * The mcast component runs large MPI_Bcast over an InfiniBand UD
+ * multicast group: the root injects every packet once and the switches
+ * replicate it, so neither the root nor the inner nodes of a tree limit
+ * the throughput.
+ *
+ * It only handles the communicators that have one process per node, in
+ * practice the inter-node (leaders) communicators of HAN, so the
+ * intra-node stage of the broadcast stays in HAN over shared memory.
+ *
+ * UD is unreliable.  Once the root has multicast the payload, every
+ * receiver sends it a NACK (over the PML) listing the packets it
+ * missed, an empty NACK standing for an ACK.  The root repairs the
+ * losses with point-to-point sends.
+ *
+ * The group is joined lazily, on the first broadcast that qualifies.
+ * If any process cannot join, the communicator falls back to the
+ * knomial broadcast of coll/base for its large broadcasts.  Small or
+ * non contiguous broadcasts are forwarded to the underlying module.
+ */
+
+#ifndef MCA_COLL_MCAST_EXPORT_H
+#define MCA_COLL_MCAST_EXPORT_H
+
+#include "ompi_config.h"
+
+#include "mpi.h"
+
+#include "opal/class/opal_object.h"
+#include "opal/mca/mca.h"
+
+#include "ompi/constants.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/mca/coll/base/base.h"
+#include "ompi/communicator/communicator.h"
+
+#include <netinet/in.h>
+#include <infiniband/verbs.h>
+#include <rdma/rdma_cma.h>
+
+BEGIN_C_DECLS
+
+/* Space the HCA writes in front of every UD receive */
+#define MCA_COLL_MCAST_GRH_SIZE 40
+
+typedef struct mca_coll_mcast_hdr_t {
+    uint32_t magic;     /* identifies the communicator in the group */
+    uint32_t seq;       /* broadcast number on this communicator */
+    uint32_t psn;       /* packet number in this broadcast */
+    uint32_t npkts;     /* number of packets of this broadcast */
+} mca_coll_mcast_hdr_t;
+
+/* Multicast endpoint of a communicator */
+typedef struct mca_coll_mcast_ctx_t {
+    struct rdma_event_channel *channel;
+    struct rdma_cm_id *id;
+    struct ibv_pd *pd;
+    struct ibv_cq *send_cq;
+    struct ibv_cq *recv_cq;
+    struct ibv_ah *ah;
+    struct sockaddr_in group_addr;
+    uint32_t remote_qpn;
+    uint32_t remote_qkey;
+    bool joined;
+
+    /* receive ring, then send ring, in one registration */
+    char *buf;
+    struct ibv_mr *mr;
+    size_t slot_size;       /* GRH + header + payload */
+    size_t payload;         /* payload bytes per packet */
+    int recv_depth;
+    int send_depth;
+    int send_head;          /* next send slot */
+    int send_posted;        /* sends not completed yet */
+} mca_coll_mcast_ctx_t;
+
+typedef enum {
+    MCA_COLL_MCAST_STATE_IDLE = 0,  /* group not joined yet */
+    MCA_COLL_MCAST_STATE_READY,     /* every process joined the group */
+    MCA_COLL_MCAST_STATE_DISABLED,  /* at least one process could not join */
+} mca_coll_mcast_state_t;
+
+/* API functions */
+
+int mca_coll_mcast_init_query(bool enable_progress_threads,
+                              bool enable_mpi_threads);
+mca_coll_base_module_t
+*mca_coll_mcast_comm_query(struct ompi_communicator_t *comm,
+                           int *priority);
+
+int mca_coll_mcast_module_enable(mca_coll_base_module_t *module,
+                                 struct ompi_communicator_t *comm);
+
+int mca_coll_mcast_bcast(void *buff, int count,
+                         struct ompi_datatype_t *datatype, int root,
+                         struct ompi_communicator_t *comm,
+                         mca_coll_base_module_t *module);
+
+/* Transport */
+
+/* Join the multicast group of the communicator and post the receive ring */
+int mca_coll_mcast_ctx_init(mca_coll_mcast_ctx_t *ctx,
+                            struct ompi_communicator_t *comm,
+                            uint32_t magic);
+void mca_coll_mcast_ctx_fini(mca_coll_mcast_ctx_t *ctx);
+
+/* Multicast one packet, the payload is copied into a send slot */
+int mca_coll_mcast_ctx_send(mca_coll_mcast_ctx_t *ctx,
+                            const mca_coll_mcast_hdr_t *hdr,
+                            const void *payload, size_t len);
+/* Wait until all the posted sends completed */
+int mca_coll_mcast_ctx_flush(mca_coll_mcast_ctx_t *ctx);
+
+/* Poll one received packet.  Return 1 and set hdr, payload and len if a
+ * packet was received, 0 if none, or an error.  The slot must be given
+ * back with mca_coll_mcast_ctx_repost once the payload is consumed. */
+int mca_coll_mcast_ctx_poll(mca_coll_mcast_ctx_t *ctx,
+                            mca_coll_mcast_hdr_t **hdr,
+                            void **payload, size_t *len,
+                            uint64_t *slot);
+int mca_coll_mcast_ctx_repost(mca_coll_mcast_ctx_t *ctx, uint64_t slot);
+
+/* Types */
+/* Module */
+
+typedef struct mca_coll_mcast_module_t {
+    mca_coll_base_module_t super;
+
+    /* Pointers to the "real" collective functions */
+    mca_coll_base_comm_coll_t c_coll;
+
+    mca_coll_mcast_state_t state;
+    mca_coll_mcast_ctx_t ctx;
+    uint32_t magic;
+    uint32_t seq;
+} mca_coll_mcast_module_t;
+
+OBJ_CLASS_DECLARATION(mca_coll_mcast_module_t);
+
+/* Component */
+
+typedef struct mca_coll_mcast_component_t {
+    mca_coll_base_component_2_4_0_t super;
+
+    int priority;           /* Priority of this component */
+    bool enable;            /* The component is opt-in */
+    int min_comm_size;      /* Smaller communicators are not handled */
+    size_t min_bytes;       /* Smaller payloads are forwarded */
+    char *if_include;       /* IPoIB interface used to join the groups */
+    int mtu;                /* Bytes per UD packet, header included */
+    int recv_depth;         /* Receive ring, in packets */
+    int send_depth;         /* Send ring, in packets */
+    int nack_timeout;       /* Silence (usec) after which a receiver NACKs */
+    int knomial_radix;      /* Radix of the fallback broadcast */
+} mca_coll_mcast_component_t;
+
+/* Globally exported variables */
+
+OMPI_MODULE_DECLSPEC extern mca_coll_mcast_component_t mca_coll_mcast_component;
+
+END_C_DECLS
+
+#endif /* MCA_COLL_MCAST_EXPORT_H */
@@ -0,0 +1,335 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "mpi.h"
+
+#include "opal/util/output.h"
+#include "opal/mca/timer/base/base.h"
+
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/request/request.h"
+#include "ompi/mca/pml/pml.h"
+#include "ompi/mca/coll/base/coll_tags.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "coll_mcast.h"
+
+#define MCAST_BIT_IS_SET(map, i) ((map)[(i) >> 3] & (1 << ((i) & 7)))
+#define MCAST_BIT_SET(map, i)    ((map)[(i) >> 3] |= (uint8_t)(1 << ((i) & 7)))
+
+/*
+ * Join the group on every process, or on none.  The payload of a packet
+ * is the smallest one of the communicator, the ports may not all run the
+ * same MTU.
+ */
+static void mcast_setup(mca_coll_mcast_module_t *s,
+                        struct ompi_communicator_t *comm)
+{
+    int local[2], global[2], ret;
+
+    local[0] = (OMPI_SUCCESS == mca_coll_mcast_ctx_init(&s->ctx, comm, s->magic));
+    local[1] = local[0] ? (int)s->ctx.payload : INT_MAX;
+
+    ret = s->c_coll.coll_allreduce(local, global, 2, MPI_INT, MPI_MIN, comm,
+                                   s->c_coll.coll_allreduce_module);
+    if (OMPI_SUCCESS == ret && global[0]) {
+        s->ctx.payload = (size_t)global[1];
+        s->state = MCA_COLL_MCAST_STATE_READY;
+        return;
+    }
+
+    if (local[0]) {
+        mca_coll_mcast_ctx_fini(&s->ctx);
+    }
+    opal_output_verbose(1, ompi_coll_base_framework.framework_output,
+                        "coll:mcast (%d/%s): the multicast group could not be joined everywhere, "
+                        "falling back to the knomial broadcast",
+                        comm->c_contextid, comm->c_name);
+    s->state = MCA_COLL_MCAST_STATE_DISABLED;
+}
+
+/* Give back the packets sitting in the receive ring, the root gets its own
+ * packets back through the loopback of the HCA */
+static int mcast_drain(mca_coll_mcast_ctx_t *ctx)
+{
+    mca_coll_mcast_hdr_t *hdr;
+    void *payload;
+    uint64_t slot;
+    size_t len;
+    int n;
+
+    while (0 < (n = mca_coll_mcast_ctx_poll(ctx, &hdr, &payload, &len, &slot))) {
+        if (OMPI_SUCCESS != mca_coll_mcast_ctx_repost(ctx, slot)) {
+            return OMPI_ERROR;
+        }
+    }
+    return n;
+}
+
+static inline size_t mcast_pkt_len(size_t bytes, size_t payload, uint32_t psn)
+{
+    size_t offset = (size_t)psn * payload;
+    return bytes - offset < payload ? bytes - offset : payload;
+}
+
+static int mcast_bcast_root(mca_coll_mcast_module_t *s, char *ptr, size_t bytes,
+                            uint32_t npkts, struct ompi_communicator_t *comm)
+{
+    mca_coll_mcast_ctx_t *ctx = &s->ctx;
+    ompi_request_t **reqs = NULL;
+    size_t nreqs = 0, max_reqs = 0, map_len;
+    mca_coll_mcast_hdr_t hdr;
+    ompi_status_public_t status;
+    uint8_t *map = NULL;
+    int ret, i;
+    uint32_t psn;
+
+    hdr.magic = s->magic;
+    hdr.seq = s->seq;
+    hdr.npkts = npkts;
+    for (psn = 0; psn < npkts; ++psn) {
+        hdr.psn = psn;
+        ret = mca_coll_mcast_ctx_send(ctx, &hdr, ptr + (size_t)psn * ctx->payload,
+                                      mcast_pkt_len(bytes, ctx->payload, psn));
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+    }
+    ret = mca_coll_mcast_ctx_flush(ctx);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+    ret = mcast_drain(ctx);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    /* One NACK per receiver, in the order they come.  A NACK is the bitmap
+     * of the missing packets, an empty one means all of them arrived. */
+    map_len = (npkts + 7) / 8;
+    map = (uint8_t *)malloc(map_len);
+    if (NULL == map) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    for (i = 1; i < ompi_comm_size(comm); ++i) {
+        ret = MCA_PML_CALL(recv(map, (int)map_len, MPI_BYTE, MPI_ANY_SOURCE,
+                                MCA_COLL_BASE_TAG_MCAST, comm, &status));
+        if (OMPI_SUCCESS != ret) {
+            goto cleanup;
+        }
+        if (0 == status._ucount) {
+            continue;
+        }
+        for (psn = 0; psn < npkts; ++psn) {
+            if (!MCAST_BIT_IS_SET(map, psn)) {
+                continue;
+            }
+            if (nreqs == max_reqs) {
+                ompi_request_t **tmp;
+                max_reqs = 0 == max_reqs ? 64 : 2 * max_reqs;
+                tmp = (ompi_request_t **)realloc(reqs, max_reqs * sizeof(*reqs));
+                if (NULL == tmp) {
+                    ret = OMPI_ERR_OUT_OF_RESOURCE;
+                    goto cleanup;
+                }
+                reqs = tmp;
+            }
+            ret = MCA_PML_CALL(isend(ptr + (size_t)psn * ctx->payload,
+                                     (int)mcast_pkt_len(bytes, ctx->payload, psn), MPI_BYTE,
+                                     status.MPI_SOURCE, MCA_COLL_BASE_TAG_MCAST,
+                                     MCA_PML_BASE_SEND_STANDARD, comm, &reqs[nreqs]));
+            if (OMPI_SUCCESS != ret) {
+                goto cleanup;
+            }
+            nreqs++;
+        }
+    }
+
+ cleanup:
+    if (nreqs > 0) {
+        int wret = ompi_request_wait_all(nreqs, reqs, MPI_STATUSES_IGNORE);
+        if (OMPI_SUCCESS == ret) {
+            ret = wret;
+        }
+    }
+    free(reqs);
+    free(map);
+    return ret;
+}
+
+static int mcast_bcast_leaf(mca_coll_mcast_module_t *s, char *ptr, size_t bytes,
+                            uint32_t npkts, int root, struct ompi_communicator_t *comm)
+{
+    mca_coll_mcast_ctx_t *ctx = &s->ctx;
+    ompi_request_t **reqs = NULL;
+    mca_coll_mcast_hdr_t *hdr;
+    size_t map_len, len, nmissing = 0;
+    uint32_t received = 0, psn;
+    opal_timer_t last;
+    uint8_t *map;
+    uint64_t slot;
+    void *payload;
+    int ret = OMPI_SUCCESS, n;
+
+    map_len = (npkts + 7) / 8;
+    map = (uint8_t *)calloc(map_len, 1);
+    if (NULL == map) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    last = opal_timer_base_get_usec();
+    while (received < npkts) {
+        n = mca_coll_mcast_ctx_poll(ctx, &hdr, &payload, &len, &slot);
+        if (n < 0) {
+            ret = n;
+            goto cleanup;
+        }
+        if (0 == n) {
+            if (opal_timer_base_get_usec() - last > (opal_timer_t)mca_coll_mcast_component.nack_timeout) {
+                break;
+            }
+            continue;
+        }
+        last = opal_timer_base_get_usec();
+        psn = hdr->psn;
+        /* packets of other communicators, or late ones of a previous broadcast */
+        if (hdr->magic == s->magic && hdr->seq == s->seq && hdr->npkts == npkts &&
+            psn < npkts && !MCAST_BIT_IS_SET(map, psn) &&
+            len == mcast_pkt_len(bytes, ctx->payload, psn)) {
+            memcpy(ptr + (size_t)psn * ctx->payload, payload, len);
+            MCAST_BIT_SET(map, psn);
+            received++;
+        }
+        ret = mca_coll_mcast_ctx_repost(ctx, slot);
+        if (OMPI_SUCCESS != ret) {
+            goto cleanup;
+        }
+    }
+
+    /* Post the repairs before asking for them, then flip the bitmap into
+     * the list of the missing packets */
+    nmissing = npkts - received;
+    if (nmissing > 0) {
+        size_t r = 0;
+        reqs = (ompi_request_t **)malloc(nmissing * sizeof(*reqs));
+        if (NULL == reqs) {
+            ret = OMPI_ERR_OUT_OF_RESOURCE;
+            goto cleanup;
+        }
+        for (psn = 0; psn < npkts; ++psn) {
+            if (MCAST_BIT_IS_SET(map, psn)) {
+                continue;
+            }
+            ret = MCA_PML_CALL(irecv(ptr + (size_t)psn * ctx->payload,
+                                     (int)mcast_pkt_len(bytes, ctx->payload, psn), MPI_BYTE,
+                                     root, MCA_COLL_BASE_TAG_MCAST, comm, &reqs[r]));
+            if (OMPI_SUCCESS != ret) {
+                nmissing = r;
+                goto cleanup;
+            }
+            r++;
+        }
+        for (size_t i = 0; i < map_len; ++i) {
+            map[i] = (uint8_t)~map[i];
+        }
+    }
+    ret = MCA_PML_CALL(send(map, nmissing > 0 ? (int)map_len : 0, MPI_BYTE, root,
+                            MCA_COLL_BASE_TAG_MCAST, MCA_PML_BASE_SEND_STANDARD, comm));
+
+ cleanup:
+    if (nmissing > 0 && NULL != reqs) {
+        int wret = ompi_request_wait_all(nmissing, reqs, MPI_STATUSES_IGNORE);
+        if (OMPI_SUCCESS == ret) {
+            ret = wret;
+        }
+    }
+    free(reqs);
+    free(map);
+    return ret;
+}
+
+/*
+ * Broadcast over the multicast group.  The barrier makes sure the
+ * receivers poll before the root floods the group, what they still miss
+ * is repaired by the root over the PML.
+ */
+int mca_coll_mcast_bcast(void *buff, int count,
+                         struct ompi_datatype_t *datatype, int root,
+                         struct ompi_communicator_t *comm,
+                         mca_coll_base_module_t *module)
+{
+    mca_coll_mcast_module_t *s = (mca_coll_mcast_module_t *) module;
+    ptrdiff_t true_lb, true_extent;
+    char *ptr, *tmp = NULL;
+    size_t dsize, bytes;
+    uint32_t npkts;
+    int ret;
+
+    /* Only the size is the same everywhere, the layout may not be */
+    ompi_datatype_type_size(datatype, &dsize);
+    bytes = dsize * (size_t)count;
+    if (bytes < mca_coll_mcast_component.min_bytes || bytes > INT_MAX) {
+        return s->c_coll.coll_bcast(buff, count, datatype, root, comm,
+                                    s->c_coll.coll_bcast_module);
+    }
+
+    if (MCA_COLL_MCAST_STATE_IDLE == s->state) {
+        mcast_setup(s, comm);
+    }
+    if (MCA_COLL_MCAST_STATE_DISABLED == s->state) {
+        return ompi_coll_base_bcast_intra_knomial(buff, count, datatype, root, comm, module,
+                                                  0, mca_coll_mcast_component.knomial_radix);
+    }
+
+    if (ompi_datatype_is_contiguous_memory_layout(datatype, count)) {
+        ompi_datatype_get_true_extent(datatype, &true_lb, &true_extent);
+        ptr = (char *)buff + true_lb;
+    } else {
+        tmp = ptr = (char *)malloc(bytes);
+        if (NULL == tmp) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        if (ompi_comm_rank(comm) == root) {
+            ret = ompi_datatype_sndrcv(buff, count, datatype, tmp, (int32_t)bytes, MPI_BYTE);
+            if (OMPI_SUCCESS != ret) {
+                goto cleanup;
+            }
+        }
+    }
+
+    ret = s->c_coll.coll_barrier(comm, s->c_coll.coll_barrier_module);
+    if (OMPI_SUCCESS != ret) {
+        goto cleanup;
+    }
+
+    s->seq++;
+    npkts = (uint32_t)((bytes + s->ctx.payload - 1) / s->ctx.payload);
+    if (ompi_comm_rank(comm) == root) {
+        ret = mcast_bcast_root(s, ptr, bytes, npkts, comm);
+    } else {
+        ret = mcast_bcast_leaf(s, ptr, bytes, npkts, root, comm);
+        if (OMPI_SUCCESS == ret && NULL != tmp) {
+            ret = ompi_datatype_sndrcv(tmp, (int32_t)bytes, MPI_BYTE, buff, count, datatype);
+        }
+    }
+
+ cleanup:
+    free(tmp);
+    return ret;
+}
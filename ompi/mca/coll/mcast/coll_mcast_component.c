@@ -0,0 +1,161 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "coll_mcast.h"
+
+/*
+ * Public string showing the coll ompi_mcast component version number
+ */
+const char *mca_coll_mcast_component_version_string =
+    "Open MPI mcast collective MCA component version " OMPI_VERSION;
+
+/*
+ * Local function
+ */
+static int mcast_register(void);
+
+/*
+ * Instantiate the public struct with all of our public information
+ * and pointers to our public functions in it
+ */
+
+mca_coll_mcast_component_t mca_coll_mcast_component = {
+    {
+        /* First, the mca_component_t struct containing meta information
+         * about the component itself */
+
+        .collm_version = {
+            MCA_COLL_BASE_VERSION_2_4_0,
+
+            /* Component name and version */
+            .mca_component_name = "mcast",
+            MCA_BASE_MAKE_VERSION(component, OMPI_MAJOR_VERSION, OMPI_MINOR_VERSION,
+                                  OMPI_RELEASE_VERSION),
+
+            /* Component open and close functions */
+            .mca_register_component_params = mcast_register,
+        },
+        .collm_data = {
+            /* The component is not checkpoint ready */
+            MCA_BASE_METADATA_PARAM_NONE
+        },
+
+        /* Initialization / querying functions */
+
+        .collm_init_query = mca_coll_mcast_init_query,
+        .collm_comm_query = mca_coll_mcast_comm_query,
+    },
+
+    /* mcast-specific component information */
+
+    /* Priority: above everything that can run a broadcast on the
+     * inter-node communicators, it forwards the small ones anyway */
+    .priority = 90,
+    .enable = false,
+    .min_comm_size = 16,
+    .min_bytes = 256 * 1024,
+    .if_include = NULL,
+    .mtu = 4096,
+    .recv_depth = 4096,
+    .send_depth = 256,
+    .nack_timeout = 2000,
+    .knomial_radix = 4,
+};
+
+
+static int mcast_register(void)
+{
+    mca_base_component_t *c = &mca_coll_mcast_component.super.collm_version;
+
+    (void) mca_base_component_var_register(c, "priority",
+                                           "Priority of the mcast coll component",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_mcast_component.priority);
+
+    (void) mca_base_component_var_register(c, "enable",
+                                           "Run the large broadcasts of the inter-node communicators "
+                                           "over InfiniBand multicast (requires the fabric to allow "
+                                           "the processes to join multicast groups)",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_4,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_mcast_component.enable);
+
+    (void) mca_base_component_var_register(c, "min_comm_size",
+                                           "Smallest communicator on which multicast is used",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_mcast_component.min_comm_size);
+
+    (void) mca_base_component_var_register(c, "min_bytes",
+                                           "Broadcasts smaller than this many bytes are forwarded "
+                                           "to the underlying component",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_mcast_component.min_bytes);
+
+    (void) mca_base_component_var_register(c, "if_include",
+                                           "IPoIB interface used to join the multicast groups "
+                                           "(default: the first ib* interface)",
+                                           MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_mcast_component.if_include);
+
+    (void) mca_base_component_var_register(c, "mtu",
+                                           "Bytes per multicast packet, header included; "
+                                           "reduced to the MTU of the port if larger",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_mcast_component.mtu);
+
+    (void) mca_base_component_var_register(c, "recv_depth",
+                                           "Number of packets pre-posted on the receive queue",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_mcast_component.recv_depth);
+
+    (void) mca_base_component_var_register(c, "send_depth",
+                                           "Number of multicast packets the root keeps in flight",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_mcast_component.send_depth);
+
+    (void) mca_base_component_var_register(c, "nack_timeout",
+                                           "Microseconds without packets after which a receiver "
+                                           "asks the root for the packets it missed",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_mcast_component.nack_timeout);
+
+    (void) mca_base_component_var_register(c, "knomial_radix",
+                                           "Radix of the knomial broadcast used when the "
+                                           "multicast group cannot be joined",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_coll_mcast_component.knomial_radix);
+
+    return OMPI_SUCCESS;
+}
@@ -0,0 +1,353 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+
+#include "opal/util/output.h"
+#include "opal/util/if.h"
+
+#include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "coll_mcast.h"
+
+
+/*
+ * Address of the IPoIB interface the rdma_cm id is bound to, it selects
+ * the HCA and the port
+ */
+static int mcast_local_addr(struct sockaddr_in *addr)
+{
+    const char *wanted = mca_coll_mcast_component.if_include;
+    struct sockaddr_storage ss;
+    char name[OPAL_IF_NAMESIZE];
+    int idx;
+
+    for (idx = opal_ifbegin(); idx >= 0; idx = opal_ifnext(idx)) {
+        if (OPAL_SUCCESS != opal_ifindextoname(idx, name, sizeof(name))) {
+            continue;
+        }
+        if (NULL != wanted ? 0 != strcmp(name, wanted) : 0 != strncmp(name, "ib", 2)) {
+            continue;
+        }
+        if (OPAL_SUCCESS != opal_ifindextoaddr(idx, (struct sockaddr *)&ss, sizeof(ss)) ||
+            AF_INET != ss.ss_family) {
+            continue;
+        }
+        memcpy(addr, &ss, sizeof(*addr));
+        addr->sin_port = 0;
+        return OMPI_SUCCESS;
+    }
+    return OMPI_ERR_NOT_FOUND;
+}
+
+static inline char *mcast_recv_slot(mca_coll_mcast_ctx_t *ctx, uint64_t slot)
+{
+    return ctx->buf + slot * ctx->slot_size;
+}
+
+static inline char *mcast_send_slot(mca_coll_mcast_ctx_t *ctx, int slot)
+{
+    return ctx->buf + ((size_t)ctx->recv_depth + slot) * ctx->slot_size;
+}
+
+int mca_coll_mcast_ctx_repost(mca_coll_mcast_ctx_t *ctx, uint64_t slot)
+{
+    struct ibv_recv_wr wr, *bad_wr;
+    struct ibv_sge sge;
+
+    sge.addr = (uintptr_t)mcast_recv_slot(ctx, slot);
+    sge.length = (uint32_t)ctx->slot_size;
+    sge.lkey = ctx->mr->lkey;
+
+    wr.wr_id = slot;
+    wr.next = NULL;
+    wr.sg_list = &sge;
+    wr.num_sge = 1;
+
+    return 0 == ibv_post_recv(ctx->id->qp, &wr, &bad_wr) ? OMPI_SUCCESS : OMPI_ERROR;
+}
+
+static int mcast_join(mca_coll_mcast_ctx_t *ctx)
+{
+    struct rdma_cm_event *event;
+    int ret = OMPI_ERROR;
+
+    if (0 != rdma_join_multicast(ctx->id, (struct sockaddr *)&ctx->group_addr, ctx)) {
+        return OMPI_ERROR;
+    }
+    if (0 != rdma_get_cm_event(ctx->channel, &event)) {
+        rdma_leave_multicast(ctx->id, (struct sockaddr *)&ctx->group_addr);
+        return OMPI_ERROR;
+    }
+    if (RDMA_CM_EVENT_MULTICAST_JOIN == event->event) {
+        ctx->remote_qpn = event->param.ud.qp_num;
+        ctx->remote_qkey = event->param.ud.qkey;
+        ctx->ah = ibv_create_ah(ctx->pd, &event->param.ud.ah_attr);
+        if (NULL != ctx->ah) {
+            ret = OMPI_SUCCESS;
+        }
+    }
+    rdma_ack_cm_event(event);
+
+    if (OMPI_SUCCESS != ret) {
+        rdma_leave_multicast(ctx->id, (struct sockaddr *)&ctx->group_addr);
+        return ret;
+    }
+    ctx->joined = true;
+    return OMPI_SUCCESS;
+}
+
+int mca_coll_mcast_ctx_init(mca_coll_mcast_ctx_t *ctx,
+                            struct ompi_communicator_t *comm,
+                            uint32_t magic)
+{
+    struct ibv_qp_init_attr qp_attr;
+    struct ibv_port_attr port_attr;
+    struct sockaddr_in local;
+    size_t mtu, len;
+    int i;
+
+    memset(ctx, 0, sizeof(*ctx));
+
+    if (OMPI_SUCCESS != mcast_local_addr(&local)) {
+        opal_output_verbose(10, ompi_coll_base_framework.framework_output,
+                            "coll:mcast (%d/%s): no IPoIB interface",
+                            comm->c_contextid, comm->c_name);
+        return OMPI_ERR_NOT_FOUND;
+    }
+
+    ctx->channel = rdma_create_event_channel();
+    if (NULL == ctx->channel) {
+        goto err_hdlr;
+    }
+    if (0 != rdma_create_id(ctx->channel, &ctx->id, ctx, RDMA_PS_UDP) ||
+        0 != rdma_bind_addr(ctx->id, (struct sockaddr *)&local)) {
+        goto err_hdlr;
+    }
+
+    /* UD carries at most one MTU per packet, the GRH comes on top */
+    if (0 != ibv_query_port(ctx->id->verbs, ctx->id->port_num, &port_attr)) {
+        goto err_hdlr;
+    }
+    mtu = (size_t)128 << port_attr.active_mtu;
+    if ((size_t)mca_coll_mcast_component.mtu < mtu) {
+        mtu = (size_t)mca_coll_mcast_component.mtu;
+    }
+    if (mtu <= sizeof(mca_coll_mcast_hdr_t)) {
+        goto err_hdlr;
+    }
+    ctx->payload = mtu - sizeof(mca_coll_mcast_hdr_t);
+    ctx->slot_size = MCA_COLL_MCAST_GRH_SIZE + mtu;
+    ctx->recv_depth = mca_coll_mcast_component.recv_depth;
+    ctx->send_depth = mca_coll_mcast_component.send_depth;
+
+    ctx->pd = ibv_alloc_pd(ctx->id->verbs);
+    if (NULL == ctx->pd) {
+        goto err_hdlr;
+    }
+    ctx->recv_cq = ibv_create_cq(ctx->id->verbs, ctx->recv_depth, NULL, NULL, 0);
+    ctx->send_cq = ibv_create_cq(ctx->id->verbs, ctx->send_depth, NULL, NULL, 0);
+    if (NULL == ctx->recv_cq || NULL == ctx->send_cq) {
+        goto err_hdlr;
+    }
+
+    memset(&qp_attr, 0, sizeof(qp_attr));
+    qp_attr.qp_type = IBV_QPT_UD;
+    qp_attr.send_cq = ctx->send_cq;
+    qp_attr.recv_cq = ctx->recv_cq;
+    qp_attr.cap.max_send_wr = ctx->send_depth;
+    qp_attr.cap.max_recv_wr = ctx->recv_depth;
+    qp_attr.cap.max_send_sge = 1;
+    qp_attr.cap.max_recv_sge = 1;
+    if (0 != rdma_create_qp(ctx->id, ctx->pd, &qp_attr)) {
+        goto err_hdlr;
+    }
+
+    len = (size_t)(ctx->recv_depth + ctx->send_depth) * ctx->slot_size;
+    if (0 != posix_memalign((void **)&ctx->buf, (size_t)getpagesize(), len)) {
+        ctx->buf = NULL;
+        goto err_hdlr;
+    }
+    ctx->mr = ibv_reg_mr(ctx->pd, ctx->buf, len, IBV_ACCESS_LOCAL_WRITE);
+    if (NULL == ctx->mr) {
+        goto err_hdlr;
+    }
+    for (i = 0; i < ctx->recv_depth; ++i) {
+        if (OMPI_SUCCESS != mca_coll_mcast_ctx_repost(ctx, i)) {
+            goto err_hdlr;
+        }
+    }
+
+    /* One group per communicator in the administratively scoped range,
+     * the magic of the header sorts out the collisions */
+    ctx->group_addr.sin_family = AF_INET;
+    ctx->group_addr.sin_addr.s_addr = htonl(0xef000000u | (magic & 0x00ffffffu));
+    if (OMPI_SUCCESS != mcast_join(ctx)) {
+        opal_output_verbose(10, ompi_coll_base_framework.framework_output,
+                            "coll:mcast (%d/%s): cannot join the multicast group",
+                            comm->c_contextid, comm->c_name);
+        goto err_hdlr;
+    }
+    return OMPI_SUCCESS;
+
+ err_hdlr:
+    mca_coll_mcast_ctx_fini(ctx);
+    return OMPI_ERROR;
+}
+
+void mca_coll_mcast_ctx_fini(mca_coll_mcast_ctx_t *ctx)
+{
+    if (ctx->joined) {
+        rdma_leave_multicast(ctx->id, (struct sockaddr *)&ctx->group_addr);
+        ctx->joined = false;
+    }
+    if (NULL != ctx->ah) {
+        ibv_destroy_ah(ctx->ah);
+        ctx->ah = NULL;
+    }
+    if (NULL != ctx->id && NULL != ctx->id->qp) {
+        rdma_destroy_qp(ctx->id);
+    }
+    if (NULL != ctx->mr) {
+        ibv_dereg_mr(ctx->mr);
+        ctx->mr = NULL;
+    }
+    if (NULL != ctx->buf) {
+        free(ctx->buf);
+        ctx->buf = NULL;
+    }
+    if (NULL != ctx->send_cq) {
+        ibv_destroy_cq(ctx->send_cq);
+        ctx->send_cq = NULL;
+    }
+    if (NULL != ctx->recv_cq) {
+        ibv_destroy_cq(ctx->recv_cq);
+        ctx->recv_cq = NULL;
+    }
+    if (NULL != ctx->pd) {
+        ibv_dealloc_pd(ctx->pd);
+        ctx->pd = NULL;
+    }
+    if (NULL != ctx->id) {
+        rdma_destroy_id(ctx->id);
+        ctx->id = NULL;
+    }
+    if (NULL != ctx->channel) {
+        rdma_destroy_event_channel(ctx->channel);
+        ctx->channel = NULL;
+    }
+}
+
+/* Reap the completed sends, waiting for at least one if the ring is full */
+static int mcast_reap_sends(mca_coll_mcast_ctx_t *ctx, bool wait)
+{
+    struct ibv_wc wc[16];
+    int n;
+
+    do {
+        n = ibv_poll_cq(ctx->send_cq, 16, wc);
+        if (n < 0) {
+            return OMPI_ERROR;
+        }
+        for (int i = 0; i < n; ++i) {
+            if (IBV_WC_SUCCESS != wc[i].status) {
+                return OMPI_ERROR;
+            }
+        }
+        ctx->send_posted -= n;
+    } while (wait && 0 == n);
+    return OMPI_SUCCESS;
+}
+
+int mca_coll_mcast_ctx_send(mca_coll_mcast_ctx_t *ctx,
+                            const mca_coll_mcast_hdr_t *hdr,
+                            const void *payload, size_t len)
+{
+    struct ibv_send_wr wr, *bad_wr;
+    struct ibv_sge sge;
+    char *slot;
+    int ret;
+
+    ret = mcast_reap_sends(ctx, ctx->send_posted == ctx->send_depth);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    slot = mcast_send_slot(ctx, ctx->send_head);
+    memcpy(slot, hdr, sizeof(*hdr));
+    memcpy(slot + sizeof(*hdr), payload, len);
+
+    sge.addr = (uintptr_t)slot;
+    sge.length = (uint32_t)(sizeof(*hdr) + len);
+    sge.lkey = ctx->mr->lkey;
+
+    memset(&wr, 0, sizeof(wr));
+    wr.wr_id = ctx->send_head;
+    wr.sg_list = &sge;
+    wr.num_sge = 1;
+    wr.opcode = IBV_WR_SEND;
+    wr.send_flags = IBV_SEND_SIGNALED;
+    wr.wr.ud.ah = ctx->ah;
+    wr.wr.ud.remote_qpn = ctx->remote_qpn;
+    wr.wr.ud.remote_qkey = ctx->remote_qkey;
+
+    if (0 != ibv_post_send(ctx->id->qp, &wr, &bad_wr)) {
+        return OMPI_ERROR;
+    }
+    ctx->send_posted++;
+    ctx->send_head = (ctx->send_head + 1) % ctx->send_depth;
+    return OMPI_SUCCESS;
+}
+
+int mca_coll_mcast_ctx_flush(mca_coll_mcast_ctx_t *ctx)
+{
+    int ret;
+
+    while (ctx->send_posted > 0) {
+        ret = mcast_reap_sends(ctx, true);
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+    }
+    return OMPI_SUCCESS;
+}
+
+int mca_coll_mcast_ctx_poll(mca_coll_mcast_ctx_t *ctx,
+                            mca_coll_mcast_hdr_t **hdr,
+                            void **payload, size_t *len,
+                            uint64_t *slot)
+{
+    struct ibv_wc wc;
+    int n;
+
+    n = ibv_poll_cq(ctx->recv_cq, 1, &wc);
+    if (n <= 0) {
+        return n < 0 ? OMPI_ERROR : 0;
+    }
+    if (IBV_WC_SUCCESS != wc.status) {
+        return OMPI_ERROR;
+    }
+    if (wc.byte_len < MCA_COLL_MCAST_GRH_SIZE + sizeof(mca_coll_mcast_hdr_t)) {
+        /* not one of ours */
+        return OMPI_SUCCESS == mca_coll_mcast_ctx_repost(ctx, wc.wr_id) ? 0 : OMPI_ERROR;
+    }
+    *slot = wc.wr_id;
+    *hdr = (mca_coll_mcast_hdr_t *)(mcast_recv_slot(ctx, wc.wr_id) + MCA_COLL_MCAST_GRH_SIZE);
+    *payload = (char *)*hdr + sizeof(mca_coll_mcast_hdr_t);
+    *len = wc.byte_len - MCA_COLL_MCAST_GRH_SIZE - sizeof(mca_coll_mcast_hdr_t);
+    return 1;
+}
@@ -0,0 +1,185 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "mpi.h"
+
+#include "opal/util/output.h"
+#include "opal/util/info.h"
+
+#include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/group/group.h"
+#include "ompi/proc/proc.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/mca/coll/base/base.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "coll_mcast.h"
+
+
+static void mca_coll_mcast_module_construct(mca_coll_mcast_module_t *module)
+{
+    memset(&(module->c_coll), 0, sizeof(module->c_coll));
+    memset(&(module->ctx), 0, sizeof(module->ctx));
+    module->state = MCA_COLL_MCAST_STATE_IDLE;
+    module->magic = 0;
+    module->seq = 0;
+}
+
+static void mca_coll_mcast_module_destruct(mca_coll_mcast_module_t *module)
+{
+    mca_coll_mcast_ctx_fini(&module->ctx);
+
+    if (NULL != module->c_coll.coll_bcast_module) {
+        OBJ_RELEASE(module->c_coll.coll_bcast_module);
+    }
+    if (NULL != module->c_coll.coll_allreduce_module) {
+        OBJ_RELEASE(module->c_coll.coll_allreduce_module);
+    }
+    if (NULL != module->c_coll.coll_barrier_module) {
+        OBJ_RELEASE(module->c_coll.coll_barrier_module);
+    }
+}
+
+OBJ_CLASS_INSTANCE(mca_coll_mcast_module_t, mca_coll_base_module_t,
+                   mca_coll_mcast_module_construct,
+                   mca_coll_mcast_module_destruct);
+
+
+/*
+ * Initial query function that is invoked during MPI_INIT, allowing
+ * this component to disqualify itself if it doesn't support the
+ * required level of thread support.
+ */
+int mca_coll_mcast_init_query(bool enable_progress_threads,
+                              bool enable_mpi_threads)
+{
+    /* Nothing to do */
+    return OMPI_SUCCESS;
+}
+
+
+/*
+ * Only the communicators with one process per node benefit from the
+ * multicast: the inter-node communicators of HAN, or a communicator
+ * the application built that way.
+ */
+static bool mcast_comm_is_inter_node(struct ompi_communicator_t *comm)
+{
+    opal_cstring_t *info_str = NULL;
+    bool inter_node = false;
+    int flag;
+
+    if (NULL != comm->super.s_info) {
+        opal_info_get(comm->super.s_info, "ompi_comm_coll_han_topo_level",
+                      &info_str, &flag);
+        if (flag) {
+            inter_node = (0 == strcmp(info_str->string, "INTER_NODE"));
+            OBJ_RELEASE(info_str);
+            return inter_node;
+        }
+    }
+    return 1 == ompi_group_count_local_peers(comm->c_local_group);
+}
+
+
+/*
+ * Invoked when there's a new communicator that has been created.
+ * Look at the communicator and decide which set of functions and
+ * priority we want to return.
+ */
+mca_coll_base_module_t *
+mca_coll_mcast_comm_query(struct ompi_communicator_t *comm,
+                          int *priority)
+{
+    mca_coll_mcast_module_t *mcast_module;
+    uint32_t magic;
+
+    if (!mca_coll_mcast_component.enable) {
+        return NULL;
+    }
+    if (OMPI_COMM_IS_INTER(comm) ||
+        ompi_comm_size(comm) < mca_coll_mcast_component.min_comm_size) {
+        return NULL;
+    }
+    if (!mcast_comm_is_inter_node(comm)) {
+        opal_output_verbose(10, ompi_coll_base_framework.framework_output,
+                            "coll:mcast:comm_query (%d/%s): more than one process per node, disqualifying myself",
+                            comm->c_contextid, comm->c_name);
+        return NULL;
+    }
+
+    mcast_module = OBJ_NEW(mca_coll_mcast_module_t);
+    if (NULL == mcast_module) {
+        return NULL;
+    }
+
+    /* The fallback broadcast of coll/base keeps its topology there */
+    mcast_module->super.base_data = OBJ_NEW(mca_coll_base_comm_t);
+    if (NULL == mcast_module->super.base_data) {
+        OBJ_RELEASE(mcast_module);
+        return NULL;
+    }
+
+    /* Same value on all the processes of the communicator, and unlikely
+     * to match another communicator that hashes to the same group */
+    magic = (uint32_t)OMPI_PROC_MY_NAME->jobid * 2654435761u;
+    magic ^= comm->c_contextid + 0x9e3779b9u + (magic << 6) + (magic >> 2);
+    mcast_module->magic = magic;
+
+    *priority = mca_coll_mcast_component.priority;
+
+    mcast_module->super.coll_module_enable = mca_coll_mcast_module_enable;
+
+    mcast_module->super.coll_bcast = mca_coll_mcast_bcast;
+
+    return &(mcast_module->super);
+}
+
+
+/*
+ * Init module on the communicator
+ */
+int mca_coll_mcast_module_enable(mca_coll_base_module_t *module,
+                                 struct ompi_communicator_t *comm)
+{
+    bool good = true;
+    char *msg = NULL;
+    mca_coll_mcast_module_t *s = (mca_coll_mcast_module_t*) module;
+
+#define CHECK_AND_RETAIN(src, dst, name)                                                   \
+    if (NULL == (src)->c_coll->coll_ ## name ## _module) {                                 \
+        good = false;                                                                      \
+        msg = #name;                                                                       \
+    } else if (good) {                                                                     \
+        (dst)->c_coll.coll_ ## name ## _module = (src)->c_coll->coll_ ## name ## _module;  \
+        (dst)->c_coll.coll_ ## name = (src)->c_coll->coll_ ## name;                        \
+        OBJ_RETAIN((src)->c_coll->coll_ ## name ## _module);                               \
+    }
+
+    CHECK_AND_RETAIN(comm, s, bcast);
+    CHECK_AND_RETAIN(comm, s, allreduce);
+    CHECK_AND_RETAIN(comm, s, barrier);
+
+    /* All done */
+    if (good) {
+        return OMPI_SUCCESS;
+    }
+    opal_output_verbose(1, ompi_coll_base_framework.framework_output,
+                        "coll:mcast:module_enable (%d/%s): no underlying %s",
+                        comm->c_contextid, comm->c_name, msg);
+    return OMPI_ERR_NOT_FOUND;
+}
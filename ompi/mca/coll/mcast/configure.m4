@@ -0,0 +1,68 @@
+# -*- shell-script -*-
+#
+# Copyright (c) 2026      The University of Tennessee and The University
+#                         of Tennessee Research Foundation.  All rights
+#                         reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# MCA_coll_mcast_CONFIG([action-if-can-compile],
+#                       [action-if-cant-compile])
+# ------------------------------------------------
+# The multicast groups are joined through librdmacm and driven with
+# libibverbs, both are required.
+AC_DEFUN([MCA_ompi_coll_mcast_CONFIG],[
+    AC_CONFIG_FILES([ompi/mca/coll/mcast/Makefile])
+
+    OPAL_VAR_SCOPE_PUSH([coll_mcast_dir coll_mcast_happy])
+
+    AC_ARG_WITH([rdmacm],
+                [AC_HELP_STRING([--with-rdmacm(=DIR)],
+                                [Build the InfiniBand multicast collectives, searching for libibverbs and librdmacm in DIR])])
+
+    coll_mcast_happy=no
+    AS_IF([test "$with_rdmacm" != "no"],
+          [AS_IF([test ! -z "$with_rdmacm" && test "$with_rdmacm" != "yes"],
+                 [coll_mcast_dir=$with_rdmacm])
+
+           OPAL_CHECK_PACKAGE([coll_mcast],
+                              [infiniband/verbs.h],
+                              [ibverbs],
+                              [ibv_open_device],
+                              [],
+                              [$coll_mcast_dir],
+                              [],
+                              [coll_mcast_happy="yes"],
+                              [coll_mcast_happy="no"])
+
+           AS_IF([test "$coll_mcast_happy" = "yes"],
+                 [OPAL_CHECK_PACKAGE([coll_mcast_rdmacm],
+                                     [rdma/rdma_cma.h],
+                                     [rdmacm],
+                                     [rdma_join_multicast],
+                                     [],
+                                     [$coll_mcast_dir],
+                                     [],
+                                     [coll_mcast_LIBS="$coll_mcast_rdmacm_LIBS $coll_mcast_LIBS"
+                                      coll_mcast_LDFLAGS="$coll_mcast_rdmacm_LDFLAGS $coll_mcast_LDFLAGS"
+                                      coll_mcast_CPPFLAGS="$coll_mcast_rdmacm_CPPFLAGS $coll_mcast_CPPFLAGS"],
+                                     [coll_mcast_happy="no"])])])
+
+    AS_IF([test "$coll_mcast_happy" = "yes"],
+          [coll_mcast_WRAPPER_EXTRA_LDFLAGS="$coll_mcast_LDFLAGS"
+           coll_mcast_WRAPPER_EXTRA_LIBS="$coll_mcast_LIBS"
+           $1],
+          [AS_IF([test ! -z "$with_rdmacm" && test "$with_rdmacm" != "no"],
+                 [AC_MSG_ERROR([InfiniBand multicast support requested but libibverbs or librdmacm not found.  Aborting])])
+           $2])
+
+    OPAL_VAR_SCOPE_POP
+
+    AC_SUBST([coll_mcast_CPPFLAGS])
+    AC_SUBST([coll_mcast_LDFLAGS])
+    AC_SUBST([coll_mcast_LIBS])
+])dnl
@@ -105,6 +105,11 @@ struct mca_coll_portals4_module_t {
     mca_coll_base_module_iallreduce_fn_t previous_iallreduce;
     mca_coll_base_module_t *previous_iallreduce_module;
 
+    mca_coll_base_module_reduce_scatter_fn_t previous_reduce_scatter;
+    mca_coll_base_module_t *previous_reduce_scatter_module;
+    mca_coll_base_module_ireduce_scatter_fn_t previous_ireduce_scatter;
+    mca_coll_base_module_t *previous_ireduce_scatter_module;
+
     /* binomial tree */
     ompi_coll_portals4_tree_t *cached_in_order_bmtree;
     int                        cached_in_order_bmtree_root;
@@ -141,6 +146,9 @@ struct ompi_coll_portals4_request_t;
 #define COLL_PORTALS4_GATHER        0x04
 #define COLL_PORTALS4_REDUCE        0x05
 #define COLL_PORTALS4_ALLREDUCE     0x06
+#define COLL_PORTALS4_ALLGATHER     0x07
+#define COLL_PORTALS4_ALLTOALL      0x08
+#define COLL_PORTALS4_REDUCE_SCATTER 0x09
 
 #define PTL_INVALID_RANK ((ptl_rank_t)-1)
 #define PTL_FIRST_RANK   ((ptl_rank_t)0)
@@ -248,6 +256,39 @@ int ompi_coll_portals4_iscatter_intra(const void *sbuf, int scount, struct ompi_
                                       mca_coll_base_module_t *module);
 int ompi_coll_portals4_iscatter_intra_fini(struct ompi_coll_portals4_request_t *request);
 
+int ompi_coll_portals4_allgather_intra(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                                       void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                                       struct ompi_communicator_t *comm,
+                                       mca_coll_base_module_t *module);
+int ompi_coll_portals4_iallgather_intra(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                                        void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                                        struct ompi_communicator_t *comm,
+                                        ompi_request_t **request,
+                                        mca_coll_base_module_t *module);
+int ompi_coll_portals4_iallgather_intra_fini(struct ompi_coll_portals4_request_t *request);
+
+int ompi_coll_portals4_alltoall_intra(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                                      void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                                      struct ompi_communicator_t *comm,
+                                      mca_coll_base_module_t *module);
+int ompi_coll_portals4_ialltoall_intra(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                                       void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                                       struct ompi_communicator_t *comm,
+                                       ompi_request_t **request,
+                                       mca_coll_base_module_t *module);
+int ompi_coll_portals4_ialltoall_intra_fini(struct ompi_coll_portals4_request_t *request);
+
+int ompi_coll_portals4_reduce_scatter_intra(const void *sbuf, void *rbuf, const int *rcounts,
+        MPI_Datatype dtype, MPI_Op op,
+        struct ompi_communicator_t *comm,
+        mca_coll_base_module_t *module);
+int ompi_coll_portals4_ireduce_scatter_intra(const void *sbuf, void *rbuf, const int *rcounts,
+        MPI_Datatype dtype, MPI_Op op,
+        struct ompi_communicator_t *comm,
+        ompi_request_t **request,
+        mca_coll_base_module_t *module);
+int ompi_coll_portals4_ireduce_scatter_intra_fini(struct ompi_coll_portals4_request_t *request);
+
 
 static inline ptl_process_t
 ompi_coll_portals4_get_peer(struct ompi_communicator_t *comm, int rank)
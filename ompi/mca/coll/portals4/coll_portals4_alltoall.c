@@ -0,0 +1,604 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+
+#include "ompi_config.h"
+
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/mca/coll/base/base.h"
+#include "ompi/mca/coll/coll.h"
+
+#include "coll_portals4.h"
+#include "coll_portals4_request.h"
+
+/*
+ * Direct exchange alltoall, entirely driven by triggered operations.
+ *
+ * The schedule is the one of the allgather: the send blocks are packed
+ * in a send buffer, the peers put into a receive buffer exposed through
+ * a single ME (block i at offset i * packed_size).  The puts to every
+ * peer (cut in fragments of at most max_msg_size) are triggered by the
+ * RTR counter, the Recv-ACKs by the data counter, and both counters are
+ * chained to the done counter.
+ *
+ *   sync_cth : RTR (size - 1), then Recv-ACK (size - 1)
+ *   data_cth : fragments from the peers ((size - 1) * number_of_fragment)
+ *   done_cth : one increment from each of the two counters above
+ */
+
+static int
+setup_alltoall_buffers(struct ompi_communicator_t   *comm,
+                       ompi_coll_portals4_request_t *request)
+{
+    int ret, line;
+
+    uint32_t iov_count = 1;
+    struct iovec iov;
+    size_t max_data;
+
+    opal_convertor_t send_converter;
+
+    /* the send blocks are contiguous in sbuf, a single convertor packs them all */
+    ompi_coll_portals4_create_send_converter (&send_converter,
+                                              request->u.alltoall.pack_src_buf,
+                                              ompi_comm_peer_lookup(comm, request->u.alltoall.my_rank),
+                                              request->u.alltoall.pack_src_count * request->u.alltoall.size,
+                                              request->u.alltoall.pack_src_dtype);
+    opal_convertor_get_packed_size(&send_converter, &request->u.alltoall.xfer_bytes);
+    request->u.alltoall.packed_size = request->u.alltoall.xfer_bytes / request->u.alltoall.size;
+
+    /**********************************/
+    /* Setup Alltoall Buffers         */
+    /**********************************/
+
+    /* send blocks first, then receive blocks */
+    request->u.alltoall.send_buf = NULL;
+    request->u.alltoall.recv_buf = NULL;
+    if (0 < request->u.alltoall.xfer_bytes) {
+        request->u.alltoall.send_buf = (char *) malloc(2 * request->u.alltoall.xfer_bytes);
+        if (NULL == request->u.alltoall.send_buf) {
+            OBJ_DESTRUCT(&send_converter);
+            ret = OMPI_ERR_OUT_OF_RESOURCE; line = __LINE__; goto err_hdlr;
+        }
+        request->u.alltoall.recv_buf = request->u.alltoall.send_buf + request->u.alltoall.xfer_bytes;
+    }
+
+    iov.iov_len = request->u.alltoall.xfer_bytes;
+    iov.iov_base = (IOVBASE_TYPE *) request->u.alltoall.send_buf;
+    opal_convertor_pack(&send_converter, &iov, &iov_count, &max_data);
+    OBJ_DESTRUCT(&send_converter);
+
+    /* the local block does not go through the network */
+    if (0 < request->u.alltoall.packed_size) {
+        ptrdiff_t local_offset = (ptrdiff_t)request->u.alltoall.my_rank * request->u.alltoall.packed_size;
+        memcpy(request->u.alltoall.recv_buf + local_offset,
+               request->u.alltoall.send_buf + local_offset,
+               request->u.alltoall.packed_size);
+    }
+
+    opal_output_verbose(30, ompi_coll_base_framework.framework_output,
+                        "%s:%d:rank(%d): send_buf(%p) - recv_buf(%p) - xfer_bytes(%lu)=packed_size(%ld) * size(%d)",
+                        __FILE__, __LINE__, request->u.alltoall.my_rank,
+                        request->u.alltoall.send_buf, request->u.alltoall.recv_buf,
+                        request->u.alltoall.xfer_bytes,
+                        request->u.alltoall.packed_size, request->u.alltoall.size);
+
+    return OMPI_SUCCESS;
+
+err_hdlr:
+    opal_output(ompi_coll_base_framework.framework_output,
+                "%s:%4d:%4d\tError occurred ret=%d, rank %2d",
+                __FILE__, __LINE__, line, ret, request->u.alltoall.my_rank);
+
+    return ret;
+}
+
+static int
+setup_alltoall_handles(struct ompi_communicator_t   *comm,
+                       ompi_coll_portals4_request_t *request)
+{
+    int ret, line;
+
+    ptl_me_t  me;
+
+    /**********************************/
+    /* Setup Data and Sync Handles    */
+    /**********************************/
+    COLL_PORTALS4_SET_BITS(request->u.alltoall.data_match_bits, ompi_comm_get_cid(comm),
+            0, 0, COLL_PORTALS4_ALLTOALL, 0, request->u.alltoall.coll_count);
+    COLL_PORTALS4_SET_BITS(request->u.alltoall.sync_match_bits, ompi_comm_get_cid(comm),
+            0, 1, COLL_PORTALS4_ALLTOALL, 0, request->u.alltoall.coll_count);
+
+    ret = PtlCTAlloc(mca_coll_portals4_component.ni_h, &request->u.alltoall.data_cth);
+    if (PTL_OK != ret) { ret = OMPI_ERR_TEMP_OUT_OF_RESOURCE; line = __LINE__; goto err_hdlr; }
+
+    ret = PtlCTAlloc(mca_coll_portals4_component.ni_h, &request->u.alltoall.sync_cth);
+    if (PTL_OK != ret) { ret = OMPI_ERR_TEMP_OUT_OF_RESOURCE; line = __LINE__; goto err_hdlr; }
+
+    ret = PtlCTAlloc(mca_coll_portals4_component.ni_h, &request->u.alltoall.done_cth);
+    if (PTL_OK != ret) { ret = OMPI_ERR_TEMP_OUT_OF_RESOURCE; line = __LINE__; goto err_hdlr; }
+
+    /* peers put their block for us here */
+    memset(&me, 0, sizeof(ptl_me_t));
+    me.start = request->u.alltoall.recv_buf;
+    me.length = request->u.alltoall.xfer_bytes;
+    me.ct_handle = request->u.alltoall.data_cth;
+    me.min_free = 0;
+    me.uid = mca_coll_portals4_component.uid;
+    me.options = PTL_ME_OP_PUT | PTL_ME_EVENT_SUCCESS_DISABLE |
+        PTL_ME_EVENT_LINK_DISABLE | PTL_ME_EVENT_UNLINK_DISABLE |
+        PTL_ME_EVENT_CT_COMM;
+    me.match_id.phys.nid = PTL_NID_ANY;
+    me.match_id.phys.pid = PTL_PID_ANY;
+    me.match_bits = request->u.alltoall.data_match_bits;
+    me.ignore_bits = 0;
+    ret = PtlMEAppend(mca_coll_portals4_component.ni_h,
+                      mca_coll_portals4_component.pt_idx,
+                      &me,
+                      PTL_PRIORITY_LIST,
+                      NULL,
+                      &request->u.alltoall.data_meh);
+    if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+
+    /* RTR and Recv-ACK, the RTR may already sit in the overflow list */
+    memset(&me, 0, sizeof(ptl_me_t));
+    me.start = NULL;
+    me.length = 0;
+    me.ct_handle = request->u.alltoall.sync_cth;
+    me.min_free = 0;
+    me.uid = mca_coll_portals4_component.uid;
+    me.options = PTL_ME_OP_PUT | PTL_ME_EVENT_SUCCESS_DISABLE |
+        PTL_ME_EVENT_LINK_DISABLE | PTL_ME_EVENT_UNLINK_DISABLE |
+        PTL_ME_EVENT_CT_COMM | PTL_ME_EVENT_CT_OVERFLOW;
+    me.match_id.phys.nid = PTL_NID_ANY;
+    me.match_id.phys.pid = PTL_PID_ANY;
+    me.match_bits = request->u.alltoall.sync_match_bits;
+    me.ignore_bits = 0;
+    ret = PtlMEAppend(mca_coll_portals4_component.ni_h,
+                      mca_coll_portals4_component.pt_idx,
+                      &me,
+                      PTL_PRIORITY_LIST,
+                      NULL,
+                      &request->u.alltoall.sync_meh);
+    if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+
+    return OMPI_SUCCESS;
+
+err_hdlr:
+    opal_output(ompi_coll_base_framework.framework_output,
+                "%s:%4d:%4d\tError occurred ret=%d, rank %2d",
+                __FILE__, __LINE__, line, ret, request->u.alltoall.my_rank);
+
+    return ret;
+}
+
+static int
+cleanup_alltoall_handles(ompi_coll_portals4_request_t *request)
+{
+    int ret, line;
+
+    /**********************************/
+    /* Cleanup Data and Sync Handles  */
+    /**********************************/
+    do {
+        ret = PtlMEUnlink(request->u.alltoall.data_meh);
+    } while (PTL_IN_USE == ret);
+    if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+
+    do {
+        ret = PtlMEUnlink(request->u.alltoall.sync_meh);
+    } while (PTL_IN_USE == ret);
+    if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+
+    ret = PtlCTFree(request->u.alltoall.data_cth);
+    if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+
+    ret = PtlCTFree(request->u.alltoall.sync_cth);
+    if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+
+    ret = PtlCTFree(request->u.alltoall.done_cth);
+    if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+
+    return OMPI_SUCCESS;
+
+err_hdlr:
+    opal_output(ompi_coll_base_framework.framework_output,
+                "%s:%4d:%4d\tError occurred ret=%d, rank %2d",
+                __FILE__, __LINE__, line, ret, request->u.alltoall.my_rank);
+
+    return ret;
+}
+
+static int
+ompi_coll_portals4_alltoall_intra_top(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                                      void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                                      struct ompi_communicator_t *comm,
+                                      ompi_coll_portals4_request_t *request,
+                                      mca_coll_base_module_t *module)
+{
+    mca_coll_portals4_module_t *portals4_module = (mca_coll_portals4_module_t*) module;
+    int ret, line;
+    ptl_ct_event_t ct;
+    ptl_ct_event_t ct_inc;
+
+    int32_t i;
+    int32_t peers;
+
+    ptl_size_t number_of_fragment = 1;
+
+    OPAL_OUTPUT_VERBOSE((10, ompi_coll_base_framework.framework_output,
+                 "coll:portals4:alltoall_intra_top enter rank %d", ompi_comm_rank(comm)));
+
+    request->type = OMPI_COLL_PORTALS4_TYPE_ALLTOALL;
+    request->u.alltoall.send_buf = NULL;
+
+    request->u.alltoall.my_rank = ompi_comm_rank(comm);
+    request->u.alltoall.size    = ompi_comm_size(comm);
+
+    /* with MPI_IN_PLACE, rbuf is entirely packed before anything lands */
+    if (MPI_IN_PLACE == sbuf) {
+        request->u.alltoall.pack_src_buf   = rbuf;
+        request->u.alltoall.pack_src_count = rcount;
+        request->u.alltoall.pack_src_dtype = rdtype;
+    } else {
+        request->u.alltoall.pack_src_buf   = sbuf;
+        request->u.alltoall.pack_src_count = scount;
+        request->u.alltoall.pack_src_dtype = sdtype;
+    }
+    request->u.alltoall.unpack_dst_buf   = rbuf;
+    request->u.alltoall.unpack_dst_count = rcount;
+    request->u.alltoall.unpack_dst_dtype = rdtype;
+
+    /**********************************/
+    /* Setup Common Parameters        */
+    /**********************************/
+
+    peers = request->u.alltoall.size - 1;
+
+    request->u.alltoall.coll_count = opal_atomic_add_fetch_size_t(&portals4_module->coll_count, 1);
+
+    ret = setup_alltoall_buffers(comm, request);
+    if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hdlr; }
+
+    ret = setup_alltoall_handles(comm, request);
+    if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hdlr; }
+
+    number_of_fragment = (request->u.alltoall.packed_size > mca_coll_portals4_component.ni_limits.max_msg_size) ?
+        (request->u.alltoall.packed_size + mca_coll_portals4_component.ni_limits.max_msg_size - 1) / mca_coll_portals4_component.ni_limits.max_msg_size :
+        1;
+    opal_output_verbose(90, ompi_coll_base_framework.framework_output,
+        "%s:%d:rank %d:number_of_fragment = %lu",
+        __FILE__, __LINE__, request->u.alltoall.my_rank, number_of_fragment);
+
+    /*******************************************************/
+    /* put block i to peer i once all the RTRs are there  */
+    /*******************************************************/
+    for (i = 1 ; i < request->u.alltoall.size ; i++) {
+        /* start with the right neighbour, so the peers are not all hit at once */
+        int peer = (request->u.alltoall.my_rank + i) % request->u.alltoall.size;
+        ptl_size_t local_offset = (ptl_size_t)peer * request->u.alltoall.packed_size;
+        ptl_size_t remote_offset = (ptl_size_t)request->u.alltoall.my_rank * request->u.alltoall.packed_size;
+        ptl_size_t split_offset = 0;
+        ptl_size_t size_left = request->u.alltoall.packed_size;
+
+        for (ptl_size_t j = 0 ; j < number_of_fragment ; j++) {
+            ptl_size_t frag_size = (size_left > mca_coll_portals4_component.ni_limits.max_msg_size) ?
+                mca_coll_portals4_component.ni_limits.max_msg_size :
+                size_left;
+
+            ret = PtlTriggeredPut(mca_coll_portals4_component.data_md_h,
+                                  (ptl_size_t)request->u.alltoall.send_buf + local_offset + split_offset,
+                                  frag_size,
+                                  PTL_NO_ACK_REQ,
+                                  ompi_coll_portals4_get_peer(comm, peer),
+                                  mca_coll_portals4_component.pt_idx,
+                                  request->u.alltoall.data_match_bits,
+                                  remote_offset + split_offset,
+                                  NULL,
+                                  0,
+                                  request->u.alltoall.sync_cth,
+                                  peers);
+            if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+
+            size_left -= frag_size;
+            split_offset += frag_size;
+        }
+    }
+
+    /******************************************************/
+    /* Recv-ACK to every peer once all the data is there */
+    /******************************************************/
+    for (i = 0 ; i < request->u.alltoall.size ; i++) {
+        if (i == request->u.alltoall.my_rank) { continue; }
+        ret = PtlTriggeredPut(mca_coll_portals4_component.zero_md_h,
+                              0,
+                              0,
+                              PTL_NO_ACK_REQ,
+                              ompi_coll_portals4_get_peer(comm, i),
+                              mca_coll_portals4_component.pt_idx,
+                              request->u.alltoall.sync_match_bits,
+                              0,
+                              NULL,
+                              0,
+                              request->u.alltoall.data_cth,
+                              peers * number_of_fragment);
+        if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+    }
+
+    /***************************************/
+    /* Chain data and sync to the done CT  */
+    /***************************************/
+    ct_inc.success = 1;
+    ct_inc.failure = 0;
+    ret = PtlTriggeredCTInc(request->u.alltoall.done_cth,
+                            ct_inc,
+                            request->u.alltoall.data_cth,
+                            peers * number_of_fragment);
+    if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+    ret = PtlTriggeredCTInc(request->u.alltoall.done_cth,
+                            ct_inc,
+                            request->u.alltoall.sync_cth,
+                            2 * peers);
+    if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+
+    if (!request->is_sync) {
+        /******************************************/
+        /* put to finish pt when all ops complete */
+        /******************************************/
+        ret = PtlTriggeredPut(mca_coll_portals4_component.zero_md_h,
+                0,
+                0,
+                PTL_NO_ACK_REQ,
+                ompi_coll_portals4_get_peer(comm, request->u.alltoall.my_rank),
+                mca_coll_portals4_component.finish_pt_idx,
+                0,
+                0,
+                NULL,
+                (uintptr_t) request,
+                request->u.alltoall.done_cth,
+                2);
+        if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+    }
+
+    /***********************************************/
+    /* everything is posted, send RTR to all peers */
+    /***********************************************/
+    for (i = 0 ; i < request->u.alltoall.size ; i++) {
+        if (i == request->u.alltoall.my_rank) { continue; }
+        ret = PtlPut(mca_coll_portals4_component.zero_md_h,
+                     0,
+                     0,
+                     PTL_NO_ACK_REQ,
+                     ompi_coll_portals4_get_peer(comm, i),
+                     mca_coll_portals4_component.pt_idx,
+                     request->u.alltoall.sync_match_bits,
+                     0,
+                     NULL,
+                     0);
+        if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+    }
+
+    if (request->is_sync) {
+        /********************************/
+        /* Wait for all ops to complete */
+        /********************************/
+        ret = PtlCTWait(request->u.alltoall.done_cth, 2, &ct);
+        if (PTL_OK != ret) { ret = OMPI_ERROR; line = __LINE__; goto err_hdlr; }
+    }
+
+    OPAL_OUTPUT_VERBOSE((10, ompi_coll_base_framework.framework_output,
+                 "coll:portals4:alltoall_intra_top exit rank %d", request->u.alltoall.my_rank));
+
+    return OMPI_SUCCESS;
+
+err_hdlr:
+    if (NULL != request->u.alltoall.send_buf)
+        free(request->u.alltoall.send_buf);
+
+    opal_output(ompi_coll_base_framework.framework_output,
+                "%s:%4d:%4d\tError occurred ret=%d, rank %2d",
+                __FILE__, __LINE__, line, ret, request->u.alltoall.my_rank);
+
+    return ret;
+}
+
+static int
+ompi_coll_portals4_alltoall_intra_bottom(struct ompi_communicator_t *comm,
+                                         ompi_coll_portals4_request_t *request)
+{
+    int ret, line;
+
+    uint32_t iov_count = 1;
+    struct iovec iov;
+    size_t max_data;
+
+    opal_convertor_t recv_converter;
+
+    OPAL_OUTPUT_VERBOSE((10, ompi_coll_base_framework.framework_output,
+                 "coll:portals4:alltoall_intra_bottom enter rank %d", request->u.alltoall.my_rank));
+
+    ret = cleanup_alltoall_handles(request);
+    if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hdlr; }
+
+    ompi_coll_portals4_create_recv_converter (&recv_converter,
+                                              request->u.alltoall.unpack_dst_buf,
+                                              ompi_comm_peer_lookup(comm, request->u.alltoall.my_rank),
+                                              request->u.alltoall.unpack_dst_count * request->u.alltoall.size,
+                                              request->u.alltoall.unpack_dst_dtype);
+
+    iov.iov_len = request->u.alltoall.xfer_bytes;
+    iov.iov_base = (IOVBASE_TYPE *) request->u.alltoall.recv_buf;
+    opal_convertor_unpack(&recv_converter, &iov, &iov_count, &max_data);
+
+    OBJ_DESTRUCT(&recv_converter);
+
+    if (NULL != request->u.alltoall.send_buf)
+        free(request->u.alltoall.send_buf);
+
+    request->super.req_status.MPI_ERROR = OMPI_SUCCESS;
+
+    ompi_request_complete(&request->super, true);
+
+    OPAL_OUTPUT_VERBOSE((10, ompi_coll_base_framework.framework_output,
+                 "coll:portals4:alltoall_intra_bottom exit rank %d", request->u.alltoall.my_rank));
+
+    return OMPI_SUCCESS;
+
+err_hdlr:
+    request->super.req_status.MPI_ERROR = ret;
+
+    if (NULL != request->u.alltoall.send_buf)
+        free(request->u.alltoall.send_buf);
+
+    opal_output(ompi_coll_base_framework.framework_output,
+            "%s:%4d:%4d\tError occurred ret=%d, rank %2d",
+            __FILE__, __LINE__, line, ret, request->u.alltoall.my_rank);
+
+    return ret;
+}
+
+int
+ompi_coll_portals4_alltoall_intra(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                                  void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                                  struct ompi_communicator_t *comm,
+                                  mca_coll_base_module_t *module)
+{
+    int ret, line;
+
+    ompi_coll_portals4_request_t *request;
+
+    OPAL_OUTPUT_VERBOSE((10, ompi_coll_base_framework.framework_output,
+                 "coll:portals4:alltoall_intra enter rank %d", ompi_comm_rank(comm)));
+
+    /*
+     *  allocate a portals4 request
+     */
+    OMPI_COLL_PORTALS4_REQUEST_ALLOC(comm, request);
+    if (NULL == request) {
+        ret = OMPI_ERR_TEMP_OUT_OF_RESOURCE; line = __LINE__; goto err_hdlr;
+    }
+    request->is_sync = true;
+    request->fallback_request = NULL;
+
+    /*
+     *  initiate the alltoall
+     *
+     *  this request is synchronous, so PtlCTWait()
+     *  will be called to wait for completion.
+     */
+    ret = ompi_coll_portals4_alltoall_intra_top(sbuf, scount, sdtype,
+                                                rbuf, rcount, rdtype,
+                                                comm,
+                                                request,
+                                                module);
+    if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hdlr; }
+
+    ret = ompi_coll_portals4_alltoall_intra_bottom(comm, request);
+    if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hdlr; }
+
+    OPAL_OUTPUT_VERBOSE((10, ompi_coll_base_framework.framework_output,
+                 "coll:portals4:alltoall_intra exit rank %d", request->u.alltoall.my_rank));
+
+    /*
+     *  return the portals4 request
+     */
+    OMPI_COLL_PORTALS4_REQUEST_RETURN(request);
+
+    return OMPI_SUCCESS;
+
+err_hdlr:
+    opal_output(ompi_coll_base_framework.framework_output,
+            "%s:%4d:%4d\tError occurred ret=%d, rank %2d",
+            __FILE__, __LINE__, line, ret, ompi_comm_rank(comm));
+
+    return ret;
+}
+
+
+int
+ompi_coll_portals4_ialltoall_intra(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                                   void *rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                                   struct ompi_communicator_t *comm,
+                                   ompi_request_t **ompi_request,
+                                   mca_coll_base_module_t *module)
+{
+    int ret, line;
+
+    ompi_coll_portals4_request_t *request;
+
+    OPAL_OUTPUT_VERBOSE((10, ompi_coll_base_framework.framework_output,
+                 "coll:portals4:ialltoall_intra enter rank %d", ompi_comm_rank(comm)));
+
+    /*
+     *  allocate a portals4 request
+     */
+    OMPI_COLL_PORTALS4_REQUEST_ALLOC(comm, request);
+    if (NULL == request) {
+        ret = OMPI_ERR_TEMP_OUT_OF_RESOURCE; line = __LINE__; goto err_hdlr;
+    }
+    *ompi_request = &request->super;
+    request->is_sync = false;
+    request->fallback_request = ompi_request;
+
+    /*
+     *  initiate the alltoall
+     *
+     *  this request is asynchronous, so
+     *  portals4_progress() will handle completion.
+     */
+    ret = ompi_coll_portals4_alltoall_intra_top(sbuf, scount, sdtype,
+                                                rbuf, rcount, rdtype,
+                                                comm,
+                                                request,
+                                                module);
+    if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hdlr; }
+
+    OPAL_OUTPUT_VERBOSE((10, ompi_coll_base_framework.framework_output,
+                 "coll:portals4:ialltoall_intra exit rank %d", request->u.alltoall.my_rank));
+
+    return OMPI_SUCCESS;
+
+err_hdlr:
+    opal_output(ompi_coll_base_framework.framework_output,
+            "%s:%4d:%4d\tError occurred ret=%d, rank %2d",
+            __FILE__, __LINE__, line, ret, ompi_comm_rank(comm));
+
+    return ret;
+}
+
+
+int
+ompi_coll_portals4_ialltoall_intra_fini(ompi_coll_portals4_request_t *request)
+{
+    int ret, line;
+
+    OPAL_OUTPUT_VERBOSE((10, ompi_coll_base_framework.framework_output,
+                 "coll:portals4:ialltoall_intra_fini enter rank %d", request->u.alltoall.my_rank));
+
+    /*
+     *  cleanup the alltoall
+     */
+    ret = ompi_coll_portals4_alltoall_intra_bottom(request->super.req_mpi_object.comm, request);
+    if (MPI_SUCCESS != ret) { line = __LINE__; goto err_hdlr; }
+
+    OPAL_OUTPUT_VERBOSE((10, ompi_coll_base_framework.framework_output,
+                 "coll:portals4:ialltoall_intra_fini exit rank %d", request->u.alltoall.my_rank));
+
+    return OMPI_SUCCESS;
+
+err_hdlr:
+    opal_output(ompi_coll_base_framework.framework_output,
+            "%s:%4d:%4d\tError occurred ret=%d, rank %2d",
+            __FILE__, __LINE__, line, ret, request->u.alltoall.my_rank);
+
+    return ret;
+}
@@ -640,6 +640,15 @@ portals4_comm_query(struct ompi_communicator_t *comm,
     portals4_module->super.coll_reduce = ompi_coll_portals4_reduce_intra;
     portals4_module->super.coll_ireduce = ompi_coll_portals4_ireduce_intra;
 
+    portals4_module->super.coll_allgather = ompi_coll_portals4_allgather_intra;
+    portals4_module->super.coll_iallgather = ompi_coll_portals4_iallgather_intra;
+
+    portals4_module->super.coll_alltoall = ompi_coll_portals4_alltoall_intra;
+    portals4_module->super.coll_ialltoall = ompi_coll_portals4_ialltoall_intra;
+
+    portals4_module->super.coll_reduce_scatter = ompi_coll_portals4_reduce_scatter_intra;
+    portals4_module->super.coll_ireduce_scatter = ompi_coll_portals4_ireduce_scatter_intra;
+
     return &(portals4_module->super);
 }
 
@@ -657,6 +666,8 @@ portals4_module_enable(mca_coll_base_module_t *module,
     PORTALS4_SAVE_PREV_COLL_API(portals4_module, comm, iallreduce);
     PORTALS4_SAVE_PREV_COLL_API(portals4_module, comm, reduce);
     PORTALS4_SAVE_PREV_COLL_API(portals4_module, comm, ireduce);
+    PORTALS4_SAVE_PREV_COLL_API(portals4_module, comm, reduce_scatter);
+    PORTALS4_SAVE_PREV_COLL_API(portals4_module, comm, ireduce_scatter);
 
     return OMPI_SUCCESS;
 }
@@ -741,6 +752,15 @@ portals4_progress(void)
                     case OMPI_COLL_PORTALS4_TYPE_GATHER:
                         ompi_coll_portals4_igather_intra_fini(ptl_request);
                         break;
+                    case OMPI_COLL_PORTALS4_TYPE_ALLGATHER:
+                        ompi_coll_portals4_iallgather_intra_fini(ptl_request);
+                        break;
+                    case OMPI_COLL_PORTALS4_TYPE_ALLTOALL:
+                        ompi_coll_portals4_ialltoall_intra_fini(ptl_request);
+                        break;
+                    case OMPI_COLL_PORTALS4_TYPE_REDUCE_SCATTER:
+                        ompi_coll_portals4_ireduce_scatter_intra_fini(ptl_request);
+                        break;
                     }
                 }
 
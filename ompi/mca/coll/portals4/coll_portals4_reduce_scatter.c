@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/datatype/ompi_datatype_internal.h"
+#include "ompi/mca/coll/base/base.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/op/op.h"
+
+#include "coll_portals4.h"
+#include "coll_portals4_request.h"
+
+/*
+ * Direct exchange reduce_scatter with the reduction done by the NIC.
+ *
+ * Every rank copies its own contribution to its block into recvbuf,
+ * exposes recvbuf through an ME and sends an RTR to every peer.  Once
+ * all the RTRs are there, the block of every peer is sent as triggered
+ * atomics, cut in segments of at most max_atomic_size, so the peers
+ * accumulate the contributions in place.  The data counter counts the
+ * incoming segments, then the Recv-ACKs and the done counter work as in
+ * the allgather.
+ *
+ * Only the op/datatype pairs that the NIC can reduce (commutative and
+ * associative predefined ops on predefined types) are offloaded, the
+ * others as well as MPI_IN_PLACE go to the previous component.
+ */
+
+static int
+reduce_scatter_setup_handles(struct ompi_communicator_t *comm,
+        ompi_coll_portals4_request_t *request,
+        void *recvbuf, size_t length)
+{
+    int ret;
+    ptl_me_t me;
+
+    COLL_PORTALS4_SET_BITS(request->u.reduce_scatter.data_match_bits, ompi_comm_get_cid(comm),
+            0, 0, COLL_PORTALS4_REDUCE_SCATTER, 0, request->u.reduce_scatter.coll_count);
+    COLL_PORTALS4_SET_BITS(request->u.reduce_scatter.sync_match_bits, ompi_comm_get_cid(comm),
+            0, 1, COLL_PORTALS4_REDUCE_SCATTER, 0, request->u.reduce_scatter.coll_count);
+
+    if ((ret = PtlCTAlloc(mca_coll_portals4_component.ni_h, &request->u.reduce_scatter.data_cth)) != 0) {
+        return opal_stderr("PtlCTAlloc failed", __FILE__, __LINE__, ret);
+    }
+    if ((ret = PtlCTAlloc(mca_coll_portals4_component.ni_h, &request->u.reduce_scatter.sync_cth)) != 0) {
+        return opal_stderr("PtlCTAlloc failed", __FILE__, __LINE__, ret);
+    }
+    if ((ret = PtlCTAlloc(mca_coll_portals4_component.ni_h, &request->u.reduce_scatter.done_cth)) != 0) {
+        return opal_stderr("PtlCTAlloc failed", __FILE__, __LINE__, ret);
+    }
+
+    /*
+     ** Prepare Data ME, target of the atomics
+     */
+    memset(&me, 0, sizeof(ptl_me_t));
+    me.start = recvbuf;
+    me.length = length;
+    me.ct_handle = request->u.reduce_scatter.data_cth;
+    me.uid = mca_coll_portals4_component.uid;
+    me.options = PTL_ME_OP_PUT | PTL_ME_EVENT_SUCCESS_DISABLE |
+            PTL_ME_EVENT_LINK_DISABLE | PTL_ME_EVENT_UNLINK_DISABLE |
+            PTL_ME_EVENT_CT_COMM;
+    me.match_id.phys.nid = PTL_NID_ANY;
+    me.match_id.phys.pid = PTL_PID_ANY;
+    me.match_bits = request->u.reduce_scatter.data_match_bits;
+    me.ignore_bits = 0;
+
+    if ((ret = PtlMEAppend(mca_coll_portals4_component.ni_h,
+            mca_coll_portals4_component.pt_idx,
+            &me, PTL_PRIORITY_LIST, NULL,
+            &request->u.reduce_scatter.data_me_h)) != 0) {
+        return opal_stderr("PtlMEAppend failed", __FILE__, __LINE__, ret);
+    }
+
+    /*
+     ** Prepare ME for RTR and Recv-ACK
+     ** Priority List, match also with "Overflow list Me" in coll_portals4_component
+     */
+    memset(&me, 0, sizeof(ptl_me_t));
+    me.start = NULL;
+    me.length = 0;
+    me.ct_handle = request->u.reduce_scatter.sync_cth;
+    me.uid = mca_coll_portals4_component.uid;
+    me.options = PTL_ME_OP_PUT | PTL_ME_EVENT_SUCCESS_DISABLE |
+            PTL_ME_EVENT_LINK_DISABLE | PTL_ME_EVENT_UNLINK_DISABLE |
+            PTL_ME_EVENT_CT_COMM | PTL_ME_EVENT_CT_OVERFLOW;
+    me.match_id.phys.nid = PTL_NID_ANY;
+    me.match_id.phys.pid = PTL_PID_ANY;
+    me.match_bits = request->u.reduce_scatter.sync_match_bits;
+    me.ignore_bits = 0;
+
+    if ((ret = PtlMEAppend(mca_coll_portals4_component.ni_h,
+            mca_coll_portals4_component.pt_idx,
+            &me, PTL_PRIORITY_LIST, NULL,
+            &request->u.reduce_scatter.sync_me_h)) != 0) {
+        return opal_stderr("PtlMEAppend failed", __FILE__, __LINE__, ret);
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int
+reduce_scatter_top(const void *sendbuf, void *recvbuf, const int *recvcounts,
+        MPI_Datatype dtype, ptl_op_t ptl_op, ptl_datatype_t ptl_dtype,
+        size_t segment_count,
+        struct ompi_communicator_t *comm,
+        ompi_coll_portals4_request_t *request,
+        mca_coll_portals4_module_t *module)
+{
+    int ret, i;
+    int size = ompi_comm_size(comm);
+    int rank = ompi_comm_rank(comm);
+    int peers = size - 1;
+    size_t dsize, my_disp = 0, my_segment_nb;
+    ptl_ct_event_t ct, ct_inc;
+
+    request->type = OMPI_COLL_PORTALS4_TYPE_REDUCE_SCATTER;
+
+    ompi_datatype_type_size(dtype, &dsize);
+
+    for (i = 0 ; i < rank ; i++) {
+        my_disp += recvcounts[i];
+    }
+    my_segment_nb = div(recvcounts[rank], segment_count);
+
+    request->u.reduce_scatter.coll_count = opal_atomic_add_fetch_size_t(&module->coll_count, 1);
+
+    /* our own contribution is the initial value of the accumulation */
+    memcpy(recvbuf, (char *) sendbuf + my_disp * dsize, recvcounts[rank] * dsize);
+
+    ret = reduce_scatter_setup_handles(comm, request, recvbuf, recvcounts[rank] * dsize);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    /*
+     * Triggered atomics of the block of every peer, once all the RTRs are there
+     */
+    for (i = 1 ; i < size ; i++) {
+        /* start with the right neighbour, so the peers are not all hit at once */
+        int peer = (rank + i) % size;
+        size_t disp = 0, done = 0;
+        int j;
+
+        for (j = 0 ; j < peer ; j++) {
+            disp += recvcounts[j];
+        }
+
+        while (done < (size_t) recvcounts[peer]) {
+            size_t seg = min(segment_count, recvcounts[peer] - done);
+
+            if ((ret = PtlTriggeredAtomic(mca_coll_portals4_component.data_md_h,
+                    (uint64_t) sendbuf + (disp + done) * dsize,
+                    seg * dsize, PTL_NO_ACK_REQ,
+                    ompi_coll_portals4_get_peer(comm, peer),
+                    mca_coll_portals4_component.pt_idx,
+                    request->u.reduce_scatter.data_match_bits,
+                    done * dsize, NULL, 0,
+                    ptl_op, ptl_dtype,
+                    request->u.reduce_scatter.sync_cth,
+                    peers)) != 0) {
+                return opal_stderr("PtlTriggeredAtomic failed", __FILE__, __LINE__, ret);
+            }
+            done += seg;
+        }
+    }
+
+    /*
+     * Recv-ACK to every peer once all the segments are accumulated
+     */
+    for (i = 0 ; i < size ; i++) {
+        if (i == rank) {
+            continue;
+        }
+        if ((ret = PtlTriggeredPut(mca_coll_portals4_component.zero_md_h, 0, 0, PTL_NO_ACK_REQ,
+                ompi_coll_portals4_get_peer(comm, i),
+                mca_coll_portals4_component.pt_idx,
+                request->u.reduce_scatter.sync_match_bits, 0, NULL, 0,
+                request->u.reduce_scatter.data_cth,
+                peers * my_segment_nb)) != 0) {
+            return opal_stderr("PtlTriggeredPut failed", __FILE__, __LINE__, ret);
+        }
+    }
+
+    /*
+     * Chain data and sync to the done CT
+     */
+    ct_inc.success = 1;
+    ct_inc.failure = 0;
+    if ((ret = PtlTriggeredCTInc(request->u.reduce_scatter.done_cth, ct_inc,
+            request->u.reduce_scatter.data_cth,
+            peers * my_segment_nb)) != 0) {
+        return opal_stderr("PtlTriggeredCTInc failed", __FILE__, __LINE__, ret);
+    }
+    if ((ret = PtlTriggeredCTInc(request->u.reduce_scatter.done_cth, ct_inc,
+            request->u.reduce_scatter.sync_cth,
+            2 * peers)) != 0) {
+        return opal_stderr("PtlTriggeredCTInc failed", __FILE__, __LINE__, ret);
+    }
+
+    if (!request->is_sync) {
+        if ((ret = PtlTriggeredPut(mca_coll_portals4_component.zero_md_h, 0, 0, PTL_NO_ACK_REQ,
+                ompi_coll_portals4_get_peer(comm, rank),
+                mca_coll_portals4_component.finish_pt_idx,
+                0, 0, NULL, (uintptr_t) request,
+                request->u.reduce_scatter.done_cth,
+                2)) != 0) {
+            return opal_stderr("PtlTriggeredPut failed", __FILE__, __LINE__, ret);
+        }
+    }
+
+    /*
+     * OK, everything is ready for data and acknowledgement reception,
+     * send RTR to all peers
+     */
+    for (i = 0 ; i < size ; i++) {
+        if (i == rank) {
+            continue;
+        }
+        if ((ret = PtlPut(mca_coll_portals4_component.zero_md_h, 0, 0, PTL_NO_ACK_REQ,
+                ompi_coll_portals4_get_peer(comm, i),
+                mca_coll_portals4_component.pt_idx,
+                request->u.reduce_scatter.sync_match_bits, 0, NULL, 0)) != PTL_OK) {
+            return opal_stderr("Put RTR failed", __FILE__, __LINE__, ret);
+        }
+    }
+
+    if (request->is_sync) {
+        if ((ret = PtlCTWait(request->u.reduce_scatter.done_cth, 2, &ct)) != 0) {
+            opal_stderr("PtlCTWait failed", __FILE__, __LINE__, ret);
+        }
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int
+reduce_scatter_bottom(ompi_coll_portals4_request_t *request)
+{
+    int ret;
+
+    PtlAtomicSync();
+
+    do {
+        ret = PtlMEUnlink(request->u.reduce_scatter.data_me_h);
+    } while (PTL_IN_USE == ret);
+    if (PTL_OK != ret) {
+        opal_output_verbose(1, ompi_coll_base_framework.framework_output,
+                "%s:%d: PtlMEUnlink failed: %d\n",
+                __FILE__, __LINE__, ret);
+        return OMPI_ERROR;
+    }
+
+    do {
+        ret = PtlMEUnlink(request->u.reduce_scatter.sync_me_h);
+    } while (PTL_IN_USE == ret);
+    if (PTL_OK != ret) {
+        opal_output_verbose(1, ompi_coll_base_framework.framework_output,
+                "%s:%d: PtlMEUnlink failed: %d\n",
+                __FILE__, __LINE__, ret);
+        return OMPI_ERROR;
+    }
+
+    ret = PtlCTFree(request->u.reduce_scatter.data_cth);
+    if (PTL_OK != ret) {
+        opal_output_verbose(1, ompi_coll_base_framework.framework_output,
+                "%s:%d: PtlCTFree failed: %d\n",
+                __FILE__, __LINE__, ret);
+        return OMPI_ERROR;
+    }
+
+    ret = PtlCTFree(request->u.reduce_scatter.sync_cth);
+    if (PTL_OK != ret) {
+        opal_output_verbose(1, ompi_coll_base_framework.framework_output,
+                "%s:%d: PtlCTFree failed: %d\n",
+                __FILE__, __LINE__, ret);
+        return OMPI_ERROR;
+    }
+
+    ret = PtlCTFree(request->u.reduce_scatter.done_cth);
+    if (PTL_OK != ret) {
+        opal_output_verbose(1, ompi_coll_base_framework.framework_output,
+                "%s:%d: PtlCTFree failed: %d\n",
+                __FILE__, __LINE__, ret);
+        return OMPI_ERROR;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Can the NIC reduce this call?  On success, *segment_count is the
+ * number of elements carried by one atomic.
+ */
+static bool
+reduce_scatter_is_optimizable(const void *sendbuf, MPI_Datatype dtype, MPI_Op op,
+        ptl_datatype_t *ptl_dtype, ptl_op_t *ptl_op, size_t *segment_count)
+{
+    size_t dsize;
+
+    if (MPI_IN_PLACE == sendbuf) {
+        return false;
+    }
+
+    ompi_datatype_type_size(dtype, &dsize);
+    if (0 == dsize) {
+        return false;
+    }
+
+    /* the length check is done on a single element, the blocks are segmented */
+    if (!is_reduce_optimizable(dtype, dsize, op, ptl_dtype, ptl_op)) {
+        return false;
+    }
+
+    *segment_count = mca_coll_portals4_component.ni_limits.max_atomic_size / dsize;
+    return (0 < *segment_count);
+}
+
+int
+ompi_coll_portals4_reduce_scatter_intra(const void *sendbuf, void *recvbuf,
+        const int *recvcounts,
+        MPI_Datatype dtype, MPI_Op op,
+        struct ompi_communicator_t *comm,
+        mca_coll_base_module_t *module)
+{
+    mca_coll_portals4_module_t *portals4_module = (mca_coll_portals4_module_t*) module;
+    ompi_coll_portals4_request_t *request;
+    ptl_datatype_t ptl_dtype;
+    ptl_op_t ptl_op;
+    size_t segment_count;
+    int ret;
+
+    if (!reduce_scatter_is_optimizable(sendbuf, dtype, op, &ptl_dtype, &ptl_op, &segment_count)) {
+        opal_output_verbose(100, ompi_coll_base_framework.framework_output,
+                "rank %d - optimization not supported, falling back to previous handler\n",
+                ompi_comm_rank(comm));
+        return portals4_module->previous_reduce_scatter(sendbuf, recvbuf, recvcounts, dtype, op,
+                comm, portals4_module->previous_reduce_scatter_module);
+    }
+
+    OMPI_COLL_PORTALS4_REQUEST_ALLOC(comm, request);
+    if (NULL == request) {
+        opal_output_verbose(1, ompi_coll_base_framework.framework_output,
+                "%s:%d: request alloc failed\n",
+                __FILE__, __LINE__);
+        return OMPI_ERR_TEMP_OUT_OF_RESOURCE;
+    }
+
+    request->is_sync = true;
+    request->fallback_request = NULL;
+
+    ret = reduce_scatter_top(sendbuf, recvbuf, recvcounts, dtype, ptl_op, ptl_dtype,
+            segment_count, comm, request, portals4_module);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    reduce_scatter_bottom(request);
+
+    OMPI_COLL_PORTALS4_REQUEST_RETURN(request);
+    return (OMPI_SUCCESS);
+}
+
+
+int
+ompi_coll_portals4_ireduce_scatter_intra(const void *sendbuf, void *recvbuf,
+        const int *recvcounts,
+        MPI_Datatype dtype, MPI_Op op,
+        struct ompi_communicator_t *comm,
+        ompi_request_t **ompi_request,
+        mca_coll_base_module_t *module)
+{
+    mca_coll_portals4_module_t *portals4_module = (mca_coll_portals4_module_t*) module;
+    ompi_coll_portals4_request_t *request;
+    ptl_datatype_t ptl_dtype;
+    ptl_op_t ptl_op;
+    size_t segment_count;
+    int ret;
+
+    if (!reduce_scatter_is_optimizable(sendbuf, dtype, op, &ptl_dtype, &ptl_op, &segment_count)) {
+        opal_output_verbose(100, ompi_coll_base_framework.framework_output,
+                "rank %d - optimization not supported, falling back to previous handler\n",
+                ompi_comm_rank(comm));
+        return portals4_module->previous_ireduce_scatter(sendbuf, recvbuf, recvcounts, dtype, op,
+                comm, ompi_request, portals4_module->previous_ireduce_scatter_module);
+    }
+
+    OMPI_COLL_PORTALS4_REQUEST_ALLOC(comm, request);
+    if (NULL == request) {
+        opal_output_verbose(1, ompi_coll_base_framework.framework_output,
+                "%s:%d: request alloc failed\n",
+                __FILE__, __LINE__);
+        return OMPI_ERR_TEMP_OUT_OF_RESOURCE;
+    }
+    *ompi_request = &request->super;
+    request->fallback_request = ompi_request;
+    request->is_sync = false;
+
+    ret = reduce_scatter_top(sendbuf, recvbuf, recvcounts, dtype, ptl_op, ptl_dtype,
+            segment_count, comm, request, portals4_module);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    opal_output_verbose(10, ompi_coll_base_framework.framework_output, "ireduce_scatter");
+    return (OMPI_SUCCESS);
+}
+
+
+int
+ompi_coll_portals4_ireduce_scatter_intra_fini(ompi_coll_portals4_request_t *request)
+{
+    reduce_scatter_bottom(request);
+    ompi_request_complete(&request->super, true);
+
+    return (OMPI_SUCCESS);
+}
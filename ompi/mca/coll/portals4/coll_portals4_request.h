@@ -34,6 +34,9 @@ enum ompi_coll_portals4_request_type_t {
     OMPI_COLL_PORTALS4_TYPE_GATHER,
     OMPI_COLL_PORTALS4_TYPE_REDUCE,
     OMPI_COLL_PORTALS4_TYPE_ALLREDUCE,
+    OMPI_COLL_PORTALS4_TYPE_ALLGATHER,
+    OMPI_COLL_PORTALS4_TYPE_ALLTOALL,
+    OMPI_COLL_PORTALS4_TYPE_REDUCE_SCATTER,
 };
 typedef enum ompi_coll_portals4_request_type_t ompi_coll_portals4_request_type_t;
 
@@ -166,6 +169,62 @@ struct ompi_coll_portals4_request_t {
             MPI_Aint                unpack_dst_true_lb;
             MPI_Aint                unpack_dst_offset;
         } scatter;
+
+        struct {
+            size_t                  packed_size;
+            size_t                  coll_count;
+            char                   *gather_buf;
+            uint64_t                gather_bytes;
+            ptl_match_bits_t        data_match_bits;
+            ptl_handle_ct_t         data_cth;
+            ptl_handle_me_t         data_meh;
+            ptl_match_bits_t        sync_match_bits;
+            ptl_handle_ct_t         sync_cth;
+            ptl_handle_me_t         sync_meh;
+            ptl_handle_ct_t         done_cth;
+            int                     my_rank;
+            int                     size;
+            const char             *pack_src_buf;
+            int                     pack_src_count;
+            struct ompi_datatype_t *pack_src_dtype;
+            char                   *unpack_dst_buf;
+            int                     unpack_dst_count;
+            struct ompi_datatype_t *unpack_dst_dtype;
+        } allgather;
+
+        struct {
+            size_t                  packed_size;
+            size_t                  coll_count;
+            char                   *send_buf;
+            char                   *recv_buf;
+            size_t                  xfer_bytes;
+            ptl_match_bits_t        data_match_bits;
+            ptl_handle_ct_t         data_cth;
+            ptl_handle_me_t         data_meh;
+            ptl_match_bits_t        sync_match_bits;
+            ptl_handle_ct_t         sync_cth;
+            ptl_handle_me_t         sync_meh;
+            ptl_handle_ct_t         done_cth;
+            int                     my_rank;
+            int                     size;
+            const char             *pack_src_buf;
+            int                     pack_src_count;
+            struct ompi_datatype_t *pack_src_dtype;
+            char                   *unpack_dst_buf;
+            int                     unpack_dst_count;
+            struct ompi_datatype_t *unpack_dst_dtype;
+        } alltoall;
+
+        struct {
+            size_t coll_count;
+            ptl_match_bits_t data_match_bits;
+            ptl_match_bits_t sync_match_bits;
+            ptl_handle_me_t data_me_h;
+            ptl_handle_me_t sync_me_h;
+            ptl_handle_ct_t data_cth;
+            ptl_handle_ct_t sync_cth;
+            ptl_handle_ct_t done_cth;
+        } reduce_scatter;
     } u;
 };
 typedef struct ompi_coll_portals4_request_t ompi_coll_portals4_request_t;
@@ -81,6 +81,10 @@ BEGIN_C_DECLS
             calculation of the "info" MCA parameter */
         int sm_info_comm_size;
 
+        /** MCA parameter: Message size (in bytes) from which allreduce
+            switches from reduce+bcast to reduce-scatter+allgather */
+        int sm_allreduce_rsag_min_size;
+
         /******* end of MCA params ********/
 
         /** How many fragment segments are protected by a single
@@ -117,6 +121,12 @@ BEGIN_C_DECLS
         opal_atomic_uint32_t mcsiuf_num_procs_using;
         /** Must match data->mcb_count */
         volatile uint32_t mcsiuf_operation_count;
+        /** Number of processes that have copied their input into the
+            set of segments (reduce-scatter/allgather allreduce) */
+        opal_atomic_uint32_t mcsiuf_num_procs_copied;
+        /** Number of processes that have reduced their slice of the
+            set of segments (reduce-scatter/allgather allreduce) */
+        opal_atomic_uint32_t mcsiuf_num_procs_reduced;
     } mca_coll_sm_in_use_flag_t;
 
     /**
@@ -195,6 +205,14 @@ BEGIN_C_DECLS
         /* Underlying reduce function and module */
 	mca_coll_base_module_reduce_fn_t previous_reduce;
 	mca_coll_base_module_t *previous_reduce_module;
+
+        /* Underlying alltoall and alltoallv functions and modules
+           (used for MPI_IN_PLACE, which the pairwise exchange cannot
+           handle) */
+	mca_coll_base_module_alltoall_fn_t previous_alltoall;
+	mca_coll_base_module_t *previous_alltoall_module;
+	mca_coll_base_module_alltoallv_fn_t previous_alltoallv;
+	mca_coll_base_module_t *previous_alltoallv_module;
     } mca_coll_sm_module_t;
     OBJ_CLASS_DECLARATION(mca_coll_sm_module_t);
 
@@ -270,14 +288,14 @@ BEGIN_C_DECLS
 				 struct ompi_op_t *op,
 				 struct ompi_communicator_t *comm,
 				 mca_coll_base_module_t *module);
-    int mca_coll_sm_gather_intra(void *sbuf, int scount,
+    int mca_coll_sm_gather_intra(const void *sbuf, int scount,
 				 struct ompi_datatype_t *sdtype, void *rbuf,
 				 int rcount, struct ompi_datatype_t *rdtype,
 				 int root, struct ompi_communicator_t *comm,
 				 mca_coll_base_module_t *module);
-    int mca_coll_sm_gatherv_intra(void *sbuf, int scount,
+    int mca_coll_sm_gatherv_intra(const void *sbuf, int scount,
 				  struct ompi_datatype_t *sdtype, void *rbuf,
-				  int *rcounts, int *disps,
+				  const int *rcounts, const int *disps,
 				  struct ompi_datatype_t *rdtype, int root,
 				  struct ompi_communicator_t *comm,
 				  mca_coll_base_module_t *module);
@@ -316,6 +334,33 @@ BEGIN_C_DECLS
 				   struct ompi_communicator_t *comm,
 				   mca_coll_base_module_t *module);
 
+    /* Fragment engines shared by the rooted and the all-to-all style
+       collectives.  max_bytes is the largest packed contribution of
+       any single process (or process pair) and must be the same on
+       every process: it determines how many segments everyone steps
+       through. */
+    int mca_coll_sm_gatherv_frags(const void *sbuf, int scount,
+				  struct ompi_datatype_t *sdtype, void *rbuf,
+				  const int *rcounts, const int *disps,
+				  struct ompi_datatype_t *rdtype, int root,
+				  size_t max_bytes,
+				  struct ompi_communicator_t *comm,
+				  mca_coll_base_module_t *module);
+    int mca_coll_sm_scatterv_frags(const void *sbuf, const int *scounts,
+				   const int *disps, struct ompi_datatype_t *sdtype,
+				   void *rbuf, int rcount,
+				   struct ompi_datatype_t *rdtype, int root,
+				   size_t max_bytes,
+				   struct ompi_communicator_t *comm,
+				   mca_coll_base_module_t *module);
+    int mca_coll_sm_exchange_frags(const void *sbuf, const int *scounts,
+				   const int *sdisps, struct ompi_datatype_t *sdtype,
+				   void *rbuf, const int *rcounts, const int *rdisps,
+				   struct ompi_datatype_t *rdtype,
+				   size_t max_bytes,
+				   struct ompi_communicator_t *comm,
+				   mca_coll_base_module_t *module);
+
 /**
  * Global variables used in the macros (essentially constants, so
  * these are thread safe)
@@ -422,6 +467,18 @@ extern uint32_t mca_coll_sm_one;
         *ptr = 0; \
     } while (0)
 
+/**
+ * Macro for a process to tell a specific peer that a fragment is
+ * ready.  The peer waits on its own control buffer with
+ * CHILD_WAIT_FOR_NOTIFY().  Used by the flat (non-tree) fan in, fan
+ * out and pairwise exchange operations.
+ */
+#define PEER_NOTIFY(peer_rank, index, value) \
+    *((uint32_t volatile *) \
+      (((char*) (index)->mcbmi_control) + \
+       ((peer_rank) * mca_coll_sm_component.sm_control_size))) = \
+        (uint32_t) (value)
+
 /**
  * Macro for children to tell parent that the data is ready in their
  * segment.  Used for fan in operations.
@@ -20,16 +20,24 @@
 
 #include "ompi_config.h"
 
+#include <stdlib.h>
+
 #include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/datatype/ompi_datatype.h"
 #include "coll_sm.h"
 
 
 /*
- *	allgather
+ *      allgather
+ *
+ *      Function:       - shared memory allgather
+ *      Accepts:        - same as MPI_Allgather()
+ *      Returns:        - MPI_SUCCESS or error code
  *
- *	Function:	- allgather
- *	Accepts:	- same as MPI_Allgather()
- *	Returns:	- MPI_SUCCESS or error code
+ *      This is the pairwise exchange engine where every peer is sent
+ *      the same block.  With MPI_IN_PLACE, that block is my own slot
+ *      of the receive buffer.
  */
 int mca_coll_sm_allgather_intra(const void *sbuf, int scount,
                                 struct ompi_datatype_t *sdtype, void *rbuf,
@@ -37,5 +45,36 @@ int mca_coll_sm_allgather_intra(const void *sbuf, int scount,
                                 struct ompi_communicator_t *comm,
                                 mca_coll_base_module_t *module)
 {
-    return OMPI_ERR_NOT_IMPLEMENTED;
+    int i, ret, size, sdisp = 0;
+    int *scounts, *sdisps, *rcounts, *rdisps;
+    size_t dsize;
+
+    size = ompi_comm_size(comm);
+    if (MPI_IN_PLACE == sbuf) {
+        sbuf = rbuf;
+        scount = rcount;
+        sdtype = rdtype;
+        sdisp = ompi_comm_rank(comm) * rcount;
+    }
+
+    scounts = (int*) malloc(4 * size * sizeof(int));
+    if (NULL == scounts) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    sdisps = scounts + size;
+    rcounts = sdisps + size;
+    rdisps = rcounts + size;
+    for (i = 0; i < size; ++i) {
+        scounts[i] = scount;
+        sdisps[i] = sdisp;
+        rcounts[i] = rcount;
+        rdisps[i] = i * rcount;
+    }
+    ompi_datatype_type_size(rdtype, &dsize);
+
+    ret = mca_coll_sm_exchange_frags(sbuf, scounts, sdisps, sdtype,
+                                     rbuf, rcounts, rdisps, rdtype,
+                                     dsize * rcount, comm, module);
+    free(scounts);
+    return ret;
 }
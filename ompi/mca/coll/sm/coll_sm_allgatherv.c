@@ -20,23 +20,62 @@
 
 #include "ompi_config.h"
 
+#include <stdlib.h>
+
 #include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/datatype/ompi_datatype.h"
 #include "coll_sm.h"
 
 
 /*
- *	allgatherv_intra
+ *      allgatherv
+ *
+ *      Function:       - shared memory allgatherv
+ *      Accepts:        - same as MPI_Allgatherv()
+ *      Returns:        - MPI_SUCCESS or error code
  *
- *	Function:	- allgatherv
- *	Accepts:	- same as MPI_Allgatherv()
- *	Returns:	- MPI_SUCCESS or error code
+ *      This is the pairwise exchange engine where every peer is sent
+ *      the same block.  All the receive counts are known everywhere,
+ *      so the largest block is computed locally.
  */
 int mca_coll_sm_allgatherv_intra(const void *sbuf, int scount,
                                  struct ompi_datatype_t *sdtype,
                                  void * rbuf, const int *rcounts, const int *disps,
                                  struct ompi_datatype_t *rdtype,
                                  struct ompi_communicator_t *comm,
-                                mca_coll_base_module_t *module)
+                                 mca_coll_base_module_t *module)
 {
-    return OMPI_ERR_NOT_IMPLEMENTED;
+    int i, ret, size, sdisp = 0;
+    int *scounts, *sdisps;
+    size_t dsize, max_bytes = 0;
+
+    size = ompi_comm_size(comm);
+    if (MPI_IN_PLACE == sbuf) {
+        i = ompi_comm_rank(comm);
+        sbuf = rbuf;
+        scount = rcounts[i];
+        sdtype = rdtype;
+        sdisp = disps[i];
+    }
+
+    scounts = (int*) malloc(2 * size * sizeof(int));
+    if (NULL == scounts) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    sdisps = scounts + size;
+    ompi_datatype_type_size(rdtype, &dsize);
+    for (i = 0; i < size; ++i) {
+        scounts[i] = scount;
+        sdisps[i] = sdisp;
+        if ((size_t) rcounts[i] * dsize > max_bytes) {
+            max_bytes = (size_t) rcounts[i] * dsize;
+        }
+    }
+
+    ret = mca_coll_sm_exchange_frags(sbuf, scounts, sdisps, sdtype,
+                                     rbuf, rcounts, disps, rdtype,
+                                     max_bytes, comm, module);
+    free(scounts);
+    return ret;
 }
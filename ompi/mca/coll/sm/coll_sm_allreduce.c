@@ -22,16 +22,35 @@
 
 #include "ompi_config.h"
 
+#include <string.h>
+
+#include "opal/runtime/opal.h"
+#include "opal/sys/atomic.h"
+#include "opal/util/minmax.h"
 #include "ompi/constants.h"
 #include "ompi/communicator/communicator.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/op/op.h"
 #include "coll_sm.h"
 
 
+/*
+ * Local functions
+ */
+static int allreduce_rsag(const void *sbuf, void *rbuf, int count,
+                          struct ompi_datatype_t *dtype,
+                          struct ompi_op_t *op,
+                          struct ompi_communicator_t *comm,
+                          mca_coll_base_module_t *module);
+
+
 /**
  * Shared memory allreduce.
  *
- * For the moment, all we're doing is a reduce to root==0 and then a
- * broadcast.  It is possible that we'll do something better someday.
+ * Large messages of predefined datatypes with commutative operations
+ * use a reduce-scatter followed by an allgather through the shared
+ * segments (see allreduce_rsag()).  Everything else is a reduce to
+ * root==0 and then a broadcast.
  */
 int mca_coll_sm_allreduce_intra(const void *sbuf, void *rbuf, int count,
                                 struct ompi_datatype_t *dtype,
@@ -40,6 +59,15 @@ int mca_coll_sm_allreduce_intra(const void *sbuf, void *rbuf, int count,
                                 mca_coll_base_module_t *module)
 {
     int ret;
+    size_t dsize;
+
+    ompi_datatype_type_size(dtype, &dsize);
+    if (mca_coll_sm_component.sm_allreduce_rsag_min_size >= 0 &&
+        dsize * (size_t) count >= (size_t) mca_coll_sm_component.sm_allreduce_rsag_min_size &&
+        (int) dsize <= mca_coll_sm_component.sm_fragment_size &&
+        ompi_datatype_is_predefined(dtype) && ompi_op_is_commute(op)) {
+        return allreduce_rsag(sbuf, rbuf, count, dtype, op, comm, module);
+    }
 
     /* Note that only the root can pass MPI_IN_PLACE to MPI_REDUCE, so
        have slightly different logic for that case. */
@@ -60,3 +88,179 @@ int mca_coll_sm_allreduce_intra(const void *sbuf, void *rbuf, int count,
     return (ret == OMPI_SUCCESS) ?
         mca_coll_sm_bcast_intra(rbuf, count, dtype, 0, comm, module) : ret;
 }
+
+
+/**
+ * Reduce-scatter + allgather allreduce.
+ *
+ * Every process copies a fragment of its input into its own portion
+ * of each segment of a set.  The elements of a segment are then split
+ * into size slices (rounded up to whole cache lines), and process j
+ * owns slice j: it reduces slice j of every other process' portion
+ * into slice j of its own portion, so the result is accumulated in
+ * memory that is local to the owner (see the memory affinity setup in
+ * ompi_coll_sm_lazy_enable()).  Finally, every process copies all the
+ * reduced slices out to its receive buffer.
+ *
+ * This spreads the reduction work and the memory traffic evenly over
+ * all the processes (and sockets), instead of funneling it through a
+ * single root.
+ *
+ * Rank 0 claims each set of segments and resets its two phase
+ * counters; the processes synchronize on those counters between the
+ * copy in, reduce and copy out phases.
+ */
+static int allreduce_rsag(const void *sbuf, void *rbuf, int count,
+                          struct ompi_datatype_t *dtype,
+                          struct ompi_op_t *op,
+                          struct ompi_communicator_t *comm,
+                          mca_coll_base_module_t *module)
+{
+    mca_coll_sm_module_t *sm_module = (mca_coll_sm_module_t*) module;
+    mca_coll_sm_comm_t *data;
+    int ret, rank, size, peer;
+    int flag_num, segment_num, first_segment_num, max_segment_num;
+    size_t dsize, seg_count, slice_count, line_count, done, todo, lo, hi;
+    size_t frag_size = (size_t) mca_coll_sm_component.sm_fragment_size;
+    char *src, *dst, *mine;
+    mca_coll_sm_in_use_flag_t *flag;
+    mca_coll_sm_data_index_t *index;
+
+    /* Lazily enable the module the first time we invoke a collective
+       on it */
+    if (!sm_module->enabled) {
+        if (OMPI_SUCCESS != (ret = ompi_coll_sm_lazy_enable(module, comm))) {
+            return ret;
+        }
+    }
+    data = sm_module->sm_comm_data;
+
+    rank = ompi_comm_rank(comm);
+    size = ompi_comm_size(comm);
+    if (MPI_IN_PLACE == sbuf) {
+        sbuf = rbuf;
+    }
+
+    /* Number of elements in a fragment, and in a cache line (slices
+       are a multiple of the latter so that no two owners write the
+       same cache line) */
+    ompi_datatype_type_size(dtype, &dsize);
+    seg_count = frag_size / dsize;
+    line_count = 1;
+    if (0 == opal_cache_line_size % dsize &&
+        (size_t) opal_cache_line_size / dsize <= seg_count) {
+        line_count = (size_t) opal_cache_line_size / dsize;
+    }
+
+    done = 0;
+    do {
+        flag_num = (data->mcb_operation_count %
+                    mca_coll_sm_component.sm_comm_num_in_use_flags);
+        FLAG_SETUP(flag_num, flag, data);
+        if (0 == rank) {
+            FLAG_WAIT_FOR_IDLE(flag, rsag_claim_label);
+            flag->mcsiuf_num_procs_copied = 0;
+            flag->mcsiuf_num_procs_reduced = 0;
+            opal_atomic_wmb();
+            FLAG_RETAIN(flag, size, data->mcb_operation_count);
+        } else {
+            FLAG_WAIT_FOR_OP(flag, data->mcb_operation_count, rsag_wait_label);
+        }
+        ++data->mcb_operation_count;
+
+        first_segment_num =
+            flag_num * mca_coll_sm_component.sm_segs_per_inuse_flag;
+        max_segment_num =
+            (flag_num + 1) * mca_coll_sm_component.sm_segs_per_inuse_flag;
+
+        /* Copy in: one fragment of my input per segment.  Nobody
+           reads my own slice of it: it is reduced from sbuf below. */
+
+        todo = done;
+        for (segment_num = first_segment_num;
+             segment_num < max_segment_num && todo < (size_t) count;
+             ++segment_num) {
+            index = &(data->mcb_data_index[segment_num]);
+            hi = opal_min(seg_count, (size_t) count - todo);
+            lo = hi;
+            slice_count = 0;
+            if (size > 1) {
+                slice_count = (hi + size - 1) / size;
+                slice_count = ((slice_count + line_count - 1) / line_count) * line_count;
+                lo = opal_min(rank * slice_count, hi);
+                slice_count = opal_min(lo + slice_count, hi) - lo;
+            }
+            memcpy(index->mcbmi_data + rank * frag_size,
+                   (char*) sbuf + todo * dsize, lo * dsize);
+            memcpy(index->mcbmi_data + rank * frag_size + (lo + slice_count) * dsize,
+                   (char*) sbuf + (todo + lo + slice_count) * dsize,
+                   (hi - lo - slice_count) * dsize);
+            todo += hi;
+        }
+        opal_atomic_wmb();
+        opal_atomic_add(&flag->mcsiuf_num_procs_copied, 1);
+        SPIN_CONDITION(size == flag->mcsiuf_num_procs_copied, rsag_copied_label);
+
+        /* Reduce my slice of each segment into my own portion */
+
+        todo = done;
+        for (segment_num = first_segment_num;
+             segment_num < max_segment_num && todo < (size_t) count;
+             ++segment_num) {
+            index = &(data->mcb_data_index[segment_num]);
+            hi = opal_min(seg_count, (size_t) count - todo);
+            slice_count = (hi + size - 1) / size;
+            slice_count = ((slice_count + line_count - 1) / line_count) * line_count;
+            lo = opal_min(rank * slice_count, hi);
+            mine = (char*) sbuf + (todo + lo) * dsize;
+            todo += hi;
+            hi = opal_min(lo + slice_count, hi);
+            if (lo == hi) {
+                continue;
+            }
+            /* The first reduction reads my slice from sbuf and writes
+               the result straight into the fragment the others copy
+               out (predefined datatypes are contiguous, so the packed
+               fragment is the memory layout) */
+            dst = index->mcbmi_data + rank * frag_size + lo * dsize;
+            for (peer = 0; peer < size; ++peer) {
+                if (peer == rank) {
+                    continue;
+                }
+                src = index->mcbmi_data + peer * frag_size + lo * dsize;
+                if (NULL != mine) {
+                    (void) ompi_op_reduce_pack(op, src, mine, dst, hi - lo, dtype);
+                    mine = NULL;
+                } else {
+                    ompi_op_reduce(op, src, dst, hi - lo, dtype);
+                }
+            }
+        }
+        opal_atomic_wmb();
+        opal_atomic_add(&flag->mcsiuf_num_procs_reduced, 1);
+        SPIN_CONDITION(size == flag->mcsiuf_num_procs_reduced, rsag_reduced_label);
+
+        /* Copy out: every owner's slice of each segment */
+
+        for (segment_num = first_segment_num;
+             segment_num < max_segment_num && done < (size_t) count;
+             ++segment_num) {
+            index = &(data->mcb_data_index[segment_num]);
+            hi = opal_min(seg_count, (size_t) count - done);
+            slice_count = (hi + size - 1) / size;
+            slice_count = ((slice_count + line_count - 1) / line_count) * line_count;
+            for (peer = 0, lo = 0; peer < size && lo < hi; ++peer, lo += slice_count) {
+                memcpy((char*) rbuf + (done + lo) * dsize,
+                       index->mcbmi_data + peer * frag_size + lo * dsize,
+                       opal_min(slice_count, hi - lo) * dsize);
+            }
+            done += hi;
+        }
+
+        /* We're finished with this set of segments */
+        opal_atomic_wmb();
+        FLAG_RELEASE(flag);
+    } while (done < (size_t) count);
+
+    return OMPI_SUCCESS;
+}
@@ -20,22 +20,63 @@
 
 #include "ompi_config.h"
 
+#include <stdlib.h>
+
 #include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/datatype/ompi_datatype.h"
 #include "coll_sm.h"
 
 
 /*
- *	alltoall_intra
+ *      alltoall
+ *
+ *      Function:       - shared memory alltoall
+ *      Accepts:        - same as MPI_Alltoall()
+ *      Returns:        - MPI_SUCCESS or error code
  *
- *	Function:	- MPI_Alltoall
- *	Accepts:	- same as MPI_Alltoall()
- *	Returns:	- MPI_SUCCESS or an MPI error code
+ *      This is the pairwise exchange engine with uniform counts.
+ *      MPI_IN_PLACE is handed to the underlying module.
  */
 int mca_coll_sm_alltoall_intra(const void *sbuf, int scount,
                                struct ompi_datatype_t *sdtype, void *rbuf,
                                int rcount, struct ompi_datatype_t *rdtype,
                                struct ompi_communicator_t *comm,
-                                mca_coll_base_module_t *module)
+                               mca_coll_base_module_t *module)
 {
-    return OMPI_ERR_NOT_IMPLEMENTED;
+    mca_coll_sm_module_t *sm_module = (mca_coll_sm_module_t*) module;
+    int i, ret, size;
+    int *scounts, *sdisps, *rcounts, *rdisps;
+    size_t dsize;
+
+    if (MPI_IN_PLACE == sbuf) {
+        if (NULL == sm_module->previous_alltoall) {
+            return OMPI_ERR_NOT_SUPPORTED;
+        }
+        return sm_module->previous_alltoall(sbuf, scount, sdtype,
+                                            rbuf, rcount, rdtype, comm,
+                                            sm_module->previous_alltoall_module);
+    }
+
+    size = ompi_comm_size(comm);
+    scounts = (int*) malloc(4 * size * sizeof(int));
+    if (NULL == scounts) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    sdisps = scounts + size;
+    rcounts = sdisps + size;
+    rdisps = rcounts + size;
+    for (i = 0; i < size; ++i) {
+        scounts[i] = scount;
+        sdisps[i] = i * scount;
+        rcounts[i] = rcount;
+        rdisps[i] = i * rcount;
+    }
+    ompi_datatype_type_size(rdtype, &dsize);
+
+    ret = mca_coll_sm_exchange_frags(sbuf, scounts, sdisps, sdtype,
+                                     rbuf, rcounts, rdisps, rdtype,
+                                     dsize * rcount, comm, module);
+    free(scounts);
+    return ret;
 }
@@ -20,16 +20,211 @@
 
 #include "ompi_config.h"
 
+#include <stdlib.h>
+
+#include "opal/datatype/opal_convertor.h"
 #include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/op/op.h"
+#include "opal/sys/atomic.h"
 #include "coll_sm.h"
 
 
+/**
+ * Shared memory pairwise exchange fragment engine.
+ *
+ * This is the engine behind allgather(v) and alltoall(v).  The
+ * exchange takes size - 1 steps; in step k, process r sends its block
+ * for (r + k) % size and receives the block from (r - k) % size, so
+ * each process has exactly one writer and one reader per step.  Each
+ * step is cut into fragments, and each fragment uses one segment:
+ * the sender packs into its own portion of the segment and writes the
+ * fragment size into the receiver's control buffer; the receiver
+ * waits on its own control buffer and unpacks from the sender's
+ * portion.  All the writes of a segment happen before any process
+ * waits on it, so a segment can never deadlock.
+ *
+ * There is no root, so rank 0 claims each set of segments (and, like
+ * the reduction root, releases it as well).  Pairs with nothing left
+ * to say for a fragment simply skip it.  Everyone steps through the
+ * same (size - 1) * num_frags segments, derived from max_bytes.
+ *
+ * The local block is copied directly unless it is already in place
+ * (MPI_IN_PLACE allgather(v)).
+ */
+int mca_coll_sm_exchange_frags(const void *sbuf, const int *scounts,
+                               const int *sdisps, struct ompi_datatype_t *sdtype,
+                               void *rbuf, const int *rcounts, const int *rdisps,
+                               struct ompi_datatype_t *rdtype,
+                               size_t max_bytes,
+                               struct ompi_communicator_t *comm,
+                               mca_coll_base_module_t *module)
+{
+    struct iovec iov;
+    mca_coll_sm_module_t *sm_module = (mca_coll_sm_module_t*) module;
+    mca_coll_sm_comm_t *data;
+    int ret, rank, size, peer, step, dst, src;
+    int flag_num, segment_num, max_segment_num;
+    size_t unit, num_units, frag_num, num_frags, total_size, max_data, frag_size;
+    ptrdiff_t sextent, rextent, lb;
+    char *sptr, *rptr;
+    mca_coll_sm_in_use_flag_t *flag;
+    opal_convertor_t *convertors, *send_convertors, *recv_convertors;
+    mca_coll_sm_data_index_t *index;
+
+    /* Lazily enable the module the first time we invoke a collective
+       on it */
+    if (!sm_module->enabled) {
+        if (OMPI_SUCCESS != (ret = ompi_coll_sm_lazy_enable(module, comm))) {
+            return ret;
+        }
+    }
+    data = sm_module->sm_comm_data;
+
+    /* Setup some identities */
+
+    rank = ompi_comm_rank(comm);
+    size = ompi_comm_size(comm);
+    frag_size = (size_t) mca_coll_sm_component.sm_fragment_size;
+    num_frags = (max_bytes + frag_size - 1) / frag_size;
+    num_units = (size_t) (size - 1) * num_frags;
+
+    /* Local block */
+
+    ompi_datatype_get_extent(sdtype, &lb, &sextent);
+    ompi_datatype_get_extent(rdtype, &lb, &rextent);
+    sptr = (char*) sbuf + (ptrdiff_t) sdisps[rank] * sextent;
+    rptr = (char*) rbuf + (ptrdiff_t) rdisps[rank] * rextent;
+    if (sptr != rptr) {
+        ret = ompi_datatype_sndrcv(sptr, scounts[rank], sdtype,
+                                   rptr, rcounts[rank], rdtype);
+        if (MPI_SUCCESS != ret) {
+            return ret;
+        }
+    }
+    if (0 == num_units) {
+        return OMPI_SUCCESS;
+    }
+
+    /* One send and one receive convertor per peer, all prepared up
+       front so that nothing can fail once the other processes are
+       committed to the fragment loop */
+
+    convertors = (opal_convertor_t*)
+        malloc(2 * size * sizeof(opal_convertor_t));
+    if (NULL == convertors) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    send_convertors = convertors;
+    recv_convertors = convertors + size;
+    for (peer = 0; peer < 2 * size; ++peer) {
+        OBJ_CONSTRUCT(&convertors[peer], opal_convertor_t);
+    }
+    for (peer = 0; peer < size; ++peer) {
+        if (rank == peer) {
+            continue;
+        }
+        if (OMPI_SUCCESS !=
+            (ret =
+             opal_convertor_copy_and_prepare_for_send(ompi_mpi_local_convertor,
+                                                      &(sdtype->super),
+                                                      scounts[peer],
+                                                      (char*) sbuf + (ptrdiff_t) sdisps[peer] * sextent,
+                                                      0,
+                                                      &send_convertors[peer])) ||
+            OMPI_SUCCESS !=
+            (ret =
+             opal_convertor_copy_and_prepare_for_recv(ompi_mpi_local_convertor,
+                                                      &(rdtype->super),
+                                                      rcounts[peer],
+                                                      (char*) rbuf + (ptrdiff_t) rdisps[peer] * rextent,
+                                                      0,
+                                                      &recv_convertors[peer]))) {
+            goto cleanup;
+        }
+    }
+
+    /* Main loop over the exchange fragments */
+
+    unit = 0;
+    do {
+        flag_num = (data->mcb_operation_count %
+                    mca_coll_sm_component.sm_comm_num_in_use_flags);
+        FLAG_SETUP(flag_num, flag, data);
+        if (0 == rank) {
+            FLAG_WAIT_FOR_IDLE(flag, exchange_claim_label);
+            FLAG_RETAIN(flag, size, data->mcb_operation_count);
+        } else {
+            FLAG_WAIT_FOR_OP(flag, data->mcb_operation_count, exchange_wait_label);
+        }
+        ++data->mcb_operation_count;
+
+        /* Loop over all the segments in this set */
+
+        segment_num =
+            flag_num * mca_coll_sm_component.sm_segs_per_inuse_flag;
+        max_segment_num =
+            (flag_num + 1) * mca_coll_sm_component.sm_segs_per_inuse_flag;
+        do {
+            index = &(data->mcb_data_index[segment_num]);
+            step = (int) (unit / num_frags) + 1;
+            frag_num = unit % num_frags;
+            dst = (rank + step) % size;
+            src = (rank - step + size) % size;
+
+            /* Send my next fragment for dst, if there is one */
+            opal_convertor_get_packed_size(&send_convertors[dst], &total_size);
+            if (frag_num * frag_size < total_size) {
+                max_data = frag_size;
+                COPY_FRAGMENT_IN(send_convertors[dst], index, rank, iov, max_data);
+
+                /* Wait for the write to absolutely complete */
+                opal_atomic_wmb();
+
+                PEER_NOTIFY(dst, index, max_data);
+            }
+
+            /* Receive the next fragment from src, if there is one */
+            opal_convertor_get_packed_size(&recv_convertors[src], &total_size);
+            if (frag_num * frag_size < total_size) {
+                CHILD_WAIT_FOR_NOTIFY(rank, index, max_data, exchange_recv_label);
+                COPY_FRAGMENT_OUT(recv_convertors[src], src, index, iov, max_data);
+            }
+
+            ++unit;
+            ++segment_num;
+        } while (unit < num_units && segment_num < max_segment_num);
+
+        /* Wait for all copy-out writes to complete before I say I'm
+           done with the segments */
+        opal_atomic_wmb();
+
+        /* We're finished with this set of segments */
+        FLAG_RELEASE(flag);
+    } while (unit < num_units);
+    ret = OMPI_SUCCESS;
+
+ cleanup:
+    for (peer = 0; peer < 2 * size; ++peer) {
+        OBJ_DESTRUCT(&convertors[peer]);
+    }
+    free(convertors);
+    return ret;
+}
+
+
 /*
- *	alltoallv_intra
+ *      alltoallv
  *
- *	Function:	- MPI_Alltoallv
- *	Accepts:	- same as MPI_Alltoallv()
- *	Returns:	- MPI_SUCCESS or an MPI error code
+ *      Function:       - shared memory alltoallv
+ *      Accepts:        - same as MPI_Alltoallv()
+ *      Returns:        - MPI_SUCCESS or error code
+ *
+ *      Each process only knows its own counts, so the largest block
+ *      is agreed upon with an allreduce before the exchange.
+ *      MPI_IN_PLACE is handed to the underlying module.
  */
 int mca_coll_sm_alltoallv_intra(const void *sbuf, const int *scounts, const int *sdisps,
                                 struct ompi_datatype_t *sdtype,
@@ -38,5 +233,44 @@ int mca_coll_sm_alltoallv_intra(const void *sbuf, const int *scounts, const int
                                 struct ompi_communicator_t *comm,
                                 mca_coll_base_module_t *module)
 {
-    return OMPI_ERR_NOT_IMPLEMENTED;
+    mca_coll_sm_module_t *sm_module = (mca_coll_sm_module_t*) module;
+    int i, ret, rank, size;
+    size_t ssize, rsize;
+    unsigned long max_bytes = 0;
+
+    if (MPI_IN_PLACE == sbuf) {
+        if (NULL == sm_module->previous_alltoallv) {
+            return OMPI_ERR_NOT_SUPPORTED;
+        }
+        return sm_module->previous_alltoallv(sbuf, scounts, sdisps, sdtype,
+                                             rbuf, rcounts, rdisps, rdtype,
+                                             comm,
+                                             sm_module->previous_alltoallv_module);
+    }
+
+    rank = ompi_comm_rank(comm);
+    size = ompi_comm_size(comm);
+    ompi_datatype_type_size(sdtype, &ssize);
+    ompi_datatype_type_size(rdtype, &rsize);
+    for (i = 0; i < size; ++i) {
+        if (i == rank) {
+            continue;
+        }
+        if ((size_t) scounts[i] * ssize > max_bytes) {
+            max_bytes = (size_t) scounts[i] * ssize;
+        }
+        if ((size_t) rcounts[i] * rsize > max_bytes) {
+            max_bytes = (size_t) rcounts[i] * rsize;
+        }
+    }
+    ret = mca_coll_sm_allreduce_intra(MPI_IN_PLACE, &max_bytes, 1,
+                                      MPI_UNSIGNED_LONG, MPI_MAX,
+                                      comm, module);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    return mca_coll_sm_exchange_frags(sbuf, scounts, sdisps, sdtype,
+                                      rbuf, rcounts, rdisps, rdtype,
+                                      max_bytes, comm, module);
 }
@@ -231,6 +231,14 @@ static int sm_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &cs->sm_tree_degree);
 
+    cs->sm_allreduce_rsag_min_size = 65536;
+    (void) mca_base_component_var_register(c, "allreduce_rsag_min_size",
+                                           "Message size (in bytes) from which allreduce on predefined datatypes with commutative operations uses a reduce-scatter followed by an allgather, where each process reduces its own slice of the shared segments, instead of a reduce followed by a bcast (negative to disable)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &cs->sm_allreduce_rsag_min_size);
+
     /* INFO: Calculate how much space we need in the per-communicator
        shmem data segment.  This formula taken directly from
        coll_sm_module.c. */
@@ -20,7 +20,11 @@
 
 #include "ompi_config.h"
 
+#include <stdlib.h>
+
 #include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/datatype/ompi_datatype.h"
 #include "coll_sm.h"
 
 
@@ -30,6 +34,10 @@
  *      Function:       - shared memory gather
  *      Accepts:        - same as MPI_Gather()
  *      Returns:        - MPI_SUCCESS or error code
+ *
+ *      This is the gatherv fragment engine with uniform counts; every
+ *      process already knows the size of each contribution, so no
+ *      extra broadcast is needed.
  */
 int mca_coll_sm_gather_intra(const void *sbuf, int scount,
                              struct ompi_datatype_t *sdtype, void *rbuf,
@@ -37,5 +45,33 @@ int mca_coll_sm_gather_intra(const void *sbuf, int scount,
                              int root, struct ompi_communicator_t *comm,
                              mca_coll_base_module_t *module)
 {
-    return OMPI_ERR_NOT_IMPLEMENTED;
+    int i, ret, size;
+    int *rcounts = NULL, *disps = NULL;
+    size_t dsize;
+
+    if (ompi_comm_rank(comm) == root) {
+        size = ompi_comm_size(comm);
+        rcounts = (int*) malloc(2 * size * sizeof(int));
+        if (NULL == rcounts) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        disps = rcounts + size;
+        for (i = 0; i < size; ++i) {
+            rcounts[i] = rcount;
+            disps[i] = i * rcount;
+        }
+        ompi_datatype_type_size(rdtype, &dsize);
+        dsize *= rcount;
+    } else {
+        ompi_datatype_type_size(sdtype, &dsize);
+        dsize *= scount;
+    }
+
+    ret = mca_coll_sm_gatherv_frags(sbuf, scount, sdtype, rbuf, rcounts,
+                                    disps, rdtype, root, dsize,
+                                    comm, module);
+    if (NULL != rcounts) {
+        free(rcounts);
+    }
+    return ret;
 }
@@ -20,16 +20,255 @@
 
 #include "ompi_config.h"
 
+#include <stdlib.h>
+
+#include "opal/datatype/opal_convertor.h"
 #include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/mca/coll/coll.h"
+#include "opal/sys/atomic.h"
 #include "coll_sm.h"
 
 
+/**
+ * Shared memory gatherv fragment engine.
+ *
+ * This is a flat fan in: the root claims a set of segments exactly
+ * the same way as the reduction does.  For each segment in the set,
+ * every non-root process packs its next fragment into its own
+ * portion of the segment and writes the fragment size into its own
+ * control buffer.  The root waits on each peer's control buffer in
+ * turn and unpacks the fragment straight into the user's receive
+ * buffer.  A process that has no data left for a given fragment
+ * number simply does not write (and the root, which knows all the
+ * counts, does not wait for it).
+ *
+ * Every process steps through the same number of fragments
+ * (max_bytes divided by the fragment size) so that the operation
+ * counts stay in lock step, even if its own contribution is smaller.
+ */
+int mca_coll_sm_gatherv_frags(const void *sbuf, int scount,
+                              struct ompi_datatype_t *sdtype, void *rbuf,
+                              const int *rcounts, const int *disps,
+                              struct ompi_datatype_t *rdtype, int root,
+                              size_t max_bytes,
+                              struct ompi_communicator_t *comm,
+                              mca_coll_base_module_t *module)
+{
+    struct iovec iov;
+    mca_coll_sm_module_t *sm_module = (mca_coll_sm_module_t*) module;
+    mca_coll_sm_comm_t *data;
+    int ret, rank, size, peer;
+    int flag_num, segment_num, max_segment_num;
+    size_t frag_num, num_frags, total_size, max_data, bytes, frag_size;
+    ptrdiff_t extent, lb;
+    mca_coll_sm_in_use_flag_t *flag;
+    opal_convertor_t convertor, *convertors;
+    mca_coll_sm_data_index_t *index;
+
+    /* Lazily enable the module the first time we invoke a collective
+       on it */
+    if (!sm_module->enabled) {
+        if (OMPI_SUCCESS != (ret = ompi_coll_sm_lazy_enable(module, comm))) {
+            return ret;
+        }
+    }
+    data = sm_module->sm_comm_data;
+
+    /* Setup some identities */
+
+    rank = ompi_comm_rank(comm);
+    size = ompi_comm_size(comm);
+    frag_size = (size_t) mca_coll_sm_component.sm_fragment_size;
+    num_frags = (max_bytes + frag_size - 1) / frag_size;
+
+    /*********************************************************************
+     * Root
+     *********************************************************************/
+
+    if (root == rank) {
+
+        /* My own contribution never goes through shared memory */
+
+        ompi_datatype_get_extent(rdtype, &lb, &extent);
+        if (MPI_IN_PLACE != sbuf) {
+            ret = ompi_datatype_sndrcv(sbuf, scount, sdtype,
+                                       (char*) rbuf + (ptrdiff_t) disps[rank] * extent,
+                                       rcounts[rank], rdtype);
+            if (MPI_SUCCESS != ret) {
+                return ret;
+            }
+        }
+        if (0 == num_frags) {
+            return OMPI_SUCCESS;
+        }
+
+        /* One receive convertor per peer, all prepared up front so
+           that nothing can fail once the other processes are
+           committed to the fragment loop */
+
+        convertors = (opal_convertor_t*)
+            malloc(size * sizeof(opal_convertor_t));
+        if (NULL == convertors) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        for (peer = 0; peer < size; ++peer) {
+            OBJ_CONSTRUCT(&convertors[peer], opal_convertor_t);
+        }
+        for (peer = 0; peer < size; ++peer) {
+            if (root == peer) {
+                continue;
+            }
+            if (OMPI_SUCCESS !=
+                (ret =
+                 opal_convertor_copy_and_prepare_for_recv(ompi_mpi_local_convertor,
+                                                          &(rdtype->super),
+                                                          rcounts[peer],
+                                                          (char*) rbuf + (ptrdiff_t) disps[peer] * extent,
+                                                          0,
+                                                          &convertors[peer]))) {
+                goto root_cleanup;
+            }
+        }
+
+        /* Main loop over receiving fragments */
+
+        frag_num = 0;
+        do {
+            flag_num = (data->mcb_operation_count %
+                        mca_coll_sm_component.sm_comm_num_in_use_flags);
+            FLAG_SETUP(flag_num, flag, data);
+            FLAG_WAIT_FOR_IDLE(flag, gatherv_root_flag_label);
+            FLAG_RETAIN(flag, size, data->mcb_operation_count);
+            ++data->mcb_operation_count;
+
+            /* Loop over all the segments in this set */
+
+            segment_num =
+                flag_num * mca_coll_sm_component.sm_segs_per_inuse_flag;
+            max_segment_num =
+                (flag_num + 1) * mca_coll_sm_component.sm_segs_per_inuse_flag;
+            do {
+                index = &(data->mcb_data_index[segment_num]);
+
+                for (peer = 0; peer < size; ++peer) {
+                    if (root == peer) {
+                        continue;
+                    }
+                    opal_convertor_get_packed_size(&convertors[peer], &total_size);
+                    if (frag_num * frag_size >= total_size) {
+                        continue;
+                    }
+
+                    /* Wait for the peer to copy its fragment into
+                       shmem, then copy it out to the user's buffer */
+                    CHILD_WAIT_FOR_NOTIFY(peer, index, max_data, gatherv_root_label);
+                    COPY_FRAGMENT_OUT(convertors[peer], peer, index, iov, max_data);
+                }
+
+                ++frag_num;
+                ++segment_num;
+            } while (frag_num < num_frags && segment_num < max_segment_num);
+
+            /* Root is now done with this set of segments */
+            FLAG_RELEASE(flag);
+        } while (frag_num < num_frags);
+        ret = OMPI_SUCCESS;
+
+    root_cleanup:
+        for (peer = 0; peer < size; ++peer) {
+            OBJ_DESTRUCT(&convertors[peer]);
+        }
+        free(convertors);
+        return ret;
+    }
+
+    /*********************************************************************
+     * Non-root
+     *********************************************************************/
+
+    if (0 == num_frags) {
+        return OMPI_SUCCESS;
+    }
+
+    OBJ_CONSTRUCT(&convertor, opal_convertor_t);
+    if (OMPI_SUCCESS !=
+        (ret =
+         opal_convertor_copy_and_prepare_for_send(ompi_mpi_local_convertor,
+                                                  &(sdtype->super),
+                                                  scount,
+                                                  sbuf,
+                                                  0,
+                                                  &convertor))) {
+        OBJ_DESTRUCT(&convertor);
+        return ret;
+    }
+    opal_convertor_get_packed_size(&convertor, &total_size);
+
+    /* Loop over sending fragments to the root */
+
+    bytes = 0;
+    frag_num = 0;
+    do {
+        flag_num = (data->mcb_operation_count %
+                    mca_coll_sm_component.sm_comm_num_in_use_flags);
+
+        /* Wait for the root to mark this set of segments as ours */
+        FLAG_SETUP(flag_num, flag, data);
+        FLAG_WAIT_FOR_OP(flag, data->mcb_operation_count, gatherv_nonroot_flag_label);
+        ++data->mcb_operation_count;
+
+        /* Loop over all the segments in this set */
+
+        segment_num =
+            flag_num * mca_coll_sm_component.sm_segs_per_inuse_flag;
+        max_segment_num =
+            (flag_num + 1) * mca_coll_sm_component.sm_segs_per_inuse_flag;
+        do {
+            if (bytes < total_size) {
+                index = &(data->mcb_data_index[segment_num]);
+
+                /* Copy from the user's buffer to my shared mem
+                   segment */
+                max_data = frag_size;
+                COPY_FRAGMENT_IN(convertor, index, rank, iov, max_data);
+                bytes += max_data;
+
+                /* Wait for the write to absolutely complete */
+                opal_atomic_wmb();
+
+                /* Tell the root that this fragment is ready */
+                PEER_NOTIFY(rank, index, max_data);
+            }
+
+            ++frag_num;
+            ++segment_num;
+        } while (frag_num < num_frags && segment_num < max_segment_num);
+
+        /* We're finished with this set of segments */
+        FLAG_RELEASE(flag);
+    } while (frag_num < num_frags);
+
+    /* Kill the convertor */
+
+    OBJ_DESTRUCT(&convertor);
+
+    /* All done */
+
+    return OMPI_SUCCESS;
+}
+
+
 /*
- *	gatherv_intra
+ *      gatherv
  *
- *	Function:	- basic gatherv operation
- *	Accepts:	- same arguments as MPI_Gatherb()
- *	Returns:	- MPI_SUCCESS or error code
+ *      Function:       - shared memory gatherv
+ *      Accepts:        - same as MPI_Gatherv()
+ *      Returns:        - MPI_SUCCESS or error code
+ *
+ *      Only the root knows the receive counts, so it broadcasts the
+ *      largest of them before the fragments start flowing.
  */
 int mca_coll_sm_gatherv_intra(const void *sbuf, int scount,
                               struct ompi_datatype_t *sdtype,
@@ -38,5 +277,26 @@ int mca_coll_sm_gatherv_intra(const void *sbuf, int scount,
                               struct ompi_communicator_t *comm,
                               mca_coll_base_module_t *module)
 {
-    return OMPI_ERR_NOT_IMPLEMENTED;
+    int i, ret, size;
+    size_t dsize;
+    unsigned long max_bytes = 0;
+
+    if (ompi_comm_rank(comm) == root) {
+        size = ompi_comm_size(comm);
+        ompi_datatype_type_size(rdtype, &dsize);
+        for (i = 0; i < size; ++i) {
+            if (i != root && (size_t) rcounts[i] * dsize > max_bytes) {
+                max_bytes = (size_t) rcounts[i] * dsize;
+            }
+        }
+    }
+    ret = mca_coll_sm_bcast_intra(&max_bytes, 1, MPI_UNSIGNED_LONG, root,
+                                  comm, module);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    return mca_coll_sm_gatherv_frags(sbuf, scount, sdtype, rbuf, rcounts,
+                                     disps, rdtype, root, max_bytes,
+                                     comm, module);
 }
@@ -90,6 +90,10 @@ static void mca_coll_sm_module_construct(mca_coll_sm_module_t *module)
     module->sm_comm_data = NULL;
     module->previous_reduce = NULL;
     module->previous_reduce_module = NULL;
+    module->previous_alltoall = NULL;
+    module->previous_alltoall_module = NULL;
+    module->previous_alltoallv = NULL;
+    module->previous_alltoallv_module = NULL;
     module->super.coll_module_disable = mca_coll_sm_module_disable;
 }
 
@@ -115,6 +119,12 @@ static void mca_coll_sm_module_destruct(mca_coll_sm_module_t *module)
     if (NULL != module->previous_reduce_module) {
         OBJ_RELEASE(module->previous_reduce_module);
     }
+    if (NULL != module->previous_alltoall_module) {
+        OBJ_RELEASE(module->previous_alltoall_module);
+    }
+    if (NULL != module->previous_alltoallv_module) {
+        OBJ_RELEASE(module->previous_alltoallv_module);
+    }
 
     module->enabled = false;
 }
@@ -130,6 +140,16 @@ static int mca_coll_sm_module_disable(mca_coll_base_module_t *module, struct omp
         OBJ_RELEASE(sm_module->previous_reduce_module);
 	sm_module->previous_reduce_module = NULL;
     }
+    if (NULL != sm_module->previous_alltoall_module) {
+	sm_module->previous_alltoall = NULL;
+        OBJ_RELEASE(sm_module->previous_alltoall_module);
+	sm_module->previous_alltoall_module = NULL;
+    }
+    if (NULL != sm_module->previous_alltoallv_module) {
+	sm_module->previous_alltoallv = NULL;
+        OBJ_RELEASE(sm_module->previous_alltoallv_module);
+	sm_module->previous_alltoallv_module = NULL;
+    }
     return OMPI_SUCCESS;
 }
 
@@ -195,22 +215,22 @@ mca_coll_sm_comm_query(struct ompi_communicator_t *comm, int *priority)
 
     /* All is good -- return a module */
     sm_module->super.coll_module_enable = sm_module_enable;
-    sm_module->super.coll_allgather  = NULL;
-    sm_module->super.coll_allgatherv = NULL;
+    sm_module->super.coll_allgather  = mca_coll_sm_allgather_intra;
+    sm_module->super.coll_allgatherv = mca_coll_sm_allgatherv_intra;
     sm_module->super.coll_allreduce  = mca_coll_sm_allreduce_intra;
-    sm_module->super.coll_alltoall   = NULL;
-    sm_module->super.coll_alltoallv  = NULL;
+    sm_module->super.coll_alltoall   = mca_coll_sm_alltoall_intra;
+    sm_module->super.coll_alltoallv  = mca_coll_sm_alltoallv_intra;
     sm_module->super.coll_alltoallw  = NULL;
     sm_module->super.coll_barrier    = mca_coll_sm_barrier_intra;
     sm_module->super.coll_bcast      = mca_coll_sm_bcast_intra;
     sm_module->super.coll_exscan     = NULL;
-    sm_module->super.coll_gather     = NULL;
-    sm_module->super.coll_gatherv    = NULL;
+    sm_module->super.coll_gather     = mca_coll_sm_gather_intra;
+    sm_module->super.coll_gatherv    = mca_coll_sm_gatherv_intra;
     sm_module->super.coll_reduce     = mca_coll_sm_reduce_intra;
     sm_module->super.coll_reduce_scatter = NULL;
     sm_module->super.coll_scan       = NULL;
-    sm_module->super.coll_scatter    = NULL;
-    sm_module->super.coll_scatterv   = NULL;
+    sm_module->super.coll_scatter    = mca_coll_sm_scatter_intra;
+    sm_module->super.coll_scatterv   = mca_coll_sm_scatterv_intra;
 
     opal_output_verbose(10, ompi_coll_base_framework.framework_output,
                         "coll:sm:comm_query (%d/%s): pick me! pick me!",
@@ -225,6 +245,8 @@ mca_coll_sm_comm_query(struct ompi_communicator_t *comm, int *priority)
 static int sm_module_enable(mca_coll_base_module_t *module,
                             struct ompi_communicator_t *comm)
 {
+    mca_coll_sm_module_t *sm_module = (mca_coll_sm_module_t*) module;
+
     if (NULL == comm->c_coll->coll_reduce ||
         NULL == comm->c_coll->coll_reduce_module) {
         opal_output_verbose(10, ompi_coll_base_framework.framework_output,
@@ -233,6 +255,19 @@ static int sm_module_enable(mca_coll_base_module_t *module,
         return OMPI_ERROR;
     }
 
+    /* Save the underlying alltoall and alltoallv now, while they are
+       still the ones of the lower priority components */
+    sm_module->previous_alltoall = comm->c_coll->coll_alltoall;
+    sm_module->previous_alltoall_module = comm->c_coll->coll_alltoall_module;
+    if (NULL != sm_module->previous_alltoall_module) {
+        OBJ_RETAIN(sm_module->previous_alltoall_module);
+    }
+    sm_module->previous_alltoallv = comm->c_coll->coll_alltoallv;
+    sm_module->previous_alltoallv_module = comm->c_coll->coll_alltoallv_module;
+    if (NULL != sm_module->previous_alltoallv_module) {
+        OBJ_RETAIN(sm_module->previous_alltoallv_module);
+    }
+
     /* We do everything lazily in ompi_coll_sm_enable() */
     return OMPI_SUCCESS;
 }
@@ -410,8 +445,12 @@ int ompi_coll_sm_lazy_enable(mca_coll_base_module_t *module,
            root/parent has already set the count to their op number
            (i.e., 0 is the first op count value). */
         for (i = 0; i < mca_coll_sm_component.sm_comm_num_in_use_flags; ++i) {
-            ((mca_coll_sm_in_use_flag_t *)base)[i].mcsiuf_operation_count = 1;
-            ((mca_coll_sm_in_use_flag_t *)base)[i].mcsiuf_num_procs_using = 0;
+            mca_coll_sm_in_use_flag_t *flag;
+            FLAG_SETUP(i, flag, data);
+            flag->mcsiuf_operation_count = 1;
+            flag->mcsiuf_num_procs_using = 0;
+            flag->mcsiuf_num_procs_copied = 0;
+            flag->mcsiuf_num_procs_reduced = 0;
         }
         ++j;
     }
@@ -441,7 +480,7 @@ int ompi_coll_sm_lazy_enable(mca_coll_base_module_t *module,
         maffinity[j].mbs_len = c->sm_fragment_size;
         maffinity[j].mbs_start_addr =
             ((char*) data->mcb_data_index[i].mcbmi_data) +
-            (rank * c->sm_control_size);
+            (rank * c->sm_fragment_size);
         ++j;
     }
 
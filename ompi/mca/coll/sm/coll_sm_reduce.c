@@ -228,7 +228,7 @@ static int reduce_inorder(const void *sbuf, void* rbuf, int count,
         int peer;
         size_t count_left = (size_t)count;
         int frag_num = 0;
-        bool first_operation = true;
+        char *contrib;
 
         /* If the datatype is the same packed as it is unpacked, we
            can save a memory copy and just do the reduction operation
@@ -345,24 +345,17 @@ static int reduce_inorder(const void *sbuf, void* rbuf, int count,
 
                 /* Note that all the other coll modules reduce from
                    process (size-1) to 0, so that's the order we'll do
-                   it here. */
-                /* Process (size-1) is the root (special case) */
+                   it here.  The contribution of process (size-1) is
+                   not copied to the reduce_target first: the first
+                   reduction reads it from where it is (contrib) and
+                   stores the result in the reduce_target, saving one
+                   pass over the fragment. */
+                /* Process (size-1) is the root (special case): its
+                   contribution is in my sbuf (or already in the rbuf
+                   for MPI_IN_PLACE) */
                 if (size - 1 == rank) {
-                    /* If we're the root *and* the first process to be
-                       combined *and* this is the first segment in the
-                       entire algorithm, then just copy the whole sbuf
-                       to rbuf.  That way, we never need to copy from
-                       my sbuf again (i.e., do the copy all at once
-                       since all the data is local, and then don't
-                       worry about it for the rest of the
-                       algorithm) */
-                    if (first_operation) {
-                        first_operation = false;
-                        if (MPI_IN_PLACE != sbuf) {
-                            ompi_datatype_copy_content_same_ddt(dtype, count,
-                                               reduce_target, (char*)sbuf);
-                        }
-                    }
+                    contrib = (MPI_IN_PLACE == sbuf) ? reduce_target :
+                        ((char *) sbuf) + frag_num * extent * segment_ddt_count;
                 }
 
                 /* Process (size-1) is not the root */
@@ -372,11 +365,11 @@ static int reduce_inorder(const void *sbuf, void* rbuf, int count,
                     index = &(data->mcb_data_index[segment_num]);
                     PARENT_WAIT_FOR_NOTIFY_SPECIFIC(size - 1, rank, index, max_data, reduce_root_parent_label1);
 
-                    /* If the datatype is contiguous, just copy it
-                       straight to the reduce_target */
+                    /* If the datatype is contiguous, reduce straight
+                       from the shmem */
                     if (NULL == free_buffer) {
-                        memcpy(reduce_target, ((char*)index->mcbmi_data) +
-                               (size - 1) * mca_coll_sm_component.sm_fragment_size, max_data);
+                        contrib = ((char*)index->mcbmi_data) +
+                            (size - 1) * mca_coll_sm_component.sm_fragment_size;
                     }
                     /* If the datatype is noncontiguous, use the
                        rbuf_convertor to unpack it straight to the
@@ -385,6 +378,7 @@ static int reduce_inorder(const void *sbuf, void* rbuf, int count,
                         max_data = segment_ddt_bytes;
                         COPY_FRAGMENT_OUT(rbuf_convertor, size - 1, index,
                                           iov, max_data);
+                        contrib = reduce_target;
                     }
                 }
 
@@ -401,12 +395,12 @@ static int reduce_inorder(const void *sbuf, void* rbuf, int count,
                        copy into shmem -- just reduce directly from my
                        sbuf. */
                     if (rank == peer) {
-                        ompi_op_reduce(op,
-                                       ((char *) sbuf) +
-                                       frag_num * extent * segment_ddt_count,
-                                       reduce_target,
-                                       min(count_left, segment_ddt_count),
-                                       dtype);
+                        ompi_3buff_op_reduce(op,
+                                             ((char *) sbuf) +
+                                             frag_num * extent * segment_ddt_count,
+                                             contrib, reduce_target,
+                                             min(count_left, segment_ddt_count),
+                                             dtype);
                     }
 
                     /* Now handle the case where the source is not
@@ -422,12 +416,12 @@ static int reduce_inorder(const void *sbuf, void* rbuf, int count,
                            from the shmem. */
 
                         if (NULL == free_buffer) {
-                            ompi_op_reduce(op,
-                                           (index->mcbmi_data +
-                                            (peer * mca_coll_sm_component.sm_fragment_size)),
-                                           reduce_target,
-                                           min(count_left, segment_ddt_count),
-                                           dtype);
+                            ompi_3buff_op_reduce(op,
+                                                 (index->mcbmi_data +
+                                                  (peer * mca_coll_sm_component.sm_fragment_size)),
+                                                 contrib, reduce_target,
+                                                 min(count_left, segment_ddt_count),
+                                                 dtype);
                         }
 
                         /* Otherwise, unpack the fragment to the temporary
@@ -442,14 +436,21 @@ static int reduce_inorder(const void *sbuf, void* rbuf, int count,
                             opal_convertor_set_position(&rtb_convertor, &zero);
 
                             /* Do the reduction on this fragment */
-                            ompi_op_reduce(op, reduce_temp_buffer,
-                                           reduce_target,
-                                           min(count_left, segment_ddt_count),
-                                           dtype);
+                            ompi_3buff_op_reduce(op, reduce_temp_buffer,
+                                                 contrib, reduce_target,
+                                                 min(count_left, segment_ddt_count),
+                                                 dtype);
                         }
                     } /* whether this process was me or not */
+                    contrib = reduce_target;
                 } /* loop over all proceses */
 
+                /* Single process: nothing was reduced */
+                if (contrib != reduce_target) {
+                    ompi_datatype_copy_content_same_ddt(dtype, min(count_left, segment_ddt_count),
+                                                        reduce_target, contrib);
+                }
+
                 /* We've iterated through all the processes -- now we
                    move on to the next segment */
 
@@ -20,16 +20,24 @@
 
 #include "ompi_config.h"
 
+#include <stdlib.h>
+
 #include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/datatype/ompi_datatype.h"
 #include "coll_sm.h"
 
 
 /*
  *      scatter
  *
- *      Function:       - shared memory reduce
+ *      Function:       - shared memory scatter
  *      Accepts:        - same as MPI_Scatter()
  *      Returns:        - MPI_SUCCESS or error code
+ *
+ *      This is the scatterv fragment engine with uniform counts;
+ *      every process already knows the size of each portion, so no
+ *      extra broadcast is needed.
  */
 int mca_coll_sm_scatter_intra(const void *sbuf, int scount,
                               struct ompi_datatype_t *sdtype, void *rbuf,
@@ -37,5 +45,33 @@ int mca_coll_sm_scatter_intra(const void *sbuf, int scount,
                               int root, struct ompi_communicator_t *comm,
                               mca_coll_base_module_t *module)
 {
-    return OMPI_ERR_NOT_IMPLEMENTED;
+    int i, ret, size;
+    int *scounts = NULL, *disps = NULL;
+    size_t dsize;
+
+    if (ompi_comm_rank(comm) == root) {
+        size = ompi_comm_size(comm);
+        scounts = (int*) malloc(2 * size * sizeof(int));
+        if (NULL == scounts) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        disps = scounts + size;
+        for (i = 0; i < size; ++i) {
+            scounts[i] = scount;
+            disps[i] = i * scount;
+        }
+        ompi_datatype_type_size(sdtype, &dsize);
+        dsize *= scount;
+    } else {
+        ompi_datatype_type_size(rdtype, &dsize);
+        dsize *= rcount;
+    }
+
+    ret = mca_coll_sm_scatterv_frags(sbuf, scounts, disps, sdtype, rbuf,
+                                     rcount, rdtype, root, dsize,
+                                     comm, module);
+    if (NULL != scounts) {
+        free(scounts);
+    }
+    return ret;
 }
@@ -20,16 +20,254 @@
 
 #include "ompi_config.h"
 
+#include <stdlib.h>
+
+#include "opal/datatype/opal_convertor.h"
 #include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/mca/coll/coll.h"
+#include "opal/sys/atomic.h"
 #include "coll_sm.h"
 
 
+/**
+ * Shared memory scatterv fragment engine.
+ *
+ * This is a flat fan out: the root claims a set of segments exactly
+ * the same way as the broadcast does.  For each segment in the set,
+ * the root packs the next fragment destined to each peer directly
+ * into that peer's portion of the segment and writes the fragment
+ * size into that peer's control buffer.  Each non-root process waits
+ * on its own control buffer and unpacks from its own portion of the
+ * segment into the user's receive buffer.
+ *
+ * As with gatherv, every process steps through the same number of
+ * fragments (derived from max_bytes) to keep the operation counts in
+ * lock step.
+ */
+int mca_coll_sm_scatterv_frags(const void *sbuf, const int *scounts,
+                               const int *disps, struct ompi_datatype_t *sdtype,
+                               void *rbuf, int rcount,
+                               struct ompi_datatype_t *rdtype, int root,
+                               size_t max_bytes,
+                               struct ompi_communicator_t *comm,
+                               mca_coll_base_module_t *module)
+{
+    struct iovec iov;
+    mca_coll_sm_module_t *sm_module = (mca_coll_sm_module_t*) module;
+    mca_coll_sm_comm_t *data;
+    int ret, rank, size, peer;
+    int flag_num, segment_num, max_segment_num;
+    size_t frag_num, num_frags, total_size, max_data, bytes, frag_size;
+    ptrdiff_t extent, lb;
+    mca_coll_sm_in_use_flag_t *flag;
+    opal_convertor_t convertor, *convertors;
+    mca_coll_sm_data_index_t *index;
+
+    /* Lazily enable the module the first time we invoke a collective
+       on it */
+    if (!sm_module->enabled) {
+        if (OMPI_SUCCESS != (ret = ompi_coll_sm_lazy_enable(module, comm))) {
+            return ret;
+        }
+    }
+    data = sm_module->sm_comm_data;
+
+    /* Setup some identities */
+
+    rank = ompi_comm_rank(comm);
+    size = ompi_comm_size(comm);
+    frag_size = (size_t) mca_coll_sm_component.sm_fragment_size;
+    num_frags = (max_bytes + frag_size - 1) / frag_size;
+
+    /*********************************************************************
+     * Root
+     *********************************************************************/
+
+    if (root == rank) {
+
+        /* My own portion never goes through shared memory */
+
+        ompi_datatype_get_extent(sdtype, &lb, &extent);
+        if (MPI_IN_PLACE != rbuf) {
+            ret = ompi_datatype_sndrcv((char*) sbuf + (ptrdiff_t) disps[rank] * extent,
+                                       scounts[rank], sdtype,
+                                       rbuf, rcount, rdtype);
+            if (MPI_SUCCESS != ret) {
+                return ret;
+            }
+        }
+        if (0 == num_frags) {
+            return OMPI_SUCCESS;
+        }
+
+        /* One send convertor per peer, all prepared up front so that
+           nothing can fail once the other processes are committed to
+           the fragment loop */
+
+        convertors = (opal_convertor_t*)
+            malloc(size * sizeof(opal_convertor_t));
+        if (NULL == convertors) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        for (peer = 0; peer < size; ++peer) {
+            OBJ_CONSTRUCT(&convertors[peer], opal_convertor_t);
+        }
+        for (peer = 0; peer < size; ++peer) {
+            if (root == peer) {
+                continue;
+            }
+            if (OMPI_SUCCESS !=
+                (ret =
+                 opal_convertor_copy_and_prepare_for_send(ompi_mpi_local_convertor,
+                                                          &(sdtype->super),
+                                                          scounts[peer],
+                                                          (char*) sbuf + (ptrdiff_t) disps[peer] * extent,
+                                                          0,
+                                                          &convertors[peer]))) {
+                goto root_cleanup;
+            }
+        }
+
+        /* Main loop over sending fragments */
+
+        frag_num = 0;
+        do {
+            flag_num = (data->mcb_operation_count++ %
+                        mca_coll_sm_component.sm_comm_num_in_use_flags);
+
+            FLAG_SETUP(flag_num, flag, data);
+            FLAG_WAIT_FOR_IDLE(flag, scatterv_root_label);
+            FLAG_RETAIN(flag, size - 1, data->mcb_operation_count - 1);
+
+            /* Loop over all the segments in this set */
+
+            segment_num =
+                flag_num * mca_coll_sm_component.sm_segs_per_inuse_flag;
+            max_segment_num =
+                (flag_num + 1) * mca_coll_sm_component.sm_segs_per_inuse_flag;
+            do {
+                index = &(data->mcb_data_index[segment_num]);
+
+                for (peer = 0; peer < size; ++peer) {
+                    if (root == peer) {
+                        continue;
+                    }
+                    opal_convertor_get_packed_size(&convertors[peer], &total_size);
+                    if (frag_num * frag_size >= total_size) {
+                        continue;
+                    }
+
+                    /* Copy the fragment from the user buffer to the
+                       peer's fragment in the current segment */
+                    max_data = frag_size;
+                    COPY_FRAGMENT_IN(convertors[peer], index, peer, iov, max_data);
+
+                    /* Wait for the write to absolutely complete */
+                    opal_atomic_wmb();
+
+                    /* Tell the peer that this fragment is ready */
+                    PEER_NOTIFY(peer, index, max_data);
+                }
+
+                ++frag_num;
+                ++segment_num;
+            } while (frag_num < num_frags && segment_num < max_segment_num);
+        } while (frag_num < num_frags);
+        ret = OMPI_SUCCESS;
+
+    root_cleanup:
+        for (peer = 0; peer < size; ++peer) {
+            OBJ_DESTRUCT(&convertors[peer]);
+        }
+        free(convertors);
+        return ret;
+    }
+
+    /*********************************************************************
+     * Non-root
+     *********************************************************************/
+
+    if (0 == num_frags) {
+        return OMPI_SUCCESS;
+    }
+
+    OBJ_CONSTRUCT(&convertor, opal_convertor_t);
+    if (OMPI_SUCCESS !=
+        (ret =
+         opal_convertor_copy_and_prepare_for_recv(ompi_mpi_local_convertor,
+                                                  &(rdtype->super),
+                                                  rcount,
+                                                  rbuf,
+                                                  0,
+                                                  &convertor))) {
+        OBJ_DESTRUCT(&convertor);
+        return ret;
+    }
+    opal_convertor_get_packed_size(&convertor, &total_size);
+
+    /* Loop over receiving the fragments */
+
+    bytes = 0;
+    frag_num = 0;
+    do {
+        flag_num = (data->mcb_operation_count %
+                    mca_coll_sm_component.sm_comm_num_in_use_flags);
+
+        /* Wait for the root to mark this set of segments as ours */
+        FLAG_SETUP(flag_num, flag, data);
+        FLAG_WAIT_FOR_OP(flag, data->mcb_operation_count, scatterv_nonroot_label1);
+        ++data->mcb_operation_count;
+
+        /* Loop over all the segments in this set */
+
+        segment_num =
+            flag_num * mca_coll_sm_component.sm_segs_per_inuse_flag;
+        max_segment_num =
+            (flag_num + 1) * mca_coll_sm_component.sm_segs_per_inuse_flag;
+        do {
+            if (bytes < total_size) {
+                index = &(data->mcb_data_index[segment_num]);
+
+                /* Wait for the root to tell me that my fragment is
+                   ready, then copy it to my output buffer */
+                CHILD_WAIT_FOR_NOTIFY(rank, index, max_data, scatterv_nonroot_label2);
+                COPY_FRAGMENT_OUT(convertor, rank, index, iov, max_data);
+                bytes += max_data;
+            }
+
+            ++frag_num;
+            ++segment_num;
+        } while (frag_num < num_frags && segment_num < max_segment_num);
+
+        /* Wait for all copy-out writes to complete before I say I'm
+           done with the segments */
+        opal_atomic_wmb();
+
+        /* We're finished with this set of segments */
+        FLAG_RELEASE(flag);
+    } while (frag_num < num_frags);
+
+    /* Kill the convertor */
+
+    OBJ_DESTRUCT(&convertor);
+
+    /* All done */
+
+    return OMPI_SUCCESS;
+}
+
+
 /*
- *	scatterv_intra
+ *      scatterv
  *
- *	Function:	- scatterv operation
- *	Accepts:	- same arguments as MPI_Scatterv()
- *	Returns:	- MPI_SUCCESS or error code
+ *      Function:       - shared memory scatterv
+ *      Accepts:        - same as MPI_Scatterv()
+ *      Returns:        - MPI_SUCCESS or error code
+ *
+ *      Only the root knows the send counts, so it broadcasts the
+ *      largest of them before the fragments start flowing.
  */
 int mca_coll_sm_scatterv_intra(const void *sbuf, const int *scounts,
                                const int *disps, struct ompi_datatype_t *sdtype,
@@ -38,5 +276,26 @@ int mca_coll_sm_scatterv_intra(const void *sbuf, const int *scounts,
                                struct ompi_communicator_t *comm,
                                mca_coll_base_module_t *module)
 {
-    return OMPI_ERR_NOT_IMPLEMENTED;
+    int i, ret, size;
+    size_t dsize;
+    unsigned long max_bytes = 0;
+
+    if (ompi_comm_rank(comm) == root) {
+        size = ompi_comm_size(comm);
+        ompi_datatype_type_size(sdtype, &dsize);
+        for (i = 0; i < size; ++i) {
+            if (i != root && (size_t) scounts[i] * dsize > max_bytes) {
+                max_bytes = (size_t) scounts[i] * dsize;
+            }
+        }
+    }
+    ret = mca_coll_sm_bcast_intra(&max_bytes, 1, MPI_UNSIGNED_LONG, root,
+                                  comm, module);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    return mca_coll_sm_scatterv_frags(sbuf, scounts, disps, sdtype, rbuf,
+                                      rcount, rdtype, root, max_bytes,
+                                      comm, module);
 }
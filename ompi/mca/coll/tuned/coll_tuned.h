@@ -22,6 +22,8 @@
 #include "ompi/mca/mca.h"
 #include "ompi/request/request.h"
 #include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/runtime/ompi_spc.h"
+#include "opal/mca/base/mca_base_event.h"
 #include "opal/util/output.h"
 
 /* also need the dynamic rule structures */
@@ -29,11 +31,54 @@
 
 BEGIN_C_DECLS
 
+/* Returns the result of the algorithm call of a do_this, accounting its
+ * duration in the SPC histogram of the algorithm */
+#if SPC_ENABLE == 1
+#define COLL_TUNED_ALG_RETURN(coll_id, algorithm, cycles, call)  \
+    do {                                                         \
+        int _ret = (call);                                       \
+        SPC_COLL_HIST_RECORD(coll_id, algorithm, cycles);        \
+        return _ret;                                             \
+    } while (0)
+#else
+#define COLL_TUNED_ALG_RETURN(coll_id, algorithm, cycles, call)  \
+    return (call)
+#endif
+
+/* MPI_T event raised on the communicator by a do_this with the algorithm
+ * it runs, forced or chosen by the fixed or dynamic rules */
+typedef struct ompi_coll_tuned_event_data_t {
+    int collective;
+    int algorithm;
+} ompi_coll_tuned_event_data_t;
+
+extern mca_base_event_t *ompi_coll_tuned_event_algorithm;
+
+static inline void ompi_coll_tuned_event_raise(int coll_id, int algorithm,
+                                               struct ompi_communicator_t *comm)
+{
+    ompi_coll_tuned_event_data_t data;
+
+    /* algorithm 0 goes through the fixed rules, which come back with the
+     * algorithm they chose */
+    if (OPAL_LIKELY(NULL == ompi_coll_tuned_event_algorithm ||
+                    0 == ompi_coll_tuned_event_algorithm->active) || 0 == algorithm) {
+        return;
+    }
+
+    data.collective = coll_id;
+    data.algorithm = algorithm;
+    mca_base_event_record(ompi_coll_tuned_event_algorithm, comm, &data);
+}
+
 /* these are the same across all modules and are loaded at component query time */
 extern int   ompi_coll_tuned_stream;
 extern int   ompi_coll_tuned_priority;
 extern bool  ompi_coll_tuned_use_dynamic_rules;
 extern char* ompi_coll_tuned_dynamic_rules_filename;
+extern bool  ompi_coll_tuned_autotune;
+extern int   ompi_coll_tuned_autotune_iterations;
+extern char* ompi_coll_tuned_autotune_filename;
 extern int   ompi_coll_tuned_init_tree_fanout;
 extern int   ompi_coll_tuned_init_chain_fanout;
 extern int   ompi_coll_tuned_init_max_requests;
@@ -42,10 +87,15 @@ extern int   ompi_coll_tuned_alltoall_intermediate_msg;
 extern int   ompi_coll_tuned_alltoall_large_msg;
 extern int   ompi_coll_tuned_alltoall_min_procs;
 extern int   ompi_coll_tuned_alltoall_max_requests;
+extern int   ompi_coll_tuned_alltoallv_max_requests;
+extern int   ompi_coll_tuned_alltoallv_sparse_min_procs;
+extern int   ompi_coll_tuned_alltoallv_sparse_ratio;
 extern int   ompi_coll_tuned_scatter_intermediate_msg;
 extern int   ompi_coll_tuned_scatter_large_msg;
 extern int   ompi_coll_tuned_scatter_min_procs;
 extern int   ompi_coll_tuned_scatter_blocking_send_ratio;
+extern int   ompi_coll_tuned_gatherv_knomial_min_procs;
+extern int   ompi_coll_tuned_scatterv_knomial_min_procs;
 
 /* forced algorithm choices */
 /* this structure is for storing the indexes to the forced algorithm mca params... */
@@ -146,6 +196,12 @@ int ompi_coll_tuned_gather_intra_dec_dynamic(GATHER_ARGS);
 int ompi_coll_tuned_gather_intra_do_this(GATHER_ARGS, int algorithm, int faninout, int segsize);
 int ompi_coll_tuned_gather_intra_check_forced_init (coll_tuned_force_algorithm_mca_param_indices_t *mca_param_indices);
 
+/* GatherV */
+int ompi_coll_tuned_gatherv_intra_dec_fixed(GATHERV_ARGS);
+int ompi_coll_tuned_gatherv_intra_dec_dynamic(GATHERV_ARGS);
+int ompi_coll_tuned_gatherv_intra_do_this(GATHERV_ARGS, int algorithm);
+int ompi_coll_tuned_gatherv_intra_check_forced_init (coll_tuned_force_algorithm_mca_param_indices_t *mca_param_indices);
+
 /* Reduce */
 int ompi_coll_tuned_reduce_intra_dec_fixed(REDUCE_ARGS);
 int ompi_coll_tuned_reduce_intra_dec_dynamic(REDUCE_ARGS);
@@ -170,16 +226,22 @@ int ompi_coll_tuned_scatter_intra_dec_dynamic(SCATTER_ARGS);
 int ompi_coll_tuned_scatter_intra_do_this(SCATTER_ARGS, int algorithm, int faninout, int segsize);
 int ompi_coll_tuned_scatter_intra_check_forced_init (coll_tuned_force_algorithm_mca_param_indices_t *mca_param_indices);
 
+/* ScatterV */
+int ompi_coll_tuned_scatterv_intra_dec_fixed(SCATTERV_ARGS);
+int ompi_coll_tuned_scatterv_intra_dec_dynamic(SCATTERV_ARGS);
+int ompi_coll_tuned_scatterv_intra_do_this(SCATTERV_ARGS, int algorithm);
+int ompi_coll_tuned_scatterv_intra_check_forced_init (coll_tuned_force_algorithm_mca_param_indices_t *mca_param_indices);
+
 /* Exscan */
 int ompi_coll_tuned_exscan_intra_dec_fixed(EXSCAN_ARGS);
 int ompi_coll_tuned_exscan_intra_dec_dynamic(EXSCAN_ARGS);
-int ompi_coll_tuned_exscan_intra_do_this(EXSCAN_ARGS, int algorithm);
+int ompi_coll_tuned_exscan_intra_do_this(EXSCAN_ARGS, int algorithm, int segsize);
 int ompi_coll_tuned_exscan_intra_check_forced_init (coll_tuned_force_algorithm_mca_param_indices_t *mca_param_indices);
 
 /* Scan */
 int ompi_coll_tuned_scan_intra_dec_fixed(SCAN_ARGS);
 int ompi_coll_tuned_scan_intra_dec_dynamic(SCAN_ARGS);
-int ompi_coll_tuned_scan_intra_do_this(SCAN_ARGS, int algorithm);
+int ompi_coll_tuned_scan_intra_do_this(SCAN_ARGS, int algorithm, int segsize);
 int ompi_coll_tuned_scan_intra_check_forced_init (coll_tuned_force_algorithm_mca_param_indices_t *mca_param_indices);
 
 struct mca_coll_tuned_component_t {
@@ -215,6 +277,14 @@ struct mca_coll_tuned_module_t {
 
     /* the communicator rules for each MPI collective for ONLY my comsize */
     ompi_coll_com_rule_t *com_rules[COLLCOUNT];
+
+    /* memoized lookups in com_rules, per message size bucket (NULL
+       if there are no communicator rules for the collective) */
+    ompi_coll_tuned_decision_t *decisions[COLLCOUNT];
+
+    /* online auto-tuning state, per message size bucket (NULL if the
+       collective is not being tuned) */
+    struct ompi_coll_tuned_autotune_bucket_t *autotune[COLLCOUNT];
 };
 typedef struct mca_coll_tuned_module_t mca_coll_tuned_module_t;
 OBJ_CLASS_DECLARATION(mca_coll_tuned_module_t);
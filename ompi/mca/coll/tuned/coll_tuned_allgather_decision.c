@@ -40,6 +40,7 @@ static const mca_base_var_enum_value_t allgather_algorithms[] = {
     {4, "ring"},
     {5, "neighbor"},
     {6, "two_proc"},
+    {7, "k_bruck"},
     {0, NULL}
 };
 
@@ -78,7 +79,7 @@ ompi_coll_tuned_allgather_intra_check_forced_init(coll_tuned_force_algorithm_mca
     mca_param_indices->algorithm_param_index =
         mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
                                         "allgather_algorithm",
-                                        "Which allgather algorithm is used. Can be locked down to choice of: 0 ignore, 1 basic linear, 2 bruck, 3 recursive doubling, 4 ring, 5 neighbor exchange, 6: two proc only. "
+                                        "Which allgather algorithm is used. Can be locked down to choice of: 0 ignore, 1 basic linear, 2 bruck, 3 recursive doubling, 4 ring, 5 neighbor exchange, 6: two proc only, 7: k-port bruck (radix from the fanout). "
                                         "Only relevant if coll_tuned_use_dynamic_rules is true.",
                                         MCA_BASE_VAR_TYPE_INT, new_enum, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                         OPAL_INFO_LVL_5,
@@ -103,7 +104,7 @@ ompi_coll_tuned_allgather_intra_check_forced_init(coll_tuned_force_algorithm_mca
     mca_param_indices->tree_fanout_param_index =
         mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
                                         "allgather_algorithm_tree_fanout",
-                                        "Fanout for n-tree used for allgather algorithms. Only has meaning if algorithm is forced and supports n-tree topo based operation. Currently, available algorithms do not support n-tree topologies.",
+                                        "Fanout for n-tree used for allgather algorithms. Only has meaning if algorithm is forced and supports n-tree topo based operation. The k-port bruck algorithm uses it as its radix.",
                                         MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                         OPAL_INFO_LVL_5,
                                         MCA_BASE_VAR_SCOPE_ALL,
@@ -130,39 +131,55 @@ int ompi_coll_tuned_allgather_intra_do_this(const void *sbuf, int scount,
                                             mca_coll_base_module_t *module,
                                             int algorithm, int faninout, int segsize)
 {
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
     OPAL_OUTPUT((ompi_coll_tuned_stream,
                  "coll:tuned:allgather_intra_do_this selected algorithm %d topo faninout %d segsize %d",
                  algorithm, faninout, segsize));
 
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(ALLGATHER, algorithm, comm);
     switch (algorithm) {
     case (0):
         return ompi_coll_tuned_allgather_intra_dec_fixed(sbuf, scount, sdtype,
                                                          rbuf, rcount, rdtype,
                                                          comm, module);
     case (1):
-        return ompi_coll_base_allgather_intra_basic_linear(sbuf, scount, sdtype,
-                                                           rbuf, rcount, rdtype,
-                                                           comm, module);
+        COLL_TUNED_ALG_RETURN(ALLGATHER, algorithm, cycles,
+                              ompi_coll_base_allgather_intra_basic_linear(sbuf, scount, sdtype,
+                                                                          rbuf, rcount, rdtype,
+                                                                          comm, module));
     case (2):
-        return ompi_coll_base_allgather_intra_bruck(sbuf, scount, sdtype,
-                                                    rbuf, rcount, rdtype,
-                                                    comm, module);
+        COLL_TUNED_ALG_RETURN(ALLGATHER, algorithm, cycles,
+                              ompi_coll_base_allgather_intra_bruck(sbuf, scount, sdtype,
+                                                                   rbuf, rcount, rdtype,
+                                                                   comm, module));
     case (3):
-        return ompi_coll_base_allgather_intra_recursivedoubling(sbuf, scount, sdtype,
-                                                                rbuf, rcount, rdtype,
-                                                                comm, module);
+        COLL_TUNED_ALG_RETURN(ALLGATHER, algorithm, cycles,
+                              ompi_coll_base_allgather_intra_recursivedoubling(sbuf, scount, sdtype,
+                                                                               rbuf, rcount, rdtype,
+                                                                               comm, module));
     case (4):
-        return ompi_coll_base_allgather_intra_ring(sbuf, scount, sdtype,
-                                                   rbuf, rcount, rdtype,
-                                                   comm, module);
+        COLL_TUNED_ALG_RETURN(ALLGATHER, algorithm, cycles,
+                              ompi_coll_base_allgather_intra_ring(sbuf, scount, sdtype,
+                                                                  rbuf, rcount, rdtype,
+                                                                  comm, module));
     case (5):
-        return ompi_coll_base_allgather_intra_neighborexchange(sbuf, scount, sdtype,
-                                                               rbuf, rcount, rdtype,
-                                                               comm, module);
+        COLL_TUNED_ALG_RETURN(ALLGATHER, algorithm, cycles,
+                              ompi_coll_base_allgather_intra_neighborexchange(sbuf, scount, sdtype,
+                                                                              rbuf, rcount, rdtype,
+                                                                              comm, module));
     case (6):
-        return ompi_coll_base_allgather_intra_two_procs(sbuf, scount, sdtype,
-                                                        rbuf, rcount, rdtype,
-                                                        comm, module);
+        COLL_TUNED_ALG_RETURN(ALLGATHER, algorithm, cycles,
+                              ompi_coll_base_allgather_intra_two_procs(sbuf, scount, sdtype,
+                                                                       rbuf, rcount, rdtype,
+                                                                       comm, module));
+    case (7):
+        COLL_TUNED_ALG_RETURN(ALLGATHER, algorithm, cycles,
+                              ompi_coll_base_allgather_intra_k_bruck(sbuf, scount, sdtype,
+                                                                     rbuf, rcount, rdtype,
+                                                                     comm, module, faninout));
     } /* switch */
     OPAL_OUTPUT((ompi_coll_tuned_stream,
                  "coll:tuned:allgather_intra_do_this attempt to select algorithm %d when only 0-%d is valid?",
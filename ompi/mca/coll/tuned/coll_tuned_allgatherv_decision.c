@@ -131,35 +131,45 @@ int ompi_coll_tuned_allgatherv_intra_do_this(const void *sbuf, int scount,
                                              int algorithm, int faninout,
                                              int segsize)
 {
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
     OPAL_OUTPUT((ompi_coll_tuned_stream,
                  "coll:tuned:allgatherv_intra_do_this selected algorithm %d topo faninout %d segsize %d",
                  algorithm, faninout, segsize));
 
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(ALLGATHERV, algorithm, comm);
     switch (algorithm) {
     case (0):
         return ompi_coll_tuned_allgatherv_intra_dec_fixed(sbuf, scount, sdtype,
                                                           rbuf, rcounts, rdispls, rdtype,
                                                           comm, module);
     case (1):
-        return ompi_coll_base_allgatherv_intra_basic_default(sbuf, scount, sdtype,
-                                                             rbuf, rcounts, rdispls, rdtype,
-                                                             comm, module);
+        COLL_TUNED_ALG_RETURN(ALLGATHERV, algorithm, cycles,
+                              ompi_coll_base_allgatherv_intra_basic_default(sbuf, scount, sdtype,
+                                                                            rbuf, rcounts, rdispls, rdtype,
+                                                                            comm, module));
     case (2):
-        return ompi_coll_base_allgatherv_intra_bruck(sbuf, scount, sdtype,
-                                                     rbuf, rcounts, rdispls, rdtype,
-                                                     comm, module);
+        COLL_TUNED_ALG_RETURN(ALLGATHERV, algorithm, cycles,
+                              ompi_coll_base_allgatherv_intra_bruck(sbuf, scount, sdtype,
+                                                                    rbuf, rcounts, rdispls, rdtype,
+                                                                    comm, module));
     case (3):
-        return ompi_coll_base_allgatherv_intra_ring(sbuf, scount, sdtype,
-                                                    rbuf, rcounts, rdispls, rdtype,
-                                                    comm, module);
+        COLL_TUNED_ALG_RETURN(ALLGATHERV, algorithm, cycles,
+                              ompi_coll_base_allgatherv_intra_ring(sbuf, scount, sdtype,
+                                                                   rbuf, rcounts, rdispls, rdtype,
+                                                                   comm, module));
     case (4):
-        return ompi_coll_base_allgatherv_intra_neighborexchange(sbuf, scount, sdtype,
-                                                                rbuf, rcounts, rdispls, rdtype,
-                                                                comm, module);
+        COLL_TUNED_ALG_RETURN(ALLGATHERV, algorithm, cycles,
+                              ompi_coll_base_allgatherv_intra_neighborexchange(sbuf, scount, sdtype,
+                                                                               rbuf, rcounts, rdispls, rdtype,
+                                                                               comm, module));
     case (5):
-        return ompi_coll_base_allgatherv_intra_two_procs(sbuf, scount, sdtype,
-                                                         rbuf, rcounts, rdispls, rdtype,
-                                                         comm, module);
+        COLL_TUNED_ALG_RETURN(ALLGATHERV, algorithm, cycles,
+                              ompi_coll_base_allgatherv_intra_two_procs(sbuf, scount, sdtype,
+                                                                        rbuf, rcounts, rdispls, rdtype,
+                                                                        comm, module));
     } /* switch */
     OPAL_OUTPUT((ompi_coll_tuned_stream,
                  "coll:tuned:allgatherv_intra_do_this attempt to select algorithm %d when only 0-%d is valid?",
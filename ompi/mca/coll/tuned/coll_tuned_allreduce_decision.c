@@ -32,6 +32,8 @@ static int coll_tuned_allreduce_forced_algorithm = 0;
 static int coll_tuned_allreduce_segment_size = 0;
 static int coll_tuned_allreduce_tree_fanout;
 static int coll_tuned_allreduce_chain_fanout;
+/* radix of the recursive multiplying allreduce (>= 2) */
+static int coll_tuned_allreduce_radix = 4;
 
 /* valid values for coll_tuned_allreduce_forced_algorithm */
 static const mca_base_var_enum_value_t allreduce_algorithms[] = {
@@ -42,6 +44,9 @@ static const mca_base_var_enum_value_t allreduce_algorithms[] = {
     {4, "ring"},
     {5, "segmented_ring"},
     {6, "rabenseifner"},
+    {7, "swing"},
+    {8, "recursive_multiplying"},
+    {9, "reproducible"},
     {0, NULL}
 };
 
@@ -77,7 +82,7 @@ int ompi_coll_tuned_allreduce_intra_check_forced_init (coll_tuned_force_algorith
     mca_param_indices->algorithm_param_index =
         mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
                                         "allreduce_algorithm",
-                                        "Which allreduce algorithm is used. Can be locked down to any of: 0 ignore, 1 basic linear, 2 nonoverlapping (tuned reduce + tuned bcast), 3 recursive doubling, 4 ring, 5 segmented ring. "
+                                        "Which allreduce algorithm is used. Can be locked down to any of: 0 ignore, 1 basic linear, 2 nonoverlapping (tuned reduce + tuned bcast), 3 recursive doubling, 4 ring, 5 segmented ring, 6 rabenseifner, 7 swing, 8 recursive multiplying (k-nomial), 9 reproducible (fixed binary tree over the ranks, also selected by the ompi_comm_coll_reproducible info key). "
                                         "Only relevant if coll_tuned_use_dynamic_rules is true.",
                                         MCA_BASE_VAR_TYPE_INT, new_enum, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                         OPAL_INFO_LVL_5,
@@ -118,6 +123,14 @@ int ompi_coll_tuned_allreduce_intra_check_forced_init (coll_tuned_force_algorith
                                       MCA_BASE_VAR_SCOPE_ALL,
                                       &coll_tuned_allreduce_chain_fanout);
 
+    coll_tuned_allreduce_radix = 4;
+    mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                    "allreduce_algorithm_radix",
+                                    "Radix of the recursive multiplying allreduce algorithm (radix > 1).",
+                                    MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                    OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_ALL,
+                                    &coll_tuned_allreduce_radix);
+
     return (MPI_SUCCESS);
 }
 
@@ -128,24 +141,45 @@ int ompi_coll_tuned_allreduce_intra_do_this(const void *sbuf, void *rbuf, int co
                                             mca_coll_base_module_t *module,
                                             int algorithm, int faninout, int segsize)
 {
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
     OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:allreduce_intra_do_this algorithm %d topo fan in/out %d segsize %d",
                  algorithm, faninout, segsize));
 
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(ALLREDUCE, algorithm, comm);
     switch (algorithm) {
     case (0):
         return ompi_coll_tuned_allreduce_intra_dec_fixed(sbuf, rbuf, count, dtype, op, comm, module);
     case (1):
-        return ompi_coll_base_allreduce_intra_basic_linear(sbuf, rbuf, count, dtype, op, comm, module);
+        COLL_TUNED_ALG_RETURN(ALLREDUCE, algorithm, cycles,
+                              ompi_coll_base_allreduce_intra_basic_linear(sbuf, rbuf, count, dtype, op, comm, module));
     case (2):
-        return ompi_coll_base_allreduce_intra_nonoverlapping(sbuf, rbuf, count, dtype, op, comm, module);
+        COLL_TUNED_ALG_RETURN(ALLREDUCE, algorithm, cycles,
+                              ompi_coll_base_allreduce_intra_nonoverlapping(sbuf, rbuf, count, dtype, op, comm, module));
     case (3):
-        return ompi_coll_base_allreduce_intra_recursivedoubling(sbuf, rbuf, count, dtype, op, comm, module);
+        COLL_TUNED_ALG_RETURN(ALLREDUCE, algorithm, cycles,
+                              ompi_coll_base_allreduce_intra_recursivedoubling(sbuf, rbuf, count, dtype, op, comm, module));
     case (4):
-        return ompi_coll_base_allreduce_intra_ring(sbuf, rbuf, count, dtype, op, comm, module);
+        COLL_TUNED_ALG_RETURN(ALLREDUCE, algorithm, cycles,
+                              ompi_coll_base_allreduce_intra_ring(sbuf, rbuf, count, dtype, op, comm, module));
     case (5):
-        return ompi_coll_base_allreduce_intra_ring_segmented(sbuf, rbuf, count, dtype, op, comm, module, segsize);
+        COLL_TUNED_ALG_RETURN(ALLREDUCE, algorithm, cycles,
+                              ompi_coll_base_allreduce_intra_ring_segmented(sbuf, rbuf, count, dtype, op, comm, module, segsize));
     case (6):
-        return ompi_coll_base_allreduce_intra_redscat_allgather(sbuf, rbuf, count, dtype, op, comm, module);
+        COLL_TUNED_ALG_RETURN(ALLREDUCE, algorithm, cycles,
+                              ompi_coll_base_allreduce_intra_redscat_allgather(sbuf, rbuf, count, dtype, op, comm, module));
+    case (7):
+        COLL_TUNED_ALG_RETURN(ALLREDUCE, algorithm, cycles,
+                              ompi_coll_base_allreduce_intra_swing(sbuf, rbuf, count, dtype, op, comm, module));
+    case (8):
+        COLL_TUNED_ALG_RETURN(ALLREDUCE, algorithm, cycles,
+                              ompi_coll_base_allreduce_intra_recursive_multiplying(sbuf, rbuf, count, dtype, op, comm, module,
+                                                                                   coll_tuned_allreduce_radix));
+    case (9):
+        COLL_TUNED_ALG_RETURN(ALLREDUCE, algorithm, cycles,
+                              ompi_coll_base_allreduce_intra_reproducible(sbuf, rbuf, count, dtype, op, comm, module));
     } /* switch */
     OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:allreduce_intra_do_this attempt to select algorithm %d when only 0-%d is valid?",
                  algorithm, ompi_coll_tuned_forced_max_algorithms[ALLREDUCE]));
@@ -162,22 +162,32 @@ int ompi_coll_tuned_alltoall_intra_do_this(const void *sbuf, int scount,
                                            int algorithm, int faninout, int segsize,
                                            int max_requests)
 {
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
     OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:alltoall_intra_do_this selected algorithm %d topo faninout %d segsize %d",
                  algorithm, faninout, segsize));
 
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(ALLTOALL, algorithm, comm);
     switch (algorithm) {
     case (0):
         return ompi_coll_tuned_alltoall_intra_dec_fixed(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module);
     case (1):
-        return ompi_coll_base_alltoall_intra_basic_linear(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module);
+        COLL_TUNED_ALG_RETURN(ALLTOALL, algorithm, cycles,
+                              ompi_coll_base_alltoall_intra_basic_linear(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module));
     case (2):
-        return ompi_coll_base_alltoall_intra_pairwise(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module);
+        COLL_TUNED_ALG_RETURN(ALLTOALL, algorithm, cycles,
+                              ompi_coll_base_alltoall_intra_pairwise(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module));
     case (3):
-        return ompi_coll_base_alltoall_intra_bruck(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module);
+        COLL_TUNED_ALG_RETURN(ALLTOALL, algorithm, cycles,
+                              ompi_coll_base_alltoall_intra_bruck(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module));
     case (4):
-        return ompi_coll_base_alltoall_intra_linear_sync(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module, max_requests);
+        COLL_TUNED_ALG_RETURN(ALLTOALL, algorithm, cycles,
+                              ompi_coll_base_alltoall_intra_linear_sync(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module, max_requests));
     case (5):
-        return ompi_coll_base_alltoall_intra_two_procs(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module);
+        COLL_TUNED_ALG_RETURN(ALLTOALL, algorithm, cycles,
+                              ompi_coll_base_alltoall_intra_two_procs(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, module));
     } /* switch */
     OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:alltoall_intra_do_this attempt to select algorithm %d when only 0-%d is valid?",
                  algorithm, ompi_coll_tuned_forced_max_algorithms[ALLTOALL]));
@@ -33,6 +33,7 @@ static const mca_base_var_enum_value_t alltoallv_algorithms[] = {
     {0, "ignore"},
     {1, "basic_linear"},
     {2, "pairwise"},
+    {3, "sparse"},
     {0, NULL}
 };
 
@@ -71,7 +72,7 @@ int ompi_coll_tuned_alltoallv_intra_check_forced_init(coll_tuned_force_algorithm
                                         "alltoallv_algorithm",
                                         "Which alltoallv algorithm is used. "
                                         "Can be locked down to choice of: 0 ignore, "
-                                        "1 basic linear, 2 pairwise. "
+                                        "1 basic linear, 2 pairwise, 3 sparse. "
                                         "Only relevant if coll_tuned_use_dynamic_rules is true.",
                                         MCA_BASE_VAR_TYPE_INT, new_enum, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                         OPAL_INFO_LVL_5,
@@ -83,6 +84,40 @@ int ompi_coll_tuned_alltoallv_intra_check_forced_init(coll_tuned_force_algorithm
         return mca_param_indices->algorithm_param_index;
     }
 
+    mca_param_indices->max_requests_param_index =
+      mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                      "alltoallv_algorithm_max_requests",
+                                      "Maximum number of outstanding send requests of the sparse alltoallv algorithm (0 for no limit).",
+                                      MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                      OPAL_INFO_LVL_5,
+                                      MCA_BASE_VAR_SCOPE_ALL,
+                                      &ompi_coll_tuned_alltoallv_max_requests);
+    if (mca_param_indices->max_requests_param_index < 0) {
+        return mca_param_indices->max_requests_param_index;
+    }
+
+    if (ompi_coll_tuned_alltoallv_max_requests < 0) {
+        ompi_coll_tuned_alltoallv_max_requests = 0;
+    }
+
+    (void) mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                           "alltoallv_sparse_min_procs",
+                                           "Consider the sparse alltoallv algorithm for communicators of at least this size. "
+                                           "Costs an allreduce of one integer per call to agree on the choice (0 to disable).",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_coll_tuned_alltoallv_sparse_min_procs);
+
+    (void) mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                           "alltoallv_sparse_ratio",
+                                           "Use the sparse alltoallv algorithm when at least this percentage of the blocks "
+                                           "of every process is empty",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_coll_tuned_alltoallv_sparse_ratio);
+
     return (MPI_SUCCESS);
 }
 
@@ -96,23 +131,36 @@ int ompi_coll_tuned_alltoallv_intra_do_this(const void *sbuf, const int *scounts
                                             mca_coll_base_module_t *module,
                                             int algorithm)
 {
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
     OPAL_OUTPUT((ompi_coll_tuned_stream,
                  "coll:tuned:alltoallv_intra_do_this selected algorithm %d ",
                  algorithm));
 
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(ALLTOALLV, algorithm, comm);
     switch (algorithm) {
     case (0):
         return ompi_coll_tuned_alltoallv_intra_dec_fixed(sbuf, scounts, sdisps, sdtype,
                                                          rbuf, rcounts, rdisps, rdtype,
                                                          comm, module);
     case (1):
-        return ompi_coll_base_alltoallv_intra_basic_linear(sbuf, scounts, sdisps, sdtype,
-                                                           rbuf, rcounts, rdisps, rdtype,
-                                                           comm, module);
+        COLL_TUNED_ALG_RETURN(ALLTOALLV, algorithm, cycles,
+                              ompi_coll_base_alltoallv_intra_basic_linear(sbuf, scounts, sdisps, sdtype,
+                                                                          rbuf, rcounts, rdisps, rdtype,
+                                                                          comm, module));
     case (2):
-        return ompi_coll_base_alltoallv_intra_pairwise(sbuf, scounts, sdisps, sdtype,
-                                                       rbuf, rcounts, rdisps, rdtype,
-                                                       comm, module);
+        COLL_TUNED_ALG_RETURN(ALLTOALLV, algorithm, cycles,
+                              ompi_coll_base_alltoallv_intra_pairwise(sbuf, scounts, sdisps, sdtype,
+                                                                      rbuf, rcounts, rdisps, rdtype,
+                                                                      comm, module));
+    case (3):
+        COLL_TUNED_ALG_RETURN(ALLTOALLV, algorithm, cycles,
+                              ompi_coll_base_alltoallv_intra_sparse(sbuf, scounts, sdisps, sdtype,
+                                                                    rbuf, rcounts, rdisps, rdtype,
+                                                                    comm, module,
+                                                                    ompi_coll_tuned_alltoallv_max_requests));
     }  /* switch */
     OPAL_OUTPUT((ompi_coll_tuned_stream,
                  "coll:tuned:alltoall_intra_do_this attempt to select "
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "mpi.h"
+#include "opal/mca/threads/mutex.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/runtime/ompi_rte.h"
+#include "coll_tuned.h"
+#include "coll_tuned_autotune.h"
+
+/* the winners found so far, for all communicators */
+typedef struct coll_tuned_autotune_result_t {
+    int coll_id;
+    int comsize;
+    int bucket;
+    int alg;
+    int faninout;
+    int segsize;
+} coll_tuned_autotune_result_t;
+
+static coll_tuned_autotune_result_t *autotune_results = NULL;
+static int autotune_num_results = 0;
+static int autotune_max_results = 0;
+static opal_mutex_t autotune_lock = OPAL_MUTEX_STATIC_INIT;
+
+bool ompi_coll_tuned_autotune_supported (int coll_id)
+{
+    if (!ompi_coll_tuned_autotune) {
+        return false;
+    }
+    switch (coll_id) {
+    case ALLGATHER:
+    case ALLREDUCE:
+    case ALLTOALL:
+    case BARRIER:
+    case BCAST:
+    case REDUCE:
+        /* at least two real algorithms besides "ignore" */
+        return ompi_coll_tuned_forced_max_algorithms[coll_id] > 2;
+    default:
+        return false;
+    }
+}
+
+/* the fanout the dec_dynamic functions pass along with a candidate
+   (the same the forced algorithms use) */
+static int autotune_faninout (mca_coll_tuned_module_t *tuned_module, int coll_id)
+{
+    if (BCAST == coll_id || REDUCE == coll_id) {
+        return tuned_module->user_forced[coll_id].chain_fanout;
+    }
+    return tuned_module->user_forced[coll_id].tree_fanout;
+}
+
+static size_t autotune_bucket_lower_bound (int bucket)
+{
+    return (0 == bucket) ? 0 : ((size_t) 1) << (bucket - 1);
+}
+
+ompi_coll_tuned_autotune_bucket_t *
+ompi_coll_tuned_autotune_get_bucket (mca_coll_tuned_module_t *tuned_module,
+                                     int coll_id, size_t dsize)
+{
+    ompi_coll_tuned_autotune_bucket_t *bucket;
+
+    bucket = &tuned_module->autotune[coll_id][ompi_coll_tuned_size_bucket(dsize)];
+    if (!bucket->done && NULL == bucket->times) {
+        bucket->times = (double*) calloc(ompi_coll_tuned_forced_max_algorithms[coll_id],
+                                         sizeof(double));
+        if (NULL == bucket->times) {
+            /* cannot tune, stick with the fixed decision */
+            bucket->alg = 0;
+            bucket->done = true;
+            return bucket;
+        }
+        bucket->alg = 1;
+        bucket->iter = 0;
+    }
+    return bucket;
+}
+
+static void autotune_save_result (int coll_id, int comsize, int bucket,
+                                  int alg, int faninout, int segsize)
+{
+    coll_tuned_autotune_result_t *res;
+
+    OPAL_THREAD_LOCK(&autotune_lock);
+    if (autotune_num_results == autotune_max_results) {
+        int max = (0 == autotune_max_results) ? 16 : 2 * autotune_max_results;
+        res = (coll_tuned_autotune_result_t*) realloc(autotune_results, max * sizeof(*res));
+        if (NULL == res) {
+            OPAL_THREAD_UNLOCK(&autotune_lock);
+            return;
+        }
+        autotune_results = res;
+        autotune_max_results = max;
+    }
+    res = &autotune_results[autotune_num_results++];
+    res->coll_id = coll_id;
+    res->comsize = comsize;
+    res->bucket = bucket;
+    res->alg = alg;
+    res->faninout = faninout;
+    res->segsize = segsize;
+    OPAL_THREAD_UNLOCK(&autotune_lock);
+}
+
+void ompi_coll_tuned_autotune_record (mca_coll_tuned_module_t *tuned_module,
+                                      int coll_id,
+                                      ompi_coll_tuned_autotune_bucket_t *bucket,
+                                      double elapsed,
+                                      struct ompi_communicator_t *comm)
+{
+    int alg, best, nalgs = ompi_coll_tuned_forced_max_algorithms[coll_id];
+
+    /* the first invocation of each candidate is a warm-up */
+    if (0 < bucket->iter) {
+        bucket->times[bucket->alg] += elapsed;
+    }
+    if (++bucket->iter <= ompi_coll_tuned_autotune_iterations) {
+        return;
+    }
+    bucket->iter = 0;
+    if (++bucket->alg < nalgs) {
+        return;
+    }
+
+    /* Every candidate has been timed: a collective is only as fast as
+       its slowest process, so agree on the max time of each */
+    best = 0;
+    if (MPI_SUCCESS ==
+        ompi_coll_base_allreduce_intra_recursivedoubling(MPI_IN_PLACE, bucket->times + 1,
+                                                         nalgs - 1, MPI_DOUBLE, MPI_MAX,
+                                                         comm, &tuned_module->super)) {
+        best = 1;
+        for (alg = 2; alg < nalgs; alg++) {
+            if (bucket->times[alg] < bucket->times[best]) {
+                best = alg;
+            }
+        }
+    }
+    free(bucket->times);
+    bucket->times = NULL;
+    bucket->alg = best;
+    bucket->done = true;
+
+    OPAL_OUTPUT((ompi_coll_tuned_stream,
+                 "coll:tuned:autotune collective %d comm size %d bucket %d (from %lu bytes): algorithm %d",
+                 coll_id, ompi_comm_size(comm), (int) (bucket - tuned_module->autotune[coll_id]),
+                 (unsigned long) autotune_bucket_lower_bound((int) (bucket - tuned_module->autotune[coll_id])),
+                 best));
+    if (0 != best) {
+        autotune_save_result(coll_id, ompi_comm_size(comm),
+                             (int) (bucket - tuned_module->autotune[coll_id]), best,
+                             autotune_faninout(tuned_module, coll_id),
+                             tuned_module->user_forced[coll_id].segsize);
+    }
+}
+
+void ompi_coll_tuned_autotune_module_fini (mca_coll_tuned_module_t *tuned_module)
+{
+    for (int i = 0; i < COLLCOUNT; i++) {
+        if (NULL == tuned_module->autotune[i]) {
+            continue;
+        }
+        for (int b = 0; b < COLL_TUNED_AUTOTUNE_BUCKETS; b++) {
+            free(tuned_module->autotune[i][b].times);
+        }
+        free(tuned_module->autotune[i]);
+        tuned_module->autotune[i] = NULL;
+    }
+}
+
+static int autotune_result_cmp (const void *a, const void *b)
+{
+    const coll_tuned_autotune_result_t *ra = (const coll_tuned_autotune_result_t*) a;
+    const coll_tuned_autotune_result_t *rb = (const coll_tuned_autotune_result_t*) b;
+
+    if (ra->coll_id != rb->coll_id) return ra->coll_id - rb->coll_id;
+    if (ra->comsize != rb->comsize) return ra->comsize - rb->comsize;
+    return ra->bucket - rb->bucket;
+}
+
+/*
+ * Write the results in the format read by
+ * ompi_coll_tuned_read_rules_config_file().  Several communicators of
+ * the same size may have tuned the same bucket; the first one wins.
+ * The reader insists on a rule for message size 0 first, so the
+ * smallest tuned bucket of each communicator size is extended down
+ * to 0.
+ */
+int ompi_coll_tuned_autotune_write_rules_file (const char *fname)
+{
+    FILE *fptr;
+    int i, j, k, n, ncolls, ncoms, nmsgs;
+
+    OPAL_THREAD_LOCK(&autotune_lock);
+
+    /* sort and drop duplicates */
+    qsort(autotune_results, autotune_num_results, sizeof(*autotune_results),
+          autotune_result_cmp);
+    for (i = 0, n = 0; i < autotune_num_results; i++) {
+        if (n > 0 && 0 == autotune_result_cmp(&autotune_results[n - 1], &autotune_results[i])) {
+            continue;
+        }
+        autotune_results[n++] = autotune_results[i];
+    }
+    autotune_num_results = n;
+
+    if (0 == n) {
+        OPAL_THREAD_UNLOCK(&autotune_lock);
+        return OMPI_SUCCESS;
+    }
+
+    fptr = fopen(fname, "w");
+    if (NULL == fptr) {
+        OPAL_THREAD_UNLOCK(&autotune_lock);
+        opal_output(0, "coll:tuned:autotune cannot write rules file [%s]", fname);
+        return OMPI_ERROR;
+    }
+
+    for (i = 0, ncolls = 0; i < n; i++) {
+        if (0 == i || autotune_results[i].coll_id != autotune_results[i - 1].coll_id) {
+            ncolls++;
+        }
+    }
+    fprintf(fptr, "# Open MPI tuned collectives rules, generated by coll_tuned_autotune\n");
+    fprintf(fptr, "%d # number of collectives\n", ncolls);
+
+    for (i = 0; i < n; i = j) {
+        /* all the results of this collective are in [i, j) */
+        for (j = i, ncoms = 0; j < n && autotune_results[j].coll_id == autotune_results[i].coll_id; j++) {
+            if (j == i || autotune_results[j].comsize != autotune_results[j - 1].comsize) {
+                ncoms++;
+            }
+        }
+        fprintf(fptr, "%d # collective ID\n", autotune_results[i].coll_id);
+        fprintf(fptr, "%d # number of com sizes\n", ncoms);
+
+        for (k = i; k < j; k += nmsgs) {
+            for (nmsgs = 0; k + nmsgs < j && autotune_results[k + nmsgs].comsize == autotune_results[k].comsize; nmsgs++);
+            fprintf(fptr, "%d # comm size\n", autotune_results[k].comsize);
+            fprintf(fptr, "%d # number of msg sizes\n", nmsgs);
+            for (int m = k; m < k + nmsgs; m++) {
+                fprintf(fptr, "%lu %d %d %d # message size, algorithm, topo faninout, segment size\n",
+                        (m == k) ? 0UL : (unsigned long) autotune_bucket_lower_bound(autotune_results[m].bucket),
+                        autotune_results[m].alg, autotune_results[m].faninout,
+                        autotune_results[m].segsize);
+            }
+        }
+    }
+    fprintf(fptr, "# end of rules\n");
+    fclose(fptr);
+
+    OPAL_THREAD_UNLOCK(&autotune_lock);
+    return OMPI_SUCCESS;
+}
+
+int ompi_coll_tuned_autotune_finalize (void)
+{
+    int rc = OMPI_SUCCESS;
+
+    /* every process found the same winners, only one writes them */
+    if (NULL != ompi_coll_tuned_autotune_filename && 0 == OMPI_PROC_MY_NAME->vpid) {
+        rc = ompi_coll_tuned_autotune_write_rules_file(ompi_coll_tuned_autotune_filename);
+    }
+
+    free(autotune_results);
+    autotune_results = NULL;
+    autotune_num_results = autotune_max_results = 0;
+    return rc;
+}
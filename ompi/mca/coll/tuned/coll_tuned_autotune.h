@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_COLL_TUNED_AUTOTUNE_H_HAS_BEEN_INCLUDED
+#define MCA_COLL_TUNED_AUTOTUNE_H_HAS_BEEN_INCLUDED
+
+#include "ompi_config.h"
+
+#include "coll_tuned.h"
+
+BEGIN_C_DECLS
+
+/*
+ * Online auto-tuning.
+ *
+ * For each (collective, message size bucket) of a communicator, the
+ * first invocations go through every algorithm of the collective in
+ * turn, coll_tuned_autotune_iterations times each (plus one untimed
+ * warm-up call).  Once all the candidates have been timed, the
+ * processes agree on the slowest process' time for each of them with
+ * an allreduce, and the fastest algorithm is used from then on.  The
+ * sequence of candidates only depends on the arguments of the
+ * collective, so all the processes always run the same algorithm.
+ *
+ * The message size buckets are powers of two: bucket 0 holds empty
+ * messages and bucket b holds sizes in [2^(b-1), 2^b).
+ */
+
+#define COLL_TUNED_AUTOTUNE_BUCKETS COLL_TUNED_DECISION_BUCKETS
+
+typedef struct ompi_coll_tuned_autotune_bucket_t {
+    int alg;        /* algorithm being timed, or the winner once done */
+    int iter;       /* number of invocations of the current candidate */
+    bool done;      /* the winner is known */
+    double *times;  /* accumulated time per algorithm (index 0 unused) */
+} ompi_coll_tuned_autotune_bucket_t;
+
+/* is auto-tuning enabled (and supported) for this collective */
+bool ompi_coll_tuned_autotune_supported (int coll_id);
+
+/* find (and lazily initialize) the bucket for a message size */
+ompi_coll_tuned_autotune_bucket_t *
+ompi_coll_tuned_autotune_get_bucket (mca_coll_tuned_module_t *tuned_module,
+                                     int coll_id, size_t dsize);
+
+/* account an invocation of the current candidate, and pick the
+   winner once every candidate has been timed (collective over comm) */
+void ompi_coll_tuned_autotune_record (mca_coll_tuned_module_t *tuned_module,
+                                      int coll_id,
+                                      ompi_coll_tuned_autotune_bucket_t *bucket,
+                                      double elapsed,
+                                      struct ompi_communicator_t *comm);
+
+/* release the per module tuning state */
+void ompi_coll_tuned_autotune_module_fini (mca_coll_tuned_module_t *tuned_module);
+
+/* write the winners found so far in the dynamic rules file format */
+int ompi_coll_tuned_autotune_write_rules_file (const char *fname);
+
+/* write coll_tuned_autotune_filename (if any) and release the results,
+   called when the component is closed */
+int ompi_coll_tuned_autotune_finalize (void);
+
+END_C_DECLS
+#endif /* MCA_COLL_TUNED_AUTOTUNE_H_HAS_BEEN_INCLUDED */
@@ -90,18 +90,35 @@ int ompi_coll_tuned_barrier_intra_do_this (struct ompi_communicator_t *comm,
                                            mca_coll_base_module_t *module,
                                            int algorithm, int faninout, int segsize)
 {
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
     OPAL_OUTPUT((ompi_coll_tuned_stream,
                  "coll:tuned:barrier_intra_do_this selected algorithm %d topo fanin/out%d",
                  algorithm, faninout));
 
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(BARRIER, algorithm, comm);
     switch (algorithm) {
     case (0):   return ompi_coll_tuned_barrier_intra_dec_fixed(comm, module);
-    case (1):   return ompi_coll_base_barrier_intra_basic_linear(comm, module);
-    case (2):   return ompi_coll_base_barrier_intra_doublering(comm, module);
-    case (3):   return ompi_coll_base_barrier_intra_recursivedoubling(comm, module);
-    case (4):   return ompi_coll_base_barrier_intra_bruck(comm, module);
-    case (5):   return ompi_coll_base_barrier_intra_two_procs(comm, module);
-    case (6):   return ompi_coll_base_barrier_intra_tree(comm, module);
+    case (1):
+        COLL_TUNED_ALG_RETURN(BARRIER, algorithm, cycles,
+                              ompi_coll_base_barrier_intra_basic_linear(comm, module));
+    case (2):
+        COLL_TUNED_ALG_RETURN(BARRIER, algorithm, cycles,
+                              ompi_coll_base_barrier_intra_doublering(comm, module));
+    case (3):
+        COLL_TUNED_ALG_RETURN(BARRIER, algorithm, cycles,
+                              ompi_coll_base_barrier_intra_recursivedoubling(comm, module));
+    case (4):
+        COLL_TUNED_ALG_RETURN(BARRIER, algorithm, cycles,
+                              ompi_coll_base_barrier_intra_bruck(comm, module));
+    case (5):
+        COLL_TUNED_ALG_RETURN(BARRIER, algorithm, cycles,
+                              ompi_coll_base_barrier_intra_two_procs(comm, module));
+    case (6):
+        COLL_TUNED_ALG_RETURN(BARRIER, algorithm, cycles,
+                              ompi_coll_base_barrier_intra_tree(comm, module));
     } /* switch */
     OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:barrier_intra_do_this attempt to select algorithm %d when only 0-%d is valid?",
                  algorithm, ompi_coll_tuned_forced_max_algorithms[BARRIER]));
@@ -139,31 +139,45 @@ int ompi_coll_tuned_bcast_intra_do_this(void *buf, int count,
                                         mca_coll_base_module_t *module,
                                         int algorithm, int faninout, int segsize)
 {
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
     OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:bcast_intra_do_this algorithm %d topo faninout %d segsize %d",
                  algorithm, faninout, segsize));
 
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(BCAST, algorithm, comm);
     switch (algorithm) {
     case (0):
         return ompi_coll_tuned_bcast_intra_dec_fixed( buf, count, dtype, root, comm, module );
     case (1):
-        return ompi_coll_base_bcast_intra_basic_linear( buf, count, dtype, root, comm, module );
+        COLL_TUNED_ALG_RETURN(BCAST, algorithm, cycles,
+                              ompi_coll_base_bcast_intra_basic_linear( buf, count, dtype, root, comm, module ));
     case (2):
-        return ompi_coll_base_bcast_intra_chain( buf, count, dtype, root, comm, module, segsize, faninout );
+        COLL_TUNED_ALG_RETURN(BCAST, algorithm, cycles,
+                              ompi_coll_base_bcast_intra_chain( buf, count, dtype, root, comm, module, segsize, faninout ));
     case (3):
-        return ompi_coll_base_bcast_intra_pipeline( buf, count, dtype, root, comm, module, segsize );
+        COLL_TUNED_ALG_RETURN(BCAST, algorithm, cycles,
+                              ompi_coll_base_bcast_intra_pipeline( buf, count, dtype, root, comm, module, segsize ));
     case (4):
-        return ompi_coll_base_bcast_intra_split_bintree( buf, count, dtype, root, comm, module, segsize );
+        COLL_TUNED_ALG_RETURN(BCAST, algorithm, cycles,
+                              ompi_coll_base_bcast_intra_split_bintree( buf, count, dtype, root, comm, module, segsize ));
     case (5):
-        return ompi_coll_base_bcast_intra_bintree( buf, count, dtype, root, comm, module, segsize );
+        COLL_TUNED_ALG_RETURN(BCAST, algorithm, cycles,
+                              ompi_coll_base_bcast_intra_bintree( buf, count, dtype, root, comm, module, segsize ));
     case (6):
-        return ompi_coll_base_bcast_intra_binomial( buf, count, dtype, root, comm, module, segsize );
+        COLL_TUNED_ALG_RETURN(BCAST, algorithm, cycles,
+                              ompi_coll_base_bcast_intra_binomial( buf, count, dtype, root, comm, module, segsize ));
     case (7):
-        return ompi_coll_base_bcast_intra_knomial(buf, count, dtype, root, comm, module,
-                                                  segsize, coll_tuned_bcast_knomial_radix);
+        COLL_TUNED_ALG_RETURN(BCAST, algorithm, cycles,
+                              ompi_coll_base_bcast_intra_knomial(buf, count, dtype, root, comm, module,
+                                                                 segsize, coll_tuned_bcast_knomial_radix));
     case (8):
-        return ompi_coll_base_bcast_intra_scatter_allgather(buf, count, dtype, root, comm, module, segsize);
+        COLL_TUNED_ALG_RETURN(BCAST, algorithm, cycles,
+                              ompi_coll_base_bcast_intra_scatter_allgather(buf, count, dtype, root, comm, module, segsize));
     case (9):
-        return ompi_coll_base_bcast_intra_scatter_allgather_ring(buf, count, dtype, root, comm, module, segsize);
+        COLL_TUNED_ALG_RETURN(BCAST, algorithm, cycles,
+                              ompi_coll_base_bcast_intra_scatter_allgather_ring(buf, count, dtype, root, comm, module, segsize));
     } /* switch */
     OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:bcast_intra_do_this attempt to select algorithm %d when only 0-%d is valid?",
                  algorithm, ompi_coll_tuned_forced_max_algorithms[BCAST]));
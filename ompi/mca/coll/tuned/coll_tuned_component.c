@@ -34,10 +34,14 @@
 #include "opal/util/output.h"
 #include "coll_tuned.h"
 
+#include <stdlib.h>
+
 #include "mpi.h"
 #include "ompi/mca/coll/coll.h"
 #include "coll_tuned.h"
 #include "coll_tuned_dynamic_file.h"
+#include "coll_tuned_autotune.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
 
 /*
  * Public string showing the coll ompi_tuned component version number
@@ -52,9 +56,13 @@ int   ompi_coll_tuned_stream = -1;
 int   ompi_coll_tuned_priority = 30;
 bool  ompi_coll_tuned_use_dynamic_rules = false;
 char* ompi_coll_tuned_dynamic_rules_filename = (char*) NULL;
+bool  ompi_coll_tuned_autotune = false;
+int   ompi_coll_tuned_autotune_iterations = 5;
+char* ompi_coll_tuned_autotune_filename = (char*) NULL;
 int   ompi_coll_tuned_init_tree_fanout = 4;
 int   ompi_coll_tuned_init_chain_fanout = 4;
 int   ompi_coll_tuned_init_max_requests = 128;
+mca_base_event_t *ompi_coll_tuned_event_algorithm = NULL;
 int   ompi_coll_tuned_alltoall_small_msg = 200;
 int   ompi_coll_tuned_alltoall_intermediate_msg = 3000;
 
@@ -64,6 +72,9 @@ int   ompi_coll_tuned_alltoall_intermediate_msg = 3000;
 int   ompi_coll_tuned_alltoall_large_msg = 3000;
 int   ompi_coll_tuned_alltoall_min_procs = 0; /* disable by default */
 int   ompi_coll_tuned_alltoall_max_requests  = 0; /* no limit for alltoall by default */
+int   ompi_coll_tuned_alltoallv_max_requests = 32;
+int   ompi_coll_tuned_alltoallv_sparse_min_procs = 64;
+int   ompi_coll_tuned_alltoallv_sparse_ratio = 75; /* percent of empty blocks */
 
 /* Disable by default */
 int   ompi_coll_tuned_scatter_intermediate_msg = 0;
@@ -71,6 +82,10 @@ int   ompi_coll_tuned_scatter_large_msg = 0;
 int   ompi_coll_tuned_scatter_min_procs = 0;
 int   ompi_coll_tuned_scatter_blocking_send_ratio = 0;
 
+/* root incast/outcast relief for the v variants on large communicators */
+int   ompi_coll_tuned_gatherv_knomial_min_procs = 1024;
+int   ompi_coll_tuned_scatterv_knomial_min_procs = 1024;
+
 /* forced alogrithm variables */
 /* indices for the MCA parameters */
 coll_tuned_force_algorithm_mca_param_indices_t ompi_coll_tuned_forced_params[COLLCOUNT] = {{0}};
@@ -125,6 +140,37 @@ mca_coll_tuned_component_t mca_coll_tuned_component = {
     NULL /* ompi_coll_alg_rule_t ptr */
 };
 
+static void tuned_event_register(void)
+{
+    static const mca_base_var_type_t types[] = {MCA_BASE_VAR_TYPE_INT, MCA_BASE_VAR_TYPE_INT};
+    static const size_t offsets[] = {offsetof(ompi_coll_tuned_event_data_t, collective),
+                                     offsetof(ompi_coll_tuned_event_data_t, algorithm)};
+    mca_base_var_enum_value_t colls[COLLCOUNT + 1];
+    mca_base_var_enum_t *colls_enum = NULL;
+    int index;
+
+    for (int i = 0 ; i < COLLCOUNT ; ++i) {
+        colls[i].value = i;
+        colls[i].string = mca_coll_base_colltype_to_str(i);
+    }
+    colls[COLLCOUNT].string = NULL;
+    (void) mca_base_var_enum_create("coll_tuned_collectives", colls, &colls_enum);
+
+    index = mca_base_component_event_register(&mca_coll_tuned_component.super.collm_version,
+                                              "algorithm",
+                                              "A collective runs an algorithm of the tuned component, "
+                                              "the number is the one of its forced algorithm parameter "
+                                              "(elements: collective, algorithm)",
+                                              OPAL_INFO_LVL_5, types, offsets, 2, colls_enum,
+                                              MPI_T_BIND_MPI_COMM, 0);
+    if (0 <= index) {
+        (void) mca_base_event_get(index, &ompi_coll_tuned_event_algorithm);
+    }
+    if (NULL != colls_enum) {
+        OBJ_RELEASE(colls_enum);
+    }
+}
+
 static int tuned_register(void)
 {
 
@@ -191,6 +237,36 @@ static int tuned_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &ompi_coll_tuned_dynamic_rules_filename);
 
+    ompi_coll_tuned_autotune = false;
+    (void) mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                           "autotune",
+                                           "Time every algorithm of allgather, allreduce, alltoall, barrier, bcast and reduce over their first invocations for each communicator and message size (power of two) bucket, then use the fastest one. Only used with use_dynamic_rules, for collectives without a forced algorithm or a file based rule",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_coll_tuned_autotune);
+
+    ompi_coll_tuned_autotune_iterations = 5;
+    (void) mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                           "autotune_iterations",
+                                           "Number of timed invocations of each candidate algorithm during auto-tuning (each candidate also gets one untimed warm-up invocation)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_coll_tuned_autotune_iterations);
+    if (ompi_coll_tuned_autotune_iterations < 1) {
+        ompi_coll_tuned_autotune_iterations = 1;
+    }
+
+    ompi_coll_tuned_autotune_filename = NULL;
+    (void) mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                           "autotune_filename",
+                                           "Filename where the auto-tuning results are written at the end of the job, in the dynamic_rules_filename format",
+                                           MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_coll_tuned_autotune_filename);
+
     /* register forced params */
     ompi_coll_tuned_allreduce_intra_check_forced_init(&ompi_coll_tuned_forced_params[ALLREDUCE]);
     ompi_coll_tuned_alltoall_intra_check_forced_init(&ompi_coll_tuned_forced_params[ALLTOALL]);
@@ -203,10 +279,14 @@ static int tuned_register(void)
     ompi_coll_tuned_reduce_scatter_intra_check_forced_init(&ompi_coll_tuned_forced_params[REDUCESCATTER]);
     ompi_coll_tuned_reduce_scatter_block_intra_check_forced_init(&ompi_coll_tuned_forced_params[REDUCESCATTERBLOCK]);
     ompi_coll_tuned_gather_intra_check_forced_init(&ompi_coll_tuned_forced_params[GATHER]);
+    ompi_coll_tuned_gatherv_intra_check_forced_init(&ompi_coll_tuned_forced_params[GATHERV]);
     ompi_coll_tuned_scatter_intra_check_forced_init(&ompi_coll_tuned_forced_params[SCATTER]);
+    ompi_coll_tuned_scatterv_intra_check_forced_init(&ompi_coll_tuned_forced_params[SCATTERV]);
     ompi_coll_tuned_exscan_intra_check_forced_init(&ompi_coll_tuned_forced_params[EXSCAN]);
     ompi_coll_tuned_scan_intra_check_forced_init(&ompi_coll_tuned_forced_params[SCAN]);
 
+    tuned_event_register();
+
     return OMPI_SUCCESS;
 }
 
@@ -265,6 +345,10 @@ static int tuned_close(void)
         mca_coll_tuned_component.all_base_rules = NULL;
     }
 
+    if( ompi_coll_tuned_autotune ) {
+        ompi_coll_tuned_autotune_finalize();
+    }
+
     return OMPI_SUCCESS;
 }
 
@@ -276,8 +360,20 @@ mca_coll_tuned_module_construct(mca_coll_tuned_module_t *module)
     for( int i = 0; i < COLLCOUNT; i++ ) {
         tuned_module->user_forced[i].algorithm = 0;
         tuned_module->com_rules[i] = NULL;
+        tuned_module->decisions[i] = NULL;
+        tuned_module->autotune[i] = NULL;
+    }
+}
+
+static void
+mca_coll_tuned_module_destruct(mca_coll_tuned_module_t *module)
+{
+    for( int i = 0; i < COLLCOUNT; i++ ) {
+        free(module->decisions[i]);
+        module->decisions[i] = NULL;
     }
+    ompi_coll_tuned_autotune_module_fini(module);
 }
 
 OBJ_CLASS_INSTANCE(mca_coll_tuned_module_t, mca_coll_base_module_t,
-                   mca_coll_tuned_module_construct, NULL);
+                   mca_coll_tuned_module_construct, mca_coll_tuned_module_destruct);
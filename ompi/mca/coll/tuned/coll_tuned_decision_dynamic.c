@@ -31,6 +31,7 @@
 #include "ompi/mca/coll/coll.h"
 #include "ompi/mca/coll/base/coll_tags.h"
 #include "coll_tuned.h"
+#include "coll_tuned_autotune.h"
 
 /*
  * Notes on evaluation rules and ordering
@@ -40,6 +41,8 @@
  * Else
  *      use forced rules (-coll_tuned_dynamic_ALG_intra_algorithm = algorithm-number)
  * Else
+ *      use online auto-tuning, if enabled (-coll_tuned_autotune 1)
+ * Else
  *      use fixed (compiled) rule set (or nested ifs)
  *
  */
@@ -79,7 +82,8 @@ ompi_coll_tuned_allreduce_intra_dec_dynamic (const void *sbuf, void *rbuf, int c
         ompi_datatype_type_size (dtype, &dsize);
         dsize *= count;
 
-        alg = ompi_coll_tuned_get_target_method_params (tuned_module->com_rules[ALLREDUCE],
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[ALLREDUCE],
+                                                        tuned_module->decisions[ALLREDUCE],
                                                         dsize, &faninout, &segsize, &ignoreme);
 
         if (alg) {
@@ -90,6 +94,31 @@ ompi_coll_tuned_allreduce_intra_dec_dynamic (const void *sbuf, void *rbuf, int c
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* auto-tune when there is neither a forced algorithm nor a file based rule */
+    if (tuned_module->autotune[ALLREDUCE]) {
+        ompi_coll_tuned_autotune_bucket_t *bucket;
+        double start;
+        int ret;
+        size_t dsize;
+
+        ompi_datatype_type_size (dtype, &dsize);
+        dsize *= count;
+        bucket = ompi_coll_tuned_autotune_get_bucket(tuned_module, ALLREDUCE, dsize);
+        if (bucket->done) {
+            return ompi_coll_tuned_allreduce_intra_do_this (sbuf, rbuf, count, dtype, op,
+                                                           comm, module, bucket->alg,
+                                                           tuned_module->user_forced[ALLREDUCE].tree_fanout,
+                                                           tuned_module->user_forced[ALLREDUCE].segsize);
+        }
+        start = MPI_Wtime();
+        ret = ompi_coll_tuned_allreduce_intra_do_this (sbuf, rbuf, count, dtype, op,
+                                                           comm, module, bucket->alg,
+                                                           tuned_module->user_forced[ALLREDUCE].tree_fanout,
+                                                           tuned_module->user_forced[ALLREDUCE].segsize);
+        ompi_coll_tuned_autotune_record(tuned_module, ALLREDUCE, bucket, MPI_Wtime() - start, comm);
+        return ret;
+    }
+
     return ompi_coll_tuned_allreduce_intra_dec_fixed (sbuf, rbuf, count, dtype, op,
                                                       comm, module);
 }
@@ -135,7 +164,8 @@ int ompi_coll_tuned_alltoall_intra_dec_dynamic(const void *sbuf, int scount,
         comsize = ompi_comm_size(comm);
         dsize *= (ptrdiff_t)comsize * (ptrdiff_t)scount;
 
-        alg = ompi_coll_tuned_get_target_method_params (tuned_module->com_rules[ALLTOALL],
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[ALLTOALL],
+                                                        tuned_module->decisions[ALLTOALL],
                                                         dsize, &faninout, &segsize, &max_requests);
 
         if (alg) {
@@ -147,6 +177,36 @@ int ompi_coll_tuned_alltoall_intra_dec_dynamic(const void *sbuf, int scount,
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* auto-tune when there is neither a forced algorithm nor a file based rule */
+    if (tuned_module->autotune[ALLTOALL]) {
+        ompi_coll_tuned_autotune_bucket_t *bucket;
+        double start;
+        int ret;
+        size_t dsize;
+
+        /* from the receive side, which is always valid (MPI_IN_PLACE) */
+        ompi_datatype_type_size (rdtype, &dsize);
+        dsize *= (ptrdiff_t)ompi_comm_size(comm) * (ptrdiff_t)rcount;
+        bucket = ompi_coll_tuned_autotune_get_bucket(tuned_module, ALLTOALL, dsize);
+        if (bucket->done) {
+            return ompi_coll_tuned_alltoall_intra_do_this (sbuf, scount, sdtype,
+                                                          rbuf, rcount, rdtype,
+                                                          comm, module, bucket->alg,
+                                                          tuned_module->user_forced[ALLTOALL].tree_fanout,
+                                                          tuned_module->user_forced[ALLTOALL].segsize,
+                                                          tuned_module->user_forced[ALLTOALL].max_requests);
+        }
+        start = MPI_Wtime();
+        ret = ompi_coll_tuned_alltoall_intra_do_this (sbuf, scount, sdtype,
+                                                          rbuf, rcount, rdtype,
+                                                          comm, module, bucket->alg,
+                                                          tuned_module->user_forced[ALLTOALL].tree_fanout,
+                                                          tuned_module->user_forced[ALLTOALL].segsize,
+                                                          tuned_module->user_forced[ALLTOALL].max_requests);
+        ompi_coll_tuned_autotune_record(tuned_module, ALLTOALL, bucket, MPI_Wtime() - start, comm);
+        return ret;
+    }
+
     return ompi_coll_tuned_alltoall_intra_dec_fixed (sbuf, scount, sdtype,
                                                      rbuf, rcount, rdtype,
                                                      comm, module);
@@ -186,7 +246,8 @@ int ompi_coll_tuned_alltoallv_intra_dec_dynamic(const void *sbuf, const int *sco
     if (tuned_module->com_rules[ALLTOALLV]) {
         int alg, faninout, segsize, max_requests;
 
-        alg = ompi_coll_tuned_get_target_method_params (tuned_module->com_rules[ALLTOALLV],
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[ALLTOALLV],
+                                                        tuned_module->decisions[ALLTOALLV],
                                                         0, &faninout, &segsize, &max_requests);
 
         if (alg) {
@@ -230,7 +291,8 @@ int ompi_coll_tuned_barrier_intra_dec_dynamic(struct ompi_communicator_t *comm,
         /* we do, so calc the message size or what ever we need and use this for the evaluation */
         int alg, faninout, segsize, ignoreme;
 
-        alg = ompi_coll_tuned_get_target_method_params (tuned_module->com_rules[BARRIER],
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[BARRIER],
+                                                        tuned_module->decisions[BARRIER],
                                                         0, &faninout, &segsize, &ignoreme);
 
         if (alg) {
@@ -240,6 +302,26 @@ int ompi_coll_tuned_barrier_intra_dec_dynamic(struct ompi_communicator_t *comm,
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* auto-tune when there is neither a forced algorithm nor a file based rule */
+    if (tuned_module->autotune[BARRIER]) {
+        ompi_coll_tuned_autotune_bucket_t *bucket;
+        double start;
+        int ret;
+        size_t dsize = 0;
+        bucket = ompi_coll_tuned_autotune_get_bucket(tuned_module, BARRIER, dsize);
+        if (bucket->done) {
+            return ompi_coll_tuned_barrier_intra_do_this (comm, module, bucket->alg,
+                                                         tuned_module->user_forced[BARRIER].tree_fanout,
+                                                         tuned_module->user_forced[BARRIER].segsize);
+        }
+        start = MPI_Wtime();
+        ret = ompi_coll_tuned_barrier_intra_do_this (comm, module, bucket->alg,
+                                                         tuned_module->user_forced[BARRIER].tree_fanout,
+                                                         tuned_module->user_forced[BARRIER].segsize);
+        ompi_coll_tuned_autotune_record(tuned_module, BARRIER, bucket, MPI_Wtime() - start, comm);
+        return ret;
+    }
+
     return ompi_coll_tuned_barrier_intra_dec_fixed (comm, module);
 }
 
@@ -277,7 +359,8 @@ int ompi_coll_tuned_bcast_intra_dec_dynamic(void *buf, int count,
         ompi_datatype_type_size (dtype, &dsize);
         dsize *= count;
 
-        alg = ompi_coll_tuned_get_target_method_params (tuned_module->com_rules[BCAST],
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[BCAST],
+                                                        tuned_module->decisions[BCAST],
                                                         dsize, &faninout, &segsize, &ignoreme);
 
         if (alg) {
@@ -289,6 +372,31 @@ int ompi_coll_tuned_bcast_intra_dec_dynamic(void *buf, int count,
     } /*end if any com rules to check */
 
 
+    /* auto-tune when there is neither a forced algorithm nor a file based rule */
+    if (tuned_module->autotune[BCAST]) {
+        ompi_coll_tuned_autotune_bucket_t *bucket;
+        double start;
+        int ret;
+        size_t dsize;
+
+        ompi_datatype_type_size (dtype, &dsize);
+        dsize *= count;
+        bucket = ompi_coll_tuned_autotune_get_bucket(tuned_module, BCAST, dsize);
+        if (bucket->done) {
+            return ompi_coll_tuned_bcast_intra_do_this (buf, count, dtype, root,
+                                                       comm, module, bucket->alg,
+                                                       tuned_module->user_forced[BCAST].chain_fanout,
+                                                       tuned_module->user_forced[BCAST].segsize);
+        }
+        start = MPI_Wtime();
+        ret = ompi_coll_tuned_bcast_intra_do_this (buf, count, dtype, root,
+                                                       comm, module, bucket->alg,
+                                                       tuned_module->user_forced[BCAST].chain_fanout,
+                                                       tuned_module->user_forced[BCAST].segsize);
+        ompi_coll_tuned_autotune_record(tuned_module, BCAST, bucket, MPI_Wtime() - start, comm);
+        return ret;
+    }
+
     return ompi_coll_tuned_bcast_intra_dec_fixed (buf, count, dtype, root,
                                                   comm, module);
 }
@@ -331,7 +439,8 @@ int ompi_coll_tuned_reduce_intra_dec_dynamic( const void *sbuf, void *rbuf,
         ompi_datatype_type_size(dtype, &dsize);
         dsize *= count;
 
-        alg = ompi_coll_tuned_get_target_method_params (tuned_module->com_rules[REDUCE],
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[REDUCE],
+                                                        tuned_module->decisions[REDUCE],
                                                         dsize, &faninout, &segsize, &max_requests);
 
         if (alg) {
@@ -343,6 +452,33 @@ int ompi_coll_tuned_reduce_intra_dec_dynamic( const void *sbuf, void *rbuf,
         } /* found a method */
     } /*end if any com rules to check */
 
+    /* auto-tune when there is neither a forced algorithm nor a file based rule */
+    if (tuned_module->autotune[REDUCE]) {
+        ompi_coll_tuned_autotune_bucket_t *bucket;
+        double start;
+        int ret;
+        size_t dsize;
+
+        ompi_datatype_type_size (dtype, &dsize);
+        dsize *= count;
+        bucket = ompi_coll_tuned_autotune_get_bucket(tuned_module, REDUCE, dsize);
+        if (bucket->done) {
+            return ompi_coll_tuned_reduce_intra_do_this (sbuf, rbuf, count, dtype,
+                                                        op, root, comm, module, bucket->alg,
+                                                        tuned_module->user_forced[REDUCE].chain_fanout,
+                                                        tuned_module->user_forced[REDUCE].segsize,
+                                                        tuned_module->user_forced[REDUCE].max_requests);
+        }
+        start = MPI_Wtime();
+        ret = ompi_coll_tuned_reduce_intra_do_this (sbuf, rbuf, count, dtype,
+                                                        op, root, comm, module, bucket->alg,
+                                                        tuned_module->user_forced[REDUCE].chain_fanout,
+                                                        tuned_module->user_forced[REDUCE].segsize,
+                                                        tuned_module->user_forced[REDUCE].max_requests);
+        ompi_coll_tuned_autotune_record(tuned_module, REDUCE, bucket, MPI_Wtime() - start, comm);
+        return ret;
+    }
+
     return ompi_coll_tuned_reduce_intra_dec_fixed (sbuf, rbuf, count, dtype,
                                                    op, root, comm, module);
 }
@@ -387,7 +523,8 @@ int ompi_coll_tuned_reduce_scatter_intra_dec_dynamic(const void *sbuf, void *rbu
         ompi_datatype_type_size (dtype, &dsize);
         dsize *= count;
 
-        alg = ompi_coll_tuned_get_target_method_params (tuned_module->com_rules[REDUCESCATTER],
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[REDUCESCATTER],
+                                                        tuned_module->decisions[REDUCESCATTER],
                                                         dsize, &faninout,
                                                         &segsize, &ignoreme);
         if (alg) {
@@ -441,7 +578,8 @@ int ompi_coll_tuned_reduce_scatter_block_intra_dec_dynamic(const void *sbuf, voi
         ompi_datatype_type_size (dtype, &dsize);
         dsize *= rcount * size;
 
-        alg = ompi_coll_tuned_get_target_method_params(tuned_module->com_rules[REDUCESCATTERBLOCK],
+        alg = ompi_coll_tuned_get_cached_method_params(tuned_module->com_rules[REDUCESCATTERBLOCK],
+                                                       tuned_module->decisions[REDUCESCATTERBLOCK],
                                                        dsize, &faninout,
                                                        &segsize, &ignoreme);
         if (alg) {
@@ -499,7 +637,8 @@ int ompi_coll_tuned_allgather_intra_dec_dynamic(const void *sbuf, int scount,
         comsize = ompi_comm_size(comm);
         dsize *= (ptrdiff_t)comsize * (ptrdiff_t)scount;
 
-        alg = ompi_coll_tuned_get_target_method_params (tuned_module->com_rules[ALLGATHER],
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[ALLGATHER],
+                                                        tuned_module->decisions[ALLGATHER],
                                                         dsize, &faninout, &segsize, &ignoreme);
         if (alg) {
             /* we have found a valid choice from the file based rules for
@@ -511,6 +650,34 @@ int ompi_coll_tuned_allgather_intra_dec_dynamic(const void *sbuf, int scount,
         }
     }
 
+    /* auto-tune when there is neither a forced algorithm nor a file based rule */
+    if (tuned_module->autotune[ALLGATHER]) {
+        ompi_coll_tuned_autotune_bucket_t *bucket;
+        double start;
+        int ret;
+        size_t dsize;
+
+        /* from the receive side, which is always valid (MPI_IN_PLACE) */
+        ompi_datatype_type_size (rdtype, &dsize);
+        dsize *= (ptrdiff_t)ompi_comm_size(comm) * (ptrdiff_t)rcount;
+        bucket = ompi_coll_tuned_autotune_get_bucket(tuned_module, ALLGATHER, dsize);
+        if (bucket->done) {
+            return ompi_coll_tuned_allgather_intra_do_this (sbuf, scount, sdtype,
+                                                           rbuf, rcount, rdtype,
+                                                           comm, module, bucket->alg,
+                                                           tuned_module->user_forced[ALLGATHER].tree_fanout,
+                                                           tuned_module->user_forced[ALLGATHER].segsize);
+        }
+        start = MPI_Wtime();
+        ret = ompi_coll_tuned_allgather_intra_do_this (sbuf, scount, sdtype,
+                                                           rbuf, rcount, rdtype,
+                                                           comm, module, bucket->alg,
+                                                           tuned_module->user_forced[ALLGATHER].tree_fanout,
+                                                           tuned_module->user_forced[ALLGATHER].segsize);
+        ompi_coll_tuned_autotune_record(tuned_module, ALLGATHER, bucket, MPI_Wtime() - start, comm);
+        return ret;
+    }
+
     /* Use default decision */
     return ompi_coll_tuned_allgather_intra_dec_fixed (sbuf, scount, sdtype,
                                                       rbuf, rcount, rdtype,
@@ -564,7 +731,8 @@ int ompi_coll_tuned_allgatherv_intra_dec_dynamic(const void *sbuf, int scount,
 
         per_rank_size = total_size / comsize;
 
-        alg = ompi_coll_tuned_get_target_method_params (tuned_module->com_rules[ALLGATHERV],
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[ALLGATHERV],
+                                                        tuned_module->decisions[ALLGATHERV],
                                                         per_rank_size, &faninout, &segsize, &ignoreme);
         if (alg) {
             /* we have found a valid choice from the file based rules for
@@ -617,7 +785,8 @@ int ompi_coll_tuned_gather_intra_dec_dynamic(const void *sbuf, int scount,
         ompi_datatype_type_size (sdtype, &dsize);
         dsize *= scount * comsize;
 
-        alg = ompi_coll_tuned_get_target_method_params (tuned_module->com_rules[GATHER],
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[GATHER],
+                                                        tuned_module->decisions[GATHER],
                                                         dsize, &faninout, &segsize, &max_requests);
 
         if (alg) {
@@ -667,7 +836,8 @@ int ompi_coll_tuned_scatter_intra_dec_dynamic(const void *sbuf, int scount,
         ompi_datatype_type_size (sdtype, &dsize);
         dsize *= scount * comsize;
 
-        alg = ompi_coll_tuned_get_target_method_params (tuned_module->com_rules[SCATTER],
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[SCATTER],
+                                                        tuned_module->decisions[SCATTER],
                                                         dsize, &faninout, &segsize, &max_requests);
 
         if (alg) {
@@ -699,7 +869,8 @@ int ompi_coll_tuned_exscan_intra_dec_dynamic(const void *sbuf, void* rbuf, int c
     if (tuned_module->user_forced[EXSCAN].algorithm) {
         return ompi_coll_tuned_exscan_intra_do_this(sbuf, rbuf, count, dtype,
                                                     op, comm, module,
-                                                    tuned_module->user_forced[EXSCAN].algorithm);
+                                                    tuned_module->user_forced[EXSCAN].algorithm,
+                                                    tuned_module->user_forced[EXSCAN].segsize);
     }
 
     /**
@@ -713,14 +884,15 @@ int ompi_coll_tuned_exscan_intra_dec_dynamic(const void *sbuf, void* rbuf, int c
         ompi_datatype_type_size (dtype, &dsize);
         dsize *= comsize;
 
-        alg = ompi_coll_tuned_get_target_method_params (tuned_module->com_rules[EXSCAN],
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[EXSCAN],
+                                                        tuned_module->decisions[EXSCAN],
                                                         dsize, &faninout, &segsize, &max_requests);
 
         if (alg) {
             /* we have found a valid choice from the file based rules for this message size */
             return ompi_coll_tuned_exscan_intra_do_this (sbuf, rbuf, count, dtype,
                                                          op, comm, module,
-                                                         alg);
+                                                         alg, segsize);
         } /* found a method */
     } /*end if any com rules to check */
 
@@ -743,7 +915,8 @@ int ompi_coll_tuned_scan_intra_dec_dynamic(const void *sbuf, void* rbuf, int cou
     if (tuned_module->user_forced[SCAN].algorithm) {
         return ompi_coll_tuned_scan_intra_do_this(sbuf, rbuf, count, dtype,
                                                   op, comm, module,
-                                                  tuned_module->user_forced[SCAN].algorithm);
+                                                  tuned_module->user_forced[SCAN].algorithm,
+                                                  tuned_module->user_forced[SCAN].segsize);
     }
 
     /**
@@ -757,17 +930,124 @@ int ompi_coll_tuned_scan_intra_dec_dynamic(const void *sbuf, void* rbuf, int cou
         ompi_datatype_type_size (dtype, &dsize);
         dsize *= comsize;
 
-        alg = ompi_coll_tuned_get_target_method_params (tuned_module->com_rules[SCAN],
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[SCAN],
+                                                        tuned_module->decisions[SCAN],
                                                         dsize, &faninout, &segsize, &max_requests);
 
         if (alg) {
             /* we have found a valid choice from the file based rules for this message size */
             return ompi_coll_tuned_scan_intra_do_this (sbuf, rbuf, count, dtype,
                                                        op, comm, module,
-                                                       alg);
+                                                       alg, segsize);
         } /* found a method */
     } /*end if any com rules to check */
 
     return ompi_coll_base_scan_intra_linear(sbuf, rbuf, count, dtype,
                                             op, comm, module);
 }
+
+/*
+ *    gatherv_intra_dec
+ *
+ *    Function:    - selects gatherv algorithm to use
+ *    Accepts:    - same arguments as MPI_Gatherv()
+ *    Returns:    - MPI_SUCCESS or error code (passed from
+ *                        the gatherv implementation)
+ */
+int ompi_coll_tuned_gatherv_intra_dec_dynamic(const void *sbuf, int scount,
+                                              struct ompi_datatype_t *sdtype,
+                                              void *rbuf, const int *rcounts, const int *disps,
+                                              struct ompi_datatype_t *rdtype, int root,
+                                              struct ompi_communicator_t *comm,
+                                              mca_coll_base_module_t *module)
+{
+    mca_coll_tuned_module_t *tuned_module = (mca_coll_tuned_module_t*) module;
+
+    OPAL_OUTPUT((ompi_coll_tuned_stream, "ompi_coll_tuned_gatherv_intra_dec_dynamic"));
+
+    /* Check first if an algorithm is set explicitly for this collective */
+    if (tuned_module->user_forced[GATHERV].algorithm) {
+        return ompi_coll_tuned_gatherv_intra_do_this(sbuf, scount, sdtype,
+                                                     rbuf, rcounts, disps, rdtype, root,
+                                                     comm, module,
+                                                     tuned_module->user_forced[GATHERV].algorithm);
+    }
+
+    /**
+     * check to see if we have some filebased rules. Only the root knows
+     * the total amount of data, use the first available rule so that the
+     * algorithm is chosen only based on the communicator size.
+     */
+    if (tuned_module->com_rules[GATHERV]) {
+        int alg, faninout, segsize, max_requests;
+
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[GATHERV],
+                                                        tuned_module->decisions[GATHERV],
+                                                        0, &faninout, &segsize, &max_requests);
+
+        if (alg) {
+            /* we have found a valid choice from the file based rules for this message size */
+            return ompi_coll_tuned_gatherv_intra_do_this (sbuf, scount, sdtype,
+                                                          rbuf, rcounts, disps, rdtype, root,
+                                                          comm, module,
+                                                          alg);
+        } /* found a method */
+    } /*end if any com rules to check */
+
+    return ompi_coll_tuned_gatherv_intra_dec_fixed(sbuf, scount, sdtype,
+                                                   rbuf, rcounts, disps, rdtype, root,
+                                                   comm, module);
+}
+
+/*
+ *    scatterv_intra_dec
+ *
+ *    Function:    - selects scatterv algorithm to use
+ *    Accepts:    - same arguments as MPI_Scatterv()
+ *    Returns:    - MPI_SUCCESS or error code (passed from
+ *                        the scatterv implementation)
+ */
+int ompi_coll_tuned_scatterv_intra_dec_dynamic(const void *sbuf, const int *scounts,
+                                               const int *disps, struct ompi_datatype_t *sdtype,
+                                               void *rbuf, int rcount,
+                                               struct ompi_datatype_t *rdtype, int root,
+                                               struct ompi_communicator_t *comm,
+                                               mca_coll_base_module_t *module)
+{
+    mca_coll_tuned_module_t *tuned_module = (mca_coll_tuned_module_t*) module;
+
+    OPAL_OUTPUT((ompi_coll_tuned_stream, "ompi_coll_tuned_scatterv_intra_dec_dynamic"));
+
+    /* Check first if an algorithm is set explicitly for this collective */
+    if (tuned_module->user_forced[SCATTERV].algorithm) {
+        return ompi_coll_tuned_scatterv_intra_do_this(sbuf, scounts, disps, sdtype,
+                                                      rbuf, rcount, rdtype, root,
+                                                      comm, module,
+                                                      tuned_module->user_forced[SCATTERV].algorithm);
+    }
+
+    /**
+     * check to see if we have some filebased rules. Only the root knows
+     * the total amount of data, use the first available rule so that the
+     * algorithm is chosen only based on the communicator size.
+     */
+    if (tuned_module->com_rules[SCATTERV]) {
+        int alg, faninout, segsize, max_requests;
+
+        alg = ompi_coll_tuned_get_cached_method_params (tuned_module->com_rules[SCATTERV],
+                                                        tuned_module->decisions[SCATTERV],
+                                                        0, &faninout, &segsize, &max_requests);
+
+        if (alg) {
+            /* we have found a valid choice from the file based rules for this message size */
+            return ompi_coll_tuned_scatterv_intra_do_this (sbuf, scounts, disps, sdtype,
+                                                           rbuf, rcount, rdtype, root,
+                                                           comm, module,
+                                                           alg);
+        } /* found a method */
+    } /*end if any com rules to check */
+
+    return ompi_coll_tuned_scatterv_intra_dec_fixed(sbuf, scounts, disps, sdtype,
+                                                    rbuf, rcount, rdtype, root,
+                                                    comm, module);
+}
@@ -73,9 +73,13 @@ ompi_coll_tuned_allreduce_intra_dec_fixed(const void *sbuf, void *rbuf, int coun
      *  {4, "ring"},
      *  {5, "segmented_ring"},
      *  {6, "rabenseifner"
+     *  {7, "swing"},
+     *  {8, "recursive_multiplying"},
      *
-     * Currently, ring, segmented ring, and rabenseifner do not support
-     * non-commutative operations.
+     * Currently, ring, segmented ring and swing do not support
+     * non-commutative operations. Swing and recursive multiplying are not
+     * part of the measured rules below, they are selected through forced or
+     * dynamic rules.
      */
     if( !ompi_op_is_commute(op) ) {
         if (communicator_size < 4) {
@@ -117,6 +121,11 @@ ompi_coll_tuned_allreduce_intra_dec_fixed(const void *sbuf, void *rbuf, int coun
                 alg = 3;
             }
         }
+        /* Rabenseifner keeps the order of the ranks within the blocks, and
+         * splits the large vectors between the processes */
+        if (communicator_size >= 4 && total_dsize >= 262144 && count >= communicator_size) {
+            alg = 6;
+        }
     } else {
         if (communicator_size < 4) {
             if (total_dsize < 8) {
@@ -430,9 +439,38 @@ int ompi_coll_tuned_alltoallv_intra_dec_fixed(const void *sbuf, const int *scoun
     /** Algorithms:
      *  {1, "basic_linear"},
      *  {2, "pairwise"},
+     *  {3, "sparse"},
      *
-     * We can only optimize based on com size
+     * Besides the com size, only the share of empty blocks is known, and
+     * only locally. The sparse algorithm exchanges nothing for the empty
+     * blocks so all processes have to pick it together: they agree on the
+     * densest process with an allreduce, which is cheap next to a linear
+     * or pairwise exchange on that many processes.
      */
+    if (MPI_IN_PLACE != sbuf && ompi_coll_tuned_alltoallv_sparse_min_procs > 0
+        && communicator_size >= ompi_coll_tuned_alltoallv_sparse_min_procs) {
+        int i, dense = 0, err;
+
+        for (i = 0; i < communicator_size; ++i) {
+            dense += (0 != scounts[i]) + (0 != rcounts[i]);
+        }
+        /* percentage of non empty blocks */
+        dense = (int) (((int64_t) dense * 100) / (2 * communicator_size));
+
+        err = comm->c_coll->coll_allreduce(MPI_IN_PLACE, &dense, 1, MPI_INT,
+                                           MPI_MAX, comm,
+                                           comm->c_coll->coll_allreduce_module);
+        if (MPI_SUCCESS != err) {
+            return err;
+        }
+        if (dense <= 100 - ompi_coll_tuned_alltoallv_sparse_ratio) {
+            return ompi_coll_tuned_alltoallv_intra_do_this (sbuf, scounts, sdisps, sdtype,
+                                                            rbuf, rcounts, rdisps, rdtype,
+                                                            comm, module,
+                                                            3);
+        }
+    }
+
     if (communicator_size < 4) {
 		alg = 2;
     } else if (communicator_size < 64) {
@@ -685,8 +723,8 @@ int ompi_coll_tuned_reduce_intra_dec_fixed( const void *sendbuf, void *recvbuf,
      *  {6, "in-order_binary"},
      *  {7, "rabenseifner"},
      *
-     * Currently, only linear and in-order binary tree algorithms are
-     * capable of non commutative ops.
+     * Currently, only linear, in-order binary tree and rabenseifner
+     * algorithms are capable of non commutative ops.
      */
     if( !ompi_op_is_commute(op) ) {
         if (communicator_size < 4) {
@@ -722,6 +760,11 @@ int ompi_coll_tuned_reduce_intra_dec_fixed( const void *sendbuf, void *recvbuf,
         } else {
             alg = 6;
         }
+        /* Rabenseifner keeps the order of the ranks within the blocks, and
+         * splits the large vectors between the processes */
+        if (communicator_size >= 4 && total_dsize >= 262144 && count >= communicator_size) {
+            alg = 7;
+        }
     } else {
         if (communicator_size < 4) {
             if (total_dsize < 8) {
@@ -1560,3 +1603,91 @@ int ompi_coll_tuned_scatter_intra_dec_fixed(const void *sbuf, int scount,
                                                   root, comm, module,
                                                   alg, 0, 0);
 }
+
+/*
+ *	gatherv_intra_dec
+ *
+ *	Function:	- selects gatherv algorithm to use
+ *	Accepts:	- same arguments as MPI_Gatherv()
+ *	Returns:	- MPI_SUCCESS or error code, passed from corresponding
+ *                        internal gatherv function.
+ */
+
+int ompi_coll_tuned_gatherv_intra_dec_fixed(const void *sbuf, int scount,
+                                            struct ompi_datatype_t *sdtype,
+                                            void *rbuf, const int *rcounts, const int *disps,
+                                            struct ompi_datatype_t *rdtype, int root,
+                                            struct ompi_communicator_t *comm,
+                                            mca_coll_base_module_t *module)
+{
+    int communicator_size, alg;
+
+    communicator_size = ompi_comm_size(comm);
+
+    OPAL_OUTPUT((ompi_coll_tuned_stream, "ompi_coll_tuned_gatherv_intra_dec_fixed com_size %d",
+                 communicator_size));
+
+    /** Algorithms:
+     *  {1, "basic_linear"},
+     *  {2, "knomial"},
+     *
+     * Only the root knows the size of all the blocks, the choice can only
+     * depend on the communicator size. The tree relieves the root of the
+     * p - 1 simultaneous messages it receives on large communicators.
+     */
+    if (ompi_coll_tuned_gatherv_knomial_min_procs > 0
+        && communicator_size >= ompi_coll_tuned_gatherv_knomial_min_procs) {
+        alg = 2;
+    } else {
+        alg = 1;
+    }
+
+    return ompi_coll_tuned_gatherv_intra_do_this (sbuf, scount, sdtype,
+                                                  rbuf, rcounts, disps, rdtype, root,
+                                                  comm, module,
+                                                  alg);
+}
+
+/*
+ *	scatterv_intra_dec
+ *
+ *	Function:	- selects scatterv algorithm to use
+ *	Accepts:	- same arguments as MPI_Scatterv()
+ *	Returns:	- MPI_SUCCESS or error code, passed from corresponding
+ *                        internal scatterv function.
+ */
+
+int ompi_coll_tuned_scatterv_intra_dec_fixed(const void *sbuf, const int *scounts,
+                                             const int *disps, struct ompi_datatype_t *sdtype,
+                                             void *rbuf, int rcount,
+                                             struct ompi_datatype_t *rdtype, int root,
+                                             struct ompi_communicator_t *comm,
+                                             mca_coll_base_module_t *module)
+{
+    int communicator_size, alg;
+
+    communicator_size = ompi_comm_size(comm);
+
+    OPAL_OUTPUT((ompi_coll_tuned_stream, "ompi_coll_tuned_scatterv_intra_dec_fixed com_size %d",
+                 communicator_size));
+
+    /** Algorithms:
+     *  {1, "basic_linear"},
+     *  {2, "knomial"},
+     *
+     * Only the root knows the size of all the blocks, the choice can only
+     * depend on the communicator size. The tree relieves the root of the
+     * p - 1 simultaneous messages it sends on large communicators.
+     */
+    if (ompi_coll_tuned_scatterv_knomial_min_procs > 0
+        && communicator_size >= ompi_coll_tuned_scatterv_knomial_min_procs) {
+        alg = 2;
+    } else {
+        alg = 1;
+    }
+
+    return ompi_coll_tuned_scatterv_intra_do_this (sbuf, scounts, disps, sdtype,
+                                                   rbuf, rcount, rdtype, root,
+                                                   comm, module,
+                                                   alg);
+}
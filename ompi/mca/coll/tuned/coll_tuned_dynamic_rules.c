@@ -340,8 +340,7 @@ ompi_coll_com_rule_t* ompi_coll_tuned_get_com_rule_ptr (ompi_coll_alg_rule_t* ru
  *
  */
 
-int ompi_coll_tuned_get_target_method_params (ompi_coll_com_rule_t* base_com_rule, size_t mpi_msgsize, int *result_topo_faninout,
-                                              int* result_segsize, int* max_requests)
+static ompi_coll_msg_rule_t* ompi_coll_tuned_get_msg_rule_ptr (ompi_coll_com_rule_t* base_com_rule, size_t mpi_msgsize)
 {
     ompi_coll_msg_rule_t*  msg_p = (ompi_coll_msg_rule_t*) NULL;
     ompi_coll_msg_rule_t*  best_msg_p = (ompi_coll_msg_rule_t*) NULL;
@@ -349,7 +348,7 @@ int ompi_coll_tuned_get_target_method_params (ompi_coll_com_rule_t* base_com_rul
 
     /* No rule or zero rules */
     if( (NULL == base_com_rule) || (0 == base_com_rule->n_msg_sizes)) {
-        return (0);
+        return ((ompi_coll_msg_rule_t*)NULL);
     }
 
     /* ok have some msg sizes, now to find the one closest to my mpi_msgsize */
@@ -374,6 +373,19 @@ int ompi_coll_tuned_get_target_method_params (ompi_coll_com_rule_t* base_com_rul
         i++;
     }
 
+    return (best_msg_p);
+}
+
+int ompi_coll_tuned_get_target_method_params (ompi_coll_com_rule_t* base_com_rule, size_t mpi_msgsize, int *result_topo_faninout,
+                                              int* result_segsize, int* max_requests)
+{
+    ompi_coll_msg_rule_t*  best_msg_p;
+
+    best_msg_p = ompi_coll_tuned_get_msg_rule_ptr (base_com_rule, mpi_msgsize);
+    if (NULL == best_msg_p) {
+        return (0);
+    }
+
     OPAL_OUTPUT((ompi_coll_tuned_stream,"Selected the following msg rule id %d\n", best_msg_p->msg_rule_id));
     ompi_coll_tuned_dump_msg_rule (best_msg_p);
 
@@ -389,3 +401,80 @@ int ompi_coll_tuned_get_target_method_params (ompi_coll_com_rule_t* base_com_rul
     /* return the algorithm/method to use */
     return (best_msg_p->result_alg);
 }
+
+
+/*
+ * Allocate a decision table, with all the buckets still to be resolved
+ */
+ompi_coll_tuned_decision_t* ompi_coll_tuned_mk_decisions (void)
+{
+    ompi_coll_tuned_decision_t* decisions;
+    int i;
+
+    decisions = (ompi_coll_tuned_decision_t *) malloc (sizeof(ompi_coll_tuned_decision_t) * COLL_TUNED_DECISION_BUCKETS);
+    if (!decisions) {
+        return decisions;
+    }
+
+    for (i = 0; i < COLL_TUNED_DECISION_BUCKETS; i++) {
+        decisions[i].alg = COLL_TUNED_DECISION_UNKNOWN;
+        decisions[i].faninout = 0;
+        decisions[i].segsize = 0;
+        decisions[i].max_requests = 0;
+    }
+    return decisions;
+}
+
+/*
+ * Slow path of ompi_coll_tuned_get_cached_method_params(): do the msg rule
+ * lookup, and remember the result for the whole power-of-two bucket of
+ * mpi_msgsize if both ends of the bucket select the same msg rule (as the
+ * rules are sorted by message size, so does everything in between).
+ * Buckets straddling a rule boundary are marked and always looked up.
+ */
+int ompi_coll_tuned_resolve_decision (ompi_coll_com_rule_t* base_com_rule,
+                                      ompi_coll_tuned_decision_t* decisions, size_t mpi_msgsize,
+                                      int* result_topo_faninout, int* result_segsize,
+                                      int* max_requests)
+{
+    ompi_coll_tuned_decision_t *d;
+    ompi_coll_msg_rule_t *low_p, *high_p;
+    size_t low, high;
+    int bucket;
+
+    bucket = ompi_coll_tuned_size_bucket (mpi_msgsize);
+    d = &decisions[bucket];
+
+    if (COLL_TUNED_DECISION_UNKNOWN == d->alg) {
+        if (0 == bucket) {
+            low = high = 0;
+        } else {
+            low = ((size_t)1) << (bucket - 1);
+            high = low + (low - 1);
+        }
+        low_p = ompi_coll_tuned_get_msg_rule_ptr (base_com_rule, low);
+        high_p = ompi_coll_tuned_get_msg_rule_ptr (base_com_rule, high);
+
+        if (low_p != high_p) {
+            d->alg = COLL_TUNED_DECISION_SPLIT;
+        } else if (NULL == low_p) {
+            d->alg = 0;
+        } else {
+            d->faninout = low_p->result_topo_faninout;
+            d->segsize = low_p->result_segsize;
+            d->max_requests = low_p->result_max_requests;
+            d->alg = low_p->result_alg;
+        }
+    }
+
+    if (d->alg >= 0) {
+        *result_topo_faninout = d->faninout;
+        *result_segsize = d->segsize;
+        *max_requests = d->max_requests;
+        return d->alg;
+    }
+
+    return ompi_coll_tuned_get_target_method_params (base_com_rule, mpi_msgsize,
+                                                     result_topo_faninout, result_segsize,
+                                                     max_requests);
+}
@@ -23,6 +23,8 @@
 
 #include "ompi_config.h"
 
+#include "opal/prefetch.h"
+
 BEGIN_C_DECLS
 
 
@@ -71,6 +73,24 @@ typedef struct alg_rule_s {
 
 } ompi_coll_alg_rule_t;
 
+
+/*
+ * Memoized result of the message size lookup, per power-of-two message
+ * size bucket (see ompi_coll_tuned_size_bucket()). A bucket is only
+ * cached when all the sizes it covers resolve to the same msg rule.
+ */
+#define COLL_TUNED_DECISION_BUCKETS  65
+
+#define COLL_TUNED_DECISION_UNKNOWN  -1  /* not looked up yet */
+#define COLL_TUNED_DECISION_SPLIT    -2  /* bucket spans several msg rules */
+
+typedef struct ompi_coll_tuned_decision_s {
+    int alg;           /* result algorithm, 0 for the fixed rules, or one of the above */
+    int faninout;
+    int segsize;
+    int max_requests;
+} ompi_coll_tuned_decision_t;
+
 /* function prototypes */
 
 /* these are used to build the rule tables (by the read file routines) */
@@ -98,6 +118,62 @@ int ompi_coll_tuned_get_target_method_params (ompi_coll_com_rule_t* base_com_rul
                                               int* result_topo_faninout, int* result_segsize,
                                               int* max_requests);
 
+ompi_coll_tuned_decision_t* ompi_coll_tuned_mk_decisions (void);
+int ompi_coll_tuned_resolve_decision (ompi_coll_com_rule_t* base_com_rule,
+                                      ompi_coll_tuned_decision_t* decisions, size_t mpi_msgsize,
+                                      int* result_topo_faninout, int* result_segsize,
+                                      int* max_requests);
+
+/* the number of significant bits of the message size, 0 to 64 */
+static inline int ompi_coll_tuned_size_bucket (size_t mpi_msgsize)
+{
+#if OPAL_C_HAVE_BUILTIN_CLZ
+    if (0 == mpi_msgsize) {
+        return 0;
+    }
+    return (int)(8 * sizeof(unsigned long long)) - __builtin_clzll((unsigned long long)mpi_msgsize);
+#else
+    int b = 0;
+
+    while (mpi_msgsize) {
+        b++;
+        mpi_msgsize >>= 1;
+    }
+    return b;
+#endif
+}
+
+/*
+ * Same as ompi_coll_tuned_get_target_method_params(), but served from
+ * the per-module decision table once the bucket has been resolved.
+ */
+static inline int
+ompi_coll_tuned_get_cached_method_params (ompi_coll_com_rule_t* base_com_rule,
+                                          ompi_coll_tuned_decision_t* decisions, size_t mpi_msgsize,
+                                          int* result_topo_faninout, int* result_segsize,
+                                          int* max_requests)
+{
+    ompi_coll_tuned_decision_t *d;
+
+    if (OPAL_UNLIKELY(NULL == decisions)) {
+        return ompi_coll_tuned_get_target_method_params (base_com_rule, mpi_msgsize,
+                                                         result_topo_faninout, result_segsize,
+                                                         max_requests);
+    }
+
+    d = &decisions[ompi_coll_tuned_size_bucket(mpi_msgsize)];
+    if (OPAL_LIKELY(d->alg >= 0)) {
+        *result_topo_faninout = d->faninout;
+        *result_segsize = d->segsize;
+        *max_requests = d->max_requests;
+        return d->alg;
+    }
+
+    return ompi_coll_tuned_resolve_decision (base_com_rule, decisions, mpi_msgsize,
+                                             result_topo_faninout, result_segsize,
+                                             max_requests);
+}
+
 
 END_C_DECLS
 #endif /* MCA_COLL_TUNED_DYNAMIC_RULES_H_HAS_BEEN_INCLUDED */
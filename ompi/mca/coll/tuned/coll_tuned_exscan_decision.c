@@ -27,12 +27,14 @@
 
 /* exscan algorithm variables */
 static int coll_tuned_exscan_forced_algorithm = 0;
+static int coll_tuned_exscan_segment_size = 0;
 
 /* valid values for coll_tuned_exscan_forced_algorithm */
 static const mca_base_var_enum_value_t exscan_algorithms[] = {
     {0, "ignore"},
     {1, "linear"},
     {2, "recursive_doubling"},
+    {3, "updown_tree"},
     {0, NULL}
 };
 
@@ -71,7 +73,7 @@ int ompi_coll_tuned_exscan_intra_check_forced_init (coll_tuned_force_algorithm_m
     mca_param_indices->algorithm_param_index =
         mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
                                         "exscan_algorithm",
-                                        "Which exscan algorithm is used. Can be locked down to choice of: 0 ignore, 1 linear, 2 recursive_doubling. "
+                                        "Which exscan algorithm is used. Can be locked down to choice of: 0 ignore, 1 linear, 2 recursive_doubling, 3 updown_tree. "
                                         "Only relevant if coll_tuned_use_dynamic_rules is true.",
                                         MCA_BASE_VAR_TYPE_INT, new_enum, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                         OPAL_INFO_LVL_5,
@@ -82,6 +84,16 @@ int ompi_coll_tuned_exscan_intra_check_forced_init (coll_tuned_force_algorithm_m
         return mca_param_indices->algorithm_param_index;
     }
 
+    coll_tuned_exscan_segment_size = 0;
+    mca_param_indices->segsize_param_index =
+        mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                        "exscan_algorithm_segmentsize",
+                                        "Segment size in bytes used by default for exscan algorithms. Only has meaning if algorithm is forced and supports segmenting (updown_tree). 0 bytes means no segmentation.",
+                                        MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                        OPAL_INFO_LVL_5,
+                                        MCA_BASE_VAR_SCOPE_ALL,
+                                        &coll_tuned_exscan_segment_size);
+
     return (MPI_SUCCESS);
 }
 
@@ -90,17 +102,30 @@ int ompi_coll_tuned_exscan_intra_do_this(const void *sbuf, void* rbuf, int count
                                          struct ompi_op_t *op,
                                          struct ompi_communicator_t *comm,
                                          mca_coll_base_module_t *module,
-                                         int algorithm)
+                                         int algorithm, int segsize)
 {
-    OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:exscan_intra_do_this selected algorithm %d",
-                 algorithm));
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
+    OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:exscan_intra_do_this selected algorithm %d segsize %d",
+                 algorithm, segsize));
 
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(EXSCAN, algorithm, comm);
     switch (algorithm) {
     case (0):
-    case (1):  return ompi_coll_base_exscan_intra_linear(sbuf, rbuf, count, dtype,
-                                                         op, comm, module);
-    case (2):  return ompi_coll_base_exscan_intra_recursivedoubling(sbuf, rbuf, count, dtype,
-                                                                    op, comm, module);
+    case (1):
+        COLL_TUNED_ALG_RETURN(EXSCAN, algorithm, cycles,
+                              ompi_coll_base_exscan_intra_linear(sbuf, rbuf, count, dtype,
+                                                                 op, comm, module));
+    case (2):
+        COLL_TUNED_ALG_RETURN(EXSCAN, algorithm, cycles,
+                              ompi_coll_base_exscan_intra_recursivedoubling(sbuf, rbuf, count, dtype,
+                                                                            op, comm, module));
+    case (3):
+        COLL_TUNED_ALG_RETURN(EXSCAN, algorithm, cycles,
+                              ompi_coll_base_exscan_intra_updown(sbuf, rbuf, count, dtype,
+                                                                 op, comm, module, segsize));
     } /* switch */
     OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:exscan_intra_do_this attempt to select algorithm %d when only 0-%d is valid?",
                  algorithm, ompi_coll_tuned_forced_max_algorithms[EXSCAN]));
@@ -129,28 +129,36 @@ ompi_coll_tuned_gather_intra_do_this(const void *sbuf, int scount,
                                      mca_coll_base_module_t *module,
                                      int algorithm, int faninout, int segsize)
 {
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
     OPAL_OUTPUT((ompi_coll_tuned_stream,
                  "coll:tuned:gather_intra_do_this selected algorithm %d topo faninout %d segsize %d",
                  algorithm, faninout, segsize));
 
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(GATHER, algorithm, comm);
     switch (algorithm) {
     case (0):
         return ompi_coll_tuned_gather_intra_dec_fixed(sbuf, scount, sdtype,
                                                       rbuf, rcount, rdtype,
                                                       root, comm, module);
     case (1):
-        return ompi_coll_base_gather_intra_basic_linear(sbuf, scount, sdtype,
-                                                        rbuf, rcount, rdtype,
-                                                        root, comm, module);
+        COLL_TUNED_ALG_RETURN(GATHER, algorithm, cycles,
+                              ompi_coll_base_gather_intra_basic_linear(sbuf, scount, sdtype,
+                                                                       rbuf, rcount, rdtype,
+                                                                       root, comm, module));
     case (2):
-        return ompi_coll_base_gather_intra_binomial(sbuf, scount, sdtype,
-                                                    rbuf, rcount, rdtype,
-                                                    root, comm, module);
+        COLL_TUNED_ALG_RETURN(GATHER, algorithm, cycles,
+                              ompi_coll_base_gather_intra_binomial(sbuf, scount, sdtype,
+                                                                   rbuf, rcount, rdtype,
+                                                                   root, comm, module));
     case (3):
-        return ompi_coll_base_gather_intra_linear_sync(sbuf, scount, sdtype,
-                                                       rbuf, rcount, rdtype,
-                                                       root, comm, module,
-                                                       segsize);
+        COLL_TUNED_ALG_RETURN(GATHER, algorithm, cycles,
+                              ompi_coll_base_gather_intra_linear_sync(sbuf, scount, sdtype,
+                                                                      rbuf, rcount, rdtype,
+                                                                      root, comm, module,
+                                                                      segsize));
     } /* switch */
     OPAL_OUTPUT((ompi_coll_tuned_stream,
                  "coll:tuned:gather_intra_do_this attempt to select algorithm %d when only 0-%d is valid?",
@@ -0,0 +1,143 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/mca/coll/base/coll_tags.h"
+#include "ompi/mca/pml/pml.h"
+#include "coll_tuned.h"
+
+/* gatherv algorithm variables */
+static int coll_tuned_gatherv_forced_algorithm = 0;
+
+/* k-nomial tree radix for the gatherv algorithm (>= 2) */
+static int coll_tuned_gatherv_knomial_radix = 4;
+
+/* valid values for coll_tuned_gatherv_forced_algorithm */
+static const mca_base_var_enum_value_t gatherv_algorithms[] = {
+    {0, "ignore"},
+    {1, "basic_linear"},
+    {2, "knomial"},
+    {0, NULL}
+};
+
+/*
+ * The following are used by dynamic and forced rules.  Publish
+ * details of each algorithm and if its forced/fixed/locked in as you add
+ * methods/algorithms you must update this and the query/map routines.
+ * This routine is called by the component only.  This makes sure that
+ * the mca parameters are set to their initial values and perms.
+ * Module does not call this.  They call the forced_getvalues routine
+ * instead.
+ */
+int ompi_coll_tuned_gatherv_intra_check_forced_init(coll_tuned_force_algorithm_mca_param_indices_t
+                                                    *mca_param_indices)
+{
+    mca_base_var_enum_t *new_enum;
+    int cnt;
+
+    for( cnt = 0; NULL != gatherv_algorithms[cnt].string; cnt++ );
+    ompi_coll_tuned_forced_max_algorithms[GATHERV] = cnt;
+
+    (void) mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                           "gatherv_algorithm_count",
+                                           "Number of gatherv algorithms available",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_DEFAULT_ONLY,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_CONSTANT,
+                                           &ompi_coll_tuned_forced_max_algorithms[GATHERV]);
+
+    /* MPI_T: This variable should eventually be bound to a communicator */
+    coll_tuned_gatherv_forced_algorithm = 0;
+    (void) mca_base_var_enum_create("coll_tuned_gatherv_algorithms", gatherv_algorithms, &new_enum);
+    mca_param_indices->algorithm_param_index =
+        mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                        "gatherv_algorithm",
+                                        "Which gatherv algorithm is used. Can be locked down to choice of: 0 ignore, 1 basic linear, 2 knomial tree. "
+                                        "Only relevant if coll_tuned_use_dynamic_rules is true.",
+                                        MCA_BASE_VAR_TYPE_INT, new_enum, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                        OPAL_INFO_LVL_5,
+                                        MCA_BASE_VAR_SCOPE_ALL,
+                                        &coll_tuned_gatherv_forced_algorithm);
+    OBJ_RELEASE(new_enum);
+    if (mca_param_indices->algorithm_param_index < 0) {
+        return mca_param_indices->algorithm_param_index;
+    }
+
+    coll_tuned_gatherv_knomial_radix = 4;
+    mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                    "gatherv_algorithm_knomial_radix",
+                                    "k-nomial tree radix for the gatherv algorithm (radix > 1).",
+                                    MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                    OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_ALL,
+                                    &coll_tuned_gatherv_knomial_radix);
+
+    (void) mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                           "gatherv_knomial_min_procs",
+                                           "Use the knomial gatherv algorithm by default for communicators of at least this size "
+                                           "(0 to always use the linear algorithm).",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_6,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_coll_tuned_gatherv_knomial_min_procs);
+
+    return (MPI_SUCCESS);
+}
+
+/* If the user selects dynamic rules and specifies the algorithm to
+ * use, then this function is called.  */
+int ompi_coll_tuned_gatherv_intra_do_this(const void *sbuf, int scount,
+                                          struct ompi_datatype_t *sdtype,
+                                          void *rbuf, const int *rcounts, const int *disps,
+                                          struct ompi_datatype_t *rdtype, int root,
+                                          struct ompi_communicator_t *comm,
+                                          mca_coll_base_module_t *module,
+                                          int algorithm)
+{
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
+    OPAL_OUTPUT((ompi_coll_tuned_stream,
+                 "coll:tuned:gatherv_intra_do_this selected algorithm %d ",
+                 algorithm));
+
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(GATHERV, algorithm, comm);
+    switch (algorithm) {
+    case (0):
+        return ompi_coll_tuned_gatherv_intra_dec_fixed(sbuf, scount, sdtype,
+                                                       rbuf, rcounts, disps, rdtype, root,
+                                                       comm, module);
+    case (1):
+        COLL_TUNED_ALG_RETURN(GATHERV, algorithm, cycles,
+                              ompi_coll_base_gatherv_intra_basic_linear(sbuf, scount, sdtype,
+                                                                        rbuf, rcounts, disps, rdtype, root,
+                                                                        comm, module));
+    case (2):
+        COLL_TUNED_ALG_RETURN(GATHERV, algorithm, cycles,
+                              ompi_coll_base_gatherv_intra_knomial(sbuf, scount, sdtype,
+                                                                   rbuf, rcounts, disps, rdtype, root,
+                                                                   comm, module,
+                                                                   coll_tuned_gatherv_knomial_radix));
+    }  /* switch */
+    OPAL_OUTPUT((ompi_coll_tuned_stream,
+                 "coll:tuned:gatherv_intra_do_this attempt to select "
+                 "algorithm %d when only 0-%d is valid.",
+                 algorithm, ompi_coll_tuned_forced_max_algorithms[GATHERV]));
+    return (MPI_ERR_ARG);
+}
@@ -24,15 +24,18 @@
 #include "coll_tuned.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 
 #include "mpi.h"
 #include "ompi/communicator/communicator.h"
 #include "ompi/mca/coll/coll.h"
 #include "ompi/mca/coll/base/base.h"
 #include "ompi/mca/coll/base/coll_base_topo.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
 #include "coll_tuned.h"
 #include "coll_tuned_dynamic_rules.h"
 #include "coll_tuned_dynamic_file.h"
+#include "coll_tuned_autotune.h"
 
 static int tuned_module_enable(mca_coll_base_module_t *module,
                    struct ompi_communicator_t *comm);
@@ -104,13 +107,13 @@ ompi_coll_tuned_comm_query(struct ompi_communicator_t *comm, int *priority)
     tuned_module->super.coll_bcast      = ompi_coll_tuned_bcast_intra_dec_fixed;
     tuned_module->super.coll_exscan     = NULL;
     tuned_module->super.coll_gather     = ompi_coll_tuned_gather_intra_dec_fixed;
-    tuned_module->super.coll_gatherv    = NULL;
+    tuned_module->super.coll_gatherv    = ompi_coll_tuned_gatherv_intra_dec_fixed;
     tuned_module->super.coll_reduce     = ompi_coll_tuned_reduce_intra_dec_fixed;
     tuned_module->super.coll_reduce_scatter = ompi_coll_tuned_reduce_scatter_intra_dec_fixed;
     tuned_module->super.coll_reduce_scatter_block = ompi_coll_tuned_reduce_scatter_block_intra_dec_fixed;
     tuned_module->super.coll_scan       = NULL;
     tuned_module->super.coll_scatter    = ompi_coll_tuned_scatter_intra_dec_fixed;
-    tuned_module->super.coll_scatterv   = NULL;
+    tuned_module->super.coll_scatterv   = ompi_coll_tuned_scatterv_intra_dec_fixed;
 
     return &(tuned_module->super);
 }
@@ -161,6 +164,18 @@ ompi_coll_tuned_forced_getvalues( enum COLLTYPE type,
                 = ompi_coll_tuned_get_com_rule_ptr( mca_coll_tuned_component.all_base_rules, \
                                                     (TYPE), size );     \
             if( NULL != (TMOD)->com_rules[(TYPE)] ) {                   \
+                if( NULL == (TMOD)->decisions[(TYPE)] ) {               \
+                    (TMOD)->decisions[(TYPE)] = ompi_coll_tuned_mk_decisions(); \
+                }                                                       \
+                need_dynamic_decision = 1;                              \
+            }                                                           \
+        }                                                               \
+        if( ompi_coll_tuned_autotune_supported(TYPE) &&                 \
+            NULL == (TMOD)->autotune[(TYPE)] ) {                        \
+            (TMOD)->autotune[(TYPE)] = (ompi_coll_tuned_autotune_bucket_t*) \
+                calloc(COLL_TUNED_AUTOTUNE_BUCKETS,                     \
+                       sizeof(ompi_coll_tuned_autotune_bucket_t));      \
+            if( NULL != (TMOD)->autotune[(TYPE)] ) {                    \
                 need_dynamic_decision = 1;                              \
             }                                                           \
         }                                                               \
@@ -235,7 +250,7 @@ tuned_module_enable( mca_coll_base_module_t *module,
         COLL_TUNED_EXECUTE_IF_DYNAMIC(tuned_module, GATHER,
                                       tuned_module->super.coll_gather     = ompi_coll_tuned_gather_intra_dec_dynamic);
         COLL_TUNED_EXECUTE_IF_DYNAMIC(tuned_module, GATHERV,
-                                      tuned_module->super.coll_gatherv    = NULL);
+                                      tuned_module->super.coll_gatherv    = ompi_coll_tuned_gatherv_intra_dec_dynamic);
         COLL_TUNED_EXECUTE_IF_DYNAMIC(tuned_module, REDUCE,
                                       tuned_module->super.coll_reduce     = ompi_coll_tuned_reduce_intra_dec_dynamic);
         COLL_TUNED_EXECUTE_IF_DYNAMIC(tuned_module, REDUCESCATTER,
@@ -247,7 +262,15 @@ tuned_module_enable( mca_coll_base_module_t *module,
         COLL_TUNED_EXECUTE_IF_DYNAMIC(tuned_module, SCATTER,
                                       tuned_module->super.coll_scatter    = ompi_coll_tuned_scatter_intra_dec_dynamic);
         COLL_TUNED_EXECUTE_IF_DYNAMIC(tuned_module, SCATTERV,
-                                      tuned_module->super.coll_scatterv   = NULL);
+                                      tuned_module->super.coll_scatterv   = ompi_coll_tuned_scatterv_intra_dec_dynamic);
+    }
+
+    /* A reproducible allreduce requested by the communicator (algorithm 9)
+     * overrides the other decisions */
+    if (ompi_coll_base_comm_reproducible(comm)) {
+        OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:module_init reproducible allreduce"));
+        tuned_module->user_forced[ALLREDUCE].algorithm = 9;
+        tuned_module->super.coll_allreduce = ompi_coll_tuned_allreduce_intra_dec_dynamic;
     }
 
     /* general n fan out tree */
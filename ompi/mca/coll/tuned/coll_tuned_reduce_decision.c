@@ -152,31 +152,50 @@ int ompi_coll_tuned_reduce_intra_do_this(const void *sbuf, void* rbuf, int count
                                          int algorithm, int faninout,
                                          int segsize, int max_requests )
 {
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
     OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:reduce_intra_do_this selected algorithm %d topo faninout %d segsize %d",
                  algorithm, faninout, segsize));
 
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(REDUCE, algorithm, comm);
     switch (algorithm) {
     case (0):  return ompi_coll_tuned_reduce_intra_dec_fixed(sbuf, rbuf, count, dtype,
                                                              op, root, comm, module);
-    case (1):  return ompi_coll_base_reduce_intra_basic_linear(sbuf, rbuf, count, dtype,
-                                                               op, root, comm, module);
-    case (2):  return ompi_coll_base_reduce_intra_chain(sbuf, rbuf, count, dtype,
-                                                        op, root, comm, module,
-                                                        segsize, faninout, max_requests);
-    case (3):  return ompi_coll_base_reduce_intra_pipeline(sbuf, rbuf, count, dtype,
-                                                           op, root, comm, module,
-                                                           segsize, max_requests);
-    case (4):  return ompi_coll_base_reduce_intra_binary(sbuf, rbuf, count, dtype,
-                                                         op, root, comm, module,
-                                                         segsize, max_requests);
-    case (5):  return ompi_coll_base_reduce_intra_binomial(sbuf, rbuf, count, dtype,
-                                                           op, root, comm, module,
-                                                           segsize, max_requests);
-    case (6):  return ompi_coll_base_reduce_intra_in_order_binary(sbuf, rbuf, count, dtype,
-                                                                  op, root, comm, module,
-                                                                  segsize, max_requests);
-    case (7):  return ompi_coll_base_reduce_intra_redscat_gather(sbuf, rbuf, count, dtype,
-                                                                  op, root, comm, module);
+    case (1):
+        COLL_TUNED_ALG_RETURN(REDUCE, algorithm, cycles,
+                              ompi_coll_base_reduce_intra_basic_linear(sbuf, rbuf, count, dtype,
+                                                                       op, root, comm, module));
+    case (2):
+        COLL_TUNED_ALG_RETURN(REDUCE, algorithm, cycles,
+                              ompi_coll_base_reduce_intra_chain(sbuf, rbuf, count, dtype,
+                                                                op, root, comm, module,
+                                                                segsize, faninout, max_requests));
+    case (3):
+        COLL_TUNED_ALG_RETURN(REDUCE, algorithm, cycles,
+                              ompi_coll_base_reduce_intra_pipeline(sbuf, rbuf, count, dtype,
+                                                                   op, root, comm, module,
+                                                                   segsize, max_requests));
+    case (4):
+        COLL_TUNED_ALG_RETURN(REDUCE, algorithm, cycles,
+                              ompi_coll_base_reduce_intra_binary(sbuf, rbuf, count, dtype,
+                                                                 op, root, comm, module,
+                                                                 segsize, max_requests));
+    case (5):
+        COLL_TUNED_ALG_RETURN(REDUCE, algorithm, cycles,
+                              ompi_coll_base_reduce_intra_binomial(sbuf, rbuf, count, dtype,
+                                                                   op, root, comm, module,
+                                                                   segsize, max_requests));
+    case (6):
+        COLL_TUNED_ALG_RETURN(REDUCE, algorithm, cycles,
+                              ompi_coll_base_reduce_intra_in_order_binary(sbuf, rbuf, count, dtype,
+                                                                          op, root, comm, module,
+                                                                          segsize, max_requests));
+    case (7):
+        COLL_TUNED_ALG_RETURN(REDUCE, algorithm, cycles,
+                              ompi_coll_base_reduce_intra_redscat_gather(sbuf, rbuf, count, dtype,
+                                                                          op, root, comm, module));
     } /* switch */
     OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:reduce_intra_do_this attempt to select algorithm %d when only 0-%d is valid?",
                  algorithm, ompi_coll_tuned_forced_max_algorithms[REDUCE]));
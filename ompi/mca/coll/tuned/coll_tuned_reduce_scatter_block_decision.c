@@ -32,6 +32,7 @@
 static int coll_tuned_reduce_scatter_block_forced_algorithm = 0;
 static int coll_tuned_reduce_scatter_block_segment_size = 0;
 static int coll_tuned_reduce_scatter_block_tree_fanout;
+static int coll_tuned_reduce_scatter_block_chain_fanout;
 
 /* valid values for coll_tuned_reduce_scatter_blokc_forced_algorithm */
 static const mca_base_var_enum_value_t reduce_scatter_block_algorithms[] = {
@@ -40,6 +41,7 @@ static const mca_base_var_enum_value_t reduce_scatter_block_algorithms[] = {
     {2, "recursive_doubling"},
     {3, "recursive_halving"},
     {4, "butterfly"},
+    {5, "k_bruck"},
     {0, NULL}
 };
 
@@ -80,7 +82,7 @@ int ompi_coll_tuned_reduce_scatter_block_intra_check_forced_init (coll_tuned_for
                                         "reduce_scatter_block_algorithm",
                                         "Which reduce reduce_scatter_block algorithm is used. "
                                         "Can be locked down to choice of: 0 ignore, 1 basic_linear, 2 recursive_doubling, "
-                                        "3 recursive_halving, 4 butterfly. "
+                                        "3 recursive_halving, 4 butterfly, 5 k-port bruck (radix from the chain fanout). "
                                         "Only relevant if coll_tuned_use_dynamic_rules is true.",
                                         MCA_BASE_VAR_TYPE_INT, new_enum, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                         OPAL_INFO_LVL_5,
@@ -111,6 +113,16 @@ int ompi_coll_tuned_reduce_scatter_block_intra_check_forced_init (coll_tuned_for
                                         MCA_BASE_VAR_SCOPE_ALL,
                                         &coll_tuned_reduce_scatter_block_tree_fanout);
 
+    coll_tuned_reduce_scatter_block_chain_fanout = ompi_coll_tuned_init_chain_fanout; /* get system wide default */
+    mca_param_indices->chain_fanout_param_index =
+      mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
+                                      "reduce_scatter_block_algorithm_chain_fanout",
+                                      "Fanout for chains used for reduce_scatter_block algorithms. Only has meaning if algorithm is forced and supports chain topo based operation. The k-port bruck algorithm uses it as its radix.",
+                                      MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                      OPAL_INFO_LVL_5,
+                                      MCA_BASE_VAR_SCOPE_ALL,
+                                      &coll_tuned_reduce_scatter_block_chain_fanout);
+
     return (MPI_SUCCESS);
 }
 
@@ -122,20 +134,37 @@ int ompi_coll_tuned_reduce_scatter_block_intra_do_this(const void *sbuf, void *r
                                                        mca_coll_base_module_t *module,
                                                        int algorithm, int faninout, int segsize)
 {
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
     OPAL_OUTPUT((ompi_coll_tuned_stream, "coll:tuned:reduce_scatter_block_intra_do_this selected algorithm %d topo faninout %d segsize %d",
                  algorithm, faninout, segsize));
 
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(REDUCESCATTERBLOCK, algorithm, comm);
     switch (algorithm) {
     case (0): return ompi_coll_tuned_reduce_scatter_block_intra_dec_fixed(sbuf, rbuf, rcount,
                                                                           dtype, op, comm, module);
-    case (1): return ompi_coll_base_reduce_scatter_block_basic_linear(sbuf, rbuf, rcount,
-                                                                      dtype, op, comm, module);
-    case (2): return ompi_coll_base_reduce_scatter_block_intra_recursivedoubling(sbuf, rbuf, rcount,
-                                                                                 dtype, op, comm, module);
-    case (3): return ompi_coll_base_reduce_scatter_block_intra_recursivehalving(sbuf, rbuf, rcount,
-                                                                                dtype, op, comm, module);
-    case (4): return ompi_coll_base_reduce_scatter_block_intra_butterfly(sbuf, rbuf, rcount, dtype, op, comm,
-                                                                         module);
+    case (1):
+        COLL_TUNED_ALG_RETURN(REDUCESCATTERBLOCK, algorithm, cycles,
+                              ompi_coll_base_reduce_scatter_block_basic_linear(sbuf, rbuf, rcount,
+                                                                               dtype, op, comm, module));
+    case (2):
+        COLL_TUNED_ALG_RETURN(REDUCESCATTERBLOCK, algorithm, cycles,
+                              ompi_coll_base_reduce_scatter_block_intra_recursivedoubling(sbuf, rbuf, rcount,
+                                                                                          dtype, op, comm, module));
+    case (3):
+        COLL_TUNED_ALG_RETURN(REDUCESCATTERBLOCK, algorithm, cycles,
+                              ompi_coll_base_reduce_scatter_block_intra_recursivehalving(sbuf, rbuf, rcount,
+                                                                                         dtype, op, comm, module));
+    case (4):
+        COLL_TUNED_ALG_RETURN(REDUCESCATTERBLOCK, algorithm, cycles,
+                              ompi_coll_base_reduce_scatter_block_intra_butterfly(sbuf, rbuf, rcount, dtype, op, comm,
+                                                                                  module));
+    case (5):
+        COLL_TUNED_ALG_RETURN(REDUCESCATTERBLOCK, algorithm, cycles,
+                              ompi_coll_base_reduce_scatter_block_intra_k_bruck(sbuf, rbuf, rcount, dtype, op, comm,
+                                                                                module, faninout));
     } /* switch */
     OPAL_OUTPUT((ompi_coll_tuned_stream, "coll:tuned:reduce_scatter_block_intra_do_this attempt to select algorithm %d when only 0-%d is valid?",
                  algorithm, ompi_coll_tuned_forced_max_algorithms[REDUCESCATTERBLOCK]));
@@ -39,6 +39,7 @@ static const mca_base_var_enum_value_t reduce_scatter_algorithms[] = {
     {2, "recursive_halving"},
     {3, "ring"},
     {4, "butterfly"},
+    {5, "k_bruck"},
     {0, NULL}
 };
 
@@ -77,7 +78,7 @@ int ompi_coll_tuned_reduce_scatter_intra_check_forced_init (coll_tuned_force_alg
     mca_param_indices->algorithm_param_index =
         mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
                                         "reduce_scatter_algorithm",
-                                        "Which reduce reduce_scatter algorithm is used. Can be locked down to choice of: 0 ignore, 1 non-overlapping (Reduce + Scatterv), 2 recursive halving, 3 ring, 4 butterfly. "
+                                        "Which reduce reduce_scatter algorithm is used. Can be locked down to choice of: 0 ignore, 1 non-overlapping (Reduce + Scatterv), 2 recursive halving, 3 ring, 4 butterfly, 5 k-port bruck (radix from the fanout). "
                                         "Only relevant if coll_tuned_use_dynamic_rules is true.",
                                         MCA_BASE_VAR_TYPE_INT, new_enum, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                         OPAL_INFO_LVL_5,
@@ -112,7 +113,7 @@ int ompi_coll_tuned_reduce_scatter_intra_check_forced_init (coll_tuned_force_alg
     mca_param_indices->chain_fanout_param_index =
       mca_base_component_var_register(&mca_coll_tuned_component.super.collm_version,
                                       "reduce_scatter_algorithm_chain_fanout",
-                                      "Fanout for chains used for reduce_scatter algorithms. Only has meaning if algorithm is forced and supports chain topo based operation.",
+                                      "Fanout for chains used for reduce_scatter algorithms. Only has meaning if algorithm is forced and supports chain topo based operation. The k-port bruck algorithm uses it as its radix.",
                                       MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                       OPAL_INFO_LVL_5,
                                       MCA_BASE_VAR_SCOPE_ALL,
@@ -129,20 +130,37 @@ int ompi_coll_tuned_reduce_scatter_intra_do_this(const void *sbuf, void* rbuf,
                                                  mca_coll_base_module_t *module,
                                                  int algorithm, int faninout, int segsize)
 {
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
     OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:reduce_scatter_intra_do_this selected algorithm %d topo faninout %d segsize %d",
                  algorithm, faninout, segsize));
 
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(REDUCESCATTER, algorithm, comm);
     switch (algorithm) {
     case (0): return ompi_coll_tuned_reduce_scatter_intra_dec_fixed(sbuf, rbuf, rcounts,
                                                                     dtype, op, comm, module);
-    case (1): return ompi_coll_base_reduce_scatter_intra_nonoverlapping(sbuf, rbuf, rcounts,
-                                                                        dtype, op, comm, module);
-    case (2): return ompi_coll_base_reduce_scatter_intra_basic_recursivehalving(sbuf, rbuf, rcounts,
-                                                                                dtype, op, comm, module);
-    case (3): return ompi_coll_base_reduce_scatter_intra_ring(sbuf, rbuf, rcounts,
-                                                              dtype, op, comm, module);
-    case (4): return ompi_coll_base_reduce_scatter_intra_butterfly(sbuf, rbuf, rcounts,
-                                                                   dtype, op, comm, module);
+    case (1):
+        COLL_TUNED_ALG_RETURN(REDUCESCATTER, algorithm, cycles,
+                              ompi_coll_base_reduce_scatter_intra_nonoverlapping(sbuf, rbuf, rcounts,
+                                                                                 dtype, op, comm, module));
+    case (2):
+        COLL_TUNED_ALG_RETURN(REDUCESCATTER, algorithm, cycles,
+                              ompi_coll_base_reduce_scatter_intra_basic_recursivehalving(sbuf, rbuf, rcounts,
+                                                                                         dtype, op, comm, module));
+    case (3):
+        COLL_TUNED_ALG_RETURN(REDUCESCATTER, algorithm, cycles,
+                              ompi_coll_base_reduce_scatter_intra_ring(sbuf, rbuf, rcounts,
+                                                                       dtype, op, comm, module));
+    case (4):
+        COLL_TUNED_ALG_RETURN(REDUCESCATTER, algorithm, cycles,
+                              ompi_coll_base_reduce_scatter_intra_butterfly(sbuf, rbuf, rcounts,
+                                                                            dtype, op, comm, module));
+    case (5):
+        COLL_TUNED_ALG_RETURN(REDUCESCATTER, algorithm, cycles,
+                              ompi_coll_base_reduce_scatter_intra_k_bruck(sbuf, rbuf, rcounts,
+                                                                          dtype, op, comm, module, faninout));
     } /* switch */
     OPAL_OUTPUT((ompi_coll_tuned_stream,"coll:tuned:reduce_scatter_intra_do_this attempt to select algorithm %d when only 0-%d is valid?",
                  algorithm, ompi_coll_tuned_forced_max_algorithms[REDUCESCATTER]));
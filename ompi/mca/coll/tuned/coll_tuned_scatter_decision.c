@@ -162,28 +162,36 @@ ompi_coll_tuned_scatter_intra_do_this(const void *sbuf, int scount,
                                       mca_coll_base_module_t *module,
                                       int algorithm, int faninout, int segsize)
 {
+#if SPC_ENABLE == 1
+    opal_timer_t cycles;
+#endif
     OPAL_OUTPUT((ompi_coll_tuned_stream,
                  "coll:tuned:scatter_intra_do_this selected algorithm %d topo faninout %d segsize %d",
                  algorithm, faninout, segsize));
 
+    SPC_HIST_START(&cycles);
+    ompi_coll_tuned_event_raise(SCATTER, algorithm, comm);
     switch (algorithm) {
     case (0):
         return ompi_coll_tuned_scatter_intra_dec_fixed(sbuf, scount, sdtype,
                                                        rbuf, rcount, rdtype,
                                                        root, comm, module);
     case (1):
-        return ompi_coll_base_scatter_intra_basic_linear(sbuf, scount, sdtype,
-                                                         rbuf, rcount, rdtype,
-                                                         root, comm, module);
+        COLL_TUNED_ALG_RETURN(SCATTER, algorithm, cycles,
+                              ompi_coll_base_scatter_intra_basic_linear(sbuf, scount, sdtype,
+                                                                        rbuf, rcount, rdtype,
+                                                                        root, comm, module));
     case (2):
-        return ompi_coll_base_scatter_intra_binomial(sbuf, scount, sdtype,
-                                                     rbuf, rcount, rdtype,
-                                                     root, comm, module);
+        COLL_TUNED_ALG_RETURN(SCATTER, algorithm, cycles,
+                              ompi_coll_base_scatter_intra_binomial(sbuf, scount, sdtype,
+                                                                    rbuf, rcount, rdtype,
+                                                                    root, comm, module));
     case (3):
-        return ompi_coll_base_scatter_intra_linear_nb(sbuf, scount, sdtype,
-                                                      rbuf, rcount, rdtype,
-                                                      root, comm, module,
-                                                      ompi_coll_tuned_scatter_blocking_send_ratio);
+        COLL_TUNED_ALG_RETURN(SCATTER, algorithm, cycles,
+                              ompi_coll_base_scatter_intra_linear_nb(sbuf, scount, sdtype,
+                                                                     rbuf, rcount, rdtype,
+                                                                     root, comm, module,
+                                                                     ompi_coll_tuned_scatter_blocking_send_ratio));
     } /* switch */
     OPAL_OUTPUT((ompi_coll_tuned_stream,
                  "coll:tuned:scatter_intra_do_this attempt to select algorithm %d when only 0-%d is valid?",
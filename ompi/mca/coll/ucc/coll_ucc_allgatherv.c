@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2021 Mellanox Technologies. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "coll_ucc_common.h"
+
+static inline ucc_status_t mca_coll_ucc_allgatherv_init_common(const void *sbuf, int scount,
+                                                 struct ompi_datatype_t *sdtype, void* rbuf,
+                                                 const int *rcounts, const int *rdisps,
+                                                 struct ompi_datatype_t *rdtype,
+                                                 mca_coll_ucc_module_t *ucc_module,
+                                                 ucc_coll_req_h *req,
+                                                 mca_coll_ucc_req_t *coll_req)
+{
+    ucc_datatype_t         ucc_sdt = COLL_UCC_DT_UNSUPPORTED, ucc_rdt;
+
+    /* the send datatype is not significant in place */
+    if (MPI_IN_PLACE != sbuf) {
+        ucc_sdt = ompi_dtype_to_ucc_dtype(sdtype);
+        if (OPAL_UNLIKELY(COLL_UCC_DT_UNSUPPORTED == ucc_sdt)) {
+            UCC_VERBOSE(5, "ompi_datatype is not supported: dtype = %s",
+                        sdtype->super.name);
+            goto fallback;
+        }
+    }
+    ucc_rdt = ompi_dtype_to_ucc_dtype(rdtype);
+    if (OPAL_UNLIKELY(COLL_UCC_DT_UNSUPPORTED == ucc_rdt)) {
+        UCC_VERBOSE(5, "ompi_datatype is not supported: dtype = %s",
+                    rdtype->super.name);
+        goto fallback;
+    }
+
+    ucc_coll_args_t coll = {
+        .mask      = UCC_COLL_ARGS_FIELD_FLAGS,
+        .flags     = UCC_COLL_ARGS_FLAG_CONTIG_DST_BUFFER,
+        .coll_type = UCC_COLL_TYPE_ALLGATHERV,
+        .src.info = {
+            .buffer   = (void*)sbuf,
+            .count    = scount,
+            .datatype = ucc_sdt,
+            .mem_type = UCC_MEMORY_TYPE_UNKNOWN
+        },
+        .dst.info_v = {
+            .buffer        = rbuf,
+            .counts        = (ucc_count_t*)rcounts,
+            .displacements = (ucc_aint_t*)rdisps,
+            .datatype      = ucc_rdt,
+            .mem_type      = UCC_MEMORY_TYPE_UNKNOWN
+        }
+    };
+    if (MPI_IN_PLACE == sbuf) {
+        coll.mask  |= UCC_COLL_ARGS_FIELD_FLAGS;
+        coll.flags |= UCC_COLL_ARGS_FLAG_IN_PLACE;
+    }
+    COLL_UCC_REQ_INIT(coll_req, req, coll, ucc_module);
+    return UCC_OK;
+fallback:
+    return UCC_ERR_NOT_SUPPORTED;
+}
+
+int mca_coll_ucc_allgatherv(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                            void* rbuf, const int *rcounts, const int *rdisps,
+                            struct ompi_datatype_t *rdtype, struct ompi_communicator_t *comm,
+                            mca_coll_base_module_t *module)
+{
+    mca_coll_ucc_module_t *ucc_module = (mca_coll_ucc_module_t*)module;
+    ucc_coll_req_h         req;
+
+    UCC_VERBOSE(3, "running ucc allgatherv");
+    COLL_UCC_CHECK(mca_coll_ucc_allgatherv_init_common(sbuf, scount, sdtype, rbuf, rcounts, rdisps, rdtype,
+                                                       ucc_module, &req, NULL));
+    COLL_UCC_CHECK(ucc_collective_post(req));
+    COLL_UCC_CHECK(coll_ucc_req_wait(req));
+    return OMPI_SUCCESS;
+fallback:
+    UCC_VERBOSE(3, "running fallback allgatherv");
+    return ucc_module->previous_allgatherv(sbuf, scount, sdtype, rbuf, rcounts, rdisps, rdtype, comm,
+                                           ucc_module->previous_allgatherv_module);
+}
+
+int mca_coll_ucc_iallgatherv(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                             void* rbuf, const int *rcounts, const int *rdisps,
+                             struct ompi_datatype_t *rdtype, struct ompi_communicator_t *comm,
+                             ompi_request_t** request, mca_coll_base_module_t *module)
+{
+    mca_coll_ucc_module_t *ucc_module = (mca_coll_ucc_module_t*)module;
+    ucc_coll_req_h         req;
+    mca_coll_ucc_req_t    *coll_req;
+
+    UCC_VERBOSE(3, "running ucc iallgatherv");
+    COLL_UCC_GET_REQ(coll_req);
+    COLL_UCC_CHECK(mca_coll_ucc_allgatherv_init_common(sbuf, scount, sdtype, rbuf, rcounts, rdisps, rdtype,
+                                                       ucc_module, &req, coll_req));
+    COLL_UCC_CHECK(ucc_collective_post(req));
+    *request = &coll_req->super;
+    return OMPI_SUCCESS;
+fallback:
+    UCC_VERBOSE(3, "running fallback iallgatherv");
+    return ucc_module->previous_iallgatherv(sbuf, scount, sdtype, rbuf, rcounts, rdisps, rdtype,
+                                            comm, request, ucc_module->previous_iallgatherv_module);
+}
+
+int mca_coll_ucc_allgatherv_init(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                                 void* rbuf, const int *rcounts, const int *rdisps,
+                                 struct ompi_datatype_t *rdtype,
+                                 struct ompi_communicator_t *comm, struct ompi_info_t *info,
+                                 ompi_request_t** request, mca_coll_base_module_t *module)
+{
+    mca_coll_ucc_module_t *ucc_module = (mca_coll_ucc_module_t*)module;
+    ucc_coll_req_h         req;
+    mca_coll_ucc_req_t    *coll_req = NULL;
+
+    UCC_VERBOSE(3, "running ucc allgatherv_init");
+    COLL_UCC_GET_PERSISTENT_REQ(coll_req);
+    COLL_UCC_CHECK(mca_coll_ucc_allgatherv_init_common(sbuf, scount, sdtype, rbuf, rcounts, rdisps, rdtype,
+                                                       ucc_module, &req, coll_req));
+    *request = &coll_req->super;
+    return OMPI_SUCCESS;
+fallback:
+    UCC_VERBOSE(3, "running fallback allgatherv_init");
+    COLL_UCC_RELEASE_REQ(coll_req);
+    return ucc_module->previous_allgatherv_init(sbuf, scount, sdtype, rbuf, rcounts, rdisps, rdtype,
+                                                comm, info, request,
+                                                ucc_module->previous_allgatherv_init_module);
+}
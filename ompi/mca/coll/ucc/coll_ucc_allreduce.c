@@ -9,7 +9,7 @@
 
 #include "coll_ucc_common.h"
 
-static inline ucc_status_t mca_coll_ucc_allreduce_init(const void *sbuf, void *rbuf, int count,
+static inline ucc_status_t mca_coll_ucc_allreduce_init_common(const void *sbuf, void *rbuf, int count,
                                                        struct ompi_datatype_t *dtype,
                                                        struct ompi_op_t *op, mca_coll_ucc_module_t *ucc_module,
                                                        ucc_coll_req_h *req,
@@ -66,7 +66,7 @@ int mca_coll_ucc_allreduce(const void *sbuf, void *rbuf, int count,
     ucc_coll_req_h         req;
 
     UCC_VERBOSE(3, "running ucc allreduce");
-    COLL_UCC_CHECK(mca_coll_ucc_allreduce_init(sbuf, rbuf, count, dtype, op,
+    COLL_UCC_CHECK(mca_coll_ucc_allreduce_init_common(sbuf, rbuf, count, dtype, op,
                                                ucc_module, &req, NULL));
     COLL_UCC_CHECK(ucc_collective_post(req));
     COLL_UCC_CHECK(coll_ucc_req_wait(req));
@@ -89,7 +89,7 @@ int mca_coll_ucc_iallreduce(const void *sbuf, void *rbuf, int count,
 
     UCC_VERBOSE(3, "running ucc iallreduce");
     COLL_UCC_GET_REQ(coll_req);
-    COLL_UCC_CHECK(mca_coll_ucc_allreduce_init(sbuf, rbuf, count, dtype, op,
+    COLL_UCC_CHECK(mca_coll_ucc_allreduce_init_common(sbuf, rbuf, count, dtype, op,
                                                ucc_module, &req, coll_req));
     COLL_UCC_CHECK(ucc_collective_post(req));
     *request = &coll_req->super;
@@ -99,3 +99,24 @@ fallback:
     return ucc_module->previous_iallreduce(sbuf, rbuf, count, dtype, op,
                                            comm, request, ucc_module->previous_iallreduce_module);
 }
+
+int mca_coll_ucc_allreduce_init(const void *sbuf, void *rbuf, int count,
+                                struct ompi_datatype_t *dtype, struct ompi_op_t *op,
+                                struct ompi_communicator_t *comm, struct ompi_info_t *info,
+                                ompi_request_t** request, mca_coll_base_module_t *module)
+{
+    mca_coll_ucc_module_t *ucc_module = (mca_coll_ucc_module_t*)module;
+    ucc_coll_req_h         req;
+    mca_coll_ucc_req_t    *coll_req = NULL;
+
+    UCC_VERBOSE(3, "running ucc allreduce_init");
+    COLL_UCC_GET_PERSISTENT_REQ(coll_req);
+    COLL_UCC_CHECK(mca_coll_ucc_allreduce_init_common(sbuf, rbuf, count, dtype, op, ucc_module, &req, coll_req));
+    *request = &coll_req->super;
+    return OMPI_SUCCESS;
+fallback:
+    UCC_VERBOSE(3, "running fallback allreduce_init");
+    COLL_UCC_RELEASE_REQ(coll_req);
+    return ucc_module->previous_allreduce_init(sbuf, rbuf, count, dtype, op, comm, info, request,
+                                               ucc_module->previous_allreduce_init_module);
+}
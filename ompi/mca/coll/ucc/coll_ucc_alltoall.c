@@ -9,7 +9,7 @@
 
 #include "coll_ucc_common.h"
 
-static inline ucc_status_t mca_coll_ucc_alltoall_init(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+static inline ucc_status_t mca_coll_ucc_alltoall_init_common(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
                                                       void* rbuf, int rcount, struct ompi_datatype_t *rdtype,
                                                       mca_coll_ucc_module_t *ucc_module,
                                                       ucc_coll_req_h *req,
@@ -69,7 +69,7 @@ int mca_coll_ucc_alltoall(const void *sbuf, int scount, struct ompi_datatype_t *
     ucc_coll_req_h         req;
 
     UCC_VERBOSE(3, "running ucc alltoall");
-    COLL_UCC_CHECK(mca_coll_ucc_alltoall_init(sbuf, scount, sdtype,
+    COLL_UCC_CHECK(mca_coll_ucc_alltoall_init_common(sbuf, scount, sdtype,
                                               rbuf, rcount, rdtype,
                                               ucc_module, &req, NULL));
     COLL_UCC_CHECK(ucc_collective_post(req));
@@ -93,7 +93,7 @@ int mca_coll_ucc_ialltoall(const void *sbuf, int scount, struct ompi_datatype_t
 
     UCC_VERBOSE(3, "running ucc ialltoall");
     COLL_UCC_GET_REQ(coll_req);
-    COLL_UCC_CHECK(mca_coll_ucc_alltoall_init(sbuf, scount, sdtype,
+    COLL_UCC_CHECK(mca_coll_ucc_alltoall_init_common(sbuf, scount, sdtype,
                                               rbuf, rcount, rdtype,
                                               ucc_module, &req, coll_req));
     COLL_UCC_CHECK(ucc_collective_post(req));
@@ -104,3 +104,25 @@ fallback:
     return ucc_module->previous_ialltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype,
                                           comm, request, ucc_module->previous_ialltoall_module);
 }
+
+int mca_coll_ucc_alltoall_init(const void *sbuf, int scount, struct ompi_datatype_t *sdtype,
+                               void* rbuf, int rcount, struct ompi_datatype_t *rdtype,
+                               struct ompi_communicator_t *comm, struct ompi_info_t *info,
+                               ompi_request_t** request, mca_coll_base_module_t *module)
+{
+    mca_coll_ucc_module_t *ucc_module = (mca_coll_ucc_module_t*)module;
+    ucc_coll_req_h         req;
+    mca_coll_ucc_req_t    *coll_req = NULL;
+
+    UCC_VERBOSE(3, "running ucc alltoall_init");
+    COLL_UCC_GET_PERSISTENT_REQ(coll_req);
+    COLL_UCC_CHECK(mca_coll_ucc_alltoall_init_common(sbuf, scount, sdtype, rbuf, rcount, rdtype, ucc_module, &req,
+                                                     coll_req));
+    *request = &coll_req->super;
+    return OMPI_SUCCESS;
+fallback:
+    UCC_VERBOSE(3, "running fallback alltoall_init");
+    COLL_UCC_RELEASE_REQ(coll_req);
+    return ucc_module->previous_alltoall_init(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, info,
+                                              request, ucc_module->previous_alltoall_init_module);
+}
@@ -9,7 +9,7 @@
 
 #include "coll_ucc_common.h"
 
-static inline ucc_status_t mca_coll_ucc_alltoallv_init(const void *sbuf, const int *scounts,
+static inline ucc_status_t mca_coll_ucc_alltoallv_init_common(const void *sbuf, const int *scounts,
                                                        const int *sdisps, struct ompi_datatype_t *sdtype,
                                                        void* rbuf, const int *rcounts, const int *rdisps,
                                                        struct ompi_datatype_t *rdtype,
@@ -73,7 +73,7 @@ int mca_coll_ucc_alltoallv(const void *sbuf, const int *scounts,
 
     UCC_VERBOSE(3, "running ucc alltoallv");
 
-    COLL_UCC_CHECK(mca_coll_ucc_alltoallv_init(sbuf, scounts, sdisps, sdtype,
+    COLL_UCC_CHECK(mca_coll_ucc_alltoallv_init_common(sbuf, scounts, sdisps, sdtype,
                                                rbuf, rcounts, rdisps, rdtype,
                                                ucc_module, &req, NULL));
     COLL_UCC_CHECK(ucc_collective_post(req));
@@ -100,7 +100,7 @@ int mca_coll_ucc_ialltoallv(const void *sbuf, const int *scounts,
 
     UCC_VERBOSE(3, "running ucc ialltoallv");
     COLL_UCC_GET_REQ(coll_req);
-    COLL_UCC_CHECK(mca_coll_ucc_alltoallv_init(sbuf, scounts, sdisps, sdtype,
+    COLL_UCC_CHECK(mca_coll_ucc_alltoallv_init_common(sbuf, scounts, sdisps, sdtype,
                                                rbuf, rcounts, rdisps, rdtype,
                                                ucc_module, &req, coll_req));
     COLL_UCC_CHECK(ucc_collective_post(req));
@@ -112,3 +112,27 @@ fallback:
                                           rbuf, rcounts, rdisps, rdtype,
                                            comm, request, ucc_module->previous_ialltoallv_module);
 }
+
+int mca_coll_ucc_alltoallv_init(const void *sbuf, const int *scounts, const int *sdisps,
+                                struct ompi_datatype_t *sdtype, void* rbuf, const int *rcounts,
+                                const int *rdisps, struct ompi_datatype_t *rdtype,
+                                struct ompi_communicator_t *comm, struct ompi_info_t *info,
+                                ompi_request_t** request, mca_coll_base_module_t *module)
+{
+    mca_coll_ucc_module_t *ucc_module = (mca_coll_ucc_module_t*)module;
+    ucc_coll_req_h         req;
+    mca_coll_ucc_req_t    *coll_req = NULL;
+
+    UCC_VERBOSE(3, "running ucc alltoallv_init");
+    COLL_UCC_GET_PERSISTENT_REQ(coll_req);
+    COLL_UCC_CHECK(mca_coll_ucc_alltoallv_init_common(sbuf, scounts, sdisps, sdtype, rbuf, rcounts, rdisps, rdtype,
+                                                      ucc_module, &req, coll_req));
+    *request = &coll_req->super;
+    return OMPI_SUCCESS;
+fallback:
+    UCC_VERBOSE(3, "running fallback alltoallv_init");
+    COLL_UCC_RELEASE_REQ(coll_req);
+    return ucc_module->previous_alltoallv_init(sbuf, scounts, sdisps, sdtype, rbuf, rcounts, rdisps,
+                                               rdtype, comm, info, request,
+                                               ucc_module->previous_alltoallv_init_module);
+}
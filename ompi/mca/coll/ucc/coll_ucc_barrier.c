@@ -8,7 +8,7 @@
 
 #include "coll_ucc_common.h"
 
-static inline ucc_status_t mca_coll_ucc_barrier_init(mca_coll_ucc_module_t *ucc_module,
+static inline ucc_status_t mca_coll_ucc_barrier_init_common(mca_coll_ucc_module_t *ucc_module,
                                                      ucc_coll_req_h *req,
                                                      mca_coll_ucc_req_t *coll_req)
 {
@@ -29,7 +29,7 @@ int mca_coll_ucc_barrier(struct ompi_communicator_t *comm,
     ucc_coll_req_h         req;
 
     UCC_VERBOSE(3, "running ucc barrier");
-    COLL_UCC_CHECK(mca_coll_ucc_barrier_init(ucc_module, &req, NULL));
+    COLL_UCC_CHECK(mca_coll_ucc_barrier_init_common(ucc_module, &req, NULL));
     COLL_UCC_CHECK(ucc_collective_post(req));
     COLL_UCC_CHECK(coll_ucc_req_wait(req));
     return OMPI_SUCCESS;
@@ -48,7 +48,7 @@ int mca_coll_ucc_ibarrier(struct ompi_communicator_t *comm,
 
     UCC_VERBOSE(3, "running ucc ibarrier");
     COLL_UCC_GET_REQ(coll_req);
-    COLL_UCC_CHECK(mca_coll_ucc_barrier_init(ucc_module, &req, coll_req));
+    COLL_UCC_CHECK(mca_coll_ucc_barrier_init_common(ucc_module, &req, coll_req));
     COLL_UCC_CHECK(ucc_collective_post(req));
     *request = &coll_req->super;
     return OMPI_SUCCESS;
@@ -57,3 +57,22 @@ fallback:
     return ucc_module->previous_ibarrier(comm, request,
                                          ucc_module->previous_ibarrier_module);
 }
+
+int mca_coll_ucc_barrier_init(struct ompi_communicator_t *comm, struct ompi_info_t *info,
+                              ompi_request_t** request, mca_coll_base_module_t *module)
+{
+    mca_coll_ucc_module_t *ucc_module = (mca_coll_ucc_module_t*)module;
+    ucc_coll_req_h         req;
+    mca_coll_ucc_req_t    *coll_req = NULL;
+
+    UCC_VERBOSE(3, "running ucc barrier_init");
+    COLL_UCC_GET_PERSISTENT_REQ(coll_req);
+    COLL_UCC_CHECK(mca_coll_ucc_barrier_init_common(ucc_module, &req, coll_req));
+    *request = &coll_req->super;
+    return OMPI_SUCCESS;
+fallback:
+    UCC_VERBOSE(3, "running fallback barrier_init");
+    COLL_UCC_RELEASE_REQ(coll_req);
+    return ucc_module->previous_barrier_init(comm, info, request,
+                                             ucc_module->previous_barrier_init_module);
+}
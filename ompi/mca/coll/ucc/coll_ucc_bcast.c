@@ -8,7 +8,7 @@
 
 #include "coll_ucc_common.h"
 
-static inline ucc_status_t mca_coll_ucc_bcast_init(void *buf, int count, struct ompi_datatype_t *dtype,
+static inline ucc_status_t mca_coll_ucc_bcast_init_common(void *buf, int count, struct ompi_datatype_t *dtype,
                                                    int root, mca_coll_ucc_module_t *ucc_module,
                                                    ucc_coll_req_h *req,
                                                    mca_coll_ucc_req_t *coll_req)
@@ -43,7 +43,7 @@ int mca_coll_ucc_bcast(void *buf, int count, struct ompi_datatype_t *dtype,
     mca_coll_ucc_module_t *ucc_module = (mca_coll_ucc_module_t*)module;
     ucc_coll_req_h         req;
     UCC_VERBOSE(3, "running ucc bcast");
-    COLL_UCC_CHECK(mca_coll_ucc_bcast_init(buf, count, dtype, root,
+    COLL_UCC_CHECK(mca_coll_ucc_bcast_init_common(buf, count, dtype, root,
                                            ucc_module, &req, NULL));
     COLL_UCC_CHECK(ucc_collective_post(req));
     COLL_UCC_CHECK(coll_ucc_req_wait(req));
@@ -65,7 +65,7 @@ int mca_coll_ucc_ibcast(void *buf, int count, struct ompi_datatype_t *dtype,
 
     UCC_VERBOSE(3, "running ucc ibcast");
     COLL_UCC_GET_REQ(coll_req);
-    COLL_UCC_CHECK(mca_coll_ucc_bcast_init(buf, count, dtype, root,
+    COLL_UCC_CHECK(mca_coll_ucc_bcast_init_common(buf, count, dtype, root,
                                            ucc_module, &req, coll_req));
     COLL_UCC_CHECK(ucc_collective_post(req));
     *request = &coll_req->super;
@@ -75,3 +75,23 @@ fallback:
     return ucc_module->previous_ibcast(buf, count, dtype, root,
                                        comm, request, ucc_module->previous_ibcast_module);
 }
+
+int mca_coll_ucc_bcast_init(void *buf, int count, struct ompi_datatype_t *dtype, int root,
+                            struct ompi_communicator_t *comm, struct ompi_info_t *info,
+                            ompi_request_t** request, mca_coll_base_module_t *module)
+{
+    mca_coll_ucc_module_t *ucc_module = (mca_coll_ucc_module_t*)module;
+    ucc_coll_req_h         req;
+    mca_coll_ucc_req_t    *coll_req = NULL;
+
+    UCC_VERBOSE(3, "running ucc bcast_init");
+    COLL_UCC_GET_PERSISTENT_REQ(coll_req);
+    COLL_UCC_CHECK(mca_coll_ucc_bcast_init_common(buf, count, dtype, root, ucc_module, &req, coll_req));
+    *request = &coll_req->super;
+    return OMPI_SUCCESS;
+fallback:
+    UCC_VERBOSE(3, "running fallback bcast_init");
+    COLL_UCC_RELEASE_REQ(coll_req);
+    return ucc_module->previous_bcast_init(buf, count, dtype, root, comm, info, request,
+                                           ucc_module->previous_bcast_init_module);
+}
@@ -35,12 +35,45 @@
         _coll_req->super.req_type             = OMPI_REQUEST_COLL;      \
     } while(0)
 
+/* persistent requests are started by mca_coll_ucc_req_start, the ucc
+ * request is kept until the request is freed */
+#if HAVE_DECL_UCC_COLL_ARGS_FLAG_PERSISTENT
+#define COLL_UCC_GET_PERSISTENT_REQ(_coll_req) do {                     \
+        COLL_UCC_GET_REQ(_coll_req);                                    \
+        OMPI_REQUEST_INIT(&_coll_req->super, true);                     \
+        _coll_req->super.req_start = mca_coll_ucc_req_start;            \
+    } while(0)
+#else
+#define COLL_UCC_GET_PERSISTENT_REQ(_coll_req) do {                     \
+        goto fallback;                                                  \
+    } while(0)
+#endif
+
+#define COLL_UCC_RELEASE_REQ(_coll_req) do {                            \
+        if (NULL != (_coll_req)) {                                      \
+            opal_free_list_return(&mca_coll_ucc_component.requests,     \
+                                  (opal_free_list_item_t *)(_coll_req));\
+        }                                                               \
+    } while(0)
+
+#if HAVE_DECL_UCC_COLL_ARGS_FLAG_PERSISTENT
+#define COLL_UCC_SET_PERSISTENT(_coll_req, _coll) do {                  \
+        if (_coll_req && _coll_req->super.req_persistent) {             \
+            _coll.mask  |= UCC_COLL_ARGS_FIELD_FLAGS;                   \
+            _coll.flags |= UCC_COLL_ARGS_FLAG_PERSISTENT;               \
+        }                                                               \
+    } while(0)
+#else
+#define COLL_UCC_SET_PERSISTENT(_coll_req, _coll)
+#endif
+
 #define COLL_UCC_REQ_INIT(_coll_req, _req, _coll, _module) do{          \
         if (_coll_req) {                                                \
             _coll.mask   |= UCC_COLL_ARGS_FIELD_CB;                     \
             _coll.cb.cb   = mca_coll_ucc_completion;                    \
             _coll.cb.data = (void*)_coll_req;                           \
         }                                                               \
+        COLL_UCC_SET_PERSISTENT(_coll_req, _coll);                      \
         COLL_UCC_CHECK(ucc_collective_init(&_coll, _req,                \
                                            _module->ucc_team));         \
         if (_coll_req) {                                                \
@@ -63,6 +96,7 @@ static inline ucc_status_t coll_ucc_req_wait(ucc_coll_req_h req)
     return ucc_collective_finalize(req);
 }
 
+int mca_coll_ucc_req_start(size_t count, struct ompi_request_t **requests);
 int mca_coll_ucc_req_free(struct ompi_request_t **ompi_req);
 void mca_coll_ucc_completion(void *data, ucc_status_t status);
 
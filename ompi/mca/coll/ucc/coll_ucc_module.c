@@ -38,6 +38,38 @@ static void mca_coll_ucc_module_clear(mca_coll_ucc_module_t *ucc_module)
     ucc_module->previous_ialltoall  = NULL;
     ucc_module->previous_alltoallv  = NULL;
     ucc_module->previous_ialltoallv = NULL;
+    ucc_module->previous_reduce = NULL;
+    ucc_module->previous_ireduce = NULL;
+    ucc_module->previous_allgather = NULL;
+    ucc_module->previous_iallgather = NULL;
+    ucc_module->previous_allgatherv = NULL;
+    ucc_module->previous_iallgatherv = NULL;
+    ucc_module->previous_gather = NULL;
+    ucc_module->previous_igather = NULL;
+    ucc_module->previous_gatherv = NULL;
+    ucc_module->previous_igatherv = NULL;
+    ucc_module->previous_scatter = NULL;
+    ucc_module->previous_iscatter = NULL;
+    ucc_module->previous_scatterv = NULL;
+    ucc_module->previous_iscatterv = NULL;
+    ucc_module->previous_reduce_scatter = NULL;
+    ucc_module->previous_ireduce_scatter = NULL;
+    ucc_module->previous_reduce_scatter_block = NULL;
+    ucc_module->previous_ireduce_scatter_block = NULL;
+    ucc_module->previous_allreduce_init = NULL;
+    ucc_module->previous_barrier_init = NULL;
+    ucc_module->previous_bcast_init = NULL;
+    ucc_module->previous_alltoall_init = NULL;
+    ucc_module->previous_alltoallv_init = NULL;
+    ucc_module->previous_reduce_init = NULL;
+    ucc_module->previous_allgather_init = NULL;
+    ucc_module->previous_allgatherv_init = NULL;
+    ucc_module->previous_gather_init = NULL;
+    ucc_module->previous_gatherv_init = NULL;
+    ucc_module->previous_scatter_init = NULL;
+    ucc_module->previous_scatterv_init = NULL;
+    ucc_module->previous_reduce_scatter_init = NULL;
+    ucc_module->previous_reduce_scatter_block_init = NULL;
 }
 
 static void mca_coll_ucc_module_construct(mca_coll_ucc_module_t *ucc_module)
@@ -68,6 +100,38 @@ static void mca_coll_ucc_module_destruct(mca_coll_ucc_module_t *ucc_module)
     OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_ialltoall_module);
     OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_alltoallv_module);
     OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_ialltoallv_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_reduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_ireduce_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_allgather_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_iallgather_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_allgatherv_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_iallgatherv_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_gather_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_igather_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_gatherv_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_igatherv_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_scatter_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_iscatter_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_scatterv_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_iscatterv_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_reduce_scatter_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_ireduce_scatter_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_reduce_scatter_block_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_ireduce_scatter_block_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_allreduce_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_barrier_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_bcast_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_alltoall_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_alltoallv_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_reduce_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_allgather_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_allgatherv_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_gather_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_gatherv_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_scatter_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_scatterv_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_reduce_scatter_init_module);
+    OBJ_RELEASE_IF_NOT_NULL(ucc_module->previous_reduce_scatter_block_init_module);
     mca_coll_ucc_module_clear(ucc_module);
 }
 
@@ -80,6 +144,19 @@ static void mca_coll_ucc_module_destruct(mca_coll_ucc_module_t *ucc_module)
         OBJ_RETAIN(ucc_module->previous_ ## __api ## _module);                               \
     } while(0)
 
+/* the persistent collectives are optional, without them ucc does not provide its own */
+#define SAVE_PREV_INIT_COLL_API(__api) do {                                                  \
+        ucc_module->previous_ ## __api            = comm->c_coll->coll_ ## __api;            \
+        ucc_module->previous_ ## __api ## _module = comm->c_coll->coll_ ## __api ## _module; \
+        if (!comm->c_coll->coll_ ## __api || !comm->c_coll->coll_ ## __api ## _module) {     \
+            ucc_module->previous_ ## __api            = NULL;                                \
+            ucc_module->previous_ ## __api ## _module = NULL;                                \
+            ucc_module->super.coll_ ## __api          = NULL;                                \
+        } else {                                                                             \
+            OBJ_RETAIN(ucc_module->previous_ ## __api ## _module);                           \
+        }                                                                                    \
+    } while(0)
+
 static int mca_coll_ucc_save_coll_handlers(mca_coll_ucc_module_t *ucc_module)
 {
     ompi_communicator_t *comm = ucc_module->comm;
@@ -93,6 +170,38 @@ static int mca_coll_ucc_save_coll_handlers(mca_coll_ucc_module_t *ucc_module)
     SAVE_PREV_COLL_API(ialltoall);
     SAVE_PREV_COLL_API(alltoallv);
     SAVE_PREV_COLL_API(ialltoallv);
+    SAVE_PREV_COLL_API(reduce);
+    SAVE_PREV_COLL_API(ireduce);
+    SAVE_PREV_COLL_API(allgather);
+    SAVE_PREV_COLL_API(iallgather);
+    SAVE_PREV_COLL_API(allgatherv);
+    SAVE_PREV_COLL_API(iallgatherv);
+    SAVE_PREV_COLL_API(gather);
+    SAVE_PREV_COLL_API(igather);
+    SAVE_PREV_COLL_API(gatherv);
+    SAVE_PREV_COLL_API(igatherv);
+    SAVE_PREV_COLL_API(scatter);
+    SAVE_PREV_COLL_API(iscatter);
+    SAVE_PREV_COLL_API(scatterv);
+    SAVE_PREV_COLL_API(iscatterv);
+    SAVE_PREV_COLL_API(reduce_scatter);
+    SAVE_PREV_COLL_API(ireduce_scatter);
+    SAVE_PREV_COLL_API(reduce_scatter_block);
+    SAVE_PREV_COLL_API(ireduce_scatter_block);
+    SAVE_PREV_INIT_COLL_API(allreduce_init);
+    SAVE_PREV_INIT_COLL_API(barrier_init);
+    SAVE_PREV_INIT_COLL_API(bcast_init);
+    SAVE_PREV_INIT_COLL_API(alltoall_init);
+    SAVE_PREV_INIT_COLL_API(alltoallv_init);
+    SAVE_PREV_INIT_COLL_API(reduce_init);
+    SAVE_PREV_INIT_COLL_API(allgather_init);
+    SAVE_PREV_INIT_COLL_API(allgatherv_init);
+    SAVE_PREV_INIT_COLL_API(gather_init);
+    SAVE_PREV_INIT_COLL_API(gatherv_init);
+    SAVE_PREV_INIT_COLL_API(scatter_init);
+    SAVE_PREV_INIT_COLL_API(scatterv_init);
+    SAVE_PREV_INIT_COLL_API(reduce_scatter_init);
+    SAVE_PREV_INIT_COLL_API(reduce_scatter_block_init);
     return OMPI_SUCCESS;
 }
 
@@ -362,20 +471,24 @@ err:
 }
 
 
-#define SET_COLL_PTR(_module, _COLL, _coll) do {                          \
-        _module->super.coll_  ## _coll = NULL;                            \
-        _module->super.coll_i ## _coll = NULL;                            \
-        if ((mca_coll_ucc_component.ucc_lib_attr.coll_types &             \
-             UCC_COLL_TYPE_ ## _COLL)) {                                  \
-            if (mca_coll_ucc_component.cts_requested &                    \
-                UCC_COLL_TYPE_ ## _COLL) {                                \
-                _module->super.coll_ ## _coll  = mca_coll_ucc_  ## _coll; \
-            }                                                             \
-            if (mca_coll_ucc_component.nb_cts_requested &                 \
-                UCC_COLL_TYPE_ ## _COLL) {                                \
-                _module->super.coll_i ## _coll = mca_coll_ucc_i ## _coll; \
-            }                                                             \
-        }                                                                 \
+#define SET_COLL_PTR(_module, _COLL, _coll) do {                                \
+        _module->super.coll_  ## _coll           = NULL;                        \
+        _module->super.coll_i ## _coll           = NULL;                        \
+        _module->super.coll_  ## _coll ## _init  = NULL;                        \
+        if ((mca_coll_ucc_component.ucc_lib_attr.coll_types &                   \
+             UCC_COLL_TYPE_ ## _COLL)) {                                        \
+            if (mca_coll_ucc_component.cts_requested &                          \
+                UCC_COLL_TYPE_ ## _COLL) {                                      \
+                _module->super.coll_ ## _coll  = mca_coll_ucc_  ## _coll;       \
+            }                                                                   \
+            if (mca_coll_ucc_component.nb_cts_requested &                       \
+                UCC_COLL_TYPE_ ## _COLL) {                                      \
+                _module->super.coll_i ## _coll = mca_coll_ucc_i ## _coll;       \
+                /* persistent collectives follow the nonblocking selection */   \
+                _module->super.coll_ ## _coll ## _init =                        \
+                    mca_coll_ucc_ ## _coll ## _init;                            \
+            }                                                                   \
+        }                                                                       \
     } while(0)
 
 /*
@@ -414,11 +527,20 @@ mca_coll_ucc_comm_query(struct ompi_communicator_t *comm, int *priority)
     ucc_module->comm                     = comm;
     ucc_module->super.coll_module_enable = mca_coll_ucc_module_enable;
     *priority                            = cm->ucc_priority;
-    SET_COLL_PTR(ucc_module, BARRIER,   barrier);
-    SET_COLL_PTR(ucc_module, BCAST,     bcast);
-    SET_COLL_PTR(ucc_module, ALLREDUCE, allreduce);
-    SET_COLL_PTR(ucc_module, ALLTOALL,  alltoall);
-    SET_COLL_PTR(ucc_module, ALLTOALLV, alltoallv);
+    SET_COLL_PTR(ucc_module, BARRIER,         barrier);
+    SET_COLL_PTR(ucc_module, BCAST,           bcast);
+    SET_COLL_PTR(ucc_module, ALLREDUCE,       allreduce);
+    SET_COLL_PTR(ucc_module, ALLTOALL,        alltoall);
+    SET_COLL_PTR(ucc_module, ALLTOALLV,       alltoallv);
+    SET_COLL_PTR(ucc_module, REDUCE,          reduce);
+    SET_COLL_PTR(ucc_module, ALLGATHER,       allgather);
+    SET_COLL_PTR(ucc_module, ALLGATHERV,      allgatherv);
+    SET_COLL_PTR(ucc_module, GATHER,          gather);
+    SET_COLL_PTR(ucc_module, GATHERV,         gatherv);
+    SET_COLL_PTR(ucc_module, SCATTER,         scatter);
+    SET_COLL_PTR(ucc_module, SCATTERV,        scatterv);
+    SET_COLL_PTR(ucc_module, REDUCE_SCATTERV, reduce_scatter);
+    SET_COLL_PTR(ucc_module, REDUCE_SCATTER,  reduce_scatter_block);
     return &ucc_module->super;
 }
 
@@ -431,8 +553,33 @@ OBJ_CLASS_INSTANCE(mca_coll_ucc_module_t,
 OBJ_CLASS_INSTANCE(mca_coll_ucc_req_t, ompi_request_t,
                    NULL, NULL);
 
+int mca_coll_ucc_req_start(size_t count, struct ompi_request_t **requests)
+{
+    for (size_t i = 0; i < count; i++) {
+        mca_coll_ucc_req_t *coll_req = (mca_coll_ucc_req_t*)requests[i];
+
+        coll_req->super.req_complete          = REQUEST_PENDING;
+        coll_req->super.req_state             = OMPI_REQUEST_ACTIVE;
+        coll_req->super.req_status.MPI_ERROR  = MPI_SUCCESS;
+        if (UCC_OK != ucc_collective_post(coll_req->ucc_req)) {
+            UCC_ERROR("ucc_collective_post failed for a persistent request");
+            return OMPI_ERROR;
+        }
+    }
+    return OMPI_SUCCESS;
+}
+
 int mca_coll_ucc_req_free(struct ompi_request_t **ompi_req)
 {
+    mca_coll_ucc_req_t *coll_req = (mca_coll_ucc_req_t*)(*ompi_req);
+
+    if (coll_req->super.req_persistent) {
+        if (!REQUEST_COMPLETE(&coll_req->super)) {
+            return MPI_ERR_REQUEST;
+        }
+        /* the ucc request is reused by every start, it is only released here */
+        ucc_collective_finalize(coll_req->ucc_req);
+    }
     opal_free_list_return (&mca_coll_ucc_component.requests,
                            (opal_free_list_item_t *)(*ompi_req));
     *ompi_req = &ompi_request_empty;
@@ -443,6 +590,11 @@ int mca_coll_ucc_req_free(struct ompi_request_t **ompi_req)
 void mca_coll_ucc_completion(void *data, ucc_status_t status)
 {
     mca_coll_ucc_req_t *coll_req = (mca_coll_ucc_req_t*)data;
-    ucc_collective_finalize(coll_req->ucc_req);
+    if (!coll_req->super.req_persistent) {
+        ucc_collective_finalize(coll_req->ucc_req);
+    }
+    if (OPAL_UNLIKELY(UCC_OK != status)) {
+        coll_req->super.req_status.MPI_ERROR = MPI_ERR_INTERN;
+    }
     ompi_request_complete(&coll_req->super, true);
 }
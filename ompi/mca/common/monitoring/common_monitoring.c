@@ -28,7 +28,10 @@
 #include "opal/util/output.h"
 #include "opal/util/printf.h"
 #include "opal/runtime/opal.h"
+#include "opal/mca/threads/mutex.h"
+#include "opal/mca/threads/thread_usage.h"
 #include <math.h>
+#include <sys/time.h>
 
 #if SIZEOF_LONG_LONG == SIZEOF_SIZE_T
 #define MCA_MONITORING_VAR_TYPE MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG
@@ -83,6 +86,38 @@ static double log10_2 = 0.;
 static int rank_world = -1;
 static int nprocs_world = 0;
 
+/*
+ * Sampling mode (pml_monitoring_sampling > 1): only one operation out of
+ * pml_monitoring_sampling is recorded, with a weight of
+ * pml_monitoring_sampling so that the counters remain estimates of the
+ * real traffic. Each thread records in its own block of counters, laid out
+ * like the shared arrays above, without atomics; the blocks are added to
+ * the shared arrays when they are read (flush or MPI_T). An update done by
+ * a thread while its block is merged can be lost, which is within the
+ * precision of the sampling.
+ */
+static int mca_common_monitoring_sampling = 1;
+
+/* Output format of a flush into a file: 0 for text (.prof), 1 for the
+ * streaming binary format (.bprof, see mca_common_monitoring_output_binary) */
+static int mca_common_monitoring_output_format = 0;
+
+#if OPAL_HAVE_THREAD_LOCAL
+typedef struct mca_common_monitoring_local_s {
+    struct mca_common_monitoring_local_s *next;
+    int generation;              /**< monitoring instance the block belongs to */
+    int countdown;               /**< operations to skip before the next sample */
+    size_t counters[];           /**< same layout as the shared arrays */
+} mca_common_monitoring_local_t;
+
+static opal_thread_local mca_common_monitoring_local_t *mca_common_monitoring_local = NULL;
+static mca_common_monitoring_local_t *mca_common_monitoring_local_list = NULL;
+static int mca_common_monitoring_generation = 0;
+#else
+static opal_atomic_int32_t mca_common_monitoring_tick = 0;
+#endif  /* OPAL_HAVE_THREAD_LOCAL */
+static opal_mutex_t mca_common_monitoring_local_lock = OPAL_MUTEX_STATIC_INIT;
+
 opal_hash_table_t *common_monitoring_translation_ht = NULL;
 
 /* Reset all the monitoring arrays */
@@ -246,6 +281,18 @@ void mca_common_monitoring_finalize( void )
     free(mca_common_monitoring_output_stream_obj.lds_prefix);
     /* Free internal data structure */
     free((void *) pml_data);  /* a single allocation */
+    pml_data = NULL;
+#if OPAL_HAVE_THREAD_LOCAL
+    /* The threads notice the change of generation and allocate new blocks */
+    opal_mutex_lock(&mca_common_monitoring_local_lock);
+    while( NULL != mca_common_monitoring_local_list ) {
+        mca_common_monitoring_local_t *local = mca_common_monitoring_local_list;
+        mca_common_monitoring_local_list = local->next;
+        free(local);
+    }
+    mca_common_monitoring_generation++;
+    opal_mutex_unlock(&mca_common_monitoring_local_lock);
+#endif  /* OPAL_HAVE_THREAD_LOCAL */
     opal_hash_table_remove_all( common_monitoring_translation_ht );
     OBJ_RELEASE(common_monitoring_translation_ht);
     mca_common_monitoring_coll_finalize();
@@ -293,6 +340,31 @@ int mca_common_monitoring_register(void)
                                 MCA_BASE_VAR_SCOPE_READONLY,
                                 &mca_common_monitoring_initial_filename);
 
+    (void)mca_base_var_register("ompi", "pml", "monitoring", "sampling",
+                                "Record only one operation out of this many (point-to-point, "
+                                "one-sided and collective), each recorded operation counting "
+                                "for this many. Values larger than 1 (default 1, record "
+                                "everything) also use per-thread counters instead of atomic "
+                                "updates, which makes the monitoring cheap enough to always "
+                                "be enabled.",
+                                MCA_BASE_VAR_TYPE_INT, NULL, MPI_T_BIND_NO_OBJECT,
+                                MCA_BASE_VAR_FLAG_DWG, OPAL_INFO_LVL_4,
+                                MCA_BASE_VAR_SCOPE_READONLY,
+                                &mca_common_monitoring_sampling);
+    if( 1 > mca_common_monitoring_sampling ) {
+        mca_common_monitoring_sampling = 1;
+    }
+
+    (void)mca_base_var_register("ompi", "pml", "monitoring", "output_format",
+                                "Format of the monitoring information saved in a file. A value "
+                                "of 0 writes the textual output in \".prof\" files (default). A "
+                                "value of 1 appends a binary record to \".bprof\" files at each "
+                                "flush, to be aggregated afterwards with profile2mat.pl.",
+                                MCA_BASE_VAR_TYPE_INT, NULL, MPI_T_BIND_NO_OBJECT,
+                                MCA_BASE_VAR_FLAG_DWG, OPAL_INFO_LVL_4,
+                                MCA_BASE_VAR_SCOPE_READONLY,
+                                &mca_common_monitoring_output_format);
+
     /* Now that the MCA variables are automatically unregistered when
      * their component close, we need to keep a safe copy of the
      * filename.
@@ -494,34 +566,123 @@ int mca_common_monitoring_add_procs(struct ompi_proc_t **procs,
     return OMPI_SUCCESS;
 }
 
+/* Number of counters in the shared arrays (and in each per-thread block) */
+static inline int mca_common_monitoring_array_size( void )
+{
+    return (10 + max_size_histogram) * nprocs_world;
+}
+
+#if OPAL_HAVE_THREAD_LOCAL
+static mca_common_monitoring_local_t *mca_common_monitoring_local_new( void )
+{
+    mca_common_monitoring_local_t *local;
+
+    local = (mca_common_monitoring_local_t*)calloc(1, sizeof(*local) +
+                                                   mca_common_monitoring_array_size() * sizeof(size_t));
+    if( NULL == local ) return NULL;
+    local->generation = mca_common_monitoring_generation;
+    local->countdown = mca_common_monitoring_sampling;
+
+    opal_mutex_lock(&mca_common_monitoring_local_lock);
+    local->next = mca_common_monitoring_local_list;
+    mca_common_monitoring_local_list = local;
+    opal_mutex_unlock(&mca_common_monitoring_local_lock);
+    return local;
+}
+#endif  /* OPAL_HAVE_THREAD_LOCAL */
+
+/*
+ * Decide if the current operation is recorded. If it is, the counters are
+ * to be updated with a weight of mca_common_monitoring_sampling, in *local
+ * if it is not NULL (a block of the calling thread, with the same layout as
+ * the shared arrays), atomically in the shared arrays otherwise.
+ */
+static inline bool mca_common_monitoring_sample(size_t **local)
+{
+    *local = NULL;
+    if( 1 >= mca_common_monitoring_sampling ) return true;
+#if OPAL_HAVE_THREAD_LOCAL
+    mca_common_monitoring_local_t *block = mca_common_monitoring_local;
+    if( OPAL_UNLIKELY(NULL == block || block->generation != mca_common_monitoring_generation) ) {
+        block = mca_common_monitoring_local = mca_common_monitoring_local_new();
+        if( NULL == block ) return true;
+    }
+    if( 0 < --block->countdown ) return false;
+    block->countdown = mca_common_monitoring_sampling;
+    *local = block->counters;
+    return true;
+#else
+    return 0 == (opal_atomic_fetch_add_32(&mca_common_monitoring_tick, 1) % mca_common_monitoring_sampling);
+#endif  /* OPAL_HAVE_THREAD_LOCAL */
+}
+
+static inline void mca_common_monitoring_add(opal_atomic_size_t *array, int index,
+                                             size_t value, size_t *local)
+{
+    if( NULL != local ) {
+        local[(array - pml_data) + index] += value;
+    } else {
+        opal_atomic_add_fetch_size_t(&array[index], value);
+    }
+}
+
+/* Fold the per-thread counters into the shared arrays */
+static void mca_common_monitoring_merge( bool discard )
+{
+#if OPAL_HAVE_THREAD_LOCAL
+    mca_common_monitoring_local_t *local;
+    int i, array_size = mca_common_monitoring_array_size();
+
+    if( NULL == mca_common_monitoring_local_list ) return;
+
+    opal_mutex_lock(&mca_common_monitoring_local_lock);
+    for( local = mca_common_monitoring_local_list; NULL != local; local = local->next ) {
+        for( i = 0; i < array_size; i++ ) {
+            if( 0 != local->counters[i] ) {
+                if( !discard ) pml_data[i] += local->counters[i];
+                local->counters[i] = 0;
+            }
+        }
+    }
+    opal_mutex_unlock(&mca_common_monitoring_local_lock);
+#endif  /* OPAL_HAVE_THREAD_LOCAL */
+}
+
 static void mca_common_monitoring_reset( void )
 {
-    int array_size = (10 + max_size_histogram) * nprocs_world;
+    int array_size = mca_common_monitoring_array_size();
+    mca_common_monitoring_merge(true);
     memset((void *) pml_data, 0, array_size * sizeof(size_t));
     mca_common_monitoring_coll_reset();
 }
 
 void mca_common_monitoring_record_pml(int world_rank, size_t data_size, int tag)
 {
+    size_t *local;
+
     if( 0 == mca_common_monitoring_current_state ) return;  /* right now the monitoring is not started */
+    if( !mca_common_monitoring_sample(&local) ) return;
+
+    const size_t weight = (size_t) mca_common_monitoring_sampling;
 
     /* Keep tracks of the data_size distribution */
     if( 0 == data_size ) {
-        opal_atomic_add_fetch_size_t(&size_histogram[world_rank * max_size_histogram], 1);
+        mca_common_monitoring_add(size_histogram, world_rank * max_size_histogram, weight, local);
     } else {
         int log2_size = log10(data_size)/log10_2;
         if(log2_size > max_size_histogram - 2) /* Avoid out-of-bound write */
             log2_size = max_size_histogram - 2;
-        opal_atomic_add_fetch_size_t(&size_histogram[world_rank * max_size_histogram + log2_size + 1], 1);
+        mca_common_monitoring_add(size_histogram, world_rank * max_size_histogram + log2_size + 1,
+                                  weight, local);
     }
 
     /* distinguishses positive and negative tags if requested */
     if( (tag < 0) && (mca_common_monitoring_filter()) ) {
-        opal_atomic_add_fetch_size_t(&filtered_pml_data[world_rank], data_size);
-        opal_atomic_add_fetch_size_t(&filtered_pml_count[world_rank], 1);
+        mca_common_monitoring_add(filtered_pml_data, world_rank, weight * data_size, local);
+        mca_common_monitoring_add(filtered_pml_count, world_rank, weight, local);
     } else { /* if filtered monitoring is not activated data is aggregated indifferently */
-        opal_atomic_add_fetch_size_t(&pml_data[world_rank], data_size);
-        opal_atomic_add_fetch_size_t(&pml_count[world_rank], 1);
+        mca_common_monitoring_add(pml_data, world_rank, weight * data_size, local);
+        mca_common_monitoring_add(pml_count, world_rank, weight, local);
     }
 }
 
@@ -536,6 +697,8 @@ static int mca_common_monitoring_get_pml_count(const struct mca_base_pvar_t *pva
     if(comm != &ompi_mpi_comm_world.comm || NULL == pml_count)
         return OMPI_ERROR;
 
+    mca_common_monitoring_merge(false);
+
     for (i = 0 ; i < comm_size ; ++i) {
         values[i] = pml_count[i];
     }
@@ -555,6 +718,8 @@ static int mca_common_monitoring_get_pml_size(const struct mca_base_pvar_t *pvar
     if(comm != &ompi_mpi_comm_world.comm || NULL == pml_data)
         return OMPI_ERROR;
 
+    mca_common_monitoring_merge(false);
+
     for (i = 0 ; i < comm_size ; ++i) {
         values[i] = pml_data[i];
     }
@@ -565,14 +730,19 @@ static int mca_common_monitoring_get_pml_size(const struct mca_base_pvar_t *pvar
 void mca_common_monitoring_record_osc(int world_rank, size_t data_size,
                                       enum mca_monitoring_osc_direction dir)
 {
+    size_t *local;
+
     if( 0 == mca_common_monitoring_current_state ) return;  /* right now the monitoring is not started */
+    if( !mca_common_monitoring_sample(&local) ) return;
+
+    const size_t weight = (size_t) mca_common_monitoring_sampling;
 
     if( SEND == dir ) {
-        opal_atomic_add_fetch_size_t(&osc_data_s[world_rank], data_size);
-        opal_atomic_add_fetch_size_t(&osc_count_s[world_rank], 1);
+        mca_common_monitoring_add(osc_data_s, world_rank, weight * data_size, local);
+        mca_common_monitoring_add(osc_count_s, world_rank, weight, local);
     } else {
-        opal_atomic_add_fetch_size_t(&osc_data_r[world_rank], data_size);
-        opal_atomic_add_fetch_size_t(&osc_count_r[world_rank], 1);
+        mca_common_monitoring_add(osc_data_r, world_rank, weight * data_size, local);
+        mca_common_monitoring_add(osc_count_r, world_rank, weight, local);
     }
 }
 
@@ -587,6 +757,8 @@ static int mca_common_monitoring_get_osc_sent_count(const struct mca_base_pvar_t
     if(comm != &ompi_mpi_comm_world.comm || NULL == pml_count)
         return OMPI_ERROR;
 
+    mca_common_monitoring_merge(false);
+
     for (i = 0 ; i < comm_size ; ++i) {
         values[i] = osc_count_s[i];
     }
@@ -606,6 +778,8 @@ static int mca_common_monitoring_get_osc_sent_size(const struct mca_base_pvar_t
     if(comm != &ompi_mpi_comm_world.comm || NULL == pml_data)
         return OMPI_ERROR;
 
+    mca_common_monitoring_merge(false);
+
     for (i = 0 ; i < comm_size ; ++i) {
         values[i] = osc_data_s[i];
     }
@@ -624,6 +798,8 @@ static int mca_common_monitoring_get_osc_recv_count(const struct mca_base_pvar_t
     if(comm != &ompi_mpi_comm_world.comm || NULL == pml_count)
         return OMPI_ERROR;
 
+    mca_common_monitoring_merge(false);
+
     for (i = 0 ; i < comm_size ; ++i) {
         values[i] = osc_count_r[i];
     }
@@ -643,6 +819,8 @@ static int mca_common_monitoring_get_osc_recv_size(const struct mca_base_pvar_t
     if(comm != &ompi_mpi_comm_world.comm || NULL == pml_data)
         return OMPI_ERROR;
 
+    mca_common_monitoring_merge(false);
+
     for (i = 0 ; i < comm_size ; ++i) {
         values[i] = osc_data_r[i];
     }
@@ -652,10 +830,15 @@ static int mca_common_monitoring_get_osc_recv_size(const struct mca_base_pvar_t
 
 void mca_common_monitoring_record_coll(int world_rank, size_t data_size)
 {
+    size_t *local;
+
     if( 0 == mca_common_monitoring_current_state ) return;  /* right now the monitoring is not started */
+    if( !mca_common_monitoring_sample(&local) ) return;
 
-    opal_atomic_add_fetch_size_t(&coll_data[world_rank], data_size);
-    opal_atomic_add_fetch_size_t(&coll_count[world_rank], 1);
+    const size_t weight = (size_t) mca_common_monitoring_sampling;
+
+    mca_common_monitoring_add(coll_data, world_rank, weight * data_size, local);
+    mca_common_monitoring_add(coll_count, world_rank, weight, local);
 }
 
 static int mca_common_monitoring_get_coll_count(const struct mca_base_pvar_t *pvar,
@@ -669,6 +852,8 @@ static int mca_common_monitoring_get_coll_count(const struct mca_base_pvar_t *pv
     if(comm != &ompi_mpi_comm_world.comm || NULL == pml_count)
         return OMPI_ERROR;
 
+    mca_common_monitoring_merge(false);
+
     for (i = 0 ; i < comm_size ; ++i) {
         values[i] = coll_count[i];
     }
@@ -688,6 +873,8 @@ static int mca_common_monitoring_get_coll_size(const struct mca_base_pvar_t *pva
     if(comm != &ompi_mpi_comm_world.comm || NULL == pml_data)
         return OMPI_ERROR;
 
+    mca_common_monitoring_merge(false);
+
     for (i = 0 ; i < comm_size ; ++i) {
         values[i] = coll_data[i];
     }
@@ -755,6 +942,77 @@ static void mca_common_monitoring_output( FILE *pf, int my_rank, int nbprocs )
     mca_common_monitoring_coll_flush_all(pf);
 }
 
+/*
+ * Streaming binary output: each flush appends one record made of a header
+ * followed by one entry for each (category, peer) pair with traffic. The
+ * categories are the letters of the textual output (E, I, S, R and C). The
+ * values are in the native byte order, and already weighted by the
+ * sampling rate, which is kept in the header for reference.
+ */
+#define MCA_COMMON_MONITORING_BINARY_MAGIC   "OMPM"
+#define MCA_COMMON_MONITORING_BINARY_VERSION 1
+
+typedef struct {
+    char     magic[4];
+    uint32_t version;
+    int32_t  rank;
+    int32_t  nprocs;
+    uint32_t sampling;
+    uint32_t nentries;
+    uint64_t timestamp;         /**< microseconds since the epoch */
+} mca_common_monitoring_binary_header_t;
+
+typedef struct {
+    char     type;
+    char     padding[3];
+    int32_t  peer;
+    uint64_t bytes;
+    uint64_t count;
+} mca_common_monitoring_binary_entry_t;
+
+static int mca_common_monitoring_output_binary( FILE *pf, int my_rank, int nbprocs )
+{
+    const struct {
+        char type;
+        opal_atomic_size_t *data;
+        opal_atomic_size_t *count;
+    } categories[] = {
+        {'E', pml_data, pml_count},
+        {'I', filtered_pml_data, filtered_pml_count},
+        {'S', osc_data_s, osc_count_s},
+        {'R', osc_data_r, osc_count_r},
+        {'C', coll_data, coll_count},
+    };
+    const int ncategories = sizeof(categories) / sizeof(categories[0]);
+    mca_common_monitoring_binary_header_t header = {.magic = MCA_COMMON_MONITORING_BINARY_MAGIC,
+                                                    .version = MCA_COMMON_MONITORING_BINARY_VERSION,
+                                                    .rank = my_rank, .nprocs = nbprocs,
+                                                    .sampling = mca_common_monitoring_sampling};
+    mca_common_monitoring_binary_entry_t entry = {.padding = {0}};
+    struct timeval tv;
+
+    for (int c = 0 ; c < ncategories ; c++) {
+        for (int i = 0 ; i < nbprocs ; i++) {
+            if(categories[c].count[i] > 0) header.nentries++;
+        }
+    }
+    gettimeofday(&tv, NULL);
+    header.timestamp = (uint64_t)tv.tv_sec * 1000000 + (uint64_t)tv.tv_usec;
+
+    if( 1 != fwrite(&header, sizeof(header), 1, pf) ) return OMPI_ERROR;
+    for (int c = 0 ; c < ncategories ; c++) {
+        entry.type = categories[c].type;
+        for (int i = 0 ; i < nbprocs ; i++) {
+            if(0 == categories[c].count[i]) continue;
+            entry.peer  = i;
+            entry.bytes = categories[c].data[i];
+            entry.count = categories[c].count[i];
+            if( 1 != fwrite(&entry, sizeof(entry), 1, pf) ) return OMPI_ERROR;
+        }
+    }
+    return OMPI_SUCCESS;
+}
+
 /*
  * Flushes the monitoring into filename
  * Useful for phases (see example in test/monitoring)
@@ -765,6 +1023,8 @@ static int mca_common_monitoring_flush(int fd, char* filename)
     if( 0 == mca_common_monitoring_current_state || 0 == fd ) /* if disabled do nothing */
         return OMPI_SUCCESS;
 
+    mca_common_monitoring_merge(false);
+
     if( 1 == fd ) {
         OPAL_MONITORING_PRINT_INFO("Proc %" PRId32 " flushing monitoring to stdout", rank_world);
         mca_common_monitoring_output( stdout, rank_world, nprocs_world );
@@ -774,26 +1034,36 @@ static int mca_common_monitoring_flush(int fd, char* filename)
     } else {
         FILE *pf = NULL;
         char* tmpfn = NULL;
+        const bool binary = (1 == mca_common_monitoring_output_format);
+        const char *ext = binary ? "bprof" : "prof";
 
         if( NULL == filename ) { /* No filename */
             OPAL_MONITORING_PRINT_ERR("Error while flushing: no filename provided");
             return OMPI_ERROR;
         } else {
-            opal_asprintf(&tmpfn, "%s.%" PRId32 ".prof", filename, rank_world);
-            pf = fopen(tmpfn, "w");
+            opal_asprintf(&tmpfn, "%s.%" PRId32 ".%s", filename, rank_world, ext);
+            /* the binary records of successive flushes are streamed in the same file */
+            pf = fopen(tmpfn, binary ? "ab" : "w");
             free(tmpfn);
         }
 
         if(NULL == pf) {  /* Error during open */
-            OPAL_MONITORING_PRINT_ERR("Error while flushing to: %s.%" PRId32 ".prof",
-                                      filename, rank_world);
+            OPAL_MONITORING_PRINT_ERR("Error while flushing to: %s.%" PRId32 ".%s",
+                                      filename, rank_world, ext);
             return OMPI_ERROR;
         }
 
-        OPAL_MONITORING_PRINT_INFO("Proc %d flushing monitoring to: %s.%" PRId32 ".prof",
-                                   rank_world, filename, rank_world);
+        OPAL_MONITORING_PRINT_INFO("Proc %d flushing monitoring to: %s.%" PRId32 ".%s",
+                                   rank_world, filename, rank_world, ext);
 
-        mca_common_monitoring_output( pf, rank_world, nprocs_world );
+        if( binary ) {
+            if( OMPI_SUCCESS != mca_common_monitoring_output_binary( pf, rank_world, nprocs_world ) ) {
+                OPAL_MONITORING_PRINT_ERR("Error while writing to: %s.%" PRId32 ".%s",
+                                          filename, rank_world, ext);
+            }
+        } else {
+            mca_common_monitoring_output( pf, rank_world, nprocs_world );
+        }
 
         fclose(pf);
     }
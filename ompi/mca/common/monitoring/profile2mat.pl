@@ -25,6 +25,10 @@
 # If possible it creates file with "internal" tags (collexctive and eta data),
 # "external" tags (point to point messages)  and "all" (every messgaes).
 #
+# Binary profiles (".bprof", written with pml_monitoring_output_format=1)
+# are decoded into the same records; all the records streamed by the
+# successive flushes of a file are aggregated.
+#
 # ensure that this script as the executable right: chmod +x ...
 #
 
@@ -35,6 +39,8 @@ if($#ARGV < 0){
    $filename=$ARGV[0];
 }
 
+@lines=load($filename);
+
 profile($filename,"I|E|S|R|C","all");
 if ( profile($filename,"E","external") ){
     profile($filename,"I","internal");
@@ -49,16 +55,15 @@ sub profile{
    my $done = 0;
 
    $outfile=$filename;
-   $outfile=~s/\.prof$/_size_$suffix\.mat/;
+   $outfile=~s/\.b?prof$/_size_$suffix\.mat/;
 
 
-   open IN,"<$filename";
    $n=0;
    @mat1=();
    @mat2=();
    @mat3=();
    $i=0;
-   while (<IN>) {
+   foreach (@lines) {
       $i++;
       if (($f,$p1,$p2,$s,$m)=/^($filter)\s+(\d+)\s+(\d+)\s+(\d+)\D+(\d+)/){
 	 $done = 1;
@@ -74,7 +79,6 @@ sub profile{
 	 # print("file $filename line $i: $_\n");
       }
    }
-   close IN;
 
    #print "$done\n";
 
@@ -107,6 +111,36 @@ sub profile{
 }
 
 
+# Returns the records of a profile, in the textual format
+sub load{
+   my $filename= $_[0];
+   my @lines=();
+   my ($buf, $magic, $version, $rank, $nprocs, $sampling, $nentries, $stamp);
+   my ($type, $peer, $bytes, $count);
+
+   if ($filename !~ /\.bprof$/) {
+      open IN,"<$filename" or die("Cannot open $filename\n");
+      @lines=<IN>;
+      close IN;
+      return @lines;
+   }
+
+   open IN,"<:raw",$filename or die("Cannot open $filename\n");
+   # header: magic, version, rank, nprocs, sampling, nentries, timestamp
+   while (32 == read(IN, $buf, 32)) {
+      ($magic,$version,$rank,$nprocs,$sampling,$nentries,$stamp)=unpack("a4 L l l L L Q",$buf);
+      die("$filename: not a monitoring binary profile\n") if ($magic ne "OMPM" || $version != 1);
+      # entries: type, peer, bytes, count
+      foreach (1..$nentries) {
+         die("$filename: truncated record\n") if (24 != read(IN, $buf, 24));
+         ($type,$peer,$bytes,$count)=unpack("a1 x3 l Q Q",$buf);
+         push @lines, "$type\t$rank\t$peer\t$bytes bytes\t$count msgs sent\n";
+      }
+   }
+   close IN;
+   return @lines;
+}
+
 sub save_file{
    my $outfile=$_[0];
    my $n=$_[1];
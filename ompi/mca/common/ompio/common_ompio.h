@@ -41,6 +41,7 @@
 #include "opal/datatype/opal_convertor.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/request/request.h"
+#include "common_ompio_trace.h"
 
 #define OMPIO_MIN(a, b) (((a) < (b)) ? (a) : (b))
 #define OMPIO_MAX(a, b) (((a) < (b)) ? (b) : (a))
@@ -83,6 +84,7 @@
 #define SIMPLE                          5
 #define NO_REFINEMENT                   6
 #define SIMPLE_PLUS                     7
+#define TOPOLOGY_AWARE                  8
 
 #define OMPIO_LOCK_ENTIRE_REGION  10
 #define OMPIO_LOCK_SELECTIVE      11
@@ -174,6 +176,20 @@ struct ompio_file_t {
     enum ompio_fs_type     f_fstype;
     ompi_request_t        *f_split_coll_req;
     bool                   f_split_coll_in_use;
+    /* write-behind buffer of the small independent writes, holding
+       f_wb_len bytes of the file starting at f_wb_offset */
+    char                  *f_wb_buf;
+    OMPI_MPI_OFFSET_TYPE   f_wb_offset;
+    size_t                 f_wb_len;
+    uint64_t               f_wb_start; /* usec, first byte buffered */
+    /* read-ahead buffer of the sequential independent reads */
+    char                  *f_ra_buf;
+    OMPI_MPI_OFFSET_TYPE   f_ra_offset;
+    size_t                 f_ra_len;
+    OMPI_MPI_OFFSET_TYPE   f_ra_next;  /* end of the last read */
+    struct mca_common_ompio_cache_t *f_read_cache;
+    void                  *f_cufile;   /* cuFile handle, GPUDirect Storage */
+    mca_common_ompio_trace_t f_trace;
     /* Place for selected sharedfp module to hang it's data.
        Note: Neither f_sharedfp nor f_sharedfp_component seemed appropriate for this.
     */
@@ -194,6 +210,20 @@ struct ompio_file_t {
     ompi_datatype_t  *f_orig_filetype; /* the fileview passed by the user to us */
     size_t            f_etype_size;
 
+    /* The decoded view is kept as long as the same etype and filetype are set
+       again. Regular views are folded into a single block per stride, the size
+       of the unfolded view is kept for the aggregator selection heuristics. */
+    ompi_datatype_t  *f_view_cache_etype;
+    ompi_datatype_t  *f_view_cache_filetype;
+    size_t            f_view_cache_size;
+
+    /* Last decoded memory datatype, its offsets relative to the user buffer */
+    ompi_datatype_t  *f_mem_cache_type;
+    int               f_mem_cache_count;
+    struct iovec     *f_mem_cache_iov;
+    uint32_t          f_mem_cache_iov_count;
+    size_t            f_mem_cache_max_data;
+
     /* contains IO requests that needs to be read/written */
     mca_common_ompio_io_array_t *f_io_array;
     int                      f_num_of_io_entries;
@@ -277,6 +307,16 @@ OMPI_DECLSPEC int mca_common_ompio_build_io_array ( ompio_file_t *fh, int index,
                                                     size_t *spc, mca_common_ompio_io_array_t **io_array,
                                                     int *num_io_entries );
 
+OMPI_DECLSPEC ssize_t mca_common_ompio_fbtl_io (ompio_file_t *fh, mca_common_ompio_io_array_t *io_array,
+                                                int num_io_entries, bool is_read);
+
+/* Write the data held by the write-behind buffer, if any */
+OMPI_DECLSPEC int mca_common_ompio_write_behind_flush (ompio_file_t *fh);
+
+/* Flush the write-behind buffer if it overlaps the io array about to be read */
+OMPI_DECLSPEC int mca_common_ompio_write_behind_check (ompio_file_t *fh, mca_common_ompio_io_array_t *io_array,
+                                                       int num_io_entries);
+
 
 OMPI_DECLSPEC int mca_common_ompio_file_read (ompio_file_t *fh,  void *buf,  int count,
                                               struct ompi_datatype_t *datatype, ompi_status_public_t *status);
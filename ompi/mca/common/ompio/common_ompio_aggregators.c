@@ -27,6 +27,8 @@
 
 #include "ompi/runtime/params.h"
 #include "ompi/communicator/communicator.h"
+#include "ompi/group/group.h"
+#include "ompi/proc/proc.h"
 #include "ompi/mca/pml/pml.h"
 #include "ompi/mca/topo/topo.h"
 #include "ompi/mca/fcoll/base/fcoll_base_coll_array.h"
@@ -51,6 +53,8 @@
 ** 2. fview_based_grouping: analysis the fileview to detect regular patterns
 ** 3. cart_based_grouping: uses a cartesian communicator to derive certain (probable) properties
 **    of the access pattern
+** 4. node_based_grouping: spreads the aggregators evenly over the nodes, with a number of
+**    aggregators matched to the stripe count of the file
 */
 
 static double cost_calc (int P, int P_agg, size_t Data_proc, size_t coll_buffer, int dim );
@@ -449,6 +453,154 @@ exit:
 
 
 
+int mca_common_ompio_node_based_grouping(ompio_file_t *fh,
+                                         int *num_groups,
+                                         mca_common_ompio_contg *contg_groups)
+{
+    int ret = OMPI_SUCCESS;
+    int i, n, g, k, leader = -1;
+    int num_nodes = 0, groups = *num_groups, aggrs_per_node, with_aggr;
+    int chunk, rest;
+    int *node_of = NULL, *node_index = NULL, *node_size = NULL, *node_first_group = NULL;
+    int *node_seen = NULL;
+    ompi_proc_t *proc;
+
+    /* The node of a process is identified by the lowest rank on that node. The
+    ** procs of the remote nodes might not be allocated yet, they are not local
+    ** anyway.
+    */
+    for (i = 0; i < fh->f_size && -1 == leader; i++) {
+        proc = ompi_group_peer_lookup_existing (fh->f_comm->c_local_group, i);
+        if (NULL != proc && OPAL_PROC_ON_LOCAL_NODE(proc->super.proc_flags)) {
+            leader = i;
+        }
+    }
+    if (-1 == leader) {
+        leader = fh->f_rank;
+    }
+
+    node_of = (int *) malloc (fh->f_size * sizeof(int));
+    node_index = (int *) malloc (fh->f_size * sizeof(int));
+    node_size = (int *) calloc (fh->f_size, sizeof(int));
+    node_first_group = (int *) malloc (fh->f_size * sizeof(int));
+    node_seen = (int *) calloc (fh->f_size, sizeof(int));
+    if (NULL == node_of || NULL == node_index || NULL == node_size || NULL == node_first_group ||
+        NULL == node_seen) {
+        opal_output (1, "OUT OF MEMORY\n");
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+
+    ret = fh->f_comm->c_coll->coll_allgather (&leader,
+                                              1,
+                                              MPI_INT,
+                                              node_of,
+                                              1,
+                                              MPI_INT,
+                                              fh->f_comm,
+                                              fh->f_comm->c_coll->coll_allgather_module);
+    if ( OMPI_SUCCESS != ret ) {
+        goto exit;
+    }
+
+    /* number the nodes in the order of their lowest rank */
+    for (i = 0; i < fh->f_size; i++) {
+        node_index[i] = -1;
+    }
+    for (i = 0; i < fh->f_size; i++) {
+        if (-1 == node_index[node_of[i]]) {
+            node_index[node_of[i]] = num_nodes++;
+        }
+        node_of[i] = node_index[node_of[i]];
+        node_size[node_of[i]]++;
+    }
+
+    if (-1 == groups) {
+        aggrs_per_node = OMPIO_MCA_GET(fh, aggregators_per_node);
+        if (1 > aggrs_per_node) {
+            aggrs_per_node = 1;
+        }
+        groups = num_nodes * aggrs_per_node;
+
+        /* Each aggregator should serve whole stripes: use a multiple of the stripe
+        ** count, or a divisor of it when there are fewer nodes than stripes.
+        */
+        if (1 < fh->f_stripe_count) {
+            if (groups >= fh->f_stripe_count) {
+                groups = (groups / fh->f_stripe_count) * fh->f_stripe_count;
+            }
+            else {
+                while (0 != (fh->f_stripe_count % groups)) {
+                    groups--;
+                }
+            }
+        }
+    }
+    if (groups > fh->f_size) {
+        groups = fh->f_size;
+    }
+    if (1 > groups) {
+        groups = 1;
+    }
+
+    /* Hand out the groups round-robin over the nodes so that the load is
+    ** spread, never more groups on a node than it has processes.
+    */
+    for (n = 0; n < num_nodes; n++) {
+        node_index[n] = 0; /* groups of node n */
+    }
+    for (g = 0, n = 0; g < groups; n = (n + 1) % num_nodes) {
+        if (node_index[n] < node_size[n]) {
+            node_index[n]++;
+            g++;
+        }
+    }
+
+    for (g = 0, n = 0; n < num_nodes; n++) {
+        node_first_group[n] = g;
+        for (k = 0; k < node_index[n]; k++, g++) {
+            contg_groups[g].procs_per_contg_group = 0;
+        }
+    }
+
+    /* Split the processes of each node into contiguous chunks, the first
+    ** process of a chunk being the aggregator. The processes of a node without
+    ** aggregator are attached to the groups of the nodes with one.
+    */
+    with_aggr = OMPIO_MIN(groups, num_nodes);
+    for (i = 0; i < fh->f_size; i++) {
+        n = node_of[i];
+        if (0 < node_index[n]) {
+            /* the first rest chunks of the node have one more process */
+            chunk = node_size[n] / node_index[n];
+            rest  = node_size[n] % node_index[n];
+            k = node_seen[n]++;
+            if (k < rest * (chunk + 1)) {
+                g = node_first_group[n] + k / (chunk + 1);
+            }
+            else {
+                g = node_first_group[n] + rest + (k - rest * (chunk + 1)) / chunk;
+            }
+        }
+        else {
+            /* with fewer groups than nodes, nodes 0 .. groups-1 got one */
+            g = node_first_group[n % with_aggr];
+        }
+        contg_groups[g].procs_in_contg_group[contg_groups[g].procs_per_contg_group++] = i;
+    }
+
+    *num_groups = groups;
+
+exit:
+    free (node_of);
+    free (node_index);
+    free (node_size);
+    free (node_first_group);
+    free (node_seen);
+
+    return ret;
+}
+
 int mca_common_ompio_finalize_initial_grouping(ompio_file_t *fh,
 		                               int num_groups,
 					       mca_common_ompio_contg *contg_groups)
@@ -514,7 +666,8 @@ int mca_common_ompio_set_aggregator_props (struct ompio_file_t *fh,
     if ( (-1 == num_aggregators) && 
          ((SIMPLE        != OMPIO_MCA_GET(fh, grouping_option) &&
            NO_REFINEMENT != OMPIO_MCA_GET(fh, grouping_option) &&
-           SIMPLE_PLUS   != OMPIO_MCA_GET(fh, grouping_option) ))) {
+           SIMPLE_PLUS   != OMPIO_MCA_GET(fh, grouping_option) &&
+           TOPOLOGY_AWARE != OMPIO_MCA_GET(fh, grouping_option) ))) {
         ret = mca_common_ompio_create_groups(fh,bytes_per_proc);
     }
     else {
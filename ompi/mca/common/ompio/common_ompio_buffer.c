@@ -23,11 +23,17 @@
 #include "opal/mca/common/cuda/common_cuda.h"
 #include "opal/util/sys_limits.h"
 
+#include <string.h>
+
 #include "opal/mca/allocator/allocator.h"
 #include "opal/mca/allocator/base/base.h"
 #include "common_ompio.h"
 #include "common_ompio_buffer.h"
 
+#if OMPIO_HAVE_CUFILE
+#include <cufile.h>
+#endif
+
 
 static opal_mutex_t     mca_common_ompio_buffer_mutex;      /* lock for thread safety */
 static mca_allocator_base_component_t* mca_common_ompio_allocator_component=NULL;
@@ -37,6 +43,9 @@ static opal_atomic_int32_t  mca_common_ompio_buffer_init = 0;
 static int32_t  mca_common_ompio_pagesize=4096;
 static void* mca_common_ompio_buffer_alloc_seg ( void *ctx, size_t *size );
 static void mca_common_ompio_buffer_free_seg ( void *ctx, void *buf );
+#if OMPIO_HAVE_CUFILE
+static bool mca_common_ompio_cufile_driver_open = false;
+#endif
 
 #if OPAL_CUDA_SUPPORT
 void mca_common_ompio_check_gpu_buf ( ompio_file_t *fh, const void *buf, int *is_gpu, 
@@ -127,6 +136,12 @@ int mca_common_ompio_buffer_alloc_fini ( void )
         OPAL_THREAD_LOCK (&mca_common_ompio_buffer_mutex);
         mca_common_ompio_allocator->alc_finalize(mca_common_ompio_allocator);
         mca_common_ompio_allocator=NULL;
+#if OMPIO_HAVE_CUFILE
+        if ( mca_common_ompio_cufile_driver_open ) {
+            cuFileDriverClose ();
+            mca_common_ompio_cufile_driver_open = false;
+        }
+#endif
         OPAL_THREAD_UNLOCK (&mca_common_ompio_buffer_mutex);
         OBJ_DESTRUCT (&mca_common_ompio_buffer_mutex);
     }
@@ -167,3 +182,112 @@ void mca_common_ompio_release_buf ( ompio_file_t *fh, void *buf )
     return;
 }
 
+#if OMPIO_HAVE_CUFILE
+int mca_common_ompio_cufile_register ( ompio_file_t *fh )
+{
+    CUfileDescr_t descr;
+    CUfileHandle_t handle;
+    CUfileError_t status;
+
+    if ( NULL != fh->f_cufile ) {
+        return OMPI_SUCCESS;
+    }
+    if ( 0 >= OMPIO_MCA_GET(fh, gpu_direct_storage) || 0 > fh->fd ) {
+        /* disabled, or the fs component does not use a file descriptor */
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    if ( !mca_common_ompio_buffer_init ){
+        mca_common_ompio_buffer_alloc_init ();
+    }
+    OPAL_THREAD_LOCK (&mca_common_ompio_buffer_mutex);
+    if ( !mca_common_ompio_cufile_driver_open ) {
+        status = cuFileDriverOpen ();
+        if ( CU_FILE_SUCCESS != status.err ) {
+            OPAL_THREAD_UNLOCK (&mca_common_ompio_buffer_mutex);
+            opal_output (1, "common_ompio: could not open the cuFile driver (%d)\n", status.err);
+            return OMPI_ERR_NOT_SUPPORTED;
+        }
+        mca_common_ompio_cufile_driver_open = true;
+    }
+    OPAL_THREAD_UNLOCK (&mca_common_ompio_buffer_mutex);
+
+    memset (&descr, 0, sizeof(descr));
+    descr.handle.fd = fh->fd;
+    descr.type = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
+    status = cuFileHandleRegister (&handle, &descr);
+    if ( CU_FILE_SUCCESS != status.err ) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+    fh->f_cufile = handle;
+
+    return OMPI_SUCCESS;
+}
+
+void mca_common_ompio_cufile_deregister ( ompio_file_t *fh )
+{
+    if ( NULL != fh->f_cufile ) {
+        cuFileHandleDeregister ((CUfileHandle_t) fh->f_cufile);
+        fh->f_cufile = NULL;
+    }
+}
+
+void *mca_common_ompio_alloc_device_buf ( ompio_file_t *fh, size_t bufsize )
+{
+    void *buf = NULL;
+    CUfileError_t status;
+
+    if ( 0 != mca_common_cuda_malloc (&buf, bufsize) ) {
+        return NULL;
+    }
+    /* not fatal, cuFile bounces through its own buffers otherwise */
+    status = cuFileBufRegister (buf, bufsize, 0);
+    if ( CU_FILE_SUCCESS != status.err ) {
+        opal_output (10, "common_ompio: cuFileBufRegister failed (%d)\n", status.err);
+    }
+    return buf;
+}
+
+void mca_common_ompio_release_device_buf ( ompio_file_t *fh, void *buf )
+{
+    if ( NULL != buf ) {
+        cuFileBufDeregister (buf);
+        mca_common_cuda_free (buf);
+    }
+}
+
+ssize_t mca_common_ompio_cufile_io ( ompio_file_t *fh, mca_common_ompio_io_array_t *io_array,
+                                     int num_entries, int is_read )
+{
+    ssize_t bytes = 0, ret;
+    size_t done;
+    int i;
+
+    for ( i = 0; i < num_entries; i++ ) {
+        done = 0;
+        while ( done < io_array[i].length ) {
+            off_t offset = (off_t) (intptr_t) io_array[i].offset + done;
+            if ( is_read ) {
+                ret = cuFileRead ((CUfileHandle_t) fh->f_cufile, io_array[i].memory_address,
+                                  io_array[i].length - done, offset, done);
+            }
+            else {
+                ret = cuFileWrite ((CUfileHandle_t) fh->f_cufile, io_array[i].memory_address,
+                                   io_array[i].length - done, offset, done);
+            }
+            if ( 0 > ret ) {
+                opal_output (1, "common_ompio: cuFile %s failed (%zd)\n", is_read ? "read" : "write", ret);
+                return OMPI_ERROR;
+            }
+            if ( 0 == ret ) {
+                /* end of file */
+                return bytes;
+            }
+            done  += ret;
+            bytes += ret;
+        }
+    }
+
+    return bytes;
+}
+#endif
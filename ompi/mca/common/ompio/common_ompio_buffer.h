@@ -69,4 +69,17 @@ int mca_common_ompio_buffer_alloc_fini ( void );
 void* mca_common_ompio_alloc_buf ( ompio_file_t *fh, size_t bufsize);
 void mca_common_ompio_release_buf ( ompio_file_t *fh,  void *buf );
 
+#if OMPIO_HAVE_CUFILE
+/* GPUDirect Storage. The handle of the file is registered on first use and
+** released at close, mca_common_ompio_cufile_io transfers the entries of an
+** io array whose memory addresses are all in device memory.
+*/
+int mca_common_ompio_cufile_register ( ompio_file_t *fh );
+void mca_common_ompio_cufile_deregister ( ompio_file_t *fh );
+ssize_t mca_common_ompio_cufile_io ( ompio_file_t *fh, mca_common_ompio_io_array_t *io_array,
+                                     int num_entries, int is_read );
+void *mca_common_ompio_alloc_device_buf ( ompio_file_t *fh, size_t bufsize );
+void mca_common_ompio_release_device_buf ( ompio_file_t *fh, void *buf );
+#endif
+
 #endif
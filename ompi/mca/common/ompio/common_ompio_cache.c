@@ -0,0 +1,384 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "ompi/communicator/communicator.h"
+#include "ompi/info/info.h"
+#include "ompi/file/file.h"
+#include "ompi/mca/fs/fs.h"
+#include "ompi/mca/fbtl/fbtl.h"
+#include "ompi/mca/fcoll/fcoll.h"
+#include "ompi/runtime/ompi_rte.h"
+#include "opal/include/opal/align.h"
+#include "opal/mca/shmem/base/base.h"
+#include "opal/sys/atomic.h"
+#include "opal/util/printf.h"
+
+#include "common_ompio.h"
+#include "common_ompio_cache.h"
+#include <string.h>
+#include <unistd.h>
+
+/* The segment is made of the header, followed by the slots describing
+** the cached blocks and by the data of the blocks. The cache is direct
+** mapped, block b of the file goes to slot b % nslots.
+*/
+typedef struct {
+    opal_atomic_int64_t generation; /* bumped on every invalidation */
+    int64_t nslots;
+    int64_t block_size;
+} mca_common_ompio_cache_header_t;
+
+typedef struct {
+    int64_t block;       /* block of the file held by the slot, -1 if none */
+    int64_t generation;  /* the data is valid if equal to the one of the header */
+    int64_t length;      /* short for the last block of the file */
+    int64_t wanted;      /* block a process of the node missed, -1 if none */
+} mca_common_ompio_cache_slot_t;
+
+struct mca_common_ompio_cache_t {
+    ompi_communicator_t *node_comm;
+    opal_shmem_ds_t seg_ds;
+    /* NULL if the segment could not be set up on this node, the processes
+       still take part in the agreement of the collective reads */
+    char *seg_base;
+    mca_common_ompio_cache_header_t *header;
+    mca_common_ompio_cache_slot_t *slots;
+    char *data;
+};
+
+static int mca_common_ompio_cache_attach (struct mca_common_ompio_cache_t *cache,
+                                          size_t cache_size, size_t block_size)
+{
+    int64_t nslots = cache_size / block_size;
+    size_t header_size, seg_size;
+    int node_rank, ret = OMPI_SUCCESS, ok;
+    char *seg_file = NULL;
+
+    if ( 0 == nslots ) {
+        return OMPI_ERR_BAD_PARAM;
+    }
+    header_size = sizeof(mca_common_ompio_cache_header_t) + nslots * sizeof(mca_common_ompio_cache_slot_t);
+    header_size += OPAL_ALIGN_PAD_AMOUNT(header_size, 64);
+    seg_size = header_size + nslots * block_size;
+
+    node_rank = ompi_comm_rank (cache->node_comm);
+    if ( 0 == node_rank ) {
+        ret = opal_asprintf (&seg_file, "%s" OPAL_PATH_SEP "ompio_cache.%s.%x.%d.%d",
+                             (0 == access ("/dev/shm", W_OK)) ? "/dev/shm" : ompi_process_info.job_session_dir,
+                             ompi_process_info.nodename, OMPI_PROC_MY_NAME->jobid,
+                             (int) OMPI_PROC_MY_NAME->vpid, ompi_comm_get_cid(cache->node_comm));
+        if ( 0 > ret ) {
+            ret = OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        else {
+            ret = opal_shmem_segment_create (&cache->seg_ds, seg_file, seg_size);
+            free (seg_file);
+        }
+    }
+    ok = (OMPI_SUCCESS == ret);
+    ret = cache->node_comm->c_coll->coll_bcast (&ok, 1, MPI_INT, 0, cache->node_comm,
+                                                cache->node_comm->c_coll->coll_bcast_module);
+    if ( OMPI_SUCCESS != ret || !ok ) {
+        return OMPI_ERROR;
+    }
+    ret = cache->node_comm->c_coll->coll_bcast (&cache->seg_ds, sizeof (cache->seg_ds), MPI_BYTE, 0,
+                                                cache->node_comm, cache->node_comm->c_coll->coll_bcast_module);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    cache->seg_base = (char *) opal_shmem_segment_attach (&cache->seg_ds);
+    if ( 0 == node_rank && NULL != cache->seg_base ) {
+        cache->header = (mca_common_ompio_cache_header_t *) cache->seg_base;
+        cache->slots = (mca_common_ompio_cache_slot_t *) (cache->header + 1);
+        cache->header->generation = 0;
+        cache->header->nslots = nslots;
+        cache->header->block_size = (int64_t) block_size;
+        for ( int64_t k = 0; k < nslots; k++ ) {
+            cache->slots[k].block = -1;
+            cache->slots[k].generation = -1;
+            cache->slots[k].length = 0;
+            cache->slots[k].wanted = -1;
+        }
+        opal_atomic_wmb ();
+    }
+
+    /* all the processes of the node use the segment, or none */
+    ok = (NULL != cache->seg_base);
+    ret = cache->node_comm->c_coll->coll_allreduce (MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN,
+                                                    cache->node_comm,
+                                                    cache->node_comm->c_coll->coll_allreduce_module);
+    if ( 0 == node_rank ) {
+        opal_shmem_unlink (&cache->seg_ds);
+    }
+    if ( OMPI_SUCCESS != ret || !ok ) {
+        if ( NULL != cache->seg_base ) {
+            opal_shmem_segment_detach (&cache->seg_ds);
+            cache->seg_base = NULL;
+        }
+        return OMPI_ERROR;
+    }
+
+    cache->header = (mca_common_ompio_cache_header_t *) cache->seg_base;
+    cache->slots = (mca_common_ompio_cache_slot_t *) (cache->header + 1);
+    cache->data = cache->seg_base + header_size;
+    return OMPI_SUCCESS;
+}
+
+int mca_common_ompio_cache_init (ompio_file_t *fh)
+{
+    struct mca_common_ompio_cache_t *cache;
+    opal_cstring_t *info_str;
+    size_t cache_size, block_size;
+    int flag, ret;
+
+    fh->f_read_cache = NULL;
+    opal_info_get (fh->f_info, "ompio_read_cache", &info_str, &flag);
+    if ( !flag ) {
+        return OMPI_SUCCESS;
+    }
+    OMPIO_MCA_PRINT_INFO(fh, "ompio_read_cache", info_str->string, "");
+    flag = !strncmp (info_str->string, "true", sizeof("true"));
+    OBJ_RELEASE(info_str);
+    if ( !flag || (fh->f_amode & MPI_MODE_WRONLY) ) {
+        return OMPI_SUCCESS;
+    }
+
+    cache_size = (size_t) OMPIO_MCA_GET(fh, read_cache_size);
+    opal_info_get (fh->f_info, "ompio_read_cache_size", &info_str, &flag);
+    if ( flag ) {
+        /* Info object trumps mca parameter value */
+        sscanf ( info_str->string, "%zu", &cache_size );
+        OMPIO_MCA_PRINT_INFO(fh, "ompio_read_cache_size", info_str->string, "");
+        OBJ_RELEASE(info_str);
+    }
+    block_size = (0 < fh->f_stripe_size) ? (size_t) fh->f_stripe_size : OMPIO_CACHE_DEFAULT_BLOCK_SIZE;
+
+    cache = (struct mca_common_ompio_cache_t *) calloc (1, sizeof (struct mca_common_ompio_cache_t));
+    if ( NULL == cache ) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    ret = ompi_comm_split_type (fh->f_comm, MPI_COMM_TYPE_SHARED, 0, &(MPI_INFO_NULL->super),
+                                &cache->node_comm);
+    if ( OMPI_SUCCESS != ret ) {
+        cache->node_comm = NULL;
+    }
+    if ( NULL == cache->node_comm ||
+         OMPI_SUCCESS != mca_common_ompio_cache_attach (cache, cache_size, block_size) ) {
+        opal_output (1, "mca_common_ompio_cache_init: could not set up a read cache of %zu bytes "
+                     "for file %s\n", cache_size, fh->f_filename);
+    }
+
+    fh->f_read_cache = cache;
+    return OMPI_SUCCESS;
+}
+
+void mca_common_ompio_cache_finalize (ompio_file_t *fh)
+{
+    struct mca_common_ompio_cache_t *cache = fh->f_read_cache;
+
+    if ( NULL == cache ) {
+        return;
+    }
+    if ( NULL != cache->seg_base ) {
+        opal_shmem_segment_detach (&cache->seg_ds);
+    }
+    if ( NULL != cache->node_comm ) {
+        ompi_comm_free (&cache->node_comm);
+    }
+    free (cache);
+    fh->f_read_cache = NULL;
+}
+
+void mca_common_ompio_cache_invalidate (ompio_file_t *fh)
+{
+    fh->f_ra_len = 0;
+    if ( NULL != fh->f_read_cache && NULL != fh->f_read_cache->seg_base ) {
+        opal_atomic_add_fetch_64 (&fh->f_read_cache->header->generation, 1);
+    }
+}
+
+/* Copy the pieces of the io array from the cache into memory, or just
+** check that they are all available if copy is false.
+*/
+static bool mca_common_ompio_cache_lookup (struct mca_common_ompio_cache_t *cache, int64_t generation,
+                                           mca_common_ompio_io_array_t *io_array, int num_io_entries,
+                                           bool copy)
+{
+    int64_t block_size = cache->header->block_size;
+    int64_t nslots = cache->header->nslots;
+    mca_common_ompio_cache_slot_t *slot;
+    int64_t offset, len, block, skip, n;
+    char *mem;
+
+    for ( int k = 0; k < num_io_entries; k++ ) {
+        offset = (int64_t)(intptr_t) io_array[k].offset;
+        len = (int64_t) io_array[k].length;
+        mem = (char *) io_array[k].memory_address;
+        while ( 0 < len ) {
+            block = offset / block_size;
+            skip = offset % block_size;
+            n = ( len < block_size - skip ) ? len : block_size - skip;
+            slot = &cache->slots[block % nslots];
+            if ( slot->block != block || slot->generation != generation || slot->length < skip + n ) {
+                return false;
+            }
+            if ( copy ) {
+                memcpy (mem, cache->data + (block % nslots) * block_size + skip, n);
+            }
+            offset += n;
+            mem += n;
+            len -= n;
+        }
+    }
+    return true;
+}
+
+/* Called by all the processes of the node after a collective read that
+** missed the cache. Each process flags the blocks it did not find, and the
+** node leader reads them into the cache on behalf of the node.
+*/
+static int mca_common_ompio_cache_fill (ompio_file_t *fh, struct mca_common_ompio_cache_t *cache,
+                                        int64_t generation, mca_common_ompio_io_array_t *io_array,
+                                        int num_io_entries)
+{
+    int64_t block_size = cache->header->block_size;
+    int64_t nslots = cache->header->nslots;
+    mca_common_ompio_io_array_t *fill_array = NULL;
+    mca_common_ompio_cache_slot_t *slot;
+    OMPI_MPI_OFFSET_TYPE file_size;
+    int64_t offset, end, block;
+    int num_fill = 0, ret;
+    size_t fill_bytes = 0;
+    ssize_t ret_code;
+
+    for ( int k = 0; k < num_io_entries; k++ ) {
+        offset = (int64_t)(intptr_t) io_array[k].offset;
+        end = offset + (int64_t) io_array[k].length;
+        for ( block = offset / block_size; block * block_size < end; block++ ) {
+            cache->slots[block % nslots].wanted = block;
+        }
+    }
+    ret = cache->node_comm->c_coll->coll_barrier (cache->node_comm,
+                                                  cache->node_comm->c_coll->coll_barrier_module);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    if ( 0 == ompi_comm_rank (cache->node_comm) ) {
+        ret = fh->f_fs->fs_file_get_size (fh, &file_size);
+        if ( OMPI_SUCCESS == ret ) {
+            fill_array = (mca_common_ompio_io_array_t *) malloc (nslots * sizeof (mca_common_ompio_io_array_t));
+            if ( NULL == fill_array ) {
+                ret = OMPI_ERR_OUT_OF_RESOURCE;
+            }
+        }
+        for ( int64_t k = 0; OMPI_SUCCESS == ret && k < nslots; k++ ) {
+            slot = &cache->slots[k];
+            block = slot->wanted;
+            slot->wanted = -1;
+            if ( 0 > block || (slot->block == block && slot->generation == generation) ||
+                 block * block_size >= file_size ) {
+                continue;
+            }
+            slot->block = -1;
+            slot->length = ( file_size - block * block_size < block_size ) ? file_size - block * block_size : block_size;
+            fill_array[num_fill].memory_address = cache->data + k * block_size;
+            fill_array[num_fill].offset = (IOVBASE_TYPE *)(intptr_t) (block * block_size);
+            fill_array[num_fill].length = (size_t) slot->length;
+            fill_bytes += fill_array[num_fill].length;
+            num_fill++;
+        }
+        if ( 0 < num_fill ) {
+            ret_code = mca_common_ompio_fbtl_io (fh, fill_array, num_fill, true);
+            if ( ret_code == (ssize_t) fill_bytes ) {
+                for ( int k = 0; k < num_fill; k++ ) {
+                    offset = (int64_t)(intptr_t) fill_array[k].offset;
+                    slot = &cache->slots[(offset / block_size) % nslots];
+                    slot->generation = generation;
+                    slot->block = offset / block_size;
+                }
+            }
+        }
+        free (fill_array);
+        opal_atomic_wmb ();
+    }
+
+    /* the leader is done filling, it is also the only one resetting the
+       wanted flags so there is no need to wait for it on failure */
+    return cache->node_comm->c_coll->coll_barrier (cache->node_comm,
+                                                   cache->node_comm->c_coll->coll_barrier_module);
+}
+
+int mca_common_ompio_cache_read_all (ompio_file_t *fh, void *buf, int count,
+                                     struct ompi_datatype_t *datatype,
+                                     ompi_status_public_t *status)
+{
+    struct mca_common_ompio_cache_t *cache = fh->f_read_cache;
+    OMPI_MPI_OFFSET_TYPE prev_offset;
+    mca_common_ompio_io_array_t *io_array = NULL;
+    struct iovec *decoded_iov = NULL;
+    uint32_t iov_count = 0;
+    size_t max_data = 0, total_bytes = 0, spc = 0;
+    int num_io_entries = 0, i = 0, j, hit, ret;
+    int64_t generation = 0;
+
+    if ( NULL == cache || fh->f_atomicity ) {
+        return fh->f_fcoll->fcoll_file_read_all (fh, buf, count, datatype, status);
+    }
+
+    /* the pieces of the file this process reads, the file pointer moves as
+       if they were read and is put back if the cache is missed */
+    mca_common_ompio_file_get_position (fh, &prev_offset);
+    ret = mca_common_ompio_decode_datatype (fh, datatype, count, buf, &max_data,
+                                            fh->f_mem_convertor, &decoded_iov, &iov_count);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+    if ( 0 < max_data && 0 < fh->f_iov_count ) {
+        j = fh->f_index_in_file_view;
+        ret = mca_common_ompio_build_io_array (fh, 0, 1, max_data, max_data, iov_count, decoded_iov,
+                                               &i, &j, &total_bytes, &spc, &io_array, &num_io_entries);
+        if ( OMPI_SUCCESS != ret ) {
+            free (decoded_iov);
+            return ret;
+        }
+    }
+
+    hit = 0;
+    if ( NULL != cache->seg_base ) {
+        generation = cache->header->generation;
+        opal_atomic_rmb ();
+        hit = mca_common_ompio_cache_lookup (cache, generation, io_array, num_io_entries, false);
+    }
+    ret = fh->f_comm->c_coll->coll_allreduce (MPI_IN_PLACE, &hit, 1, MPI_INT, MPI_MIN, fh->f_comm,
+                                              fh->f_comm->c_coll->coll_allreduce_module);
+    if ( OMPI_SUCCESS == ret && hit ) {
+        mca_common_ompio_cache_lookup (cache, generation, io_array, num_io_entries, true);
+        if ( MPI_STATUS_IGNORE != status ) {
+            status->_ucount = max_data;
+        }
+    }
+    else if ( OMPI_SUCCESS == ret ) {
+        mca_common_ompio_set_explicit_offset (fh, prev_offset);
+        ret = fh->f_fcoll->fcoll_file_read_all (fh, buf, count, datatype, status);
+        if ( OMPI_SUCCESS == ret && NULL != cache->seg_base ) {
+            ret = mca_common_ompio_cache_fill (fh, cache, generation, io_array, num_io_entries);
+        }
+    }
+
+    free (io_array);
+    free (decoded_iov);
+    return ret;
+}
@@ -0,0 +1,41 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_COMMON_OMPIO_CACHE_H
+#define MCA_COMMON_OMPIO_CACHE_H
+
+/* Node-shared cache of the file blocks accessed by the collective reads,
+** enabled with the ompio_read_cache info key at file open and limited to
+** ompio_read_cache_size bytes per node (io_ompio_read_cache_size mca
+** parameter by default). The node leader fills the cache with the blocks
+** the processes of its node missed, and a collective read is served from
+** memory when all the processes find their data in the cache of their
+** node. Any write, sync or change of the file size through ompio
+** invalidates the cache.
+*/
+
+#define OMPIO_CACHE_DEFAULT_BLOCK_SIZE (1024*1024)
+
+struct mca_common_ompio_cache_t;
+
+int mca_common_ompio_cache_init (ompio_file_t *fh);
+void mca_common_ompio_cache_finalize (ompio_file_t *fh);
+
+/* Drop the cached data of this file, including the read-ahead buffer */
+OMPI_DECLSPEC void mca_common_ompio_cache_invalidate (ompio_file_t *fh);
+
+/* fcoll_file_read_all going through the node cache if enabled */
+OMPI_DECLSPEC int mca_common_ompio_cache_read_all (ompio_file_t *fh, void *buf, int count,
+                                                   struct ompi_datatype_t *datatype,
+                                                   ompi_status_public_t *status);
+
+#endif
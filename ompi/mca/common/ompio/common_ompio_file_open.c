@@ -39,7 +39,10 @@
 
 #include <unistd.h>
 #include <math.h>
+#include <string.h>
 #include "common_ompio.h"
+#include "common_ompio_cache.h"
+#include "common_ompio_buffer.h"
 #include "ompi/mca/topo/topo.h"
 
 static mca_common_ompio_generate_current_file_view_fn_t generate_current_file_view_fn;
@@ -217,7 +220,14 @@ int mca_common_ompio_file_open (ompi_communicator_t *comm,
 
     }
 
-
+    if ( true == use_sharedfp ) {
+        /* not for the files opened internally by the sharedfp components */
+        ret = mca_common_ompio_cache_init (ompio_fh);
+        if ( OMPI_SUCCESS != ret ) {
+            goto fn_fail;
+        }
+        mca_common_ompio_trace_init (ompio_fh);
+    }
 
     return OMPI_SUCCESS;
 
@@ -235,6 +245,12 @@ int mca_common_ompio_file_close (ompio_file_t *ompio_fh)
     int delete_flag = 0;
     char name[256];
 
+    /* the other processes might read the data once the file is closed */
+    ret = mca_common_ompio_write_behind_flush (ompio_fh);
+    if ( OMPI_SUCCESS != ret ) {
+        opal_output (1,"mca_common_ompio_file_close: error flushing the write-behind buffer\n");
+    }
+
     /* Call coll_barrier only if collectives are set (same reasoning as below for f_fs) */
     if (NULL == ompio_fh->f_comm || NULL == ompio_fh->f_comm->c_coll) {
         return OMPI_SUCCESS;
@@ -269,6 +285,7 @@ int mca_common_ompio_file_close (ompio_file_t *ompio_fh)
             }
         }
     }
+    mca_common_ompio_trace_finalize (ompio_fh);
     if ( ompio_fh->f_amode & MPI_MODE_DELETE_ON_CLOSE ) {
         delete_flag = 1;
     }
@@ -277,6 +294,9 @@ int mca_common_ompio_file_close (ompio_file_t *ompio_fh)
     if( NULL != ompio_fh->f_sharedfp ){
         ret = ompio_fh->f_sharedfp->sharedfp_file_close(ompio_fh);
     }
+#if OMPIO_HAVE_CUFILE
+    mca_common_ompio_cufile_deregister (ompio_fh);
+#endif
     if ( NULL != ompio_fh->f_fs ) {
 	/* The pointer might not be set if file_close() is
 	** called from the file destructor in case of an error
@@ -328,6 +348,23 @@ int mca_common_ompio_file_close (ompio_file_t *ompio_fh)
         free (ompio_fh->f_decoded_iov);
         ompio_fh->f_decoded_iov = NULL;
     }
+    if (NULL != ompio_fh->f_view_cache_filetype) {
+        OBJ_RELEASE(ompio_fh->f_view_cache_filetype);
+        OBJ_RELEASE(ompio_fh->f_view_cache_etype);
+        ompio_fh->f_view_cache_filetype = NULL;
+        ompio_fh->f_view_cache_etype = NULL;
+    }
+    if (NULL != ompio_fh->f_mem_cache_type) {
+        OBJ_RELEASE(ompio_fh->f_mem_cache_type);
+        ompio_fh->f_mem_cache_type = NULL;
+    }
+    free (ompio_fh->f_mem_cache_iov);
+    ompio_fh->f_mem_cache_iov = NULL;
+    free (ompio_fh->f_wb_buf);
+    ompio_fh->f_wb_buf = NULL;
+    free (ompio_fh->f_ra_buf);
+    ompio_fh->f_ra_buf = NULL;
+    mca_common_ompio_cache_finalize (ompio_fh);
 
     if (NULL != ompio_fh->f_mem_convertor) {
         opal_convertor_cleanup (ompio_fh->f_mem_convertor);
@@ -385,6 +422,11 @@ int mca_common_ompio_file_get_size (ompio_file_t *ompio_fh,
 {
     int ret = OMPI_SUCCESS;
 
+    /* buffered data might extend the file */
+    ret = mca_common_ompio_write_behind_flush (ompio_fh);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
     ret = ompio_fh->f_fs->fs_file_get_size (ompio_fh, size);
 
     return ret;
@@ -465,6 +507,27 @@ int mca_common_ompio_set_file_defaults (ompio_file_t *fh)
        fh->f_stripe_size = 0;
        /*Decoded iovec of the file-view*/
        fh->f_decoded_iov = NULL;
+       fh->f_view_cache_etype = NULL;
+       fh->f_view_cache_filetype = NULL;
+       fh->f_view_cache_size = 0;
+       fh->f_mem_cache_type = NULL;
+       fh->f_mem_cache_count = 0;
+       fh->f_mem_cache_iov = NULL;
+       fh->f_mem_cache_iov_count = 0;
+       fh->f_mem_cache_max_data = 0;
+
+       fh->f_wb_buf = NULL;
+       fh->f_wb_offset = 0;
+       fh->f_wb_len = 0;
+       fh->f_wb_start = 0;
+
+       fh->f_ra_buf = NULL;
+       fh->f_ra_offset = 0;
+       fh->f_ra_len = 0;
+       fh->f_ra_next = 0;
+       fh->f_cufile = NULL;
+       memset (&fh->f_trace, 0, sizeof(fh->f_trace));
+       fh->f_read_cache = NULL;
        fh->f_etype = MPI_DATATYPE_NULL;
        fh->f_filetype = MPI_DATATYPE_NULL;
        fh->f_orig_filetype = MPI_DATATYPE_NULL;
@@ -572,6 +635,15 @@ int mca_common_ompio_create_incomplete_file_handle (const char *filename,
     return OMPI_SUCCESS;
 }
 
+static int decode_datatype_raw (struct ompio_file_t *fh,
+                                ompi_datatype_t *datatype,
+                                int count,
+                                const void *buf,
+                                size_t *max_data,
+                                opal_convertor_t *conv,
+                                struct iovec **iov,
+                                uint32_t *iovec_count);
+
 int mca_common_ompio_decode_datatype (struct ompio_file_t *fh,
                                       ompi_datatype_t *datatype,
                                       int count,
@@ -581,6 +653,67 @@ int mca_common_ompio_decode_datatype (struct ompio_file_t *fh,
                                       struct iovec **iov,
                                       uint32_t *iovec_count)
 {
+    uint32_t i;
+    int ret;
+
+    if ( conv != fh->f_mem_convertor ) {
+        return decode_datatype_raw (fh, datatype, count, buf, max_data, conv, iov, iovec_count);
+    }
+
+    /* The collective operations decode the memory datatype at every call, while
+       applications mostly reuse the same one over and over. Keep the last one
+       decoded against a NULL buffer and only rebase it on the user buffer. */
+    if ( datatype != fh->f_mem_cache_type || count != fh->f_mem_cache_count ) {
+        struct iovec *cache_iov = NULL;
+        uint32_t cache_iov_count = 0;
+        size_t cache_max_data = 0;
+
+        ret = decode_datatype_raw (fh, datatype, count, NULL, &cache_max_data, conv,
+                                   &cache_iov, &cache_iov_count);
+        if ( OMPI_SUCCESS != ret ) {
+            free (cache_iov);
+            return ret;
+        }
+        if ( NULL != fh->f_mem_cache_type ) {
+            OBJ_RELEASE(fh->f_mem_cache_type);
+        }
+        free (fh->f_mem_cache_iov);
+        OBJ_RETAIN(datatype);
+        fh->f_mem_cache_type      = datatype;
+        fh->f_mem_cache_count     = count;
+        fh->f_mem_cache_iov       = cache_iov;
+        fh->f_mem_cache_iov_count = cache_iov_count;
+        fh->f_mem_cache_max_data  = cache_max_data;
+    }
+
+    if ( 0 < fh->f_mem_cache_iov_count ) {
+        *iov = (struct iovec *) realloc (*iov, (*iovec_count + fh->f_mem_cache_iov_count) *
+                                         sizeof(struct iovec));
+        if (NULL == *iov) {
+            opal_output(1, "OUT OF MEMORY\n");
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        for (i=0 ; i<fh->f_mem_cache_iov_count ; i++) {
+            (*iov)[*iovec_count + i].iov_base = (IOVBASE_TYPE *)
+                ((ptrdiff_t)buf + (ptrdiff_t)fh->f_mem_cache_iov[i].iov_base);
+            (*iov)[*iovec_count + i].iov_len  = fh->f_mem_cache_iov[i].iov_len;
+        }
+    }
+    *iovec_count += fh->f_mem_cache_iov_count;
+    *max_data    += fh->f_mem_cache_max_data;
+
+    return OMPI_SUCCESS;
+}
+
+static int decode_datatype_raw (struct ompio_file_t *fh,
+                                ompi_datatype_t *datatype,
+                                int count,
+                                const void *buf,
+                                size_t *max_data,
+                                opal_convertor_t *conv,
+                                struct iovec **iov,
+                                uint32_t *iovec_count)
+{
 
 
 
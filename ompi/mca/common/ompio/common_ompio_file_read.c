@@ -34,9 +34,13 @@
 #include "common_ompio.h"
 #include "common_ompio_request.h"
 #include "common_ompio_buffer.h"
+#include "common_ompio_cache.h"
 #include <unistd.h>
+#include <string.h>
 #include <math.h>
 
+static ssize_t mca_common_ompio_read_ahead (ompio_file_t *fh);
+
 
 /* Read and write routines are split into two interfaces.
 **   The
@@ -81,6 +85,7 @@ int mca_common_ompio_file_read (ompio_file_t *fh,
       return ret;
     }
 
+    mca_common_ompio_trace_access (&fh->f_trace, 1, 0, datatype, count);
     if ( 0 == count ) {
         if ( MPI_STATUS_IGNORE != status ) {
             status->_ucount = 0;
@@ -168,7 +173,16 @@ int mca_common_ompio_file_read (ompio_file_t *fh,
                                           &fh->f_num_of_io_entries);
 
         if (fh->f_num_of_io_entries) {
-            ret_code = fh->f_fbtl->fbtl_preadv (fh);
+            if ( OMPI_SUCCESS != mca_common_ompio_write_behind_check (fh, fh->f_io_array,
+                                                                      fh->f_num_of_io_entries) ) {
+                ret = MPI_ERR_IO;
+            }
+            if ( 0 < OMPIO_MCA_GET(fh, read_ahead_size) && !fh->f_atomicity ) {
+                ret_code = mca_common_ompio_read_ahead (fh);
+            }
+            else {
+                ret_code = fh->f_fbtl->fbtl_preadv (fh);
+            }
             if ( 0<= ret_code ) {
                 real_bytes_read+=(size_t)ret_code;
             }
@@ -245,6 +259,7 @@ int mca_common_ompio_file_iread (ompio_file_t *fh,
       return ret;
     }
 
+    mca_common_ompio_trace_access (&fh->f_trace, 1, 0, datatype, count);
     mca_common_ompio_request_alloc ( &ompio_req, MCA_OMPIO_REQUEST_READ);
 
     if ( 0 == count ) {
@@ -339,6 +354,7 @@ int mca_common_ompio_file_iread (ompio_file_t *fh,
                                           &fh->f_num_of_io_entries);
 
 	if (fh->f_num_of_io_entries) {
+	  ret = mca_common_ompio_write_behind_check (fh, fh->f_io_array, fh->f_num_of_io_entries);
 	  fh->f_fbtl->fbtl_ipreadv (fh, (ompi_request_t *) ompio_req);
 	}
 
@@ -410,7 +426,15 @@ int mca_common_ompio_file_read_all (ompio_file_t *fh,
                                     ompi_status_public_t * status)
 {
     int ret = OMPI_SUCCESS;
+    mca_common_ompio_trace_mark_t mark;
+
+    /* the aggregators might read what this process wrote */
+    ret = mca_common_ompio_write_behind_flush (fh);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
 
+    mca_common_ompio_trace_coll_begin (&fh->f_trace, 1, datatype, count, &mark);
 
     if ( !( fh->f_flags & OMPIO_DATAREP_NATIVE ) &&
          !(datatype == &ompi_mpi_byte.dt  ||
@@ -435,7 +459,7 @@ int mca_common_ompio_file_read_all (ompio_file_t *fh,
         uint32_t iov_count = 0;
 
         OMPIO_PREPARE_READ_BUF(fh,buf,count,datatype,tbuf,&convertor,max_data,decoded_iov,iov_count);   
-        ret = fh->f_fcoll->fcoll_file_read_all (fh,
+        ret = mca_common_ompio_cache_read_all (fh,
                                                 decoded_iov->iov_base,
                                                 decoded_iov->iov_len,
                                                 MPI_BYTE,
@@ -450,12 +474,13 @@ int mca_common_ompio_file_read_all (ompio_file_t *fh,
         }
     }
     else {
-        ret = fh->f_fcoll->fcoll_file_read_all (fh,
+        ret = mca_common_ompio_cache_read_all (fh,
                                                 buf,
                                                 count,
                                                 datatype,
                                                 status);
     }
+    mca_common_ompio_trace_coll_end (&fh->f_trace, &mark);
     return ret;
 }
 
@@ -488,7 +513,14 @@ int mca_common_ompio_file_iread_all (ompio_file_t *fp,
                                      ompi_request_t **request)
 {
     int ret = OMPI_SUCCESS;
+    mca_common_ompio_trace_mark_t mark;
 
+    ret = mca_common_ompio_write_behind_flush (fp);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    mca_common_ompio_trace_coll_begin (&fp->f_trace, 1, datatype, count, &mark);
     if ( NULL != fp->f_fcoll->fcoll_file_iread_all ) {
 	ret = fp->f_fcoll->fcoll_file_iread_all (fp,
 						 buf,
@@ -502,6 +534,7 @@ int mca_common_ompio_file_iread_all (ompio_file_t *fp,
 	   individual non-blocking I/O operations. */
 	ret = mca_common_ompio_file_iread ( fp, buf, count, datatype, request );
     }
+    mca_common_ompio_trace_coll_end (&fp->f_trace, &mark);
 
     return ret;
 }
@@ -564,3 +597,88 @@ int mca_common_ompio_set_explicit_offset (ompio_file_t *fh,
 
     return OMPI_SUCCESS;
 }
+
+/* Read-ahead of the sequential independent reads                     */
+/**********************************************************************/
+
+/* Serve the io array of the file handle from the read-ahead buffer,
+** refilling it when a small piece starts right where the previous read
+** ended. Other pieces are read directly. Returns the number of bytes
+** read, like fbtl_preadv.
+*/
+static ssize_t mca_common_ompio_read_ahead (ompio_file_t *fh)
+{
+    size_t ra_size = (size_t) OMPIO_MCA_GET(fh, read_ahead_size);
+    mca_common_ompio_io_array_t entry;
+    OMPI_MPI_OFFSET_TYPE offset, ra_end;
+    size_t len, n, total_bytes = 0;
+    ssize_t ret_code;
+    char *mem;
+    int k;
+
+    if ( NULL == fh->f_ra_buf ) {
+        fh->f_ra_buf = (char *) malloc (ra_size);
+        if ( NULL == fh->f_ra_buf ) {
+            return fh->f_fbtl->fbtl_preadv (fh);
+        }
+    }
+
+    for ( k = 0; k < fh->f_num_of_io_entries; k++ ) {
+        offset = (OMPI_MPI_OFFSET_TYPE)(intptr_t) fh->f_io_array[k].offset;
+        len = fh->f_io_array[k].length;
+        mem = (char *) fh->f_io_array[k].memory_address;
+
+        while ( 0 < len ) {
+            ra_end = fh->f_ra_offset + (OMPI_MPI_OFFSET_TYPE) fh->f_ra_len;
+            if ( offset >= fh->f_ra_offset && offset < ra_end ) {
+                n = ( (OMPI_MPI_OFFSET_TYPE) len < ra_end - offset ) ? len : (size_t) (ra_end - offset);
+                memcpy (mem, fh->f_ra_buf + (offset - fh->f_ra_offset), n);
+            }
+            else if ( offset != fh->f_ra_next || len >= ra_size ) {
+                /* not sequential or large enough on its own */
+                entry.memory_address = mem;
+                entry.offset = (IOVBASE_TYPE *)(intptr_t) offset;
+                entry.length = len;
+                ret_code = mca_common_ompio_fbtl_io (fh, &entry, 1, true);
+                if ( 0 > ret_code ) {
+                    return ret_code;
+                }
+                n = (size_t) ret_code;
+                if ( n < len ) {
+                    /* end of file */
+                    fh->f_ra_next = offset + n;
+                    return (ssize_t) (total_bytes + n);
+                }
+            }
+            else {
+                /* the buffer goes beyond the piece, it must not miss
+                   any write still held back */
+                if ( OMPI_SUCCESS != mca_common_ompio_write_behind_flush (fh) ) {
+                    return OMPI_ERROR;
+                }
+                entry.memory_address = fh->f_ra_buf;
+                entry.offset = (IOVBASE_TYPE *)(intptr_t) offset;
+                entry.length = ra_size;
+                fh->f_ra_len = 0;
+                ret_code = mca_common_ompio_fbtl_io (fh, &entry, 1, true);
+                if ( 0 > ret_code ) {
+                    return ret_code;
+                }
+                fh->f_ra_offset = offset;
+                fh->f_ra_len = (size_t) ret_code;
+                if ( 0 == ret_code ) {
+                    /* end of file */
+                    return (ssize_t) total_bytes;
+                }
+                continue;
+            }
+            offset += n;
+            mem += n;
+            len -= n;
+            total_bytes += n;
+            fh->f_ra_next = offset;
+        }
+    }
+
+    return (ssize_t) total_bytes;
+}
@@ -32,6 +32,7 @@
 #include "ompi/mca/topo/topo.h"
 
 static OMPI_MPI_OFFSET_TYPE get_contiguous_chunk_size (ompio_file_t *, int flag);
+static void fold_regular_view (ompio_file_t *fh);
 static int datatype_duplicate (ompi_datatype_t *oldtype, ompi_datatype_t **newtype );
 static int datatype_duplicate  (ompi_datatype_t *oldtype, ompi_datatype_t **newtype )
 {
@@ -71,6 +72,7 @@ int mca_common_ompio_set_view (ompio_file_t *fh,
     size_t ftype_size;
     ptrdiff_t ftype_extent, lb, ub;
     ompi_datatype_t *newfiletype;
+    bool view_cached;
 
     if ( (MPI_DISPLACEMENT_CURRENT == disp) &&
          (fh->f_amode & MPI_MODE_SEQUENTIAL) ) {
@@ -82,6 +84,10 @@ int mca_common_ompio_set_view (ompio_file_t *fh,
         shared_fp_base_module->sharedfp_get_position(fh, &disp);
     }
     
+    /* Applications setting the same view at every step keep the decoded one */
+    view_cached = (filetype == fh->f_view_cache_filetype) && (etype == fh->f_view_cache_etype) &&
+        (NULL != fh->f_datarep) && (0 == strcmp (fh->f_datarep, datarep));
+
     if ( NULL != fh->f_etype ) {
         ompi_datatype_destroy (&fh->f_etype);
     }
@@ -91,9 +97,17 @@ int mca_common_ompio_set_view (ompio_file_t *fh,
     if ( NULL != fh->f_orig_filetype ) {
         ompi_datatype_destroy (&fh->f_orig_filetype);
     }
-    if (NULL != fh->f_decoded_iov) {
-        free (fh->f_decoded_iov);
-        fh->f_decoded_iov = NULL;
+    if (!view_cached) {
+        if (NULL != fh->f_decoded_iov) {
+            free (fh->f_decoded_iov);
+            fh->f_decoded_iov = NULL;
+        }
+        if (NULL != fh->f_view_cache_filetype) {
+            OBJ_RELEASE(fh->f_view_cache_filetype);
+            OBJ_RELEASE(fh->f_view_cache_etype);
+            fh->f_view_cache_filetype = NULL;
+            fh->f_view_cache_etype = NULL;
+        }
     }
 
     if (NULL != fh->f_datarep) {
@@ -148,26 +162,35 @@ int mca_common_ompio_set_view (ompio_file_t *fh,
 	fh->f_flags |= OMPIO_FILE_VIEW_IS_SET;
     }
 
-    fh->f_iov_count   = 0;
     fh->f_disp        = disp;
     fh->f_offset      = disp;
     fh->f_total_bytes = 0;
     fh->f_index_in_file_view=0;
     fh->f_position_in_file_view=0;
 
-    mca_common_ompio_decode_datatype (fh,
-                                      newfiletype,
-                                      1,
-                                      NULL,
-                                      &max_data,
-                                      fh->f_file_convertor,
-                                      &fh->f_decoded_iov,
-                                      &fh->f_iov_count);
-
-    opal_datatype_get_extent(&newfiletype->super, &lb, &fh->f_view_extent);
     opal_datatype_type_ub   (&newfiletype->super, &ub);
     opal_datatype_type_size (&etype->super, &fh->f_etype_size);
-    opal_datatype_type_size (&newfiletype->super, &fh->f_view_size);
+    if (!view_cached) {
+        fh->f_iov_count   = 0;
+        mca_common_ompio_decode_datatype (fh,
+                                          newfiletype,
+                                          1,
+                                          NULL,
+                                          &max_data,
+                                          fh->f_file_convertor,
+                                          &fh->f_decoded_iov,
+                                          &fh->f_iov_count);
+
+        opal_datatype_get_extent(&newfiletype->super, &lb, &fh->f_view_extent);
+        opal_datatype_type_size (&newfiletype->super, &fh->f_view_size);
+        fh->f_view_cache_size = fh->f_view_size;
+        fold_regular_view (fh);
+
+        OBJ_RETAIN(filetype);
+        OBJ_RETAIN(etype);
+        fh->f_view_cache_filetype = filetype;
+        fh->f_view_cache_etype    = etype;
+    }
     datatype_duplicate (etype, &fh->f_etype);
     // This file type is our own representation. The original is stored
     // in orig_file type, No need to set args on this one.
@@ -239,7 +262,18 @@ int mca_common_ompio_set_view (ompio_file_t *fh,
     }
         
 
-    if ( -1 != OMPIO_MCA_GET(fh, num_aggregators) || -1 != num_cb_nodes) {
+    if ( TOPOLOGY_AWARE == OMPIO_MCA_GET(fh, grouping_option) ) {
+        /* A requested number of aggregators is still spread over the nodes */
+        num_groups = ( -1 != num_cb_nodes ) ? num_cb_nodes : OMPIO_MCA_GET(fh, num_aggregators);
+        ret = mca_common_ompio_node_based_grouping(fh,
+                                                   &num_groups,
+                                                   contg_groups);
+        if ( OMPI_SUCCESS != ret ) {
+            opal_output(1, "mca_common_ompio_set_view: mca_common_ompio_node_based_grouping failed\n");
+            goto exit;
+        }
+    }
+    else if ( -1 != OMPIO_MCA_GET(fh, num_aggregators) || -1 != num_cb_nodes) {
         /* The user requested a particular number of aggregators */
         num_groups = OMPIO_MCA_GET(fh, num_aggregators);                                       
         if ( -1 != num_cb_nodes ) {
@@ -385,7 +419,7 @@ OMPI_MPI_OFFSET_TYPE get_contiguous_chunk_size (ompio_file_t *fh, int flag)
 
     if ( flag  ) {
         global_avg[0] = MCA_IO_DEFAULT_FILE_VIEW_SIZE;
-        fh->f_avg_view_size = fh->f_view_size;
+        fh->f_avg_view_size = fh->f_view_cache_size;
     }
     else {
         for (i=0 ; i<(int)fh->f_iov_count ; i++) {
@@ -395,7 +429,7 @@ OMPI_MPI_OFFSET_TYPE get_contiguous_chunk_size (ompio_file_t *fh, int flag)
             avg[0] = avg[0]/fh->f_iov_count;
         }
         avg[1] = (OMPI_MPI_OFFSET_TYPE) fh->f_iov_count;
-        avg[2] = (OMPI_MPI_OFFSET_TYPE) fh->f_view_size;
+        avg[2] = (OMPI_MPI_OFFSET_TYPE) fh->f_view_cache_size;
         
         fh->f_comm->c_coll->coll_allreduce (avg,
                                             global_avg,
@@ -413,3 +447,41 @@ OMPI_MPI_OFFSET_TYPE get_contiguous_chunk_size (ompio_file_t *fh, int flag)
 }
 
 
+
+/* A view made of blocks of identical length at a constant stride, which
+** exactly tiles its extent (e.g. a vector or a 1-D subarray), is equivalent to
+** a view of a single block with the stride as extent. Folding it avoids walking
+** (and keeping) one iovec per block of the filetype.
+*/
+static void fold_regular_view (ompio_file_t *fh)
+{
+    struct iovec *iov = fh->f_decoded_iov;
+    ptrdiff_t stride;
+    size_t len;
+    uint32_t i;
+
+    if ( 2 > fh->f_iov_count ) {
+        return;
+    }
+    len    = iov[0].iov_len;
+    stride = (ptrdiff_t)iov[1].iov_base - (ptrdiff_t)iov[0].iov_base;
+    if ( stride < (ptrdiff_t)len || 0 != (len % fh->f_etype_size) ||
+         (ptrdiff_t)fh->f_iov_count * stride != fh->f_view_extent ) {
+        return;
+    }
+    for ( i = 1; i < fh->f_iov_count; i++ ) {
+        if ( len != iov[i].iov_len ||
+             (ptrdiff_t)iov[i].iov_base != (ptrdiff_t)iov[0].iov_base + (ptrdiff_t)i * stride ) {
+            return;
+        }
+    }
+
+    fh->f_iov_count   = 1;
+    fh->f_view_extent = stride;
+    fh->f_view_size   = len;
+    fh->f_decoded_iov = (struct iovec *) realloc (iov, sizeof(struct iovec));
+    if ( NULL == fh->f_decoded_iov ) {
+        /* shrinking, keep the original array */
+        fh->f_decoded_iov = iov;
+    }
+}
@@ -28,13 +28,18 @@
 #include "ompi/mca/fcoll/base/base.h"
 #include "ompi/mca/fbtl/fbtl.h"
 #include "ompi/mca/fbtl/base/base.h"
+#include "opal/mca/timer/base/base.h"
 
 #include "common_ompio.h"
 #include "common_ompio_request.h"
 #include "common_ompio_buffer.h"
+#include "common_ompio_cache.h"
 #include <unistd.h>
+#include <string.h>
 #include <math.h>
 
+static ssize_t mca_common_ompio_write_behind (ompio_file_t *fh);
+
 int mca_common_ompio_file_write (ompio_file_t *fh,
 			       const void *buf,
 			       int count,
@@ -61,6 +66,8 @@ int mca_common_ompio_file_write (ompio_file_t *fh,
       return ret;
     }
 
+    mca_common_ompio_cache_invalidate (fh);
+    mca_common_ompio_trace_access (&fh->f_trace, 0, 0, datatype, count);
     
     if ( 0 == count ) {
         if ( MPI_STATUS_IGNORE != status ) {
@@ -151,7 +158,16 @@ int mca_common_ompio_file_write (ompio_file_t *fh,
                                           &fh->f_num_of_io_entries);
 
         if (fh->f_num_of_io_entries) {
-            ret_code =fh->f_fbtl->fbtl_pwritev (fh);
+            if ( 0 < OMPIO_MCA_GET(fh, write_behind_size) && !fh->f_atomicity ) {
+                ret_code = mca_common_ompio_write_behind (fh);
+                if ( 0 > ret_code ) {
+                    /* might as well be an earlier write failing on flush */
+                    ret = MPI_ERR_IO;
+                }
+            }
+            else {
+                ret_code =fh->f_fbtl->fbtl_pwritev (fh);
+            }
             if ( 0<= ret_code ) {
                 real_bytes_written+= (size_t)ret_code;
             }
@@ -220,6 +236,13 @@ int mca_common_ompio_file_iwrite (ompio_file_t *fh,
         ret = MPI_ERR_READ_ONLY;
       return ret;
     }
+
+    ret = mca_common_ompio_write_behind_flush (fh);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+    mca_common_ompio_cache_invalidate (fh);
+    mca_common_ompio_trace_access (&fh->f_trace, 0, 0, datatype, count);
     
     mca_common_ompio_request_alloc ( &ompio_req, MCA_OMPIO_REQUEST_WRITE);
 
@@ -387,6 +410,15 @@ int mca_common_ompio_file_write_all (ompio_file_t *fh,
                                      ompi_status_public_t *status)
 {
     int ret = OMPI_SUCCESS;
+    mca_common_ompio_trace_mark_t mark;
+
+    /* the aggregators write on behalf of this process */
+    ret = mca_common_ompio_write_behind_flush (fh);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+    mca_common_ompio_cache_invalidate (fh);
+    mca_common_ompio_trace_coll_begin (&fh->f_trace, 0, datatype, count, &mark);
     
     if ( !( fh->f_flags & OMPIO_DATAREP_NATIVE ) &&
          !(datatype == &ompi_mpi_byte.dt  ||
@@ -434,6 +466,7 @@ int mca_common_ompio_file_write_all (ompio_file_t *fh,
                                                  datatype,
                                                  status);
     }
+    mca_common_ompio_trace_coll_end (&fh->f_trace, &mark);
     return ret;
 }
 
@@ -466,6 +499,14 @@ int mca_common_ompio_file_iwrite_all (ompio_file_t *fp,
                                       ompi_request_t **request)
 {
     int ret = OMPI_SUCCESS;
+    mca_common_ompio_trace_mark_t mark;
+
+    ret = mca_common_ompio_write_behind_flush (fp);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+    mca_common_ompio_cache_invalidate (fp);
+    mca_common_ompio_trace_coll_begin (&fp->f_trace, 0, datatype, count, &mark);
 
     if ( NULL != fp->f_fcoll->fcoll_file_iwrite_all ) {
 	ret = fp->f_fcoll->fcoll_file_iwrite_all (fp,
@@ -480,6 +521,7 @@ int mca_common_ompio_file_iwrite_all (ompio_file_t *fp,
 	   individual non-blocking I/O operations. */
 	ret = mca_common_ompio_file_iwrite ( fp, buf, count, datatype, request );
     }
+    mca_common_ompio_trace_coll_end (&fp->f_trace, &mark);
 
     return ret;
 }
@@ -641,3 +683,138 @@ int mca_common_ompio_build_io_array ( ompio_file_t *fh, int index, int cycles,
     return OMPI_SUCCESS;
 }
 
+/* Blocking read or write of an io array other than the one of the file
+** handle, which the caller might be in the middle of.
+*/
+ssize_t mca_common_ompio_fbtl_io (ompio_file_t *fh, mca_common_ompio_io_array_t *io_array,
+                                  int num_io_entries, bool is_read)
+{
+    mca_common_ompio_io_array_t *f_io_array = fh->f_io_array;
+    int f_num_io_entries = fh->f_num_of_io_entries;
+    ssize_t ret_code;
+
+    fh->f_io_array = io_array;
+    fh->f_num_of_io_entries = num_io_entries;
+    if ( is_read ) {
+        ret_code = fh->f_fbtl->fbtl_preadv (fh);
+    }
+    else {
+        ret_code = fh->f_fbtl->fbtl_pwritev (fh);
+    }
+    fh->f_io_array = f_io_array;
+    fh->f_num_of_io_entries = f_num_io_entries;
+
+    return ret_code;
+}
+
+/* Write-behind buffer of the small independent writes               */
+/*********************************************************************/
+
+static bool mca_common_ompio_write_behind_expired (ompio_file_t *fh)
+{
+    uint64_t timeout = (uint64_t) OMPIO_MCA_GET(fh, write_behind_timeout) * 1000;
+
+    return ( 0 < fh->f_wb_len ) && ( opal_timer_base_get_usec() - fh->f_wb_start >= timeout );
+}
+
+int mca_common_ompio_write_behind_flush (ompio_file_t *fh)
+{
+    mca_common_ompio_io_array_t entry;
+    ssize_t ret_code;
+
+    if ( 0 == fh->f_wb_len ) {
+        return OMPI_SUCCESS;
+    }
+
+    entry.memory_address = fh->f_wb_buf;
+    entry.offset = (IOVBASE_TYPE *)(intptr_t) fh->f_wb_offset;
+    entry.length = fh->f_wb_len;
+    fh->f_wb_len = 0;
+
+    ret_code = mca_common_ompio_fbtl_io (fh, &entry, 1, false);
+
+    if ( ret_code != (ssize_t) entry.length ) {
+        opal_output (1, "mca_common_ompio_write_behind_flush: could not write the %ld buffered bytes "
+                     "at offset %ld\n", (long) entry.length, (long) fh->f_wb_offset);
+        return OMPI_ERROR;
+    }
+    return OMPI_SUCCESS;
+}
+
+int mca_common_ompio_write_behind_check (ompio_file_t *fh, mca_common_ompio_io_array_t *io_array,
+                                         int num_io_entries)
+{
+    OMPI_MPI_OFFSET_TYPE offset;
+    int k;
+
+    if ( 0 == fh->f_wb_len ) {
+        return OMPI_SUCCESS;
+    }
+    if ( mca_common_ompio_write_behind_expired (fh) ) {
+        return mca_common_ompio_write_behind_flush (fh);
+    }
+    for ( k = 0; k < num_io_entries; k++ ) {
+        offset = (OMPI_MPI_OFFSET_TYPE)(intptr_t) io_array[k].offset;
+        if ( offset < fh->f_wb_offset + (OMPI_MPI_OFFSET_TYPE) fh->f_wb_len &&
+             offset + (OMPI_MPI_OFFSET_TYPE) io_array[k].length > fh->f_wb_offset ) {
+            return mca_common_ompio_write_behind_flush (fh);
+        }
+    }
+    return OMPI_SUCCESS;
+}
+
+/* Copy the io array of the file handle into the write-behind buffer,
+** merging it with the buffered data as long as it extends or overwrites
+** it. Anything else flushes the buffer first, and a cycle larger than the
+** buffer is written directly. Returns the number of bytes accepted, like
+** fbtl_pwritev.
+*/
+static ssize_t mca_common_ompio_write_behind (ompio_file_t *fh)
+{
+    size_t wb_size = (size_t) OMPIO_MCA_GET(fh, write_behind_size);
+    mca_common_ompio_io_array_t *entry;
+    OMPI_MPI_OFFSET_TYPE offset;
+    size_t total_bytes = 0;
+    int k;
+
+    for ( k = 0; k < fh->f_num_of_io_entries; k++ ) {
+        total_bytes += fh->f_io_array[k].length;
+    }
+
+    if ( NULL == fh->f_wb_buf && total_bytes <= wb_size ) {
+        fh->f_wb_buf = (char *) malloc (wb_size);
+    }
+    if ( total_bytes > wb_size || NULL == fh->f_wb_buf ) {
+        if ( OMPI_SUCCESS != mca_common_ompio_write_behind_flush (fh) ) {
+            return OMPI_ERROR;
+        }
+        return fh->f_fbtl->fbtl_pwritev (fh);
+    }
+
+    for ( k = 0; k < fh->f_num_of_io_entries; k++ ) {
+        entry = &fh->f_io_array[k];
+        offset = (OMPI_MPI_OFFSET_TYPE)(intptr_t) entry->offset;
+        if ( 0 < fh->f_wb_len &&
+             ( offset < fh->f_wb_offset ||
+               offset > fh->f_wb_offset + (OMPI_MPI_OFFSET_TYPE) fh->f_wb_len ||
+               offset + (OMPI_MPI_OFFSET_TYPE) entry->length > fh->f_wb_offset + (OMPI_MPI_OFFSET_TYPE) wb_size ) ) {
+            if ( OMPI_SUCCESS != mca_common_ompio_write_behind_flush (fh) ) {
+                return OMPI_ERROR;
+            }
+        }
+        if ( 0 == fh->f_wb_len ) {
+            fh->f_wb_offset = offset;
+            fh->f_wb_start = opal_timer_base_get_usec();
+        }
+        memcpy (fh->f_wb_buf + (offset - fh->f_wb_offset), entry->memory_address, entry->length);
+        if ( offset + (OMPI_MPI_OFFSET_TYPE) entry->length > fh->f_wb_offset + (OMPI_MPI_OFFSET_TYPE) fh->f_wb_len ) {
+            fh->f_wb_len = (size_t) (offset + entry->length - fh->f_wb_offset);
+        }
+    }
+
+    if ( mca_common_ompio_write_behind_expired (fh) &&
+         OMPI_SUCCESS != mca_common_ompio_write_behind_flush (fh) ) {
+        return OMPI_ERROR;
+    }
+    return (ssize_t) total_bytes;
+}
@@ -0,0 +1,288 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/op/op.h"
+
+#include "common_ompio.h"
+#include "common_ompio_trace.h"
+
+/* values reduced over the processes of the file at close */
+enum {
+    TRACE_VIEWS = 0,
+    TRACE_INDEP_READS,
+    TRACE_INDEP_WRITES,
+    TRACE_COLL_READS,
+    TRACE_COLL_WRITES,
+    TRACE_BYTES_READ,
+    TRACE_BYTES_WRITTEN,
+    TRACE_FBTL_READS,
+    TRACE_FBTL_WRITES,
+    TRACE_FBTL_BYTES_READ,
+    TRACE_FBTL_BYTES_WRITTEN,
+    TRACE_AGGR_BYTES,
+    TRACE_AGGREGATORS,
+    TRACE_RANK_TIME,
+    TRACE_RANK_TIME2,
+    TRACE_RANK_BYTES,
+    TRACE_RANK_BYTES2,
+    TRACE_TIME,         /* OMPIO_TRACE_NUM_PHASES values */
+    TRACE_NUM_VALUES = TRACE_TIME + OMPIO_TRACE_NUM_PHASES
+};
+
+static size_t trace_io_array_length (ompio_file_t *fh)
+{
+    size_t length = 0;
+    int i;
+
+    for ( i = 0; i < fh->f_num_of_io_entries; i++ ) {
+        length += fh->f_io_array[i].length;
+    }
+    return length;
+}
+
+static void trace_fbtl_access (ompio_file_t *fh, int is_read, ssize_t bytes)
+{
+    mca_common_ompio_trace_t *trace = &fh->f_trace;
+
+    if ( is_read ) {
+        trace->fbtl_reads++;
+    }
+    else {
+        trace->fbtl_writes++;
+    }
+    if ( 0 < bytes ) {
+        if ( is_read ) {
+            trace->fbtl_bytes_read += bytes;
+        }
+        else {
+            trace->fbtl_bytes_written += bytes;
+        }
+        if ( 0 < trace->coll_depth ) {
+            trace->aggr_bytes += bytes;
+        }
+    }
+}
+
+static ssize_t trace_preadv (ompio_file_t *fh)
+{
+    mca_common_ompio_trace_mark_t mark;
+    ssize_t ret;
+
+    mca_common_ompio_trace_begin (&fh->f_trace, &mark);
+    ret = fh->f_trace.traced_fbtl->fbtl_preadv (fh);
+    mca_common_ompio_trace_end (&fh->f_trace, OMPIO_TRACE_FBTL_READ, &mark);
+    trace_fbtl_access (fh, 1, ret);
+
+    return ret;
+}
+
+static ssize_t trace_pwritev (ompio_file_t *fh)
+{
+    mca_common_ompio_trace_mark_t mark;
+    ssize_t ret;
+
+    mca_common_ompio_trace_begin (&fh->f_trace, &mark);
+    ret = fh->f_trace.traced_fbtl->fbtl_pwritev (fh);
+    mca_common_ompio_trace_end (&fh->f_trace, OMPIO_TRACE_FBTL_WRITE, &mark);
+    trace_fbtl_access (fh, 0, ret);
+
+    return ret;
+}
+
+/* only the time to post the non-blocking operations is accounted */
+static ssize_t trace_ipreadv (ompio_file_t *fh, ompi_request_t *request)
+{
+    mca_common_ompio_trace_mark_t mark;
+    size_t length = trace_io_array_length (fh);
+    ssize_t ret;
+
+    mca_common_ompio_trace_begin (&fh->f_trace, &mark);
+    ret = fh->f_trace.traced_fbtl->fbtl_ipreadv (fh, request);
+    mca_common_ompio_trace_end (&fh->f_trace, OMPIO_TRACE_FBTL_READ, &mark);
+    trace_fbtl_access (fh, 1, (0 > ret) ? ret : (ssize_t) length);
+
+    return ret;
+}
+
+static ssize_t trace_ipwritev (ompio_file_t *fh, ompi_request_t *request)
+{
+    mca_common_ompio_trace_mark_t mark;
+    size_t length = trace_io_array_length (fh);
+    ssize_t ret;
+
+    mca_common_ompio_trace_begin (&fh->f_trace, &mark);
+    ret = fh->f_trace.traced_fbtl->fbtl_ipwritev (fh, request);
+    mca_common_ompio_trace_end (&fh->f_trace, OMPIO_TRACE_FBTL_WRITE, &mark);
+    trace_fbtl_access (fh, 0, (0 > ret) ? ret : (ssize_t) length);
+
+    return ret;
+}
+
+void mca_common_ompio_trace_init (ompio_file_t *fh)
+{
+    mca_common_ompio_trace_t *trace = &fh->f_trace;
+
+    memset (trace, 0, sizeof(*trace));
+    if ( 0 >= OMPIO_MCA_GET(fh, trace) || NULL == fh->f_fbtl ) {
+        return;
+    }
+
+    trace->enabled     = true;
+    trace->traced_fbtl = fh->f_fbtl;
+    trace->fbtl        = *fh->f_fbtl;
+    /* the fcoll components check for the non-blocking functions */
+    trace->fbtl.fbtl_preadv  = (NULL != fh->f_fbtl->fbtl_preadv)   ? trace_preadv   : NULL;
+    trace->fbtl.fbtl_pwritev = (NULL != fh->f_fbtl->fbtl_pwritev)  ? trace_pwritev  : NULL;
+    trace->fbtl.fbtl_ipreadv = (NULL != fh->f_fbtl->fbtl_ipreadv)  ? trace_ipreadv  : NULL;
+    trace->fbtl.fbtl_ipwritev = (NULL != fh->f_fbtl->fbtl_ipwritev) ? trace_ipwritev : NULL;
+    fh->f_fbtl = &trace->fbtl;
+}
+
+static const char *trace_fs_name (ompio_file_t *fh)
+{
+    switch ( fh->f_fstype ) {
+    case UFS:    return "ufs";
+    case PVFS2:  return "pvfs2";
+    case LUSTRE: return "lustre";
+    case PLFS:   return "plfs";
+    case IME:    return "ime";
+    case GPFS:   return "gpfs";
+    default:     return "unknown";
+    }
+}
+
+static void trace_print_summary (ompio_file_t *fh, double *sum, double *max)
+{
+    const char *fs = trace_fs_name (fh);
+    uint64_t id = 14695981039346656037ULL;
+    double mean, aggr_mean;
+    const char *c;
+
+    /* record id of the file, as darshan it is a hash of the name */
+    for ( c = fh->f_filename; NULL != c && '\0' != *c; c++ ) {
+        id = (id ^ (unsigned char) *c) * 1099511628211ULL;
+    }
+
+#define TRACE_PRINT_COUNTER(_module, _name, _value)                     \
+    printf ("%s\t-1\t%llu\t%s\t%lld\t%s\t/\t%s\n", _module, (unsigned long long) id, _name, \
+            (long long) (_value), fh->f_filename, fs)
+#define TRACE_PRINT_FCOUNTER(_module, _name, _value)                    \
+    printf ("%s\t-1\t%llu\t%s\t%f\t%s\t/\t%s\n", _module, (unsigned long long) id, _name, \
+            (double) (_value), fh->f_filename, fs)
+
+    printf ("# ompio I/O summary, %d processes\n", fh->f_size);
+    printf ("#<module>\t<rank>\t<record id>\t<counter>\t<value>\t<file name>\t<mount pt>\t<fs type>\n");
+    TRACE_PRINT_COUNTER ("MPI-IO", "MPIIO_INDEP_READS",   sum[TRACE_INDEP_READS]);
+    TRACE_PRINT_COUNTER ("MPI-IO", "MPIIO_INDEP_WRITES",  sum[TRACE_INDEP_WRITES]);
+    TRACE_PRINT_COUNTER ("MPI-IO", "MPIIO_COLL_READS",    sum[TRACE_COLL_READS]);
+    TRACE_PRINT_COUNTER ("MPI-IO", "MPIIO_COLL_WRITES",   sum[TRACE_COLL_WRITES]);
+    TRACE_PRINT_COUNTER ("MPI-IO", "MPIIO_VIEWS",         sum[TRACE_VIEWS]);
+    TRACE_PRINT_COUNTER ("MPI-IO", "MPIIO_BYTES_READ",    sum[TRACE_BYTES_READ]);
+    TRACE_PRINT_COUNTER ("MPI-IO", "MPIIO_BYTES_WRITTEN", sum[TRACE_BYTES_WRITTEN]);
+    TRACE_PRINT_FCOUNTER ("MPI-IO", "MPIIO_F_META_TIME",  sum[TRACE_TIME + OMPIO_TRACE_VIEW]);
+    TRACE_PRINT_FCOUNTER ("MPI-IO", "MPIIO_F_SLOWEST_RANK_TIME", max[TRACE_RANK_TIME]);
+
+    /* variance over the processes of the time and bytes of each process */
+    mean = sum[TRACE_RANK_TIME] / fh->f_size;
+    TRACE_PRINT_FCOUNTER ("MPI-IO", "MPIIO_F_VARIANCE_RANK_TIME",
+                          sum[TRACE_RANK_TIME2] / fh->f_size - mean * mean);
+    mean = sum[TRACE_RANK_BYTES] / fh->f_size;
+    TRACE_PRINT_FCOUNTER ("MPI-IO", "MPIIO_F_VARIANCE_RANK_BYTES",
+                          sum[TRACE_RANK_BYTES2] / fh->f_size - mean * mean);
+
+    TRACE_PRINT_COUNTER ("POSIX", "POSIX_READS",          sum[TRACE_FBTL_READS]);
+    TRACE_PRINT_COUNTER ("POSIX", "POSIX_WRITES",         sum[TRACE_FBTL_WRITES]);
+    TRACE_PRINT_COUNTER ("POSIX", "POSIX_BYTES_READ",     sum[TRACE_FBTL_BYTES_READ]);
+    TRACE_PRINT_COUNTER ("POSIX", "POSIX_BYTES_WRITTEN",  sum[TRACE_FBTL_BYTES_WRITTEN]);
+    TRACE_PRINT_FCOUNTER ("POSIX", "POSIX_F_READ_TIME",   sum[TRACE_TIME + OMPIO_TRACE_FBTL_READ]);
+    TRACE_PRINT_FCOUNTER ("POSIX", "POSIX_F_WRITE_TIME",  sum[TRACE_TIME + OMPIO_TRACE_FBTL_WRITE]);
+
+    /* not part of darshan */
+    TRACE_PRINT_FCOUNTER ("OMPIO", "OMPIO_F_SHUFFLE_TIME",      sum[TRACE_TIME + OMPIO_TRACE_SHUFFLE]);
+    TRACE_PRINT_FCOUNTER ("OMPIO", "OMPIO_F_MAX_SHUFFLE_TIME",  max[TRACE_TIME + OMPIO_TRACE_SHUFFLE]);
+    TRACE_PRINT_FCOUNTER ("OMPIO", "OMPIO_F_SHAREDFP_TIME",     sum[TRACE_TIME + OMPIO_TRACE_SHAREDFP]);
+    TRACE_PRINT_FCOUNTER ("OMPIO", "OMPIO_F_MAX_SHAREDFP_TIME", max[TRACE_TIME + OMPIO_TRACE_SHAREDFP]);
+    TRACE_PRINT_COUNTER ("OMPIO", "OMPIO_AGGREGATORS",          sum[TRACE_AGGREGATORS]);
+    TRACE_PRINT_COUNTER ("OMPIO", "OMPIO_AGGR_BYTES",           sum[TRACE_AGGR_BYTES]);
+    TRACE_PRINT_COUNTER ("OMPIO", "OMPIO_AGGR_MAX_BYTES",       max[TRACE_AGGR_BYTES]);
+    /* bytes of the busiest aggregator relative to the average of the aggregators */
+    aggr_mean = (0 < sum[TRACE_AGGREGATORS]) ? sum[TRACE_AGGR_BYTES] / sum[TRACE_AGGREGATORS] : 0.0;
+    TRACE_PRINT_FCOUNTER ("OMPIO", "OMPIO_F_AGGR_IMBALANCE",
+                          (0 < aggr_mean) ? max[TRACE_AGGR_BYTES] / aggr_mean : 0.0);
+    fflush (stdout);
+
+#undef TRACE_PRINT_COUNTER
+#undef TRACE_PRINT_FCOUNTER
+}
+
+void mca_common_ompio_trace_finalize (ompio_file_t *fh)
+{
+    mca_common_ompio_trace_t *trace = &fh->f_trace;
+    double local[TRACE_NUM_VALUES], sum[TRACE_NUM_VALUES], max[TRACE_NUM_VALUES];
+    double rank_time = 0.0, rank_bytes;
+    int i, ret;
+
+    if ( !trace->enabled ) {
+        return;
+    }
+
+    if ( 2 <= OMPIO_MCA_GET(fh, trace) ) {
+        for ( i = 0; i < OMPIO_TRACE_NUM_PHASES; i++ ) {
+            local[TRACE_TIME + i] = trace->time[i];
+            rank_time += trace->time[i];
+        }
+        rank_bytes = (double) (trace->bytes_read + trace->bytes_written);
+
+        local[TRACE_VIEWS]              = trace->views;
+        local[TRACE_INDEP_READS]        = trace->indep_reads;
+        local[TRACE_INDEP_WRITES]       = trace->indep_writes;
+        local[TRACE_COLL_READS]         = trace->coll_reads;
+        local[TRACE_COLL_WRITES]        = trace->coll_writes;
+        local[TRACE_BYTES_READ]         = trace->bytes_read;
+        local[TRACE_BYTES_WRITTEN]      = trace->bytes_written;
+        local[TRACE_FBTL_READS]         = trace->fbtl_reads;
+        local[TRACE_FBTL_WRITES]        = trace->fbtl_writes;
+        local[TRACE_FBTL_BYTES_READ]    = trace->fbtl_bytes_read;
+        local[TRACE_FBTL_BYTES_WRITTEN] = trace->fbtl_bytes_written;
+        local[TRACE_AGGR_BYTES]         = trace->aggr_bytes;
+        local[TRACE_AGGREGATORS]        = (0 < trace->aggr_bytes) ? 1.0 : 0.0;
+        local[TRACE_RANK_TIME]          = rank_time;
+        local[TRACE_RANK_TIME2]         = rank_time * rank_time;
+        local[TRACE_RANK_BYTES]         = rank_bytes;
+        local[TRACE_RANK_BYTES2]        = rank_bytes * rank_bytes;
+
+        ret = fh->f_comm->c_coll->coll_reduce (local, sum, TRACE_NUM_VALUES, MPI_DOUBLE, MPI_SUM,
+                                               OMPIO_ROOT, fh->f_comm,
+                                               fh->f_comm->c_coll->coll_reduce_module);
+        if ( OMPI_SUCCESS == ret ) {
+            ret = fh->f_comm->c_coll->coll_reduce (local, max, TRACE_NUM_VALUES, MPI_DOUBLE, MPI_MAX,
+                                                   OMPIO_ROOT, fh->f_comm,
+                                                   fh->f_comm->c_coll->coll_reduce_module);
+        }
+        if ( OMPI_SUCCESS != ret ) {
+            opal_output (1, "mca_common_ompio_trace_finalize: could not collect the I/O statistics\n");
+        }
+        else if ( OMPIO_ROOT == fh->f_rank ) {
+            trace_print_summary (fh, sum, max);
+        }
+    }
+
+    fh->f_fbtl = trace->traced_fbtl;
+    trace->enabled = false;
+}
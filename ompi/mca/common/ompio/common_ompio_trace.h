@@ -0,0 +1,144 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_COMMON_OMPIO_TRACE_H
+#define MCA_COMMON_OMPIO_TRACE_H
+
+#include "opal/mca/timer/base/base.h"
+#include "ompi/mca/fbtl/fbtl.h"
+#include "ompi/datatype/ompi_datatype.h"
+
+/* Per file statistics of the I/O operations, collected if the io_ompio_trace
+** mca parameter is set. They are exported as MPI_T performance variables
+** bound to the file handle, and with io_ompio_trace=2 summarized at file
+** close in the format of the darshan-parser counters. The fbtl module of
+** the file is wrapped to account the calls into the file system.
+**
+** The time of a phase excludes the time of the phases nested in it, e.g.
+** the shuffle time of a collective write does not include the writes of the
+** aggregators, and the sharedfp time is essentially the time spent managing
+** the shared file pointer.
+*/
+
+enum {
+    OMPIO_TRACE_VIEW = 0,      /* set_view */
+    OMPIO_TRACE_SHUFFLE,       /* collective operations */
+    OMPIO_TRACE_FBTL_READ,     /* fbtl read calls */
+    OMPIO_TRACE_FBTL_WRITE,    /* fbtl write calls */
+    OMPIO_TRACE_SHAREDFP,      /* shared file pointer operations */
+    OMPIO_TRACE_NUM_PHASES
+};
+
+typedef struct mca_common_ompio_trace_t {
+    bool enabled;
+    int coll_depth;                        /* > 0 within a collective operation */
+    /* MPI-IO level */
+    unsigned long long views;
+    unsigned long long indep_reads, indep_writes;
+    unsigned long long coll_reads, coll_writes;
+    unsigned long long bytes_read, bytes_written;
+    /* fbtl level */
+    unsigned long long fbtl_reads, fbtl_writes;
+    unsigned long long fbtl_bytes_read, fbtl_bytes_written;
+    unsigned long long aggr_bytes;         /* fbtl bytes of the collective operations */
+    double time[OMPIO_TRACE_NUM_PHASES];   /* seconds */
+    uint64_t accounted;                    /* usec accounted in all the phases */
+    mca_fbtl_base_module_t *traced_fbtl;   /* the module selected for the file */
+    mca_fbtl_base_module_t fbtl;           /* and its wrapper */
+} mca_common_ompio_trace_t;
+
+typedef struct mca_common_ompio_trace_mark_t {
+    uint64_t start;
+    uint64_t accounted;
+} mca_common_ompio_trace_mark_t;
+
+static inline void mca_common_ompio_trace_begin (mca_common_ompio_trace_t *trace,
+                                                 mca_common_ompio_trace_mark_t *mark)
+{
+    if ( trace->enabled ) {
+        mark->start     = opal_timer_base_get_usec ();
+        mark->accounted = trace->accounted;
+    }
+}
+
+static inline void mca_common_ompio_trace_end (mca_common_ompio_trace_t *trace, int phase,
+                                               mca_common_ompio_trace_mark_t *mark)
+{
+    if ( trace->enabled ) {
+        uint64_t elapsed = opal_timer_base_get_usec () - mark->start;
+        uint64_t nested  = trace->accounted - mark->accounted;
+
+        elapsed = (elapsed > nested) ? elapsed - nested : 0;
+        trace->time[phase] += elapsed * 1e-6;
+        trace->accounted   += elapsed;
+    }
+}
+
+/* An MPI-IO level access. The independent accesses the collective
+** operations might be implemented with are not counted. */
+static inline void mca_common_ompio_trace_access (mca_common_ompio_trace_t *trace, int is_read,
+                                                  int is_coll, struct ompi_datatype_t *datatype,
+                                                  int count)
+{
+    size_t bytes = 0;
+
+    if ( !trace->enabled || 0 < trace->coll_depth ) {
+        return;
+    }
+    ompi_datatype_type_size (datatype, &bytes);
+    bytes *= count;
+    if ( is_read ) {
+        if ( is_coll ) {
+            trace->coll_reads++;
+        }
+        else {
+            trace->indep_reads++;
+        }
+        trace->bytes_read += bytes;
+    }
+    else {
+        if ( is_coll ) {
+            trace->coll_writes++;
+        }
+        else {
+            trace->indep_writes++;
+        }
+        trace->bytes_written += bytes;
+    }
+}
+
+/* Bracket a collective operation, accounted in the shuffle phase */
+static inline void mca_common_ompio_trace_coll_begin (mca_common_ompio_trace_t *trace, int is_read,
+                                                      struct ompi_datatype_t *datatype, int count,
+                                                      mca_common_ompio_trace_mark_t *mark)
+{
+    mca_common_ompio_trace_access (trace, is_read, 1, datatype, count);
+    trace->coll_depth++;
+    mca_common_ompio_trace_begin (trace, mark);
+}
+
+static inline void mca_common_ompio_trace_coll_end (mca_common_ompio_trace_t *trace,
+                                                    mca_common_ompio_trace_mark_t *mark)
+{
+    mca_common_ompio_trace_end (trace, OMPIO_TRACE_SHUFFLE, mark);
+    trace->coll_depth--;
+}
+
+struct ompio_file_t;
+
+/* Wraps the fbtl module if tracing is enabled */
+void mca_common_ompio_trace_init (struct ompio_file_t *fh);
+
+/* Collective, prints the summary if requested and restores the fbtl module */
+void mca_common_ompio_trace_finalize (struct ompio_file_t *fh);
+
+#endif
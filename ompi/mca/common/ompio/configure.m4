@@ -15,6 +15,45 @@
 AC_DEFUN([MCA_ompi_common_ompio_CONFIG],[
     AC_CONFIG_FILES([ompi/mca/common/ompio/Makefile])
 
+    OPAL_VAR_SCOPE_PUSH([common_ompio_cufile_happy common_ompio_save_CPPFLAGS])
+
+    # GPUDirect Storage, letting the aggregators access the file
+    # from device memory
+    AC_ARG_WITH([cufile],
+                [AS_HELP_STRING([--with-cufile(=DIR)],
+                                [Build GPUDirect Storage (cuFile) support in ompio, optionally adding DIR/include, DIR/lib, and DIR/lib64 to the search path for headers and libraries])])
+    AC_ARG_WITH([cufile-libdir],
+                [AS_HELP_STRING([--with-cufile-libdir=DIR],
+                                [Search for cuFile libraries in DIR])])
+
+    common_ompio_cufile_happy=no
+    AS_IF([test "$with_cufile" != "no" && test "$CUDA_SUPPORT" = "1"],
+          [common_ompio_save_CPPFLAGS=$CPPFLAGS
+           CPPFLAGS="$CPPFLAGS $common_cuda_CPPFLAGS"
+           OPAL_CHECK_PACKAGE([common_ompio], [cufile.h], [cufile], [cuFileHandleRegister],
+                              [], [$with_cufile], [$with_cufile_libdir],
+                              [common_ompio_cufile_happy=yes],
+                              [common_ompio_cufile_happy=no])
+           CPPFLAGS=$common_ompio_save_CPPFLAGS
+           common_ompio_CPPFLAGS="$common_ompio_CPPFLAGS $common_cuda_CPPFLAGS"])
+
+    AS_IF([test "$common_ompio_cufile_happy" = "no" && test -n "$with_cufile" && test "$with_cufile" != "no"],
+          [AC_MSG_WARN([cuFile support requested but not found])
+           AC_MSG_ERROR([Aborting])])
+
+    AS_IF([test "$common_ompio_cufile_happy" = "yes"],
+          [AC_DEFINE_UNQUOTED([OMPIO_HAVE_CUFILE], [1], [Whether ompio uses GPUDirect Storage])],
+          [AC_DEFINE_UNQUOTED([OMPIO_HAVE_CUFILE], [0], [Whether ompio uses GPUDirect Storage])
+           common_ompio_CPPFLAGS=
+           common_ompio_LDFLAGS=
+           common_ompio_LIBS=])
+
+    AC_SUBST([common_ompio_CPPFLAGS])
+    AC_SUBST([common_ompio_LDFLAGS])
+    AC_SUBST([common_ompio_LIBS])
+
+    OPAL_VAR_SCOPE_POP
+
     AS_IF([test "$enable_io_ompio" != "no"],
           [$1],
           [$2])
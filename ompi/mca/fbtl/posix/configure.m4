@@ -35,7 +35,29 @@ AC_DEFUN([MCA_ompi_fbtl_posix_CONFIG],[
     AC_CHECK_FUNCS([pwritev],[],[])
     AC_CHECK_FUNCS([preadv],[],[])
 
+    # optional io_uring mode of the non-blocking operations
+    AC_ARG_WITH([liburing], [AS_HELP_STRING([--with-liburing(=DIR)],
+                [Build the io_uring mode of the posix fbtl, searching for headers in DIR])])
+    OPAL_CHECK_WITHDIR([liburing], [$with_liburing], [include/liburing.h])
+
+    fbtl_posix_have_io_uring=0
+    AS_IF([test "$with_liburing" != "no"],
+          [AS_IF([test -n "$with_liburing" && test "$with_liburing" != "yes"],
+                 [fbtl_posix_liburing_dir=$with_liburing])
+           OPAL_CHECK_PACKAGE([fbtl_posix_liburing], [liburing.h], [uring],
+                              [io_uring_register_files_update], [],
+                              [$fbtl_posix_liburing_dir], [],
+                              [fbtl_posix_have_io_uring=1], [])
+           AS_IF([test "$fbtl_posix_have_io_uring" = "0" && test -n "$with_liburing"],
+                 [AC_MSG_ERROR([liburing support requested but not found.  Aborting])])])
+    AC_DEFINE_UNQUOTED([OMPI_FBTL_POSIX_HAVE_IO_URING], [$fbtl_posix_have_io_uring],
+                       [Whether the posix fbtl can use io_uring])
+
     AS_IF([test "$fbtl_posix_happy" = "yes"],
           [$1],
           [$2])
+
+    AC_SUBST([fbtl_posix_liburing_CPPFLAGS])
+    AC_SUBST([fbtl_posix_liburing_LDFLAGS])
+    AC_SUBST([fbtl_posix_liburing_LIBS])
 ])dnl
@@ -113,6 +113,9 @@ int mca_fbtl_posix_module_init (ompio_file_t *file) {
 
 
 int mca_fbtl_posix_module_finalize (ompio_file_t *file) {
+#if OMPI_FBTL_POSIX_HAVE_IO_URING
+    mca_fbtl_posix_io_uring_file_close (file);
+#endif
     return OMPI_SUCCESS;
 }
 
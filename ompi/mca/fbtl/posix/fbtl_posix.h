@@ -34,6 +34,10 @@ extern bool mca_fbtl_posix_write_datasieving;
 extern size_t mca_fbtl_posix_max_block_size;
 extern size_t mca_fbtl_posix_max_gap_size;
 extern size_t mca_fbtl_posix_max_tmpbuf_size;
+extern bool mca_fbtl_posix_io_uring;
+extern int mca_fbtl_posix_io_uring_depth;
+extern bool mca_fbtl_posix_io_uring_direct;
+extern size_t mca_fbtl_posix_io_uring_direct_alignment;
 
 BEGIN_C_DECLS
 
@@ -71,6 +75,16 @@ int mca_fbtl_posix_lock ( struct flock *lock, ompio_file_t *fh, int op,
                           int *lock_counter);
 void  mca_fbtl_posix_unlock ( struct flock *lock, ompio_file_t *fh, int *lock_counter );
 
+#if OMPI_FBTL_POSIX_HAVE_IO_URING
+/* Post the non-blocking operation described by the io array of the file
+ * on the io_uring, returns OMPI_ERR_NOT_AVAILABLE if it has to go through
+ * POSIX aio instead */
+int  mca_fbtl_posix_io_uring_post ( ompio_file_t *fh, ompi_request_t *request, int type );
+void mca_fbtl_posix_io_uring_file_close ( ompio_file_t *fh );
+void mca_fbtl_posix_io_uring_open ( void );
+void mca_fbtl_posix_io_uring_close ( void );
+#endif
+
 
 struct mca_fbtl_posix_request_data_t {
     int            aio_req_count;       /* total number of aio reqs */
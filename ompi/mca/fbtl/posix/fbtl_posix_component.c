@@ -42,10 +42,18 @@ bool mca_fbtl_posix_write_datasieving = true;
 size_t mca_fbtl_posix_max_block_size  = 1048576;  // 1MB
 size_t mca_fbtl_posix_max_gap_size    = 4096;     // Size of a block in many linux fs
 size_t mca_fbtl_posix_max_tmpbuf_size = 67108864; // 64 MB
+bool mca_fbtl_posix_io_uring = false;
+int mca_fbtl_posix_io_uring_depth = 256;
+bool mca_fbtl_posix_io_uring_direct = false;
+size_t mca_fbtl_posix_io_uring_direct_alignment = 4096;
 /*
  * Private functions
  */
 static int register_component(void);
+#if OMPI_FBTL_POSIX_HAVE_IO_URING
+static int open_component(void);
+static int close_component(void);
+#endif
 
 /*
  * Instantiate the public struct with all of our public information
@@ -64,6 +72,10 @@ mca_fbtl_base_component_2_0_0_t mca_fbtl_posix_component = {
         MCA_BASE_MAKE_VERSION(component, OMPI_MAJOR_VERSION, OMPI_MINOR_VERSION,
                               OMPI_RELEASE_VERSION),
         .mca_register_component_params = register_component,
+#if OMPI_FBTL_POSIX_HAVE_IO_URING
+        .mca_open_component = open_component,
+        .mca_close_component = close_component,
+#endif
     },
     .fbtlm_data = {
         /* This component is checkpointable */
@@ -129,6 +141,62 @@ static int register_component(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_fbtl_posix_write_datasieving );
 
-    
+#if OMPI_FBTL_POSIX_HAVE_IO_URING
+    mca_fbtl_posix_io_uring = false;
+    (void) mca_base_component_var_register(&mca_fbtl_posix_component.fbtlm_version,
+                                           "io_uring", "Parameter indicating whether to submit the non-blocking operations "
+                                           "through io_uring instead of POSIX aio. Falls back to aio if io_uring is not "
+                                           "available at run time. Default: false.",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_fbtl_posix_io_uring );
+
+    mca_fbtl_posix_io_uring_depth = 256;
+    (void) mca_base_component_var_register(&mca_fbtl_posix_component.fbtlm_version,
+                                           "io_uring_depth", "Maximum number of operations in flight on the io_uring, "
+                                           "all files together. Default: 256.",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_fbtl_posix_io_uring_depth );
+
+    mca_fbtl_posix_io_uring_direct = false;
+    (void) mca_base_component_var_register(&mca_fbtl_posix_component.fbtlm_version,
+                                           "io_uring_direct", "Parameter indicating whether to also open the files with O_DIRECT, "
+                                           "the io_uring operations with aligned offset, buffers and lengths bypassing the page "
+                                           "cache. Default: false.",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_fbtl_posix_io_uring_direct );
+
+    mca_fbtl_posix_io_uring_direct_alignment = 4096;
+    (void) mca_base_component_var_register(&mca_fbtl_posix_component.fbtlm_version,
+                                           "io_uring_direct_alignment", "Alignment in bytes required by O_DIRECT on the file "
+                                           "system. Default: 4096 bytes.",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_fbtl_posix_io_uring_direct_alignment );
+    if (0 == mca_fbtl_posix_io_uring_direct_alignment) {
+        mca_fbtl_posix_io_uring_direct = false;
+    }
+#endif
+
+    return OMPI_SUCCESS;
+}
+
+#if OMPI_FBTL_POSIX_HAVE_IO_URING
+static int open_component(void)
+{
+    mca_fbtl_posix_io_uring_open();
+    return OMPI_SUCCESS;
+}
+
+static int close_component(void)
+{
+    mca_fbtl_posix_io_uring_close();
     return OMPI_SUCCESS;
 }
+#endif
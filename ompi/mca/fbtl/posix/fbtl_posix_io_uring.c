@@ -0,0 +1,478 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * io_uring mode of the non-blocking operations. Instead of one POSIX aio
+ * request (i.e. one syscall in a glibc helper thread) per entry of the io
+ * array, the entries contiguous in the file are merged in readv/writev
+ * operations, submitted in batches on a ring shared by all the files of the
+ * process, and their completions are reaped from the ompio request progress.
+ * The files are registered as fixed files of the ring, and when requested
+ * the file is also opened with O_DIRECT, the operations whose offset, buffers
+ * and lengths are all aligned going through the direct descriptor.
+ */
+
+#include "ompi_config.h"
+#include "fbtl_posix.h"
+
+#if OMPI_FBTL_POSIX_HAVE_IO_URING
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <liburing.h>
+
+#include "opal/mca/threads/mutex.h"
+#include "opal/util/output.h"
+#include "ompi/constants.h"
+#include "ompi/mca/fbtl/base/base.h"
+
+/* the ring holds two slots (buffered and direct) per file */
+#define FBTL_POSIX_IO_URING_MAX_FILES 32
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+typedef struct mca_fbtl_posix_io_uring_file_t {
+    ompio_file_t *fh;    /* NULL if the entry is free */
+    int fd;
+    int direct_fd;       /* -1 if the file is not opened with O_DIRECT */
+} mca_fbtl_posix_io_uring_file_t;
+
+struct mca_fbtl_posix_io_uring_data_t;
+
+typedef struct mca_fbtl_posix_io_uring_op_t {
+    struct mca_fbtl_posix_io_uring_data_t *data;
+    struct iovec *iov;   /* first iovec not completely transferred */
+    int iovcnt;
+    off_t offset;
+    size_t length;       /* bytes not yet transferred */
+} mca_fbtl_posix_io_uring_op_t;
+
+typedef struct mca_fbtl_posix_io_uring_data_t {
+    int type;                              /* read or write */
+    int nops;
+    int next_op;                           /* first op never submitted */
+    int inflight;                          /* ops submitted and not yet completed */
+    int open_ops;                          /* ops not yet completed */
+    int nretry;                            /* partially completed ops to submit again */
+    int error;                             /* errno of the first failure */
+    ssize_t total_len;
+    mca_fbtl_posix_io_uring_op_t *ops;
+    mca_fbtl_posix_io_uring_op_t **retry;
+    struct iovec *iov;
+    mca_fbtl_posix_io_uring_file_t *file;
+    struct flock lock;
+    int lock_counter;
+    ompio_file_t *fh;
+} mca_fbtl_posix_io_uring_data_t;
+
+static struct {
+    opal_mutex_t lock;
+    int state;         /* 0 not initialized, 1 ready, -1 not available */
+    bool fixed_files;  /* the descriptors are registered */
+    int inflight;      /* operations in the ring, all files merged */
+    struct io_uring ring;
+    mca_fbtl_posix_io_uring_file_t files[FBTL_POSIX_IO_URING_MAX_FILES];
+} mca_fbtl_posix_io_uring_state = {.state = 0};
+
+void mca_fbtl_posix_io_uring_open(void)
+{
+    OBJ_CONSTRUCT(&mca_fbtl_posix_io_uring_state.lock, opal_mutex_t);
+}
+
+/* Called with the lock held */
+static int mca_fbtl_posix_io_uring_init(void)
+{
+    int fds[2 * FBTL_POSIX_IO_URING_MAX_FILES];
+    int ret, i;
+
+    ret = io_uring_queue_init(mca_fbtl_posix_io_uring_depth, &mca_fbtl_posix_io_uring_state.ring, 0);
+    if (0 != ret) {
+        opal_output_verbose(1, ompi_fbtl_base_framework.framework_output,
+                            "fbtl:posix: cannot create the io_uring (%s), using aio", strerror(-ret));
+        mca_fbtl_posix_io_uring_state.state = -1;
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+    for (i = 0; i < 2 * FBTL_POSIX_IO_URING_MAX_FILES; i++) {
+        fds[i] = -1;
+    }
+    for (i = 0; i < FBTL_POSIX_IO_URING_MAX_FILES; i++) {
+        mca_fbtl_posix_io_uring_state.files[i].fh = NULL;
+    }
+    /* sparse tables need 5.5, without it the descriptors are used directly */
+    mca_fbtl_posix_io_uring_state.fixed_files =
+        (0 == io_uring_register_files(&mca_fbtl_posix_io_uring_state.ring, fds,
+                                      2 * FBTL_POSIX_IO_URING_MAX_FILES));
+    mca_fbtl_posix_io_uring_state.inflight = 0;
+    mca_fbtl_posix_io_uring_state.state = 1;
+    return OMPI_SUCCESS;
+}
+
+void mca_fbtl_posix_io_uring_close(void)
+{
+    if (1 == mca_fbtl_posix_io_uring_state.state) {
+        io_uring_queue_exit(&mca_fbtl_posix_io_uring_state.ring);
+    }
+    mca_fbtl_posix_io_uring_state.state = 0;
+    OBJ_DESTRUCT(&mca_fbtl_posix_io_uring_state.lock);
+}
+
+/* Called with the lock held */
+static mca_fbtl_posix_io_uring_file_t *mca_fbtl_posix_io_uring_get_file(ompio_file_t *fh)
+{
+    mca_fbtl_posix_io_uring_file_t *file = NULL;
+    int i, fds[2];
+
+    for (i = 0; i < FBTL_POSIX_IO_URING_MAX_FILES; i++) {
+        if (fh == mca_fbtl_posix_io_uring_state.files[i].fh) {
+            return &mca_fbtl_posix_io_uring_state.files[i];
+        }
+        if ((NULL == file) && (NULL == mca_fbtl_posix_io_uring_state.files[i].fh)) {
+            file = &mca_fbtl_posix_io_uring_state.files[i];
+        }
+    }
+    if (NULL == file) {
+        return NULL; /* too many open files, they go through aio */
+    }
+
+    file->fh = fh;
+    file->fd = fh->fd;
+    file->direct_fd = -1;
+#ifdef O_DIRECT
+    if (mca_fbtl_posix_io_uring_direct) {
+        int flags = fcntl(fh->fd, F_GETFL);
+        if (-1 != flags) {
+            file->direct_fd = open(fh->f_filename, (flags & O_ACCMODE) | O_DIRECT);
+        }
+        if (-1 == file->direct_fd) {
+            opal_output_verbose(10, ompi_fbtl_base_framework.framework_output,
+                                "fbtl:posix: cannot open %s with O_DIRECT (%s)", fh->f_filename,
+                                strerror(errno));
+        }
+    }
+#endif
+    if (mca_fbtl_posix_io_uring_state.fixed_files) {
+        i = file - mca_fbtl_posix_io_uring_state.files;
+        fds[0] = file->fd;
+        fds[1] = file->direct_fd;
+        if (2 != io_uring_register_files_update(&mca_fbtl_posix_io_uring_state.ring, 2 * i, fds,
+                                                2)) {
+            if (-1 != file->direct_fd) {
+                close(file->direct_fd);
+            }
+            file->fh = NULL;
+            return NULL;
+        }
+    }
+    return file;
+}
+
+void mca_fbtl_posix_io_uring_file_close(ompio_file_t *fh)
+{
+    mca_fbtl_posix_io_uring_file_t *file;
+    int i, fds[2] = {-1, -1};
+
+    if (1 != mca_fbtl_posix_io_uring_state.state) {
+        return;
+    }
+    OPAL_THREAD_LOCK(&mca_fbtl_posix_io_uring_state.lock);
+    for (i = 0; i < FBTL_POSIX_IO_URING_MAX_FILES; i++) {
+        file = &mca_fbtl_posix_io_uring_state.files[i];
+        if (fh != file->fh) {
+            continue;
+        }
+        if (mca_fbtl_posix_io_uring_state.fixed_files) {
+            (void) io_uring_register_files_update(&mca_fbtl_posix_io_uring_state.ring, 2 * i, fds,
+                                                  2);
+        }
+        if (-1 != file->direct_fd) {
+            close(file->direct_fd);
+        }
+        file->fh = NULL;
+        break;
+    }
+    OPAL_THREAD_UNLOCK(&mca_fbtl_posix_io_uring_state.lock);
+}
+
+static bool mca_fbtl_posix_io_uring_aligned(const mca_fbtl_posix_io_uring_op_t *op)
+{
+    const size_t align = mca_fbtl_posix_io_uring_direct_alignment;
+
+    if (0 != ((size_t) op->offset % align)) {
+        return false;
+    }
+    for (int i = 0; i < op->iovcnt; i++) {
+        if ((0 != ((uintptr_t) op->iov[i].iov_base % align)) || (0 != (op->iov[i].iov_len % align))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Called with the lock held. Prepare the submission of the op, the caller
+ * flushes the submission queue. */
+static bool mca_fbtl_posix_io_uring_prep(mca_fbtl_posix_io_uring_op_t *op)
+{
+    mca_fbtl_posix_io_uring_file_t *file = op->data->file;
+    struct io_uring_sqe *sqe;
+    bool direct = (-1 != file->direct_fd) && mca_fbtl_posix_io_uring_aligned(op);
+    int fd;
+
+    if (mca_fbtl_posix_io_uring_state.inflight >= mca_fbtl_posix_io_uring_depth) {
+        return false;
+    }
+    if (NULL == (sqe = io_uring_get_sqe(&mca_fbtl_posix_io_uring_state.ring))) {
+        return false;
+    }
+    if (mca_fbtl_posix_io_uring_state.fixed_files) {
+        fd = 2 * (int) (file - mca_fbtl_posix_io_uring_state.files) + (direct ? 1 : 0);
+    } else {
+        fd = direct ? file->direct_fd : file->fd;
+    }
+    if (FBTL_POSIX_READ == op->data->type) {
+        io_uring_prep_readv(sqe, fd, op->iov, op->iovcnt, op->offset);
+    } else {
+        io_uring_prep_writev(sqe, fd, op->iov, op->iovcnt, op->offset);
+    }
+    if (mca_fbtl_posix_io_uring_state.fixed_files) {
+        io_uring_sqe_set_flags(sqe, IOSQE_FIXED_FILE);
+    }
+    io_uring_sqe_set_data(sqe, op);
+    op->data->inflight++;
+    mca_fbtl_posix_io_uring_state.inflight++;
+    return true;
+}
+
+/* Called with the lock held */
+static void mca_fbtl_posix_io_uring_submit(mca_fbtl_posix_io_uring_data_t *data)
+{
+    bool posted = false;
+
+    while (0 < data->nretry) {
+        if (!mca_fbtl_posix_io_uring_prep(data->retry[data->nretry - 1])) {
+            goto flush;
+        }
+        data->nretry--;
+        posted = true;
+    }
+    while (data->next_op < data->nops) {
+        if (!mca_fbtl_posix_io_uring_prep(&data->ops[data->next_op])) {
+            break;
+        }
+        data->next_op++;
+        posted = true;
+    }
+
+flush:
+    if (posted) {
+        /* on a transient failure the entries stay in the queue and are
+         * flushed by the next submission */
+        (void) io_uring_submit(&mca_fbtl_posix_io_uring_state.ring);
+    }
+}
+
+/* Called with the lock held */
+static void mca_fbtl_posix_io_uring_complete(mca_fbtl_posix_io_uring_op_t *op, int res)
+{
+    mca_fbtl_posix_io_uring_data_t *data = op->data;
+    size_t done;
+
+    data->inflight--;
+    mca_fbtl_posix_io_uring_state.inflight--;
+    if (res < 0) {
+        if (0 == data->error) {
+            data->error = -res;
+        }
+        data->open_ops--;
+        return;
+    }
+
+    done = (size_t) res;
+    data->total_len += done;
+    op->length -= done;
+    op->offset += done;
+    if ((0 == op->length) || ((0 == done) && (FBTL_POSIX_READ == data->type))) {
+        /* done, or the end of the file */
+        data->open_ops--;
+        return;
+    }
+
+    /* Partial completion, submit the rest again */
+    while (done >= op->iov->iov_len) {
+        done -= op->iov->iov_len;
+        op->iov++;
+        op->iovcnt--;
+    }
+    op->iov->iov_base = (char *) op->iov->iov_base + done;
+    op->iov->iov_len -= done;
+    data->retry[data->nretry++] = op;
+}
+
+/* Called with the lock held. Reap the completions of all the files. */
+static void mca_fbtl_posix_io_uring_reap(void)
+{
+    struct io_uring_cqe *cqe;
+    unsigned head, count = 0;
+
+    io_uring_for_each_cqe (&mca_fbtl_posix_io_uring_state.ring, head, cqe) {
+        mca_fbtl_posix_io_uring_complete((mca_fbtl_posix_io_uring_op_t *) io_uring_cqe_get_data(cqe),
+                                         cqe->res);
+        count++;
+    }
+    io_uring_cq_advance(&mca_fbtl_posix_io_uring_state.ring, count);
+}
+
+static bool mca_fbtl_posix_io_uring_progress(mca_ompio_request_t *req)
+{
+    mca_fbtl_posix_io_uring_data_t *data = (mca_fbtl_posix_io_uring_data_t *) req->req_data;
+    bool done;
+
+    OPAL_THREAD_LOCK(&mca_fbtl_posix_io_uring_state.lock);
+    mca_fbtl_posix_io_uring_reap();
+    if (0 == data->error) {
+        mca_fbtl_posix_io_uring_submit(data);
+    }
+    /* the kernel may still write in the buffers until all the submitted
+     * operations are completed, even after a failure */
+    done = (0 == data->inflight) && ((0 != data->error) || (0 == data->open_ops));
+    OPAL_THREAD_UNLOCK(&mca_fbtl_posix_io_uring_state.lock);
+
+    if (done) {
+        if (0 != data->error) {
+            opal_output(1, "mca_fbtl_posix_io_uring_progress: error in %s: %s",
+                        (FBTL_POSIX_READ == data->type) ? "readv" : "writev",
+                        strerror(data->error));
+            req->req_ompi.req_status.MPI_ERROR = OMPI_ERROR;
+        } else {
+            req->req_ompi.req_status.MPI_ERROR = OMPI_SUCCESS;
+        }
+        req->req_ompi.req_status._ucount = data->total_len;
+        mca_fbtl_posix_unlock(&data->lock, data->fh, &data->lock_counter);
+        if (data->fh->f_atomicity) {
+            mca_fbtl_posix_unlock(&data->lock, data->fh, &data->lock_counter);
+        }
+    }
+    return done;
+}
+
+static void mca_fbtl_posix_io_uring_request_free(mca_ompio_request_t *req)
+{
+    free(req->req_data);
+    req->req_data = NULL;
+}
+
+int mca_fbtl_posix_io_uring_post(ompio_file_t *fh, ompi_request_t *request, int type)
+{
+    mca_ompio_request_t *req = (mca_ompio_request_t *) request;
+    mca_common_ompio_io_array_t *entries = fh->f_io_array;
+    const int nentries = fh->f_num_of_io_entries;
+    mca_fbtl_posix_io_uring_file_t *file = NULL;
+    mca_fbtl_posix_io_uring_data_t *data;
+    mca_fbtl_posix_io_uring_op_t *op = NULL;
+    off_t start_offset, end_offset;
+    int i, ret;
+
+    if (-1 == mca_fbtl_posix_io_uring_state.state) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+    OPAL_THREAD_LOCK(&mca_fbtl_posix_io_uring_state.lock);
+    if ((1 == mca_fbtl_posix_io_uring_state.state)
+        || ((0 == mca_fbtl_posix_io_uring_state.state)
+            && (OMPI_SUCCESS == mca_fbtl_posix_io_uring_init()))) {
+        file = mca_fbtl_posix_io_uring_get_file(fh);
+    }
+    OPAL_THREAD_UNLOCK(&mca_fbtl_posix_io_uring_state.lock);
+    if (NULL == file) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
+    /* a single allocation for the worst case of one op per entry */
+    data = (mca_fbtl_posix_io_uring_data_t *) malloc(
+        sizeof(mca_fbtl_posix_io_uring_data_t)
+        + nentries * (sizeof(mca_fbtl_posix_io_uring_op_t) + sizeof(mca_fbtl_posix_io_uring_op_t *)
+                      + sizeof(struct iovec)));
+    if (NULL == data) {
+        opal_output(1, "mca_fbtl_posix_io_uring_post: could not allocate memory\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    data->ops = (mca_fbtl_posix_io_uring_op_t *) (data + 1);
+    data->retry = (mca_fbtl_posix_io_uring_op_t **) (data->ops + nentries);
+    data->iov = (struct iovec *) (data->retry + nentries);
+    data->type = type;
+    data->nops = 0;
+    data->next_op = 0;
+    data->inflight = 0;
+    data->nretry = 0;
+    data->error = 0;
+    data->total_len = 0;
+    data->file = file;
+    data->lock_counter = 0;
+    data->fh = fh;
+
+    /* merge the entries contiguous in the file in vectored operations */
+    start_offset = end_offset = (0 < nentries) ? (off_t) (intptr_t) entries[0].offset : 0;
+    for (i = 0; i < nentries; i++) {
+        off_t offset = (off_t) (intptr_t) entries[i].offset;
+
+        data->iov[i].iov_base = entries[i].memory_address;
+        data->iov[i].iov_len = entries[i].length;
+        if ((NULL != op) && (offset == (op->offset + (off_t) op->length))
+            && (op->iovcnt < IOV_MAX)) {
+            op->iovcnt++;
+            op->length += entries[i].length;
+        } else {
+            op = &data->ops[data->nops++];
+            op->data = data;
+            op->iov = &data->iov[i];
+            op->iovcnt = 1;
+            op->offset = offset;
+            op->length = entries[i].length;
+        }
+        if (offset < start_offset) {
+            start_offset = offset;
+        }
+        if ((offset + (off_t) entries[i].length) > end_offset) {
+            end_offset = offset + (off_t) entries[i].length;
+        }
+    }
+    data->open_ops = data->nops;
+
+    if (fh->f_atomicity) {
+        OMPIO_SET_ATOMICITY_LOCK(fh, data->lock, data->lock_counter,
+                                 (FBTL_POSIX_READ == type) ? F_RDLCK : F_WRLCK);
+    }
+    ret = mca_fbtl_posix_lock(&data->lock, fh, (FBTL_POSIX_READ == type) ? F_RDLCK : F_WRLCK,
+                              start_offset, end_offset - start_offset, OMPIO_LOCK_ENTIRE_REGION,
+                              &data->lock_counter);
+    if (0 < ret) {
+        opal_output(1, "mca_fbtl_posix_io_uring_post: error in mca_fbtl_posix_lock() error ret=%d %s",
+                    ret, strerror(errno));
+        mca_fbtl_posix_unlock(&data->lock, fh, &data->lock_counter);
+        free(data);
+        return OMPI_ERROR;
+    }
+
+    OPAL_THREAD_LOCK(&mca_fbtl_posix_io_uring_state.lock);
+    mca_fbtl_posix_io_uring_submit(data);
+    OPAL_THREAD_UNLOCK(&mca_fbtl_posix_io_uring_state.lock);
+
+    req->req_data = data;
+    req->req_progress_fn = mca_fbtl_posix_io_uring_progress;
+    req->req_free_fn = mca_fbtl_posix_io_uring_request_free;
+    return OMPI_SUCCESS;
+}
+
+#endif /* OMPI_FBTL_POSIX_HAVE_IO_URING */
@@ -43,6 +43,15 @@ ssize_t  mca_fbtl_posix_ipwritev (ompio_file_t *fh,
     int i=0, ret;
     off_t start_offset, end_offset, total_length;
 
+#if OMPI_FBTL_POSIX_HAVE_IO_URING
+    if ( mca_fbtl_posix_io_uring ) {
+        ret = mca_fbtl_posix_io_uring_post ( fh, request, FBTL_POSIX_WRITE );
+        if ( OMPI_ERR_NOT_AVAILABLE != ret ) {
+            return ret;
+        }
+    }
+#endif
+
     data = (mca_fbtl_posix_request_data_t *) malloc ( sizeof (mca_fbtl_posix_request_data_t));
     if ( NULL == data ) {
         opal_output (1,"mca_fbtl_posix_ipwritev: could not allocate memory\n");
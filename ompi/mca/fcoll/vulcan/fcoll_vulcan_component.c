@@ -44,6 +44,7 @@ int mca_fcoll_vulcan_priority = 10;
 int mca_fcoll_vulcan_num_groups = 1;
 int mca_fcoll_vulcan_write_chunksize = -1;
 int mca_fcoll_vulcan_async_io = 0;
+int mca_fcoll_vulcan_pipeline_depth = 2;
 
 /*
  * Local function
@@ -111,5 +112,14 @@ vulcan_register(void)
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_async_io);
 
+    mca_fcoll_vulcan_pipeline_depth = 2;
+    (void) mca_base_component_var_register(&mca_fcoll_vulcan_component.fcollm_version,
+                                           "pipeline_depth", "Number of cycles of the collective write in flight "
+                                           "at once, the aggregation buffer is split among them. Values below 2 "
+                                           "are treated as 2. Only used with asynchronous I/O (default: 2)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_pipeline_depth);
+
     return OMPI_SUCCESS;
 }
@@ -28,6 +28,7 @@
 #include "ompi/mca/fcoll/base/fcoll_base_coll_array.h"
 #include "ompi/mca/common/ompio/common_ompio.h"
 #include "ompi/mca/io/io.h"
+#include "ompi/mca/common/ompio/common_ompio_buffer.h"
 #include "math.h"
 #include "ompi/mca/pml/pml.h"
 #include <unistd.h>
@@ -96,6 +97,7 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
     MPI_Request *send_req = NULL;
     MPI_Request recv_req = MPI_REQUEST_NULL;
     int my_aggregator =-1;
+    int gpu_direct = 0;
 
     int* blocklength_proc       = NULL;
     ptrdiff_t* displs_proc      = NULL;
@@ -357,7 +359,23 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
 	    goto exit;
 	}
 
-	global_buf = (char *) malloc (bytes_per_cycle);
+#if OMPIO_HAVE_CUFILE
+        {
+            /* read with GPUDirect Storage into device memory, the data is
+               sent from there by the CUDA-aware pml */
+            int is_gpu, is_managed;
+            mca_common_ompio_check_gpu_buf ( fh, buf, &is_gpu, &is_managed);
+            if ( is_gpu && !is_managed && OMPI_SUCCESS == mca_common_ompio_cufile_register (fh) ) {
+                gpu_direct = 1;
+            }
+        }
+        if ( gpu_direct ) {
+            global_buf = (char *) mca_common_ompio_alloc_device_buf (fh, bytes_per_cycle);
+        }
+        else
+#endif
+        /* registered with the CUDA-aware pml, if any */
+	global_buf = (char *) mca_common_ompio_alloc_buf (fh, bytes_per_cycle);
 	if (NULL == global_buf){
 	    opal_output(1, "OUT OF MEMORY\n");
 	    ret = OMPI_ERR_OUT_OF_RESOURCE;
@@ -681,6 +699,16 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
 #endif
 
             if (fh->f_num_of_io_entries) {
+#if OMPIO_HAVE_CUFILE
+                if ( gpu_direct ) {
+                    if ( 0 > mca_common_ompio_cufile_io (fh, fh->f_io_array, fh->f_num_of_io_entries, 1)) {
+                        opal_output (1, "READ FAILED\n");
+                        ret = OMPI_ERROR;
+                        goto exit;
+                    }
+                }
+                else
+#endif
                 if ( 0 >  fh->f_fbtl->fbtl_preadv (fh)) {
                     opal_output (1, "READ FAILED\n");
                     ret = OMPI_ERROR;
@@ -876,7 +904,13 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
 
 exit:
     if (NULL != global_buf) {
-        free (global_buf);
+#if OMPIO_HAVE_CUFILE
+        if ( gpu_direct ) {
+            mca_common_ompio_release_device_buf (fh, global_buf);
+        }
+        else
+#endif
+        mca_common_ompio_release_buf (fh, global_buf);
         global_buf = NULL;
     }
     if (NULL != sorted) {
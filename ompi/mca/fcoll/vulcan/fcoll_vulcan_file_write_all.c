@@ -29,6 +29,7 @@
 #include "ompi/mca/common/ompio/common_ompio.h"
 #include "ompi/mca/io/io.h"
 #include "ompi/mca/common/ompio/common_ompio_request.h"
+#include "ompi/mca/common/ompio/common_ompio_buffer.h"
 #include "math.h"
 #include "ompi/mca/pml/pml.h"
 #include <unistd.h>
@@ -49,8 +50,8 @@ typedef struct mca_io_ompio_aggregator_data {
     int **blocklen_per_process;
     MPI_Aint **displs_per_process, total_bytes, bytes_per_cycle, total_bytes_written;
     MPI_Comm comm;
-    char *buf, *global_buf, *prev_global_buf;
-    ompi_datatype_t **recvtype, **prev_recvtype;
+    char *buf, *global_buf;
+    ompi_datatype_t **recvtype;
     struct iovec *global_iov_array;
     int current_index, current_position;
     int bytes_to_write_in_cycle, bytes_remaining, procs_per_group;    
@@ -60,6 +61,12 @@ typedef struct mca_io_ompio_aggregator_data {
     int bytes_to_write, prev_bytes_to_write;
     mca_common_ompio_io_array_t *io_array, *prev_io_array;
     int num_io_entries, prev_num_io_entries;
+    /* buffers, receive types and io arrays of the cycles in flight,
+       one slot per stage of the pipeline */
+    char **cycle_buf;
+    ompi_datatype_t ***cycle_recvtype;
+    mca_common_ompio_io_array_t **cycle_io_array;
+    int *cycle_num_io_entries, *cycle_bytes_sent, *cycle_bytes_to_write;
 } mca_io_ompio_aggregator_data;
 
 
@@ -68,21 +75,27 @@ typedef struct mca_io_ompio_aggregator_data {
     _r1=_r2;                     \
     _r2=_t;}
 
-#define SWAP_AGGR_POINTERS(_aggr,_num) {                        \
-    int _i;                                                     \
-    char *_t;                                                   \
-    for (_i=0; _i<_num; _i++ ) {                                \
-        _aggr[_i]->prev_io_array=_aggr[_i]->io_array;             \
-        _aggr[_i]->prev_num_io_entries=_aggr[_i]->num_io_entries; \
-        _aggr[_i]->prev_bytes_sent=_aggr[_i]->bytes_sent;         \
-        _aggr[_i]->prev_bytes_to_write=_aggr[_i]->bytes_to_write; \
-        _t=_aggr[_i]->prev_global_buf;                            \
-        _aggr[_i]->prev_global_buf=_aggr[_i]->global_buf;         \
-        _aggr[_i]->global_buf=_t;                                 \
-        _t=(char *)_aggr[_i]->recvtype;                           \
-        _aggr[_i]->recvtype=_aggr[_i]->prev_recvtype;             \
-        _aggr[_i]->prev_recvtype=(ompi_datatype_t **)_t;          }                                                             \
-}
+/* Shuffle the next cycle in the buffers of the slot */
+#define SHUFFLE_SLOT(_aggr,_slot) {                                 \
+    (_aggr)->global_buf=(_aggr)->cycle_buf[_slot];                  \
+    (_aggr)->recvtype=(_aggr)->cycle_recvtype[_slot]; }
+
+/* Keep the io array of the cycle just shuffled until it is written */
+#define SAVE_SLOT(_aggr,_slot) {                                    \
+    (_aggr)->cycle_io_array[_slot]=(_aggr)->io_array;                \
+    (_aggr)->cycle_num_io_entries[_slot]=(_aggr)->num_io_entries;    \
+    (_aggr)->cycle_bytes_sent[_slot]=(_aggr)->bytes_sent;            \
+    (_aggr)->cycle_bytes_to_write[_slot]=(_aggr)->bytes_to_write;    \
+    (_aggr)->io_array=NULL; }
+
+/* Write the cycle held by the slot, write_init frees the io array */
+#define WRITE_SLOT(_aggr,_slot) {                                   \
+    (_aggr)->prev_io_array=(_aggr)->cycle_io_array[_slot];           \
+    (_aggr)->prev_num_io_entries=(_aggr)->cycle_num_io_entries[_slot]; \
+    (_aggr)->prev_bytes_sent=(_aggr)->cycle_bytes_sent[_slot];       \
+    (_aggr)->prev_bytes_to_write=(_aggr)->cycle_bytes_to_write[_slot]; \
+    (_aggr)->cycle_io_array[_slot]=NULL;                             \
+    (_aggr)->cycle_num_io_entries[_slot]=0; }
 
 
 
@@ -131,7 +144,7 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
     uint32_t total_fview_count = 0;
     int local_count = 0;
     ompi_request_t **reqs = NULL;
-    ompi_request_t *req_iwrite = MPI_REQUEST_NULL;
+    ompi_request_t **write_reqs = NULL;
     mca_io_ompio_aggregator_data **aggr_data=NULL;
     
     int *displs = NULL;
@@ -148,6 +161,10 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
     int aggr_index = NOT_AGGR_INDEX;
     int write_synch_type = 2;
     int write_chunksize, *result_counts=NULL;
+    int pipeline_depth = 2, slot, pslot, nreqs;
+    int gpu_direct = 0;
+    double shuffle_wait_time = 0.0, write_post_time = 0.0, write_wait_time = 0.0, start_time = 0.0;
+    bool want_timings = opal_output_check_verbosity(10, ompi_fcoll_base_framework.framework_output);
     
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
     double write_time = 0.0, start_write_time = 0.0, end_write_time = 0.0;
@@ -173,9 +190,14 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
         goto exit;
     }
 
-    /* since we want to overlap 2 iterations, define the bytes_per_cycle to be half of what
-       the user requested */
-    bytes_per_cycle =bytes_per_cycle/2;
+    /* the cycles in flight share the buffer the user requested. Without asynchronous
+       writes there is nothing to overlap beyond the next shuffle, stay with 2 */
+    pipeline_depth = (2 < mca_fcoll_vulcan_pipeline_depth) ? mca_fcoll_vulcan_pipeline_depth : 2;
+    if ( (2 == mca_fcoll_vulcan_async_io) || (NULL == fh->f_fbtl->fbtl_ipwritev) ||
+         (0 == bytes_per_cycle / pipeline_depth) ) {
+        pipeline_depth = 2;
+    }
+    bytes_per_cycle =bytes_per_cycle/pipeline_depth;
     write_chunksize = bytes_per_cycle;
     
     ret =   mca_common_ompio_decode_datatype ((struct ompio_file_t *) fh,
@@ -193,6 +215,20 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
     if ( MPI_STATUS_IGNORE != status ) {
 	status->_ucount = max_data;
     }
+
+#if OMPIO_HAVE_CUFILE
+    {
+        /* The shuffle moves device data with the CUDA-aware pml in any case.
+           If the data of this process is in device memory, its aggregator
+           buffers are allocated there as well and written with GPUDirect
+           Storage, without going through host memory at all */
+        int is_gpu, is_managed;
+        mca_common_ompio_check_gpu_buf ( fh, buf, &is_gpu, &is_managed);
+        if ( is_gpu && !is_managed && OMPI_SUCCESS == mca_common_ompio_cufile_register (fh) ) {
+            gpu_direct = 1;
+        }
+    }
+#endif
     
     
     ret = mca_fcoll_vulcan_get_configuration (fh, vulcan_num_io_procs, mca_fcoll_vulcan_num_groups, max_data);
@@ -521,26 +557,47 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
             }
         
             
-            aggr_data[i]->global_buf       = (char *) malloc (bytes_per_cycle);
-            aggr_data[i]->prev_global_buf  = (char *) malloc (bytes_per_cycle);
-            if (NULL == aggr_data[i]->global_buf || NULL == aggr_data[i]->prev_global_buf){
-                opal_output(1, "OUT OF MEMORY");
-                ret = OMPI_ERR_OUT_OF_RESOURCE;
-                goto exit;
-            }
-        
-            aggr_data[i]->recvtype = (ompi_datatype_t **) malloc (fh->f_procs_per_group  * 
-                                                                  sizeof(ompi_datatype_t *));
-            aggr_data[i]->prev_recvtype = (ompi_datatype_t **) malloc (fh->f_procs_per_group  * 
-                                                                       sizeof(ompi_datatype_t *));
-            if (NULL == aggr_data[i]->recvtype || NULL == aggr_data[i]->prev_recvtype) {
+            aggr_data[i]->cycle_buf      = (char **) calloc (pipeline_depth, sizeof(char *));
+            aggr_data[i]->cycle_recvtype = (ompi_datatype_t ***) calloc (pipeline_depth,
+                                                                         sizeof(ompi_datatype_t **));
+            aggr_data[i]->cycle_io_array = (mca_common_ompio_io_array_t **) calloc (pipeline_depth,
+                                                                                    sizeof(mca_common_ompio_io_array_t *));
+            aggr_data[i]->cycle_num_io_entries = (int *) calloc (pipeline_depth, sizeof(int));
+            aggr_data[i]->cycle_bytes_sent     = (int *) calloc (pipeline_depth, sizeof(int));
+            aggr_data[i]->cycle_bytes_to_write = (int *) calloc (pipeline_depth, sizeof(int));
+            if (NULL == aggr_data[i]->cycle_buf || NULL == aggr_data[i]->cycle_recvtype ||
+                NULL == aggr_data[i]->cycle_io_array || NULL == aggr_data[i]->cycle_num_io_entries ||
+                NULL == aggr_data[i]->cycle_bytes_sent || NULL == aggr_data[i]->cycle_bytes_to_write) {
                 opal_output (1, "OUT OF MEMORY\n");
                 ret = OMPI_ERR_OUT_OF_RESOURCE;
                 goto exit;
             }
-            for(l=0;l<fh->f_procs_per_group;l++){
-                aggr_data[i]->recvtype[l]      = MPI_DATATYPE_NULL;
-                aggr_data[i]->prev_recvtype[l] = MPI_DATATYPE_NULL;
+
+            for (slot = 0; slot < pipeline_depth; slot++) {
+#if OMPIO_HAVE_CUFILE
+                if ( gpu_direct ) {
+                    aggr_data[i]->cycle_buf[slot] = (char *) mca_common_ompio_alloc_device_buf (fh, bytes_per_cycle);
+                }
+                else
+#endif
+                /* registered with the CUDA-aware pml, if any */
+                aggr_data[i]->cycle_buf[slot] = (char *) mca_common_ompio_alloc_buf (fh, bytes_per_cycle);
+                if (NULL == aggr_data[i]->cycle_buf[slot]) {
+                    opal_output(1, "OUT OF MEMORY");
+                    ret = OMPI_ERR_OUT_OF_RESOURCE;
+                    goto exit;
+                }
+
+                aggr_data[i]->cycle_recvtype[slot] = (ompi_datatype_t **) malloc (fh->f_procs_per_group  *
+                                                                                  sizeof(ompi_datatype_t *));
+                if (NULL == aggr_data[i]->cycle_recvtype[slot]) {
+                    opal_output (1, "OUT OF MEMORY\n");
+                    ret = OMPI_ERR_OUT_OF_RESOURCE;
+                    goto exit;
+                }
+                for(l=0;l<fh->f_procs_per_group;l++){
+                    aggr_data[i]->cycle_recvtype[slot][l] = MPI_DATATYPE_NULL;
+                }
             }
         }
     
@@ -549,19 +606,22 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
 #endif
     }    
 
-    reqs = (ompi_request_t **)malloc ((fh->f_procs_per_group + 1 )*fh->f_num_aggrs *sizeof(ompi_request_t *));
+    /* one set of shuffle requests and one write request per cycle in flight */
+    nreqs = (fh->f_procs_per_group + 1 )*fh->f_num_aggrs;
+    reqs = (ompi_request_t **)malloc (pipeline_depth * nreqs *sizeof(ompi_request_t *));
+    write_reqs = (ompi_request_t **)malloc (pipeline_depth *sizeof(ompi_request_t *));
 
-    if ( NULL == reqs ) {
+    if ( NULL == reqs || NULL == write_reqs ) {
         opal_output (1, "OUT OF MEMORY\n");
         ret = OMPI_ERR_OUT_OF_RESOURCE;
         goto exit;
     }
 
-    for (l=0,i=0; i < fh->f_num_aggrs; i++ ) {
-        for ( j=0; j< (fh->f_procs_per_group+1); j++ ) {
-            reqs[l] = MPI_REQUEST_NULL;
-            l++;
-        }
+    for (l=0; l < pipeline_depth * nreqs; l++ ) {
+        reqs[l] = MPI_REQUEST_NULL;
+    }
+    for (slot=0; slot < pipeline_depth; slot++ ) {
+        write_reqs[slot] = MPI_REQUEST_NULL;
     }
 
     // In fact it should be: if ((1 == mca_fcoll_vulcan_async_io) && (NULL != fh->f_fbtl->fbtl_ipwritev))
@@ -570,90 +630,118 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
         ( (0 == mca_fcoll_vulcan_async_io) && (NULL != fh->f_fbtl->fbtl_ipwritev) && (2 < cycles) ) ) {
         write_synch_type = 1;
     }
+    if ( gpu_direct ) {
+        write_synch_type = 3;
+    }
 
-    if ( cycles > 0 ) {
-        for ( i=0; i<fh->f_num_aggrs; i++ ) {
-            ret = shuffle_init ( 0, cycles, fh->f_aggr_list[i], fh->f_rank, aggr_data[i],
-                                 &reqs[i*(fh->f_procs_per_group + 1)] );
-            if ( OMPI_SUCCESS != ret ) {
-                goto exit;
-            }
-        }
+    if ( (cycles > 0) && (NOT_AGGR_INDEX != aggr_index) ) {
         // Register progress function that should be used by ompi_request_wait
-        if (NOT_AGGR_INDEX != aggr_index)  {
-            mca_common_ompio_register_progress ();
-        }
+        mca_common_ompio_register_progress ();
     }
 
-    ret = ompi_request_wait_all ( (fh->f_procs_per_group + 1 )*fh->f_num_aggrs,
-                                  reqs, MPI_STATUS_IGNORE);
-
-    for (index = 1; index < cycles; index++) {
-        SWAP_AGGR_POINTERS(aggr_data, fh->f_num_aggrs);
+    /* Cycle index is shuffled in the slot index % pipeline_depth while the
+       previous cycles of the other slots are still being written. The write
+       of a cycle is posted as soon as its shuffle completes, and a slot is
+       reused only once the write of the cycle it held completed. */
+    for (index = 0; index <= cycles; index++) {
+        slot  = index % pipeline_depth;
+        pslot = (index + pipeline_depth - 1) % pipeline_depth;
+
+        if (index < cycles) {
+            if (NOT_AGGR_INDEX != aggr_index) {
+                if (want_timings) {
+                    start_time = MPI_Wtime();
+                }
+                ret = ompi_request_wait(&write_reqs[slot], MPI_STATUS_IGNORE);
+                if (OMPI_SUCCESS != ret){
+                    goto exit;
+                }
+                if (want_timings) {
+                    write_wait_time += MPI_Wtime() - start_time;
+                }
+            }
 
-        if(NOT_AGGR_INDEX != aggr_index) {
-#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-            start_write_time = MPI_Wtime();
-#endif
-            ret = write_init (fh, fh->f_aggr_list[aggr_index], aggr_data[aggr_index],
-                              write_chunksize, write_synch_type, &req_iwrite);
-            if (OMPI_SUCCESS != ret){
-                goto exit;
+            for ( i=0; i<fh->f_num_aggrs; i++ ) {
+                if (fh->f_aggr_list[i] == fh->f_rank) {
+                    SHUFFLE_SLOT(aggr_data[i], slot);
+                }
+                ret = shuffle_init ( index, cycles, fh->f_aggr_list[i], fh->f_rank, aggr_data[i],
+                                     &reqs[slot*nreqs + i*(fh->f_procs_per_group + 1)] );
+                if ( OMPI_SUCCESS != ret ) {
+                    goto exit;
+                }
+                if (fh->f_aggr_list[i] == fh->f_rank) {
+                    SAVE_SLOT(aggr_data[i], slot);
+                }
             }
-#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-            end_write_time = MPI_Wtime();
-            write_time += end_write_time - start_write_time;
-#endif
         }
 
-        for ( i=0; i<fh->f_num_aggrs; i++ ) {
-            ret = shuffle_init ( index, cycles, fh->f_aggr_list[i], fh->f_rank, aggr_data[i],
-                                 &reqs[i*(fh->f_procs_per_group + 1)] );
-            if ( OMPI_SUCCESS != ret ) {
-                goto exit;
-            }
+        if (0 == index) {
+            continue;
         }
 
-        ret = ompi_request_wait_all ( (fh->f_procs_per_group + 1 )*fh->f_num_aggrs,
-                                      reqs, MPI_STATUS_IGNORE);
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+        start_comm_time = MPI_Wtime();
+#endif
+        if (want_timings) {
+            start_time = MPI_Wtime();
+        }
+        ret = ompi_request_wait_all ( nreqs, &reqs[pslot*nreqs], MPI_STATUS_IGNORE);
         if (OMPI_SUCCESS != ret){
             goto exit;
         }
-
-        if(NOT_AGGR_INDEX != aggr_index) {
-            ret = ompi_request_wait(&req_iwrite, MPI_STATUS_IGNORE);
-            if (OMPI_SUCCESS != ret){
-                goto exit;
-            }
+        if (want_timings) {
+            shuffle_wait_time += MPI_Wtime() - start_time;
         }
-    } /* end  for (index = 0; index < cycles; index++) */
-
-    if ( cycles > 0 ) {
-        SWAP_AGGR_POINTERS(aggr_data,fh->f_num_aggrs);
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+        end_comm_time = MPI_Wtime();
+        comm_time += (end_comm_time - start_comm_time);
+#endif
 
         if(NOT_AGGR_INDEX != aggr_index) {
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
             start_write_time = MPI_Wtime();
 #endif
+            if (want_timings) {
+                start_time = MPI_Wtime();
+            }
+            WRITE_SLOT(aggr_data[aggr_index], pslot);
             ret = write_init (fh, fh->f_aggr_list[aggr_index], aggr_data[aggr_index],
-                              write_chunksize, write_synch_type, &req_iwrite);
+                              write_chunksize, write_synch_type, &write_reqs[pslot]);
             if (OMPI_SUCCESS != ret){
                 goto exit;
             }
+            if (want_timings) {
+                write_post_time += MPI_Wtime() - start_time;
+            }
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
             end_write_time = MPI_Wtime();
             write_time += end_write_time - start_write_time;
 #endif
         }
+    } /* end  for (index = 0; index <= cycles; index++) */
 
-        if(NOT_AGGR_INDEX != aggr_index) {
-            ret = ompi_request_wait(&req_iwrite, MPI_STATUS_IGNORE);
-            if (OMPI_SUCCESS != ret){
-                goto exit;
-            }
+    if (NOT_AGGR_INDEX != aggr_index) {
+        if (want_timings) {
+            start_time = MPI_Wtime();
+        }
+        ret = ompi_request_wait_all (pipeline_depth, write_reqs, MPI_STATUS_IGNORE);
+        if (OMPI_SUCCESS != ret){
+            goto exit;
+        }
+        if (want_timings) {
+            write_wait_time += MPI_Wtime() - start_time;
         }
     }
-        
+
+    if (want_timings) {
+        opal_output_verbose(10, ompi_fcoll_base_framework.framework_output,
+                            "fcoll:vulcan:write_all: rank %d cycles %d depth %d (%d bytes per cycle) "
+                            "shuffle wait %f write post %f write wait %f\n",
+                            fh->f_rank, cycles, pipeline_depth, bytes_per_cycle,
+                            shuffle_wait_time, write_post_time, write_wait_time);
+    }
+
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
     end_exch = MPI_Wtime();
     exch_write += end_exch - start_exch;
@@ -679,24 +767,39 @@ exit :
         
         for ( i=0; i< fh->f_num_aggrs; i++ ) {            
             if (fh->f_aggr_list[i] == fh->f_rank) {
-                if (NULL != aggr_data[i]->recvtype){
-                    for (j =0; j< aggr_data[i]->procs_per_group; j++) {
-                        if ( MPI_DATATYPE_NULL != aggr_data[i]->recvtype[j] ) {
-                            ompi_datatype_destroy(&aggr_data[i]->recvtype[j]);
+                for (slot = 0; slot < pipeline_depth; slot++) {
+                    if (NULL != aggr_data[i]->cycle_recvtype && NULL != aggr_data[i]->cycle_recvtype[slot]) {
+                        for (j =0; j< aggr_data[i]->procs_per_group; j++) {
+                            if ( MPI_DATATYPE_NULL != aggr_data[i]->cycle_recvtype[slot][j] ) {
+                                ompi_datatype_destroy(&aggr_data[i]->cycle_recvtype[slot][j]);
+                            }
                         }
-                        if ( MPI_DATATYPE_NULL != aggr_data[i]->prev_recvtype[j] ) {
-                            ompi_datatype_destroy(&aggr_data[i]->prev_recvtype[j]);
+                        free(aggr_data[i]->cycle_recvtype[slot]);
+                    }
+                    if (NULL != aggr_data[i]->cycle_buf && NULL != aggr_data[i]->cycle_buf[slot]) {
+#if OMPIO_HAVE_CUFILE
+                        if ( gpu_direct ) {
+                            mca_common_ompio_release_device_buf (fh, aggr_data[i]->cycle_buf[slot]);
                         }
-			
+                        else
+#endif
+                        mca_common_ompio_release_buf (fh, aggr_data[i]->cycle_buf[slot]);
+                    }
+                    if (NULL != aggr_data[i]->cycle_io_array) {
+                        /* cycles shuffled but not written on the error path */
+                        free (aggr_data[i]->cycle_io_array[slot]);
                     }
-                    free(aggr_data[i]->recvtype);
-                    free(aggr_data[i]->prev_recvtype);
                 }
-                
+                free (aggr_data[i]->cycle_recvtype);
+                free (aggr_data[i]->cycle_buf);
+                free (aggr_data[i]->cycle_io_array);
+                free (aggr_data[i]->cycle_num_io_entries);
+                free (aggr_data[i]->cycle_bytes_sent);
+                free (aggr_data[i]->cycle_bytes_to_write);
+                free (aggr_data[i]->io_array);
+
                 free (aggr_data[i]->disp_index);
                 free (aggr_data[i]->max_disp_index);
-                free (aggr_data[i]->global_buf);
-                free (aggr_data[i]->prev_global_buf);
                 for(l=0;l<aggr_data[i]->procs_per_group;l++){
                     free (aggr_data[i]->blocklen_per_process[l]);
                     free (aggr_data[i]->displs_per_process[l]);
@@ -731,6 +834,7 @@ exit :
     fh->f_procs_per_group=0;
     free(result_counts);
     free(reqs);
+    free(write_reqs);
      
     return OMPI_SUCCESS;
 }
@@ -769,9 +873,18 @@ static int write_init (ompio_file_t *fh,
             }
         }
         else {
-            fh->f_flags |= OMPIO_COLLECTIVE_OP;
-            ret_temp = fh->f_fbtl->fbtl_pwritev(fh);
-            fh->f_flags &= ~OMPIO_COLLECTIVE_OP;
+#if OMPIO_HAVE_CUFILE
+            if (3 == write_synchType) {
+                /* the buffer of the cycle is in device memory */
+                ret_temp = mca_common_ompio_cufile_io (fh, fh->f_io_array, fh->f_num_of_io_entries, 0);
+            }
+            else
+#endif
+            {
+                fh->f_flags |= OMPIO_COLLECTIVE_OP;
+                ret_temp = fh->f_fbtl->fbtl_pwritev(fh);
+                fh->f_flags &= ~OMPIO_COLLECTIVE_OP;
+            }
             if(0 > ret_temp) {
                 opal_output (1, "vulcan_write_all: fbtl_pwritev failed\n");
                 ret = ret_temp;
@@ -1383,6 +1496,14 @@ static int mca_fcoll_vulcan_minmax ( ompio_file_t *fh, struct iovec *iov, int io
       stripe_size++;
     }
 
+    /* With the topology aware grouping the number of aggregators is matched to the
+       stripe count: hand out the file stripes round-robin, so that each aggregator
+       keeps writing the same storage targets and no two aggregators share a stripe. */
+    if ( TOPOLOGY_AWARE == fh->f_get_mca_parameter_value ("grouping_option", strlen("grouping_option")) &&
+         0 < fh->f_stripe_size ) {
+        stripe_size = (long) fh->f_stripe_size;
+    }
+
     *new_stripe_size  = stripe_size;
     //    if ( fh->f_rank == 0 ) 
     //    printf(" partition size is %ld\n", stripe_size);
@@ -45,6 +45,7 @@ int mca_fs_lustre_priority = 20;
    runtime also*/
 int mca_fs_lustre_stripe_size = 0;
 int mca_fs_lustre_stripe_width = 0;
+int mca_fs_lustre_auto_layout = 0;
 /*
  * Instantiate the public struct with all of our public information
  * and pointers to our public functions in it
@@ -93,6 +94,16 @@ lustre_register(void)
                                            MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY, &mca_fs_lustre_stripe_width);
+    mca_fs_lustre_auto_layout = 0;
+    (void) mca_base_component_var_register(&mca_fs_lustre_component.fsm_version,
+                                           "auto_layout", "Choose the layout of the files created without "
+                                           "stripe_size or stripe_width from the number of processes, of "
+                                           "aggregators and of OSTs and from the expected_file_size hint, "
+                                           "using a composite (PFL) layout when the size is unknown. "
+                                           "Also enabled per file by the lustre_auto_layout info key (default: 0)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_fs_lustre_auto_layout);
 
     return OMPI_SUCCESS;
 }
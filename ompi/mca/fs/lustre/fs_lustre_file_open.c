@@ -26,6 +26,8 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <limits.h>
+#include <string.h>
 #include "mpi.h"
 #include "ompi/constants.h"
 #include "ompi/mca/fs/fs.h"
@@ -34,8 +36,25 @@
 #include "ompi/info/info.h"
 
 #include <sys/ioctl.h>
+#include <libgen.h>
+
+/* Bounds of the automatic layouts */
+#define FS_LUSTRE_AUTO_STRIPE_SIZE     (1024*1024)
+#define FS_LUSTRE_AUTO_BIG_STRIPE_SIZE (4*1024*1024)
+#define FS_LUSTRE_AUTO_BYTES_PER_OST   (64LL*1024*1024)
+#define FS_LUSTRE_AUTO_BIG_STRIPE      (4LL*1024*1024*1024)
+/* extents of the components of the composite layout */
+#define FS_LUSTRE_PFL_FIRST_END        (64LL*1024*1024)
+#define FS_LUSTRE_PFL_SECOND_END       (1024LL*1024*1024)
+#define FS_LUSTRE_PFL_SECOND_COUNT     4
 
 static void *alloc_lum(void);
+static int auto_layout (struct ompi_communicator_t *comm, const char *filename,
+                        struct opal_info_t *info, ompio_file_t *fh,
+                        int *stripe_size, int *stripe_count);
+#ifdef HAVE_LLAPI_LAYOUT_COMP_ADD
+static int create_pfl (const char *filename, int amode, int perm, int stripe_count);
+#endif
 
 static void *alloc_lum(void)
 {
@@ -69,6 +88,7 @@ mca_fs_lustre_file_open (struct ompi_communicator_t *comm,
     int flag;
     int fs_lustre_stripe_size = -1;
     int fs_lustre_stripe_width = -1;
+    int use_auto_layout = mca_fs_lustre_auto_layout;
     opal_cstring_t *stripe_str;
 
     struct lov_user_md *lump=NULL;
@@ -96,10 +116,27 @@ mca_fs_lustre_file_open (struct ompi_communicator_t *comm,
         fs_lustre_stripe_width = mca_fs_lustre_stripe_width;
     }
 
+    opal_info_get (info, "lustre_auto_layout", &stripe_str, &flag);
+    if ( flag ) {
+        use_auto_layout = !strncmp (stripe_str->string, "true", sizeof("true"));
+        OBJ_RELEASE(stripe_str);
+    }
     
     /* Reset errno */
     errno = 0;
     if (OMPIO_ROOT == fh->f_rank) {
+        int pfl = 0;
+
+        if ( use_auto_layout && fs_lustre_stripe_size <= 0 && fs_lustre_stripe_width <= 0 &&
+             ( amode&O_CREAT) && ( (amode&O_RDWR)|| amode&O_WRONLY) ) {
+            pfl = auto_layout (comm, filename, info, fh, &fs_lustre_stripe_size, &fs_lustre_stripe_width);
+        }
+#ifdef HAVE_LLAPI_LAYOUT_COMP_ADD
+        if ( pfl ) {
+            fh->fd = create_pfl (filename, amode, perm, fs_lustre_stripe_width);
+        }
+        else
+#endif
         if ( (fs_lustre_stripe_size>0 || fs_lustre_stripe_width>0) &&
              ( amode&O_CREAT)                                      && 
              ( (amode&O_RDWR)|| amode&O_WRONLY) ) {
@@ -133,6 +170,30 @@ mca_fs_lustre_file_open (struct ompi_communicator_t *comm,
         }
     }
 
+#ifdef HAVE_LLAPI_LAYOUT_COMP_ADD
+    {
+        /* The last component of a composite layout covers the bulk of the
+           file, the aggregators and the file domains are aligned with it */
+        struct llapi_layout *layout = llapi_layout_get_by_fd (fh->fd, 0);
+        uint64_t count = 0, size = 0;
+
+        if ( NULL != layout ) {
+            if ( 0 == llapi_layout_comp_use (layout, LLAPI_LAYOUT_COMP_USE_LAST) &&
+                 0 == llapi_layout_stripe_count_get (layout, &count) &&
+                 0 == llapi_layout_stripe_size_get (layout, &size) &&
+                 0 < count && count <= LOV_MAX_STRIPE_COUNT && 0 < size && size <= INT_MAX ) {
+                fh->f_stripe_size   = (int) size;
+                fh->f_stripe_count  = (int) count;
+                fh->f_fs_block_size = (int) size;
+                fh->f_flags |= OMPIO_LOCK_NEVER;
+                llapi_layout_free (layout);
+                return OMPI_SUCCESS;
+            }
+            llapi_layout_free (layout);
+        }
+    }
+#endif
+
     lump = alloc_lum();
     if (NULL == lump) {
         fprintf(stderr,"Cannot allocate memory for extracting stripe size\n");
@@ -152,3 +213,129 @@ mca_fs_lustre_file_open (struct ompi_communicator_t *comm,
 
     return OMPI_SUCCESS;
 }
+
+/* Choose the striping of a new file. The stripe count follows the number
+** of aggregators writing the file, bounded by the number of OSTs and, if
+** the expected_file_size hint is given, by the size of the file. Returns
+** 1 if a composite layout should be used instead, the size being unknown.
+*/
+static int auto_layout (struct ompi_communicator_t *comm, const char *filename,
+                        struct opal_info_t *info, ompio_file_t *fh,
+                        int *stripe_size, int *stripe_count)
+{
+    long long expected_size = 0;
+    int num_aggregators = -1, num_osts = LOV_MAX_STRIPE_COUNT;
+    opal_cstring_t *info_str;
+    int flag;
+
+    opal_info_get (info, "cb_nodes", &info_str, &flag);
+    if ( flag ) {
+        sscanf ( info_str->string, "%d", &num_aggregators );
+        OBJ_RELEASE(info_str);
+    }
+    if ( 0 >= num_aggregators ) {
+        num_aggregators = OMPIO_MCA_GET(fh, num_aggregators);
+    }
+    if ( 0 >= num_aggregators ) {
+        num_aggregators = ompi_comm_size (comm);
+    }
+
+    opal_info_get (info, "expected_file_size", &info_str, &flag);
+    if ( flag ) {
+        sscanf ( info_str->string, "%lld", &expected_size );
+        OBJ_RELEASE(info_str);
+    }
+
+#ifdef HAVE_LLAPI_GET_OBD_COUNT
+    {
+        char *dir = strdup (filename);
+        int count = 0;
+
+        if ( NULL != dir ) {
+            if ( 0 == llapi_get_obd_count (dirname (dir), &count, 0) && 0 < count ) {
+                num_osts = count;
+            }
+            free (dir);
+        }
+    }
+#endif
+
+    *stripe_count = num_aggregators;
+    if ( *stripe_count > num_osts ) {
+        *stripe_count = num_osts;
+    }
+    if ( *stripe_count > LOV_MAX_STRIPE_COUNT ) {
+        *stripe_count = LOV_MAX_STRIPE_COUNT;
+    }
+    *stripe_size = FS_LUSTRE_AUTO_STRIPE_SIZE;
+
+    if ( 0 < expected_size ) {
+        if ( expected_size / FS_LUSTRE_AUTO_BYTES_PER_OST < *stripe_count ) {
+            *stripe_count = (int) (expected_size / FS_LUSTRE_AUTO_BYTES_PER_OST);
+            if ( 0 == *stripe_count ) {
+                *stripe_count = 1;
+            }
+        }
+        if ( expected_size / *stripe_count >= FS_LUSTRE_AUTO_BIG_STRIPE ) {
+            *stripe_size = FS_LUSTRE_AUTO_BIG_STRIPE_SIZE;
+        }
+        return 0;
+    }
+
+#ifdef HAVE_LLAPI_LAYOUT_COMP_ADD
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+#ifdef HAVE_LLAPI_LAYOUT_COMP_ADD
+/* Progressive file layout: a single stripe for the first extent of the file,
+** a few for the next one and stripe_count for the rest, so a file of
+** unknown size does not pay for wide striping if it remains small.
+*/
+static int create_pfl (const char *filename, int amode, int perm, int stripe_count)
+{
+    struct llapi_layout *layout = llapi_layout_alloc ();
+    int second_count = (stripe_count < FS_LUSTRE_PFL_SECOND_COUNT) ? stripe_count : FS_LUSTRE_PFL_SECOND_COUNT;
+    int fd;
+
+    if ( NULL == layout ) {
+        return open (filename, amode, perm);
+    }
+    if ( 0 != llapi_layout_stripe_count_set (layout, 1) ||
+         0 != llapi_layout_stripe_size_set (layout, FS_LUSTRE_AUTO_STRIPE_SIZE) ||
+         0 != llapi_layout_comp_extent_set (layout, 0, FS_LUSTRE_PFL_FIRST_END) ||
+         0 != llapi_layout_comp_add (layout) ||
+         0 != llapi_layout_comp_extent_set (layout, FS_LUSTRE_PFL_FIRST_END, FS_LUSTRE_PFL_SECOND_END) ||
+         0 != llapi_layout_stripe_count_set (layout, second_count) ||
+         0 != llapi_layout_stripe_size_set (layout, FS_LUSTRE_AUTO_STRIPE_SIZE) ||
+         0 != llapi_layout_comp_add (layout) ||
+         0 != llapi_layout_comp_extent_set (layout, FS_LUSTRE_PFL_SECOND_END, LUSTRE_EOF) ||
+         0 != llapi_layout_stripe_count_set (layout, stripe_count) ||
+         0 != llapi_layout_stripe_size_set (layout, FS_LUSTRE_AUTO_BIG_STRIPE_SIZE) ) {
+        opal_output(1, "mca_fs_lustre_file_open: could not build a composite layout for %s, "
+                    "using the default one\n", filename);
+        llapi_layout_free (layout);
+        return open (filename, amode, perm);
+    }
+
+    fd = llapi_layout_file_create (filename, amode, perm, layout);
+    llapi_layout_free (layout);
+    if ( 0 > fd && EEXIST != errno ) {
+        /* e.g. a server without PFL support */
+        fd = open (filename, amode, perm);
+    }
+    else if ( 0 > fd ) {
+        fd = open (filename, amode & ~O_EXCL, perm);
+        if ( amode & O_EXCL ) {
+            if ( 0 <= fd ) {
+                close (fd);
+            }
+            errno = EEXIST;
+            fd = -1;
+        }
+    }
+    return fd;
+}
+#endif
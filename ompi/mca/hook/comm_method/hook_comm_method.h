@@ -27,6 +27,7 @@ extern bool mca_hook_comm_method_enable_mpi_finalize;
 extern int mca_hook_comm_method_max;
 extern int mca_hook_comm_method_brief;
 extern char *mca_hook_comm_method_fakefile;
+extern int mca_hook_comm_method_sample;
 
 void ompi_hook_comm_method_mpi_init_bottom(int argc, char **argv, int requested, int *provided);
 
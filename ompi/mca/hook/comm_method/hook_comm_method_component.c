@@ -81,6 +81,7 @@ uint32_t mca_hook_comm_method_enabled_flags = 0x00;
 int mca_hook_comm_method_max = 12;
 int mca_hook_comm_method_brief = 0;
 char *mca_hook_comm_method_fakefile = NULL;
+int mca_hook_comm_method_sample = 0;
 
 static mca_base_var_enum_value_flag_t mca_hook_comm_method_modes[] = {
     {.flag = OMPI_HOOK_COMM_METHOD_INIT, .string = "mpi_init"},
@@ -180,6 +181,15 @@ static int ompi_hook_comm_method_component_register(void)
                                  MCA_BASE_VAR_SCOPE_READONLY,
                                  &mca_hook_comm_method_brief);
 
+    // hook_comm_method_sample
+    (void) mca_base_component_var_register(&mca_hook_comm_method_component.hookm_version, "sample",
+                                 "Only look at the connections of each host to this many other hosts and print a summary of the methods used, instead of the full table of all pairs of hosts (0 = all hosts).",
+                                 MCA_BASE_VAR_TYPE_INT, NULL,
+                                 0, 0,
+                                 OPAL_INFO_LVL_3,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &mca_hook_comm_method_sample);
+
     // hook_comm_method_fakefile is just for debugging, allows complete override of all the
     // comm method in the table
     (void) mca_base_component_var_register(&mca_hook_comm_method_component.hookm_version, "fakefile",
@@ -216,6 +216,8 @@ static char* comm_method_to_string(int method);
 static int icompar(const void *a, const void *b);
 static void abbreviate_list_into_string(char *str, int max, int *list, int nlist);
 static void ompi_report_comm_methods(int called_from_location);
+static void ompi_report_sampled_comm_methods(ompi_communicator_t *local_comm,
+    ompi_communicator_t *leader_comm, int called_from_location);
 
 void ompi_hook_comm_method_mpi_init_bottom(int argc, char **argv, int requested, int *provided)
 {
@@ -312,6 +314,156 @@ abbreviate_list_into_string(char *str, int max, int *list, int nlist)
     }
 }
 
+// Scalable version of the report (hook_comm_method_sample > 0), called
+// by the host leaders only.  Each host only looks at its connections to
+// a few other hosts (spread with a fixed stride so the whole job is
+// covered), the per-method counts are summed over all the hosts with a
+// reduction instead of gathering the full table, and rank 0 prints the
+// share of each method plus the hosts that mostly use something else.
+static void
+ompi_report_sampled_comm_methods(ompi_communicator_t *local_comm,
+    ompi_communicator_t *leader_comm, int called_from_location)
+{
+    int myleaderrank = ompi_comm_rank(leader_comm);
+    int nleaderranks = ompi_comm_size(leader_comm);
+    int nlocalranks = ompi_comm_size(local_comm);
+    int nsample, stride, i, j;
+    int counts[2 * MAX_COMM_METHODS], totals[2 * MAX_COMM_METHODS];
+    int *offhost = &counts[MAX_COMM_METHODS];
+    int mine, majority, total_on, total_off;
+    int *odd = NULL;
+    int comm_mode = MODE_IS_BTL;
+
+    nsample = mca_hook_comm_method_sample;
+    if (nsample > nleaderranks - 1) { nsample = nleaderranks - 1; }
+    stride = (nsample > 0) ? (nleaderranks - 1) / nsample : 1;
+
+// Only connect to the sampled hosts (and from the hosts sampling us)
+    if (called_from_location == 1) {
+        for (j=0; j<nsample; ++j) {
+            MPI_Request sreq, rreq;
+            MPI_Status status;
+            int sbuf = 0, rbuf = 0;
+            int speer = (myleaderrank + 1 + j * stride) % nleaderranks;
+            int rpeer = (myleaderrank - 1 - j * stride % nleaderranks + 2 * nleaderranks)
+                        % nleaderranks;
+
+            MCA_PML_CALL(isend(&sbuf, 1, MPI_INT, speer, 99,
+                    MCA_PML_BASE_SEND_STANDARD,
+                    leader_comm, &sreq));
+            MCA_PML_CALL(irecv(&rbuf, 1, MPI_INT, rpeer, 99,
+                    leader_comm, &rreq));
+            ompi_request_wait(&sreq, &status);
+            ompi_request_wait(&rreq, &status);
+        }
+    }
+
+// Same string to id mapping as the full report, from the sampled peers
+    init_string_to_conversion_struct(&comm_method_string_conversion);
+    for (j=0; j<nsample; ++j) {
+        char *p = comm_method_string(leader_comm,
+            (myleaderrank + 1 + j * stride) % nleaderranks, &comm_mode);
+        add_string_to_conversion_struct(&comm_method_string_conversion, p);
+        free(p);
+    }
+    {
+        char *p = comm_method_string((nlocalranks > 1) ? local_comm : leader_comm,
+            (nlocalranks > 1) ? 1 : myleaderrank, &comm_mode);
+        add_string_to_conversion_struct(&comm_method_string_conversion, p);
+        free(p);
+    }
+
+    MPI_Datatype mydt;
+    MPI_Op myop;
+    MPI_Type_contiguous(sizeof(comm_method_string_conversion_t), MPI_BYTE, &mydt);
+    MPI_Type_commit(&mydt);
+    MPI_Op_create(myfn, 1, &myop);
+    leader_comm->c_coll->coll_allreduce(
+        MPI_IN_PLACE, (void*)&comm_method_string_conversion, 1, mydt, myop, leader_comm,
+            leader_comm->c_coll->coll_allreduce_module);
+    MPI_Op_free(&myop);
+    MPI_Type_free(&mydt);
+
+// counts[0..MAX) is the on-host method of this host, counts[MAX..2*MAX)
+// the methods to the sampled hosts
+    memset(counts, 0, sizeof(counts));
+    if (nlocalranks > 1) {
+        ++counts[comm_method(local_comm, 1)];
+    } else {
+        ++counts[COMM_METHOD_SELF];
+    }
+    for (j=0; j<nsample; ++j) {
+        ++offhost[comm_method(leader_comm, (myleaderrank + 1 + j * stride) % nleaderranks)];
+    }
+    leader_comm->c_coll->coll_allreduce(
+        counts, totals, 2 * MAX_COMM_METHODS, MPI_INT, MPI_SUM, leader_comm,
+            leader_comm->c_coll->coll_allreduce_module);
+
+// the hosts whose sampled connections mostly are not the majority method
+    majority = 0;
+    mine = 0;
+    total_off = 0;
+    for (i=0; i<NUM_COMM_METHODS; ++i) {
+        total_off += totals[MAX_COMM_METHODS + i];
+        if (totals[MAX_COMM_METHODS + i] > totals[MAX_COMM_METHODS + majority]) {
+            majority = i;
+        }
+        if (offhost[i] > offhost[mine]) { mine = i; }
+    }
+    mine = (nsample > 0 && mine != majority) ? 1 : 0;
+    if (myleaderrank == 0) {
+        odd = malloc(nleaderranks * sizeof(int));
+    }
+    leader_comm->c_coll->coll_gather(
+        &mine, 1, MPI_INT,
+        odd, 1, MPI_INT,
+        0, leader_comm, leader_comm->c_coll->coll_gather_module);
+
+    if (myleaderrank == 0) {
+        char *btl_etc = "btl";
+        char *str;
+        int nodd = 0;
+
+        if (comm_mode == MODE_IS_MTL) { btl_etc = "mtl"; }
+        if (comm_mode == MODE_IS_PML) { btl_etc = "pml"; }
+        printf("Connection summary: (%s) %d hosts, %d sampled peer hosts per host\n",
+            btl_etc, nleaderranks, nsample);
+
+        total_on = 0;
+        for (i=0; i<NUM_COMM_METHODS; ++i) { total_on += totals[i]; }
+        printf("  on-host: ");
+        for (i=0; i<NUM_COMM_METHODS; ++i) {
+            if (totals[i] > 0) {
+                printf(" %s %.1f%%", comm_method_to_string(i), 100.0 * totals[i] / total_on);
+            }
+        }
+        printf("\n");
+        if (total_off > 0) {
+            printf("  off-host:");
+            for (i=0; i<NUM_COMM_METHODS; ++i) {
+                if (totals[MAX_COMM_METHODS + i] > 0) {
+                    printf(" %s %.1f%%", comm_method_to_string(i),
+                        100.0 * totals[MAX_COMM_METHODS + i] / total_off);
+                }
+            }
+            printf("\n");
+        }
+
+        for (i=0; i<nleaderranks; ++i) {
+            if (odd[i]) { odd[nodd++] = i; }
+        }
+        if (nodd > 0) {
+            str = malloc(1024);
+            abbreviate_list_into_string(str, 1024, odd, nodd);
+            printf("Exceptions: off-host connections mostly not %s on host(s) %s\n",
+                comm_method_to_string(majority), str);
+            free(str);
+        }
+        printf("\n");
+        free(odd);
+    }
+}
+
 // Input argument tells where we're being called from:
 // 1 for init, 2 for finalize.
 // The other implicit input is an environment variable we look at.
@@ -375,6 +527,13 @@ ompi_report_comm_methods(int called_from_location) // 1 = from init, 2 = from fi
     myleaderrank = ompi_comm_rank(leader_comm);
     nleaderranks = numhosts = ompi_comm_size(leader_comm);
 
+    if (mca_hook_comm_method_sample > 0) {
+        ompi_report_sampled_comm_methods(local_comm, leader_comm, called_from_location);
+        ompi_comm_free(&local_comm);
+        ompi_comm_free(&leader_comm);
+        return;
+    }
+
 /*
  *  Allocate space for each rank to store its communication method
  *  on a per-host basis.  But rank 0 gets enough space to store the
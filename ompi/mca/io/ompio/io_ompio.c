@@ -542,9 +542,30 @@ int mca_io_ompio_get_mca_parameter_value ( char *mca_parameter_name, int name_le
     else if ( !strncmp ( mca_parameter_name, "aggregators_cutoff_threshold", name_length )) {
         return mca_io_ompio_aggregators_cutoff_threshold;
     }
+    else if ( !strncmp ( mca_parameter_name, "aggregators_per_node", name_length )) {
+        return mca_io_ompio_aggregators_per_node;
+    }
     else if ( !strncmp ( mca_parameter_name, "grouping_option", name_length )) {
         return mca_io_ompio_grouping_option;
     }
+    else if ( !strncmp ( mca_parameter_name, "write_behind_size", name_length )) {
+        return mca_io_ompio_write_behind_size;
+    }
+    else if ( !strncmp ( mca_parameter_name, "write_behind_timeout", name_length )) {
+        return mca_io_ompio_write_behind_timeout;
+    }
+    else if ( !strncmp ( mca_parameter_name, "read_ahead_size", name_length )) {
+        return mca_io_ompio_read_ahead_size;
+    }
+    else if ( !strncmp ( mca_parameter_name, "read_cache_size", name_length )) {
+        return mca_io_ompio_read_cache_size;
+    }
+    else if ( !strncmp ( mca_parameter_name, "gpu_direct_storage", name_length )) {
+        return mca_io_ompio_gpu_direct_storage;
+    }
+    else if ( !strncmp ( mca_parameter_name, "trace", name_length )) {
+        return mca_io_ompio_trace;
+    }
     else if ( !strncmp ( mca_parameter_name, "coll_timing_info", name_length )) {
         return mca_io_ompio_coll_timing_info;
     }
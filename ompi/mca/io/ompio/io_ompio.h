@@ -51,6 +51,13 @@ extern int mca_io_ompio_record_offset_info;
 extern int mca_io_ompio_grouping_option;
 extern int mca_io_ompio_max_aggregators_ratio;
 extern int mca_io_ompio_aggregators_cutoff_threshold;
+extern int mca_io_ompio_aggregators_per_node;
+extern int mca_io_ompio_write_behind_size;
+extern int mca_io_ompio_write_behind_timeout;
+extern int mca_io_ompio_read_ahead_size;
+extern int mca_io_ompio_read_cache_size;
+extern int mca_io_ompio_gpu_direct_storage;
+extern int mca_io_ompio_trace;
 extern int mca_io_ompio_overwrite_amode;
 extern int mca_io_ompio_verbose_info_parsing;
 
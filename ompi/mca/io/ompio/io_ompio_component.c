@@ -26,10 +26,14 @@
 
 #include "ompi_config.h"
 
+#include <stddef.h>
+#include <string.h>
+
 #include "mpi.h"
 #include "opal/class/opal_list.h"
 #include "opal/mca/threads/mutex.h"
 #include "opal/mca/base/base.h"
+#include "opal/mca/base/mca_base_pvar.h"
 #include "ompi/mca/io/io.h"
 #include "ompi/mca/fs/base/base.h"
 #include "io_ompio.h"
@@ -48,6 +52,13 @@ int mca_io_ompio_record_offset_info = 0;
 int mca_io_ompio_coll_timing_info = 0;
 int mca_io_ompio_max_aggregators_ratio=8;
 int mca_io_ompio_aggregators_cutoff_threshold=3;
+int mca_io_ompio_aggregators_per_node=1;
+int mca_io_ompio_write_behind_size=0;
+int mca_io_ompio_write_behind_timeout=1000;
+int mca_io_ompio_read_ahead_size=0;
+int mca_io_ompio_read_cache_size=256*1024*1024;
+int mca_io_ompio_gpu_direct_storage=1;
+int mca_io_ompio_trace=0;
 int mca_io_ompio_overwrite_amode = 1;
 int mca_io_ompio_verbose_info_parsing = 0;
 
@@ -82,6 +93,8 @@ static int register_datarep(const char *,
                             void*);
 /*
 static int io_progress(void);
+static int io_pvar_read(const struct mca_base_pvar_t *pvar, void *value, void *obj);
+static void register_pvars(void);
 
 */
 
@@ -138,6 +151,83 @@ mca_io_base_component_2_0_0_t mca_io_ompio_component = {
     .io_register_datarep = register_datarep,
 };
 
+static int io_pvar_read(const struct mca_base_pvar_t *pvar, void *value, void *obj)
+{
+    ompi_file_t *fp = (ompi_file_t *) obj;
+    mca_common_ompio_data_t *data;
+    int offset = (int) (intptr_t) pvar->ctx;
+
+    if ( MCA_IO_BASE_V_2_0_0 != fp->f_io_version ||
+         0 != strcmp (fp->f_io_selected_component.v2_0_0.io_version.mca_component_name,
+                      mca_io_ompio_component.io_version.mca_component_name) ) {
+        /* file opened by another io component */
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+    data = (mca_common_ompio_data_t *) fp->f_io_selected_data;
+    if ( MCA_BASE_VAR_TYPE_DOUBLE == pvar->type ) {
+        memcpy (value, (char *) &data->ompio_fh.f_trace + offset, sizeof (double));
+    }
+    else {
+        memcpy (value, (char *) &data->ompio_fh.f_trace + offset, sizeof (unsigned long long));
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static void register_pvars(void)
+{
+    static const struct {
+        const char *name;
+        const char *desc;
+        size_t offset;
+    } counters[] = {
+        {"trace_views", "Number of file views set", offsetof (mca_common_ompio_trace_t, views)},
+        {"trace_indep_reads", "Number of independent read operations", offsetof (mca_common_ompio_trace_t, indep_reads)},
+        {"trace_indep_writes", "Number of independent write operations", offsetof (mca_common_ompio_trace_t, indep_writes)},
+        {"trace_coll_reads", "Number of collective read operations", offsetof (mca_common_ompio_trace_t, coll_reads)},
+        {"trace_coll_writes", "Number of collective write operations", offsetof (mca_common_ompio_trace_t, coll_writes)},
+        {"trace_bytes_read", "Bytes read by the MPI-IO operations", offsetof (mca_common_ompio_trace_t, bytes_read)},
+        {"trace_bytes_written", "Bytes written by the MPI-IO operations", offsetof (mca_common_ompio_trace_t, bytes_written)},
+        {"trace_fbtl_reads", "Number of read calls into the file system", offsetof (mca_common_ompio_trace_t, fbtl_reads)},
+        {"trace_fbtl_writes", "Number of write calls into the file system", offsetof (mca_common_ompio_trace_t, fbtl_writes)},
+        {"trace_fbtl_bytes_read", "Bytes read from the file system", offsetof (mca_common_ompio_trace_t, fbtl_bytes_read)},
+        {"trace_fbtl_bytes_written", "Bytes written to the file system", offsetof (mca_common_ompio_trace_t, fbtl_bytes_written)},
+        {"trace_aggr_bytes", "Bytes this process accessed in the file system as an aggregator "
+         "of the collective operations", offsetof (mca_common_ompio_trace_t, aggr_bytes)},
+    };
+    static const struct {
+        const char *name;
+        const char *desc;
+        int phase;
+    } timers[] = {
+        {"trace_view_time", "Time in seconds spent setting file views", OMPIO_TRACE_VIEW},
+        {"trace_shuffle_time", "Time in seconds spent in the collective operations, "
+         "besides the file system accesses", OMPIO_TRACE_SHUFFLE},
+        {"trace_fbtl_read_time", "Time in seconds spent reading from the file system", OMPIO_TRACE_FBTL_READ},
+        {"trace_fbtl_write_time", "Time in seconds spent writing to the file system", OMPIO_TRACE_FBTL_WRITE},
+        {"trace_sharedfp_time", "Time in seconds spent in the shared file pointer operations, "
+         "besides the file system accesses", OMPIO_TRACE_SHAREDFP},
+    };
+    size_t i;
+
+    for (i = 0 ; i < sizeof (counters) / sizeof (counters[0]) ; i++) {
+        (void) mca_base_component_pvar_register (&mca_io_ompio_component.io_version, counters[i].name,
+                                                 counters[i].desc, OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER,
+                                                 MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL, MCA_BASE_VAR_BIND_MPI_FILE,
+                                                 MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                                 io_pvar_read, NULL, NULL, (void *) (intptr_t) counters[i].offset);
+    }
+    for (i = 0 ; i < sizeof (timers) / sizeof (timers[0]) ; i++) {
+        (void) mca_base_component_pvar_register (&mca_io_ompio_component.io_version, timers[i].name,
+                                                 timers[i].desc, OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_TIMER,
+                                                 MCA_BASE_VAR_TYPE_DOUBLE, NULL, MCA_BASE_VAR_BIND_MPI_FILE,
+                                                 MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                                 io_pvar_read, NULL, NULL,
+                                                 (void *) (intptr_t) (offsetof (mca_common_ompio_trace_t, time)
+                                                                      + timers[i].phase * sizeof (double)));
+    }
+}
+
 static int register_component(void)
 {
     priority_param = 30;
@@ -207,7 +297,9 @@ static int register_component(void)
                                            "Option for grouping of processes in the aggregator selection "
                                            "1: Data volume based grouping 2: maximizing group size uniformity 3: maximimze "
                                            "data contiguity 4: hybrid optimization  5: simple (default) "
-                                           "6: skip refinement step 7: simple+: grouping based on default file view",
+                                           "6: skip refinement step 7: simple+: grouping based on default file view "
+                                           "8: topology aware: aggregators spread over the nodes, their number "
+                                           "matched to the stripe count of the file",
                                            MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY,
@@ -237,6 +329,68 @@ static int register_component(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_io_ompio_aggregators_cutoff_threshold);
 
+    mca_io_ompio_aggregators_per_node=1;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "aggregators_per_node",
+                                           "Number of aggregators per node in the topology aware aggregator "
+                                           "selection (8), typically the number of network interfaces of a node.",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_aggregators_per_node);
+
+    mca_io_ompio_write_behind_size=0;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "write_behind_size",
+                                           "Size in bytes of the per file buffer merging the small contiguous "
+                                           "independent writes before issuing them. 0: disabled (default)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_write_behind_size);
+
+    mca_io_ompio_write_behind_timeout=1000;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "write_behind_timeout",
+                                           "Maximum time in milliseconds data is kept in the write-behind buffer, "
+                                           "checked whenever the file is accessed (default: 1000)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_write_behind_timeout);
+
+    mca_io_ompio_read_ahead_size=0;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "read_ahead_size",
+                                           "Size in bytes of the per file buffer prefetching the data following "
+                                           "small sequential independent reads. 0: disabled (default)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_read_ahead_size);
+
+    mca_io_ompio_read_cache_size=256*1024*1024;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "read_cache_size",
+                                           "Memory in bytes per node of the shared cache of the collective reads, "
+                                           "for the files opened with the ompio_read_cache info key set to true. "
+                                           "The ompio_read_cache_size info key overrides it (default: 256MB)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_read_cache_size);
+
+    mca_io_ompio_gpu_direct_storage=1;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "gpu_direct_storage",
+                                           "Let the aggregators of the collective operations on device buffers "
+                                           "access the file directly from device memory through GPUDirect Storage, "
+                                           "if Open MPI was built with cuFile support. 0: disabled, 1: enabled (default)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_gpu_direct_storage);
+
     mca_io_ompio_overwrite_amode = 1;
     (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
                                            "overwrite_amode",
@@ -260,6 +414,20 @@ static int register_component(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_io_ompio_verbose_info_parsing);
 
+    mca_io_ompio_trace = 0;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "trace",
+                                           "Collect per file I/O statistics, exported as MPI_T performance "
+                                           "variables bound to the file. 0: disabled (default), 1: enabled, "
+                                           "2: also print a darshan-parser style summary of each file when "
+                                           "it is closed",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_trace);
+
+    register_pvars ();
+
     return OMPI_SUCCESS;
 }
 
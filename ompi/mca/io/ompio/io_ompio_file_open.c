@@ -40,6 +40,7 @@
 #include <math.h>
 #include "io_ompio.h"
 #include "ompi/mca/common/ompio/common_ompio_request.h"
+#include "ompi/mca/common/ompio/common_ompio_cache.h"
 #include "ompi/mca/topo/topo.h"
 
 int mca_io_ompio_file_open (ompi_communicator_t *comm,
@@ -132,8 +133,8 @@ int mca_io_ompio_file_preallocate (ompi_file_t *fh,
         OPAL_THREAD_UNLOCK(&fh->f_lock);
         return OMPI_ERROR;
     }
-    ret = data->ompio_fh.f_fs->fs_file_get_size (&data->ompio_fh,
-                                                 &current_size);
+    ret = mca_common_ompio_file_get_size (&data->ompio_fh,
+                                          &current_size);
     if ( OMPI_SUCCESS != ret ) {
         OPAL_THREAD_UNLOCK(&fh->f_lock);
         return OMPI_ERROR;
@@ -205,6 +206,11 @@ int mca_io_ompio_file_preallocate (ompi_file_t *fh,
             }
         }
 
+        ret = mca_common_ompio_write_behind_flush (&data->ompio_fh);
+        if (ret != OMPI_SUCCESS) {
+            goto exit;
+        }
+
         // This operation should not affect file pointer position.
         mca_common_ompio_set_explicit_offset ( &data->ompio_fh, prev_offset);
     }
@@ -217,6 +223,7 @@ exit:
     if ( diskspace > current_size ) {
         data->ompio_fh.f_fs->fs_file_set_size (&data->ompio_fh, diskspace);
     }
+    mca_common_ompio_cache_invalidate (&data->ompio_fh);
     OPAL_THREAD_UNLOCK(&fh->f_lock);
 
     return ret;
@@ -251,7 +258,12 @@ int mca_io_ompio_file_set_size (ompi_file_t *fh,
         return OMPI_ERROR;
     }
 
-    ret = data->ompio_fh.f_fs->fs_file_set_size (&data->ompio_fh, size);
+    /* a later flush would undo the truncation */
+    mca_common_ompio_cache_invalidate (&data->ompio_fh);
+    ret = mca_common_ompio_write_behind_flush (&data->ompio_fh);
+    if ( OMPI_SUCCESS == ret ) {
+        ret = data->ompio_fh.f_fs->fs_file_set_size (&data->ompio_fh, size);
+    }
     if ( OMPI_SUCCESS != ret ) {
         opal_output(1, ",mca_io_ompio_file_set_size: error in fs->set_size\n");
         OPAL_THREAD_UNLOCK(&fh->f_lock);
@@ -337,6 +349,12 @@ int mca_io_ompio_file_set_atomicity (ompi_file_t *fh,
 
     bool result;
     if ( flag ) {
+        /* atomic mode bypasses the write-behind buffer */
+        ret = mca_common_ompio_write_behind_flush (&data->ompio_fh);
+        if ( OMPI_SUCCESS != ret ) {
+            OPAL_THREAD_UNLOCK(&fh->f_lock);
+            return ret;
+        }
         result = data->ompio_fh.f_fbtl->fbtl_check_atomicity(&data->ompio_fh);
         if ( result ) {
             data->ompio_fh.f_atomicity = flag;
@@ -384,6 +402,13 @@ int mca_io_ompio_file_sync (ompi_file_t *fh)
         OPAL_THREAD_UNLOCK(&fh->f_lock);
         return MPI_ERR_ACCESS;
     }        
+    ret = mca_common_ompio_write_behind_flush (&data->ompio_fh);
+    if ( OMPI_SUCCESS != ret ) {
+        OPAL_THREAD_UNLOCK(&fh->f_lock);
+        return ret;
+    }
+    /* the data other processes wrote becomes visible */
+    mca_common_ompio_cache_invalidate (&data->ompio_fh);
     // Make sure all processes reach this point before syncing the file.
     ret = data->ompio_fh.f_comm->c_coll->coll_barrier (data->ompio_fh.f_comm,
                                                        data->ompio_fh.f_comm->c_coll->coll_barrier_module);
@@ -467,8 +492,8 @@ int mca_io_ompio_file_seek (ompi_file_t *fh,
         }
         break;
     case MPI_SEEK_END:
-        ret = data->ompio_fh.f_fs->fs_file_get_size (&data->ompio_fh,
-                                                     &temp_offset2);
+        ret = mca_common_ompio_file_get_size (&data->ompio_fh,
+                                              &temp_offset2);
         mca_io_ompio_file_get_eof_offset (&data->ompio_fh,
                                           temp_offset2, &temp_offset);
         offset += temp_offset;
@@ -566,6 +591,7 @@ int mca_io_ompio_file_seek_shared (ompi_file_t *fp,
     mca_common_ompio_data_t *data;
     ompio_file_t *fh;
     mca_sharedfp_base_module_t * shared_fp_base_module;
+    mca_common_ompio_trace_mark_t mark;
 
     data = (mca_common_ompio_data_t *) fp->f_io_selected_data;
     fh = &data->ompio_fh;
@@ -578,7 +604,9 @@ int mca_io_ompio_file_seek_shared (ompi_file_t *fp,
     }
 
     OPAL_THREAD_LOCK(&fp->f_lock);
+    mca_common_ompio_trace_begin (&fh->f_trace, &mark);
     ret = shared_fp_base_module->sharedfp_seek(fh,offset,whence);
+    mca_common_ompio_trace_end (&fh->f_trace, OMPIO_TRACE_SHAREDFP, &mark);
     OPAL_THREAD_UNLOCK(&fp->f_lock);
 
     return ret;
@@ -592,6 +620,7 @@ int mca_io_ompio_file_get_position_shared (ompi_file_t *fp,
     mca_common_ompio_data_t *data;
     ompio_file_t *fh;
     mca_sharedfp_base_module_t * shared_fp_base_module;
+    mca_common_ompio_trace_mark_t mark;
 
     data = (mca_common_ompio_data_t *) fp->f_io_selected_data;
     fh = &data->ompio_fh;
@@ -603,7 +632,9 @@ int mca_io_ompio_file_get_position_shared (ompi_file_t *fp,
         return OMPI_ERROR;
     }
     OPAL_THREAD_LOCK(&fp->f_lock);
+    mca_common_ompio_trace_begin (&fh->f_trace, &mark);
     ret = shared_fp_base_module->sharedfp_get_position(fh,offset);
+    mca_common_ompio_trace_end (&fh->f_trace, OMPIO_TRACE_SHAREDFP, &mark);
     *offset = *offset / fh->f_etype_size;
     OPAL_THREAD_UNLOCK(&fp->f_lock);
 
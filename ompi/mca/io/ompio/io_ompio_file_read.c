@@ -225,6 +225,7 @@ int mca_io_ompio_file_read_shared (ompi_file_t *fp,
     mca_common_ompio_data_t *data;
     ompio_file_t *fh;
     mca_sharedfp_base_module_t * shared_fp_base_module;
+    mca_common_ompio_trace_mark_t mark;
 
     data = (mca_common_ompio_data_t *) fp->f_io_selected_data;
     fh = &data->ompio_fh;
@@ -236,7 +237,9 @@ int mca_io_ompio_file_read_shared (ompi_file_t *fp,
 	return OMPI_ERROR;
     }
     OPAL_THREAD_LOCK(&fp->f_lock);
+    mca_common_ompio_trace_begin (&fh->f_trace, &mark);
     ret = shared_fp_base_module->sharedfp_read(fh,buf,count,datatype,status);
+    mca_common_ompio_trace_end (&fh->f_trace, OMPIO_TRACE_SHAREDFP, &mark);
     OPAL_THREAD_UNLOCK(&fp->f_lock);
 
     return ret;
@@ -252,6 +255,7 @@ int mca_io_ompio_file_iread_shared (ompi_file_t *fh,
     mca_common_ompio_data_t *data;
     ompio_file_t *ompio_fh;
     mca_sharedfp_base_module_t * shared_fp_base_module;
+    mca_common_ompio_trace_mark_t mark;
 
     data = (mca_common_ompio_data_t *) fh->f_io_selected_data;
     ompio_fh = &data->ompio_fh;
@@ -263,7 +267,9 @@ int mca_io_ompio_file_iread_shared (ompi_file_t *fh,
 	return OMPI_ERROR;
     }
     OPAL_THREAD_LOCK(&fh->f_lock);
+    mca_common_ompio_trace_begin (&ompio_fh->f_trace, &mark);
     ret = shared_fp_base_module->sharedfp_iread(ompio_fh,buf,count,datatype,request);
+    mca_common_ompio_trace_end (&ompio_fh->f_trace, OMPIO_TRACE_SHAREDFP, &mark);
     OPAL_THREAD_UNLOCK(&fh->f_lock);
 
     return ret;
@@ -279,6 +285,7 @@ int mca_io_ompio_file_read_ordered (ompi_file_t *fh,
     mca_common_ompio_data_t *data;
     ompio_file_t *ompio_fh;
     mca_sharedfp_base_module_t * shared_fp_base_module;
+    mca_common_ompio_trace_mark_t mark;
 
     data = (mca_common_ompio_data_t *) fh->f_io_selected_data;
     ompio_fh = &data->ompio_fh;
@@ -290,7 +297,9 @@ int mca_io_ompio_file_read_ordered (ompi_file_t *fh,
 	return OMPI_ERROR;
     }
     OPAL_THREAD_LOCK(&fh->f_lock);
+    mca_common_ompio_trace_begin (&ompio_fh->f_trace, &mark);
     ret = shared_fp_base_module->sharedfp_read_ordered(ompio_fh,buf,count,datatype,status);
+    mca_common_ompio_trace_end (&ompio_fh->f_trace, OMPIO_TRACE_SHAREDFP, &mark);
     OPAL_THREAD_UNLOCK(&fh->f_lock);
     return ret;
 }
@@ -304,6 +313,7 @@ int mca_io_ompio_file_read_ordered_begin (ompi_file_t *fh,
     mca_common_ompio_data_t *data;
     ompio_file_t *ompio_fh;
     mca_sharedfp_base_module_t * shared_fp_base_module;
+    mca_common_ompio_trace_mark_t mark;
 
     data = (mca_common_ompio_data_t *) fh->f_io_selected_data;
     ompio_fh = &data->ompio_fh;
@@ -315,7 +325,9 @@ int mca_io_ompio_file_read_ordered_begin (ompi_file_t *fh,
 	return OMPI_ERROR;
     }
     OPAL_THREAD_LOCK(&fh->f_lock);
+    mca_common_ompio_trace_begin (&ompio_fh->f_trace, &mark);
     ret = shared_fp_base_module->sharedfp_read_ordered_begin(ompio_fh,buf,count,datatype);
+    mca_common_ompio_trace_end (&ompio_fh->f_trace, OMPIO_TRACE_SHAREDFP, &mark);
     OPAL_THREAD_UNLOCK(&fh->f_lock);
 
     return ret;
@@ -329,6 +341,7 @@ int mca_io_ompio_file_read_ordered_end (ompi_file_t *fh,
     mca_common_ompio_data_t *data;
     ompio_file_t *ompio_fh;
     mca_sharedfp_base_module_t * shared_fp_base_module;
+    mca_common_ompio_trace_mark_t mark;
 
     data = (mca_common_ompio_data_t *) fh->f_io_selected_data;
     ompio_fh = &data->ompio_fh;
@@ -340,7 +353,9 @@ int mca_io_ompio_file_read_ordered_end (ompi_file_t *fh,
 	return OMPI_ERROR;
     }
     OPAL_THREAD_LOCK(&fh->f_lock);
+    mca_common_ompio_trace_begin (&ompio_fh->f_trace, &mark);
     ret = shared_fp_base_module->sharedfp_read_ordered_end(ompio_fh,buf,status);
+    mca_common_ompio_trace_end (&ompio_fh->f_trace, OMPIO_TRACE_SHAREDFP, &mark);
     OPAL_THREAD_UNLOCK(&fh->f_lock);
 
     return ret;
@@ -65,6 +65,7 @@ int mca_io_ompio_file_set_view (ompi_file_t *fp,
     int ret=OMPI_SUCCESS;
     mca_common_ompio_data_t *data;
     ompio_file_t *fh;
+    mca_common_ompio_trace_mark_t mark;
 
     if ( (strcmp(datarep, "native") && strcmp(datarep, "NATIVE") &&
           strcmp(datarep, "external32") && strcmp(datarep, "EXTERNAL32"))) {
@@ -86,7 +87,10 @@ int mca_io_ompio_file_set_view (ompi_file_t *fp,
         
     
     OPAL_THREAD_LOCK(&fp->f_lock);
+    mca_common_ompio_trace_begin (&fh->f_trace, &mark);
     ret = mca_common_ompio_set_view(fh, disp, etype, filetype, datarep, info);
+    mca_common_ompio_trace_end (&fh->f_trace, OMPIO_TRACE_VIEW, &mark);
+    fh->f_trace.views++;
     OPAL_THREAD_UNLOCK(&fp->f_lock);
     return ret;
 }
@@ -232,6 +232,7 @@ int mca_io_ompio_file_write_shared (ompi_file_t *fp,
     mca_common_ompio_data_t *data;
     ompio_file_t *fh;
     mca_sharedfp_base_module_t * shared_fp_base_module;
+    mca_common_ompio_trace_mark_t mark;
 
     data = (mca_common_ompio_data_t *) fp->f_io_selected_data;
     fh = &data->ompio_fh;
@@ -243,7 +244,9 @@ int mca_io_ompio_file_write_shared (ompi_file_t *fp,
         return OMPI_ERROR;
     }
     OPAL_THREAD_LOCK(&fp->f_lock);
+    mca_common_ompio_trace_begin (&fh->f_trace, &mark);
     ret = shared_fp_base_module->sharedfp_write(fh,buf,count,datatype,status);
+    mca_common_ompio_trace_end (&fh->f_trace, OMPIO_TRACE_SHAREDFP, &mark);
     OPAL_THREAD_UNLOCK(&fp->f_lock);
 
     return ret;
@@ -259,6 +262,7 @@ int mca_io_ompio_file_iwrite_shared (ompi_file_t *fp,
     mca_common_ompio_data_t *data;
     ompio_file_t *fh;
     mca_sharedfp_base_module_t * shared_fp_base_module;
+    mca_common_ompio_trace_mark_t mark;
 
     data = (mca_common_ompio_data_t *) fp->f_io_selected_data;
     fh = &data->ompio_fh;
@@ -270,7 +274,9 @@ int mca_io_ompio_file_iwrite_shared (ompi_file_t *fp,
         return OMPI_ERROR;
     }
     OPAL_THREAD_LOCK(&fp->f_lock);
+    mca_common_ompio_trace_begin (&fh->f_trace, &mark);
     ret = shared_fp_base_module->sharedfp_iwrite(fh,buf,count,datatype,request);
+    mca_common_ompio_trace_end (&fh->f_trace, OMPIO_TRACE_SHAREDFP, &mark);
     OPAL_THREAD_UNLOCK(&fp->f_lock);
 
     return ret;
@@ -286,6 +292,7 @@ int mca_io_ompio_file_write_ordered (ompi_file_t *fp,
     mca_common_ompio_data_t *data;
     ompio_file_t *fh;
     mca_sharedfp_base_module_t * shared_fp_base_module;
+    mca_common_ompio_trace_mark_t mark;
 
     data = (mca_common_ompio_data_t *) fp->f_io_selected_data;
     fh = &data->ompio_fh;
@@ -297,7 +304,9 @@ int mca_io_ompio_file_write_ordered (ompi_file_t *fp,
         return OMPI_ERROR;
     }
     OPAL_THREAD_LOCK(&fp->f_lock);
+    mca_common_ompio_trace_begin (&fh->f_trace, &mark);
     ret = shared_fp_base_module->sharedfp_write_ordered(fh,buf,count,datatype,status);
+    mca_common_ompio_trace_end (&fh->f_trace, OMPIO_TRACE_SHAREDFP, &mark);
     OPAL_THREAD_UNLOCK(&fp->f_lock);
 
     return ret;
@@ -312,6 +321,7 @@ int mca_io_ompio_file_write_ordered_begin (ompi_file_t *fp,
     mca_common_ompio_data_t *data;
     ompio_file_t *fh;
     mca_sharedfp_base_module_t * shared_fp_base_module;
+    mca_common_ompio_trace_mark_t mark;
 
     data = (mca_common_ompio_data_t *) fp->f_io_selected_data;
     fh = &data->ompio_fh;
@@ -323,7 +333,9 @@ int mca_io_ompio_file_write_ordered_begin (ompi_file_t *fp,
 	return OMPI_ERROR;
     }
     OPAL_THREAD_LOCK(&fp->f_lock);
+    mca_common_ompio_trace_begin (&fh->f_trace, &mark);
     ret = shared_fp_base_module->sharedfp_write_ordered_begin(fh,buf,count,datatype);
+    mca_common_ompio_trace_end (&fh->f_trace, OMPIO_TRACE_SHAREDFP, &mark);
     OPAL_THREAD_UNLOCK(&fp->f_lock);
 
     return ret;
@@ -337,6 +349,7 @@ int mca_io_ompio_file_write_ordered_end (ompi_file_t *fp,
     mca_common_ompio_data_t *data;
     ompio_file_t *fh;
     mca_sharedfp_base_module_t * shared_fp_base_module;
+    mca_common_ompio_trace_mark_t mark;
 
     data = (mca_common_ompio_data_t *) fp->f_io_selected_data;
     fh = &data->ompio_fh;
@@ -348,7 +361,9 @@ int mca_io_ompio_file_write_ordered_end (ompi_file_t *fp,
 	return OMPI_ERROR;
     }
     OPAL_THREAD_LOCK(&fp->f_lock);
+    mca_common_ompio_trace_begin (&fh->f_trace, &mark);
     ret = shared_fp_base_module->sharedfp_write_ordered_end(fh,buf,status);
+    mca_common_ompio_trace_end (&fh->f_trace, OMPIO_TRACE_SHAREDFP, &mark);
     OPAL_THREAD_UNLOCK(&fp->f_lock);
 
     return ret;
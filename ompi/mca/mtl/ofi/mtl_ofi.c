@@ -12,6 +12,8 @@
 
 OMPI_DECLSPEC extern mca_mtl_ofi_component_t mca_mtl_ofi_component;
 
+OBJ_CLASS_INSTANCE(ompi_mtl_ofi_mrecv_request_t, opal_free_list_item_t, NULL, NULL);
+
 mca_mtl_ofi_module_t ompi_mtl_ofi = {
     {
         (int)((1ULL << MTL_OFI_CID_BIT_COUNT_1) - 1), /* max cid */
@@ -71,53 +73,59 @@ ompi_mtl_ofi_add_procs(struct mca_mtl_base_module_t *mtl,
     }
 
     /**
-     * Create array of EP names.
-     */
-    ep_names = malloc(nprocs * namelen);
-    if (NULL == ep_names) {
-        ret = OMPI_ERROR;
-        goto bail;
-    }
-
-    /**
-     * Create array of fi_addrs.
+     * With mtl_ofi_lazy_av the names are looked up and inserted in the AV
+     * by ompi_mtl_ofi_get_endpoint the first time each peer is used.
      */
-    fi_addrs = malloc(nprocs * sizeof(fi_addr_t));
-    if (NULL == fi_addrs) {
-        ret = OMPI_ERROR;
-        goto bail;
-    }
+    if (!ompi_mtl_ofi.lazy_av) {
+        /**
+         * Create array of EP names.
+         */
+        ep_names = malloc(nprocs * namelen);
+        if (NULL == ep_names) {
+            ret = OMPI_ERROR;
+            goto bail;
+        }
 
-    /**
-     * Retrieve the processes' EP names from modex.
-     */
-    for (i = 0; i < nprocs; ++i) {
-        OFI_COMPAT_MODEX_RECV(ret,
-                              &mca_mtl_ofi_component.super.mtl_version,
-                              procs[i],
-                              (void**)&ep_name,
-                              &size);
-        if (OMPI_SUCCESS != ret) {
-            char *errhost = opal_get_proc_hostname(&procs[i]->super);
-            opal_show_help("help-mtl-ofi.txt", "modex failed",
-                           true, ompi_process_info.nodename,
-			                     errhost, opal_strerror(ret), ret);
-            free(errhost);
+        /**
+         * Create array of fi_addrs.
+         */
+        fi_addrs = malloc(nprocs * sizeof(fi_addr_t));
+        if (NULL == fi_addrs) {
+            ret = OMPI_ERROR;
             goto bail;
         }
-        memcpy(&ep_names[i*namelen], ep_name, namelen);
-    }
 
-    /**
-     * Map the EP names to fi_addrs.
-     */
-    count = fi_av_insert(ompi_mtl_ofi.av, ep_names, nprocs, fi_addrs, 0, NULL);
-    if ((count < 0) || (nprocs != (size_t)count)) {
-        opal_output_verbose(1, opal_common_ofi.output,
-                            "%s:%d: fi_av_insert failed: %d\n",
-                            __FILE__, __LINE__, count);
-        ret = OMPI_ERROR;
-        goto bail;
+        /**
+         * Retrieve the processes' EP names from modex.
+         */
+        for (i = 0; i < nprocs; ++i) {
+            OFI_COMPAT_MODEX_RECV(ret,
+                                  &mca_mtl_ofi_component.super.mtl_version,
+                                  procs[i],
+                                  (void**)&ep_name,
+                                  &size);
+            if (OMPI_SUCCESS != ret) {
+                char *errhost = opal_get_proc_hostname(&procs[i]->super);
+                opal_show_help("help-mtl-ofi.txt", "modex failed",
+                               true, ompi_process_info.nodename,
+                               errhost, opal_strerror(ret), ret);
+                free(errhost);
+                goto bail;
+            }
+            memcpy(&ep_names[i*namelen], ep_name, namelen);
+        }
+
+        /**
+         * Map the EP names to fi_addrs.
+         */
+        count = fi_av_insert(ompi_mtl_ofi.av, ep_names, nprocs, fi_addrs, 0, NULL);
+        if ((count < 0) || (nprocs != (size_t)count)) {
+            opal_output_verbose(1, opal_common_ofi.output,
+                                "%s:%d: fi_av_insert failed: %d\n",
+                                __FILE__, __LINE__, count);
+            ret = OMPI_ERROR;
+            goto bail;
+        }
     }
 
     /**
@@ -135,7 +143,7 @@ ompi_mtl_ofi_add_procs(struct mca_mtl_base_module_t *mtl,
         }
 
         endpoint->mtl_ofi_module = &ompi_mtl_ofi;
-        endpoint->peer_fiaddr = fi_addrs[i];
+        endpoint->peer_fiaddr = (NULL != fi_addrs) ? fi_addrs[i] : FI_ADDR_NOTAVAIL;
 
         /* FIXME: What happens if this endpoint already exists? */
         procs[i]->proc_endpoints[OMPI_PROC_ENDPOINT_TAG_MTL] = endpoint;
@@ -156,6 +164,55 @@ bail:
     return ret;
 }
 
+int
+ompi_mtl_ofi_insert_addr(mca_mtl_ofi_endpoint_t *endpoint, ompi_proc_t *ompi_proc)
+{
+    int ret = OMPI_SUCCESS;
+    int count;
+    size_t size;
+    char *ep_name = NULL;
+    fi_addr_t fi_addr;
+
+    OPAL_THREAD_LOCK(&ompi_mtl_ofi.av_lock);
+    if (FI_ADDR_NOTAVAIL != endpoint->peer_fiaddr) {
+        /* inserted by another thread */
+        goto unlock;
+    }
+
+    OFI_COMPAT_MODEX_RECV(ret,
+                          &mca_mtl_ofi_component.super.mtl_version,
+                          ompi_proc,
+                          (void**)&ep_name,
+                          &size);
+    if (OMPI_SUCCESS != ret) {
+        char *errhost = opal_get_proc_hostname(&ompi_proc->super);
+        opal_show_help("help-mtl-ofi.txt", "modex failed",
+                       true, ompi_process_info.nodename,
+                       errhost, opal_strerror(ret), ret);
+        free(errhost);
+        goto unlock;
+    }
+
+    count = fi_av_insert(ompi_mtl_ofi.av, ep_name, 1, &fi_addr, 0, NULL);
+    free(ep_name);
+    if (1 != count) {
+        opal_output_verbose(1, opal_common_ofi.output,
+                            "%s:%d: fi_av_insert failed: %d\n",
+                            __FILE__, __LINE__, count);
+        ret = OMPI_ERROR;
+        goto unlock;
+    }
+
+    /* peer_fiaddr is read without the lock */
+    opal_atomic_wmb();
+    endpoint->peer_fiaddr = fi_addr;
+
+unlock:
+    OPAL_THREAD_UNLOCK(&ompi_mtl_ofi.av_lock);
+
+    return ret;
+}
+
 int
 ompi_mtl_ofi_del_procs(struct mca_mtl_base_module_t *mtl,
                        size_t nprocs,
@@ -169,11 +226,13 @@ ompi_mtl_ofi_del_procs(struct mca_mtl_base_module_t *mtl,
         if (NULL != procs[i] &&
             NULL != procs[i]->proc_endpoints[OMPI_PROC_ENDPOINT_TAG_MTL]) {
             endpoint = procs[i]->proc_endpoints[OMPI_PROC_ENDPOINT_TAG_MTL];
-            ret = fi_av_remove(ompi_mtl_ofi.av, &endpoint->peer_fiaddr, 1, 0);
-            if (ret) {
-                opal_output_verbose(1, opal_common_ofi.output,
-                        "%s:%d: fi_av_remove failed: %s\n", __FILE__, __LINE__, fi_strerror(errno));
-                return ret;
+            if (FI_ADDR_NOTAVAIL != endpoint->peer_fiaddr) {
+                ret = fi_av_remove(ompi_mtl_ofi.av, &endpoint->peer_fiaddr, 1, 0);
+                if (ret) {
+                    opal_output_verbose(1, opal_common_ofi.output,
+                            "%s:%d: fi_av_remove failed: %s\n", __FILE__, __LINE__, fi_strerror(errno));
+                    return ret;
+                }
             }
             procs[i]->proc_endpoints[OMPI_PROC_ENDPOINT_TAG_MTL] = NULL;
             OBJ_RELEASE(endpoint);
@@ -34,6 +34,7 @@
 #include "ompi/proc/proc.h"
 #include "ompi/mca/mtl/mtl.h"
 #include "opal/class/opal_list.h"
+#include "opal/class/opal_free_list.h"
 #include "ompi/communicator/communicator.h"
 #include "opal/datatype/opal_convertor.h"
 #include "ompi/mca/mtl/base/base.h"
@@ -262,6 +263,32 @@ ompi_mtl_ofi_set_mr_null(ompi_mtl_ofi_request_t *ofi_req) {
     ofi_req->mr = NULL;
 }
 
+/**
+ * Matched probe requests
+ */
+
+__opal_attribute_always_inline__ static inline ompi_mtl_ofi_request_t *
+ompi_mtl_ofi_mrecv_request_alloc(void)
+{
+    ompi_mtl_ofi_mrecv_request_t *mrecv_req;
+
+    mrecv_req = (ompi_mtl_ofi_mrecv_request_t *)
+        opal_free_list_get(&ompi_mtl_ofi.mrecv_reqs);
+    if (OPAL_UNLIKELY(NULL == mrecv_req)) {
+        return NULL;
+    }
+
+    return &mrecv_req->ofi_req;
+}
+
+__opal_attribute_always_inline__ static inline void
+ompi_mtl_ofi_mrecv_request_return(ompi_mtl_ofi_request_t *ofi_req)
+{
+    opal_free_list_return(&ompi_mtl_ofi.mrecv_reqs,
+                          &container_of(ofi_req, ompi_mtl_ofi_mrecv_request_t,
+                                        ofi_req)->super);
+}
+
 /**
  * Registers user buffer with Libfabric domain if
  * buffer is cuda and provider has fi_mr_hmem
@@ -498,7 +525,9 @@ ompi_mtl_ofi_send_generic(struct mca_mtl_base_module_t *mtl,
                   int tag,
                   struct opal_convertor_t *convertor,
                   mca_pml_base_send_mode_t mode,
-                  bool ofi_cq_data)
+                  bool ofi_cq_data,
+                  bool ofi_inject,
+                  bool ofi_hmem)
 {
     ssize_t ret = OMPI_SUCCESS;
     ompi_mtl_ofi_request_t ofi_req;
@@ -568,10 +597,10 @@ ompi_mtl_ofi_send_generic(struct mca_mtl_base_module_t *mtl,
      *  https://github.com/ofiwg/libfabric/issues/5861
      */
 #if OPAL_CUDA_SUPPORT
-    if (!(convertor->flags & CONVERTOR_CUDA)
+    if (ofi_inject && (!ofi_hmem || !(convertor->flags & CONVERTOR_CUDA))
         && (ompi_mtl_ofi.max_inject_size >= length)) {
 #else /* !(OPAL_CUDA_SUPPORT)*/
-    if (ompi_mtl_ofi.max_inject_size >= length) {
+    if (ofi_inject && ompi_mtl_ofi.max_inject_size >= length) {
 #endif /* OPAL_CUDA_SUPPORT */
         if (ofi_cq_data) {
             MTL_OFI_RETRY_UNTIL_DONE(fi_tinjectdata(ompi_mtl_ofi.ofi_ctxt[ctxt_id].tx_ep,
@@ -600,9 +629,13 @@ ompi_mtl_ofi_send_generic(struct mca_mtl_base_module_t *mtl,
             goto free_request_buffer;
         }
     } else {
-        ompi_ret = ompi_mtl_ofi_register_buffer(convertor, &ofi_req, start);
-        if (OPAL_UNLIKELY(OMPI_SUCCESS != ompi_ret)) {
-            return ompi_ret;
+        if (ofi_hmem) {
+            ompi_ret = ompi_mtl_ofi_register_buffer(convertor, &ofi_req, start);
+            if (OPAL_UNLIKELY(OMPI_SUCCESS != ompi_ret)) {
+                return ompi_ret;
+            }
+        } else {
+            ofi_req.mr = NULL;
         }
         ofi_req.completion_count += 1;
         if (ofi_cq_data) {
@@ -655,7 +688,8 @@ ompi_mtl_ofi_isend_generic(struct mca_mtl_base_module_t *mtl,
                    mca_pml_base_send_mode_t mode,
                    bool blocking,
                    mca_mtl_request_t *mtl_request,
-                   bool ofi_cq_data)
+                   bool ofi_cq_data,
+                   bool ofi_hmem)
 {
     ssize_t ret = OMPI_SUCCESS;
     ompi_mtl_ofi_request_t *ofi_req = (ompi_mtl_ofi_request_t *) mtl_request;
@@ -714,9 +748,13 @@ ompi_mtl_ofi_isend_generic(struct mca_mtl_base_module_t *mtl,
             goto free_request_buffer;
     }
 
-    ompi_ret = ompi_mtl_ofi_register_buffer(convertor, ofi_req, start);
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != ompi_ret)) {
-        return ompi_ret;
+    if (ofi_hmem) {
+        ompi_ret = ompi_mtl_ofi_register_buffer(convertor, ofi_req, start);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != ompi_ret)) {
+            return ompi_ret;
+        }
+    } else {
+        ofi_req->mr = NULL;
     }
 
     if (ofi_cq_data) {
@@ -897,7 +935,8 @@ ompi_mtl_ofi_irecv_generic(struct mca_mtl_base_module_t *mtl,
                    int tag,
                    struct opal_convertor_t *convertor,
                    mca_mtl_request_t *mtl_request,
-                   bool ofi_cq_data)
+                   bool ofi_cq_data,
+                   bool ofi_hmem)
 {
     int ompi_ret = OMPI_SUCCESS, ctxt_id = 0;
     ssize_t ret;
@@ -950,9 +989,13 @@ ompi_mtl_ofi_irecv_generic(struct mca_mtl_base_module_t *mtl,
     ofi_req->remote_addr = remote_addr;
     ofi_req->match_bits = match_bits;
 
-    ompi_ret = ompi_mtl_ofi_register_buffer(convertor, ofi_req, start);
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != ompi_ret)) {
-        return ompi_ret;
+    if (ofi_hmem) {
+        ompi_ret = ompi_mtl_ofi_register_buffer(convertor, ofi_req, start);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != ompi_ret)) {
+            return ompi_ret;
+        }
+    } else {
+        ofi_req->mr = NULL;
     }
 
     MTL_OFI_RETRY_UNTIL_DONE(fi_trecv(ompi_mtl_ofi.ofi_ctxt[ctxt_id].rx_ep,
@@ -989,7 +1032,7 @@ ompi_mtl_ofi_mrecv_callback(struct fi_cq_tagged_entry *wc,
 
     ompi_mtl_ofi_deregister_and_free_buffer(ofi_req);
 
-    free(ofi_req);
+    ompi_mtl_ofi_mrecv_request_return(ofi_req);
 
     mrecv_req->completion_callback(mrecv_req);
 
@@ -1021,7 +1064,7 @@ ompi_mtl_ofi_mrecv_error_callback(struct fi_cq_err_entry *error,
 
     ompi_mtl_ofi_deregister_and_free_buffer(ofi_req);
 
-    free(ofi_req);
+    ompi_mtl_ofi_mrecv_request_return(ofi_req);
 
     mrecv_req->completion_callback(mrecv_req);
 
@@ -1244,9 +1287,10 @@ ompi_mtl_ofi_improbe_generic(struct mca_mtl_base_module_t *mtl,
     ctxt_id = ompi_mtl_ofi_map_comm_to_ctxt(comm->c_contextid);
     set_thread_context(ctxt_id);
 
-    ofi_req = malloc(sizeof *ofi_req);
-    if (NULL == ofi_req) {
-        return OMPI_ERROR;
+    /* the request stays attached to the message if the probe matches */
+    ofi_req = ompi_mtl_ofi_mrecv_request_alloc();
+    if (OPAL_UNLIKELY(NULL == ofi_req)) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
     }
 
     /**
@@ -1295,7 +1339,7 @@ ompi_mtl_ofi_improbe_generic(struct mca_mtl_base_module_t *mtl,
     MTL_OFI_RETRY_UNTIL_DONE(fi_trecvmsg(ompi_mtl_ofi.ofi_ctxt[ctxt_id].rx_ep, &msg, msgflags), ret);
     if (OPAL_UNLIKELY(0 > ret)) {
         MTL_OFI_LOG_FI_ERR(ret, "fi_trecvmsg failed");
-        free(ofi_req);
+        ompi_mtl_ofi_mrecv_request_return(ofi_req);
         return ompi_mtl_ofi_get_error(ret);
     }
 
@@ -1321,7 +1365,7 @@ ompi_mtl_ofi_improbe_generic(struct mca_mtl_base_module_t *mtl,
 
     } else {
         (*message) = MPI_MESSAGE_NULL;
-        free(ofi_req);
+        ompi_mtl_ofi_mrecv_request_return(ofi_req);
     }
 
     return OMPI_SUCCESS;
@@ -1609,7 +1653,9 @@ ompi_mtl_ofi_send(struct mca_mtl_base_module_t *mtl,
 {
     return ompi_mtl_ofi_send_generic(mtl, comm, dest, tag,
                                     convertor, mode,
-                                    ompi_mtl_ofi.fi_cq_data);
+                                    ompi_mtl_ofi.fi_cq_data,
+                                    ompi_mtl_ofi.fi_inject,
+                                    ompi_mtl_ofi.hmem);
 }
 
 __opal_attribute_always_inline__ static inline int
@@ -1624,7 +1670,8 @@ ompi_mtl_ofi_isend(struct mca_mtl_base_module_t *mtl,
 {
     return ompi_mtl_ofi_isend_generic(mtl, comm, dest, tag,
                                     convertor, mode, blocking, mtl_request,
-                                    ompi_mtl_ofi.fi_cq_data);
+                                    ompi_mtl_ofi.fi_cq_data,
+                                    ompi_mtl_ofi.hmem);
 }
 
 __opal_attribute_always_inline__ static inline int
@@ -1637,7 +1684,8 @@ ompi_mtl_ofi_irecv(struct mca_mtl_base_module_t *mtl,
 {
     return ompi_mtl_ofi_irecv_generic(mtl, comm, src, tag,
                                     convertor, mtl_request,
-                                    ompi_mtl_ofi.fi_cq_data);
+                                    ompi_mtl_ofi.fi_cq_data,
+                                    ompi_mtl_ofi.hmem);
 }
 
 __opal_attribute_always_inline__ static inline int
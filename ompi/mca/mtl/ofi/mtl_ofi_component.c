@@ -20,6 +20,8 @@
 #include "opal/util/argv.h"
 #include "opal/util/printf.h"
 #include "opal/mca/common/ofi/common_ofi.h"
+#include "opal/runtime/opal.h"
+#include "opal/runtime/opal_params.h"
 #if OPAL_CUDA_SUPPORT
 #include "opal/mca/common/cuda/common_cuda.h"
 #endif /* OPAL_CUDA_SUPPORT */
@@ -222,6 +224,15 @@ ompi_mtl_ofi_component_register(void)
                                      &av_type);
     OBJ_RELEASE(new_enum);
 
+    ompi_mtl_ofi.lazy_av = false;
+    mca_base_component_var_register(&mca_mtl_ofi_component.super.mtl_version,
+                                    "lazy_av",
+                                    "Look up the address of a peer and insert it in the AV the first time a message is sent to it or a receive is posted for it instead of at add_procs time (default: false). Receives from any source do not need the address of the sender.",
+                                    MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                    OPAL_INFO_LVL_4,
+                                    MCA_BASE_VAR_SCOPE_READONLY,
+                                    &ompi_mtl_ofi.lazy_av);
+
     ompi_mtl_ofi.enable_sep = 0;
     mca_base_component_var_register(&mca_mtl_ofi_component.super.mtl_version,
                                     "enable_sep",
@@ -264,6 +275,8 @@ ompi_mtl_ofi_component_register(void)
 static int
 ompi_mtl_ofi_component_open(void)
 {
+    int ret;
+
     ompi_mtl_ofi.base.mtl_request_size =
         sizeof(ompi_mtl_ofi_request_t) - sizeof(struct mca_mtl_request_t);
 
@@ -271,6 +284,18 @@ ompi_mtl_ofi_component_open(void)
     ompi_mtl_ofi.av     =  NULL;
     ompi_mtl_ofi.sep     =  NULL;
 
+    OBJ_CONSTRUCT(&ompi_mtl_ofi.av_lock, opal_mutex_t);
+
+    OBJ_CONSTRUCT(&ompi_mtl_ofi.mrecv_reqs, opal_free_list_t);
+    ret = opal_free_list_init(&ompi_mtl_ofi.mrecv_reqs,
+                              sizeof(ompi_mtl_ofi_mrecv_request_t),
+                              opal_cache_line_size,
+                              OBJ_CLASS(ompi_mtl_ofi_mrecv_request_t),
+                              0, 0, 0, -1, 16, NULL, 0, NULL, NULL, NULL);
+    if (OPAL_SUCCESS != ret) {
+        return ret;
+    }
+
     /**
      * Sanity check: provider_include and provider_exclude must be mutually
      * exclusive
@@ -303,6 +328,8 @@ ompi_mtl_ofi_component_close(void)
 #if OPAL_CUDA_SUPPORT
     mca_common_cuda_fini();
 #endif
+    OBJ_DESTRUCT(&ompi_mtl_ofi.mrecv_reqs);
+    OBJ_DESTRUCT(&ompi_mtl_ofi.av_lock);
     opal_common_ofi_mca_deregister();
     return OMPI_SUCCESS;
 }
@@ -814,31 +841,6 @@ select_prov:
         ompi_mtl_ofi_define_tag_mode(ofi_tag_mode, &ofi_tag_bits_for_cid);
     }
 
-    /**
-     * Initialize the MTL OFI Symbol Tables & function pointers
-     * for specialized functions.
-     */
-
-    ompi_mtl_ofi_send_symtable_init(&ompi_mtl_ofi.sym_table);
-    ompi_mtl_ofi.base.mtl_send =
-        ompi_mtl_ofi.sym_table.ompi_mtl_ofi_send[ompi_mtl_ofi.fi_cq_data];
-
-    ompi_mtl_ofi_isend_symtable_init(&ompi_mtl_ofi.sym_table);
-    ompi_mtl_ofi.base.mtl_isend =
-        ompi_mtl_ofi.sym_table.ompi_mtl_ofi_isend[ompi_mtl_ofi.fi_cq_data];
-
-    ompi_mtl_ofi_irecv_symtable_init(&ompi_mtl_ofi.sym_table);
-    ompi_mtl_ofi.base.mtl_irecv =
-        ompi_mtl_ofi.sym_table.ompi_mtl_ofi_irecv[ompi_mtl_ofi.fi_cq_data];
-
-    ompi_mtl_ofi_iprobe_symtable_init(&ompi_mtl_ofi.sym_table);
-    ompi_mtl_ofi.base.mtl_iprobe =
-        ompi_mtl_ofi.sym_table.ompi_mtl_ofi_iprobe[ompi_mtl_ofi.fi_cq_data];
-
-    ompi_mtl_ofi_improbe_symtable_init(&ompi_mtl_ofi.sym_table);
-    ompi_mtl_ofi.base.mtl_improbe =
-        ompi_mtl_ofi.sym_table.ompi_mtl_ofi_improbe[ompi_mtl_ofi.fi_cq_data];
-
     /**
      * Check for potential bits in the OFI tag that providers may be reserving
      * for internal usage (see mem_tag_format in fi_endpoint man page).
@@ -944,6 +946,47 @@ select_prov:
     ompi_mtl_ofi.max_inject_size = prov->tx_attr->inject_size;
     ompi_mtl_ofi.max_msg_size = prov->ep_attr->max_msg_size;
 
+    /**
+     * Capabilities the specialized functions are compiled for. Providers
+     * that cannot inject skip the inject branch, and device buffer
+     * registration is only done when CUDA buffers can reach the MTL.
+     */
+    ompi_mtl_ofi.fi_inject = (0 < ompi_mtl_ofi.max_inject_size);
+#if OPAL_CUDA_SUPPORT
+    ompi_mtl_ofi.hmem = opal_cuda_support;
+#else
+    ompi_mtl_ofi.hmem = false;
+#endif /* OPAL_CUDA_SUPPORT */
+
+    /**
+     * Initialize the MTL OFI Symbol Tables & function pointers
+     * for specialized functions.
+     */
+
+    ompi_mtl_ofi_send_symtable_init(&ompi_mtl_ofi.sym_table);
+    ompi_mtl_ofi.base.mtl_send =
+        ompi_mtl_ofi.sym_table.ompi_mtl_ofi_send[ompi_mtl_ofi.fi_cq_data]
+                                                [ompi_mtl_ofi.fi_inject]
+                                                [ompi_mtl_ofi.hmem];
+
+    ompi_mtl_ofi_isend_symtable_init(&ompi_mtl_ofi.sym_table);
+    ompi_mtl_ofi.base.mtl_isend =
+        ompi_mtl_ofi.sym_table.ompi_mtl_ofi_isend[ompi_mtl_ofi.fi_cq_data]
+                                                 [ompi_mtl_ofi.hmem];
+
+    ompi_mtl_ofi_irecv_symtable_init(&ompi_mtl_ofi.sym_table);
+    ompi_mtl_ofi.base.mtl_irecv =
+        ompi_mtl_ofi.sym_table.ompi_mtl_ofi_irecv[ompi_mtl_ofi.fi_cq_data]
+                                                 [ompi_mtl_ofi.hmem];
+
+    ompi_mtl_ofi_iprobe_symtable_init(&ompi_mtl_ofi.sym_table);
+    ompi_mtl_ofi.base.mtl_iprobe =
+        ompi_mtl_ofi.sym_table.ompi_mtl_ofi_iprobe[ompi_mtl_ofi.fi_cq_data];
+
+    ompi_mtl_ofi_improbe_symtable_init(&ompi_mtl_ofi.sym_table);
+    ompi_mtl_ofi.base.mtl_improbe =
+        ompi_mtl_ofi.sym_table.ompi_mtl_ofi_improbe[ompi_mtl_ofi.fi_cq_data];
+
     /**
      * The user is not allowed to exceed MTL_OFI_MAX_PROG_EVENT_COUNT.
      * The reason is because progress entries array is now a TLS variable
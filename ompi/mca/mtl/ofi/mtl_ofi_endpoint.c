@@ -17,6 +17,7 @@
 static void mca_mtl_ofi_endpoint_construct(mca_mtl_ofi_endpoint_t *endpoint)
 {
     endpoint->mtl_ofi_module = NULL;
+    endpoint->peer_fiaddr = FI_ADDR_NOTAVAIL;
 }
 
 /**
@@ -32,16 +32,20 @@ struct mca_mtl_ofi_endpoint_t {
     /** MTL instance that created this connection */
     struct mca_mtl_ofi_module_t *mtl_ofi_module;
 
-    /** The peer's fi_addr */
+    /** The peer's fi_addr, FI_ADDR_NOTAVAIL until it is inserted (mtl_ofi_lazy_av) */
     fi_addr_t peer_fiaddr;
 };
 
 typedef struct mca_mtl_ofi_endpoint_t  mca_mtl_ofi_endpoint_t;
 
+int ompi_mtl_ofi_insert_addr(mca_mtl_ofi_endpoint_t *endpoint, ompi_proc_t *ompi_proc);
+
 static inline mca_mtl_ofi_endpoint_t *
 ompi_mtl_ofi_get_endpoint(struct mca_mtl_base_module_t* mtl,
                           ompi_proc_t *ompi_proc)
 {
+    mca_mtl_ofi_endpoint_t *endpoint;
+
     if (OPAL_UNLIKELY(NULL == ompi_proc->proc_endpoints[OMPI_PROC_ENDPOINT_TAG_MTL])) {
         if (OPAL_UNLIKELY(OMPI_SUCCESS != MCA_PML_CALL(add_procs(&ompi_proc, 1)))) {
             /* Fatal error. exit() out */
@@ -52,7 +56,19 @@ ompi_mtl_ofi_get_endpoint(struct mca_mtl_base_module_t* mtl,
         }
     }
 
-    return ompi_proc->proc_endpoints[OMPI_PROC_ENDPOINT_TAG_MTL];
+    endpoint = ompi_proc->proc_endpoints[OMPI_PROC_ENDPOINT_TAG_MTL];
+
+    if (OPAL_UNLIKELY(FI_ADDR_NOTAVAIL == endpoint->peer_fiaddr)) {
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != ompi_mtl_ofi_insert_addr(endpoint, ompi_proc))) {
+            /* Fatal error. exit() out */
+            opal_output(0, "%s:%d: *** The Open MPI OFI MTL is aborting the MPI job (via exit(3)).\n",
+                           __FILE__, __LINE__);
+            fflush(stderr);
+            exit(1);
+        }
+    }
+
+    return endpoint;
 }
 
 END_C_DECLS
@@ -20,16 +20,19 @@ sub gen_funcs {
     my $gen_file = $_[0];
     my $gen_type = $_[1];
     my $OFI_CQ_DATA_EN = "false";
+    my $OFI_HMEM_EN = "false";
 
     foreach $OFI_CQ_DATA_EN (@true_false) {
-        my @flags = ($OFI_CQ_DATA_EN);
-        if (($gen_type cmp "FUNC") == 0) {
-            my $FUNC = gen_isend_function(\@flags);
-            print $gen_file "$FUNC\n\n";
-        }
-        if (($gen_type cmp "SYM") == 0) {
-            my $SYM = gen_isend_sym_init(\@flags);
-            print $gen_file "$SYM\n";
+        foreach $OFI_HMEM_EN (@true_false) {
+            my @flags = ($OFI_CQ_DATA_EN, $OFI_HMEM_EN);
+            if (($gen_type cmp "FUNC") == 0) {
+                my $FUNC = gen_isend_function(\@flags);
+                print $gen_file "$FUNC\n\n";
+            }
+            if (($gen_type cmp "SYM") == 0) {
+                my $SYM = gen_isend_sym_init(\@flags);
+                print $gen_file "$SYM\n";
+            }
         }
     }
 }
@@ -38,6 +41,7 @@ sub gen_isend_function {
     my @op_flags = @{$_[0]};
     my $MTL_OFI_NAME_EXT = opt_common::mtl_ofi_opt_common::gen_flags_ext(\@op_flags);
     my $OFI_CQ_DATA_EN = $op_flags[0];
+    my $OFI_HMEM_EN = $op_flags[1];
 
     my $ISEND_FUNCTION =
 "__opal_attribute_always_inline__ static inline int
@@ -51,10 +55,11 @@ ompi_mtl_ofi_isend_" . $MTL_OFI_NAME_EXT . "(struct mca_mtl_base_module_t *mtl,
                mca_mtl_request_t *mtl_request)
 {
     const bool OFI_CQ_DATA = " . $OFI_CQ_DATA_EN . ";
+    const bool OFI_HMEM = " . $OFI_HMEM_EN . ";
 
     return ompi_mtl_ofi_isend_generic(mtl, comm, dest, tag,
                                     convertor, mode, blocking,
-                                    mtl_request, OFI_CQ_DATA);
+                                    mtl_request, OFI_CQ_DATA, OFI_HMEM);
 }";
     return $ISEND_FUNCTION;
 }
@@ -63,9 +68,10 @@ sub gen_isend_sym_init {
     my @op_flags = @{$_[0]};
     my $MTL_OFI_FUNC_NAME = "ompi_mtl_ofi_isend_" . opt_common::mtl_ofi_opt_common::gen_flags_ext(\@op_flags) . "";
     my $OFI_CQ_DATA_EN = $op_flags[0];
+    my $OFI_HMEM_EN = $op_flags[1];
     my $symbol_init =
 "
-    sym_table->ompi_mtl_ofi_isend[".$OFI_CQ_DATA_EN."]
+    sym_table->ompi_mtl_ofi_isend[".$OFI_CQ_DATA_EN."][".$OFI_HMEM_EN."]
         = ".$MTL_OFI_FUNC_NAME.";
 ";
     return $symbol_init;
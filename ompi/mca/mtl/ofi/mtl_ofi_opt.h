@@ -16,9 +16,11 @@
 BEGIN_C_DECLS
 
 #define CQ_DATA_TYPES 2
-#define OMPI_MTL_OFI_SEND_TYPES     [CQ_DATA_TYPES]
-#define OMPI_MTL_OFI_ISEND_TYPES    [CQ_DATA_TYPES]
-#define OMPI_MTL_OFI_IRECV_TYPES    [CQ_DATA_TYPES]
+#define INJECT_TYPES 2
+#define HMEM_TYPES 2
+#define OMPI_MTL_OFI_SEND_TYPES     [CQ_DATA_TYPES][INJECT_TYPES][HMEM_TYPES]
+#define OMPI_MTL_OFI_ISEND_TYPES    [CQ_DATA_TYPES][HMEM_TYPES]
+#define OMPI_MTL_OFI_IRECV_TYPES    [CQ_DATA_TYPES][HMEM_TYPES]
 #define OMPI_MTL_OFI_IPROBE_TYPES   [CQ_DATA_TYPES]
 #define OMPI_MTL_OFI_IMPROBE_TYPES  [CQ_DATA_TYPES]
 
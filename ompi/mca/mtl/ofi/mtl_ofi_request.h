@@ -94,4 +94,15 @@ struct ompi_mtl_ofi_request_t {
 };
 typedef struct ompi_mtl_ofi_request_t ompi_mtl_ofi_request_t;
 
+/**
+ * Request of a message matched by improbe. It is kept in
+ * ompi_mtl_ofi.mrecv_reqs so that matched probes do not allocate.
+ */
+struct ompi_mtl_ofi_mrecv_request_t {
+    opal_free_list_item_t super;
+    ompi_mtl_ofi_request_t ofi_req;
+};
+typedef struct ompi_mtl_ofi_mrecv_request_t ompi_mtl_ofi_mrecv_request_t;
+OBJ_CLASS_DECLARATION(ompi_mtl_ofi_mrecv_request_t);
+
 #endif
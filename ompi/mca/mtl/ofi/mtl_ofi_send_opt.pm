@@ -20,16 +20,22 @@ sub gen_funcs {
     my $gen_file = $_[0];
     my $gen_type = $_[1];
     my $OFI_CQ_DATA_EN = "false";
+    my $OFI_INJECT_EN = "false";
+    my $OFI_HMEM_EN = "false";
 
     foreach $OFI_CQ_DATA_EN (@true_false) {
-        my @flags = ($OFI_CQ_DATA_EN);
-        if (($gen_type cmp "FUNC") == 0) {
-            my $FUNC = gen_send_function(\@flags);
-            print $gen_file "$FUNC\n\n";
-        }
-        if (($gen_type cmp "SYM") == 0) {
-            my $SYM = gen_send_sym_init(\@flags);
-            print $gen_file "$SYM\n";
+        foreach $OFI_INJECT_EN (@true_false) {
+            foreach $OFI_HMEM_EN (@true_false) {
+                my @flags = ($OFI_CQ_DATA_EN, $OFI_INJECT_EN, $OFI_HMEM_EN);
+                if (($gen_type cmp "FUNC") == 0) {
+                    my $FUNC = gen_send_function(\@flags);
+                    print $gen_file "$FUNC\n\n";
+                }
+                if (($gen_type cmp "SYM") == 0) {
+                    my $SYM = gen_send_sym_init(\@flags);
+                    print $gen_file "$SYM\n";
+                }
+            }
         }
     }
 }
@@ -38,6 +44,8 @@ sub gen_send_function {
     my @op_flags = @{$_[0]};
     my $MTL_OFI_NAME_EXT = opt_common::mtl_ofi_opt_common::gen_flags_ext(\@op_flags);
     my $OFI_CQ_DATA_EN = $op_flags[0];
+    my $OFI_INJECT_EN = $op_flags[1];
+    my $OFI_HMEM_EN = $op_flags[2];
     my $SEND_FUNCTION =
 "__opal_attribute_always_inline__ static inline int
 ompi_mtl_ofi_send_" . $MTL_OFI_NAME_EXT . "(struct mca_mtl_base_module_t *mtl,
@@ -48,10 +56,12 @@ ompi_mtl_ofi_send_" . $MTL_OFI_NAME_EXT . "(struct mca_mtl_base_module_t *mtl,
                   mca_pml_base_send_mode_t mode)
 {
     const bool OFI_CQ_DATA = " . $OFI_CQ_DATA_EN . ";
+    const bool OFI_INJECT = " . $OFI_INJECT_EN . ";
+    const bool OFI_HMEM = " . $OFI_HMEM_EN . ";
 
     return ompi_mtl_ofi_send_generic(mtl, comm, dest, tag,
                                     convertor, mode,
-                                    OFI_CQ_DATA);
+                                    OFI_CQ_DATA, OFI_INJECT, OFI_HMEM);
 }";
     return $SEND_FUNCTION;
 }
@@ -60,9 +70,11 @@ sub gen_send_sym_init {
     my @op_flags = @{$_[0]};
     my $MTL_OFI_FUNC_NAME = "ompi_mtl_ofi_send_" . opt_common::mtl_ofi_opt_common::gen_flags_ext(\@op_flags) . "";
     my $OFI_CQ_DATA_EN = $op_flags[0];
+    my $OFI_INJECT_EN = $op_flags[1];
+    my $OFI_HMEM_EN = $op_flags[2];
     my $symbol_init =
 "
-    sym_table->ompi_mtl_ofi_send[".$OFI_CQ_DATA_EN."]
+    sym_table->ompi_mtl_ofi_send[".$OFI_CQ_DATA_EN."][".$OFI_INJECT_EN."][".$OFI_HMEM_EN."]
         = ".$MTL_OFI_FUNC_NAME.";
 ";
     return $symbol_init;
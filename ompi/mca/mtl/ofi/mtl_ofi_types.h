@@ -44,6 +44,12 @@ typedef struct mca_mtl_ofi_module_t {
     /** Address vector handle */
     struct fid_av *av;
 
+    /** Insert the peer addresses in the AV on first use instead of in add_procs */
+    bool lazy_av;
+
+    /** Serializes the lazy AV inserts */
+    opal_mutex_t av_lock;
+
     /* Multi-threaded Application flag */
     bool mpi_thread_multiple;
 
@@ -79,6 +85,12 @@ typedef struct mca_mtl_ofi_module_t {
     /** Use FI_REMOTE_CQ_DATA*/
     bool fi_cq_data;
 
+    /** Provider can inject small messages (max_inject_size > 0) */
+    bool fi_inject;
+
+    /** Device buffers may be passed to the provider (FI_HMEM) */
+    bool hmem;
+
     /** Info used to create the OFI tag **/
     unsigned long long source_rank_tag_mask;
     int num_bits_source_rank;
@@ -95,6 +107,9 @@ typedef struct mca_mtl_ofi_module_t {
     /** Optimized function Symbol Tables **/
     struct ompi_mtl_ofi_symtable sym_table;
 
+    /** Requests of the messages matched by improbe, until imrecv completes */
+    opal_free_list_t mrecv_reqs;
+
 } mca_mtl_ofi_module_t;
 
 extern mca_mtl_ofi_module_t ompi_mtl_ofi;
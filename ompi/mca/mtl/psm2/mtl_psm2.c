@@ -410,15 +410,30 @@ ompi_mtl_psm2_del_comm(struct mca_mtl_base_module_t *mtl,
 }
 
 
+/*
+ * Only one thread polls the mq at a time and completes the requests of
+ * all the threads: the others return instead of waiting for the lock.
+ */
 int ompi_mtl_psm2_progress( void ) {
+    static int idle_calls = 0;
     psm2_error_t err;
     mca_mtl_psm2_request_t* mtl_psm2_request;
     psm2_mq_status2_t psm2_status;
     psm2_mq_req_t req;
     int completed = 0;
 
+    if (0 == ompi_mtl_psm2.outstanding && 1 < ompi_mtl_psm2.progress_idle_interval) {
+        /* nothing to complete, still let psm2 progress from time to time */
+        if (++idle_calls < ompi_mtl_psm2.progress_idle_interval) {
+            return 0;
+        }
+        idle_calls = 0;
+    }
+
     do {
-        OPAL_THREAD_LOCK(&mtl_psm2_mq_mutex);
+        if (OPAL_THREAD_TRYLOCK(&mtl_psm2_mq_mutex)) {
+            return completed;
+        }
         err = psm2_mq_ipeek2(ompi_mtl_psm2.mq, &req, NULL);
         if (err == PSM2_MQ_INCOMPLETE) {
             OPAL_THREAD_UNLOCK(&mtl_psm2_mq_mutex);
@@ -436,6 +451,7 @@ int ompi_mtl_psm2_progress( void ) {
         }
 
         completed++;
+        OPAL_THREAD_ADD_FETCH32(&ompi_mtl_psm2.outstanding, -1);
 
         mtl_psm2_request = (mca_mtl_psm2_request_t*) psm2_status.context;
 
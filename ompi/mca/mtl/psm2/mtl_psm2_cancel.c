@@ -41,6 +41,7 @@ int ompi_mtl_psm2_cancel(struct mca_mtl_base_module_t* mtl,
   if(PSM2_OK == err) {
     err = psm2_mq_test(&mtl_psm2_request->psm2_request, &status);
     if(PSM2_OK == err) {
+      OPAL_THREAD_ADD_FETCH32(&ompi_mtl_psm2.outstanding, -1);
       mtl_request->ompi_req->req_status._cancelled = true;
       mtl_psm2_request->super.completion_callback(&mtl_psm2_request->super);
       return OMPI_SUCCESS;
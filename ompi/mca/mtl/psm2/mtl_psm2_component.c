@@ -241,6 +241,17 @@ ompi_mtl_psm2_component_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &ompi_mtl_psm2.connect_timeout);
 
+    ompi_mtl_psm2.progress_idle_interval = 1;
+    (void) mca_base_component_var_register(&mca_mtl_psm2_component.super.mtl_version,
+                                           "progress_idle_interval",
+                                           "When no send or receive is outstanding, only poll "
+                                           "the PSM2 matched queue once every this many calls to "
+                                           "progress (1: poll on every call)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_mtl_psm2.progress_idle_interval);
+
 
     (void) get_num_local_procs(&num_local_procs);
     (void) get_num_total_procs(&num_total_procs);
@@ -83,6 +83,7 @@ ompi_mtl_psm2_irecv(struct mca_mtl_base_module_t* mtl,
       return OMPI_ERROR;
     }
 
+    OPAL_THREAD_ADD_FETCH32(&ompi_mtl_psm2.outstanding, 1);
     return OMPI_SUCCESS;
 }
 
@@ -133,6 +134,7 @@ ompi_mtl_psm2_imrecv(struct mca_mtl_base_module_t* mtl,
       return OMPI_ERROR;
     }
 
+    OPAL_THREAD_ADD_FETCH32(&ompi_mtl_psm2.outstanding, 1);
     *message = MPI_MESSAGE_NULL;
     return OMPI_SUCCESS;
 }
@@ -138,6 +138,10 @@ ompi_mtl_psm2_isend(struct mca_mtl_base_module_t* mtl,
 			     length,
 			     mtl_psm2_request,
 			     &mtl_psm2_request->psm2_request);
+    if (OPAL_UNLIKELY(PSM2_OK != psm2_error)) {
+        return OMPI_ERROR;
+    }
 
-    return psm2_error == PSM2_OK ? OMPI_SUCCESS : OMPI_ERROR;
+    OPAL_THREAD_ADD_FETCH32(&ompi_mtl_psm2.outstanding, 1);
+    return OMPI_SUCCESS;
 }
@@ -61,6 +61,12 @@ struct mca_mtl_psm2_module_t {
     bool psm2_recvthread;
     bool psm2_shared_contexts;
     unsigned long psm2_opa_sl;
+
+    /* requests posted to the mq and not completed yet */
+    opal_atomic_int32_t outstanding;
+    /* poll the mq once every progress_idle_interval calls when no
+     * request is outstanding */
+    int progress_idle_interval;
 };
 
 typedef struct mca_mtl_psm2_module_t mca_mtl_psm2_module_t;
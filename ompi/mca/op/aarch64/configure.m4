@@ -0,0 +1,116 @@
+# -*- shell-script -*-
+#
+# Copyright (c) 2021      The University of Tennessee and The University
+#                         of Tennessee Research Foundation.  All rights
+#                         reserved.
+#
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# MCA_ompi_op_aarch64_CONFIG([action-if-can-compile],
+#                            [action-if-cant-compile])
+# ------------------------------------------------
+# We can build on AArch64 when the compiler provides the NEON intrinsics.
+AC_DEFUN([MCA_ompi_op_aarch64_CONFIG],[
+    AC_CONFIG_FILES([ompi/mca/op/aarch64/Makefile])
+
+    MCA_BUILD_OP_NEON_FLAGS=""
+    MCA_BUILD_OP_SVE_FLAGS=""
+    op_neon_support=0
+    op_sve_support=0
+
+    AS_VAR_PUSHDEF([op_aarch64_check_sve], [ompi_cv_op_aarch64_check_sve])
+
+    OPAL_VAR_SCOPE_PUSH([op_aarch64_cflags_save])
+
+    AS_IF([test "$opal_cv_asm_arch" = "ARM64"],
+          [AC_LANG_PUSH([C])
+
+           #
+           # NEON is part of the base AArch64 architecture
+           #
+           AC_MSG_CHECKING([for NEON support])
+           AC_LINK_IFELSE(
+               [AC_LANG_PROGRAM([[#include <arm_neon.h>]],
+                                [[
+#if !defined(__ARM_NEON)
+#error "the compiler does not generate NEON code"
+#endif
+    float32x4_t vA = vdupq_n_f32(1.0f), vB = vdupq_n_f32(2.0f);
+    float16x4_t vH = vcvt_f16_f32(vaddq_f32(vA, vB));
+    (void)vcvt_f32_f16(vH)
+                                ]])],
+               [op_neon_support=1
+                AC_MSG_RESULT([yes])],
+               [AC_MSG_RESULT([no])])
+
+           #
+           # Check for SVE support, first without then with the -march flag
+           #
+           AC_CACHE_CHECK([for SVE support], op_aarch64_check_sve, AS_VAR_SET(op_aarch64_check_sve, yes))
+           AS_IF([test "$op_aarch64_check_sve" = "yes"],
+                 [AC_MSG_CHECKING([for SVE support (no additional flags)])
+                  AC_LINK_IFELSE(
+                      [AC_LANG_PROGRAM([[#include <arm_sve.h>]],
+                                       [[
+#if !defined(__ARM_FEATURE_SVE)
+#error "the compiler does not generate SVE code"
+#endif
+    svbool_t pg = svwhilelt_b32_s64(0, 3);
+    svfloat32_t vA = svdup_n_f32(1.0f);
+    (void)svptest_any(svptrue_b32(), pg);
+    (void)svadd_f32_x(pg, vA, vA)
+                                       ]])],
+                      [op_sve_support=1
+                       AC_MSG_RESULT([yes])],
+                      [AC_MSG_RESULT([no])])
+                  AS_IF([test $op_sve_support -eq 0],
+                        [AC_MSG_CHECKING([for SVE support (with -march=armv8.2-a+sve)])
+                         op_aarch64_cflags_save="$CFLAGS"
+                         CFLAGS="$CFLAGS -march=armv8.2-a+sve"
+                         AC_LINK_IFELSE(
+                             [AC_LANG_PROGRAM([[#include <arm_sve.h>]],
+                                              [[
+#if !defined(__ARM_FEATURE_SVE)
+#error "the compiler does not generate SVE code"
+#endif
+    svbool_t pg = svwhilelt_b32_s64(0, 3);
+    svfloat32_t vA = svdup_n_f32(1.0f);
+    (void)svptest_any(svptrue_b32(), pg);
+    (void)svadd_f32_x(pg, vA, vA)
+                                              ]])],
+                             [op_sve_support=1
+                              MCA_BUILD_OP_SVE_FLAGS="-march=armv8.2-a+sve"
+                              AC_MSG_RESULT([yes])],
+                             [AC_MSG_RESULT([no])])
+                         CFLAGS="$op_aarch64_cflags_save"
+                        ])])
+
+           AC_LANG_POP([C])
+          ])
+    AC_DEFINE_UNQUOTED([OMPI_MCA_OP_HAVE_NEON],
+                       [$op_neon_support],
+                       [NEON supported in the current build])
+    AC_DEFINE_UNQUOTED([OMPI_MCA_OP_HAVE_SVE],
+                       [$op_sve_support],
+                       [SVE supported in the current build])
+    AM_CONDITIONAL([MCA_BUILD_ompi_op_has_neon_support],
+                   [test "$op_neon_support" == "1"])
+    AM_CONDITIONAL([MCA_BUILD_ompi_op_has_sve_support],
+                   [test "$op_sve_support" == "1"])
+    AC_SUBST(MCA_BUILD_OP_NEON_FLAGS)
+    AC_SUBST(MCA_BUILD_OP_SVE_FLAGS)
+
+    AS_VAR_POPDEF([op_aarch64_check_sve])
+
+    OPAL_VAR_SCOPE_POP
+    # Enable this component iff we have at least NEON
+    AS_IF([test $op_neon_support -eq 1],
+          [$1],
+          [$2])
+
+])dnl
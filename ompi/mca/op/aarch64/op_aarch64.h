@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_OP_AARCH64_EXPORT_H
+#define MCA_OP_AARCH64_EXPORT_H
+
+#include "ompi_config.h"
+
+#include "ompi/mca/mca.h"
+#include "opal/class/opal_object.h"
+
+#include "ompi/mca/op/op.h"
+
+BEGIN_C_DECLS
+
+#define OMPI_OP_AARCH64_HAS_SVE_FLAG   0x00000002
+#define OMPI_OP_AARCH64_HAS_NEON_FLAG  0x00000001
+
+/**
+ * Derive a struct from the base op component struct, allowing us to
+ * cache some component-specific information on our well-known
+ * component struct.
+ */
+typedef struct {
+    /** The base op component struct */
+    ompi_op_base_component_1_0_0_t super;
+
+    uint32_t supported; /* vector extensions supported by the environment */
+    uint32_t flags; /* vector extensions requested by this process */
+    size_t parallel_min_size; /* opm_parallel_min_size of the modules */
+} ompi_op_aarch64_component_t;
+
+/**
+ * Globally exported variable.  Note that it is a *aarch64* component
+ * (defined above), which has the ompi_op_base_component_t as its
+ * first member.  Hence, the MCA/op framework will find the data that
+ * it expects in the first memory locations, but then the component
+ * itself can cache additional information after that that can be used
+ * by both the component and modules.
+ */
+OMPI_DECLSPEC extern ompi_op_aarch64_component_t
+    mca_op_aarch64_component;
+
+END_C_DECLS
+
+#endif /* MCA_OP_AARCH64_EXPORT_H */
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/** @file
+ *
+ * This is the "aarch64" component source code.
+ *
+ */
+
+#include "ompi_config.h"
+
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif  /* defined(__linux__) */
+
+#include "ompi/constants.h"
+#include "ompi/op/op.h"
+#include "ompi/mca/op/op.h"
+#include "ompi/mca/op/base/base.h"
+#include "ompi/mca/op/aarch64/op_aarch64.h"
+
+static int aarch64_component_open(void);
+static int aarch64_component_close(void);
+static int aarch64_component_init_query(bool enable_progress_threads,
+                                        bool enable_mpi_thread_multiple);
+static struct ompi_op_base_module_1_0_0_t *
+    aarch64_component_op_query(struct ompi_op_t *op, int *priority);
+static int aarch64_component_register(void);
+
+static mca_base_var_enum_value_flag_t aarch64_support_flags[] = {
+    { .flag = 0x001, .string = "NEON" },
+    { .flag = 0x002, .string = "SVE" },
+    { .flag = 0,     .string = NULL },
+};
+
+/*
+ * The hardware capabilities the kernel reports, see
+ * https://www.kernel.org/doc/html/latest/arm64/elf_hwcaps.html
+ */
+static uint32_t has_aarch64_features(void)
+{
+    uint32_t flags = 0;
+#if defined(__linux__)
+    const unsigned long asimd_mask = (1UL << 1);   // HWCAP_ASIMD
+    const unsigned long sve_mask   = (1UL << 22);  // HWCAP_SVE
+    unsigned long hwcap = getauxval(AT_HWCAP);
+
+    flags |= (hwcap & asimd_mask) ? OMPI_OP_AARCH64_HAS_NEON_FLAG : 0;
+    flags |= (hwcap & sve_mask)   ? OMPI_OP_AARCH64_HAS_SVE_FLAG  : 0;
+#elif defined(__ARM_NEON)
+    /* no way to ask, but every AArch64 platform we run on has the Advanced SIMD */
+    flags |= OMPI_OP_AARCH64_HAS_NEON_FLAG;
+#endif  /* defined(__linux__) */
+    return flags;
+}
+
+ompi_op_aarch64_component_t mca_op_aarch64_component = {
+    {
+        .opc_version = {
+            OMPI_OP_BASE_VERSION_1_0_0,
+
+            .mca_component_name = "aarch64",
+            MCA_BASE_MAKE_VERSION(component, OMPI_MAJOR_VERSION, OMPI_MINOR_VERSION,
+                                  OMPI_RELEASE_VERSION),
+            .mca_open_component = aarch64_component_open,
+            .mca_close_component = aarch64_component_close,
+            .mca_register_component_params = aarch64_component_register,
+        },
+        .opc_data = {
+            /* The component is checkpoint ready */
+            MCA_BASE_METADATA_PARAM_CHECKPOINT
+        },
+
+        .opc_init_query = aarch64_component_init_query,
+        .opc_op_query = aarch64_component_op_query,
+    },
+};
+
+/*
+ * Component open
+ */
+static int aarch64_component_open(void)
+{
+    /* The flags were checked during register, if they are zero either
+     * the processor is not suitable or the user disabled the support. */
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Component close
+ */
+static int aarch64_component_close(void)
+{
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Register MCA params.
+ */
+static int
+aarch64_component_register(void)
+{
+    mca_op_aarch64_component.supported =
+        mca_op_aarch64_component.flags = has_aarch64_features();
+
+    mca_base_var_enum_flag_t *new_enum_flag = NULL;
+    (void) mca_base_var_enum_create_flag("op_aarch64_support_flags",
+                                         aarch64_support_flags, &new_enum_flag);
+
+    (void) mca_base_component_var_register(&mca_op_aarch64_component.super.opc_version,
+                                           "capabilities",
+                                           "Level of NEON/SVE support available in the current environment",
+                                           MCA_BASE_VAR_TYPE_INT,
+                                           &(new_enum_flag->super), 0, 0,
+                                           OPAL_INFO_LVL_4,
+                                           MCA_BASE_VAR_SCOPE_CONSTANT,
+                                           &mca_op_aarch64_component.supported);
+
+    (void) mca_base_component_var_register(&mca_op_aarch64_component.super.opc_version,
+                                           "support",
+                                           "Level of NEON/SVE support to be used, capped by the local architecture capabilities",
+                                           MCA_BASE_VAR_TYPE_INT,
+                                           &(new_enum_flag->super), 0, 0,
+                                           OPAL_INFO_LVL_4,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_op_aarch64_component.flags);
+    OBJ_RELEASE(new_enum_flag);
+
+    mca_op_aarch64_component.flags &= mca_op_aarch64_component.supported;
+
+    /* the vector kernels saturate the bandwidth of a core sooner than the
+     * base functions, the helpers may pay off at another size */
+    mca_op_aarch64_component.parallel_min_size = ompi_op_base_parallel_min_size;
+    (void) mca_base_component_var_register(&mca_op_aarch64_component.super.opc_version,
+                                           "parallel_min_size",
+                                           "Smallest reduction, in bytes, split among the threads of op_base_parallel_threads (0: never)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_op_aarch64_component.parallel_min_size);
+
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Query whether this component wants to be used in this process.
+ */
+static int
+aarch64_component_init_query(bool enable_progress_threads,
+                             bool enable_mpi_thread_multiple)
+{
+    if( 0 == mca_op_aarch64_component.flags )
+        return OMPI_ERR_NOT_SUPPORTED;
+    return OMPI_SUCCESS;
+}
+
+#if OMPI_MCA_OP_HAVE_SVE
+ extern ompi_op_base_handler_fn_t ompi_op_aarch64_functions_sve[OMPI_OP_BASE_FORTRAN_OP_MAX][OMPI_OP_BASE_TYPE_MAX];
+ extern ompi_op_base_3buff_handler_fn_t ompi_op_aarch64_3buff_functions_sve[OMPI_OP_BASE_FORTRAN_OP_MAX][OMPI_OP_BASE_TYPE_MAX];
+#endif
+#if OMPI_MCA_OP_HAVE_NEON
+ extern ompi_op_base_handler_fn_t ompi_op_aarch64_functions_neon[OMPI_OP_BASE_FORTRAN_OP_MAX][OMPI_OP_BASE_TYPE_MAX];
+ extern ompi_op_base_3buff_handler_fn_t ompi_op_aarch64_3buff_functions_neon[OMPI_OP_BASE_FORTRAN_OP_MAX][OMPI_OP_BASE_TYPE_MAX];
+#endif
+/*
+ * Query whether this component can be used for a specific op
+ */
+static struct ompi_op_base_module_1_0_0_t*
+aarch64_component_op_query(struct ompi_op_t *op, int *priority)
+{
+    ompi_op_base_module_t *module = NULL;
+    /* Sanity check -- although the framework should never invoke the
+       _component_op_query() on non-intrinsic MPI_Op's, we'll put a
+       check here just to be sure. */
+    if (0 == (OMPI_OP_FLAGS_INTRINSIC & op->o_flags)) {
+        return NULL;
+    }
+
+    switch (op->o_f_to_c_index) {
+    case OMPI_OP_BASE_FORTRAN_MAX:
+    case OMPI_OP_BASE_FORTRAN_MIN:
+    case OMPI_OP_BASE_FORTRAN_SUM:
+    case OMPI_OP_BASE_FORTRAN_PROD:
+    case OMPI_OP_BASE_FORTRAN_BOR:
+    case OMPI_OP_BASE_FORTRAN_BAND:
+    case OMPI_OP_BASE_FORTRAN_BXOR:
+        module = OBJ_NEW(ompi_op_base_module_t);
+        module->opm_parallel_min_size = mca_op_aarch64_component.parallel_min_size;
+        for (int i = 0; i < OMPI_OP_BASE_TYPE_MAX; ++i) {
+#if OMPI_MCA_OP_HAVE_SVE
+            if( mca_op_aarch64_component.flags & OMPI_OP_AARCH64_HAS_SVE_FLAG ) {
+                module->opm_fns[i] = ompi_op_aarch64_functions_sve[op->o_f_to_c_index][i];
+                module->opm_3buff_fns[i] = ompi_op_aarch64_3buff_functions_sve[op->o_f_to_c_index][i];
+            }
+#endif
+#if OMPI_MCA_OP_HAVE_NEON
+            if( mca_op_aarch64_component.flags & OMPI_OP_AARCH64_HAS_NEON_FLAG ) {
+                if( NULL == module->opm_fns[i] ) {
+                    module->opm_fns[i] = ompi_op_aarch64_functions_neon[op->o_f_to_c_index][i];
+                }
+                if( NULL == module->opm_3buff_fns[i] ) {
+                    module->opm_3buff_fns[i] = ompi_op_aarch64_3buff_functions_neon[op->o_f_to_c_index][i];
+                }
+            }
+#endif
+            if( NULL != module->opm_fns[i] ) {
+                OBJ_RETAIN(module);
+            }
+            if( NULL != module->opm_3buff_fns[i] ) {
+                OBJ_RETAIN(module);
+            }
+        }
+        break;
+    case OMPI_OP_BASE_FORTRAN_LAND:
+    case OMPI_OP_BASE_FORTRAN_LOR:
+    case OMPI_OP_BASE_FORTRAN_LXOR:
+    case OMPI_OP_BASE_FORTRAN_MAXLOC:
+    case OMPI_OP_BASE_FORTRAN_MINLOC:
+    case OMPI_OP_BASE_FORTRAN_REPLACE:
+    default:
+        break;
+    }
+    /* If we got a module from above, we'll return it.  Otherwise,
+       we'll return NULL, indicating that this component does not want
+       to be considered for selection for this MPI_Op. */
+    if (NULL != module) {
+        *priority = 50;
+    }
+    return (ompi_op_base_module_1_0_0_t *) module;
+}
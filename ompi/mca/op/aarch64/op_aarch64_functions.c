@@ -0,0 +1,576 @@
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#include <limits.h>
+
+#include "opal/util/output.h"
+
+#include "ompi/op/op.h"
+#include "ompi/mca/op/op.h"
+#include "ompi/mca/op/base/base.h"
+#include "ompi/mca/op/aarch64/op_aarch64.h"
+
+/**
+ * This file is compiled once for each flavor, NEON (the Advanced SIMD of
+ * the base architecture) and SVE. The SVE kernels do not depend on the
+ * vector length of the processor: the loops are predicated, so there is
+ * no scalar remainder either. If the compiler flags changed after the
+ * configure step and the SVE code cannot be generated, error out as
+ * op/avx does.
+ */
+#if defined(GENERATE_SVE_CODE)
+#  if defined(__ARM_FEATURE_SVE)
+#    include <arm_sve.h>
+#    define PREPEND _sve
+#  else
+#    error The configure step has detected support for SVE but the compiler flags during make are too restrictive. Please disable the aarch64 component by adding --enable-mca-no-build=op-aarch64 to your configure step.
+#  endif  /* defined(__ARM_FEATURE_SVE) */
+#elif defined(GENERATE_NEON_CODE)
+#  if defined(__ARM_NEON)
+#    include <arm_neon.h>
+#    define PREPEND _neon
+#  else
+#    error This file should not be compiled in this conditions. Please provide the config.log file to the OMPI developers.
+#  endif  /* defined(__ARM_NEON) */
+#else
+#  error This file should not be compiled in this conditions. Please provide the config.log file to the OMPI developers.
+#endif  /* defined(GENERATE_SVE_CODE) */
+
+/*
+ * Concatenate preprocessor tokens A and B without expanding macro definitions
+ * (however, if invoked from a macro, macro arguments are expanded).
+ */
+#define OP_CONCAT_NX(A, B) A ## B
+
+/*
+ * Concatenate preprocessor tokens A and B after macro-expanding them.
+ */
+#define OP_CONCAT(A, B) OP_CONCAT_NX(A, B)
+
+/*
+ * The half precision kernels rely on opal_short_float_t being an IEEE
+ * binary16, which is the case of short float and _Float16. NEON has no
+ * half precision arithmetic in the base architecture, so it converts to
+ * single precision and rounds back to the nearest half. This gives the
+ * same bits as the correctly rounded half precision operations of SVE
+ * and of the scalar loops.
+ */
+#if defined(HAVE_OPAL_SHORT_FLOAT_T) && (2 == SIZEOF_OPAL_SHORT_FLOAT_T)
+#define OP_AARCH64_SHORT_FLOAT_KERNELS 1
+#endif
+
+/*
+ * Since all the functions in this file are essentially identical, we
+ * use a macro to substitute in names and types. The element type is
+ * the one the intrinsics use (float32_t for float, ...), the name is
+ * the one of the op/base tables.
+ *
+ * The two buffer versions do (out = out op in), the three buffer
+ * versions (out = in1 op in2).
+ */
+#if defined(GENERATE_NEON_CODE)
+
+/* NEON has no 64 bits integer max and min */
+static inline int64x2_t ompi_op_aarch64_vmaxq_s64(int64x2_t a, int64x2_t b)
+{
+    return vbslq_s64(vcgtq_s64(a, b), a, b);
+}
+
+static inline uint64x2_t ompi_op_aarch64_vmaxq_u64(uint64x2_t a, uint64x2_t b)
+{
+    return vbslq_u64(vcgtq_u64(a, b), a, b);
+}
+
+static inline int64x2_t ompi_op_aarch64_vminq_s64(int64x2_t a, int64x2_t b)
+{
+    return vbslq_s64(vcltq_s64(a, b), a, b);
+}
+
+static inline uint64x2_t ompi_op_aarch64_vminq_u64(uint64x2_t a, uint64x2_t b)
+{
+    return vbslq_u64(vcltq_u64(a, b), a, b);
+}
+
+#define OP_AARCH64_FUNC(name, type_name, type, sfx, bits, op)                  \
+static void OP_CONCAT(ompi_op_aarch64_2buff_##name##_##type_name,PREPEND)(const void *_in, void *_out, int *count, \
+                                                                          struct ompi_datatype_t **dtype, \
+                                                                          struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                              \
+    const int types_per_step = 16 / sizeof(type);                              \
+    int left_over = *count;                                                    \
+    const type *in = (const type *) _in;                                       \
+    type *out = (type *) _out;                                                 \
+    for( ; left_over >= types_per_step; left_over -= types_per_step ) {        \
+        vst1q_##sfx(out, op##_##sfx(vld1q_##sfx(out), vld1q_##sfx(in)));      \
+        in += types_per_step;                                                  \
+        out += types_per_step;                                                 \
+    }                                                                          \
+    for( int i = 0; i < left_over; ++i ) {                                     \
+        out[i] = current_func(out[i], in[i]);                                  \
+    }                                                                          \
+}                                                                              \
+static void OP_CONCAT(ompi_op_aarch64_3buff_##name##_##type_name,PREPEND)(const void *_in1, const void *_in2, \
+                                                                          void *_out, int *count, \
+                                                                          struct ompi_datatype_t **dtype, \
+                                                                          struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                              \
+    const int types_per_step = 16 / sizeof(type);                              \
+    int left_over = *count;                                                    \
+    const type *in1 = (const type *) _in1, *in2 = (const type *) _in2;         \
+    type *out = (type *) _out;                                                 \
+    for( ; left_over >= types_per_step; left_over -= types_per_step ) {        \
+        vst1q_##sfx(out, op##_##sfx(vld1q_##sfx(in1), vld1q_##sfx(in2)));     \
+        in1 += types_per_step;                                                 \
+        in2 += types_per_step;                                                 \
+        out += types_per_step;                                                 \
+    }                                                                          \
+    for( int i = 0; i < left_over; ++i ) {                                     \
+        out[i] = current_func(in1[i], in2[i]);                                 \
+    }                                                                          \
+}
+
+#define OP_AARCH64_HALF_FUNC(name, op)                                         \
+static void OP_CONCAT(ompi_op_aarch64_2buff_##name##_short_float,PREPEND)(const void *_in, void *_out, int *count, \
+                                                                          struct ompi_datatype_t **dtype, \
+                                                                          struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                              \
+    int left_over = *count;                                                    \
+    const float16_t *in = (const float16_t *) _in;                             \
+    float16_t *out = (float16_t *) _out;                                       \
+    for( ; left_over >= 8; left_over -= 8 ) {                                  \
+        float16x8_t vecA = vld1q_f16(in), vecB = vld1q_f16(out);               \
+        float32x4_t lo = op##_f32(vcvt_f32_f16(vget_low_f16(vecB)), vcvt_f32_f16(vget_low_f16(vecA))); \
+        float32x4_t hi = op##_f32(vcvt_high_f32_f16(vecB), vcvt_high_f32_f16(vecA)); \
+        vst1q_f16(out, vcvt_high_f16_f32(vcvt_f16_f32(lo), hi));               \
+        in += 8;                                                               \
+        out += 8;                                                              \
+    }                                                                          \
+    for( int i = 0; i < left_over; ++i ) {                                     \
+        out[i] = current_func(out[i], in[i]);                                  \
+    }                                                                          \
+}                                                                              \
+static void OP_CONCAT(ompi_op_aarch64_3buff_##name##_short_float,PREPEND)(const void *_in1, const void *_in2, \
+                                                                          void *_out, int *count, \
+                                                                          struct ompi_datatype_t **dtype, \
+                                                                          struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                              \
+    int left_over = *count;                                                    \
+    const float16_t *in1 = (const float16_t *) _in1, *in2 = (const float16_t *) _in2; \
+    float16_t *out = (float16_t *) _out;                                       \
+    for( ; left_over >= 8; left_over -= 8 ) {                                  \
+        float16x8_t vecA = vld1q_f16(in1), vecB = vld1q_f16(in2);              \
+        float32x4_t lo = op##_f32(vcvt_f32_f16(vget_low_f16(vecA)), vcvt_f32_f16(vget_low_f16(vecB))); \
+        float32x4_t hi = op##_f32(vcvt_high_f32_f16(vecA), vcvt_high_f32_f16(vecB)); \
+        vst1q_f16(out, vcvt_high_f16_f32(vcvt_f16_f32(lo), hi));               \
+        in1 += 8;                                                              \
+        in2 += 8;                                                              \
+        out += 8;                                                              \
+    }                                                                          \
+    for( int i = 0; i < left_over; ++i ) {                                     \
+        out[i] = current_func(in1[i], in2[i]);                                 \
+    }                                                                          \
+}
+
+#define OP_NEON_OR_SVE(neon, sve) neon
+
+#elif defined(GENERATE_SVE_CODE)
+
+#define OP_AARCH64_FUNC(name, type_name, type, sfx, bits, op)                  \
+static void OP_CONCAT(ompi_op_aarch64_2buff_##name##_##type_name,PREPEND)(const void *_in, void *_out, int *count, \
+                                                                          struct ompi_datatype_t **dtype, \
+                                                                          struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                              \
+    const int64_t n = *count;                                                  \
+    const int64_t step = (int64_t) svcntp_b##bits(svptrue_b##bits(), svptrue_b##bits()); \
+    const type *in = (const type *) _in;                                       \
+    type *out = (type *) _out;                                                 \
+    int64_t i = 0;                                                             \
+    svbool_t pg = svwhilelt_b##bits##_s64(i, n);                               \
+    while( svptest_any(svptrue_b##bits(), pg) ) {                              \
+        svst1_##sfx(pg, out + i, op##_##sfx##_x(pg, svld1_##sfx(pg, out + i), svld1_##sfx(pg, in + i))); \
+        i += step;                                                             \
+        pg = svwhilelt_b##bits##_s64(i, n);                                    \
+    }                                                                          \
+}                                                                              \
+static void OP_CONCAT(ompi_op_aarch64_3buff_##name##_##type_name,PREPEND)(const void *_in1, const void *_in2, \
+                                                                          void *_out, int *count, \
+                                                                          struct ompi_datatype_t **dtype, \
+                                                                          struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                              \
+    const int64_t n = *count;                                                  \
+    const int64_t step = (int64_t) svcntp_b##bits(svptrue_b##bits(), svptrue_b##bits()); \
+    const type *in1 = (const type *) _in1, *in2 = (const type *) _in2;         \
+    type *out = (type *) _out;                                                 \
+    int64_t i = 0;                                                             \
+    svbool_t pg = svwhilelt_b##bits##_s64(i, n);                               \
+    while( svptest_any(svptrue_b##bits(), pg) ) {                              \
+        svst1_##sfx(pg, out + i, op##_##sfx##_x(pg, svld1_##sfx(pg, in1 + i), svld1_##sfx(pg, in2 + i))); \
+        i += step;                                                             \
+        pg = svwhilelt_b##bits##_s64(i, n);                                    \
+    }                                                                          \
+}
+
+/* SVE has the half precision arithmetic */
+#define OP_AARCH64_HALF_FUNC(name, op) \
+    OP_AARCH64_FUNC(name, short_float, float16_t, f16, 16, op)
+
+#define OP_NEON_OR_SVE(neon, sve) sve
+
+#endif  /* defined(GENERATE_NEON_CODE) */
+
+/*************************************************************************
+ * Max
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) > (b) ? (a) : (b))
+    OP_AARCH64_FUNC(max, int8_t,     int8_t,  s8,  8, OP_NEON_OR_SVE(vmaxq, svmax))
+    OP_AARCH64_FUNC(max, uint8_t,   uint8_t,  u8,  8, OP_NEON_OR_SVE(vmaxq, svmax))
+    OP_AARCH64_FUNC(max, int16_t,   int16_t, s16, 16, OP_NEON_OR_SVE(vmaxq, svmax))
+    OP_AARCH64_FUNC(max, uint16_t, uint16_t, u16, 16, OP_NEON_OR_SVE(vmaxq, svmax))
+    OP_AARCH64_FUNC(max, int32_t,   int32_t, s32, 32, OP_NEON_OR_SVE(vmaxq, svmax))
+    OP_AARCH64_FUNC(max, uint32_t, uint32_t, u32, 32, OP_NEON_OR_SVE(vmaxq, svmax))
+    OP_AARCH64_FUNC(max, int64_t,   int64_t, s64, 64, OP_NEON_OR_SVE(ompi_op_aarch64_vmaxq, svmax))
+    OP_AARCH64_FUNC(max, uint64_t, uint64_t, u64, 64, OP_NEON_OR_SVE(ompi_op_aarch64_vmaxq, svmax))
+
+    /* Floating point */
+    OP_AARCH64_FUNC(max, float,   float32_t, f32, 32, OP_NEON_OR_SVE(vmaxq, svmax))
+    OP_AARCH64_FUNC(max, double,  float64_t, f64, 64, OP_NEON_OR_SVE(vmaxq, svmax))
+#if defined(OP_AARCH64_SHORT_FLOAT_KERNELS)
+    OP_AARCH64_HALF_FUNC(max, OP_NEON_OR_SVE(vmaxq, svmax))
+#endif
+
+/*************************************************************************
+ * Min
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) < (b) ? (a) : (b))
+    OP_AARCH64_FUNC(min, int8_t,     int8_t,  s8,  8, OP_NEON_OR_SVE(vminq, svmin))
+    OP_AARCH64_FUNC(min, uint8_t,   uint8_t,  u8,  8, OP_NEON_OR_SVE(vminq, svmin))
+    OP_AARCH64_FUNC(min, int16_t,   int16_t, s16, 16, OP_NEON_OR_SVE(vminq, svmin))
+    OP_AARCH64_FUNC(min, uint16_t, uint16_t, u16, 16, OP_NEON_OR_SVE(vminq, svmin))
+    OP_AARCH64_FUNC(min, int32_t,   int32_t, s32, 32, OP_NEON_OR_SVE(vminq, svmin))
+    OP_AARCH64_FUNC(min, uint32_t, uint32_t, u32, 32, OP_NEON_OR_SVE(vminq, svmin))
+    OP_AARCH64_FUNC(min, int64_t,   int64_t, s64, 64, OP_NEON_OR_SVE(ompi_op_aarch64_vminq, svmin))
+    OP_AARCH64_FUNC(min, uint64_t, uint64_t, u64, 64, OP_NEON_OR_SVE(ompi_op_aarch64_vminq, svmin))
+
+    /* Floating point */
+    OP_AARCH64_FUNC(min, float,   float32_t, f32, 32, OP_NEON_OR_SVE(vminq, svmin))
+    OP_AARCH64_FUNC(min, double,  float64_t, f64, 64, OP_NEON_OR_SVE(vminq, svmin))
+#if defined(OP_AARCH64_SHORT_FLOAT_KERNELS)
+    OP_AARCH64_HALF_FUNC(min, OP_NEON_OR_SVE(vminq, svmin))
+#endif
+
+/*************************************************************************
+ * Sum
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) + (b))
+    OP_AARCH64_FUNC(sum, int8_t,     int8_t,  s8,  8, OP_NEON_OR_SVE(vaddq, svadd))
+    OP_AARCH64_FUNC(sum, uint8_t,   uint8_t,  u8,  8, OP_NEON_OR_SVE(vaddq, svadd))
+    OP_AARCH64_FUNC(sum, int16_t,   int16_t, s16, 16, OP_NEON_OR_SVE(vaddq, svadd))
+    OP_AARCH64_FUNC(sum, uint16_t, uint16_t, u16, 16, OP_NEON_OR_SVE(vaddq, svadd))
+    OP_AARCH64_FUNC(sum, int32_t,   int32_t, s32, 32, OP_NEON_OR_SVE(vaddq, svadd))
+    OP_AARCH64_FUNC(sum, uint32_t, uint32_t, u32, 32, OP_NEON_OR_SVE(vaddq, svadd))
+    OP_AARCH64_FUNC(sum, int64_t,   int64_t, s64, 64, OP_NEON_OR_SVE(vaddq, svadd))
+    OP_AARCH64_FUNC(sum, uint64_t, uint64_t, u64, 64, OP_NEON_OR_SVE(vaddq, svadd))
+
+    /* Floating point */
+    OP_AARCH64_FUNC(sum, float,   float32_t, f32, 32, OP_NEON_OR_SVE(vaddq, svadd))
+    OP_AARCH64_FUNC(sum, double,  float64_t, f64, 64, OP_NEON_OR_SVE(vaddq, svadd))
+#if defined(OP_AARCH64_SHORT_FLOAT_KERNELS)
+    OP_AARCH64_HALF_FUNC(sum, OP_NEON_OR_SVE(vaddq, svadd))
+#endif
+
+/*************************************************************************
+ * Product
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) * (b))
+    OP_AARCH64_FUNC(prod, int8_t,     int8_t,  s8,  8, OP_NEON_OR_SVE(vmulq, svmul))
+    OP_AARCH64_FUNC(prod, uint8_t,   uint8_t,  u8,  8, OP_NEON_OR_SVE(vmulq, svmul))
+    OP_AARCH64_FUNC(prod, int16_t,   int16_t, s16, 16, OP_NEON_OR_SVE(vmulq, svmul))
+    OP_AARCH64_FUNC(prod, uint16_t, uint16_t, u16, 16, OP_NEON_OR_SVE(vmulq, svmul))
+    OP_AARCH64_FUNC(prod, int32_t,   int32_t, s32, 32, OP_NEON_OR_SVE(vmulq, svmul))
+    OP_AARCH64_FUNC(prod, uint32_t, uint32_t, u32, 32, OP_NEON_OR_SVE(vmulq, svmul))
+#if defined(GENERATE_SVE_CODE)
+    /* NEON has no 64 bits integer multiply */
+    OP_AARCH64_FUNC(prod, int64_t,   int64_t, s64, 64, svmul)
+    OP_AARCH64_FUNC(prod, uint64_t, uint64_t, u64, 64, svmul)
+#endif
+
+    /* Floating point */
+    OP_AARCH64_FUNC(prod, float,   float32_t, f32, 32, OP_NEON_OR_SVE(vmulq, svmul))
+    OP_AARCH64_FUNC(prod, double,  float64_t, f64, 64, OP_NEON_OR_SVE(vmulq, svmul))
+#if defined(OP_AARCH64_SHORT_FLOAT_KERNELS)
+    OP_AARCH64_HALF_FUNC(prod, OP_NEON_OR_SVE(vmulq, svmul))
+#endif
+
+/*************************************************************************
+ * Bitwise AND
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) & (b))
+    OP_AARCH64_FUNC(band, int8_t,     int8_t,  s8,  8, OP_NEON_OR_SVE(vandq, svand))
+    OP_AARCH64_FUNC(band, uint8_t,   uint8_t,  u8,  8, OP_NEON_OR_SVE(vandq, svand))
+    OP_AARCH64_FUNC(band, int16_t,   int16_t, s16, 16, OP_NEON_OR_SVE(vandq, svand))
+    OP_AARCH64_FUNC(band, uint16_t, uint16_t, u16, 16, OP_NEON_OR_SVE(vandq, svand))
+    OP_AARCH64_FUNC(band, int32_t,   int32_t, s32, 32, OP_NEON_OR_SVE(vandq, svand))
+    OP_AARCH64_FUNC(band, uint32_t, uint32_t, u32, 32, OP_NEON_OR_SVE(vandq, svand))
+    OP_AARCH64_FUNC(band, int64_t,   int64_t, s64, 64, OP_NEON_OR_SVE(vandq, svand))
+    OP_AARCH64_FUNC(band, uint64_t, uint64_t, u64, 64, OP_NEON_OR_SVE(vandq, svand))
+
+/*************************************************************************
+ * Bitwise OR
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) | (b))
+    OP_AARCH64_FUNC(bor, int8_t,     int8_t,  s8,  8, OP_NEON_OR_SVE(vorrq, svorr))
+    OP_AARCH64_FUNC(bor, uint8_t,   uint8_t,  u8,  8, OP_NEON_OR_SVE(vorrq, svorr))
+    OP_AARCH64_FUNC(bor, int16_t,   int16_t, s16, 16, OP_NEON_OR_SVE(vorrq, svorr))
+    OP_AARCH64_FUNC(bor, uint16_t, uint16_t, u16, 16, OP_NEON_OR_SVE(vorrq, svorr))
+    OP_AARCH64_FUNC(bor, int32_t,   int32_t, s32, 32, OP_NEON_OR_SVE(vorrq, svorr))
+    OP_AARCH64_FUNC(bor, uint32_t, uint32_t, u32, 32, OP_NEON_OR_SVE(vorrq, svorr))
+    OP_AARCH64_FUNC(bor, int64_t,   int64_t, s64, 64, OP_NEON_OR_SVE(vorrq, svorr))
+    OP_AARCH64_FUNC(bor, uint64_t, uint64_t, u64, 64, OP_NEON_OR_SVE(vorrq, svorr))
+
+/*************************************************************************
+ * Bitwise XOR
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) ^ (b))
+    OP_AARCH64_FUNC(bxor, int8_t,     int8_t,  s8,  8, OP_NEON_OR_SVE(veorq, sveor))
+    OP_AARCH64_FUNC(bxor, uint8_t,   uint8_t,  u8,  8, OP_NEON_OR_SVE(veorq, sveor))
+    OP_AARCH64_FUNC(bxor, int16_t,   int16_t, s16, 16, OP_NEON_OR_SVE(veorq, sveor))
+    OP_AARCH64_FUNC(bxor, uint16_t, uint16_t, u16, 16, OP_NEON_OR_SVE(veorq, sveor))
+    OP_AARCH64_FUNC(bxor, int32_t,   int32_t, s32, 32, OP_NEON_OR_SVE(veorq, sveor))
+    OP_AARCH64_FUNC(bxor, uint32_t, uint32_t, u32, 32, OP_NEON_OR_SVE(veorq, sveor))
+    OP_AARCH64_FUNC(bxor, int64_t,   int64_t, s64, 64, OP_NEON_OR_SVE(veorq, sveor))
+    OP_AARCH64_FUNC(bxor, uint64_t, uint64_t, u64, 64, OP_NEON_OR_SVE(veorq, sveor))
+
+/*************************************************************************
+ * Complex sum
+ *
+ * The sum of two complex is the sum of their real and imaginary parts,
+ * so the real kernels do it on twice the count. The count is split to
+ * not overflow the int.
+ *************************************************************************/
+#define OP_AARCH64_COMPLEX_SUM_FUNC(type_name, type, real_name)               \
+static void OP_CONCAT(ompi_op_aarch64_2buff_sum_##type_name,PREPEND)(const void *_in, void *_out, int *count, \
+                                                                     struct ompi_datatype_t **dtype, \
+                                                                     struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                             \
+    const type *in = (const type *) _in;                                      \
+    type *out = (type *) _out;                                                \
+    int left_over = *count;                                                   \
+    while( left_over > 0 ) {                                                  \
+        int how_much = (left_over > INT_MAX / 2) ? INT_MAX / 2 : left_over;   \
+        int n = 2 * how_much;                                                 \
+        OP_CONCAT(ompi_op_aarch64_2buff_sum_##real_name,PREPEND)(in, out, &n, dtype, module); \
+        left_over -= how_much;                                                \
+        in += n;                                                              \
+        out += n;                                                             \
+    }                                                                         \
+}                                                                             \
+static void OP_CONCAT(ompi_op_aarch64_3buff_sum_##type_name,PREPEND)(const void *_in1, const void *_in2, \
+                                                                     void *_out, int *count, \
+                                                                     struct ompi_datatype_t **dtype, \
+                                                                     struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                             \
+    const type *in1 = (const type *) _in1, *in2 = (const type *) _in2;        \
+    type *out = (type *) _out;                                                \
+    int left_over = *count;                                                   \
+    while( left_over > 0 ) {                                                  \
+        int how_much = (left_over > INT_MAX / 2) ? INT_MAX / 2 : left_over;   \
+        int n = 2 * how_much;                                                 \
+        OP_CONCAT(ompi_op_aarch64_3buff_sum_##real_name,PREPEND)(in1, in2, out, &n, dtype, module); \
+        left_over -= how_much;                                                \
+        in1 += n;                                                             \
+        in2 += n;                                                             \
+        out += n;                                                             \
+    }                                                                         \
+}
+
+    OP_AARCH64_COMPLEX_SUM_FUNC(c_float_complex, float, float)
+    OP_AARCH64_COMPLEX_SUM_FUNC(c_double_complex, double, double)
+#if defined(OP_AARCH64_SHORT_FLOAT_KERNELS)
+    OP_AARCH64_COMPLEX_SUM_FUNC(c_short_float_complex, opal_short_float_t, short_float)
+#endif
+
+/** C integer ***********************************************************/
+#define C_INTEGER_8_16_32(name, ftype)                                                            \
+    [OMPI_OP_BASE_TYPE_INT8_T]   = OP_CONCAT(ompi_op_aarch64_##ftype##_##name##_int8_t,PREPEND),   \
+    [OMPI_OP_BASE_TYPE_UINT8_T]  = OP_CONCAT(ompi_op_aarch64_##ftype##_##name##_uint8_t,PREPEND),  \
+    [OMPI_OP_BASE_TYPE_INT16_T]  = OP_CONCAT(ompi_op_aarch64_##ftype##_##name##_int16_t,PREPEND),  \
+    [OMPI_OP_BASE_TYPE_UINT16_T] = OP_CONCAT(ompi_op_aarch64_##ftype##_##name##_uint16_t,PREPEND), \
+    [OMPI_OP_BASE_TYPE_INT32_T]  = OP_CONCAT(ompi_op_aarch64_##ftype##_##name##_int32_t,PREPEND),  \
+    [OMPI_OP_BASE_TYPE_UINT32_T] = OP_CONCAT(ompi_op_aarch64_##ftype##_##name##_uint32_t,PREPEND)
+
+#define C_INTEGER(name, ftype)                                                                    \
+    C_INTEGER_8_16_32(name, ftype),                                                               \
+    [OMPI_OP_BASE_TYPE_INT64_T]  = OP_CONCAT(ompi_op_aarch64_##ftype##_##name##_int64_t,PREPEND),  \
+    [OMPI_OP_BASE_TYPE_UINT64_T] = OP_CONCAT(ompi_op_aarch64_##ftype##_##name##_uint64_t,PREPEND)
+
+#if defined(GENERATE_SVE_CODE)
+#define C_INTEGER_PROD(ftype) C_INTEGER(prod, ftype)
+#else
+#define C_INTEGER_PROD(ftype) C_INTEGER_8_16_32(prod, ftype)
+#endif
+
+/** Floating point ******************************************************/
+#if defined(OP_AARCH64_SHORT_FLOAT_KERNELS)
+#define SHORT_FLOAT(name, ftype) OP_CONCAT(ompi_op_aarch64_##ftype##_##name##_short_float,PREPEND)
+#define C_SHORT_FLOAT_COMPLEX(name, ftype) OP_CONCAT(ompi_op_aarch64_##ftype##_##name##_c_short_float_complex,PREPEND)
+#else
+#define SHORT_FLOAT(name, ftype) NULL
+#define C_SHORT_FLOAT_COMPLEX(name, ftype) NULL
+#endif  /* defined(OP_AARCH64_SHORT_FLOAT_KERNELS) */
+
+#define FLOATING_POINT(name, ftype)                                                               \
+    [OMPI_OP_BASE_TYPE_SHORT_FLOAT] = SHORT_FLOAT(name, ftype),                                   \
+    [OMPI_OP_BASE_TYPE_FLOAT] = OP_CONCAT(ompi_op_aarch64_##ftype##_##name##_float,PREPEND),      \
+    [OMPI_OP_BASE_TYPE_DOUBLE] = OP_CONCAT(ompi_op_aarch64_##ftype##_##name##_double,PREPEND)
+
+/** Complex *************************************************************/
+#define COMPLEX_SUM(ftype)                                                                        \
+    [OMPI_OP_BASE_TYPE_C_SHORT_FLOAT_COMPLEX] = C_SHORT_FLOAT_COMPLEX(sum, ftype),                \
+    [OMPI_OP_BASE_TYPE_C_FLOAT_COMPLEX] = OP_CONCAT(ompi_op_aarch64_##ftype##_sum_c_float_complex,PREPEND), \
+    [OMPI_OP_BASE_TYPE_C_DOUBLE_COMPLEX] = OP_CONCAT(ompi_op_aarch64_##ftype##_sum_c_double_complex,PREPEND)
+
+ompi_op_base_handler_fn_t OP_CONCAT(ompi_op_aarch64_functions, PREPEND)[OMPI_OP_BASE_FORTRAN_OP_MAX][OMPI_OP_BASE_TYPE_MAX] =
+{
+    /* Corresponds to MPI_OP_NULL */
+    [OMPI_OP_BASE_FORTRAN_NULL] = {
+        /* Leaving this empty puts in NULL for all entries */
+        NULL,
+    },
+    /* Corresponds to MPI_MAX */
+    [OMPI_OP_BASE_FORTRAN_MAX] = {
+        C_INTEGER(max, 2buff),
+        FLOATING_POINT(max, 2buff),
+    },
+    /* Corresponds to MPI_MIN */
+    [OMPI_OP_BASE_FORTRAN_MIN] = {
+        C_INTEGER(min, 2buff),
+        FLOATING_POINT(min, 2buff),
+    },
+    /* Corresponds to MPI_SUM */
+    [OMPI_OP_BASE_FORTRAN_SUM] = {
+        C_INTEGER(sum, 2buff),
+        FLOATING_POINT(sum, 2buff),
+        COMPLEX_SUM(2buff),
+    },
+    /* Corresponds to MPI_PROD */
+    [OMPI_OP_BASE_FORTRAN_PROD] = {
+        C_INTEGER_PROD(2buff),
+        FLOATING_POINT(prod, 2buff),
+    },
+    /* Corresponds to MPI_LAND */
+    [OMPI_OP_BASE_FORTRAN_LAND] = {
+        NULL,
+    },
+    /* Corresponds to MPI_BAND */
+    [OMPI_OP_BASE_FORTRAN_BAND] = {
+        C_INTEGER(band, 2buff),
+    },
+    /* Corresponds to MPI_LOR */
+    [OMPI_OP_BASE_FORTRAN_LOR] = {
+        NULL,
+    },
+    /* Corresponds to MPI_BOR */
+    [OMPI_OP_BASE_FORTRAN_BOR] = {
+        C_INTEGER(bor, 2buff),
+    },
+    /* Corresponds to MPI_LXOR */
+    [OMPI_OP_BASE_FORTRAN_LXOR] = {
+        NULL,
+    },
+    /* Corresponds to MPI_BXOR */
+    [OMPI_OP_BASE_FORTRAN_BXOR] = {
+        C_INTEGER(bxor, 2buff),
+    },
+    /* Corresponds to MPI_REPLACE */
+    [OMPI_OP_BASE_FORTRAN_REPLACE] = {
+        /* (MPI_ACCUMULATE is handled differently than the other
+           reductions, so just zero out its function
+           implementations here to ensure that users don't invoke
+           MPI_REPLACE with any reduction operations other than
+           ACCUMULATE) */
+        NULL,
+    },
+};
+
+ompi_op_base_3buff_handler_fn_t OP_CONCAT(ompi_op_aarch64_3buff_functions, PREPEND)[OMPI_OP_BASE_FORTRAN_OP_MAX][OMPI_OP_BASE_TYPE_MAX] =
+{
+    /* Corresponds to MPI_OP_NULL */
+    [OMPI_OP_BASE_FORTRAN_NULL] = {
+        /* Leaving this empty puts in NULL for all entries */
+        NULL,
+    },
+    /* Corresponds to MPI_MAX */
+    [OMPI_OP_BASE_FORTRAN_MAX] = {
+        C_INTEGER(max, 3buff),
+        FLOATING_POINT(max, 3buff),
+    },
+    /* Corresponds to MPI_MIN */
+    [OMPI_OP_BASE_FORTRAN_MIN] = {
+        C_INTEGER(min, 3buff),
+        FLOATING_POINT(min, 3buff),
+    },
+    /* Corresponds to MPI_SUM */
+    [OMPI_OP_BASE_FORTRAN_SUM] = {
+        C_INTEGER(sum, 3buff),
+        FLOATING_POINT(sum, 3buff),
+        COMPLEX_SUM(3buff),
+    },
+    /* Corresponds to MPI_PROD */
+    [OMPI_OP_BASE_FORTRAN_PROD] = {
+        C_INTEGER_PROD(3buff),
+        FLOATING_POINT(prod, 3buff),
+    },
+    /* Corresponds to MPI_LAND */
+    [OMPI_OP_BASE_FORTRAN_LAND] = {
+        NULL,
+    },
+    /* Corresponds to MPI_BAND */
+    [OMPI_OP_BASE_FORTRAN_BAND] = {
+        C_INTEGER(band, 3buff),
+    },
+    /* Corresponds to MPI_LOR */
+    [OMPI_OP_BASE_FORTRAN_LOR] = {
+        NULL,
+    },
+    /* Corresponds to MPI_BOR */
+    [OMPI_OP_BASE_FORTRAN_BOR] = {
+        C_INTEGER(bor, 3buff),
+    },
+    /* Corresponds to MPI_LXOR */
+    [OMPI_OP_BASE_FORTRAN_LXOR] = {
+        NULL,
+    },
+    /* Corresponds to MPI_BXOR */
+    [OMPI_OP_BASE_FORTRAN_BXOR] = {
+        C_INTEGER(bxor, 3buff),
+    },
+    /* Corresponds to MPI_REPLACE */
+    [OMPI_OP_BASE_FORTRAN_REPLACE] = {
+        /* MPI_ACCUMULATE is handled differently than the other
+           reductions, so just zero out its function
+           implementations here to ensure that users don't invoke
+           MPI_REPLACE with any reduction operations other than
+           ACCUMULATE */
+        NULL,
+    },
+};
@@ -29,6 +29,7 @@ AC_DEFUN([MCA_ompi_op_avx_CONFIG],[
     op_avx_support=0
     op_avx2_support=0
     op_avx512_support=0
+    op_f16c_support=0
 
     AS_VAR_PUSHDEF([op_avx_check_sse3], [ompi_cv_op_avx_check_sse3])
     AS_VAR_PUSHDEF([op_avx_check_sse41], [ompi_cv_op_avx_check_sse41])
@@ -183,6 +184,44 @@ AC_DEFUN([MCA_ompi_op_avx_CONFIG],[
                               MCA_BUILD_OP_AVX2_FLAGS=""
                               AC_MSG_RESULT([no])])
                          CFLAGS="$op_avx_cflags_save"
+                        ])
+                  #
+                  # The half precision kernels of the AVX2 flavor convert to and from
+                  # single precision with F16C. It is an extension of its own, add its
+                  # flag to the AVX2 flavor if the compiler needs it.
+                  #
+                  AS_IF([test $op_avx2_support -eq 1],
+                        [AC_MSG_CHECKING([for F16C support])
+                         op_avx_cflags_save="$CFLAGS"
+                         CFLAGS="$CFLAGS $MCA_BUILD_OP_AVX2_FLAGS"
+                         AC_LINK_IFELSE(
+                             [AC_LANG_PROGRAM([[#include <immintrin.h>]],
+                                      [[
+#if defined(__ICC) && !defined(__F16C__)
+#error "icc needs the -m flags to provide the AVX* detection macros
+#endif
+    unsigned short A[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    __m256 vA = _mm256_cvtph_ps(_mm_loadu_si128((__m128i*)A));
+    _mm_storeu_si128((__m128i*)A, _mm256_cvtps_ph(vA, _MM_FROUND_TO_NEAREST_INT))
+                                      ]])],
+                             [op_f16c_support=1
+                              AC_MSG_RESULT([yes])],
+                             [AC_MSG_RESULT([no])])
+                         AS_IF([test $op_f16c_support -eq 0],
+                               [AC_MSG_CHECKING([for F16C support (with -mf16c)])
+                                CFLAGS="$CFLAGS -mf16c"
+                                AC_LINK_IFELSE(
+                                    [AC_LANG_PROGRAM([[#include <immintrin.h>]],
+                                             [[
+    unsigned short A[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    __m256 vA = _mm256_cvtph_ps(_mm_loadu_si128((__m128i*)A));
+    _mm_storeu_si128((__m128i*)A, _mm256_cvtps_ph(vA, _MM_FROUND_TO_NEAREST_INT))
+                                             ]])],
+                                    [op_f16c_support=1
+                                     MCA_BUILD_OP_AVX2_FLAGS="$MCA_BUILD_OP_AVX2_FLAGS -mf16c"
+                                     AC_MSG_RESULT([yes])],
+                                    [AC_MSG_RESULT([no])])])
+                         CFLAGS="$op_avx_cflags_save"
                         ])])
            #
            # What about early AVX support? The rest of the logic is slightly different as
@@ -305,6 +344,9 @@ AC_DEFUN([MCA_ompi_op_avx_CONFIG],[
     AC_DEFINE_UNQUOTED([OMPI_MCA_OP_HAVE_AVX2],
                        [$op_avx2_support],
                        [AVX2 supported in the current build])
+    AC_DEFINE_UNQUOTED([OMPI_MCA_OP_HAVE_F16C],
+                       [$op_f16c_support],
+                       [F16C supported by the AVX2 flavor in the current build])
     AC_DEFINE_UNQUOTED([OMPI_MCA_OP_HAVE_AVX],
                        [$op_avx_support],
                        [AVX supported in the current build])
@@ -23,6 +23,7 @@ BEGIN_C_DECLS
 
 #define OMPI_OP_AVX_HAS_AVX512BW_FLAG  0x00000200
 #define OMPI_OP_AVX_HAS_AVX512F_FLAG   0x00000100
+#define OMPI_OP_AVX_HAS_F16C_FLAG      0x00000040
 #define OMPI_OP_AVX_HAS_AVX2_FLAG      0x00000020
 #define OMPI_OP_AVX_HAS_AVX_FLAG       0x00000010
 #define OMPI_OP_AVX_HAS_SSE4_1_FLAG    0x00000008
@@ -48,6 +49,7 @@ typedef struct {
 
     uint32_t supported; /* AVX capabilities supported by the environment */
     uint32_t flags; /* AVX capabilities requested by this process */
+    size_t parallel_min_size; /* opm_parallel_min_size of the modules */
 } ompi_op_avx_component_t;
 
 /**
@@ -44,6 +44,7 @@ static mca_base_var_enum_value_flag_t avx_support_flags[] = {
     { .flag = 0x008, .string = "SSE4.1" },
     { .flag = 0x010, .string = "AVX" },
     { .flag = 0x020, .string = "AVX2" },
+    { .flag = 0x040, .string = "F16C" },
     { .flag = 0x100, .string = "AVX512F" },
     { .flag = 0x200, .string = "AVX512BW" },
     { .flag = 0,     .string = NULL },
@@ -64,6 +65,7 @@ static uint32_t has_intel_AVX_features(void)
     flags |= _may_i_use_cpu_feature(_FEATURE_AVX512F)  ? OMPI_OP_AVX_HAS_AVX512F_FLAG   : 0;
     flags |= _may_i_use_cpu_feature(_FEATURE_AVX512BW) ? OMPI_OP_AVX_HAS_AVX512BW_FLAG : 0;
     flags |= _may_i_use_cpu_feature(_FEATURE_AVX2)     ? OMPI_OP_AVX_HAS_AVX2_FLAG      : 0;
+    flags |= _may_i_use_cpu_feature(_FEATURE_F16C)     ? OMPI_OP_AVX_HAS_F16C_FLAG      : 0;
     flags |= _may_i_use_cpu_feature(_FEATURE_AVX)      ? OMPI_OP_AVX_HAS_AVX_FLAG       : 0;
     flags |= _may_i_use_cpu_feature(_FEATURE_SSE4_1)   ? OMPI_OP_AVX_HAS_SSE4_1_FLAG    : 0;
     flags |= _may_i_use_cpu_feature(_FEATURE_SSE3)     ? OMPI_OP_AVX_HAS_SSE3_FLAG      : 0;
@@ -101,6 +103,7 @@ static uint32_t has_intel_AVX_features(void)
     const uint32_t avx512f_mask   = (1U << 16);  // AVX512F   (EAX = 7, ECX = 0) : EBX
     const uint32_t avx512_bw_mask = (1U << 30);  // AVX512BW  (EAX = 7, ECX = 0) : EBX
     const uint32_t avx2_mask      = (1U << 5);   // AVX2      (EAX = 7, ECX = 0) : EBX
+    const uint32_t f16c_mask      = (1U << 29);  // F16C      (EAX = 1, ECX = 0) : ECX
     const uint32_t avx_mask       = (1U << 28);  // AVX       (EAX = 1, ECX = 0) : ECX
     const uint32_t sse4_1_mask    = (1U << 19);  // SSE4.1    (EAX = 1, ECX = 0) : ECX
     const uint32_t sse3_mask      = (1U << 0);   // SSE3      (EAX = 1, ECX = 0) : ECX
@@ -109,6 +112,7 @@ static uint32_t has_intel_AVX_features(void)
     uint32_t flags = 0, abcd[4];
 
     run_cpuid( 1, 0, abcd );
+    flags |= (abcd[2] & f16c_mask)      ? OMPI_OP_AVX_HAS_F16C_FLAG     : 0;
     flags |= (abcd[2] & avx_mask)       ? OMPI_OP_AVX_HAS_AVX_FLAG      : 0;
     flags |= (abcd[2] & sse4_1_mask)    ? OMPI_OP_AVX_HAS_SSE4_1_FLAG   : 0;
     flags |= (abcd[2] & sse3_mask)      ? OMPI_OP_AVX_HAS_SSE3_FLAG     : 0;
@@ -221,6 +225,17 @@ avx_component_register(void)
 
     mca_op_avx_component.flags &= mca_op_avx_component.supported;
 
+    /* the vector kernels saturate the bandwidth of a core sooner than the
+     * base functions, the helpers may pay off at another size */
+    mca_op_avx_component.parallel_min_size = ompi_op_base_parallel_min_size;
+    (void) mca_base_component_var_register(&mca_op_avx_component.super.opc_version,
+                                           "parallel_min_size",
+                                           "Smallest reduction, in bytes, split among the threads of op_base_parallel_threads (0: never)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_op_avx_component.parallel_min_size);
+
     return OMPI_SUCCESS;
 }
 
@@ -271,6 +286,7 @@ avx_component_op_query(struct ompi_op_t *op, int *priority)
     case OMPI_OP_BASE_FORTRAN_BAND:
     case OMPI_OP_BASE_FORTRAN_BXOR:
         module = OBJ_NEW(ompi_op_base_module_t);
+        module->opm_parallel_min_size = mca_op_avx_component.parallel_min_size;
         for (int i = 0; i < OMPI_OP_BASE_TYPE_MAX; ++i) {
 #if OMPI_MCA_OP_HAVE_AVX512
             if( mca_op_avx_component.flags & OMPI_OP_AVX_HAS_AVX512F_FLAG ) {
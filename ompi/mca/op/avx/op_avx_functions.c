@@ -16,6 +16,8 @@
 #ifdef HAVE_SYS_TYPES_H
 #include <sys/types.h>
 #endif
+#include <limits.h>
+
 #include "opal/util/output.h"
 
 #include "ompi/op/op.h"
@@ -82,6 +84,7 @@
  * _mm_add_ps                      SSE
  * _mm_adds_epi[8,16]              SSE2
  * _mm_adds_epu[8,16]              SSE2
+ * _mm_addsub_p[s,d]               SSE3
  * _mm_and_si128                   SSE2
  * _mm_lddqu_si128                 SSE3
  * _mm_loadu_pd                    SSE2
@@ -104,21 +107,28 @@
  * _mm_min_epu64                   AVX512VL + AVX512F
  * _mm_min_pd                      SSE2
  * _mm_min_ps                      SSE
+ * _mm_move[l,h]dup_ps             SSE3
+ * _mm_movedup_pd                  SSE3
  * _mm_mul_pd                      SSE2
  * _mm_mul_ps                      SSE
  * _mm_mullo_epi16                 SSE2
  * _mm_mullo_epi32                 SSE4.1
  * _mm_mullo_epi64                 AVX512VL + AVX512DQ
  * _mm_or_si128                    SSE2
+ * _mm_shuffle_p[s,d]              SSE/SSE2
  * _mm_storeu_pd                   SSE2
  * _mm_storeu_ps                   SSE
  * _mm_storeu_si128                SSE2
+ * _mm_unpackhi_pd                 SSE2
  * _mm_xor_si128                   SSE2
  * _mm256_add_epi[8,16,32,64]      AVX2
  * _mm256_add_p[s,d]               AVX
  * _mm256_adds_epi[8,16]           AVX2
  * _mm256_adds_epu[8,16]           AVX2
+ * _mm256_addsub_p[s,d]            AVX
  * _mm256_and_si256                AVX2
+ * _mm256_cvtph_ps                 F16C
+ * _mm256_cvtps_ph                 F16C
  * _mm256_loadu_p[s,d]             AVX
  * _mm256_loadu_si256              AVX
  * _mm256_max_epi[8,16,32]         AVX2
@@ -131,10 +141,13 @@
  * _mm256_min_epu[8,16,32]         AVX2
  * _mm256_min_epu64                AVX512VL + AVX512F
  * _mm256_min_p[s,d]               AVX
+ * _mm256_move[l,h]dup_ps          AVX
+ * _mm256_movedup_pd               AVX
  * _mm256_mul_p[s,d]               AVX
  * _mm256_mullo_epi[16,32]         AVX2
  * _mm256_mullo_epi64              AVX512VL + AVX512DQ
  * _mm256_or_si256                 AVX2
+ * _mm256_permute_p[s,d]           AVX
  * _mm256_storeu_p[s,d]            AVX
  * _mm256_storeu_si256             AVX
  * _mm256_xor_si256                AVX2
@@ -146,8 +159,13 @@
  * _mm512_and_si512                AVX512F
  * _mm512_cvtepi16_epi8            AVX512BW
  * _mm512_cvtepi8_epi16            AVX512BW
+ * _mm512_cvtph_ps                 AVX512F
+ * _mm512_cvtps_ph                 AVX512F
  * _mm512_loadu_p[s,d]             AVX512F
  * _mm512_loadu_si512              AVX512F
+ * _mm512_mask_storeu_p[s,d]       AVX512F
+ * _mm512_mask_sub_p[s,d]          AVX512F
+ * _mm512_maskz_loadu_p[s,d]       AVX512F
  * _mm512_max_epi[8,16]            AVX512BW
  * _mm512_max_epi[32,64]           AVX512F
  * _mm512_max_epu[8,16]            AVX512BW
@@ -158,11 +176,14 @@
  * _mm512_min_epu[8,16]            AVX512BW
  * _mm512_min_epu[32,64]           AVX512F
  * _mm512_min_p[s,d]               AVX512F
+ * _mm512_move[l,h]dup_ps          AVX512F
+ * _mm512_movedup_pd               AVX512F
  * _mm512_mul_p[s,d]               AVX512F
  * _mm512_mullo_epi16              AVX512BW
  * _mm512_mullo_epi32              AVX512F
  * _mm512_mullo_epi64              AVX512DQ
  * _mm512_or_si512                 AVX512F
+ * _mm512_permute_p[s,d]           AVX512F
  * _mm512_storeu_p[s,d]            AVX512F
  * _mm512_storeu_si512             AVX512F
  * _mm512_xor_si512                AVX512F
@@ -1337,6 +1358,340 @@ static void OP_CONCAT(ompi_op_avx_3buff_##op##_double,PREPEND)(const void *_in1,
     // not defined - OP_AVX_FLOAT_FUNC_3(xor)
     // not defined - OP_AVX_DOUBLE_FUNC_3(xor)
 
+/*
+ * Half precision (MPIX_C_FLOAT16 and the Fortran REAL*2 of the shortfloat
+ * extension). The halves are converted to single precision, combined and
+ * rounded back to the nearest half. A single precision result of the sum,
+ * the product, the max or the min of two halves rounds to the same half as
+ * the exact one, so these kernels give the same bits as the scalar loops.
+ * They rely on opal_short_float_t being an IEEE binary16, which is the case
+ * of short float and _Float16.
+ *
+ * The AVX512 flavor converts with AVX512F. The AVX2 flavor needs F16C,
+ * which is detected separately, otherwise it leaves the type to the base
+ * functions.
+ */
+#define OP_AVX_HALF_ROUNDING (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)
+
+#if defined(HAVE_OPAL_SHORT_FLOAT_T) && (2 == SIZEOF_OPAL_SHORT_FLOAT_T)
+
+#if defined(GENERATE_AVX512_CODE) && defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512)
+#if __AVX512F__
+#define OP_AVX_SHORT_FLOAT_KERNELS 1
+#define OP_AVX_AVX512_SHORT_FLOAT_FUNC(op)                              \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG) ) {         \
+        types_per_step = (512 / 8) / sizeof(float);                     \
+        for (; left_over >= types_per_step; left_over -= types_per_step) { \
+            __m512 vecA = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)in1)); \
+            __m512 vecB = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)in2)); \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            __m512 res = _mm512_##op##_ps(vecA, vecB);                  \
+            _mm256_storeu_si256((__m256i*)out, _mm512_cvtps_ph(res, OP_AVX_HALF_ROUNDING)); \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX512F support needed for _mm512_cvtph_ps and _mm512_cvtps_ph
+#endif  /* __AVX512F__ */
+#else
+#define OP_AVX_AVX512_SHORT_FLOAT_FUNC(op) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512) */
+
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_F16C) && (1 == OMPI_MCA_OP_HAVE_F16C) && \
+    defined(__AVX__) && defined(__F16C__)
+#ifndef OP_AVX_SHORT_FLOAT_KERNELS
+#define OP_AVX_SHORT_FLOAT_KERNELS 1
+#endif
+#define OP_AVX_F16C_SHORT_FLOAT_FUNC(op)                                \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX_FLAG|OMPI_OP_AVX_HAS_F16C_FLAG) ) { \
+        types_per_step = (256 / 8) / sizeof(float);                     \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m256 vecA = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)in1)); \
+            __m256 vecB = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)in2)); \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            __m256 res = _mm256_##op##_ps(vecA, vecB);                  \
+            _mm_storeu_si128((__m128i*)out, _mm256_cvtps_ph(res, OP_AVX_HALF_ROUNDING)); \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+/* the compiler flags do not allow the conversions, or this is the AVX flavor */
+#define OP_AVX_F16C_SHORT_FLOAT_FUNC(op) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_F16C) && (1 == OMPI_MCA_OP_HAVE_F16C) */
+
+#endif  /* defined(HAVE_OPAL_SHORT_FLOAT_T) && (2 == SIZEOF_OPAL_SHORT_FLOAT_T) */
+
+#if defined(OP_AVX_SHORT_FLOAT_KERNELS)
+/* in the two buffer version in2 is the output buffer */
+#define OP_AVX_SHORT_FLOAT_FUNC(op)                                     \
+static void OP_CONCAT(ompi_op_avx_2buff_##op##_short_float,PREPEND)(const void *_in, void *_out, int *count, \
+                                                                    struct ompi_datatype_t **dtype, \
+                                                                    struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int types_per_step, left_over = *count;                             \
+    const opal_short_float_t *in1 = (const opal_short_float_t*)_in;     \
+    const opal_short_float_t *in2 = (const opal_short_float_t*)_out;    \
+    opal_short_float_t *out = (opal_short_float_t*)_out;                \
+    OP_AVX_AVX512_SHORT_FLOAT_FUNC(op);                                 \
+    OP_AVX_F16C_SHORT_FLOAT_FUNC(op);                                   \
+    (void)types_per_step;                                               \
+    for( int i = 0; i < left_over; ++i ) {                              \
+        out[i] = current_func(out[i], in1[i]);                          \
+    }                                                                   \
+}
+
+#define OP_AVX_SHORT_FLOAT_FUNC_3(op)                                   \
+static void OP_CONCAT(ompi_op_avx_3buff_##op##_short_float,PREPEND)(const void *_in1, const void *_in2, \
+                                                                    void *_out, int *count, \
+                                                                    struct ompi_datatype_t **dtype, \
+                                                                    struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int types_per_step, left_over = *count;                             \
+    const opal_short_float_t *in1 = (const opal_short_float_t*)_in1;    \
+    const opal_short_float_t *in2 = (const opal_short_float_t*)_in2;    \
+    opal_short_float_t *out = (opal_short_float_t*)_out;                \
+    OP_AVX_AVX512_SHORT_FLOAT_FUNC(op);                                 \
+    OP_AVX_F16C_SHORT_FLOAT_FUNC(op);                                   \
+    (void)types_per_step;                                               \
+    for( int i = 0; i < left_over; ++i ) {                              \
+        out[i] = current_func(in1[i], in2[i]);                          \
+    }                                                                   \
+}
+
+#undef current_func
+#define current_func(a, b) ((a) > (b) ? (a) : (b))
+    OP_AVX_SHORT_FLOAT_FUNC(max)
+    OP_AVX_SHORT_FLOAT_FUNC_3(max)
+#undef current_func
+#define current_func(a, b) ((a) < (b) ? (a) : (b))
+    OP_AVX_SHORT_FLOAT_FUNC(min)
+    OP_AVX_SHORT_FLOAT_FUNC_3(min)
+#undef current_func
+#define current_func(a, b) ((a) + (b))
+    OP_AVX_SHORT_FLOAT_FUNC(add)
+    OP_AVX_SHORT_FLOAT_FUNC_3(add)
+#undef current_func
+#define current_func(a, b) ((a) * (b))
+    OP_AVX_SHORT_FLOAT_FUNC(mul)
+    OP_AVX_SHORT_FLOAT_FUNC_3(mul)
+#endif  /* defined(OP_AVX_SHORT_FLOAT_KERNELS) */
+
+/*************************************************************************
+ * Complex
+ *************************************************************************/
+
+/*
+ * The sum of two complex is the sum of their real and imaginary parts, so
+ * the real kernels do it on twice the count. The count is split to not
+ * overflow the int.
+ */
+#define OP_AVX_COMPLEX_SUM_FUNC(type_name, type, real_name)             \
+static void OP_CONCAT(ompi_op_avx_2buff_sum_##type_name,PREPEND)(const void *_in, void *_out, int *count, \
+                                                                 struct ompi_datatype_t **dtype, \
+                                                                 struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    const type *in = (const type*)_in;                                  \
+    type *out = (type*)_out;                                            \
+    int left_over = *count;                                             \
+    while( left_over > 0 ) {                                            \
+        int how_much = (left_over > INT_MAX / 2) ? INT_MAX / 2 : left_over; \
+        int n = 2 * how_much;                                           \
+        OP_CONCAT(ompi_op_avx_2buff_add_##real_name,PREPEND)(in, out, &n, dtype, module); \
+        left_over -= how_much;                                          \
+        in += n;                                                        \
+        out += n;                                                       \
+    }                                                                   \
+}                                                                       \
+static void OP_CONCAT(ompi_op_avx_3buff_sum_##type_name,PREPEND)(const void *_in1, const void *_in2, \
+                                                                 void *_out, int *count, \
+                                                                 struct ompi_datatype_t **dtype, \
+                                                                 struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    const type *in1 = (const type*)_in1, *in2 = (const type*)_in2;      \
+    type *out = (type*)_out;                                            \
+    int left_over = *count;                                             \
+    while( left_over > 0 ) {                                            \
+        int how_much = (left_over > INT_MAX / 2) ? INT_MAX / 2 : left_over; \
+        int n = 2 * how_much;                                           \
+        OP_CONCAT(ompi_op_avx_3buff_add_##real_name,PREPEND)(in1, in2, out, &n, dtype, module); \
+        left_over -= how_much;                                          \
+        in1 += n;                                                       \
+        in2 += n;                                                       \
+        out += n;                                                       \
+    }                                                                   \
+}
+
+    OP_AVX_COMPLEX_SUM_FUNC(c_float_complex, float, float)
+    OP_AVX_COMPLEX_SUM_FUNC(c_double_complex, double, double)
+#if defined(OP_AVX_SHORT_FLOAT_KERNELS)
+    OP_AVX_COMPLEX_SUM_FUNC(c_short_float_complex, opal_short_float_t, short_float)
+#endif  /* defined(OP_AVX_SHORT_FLOAT_KERNELS) */
+
+/*
+ * Product of interleaved (real, imaginary) pairs: with a = (ar, ai) and
+ * b = (br, bi), t1 = (ar * br, ar * bi) and t2 = (ai * bi, ai * br), the
+ * real part is t1 - t2 and the imaginary part t1 + t2 in the odd lanes.
+ * This is the textbook formula of the scalar loops, without the recovery
+ * of the infinite results that C99 Annex G does when it computes NaNs.
+ */
+#if defined(GENERATE_AVX512_CODE) && defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512)
+#if __AVX512F__
+static inline __m512 ompi_op_avx_cmul_512_float(__m512 a, __m512 b)
+{
+    __m512 t1 = _mm512_mul_ps(_mm512_moveldup_ps(a), b);
+    __m512 t2 = _mm512_mul_ps(_mm512_movehdup_ps(a), _mm512_permute_ps(b, 0xB1));
+    return _mm512_mask_sub_ps(_mm512_add_ps(t1, t2), 0x5555, t1, t2);
+}
+
+static inline __m512d ompi_op_avx_cmul_512_double(__m512d a, __m512d b)
+{
+    __m512d t1 = _mm512_mul_pd(_mm512_movedup_pd(a), b);
+    __m512d t2 = _mm512_mul_pd(_mm512_permute_pd(a, 0xFF), _mm512_permute_pd(b, 0x55));
+    return _mm512_mask_sub_pd(_mm512_add_pd(t1, t2), 0x55, t1, t2);
+}
+
+#define OP_AVX_AVX512_COMPLEX_PROD(type, vtype, sfx)                    \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG) ) {         \
+        types_per_step = (512 / 8) / (2 * sizeof(type));                \
+        for (; left_over >= types_per_step; left_over -= types_per_step) { \
+            vtype vecA = _mm512_loadu_##sfx(in1);                       \
+            vtype vecB = _mm512_loadu_##sfx(in2);                       \
+            in1 += 2 * types_per_step;                                  \
+            in2 += 2 * types_per_step;                                  \
+            _mm512_storeu_##sfx(out, ompi_op_avx_cmul_512_##type(vecA, vecB)); \
+            out += 2 * types_per_step;                                  \
+        }                                                               \
+        /* masked remainder, the flags allow FMA a scalar loop could get contracted to */ \
+        if( left_over > 0 ) {                                           \
+            unsigned int mask = (1U << (2 * left_over)) - 1;            \
+            vtype vecA = _mm512_maskz_loadu_##sfx(mask, in1);           \
+            vtype vecB = _mm512_maskz_loadu_##sfx(mask, in2);           \
+            _mm512_mask_storeu_##sfx(out, mask, ompi_op_avx_cmul_512_##type(vecA, vecB)); \
+        }                                                               \
+        return;                                                         \
+    }
+#else
+#error Target architecture lacks AVX512F support needed for _mm512_mask_sub_p[s,d]
+#endif  /* __AVX512F__ */
+#else
+#define OP_AVX_AVX512_COMPLEX_PROD(type, vtype, sfx) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512) */
+
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2)
+#if __AVX__
+static inline __m256 ompi_op_avx_cmul_256_float(__m256 a, __m256 b)
+{
+    __m256 t1 = _mm256_mul_ps(_mm256_moveldup_ps(a), b);
+    __m256 t2 = _mm256_mul_ps(_mm256_movehdup_ps(a), _mm256_permute_ps(b, 0xB1));
+    return _mm256_addsub_ps(t1, t2);
+}
+
+static inline __m256d ompi_op_avx_cmul_256_double(__m256d a, __m256d b)
+{
+    __m256d t1 = _mm256_mul_pd(_mm256_movedup_pd(a), b);
+    __m256d t2 = _mm256_mul_pd(_mm256_permute_pd(a, 0xF), _mm256_permute_pd(b, 0x5));
+    return _mm256_addsub_pd(t1, t2);
+}
+
+#define OP_AVX_AVX_COMPLEX_PROD(type, vtype, sfx)                       \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX_FLAG) ) {             \
+        types_per_step = (256 / 8) / (2 * sizeof(type));                \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            vtype vecA = _mm256_loadu_##sfx(in1);                       \
+            vtype vecB = _mm256_loadu_##sfx(in2);                       \
+            in1 += 2 * types_per_step;                                  \
+            in2 += 2 * types_per_step;                                  \
+            _mm256_storeu_##sfx(out, ompi_op_avx_cmul_256_##type(vecA, vecB)); \
+            out += 2 * types_per_step;                                  \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX support needed for _mm256_addsub_p[s,d]
+#endif  /* __AVX__ */
+#else
+#define OP_AVX_AVX_COMPLEX_PROD(type, vtype, sfx) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2) */
+
+#if defined(GENERATE_SSE3_CODE) && defined(OMPI_MCA_OP_HAVE_SSE3) && (1 == OMPI_MCA_OP_HAVE_SSE3)
+#if __SSE3__
+static inline __m128 ompi_op_avx_cmul_128_float(__m128 a, __m128 b)
+{
+    __m128 t1 = _mm_mul_ps(_mm_moveldup_ps(a), b);
+    __m128 t2 = _mm_mul_ps(_mm_movehdup_ps(a), _mm_shuffle_ps(b, b, 0xB1));
+    return _mm_addsub_ps(t1, t2);
+}
+
+static inline __m128d ompi_op_avx_cmul_128_double(__m128d a, __m128d b)
+{
+    __m128d t1 = _mm_mul_pd(_mm_movedup_pd(a), b);
+    __m128d t2 = _mm_mul_pd(_mm_unpackhi_pd(a, a), _mm_shuffle_pd(b, b, 0x1));
+    return _mm_addsub_pd(t1, t2);
+}
+
+#define OP_AVX_SSE3_COMPLEX_PROD(type, vtype, sfx)                      \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_SSE3_FLAG) ) {            \
+        types_per_step = (128 / 8) / (2 * sizeof(type));                \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            vtype vecA = _mm_loadu_##sfx(in1);                          \
+            vtype vecB = _mm_loadu_##sfx(in2);                          \
+            in1 += 2 * types_per_step;                                  \
+            in2 += 2 * types_per_step;                                  \
+            _mm_storeu_##sfx(out, ompi_op_avx_cmul_128_##type(vecA, vecB)); \
+            out += 2 * types_per_step;                                  \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks SSE3 support needed for _mm_addsub_p[s,d]
+#endif  /* __SSE3__ */
+#else
+#define OP_AVX_SSE3_COMPLEX_PROD(type, vtype, sfx) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_SSE3) && (1 == OMPI_MCA_OP_HAVE_SSE3) */
+
+#define OP_AVX_COMPLEX_PROD_BODY(type, vtype512, vtype256, vtype128, sfx) \
+    int types_per_step, left_over = *count;                             \
+    OP_AVX_AVX512_COMPLEX_PROD(type, vtype512, sfx);                    \
+    OP_AVX_AVX_COMPLEX_PROD(type, vtype256, sfx);                       \
+    OP_AVX_SSE3_COMPLEX_PROD(type, vtype128, sfx);                      \
+    (void)types_per_step;                                               \
+    for( ; left_over > 0; --left_over ) {                               \
+        type re = in1[0] * in2[0] - in1[1] * in2[1];                    \
+        type im = in1[0] * in2[1] + in1[1] * in2[0];                    \
+        out[0] = re;                                                    \
+        out[1] = im;                                                    \
+        in1 += 2;                                                       \
+        in2 += 2;                                                       \
+        out += 2;                                                       \
+    }
+
+/* in the two buffer version in2 is the output buffer */
+#define OP_AVX_COMPLEX_PROD_FUNC(type_name, type, vtype512, vtype256, vtype128, sfx) \
+static void OP_CONCAT(ompi_op_avx_2buff_prod_##type_name,PREPEND)(const void *_in, void *_out, int *count, \
+                                                                  struct ompi_datatype_t **dtype, \
+                                                                  struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    const type *in1 = (const type*)_in, *in2 = (const type*)_out;       \
+    type *out = (type*)_out;                                            \
+    OP_AVX_COMPLEX_PROD_BODY(type, vtype512, vtype256, vtype128, sfx)   \
+}                                                                       \
+static void OP_CONCAT(ompi_op_avx_3buff_prod_##type_name,PREPEND)(const void *_in1, const void *_in2, \
+                                                                  void *_out, int *count, \
+                                                                  struct ompi_datatype_t **dtype, \
+                                                                  struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    const type *in1 = (const type*)_in1, *in2 = (const type*)_in2;      \
+    type *out = (type*)_out;                                            \
+    OP_AVX_COMPLEX_PROD_BODY(type, vtype512, vtype256, vtype128, sfx)   \
+}
+
+    OP_AVX_COMPLEX_PROD_FUNC(c_float_complex, float, __m512, __m256, __m128, ps)
+    OP_AVX_COMPLEX_PROD_FUNC(c_double_complex, double, __m512d, __m256d, __m128d, pd)
+
 /** C integer ***********************************************************/
 #define C_INTEGER_8_16_32(name, ftype)                                                         \
     [OMPI_OP_BASE_TYPE_INT8_T]   = OP_CONCAT(ompi_op_avx_##ftype##_##name##_int8_t,PREPEND),   \
@@ -1365,11 +1720,29 @@ static void OP_CONCAT(ompi_op_avx_3buff_##op##_double,PREPEND)(const void *_in1,
 #define FLOAT(name, ftype) OP_CONCAT(ompi_op_avx_##ftype##_##name##_float,PREPEND)
 #define DOUBLE(name, ftype) OP_CONCAT(ompi_op_avx_##ftype##_##name##_double,PREPEND)
 
+#if defined(OP_AVX_SHORT_FLOAT_KERNELS)
+#define SHORT_FLOAT(name, ftype) OP_CONCAT(ompi_op_avx_##ftype##_##name##_short_float,PREPEND)
+#define C_SHORT_FLOAT_COMPLEX(name, ftype) OP_CONCAT(ompi_op_avx_##ftype##_##name##_c_short_float_complex,PREPEND)
+#else
+#define SHORT_FLOAT(name, ftype) NULL
+#define C_SHORT_FLOAT_COMPLEX(name, ftype) NULL
+#endif  /* defined(OP_AVX_SHORT_FLOAT_KERNELS) */
+
 #define FLOATING_POINT(name, ftype)                                         \
-    [OMPI_OP_BASE_TYPE_SHORT_FLOAT] = NULL,                                 \
+    [OMPI_OP_BASE_TYPE_SHORT_FLOAT] = SHORT_FLOAT(name, ftype),             \
     [OMPI_OP_BASE_TYPE_FLOAT] = FLOAT(name, ftype),                         \
     [OMPI_OP_BASE_TYPE_DOUBLE] = DOUBLE(name, ftype)
 
+/** Complex *************************************************************/
+#define COMPLEX_SUM(ftype)                                                  \
+    [OMPI_OP_BASE_TYPE_C_SHORT_FLOAT_COMPLEX] = C_SHORT_FLOAT_COMPLEX(sum, ftype), \
+    [OMPI_OP_BASE_TYPE_C_FLOAT_COMPLEX] = OP_CONCAT(ompi_op_avx_##ftype##_sum_c_float_complex,PREPEND), \
+    [OMPI_OP_BASE_TYPE_C_DOUBLE_COMPLEX] = OP_CONCAT(ompi_op_avx_##ftype##_sum_c_double_complex,PREPEND)
+
+#define COMPLEX_PROD(ftype)                                                 \
+    [OMPI_OP_BASE_TYPE_C_FLOAT_COMPLEX] = OP_CONCAT(ompi_op_avx_##ftype##_prod_c_float_complex,PREPEND), \
+    [OMPI_OP_BASE_TYPE_C_DOUBLE_COMPLEX] = OP_CONCAT(ompi_op_avx_##ftype##_prod_c_double_complex,PREPEND)
+
 /*
  * MPI_OP_NULL
  * All types
@@ -1401,11 +1774,13 @@ ompi_op_base_handler_fn_t OP_CONCAT(ompi_op_avx_functions, PREPEND)[OMPI_OP_BASE
     [OMPI_OP_BASE_FORTRAN_SUM] = {
         C_INTEGER(sum, 2buff),
         FLOATING_POINT(add, 2buff),
+        COMPLEX_SUM(2buff),
     },
     /* Corresponds to MPI_PROD */
     [OMPI_OP_BASE_FORTRAN_PROD] = {
         C_INTEGER_OPTIONAL(prod, 2buff),
         FLOATING_POINT(mul, 2buff),
+        COMPLEX_PROD(2buff),
     },
     /* Corresponds to MPI_LAND */
     [OMPI_OP_BASE_FORTRAN_LAND] = {
@@ -1464,11 +1839,13 @@ ompi_op_base_3buff_handler_fn_t OP_CONCAT(ompi_op_avx_3buff_functions, PREPEND)[
     [OMPI_OP_BASE_FORTRAN_SUM] = {
         C_INTEGER(sum, 3buff),
         FLOATING_POINT(add, 3buff),
+        COMPLEX_SUM(3buff),
     },
     /* Corresponds to MPI_PROD */
     [OMPI_OP_BASE_FORTRAN_PROD] = {
         C_INTEGER_OPTIONAL(prod, 3buff),
         FLOATING_POINT(mul, 3buff),
+        COMPLEX_PROD(3buff),
     },
     /* Corresponds to MPI_LAND */
     [OMPI_OP_BASE_FORTRAN_LAND] ={
@@ -95,5 +95,16 @@ OMPI_DECLSPEC int ompi_op_base_op_unselect(struct ompi_op_t *op);
 
 OMPI_DECLSPEC extern mca_base_framework_t ompi_op_base_framework;
 
+/**
+ * Default threshold of the parallel reductions of the op modules, see
+ * ompi_op_base_parallel_reduce.
+ */
+OMPI_DECLSPEC extern size_t ompi_op_base_parallel_min_size;
+
+/**
+ * Stop the helper threads of the parallel reductions.
+ */
+void ompi_op_base_parallel_finalize(void);
+
 END_C_DECLS
 #endif /* MCA_OP_BASE_H */
@@ -2,7 +2,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2005 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -38,12 +38,16 @@
  */
 #include "ompi/mca/op/base/static-components.h"
 
+int ompi_op_base_parallel_threads = 0;
+size_t ompi_op_base_parallel_min_size = 64 * 1024 * 1024;
+
 static void module_constructor(ompi_op_base_module_t *m)
 {
     m->opm_enable = NULL;
     m->opm_op = NULL;
     memset(&(m->opm_fns), 0, sizeof(m->opm_fns));
     memset(&(m->opm_3buff_fns), 0, sizeof(m->opm_3buff_fns));
+    m->opm_parallel_min_size = ompi_op_base_parallel_min_size;
 }
 
 static void module_constructor_1_0_0(ompi_op_base_module_1_0_0_t *m)
@@ -52,6 +56,7 @@ static void module_constructor_1_0_0(ompi_op_base_module_1_0_0_t *m)
     m->opm_op = NULL;
     memset(&(m->opm_fns), 0, sizeof(m->opm_fns));
     memset(&(m->opm_3buff_fns), 0, sizeof(m->opm_3buff_fns));
+    m->opm_parallel_min_size = ompi_op_base_parallel_min_size;
 }
 
 OBJ_CLASS_INSTANCE(ompi_op_base_module_t, opal_object_t,
@@ -59,5 +64,30 @@ OBJ_CLASS_INSTANCE(ompi_op_base_module_t, opal_object_t,
 OBJ_CLASS_INSTANCE(ompi_op_base_module_1_0_0_t, opal_object_t,
                    module_constructor_1_0_0, NULL);
 
-MCA_BASE_FRAMEWORK_DECLARE(ompi, op, NULL, NULL, NULL, NULL,
+static int ompi_op_base_register(mca_base_register_flag_t flags)
+{
+    (void) mca_base_var_register("ompi", "op", "base", "parallel_threads",
+                                 "Number of threads (including the caller) splitting the large "
+                                 "local reductions of the predefined operations, 0 or 1 to "
+                                 "disable. Only useful when the process is bound to several cores",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                 OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_LOCAL,
+                                 &ompi_op_base_parallel_threads);
+    (void) mca_base_var_register("ompi", "op", "base", "parallel_min_size",
+                                 "Smallest reduction, in bytes, split among the threads of "
+                                 "op_base_parallel_threads. Default of the op components that do "
+                                 "not have their own parallel_min_size",
+                                 MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                 OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_LOCAL,
+                                 &ompi_op_base_parallel_min_size);
+    return OMPI_SUCCESS;
+}
+
+static int ompi_op_base_close(void)
+{
+    ompi_op_base_parallel_finalize();
+    return mca_base_framework_components_close(&ompi_op_base_framework, NULL);
+}
+
+MCA_BASE_FRAMEWORK_DECLARE(ompi, op, NULL, ompi_op_base_register, NULL, ompi_op_base_close,
                            mca_op_base_static_components, 0);
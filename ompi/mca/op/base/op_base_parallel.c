@@ -0,0 +1,226 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Parallel local reductions. When op_base_parallel_threads is at least 2,
+ * the reductions of the intrinsic operations on predefined datatypes larger
+ * than the opm_parallel_min_size of their module are split in contiguous
+ * parts among a small pool of helper threads, the caller reducing the last
+ * part. A single core cannot use the memory bandwidth of the socket, the
+ * large local steps of the collectives (ring allreduce, the shared memory
+ * reductions) run at the speed of the memory instead. The pool serves a
+ * single reduction at a time, the others run sequentially.
+ */
+
+#include "ompi_config.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "opal/util/minmax.h"
+#include "opal/util/output.h"
+
+#include "ompi/constants.h"
+#include "ompi/op/op.h"
+#include "ompi/mca/op/op.h"
+#include "ompi/mca/op/base/base.h"
+
+/* do not bother the helpers for less than this */
+#define OMPI_OP_BASE_PARALLEL_MIN_PART (1024 * 1024)
+
+typedef struct {
+    const char *source1;
+    const char *source2; /**< NULL for the 2-buffer functions */
+    char *target;
+    int count;
+} ompi_op_base_parallel_part_t;
+
+static struct {
+    pthread_mutex_t lock;  /**< protects everything below */
+    pthread_cond_t start;  /**< a new reduction is posted (or the helpers must leave) */
+    pthread_cond_t done;   /**< the last part of the reduction is completed */
+    pthread_t *threads;
+    int nthreads;            /**< number of started helpers */
+    unsigned int generation; /**< incremented for each reduction */
+    int nparts;              /**< parts of the current reduction handled by the helpers */
+    int pending;             /**< parts not yet completed */
+    bool stop;
+    ompi_op_t *op;
+    ompi_datatype_t *dtype;
+    int dtype_id;
+    ompi_op_base_parallel_part_t *parts;
+} ompi_op_base_parallel_pool = {.lock = PTHREAD_MUTEX_INITIALIZER,
+                                .start = PTHREAD_COND_INITIALIZER,
+                                .done = PTHREAD_COND_INITIALIZER};
+
+static pthread_mutex_t ompi_op_base_parallel_busy = PTHREAD_MUTEX_INITIALIZER;
+
+static void ompi_op_base_parallel_run(ompi_op_t *op, ompi_datatype_t *dtype, int dtype_id,
+                                      ompi_op_base_parallel_part_t *part)
+{
+    int count = part->count;
+
+    if (NULL == part->source2) {
+        op->o_func.intrinsic.fns[dtype_id](part->source1, part->target, &count, &dtype,
+                                           op->o_func.intrinsic.modules[dtype_id]);
+    } else {
+        op->o_3buff_intrinsic.fns[dtype_id](part->source1, part->source2, part->target, &count,
+                                            &dtype, op->o_3buff_intrinsic.modules[dtype_id]);
+    }
+}
+
+static void *ompi_op_base_parallel_helper(void *arg)
+{
+    const int rank = (int) (intptr_t) arg;
+    unsigned int generation = 0;
+    ompi_op_base_parallel_part_t *part;
+
+    pthread_mutex_lock(&ompi_op_base_parallel_pool.lock);
+    while (1) {
+        while (!ompi_op_base_parallel_pool.stop
+               && (generation == ompi_op_base_parallel_pool.generation)) {
+            pthread_cond_wait(&ompi_op_base_parallel_pool.start, &ompi_op_base_parallel_pool.lock);
+        }
+        if (ompi_op_base_parallel_pool.stop) {
+            break;
+        }
+        generation = ompi_op_base_parallel_pool.generation;
+        if (rank >= ompi_op_base_parallel_pool.nparts) {
+            continue; /* not needed for this one */
+        }
+        part = &ompi_op_base_parallel_pool.parts[rank];
+        pthread_mutex_unlock(&ompi_op_base_parallel_pool.lock);
+
+        ompi_op_base_parallel_run(ompi_op_base_parallel_pool.op, ompi_op_base_parallel_pool.dtype,
+                                  ompi_op_base_parallel_pool.dtype_id, part);
+
+        pthread_mutex_lock(&ompi_op_base_parallel_pool.lock);
+        if (0 == --ompi_op_base_parallel_pool.pending) {
+            pthread_cond_signal(&ompi_op_base_parallel_pool.done);
+        }
+    }
+    pthread_mutex_unlock(&ompi_op_base_parallel_pool.lock);
+    return NULL;
+}
+
+/* Called with the busy lock held */
+static int ompi_op_base_parallel_init(void)
+{
+    int nthreads = ompi_op_base_parallel_threads - 1; /* the caller works too */
+
+    ompi_op_base_parallel_pool.threads = (pthread_t *) malloc(nthreads * sizeof(pthread_t));
+    ompi_op_base_parallel_pool.parts = (ompi_op_base_parallel_part_t *)
+        malloc(nthreads * sizeof(ompi_op_base_parallel_part_t));
+    if ((NULL == ompi_op_base_parallel_pool.threads) || (NULL == ompi_op_base_parallel_pool.parts)) {
+        goto disable;
+    }
+    for (; ompi_op_base_parallel_pool.nthreads < nthreads; ompi_op_base_parallel_pool.nthreads++) {
+        if (0 != pthread_create(&ompi_op_base_parallel_pool.threads[ompi_op_base_parallel_pool.nthreads],
+                                NULL, ompi_op_base_parallel_helper,
+                                (void *) (intptr_t) ompi_op_base_parallel_pool.nthreads)) {
+            break;
+        }
+    }
+    if (0 != ompi_op_base_parallel_pool.nthreads) {
+        return OMPI_SUCCESS;
+    }
+
+disable:
+    opal_output_verbose(1, ompi_op_base_framework.framework_output,
+                        "op:base: cannot start the helper threads, parallel reductions are "
+                        "disabled");
+    ompi_op_base_parallel_threads = 0;
+    free(ompi_op_base_parallel_pool.threads);
+    free(ompi_op_base_parallel_pool.parts);
+    ompi_op_base_parallel_pool.threads = NULL;
+    ompi_op_base_parallel_pool.parts = NULL;
+    return OMPI_ERR_OUT_OF_RESOURCE;
+}
+
+void ompi_op_base_parallel_finalize(void)
+{
+    if (0 == ompi_op_base_parallel_pool.nthreads) {
+        return;
+    }
+    pthread_mutex_lock(&ompi_op_base_parallel_pool.lock);
+    ompi_op_base_parallel_pool.stop = true;
+    pthread_cond_broadcast(&ompi_op_base_parallel_pool.start);
+    pthread_mutex_unlock(&ompi_op_base_parallel_pool.lock);
+    for (int i = 0; i < ompi_op_base_parallel_pool.nthreads; i++) {
+        pthread_join(ompi_op_base_parallel_pool.threads[i], NULL);
+    }
+    free(ompi_op_base_parallel_pool.threads);
+    free(ompi_op_base_parallel_pool.parts);
+    ompi_op_base_parallel_pool.threads = NULL;
+    ompi_op_base_parallel_pool.parts = NULL;
+    ompi_op_base_parallel_pool.nthreads = 0;
+    ompi_op_base_parallel_pool.stop = false;
+}
+
+bool ompi_op_base_parallel_reduce(ompi_op_t *op, const void *source1, const void *source2,
+                                  void *target, int count, ompi_datatype_t *dtype, int dtype_id)
+{
+    ompi_op_base_module_t *module = (NULL == source2) ? op->o_func.intrinsic.modules[dtype_id]
+                                                      : op->o_3buff_intrinsic.modules[dtype_id];
+    size_t size = dtype->super.size, length = (size_t) count * size;
+    ompi_op_base_parallel_part_t *part, last;
+    int nparts, chunk, i;
+
+    if ((NULL == module) || (0 == module->opm_parallel_min_size)
+        || (length < module->opm_parallel_min_size)
+        || (0 != pthread_mutex_trylock(&ompi_op_base_parallel_busy))) {
+        return false;
+    }
+    if ((0 == ompi_op_base_parallel_pool.nthreads)
+        && (OMPI_SUCCESS != ompi_op_base_parallel_init())) {
+        pthread_mutex_unlock(&ompi_op_base_parallel_busy);
+        return false;
+    }
+    nparts = (int) opal_min((size_t) ompi_op_base_parallel_pool.nthreads + 1,
+                            length / OMPI_OP_BASE_PARALLEL_MIN_PART);
+    if (nparts < 2) {
+        pthread_mutex_unlock(&ompi_op_base_parallel_busy);
+        return false;
+    }
+
+    /* the helpers take the first nparts-1 parts, the caller the last one
+     * with the remainder */
+    chunk = count / nparts;
+    for (i = 0; i < nparts; i++) {
+        part = (i < (nparts - 1)) ? &ompi_op_base_parallel_pool.parts[i] : &last;
+        part->source1 = (const char *) source1 + (size_t) i * chunk * size;
+        part->source2 = (NULL == source2) ? NULL : (const char *) source2 + (size_t) i * chunk * size;
+        part->target = (char *) target + (size_t) i * chunk * size;
+        part->count = (i < (nparts - 1)) ? chunk : count - i * chunk;
+    }
+
+    pthread_mutex_lock(&ompi_op_base_parallel_pool.lock);
+    ompi_op_base_parallel_pool.op = op;
+    ompi_op_base_parallel_pool.dtype = dtype;
+    ompi_op_base_parallel_pool.dtype_id = dtype_id;
+    ompi_op_base_parallel_pool.nparts = nparts - 1;
+    ompi_op_base_parallel_pool.pending = nparts - 1;
+    ompi_op_base_parallel_pool.generation++;
+    pthread_cond_broadcast(&ompi_op_base_parallel_pool.start);
+    pthread_mutex_unlock(&ompi_op_base_parallel_pool.lock);
+
+    ompi_op_base_parallel_run(op, dtype, dtype_id, &last);
+
+    pthread_mutex_lock(&ompi_op_base_parallel_pool.lock);
+    while (0 != ompi_op_base_parallel_pool.pending) {
+        pthread_cond_wait(&ompi_op_base_parallel_pool.done, &ompi_op_base_parallel_pool.lock);
+    }
+    pthread_mutex_unlock(&ompi_op_base_parallel_pool.lock);
+    pthread_mutex_unlock(&ompi_op_base_parallel_busy);
+
+    return true;
+}
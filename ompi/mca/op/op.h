@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2007 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2010 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -380,6 +380,11 @@ typedef struct ompi_op_base_module_1_0_0_t {
         with the MPI_Op that this module is used with */
     ompi_op_base_handler_fn_1_0_0_t opm_fns[OMPI_OP_BASE_TYPE_MAX];
     ompi_op_base_3buff_handler_fn_1_0_0_t opm_3buff_fns[OMPI_OP_BASE_TYPE_MAX];
+
+    /** Smallest reduction, in bytes, that ompi_op_reduce splits among
+        the helper threads (0: never). Set by the constructor to
+        op_base_parallel_min_size, components may change it. */
+    size_t opm_parallel_min_size;
 } ompi_op_base_module_1_0_0_t;
 
 /**
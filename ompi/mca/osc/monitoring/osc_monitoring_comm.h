@@ -114,6 +114,54 @@
             OPAL_MONITORING_PRINT_INFO("MPI_Rget to %d intercepted", world_rank); \
         }                                                               \
         return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_rget(origin_addr, origin_count, origin_datatype, source_rank, source_disp, source_count, source_datatype, win, request); \
+    }                                                                   \
+                                                                        \
+    static int ompi_osc_monitoring_## template ##_put_notify (const void *origin_addr, \
+                                                              int origin_count, \
+                                                              ompi_datatype_t *origin_datatype, \
+                                                              int target_rank, \
+                                                              ptrdiff_t target_disp, \
+                                                              int target_count, \
+                                                              ompi_datatype_t *target_datatype, \
+                                                              int notification_idx, \
+                                                              ompi_win_t *win) \
+    {                                                                   \
+        int world_rank;                                                 \
+        if (NULL == OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_put_notify) { \
+            return OMPI_ERR_NOT_SUPPORTED;                              \
+        }                                                               \
+        if(OPAL_SUCCESS == mca_common_monitoring_get_world_rank(target_rank, win->w_group, &world_rank)) { \
+            size_t type_size, data_size;                                \
+            ompi_datatype_type_size(origin_datatype, &type_size);       \
+            data_size = origin_count*type_size;                         \
+            mca_common_monitoring_record_osc(world_rank, data_size, SEND); \
+            OPAL_MONITORING_PRINT_INFO("MPIX_Put_notify to %d intercepted", world_rank); \
+        }                                                               \
+        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_put_notify(origin_addr, origin_count, origin_datatype, target_rank, target_disp, target_count, target_datatype, notification_idx, win); \
+    }                                                                   \
+                                                                        \
+    static int ompi_osc_monitoring_## template ##_get_notify (void *origin_addr, int origin_count, \
+                                                              ompi_datatype_t *origin_datatype, \
+                                                              int source_rank, \
+                                                              ptrdiff_t source_disp, \
+                                                              int source_count, \
+                                                              ompi_datatype_t *source_datatype, \
+                                                              int notification_idx, \
+                                                              ompi_win_t *win) \
+    {                                                                   \
+        int world_rank;                                                 \
+        if (NULL == OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_get_notify) { \
+            return OMPI_ERR_NOT_SUPPORTED;                              \
+        }                                                               \
+        if(OPAL_SUCCESS == mca_common_monitoring_get_world_rank(source_rank, win->w_group, &world_rank)) { \
+            size_t type_size, data_size;                                \
+            ompi_datatype_type_size(origin_datatype, &type_size);       \
+            data_size = origin_count*type_size;                         \
+            mca_common_monitoring_record_osc(world_rank, 0, SEND);      \
+            mca_common_monitoring_record_osc(world_rank, data_size, RECV); \
+            OPAL_MONITORING_PRINT_INFO("MPIX_Get_notify to %d intercepted", world_rank); \
+        }                                                               \
+        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_get_notify(origin_addr, origin_count, origin_datatype, source_rank, source_disp, source_count, source_datatype, notification_idx, win); \
     }
 
 #endif /* MCA_OSC_MONITORING_COMM_H */
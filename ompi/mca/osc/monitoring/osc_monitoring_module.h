@@ -40,6 +40,18 @@
     static int ompi_osc_monitoring_## template ##_free(ompi_win_t *win) \
     {                                                                   \
         return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_free(win); \
+    }                                                                   \
+                                                                        \
+    static int ompi_osc_monitoring_## template ##_notify_counters(ompi_win_t *win, \
+                                                                  opal_atomic_int64_t **counters, \
+                                                                  int *count) \
+    {                                                                   \
+        if (NULL == OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_win_notify_counters) { \
+            *counters = NULL;                                           \
+            *count = 0;                                                 \
+            return OMPI_SUCCESS;                                        \
+        }                                                               \
+        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_win_notify_counters(win, counters, count); \
     }
 
 #define MCA_OSC_MONITORING_MODULE_TEMPLATE_GENERATE(template)           \
@@ -91,6 +103,10 @@
             .osc_flush_all = ompi_osc_monitoring_## template ##_flush_all, \
             .osc_flush_local = ompi_osc_monitoring_## template ##_flush_local, \
             .osc_flush_local_all = ompi_osc_monitoring_## template ##_flush_local_all, \
+                                                                        \
+            .osc_put_notify = ompi_osc_monitoring_## template ##_put_notify, \
+            .osc_get_notify = ompi_osc_monitoring_## template ##_get_notify, \
+            .osc_win_notify_counters = ompi_osc_monitoring_## template ##_notify_counters, \
         };                                                              \
         if ( 1 == opal_atomic_add_fetch_32(&init_done, 1) ) {           \
             /* Saves the original module functions in                   \
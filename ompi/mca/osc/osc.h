@@ -14,6 +14,9 @@
  * Copyright (c) 2015-2017 Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * Copyright (c) 2016-2017 IBM Corporation. All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -37,6 +40,7 @@
 
 #include <stddef.h>
 
+#include "opal_stdatomic.h"
 #include "ompi/mca/mca.h"
 
 BEGIN_C_DECLS
@@ -353,6 +357,43 @@ typedef int (*ompi_osc_base_module_flush_local_fn_t)(int target,
                                                struct ompi_win_t *win);
 typedef int (*ompi_osc_base_module_flush_local_all_fn_t)(struct ompi_win_t *win);
 
+/**
+ * Notified RMA (optional)
+ *
+ * Same as put and get, and increment notification counter
+ * notification_idx of the target once the data was written to (put)
+ * or read from (get) its window. The increment is complete at the
+ * target when the operation is, at the next flush or synchronization.
+ */
+typedef int (*ompi_osc_base_module_put_notify_fn_t)(const void *origin_addr,
+                                                    int origin_count,
+                                                    struct ompi_datatype_t *origin_dt,
+                                                    int target,
+                                                    ptrdiff_t target_disp,
+                                                    int target_count,
+                                                    struct ompi_datatype_t *target_dt,
+                                                    int notification_idx,
+                                                    struct ompi_win_t *win);
+
+typedef int (*ompi_osc_base_module_get_notify_fn_t)(void *origin_addr,
+                                                    int origin_count,
+                                                    struct ompi_datatype_t *origin_dt,
+                                                    int target,
+                                                    ptrdiff_t target_disp,
+                                                    int target_count,
+                                                    struct ompi_datatype_t *target_dt,
+                                                    int notification_idx,
+                                                    struct ompi_win_t *win);
+
+/**
+ * Return the notification counters of the local process in the
+ * window, updated by the peers with atomics. count is 0 if the window
+ * was created without notification counters.
+ */
+typedef int (*ompi_osc_base_module_win_notify_counters_fn_t)(struct ompi_win_t *win,
+                                                             opal_atomic_int64_t **counters,
+                                                             int *count);
+
 
 
 /* ******************************************************************** */
@@ -404,6 +445,11 @@ struct ompi_osc_base_module_3_0_0_t {
     ompi_osc_base_module_flush_all_fn_t osc_flush_all;
     ompi_osc_base_module_flush_local_fn_t osc_flush_local;
     ompi_osc_base_module_flush_local_all_fn_t osc_flush_local_all;
+
+    /* optional, NULL if the component does not support notified RMA */
+    ompi_osc_base_module_put_notify_fn_t osc_put_notify;
+    ompi_osc_base_module_get_notify_fn_t osc_get_notify;
+    ompi_osc_base_module_win_notify_counters_fn_t osc_win_notify_counters;
 };
 typedef struct ompi_osc_base_module_3_0_0_t ompi_osc_base_module_3_0_0_t;
 typedef ompi_osc_base_module_3_0_0_t ompi_osc_base_module_t;
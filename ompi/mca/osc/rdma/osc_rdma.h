@@ -45,6 +45,7 @@
 #include "ompi/memchecker.h"
 #include "ompi/op/op.h"
 #include "opal/align.h"
+#include "opal/mca/base/mca_base_event.h"
 
 #include "osc_rdma_types.h"
 #include "osc_rdma_sync.h"
@@ -60,8 +61,36 @@
 enum {
     OMPI_OSC_RDMA_LOCKING_TWO_LEVEL,
     OMPI_OSC_RDMA_LOCKING_ON_DEMAND,
+    /** two level locking with a queue of the exclusive lock waiters */
+    OMPI_OSC_RDMA_LOCKING_MCS,
 };
 
+/**
+ * @brief registered local state segment kept for the next window
+ *
+ * Segments allocated and registered by allocate_state_single are pooled
+ * when their window is freed instead of being deregistered, so that the
+ * windows that are created and freed repeatedly skip the allocation and
+ * the registration.
+ */
+struct ompi_osc_rdma_pool_segment_t {
+    opal_list_item_t super;
+
+    /** segment (allocated with calloc) */
+    void *base;
+
+    /** size of the segment */
+    size_t size;
+
+    /** btl the segment is registered with */
+    struct mca_btl_base_module_t *btl;
+
+    /** registration handle of the segment */
+    mca_btl_base_registration_handle_t *handle;
+};
+typedef struct ompi_osc_rdma_pool_segment_t ompi_osc_rdma_pool_segment_t;
+OBJ_CLASS_DECLARATION(ompi_osc_rdma_pool_segment_t);
+
 /**
  * @brief osc rdma component structure
  */
@@ -116,9 +145,32 @@ struct ompi_osc_rdma_component_t {
 
     /** maximum count for network AMO usage */
     unsigned long network_amo_max_count;
+
+    /** size of the buffer small puts to a peer are combined in, 0 to disable */
+    unsigned int put_coalesce_size;
+
+    /** registered state segments of freed windows (ompi_osc_rdma_pool_segment_t) */
+    opal_list_t segment_pool;
+
+    /** maximum number of bytes kept in the segment pool, 0 to disable */
+    unsigned long segment_pool_size;
+
+    /** number of bytes in the segment pool */
+    size_t segment_pool_used;
+
+    /** MPI_T event raised on the window when a passive target lock is acquired */
+    mca_base_event_t *event_lock_acquired;
 };
 typedef struct ompi_osc_rdma_component_t ompi_osc_rdma_component_t;
 
+/** data of the lock_acquired event */
+typedef struct ompi_osc_rdma_event_lock_t {
+    /** target of the lock, -1 for MPI_Win_lock_all */
+    int target;
+    /** MPI_LOCK_SHARED or MPI_LOCK_EXCLUSIVE */
+    int lock_type;
+} ompi_osc_rdma_event_lock_t;
+
 struct ompi_osc_rdma_frag_t;
 
 /**
@@ -173,6 +225,16 @@ struct ompi_osc_rdma_module_t {
     /** maximum count for network AMO usage */
     unsigned long network_amo_max_count;
 
+    /** size of the buffer small puts to a peer are combined in, 0 if disabled */
+    size_t put_coalesce_size;
+
+    /** queue nodes (state->mcs_nodes) in use, one bit per node */
+    opal_atomic_int32_t mcs_nodes_used;
+
+    /** peers with combined puts that have not been sent */
+    ompi_osc_rdma_peer_t **wc_peers;
+    int wc_peer_count;
+
     /** global leader */
     ompi_osc_rdma_peer_t *leader;
 
@@ -182,6 +244,9 @@ struct ompi_osc_rdma_module_t {
     /** pointer to free on cleanup (may be NULL) */
     void *free_after;
 
+    /** size of free_after when it is a registered segment that can be pooled, 0 otherwise */
+    size_t free_after_size;
+
     /** local state structure (shared memory) */
     ompi_osc_rdma_state_t *state;
 
@@ -221,6 +286,12 @@ struct ompi_osc_rdma_module_t {
     /** offset in the shared memory segment where the state array starts */
     size_t state_offset;
 
+    /** number of notification counters (notified RMA) */
+    int notify_count;
+
+    /** offset of the notification counters in the state structure */
+    size_t notify_offset;
+
     /* ********************* sync data ************************ */
 
     /** global sync object (PSCW, fence, lock all) */
@@ -292,6 +363,18 @@ struct ompi_osc_rdma_module_t {
     /** number of time a get had to be retried */
     unsigned long get_retry_count;
 
+    /** number of puts combined with an earlier put */
+    unsigned long put_coalesce_count;
+
+    /** number of accumulate elements executed with btl atomics */
+    unsigned long acc_amo_count;
+
+    /** number of accumulate elements executed with btl compare-and-swap */
+    unsigned long acc_cas_count;
+
+    /** number of accumulate elements executed with get, op and put */
+    unsigned long acc_get_op_put_count;
+
     /** outstanding atomic operations */
     opal_atomic_int32_t pending_ops;
 };
@@ -326,6 +409,26 @@ int ompi_osc_module_add_peer (ompi_osc_rdma_module_t *module, ompi_osc_rdma_peer
  */
 int ompi_osc_rdma_demand_lock_peer (ompi_osc_rdma_module_t *module, ompi_osc_rdma_peer_t *peer);
 
+/**
+ * @brief keep the registered state segment of a window for the next one
+ *
+ * @param[in] module          osc rdma module being freed
+ *
+ * On success the caller no longer owns module->free_after and
+ * module->state_handle, both are set to NULL.
+ */
+void ompi_osc_rdma_segment_pool_return (ompi_osc_rdma_module_t *module);
+
+/**
+ * @brief start the small puts combined for all peers
+ *
+ * @param[in] module          osc rdma module
+ *
+ * Called before waiting for the completion of the rdma operations of a
+ * synchronization object.
+ */
+void ompi_osc_rdma_put_coalesce_flush_all (ompi_osc_rdma_module_t *module);
+
 /**
  * @brief check if a peer object is cached for a remote rank
  *
@@ -591,6 +694,11 @@ static inline void ompi_osc_rdma_sync_rdma_dec (ompi_osc_rdma_sync_t *rdma_sync)
  */
 static inline void ompi_osc_rdma_sync_rdma_complete (ompi_osc_rdma_sync_t *sync)
 {
+    /* start the puts that are still being combined */
+    if (sync->module->wc_peer_count) {
+        ompi_osc_rdma_put_coalesce_flush_all (sync->module);
+    }
+
 #if !defined(BTL_VERSION) || (BTL_VERSION < 310)
     do {
         opal_progress ();
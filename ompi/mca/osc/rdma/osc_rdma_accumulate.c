@@ -20,6 +20,7 @@
 #include "osc_rdma_request.h"
 #include "osc_rdma_comm.h"
 
+#include "opal/datatype/opal_datatype_internal.h"
 #include "ompi/mca/osc/base/base.h"
 #include "ompi/mca/osc/base/osc_base_obj_convert.h"
 
@@ -135,6 +136,20 @@ static int ompi_osc_rdma_op_mapping[OMPI_OP_NUM_OF_TYPES + 1] = {
     [OMPI_OP_REPLACE] = MCA_BTL_ATOMIC_SWAP,
 };
 
+/* btl_atomic_flags bit the btl sets when it can execute the mapped operation */
+static int ompi_osc_rdma_op_support[OMPI_OP_NUM_OF_TYPES + 1] = {
+    [OMPI_OP_MAX] = MCA_BTL_ATOMIC_SUPPORTS_MAX,
+    [OMPI_OP_MIN] = MCA_BTL_ATOMIC_SUPPORTS_MIN,
+    [OMPI_OP_SUM] = MCA_BTL_ATOMIC_SUPPORTS_ADD,
+    [OMPI_OP_BAND] = MCA_BTL_ATOMIC_SUPPORTS_AND,
+    [OMPI_OP_BOR] = MCA_BTL_ATOMIC_SUPPORTS_OR,
+    [OMPI_OP_BXOR] = MCA_BTL_ATOMIC_SUPPORTS_XOR,
+    [OMPI_OP_LAND] = MCA_BTL_ATOMIC_SUPPORTS_LAND,
+    [OMPI_OP_LOR] = MCA_BTL_ATOMIC_SUPPORTS_LOR,
+    [OMPI_OP_LXOR] = MCA_BTL_ATOMIC_SUPPORTS_LXOR,
+    [OMPI_OP_REPLACE] = MCA_BTL_ATOMIC_SUPPORTS_SWAP,
+};
+
 /* set the appropriate flags for this atomic */
 static inline int ompi_osc_rdma_set_btl_flags(ompi_osc_rdma_module_t *module, ompi_datatype_t *dt, ptrdiff_t extent) {
 
@@ -151,19 +166,59 @@ static inline int ompi_osc_rdma_set_btl_flags(ompi_osc_rdma_module_t *module, om
     return flags;
 }
 
+static inline bool ompi_osc_rdma_datatype_is_unsigned (ompi_datatype_t *dt)
+{
+    switch (dt->super.id) {
+    case OPAL_DATATYPE_UINT1:
+    case OPAL_DATATYPE_UINT2:
+    case OPAL_DATATYPE_UINT4:
+    case OPAL_DATATYPE_UINT8:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* check that the btl can execute op on an element of dt with a single atomic */
+static inline bool ompi_osc_rdma_btl_atomic_supported (mca_btl_base_module_t *btl, ompi_datatype_t *dt, ptrdiff_t extent,
+                                                       ompi_op_t *op)
+{
+    int32_t atomic_flags = btl->btl_atomic_flags;
+    int btl_op;
+
+    if ((8 != extent && !((MCA_BTL_ATOMIC_SUPPORTS_32BIT & atomic_flags) && 4 == extent)) ||
+        (!(OMPI_DATATYPE_FLAG_DATA_INT & dt->super.flags) && !(MCA_BTL_ATOMIC_SUPPORTS_FLOAT & atomic_flags)) ||
+        !ompi_op_is_intrinsic (op) || (0 == ompi_osc_rdma_op_mapping[op->op_type]) ||
+        !(ompi_osc_rdma_op_support[op->op_type] & atomic_flags)) {
+        return false;
+    }
+
+    btl_op = ompi_osc_rdma_op_mapping[op->op_type];
+
+    /* the btl min and max compare signed integers */
+    return !((MCA_BTL_ATOMIC_MIN == btl_op || MCA_BTL_ATOMIC_MAX == btl_op) && ompi_osc_rdma_datatype_is_unsigned (dt));
+}
+
+/* completion of one of the atomics started by ompi_osc_rdma_gacc_amo */
+static void ompi_osc_rdma_gacc_amo_complete (void *cbdata, void *cbcontext, int status)
+{
+    opal_atomic_int32_t *outstanding = (opal_atomic_int32_t *) cbdata;
+
+    (void) opal_atomic_fetch_add_32 (outstanding, -1);
+}
+
 static int ompi_osc_rdma_fetch_and_op_atomic (ompi_osc_rdma_sync_t *sync, const void *origin_addr, void *result_addr, ompi_datatype_t *dt,
                                               ptrdiff_t extent, ompi_osc_rdma_peer_t *peer, uint64_t target_address,
-                                              mca_btl_base_registration_handle_t *target_handle, ompi_op_t *op, ompi_osc_rdma_request_t *req)
+                                              mca_btl_base_registration_handle_t *target_handle, ompi_op_t *op,
+                                              opal_atomic_int32_t *outstanding)
 {
     ompi_osc_rdma_module_t *module = sync->module;
     mca_btl_base_module_t *selected_btl = ompi_osc_rdma_selected_btl (module, peer->data_btl_index);
-    int32_t atomic_flags = selected_btl->btl_atomic_flags;
     int btl_op, flags;
     int64_t origin;
+    int ret;
 
-    if ((8 != extent && !((MCA_BTL_ATOMIC_SUPPORTS_32BIT & atomic_flags) && 4 == extent)) ||
-        (!(OMPI_DATATYPE_FLAG_DATA_INT & dt->super.flags) && !(MCA_BTL_ATOMIC_SUPPORTS_FLOAT & atomic_flags)) ||
-        !ompi_op_is_intrinsic (op) || (0 == ompi_osc_rdma_op_mapping[op->op_type])) {
+    if (!ompi_osc_rdma_btl_atomic_supported (selected_btl, dt, extent, op)) {
         return OMPI_ERR_NOT_SUPPORTED;
     }
 
@@ -176,8 +231,19 @@ static int ompi_osc_rdma_fetch_and_op_atomic (ompi_osc_rdma_sync_t *sync, const
 
     origin = (8 == extent) ? ((int64_t *) origin_addr)[0] : ((int32_t *) origin_addr)[0];
 
-    return ompi_osc_rdma_btl_fop (module, peer->data_btl_index, peer->data_endpoint, target_address, target_handle, btl_op, origin, flags,
-                                 result_addr, true, NULL, NULL, NULL);
+    if (NULL == outstanding) {
+        return ompi_osc_rdma_btl_fop (module, peer->data_btl_index, peer->data_endpoint, target_address, target_handle, btl_op, origin, flags,
+                                      result_addr, true, NULL, NULL, NULL);
+    }
+
+    (void) opal_atomic_fetch_add_32 (outstanding, 1);
+    ret = ompi_osc_rdma_btl_fop (module, peer->data_btl_index, peer->data_endpoint, target_address, target_handle, btl_op, origin, flags,
+                                 result_addr, false, ompi_osc_rdma_gacc_amo_complete, (void *) outstanding, NULL);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        (void) opal_atomic_fetch_add_32 (outstanding, -1);
+    }
+
+    return ret;
 }
 
 static int ompi_osc_rdma_fetch_and_op_cas (ompi_osc_rdma_sync_t *sync, const void *origin_addr, void *result_addr, ompi_datatype_t *dt,
@@ -231,23 +297,21 @@ static int ompi_osc_rdma_fetch_and_op_cas (ompi_osc_rdma_sync_t *sync, const voi
 
 static int ompi_osc_rdma_acc_single_atomic (ompi_osc_rdma_sync_t *sync, const void *origin_addr, ompi_datatype_t *dt, ptrdiff_t extent,
                                             ompi_osc_rdma_peer_t *peer, uint64_t target_address,  mca_btl_base_registration_handle_t *target_handle,
-                                            ompi_op_t *op, ompi_osc_rdma_request_t *req)
+                                            ompi_op_t *op, opal_atomic_int32_t *outstanding)
 {
     ompi_osc_rdma_module_t *module = sync->module;
     mca_btl_base_module_t *selected_btl = ompi_osc_rdma_selected_btl (module, peer->data_btl_index);
-    int32_t atomic_flags = selected_btl->btl_atomic_flags;
     int btl_op, flags;
     int64_t origin;
+    int ret;
 
     if (!(selected_btl->btl_flags & MCA_BTL_FLAGS_ATOMIC_OPS)) {
         /* btl put atomics not supported or disabled. fall back on fetch-and-op */
         return ompi_osc_rdma_fetch_and_op_atomic (sync, origin_addr, NULL, dt, extent, peer, target_address, target_handle,
-                                                  op, req);
+                                                  op, outstanding);
     }
 
-    if ((8 != extent && !((MCA_BTL_ATOMIC_SUPPORTS_32BIT & atomic_flags) && 4 == extent)) ||
-        (!(OMPI_DATATYPE_FLAG_DATA_INT & dt->super.flags) && !(MCA_BTL_ATOMIC_SUPPORTS_FLOAT & atomic_flags)) ||
-        !ompi_op_is_intrinsic (op) || (0 == ompi_osc_rdma_op_mapping[op->op_type])) {
+    if (!ompi_osc_rdma_btl_atomic_supported (selected_btl, dt, extent, op)) {
         return OMPI_ERR_NOT_SUPPORTED;
     }
 
@@ -258,12 +322,23 @@ static int ompi_osc_rdma_acc_single_atomic (ompi_osc_rdma_sync_t *sync, const vo
 
     btl_op = ompi_osc_rdma_op_mapping[op->op_type];
 
-    OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "initiating accumulate using 64-bit btl atomics. origin: 0x%" PRIx64,
-                     *((int64_t *) origin_addr));
+    OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "initiating accumulate using %d-bit btl atomics. origin: 0x%" PRIx64,
+                     (4 == extent) ? 32 : 64, *((int64_t *) origin_addr));
+
+    if (NULL == outstanding) {
+        /* if we locked the peer its best to wait for completion before returning */
+        return ompi_osc_rdma_btl_op (module, peer->data_btl_index, peer->data_endpoint, target_address, target_handle, btl_op, origin,
+                                     flags, true, NULL, NULL, NULL);
+    }
 
-    /* if we locked the peer its best to wait for completion before returning */
-    return ompi_osc_rdma_btl_op (module, peer->data_btl_index, peer->data_endpoint, target_address, target_handle, btl_op, origin,
-                                flags, true, NULL, NULL, NULL);
+    (void) opal_atomic_fetch_add_32 (outstanding, 1);
+    ret = ompi_osc_rdma_btl_op (module, peer->data_btl_index, peer->data_endpoint, target_address, target_handle, btl_op, origin,
+                                flags, false, ompi_osc_rdma_gacc_amo_complete, (void *) outstanding, NULL);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        (void) opal_atomic_fetch_add_32 (outstanding, -1);
+    }
+
+    return ret;
 }
 
 static inline int ompi_osc_rdma_gacc_amo (ompi_osc_rdma_module_t *module, ompi_osc_rdma_sync_t *sync, const void *source, void *result,
@@ -272,27 +347,46 @@ static inline int ompi_osc_rdma_gacc_amo (ompi_osc_rdma_module_t *module, ompi_o
                                           mca_btl_base_registration_handle_t *target_handle, int count,
                                           ompi_datatype_t *datatype, ompi_op_t *op, ompi_osc_rdma_request_t *request)
 {
-    const bool use_amo = module->acc_use_amo;
+    mca_btl_base_module_t *selected_btl = ompi_osc_rdma_selected_btl (module, peer->data_btl_index);
     const size_t dt_size = datatype->super.size;
-    void *to_free = NULL;
-    int ret;
+    const bool fetch = (NULL != result || NULL != result_convertor);
+    opal_atomic_int32_t outstanding = 0;
+    bool use_amo = module->acc_use_amo;
+    void *result_buffer, *to_free = NULL;
+    int ret = OMPI_SUCCESS;
+
+    if (use_amo && !ompi_osc_rdma_btl_atomic_supported (selected_btl, datatype, dt_size, op)) {
+        /* a single element can still be updated atomically with compare-and-swap. with more
+         * elements get-op-put is cheaper (one get and one put instead of two round trips per
+         * element) */
+        if (1 != count || &ompi_mpi_op_no_op.op == op ||
+            !(MCA_BTL_ATOMIC_SUPPORTS_CSWAP & selected_btl->btl_atomic_flags)) {
+            return OMPI_ERR_NOT_SUPPORTED;
+        }
+        use_amo = false;
+    }
 
-    OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "using network atomics for accumulate operation with count %d", count);
+    OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "using network %s for accumulate operation with count %d",
+                     use_amo ? "atomics" : "compare-and-swap", count);
 
-    if (NULL == result) {
+    if (fetch && NULL == result) {
         to_free = result = malloc (request->len);
         if (OPAL_UNLIKELY(NULL == result)) {
             return OMPI_ERR_OUT_OF_RESOURCE;
        }
     }
 
+    result_buffer = result;
+
+    /* the atomics are independent. start all of them and wait once */
     for (int i = 0 ; i < count ; ) {
         if (use_amo) {
-            if (NULL == result) {
-                ret = ompi_osc_rdma_acc_single_atomic (sync, source, datatype, dt_size, peer, target_address, target_handle, op, request);
+            if (!fetch) {
+                ret = ompi_osc_rdma_acc_single_atomic (sync, source, datatype, dt_size, peer, target_address, target_handle, op,
+                                                       &outstanding);
             } else {
                 ret = ompi_osc_rdma_fetch_and_op_atomic (sync, source, result, datatype, dt_size, peer, target_address, target_handle, op,
-                                                         request);
+                                                         &outstanding);
             }
         } else {
             ret = ompi_osc_rdma_fetch_and_op_cas (sync, source, result, datatype, dt_size, peer, target_address, target_handle, op,
@@ -309,14 +403,30 @@ static inline int ompi_osc_rdma_gacc_amo (ompi_osc_rdma_module_t *module, ompi_o
             target_address += dt_size;
             ++i;
         } else if (OPAL_UNLIKELY(OMPI_ERR_NOT_SUPPORTED == ret)) {
-            return OMPI_ERR_NOT_SUPPORTED;
+            break;
         }
     }
 
+    while (outstanding) {
+        ompi_osc_rdma_progress (module);
+    }
+
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        /* can only happen before the first element */
+        free (to_free);
+        return ret;
+    }
+
+    if (use_amo) {
+        module->acc_amo_count += count;
+    } else {
+        module->acc_cas_count += count;
+    }
+
     if (NULL != result_convertor) {
         /* result buffer is not necessarily contiguous. use the opal datatype engine to
          * copy the data over in this case */
-        struct iovec iov = {.iov_base = result, .iov_len = request->len};
+        struct iovec iov = {.iov_base = result_buffer, .iov_len = request->len};
         uint32_t iov_count = 1;
         size_t size = request->len;
 
@@ -365,6 +475,8 @@ static inline int ompi_osc_rdma_gacc_contig (ompi_osc_rdma_sync_t *sync, const v
 
     OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "using get-op-put to execute accumulate with count %d", target_count);
 
+    module->acc_get_op_put_count += target_count;
+
     if (&ompi_mpi_op_replace.op != op || OMPI_OSC_RDMA_TYPE_GET_ACC == request->type) {
         ptr = malloc (len);
         if (OPAL_UNLIKELY(NULL == ptr)) {
@@ -811,6 +923,11 @@ int ompi_osc_rdma_compare_and_swap (const void *origin_addr, const void *compare
         return OMPI_ERR_RMA_SYNC;
     }
 
+    /* the combined puts to the peer come first */
+    if (OPAL_UNLIKELY(NULL != peer->wc_frag)) {
+        (void) ompi_osc_rdma_put_coalesce_flush (peer);
+    }
+
     ret = ompi_datatype_get_true_extent(dt, &true_lb, &true_extent);
     if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
         return ret;
@@ -901,6 +1018,11 @@ int ompi_osc_rdma_rget_accumulate_internal (ompi_win_t *win, const void *origin_
         return OMPI_ERR_RMA_SYNC;
     }
 
+    /* the combined puts to the peer come first */
+    if (OPAL_UNLIKELY(NULL != peer->wc_frag)) {
+        (void) ompi_osc_rdma_put_coalesce_flush (peer);
+    }
+
     if (request_out) {
         OMPI_OSC_RDMA_REQUEST_ALLOC(module, peer, rdma_request);
         *request_out = &rdma_request->super;
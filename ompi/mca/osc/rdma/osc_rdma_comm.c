@@ -6,6 +6,9 @@
  * Copyright (c) 2017      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * Copyright (c) 2017      IBM Corporation. All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -535,6 +538,107 @@ int ompi_osc_rdma_put_contig (ompi_osc_rdma_sync_t *sync, ompi_osc_rdma_peer_t *
     return ret;
 }
 
+int ompi_osc_rdma_put_coalesce_flush (ompi_osc_rdma_peer_t *peer)
+{
+    ompi_osc_rdma_frag_t *frag = peer->wc_frag;
+    ompi_osc_rdma_sync_t *sync = peer->wc_sync;
+    mca_btl_base_rdma_completion_fn_t cbfunc;
+    ompi_osc_rdma_module_t *module;
+    void *cbcontext;
+    int ret;
+
+    if (NULL == frag) {
+        return OMPI_SUCCESS;
+    }
+
+    module = sync->module;
+    peer->wc_frag = NULL;
+
+    for (int i = 0 ; i < module->wc_peer_count ; ++i) {
+        if (module->wc_peers[i] == peer) {
+            module->wc_peers[i] = module->wc_peers[--module->wc_peer_count];
+            break;
+        }
+    }
+
+    OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "starting %lu bytes of combined puts to remote address %" PRIx64,
+                     (unsigned long) peer->wc_size, peer->wc_address);
+
+    /* see ompi_osc_rdma_put_contig */
+    if (ompi_osc_rdma_use_btl_flush (module)) {
+        cbfunc = ompi_osc_rdma_put_complete_flush;
+        cbcontext = (void *) module;
+    } else {
+        cbfunc = ompi_osc_rdma_put_complete;
+        cbcontext = (void *) sync;
+    }
+
+    ret = ompi_osc_rdma_put_real (sync, peer, peer->wc_address, peer->wc_handle, peer->wc_buffer, frag->handle,
+                                  peer->wc_size, cbfunc, cbcontext, frag);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        ompi_osc_rdma_cleanup_rdma (sync, false, frag, NULL, NULL);
+    }
+
+    return ret;
+}
+
+void ompi_osc_rdma_put_coalesce_flush_all (ompi_osc_rdma_module_t *module)
+{
+    while (module->wc_peer_count) {
+        (void) ompi_osc_rdma_put_coalesce_flush (module->wc_peers[module->wc_peer_count - 1]);
+    }
+}
+
+/* add a small put to the buffer of the peer. only puts that write right after the previous
+ * one are combined, filling a gap would overwrite target memory the user did not ask for */
+static int ompi_osc_rdma_put_coalesce (ompi_osc_rdma_sync_t *sync, ompi_osc_rdma_peer_t *peer, uint64_t target_address,
+                                       mca_btl_base_registration_handle_t *target_handle, const void *source_buffer,
+                                       size_t size)
+{
+    ompi_osc_rdma_module_t *module = sync->module;
+    int ret;
+
+    if (NULL != peer->wc_frag) {
+        if (peer->wc_sync == sync && peer->wc_handle == target_handle &&
+            peer->wc_address + peer->wc_size == target_address &&
+            peer->wc_size + size <= module->put_coalesce_size) {
+            memcpy (peer->wc_buffer + peer->wc_size, source_buffer, size);
+            peer->wc_size += size;
+            ++module->put_coalesce_count;
+            return OMPI_SUCCESS;
+        }
+
+        ret = ompi_osc_rdma_put_coalesce_flush (peer);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+            return ret;
+        }
+    }
+
+    if (NULL == module->wc_peers) {
+        module->wc_peers = (ompi_osc_rdma_peer_t **) calloc (ompi_comm_size (module->comm), sizeof (module->wc_peers[0]));
+        if (OPAL_UNLIKELY(NULL == module->wc_peers)) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+    }
+
+    /* no room left in the temporary buffers. the put takes the usual path */
+    ret = ompi_osc_rdma_frag_alloc (module, module->put_coalesce_size, &peer->wc_frag, &peer->wc_buffer);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        peer->wc_frag = NULL;
+        return ret;
+    }
+
+    memcpy (peer->wc_buffer, source_buffer, size);
+    peer->wc_address = target_address;
+    peer->wc_handle = target_handle;
+    peer->wc_size = size;
+    peer->wc_sync = sync;
+
+    module->wc_peers[module->wc_peer_count++] = peer;
+
+    return OMPI_SUCCESS;
+}
+
 static void ompi_osc_rdma_get_complete (struct mca_btl_base_module_t *btl, struct mca_btl_base_endpoint_t *endpoint,
                                         void *local_address, mca_btl_base_registration_handle_t *local_handle,
                                         void *context, void *data, int status)
@@ -769,6 +873,26 @@ static inline int ompi_osc_rdma_put_w_req (ompi_osc_rdma_sync_t *sync, const voi
                                          target_count, target_datatype, request);
     }
 
+    /* small puts without a request can wait for the next synchronization */
+    if (NULL == request && module->put_coalesce_size) {
+        size_t size = origin_datatype->super.size * origin_count;
+
+        if (size <= module->put_coalesce_size &&
+            ompi_datatype_is_contiguous_memory_layout (origin_datatype, origin_count) &&
+            ompi_datatype_is_contiguous_memory_layout (target_datatype, target_count)) {
+            ptrdiff_t origin_lb, target_lb, extent;
+
+            (void) ompi_datatype_get_true_extent (origin_datatype, &origin_lb, &extent);
+            (void) ompi_datatype_get_true_extent (target_datatype, &target_lb, &extent);
+
+            ret = ompi_osc_rdma_put_coalesce (sync, peer, target_address + target_lb, target_handle,
+                                              (const void *) ((intptr_t) origin_addr + origin_lb), size);
+            if (OMPI_SUCCESS == ret) {
+                return OMPI_SUCCESS;
+            }
+        }
+    }
+
     return ompi_osc_rdma_master (sync, (void *) origin_addr, origin_count, origin_datatype, peer,
                                  target_address, target_handle, target_count, target_datatype, request,
                                  btl->btl_put_limit, ompi_osc_rdma_put_contig, false);
@@ -804,6 +928,11 @@ static inline int ompi_osc_rdma_get_w_req (ompi_osc_rdma_sync_t *sync, void *ori
         return ret;
     }
 
+    /* the data may have been written by combined puts */
+    if (OPAL_UNLIKELY(NULL != peer->wc_frag)) {
+        (void) ompi_osc_rdma_put_coalesce_flush (peer);
+    }
+
     /* optimize self/local communication */
     if (ompi_osc_rdma_peer_local_base (peer)) {
         return ompi_osc_rdma_copy_local ((void *) (intptr_t) source_address, source_count, source_datatype,
@@ -925,3 +1054,134 @@ int ompi_osc_rdma_rget (void *origin_addr, int origin_count, ompi_datatype_t *or
 
     return OMPI_SUCCESS;
 }
+
+static void ompi_osc_rdma_notify_complete (void *cbdata, void *cbcontext, int status)
+{
+    ompi_osc_rdma_sync_rdma_dec_always ((ompi_osc_rdma_sync_t *) cbdata);
+}
+
+/* cleanup of the internal request of a notified operation: increment the notification counter of the target */
+static void ompi_osc_rdma_notify (ompi_osc_rdma_request_t *request)
+{
+    ompi_osc_rdma_peer_t *peer = request->peer;
+    ompi_osc_rdma_sync_t *sync = request->sync;
+    int ret;
+
+    OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "notifying peer %d at 0x%" PRIx64, peer->rank, request->target_address);
+
+    if (ompi_osc_rdma_peer_local_state (peer)) {
+        opal_atomic_mb ();
+        (void) opal_atomic_add_fetch_64 ((opal_atomic_int64_t *) (intptr_t) request->target_address, 1);
+        ompi_osc_rdma_sync_rdma_dec_always (sync);
+        return;
+    }
+
+    ret = ompi_osc_rdma_btl_op (request->module, peer->state_btl_index, peer->state_endpoint, request->target_address,
+                                peer->state_handle, MCA_BTL_ATOMIC_ADD, 1, 0, false, ompi_osc_rdma_notify_complete,
+                                (void *) sync, NULL);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_ERROR, "could not notify peer %d. error code %d", peer->rank, ret);
+        ompi_osc_rdma_sync_rdma_dec_always (sync);
+    }
+}
+
+static inline ompi_osc_rdma_request_t *ompi_osc_rdma_notify_request (ompi_osc_rdma_sync_t *sync, ompi_osc_rdma_peer_t *peer,
+                                                                     int notification_idx, ompi_osc_rdma_request_type_t type)
+{
+    ompi_osc_rdma_module_t *module = sync->module;
+    ompi_osc_rdma_request_t *request;
+
+    OMPI_OSC_RDMA_REQUEST_ALLOC(module, peer, request);
+
+    request->type = type;
+    request->internal = true;
+    request->sync = sync;
+    request->cleanup = ompi_osc_rdma_notify;
+    request->target_address = peer->state + module->notify_offset + notification_idx * sizeof (int64_t);
+
+    /* the notification completes with the synchronization, like the operation */
+    ompi_osc_rdma_sync_rdma_inc_always (sync);
+
+    return request;
+}
+
+int ompi_osc_rdma_put_notify (const void *origin_addr, int origin_count, ompi_datatype_t *origin_datatype,
+                              int target_rank, ptrdiff_t target_disp, int target_count,
+                              ompi_datatype_t *target_datatype, int notification_idx, ompi_win_t *win)
+{
+    ompi_osc_rdma_module_t *module = GET_MODULE(win);
+    ompi_osc_rdma_request_t *rdma_request;
+    ompi_osc_rdma_peer_t *peer;
+    ompi_osc_rdma_sync_t *sync;
+    int ret;
+
+    OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "put_notify: 0x%lx, %d, %s, %d, %d, %d, %s, %d, %s",
+                     (unsigned long) origin_addr, origin_count, origin_datatype->name, target_rank,
+                     (int) target_disp, target_count, target_datatype->name, notification_idx, win->w_name);
+
+    if (OPAL_UNLIKELY(notification_idx < 0 || notification_idx >= module->notify_count)) {
+        return OMPI_ERR_BAD_PARAM;
+    }
+
+    sync = ompi_osc_rdma_module_sync_lookup (module, target_rank, &peer);
+    if (OPAL_UNLIKELY(NULL == sync)) {
+        return OMPI_ERR_RMA_SYNC;
+    }
+
+    rdma_request = ompi_osc_rdma_notify_request (sync, peer, notification_idx, OMPI_OSC_RDMA_TYPE_PUT);
+
+    ret = ompi_osc_rdma_put_w_req (sync, origin_addr, origin_count, origin_datatype, peer, target_disp,
+                                   target_count, target_datatype, rdma_request);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        ompi_osc_rdma_sync_rdma_dec_always (sync);
+        OMPI_OSC_RDMA_REQUEST_RETURN(rdma_request);
+    }
+
+    return ret;
+}
+
+int ompi_osc_rdma_get_notify (void *origin_addr, int origin_count, ompi_datatype_t *origin_datatype,
+                              int source_rank, ptrdiff_t source_disp, int source_count,
+                              ompi_datatype_t *source_datatype, int notification_idx, ompi_win_t *win)
+{
+    ompi_osc_rdma_module_t *module = GET_MODULE(win);
+    ompi_osc_rdma_request_t *rdma_request;
+    ompi_osc_rdma_peer_t *peer;
+    ompi_osc_rdma_sync_t *sync;
+    int ret;
+
+    OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "get_notify: 0x%lx, %d, %s, %d, %d, %d, %s, %d, %s",
+                     (unsigned long) origin_addr, origin_count, origin_datatype->name, source_rank,
+                     (int) source_disp, source_count, source_datatype->name, notification_idx, win->w_name);
+
+    if (OPAL_UNLIKELY(notification_idx < 0 || notification_idx >= module->notify_count)) {
+        return OMPI_ERR_BAD_PARAM;
+    }
+
+    sync = ompi_osc_rdma_module_sync_lookup (module, source_rank, &peer);
+    if (OPAL_UNLIKELY(NULL == sync)) {
+        return OMPI_ERR_RMA_SYNC;
+    }
+
+    rdma_request = ompi_osc_rdma_notify_request (sync, peer, notification_idx, OMPI_OSC_RDMA_TYPE_GET);
+
+    ret = ompi_osc_rdma_get_w_req (sync, origin_addr, origin_count, origin_datatype, peer,
+                                   source_disp, source_count, source_datatype, rdma_request);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        ompi_osc_rdma_sync_rdma_dec_always (sync);
+        OMPI_OSC_RDMA_REQUEST_RETURN(rdma_request);
+    }
+
+    return ret;
+}
+
+int ompi_osc_rdma_notify_counters (ompi_win_t *win, opal_atomic_int64_t **counters, int *count)
+{
+    ompi_osc_rdma_module_t *module = GET_MODULE(win);
+
+    *count = module->notify_count;
+    *counters = module->notify_count ?
+        (opal_atomic_int64_t *) ((intptr_t) module->state + module->notify_offset) : NULL;
+
+    return OMPI_SUCCESS;
+}
@@ -99,6 +99,16 @@ int ompi_osc_rdma_rget (void *origin_addr, int origin_count, ompi_datatype_t *or
                         ompi_datatype_t *target_dt, ompi_win_t *win,
                         ompi_request_t **request);
 
+int ompi_osc_rdma_put_notify (const void *origin_addr, int origin_count, ompi_datatype_t *origin_dt,
+                              int target, ptrdiff_t target_disp, int target_count,
+                              ompi_datatype_t *target_dt, int notification_idx, ompi_win_t *win);
+
+int ompi_osc_rdma_get_notify (void *origin_addr, int origin_count, ompi_datatype_t *origin_dt,
+                              int target, ptrdiff_t target_disp, int target_count,
+                              ompi_datatype_t *target_dt, int notification_idx, ompi_win_t *win);
+
+int ompi_osc_rdma_notify_counters (ompi_win_t *win, opal_atomic_int64_t **counters, int *count);
+
 /**
  * @brief read data from a remote memory region (blocking)
  *
@@ -122,4 +132,13 @@ int ompi_osc_rdma_put_contig (ompi_osc_rdma_sync_t *sync, ompi_osc_rdma_peer_t *
                               mca_btl_base_registration_handle_t *target_handle, void *source_buffer, size_t size,
                               ompi_osc_rdma_request_t *request);
 
+/**
+ * @brief start the small puts combined for a peer, if any
+ *
+ * @param[in] peer            peer object
+ *
+ * Called before an operation that must see the earlier puts to the peer.
+ */
+int ompi_osc_rdma_put_coalesce_flush (ompi_osc_rdma_peer_t *peer);
+
 #endif /* OMPI_OSC_RDMA_COMM_H */
@@ -90,6 +90,7 @@ static char *ompi_osc_rdma_btl_alternate_names;
 static const mca_base_var_enum_value_t ompi_osc_rdma_locking_modes[] = {
     {.value = OMPI_OSC_RDMA_LOCKING_TWO_LEVEL, .string = "two_level"},
     {.value = OMPI_OSC_RDMA_LOCKING_ON_DEMAND, .string = "on_demand"},
+    {.value = OMPI_OSC_RDMA_LOCKING_MCS, .string = "mcs"},
     {.string = NULL},
 };
 
@@ -148,6 +149,10 @@ ompi_osc_base_module_t ompi_osc_rdma_module_rdma_template = {
     .osc_flush_all = ompi_osc_rdma_flush_all,
     .osc_flush_local = ompi_osc_rdma_flush_local,
     .osc_flush_local_all = ompi_osc_rdma_flush_local_all,
+
+    .osc_put_notify = ompi_osc_rdma_put_notify,
+    .osc_get_notify = ompi_osc_rdma_get_notify,
+    .osc_win_notify_counters = ompi_osc_rdma_notify_counters,
 };
 
 /* look up parameters for configuring this window.  The code first
@@ -172,6 +177,45 @@ static bool check_config_value_bool (char *key, opal_info_t *info)
     return flag_value[0];
 }
 
+/* number of notification counters from the mpix_num_notifications info key. it must be the same on all the
+ * processes, as the counters are part of the state structure */
+static int check_config_value_notify_count (opal_info_t *info)
+{
+    opal_cstring_t *value;
+    int count = 0, flag;
+
+    if (NULL != info && OPAL_SUCCESS == opal_info_get (info, "mpix_num_notifications", &value, &flag) && flag) {
+        if (OPAL_SUCCESS != opal_cstring_to_int (value, &count) || count < 0) {
+            count = 0;
+        }
+        OBJ_RELEASE(value);
+    }
+
+    return count;
+}
+
+/* locking mode of the window from the osc_rdma_locking_mode info key, or the MCA variable */
+static int check_config_value_locking_mode (opal_info_t *info)
+{
+    int locking_mode = mca_osc_rdma_component.locking_mode;
+    mca_base_var_enum_t *locking_enum;
+    int flag;
+
+    if (OPAL_SUCCESS != mca_base_var_enum_create ("osc_rdma_locking_mode_info", ompi_osc_rdma_locking_modes,
+                                                  &locking_enum)) {
+        return locking_mode;
+    }
+
+    if (OPAL_SUCCESS != opal_info_get_value_enum (info, "osc_rdma_locking_mode", &locking_mode,
+                                                  mca_osc_rdma_component.locking_mode, locking_enum, &flag)) {
+        /* unknown mode */
+        locking_mode = mca_osc_rdma_component.locking_mode;
+    }
+    OBJ_RELEASE(locking_enum);
+
+    return locking_mode;
+}
+
 static int ompi_osc_rdma_pvar_read (const struct mca_base_pvar_t *pvar, void *value, void *obj)
 {
     ompi_win_t *win = (ompi_win_t *) obj;
@@ -251,7 +295,10 @@ static int ompi_osc_rdma_component_register (void)
 
     mca_osc_rdma_component.locking_mode = OMPI_OSC_RDMA_LOCKING_TWO_LEVEL;
     (void) mca_base_component_var_register (&mca_osc_rdma_component.super.osc_version, "locking_mode",
-                                            "Locking mode to use for passive-target synchronization (default: two_level)",
+                                            "Locking mode to use for passive-target synchronization. mcs is two_level "
+                                            "with the exclusive lock waiters queued, each spinning on its own state "
+                                            "instead of on the lock of the target. The osc_rdma_locking_mode info key "
+                                            "overrides this value (default: two_level)",
                                             MCA_BASE_VAR_TYPE_INT, new_enum, 0, 0, OPAL_INFO_LVL_3,
                                             MCA_BASE_VAR_SCOPE_GROUP, &mca_osc_rdma_component.locking_mode);
     OBJ_RELEASE(new_enum);
@@ -305,6 +352,26 @@ static int ompi_osc_rdma_component_register (void)
                                             MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL, 0, 0, OPAL_INFO_LVL_3,
                                             MCA_BASE_VAR_SCOPE_LOCAL, &mca_osc_rdma_component.network_amo_max_count);
 
+    mca_osc_rdma_component.put_coalesce_size = 0;
+    (void) mca_base_component_var_register (&mca_osc_rdma_component.super.osc_version, "put_coalesce_size",
+                                            "Size of the buffer small contiguous puts to a peer are combined in "
+                                            "when they target adjacent memory. The buffer is written with a single "
+                                            "put when it is full, when a put does not follow the previous one and "
+                                            "at the next synchronization. Disabled with multiple threads and "
+                                            "capped at half of buffer_size. 0 disables (default: 0)",
+                                            MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                            MCA_BASE_VAR_SCOPE_LOCAL, &mca_osc_rdma_component.put_coalesce_size);
+
+    mca_osc_rdma_component.segment_pool_size = 0;
+    (void) mca_base_component_var_register (&mca_osc_rdma_component.super.osc_version, "segment_pool_size",
+                                            "Maximum number of bytes of registered memory kept from freed windows "
+                                            "that do not share memory with other processes (the internal state and, "
+                                            "for MPI_Win_allocate, the window memory). A new window reuses a kept "
+                                            "segment of at least its size and at most twice its size instead of "
+                                            "allocating and registering one. 0 disables (default: 0)",
+                                            MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                            MCA_BASE_VAR_SCOPE_LOCAL, &mca_osc_rdma_component.segment_pool_size);
+
     /* register performance variables */
 
     (void) mca_base_component_pvar_register (&mca_osc_rdma_component.super.osc_version, "put_retry_count",
@@ -321,6 +388,49 @@ static int ompi_osc_rdma_component_register (void)
                                              ompi_osc_rdma_pvar_read, NULL, NULL,
                                              (void *) (intptr_t) offsetof (ompi_osc_rdma_module_t, get_retry_count));
 
+    (void) mca_base_component_pvar_register (&mca_osc_rdma_component.super.osc_version, "put_coalesce_count",
+                                             "Number of puts combined with an earlier put to the same peer",
+                                             OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER, MCA_BASE_VAR_TYPE_UNSIGNED_LONG,
+                                             NULL, MCA_BASE_VAR_BIND_MPI_WIN, MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                             ompi_osc_rdma_pvar_read, NULL, NULL,
+                                             (void *) (intptr_t) offsetof (ompi_osc_rdma_module_t, put_coalesce_count));
+
+    (void) mca_base_component_pvar_register (&mca_osc_rdma_component.super.osc_version, "acc_amo_count",
+                                             "Number of accumulate elements executed with network atomic operations",
+                                             OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER, MCA_BASE_VAR_TYPE_UNSIGNED_LONG,
+                                             NULL, MCA_BASE_VAR_BIND_MPI_WIN, MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                             ompi_osc_rdma_pvar_read, NULL, NULL,
+                                             (void *) (intptr_t) offsetof (ompi_osc_rdma_module_t, acc_amo_count));
+
+    (void) mca_base_component_pvar_register (&mca_osc_rdma_component.super.osc_version, "acc_cas_count",
+                                             "Number of accumulate elements executed with network compare-and-swap",
+                                             OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER, MCA_BASE_VAR_TYPE_UNSIGNED_LONG,
+                                             NULL, MCA_BASE_VAR_BIND_MPI_WIN, MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                             ompi_osc_rdma_pvar_read, NULL, NULL,
+                                             (void *) (intptr_t) offsetof (ompi_osc_rdma_module_t, acc_cas_count));
+
+    (void) mca_base_component_pvar_register (&mca_osc_rdma_component.super.osc_version, "acc_get_op_put_count",
+                                             "Number of accumulate elements executed with a get, a local operation and a put",
+                                             OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER, MCA_BASE_VAR_TYPE_UNSIGNED_LONG,
+                                             NULL, MCA_BASE_VAR_BIND_MPI_WIN, MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                             ompi_osc_rdma_pvar_read, NULL, NULL,
+                                             (void *) (intptr_t) offsetof (ompi_osc_rdma_module_t, acc_get_op_put_count));
+
+    {
+        static const mca_base_var_type_t types[] = {MCA_BASE_VAR_TYPE_INT, MCA_BASE_VAR_TYPE_INT};
+        static const size_t offsets[] = {offsetof (ompi_osc_rdma_event_lock_t, target),
+                                         offsetof (ompi_osc_rdma_event_lock_t, lock_type)};
+        int index;
+
+        index = mca_base_component_event_register (&mca_osc_rdma_component.super.osc_version, "lock_acquired",
+                                                   "A passive target lock was acquired (elements: target or -1 "
+                                                   "for MPI_Win_lock_all, lock type)", OPAL_INFO_LVL_5, types,
+                                                   offsets, 2, NULL, MCA_BASE_VAR_BIND_MPI_WIN, 0);
+        if (0 <= index) {
+            (void) mca_base_event_get (index, &mca_osc_rdma_component.event_lock_acquired);
+        }
+    }
+
     return OMPI_SUCCESS;
 }
 
@@ -332,6 +442,8 @@ static int ompi_osc_rdma_component_init (bool enable_progress_threads,
     OBJ_CONSTRUCT(&mca_osc_rdma_component.lock, opal_mutex_t);
     OBJ_CONSTRUCT(&mca_osc_rdma_component.request_gc, opal_list_t);
     OBJ_CONSTRUCT(&mca_osc_rdma_component.buffer_gc, opal_list_t);
+    OBJ_CONSTRUCT(&mca_osc_rdma_component.segment_pool, opal_list_t);
+    mca_osc_rdma_component.segment_pool_used = 0;
     OBJ_CONSTRUCT(&mca_osc_rdma_component.modules, opal_hash_table_t);
 
     opal_hash_table_init(&mca_osc_rdma_component.modules, 2);
@@ -366,6 +478,7 @@ static int ompi_osc_rdma_component_init (bool enable_progress_threads,
 
 int ompi_osc_rdma_component_finalize (void)
 {
+    ompi_osc_rdma_pool_segment_t *segment;
     size_t num_modules;
 
     if (0 != (num_modules = opal_hash_table_get_size(&mca_osc_rdma_component.modules))) {
@@ -373,6 +486,13 @@ int ompi_osc_rdma_component_finalize (void)
                     "not freed.", (int) num_modules);
     }
 
+    while (NULL != (segment = (ompi_osc_rdma_pool_segment_t *) opal_list_remove_first (&mca_osc_rdma_component.segment_pool))) {
+        segment->btl->btl_deregister_mem (segment->btl, segment->handle);
+        free (segment->base);
+        OBJ_RELEASE(segment);
+    }
+    OBJ_DESTRUCT(&mca_osc_rdma_component.segment_pool);
+
     OBJ_DESTRUCT(&mca_osc_rdma_component.frags);
     OBJ_DESTRUCT(&mca_osc_rdma_component.modules);
     OBJ_DESTRUCT(&mca_osc_rdma_component.lock);
@@ -446,8 +566,75 @@ static int ompi_osc_rdma_initialize_region (ompi_osc_rdma_module_t *module, void
     return OMPI_SUCCESS;
 }
 
+OBJ_CLASS_INSTANCE(ompi_osc_rdma_pool_segment_t, opal_list_item_t, NULL, NULL);
+
+/* take a registered segment of at least size bytes from the pool, NULL if there is none */
+static ompi_osc_rdma_pool_segment_t *ompi_osc_rdma_segment_pool_get (ompi_osc_rdma_module_t *module, size_t size)
+{
+    ompi_osc_rdma_pool_segment_t *segment, *found = NULL;
+
+    if (0 == mca_osc_rdma_component.segment_pool_size || !module->use_memory_registration) {
+        return NULL;
+    }
+
+    OPAL_THREAD_LOCK(&mca_osc_rdma_component.lock);
+    OPAL_LIST_FOREACH(segment, &mca_osc_rdma_component.segment_pool, ompi_osc_rdma_pool_segment_t) {
+        /* do not waste more than half of a segment */
+        if (segment->btl == module->selected_btls[0] && segment->size >= size && segment->size <= 2 * size &&
+            (NULL == found || segment->size < found->size)) {
+            found = segment;
+        }
+    }
+
+    if (NULL != found) {
+        opal_list_remove_item (&mca_osc_rdma_component.segment_pool, &found->super);
+        mca_osc_rdma_component.segment_pool_used -= found->size;
+    }
+    OPAL_THREAD_UNLOCK(&mca_osc_rdma_component.lock);
+
+    return found;
+}
+
+void ompi_osc_rdma_segment_pool_return (ompi_osc_rdma_module_t *module)
+{
+    ompi_osc_rdma_pool_segment_t *segment;
+    size_t size = module->free_after_size;
+
+    if (0 == size || NULL == module->state_handle || NULL == module->selected_btls) {
+        return;
+    }
+
+    OPAL_THREAD_LOCK(&mca_osc_rdma_component.lock);
+    if (mca_osc_rdma_component.segment_pool_used + size > mca_osc_rdma_component.segment_pool_size) {
+        OPAL_THREAD_UNLOCK(&mca_osc_rdma_component.lock);
+        return;
+    }
+
+    segment = OBJ_NEW(ompi_osc_rdma_pool_segment_t);
+    if (NULL == segment) {
+        OPAL_THREAD_UNLOCK(&mca_osc_rdma_component.lock);
+        return;
+    }
+
+    segment->base = module->free_after;
+    segment->size = size;
+    segment->btl = module->selected_btls[0];
+    segment->handle = module->state_handle;
+    opal_list_append (&mca_osc_rdma_component.segment_pool, &segment->super);
+    mca_osc_rdma_component.segment_pool_used += size;
+    OPAL_THREAD_UNLOCK(&mca_osc_rdma_component.lock);
+
+    OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_INFO, "keeping registered segment %p (%lu bytes) for the next window",
+                     segment->base, (unsigned long) size);
+
+    module->free_after = NULL;
+    module->free_after_size = 0;
+    module->state_handle = NULL;
+}
+
 static int allocate_state_single (ompi_osc_rdma_module_t *module, void **base, size_t size)
 {
+    ompi_osc_rdma_pool_segment_t *segment;
     size_t total_size, local_rank_array_size, leader_peer_data_size;
     ompi_osc_rdma_peer_t *my_peer;
     int ret, my_rank;
@@ -473,9 +660,21 @@ static int allocate_state_single (ompi_osc_rdma_module_t *module, void **base, s
      * (if using MPI_Win_allocate). In this case the leader peer data array does not need to be stored in the same
      * segment but placing it there simplifies the peer data fetch and cleanup code. */
 
-    module->rank_array = calloc (total_size, 1);
-    if (OPAL_UNLIKELY(NULL == module->rank_array)) {
-        return OMPI_ERR_OUT_OF_RESOURCE;
+    segment = ompi_osc_rdma_segment_pool_get (module, total_size);
+    if (NULL != segment) {
+        OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_INFO, "reusing registered segment %p (%lu bytes)", segment->base,
+                         (unsigned long) segment->size);
+        /* same state as a new allocation */
+        memset (segment->base, 0, total_size);
+        module->rank_array = segment->base;
+        module->state_handle = segment->handle;
+        total_size = segment->size;
+        OBJ_RELEASE(segment);
+    } else {
+        module->rank_array = calloc (total_size, 1);
+        if (OPAL_UNLIKELY(NULL == module->rank_array)) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
     }
 
 // Note, the extra module->region_size space added after local_rank_array_size
@@ -491,11 +690,15 @@ static int allocate_state_single (ompi_osc_rdma_module_t *module, void **base, s
         *base = (void *) ((intptr_t) module->node_comm_info + leader_peer_data_size);
     }
 
-    /* just go ahead and register the whole segment */
-    ret = ompi_osc_rdma_register (module, MCA_BTL_ENDPOINT_ANY, module->rank_array, total_size,
-                                  MCA_BTL_REG_FLAG_ACCESS_ANY, &module->state_handle);
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
-        return ret;
+    if (NULL == module->state_handle) {
+        /* just go ahead and register the whole segment */
+        ret = ompi_osc_rdma_register (module, MCA_BTL_ENDPOINT_ANY, module->rank_array, total_size,
+                                      MCA_BTL_REG_FLAG_ACCESS_ANY, &module->state_handle);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+            free (module->rank_array);
+            module->rank_array = NULL;
+            return ret;
+        }
     }
 
     if (MPI_WIN_FLAVOR_DYNAMIC != module->flavor) {
@@ -518,6 +721,7 @@ static int allocate_state_single (ompi_osc_rdma_module_t *module, void **base, s
 
     module->my_peer = my_peer;
     module->free_after = module->rank_array;
+    module->free_after_size = total_size;
     my_peer->flags |= OMPI_OSC_RDMA_PEER_LOCAL_BASE;
     my_peer->state = (uint64_t) (uintptr_t) module->state;
 
@@ -1329,11 +1533,20 @@ static int ompi_osc_rdma_component_select (struct ompi_win_t *win, void **base,
     module->same_disp_unit = check_config_value_bool ("same_disp_unit", info);
     module->same_size      = check_config_value_bool ("same_size", info);
     module->no_locks       = check_config_value_bool ("no_locks", info);
-    module->locking_mode   = mca_osc_rdma_component.locking_mode;
+    module->locking_mode   = check_config_value_locking_mode (info);
     module->acc_single_intrinsic = check_config_value_bool ("acc_single_intrinsic", info);
+    module->notify_count   = check_config_value_notify_count (info);
     module->acc_use_amo = mca_osc_rdma_component.acc_use_amo;
     module->network_amo_max_count = mca_osc_rdma_component.network_amo_max_count;
 
+    /* the combining buffers are not protected against concurrent puts */
+    if (!opal_using_threads ()) {
+        module->put_coalesce_size = mca_osc_rdma_component.put_coalesce_size;
+        if (module->put_coalesce_size > (mca_osc_rdma_component.buffer_size >> 1)) {
+            module->put_coalesce_size = mca_osc_rdma_component.buffer_size >> 1;
+        }
+    }
+
     module->selected_btls_size = MCA_OSC_RDMA_BTLS_SIZE_INIT;
     module->selected_btls = calloc(module->selected_btls_size, sizeof(struct mca_btl_base_module_t *));
 
@@ -1415,6 +1628,11 @@ static int ompi_osc_rdma_component_select (struct ompi_win_t *win, void **base,
     } else {
         module->state_size += mca_osc_rdma_component.max_attach * module->region_size;
     }
+
+    /* notification counters follow the regions */
+    module->state_size += OPAL_ALIGN_PAD_AMOUNT(module->state_size, sizeof (int64_t));
+    module->notify_offset = module->state_size;
+    module->state_size += module->notify_count * sizeof (int64_t);
 /*
  * These are the info's that this module is interested in
  */
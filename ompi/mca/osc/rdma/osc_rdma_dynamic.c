@@ -4,6 +4,9 @@
  *                         reserved.
  * Copyright (c) 2020-2021 Google, LLC. All rights reserved.
  * Copyright (c) 2020      Intel, Inc.  All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -367,6 +370,20 @@ int ompi_osc_rdma_detach (struct ompi_win_t *win, const void *base)
     return OMPI_SUCCESS;
 }
 
+/**
+ * @brief drop the cached view of the dynamic memory regions of a peer
+ */
+static void ompi_osc_rdma_invalidate_dynamic_cache (ompi_osc_rdma_module_t *module, ompi_osc_rdma_peer_dynamic_t *peer)
+{
+    for (uint32_t i = 0 ; i < peer->region_count ; ++i) {
+        ompi_osc_rdma_region_t *region = (ompi_osc_rdma_region_t *) ((intptr_t) peer->regions + i * module->region_size);
+        (void) opal_interval_tree_delete (&peer->region_tree, region->base, region->base + region->len - 1, region);
+    }
+
+    peer->region_id = 0;
+    peer->region_count = 0;
+}
+
 /**
  * @brief refresh the local view of the dynamic memory region
  *
@@ -374,24 +391,25 @@ int ompi_osc_rdma_detach (struct ompi_win_t *win, const void *base)
  * @param[in] peer           peer object to refresh
  *
  * This function does the work of keeping the local view of a remote peer in sync with what is attached
- * to the remote window. It is called on every address translation since there is no way (currently) to
- * detect that the attached regions have changed. To reduce the amount of data read we first read the
- * region count (which contains an id). If that hasn't changed the region data is not updated. If the
- * list of attached regions has changed then all valid regions are read from the peer while holding
- * their region lock.
+ * to the remote window. It is called with the module lock held on every address translation since there
+ * is no way (currently) to detect that the attached regions have changed. The region count contains a
+ * generation id in its upper half, so validating the cached copy takes a single get. If the list of
+ * attached regions has changed then all valid regions are read from the peer while holding their region
+ * lock, and indexed by address range.
  */
 static int ompi_osc_rdma_refresh_dynamic_region (ompi_osc_rdma_module_t *module, ompi_osc_rdma_peer_dynamic_t *peer) {
-    osc_rdma_counter_t region_count, region_id;
+    osc_rdma_counter_t region_count, region_id, remote_value;
     uint64_t source_address;
+    unsigned region_len;
+    void *temp;
     int ret;
 
     OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "refreshing dynamic memory regions for target %d", peer->super.rank);
 
+    source_address = (uint64_t)(intptr_t) peer->super.state + offsetof (ompi_osc_rdma_state_t, region_count);
+
     /* this loop is meant to prevent us from reading data while the remote side is in attach */
     do {
-        osc_rdma_counter_t remote_value;
-
-        source_address = (uint64_t)(intptr_t) peer->super.state + offsetof (ompi_osc_rdma_state_t, region_count);
         ret = ompi_osc_get_data_blocking (module, peer->super.state_btl_index, peer->super.state_endpoint,
                                           source_address, peer->super.state_handle, &remote_value,
                                           sizeof (remote_value));
@@ -412,43 +430,63 @@ static int ompi_osc_rdma_refresh_dynamic_region (ompi_osc_rdma_module_t *module,
     }
 
     /* check if the cached copy is out of date */
-    OPAL_THREAD_LOCK(&module->lock);
+    if (peer->region_id == region_id) {
+        return OMPI_SUCCESS;
+    }
 
-    if (peer->region_id != region_id) {
-        unsigned region_len = module->region_size * region_count;
-        void *temp;
+    OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_DEBUG, "dynamic memory cache is out of data. reloading from peer");
 
-        OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_DEBUG, "dynamic memory cache is out of data. reloading from peer");
+    ompi_osc_rdma_invalidate_dynamic_cache (module, peer);
 
-        /* allocate only enough space for the remote regions */
-        temp = realloc (peer->regions, region_len);
-        if (NULL == temp) {
-            OPAL_THREAD_UNLOCK(&module->lock);
-            return OMPI_ERR_OUT_OF_RESOURCE;
-        }
-        peer->regions = temp;
+    /* lock the region */
+    ompi_osc_rdma_lock_acquire_shared (module, &peer->super, 1, offsetof (ompi_osc_rdma_state_t, regions_lock),
+                                       OMPI_OSC_RDMA_LOCK_EXCLUSIVE);
 
-        /* lock the region */
-        ompi_osc_rdma_lock_acquire_shared (module, &peer->super, 1, offsetof (ompi_osc_rdma_state_t, regions_lock),
-                                           OMPI_OSC_RDMA_LOCK_EXCLUSIVE);
+    /* the regions may have changed since the count was read */
+    ret = ompi_osc_get_data_blocking (module, peer->super.state_btl_index, peer->super.state_endpoint,
+                                      source_address, peer->super.state_handle, &remote_value,
+                                      sizeof (remote_value));
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        goto unlock;
+    }
 
-        source_address = (uint64_t)(intptr_t) peer->super.state + offsetof (ompi_osc_rdma_state_t, regions);
-        ret = ompi_osc_get_data_blocking (module, peer->super.state_btl_index, peer->super.state_endpoint,
-                                          source_address, peer->super.state_handle, peer->regions, region_len);
-        if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
-            OPAL_THREAD_UNLOCK(&module->lock);
-            return ret;
-        }
+    region_id = remote_value >> 32;
+    region_count = remote_value & 0xffffffffl;
+    if (0 == region_count) {
+        ret = OMPI_ERR_RMA_RANGE;
+        goto unlock;
+    }
+
+    /* allocate only enough space for the remote regions */
+    region_len = module->region_size * region_count;
+    temp = realloc (peer->regions, region_len);
+    if (NULL == temp) {
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto unlock;
+    }
+    peer->regions = temp;
 
-        /* release the region lock */
-        ompi_osc_rdma_lock_release_shared (module, &peer->super, -1, offsetof (ompi_osc_rdma_state_t, regions_lock));
+    source_address = (uint64_t)(intptr_t) peer->super.state + offsetof (ompi_osc_rdma_state_t, regions);
+    ret = ompi_osc_get_data_blocking (module, peer->super.state_btl_index, peer->super.state_endpoint,
+                                      source_address, peer->super.state_handle, peer->regions, region_len);
 
-        /* update cached region ids */
-        peer->region_id = region_id;
-        peer->region_count = region_count;
+unlock:
+    /* release the region lock */
+    ompi_osc_rdma_lock_release_shared (module, &peer->super, -1, offsetof (ompi_osc_rdma_state_t, regions_lock));
+
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        return ret;
     }
 
-    OPAL_THREAD_UNLOCK(&module->lock);
+    for (osc_rdma_counter_t i = 0 ; i < region_count ; ++i) {
+        ompi_osc_rdma_region_t *region = (ompi_osc_rdma_region_t *) ((intptr_t) peer->regions + i * module->region_size);
+        /* a region missing from the tree is still found by the search of the array */
+        (void) opal_interval_tree_insert (&peer->region_tree, region, region->base, region->base + region->len - 1);
+    }
+
+    /* update cached region ids */
+    peer->region_id = region_id;
+    peer->region_count = region_count;
 
     OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "finished refreshing dynamic memory regions for target %d", peer->super.rank);
 
@@ -460,37 +498,43 @@ int ompi_osc_rdma_find_dynamic_region (ompi_osc_rdma_module_t *module, ompi_osc_
 {
     ompi_osc_rdma_peer_dynamic_t *dy_peer = (ompi_osc_rdma_peer_dynamic_t *) peer;
     intptr_t bound = (intptr_t) base + len;
-    ompi_osc_rdma_region_t *regions;
-    int ret = OMPI_SUCCESS, region_count;
+    ompi_osc_rdma_region_t *found;
+    int ret;
 
     OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_TRACE, "locating dynamic memory region matching: {%" PRIx64 ", %" PRIx64 "}"
                      " (len %lu)", base, base + len, (unsigned long) len);
 
-    OPAL_THREAD_LOCK(&module->lock);
-    // Make sure region isn't being touched.
-    ompi_osc_rdma_lock_acquire_exclusive (module, peer, offsetof (ompi_osc_rdma_state_t, regions_lock));
-    if (!ompi_osc_rdma_peer_local_state (peer)) {
-        ret = ompi_osc_rdma_refresh_dynamic_region (module, dy_peer);
-        if (OMPI_SUCCESS != ret) {
-            ompi_osc_rdma_lock_release_exclusive (module, peer, offsetof (ompi_osc_rdma_state_t, regions_lock));
-            return ret;
-        }
-
-        regions = dy_peer->regions;
-        region_count = dy_peer->region_count;
-    } else {
+    if (ompi_osc_rdma_peer_local_state (peer)) {
         ompi_osc_rdma_state_t *peer_state = (ompi_osc_rdma_state_t *) peer->state;
-        regions = (ompi_osc_rdma_region_t *) peer_state->regions;
-        region_count = peer_state->region_count;
+
+        /* the regions are read in place, keep them from changing */
+        ompi_osc_rdma_lock_acquire_shared (module, peer, 1, offsetof (ompi_osc_rdma_state_t, regions_lock),
+                                           OMPI_OSC_RDMA_LOCK_EXCLUSIVE);
+        *region = ompi_osc_rdma_find_region_containing ((ompi_osc_rdma_region_t *) peer_state->regions, 0,
+                                                        (int) (peer_state->region_count & 0xffffffffl) - 1,
+                                                        (intptr_t) base, bound, module->region_size, NULL);
+        ompi_osc_rdma_lock_release_shared (module, peer, -1, offsetof (ompi_osc_rdma_state_t, regions_lock));
+
+        return *region ? OMPI_SUCCESS : OMPI_ERR_RMA_RANGE;
     }
 
-    *region = ompi_osc_rdma_find_region_containing (regions, 0, region_count - 1, (intptr_t) base, bound, module->region_size, NULL);
-    if (!*region) {
-        ret = OMPI_ERR_RMA_RANGE;
+    OPAL_THREAD_LOCK(&module->lock);
+    ret = ompi_osc_rdma_refresh_dynamic_region (module, dy_peer);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        OPAL_THREAD_UNLOCK(&module->lock);
+        return ret;
     }
+
+    found = (ompi_osc_rdma_region_t *) opal_interval_tree_find_overlapping (&dy_peer->region_tree, base,
+                                                                             (len ? bound - 1 : bound));
+    if (NULL == found || found->base > (intptr_t) base || (intptr_t) (found->base + found->len) < bound) {
+        /* the page aligned regions may overlap, look for one containing the whole range */
+        found = ompi_osc_rdma_find_region_containing (dy_peer->regions, 0, (int) dy_peer->region_count - 1,
+                                                      (intptr_t) base, bound, module->region_size, NULL);
+    }
+
+    *region = found;
     OPAL_THREAD_UNLOCK(&module->lock);
-    ompi_osc_rdma_lock_release_exclusive (module, peer, offsetof (ompi_osc_rdma_state_t, regions_lock));
 
-    /* round a matching region */
-    return ret;
+    return found ? OMPI_SUCCESS : OMPI_ERR_RMA_RANGE;
 }
@@ -94,6 +94,7 @@ int ompi_osc_rdma_free(ompi_win_t *win)
     OBJ_DESTRUCT(&module->peer_lock);
     OBJ_DESTRUCT(&module->all_sync);
 
+    ompi_osc_rdma_segment_pool_return (module);
     ompi_osc_rdma_deregister (module, module->state_handle);
     ompi_osc_rdma_deregister (module, module->base_handle);
 
@@ -139,6 +140,7 @@ int ompi_osc_rdma_free(ompi_win_t *win)
     }
 
     free (module->peer_array);
+    free (module->wc_peers);
     free (module->outstanding_lock_array);
     free (module->free_after);
     free (module->selected_btls);
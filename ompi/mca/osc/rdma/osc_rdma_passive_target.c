@@ -111,6 +111,156 @@ int ompi_osc_rdma_flush_local_all (struct ompi_win_t *win)
     return ompi_osc_rdma_flush_all (win);
 }
 
+/* swap a value in the state of a peer (mcs locking mode) */
+static int ompi_osc_rdma_mcs_swap (ompi_osc_rdma_module_t *module, ompi_osc_rdma_peer_t *peer, ptrdiff_t offset,
+                                   ompi_osc_rdma_lock_t value, ompi_osc_rdma_lock_t *result)
+{
+    uint64_t address = (uint64_t) (intptr_t) peer->state + offset;
+
+    if (!ompi_osc_rdma_peer_local_state (peer)) {
+        return ompi_osc_rdma_lock_btl_fop (module, peer, address, MCA_BTL_ATOMIC_SWAP, value, result, true);
+    }
+
+    *result = opal_atomic_swap_64 ((opal_atomic_int64_t *) (intptr_t) address, value);
+
+    return OMPI_SUCCESS;
+}
+
+/* peer of a queue entry, NULL if it can not be set up */
+static ompi_osc_rdma_peer_t *ompi_osc_rdma_mcs_peer (ompi_osc_rdma_module_t *module, ompi_osc_rdma_lock_t entry)
+{
+    return ompi_osc_rdma_module_peer (module, OMPI_OSC_RDMA_MCS_RANK(entry));
+}
+
+static ompi_osc_rdma_lock_t ompi_osc_rdma_mcs_read (ompi_osc_rdma_lock_t *value)
+{
+    opal_atomic_rmb ();
+    return *((volatile ompi_osc_rdma_lock_t *) value);
+}
+
+/**
+ * Queue for the exclusive lock of a peer (mcs locking mode).
+ *
+ * Swaps the queue entry of this process into the tail of the queue of the
+ * peer and links it behind the previous waiter, if any. Returns once the
+ * previous waiter has released the lock, after spinning on the queue node
+ * in the state of this process. The caller still has to take the exclusive
+ * lock of the peer, the queue only keeps the exclusive waiters from all
+ * hitting it at the same time. Fails if the state btl can not swap or if
+ * this process has no free queue node, the caller then spins on the lock.
+ */
+static int ompi_osc_rdma_mcs_enqueue (ompi_osc_rdma_module_t *module, ompi_osc_rdma_peer_t *peer)
+{
+    mca_btl_base_module_t *btl = ompi_osc_rdma_selected_btl (module, peer->state_btl_index);
+    ompi_osc_rdma_mcs_node_t *node;
+    ompi_osc_rdma_lock_t entry, prev, unused;
+    ompi_osc_rdma_peer_t *prev_peer;
+    int32_t used, index;
+    int ret;
+
+    if (!ompi_osc_rdma_peer_local_state (peer) && !(btl->btl_atomic_flags & MCA_BTL_ATOMIC_SUPPORTS_SWAP)) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    do {
+        used = module->mcs_nodes_used;
+        for (index = 0 ; index < OMPI_OSC_RDMA_MCS_NODES && (used & (1 << index)) ; ++index);
+        if (OMPI_OSC_RDMA_MCS_NODES == index) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+    } while (!opal_atomic_compare_exchange_strong_32 (&module->mcs_nodes_used, &used, used | (1 << index)));
+
+    node = module->state->mcs_nodes + index;
+    node->next = 0;
+    node->locked = 1;
+    opal_atomic_wmb ();
+
+    entry = OMPI_OSC_RDMA_MCS_ENCODE(ompi_comm_rank (module->comm), index);
+
+    ret = ompi_osc_rdma_mcs_swap (module, peer, offsetof (ompi_osc_rdma_state_t, mcs_tail), entry, &prev);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        (void) opal_atomic_fetch_and_32 (&module->mcs_nodes_used, ~(1 << index));
+        return ret;
+    }
+
+    peer->mcs_node = index + 1;
+
+    if (0 == prev) {
+        OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_DEBUG, "exclusive lock queue of peer %d was empty", peer->rank);
+        return OMPI_SUCCESS;
+    }
+
+    prev_peer = ompi_osc_rdma_mcs_peer (module, prev);
+    if (OPAL_UNLIKELY(NULL == prev_peer)) {
+        /* the queue is broken, the lock itself still protects the epoch */
+        return OMPI_SUCCESS;
+    }
+
+    OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_DEBUG, "waiting behind rank %d for the exclusive lock of peer %d",
+                     prev_peer->rank, peer->rank);
+
+    ret = ompi_osc_rdma_mcs_swap (module, prev_peer, offsetof (ompi_osc_rdma_state_t, mcs_nodes) +
+                                  OMPI_OSC_RDMA_MCS_INDEX(prev) * sizeof (ompi_osc_rdma_mcs_node_t) +
+                                  offsetof (ompi_osc_rdma_mcs_node_t, next), entry, &unused);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+        return OMPI_SUCCESS;
+    }
+
+    while (ompi_osc_rdma_mcs_read (&node->locked)) {
+        ompi_osc_rdma_progress (module);
+    }
+
+    return OMPI_SUCCESS;
+}
+
+/* hand the exclusive lock of a peer to the next waiter in its queue (mcs locking mode) */
+static void ompi_osc_rdma_mcs_dequeue (ompi_osc_rdma_module_t *module, ompi_osc_rdma_peer_t *peer)
+{
+    const int index = peer->mcs_node - 1;
+    ompi_osc_rdma_mcs_node_t *node = module->state->mcs_nodes + index;
+    ompi_osc_rdma_lock_t entry = OMPI_OSC_RDMA_MCS_ENCODE(ompi_comm_rank (module->comm), index);
+    ompi_osc_rdma_lock_t next, unused;
+    ompi_osc_rdma_peer_t *next_peer;
+    int ret;
+
+    peer->mcs_node = 0;
+
+    next = ompi_osc_rdma_mcs_read (&node->next);
+    if (0 == next) {
+        uint64_t tail = (uint64_t) (intptr_t) peer->state + offsetof (ompi_osc_rdma_state_t, mcs_tail);
+        ompi_osc_rdma_lock_t prev = entry;
+
+        /* no waiter linked yet. empty the queue if this process is still its tail */
+        if (!ompi_osc_rdma_peer_local_state (peer)) {
+            ret = ompi_osc_rdma_lock_btl_cswap (module, peer, tail, entry, 0, &prev);
+        } else {
+            (void) opal_atomic_compare_exchange_strong_64 ((opal_atomic_int64_t *) (intptr_t) tail, &prev, 0);
+            ret = OMPI_SUCCESS;
+        }
+
+        if (OMPI_SUCCESS == ret && prev == entry) {
+            (void) opal_atomic_fetch_and_32 (&module->mcs_nodes_used, ~(1 << index));
+            return;
+        }
+
+        /* a waiter swapped itself in and is about to link */
+        while (0 == (next = ompi_osc_rdma_mcs_read (&node->next))) {
+            ompi_osc_rdma_progress (module);
+        }
+    }
+
+    next_peer = ompi_osc_rdma_mcs_peer (module, next);
+    if (OPAL_LIKELY(NULL != next_peer)) {
+        OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_DEBUG, "handing the exclusive lock of peer %d to rank %d",
+                         peer->rank, next_peer->rank);
+        (void) ompi_osc_rdma_mcs_swap (module, next_peer, offsetof (ompi_osc_rdma_state_t, mcs_nodes) +
+                                       OMPI_OSC_RDMA_MCS_INDEX(next) * sizeof (ompi_osc_rdma_mcs_node_t) +
+                                       offsetof (ompi_osc_rdma_mcs_node_t, locked), 0, &unused);
+    }
+
+    (void) opal_atomic_fetch_and_32 (&module->mcs_nodes_used, ~(1 << index));
+}
+
 /* locking via atomics */
 static inline int ompi_osc_rdma_lock_atomic_internal (ompi_osc_rdma_module_t *module, ompi_osc_rdma_peer_t *peer,
                                                       ompi_osc_rdma_sync_t *lock)
@@ -119,9 +269,14 @@ static inline int ompi_osc_rdma_lock_atomic_internal (ompi_osc_rdma_module_t *mo
     int ret;
 
     if (MPI_LOCK_EXCLUSIVE == lock->sync.lock.type) {
+        if (OMPI_OSC_RDMA_LOCKING_MCS == locking_mode) {
+            /* wait in the queue of the peer, on failure spin on the lock like the other modes */
+            (void) ompi_osc_rdma_mcs_enqueue (module, peer);
+        }
+
         do {
             OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_DEBUG, "incrementing global exclusive lock");
-            if (OMPI_OSC_RDMA_LOCKING_TWO_LEVEL == locking_mode) {
+            if (OMPI_OSC_RDMA_LOCKING_ON_DEMAND != locking_mode) {
                 /* lock the master lock. this requires no rank has a global shared lock */
                 ret = ompi_osc_rdma_lock_acquire_shared (module, module->leader, 1, offsetof (ompi_osc_rdma_state_t, global_lock),
                                                          0xffffffff00000000L);
@@ -135,7 +290,7 @@ static inline int ompi_osc_rdma_lock_atomic_internal (ompi_osc_rdma_module_t *mo
             ret = ompi_osc_rdma_lock_try_acquire_exclusive (module, peer,  offsetof (ompi_osc_rdma_state_t, local_lock));
             if (ret) {
                 /* release the global lock */
-                if (OMPI_OSC_RDMA_LOCKING_TWO_LEVEL == locking_mode) {
+                if (OMPI_OSC_RDMA_LOCKING_ON_DEMAND != locking_mode) {
                     ompi_osc_rdma_lock_release_shared (module, module->leader, -1, offsetof (ompi_osc_rdma_state_t, global_lock));
                 }
                 ompi_osc_rdma_progress (module);
@@ -171,11 +326,15 @@ static inline int ompi_osc_rdma_unlock_atomic_internal (ompi_osc_rdma_module_t *
         OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_DEBUG, "releasing exclusive lock on peer");
         ompi_osc_rdma_lock_release_exclusive (module, peer, offsetof (ompi_osc_rdma_state_t, local_lock));
 
-        if (OMPI_OSC_RDMA_LOCKING_TWO_LEVEL == locking_mode) {
+        if (OMPI_OSC_RDMA_LOCKING_ON_DEMAND != locking_mode) {
             OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_DEBUG, "decrementing global exclusive lock");
             ompi_osc_rdma_lock_release_shared (module, module->leader, -1, offsetof (ompi_osc_rdma_state_t, global_lock));
         }
 
+        if (peer->mcs_node) {
+            ompi_osc_rdma_mcs_dequeue (module, peer);
+        }
+
         peer->flags &= ~OMPI_OSC_RDMA_PEER_EXCLUSIVE;
     } else {
         OSC_RDMA_VERBOSE(MCA_BASE_VERBOSE_DEBUG, "decrementing global shared lock");
@@ -250,6 +409,10 @@ int ompi_osc_rdma_lock_atomic (int lock_type, int target, int mpi_assert, ompi_w
     }
 
     if (OPAL_LIKELY(OMPI_SUCCESS == ret)) {
+        ompi_osc_rdma_event_lock_t data = {.target = target, .lock_type = lock_type};
+
+        mca_base_event_raise (mca_osc_rdma_component.event_lock_acquired, win, &data);
+
         ++module->passive_target_access_epoch;
 
         opal_atomic_wmb ();
@@ -351,7 +514,7 @@ int ompi_osc_rdma_lock_all_atomic (int mpi_assert, struct ompi_win_t *win)
 
     if (0 == (mpi_assert & MPI_MODE_NOCHECK)) {
         /* increment the global shared lock */
-        if (OMPI_OSC_RDMA_LOCKING_TWO_LEVEL == module->locking_mode) {
+        if (OMPI_OSC_RDMA_LOCKING_ON_DEMAND != module->locking_mode) {
             ret = ompi_osc_rdma_lock_acquire_shared (module, module->leader, 0x0000000100000000UL,
                                                      offsetof(ompi_osc_rdma_state_t, global_lock),
                                                      0x00000000ffffffffUL);
@@ -366,6 +529,10 @@ int ompi_osc_rdma_lock_all_atomic (int mpi_assert, struct ompi_win_t *win)
         lock->num_peers = 0;
         lock->epoch_active = false;
     } else {
+        ompi_osc_rdma_event_lock_t data = {.target = -1, .lock_type = MPI_LOCK_SHARED};
+
+        mca_base_event_raise (mca_osc_rdma_component.event_lock_acquired, win, &data);
+
         ++module->passive_target_access_epoch;
     }
 
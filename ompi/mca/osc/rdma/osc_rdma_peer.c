@@ -195,7 +195,7 @@ static int ompi_osc_rdma_peer_setup (ompi_osc_rdma_module_t *module, ompi_osc_rd
         peer_data_offset = offsetof (ompi_osc_rdma_state_t, disp_unit);
     }
 
-    peer_data_size = module->state_size - peer_data_offset;
+    peer_data_size = module->notify_offset - peer_data_offset;
     peer_data = alloca (peer_data_size);
 
     /* read window data from the end of the target's state structure */
@@ -356,10 +356,14 @@ OBJ_CLASS_INSTANCE(ompi_osc_rdma_peer_extended_t, ompi_osc_rdma_peer_basic_t,
 static void ompi_osc_rdma_peer_dynamic_construct (ompi_osc_rdma_peer_dynamic_t *peer)
 {
     memset ((char *) peer + sizeof (peer->super), 0, sizeof (*peer) - sizeof (peer->super));
+    OBJ_CONSTRUCT(&peer->region_tree, opal_interval_tree_t);
+    (void) opal_interval_tree_init (&peer->region_tree);
 }
 
 static void ompi_osc_rdma_peer_dynamic_destruct (ompi_osc_rdma_peer_dynamic_t *peer)
 {
+    OBJ_DESTRUCT(&peer->region_tree);
+
     if (peer->regions) {
         free (peer->regions);
     }
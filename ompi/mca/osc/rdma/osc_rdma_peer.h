@@ -2,6 +2,9 @@
 /*
  * Copyright (c) 2014-2018 Los Alamos National Security, LLC.  All rights
  *                         reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -14,6 +17,8 @@
 
 #include "osc_rdma_types.h"
 
+#include "opal/class/opal_interval_tree.h"
+
 struct ompi_osc_rdma_module_t;
 
 /**
@@ -50,6 +55,27 @@ struct ompi_osc_rdma_peer_t {
 
     /** index into BTL array */
     uint8_t state_btl_index;
+
+    /** fragment holding the small puts combined for this peer (put_coalesce_size), NULL if none */
+    struct ompi_osc_rdma_frag_t *wc_frag;
+
+    /** start of the combined puts in wc_frag */
+    char *wc_buffer;
+
+    /** remote address of the first combined byte */
+    uint64_t wc_address;
+
+    /** registration handle of the remote region */
+    mca_btl_base_registration_handle_t *wc_handle;
+
+    /** bytes combined so far */
+    size_t wc_size;
+
+    /** synchronization object the combined puts belong to */
+    struct ompi_osc_rdma_sync_t *wc_sync;
+
+    /** 1 + index of the queue node used for the exclusive lock of this peer, 0 if none */
+    int mcs_node;
 };
 typedef struct ompi_osc_rdma_peer_t ompi_osc_rdma_peer_t;
 
@@ -67,6 +93,9 @@ struct ompi_osc_rdma_peer_dynamic_t {
 
     /** cached array of attached regions for this peer */
     struct ompi_osc_rdma_region_t *regions;
+
+    /** cached regions by address range, valid while region_id is current */
+    opal_interval_tree_t region_tree;
 };
 
 typedef struct ompi_osc_rdma_peer_dynamic_t ompi_osc_rdma_peer_dynamic_t;
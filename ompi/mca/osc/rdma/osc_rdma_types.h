@@ -55,6 +55,28 @@ static inline int ompi_osc_rdma_lock_compare_exchange (opal_atomic_int64_t *p, i
     return ret;
 }
 
+/** number of exclusive locks a process can wait for or hold in the queue (mcs locking mode) */
+#define OMPI_OSC_RDMA_MCS_NODES 8
+
+/** queue entry of an exclusive lock waiter (mcs locking mode), 0 if none */
+#define OMPI_OSC_RDMA_MCS_ENCODE(rank, index) ((((ompi_osc_rdma_lock_t) (rank)) << 8 | (index)) + 1)
+#define OMPI_OSC_RDMA_MCS_RANK(entry) ((int) (((entry) - 1) >> 8))
+#define OMPI_OSC_RDMA_MCS_INDEX(entry) ((int) (((entry) - 1) & 0xff))
+
+/**
+ * @brief queue node of an exclusive lock waiter (mcs locking mode)
+ *
+ * The node lives in the state of the waiter so that it spins on local
+ * memory. The previous waiter clears locked when it releases the lock.
+ */
+struct ompi_osc_rdma_mcs_node_t {
+    /** queue entry of the next waiter, 0 if none yet */
+    ompi_osc_rdma_lock_t next;
+    /** set while the previous waiter holds the lock */
+    ompi_osc_rdma_lock_t locked;
+};
+typedef struct ompi_osc_rdma_mcs_node_t ompi_osc_rdma_mcs_node_t;
+
 /**
  * @brief structure describing a window memory region
  */
@@ -127,6 +149,10 @@ struct ompi_osc_rdma_state_t {
     ompi_osc_rdma_lock_t local_lock;
     /** lock for the accumulate state to ensure ordering and consistency */
     ompi_osc_rdma_lock_t accumulate_lock;
+    /** last entry of the queue of exclusive lock waiters (mcs locking mode), 0 if empty */
+    ompi_osc_rdma_lock_t mcs_tail;
+    /** queue nodes of this process for the exclusive locks it waits for or holds */
+    ompi_osc_rdma_mcs_node_t mcs_nodes[OMPI_OSC_RDMA_MCS_NODES];
     /** current index to post to. compare-and-swap must be used to ensure
      * the index is free */
     osc_rdma_counter_t post_index;
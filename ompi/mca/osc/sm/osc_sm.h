@@ -6,6 +6,9 @@
  * Copyright (c) 2015-2017 Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * Copyright (c) 2016-2017 IBM Corporation. All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -43,10 +46,24 @@ struct ompi_osc_sm_lock_t {
 };
 typedef struct ompi_osc_sm_lock_t ompi_osc_sm_lock_t;
 
+/* the accumulate lock of a window is split in OSC_SM_ACC_LOCKS locks. lock i
+ * covers the blocks of (1 << OSC_SM_ACC_BLOCK_SHIFT) bytes of the window whose
+ * index is i modulo OSC_SM_ACC_LOCKS, so that accumulates to disjoint parts of
+ * a window do not serialize */
+#define OSC_SM_ACC_LOCKS 8
+#define OSC_SM_ACC_BLOCK_SHIFT 8
+
+/* one accumulate lock per cache line */
+struct ompi_osc_sm_acc_lock_t {
+    opal_atomic_lock_t lock;
+    char padding[64 - sizeof (opal_atomic_lock_t)];
+};
+typedef struct ompi_osc_sm_acc_lock_t ompi_osc_sm_acc_lock_t;
+
 struct ompi_osc_sm_node_state_t {
     opal_atomic_int32_t complete_count;
     ompi_osc_sm_lock_t lock;
-    opal_atomic_lock_t accumulate_lock;
+    ompi_osc_sm_acc_lock_t accumulate_locks[OSC_SM_ACC_LOCKS];
 };
 typedef struct ompi_osc_sm_node_state_t ompi_osc_sm_node_state_t;
 
@@ -54,6 +71,14 @@ struct ompi_osc_sm_component_t {
     ompi_osc_base_component_t super;
 
     char *backing_directory;
+
+    /* default for the acc_single_intrinsic info key */
+    bool acc_single_intrinsic;
+
+    /* defaults for the mpix_numa_placement and mpix_hugepages info keys */
+    bool numa_placement;
+    bool hugepages;
+    size_t hugepage_size;
 };
 typedef struct ompi_osc_sm_component_t ompi_osc_sm_component_t;
 OMPI_DECLSPEC extern ompi_osc_sm_component_t mca_osc_sm_component;
@@ -73,6 +98,15 @@ struct ompi_osc_sm_module_t {
     void *segment_base;
     bool noncontig;
 
+    /* slices bound to the NUMA node of their owner, and backed by
+     * transparent huge pages */
+    bool numa_placement;
+    bool hugepages;
+
+    /* accumulate operations only use a single predefined datatype element.
+     * the integer ones are executed with processor atomics */
+    bool acc_single_intrinsic;
+
     size_t *sizes;
     void **bases;
     int *disp_units;
@@ -91,6 +125,10 @@ struct ompi_osc_sm_module_t {
 
     osc_sm_post_atomic_type_t **posts;
 
+    /* notification counters of the notified RMA, notify_count per rank */
+    int notify_count;
+    opal_atomic_int64_t *notify;
+
     opal_mutex_t lock;
 };
 typedef struct ompi_osc_sm_module_t ompi_osc_sm_module_t;
@@ -120,6 +158,28 @@ int ompi_osc_sm_get(void *origin_addr,
                           struct ompi_datatype_t *target_dt,
                           struct ompi_win_t *win);
 
+int ompi_osc_sm_put_notify(const void *origin_addr,
+                           int origin_count,
+                           struct ompi_datatype_t *origin_dt,
+                           int target,
+                           ptrdiff_t target_disp,
+                           int target_count,
+                           struct ompi_datatype_t *target_dt,
+                           int notification_idx,
+                           struct ompi_win_t *win);
+
+int ompi_osc_sm_get_notify(void *origin_addr,
+                           int origin_count,
+                           struct ompi_datatype_t *origin_dt,
+                           int target,
+                           ptrdiff_t target_disp,
+                           int target_count,
+                           struct ompi_datatype_t *target_dt,
+                           int notification_idx,
+                           struct ompi_win_t *win);
+
+int ompi_osc_sm_notify_counters(struct ompi_win_t *win, opal_atomic_int64_t **counters, int *count);
+
 int ompi_osc_sm_accumulate(const void *origin_addr,
                                  int origin_count,
                                  struct ompi_datatype_t *origin_dt,
@@ -5,6 +5,9 @@
  *                         reserved.
  * Copyright (c) 2015-2017 Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -14,12 +17,175 @@
 
 #include "ompi_config.h"
 
+#include "opal/datatype/opal_datatype_internal.h"
 #include "ompi/mca/osc/osc.h"
 #include "ompi/mca/osc/base/base.h"
 #include "ompi/mca/osc/base/osc_base_obj_convert.h"
 
 #include "osc_sm.h"
 
+/* accumulate locks of target covering count elements of dt at displacement
+ * target_disp, one bit per lock */
+static uint32_t
+ompi_osc_sm_acc_lock(ompi_osc_sm_module_t *module, int target, ptrdiff_t target_disp,
+                     int count, struct ompi_datatype_t *dt)
+{
+    ompi_osc_sm_acc_lock_t *locks = module->node_states[target].accumulate_locks;
+    ptrdiff_t lb, extent, true_lb, true_extent;
+    size_t first, last;
+    uint32_t mask = 0;
+
+    ompi_datatype_get_extent(dt, &lb, &extent);
+    ompi_datatype_get_true_extent(dt, &true_lb, &true_extent);
+
+    /* bytes touched, relative to the base of the target */
+    first = (size_t) (module->disp_units[target] * target_disp + true_lb);
+    last = first + ((count > 0) ? (size_t) ((count - 1) * extent + true_extent) : 1) - 1;
+
+    first >>= OSC_SM_ACC_BLOCK_SHIFT;
+    last >>= OSC_SM_ACC_BLOCK_SHIFT;
+
+    if (last - first + 1 >= OSC_SM_ACC_LOCKS) {
+        mask = (1u << OSC_SM_ACC_LOCKS) - 1;
+    } else {
+        for (size_t block = first ; block <= last ; ++block) {
+            mask |= 1u << (block % OSC_SM_ACC_LOCKS);
+        }
+    }
+
+    /* always in the same order to avoid deadlocks */
+    for (int i = 0 ; i < OSC_SM_ACC_LOCKS ; ++i) {
+        if (mask & (1u << i)) {
+            opal_atomic_lock(&locks[i].lock);
+        }
+    }
+
+    return mask;
+}
+
+static void
+ompi_osc_sm_acc_unlock(ompi_osc_sm_module_t *module, int target, uint32_t mask)
+{
+    ompi_osc_sm_acc_lock_t *locks = module->node_states[target].accumulate_locks;
+
+    for (int i = OSC_SM_ACC_LOCKS - 1 ; i >= 0 ; --i) {
+        if (mask & (1u << i)) {
+            opal_atomic_unlock(&locks[i].lock);
+        }
+    }
+}
+
+/* op_type of MPI_NO_OP for the atomic fast path */
+#define OSC_SM_OP_NO_OP -1
+
+#define OSC_SM_ACC_ATOMIC(bits)                                                                         \
+static inline int                                                                                       \
+ompi_osc_sm_acc_atomic_ ## bits(opal_atomic_int ## bits ## _t *target, int ## bits ## _t origin,        \
+                                int ## bits ## _t *result, int op_type, bool is_unsigned)               \
+{                                                                                                       \
+    int ## bits ## _t old;                                                                              \
+                                                                                                        \
+    switch (op_type) {                                                                                  \
+    case OMPI_OP_SUM:                                                                                   \
+        old = opal_atomic_fetch_add_ ## bits(target, origin);                                           \
+        break;                                                                                          \
+    case OMPI_OP_BAND:                                                                                  \
+        old = opal_atomic_fetch_and_ ## bits(target, origin);                                           \
+        break;                                                                                          \
+    case OMPI_OP_BOR:                                                                                   \
+        old = opal_atomic_fetch_or_ ## bits(target, origin);                                            \
+        break;                                                                                          \
+    case OMPI_OP_BXOR:                                                                                  \
+        old = opal_atomic_fetch_xor_ ## bits(target, origin);                                           \
+        break;                                                                                          \
+    case OMPI_OP_REPLACE:                                                                               \
+        old = opal_atomic_swap_ ## bits(target, origin);                                                \
+        break;                                                                                          \
+    case OSC_SM_OP_NO_OP:                                                                               \
+        old = *((volatile int ## bits ## _t *) target);                                                 \
+        break;                                                                                          \
+    case OMPI_OP_MAX:                                                                                   \
+    case OMPI_OP_MIN:                                                                                   \
+        old = *((volatile int ## bits ## _t *) target);                                                 \
+        do {                                                                                            \
+            bool greater = is_unsigned ? ((uint ## bits ## _t) origin > (uint ## bits ## _t) old) :     \
+                (origin > old);                                                                         \
+            if (origin == old || greater != (OMPI_OP_MAX == op_type)) {                                 \
+                break;                                                                                  \
+            }                                                                                           \
+        } while (!opal_atomic_compare_exchange_strong_ ## bits(target, &old, origin));                  \
+        break;                                                                                          \
+    default:                                                                                            \
+        return OMPI_ERR_NOT_SUPPORTED;                                                                  \
+    }                                                                                                   \
+                                                                                                        \
+    if (NULL != result) {                                                                               \
+        *result = old;                                                                                  \
+    }                                                                                                   \
+                                                                                                        \
+    return OMPI_SUCCESS;                                                                                \
+}
+
+OSC_SM_ACC_ATOMIC(32)
+OSC_SM_ACC_ATOMIC(64)
+
+/* execute an accumulate of a single predefined integer with a processor
+ * atomic instead of under the accumulate lock. only done when the window
+ * promises that no accumulate uses more than one element (acc_single_intrinsic),
+ * otherwise a locked update of several elements could lose the update.
+ * result_addr may be NULL. returns OMPI_ERR_NOT_SUPPORTED if the operation
+ * has to take the locked path */
+static int
+ompi_osc_sm_acc_atomic(ompi_osc_sm_module_t *module, const void *origin_addr, int origin_count,
+                       struct ompi_datatype_t *origin_dt, void *result_addr, int result_count,
+                       struct ompi_datatype_t *result_dt, void *remote_address, int target_count,
+                       struct ompi_datatype_t *target_dt, struct ompi_op_t *op)
+{
+    bool is_unsigned = false;
+    int op_type;
+
+    if (!module->acc_single_intrinsic || 1 != target_count || !ompi_datatype_is_predefined(target_dt) ||
+        (NULL != result_addr && (1 != result_count || target_dt != result_dt))) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    if (op == &ompi_mpi_op_no_op.op) {
+        op_type = OSC_SM_OP_NO_OP;
+        origin_addr = NULL;
+    } else if (1 != origin_count || origin_dt != target_dt) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    } else if (op == &ompi_mpi_op_replace.op || ompi_op_is_intrinsic(op)) {
+        op_type = op->op_type;
+    } else {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    switch (target_dt->super.id) {
+    case OPAL_DATATYPE_UINT4:
+        is_unsigned = true;
+        /* fall through */
+    case OPAL_DATATYPE_INT4:
+        if ((uintptr_t) remote_address & 3) {
+            return OMPI_ERR_NOT_SUPPORTED;
+        }
+        return ompi_osc_sm_acc_atomic_32((opal_atomic_int32_t *) remote_address,
+                                         (NULL != origin_addr) ? *((const int32_t *) origin_addr) : 0,
+                                         (int32_t *) result_addr, op_type, is_unsigned);
+    case OPAL_DATATYPE_UINT8:
+        is_unsigned = true;
+        /* fall through */
+    case OPAL_DATATYPE_INT8:
+        if ((uintptr_t) remote_address & 7) {
+            return OMPI_ERR_NOT_SUPPORTED;
+        }
+        return ompi_osc_sm_acc_atomic_64((opal_atomic_int64_t *) remote_address,
+                                         (NULL != origin_addr) ? *((const int64_t *) origin_addr) : 0,
+                                         (int64_t *) result_addr, op_type, is_unsigned);
+    default:
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+}
+
 int
 ompi_osc_sm_rput(const void *origin_addr,
                  int origin_count,
@@ -116,6 +282,7 @@ ompi_osc_sm_raccumulate(const void *origin_addr,
     ompi_osc_sm_module_t *module =
         (ompi_osc_sm_module_t*) win->w_osc_module;
     void *remote_address;
+    uint32_t locks;
 
     OPAL_OUTPUT_VERBOSE((50, ompi_osc_base_framework.framework_output,
                          "raccumulate: 0x%lx, %d, %s, %d, %d, %d, %s, %s, 0x%lx",
@@ -127,16 +294,20 @@ ompi_osc_sm_raccumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
-    opal_atomic_lock(&module->node_states[target].accumulate_lock);
-    if (op == &ompi_mpi_op_replace.op) {
-        ret = ompi_datatype_sndrcv((void *)origin_addr, origin_count, origin_dt,
-                                    remote_address, target_count, target_dt);
-    } else {
-        ret = ompi_osc_base_sndrcv_op(origin_addr, origin_count, origin_dt,
-                                      remote_address, target_count, target_dt,
-                                      op);
+    ret = ompi_osc_sm_acc_atomic(module, origin_addr, origin_count, origin_dt, NULL, 0, NULL,
+                                 remote_address, target_count, target_dt, op);
+    if (OMPI_SUCCESS != ret) {
+        locks = ompi_osc_sm_acc_lock(module, target, target_disp, target_count, target_dt);
+        if (op == &ompi_mpi_op_replace.op) {
+            ret = ompi_datatype_sndrcv((void *)origin_addr, origin_count, origin_dt,
+                                        remote_address, target_count, target_dt);
+        } else {
+            ret = ompi_osc_base_sndrcv_op(origin_addr, origin_count, origin_dt,
+                                          remote_address, target_count, target_dt,
+                                          op);
+        }
+        ompi_osc_sm_acc_unlock(module, target, locks);
     }
-    opal_atomic_unlock(&module->node_states[target].accumulate_lock);
 
     /* the only valid field of RMA request status is the MPI_ERROR field.
      * ompi_request_empty has status MPI_SUCCESS and indicates the request is
@@ -167,6 +338,7 @@ ompi_osc_sm_rget_accumulate(const void *origin_addr,
     ompi_osc_sm_module_t *module =
         (ompi_osc_sm_module_t*) win->w_osc_module;
     void *remote_address;
+    uint32_t locks;
 
     OPAL_OUTPUT_VERBOSE((50, ompi_osc_base_framework.framework_output,
                          "rget_accumulate: 0x%lx, %d, %s, %d, %d, %d, %s, %s, 0x%lx",
@@ -178,7 +350,14 @@ ompi_osc_sm_rget_accumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
-    opal_atomic_lock(&module->node_states[target].accumulate_lock);
+    if (OMPI_SUCCESS == ompi_osc_sm_acc_atomic(module, origin_addr, origin_count, origin_dt, result_addr,
+                                               result_count, result_dt, remote_address, target_count,
+                                               target_dt, op)) {
+        *ompi_req = &ompi_request_empty;
+        return OMPI_SUCCESS;
+    }
+
+    locks = ompi_osc_sm_acc_lock(module, target, target_disp, target_count, target_dt);
 
     ret = ompi_datatype_sndrcv(remote_address, target_count, target_dt,
                                result_addr, result_count, result_dt);
@@ -194,7 +373,7 @@ ompi_osc_sm_rget_accumulate(const void *origin_addr,
     }
 
  done:
-    opal_atomic_unlock(&module->node_states[target].accumulate_lock);
+    ompi_osc_sm_acc_unlock(module, target, locks);
 
     /* the only valid field of RMA request status is the MPI_ERROR field.
      * ompi_request_empty has status MPI_SUCCESS and indicates the request is
@@ -267,6 +446,86 @@ ompi_osc_sm_get(void *origin_addr,
 }
 
 
+int
+ompi_osc_sm_put_notify(const void *origin_addr,
+                       int origin_count,
+                       struct ompi_datatype_t *origin_dt,
+                       int target,
+                       ptrdiff_t target_disp,
+                       int target_count,
+                       struct ompi_datatype_t *target_dt,
+                       int notification_idx,
+                       struct ompi_win_t *win)
+{
+    ompi_osc_sm_module_t *module =
+        (ompi_osc_sm_module_t*) win->w_osc_module;
+    int ret;
+
+    if (notification_idx < 0 || notification_idx >= module->notify_count) {
+        return OMPI_ERR_BAD_PARAM;
+    }
+
+    ret = ompi_osc_sm_put(origin_addr, origin_count, origin_dt, target, target_disp,
+                          target_count, target_dt, win);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    /* the data must be visible before the notification */
+    opal_atomic_wmb();
+    (void) opal_atomic_add_fetch_64(&module->notify[target * module->notify_count + notification_idx], 1);
+
+    return OMPI_SUCCESS;
+}
+
+
+int
+ompi_osc_sm_get_notify(void *origin_addr,
+                       int origin_count,
+                       struct ompi_datatype_t *origin_dt,
+                       int target,
+                       ptrdiff_t target_disp,
+                       int target_count,
+                       struct ompi_datatype_t *target_dt,
+                       int notification_idx,
+                       struct ompi_win_t *win)
+{
+    ompi_osc_sm_module_t *module =
+        (ompi_osc_sm_module_t*) win->w_osc_module;
+    int ret;
+
+    if (notification_idx < 0 || notification_idx >= module->notify_count) {
+        return OMPI_ERR_BAD_PARAM;
+    }
+
+    ret = ompi_osc_sm_get(origin_addr, origin_count, origin_dt, target, target_disp,
+                          target_count, target_dt, win);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    /* the target may overwrite the data once notified */
+    opal_atomic_mb();
+    (void) opal_atomic_add_fetch_64(&module->notify[target * module->notify_count + notification_idx], 1);
+
+    return OMPI_SUCCESS;
+}
+
+
+int
+ompi_osc_sm_notify_counters(struct ompi_win_t *win, opal_atomic_int64_t **counters, int *count)
+{
+    ompi_osc_sm_module_t *module =
+        (ompi_osc_sm_module_t*) win->w_osc_module;
+
+    *count = module->notify_count;
+    *counters = module->notify_count ?
+        module->notify + ompi_comm_rank(module->comm) * module->notify_count : NULL;
+
+    return OMPI_SUCCESS;
+}
+
+
 int
 ompi_osc_sm_accumulate(const void *origin_addr,
                        int origin_count,
@@ -282,6 +541,7 @@ ompi_osc_sm_accumulate(const void *origin_addr,
     ompi_osc_sm_module_t *module =
         (ompi_osc_sm_module_t*) win->w_osc_module;
     void *remote_address;
+    uint32_t locks;
 
     OPAL_OUTPUT_VERBOSE((50, ompi_osc_base_framework.framework_output,
                          "accumulate: 0x%lx, %d, %s, %d, %d, %d, %s, %s, 0x%lx",
@@ -293,16 +553,20 @@ ompi_osc_sm_accumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
-    opal_atomic_lock(&module->node_states[target].accumulate_lock);
-    if (op == &ompi_mpi_op_replace.op) {
-        ret = ompi_datatype_sndrcv((void *)origin_addr, origin_count, origin_dt,
-                                    remote_address, target_count, target_dt);
-    } else {
-        ret = ompi_osc_base_sndrcv_op(origin_addr, origin_count, origin_dt,
-                                      remote_address, target_count, target_dt,
-                                      op);
+    ret = ompi_osc_sm_acc_atomic(module, origin_addr, origin_count, origin_dt, NULL, 0, NULL,
+                                 remote_address, target_count, target_dt, op);
+    if (OMPI_SUCCESS != ret) {
+        locks = ompi_osc_sm_acc_lock(module, target, target_disp, target_count, target_dt);
+        if (op == &ompi_mpi_op_replace.op) {
+            ret = ompi_datatype_sndrcv((void *)origin_addr, origin_count, origin_dt,
+                                        remote_address, target_count, target_dt);
+        } else {
+            ret = ompi_osc_base_sndrcv_op(origin_addr, origin_count, origin_dt,
+                                          remote_address, target_count, target_dt,
+                                          op);
+        }
+        ompi_osc_sm_acc_unlock(module, target, locks);
     }
-    opal_atomic_unlock(&module->node_states[target].accumulate_lock);
 
     return ret;
 }
@@ -326,6 +590,7 @@ ompi_osc_sm_get_accumulate(const void *origin_addr,
     ompi_osc_sm_module_t *module =
         (ompi_osc_sm_module_t*) win->w_osc_module;
     void *remote_address;
+    uint32_t locks;
 
     OPAL_OUTPUT_VERBOSE((50, ompi_osc_base_framework.framework_output,
                          "get_accumulate: 0x%lx, %d, %s, %d, %d, %d, %s, %s, 0x%lx",
@@ -337,7 +602,13 @@ ompi_osc_sm_get_accumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
-    opal_atomic_lock(&module->node_states[target].accumulate_lock);
+    if (OMPI_SUCCESS == ompi_osc_sm_acc_atomic(module, origin_addr, origin_count, origin_dt, result_addr,
+                                               result_count, result_dt, remote_address, target_count,
+                                               target_dt, op)) {
+        return OMPI_SUCCESS;
+    }
+
+    locks = ompi_osc_sm_acc_lock(module, target, target_disp, target_count, target_dt);
 
     ret = ompi_datatype_sndrcv(remote_address, target_count, target_dt,
                                result_addr, result_count, result_dt);
@@ -353,7 +624,7 @@ ompi_osc_sm_get_accumulate(const void *origin_addr,
     }
 
  done:
-    opal_atomic_unlock(&module->node_states[target].accumulate_lock);
+    ompi_osc_sm_acc_unlock(module, target, locks);
 
     return ret;
 }
@@ -371,6 +642,7 @@ ompi_osc_sm_compare_and_swap(const void *origin_addr,
     ompi_osc_sm_module_t *module =
         (ompi_osc_sm_module_t*) win->w_osc_module;
     void *remote_address;
+    uint32_t locks;
     size_t size;
 
     OPAL_OUTPUT_VERBOSE((50, ompi_osc_base_framework.framework_output,
@@ -383,7 +655,26 @@ ompi_osc_sm_compare_and_swap(const void *origin_addr,
 
     ompi_datatype_type_size(dt, &size);
 
-    opal_atomic_lock(&module->node_states[target].accumulate_lock);
+    if (module->acc_single_intrinsic && ompi_datatype_is_predefined(dt) &&
+        (OMPI_DATATYPE_FLAG_DATA_INT & dt->super.flags) && (4 == size || 8 == size) &&
+        0 == ((uintptr_t) remote_address & (size - 1))) {
+        /* same bitwise compare as below, with a processor atomic */
+        if (4 == size) {
+            int32_t old = *((const int32_t *) compare_addr);
+            (void) opal_atomic_compare_exchange_strong_32((opal_atomic_int32_t *) remote_address, &old,
+                                                          *((const int32_t *) origin_addr));
+            *((int32_t *) result_addr) = old;
+        } else {
+            int64_t old = *((const int64_t *) compare_addr);
+            (void) opal_atomic_compare_exchange_strong_64((opal_atomic_int64_t *) remote_address, &old,
+                                                          *((const int64_t *) origin_addr));
+            *((int64_t *) result_addr) = old;
+        }
+
+        return OMPI_SUCCESS;
+    }
+
+    locks = ompi_osc_sm_acc_lock(module, target, target_disp, 1, dt);
 
     /* fetch */
     ompi_datatype_copy_content_same_ddt(dt, 1, (char*) result_addr, (char*) remote_address);
@@ -393,7 +684,7 @@ ompi_osc_sm_compare_and_swap(const void *origin_addr,
         ompi_datatype_copy_content_same_ddt(dt, 1, (char*) remote_address, (char*) origin_addr);
     }
 
-    opal_atomic_unlock(&module->node_states[target].accumulate_lock);
+    ompi_osc_sm_acc_unlock(module, target, locks);
 
     return OMPI_SUCCESS;
 }
@@ -411,6 +702,7 @@ ompi_osc_sm_fetch_and_op(const void *origin_addr,
     ompi_osc_sm_module_t *module =
         (ompi_osc_sm_module_t*) win->w_osc_module;
     void *remote_address;
+    uint32_t locks;
 
     OPAL_OUTPUT_VERBOSE((50, ompi_osc_base_framework.framework_output,
                          "fetch_and_op: 0x%lx, %s, %d, %d, %s, 0x%lx",
@@ -421,7 +713,12 @@ ompi_osc_sm_fetch_and_op(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
-    opal_atomic_lock(&module->node_states[target].accumulate_lock);
+    if (OMPI_SUCCESS == ompi_osc_sm_acc_atomic(module, origin_addr, 1, dt, result_addr, 1, dt,
+                                               remote_address, 1, dt, op)) {
+        return OMPI_SUCCESS;
+    }
+
+    locks = ompi_osc_sm_acc_lock(module, target, target_disp, 1, dt);
 
     /* fetch */
     ompi_datatype_copy_content_same_ddt(dt, 1, (char*) result_addr, (char*) remote_address);
@@ -435,7 +732,7 @@ ompi_osc_sm_fetch_and_op(const void *origin_addr,
     }
 
  done:
-    opal_atomic_unlock(&module->node_states[target].accumulate_lock);
+    ompi_osc_sm_acc_unlock(module, target, locks);
 
     return OMPI_SUCCESS;;
 }
@@ -7,7 +7,7 @@
  * Copyright (c) 2015      Cisco Systems, Inc.  All rights reserved.
  * Copyright (c) 2015-2018 Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
- * Copyright (c) 2017      The University of Tennessee and The University
+ * Copyright (c) 2017-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2016-2017 IBM Corporation. All rights reserved.
@@ -22,6 +22,11 @@
 
 #include "ompi_config.h"
 
+#include <errno.h>
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
 #include "ompi/mca/osc/osc.h"
 #include "ompi/mca/osc/base/base.h"
 #include "ompi/mca/osc/base/osc_base_obj_convert.h"
@@ -30,6 +35,7 @@
 #include "opal/include/opal/align.h"
 #include "opal/util/info_subscriber.h"
 #include "opal/util/printf.h"
+#include "opal/mca/hwloc/base/base.h"
 
 #include "osc_sm.h"
 
@@ -107,6 +113,10 @@ ompi_osc_sm_module_t ompi_osc_sm_module_template = {
         .osc_flush_all = ompi_osc_sm_flush_all,
         .osc_flush_local = ompi_osc_sm_flush_local,
         .osc_flush_local_all = ompi_osc_sm_flush_local_all,
+
+        .osc_put_notify = ompi_osc_sm_put_notify,
+        .osc_get_notify = ompi_osc_sm_get_notify,
+        .osc_win_notify_counters = ompi_osc_sm_notify_counters,
     }
 };
 
@@ -125,6 +135,43 @@ static int component_register (void)
                                             MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0, OPAL_INFO_LVL_3,
                                             MCA_BASE_VAR_SCOPE_READONLY, &mca_osc_sm_component.backing_directory);
 
+    mca_osc_sm_component.acc_single_intrinsic = false;
+    (void) mca_base_component_var_register (&mca_osc_sm_component.super.osc_version, "acc_single_intrinsic",
+                                            "Enable optimizations for MPI_Fetch_and_op, MPI_Accumulate, etc for codes "
+                                            "that will not use anything more than a single predefined datatype element "
+                                            "in an accumulate operation. Single integer elements are then updated with "
+                                            "processor atomics instead of under the accumulate lock. The "
+                                            "acc_single_intrinsic info key overrides this value (default: false)",
+                                            MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                            MCA_BASE_VAR_SCOPE_GROUP, &mca_osc_sm_component.acc_single_intrinsic);
+
+    mca_osc_sm_component.numa_placement = true;
+    (void) mca_base_component_var_register (&mca_osc_sm_component.super.osc_version, "numa_placement",
+                                            "Bind the memory of each process in a shared memory window to the NUMA "
+                                            "node(s) the process is bound to, instead of the node of the process that "
+                                            "first touches it. Nothing is done for unbound processes. The "
+                                            "mpix_numa_placement info key overrides this value (default: true)",
+                                            MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                            MCA_BASE_VAR_SCOPE_GROUP, &mca_osc_sm_component.numa_placement);
+
+    mca_osc_sm_component.hugepages = false;
+    (void) mca_base_component_var_register (&mca_osc_sm_component.super.osc_version, "hugepages",
+                                            "Back shared memory windows with transparent huge pages: the data of the "
+                                            "window starts on a huge page boundary, and so does the memory of each "
+                                            "process with alloc_shared_noncontig. The backing directory must support "
+                                            "them (shmem_enabled set to advise or always for /dev/shm). The "
+                                            "mpix_hugepages info key overrides this value, it must be the same on all "
+                                            "the processes (default: false)",
+                                            MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                            MCA_BASE_VAR_SCOPE_GROUP, &mca_osc_sm_component.hugepages);
+
+    mca_osc_sm_component.hugepage_size = 2 * 1024 * 1024;
+    (void) mca_base_component_var_register (&mca_osc_sm_component.super.osc_version, "hugepage_size",
+                                            "Size of the huge pages of the shared memory windows, a multiple of the "
+                                            "page size (default: 2MB)",
+                                            MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                            MCA_BASE_VAR_SCOPE_GROUP, &mca_osc_sm_component.hugepage_size);
+
     return OPAL_SUCCESS;
 }
 
@@ -184,6 +231,51 @@ component_query(struct ompi_win_t *win, void **base, size_t size, int disp_unit,
 }
 
 
+/* place the pages of the memory of this process in the window: on the NUMA
+ * node(s) this process is bound to, backed by huge pages if requested */
+static void
+place_local_memory(ompi_osc_sm_module_t *module, void *base, size_t size)
+{
+    size_t pagesize = opal_getpagesize();
+    uintptr_t start = OPAL_ALIGN((uintptr_t) base, pagesize, uintptr_t);
+    uintptr_t end = ((uintptr_t) base + size) & ~((uintptr_t) pagesize - 1);
+    hwloc_cpuset_t cpuset;
+
+    /* the pages shared with the neighbors stay with the first touch */
+    if (end <= start) {
+        return;
+    }
+
+#if defined(HAVE_SYS_MMAN_H) && defined(MADV_HUGEPAGE)
+    if (module->hugepages && 0 != madvise((void *) start, end - start, MADV_HUGEPAGE)) {
+        OPAL_OUTPUT_VERBOSE((10, ompi_osc_base_framework.framework_output,
+                             "transparent huge pages not available for the window: %s", strerror(errno)));
+    }
+#endif
+
+    if (!module->numa_placement || OPAL_SUCCESS != opal_hwloc_base_get_topology()) {
+        return;
+    }
+
+    cpuset = hwloc_bitmap_alloc();
+    if (NULL == cpuset) {
+        return;
+    }
+
+    /* an unbound process could run anywhere, leave its memory alone */
+    if (0 == hwloc_get_cpubind(opal_hwloc_topology, cpuset, HWLOC_CPUBIND_PROCESS) &&
+        !hwloc_bitmap_isincluded(hwloc_topology_get_topology_cpuset(opal_hwloc_topology), cpuset)) {
+        if (0 != hwloc_set_area_membind(opal_hwloc_topology, (void *) start, end - start, cpuset,
+                                        HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_MIGRATE)) {
+            OPAL_OUTPUT_VERBOSE((10, ompi_osc_base_framework.framework_output,
+                                 "could not bind the window memory: %s", strerror(errno)));
+        }
+    }
+
+    hwloc_bitmap_free(cpuset);
+}
+
+
 static int
 component_select(struct ompi_win_t *win, void **base, size_t size, int disp_unit,
                  struct ompi_communicator_t *comm, struct opal_info_t *info,
@@ -221,6 +313,37 @@ component_select(struct ompi_win_t *win, void **base, size_t size, int disp_unit
 
     module->flavor = flavor;
 
+    module->acc_single_intrinsic = mca_osc_sm_component.acc_single_intrinsic;
+    module->numa_placement = mca_osc_sm_component.numa_placement;
+    module->hugepages = mca_osc_sm_component.hugepages;
+    if (NULL != info) {
+        opal_cstring_t *notify_string;
+        bool value;
+        int flag;
+
+        if (OMPI_SUCCESS == opal_info_get_bool(info, "acc_single_intrinsic", &value, &flag) && flag) {
+            module->acc_single_intrinsic = value;
+        }
+
+        if (OMPI_SUCCESS == opal_info_get_bool(info, "mpix_numa_placement", &value, &flag) && flag) {
+            module->numa_placement = value;
+        }
+
+        /* must be the same on all the processes */
+        if (OMPI_SUCCESS == opal_info_get_bool(info, "mpix_hugepages", &value, &flag) && flag) {
+            module->hugepages = value;
+        }
+
+        /* must be the same on all the processes */
+        if (OMPI_SUCCESS == opal_info_get(info, "mpix_num_notifications", &notify_string, &flag) && flag) {
+            if (OPAL_SUCCESS != opal_cstring_to_int(notify_string, &module->notify_count) ||
+                module->notify_count < 0) {
+                module->notify_count = 0;
+            }
+            OBJ_RELEASE(notify_string);
+        }
+    }
+
     /* create the segment */
     if (1 == comm_size) {
         module->segment_base = NULL;
@@ -230,8 +353,18 @@ component_select(struct ompi_win_t *win, void **base, size_t size, int disp_unit
         if (NULL == module->bases) return OMPI_ERR_TEMP_OUT_OF_RESOURCE;
 
         module->sizes[0] = size;
-        module->bases[0] = malloc(size);
-        if (NULL == module->bases[0]) return OMPI_ERR_TEMP_OUT_OF_RESOURCE;
+        if (module->hugepages && size >= mca_osc_sm_component.hugepage_size) {
+            if (0 != posix_memalign(&module->bases[0], mca_osc_sm_component.hugepage_size,
+                                    OPAL_ALIGN(size, mca_osc_sm_component.hugepage_size, size_t))) {
+                return OMPI_ERR_TEMP_OUT_OF_RESOURCE;
+            }
+            /* private memory, first touched by its owner */
+            module->numa_placement = false;
+            place_local_memory(module, module->bases[0], size);
+        } else {
+            module->bases[0] = malloc(size);
+            if (NULL == module->bases[0]) return OMPI_ERR_TEMP_OUT_OF_RESOURCE;
+        }
 
         module->global_state = malloc(sizeof(ompi_osc_sm_global_state_t));
         if (NULL == module->global_state) return OMPI_ERR_TEMP_OUT_OF_RESOURCE;
@@ -240,11 +373,15 @@ component_select(struct ompi_win_t *win, void **base, size_t size, int disp_unit
         module->posts = calloc (1, sizeof(module->posts[0]) + sizeof (module->posts[0][0]));
         if (NULL == module->posts) return OMPI_ERR_TEMP_OUT_OF_RESOURCE;
         module->posts[0] = (osc_sm_post_atomic_type_t *) (module->posts + 1);
+        if (module->notify_count) {
+            module->notify = calloc(module->notify_count, sizeof(module->notify[0]));
+            if (NULL == module->notify) return OMPI_ERR_TEMP_OUT_OF_RESOURCE;
+        }
     } else {
         unsigned long total, *rbuf;
         int i, flag;
-        size_t pagesize;
-        size_t state_size;
+        size_t pagesize, align;
+        size_t state_size, data_offset, segment_size;
         size_t posts_size, post_size = (comm_size + OSC_SM_POST_MASK) / (OSC_SM_POST_MASK + 1);
 
         OPAL_OUTPUT_VERBOSE((1, ompi_osc_base_framework.framework_output,
@@ -252,6 +389,12 @@ component_select(struct ompi_win_t *win, void **base, size_t size, int disp_unit
 
         /* get the pagesize */
         pagesize = opal_getpagesize();
+        if (module->hugepages && 0 == mca_osc_sm_component.hugepage_size % pagesize) {
+            align = mca_osc_sm_component.hugepage_size;
+        } else {
+            module->hugepages = false;
+            align = pagesize;
+        }
 
         rbuf = malloc(sizeof(unsigned long) * comm_size);
         if (NULL == rbuf) return OMPI_ERR_TEMP_OUT_OF_RESOURCE;
@@ -263,7 +406,8 @@ component_select(struct ompi_win_t *win, void **base, size_t size, int disp_unit
         }
 
         if (module->noncontig) {
-            total = ((size - 1) / pagesize + 1) * pagesize;
+            /* each slice starts on a (huge) page boundary */
+            total = OPAL_ALIGN(size, align, size_t);
         } else {
             total = size;
         }
@@ -280,9 +424,19 @@ component_select(struct ompi_win_t *win, void **base, size_t size, int disp_unit
 
         /* user opal/shmem directly to create a shared memory segment */
         state_size = sizeof(ompi_osc_sm_global_state_t) + sizeof(ompi_osc_sm_node_state_t) * comm_size;
+        state_size += OPAL_ALIGN_PAD_AMOUNT(state_size, 8);
+        state_size += sizeof(module->notify[0]) * module->notify_count * comm_size;
         state_size += OPAL_ALIGN_PAD_AMOUNT(state_size, 64);
         posts_size = comm_size * post_size * sizeof (module->posts[0][0]);
         posts_size += OPAL_ALIGN_PAD_AMOUNT(posts_size, 64);
+        data_offset = state_size + posts_size;
+        segment_size = total + pagesize + state_size + posts_size;
+        if (module->hugepages) {
+            /* the kernel maps the huge pages of a file at matching virtual
+             * offsets, aligning the file offset aligns the data */
+            data_offset = OPAL_ALIGN(data_offset, align, size_t);
+            segment_size = OPAL_ALIGN(data_offset + total, align, size_t);
+        }
         if (0 == ompi_comm_rank (module->comm)) {
             char *data_file;
             ret = opal_asprintf (&data_file, "%s" OPAL_PATH_SEP "osc_sm.%s.%x.%d.%d",
@@ -293,7 +447,7 @@ component_select(struct ompi_win_t *win, void **base, size_t size, int disp_unit
                 return OMPI_ERR_OUT_OF_RESOURCE;
             }
 
-            ret = opal_shmem_segment_create (&module->seg_ds, data_file, total + pagesize + state_size + posts_size);
+            ret = opal_shmem_segment_create (&module->seg_ds, data_file, segment_size);
             free(data_file);
             if (OPAL_SUCCESS != ret) {
                 free(rbuf);
@@ -339,8 +493,12 @@ component_select(struct ompi_win_t *win, void **base, size_t size, int disp_unit
         module->posts[0] = (osc_sm_post_atomic_type_t *) (module->segment_base);
         module->global_state = (ompi_osc_sm_global_state_t *) (module->posts[0] + comm_size * post_size);
         module->node_states = (ompi_osc_sm_node_state_t *) (module->global_state + 1);
+        if (module->notify_count) {
+            module->notify = (opal_atomic_int64_t *) OPAL_ALIGN((uintptr_t) (module->node_states + comm_size),
+                                                                8, uintptr_t);
+        }
 
-        for (i = 0, total = state_size + posts_size ; i < comm_size ; ++i) {
+        for (i = 0, total = data_offset ; i < comm_size ; ++i) {
             if (i > 0) {
                 module->posts[i] = module->posts[i - 1] + post_size;
             }
@@ -355,15 +513,25 @@ component_select(struct ompi_win_t *win, void **base, size_t size, int disp_unit
         }
 
         free(rbuf);
+
+        /* before anyone touches it */
+        place_local_memory(module, module->bases[ompi_comm_rank(module->comm)],
+                           module->sizes[ompi_comm_rank(module->comm)]);
     }
 
     /* initialize my state shared */
     module->my_node_state = &module->node_states[ompi_comm_rank(module->comm)];
     memset (module->my_node_state, 0, sizeof(*module->my_node_state));
+    if (module->notify_count) {
+        memset ((void *) (module->notify + ompi_comm_rank(module->comm) * module->notify_count), 0,
+                module->notify_count * sizeof(module->notify[0]));
+    }
 
     *base = module->bases[ompi_comm_rank(module->comm)];
 
-    opal_atomic_lock_init(&module->my_node_state->accumulate_lock, OPAL_ATOMIC_LOCK_UNLOCKED);
+    for (int i = 0 ; i < OSC_SM_ACC_LOCKS ; ++i) {
+        opal_atomic_lock_init(&module->my_node_state->accumulate_locks[i].lock, OPAL_ATOMIC_LOCK_UNLOCKED);
+    }
 
     /* share everyone's displacement units. */
     module->disp_units = malloc(sizeof(int) * comm_size);
@@ -527,6 +695,7 @@ ompi_osc_sm_free(struct ompi_win_t *win)
     } else {
         free(module->node_states);
         free(module->global_state);
+        free((void *) module->notify);
         if (NULL != module->bases) {
             free(module->bases[0]);
         }
@@ -600,6 +769,8 @@ ompi_osc_sm_get_info(struct ompi_win_t *win, struct opal_info_t **info_used)
                       (module->noncontig) ? "true" : "false");
     }
 
+    opal_info_set(info, "acc_single_intrinsic", module->acc_single_intrinsic ? "true" : "false");
+
     *info_used = info;
 
     return OMPI_SUCCESS;
@@ -1043,6 +1043,44 @@ int ompi_osc_ucx_get_accumulate(const void *origin_addr, int origin_count,
                               target_count, target_dt, op, win, NULL);
 }
 
+/* contiguous put or get completing its request from its own completion */
+static int putget_req(ompi_osc_ucx_module_t *module, opal_common_ucx_op_t op, void *origin_addr,
+                      int origin_count, struct ompi_datatype_t *origin_dt, int target,
+                      uint64_t remote_addr, struct ompi_datatype_t *target_dt,
+                      struct ompi_win_t *win, struct ompi_request_t **request) {
+    ptrdiff_t origin_lb, origin_extent, target_lb, target_extent;
+    ompi_osc_ucx_request_t *ucx_req = NULL;
+    size_t origin_len;
+    int ret;
+
+    ompi_datatype_get_true_extent(origin_dt, &origin_lb, &origin_extent);
+    ompi_datatype_get_true_extent(target_dt, &target_lb, &target_extent);
+    ompi_datatype_type_size(origin_dt, &origin_len);
+    origin_len *= origin_count;
+
+    OMPI_OSC_UCX_REQUEST_ALLOC(win, ucx_req);
+    assert(NULL != ucx_req);
+
+    mca_osc_ucx_component.num_incomplete_req_ops++;
+    ret = opal_common_ucx_wpmem_putget_nb(module->mem, op, target,
+                                          (void *)((intptr_t)origin_addr + origin_lb),
+                                          origin_len, remote_addr + target_lb,
+                                          req_completion, ucx_req);
+    if (ret != OMPI_SUCCESS) {
+        OSC_UCX_VERBOSE(1, "opal_common_ucx_wpmem_putget_nb failed: %d", ret);
+        if (!ucx_req->super.req_complete) {
+            /* the completion callback will not be called */
+            mca_osc_ucx_component.num_incomplete_req_ops--;
+            OMPI_OSC_UCX_REQUEST_RETURN(ucx_req);
+        }
+        return OMPI_ERROR;
+    }
+
+    *request = &ucx_req->super;
+
+    return ret;
+}
+
 int ompi_osc_ucx_rput(const void *origin_addr, int origin_count,
                       struct ompi_datatype_t *origin_dt,
                       int target, ptrdiff_t target_disp, int target_count,
@@ -1065,6 +1103,13 @@ int ompi_osc_ucx_rput(const void *origin_addr, int origin_count,
         }
     }
 
+    if (target_count && ompi_datatype_is_contiguous_memory_layout(origin_dt, origin_count) &&
+        ompi_datatype_is_contiguous_memory_layout(target_dt, target_count)) {
+        /* fast path */
+        return putget_req(module, OPAL_COMMON_UCX_PUT, (void *) origin_addr, origin_count, origin_dt, target,
+                          remote_addr, target_dt, win, request);
+    }
+
     OMPI_OSC_UCX_REQUEST_ALLOC(win, ucx_req);
     assert(NULL != ucx_req);
 
@@ -1118,6 +1163,13 @@ int ompi_osc_ucx_rget(void *origin_addr, int origin_count,
         }
     }
 
+    if (target_count && ompi_datatype_is_contiguous_memory_layout(origin_dt, origin_count) &&
+        ompi_datatype_is_contiguous_memory_layout(target_dt, target_count)) {
+        /* fast path */
+        return putget_req(module, OPAL_COMMON_UCX_GET, origin_addr, origin_count, origin_dt, target,
+                          remote_addr, target_dt, win, request);
+    }
+
     OMPI_OSC_UCX_REQUEST_ALLOC(win, ucx_req);
     assert(NULL != ucx_req);
 
@@ -78,6 +78,7 @@ struct ompi_part_persist_t {
     int32_t                my_world_rank; /* Because the back end communicators use a world rank, we need to communicate ours 
                                              to set up the requests. */
     opal_atomic_int32_t    block_entry;
+    size_t                 min_message_size; /* user partitions are grouped in internal transfers of at least this size */
     opal_mutex_t lock; 
 };
 typedef struct ompi_part_persist_t ompi_part_persist_t;
@@ -100,6 +101,8 @@ mca_part_persist_free_req(struct mca_part_persist_request_t* req)
     }
     free(req->persist_reqs);
     free(req->flags);
+    free((void *) req->part_ready);
+    free((void *) req->ready_bits);
 
     if( MCA_PART_PERSIST_REQUEST_PRECV == req->req_type ) {
         MCA_PART_PERSIST_PRECV_REQUEST_RETURN(req);
@@ -110,6 +113,59 @@ mca_part_persist_free_req(struct mca_part_persist_request_t* req)
 }
 
 
+/**
+ * Count of the internal transfer part. All transfers carry real_count elements
+ * but the last one, which carries what remains of the user buffer.
+ */
+__opal_attribute_always_inline__ static inline size_t
+mca_part_persist_real_count(struct mca_part_persist_request_t* req, size_t part)
+{
+    size_t total = req->req_parts * req->req_count;
+
+    if(part + 1 < req->real_parts || total < part * req->real_count) {
+        return req->real_count;
+    }
+
+    return total - part * req->real_count;
+}
+
+/**
+ * Start the transfers marked in the ready bitmap of a send request. Called from
+ * the progress engine with ompi_part_persist.lock held. The pending counter is
+ * cleared before the bitmap is read: a Pready that raced with the scan left its
+ * counter increment for the next pass, so no ready bit is left behind.
+ */
+__opal_attribute_always_inline__ static inline int
+mca_part_persist_start_ready(struct mca_part_persist_request_t* req)
+{
+    size_t words = MCA_PART_PERSIST_READY_WORDS(req->real_parts);
+    int err = OMPI_SUCCESS;
+
+    (void) opal_atomic_swap_32(&req->ready_pending, 0);
+
+    for(size_t w = 0; w < words && OMPI_SUCCESS == err; w++) {
+        uint64_t bits;
+
+        if(0 == req->ready_bits[w]) {
+            continue;
+        }
+
+        bits = (uint64_t) opal_atomic_swap_64(&req->ready_bits[w], 0);
+        for(size_t b = 0; 0 != bits && OMPI_SUCCESS == err; b++, bits >>= 1) {
+            size_t part = w * 64 + b;
+
+            if(0 == (bits & 1)) {
+                continue;
+            }
+
+            req->flags[part] = 0; /* Mark partion as ready for testing */
+            err = req->persist_reqs[part]->req_start(1, (&(req->persist_reqs[part])));
+        }
+    }
+
+    return err;
+}
+
 __opal_attribute_always_inline__ static inline void mca_part_persist_init_lists(void)
 {
     opal_free_list_init (&mca_part_base_precv_requests,
@@ -250,7 +306,8 @@ mca_part_persist_progress(void)
                     req->persist_reqs = (ompi_request_t**) malloc(sizeof(ompi_request_t*)*(req->real_parts));
                     for(i = 0; i < req->real_parts; i++) {
                          void *buf = ((void*) (((char*)req->req_addr) + (bytes * i)));
-                         err = MCA_PML_CALL(isend_init(buf, req->real_count, req->req_datatype, req->world_peer, req->my_send_tag+i, MCA_PML_BASE_SEND_STANDARD, ompi_part_persist.part_comm, &(req->persist_reqs[i])));
+                         size_t real_count = mca_part_persist_real_count(req, i);
+                         err = MCA_PML_CALL(isend_init(buf, real_count, req->req_datatype, req->world_peer, req->my_send_tag+i, MCA_PML_BASE_SEND_STANDARD, ompi_part_persist.part_comm, &(req->persist_reqs[i])));
                     }    
                 } else {
                     /* parse message */
@@ -270,7 +327,8 @@ mca_part_persist_progress(void)
                     req->flags = (int*) calloc(req->real_parts,sizeof(int));
                     for(i = 0; i < req->real_parts; i++) {
                          void *buf = ((void*) (((char*)req->req_addr) + (bytes * i)));
-                         err = MCA_PML_CALL(irecv_init(buf, req->real_count, req->req_datatype, req->world_peer, req->my_send_tag+i, ompi_part_persist.part_comm, &(req->persist_reqs[i])));
+                         size_t real_count = mca_part_persist_real_count(req, i);
+                         err = MCA_PML_CALL(irecv_init(buf, real_count, req->req_datatype, req->world_peer, req->my_send_tag+i, ompi_part_persist.part_comm, &(req->persist_reqs[i])));
                     }
                     err = req->persist_reqs[0]->req_start(req->real_parts, (&(req->persist_reqs[0])));                     
 
@@ -282,14 +340,12 @@ mca_part_persist_progress(void)
             }
         } else {
             if(false == req->req_part_complete && REQUEST_COMPLETED != req->req_ompi.req_complete && OMPI_REQUEST_ACTIVE == req->req_ompi.req_state) {
-               for(i = 0; i < req->real_parts; i++) {
-
-                    /* Check to see if partition is queued for being started. Only applicable to sends. */ 
-                    if(-2 ==  req->flags[i]) {
-                        err = req->persist_reqs[i]->req_start(1, (&(req->persist_reqs[i])));
-                        req->flags[i] = 0;
-                    }
+               /* Start the transfers marked ready since the last pass. Only applicable to sends. */
+               if(0 < req->ready_pending) {
+                    err = mca_part_persist_start_ready(req);
+               }
 
+               for(i = 0; i < req->real_parts; i++) {
                     if(0 == req->flags[i])
                     {
                         ompi_request_test(&(req->persist_reqs[i]), &(req->flags[i]), MPI_STATUS_IGNORE);
@@ -360,6 +416,10 @@ mca_part_persist_precv_init(void *buf,
     req->first_send  = true; 
     req->flag_post_setup_recv = false;
     req->flags = NULL;
+    req->part_ready = NULL;
+    req->ready_bits = NULL;
+    req->ready_pending = 0;
+    req->part_group = 1;
     /* Non-blocking recive on setup info */
     err	= MCA_PML_CALL(irecv(&req->setup_info[1], sizeof(struct ompi_mca_persist_setup_t), MPI_BYTE, src, tag, comm, &req->setup_req[1])); 
     if(OMPI_SUCCESS != err) return OMPI_ERROR;
@@ -430,21 +490,36 @@ mca_part_persist_psend_init(const void* buf,
     dt_size = (dt_size_ > (size_t) INT_MAX) ? MPI_UNDEFINED : (int) dt_size_;
     req->req_bytes = parts * count * dt_size;
 
-
+    /* Group the user partitions so that each internal transfer carries at least
+     * min_message_size bytes, whatever the number of partitions. The last
+     * transfer takes the remaining partitions. */
+    req->part_group = 1;
+    if(0 < dt_size && 0 < count && 0 < parts) {
+        size_t part_bytes = count * (size_t) dt_size;
+        req->part_group = (ompi_part_persist.min_message_size + part_bytes - 1) / part_bytes;
+        if(req->part_group > parts) {
+            req->part_group = parts;
+        } else if(0 == req->part_group) {
+            req->part_group = 1;
+        }
+    }
 
     /* non-blocking send set-up data */
+    req->real_parts = (parts + req->part_group - 1) / req->part_group;
+    req->real_count = count * req->part_group;
     req->setup_info[0].world_rank = ompi_comm_rank(&ompi_mpi_comm_world.comm);
-    req->setup_info[0].start_tag = ompi_part_persist.next_send_tag; ompi_part_persist.next_send_tag += parts; 
+    req->setup_info[0].start_tag = ompi_part_persist.next_send_tag; ompi_part_persist.next_send_tag += req->real_parts; 
     req->my_send_tag = req->setup_info[0].start_tag;
     req->setup_info[0].setup_tag = ompi_part_persist.next_recv_tag; ompi_part_persist.next_recv_tag++;
     req->my_recv_tag = req->setup_info[0].setup_tag;
-    req->setup_info[0].num_parts = parts;
-    req->real_parts = parts;
-    req->setup_info[0].count = count;
-    req->real_count = count;
+    req->setup_info[0].num_parts = req->real_parts;
+    req->setup_info[0].count = req->real_count;
 
 
     req->flags = (int*) calloc(req->real_parts, sizeof(int));
+    req->part_ready = (opal_atomic_int32_t *) calloc(req->real_parts, sizeof(opal_atomic_int32_t));
+    req->ready_bits = (opal_atomic_int64_t *) calloc(MCA_PART_PERSIST_READY_WORDS(req->real_parts), sizeof(opal_atomic_int64_t));
+    req->ready_pending = 0;
 
     err = MCA_PML_CALL(isend(&(req->setup_info[0]), sizeof(struct ompi_mca_persist_setup_t), MPI_BYTE, dst, tag, MCA_PML_BASE_SEND_STANDARD, comm, &req->setup_req[0]));
     if(OMPI_SUCCESS != err) return OMPI_ERROR;
@@ -491,7 +566,10 @@ mca_part_persist_start(size_t count, ompi_request_t** requests)
         {
             if(MCA_PART_PERSIST_REQUEST_PSEND == req->req_type) {
                 req->done_count = 0;
-                memset((void*)req->flags,0,sizeof(int32_t)*req->real_parts);
+                memset((void*)req->flags,-1,sizeof(int32_t)*req->real_parts);
+                memset((void*)req->part_ready,0,sizeof(opal_atomic_int32_t)*req->real_parts);
+                memset((void*)req->ready_bits,0,sizeof(opal_atomic_int64_t)*MCA_PART_PERSIST_READY_WORDS(req->real_parts));
+                req->ready_pending = 0;
             } else {
                 req->done_count = 0;
                 err = req->persist_reqs[0]->req_start(req->real_parts, req->persist_reqs);
@@ -500,6 +578,9 @@ mca_part_persist_start(size_t count, ompi_request_t** requests)
         } else {
             if(MCA_PART_PERSIST_REQUEST_PSEND == req->req_type) {
                 req->done_count = 0;
+                memset((void*)req->part_ready,0,sizeof(opal_atomic_int32_t)*req->real_parts);
+                memset((void*)req->ready_bits,0,sizeof(opal_atomic_int64_t)*MCA_PART_PERSIST_READY_WORDS(req->real_parts));
+                req->ready_pending = 0;
                 for(i = 0; i < req->real_parts && OMPI_SUCCESS == err; i++) {
                     req->flags[i] = -1;
                 }
@@ -527,19 +608,29 @@ mca_part_persist_pready(size_t min_part,
     int err = OMPI_SUCCESS;
     size_t i;
 
+    int32_t marked = 0;
     mca_part_persist_request_t *req = (mca_part_persist_request_t *)(request);
-    if(true == req->initialized)
-    {
-        err = req->persist_reqs[min_part]->req_start(max_part-min_part+1, (&(req->persist_reqs[min_part])));
-        for(i = min_part; i <= max_part && OMPI_SUCCESS == err; i++) {
-            req->flags[i] = 0; /* Mark partion as ready for testing */
+
+    /* Pready only sets the ready bits of the transfers, no lock is taken and no
+     * pml call is made. The progress engine starts the marked transfers. */
+    for(i = min_part; i <= max_part; i++) {
+        size_t part = i / req->part_group;
+
+        if(1 < req->part_group) {
+            /* An internal transfer leaves once all the user partitions of its group are ready. */
+            size_t group = mca_part_persist_real_count(req, part) / req->req_count;
+            if(opal_atomic_add_fetch_32(&req->part_ready[part], 1) < (int32_t) group) {
+                continue;
+            }
         }
+
+        (void) opal_atomic_fetch_or_64(&req->ready_bits[part / 64], ((int64_t) 1) << (part % 64));
+        marked++;
     }
-    else
-    {
-        for(i = min_part; i <= max_part && OMPI_SUCCESS == err; i++) {
-            req->flags[i] = -2; /* Mark partition as queued */
-        }
+
+    /* publish after the bits, see mca_part_persist_start_ready */
+    if(0 < marked) {
+        (void) opal_atomic_add_fetch_32(&req->ready_pending, marked);
     }
     return err;
 }
@@ -557,14 +648,20 @@ mca_part_persist_parrived(size_t min_part,
 
     if(0 != req->flags) {
         _flag = 1;
-        if(req->req_parts == req->real_parts) {
+        if(req->req_count == req->real_count || 0 == req->req_bytes) {
             for(i = min_part; i <= max_part; i++) {
                 _flag = _flag && req->flags[i];            
             }
         } else {
-            float convert = ((float)req->real_parts) / ((float)req->req_parts);
-            size_t _min = floor(convert * min_part);
-            size_t _max = ceil(convert * max_part);
+            /* The sender grouped or split the partitions differently, look at the
+             * internal transfers that overlap the bytes of the user partitions. */
+            size_t user_bytes = req->req_bytes / req->req_parts;
+            size_t real_bytes = req->real_count * (user_bytes / req->req_count);
+            size_t _min = (min_part * user_bytes) / real_bytes;
+            size_t _max = ((max_part + 1) * user_bytes - 1) / real_bytes;
+            if(_max >= req->real_parts) {
+                _max = req->real_parts - 1;
+            }
             for(i = _min; i <= _max; i++) {
                 _flag = _flag && req->flags[i];
             }
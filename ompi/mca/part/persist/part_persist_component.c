@@ -84,6 +84,15 @@ mca_part_persist_component_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &ompi_part_persist.free_list_inc);
 
+    ompi_part_persist.min_message_size = 65536;
+    (void) mca_base_component_var_register(&mca_part_persist_component.partm_version, "min_message_size",
+                                           "Minimum size in bytes of the internal transfers. Consecutive user partitions "
+                                           "are grouped in one transfer, sent once all of them are ready, until it reaches "
+                                           "this size (0: one transfer per partition)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_part_persist.min_message_size);
 
     return OPAL_SUCCESS;
 }
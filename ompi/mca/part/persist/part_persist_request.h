@@ -35,6 +35,9 @@ typedef enum {
 
 struct mca_part_persist_list_t;
 
+/** Number of 64 bit words of the ready bitmap of a request */
+#define MCA_PART_PERSIST_READY_WORDS(parts) (((parts) + 63) / 64)
+
 struct ompi_mca_persist_setup_t {
    int world_rank;
    int start_tag;
@@ -92,6 +95,11 @@ struct mca_part_persist_request_t {
 
     int32_t *flags;               /**< array of flags to determine whether a partition has arrived */
 
+    size_t part_group;                    /**< user partitions per internal transfer (send side) */
+    opal_atomic_int32_t *part_ready;      /**< ready user partitions of each internal transfer (send side) */
+    opal_atomic_int64_t *ready_bits;      /**< bitmap of the transfers ready to be started (send side) */
+    opal_atomic_int32_t ready_pending;    /**< transfers marked ready since the last progress pass */
+
     struct ompi_mca_persist_setup_t setup_info[2]; /**< Setup info to send durring initialization. */
   
     struct mca_part_persist_list_t* progress_elem; /**< pointer to progress list element for removal durring free. */ 
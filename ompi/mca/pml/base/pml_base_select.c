@@ -30,6 +30,7 @@
 #include "opal/class/opal_list.h"
 #include "opal/util/output.h"
 #include "opal/util/show_help.h"
+#include "opal/util/timings.h"
 #include "opal/runtime/opal_progress.h"
 #include "ompi/mca/mca.h"
 #include "opal/mca/base/base.h"
@@ -71,6 +72,8 @@ int mca_pml_base_select(bool enable_progress_threads,
     /* Traverse the list of available components; call their init
        functions. */
 
+    OPAL_TIMING_ENV_INIT(otmng);
+
     best_priority = -1;
     best_component = NULL;
     module = NULL;
@@ -121,6 +124,7 @@ int mca_pml_base_select(bool enable_progress_threads,
         priority = best_priority;
         module = component->pmlm_init(&priority, enable_progress_threads,
                                       enable_mpi_threads);
+        OPAL_TIMING_ENV_NEXT(otmng, "pml_%s", component->pmlm_version.mca_component_name);
         if (NULL == module) {
             opal_output_verbose( 10, ompi_pml_base_framework.framework_output,
                                  "select: init returned failure for component %s",
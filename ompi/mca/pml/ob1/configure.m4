@@ -22,7 +22,7 @@ AC_DEFUN([MCA_ompi_pml_ob1_POST_CONFIG], [
 # ------------------------------------------------
 # We can always build, unless we were explicitly disabled.
 AC_DEFUN([MCA_ompi_pml_ob1_CONFIG],[
-    OPAL_VAR_SCOPE_PUSH([pml_ob1_matching_engine])
+    OPAL_VAR_SCOPE_PUSH([pml_ob1_matching_engine pml_ob1_avx512_support pml_ob1_avx512_flags pml_ob1_cflags_save])
     AC_ARG_WITH([pml-ob1-matching], [AS_HELP_STRING([--with-pml-ob1-matching=type],
                                                     [Configure pml/ob1 to use an alternate matching engine. Only valid on x86_64 systems.
                                                      Valid values are: none, default, arrays, fuzzy-byte, fuzzy-short, fuzzy-word, vector (default: none)])])
@@ -60,6 +60,45 @@ AC_DEFUN([MCA_ompi_pml_ob1_CONFIG],[
 
     AC_DEFINE_UNQUOTED([MCA_PML_OB1_CUSTOM_MATCHING], [$pml_ob1_matching_engine], [Custom matching engine to use in pml/ob1])
 
+    #
+    # The vector posted receive queue has an AVX-512 kernel, built with its
+    # own flags and only used when the processor supports it.
+    #
+    MCA_BUILD_PML_OB1_AVX512_FLAGS=""
+    pml_ob1_avx512_support=0
+    AS_IF([test "$opal_cv_asm_arch" = "X86_64"],
+          [AC_LANG_PUSH([C])
+           pml_ob1_cflags_save="$CFLAGS"
+           for pml_ob1_avx512_flags in "" "-mavx512f" ; do
+               AS_IF([test $pml_ob1_avx512_support -eq 0],
+                     [AC_MSG_CHECKING([for AVX512F matching support (flags: $pml_ob1_avx512_flags)])
+                      CFLAGS="$pml_ob1_avx512_flags $pml_ob1_cflags_save"
+                      AC_LINK_IFELSE(
+                          [AC_LANG_PROGRAM([[#include <immintrin.h>]],
+                                           [[
+#if defined(__ICC) && !defined(__AVX512F__)
+#error "icc needs the -m flags to provide the AVX* detection macros
+#endif
+    int keys[16] = {0};
+    __m512i vA = _mm512_loadu_si512((void*)keys);
+    __mmask16 m = _mm512_cmpeq_epi32_mask(vA, _mm512_set1_epi32(1));
+    return (int)m;
+                                           ]])],
+                          [pml_ob1_avx512_support=1
+                           MCA_BUILD_PML_OB1_AVX512_FLAGS="$pml_ob1_avx512_flags"
+                           AC_MSG_RESULT([yes])],
+                          [AC_MSG_RESULT([no])])])
+           done
+           CFLAGS="$pml_ob1_cflags_save"
+           AC_LANG_POP([C])])
+
+    AC_DEFINE_UNQUOTED([MCA_PML_OB1_HAVE_AVX512_MATCH], [$pml_ob1_avx512_support],
+                       [Whether pml/ob1 has the AVX-512 matching kernel])
+    AM_CONDITIONAL([MCA_BUILD_ompi_pml_ob1_has_avx512_support],
+                   [test "$pml_ob1_avx512_support" = "1"])
+    AC_SUBST(MCA_BUILD_PML_OB1_AVX512_FLAGS)
+
     AC_CONFIG_FILES([ompi/mca/pml/ob1/Makefile])
+    OPAL_VAR_SCOPE_POP
     [$1]
 ])dnl
@@ -37,6 +37,7 @@
 #include "opal/class/opal_bitmap.h"
 #include "opal/util/output.h"
 #include "opal/util/show_help.h"
+#include "opal/runtime/opal_progress.h"
 #include "opal_stdint.h"
 #include "opal/mca/btl/btl.h"
 #include "opal/mca/btl/base/base.h"
@@ -57,6 +58,9 @@
 #include "pml_ob1_sendreq.h"
 #include "pml_ob1_recvreq.h"
 #include "pml_ob1_rdmafrag.h"
+#include "pml_ob1_prq_vector.h"
+#include "pml_ob1_coalesce.h"
+#include "pml_ob1_flow.h"
 
 mca_pml_ob1_t mca_pml_ob1 = {
     {
@@ -165,6 +169,12 @@ int mca_pml_ob1_enable(bool enable)
     /* missing communicator pending list */
     OBJ_CONSTRUCT(&mca_pml_ob1.non_existing_communicator_pending, opal_list_t);
 
+    OBJ_CONSTRUCT(&mca_pml_ob1.coalesce_pending, opal_list_t);
+    OBJ_CONSTRUCT(&mca_pml_ob1.coalesce_lock, opal_mutex_t);
+    if (mca_pml_ob1_coalesce_enabled ()) {
+        opal_progress_register (mca_pml_ob1_coalesce_progress);
+    }
+
     /**
      * If we get here this is the PML who get selected for the run. We
      * should get ownership for the send and receive requests list, and
@@ -192,6 +202,13 @@ int mca_pml_ob1_enable(bool enable)
                           mca_pml_ob1.free_list_inc,
                           NULL, 0, NULL, NULL, NULL);
 
+    /* requests and fragments are taken and released by every thread on the critical path,
+     * keep some of them in per-thread caches (opal_free_list_thread_cache) */
+    (void) opal_free_list_thread_cache_enable(&mca_pml_base_send_requests);
+    (void) opal_free_list_thread_cache_enable(&mca_pml_base_recv_requests);
+    (void) opal_free_list_thread_cache_enable(&mca_pml_ob1.recv_frags);
+    (void) opal_free_list_thread_cache_enable(&mca_pml_ob1.rdma_frags);
+
     mca_pml_ob1.enabled = true;
     return OMPI_SUCCESS;
 }
@@ -297,6 +314,23 @@ int mca_pml_ob1_add_comm(ompi_communicator_t* comm)
 
 int mca_pml_ob1_del_comm(ompi_communicator_t* comm)
 {
+    mca_pml_ob1_comm_t *pml_comm = comm->c_pml_comm;
+
+    if (mca_pml_ob1_coalesce_enabled ()) {
+        /* the coalesced messages have no request to keep the communicator
+         * alive, get them out before it goes away */
+        for (size_t i = 0 ; i < pml_comm->num_procs ; ++i) {
+            mca_pml_ob1_comm_proc_t *proc = pml_comm->procs[i];
+
+            while (NULL != proc && NULL != proc->coalesce && NULL != proc->coalesce->des) {
+                mca_pml_ob1_coalesce_flush (proc);
+                if (NULL != proc->coalesce->des) {
+                    opal_progress ();
+                }
+            }
+        }
+    }
+
     OBJ_RELEASE(comm->c_pml_comm);
     comm->c_pml_comm = NULL;
     return OMPI_SUCCESS;
@@ -449,6 +483,12 @@ int mca_pml_ob1_add_procs(ompi_proc_t** procs, size_t nprocs)
     if(OMPI_SUCCESS != rc)
         goto cleanup_and_return;
 
+    rc = mca_bml.bml_register( MCA_PML_OB1_HDR_TYPE_CREDIT,
+                               mca_pml_ob1_recv_frag_callback_credit,
+                               NULL );
+    if(OMPI_SUCCESS != rc)
+        goto cleanup_and_return;
+
     /* register error handlers */
     rc = mca_bml.bml_register_error(mca_pml_ob1_error_handler);
     if(OMPI_SUCCESS != rc)
@@ -603,6 +643,10 @@ int mca_pml_ob1_dump(struct ompi_communicator_t* comm, int verbose)
         opal_output(0, "expected MPI_ANY_SOURCE fragments\n");
         mca_pml_ob1_dump_frag_list(&pml_comm->wild_receives, true);
     }
+    if( pml_comm->prq_vector_active ) {
+        opal_output(0, "expected receives\n");
+        mca_pml_ob1_prq_vector_dump(pml_comm->prq_vector);
+    }
 #endif
 
 #if MCA_PML_OB1_CUSTOM_MATCH
@@ -749,7 +793,8 @@ void mca_pml_ob1_process_pending_packets(mca_bml_base_btl_t* bml_btl)
                         pckt->hdr.hdr_ack.hdr_dst_req.pval,
                         pckt->hdr.hdr_ack.hdr_send_offset,
                         pckt->hdr.hdr_ack.hdr_send_size,
-                        pckt->hdr.hdr_common.hdr_flags & MCA_PML_OB1_HDR_FLAGS_NORDMA);
+                        pckt->hdr.hdr_common.hdr_flags,
+                        pckt->hdr.hdr_ack.hdr_credits);
                 if( OPAL_UNLIKELY(OMPI_ERR_OUT_OF_RESOURCE == rc) ) {
                     OPAL_THREAD_LOCK(&mca_pml_ob1.lock);
                     opal_list_append(&mca_pml_ob1.pckt_pending,
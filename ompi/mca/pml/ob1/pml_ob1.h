@@ -41,6 +41,7 @@
 #include "ompi/mca/bml/base/base.h"
 #include "ompi/proc/proc.h"
 #include "opal/mca/allocator/base/base.h"
+#include "opal/mca/base/mca_base_event.h"
 
 BEGIN_C_DECLS
 
@@ -61,6 +62,28 @@ struct mca_pml_ob1_t {
     int max_rdma_per_request;
     int max_send_per_range;
     bool use_all_rdma;
+    /* adapt the RDMA striping to the observed bandwidth, see pml_ob1_rdma.h */
+    bool rdma_adaptive;
+    double rdma_adaptive_alpha;
+    /* rget of non-contiguous buffers, see mca_pml_ob1_rdma_iov_build */
+    int rdma_iov_max_segments;
+    size_t rdma_iov_min_segment_size;
+    /* coalescing of short messages, see pml_ob1_coalesce.h */
+    size_t coalesce_size;
+    size_t coalesce_max_msg;
+    unsigned int coalesce_delay;
+    /* match the sends to self directly against the posted receives */
+    bool self_bypass;
+    /* per peer eager limit, see pml_ob1_adapt.h */
+    bool adaptive_eager;
+    size_t adaptive_eager_min;
+    double adaptive_unexpected_threshold;
+    /* flow control of the eager messages, see pml_ob1_flow.h */
+    int flow_credits;
+    size_t flow_threshold;
+    opal_atomic_size_t flow_buffered;
+    /* match in the network, see pml_ob1_tm.h */
+    bool tag_matching;
 
     /* lock queue access */
     opal_mutex_t lock;
@@ -79,16 +102,56 @@ struct mca_pml_ob1_t {
     opal_list_t rdma_pending;
     /* List of pending fragments without a matching communicator */
     opal_list_t non_existing_communicator_pending;
+    /* open coalescing fragments, protected by coalesce_lock */
+    opal_list_t coalesce_pending;
+    opal_mutex_t coalesce_lock;
     bool enabled;
     char* allocator_name;
     mca_allocator_base_module_t* allocator;
     unsigned int unexpected_limit;
+    /* posted receive queue selection, see pml_ob1_prq_vector.h */
+    int matching_engine;
+    unsigned int matching_vector_threshold;
+    bool matching_vector_avx512;
+    /* per peer matching, see mca_pml_ob1_comm_match_lock */
+    bool matching_lanes;
+
+    /* MPI_T events on the communicators, see mca_pml_ob1_event_raise */
+    mca_base_event_t *event_rndv_start;
+    mca_base_event_t *event_rdma_complete;
+    mca_base_event_t *event_unexpected;
 };
 typedef struct mca_pml_ob1_t mca_pml_ob1_t;
 
 extern mca_pml_ob1_t mca_pml_ob1;
 extern int mca_pml_ob1_output;
 extern bool mca_pml_ob1_matching_protection;
+
+/* Data of the MPI_T events of ob1 */
+typedef struct mca_pml_ob1_event_data_t {
+    int peer;
+    int tag;
+    size_t bytes;
+} mca_pml_ob1_event_data_t;
+
+/**
+ * Raise an ob1 event on a communicator. Nothing is built unless a tool
+ * listens to the event.
+ */
+static inline void mca_pml_ob1_event_raise (mca_base_event_t *event, struct ompi_communicator_t *comm,
+                                            int peer, int tag, size_t bytes)
+{
+    mca_pml_ob1_event_data_t data;
+
+    if (OPAL_LIKELY(NULL == event || 0 == event->active)) {
+        return;
+    }
+
+    data.peer = peer;
+    data.tag = tag;
+    data.bytes = bytes;
+    mca_base_event_record (event, comm, &data);
+}
 /*
  * PML interface functions.
  */
@@ -0,0 +1,68 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "opal/mca/timer/base/base.h"
+
+#include "pml_ob1.h"
+#include "pml_ob1_adapt.h"
+#include "pml_ob1_sendreq.h"
+
+/* weight of the newest send in the smoothed bandwidth */
+#define MCA_PML_OB1_ADAPT_ALPHA 0.125
+
+void mca_pml_ob1_adapt_ack (mca_pml_ob1_send_request_t *sendreq, mca_btl_base_module_t *btl,
+                            uint8_t hdr_flags)
+{
+    mca_pml_ob1_comm_proc_t *proc = mca_pml_ob1_peer_lookup (sendreq->req_send.req_base.req_comm,
+                                                             sendreq->req_send.req_base.req_peer);
+    size_t max = btl->btl_eager_limit - sizeof (mca_pml_ob1_hdr_t);
+    size_t min = (mca_pml_ob1.adaptive_eager_min < max) ? mca_pml_ob1.adaptive_eager_min : max;
+    size_t limit = proc->adapt_eager_limit;
+
+    if (0 == limit || limit > max) {
+        limit = max;
+    }
+
+    if (hdr_flags & MCA_PML_OB1_HDR_FLAGS_UNEXPECTED) {
+        /* the eager data of the peer waits in unexpected buffers */
+        limit = (limit / 2 > min) ? limit / 2 : min;
+    } else {
+        /* the receives are posted in time, the handshakes only add latency */
+        limit = (max - limit > max / 8) ? limit + max / 8 : max;
+    }
+
+    /* the ACKs of concurrent sends only lose a step */
+    proc->adapt_eager_limit = limit;
+}
+
+void mca_pml_ob1_adapt_complete (mca_pml_ob1_send_request_t *sendreq)
+{
+    uint64_t now = opal_timer_base_get_usec ();
+    size_t length = sendreq->req_send.req_bytes_packed;
+    mca_pml_ob1_comm_proc_t *proc;
+    double sample;
+
+    /* no timer, or a completion under its resolution */
+    if (0 == length || now <= sendreq->req_adapt_start) {
+        return;
+    }
+
+    proc = mca_pml_ob1_peer_lookup (sendreq->req_send.req_base.req_comm,
+                                    sendreq->req_send.req_base.req_peer);
+
+    /* bytes per usec to Mbps */
+    sample = (8.0 * (double) length) / (double) (now - sendreq->req_adapt_start);
+    proc->adapt_bandwidth = (0.0 == proc->adapt_bandwidth) ? sample :
+        proc->adapt_bandwidth + MCA_PML_OB1_ADAPT_ALPHA * (sample - proc->adapt_bandwidth);
+}
@@ -0,0 +1,109 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Per peer adaptive eager limit.
+ *
+ * When pml_ob1_adaptive_eager is set, the receiver keeps for every peer a
+ * smoothed share of the messages (eager and rendezvous) that arrived before
+ * their receive was posted. The ACKs it sends back to that peer carry
+ * MCA_PML_OB1_HDR_FLAGS_UNEXPECTED while the share is above
+ * pml_ob1_adaptive_unexpected_threshold. The sender halves its eager limit
+ * for the peer on a flagged ACK, down to pml_ob1_adaptive_eager_min, so
+ * that the data stops waiting in unexpected buffers, and raises it back by
+ * an eighth of the btl eager limit on the other ACKs, never above the btl
+ * eager limit. The sender also keeps the smoothed bandwidth of its
+ * rendezvous sends to every peer. The limits, shares and bandwidths are
+ * exported as MPI_T variables bound to the communicators.
+ *
+ * The limit only changes the protocol of the messages that fit in the eager
+ * limit of the btl: the RDMA pipeline switch points of the btls are kept.
+ * The sends of the RGET protocol complete with a FIN, not an ACK, and give
+ * no feedback.
+ */
+#ifndef MCA_PML_OB1_ADAPT_H
+#define MCA_PML_OB1_ADAPT_H
+
+#include "ompi_config.h"
+
+#include "pml_ob1.h"
+#include "pml_ob1_comm.h"
+#include "pml_ob1_hdr.h"
+
+BEGIN_C_DECLS
+
+/* fixed point unit of mca_pml_ob1_comm_proc_t::adapt_unexpected */
+#define MCA_PML_OB1_ADAPT_ONE (1 << 16)
+
+struct mca_pml_ob1_send_request_t;
+
+/**
+ * Account for a message of the peer that matched a posted receive or went
+ * to the unexpected queue. Called with the matching lock of the peer held.
+ */
+static inline void mca_pml_ob1_adapt_arrival (mca_pml_ob1_comm_proc_t *proc, bool unexpected)
+{
+    if (mca_pml_ob1.adaptive_eager) {
+        /* the newest message weights 1/16 */
+        proc->adapt_unexpected += ((unexpected ? MCA_PML_OB1_ADAPT_ONE : 0) - proc->adapt_unexpected) / 16;
+    }
+}
+
+/**
+ * Header flags the receiver adds to the ACKs it sends to rank src.
+ */
+static inline uint8_t mca_pml_ob1_adapt_ack_flags (ompi_communicator_t *comm, int src)
+{
+    mca_pml_ob1_comm_proc_t *proc;
+
+    if (!mca_pml_ob1.adaptive_eager) {
+        return 0;
+    }
+
+    proc = mca_pml_ob1_peer_lookup (comm, src);
+    return (proc->adapt_unexpected >= mca_pml_ob1.adaptive_unexpected_threshold * MCA_PML_OB1_ADAPT_ONE) ?
+        MCA_PML_OB1_HDR_FLAGS_UNEXPECTED : 0;
+}
+
+/**
+ * Eager limit (payload bytes) of a send to rank peer, given the one of the
+ * btl.
+ */
+static inline size_t mca_pml_ob1_adapt_eager_limit (ompi_communicator_t *comm, int peer, size_t eager_limit)
+{
+    if (mca_pml_ob1.adaptive_eager) {
+        size_t limit = mca_pml_ob1_peer_lookup (comm, peer)->adapt_eager_limit;
+        if (0 != limit && limit < eager_limit) {
+            return limit;
+        }
+    }
+
+    return eager_limit;
+}
+
+/**
+ * Move the eager limit of the destination of sendreq on an ACK received
+ * from btl.
+ */
+void mca_pml_ob1_adapt_ack (struct mca_pml_ob1_send_request_t *sendreq, mca_btl_base_module_t *btl,
+                            uint8_t hdr_flags);
+
+/**
+ * Account for the completion of a rendezvous send started at
+ * sendreq->req_adapt_start.
+ */
+void mca_pml_ob1_adapt_complete (struct mca_pml_ob1_send_request_t *sendreq);
+
+END_C_DECLS
+
+#endif
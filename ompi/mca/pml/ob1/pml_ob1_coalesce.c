@@ -0,0 +1,363 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <string.h>
+
+#include "opal/align.h"
+#include "opal/sys/atomic.h"
+#include "opal/datatype/opal_convertor.h"
+#include "opal/mca/timer/base/base.h"
+#include "ompi/constants.h"
+#include "ompi/runtime/ompi_spc.h"
+
+#include "pml_ob1.h"
+#include "pml_ob1_hdr.h"
+#include "pml_ob1_coalesce.h"
+#include "pml_ob1_recvreq.h"
+#include "pml_ob1_sendreq.h"
+#include "pml_ob1_tm.h"
+
+/* expired fragments sent by one call to the progress function */
+#define MCA_PML_OB1_COALESCE_PROGRESS_BATCH 16
+
+static void mca_pml_ob1_coalesce_construct (mca_pml_ob1_coalesce_t *coalesce)
+{
+    OBJ_CONSTRUCT(&coalesce->lock, opal_mutex_t);
+    coalesce->bml_btl = NULL;
+    coalesce->des = NULL;
+    coalesce->used = 0;
+    coalesce->capacity = 0;
+    coalesce->count = 0;
+    coalesce->opened = 0;
+    coalesce->pending = false;
+}
+
+static void mca_pml_ob1_coalesce_destruct (mca_pml_ob1_coalesce_t *coalesce)
+{
+    assert (NULL == coalesce->des);
+    OBJ_DESTRUCT(&coalesce->lock);
+}
+
+OBJ_CLASS_INSTANCE(mca_pml_ob1_coalesce_t, opal_list_item_t,
+                   mca_pml_ob1_coalesce_construct,
+                   mca_pml_ob1_coalesce_destruct);
+
+static void mca_pml_ob1_coalesce_completion (struct mca_btl_base_module_t *btl,
+                                             struct mca_btl_base_endpoint_t *ep,
+                                             struct mca_btl_base_descriptor_t *des,
+                                             int status)
+{
+    mca_bml_base_btl_t *bml_btl = (mca_bml_base_btl_t *) des->des_context;
+
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != status)) {
+        /* the sends of these messages are already complete, there is no
+         * request left to report the error to */
+        opal_output_verbose(1, mca_pml_ob1_output, "pml:ob1: %s: operation failed with code %d",
+                            __func__, status);
+    }
+
+    MCA_PML_OB1_PROGRESS_PENDING(bml_btl);
+}
+
+static mca_pml_ob1_coalesce_t *mca_pml_ob1_coalesce_get (mca_pml_ob1_comm_proc_t *ob1_proc)
+{
+    mca_pml_ob1_coalesce_t *coalesce = ob1_proc->coalesce, *expected = NULL;
+
+    if (OPAL_LIKELY(NULL != coalesce)) {
+        return coalesce;
+    }
+
+    coalesce = OBJ_NEW(mca_pml_ob1_coalesce_t);
+    if (OPAL_UNLIKELY(NULL == coalesce)) {
+        return NULL;
+    }
+
+    if (!opal_atomic_compare_exchange_strong_ptr ((opal_atomic_intptr_t *) &ob1_proc->coalesce,
+                                                  (intptr_t *) &expected, (intptr_t) coalesce)) {
+        /* another thread got there first */
+        OBJ_RELEASE(coalesce);
+        coalesce = expected;
+    }
+
+    return coalesce;
+}
+
+/**
+ * Send the open fragment. Called with the lock of the fragment held.
+ *
+ * @return OMPI_ERR_OUT_OF_RESOURCE if the btl has no resources, the
+ * fragment stays open and is tried again later.
+ */
+static int mca_pml_ob1_coalesce_flush_locked (mca_pml_ob1_coalesce_t *coalesce)
+{
+    mca_btl_base_descriptor_t *des = coalesce->des;
+    mca_pml_ob1_coalesced_hdr_t *hdr;
+    int rc;
+
+    if (NULL == des) {
+        return OMPI_SUCCESS;
+    }
+
+    hdr = (mca_pml_ob1_coalesced_hdr_t *) des->des_segments->seg_addr.pval;
+    hdr->hdr_count = coalesce->count;
+    des->des_segments->seg_len = coalesce->used;
+    des->des_cbfunc = mca_pml_ob1_coalesce_completion;
+    des->des_cbdata = NULL;
+
+    rc = mca_bml_base_send (coalesce->bml_btl, des, MCA_PML_OB1_HDR_TYPE_MATCH);
+    if (OPAL_UNLIKELY(rc < 0)) {
+        if (OMPI_ERR_OUT_OF_RESOURCE == rc) {
+            return rc;
+        }
+        opal_output_verbose(1, mca_pml_ob1_output, "pml:ob1: %s: could not send %u coalesced "
+                            "messages, error %d", __func__, (unsigned) coalesce->count, rc);
+        mca_bml_base_free (coalesce->bml_btl, des);
+    }
+
+    coalesce->des = NULL;
+    coalesce->used = 0;
+    coalesce->count = 0;
+
+    return (rc < 0) ? rc : OMPI_SUCCESS;
+}
+
+/* queue the fragment for the progress engine, called with its lock held */
+static void mca_pml_ob1_coalesce_enqueue (mca_pml_ob1_coalesce_t *coalesce)
+{
+    OPAL_THREAD_LOCK(&mca_pml_ob1.coalesce_lock);
+    if (!coalesce->pending) {
+        OBJ_RETAIN(coalesce);
+        coalesce->pending = true;
+        opal_list_append (&mca_pml_ob1.coalesce_pending, &coalesce->super);
+    }
+    OPAL_THREAD_UNLOCK(&mca_pml_ob1.coalesce_lock);
+}
+
+static int mca_pml_ob1_coalesce_open (mca_pml_ob1_coalesce_t *coalesce,
+                                      mca_bml_base_endpoint_t *endpoint, size_t entry_size)
+{
+    mca_bml_base_btl_t *bml_btl = mca_bml_base_btl_array_get_next (&endpoint->btl_eager);
+    mca_pml_ob1_coalesced_hdr_t *hdr;
+    size_t capacity = mca_pml_ob1.coalesce_size;
+
+    if (capacity > bml_btl->btl->btl_eager_limit) {
+        capacity = bml_btl->btl->btl_eager_limit;
+    }
+    if (sizeof (*hdr) + entry_size > capacity) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
+    mca_bml_base_alloc (bml_btl, &coalesce->des, MCA_BTL_NO_ORDER, capacity,
+                        MCA_BTL_DES_FLAGS_PRIORITY | MCA_BTL_DES_FLAGS_BTL_OWNERSHIP);
+    if (OPAL_UNLIKELY(NULL == coalesce->des)) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
+    hdr = (mca_pml_ob1_coalesced_hdr_t *) coalesce->des->des_segments->seg_addr.pval;
+    mca_pml_ob1_common_hdr_prepare (&hdr->hdr_common, MCA_PML_OB1_HDR_TYPE_MATCH,
+                                    MCA_PML_OB1_HDR_FLAGS_COALESCED);
+    hdr->hdr_count = 0;
+    hdr->hdr_padding = 0;
+
+    coalesce->bml_btl = bml_btl;
+    coalesce->capacity = capacity;
+    coalesce->used = sizeof (*hdr);
+    coalesce->count = 0;
+    coalesce->opened = opal_timer_base_get_usec ();
+
+    mca_pml_ob1_coalesce_enqueue (coalesce);
+
+    return OMPI_SUCCESS;
+}
+
+int mca_pml_ob1_coalesce_send (const void *buf, size_t count, ompi_datatype_t *datatype,
+                               int tag, int16_t seqn, mca_pml_ob1_comm_proc_t *ob1_proc,
+                               mca_bml_base_endpoint_t *endpoint, ompi_communicator_t *comm)
+{
+    ompi_proc_t *dst_proc = ob1_proc->ompi_proc;
+    mca_pml_ob1_coalesce_t *coalesce;
+    mca_pml_ob1_coalesced_entry_t entry;
+    opal_convertor_t convertor;
+    size_t size, entry_size;
+    unsigned char *ptr;
+    int rc = OMPI_SUCCESS;
+
+    ompi_datatype_type_size (datatype, &size);
+    if (size * count > mca_pml_ob1.coalesce_max_msg) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
+    /* the tagged messages go through btl_tm_send */
+    if (mca_pml_ob1_tm_endpoint (endpoint) && mca_pml_ob1_tm_eligible (comm->c_my_rank, tag)) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
+#if OPAL_ENABLE_HETEROGENEOUS_SUPPORT
+    /* the coalesced headers are never byte swapped */
+    if (dst_proc->super.proc_arch != ompi_proc_local()->super.proc_arch) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+#endif
+
+    /* initialize just enough of the convertor to avoid a SEGV in opal_convertor_cleanup */
+    OBJ_CONSTRUCT(&convertor, opal_convertor_t);
+    if (count > 0) {
+        opal_convertor_copy_and_prepare_for_send (dst_proc->super.proc_convertor,
+                                                  (const struct opal_datatype_t *) datatype,
+                                                  count, buf, 0, &convertor);
+        if (!(convertor.flags & CONVERTOR_HOMOGENEOUS) || (convertor.flags & CONVERTOR_CUDA)) {
+            opal_convertor_cleanup (&convertor);
+            return OMPI_ERR_NOT_AVAILABLE;
+        }
+        opal_convertor_get_packed_size (&convertor, &size);
+    } else {
+        size = 0;
+    }
+
+    entry.entry_len = (uint32_t) (OMPI_PML_OB1_MATCH_HDR_LEN + size);
+    entry.entry_padding = 0;
+    entry_size = OPAL_ALIGN(sizeof (entry) + entry.entry_len, MCA_PML_OB1_COALESCED_ALIGN, size_t);
+
+    coalesce = mca_pml_ob1_coalesce_get (ob1_proc);
+    if (OPAL_UNLIKELY(NULL == coalesce)) {
+        rc = OMPI_ERR_NOT_AVAILABLE;
+        goto cleanup;
+    }
+
+    OPAL_THREAD_LOCK(&coalesce->lock);
+    if (NULL != coalesce->des &&
+        (coalesce->used + entry_size > coalesce->capacity || UINT16_MAX == coalesce->count)) {
+        if (OMPI_SUCCESS != mca_pml_ob1_coalesce_flush_locked (coalesce)) {
+            rc = OMPI_ERR_NOT_AVAILABLE;
+            goto unlock;
+        }
+    }
+
+    if (NULL == coalesce->des) {
+        rc = mca_pml_ob1_coalesce_open (coalesce, endpoint, entry_size);
+        if (OMPI_SUCCESS != rc) {
+            goto unlock;
+        }
+    }
+
+    ptr = (unsigned char *) coalesce->des->des_segments->seg_addr.pval + coalesce->used;
+    memcpy (ptr, &entry, sizeof (entry));
+    mca_pml_ob1_match_hdr_prepare ((mca_pml_ob1_match_hdr_t *) (ptr + sizeof (entry)),
+                                   MCA_PML_OB1_HDR_TYPE_MATCH, 0, comm->c_contextid,
+                                   comm->c_my_rank, tag, seqn);
+    if (size > 0) {
+        struct iovec iov = {.iov_base = (IOVBASE_TYPE *) (ptr + sizeof (entry) + OMPI_PML_OB1_MATCH_HDR_LEN),
+                            .iov_len = size};
+        uint32_t iov_count = 1;
+        size_t max_data = size;
+
+        (void) opal_convertor_pack (&convertor, &iov, &iov_count, &max_data);
+    }
+
+    coalesce->used += entry_size;
+    coalesce->count++;
+
+    SPC_USER_OR_MPI(tag, (ompi_spc_value_t) size, OMPI_SPC_BYTES_SENT_USER, OMPI_SPC_BYTES_SENT_MPI);
+
+ unlock:
+    OPAL_THREAD_UNLOCK(&coalesce->lock);
+ cleanup:
+    if (count > 0) {
+        opal_convertor_cleanup (&convertor);
+    }
+
+    return rc;
+}
+
+void mca_pml_ob1_coalesce_flush (mca_pml_ob1_comm_proc_t *ob1_proc)
+{
+    mca_pml_ob1_coalesce_t *coalesce = ob1_proc->coalesce;
+
+    if (NULL == coalesce || NULL == coalesce->des) {
+        return;
+    }
+
+    OPAL_THREAD_LOCK(&coalesce->lock);
+    /* on failure the progress engine tries again */
+    (void) mca_pml_ob1_coalesce_flush_locked (coalesce);
+    OPAL_THREAD_UNLOCK(&coalesce->lock);
+}
+
+void mca_pml_ob1_coalesce_release (mca_pml_ob1_comm_proc_t *ob1_proc)
+{
+    mca_pml_ob1_coalesce_t *coalesce = ob1_proc->coalesce;
+
+    if (NULL == coalesce) {
+        return;
+    }
+
+    OPAL_THREAD_LOCK(&coalesce->lock);
+    if (NULL != coalesce->des) {
+        /* mca_pml_ob1_del_comm sent everything it could */
+        mca_bml_base_free (coalesce->bml_btl, coalesce->des);
+        coalesce->des = NULL;
+    }
+    OPAL_THREAD_UNLOCK(&coalesce->lock);
+
+    ob1_proc->coalesce = NULL;
+    OBJ_RELEASE(coalesce);
+}
+
+int mca_pml_ob1_coalesce_progress (void)
+{
+    mca_pml_ob1_coalesce_t *expired[MCA_PML_OB1_COALESCE_PROGRESS_BATCH], *coalesce, *next;
+    int nexpired = 0, sent = 0;
+    uint64_t now;
+
+    if (opal_list_is_empty (&mca_pml_ob1.coalesce_pending)) {
+        return 0;
+    }
+
+    now = opal_timer_base_get_usec ();
+
+    /* the fragments are sent outside of the list lock, the completion
+     * callbacks can start other sends. The references of the list move
+     * to the expired array. */
+    OPAL_THREAD_LOCK(&mca_pml_ob1.coalesce_lock);
+    OPAL_LIST_FOREACH_SAFE(coalesce, next, &mca_pml_ob1.coalesce_pending, mca_pml_ob1_coalesce_t) {
+        if (NULL != coalesce->des && now - coalesce->opened < mca_pml_ob1.coalesce_delay) {
+            continue;
+        }
+        opal_list_remove_item (&mca_pml_ob1.coalesce_pending, &coalesce->super);
+        coalesce->pending = false;
+        expired[nexpired++] = coalesce;
+        if (MCA_PML_OB1_COALESCE_PROGRESS_BATCH == nexpired) {
+            break;
+        }
+    }
+    OPAL_THREAD_UNLOCK(&mca_pml_ob1.coalesce_lock);
+
+    for (int i = 0 ; i < nexpired ; ++i) {
+        coalesce = expired[i];
+
+        OPAL_THREAD_LOCK(&coalesce->lock);
+        if (NULL != coalesce->des) {
+            if (OMPI_ERR_OUT_OF_RESOURCE == mca_pml_ob1_coalesce_flush_locked (coalesce)) {
+                mca_pml_ob1_coalesce_enqueue (coalesce);
+            } else {
+                ++sent;
+            }
+        }
+        OPAL_THREAD_UNLOCK(&coalesce->lock);
+
+        OBJ_RELEASE(coalesce);
+    }
+
+    return sent;
+}
@@ -0,0 +1,88 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Sender side coalescing of short messages.
+ *
+ * When pml_ob1_coalesce_size is set, the short non-synchronous sends to a
+ * peer are packed in an eager fragment of the peer instead of being sent
+ * one by one. The fragment leaves when the next message does not fit, when
+ * a message to the same peer takes the usual path, or from the progress
+ * engine once it is older than pml_ob1_coalesce_delay microseconds. The
+ * receiver delivers the messages one at a time in
+ * mca_pml_ob1_recv_frag_callback_match, the sequence numbers keep them in
+ * order with the messages that were not coalesced.
+ */
+#ifndef MCA_PML_OB1_COALESCE_H
+#define MCA_PML_OB1_COALESCE_H
+
+#include "ompi_config.h"
+
+#include "opal/class/opal_list.h"
+#include "opal/mca/threads/mutex.h"
+#include "ompi/mca/bml/bml.h"
+
+#include "pml_ob1.h"
+#include "pml_ob1_comm.h"
+
+BEGIN_C_DECLS
+
+/**
+ * Fragment being filled for a peer, hung on its mca_pml_ob1_comm_proc_t.
+ * mca_pml_ob1.coalesce_pending holds a reference while it is queued, so
+ * the progress engine never sees it freed.
+ */
+struct mca_pml_ob1_coalesce_t {
+    opal_list_item_t super;                 /**< on mca_pml_ob1.coalesce_pending */
+    opal_mutex_t lock;
+    mca_bml_base_btl_t *bml_btl;            /**< btl of the open fragment */
+    mca_btl_base_descriptor_t *des;         /**< open fragment, NULL if none */
+    size_t used;                            /**< bytes used in the fragment */
+    size_t capacity;
+    uint16_t count;                         /**< messages in the fragment */
+    uint64_t opened;                        /**< time the first message was added (usec) */
+    bool pending;                           /**< on mca_pml_ob1.coalesce_pending */
+};
+typedef struct mca_pml_ob1_coalesce_t mca_pml_ob1_coalesce_t;
+OBJ_CLASS_DECLARATION(mca_pml_ob1_coalesce_t);
+
+/**
+ * Add a short message to the fragment of the peer.
+ *
+ * @return OMPI_SUCCESS if the message was packed (the send is complete)
+ * @return OMPI_ERR_NOT_AVAILABLE if the message has to take the usual path
+ */
+int mca_pml_ob1_coalesce_send (const void *buf, size_t count, ompi_datatype_t *datatype,
+                               int tag, int16_t seqn, mca_pml_ob1_comm_proc_t *ob1_proc,
+                               mca_bml_base_endpoint_t *endpoint, ompi_communicator_t *comm);
+
+/**
+ * Send the open fragment of the peer, if any, so that it does not get
+ * behind a message sent by another way.
+ */
+void mca_pml_ob1_coalesce_flush (mca_pml_ob1_comm_proc_t *ob1_proc);
+
+/** Release the coalescing state of a peer, called when it is destructed */
+void mca_pml_ob1_coalesce_release (mca_pml_ob1_comm_proc_t *ob1_proc);
+
+/** Send the fragments that are open for too long */
+int mca_pml_ob1_coalesce_progress (void);
+
+static inline bool mca_pml_ob1_coalesce_enabled (void)
+{
+    return 0 != mca_pml_ob1.coalesce_size;
+}
+
+END_C_DECLS
+
+#endif  /* MCA_PML_OB1_COALESCE_H */
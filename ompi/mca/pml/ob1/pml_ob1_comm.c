@@ -20,10 +20,13 @@
  */
 
 #include "ompi_config.h"
+#include <stdint.h>
 #include <string.h>
 
 #include "pml_ob1.h"
 #include "pml_ob1_comm.h"
+#include "pml_ob1_coalesce.h"
+#include "pml_ob1_prq_vector.h"
 
 
 
@@ -33,9 +36,16 @@ static void mca_pml_ob1_comm_proc_construct(mca_pml_ob1_comm_proc_t* proc)
     proc->expected_sequence = 1;
     proc->send_sequence = 0;
     proc->frags_cant_match = NULL;
+    proc->coalesce = NULL;
+    proc->adapt_unexpected = 0;
+    proc->adapt_eager_limit = 0;
+    proc->adapt_bandwidth = 0.0;
+    proc->flow_credits = mca_pml_ob1.flow_credits;
+    proc->flow_returnable = 0;
 #if !MCA_PML_OB1_CUSTOM_MATCH
     OBJ_CONSTRUCT(&proc->specific_receives, opal_list_t);
     OBJ_CONSTRUCT(&proc->unexpected_frags, opal_list_t);
+    OBJ_CONSTRUCT(&proc->lane_lock, opal_mutex_t);
 #endif
 }
 
@@ -43,9 +53,11 @@ static void mca_pml_ob1_comm_proc_construct(mca_pml_ob1_comm_proc_t* proc)
 static void mca_pml_ob1_comm_proc_destruct(mca_pml_ob1_comm_proc_t* proc)
 {
     assert(NULL == proc->frags_cant_match);
+    mca_pml_ob1_coalesce_release(proc);
 #if !MCA_PML_OB1_CUSTOM_MATCH
     OBJ_DESTRUCT(&proc->specific_receives);
     OBJ_DESTRUCT(&proc->unexpected_frags);
+    OBJ_DESTRUCT(&proc->lane_lock);
 #endif
     if (proc->ompi_proc) {
         OBJ_RELEASE(proc->ompi_proc);
@@ -62,6 +74,21 @@ static void mca_pml_ob1_comm_construct(mca_pml_ob1_comm_t* comm)
 {
 #if !MCA_PML_OB1_CUSTOM_MATCH
     OBJ_CONSTRUCT(&comm->wild_receives, opal_list_t);
+    comm->posted_receives = 0;
+    comm->prq_vector = NULL;
+    comm->prq_vector_active = false;
+    if (MCA_PML_OB1_MATCHING_VECTOR == mca_pml_ob1.matching_engine) {
+        /* stay on the lists if the queue cannot be allocated */
+        comm->prq_vector = mca_pml_ob1_prq_vector_create();
+        comm->prq_vector_active = (NULL != comm->prq_vector);
+    }
+    /* the peer locks only pay off with concurrent matching */
+    comm->lanes = mca_pml_ob1.matching_lanes && opal_using_threads();
+    comm->lanes_active = 0;
+    comm->lanes_blocked = 0;
+    /* the activation of the vector queue has to be done under matching_lock */
+    comm->lanes_threshold = (MCA_PML_OB1_MATCHING_AUTO == mca_pml_ob1.matching_engine) ?
+        mca_pml_ob1.matching_vector_threshold : SIZE_MAX;
 #else
     comm->prq = custom_match_prq_init();
     comm->umq = custom_match_umq_init();
@@ -89,6 +116,7 @@ static void mca_pml_ob1_comm_destruct(mca_pml_ob1_comm_t* comm)
 
 #if !MCA_PML_OB1_CUSTOM_MATCH
     OBJ_DESTRUCT(&comm->wild_receives);
+    mca_pml_ob1_prq_vector_destroy(comm->prq_vector);
 #else
     custom_match_prq_destroy(comm->prq);
     custom_match_umq_destroy(comm->umq);
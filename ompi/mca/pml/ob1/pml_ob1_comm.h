@@ -27,6 +27,7 @@
 #define MCA_PML_OB1_COMM_H
 
 #include "opal/mca/threads/mutex.h"
+#include "opal/sys/atomic.h"
 #include "opal/class/opal_list.h"
 #include "ompi/proc/proc.h"
 #include "ompi/communicator/communicator.h"
@@ -46,9 +47,16 @@ struct mca_pml_ob1_comm_proc_t {
     uint16_t expected_sequence;    /**< send message sequence number - receiver side */
     opal_atomic_int32_t send_sequence; /**< send side sequence number */
     struct mca_pml_ob1_recv_frag_t* frags_cant_match;  /**< out-of-order fragment queues */
+    struct mca_pml_ob1_coalesce_t *coalesce;  /**< short messages being coalesced, see pml_ob1_coalesce.h */
+    int32_t adapt_unexpected;      /**< smoothed share of the messages that arrived unexpected - receiver side, see pml_ob1_adapt.h */
+    size_t adapt_eager_limit;      /**< eager limit of the sends, 0 for the one of the btl - sender side */
+    double adapt_bandwidth;        /**< smoothed bandwidth of the rendezvous sends (Mbps) - sender side */
+    opal_atomic_int32_t flow_credits;    /**< eager credits to the peer - sender side, see pml_ob1_flow.h */
+    opal_atomic_int32_t flow_returnable; /**< credits due to the peer - receiver side */
 #if !MCA_PML_OB1_CUSTOM_MATCH
     opal_list_t specific_receives; /**< queues of unmatched specific receives */
     opal_list_t unexpected_frags;  /**< unexpected fragment queues */
+    opal_mutex_t lane_lock;        /**< matching lock of the peer, see mca_pml_ob1_comm_match_lock */
 #endif
 };
 
@@ -64,6 +72,13 @@ struct mca_pml_comm_t {
     opal_mutex_t matching_lock;   /**< matching lock */
 #if !MCA_PML_OB1_CUSTOM_MATCH
     opal_list_t wild_receives;    /**< queue of unmatched wild (source process not specified) receives */
+    opal_atomic_size_t posted_receives;  /**< number of receives on the wild and specific queues */
+    struct mca_pml_ob1_prq_vector_t *prq_vector;  /**< vectorized posted receive queue */
+    bool prq_vector_active;       /**< the posted receives are in prq_vector, not on the lists */
+    bool lanes;                   /**< per peer matching is enabled */
+    opal_atomic_int32_t lanes_active;   /**< matching operations in progress on the peer locks */
+    opal_atomic_int32_t lanes_blocked;  /**< operations holding or waiting for matching_lock */
+    size_t lanes_threshold;       /**< posted receives from which the vector queue gets activated */
 #endif
     opal_mutex_t proc_lock;
     mca_pml_ob1_comm_proc_t **procs;
@@ -117,6 +132,70 @@ static inline mca_pml_ob1_comm_proc_t *mca_pml_ob1_peer_lookup (struct ompi_comm
 
 extern int mca_pml_ob1_comm_init_size(mca_pml_ob1_comm_t* comm, size_t size);
 
+/**
+ * Take the matching lock for an operation on the queues of a peer, or on
+ * all the queues of the communicator when proc is NULL.
+ *
+ * With several threads, the fragments and the receives of different peers
+ * are matched in parallel, each under the lane_lock of its peer, as long
+ * as the communicator has no wildcard receive posted (and does not use the
+ * vector queue). Everything else takes matching_lock and waits until the
+ * operations on the peer locks are done, the other peers then wait until
+ * it releases matching_lock. The peer operations only touch the queues of
+ * their peer, the atomic counters and recv_sequence.
+ *
+ * @return true if the peer lock was taken, to pass to
+ * mca_pml_ob1_comm_match_unlock
+ */
+static inline bool mca_pml_ob1_comm_match_lock (mca_pml_ob1_comm_t *comm, mca_pml_ob1_comm_proc_t *proc)
+{
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    if (!comm->lanes) {
+        OB1_MATCHING_LOCK(&comm->matching_lock);
+        return false;
+    }
+
+    if (NULL != proc) {
+        opal_atomic_add_fetch_32 (&comm->lanes_active, 1);
+        opal_atomic_mb ();
+        if (OPAL_LIKELY(0 == comm->lanes_blocked && !comm->prq_vector_active &&
+                        0 == opal_list_get_size (&comm->wild_receives) &&
+                        comm->posted_receives < comm->lanes_threshold)) {
+            OB1_MATCHING_LOCK(&proc->lane_lock);
+            return true;
+        }
+        opal_atomic_add_fetch_32 (&comm->lanes_active, -1);
+    }
+
+    OB1_MATCHING_LOCK(&comm->matching_lock);
+    opal_atomic_add_fetch_32 (&comm->lanes_blocked, 1);
+    opal_atomic_mb ();
+    while (0 != comm->lanes_active) {
+        opal_atomic_rmb ();
+    }
+    return false;
+#else
+    OB1_MATCHING_LOCK(&comm->matching_lock);
+    return false;
+#endif
+}
+
+static inline void mca_pml_ob1_comm_match_unlock (mca_pml_ob1_comm_t *comm, mca_pml_ob1_comm_proc_t *proc,
+                                                  bool lane)
+{
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    if (lane) {
+        OB1_MATCHING_UNLOCK(&proc->lane_lock);
+        opal_atomic_add_fetch_32 (&comm->lanes_active, -1);
+        return;
+    }
+    if (comm->lanes) {
+        opal_atomic_add_fetch_32 (&comm->lanes_blocked, -1);
+    }
+#endif
+    OB1_MATCHING_UNLOCK(&comm->matching_lock);
+}
+
 END_C_DECLS
 #endif
 
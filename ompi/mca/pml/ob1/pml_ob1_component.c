@@ -41,8 +41,13 @@
 #include "pml_ob1_recvfrag.h"
 #include "ompi/mca/bml/base/base.h"
 #include "pml_ob1_component.h"
+#include "pml_ob1_prq_vector.h"
+#include "pml_ob1_coalesce.h"
+#include "pml_ob1_adapt.h"
+#include "pml_ob1_flow.h"
 #include "opal/mca/allocator/base/base.h"
 #include "opal/mca/base/mca_base_pvar.h"
+#include "opal/mca/base/mca_base_event.h"
 #include "opal/runtime/opal_params.h"
 #include "opal/mca/btl/base/base.h"
 
@@ -60,6 +65,13 @@ mca_pml_ob1_component_init( int* priority, bool enable_progress_threads,
 static int mca_pml_ob1_component_fini(void);
 int mca_pml_ob1_output = 0;
 static int mca_pml_ob1_verbose = 0;
+
+static mca_base_var_enum_value_t mca_pml_ob1_matching_engine_values[] = {
+    {MCA_PML_OB1_MATCHING_LIST, "list"},
+    {MCA_PML_OB1_MATCHING_VECTOR, "vector"},
+    {MCA_PML_OB1_MATCHING_AUTO, "auto"},
+    {0, NULL}
+};
 bool mca_pml_ob1_matching_protection = false;
 
 mca_pml_base_component_2_1_0_t mca_pml_ob1_component = {
@@ -185,6 +197,9 @@ static int mca_pml_ob1_get_posted_recvq_size (const struct mca_base_pvar_t *pvar
                                                      //       as we only have one set of queues.
 #else
             values[i] = opal_list_get_size (&pml_proc->specific_receives);
+            if (pml_comm->prq_vector_active) {
+                values[i] += mca_pml_ob1_prq_vector_peer_size (pml_comm->prq_vector, i);
+            }
 #endif
         } else {
             values[i] = 0;
@@ -194,6 +209,69 @@ static int mca_pml_ob1_get_posted_recvq_size (const struct mca_base_pvar_t *pvar
     return OMPI_SUCCESS;
 }
 
+static int mca_pml_ob1_get_adaptive_eager_limit (const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    ompi_communicator_t *comm = (ompi_communicator_t *) obj_handle;
+    mca_pml_ob1_comm_t *pml_comm = comm->c_pml_comm;
+    int comm_size = ompi_comm_size (comm);
+    unsigned long *values = (unsigned long *) value;
+
+    for (int i = 0 ; i < comm_size ; ++i) {
+        values[i] = pml_comm->procs[i] ? (unsigned long) pml_comm->procs[i]->adapt_eager_limit : 0;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int mca_pml_ob1_get_adaptive_unexpected (const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    ompi_communicator_t *comm = (ompi_communicator_t *) obj_handle;
+    mca_pml_ob1_comm_t *pml_comm = comm->c_pml_comm;
+    int comm_size = ompi_comm_size (comm);
+    double *values = (double *) value;
+
+    for (int i = 0 ; i < comm_size ; ++i) {
+        values[i] = pml_comm->procs[i] ?
+            (double) pml_comm->procs[i]->adapt_unexpected / MCA_PML_OB1_ADAPT_ONE : 0.0;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int mca_pml_ob1_get_adaptive_bandwidth (const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    ompi_communicator_t *comm = (ompi_communicator_t *) obj_handle;
+    mca_pml_ob1_comm_t *pml_comm = comm->c_pml_comm;
+    int comm_size = ompi_comm_size (comm);
+    double *values = (double *) value;
+
+    for (int i = 0 ; i < comm_size ; ++i) {
+        values[i] = pml_comm->procs[i] ? pml_comm->procs[i]->adapt_bandwidth : 0.0;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static mca_base_event_t *mca_pml_ob1_event_register (const char *name, const char *description)
+{
+    static const mca_base_var_type_t types[] = {MCA_BASE_VAR_TYPE_INT, MCA_BASE_VAR_TYPE_INT,
+                                                MCA_BASE_VAR_TYPE_SIZE_T};
+    static const size_t offsets[] = {offsetof (mca_pml_ob1_event_data_t, peer),
+                                     offsetof (mca_pml_ob1_event_data_t, tag),
+                                     offsetof (mca_pml_ob1_event_data_t, bytes)};
+    mca_base_event_t *event = NULL;
+    int index;
+
+    index = mca_base_component_event_register (&mca_pml_ob1_component.pmlm_version, name, description,
+                                               OPAL_INFO_LVL_5, types, offsets, 3, NULL,
+                                               MPI_T_BIND_MPI_COMM, 0);
+    if (0 <= index) {
+        (void) mca_base_event_get (index, &event);
+    }
+
+    return event;
+}
+
 static int mca_pml_ob1_component_register(void)
 {
     mca_pml_ob1_param_register_int("verbose", 0, &mca_pml_ob1_verbose);
@@ -216,12 +294,153 @@ static int mca_pml_ob1_component_register(void)
 
     mca_pml_ob1_param_register_uint("unexpected_limit", 128, &mca_pml_ob1.unexpected_limit);
 
+    mca_base_var_enum_t *new_enum;
+    mca_pml_ob1.matching_engine = MCA_PML_OB1_MATCHING_AUTO;
+    (void) mca_base_var_enum_create("pml_ob1_matching_engine", mca_pml_ob1_matching_engine_values, &new_enum);
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "matching_engine",
+                                           "Posted receive queue: \"list\" keeps per peer lists, \"vector\" "
+                                           "matches against a single vectorized queue, \"auto\" moves a communicator "
+                                           "to the vectorized queue once it has matching_vector_threshold receives "
+                                           "posted, and back once they have all matched (default: auto). Only used "
+                                           "when ob1 was not configured with a custom matching engine",
+                                           MCA_BASE_VAR_TYPE_INT, new_enum, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_pml_ob1.matching_engine);
+    OBJ_RELEASE(new_enum);
+
+    mca_pml_ob1.matching_vector_threshold = 64;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "matching_vector_threshold",
+                                           "Number of posted receives above which a communicator switches to the "
+                                           "vectorized posted receive queue when matching_engine is auto (default: 64)",
+                                           MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_pml_ob1.matching_vector_threshold);
+
+    mca_pml_ob1.matching_vector_avx512 = true;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "matching_vector_avx512",
+                                           "Use the AVX-512 kernel for the vectorized posted receive queue when the "
+                                           "processor supports it (default: true)",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_pml_ob1.matching_vector_avx512);
+
+    mca_pml_ob1.matching_lanes = true;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "matching_lanes",
+                                           "With several threads, match the messages of different peers in "
+                                           "parallel while no wildcard receive is posted on the communicator "
+                                           "(default: true)",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_pml_ob1.matching_lanes);
+
     mca_pml_ob1.use_all_rdma = false;
     (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "use_all_rdma",
                                            "Use all available RDMA btls for the RDMA and RDMA pipeline protocols "
                                            "(default: false)", MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
                                            OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_GROUP, &mca_pml_ob1.use_all_rdma);
 
+    mca_pml_ob1.rdma_adaptive = true;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "rdma_adaptive",
+                                           "Split the RDMA transfers over the btls according to the bandwidth "
+                                           "observed on each of them, instead of their nominal bandwidth. Large "
+                                           "pipelined messages are split again as they progress (default: true)",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_GROUP, &mca_pml_ob1.rdma_adaptive);
+
+    mca_pml_ob1.rdma_adaptive_alpha = 0.25;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "rdma_adaptive_alpha",
+                                           "Weight of the newest fragment in the smoothed bandwidth of a btl, "
+                                           "between 0 (exclusive) and 1 (default: 0.25)",
+                                           MCA_BASE_VAR_TYPE_DOUBLE, NULL, 0, 0, OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_GROUP, &mca_pml_ob1.rdma_adaptive_alpha);
+
+    mca_pml_ob1.rdma_iov_max_segments = 16;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "rdma_iov_max_segments",
+                                           "Maximum number of contiguous blocks of a non-contiguous buffer for the "
+                                           "receiver to get them directly instead of the copy in/out protocol, 0 "
+                                           "disables it (default: 16, at most 64)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_GROUP, &mca_pml_ob1.rdma_iov_max_segments);
+
+    mca_pml_ob1.rdma_iov_min_segment_size = 4096;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "rdma_iov_min_segment_size",
+                                           "Minimum average size of the contiguous blocks of a non-contiguous "
+                                           "buffer for the direct get (default: 4096)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_GROUP, &mca_pml_ob1.rdma_iov_min_segment_size);
+
+    mca_pml_ob1.coalesce_size = 0;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "coalesce_size",
+                                           "Size of the fragments in which the short non-blocking sends to a "
+                                           "peer are packed together, at most the eager limit of the btl, 0 "
+                                           "disables coalescing (default: 0)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_pml_ob1.coalesce_size);
+
+    mca_pml_ob1.coalesce_max_msg = 256;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "coalesce_max_msg",
+                                           "Largest message that is coalesced (default: 256)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_GROUP, &mca_pml_ob1.coalesce_max_msg);
+
+    mca_pml_ob1.coalesce_delay = 0;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "coalesce_delay",
+                                           "Time in microseconds a coalescing fragment may wait for more "
+                                           "messages before the progress engine sends it, 0 sends it at the "
+                                           "next progress (default: 0)",
+                                           MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_GROUP, &mca_pml_ob1.coalesce_delay);
+
+    mca_pml_ob1.self_bypass = true;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "self_bypass",
+                                           "Match the messages a process sends to itself directly against its "
+                                           "posted receives and copy them from the send to the receive buffer "
+                                           "in one pass, without going through the self btl (default: true)",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_GROUP, &mca_pml_ob1.self_bypass);
+
+    mca_pml_ob1.adaptive_eager = false;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "adaptive_eager",
+                                           "Adapt the eager limit of the sends to each peer: lower it while the "
+                                           "messages of the peer mostly arrive before their receive is posted, "
+                                           "raise it back up to the eager limit of the btl otherwise (default: false)",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_pml_ob1.adaptive_eager);
+
+    mca_pml_ob1.adaptive_eager_min = 1024;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "adaptive_eager_min",
+                                           "Smallest eager limit (bytes of data) of the adaptive eager limit "
+                                           "(default: 1024)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_GROUP, &mca_pml_ob1.adaptive_eager_min);
+
+    mca_pml_ob1.adaptive_unexpected_threshold = 0.5;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "adaptive_unexpected_threshold",
+                                           "Share of the recent messages of a peer that arrived unexpected above "
+                                           "which the receiver asks it to lower its eager limit, between 0 and 1 "
+                                           "(default: 0.5)",
+                                           MCA_BASE_VAR_TYPE_DOUBLE, NULL, 0, 0, OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_GROUP, &mca_pml_ob1.adaptive_unexpected_threshold);
+
+    mca_pml_ob1.flow_credits = 0;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "flow_credits",
+                                           "Number of eager messages a process may send to a peer of a "
+                                           "communicator before the peer delivered them, the others go by "
+                                           "rendezvous. Must be the same on all the processes, at most 65535, and "
+                                           "disables coalescing. 0 disables the flow control (default: 0)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_ALL_EQ, &mca_pml_ob1.flow_credits);
+
+    mca_pml_ob1.flow_threshold = 64 * 1024 * 1024;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "flow_threshold",
+                                           "Bytes of buffered unexpected and out of order fragments above which "
+                                           "the flow control holds the credits back (default: 64MB)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_GROUP, &mca_pml_ob1.flow_threshold);
+
+    mca_pml_ob1.tag_matching = false;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "tag_matching",
+                                           "Match the messages in the network when the only eager btl to a peer "
+                                           "supports it. Must be the same on all the processes (default: false)",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_ALL_EQ, &mca_pml_ob1.tag_matching);
+
     mca_pml_ob1.allocator_name = "bucket";
     (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "allocator",
                                            "Name of allocator component for unexpected messages",
@@ -241,6 +460,49 @@ static int mca_pml_ob1_component_register(void)
                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
                                            mca_pml_ob1_get_posted_recvq_size, NULL, mca_pml_ob1_comm_size_notify, NULL);
 
+    (void)mca_base_component_pvar_register(&mca_pml_ob1_component.pmlm_version,
+                                           "adaptive_eager_limit", "Eager limit (bytes of data) of the sends "
+                                           "to each peer in a communicator, 0 while it is the one of the btl",
+                                           OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_LEVEL,
+                                           MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL, MPI_T_BIND_MPI_COMM,
+                                           MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                           mca_pml_ob1_get_adaptive_eager_limit, NULL, mca_pml_ob1_comm_size_notify, NULL);
+
+    (void)mca_base_component_pvar_register(&mca_pml_ob1_component.pmlm_version,
+                                           "adaptive_unexpected_share", "Smoothed share of the messages "
+                                           "received from each peer in a communicator that arrived unexpected",
+                                           OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_LEVEL,
+                                           MCA_BASE_VAR_TYPE_DOUBLE, NULL, MPI_T_BIND_MPI_COMM,
+                                           MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                           mca_pml_ob1_get_adaptive_unexpected, NULL, mca_pml_ob1_comm_size_notify, NULL);
+
+    (void)mca_base_component_pvar_register(&mca_pml_ob1_component.pmlm_version,
+                                           "adaptive_rndv_bandwidth", "Smoothed bandwidth (Mbps) of the "
+                                           "rendezvous sends to each peer in a communicator",
+                                           OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_LEVEL,
+                                           MCA_BASE_VAR_TYPE_DOUBLE, NULL, MPI_T_BIND_MPI_COMM,
+                                           MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                           mca_pml_ob1_get_adaptive_bandwidth, NULL, mca_pml_ob1_comm_size_notify, NULL);
+
+    mca_pml_ob1.flow_buffered = 0;
+    (void)mca_base_component_pvar_register(&mca_pml_ob1_component.pmlm_version,
+                                           "flow_buffered", "Bytes of the fragments buffered by the receiver, "
+                                           "counted while the flow control is enabled",
+                                           OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_LEVEL,
+                                           MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL, MPI_T_BIND_NO_OBJECT,
+                                           MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                           NULL, NULL, NULL, (void *) &mca_pml_ob1.flow_buffered);
+
+    mca_pml_ob1.event_rndv_start =
+        mca_pml_ob1_event_register ("rndv_start", "A send started the rendezvous or the RDMA get "
+                                    "protocol (elements: destination, tag, message bytes)");
+    mca_pml_ob1.event_rdma_complete =
+        mca_pml_ob1_event_register ("rdma_complete", "An RDMA put or get of a message completed "
+                                    "(elements: peer, tag, fragment bytes)");
+    mca_pml_ob1.event_unexpected =
+        mca_pml_ob1_event_register ("unexpected", "A message arrived before its receive was posted "
+                                    "(elements: source, tag, bytes of the first fragment)");
+
     return OMPI_SUCCESS;
 }
 
@@ -279,6 +541,8 @@ mca_pml_ob1_component_init( int* priority,
 
     *priority = mca_pml_ob1.priority;
 
+    mca_pml_ob1_prq_vector_select_kernel ();
+
     allocator_component = mca_allocator_component_lookup( mca_pml_ob1.allocator_name );
     if(NULL == allocator_component) {
         opal_output(0, "mca_pml_ob1_component_init: can't find allocator: %s\n", mca_pml_ob1.allocator_name);
@@ -298,6 +562,27 @@ mca_pml_ob1_component_init( int* priority,
         return NULL;
     }
 
+    if (mca_pml_ob1.rdma_adaptive_alpha <= 0.0 || mca_pml_ob1.rdma_adaptive_alpha > 1.0) {
+        opal_output_verbose(1, mca_pml_ob1_output, "pml:ob1: invalid rdma_adaptive_alpha %g, using 0.25",
+                            mca_pml_ob1.rdma_adaptive_alpha);
+        mca_pml_ob1.rdma_adaptive_alpha = 0.25;
+    }
+
+    if (mca_pml_ob1.flow_credits > MCA_PML_OB1_FLOW_CREDITS_MAX) {
+        opal_output_verbose(1, mca_pml_ob1_output, "pml:ob1: flow_credits %d too large, using %d",
+                            mca_pml_ob1.flow_credits, MCA_PML_OB1_FLOW_CREDITS_MAX);
+        mca_pml_ob1.flow_credits = MCA_PML_OB1_FLOW_CREDITS_MAX;
+    }
+    if (mca_pml_ob1_flow_enabled () && 0 != mca_pml_ob1.coalesce_size) {
+        /* a coalesced fragment carries several messages for one credit */
+        opal_output_verbose(1, mca_pml_ob1_output, "pml:ob1: flow control enabled, disabling coalescing");
+        mca_pml_ob1.coalesce_size = 0;
+    }
+
+    if (OMPI_SUCCESS != mca_pml_ob1_rdma_rails_init()) {
+        opal_output_verbose(1, mca_pml_ob1_output, "pml:ob1: could not set up the per rail RDMA statistics");
+    }
+
     /* check if any btls do not support dynamic add_procs */
     mca_btl_base_selected_module_t* selected_btl;
     OPAL_LIST_FOREACH(selected_btl, &mca_btl_base_modules_initialized, mca_btl_base_selected_module_t) {
@@ -321,6 +606,8 @@ int mca_pml_ob1_component_fini(void)
 {
     int rc;
 
+    mca_pml_ob1_rdma_rails_fini();
+
     /* Shutdown BML */
     if(OMPI_SUCCESS != (rc = mca_bml.bml_finalize()))
         return rc;
@@ -352,6 +639,11 @@ int mca_pml_ob1_component_fini(void)
     OBJ_DESTRUCT(&mca_pml_ob1.recv_pending);
     OBJ_DESTRUCT(&mca_pml_ob1.send_pending);
     OBJ_DESTRUCT(&mca_pml_ob1.non_existing_communicator_pending);
+    if (mca_pml_ob1_coalesce_enabled ()) {
+        opal_progress_unregister (mca_pml_ob1_coalesce_progress);
+    }
+    OPAL_LIST_DESTRUCT(&mca_pml_ob1.coalesce_pending);
+    OBJ_DESTRUCT(&mca_pml_ob1.coalesce_lock);
     OBJ_DESTRUCT(&mca_pml_ob1.buffers);
     OBJ_DESTRUCT(&mca_pml_ob1.pending_pckts);
     OBJ_DESTRUCT(&mca_pml_ob1.recv_frags);
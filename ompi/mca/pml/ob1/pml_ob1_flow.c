@@ -0,0 +1,100 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/bml/bml.h"
+#include "ompi/runtime/ompi_spc.h"
+
+#include "pml_ob1.h"
+#include "pml_ob1_flow.h"
+#include "pml_ob1_hdr.h"
+
+static void mca_pml_ob1_flow_completion (mca_btl_base_module_t *btl, struct mca_btl_base_endpoint_t *ep,
+                                         struct mca_btl_base_descriptor_t *des, int status)
+{
+    mca_bml_base_btl_t *bml_btl = (mca_bml_base_btl_t *) des->des_context;
+
+    /* check for pending requests */
+    MCA_PML_OB1_PROGRESS_PENDING(bml_btl);
+}
+
+void mca_pml_ob1_flow_return (ompi_communicator_t *comm, mca_pml_ob1_comm_proc_t *proc)
+{
+    mca_bml_base_endpoint_t *endpoint;
+    mca_btl_base_descriptor_t *des;
+    mca_bml_base_btl_t *bml_btl;
+    int32_t credits;
+    int rc;
+
+    /* batch the returns, and hold them while too much is buffered */
+    if (!mca_pml_ob1_flow_enabled () || 2 * proc->flow_returnable < mca_pml_ob1.flow_credits ||
+        mca_pml_ob1.flow_buffered > mca_pml_ob1.flow_threshold) {
+        return;
+    }
+
+    credits = OPAL_THREAD_SWAP_32 (&proc->flow_returnable, 0);
+    if (0 == credits) {
+        /* an ACK took them */
+        return;
+    }
+
+    endpoint = mca_bml_base_get_endpoint (proc->ompi_proc);
+    bml_btl = mca_bml_base_btl_array_get_next (&endpoint->btl_eager);
+    mca_bml_base_alloc (bml_btl, &des, MCA_BTL_NO_ORDER, sizeof (mca_pml_ob1_credit_hdr_t),
+                        MCA_BTL_DES_FLAGS_PRIORITY | MCA_BTL_DES_FLAGS_BTL_OWNERSHIP);
+    if (OPAL_LIKELY(NULL != des)) {
+        des->des_cbfunc = mca_pml_ob1_flow_completion;
+        des->des_cbdata = NULL;
+
+        mca_pml_ob1_credit_hdr_prepare ((mca_pml_ob1_credit_hdr_t *) des->des_segments->seg_addr.pval,
+                                        comm->c_contextid, comm->c_my_rank, (uint32_t) credits);
+        ob1_hdr_hton ((mca_pml_ob1_hdr_t *) des->des_segments->seg_addr.pval, MCA_PML_OB1_HDR_TYPE_CREDIT,
+                      proc->ompi_proc);
+
+        rc = mca_bml_base_send (bml_btl, des, MCA_PML_OB1_HDR_TYPE_CREDIT);
+        if (OPAL_LIKELY(rc >= 0)) {
+            if (OPAL_LIKELY(1 == rc)) {
+                MCA_PML_OB1_PROGRESS_PENDING(bml_btl);
+            }
+            SPC_RECORD(OMPI_SPC_BYTES_SENT_MPI, (ompi_spc_value_t) sizeof (mca_pml_ob1_credit_hdr_t));
+            return;
+        }
+        mca_bml_base_free (bml_btl, des);
+    }
+
+    /* out of resources: the credits go with the next ACK or return */
+    OPAL_THREAD_ADD_FETCH32 (&proc->flow_returnable, credits);
+}
+
+void mca_pml_ob1_recv_frag_callback_credit (mca_btl_base_module_t *btl,
+                                            const mca_btl_base_receive_descriptor_t *descriptor)
+{
+    const mca_btl_base_segment_t *segments = descriptor->des_segments;
+    const mca_pml_ob1_credit_hdr_t *hdr = (mca_pml_ob1_credit_hdr_t *) segments->seg_addr.pval;
+    ompi_communicator_t *comm;
+
+    if (OPAL_UNLIKELY(segments->seg_len < sizeof (mca_pml_ob1_credit_hdr_t))) {
+        return;
+    }
+
+    ob1_hdr_ntoh ((mca_pml_ob1_hdr_t *) hdr, MCA_PML_OB1_HDR_TYPE_CREDIT);
+
+    /* the credits of a freed communicator are gone with it */
+    comm = ompi_comm_lookup (hdr->hdr_ctx);
+    if (OPAL_UNLIKELY(NULL == comm || NULL == comm->c_pml_comm)) {
+        return;
+    }
+
+    mca_pml_ob1_flow_grant (mca_pml_ob1_peer_lookup (comm, hdr->hdr_src), (int32_t) hdr->hdr_credits);
+}
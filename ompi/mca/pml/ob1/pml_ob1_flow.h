@@ -0,0 +1,141 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Credit based flow control of the eager messages.
+ *
+ * When pml_ob1_flow_credits is set, a sender may have at most that many
+ * eager fragments (MCA_PML_OB1_HDR_TYPE_MATCH) to a peer of a communicator
+ * that the peer did not deliver yet. The credits are granted implicitly on
+ * first contact: both sides start from pml_ob1_flow_credits when they
+ * create the mca_pml_ob1_comm_proc_t of the other, so no handshake is
+ * needed. The receiver returns the credits of the fragments it delivered
+ * (matched on arrival, or later taken off the unexpected queue) on the
+ * ACKs it sends to the peer, or in a MCA_PML_OB1_HDR_TYPE_CREDIT message
+ * once half of them are due. While the fragments buffered by the receiver
+ * exceed pml_ob1_flow_threshold bytes, it holds the credits back. A sender
+ * out of credits falls back to a rendezvous without eager data; the ACKs
+ * of those rendezvous bring the credits back once the memory is released.
+ *
+ * Each peer can therefore have at most pml_ob1_flow_credits eager
+ * fragments in the unexpected queue of a communicator. Coalescing is
+ * disabled with flow control, and all the processes must use the same
+ * pml_ob1_flow_credits.
+ */
+#ifndef MCA_PML_OB1_FLOW_H
+#define MCA_PML_OB1_FLOW_H
+
+#include "ompi_config.h"
+
+#include "opal/mca/threads/thread_usage.h"
+#include "opal/mca/btl/btl.h"
+
+#include "pml_ob1.h"
+#include "pml_ob1_comm.h"
+
+BEGIN_C_DECLS
+
+/* largest pml_ob1_flow_credits, the ACKs carry at most this many */
+#define MCA_PML_OB1_FLOW_CREDITS_MAX UINT16_MAX
+
+static inline bool mca_pml_ob1_flow_enabled (void)
+{
+    return 0 < mca_pml_ob1.flow_credits;
+}
+
+/**
+ * Take the credit of an eager fragment to rank peer. Returns false if the
+ * message has to go by rendezvous.
+ */
+static inline bool mca_pml_ob1_flow_take (ompi_communicator_t *comm, int peer)
+{
+    mca_pml_ob1_comm_proc_t *proc;
+
+    if (!mca_pml_ob1_flow_enabled ()) {
+        return true;
+    }
+
+    proc = mca_pml_ob1_peer_lookup (comm, peer);
+    if (OPAL_UNLIKELY(OPAL_THREAD_ADD_FETCH32 (&proc->flow_credits, -1) < 0)) {
+        OPAL_THREAD_ADD_FETCH32 (&proc->flow_credits, 1);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Give back a credit taken for an eager fragment that was not sent.
+ */
+static inline void mca_pml_ob1_flow_untake (ompi_communicator_t *comm, int peer)
+{
+    if (mca_pml_ob1_flow_enabled ()) {
+        OPAL_THREAD_ADD_FETCH32 (&mca_pml_ob1_peer_lookup (comm, peer)->flow_credits, 1);
+    }
+}
+
+/**
+ * Receiver side: an eager fragment of proc was delivered, its credit is due.
+ */
+static inline void mca_pml_ob1_flow_delivered (mca_pml_ob1_comm_proc_t *proc)
+{
+    if (mca_pml_ob1_flow_enabled ()) {
+        OPAL_THREAD_ADD_FETCH32 (&proc->flow_returnable, 1);
+    }
+}
+
+/**
+ * Receiver side: account for bytes of fragments buffered (positive) or
+ * released (negative).
+ */
+static inline void mca_pml_ob1_flow_buffered (ptrdiff_t bytes)
+{
+    if (mca_pml_ob1_flow_enabled ()) {
+        OPAL_THREAD_ADD_FETCH_SIZE_T (&mca_pml_ob1.flow_buffered, (size_t) bytes);
+    }
+}
+
+/**
+ * Receiver side: credits to return on an ACK to rank src, 0 while the
+ * buffered fragments are over the threshold.
+ */
+static inline uint16_t mca_pml_ob1_flow_ack_credits (ompi_communicator_t *comm, int src)
+{
+    if (!mca_pml_ob1_flow_enabled () || mca_pml_ob1.flow_buffered > mca_pml_ob1.flow_threshold) {
+        return 0;
+    }
+
+    /* never above pml_ob1_flow_credits, which fits */
+    return (uint16_t) OPAL_THREAD_SWAP_32 (&mca_pml_ob1_peer_lookup (comm, src)->flow_returnable, 0);
+}
+
+/**
+ * Sender side: credits returned by the peer of proc.
+ */
+static inline void mca_pml_ob1_flow_grant (mca_pml_ob1_comm_proc_t *proc, int32_t credits)
+{
+    OPAL_THREAD_ADD_FETCH32 (&proc->flow_credits, credits);
+}
+
+/**
+ * Receiver side: send the due credits of proc in a CREDIT message once
+ * half of them are due. Must not be called with the matching lock held.
+ */
+void mca_pml_ob1_flow_return (ompi_communicator_t *comm, mca_pml_ob1_comm_proc_t *proc);
+
+void mca_pml_ob1_recv_frag_callback_credit (mca_btl_base_module_t *btl,
+                                            const mca_btl_base_receive_descriptor_t *descriptor);
+
+END_C_DECLS
+
+#endif
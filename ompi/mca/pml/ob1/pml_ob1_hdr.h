@@ -49,6 +49,7 @@
 #define MCA_PML_OB1_HDR_TYPE_GET       (MCA_BTL_TAG_PML + 7)
 #define MCA_PML_OB1_HDR_TYPE_PUT       (MCA_BTL_TAG_PML + 8)
 #define MCA_PML_OB1_HDR_TYPE_FIN       (MCA_BTL_TAG_PML + 9)
+#define MCA_PML_OB1_HDR_TYPE_CREDIT    (MCA_BTL_TAG_PML + 10)
 
 #define MCA_PML_OB1_HDR_FLAGS_ACK     1  /* is an ack required */
 #define MCA_PML_OB1_HDR_FLAGS_NBO     2  /* is the hdr in network byte order */
@@ -56,6 +57,9 @@
 #define MCA_PML_OB1_HDR_FLAGS_CONTIG  8  /* is user buffer contiguous */
 #define MCA_PML_OB1_HDR_FLAGS_NORDMA  16 /* rest will be send by copy-in-out */
 #define MCA_PML_OB1_HDR_FLAGS_SIGNAL  32 /* message can be optionally signalling */
+#define MCA_PML_OB1_HDR_FLAGS_IOV     64 /* rget source is described by a segment list */
+#define MCA_PML_OB1_HDR_FLAGS_COALESCED 128 /* match fragment carrying several short messages */
+#define MCA_PML_OB1_HDR_FLAGS_UNEXPECTED 128 /* ack: the messages of the sender mostly arrive unexpected */
 
 /**
  * Common hdr attributes - must be first element in each hdr type
@@ -130,6 +134,29 @@ do { \
     (h).hdr_seq = htons((h).hdr_seq); \
 } while (0)
 
+/**
+ * Match fragment flagged MCA_PML_OB1_HDR_FLAGS_COALESCED: hdr_count short
+ * messages packed by the sender, see pml_ob1_coalesce.h. Each message is an
+ * entry header followed by its match header and its data, the entries are
+ * aligned on MCA_PML_OB1_COALESCED_ALIGN bytes. Coalescing is only done
+ * between processes with the same data representation, these headers are
+ * never byte swapped.
+ */
+struct mca_pml_ob1_coalesced_hdr_t {
+    mca_pml_ob1_common_hdr_t hdr_common;   /**< common attributes */
+    uint16_t hdr_count;                    /**< number of messages in the fragment */
+    uint32_t hdr_padding;
+};
+typedef struct mca_pml_ob1_coalesced_hdr_t mca_pml_ob1_coalesced_hdr_t;
+
+struct mca_pml_ob1_coalesced_entry_t {
+    uint32_t entry_len;                    /**< match header and data of the message */
+    uint32_t entry_padding;
+};
+typedef struct mca_pml_ob1_coalesced_entry_t mca_pml_ob1_coalesced_entry_t;
+
+#define MCA_PML_OB1_COALESCED_ALIGN 8
+
 /**
  * Header definition for the first fragment when an acknowledgment
  * is required. This could be the first fragment of a large message
@@ -212,6 +239,24 @@ static inline void mca_pml_ob1_rget_hdr_prepare (mca_pml_ob1_rget_hdr_t *hdr, ui
         (h).hdr_src_ptr = hton64((h).hdr_src_ptr);      \
     } while (0)
 
+/**
+ * Segment list of an RGET flagged MCA_PML_OB1_HDR_FLAGS_IOV. It follows the
+ * registration handle, which covers all the segments. The segments are in
+ * the order of the packed data. This header is only exchanged between
+ * processes with the same data representation and is never byte swapped.
+ */
+struct mca_pml_ob1_rget_iov_hdr_t {
+    uint32_t hdr_seg_count;                   /**< number of segments that follow */
+    uint32_t hdr_padding;
+};
+typedef struct mca_pml_ob1_rget_iov_hdr_t mca_pml_ob1_rget_iov_hdr_t;
+
+struct mca_pml_ob1_rget_iov_seg_t {
+    uint64_t seg_addr;                        /**< source address of the segment */
+    uint64_t seg_len;                         /**< length of the segment */
+};
+typedef struct mca_pml_ob1_rget_iov_seg_t mca_pml_ob1_rget_iov_seg_t;
+
 /**
  *  Header for subsequent fragments.
  */
@@ -262,8 +307,9 @@ static inline void mca_pml_ob1_frag_hdr_prepare (mca_pml_ob1_frag_hdr_t *hdr, ui
 
 struct mca_pml_ob1_ack_hdr_t {
     mca_pml_ob1_common_hdr_t hdr_common;      /**< common attributes */
+    uint16_t hdr_credits;                     /**< eager credits returned, see pml_ob1_flow.h */
 #if OPAL_ENABLE_HETEROGENEOUS_SUPPORT || OPAL_ENABLE_DEBUG
-    uint8_t hdr_padding[6];
+    uint8_t hdr_padding[4];
 #endif
     opal_ptr_t hdr_src_req;                   /**< source request */
     opal_ptr_t hdr_dst_req;                   /**< matched receive request */
@@ -274,16 +320,16 @@ typedef struct mca_pml_ob1_ack_hdr_t mca_pml_ob1_ack_hdr_t;
 
 static inline void mca_pml_ob1_ack_hdr_prepare (mca_pml_ob1_ack_hdr_t *hdr, uint8_t hdr_flags,
                                                 uint64_t hdr_src_req, void *hdr_dst_req,
-                                                uint64_t hdr_send_offset, uint64_t hdr_send_size)
+                                                uint64_t hdr_send_offset, uint64_t hdr_send_size,
+                                                uint16_t hdr_credits)
 {
     mca_pml_ob1_common_hdr_prepare (&hdr->hdr_common, MCA_PML_OB1_HDR_TYPE_ACK, hdr_flags);
+    hdr->hdr_credits = hdr_credits;
 #if OPAL_ENABLE_DEBUG
     hdr->hdr_padding[0] = 0;
     hdr->hdr_padding[1] = 0;
     hdr->hdr_padding[2] = 0;
     hdr->hdr_padding[3] = 0;
-    hdr->hdr_padding[4] = 0;
-    hdr->hdr_padding[5] = 0;
 #endif
     hdr->hdr_src_req.lval = hdr_src_req;
     hdr->hdr_dst_req.pval = hdr_dst_req;
@@ -298,6 +344,7 @@ static inline void mca_pml_ob1_ack_hdr_prepare (mca_pml_ob1_ack_hdr_t *hdr, uint
 #define MCA_PML_OB1_ACK_HDR_NTOH(h)                        \
     do {                                                   \
         MCA_PML_OB1_COMMON_HDR_NTOH((h).hdr_common);       \
+        (h).hdr_credits = ntohs((h).hdr_credits);          \
         (h).hdr_send_offset = ntoh64((h).hdr_send_offset); \
         (h).hdr_send_size = ntoh64((h).hdr_send_size);     \
     } while (0)
@@ -305,6 +352,7 @@ static inline void mca_pml_ob1_ack_hdr_prepare (mca_pml_ob1_ack_hdr_t *hdr, uint
 #define MCA_PML_OB1_ACK_HDR_HTON(h)                        \
     do {                                                   \
         MCA_PML_OB1_COMMON_HDR_HTON((h).hdr_common);       \
+        (h).hdr_credits = htons((h).hdr_credits);          \
         (h).hdr_send_offset = hton64((h).hdr_send_offset); \
         (h).hdr_send_size = hton64((h).hdr_send_size);     \
     } while (0)
@@ -413,6 +461,42 @@ static inline void mca_pml_ob1_fin_hdr_prepare (mca_pml_ob1_fin_hdr_t *hdr, uint
         (h).hdr_size = hton64((h).hdr_size);         \
     } while (0)
 
+/**
+ * Eager credits a receiver returns to a sender, see pml_ob1_flow.h
+ */
+struct mca_pml_ob1_credit_hdr_t {
+    mca_pml_ob1_common_hdr_t hdr_common;      /**< common attributes */
+    uint16_t hdr_ctx;                         /**< communicator index */
+    int32_t  hdr_src;                         /**< rank of the receiver in the communicator */
+    uint32_t hdr_credits;                     /**< number of credits returned */
+};
+typedef struct mca_pml_ob1_credit_hdr_t mca_pml_ob1_credit_hdr_t;
+
+static inline void mca_pml_ob1_credit_hdr_prepare (mca_pml_ob1_credit_hdr_t *hdr, uint16_t hdr_ctx,
+                                                   int32_t hdr_src, uint32_t hdr_credits)
+{
+    mca_pml_ob1_common_hdr_prepare (&hdr->hdr_common, MCA_PML_OB1_HDR_TYPE_CREDIT, 0);
+    hdr->hdr_ctx = hdr_ctx;
+    hdr->hdr_src = hdr_src;
+    hdr->hdr_credits = hdr_credits;
+}
+
+#define MCA_PML_OB1_CREDIT_HDR_NTOH(h)               \
+    do {                                             \
+        MCA_PML_OB1_COMMON_HDR_NTOH((h).hdr_common); \
+        (h).hdr_ctx = ntohs((h).hdr_ctx);            \
+        (h).hdr_src = ntohl((h).hdr_src);            \
+        (h).hdr_credits = ntohl((h).hdr_credits);    \
+    } while (0)
+
+#define MCA_PML_OB1_CREDIT_HDR_HTON(h)               \
+    do {                                             \
+        MCA_PML_OB1_COMMON_HDR_HTON((h).hdr_common); \
+        (h).hdr_ctx = htons((h).hdr_ctx);            \
+        (h).hdr_src = htonl((h).hdr_src);            \
+        (h).hdr_credits = htonl((h).hdr_credits);    \
+    } while (0)
+
 /**
  * Union of defined hdr types.
  */
@@ -425,6 +509,7 @@ union mca_pml_ob1_hdr_t {
     mca_pml_ob1_ack_hdr_t hdr_ack;
     mca_pml_ob1_rdma_hdr_t hdr_rdma;
     mca_pml_ob1_fin_hdr_t hdr_fin;
+    mca_pml_ob1_credit_hdr_t hdr_credit;
 };
 typedef union mca_pml_ob1_hdr_t mca_pml_ob1_hdr_t;
 
@@ -457,6 +542,9 @@ ob1_hdr_ntoh(mca_pml_ob1_hdr_t *hdr, const uint8_t hdr_type)
         case MCA_PML_OB1_HDR_TYPE_FIN:
             MCA_PML_OB1_FIN_HDR_NTOH(hdr->hdr_fin);
             break;
+        case MCA_PML_OB1_HDR_TYPE_CREDIT:
+            MCA_PML_OB1_CREDIT_HDR_NTOH(hdr->hdr_credit);
+            break;
         default:
             assert(0);
             break;
@@ -503,6 +591,9 @@ ob1_hdr_hton_intr(mca_pml_ob1_hdr_t *hdr, const uint8_t hdr_type,
         case MCA_PML_OB1_HDR_TYPE_FIN:
             MCA_PML_OB1_FIN_HDR_HTON(hdr->hdr_fin);
             break;
+        case MCA_PML_OB1_HDR_TYPE_CREDIT:
+            MCA_PML_OB1_CREDIT_HDR_HTON(hdr->hdr_credit);
+            break;
         default:
             assert(0);
             break;
@@ -27,6 +27,10 @@
 #include "pml_ob1.h"
 #include "pml_ob1_sendreq.h"
 #include "pml_ob1_recvreq.h"
+#include "pml_ob1_recvfrag.h"
+#include "pml_ob1_coalesce.h"
+#include "pml_ob1_flow.h"
+#include "pml_ob1_tm.h"
 #include "ompi/peruse/peruse-internal.h"
 #include "ompi/runtime/ompi_spc.h"
 
@@ -96,6 +100,15 @@ static inline int mca_pml_ob1_send_inline (const void *buf, size_t count,
         return OMPI_ERR_NOT_AVAILABLE;
     }
 
+    /* the tagged messages go through btl_tm_send */
+    if (mca_pml_ob1_tm_endpoint (endpoint) && mca_pml_ob1_tm_eligible (comm->c_my_rank, tag)) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
+    if (OPAL_UNLIKELY(!mca_pml_ob1_flow_take (comm, dst))) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
     if (count > 0) {
         /* initialize just enough of the convertor to avoid a SEGV in opal_convertor_cleanup */
         OBJ_CONSTRUCT(&convertor, opal_convertor_t);
@@ -130,6 +143,7 @@ static inline int mca_pml_ob1_send_inline (const void *buf, size_t count,
 #if SPC_ENABLE == 1
     if(OPAL_LIKELY(rc == OPAL_SUCCESS)) {
         SPC_USER_OR_MPI(tag, (ompi_spc_value_t)size, OMPI_SPC_BYTES_SENT_USER, OMPI_SPC_BYTES_SENT_MPI);
+        SPC_COMM_RECORD_SEND(comm, dst, (ompi_spc_value_t)size);
     }
 #endif
 
@@ -138,12 +152,53 @@ static inline int mca_pml_ob1_send_inline (const void *buf, size_t count,
     }
 
     if (OPAL_UNLIKELY(OMPI_SUCCESS != rc)) {
+        mca_pml_ob1_flow_untake (comm, dst);
 	return rc;
     }
 
     return (int) size;
 }
 
+/* copy a message to self straight into the posted receive, if there is one */
+static inline int mca_pml_ob1_send_self (const void *buf, size_t count,
+                                         ompi_datatype_t * datatype,
+                                         int dst, int tag, int16_t seqn,
+                                         mca_pml_ob1_comm_proc_t *ob1_proc,
+                                         mca_bml_base_endpoint_t* endpoint,
+                                         ompi_communicator_t * comm)
+{
+    mca_bml_base_btl_t *bml_btl;
+    opal_convertor_t convertor;
+    size_t size = 0;
+    int rc;
+
+    if (OPAL_UNLIKELY(0 == mca_bml_base_btl_array_get_size(&endpoint->btl_eager))) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+    bml_btl = mca_bml_base_btl_array_get_index(&endpoint->btl_eager, 0);
+
+    OBJ_CONSTRUCT(&convertor, opal_convertor_t);
+    if (count > 0) {
+        opal_convertor_copy_and_prepare_for_send (ob1_proc->ompi_proc->super.proc_convertor,
+                                                  (const struct opal_datatype_t *) datatype,
+                                                  count, buf, 0, &convertor);
+        opal_convertor_get_packed_size (&convertor, &size);
+    }
+
+    rc = mca_pml_ob1_recv_frag_match_self (bml_btl->btl, comm, ob1_proc, tag, (uint16_t) seqn,
+                                           &convertor, size);
+
+#if SPC_ENABLE == 1
+    if(OPAL_LIKELY(rc == OMPI_SUCCESS)) {
+        SPC_USER_OR_MPI(tag, (ompi_spc_value_t)size, OMPI_SPC_BYTES_SENT_USER, OMPI_SPC_BYTES_SENT_MPI);
+        SPC_COMM_RECORD_SEND(comm, dst, (ompi_spc_value_t)size);
+    }
+#endif
+
+    OBJ_DESTRUCT(&convertor);
+    return rc;
+}
+
 int mca_pml_ob1_isend(const void *buf,
                       size_t count,
                       ompi_datatype_t * datatype,
@@ -173,7 +228,30 @@ int mca_pml_ob1_isend(const void *buf,
         seqn = (uint16_t) OPAL_THREAD_ADD_FETCH32(&ob1_proc->send_sequence, 1);
     }
 
+    /* a posted receive matched here completes the send, whatever its mode */
+    if (dst_proc == ompi_proc_local() && mca_pml_ob1.self_bypass) {
+        rc = mca_pml_ob1_send_self (buf, count, datatype, dst, tag, seqn, ob1_proc,
+                                    endpoint, comm);
+        if (OPAL_LIKELY(OMPI_SUCCESS == rc)) {
+            *request = &ompi_request_empty;
+            return OMPI_SUCCESS;
+        }
+        if (OPAL_UNLIKELY(OMPI_ERR_NOT_AVAILABLE != rc)) {
+            return rc;  /* matched, the sequence number is used */
+        }
+    }
+
     if (MCA_PML_BASE_SEND_SYNCHRONOUS != sendmode) {
+        if (mca_pml_ob1_coalesce_enabled ()) {
+            rc = mca_pml_ob1_coalesce_send (buf, count, datatype, tag, seqn, ob1_proc,
+                                            endpoint, comm);
+            if (OMPI_SUCCESS == rc) {
+                *request = &ompi_request_empty;
+                return OMPI_SUCCESS;
+            }
+            mca_pml_ob1_coalesce_flush (ob1_proc);
+        }
+
         rc = mca_pml_ob1_send_inline (buf, count, datatype, dst, tag, seqn, dst_proc,
                                       endpoint, comm);
         if (OPAL_LIKELY(0 <= rc)) {
@@ -183,6 +261,8 @@ int mca_pml_ob1_isend(const void *buf,
             *request = &ompi_request_empty;
             return OMPI_SUCCESS;
         }
+    } else if (mca_pml_ob1_coalesce_enabled ()) {
+        mca_pml_ob1_coalesce_flush (ob1_proc);
     }
 
     MCA_PML_OB1_SEND_REQUEST_ALLOC(comm, dst, sendreq);
@@ -272,6 +352,20 @@ int mca_pml_ob1_send(const void *buf,
         seqn = (uint16_t) OPAL_THREAD_ADD_FETCH32(&ob1_proc->send_sequence, 1);
     }
 
+    if (dst_proc == ompi_proc_local() && mca_pml_ob1.self_bypass) {
+        rc = mca_pml_ob1_send_self (buf, count, datatype, dst, tag, seqn, ob1_proc,
+                                    endpoint, comm);
+        if (OMPI_ERR_NOT_AVAILABLE != rc) {
+            return rc;
+        }
+    }
+
+    /* blocking sends are not coalesced, send what is queued for the peer
+     * first so the receiver does not hold this message until it arrives */
+    if (mca_pml_ob1_coalesce_enabled ()) {
+        mca_pml_ob1_coalesce_flush (ob1_proc);
+    }
+
     /**
      * The immediate send will not have a request, so they are
      * intracable from the point of view of any debugger attached to
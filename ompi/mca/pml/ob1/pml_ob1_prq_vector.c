@@ -0,0 +1,420 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include "ompi/mca/pml/pml_constants.h"
+#include "pml_ob1.h"
+#include "pml_ob1_comm.h"
+#include "pml_ob1_recvreq.h"
+#include "pml_ob1_prq_vector.h"
+
+#define PRQ_VECTOR_REQ_TAG(req)  ((int32_t) (req)->req_recv.req_base.req_tag)
+#define PRQ_VECTOR_REQ_PEER(req) ((int32_t) (req)->req_recv.req_base.req_peer)
+
+/*
+ * Portable kernel. The loop has no early exit and no control flow in its
+ * body, so the compiler can vectorize it with whatever the target offers.
+ */
+static uint32_t mca_pml_ob1_prq_vector_match_generic (const int32_t *tags, const int32_t *peers,
+                                                      int32_t tag, int32_t peer)
+{
+    /* MPI_ANY_TAG does not match the negative (internal) tags */
+    const int any_tag = (tag >= 0);
+    uint32_t mask = 0;
+
+    for (int i = 0 ; i < MCA_PML_OB1_PRQ_VECTOR_SLOTS ; ++i) {
+        int tag_match = (tags[i] == tag) | ((tags[i] == OMPI_ANY_TAG) & any_tag);
+        int peer_match = (peers[i] == peer) | (peers[i] == OMPI_ANY_SOURCE);
+        mask |= (uint32_t) (tag_match & peer_match) << i;
+    }
+
+    return mask;
+}
+
+mca_pml_ob1_prq_vector_match_fn_t mca_pml_ob1_prq_vector_match_block = mca_pml_ob1_prq_vector_match_generic;
+
+#if MCA_PML_OB1_HAVE_AVX512_MATCH
+static void run_cpuid (uint32_t eax, uint32_t ecx, uint32_t *abcd)
+{
+    uint32_t ebx = 0, edx = 0;
+    __asm__ ( "cpuid" : "+b" (ebx), "+a" (eax), "+c" (ecx), "=d" (edx) );
+    abcd[0] = eax; abcd[1] = ebx; abcd[2] = ecx; abcd[3] = edx;
+}
+
+static bool mca_pml_ob1_prq_vector_have_avx512 (void)
+{
+    const uint32_t osxsave_mask = (1U << 27);  /* OSXSAVE (EAX = 1, ECX = 0) : ECX */
+    const uint32_t avx512f_mask = (1U << 16);  /* AVX512F (EAX = 7, ECX = 0) : EBX */
+    /* XMM, YMM, opmask, ZMM0-15 and ZMM16-31 state enabled by the OS */
+    const uint32_t zmm_state = 0xe6;
+    uint32_t abcd[4], xcr0, xcr0_hi;
+
+    run_cpuid (1, 0, abcd);
+    if (!(abcd[2] & osxsave_mask)) {
+        return false;
+    }
+    __asm__ ( "xgetbv" : "=a" (xcr0), "=d" (xcr0_hi) : "c" (0) );
+    if ((xcr0 & zmm_state) != zmm_state) {
+        return false;
+    }
+    run_cpuid (7, 0, abcd);
+    return !!(abcd[1] & avx512f_mask);
+}
+#endif  /* MCA_PML_OB1_HAVE_AVX512_MATCH */
+
+void mca_pml_ob1_prq_vector_select_kernel (void)
+{
+    mca_pml_ob1_prq_vector_match_block = mca_pml_ob1_prq_vector_match_generic;
+#if MCA_PML_OB1_HAVE_AVX512_MATCH
+    if (mca_pml_ob1.matching_vector_avx512 && mca_pml_ob1_prq_vector_have_avx512 ()) {
+        mca_pml_ob1_prq_vector_match_block = mca_pml_ob1_prq_vector_match_avx512;
+        opal_output_verbose (10, mca_pml_ob1_output, "vector matching uses the AVX-512 kernel");
+        return;
+    }
+#endif
+    opal_output_verbose (10, mca_pml_ob1_output, "vector matching uses the generic kernel");
+}
+
+mca_pml_ob1_prq_vector_t *mca_pml_ob1_prq_vector_create (void)
+{
+    return (mca_pml_ob1_prq_vector_t *) calloc (1, sizeof (mca_pml_ob1_prq_vector_t));
+}
+
+static void mca_pml_ob1_prq_vector_free_chain (mca_pml_ob1_prq_vector_block_t *block)
+{
+    while (NULL != block) {
+        mca_pml_ob1_prq_vector_block_t *next = block->next;
+        free (block);
+        block = next;
+    }
+}
+
+void mca_pml_ob1_prq_vector_destroy (mca_pml_ob1_prq_vector_t *prq)
+{
+    if (NULL == prq) {
+        return;
+    }
+    mca_pml_ob1_prq_vector_free_chain (prq->head);
+    mca_pml_ob1_prq_vector_free_chain (prq->pool);
+    free (prq);
+}
+
+static mca_pml_ob1_prq_vector_block_t *mca_pml_ob1_prq_vector_get_block (mca_pml_ob1_prq_vector_t *prq)
+{
+    mca_pml_ob1_prq_vector_block_t *block = prq->pool;
+
+    if (NULL != block) {
+        prq->pool = block->next;
+    } else if (0 != posix_memalign ((void **) &block, 64, sizeof (*block))) {
+        return NULL;
+    }
+
+    for (int i = 0 ; i < MCA_PML_OB1_PRQ_VECTOR_SLOTS ; ++i) {
+        block->tags[i] = MCA_PML_OB1_PRQ_VECTOR_EMPTY;
+        block->peers[i] = MCA_PML_OB1_PRQ_VECTOR_EMPTY;
+        block->reqs[i] = NULL;
+    }
+    block->next = NULL;
+    block->used = 0;
+    block->count = 0;
+
+    return block;
+}
+
+int mca_pml_ob1_prq_vector_append (mca_pml_ob1_prq_vector_t *prq, mca_pml_ob1_recv_request_t *req)
+{
+    mca_pml_ob1_prq_vector_block_t *block = prq->tail;
+
+    if (NULL == block || MCA_PML_OB1_PRQ_VECTOR_SLOTS == block->used) {
+        block = mca_pml_ob1_prq_vector_get_block (prq);
+        if (OPAL_UNLIKELY(NULL == block)) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        if (NULL == prq->tail) {
+            prq->head = block;
+        } else {
+            prq->tail->next = block;
+        }
+        prq->tail = block;
+    }
+
+    block->tags[block->used] = PRQ_VECTOR_REQ_TAG(req);
+    block->peers[block->used] = PRQ_VECTOR_REQ_PEER(req);
+    block->reqs[block->used] = req;
+    block->used++;
+    block->count++;
+    prq->size++;
+
+    return OMPI_SUCCESS;
+}
+
+static inline int mca_pml_ob1_prq_vector_first_slot (uint32_t mask)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz (mask);
+#else
+    int slot = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++slot;
+    }
+    return slot;
+#endif
+}
+
+static void mca_pml_ob1_prq_vector_clear_slot (mca_pml_ob1_prq_vector_t *prq,
+                                               mca_pml_ob1_prq_vector_block_t *prev,
+                                               mca_pml_ob1_prq_vector_block_t *block, int slot)
+{
+    block->tags[slot] = MCA_PML_OB1_PRQ_VECTOR_EMPTY;
+    block->peers[slot] = MCA_PML_OB1_PRQ_VECTOR_EMPTY;
+    block->reqs[slot] = NULL;
+    block->count--;
+    prq->size--;
+
+    if (0 != block->count) {
+        return;
+    }
+
+    if (block == prq->tail) {
+        /* keep the tail, it can be refilled from the start */
+        block->used = 0;
+        return;
+    }
+
+    /* return the empty block to the pool */
+    if (NULL == prev) {
+        prq->head = block->next;
+    } else {
+        prev->next = block->next;
+    }
+    block->next = prq->pool;
+    prq->pool = block;
+}
+
+mca_pml_ob1_recv_request_t *mca_pml_ob1_prq_vector_find_dequeue (mca_pml_ob1_prq_vector_t *prq,
+                                                                 int32_t tag, int32_t peer)
+{
+    mca_pml_ob1_prq_vector_block_t *prev = NULL;
+
+    for (mca_pml_ob1_prq_vector_block_t *block = prq->head ; NULL != block ; prev = block, block = block->next) {
+        uint32_t mask = mca_pml_ob1_prq_vector_match_block (block->tags, block->peers, tag, peer);
+
+        if (0 != mask) {
+            /* the lowest slot is the oldest receive */
+            int slot = mca_pml_ob1_prq_vector_first_slot (mask);
+            mca_pml_ob1_recv_request_t *req = block->reqs[slot];
+
+            mca_pml_ob1_prq_vector_clear_slot (prq, prev, block, slot);
+            return req;
+        }
+    }
+
+    return NULL;
+}
+
+bool mca_pml_ob1_prq_vector_remove (mca_pml_ob1_prq_vector_t *prq, mca_pml_ob1_recv_request_t *req)
+{
+    mca_pml_ob1_prq_vector_block_t *prev = NULL;
+
+    for (mca_pml_ob1_prq_vector_block_t *block = prq->head ; NULL != block ; prev = block, block = block->next) {
+        for (int i = 0 ; i < block->used ; ++i) {
+            if (block->reqs[i] == req) {
+                mca_pml_ob1_prq_vector_clear_slot (prq, prev, block, i);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+size_t mca_pml_ob1_prq_vector_peer_size (mca_pml_ob1_prq_vector_t *prq, int32_t peer)
+{
+    size_t count = 0;
+
+    for (mca_pml_ob1_prq_vector_block_t *block = prq->head ; NULL != block ; block = block->next) {
+        for (int i = 0 ; i < block->used ; ++i) {
+            count += (block->peers[i] == peer);
+        }
+    }
+
+    return count;
+}
+
+void mca_pml_ob1_prq_vector_dump (mca_pml_ob1_prq_vector_t *prq)
+{
+    opal_output(0, "vector posted receive queue: %lu receives\n", (unsigned long) prq->size);
+    for (mca_pml_ob1_prq_vector_block_t *block = prq->head ; NULL != block ; block = block->next) {
+        for (int i = 0 ; i < block->used ; ++i) {
+            mca_pml_ob1_recv_request_t *req = block->reqs[i];
+            if (NULL == req) {
+                continue;
+            }
+            opal_output(0, "req %p peer %d tag %d seq %llu\n", (void *) req,
+                        PRQ_VECTOR_REQ_PEER(req), PRQ_VECTOR_REQ_TAG(req),
+                        (unsigned long long) req->req_recv.req_base.req_sequence);
+        }
+    }
+}
+
+#if !MCA_PML_OB1_CUSTOM_MATCH
+
+/* Make sure the next count appends do not need any allocation */
+static int mca_pml_ob1_prq_vector_reserve (mca_pml_ob1_prq_vector_t *prq, size_t count)
+{
+    size_t avail = 0;
+
+    if (NULL != prq->tail) {
+        avail = MCA_PML_OB1_PRQ_VECTOR_SLOTS - prq->tail->used;
+    }
+    for (mca_pml_ob1_prq_vector_block_t *block = prq->pool ; NULL != block && avail < count ; block = block->next) {
+        avail += MCA_PML_OB1_PRQ_VECTOR_SLOTS;
+    }
+    while (avail < count) {
+        mca_pml_ob1_prq_vector_block_t *block;
+        if (0 != posix_memalign ((void **) &block, 64, sizeof (*block))) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        block->next = prq->pool;
+        prq->pool = block;
+        avail += MCA_PML_OB1_PRQ_VECTOR_SLOTS;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int mca_pml_ob1_prq_vector_seq_cmp (const void *a, const void *b)
+{
+    const mca_pml_ob1_recv_request_t *ra = *(mca_pml_ob1_recv_request_t * const *) a;
+    const mca_pml_ob1_recv_request_t *rb = *(mca_pml_ob1_recv_request_t * const *) b;
+    /* the communicator sequence is 32 bits and may have wrapped around */
+    int32_t diff = (int32_t) ((uint32_t) ra->req_recv.req_base.req_sequence -
+                              (uint32_t) rb->req_recv.req_base.req_sequence);
+
+    return (diff > 0) - (diff < 0);
+}
+
+static size_t mca_pml_ob1_comm_drain_list (opal_list_t *queue, mca_pml_ob1_recv_request_t **reqs)
+{
+    opal_list_item_t *item;
+    size_t count = 0;
+
+    while (NULL != (item = opal_list_remove_first (queue))) {
+        reqs[count++] = (mca_pml_ob1_recv_request_t *) item;
+    }
+
+    return count;
+}
+
+int mca_pml_ob1_comm_prq_vector_activate (mca_pml_ob1_comm_t *comm)
+{
+    mca_pml_ob1_recv_request_t **reqs;
+    size_t count = 0, total = opal_list_get_size (&comm->wild_receives);
+    int rc;
+
+    if (NULL == comm->prq_vector) {
+        comm->prq_vector = mca_pml_ob1_prq_vector_create ();
+        if (NULL == comm->prq_vector) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+    }
+
+    for (size_t i = 0 ; i < comm->num_procs ; ++i) {
+        if (NULL != comm->procs[i]) {
+            total += opal_list_get_size (&comm->procs[i]->specific_receives);
+        }
+    }
+
+    if (0 == total) {
+        comm->prq_vector_active = true;
+        comm->posted_receives = 0;
+        return OMPI_SUCCESS;
+    }
+
+    /* allocate everything first, the lists are left untouched on failure */
+    reqs = (mca_pml_ob1_recv_request_t **) malloc (total * sizeof (*reqs));
+    if (NULL == reqs) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    rc = mca_pml_ob1_prq_vector_reserve (comm->prq_vector, total);
+    if (OMPI_SUCCESS != rc) {
+        free (reqs);
+        return rc;
+    }
+
+    count = mca_pml_ob1_comm_drain_list (&comm->wild_receives, reqs);
+    for (size_t i = 0 ; i < comm->num_procs ; ++i) {
+        if (NULL != comm->procs[i]) {
+            count += mca_pml_ob1_comm_drain_list (&comm->procs[i]->specific_receives, reqs + count);
+        }
+    }
+    assert (count == total);
+
+    /* a single queue in posting order gives the same matching as merging
+     * the wildcard and the specific lists by sequence number */
+    qsort (reqs, count, sizeof (*reqs), mca_pml_ob1_prq_vector_seq_cmp);
+    for (size_t i = 0 ; i < count ; ++i) {
+        (void) mca_pml_ob1_prq_vector_append (comm->prq_vector, reqs[i]);
+    }
+    free (reqs);
+
+    comm->prq_vector_active = true;
+    comm->posted_receives = 0;
+
+    opal_output_verbose (20, mca_pml_ob1_output, "switched a communicator to vector matching with "
+                         "%lu posted receives", (unsigned long) count);
+
+    return OMPI_SUCCESS;
+}
+
+void mca_pml_ob1_comm_prq_vector_deactivate (mca_pml_ob1_comm_t *comm)
+{
+    mca_pml_ob1_prq_vector_t *prq = comm->prq_vector;
+    mca_pml_ob1_prq_vector_block_t *block;
+
+    comm->prq_vector_active = false;
+    comm->posted_receives = 0;
+    if (NULL == prq) {
+        return;
+    }
+
+    /* the queue is in posting order, so appending to the lists in that order
+     * keeps every list sorted by sequence number */
+    while (NULL != (block = prq->head)) {
+        for (int i = 0 ; i < block->used ; ++i) {
+            mca_pml_ob1_recv_request_t *req = block->reqs[i];
+
+            if (NULL == req) {
+                continue;
+            }
+            if (OMPI_ANY_SOURCE == PRQ_VECTOR_REQ_PEER(req)) {
+                opal_list_append (&comm->wild_receives, (opal_list_item_t *) req);
+            } else {
+                opal_list_append (&comm->procs[PRQ_VECTOR_REQ_PEER(req)]->specific_receives,
+                                  (opal_list_item_t *) req);
+            }
+            comm->posted_receives++;
+        }
+        prq->head = block->next;
+        block->next = prq->pool;
+        prq->pool = block;
+    }
+    prq->tail = NULL;
+    prq->size = 0;
+}
+
+#endif  /* !MCA_PML_OB1_CUSTOM_MATCH */
@@ -0,0 +1,128 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Posted receive queue organized for vectorized matching.
+ *
+ * The receives of a communicator are kept in posting order in a chain of
+ * blocks of MCA_PML_OB1_PRQ_VECTOR_SLOTS entries, the layout used by the
+ * fuzzy512 custom matching engines. Each block stores the tags and the
+ * sources of its receives in two packed arrays, so an incoming fragment is
+ * compared with a whole block at once, either with AVX-512 or with a
+ * portable loop, instead of chasing one list item per posted receive. The
+ * keys are exact, there is no verification step.
+ *
+ * A communicator starts on the usual per peer and wildcard lists and
+ * switches to this queue once it has enough receives posted (or from the
+ * beginning, depending on pml_ob1_matching_engine). All the posted
+ * receives then live in this queue, it returns to the lists once it is
+ * drained. Everything here is called with the matching lock held.
+ */
+#ifndef MCA_PML_OB1_PRQ_VECTOR_H
+#define MCA_PML_OB1_PRQ_VECTOR_H
+
+#include "ompi_config.h"
+
+#include <stdint.h>
+
+#include "pml_ob1_comm.h"
+
+BEGIN_C_DECLS
+
+#define MCA_PML_OB1_PRQ_VECTOR_SLOTS 16
+
+/** Tag and source of an unused slot, it can never match a fragment */
+#define MCA_PML_OB1_PRQ_VECTOR_EMPTY INT32_MIN
+
+/**
+ * Matching engines, pml_ob1_matching_engine
+ */
+enum {
+    MCA_PML_OB1_MATCHING_LIST = 0,   /**< per peer lists only */
+    MCA_PML_OB1_MATCHING_VECTOR,     /**< vector queue on all the communicators */
+    MCA_PML_OB1_MATCHING_AUTO        /**< vector queue on the communicators with deep queues */
+};
+
+struct mca_pml_ob1_recv_request_t;
+
+typedef struct mca_pml_ob1_prq_vector_block_t {
+    int32_t tags[MCA_PML_OB1_PRQ_VECTOR_SLOTS];
+    int32_t peers[MCA_PML_OB1_PRQ_VECTOR_SLOTS];
+    struct mca_pml_ob1_recv_request_t *reqs[MCA_PML_OB1_PRQ_VECTOR_SLOTS];
+    struct mca_pml_ob1_prq_vector_block_t *next;
+    int used;   /**< slots handed out so far, the free ones are at the end */
+    int count;  /**< receives still in the block */
+} mca_pml_ob1_prq_vector_block_t;
+
+typedef struct mca_pml_ob1_prq_vector_t {
+    mca_pml_ob1_prq_vector_block_t *head;
+    mca_pml_ob1_prq_vector_block_t *tail;
+    mca_pml_ob1_prq_vector_block_t *pool;  /**< unused blocks */
+    size_t size;
+} mca_pml_ob1_prq_vector_t;
+
+/**
+ * Match a tag and a source against a block. Returns the mask of the slots
+ * that match, slot i being bit i.
+ */
+typedef uint32_t (*mca_pml_ob1_prq_vector_match_fn_t) (const int32_t *tags, const int32_t *peers,
+                                                       int32_t tag, int32_t peer);
+
+extern mca_pml_ob1_prq_vector_match_fn_t mca_pml_ob1_prq_vector_match_block;
+
+#if MCA_PML_OB1_HAVE_AVX512_MATCH
+uint32_t mca_pml_ob1_prq_vector_match_avx512 (const int32_t *tags, const int32_t *peers,
+                                              int32_t tag, int32_t peer);
+#endif
+
+/**
+ * Pick the matching kernel for this processor. Called once, from the
+ * component initialization.
+ */
+void mca_pml_ob1_prq_vector_select_kernel (void);
+
+mca_pml_ob1_prq_vector_t *mca_pml_ob1_prq_vector_create (void);
+void mca_pml_ob1_prq_vector_destroy (mca_pml_ob1_prq_vector_t *prq);
+
+/** @return OMPI_ERR_OUT_OF_RESOURCE if a new block could not be allocated */
+int mca_pml_ob1_prq_vector_append (mca_pml_ob1_prq_vector_t *prq,
+                                   struct mca_pml_ob1_recv_request_t *req);
+
+/** Find and remove the oldest receive matching a fragment */
+struct mca_pml_ob1_recv_request_t *
+mca_pml_ob1_prq_vector_find_dequeue (mca_pml_ob1_prq_vector_t *prq, int32_t tag, int32_t peer);
+
+/** @return true if the receive was in the queue */
+bool mca_pml_ob1_prq_vector_remove (mca_pml_ob1_prq_vector_t *prq,
+                                    struct mca_pml_ob1_recv_request_t *req);
+
+/** Number of receives posted for a given source (for the MPI_T variables) */
+size_t mca_pml_ob1_prq_vector_peer_size (mca_pml_ob1_prq_vector_t *prq, int32_t peer);
+
+void mca_pml_ob1_prq_vector_dump (mca_pml_ob1_prq_vector_t *prq);
+
+/**
+ * Move all the posted receives of the communicator from the lists to the
+ * vector queue, keeping the posting order. The communicator remains on the
+ * lists if the queue cannot be allocated.
+ */
+int mca_pml_ob1_comm_prq_vector_activate (mca_pml_ob1_comm_t *comm);
+
+/**
+ * Move all the posted receives of the communicator back to the lists.
+ */
+void mca_pml_ob1_comm_prq_vector_deactivate (mca_pml_ob1_comm_t *comm);
+
+END_C_DECLS
+
+#endif  /* MCA_PML_OB1_PRQ_VECTOR_H */
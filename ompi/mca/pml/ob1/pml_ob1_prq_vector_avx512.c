@@ -0,0 +1,42 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * AVX-512 matching kernel. This file is built with the AVX-512 compiler
+ * flags, the kernel is only installed if the processor supports it (see
+ * mca_pml_ob1_prq_vector_select_kernel).
+ */
+
+#include "ompi_config.h"
+
+#include <immintrin.h>
+
+#include "ompi/mca/pml/pml_constants.h"
+#include "pml_ob1_prq_vector.h"
+
+uint32_t mca_pml_ob1_prq_vector_match_avx512 (const int32_t *tags, const int32_t *peers,
+                                              int32_t tag, int32_t peer)
+{
+    const __m512i vtags = _mm512_loadu_si512 ((const void *) tags);
+    const __m512i vpeers = _mm512_loadu_si512 ((const void *) peers);
+    __mmask16 tag_match, peer_match;
+
+    tag_match = _mm512_cmpeq_epi32_mask (vtags, _mm512_set1_epi32 (tag));
+    /* MPI_ANY_TAG does not match the negative (internal) tags */
+    if (tag >= 0) {
+        tag_match |= _mm512_cmpeq_epi32_mask (vtags, _mm512_set1_epi32 (OMPI_ANY_TAG));
+    }
+    peer_match = _mm512_cmpeq_epi32_mask (vpeers, _mm512_set1_epi32 (peer)) |
+        _mm512_cmpeq_epi32_mask (vpeers, _mm512_set1_epi32 (OMPI_ANY_SOURCE));
+
+    return (uint32_t) (tag_match & peer_match);
+}
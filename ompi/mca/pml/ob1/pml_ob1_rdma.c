@@ -26,11 +26,33 @@
 #include "ompi/constants.h"
 #include "ompi/mca/pml/pml.h"
 #include "ompi/mca/bml/bml.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "opal/mca/btl/base/base.h"
 #include "opal/mca/mpool/mpool.h"
+#include "opal/mca/timer/base/base.h"
+#include "opal/mca/base/mca_base_pvar.h"
 #include "opal/runtime/opal_params.h"
+#include "opal/util/printf.h"
 #include "pml_ob1.h"
+#include "pml_ob1_component.h"
 #include "pml_ob1_rdma.h"
 
+/* a rail keeps at least this share of the bandwidth of the fastest one, so
+ * that it still gets fragments and its estimate can recover */
+#define MCA_PML_OB1_RDMA_MIN_SHARE 0.05
+
+/*
+ * Observed totals for one RDMA capable btl module, over all the endpoints
+ */
+typedef struct mca_pml_ob1_rdma_rail_t {
+    mca_btl_base_module_t *btl;
+    opal_atomic_int64_t bytes;
+    double bandwidth;
+} mca_pml_ob1_rdma_rail_t;
+
+static mca_pml_ob1_rdma_rail_t *mca_pml_ob1_rdma_rails = NULL;
+static int mca_pml_ob1_rdma_num_rails = 0;
+
 /*
  * Check to see if memory is registered or can be registered. Build a
  * set of registrations on the request.
@@ -176,3 +198,319 @@ size_t mca_pml_ob1_rdma_pipeline_btls( mca_bml_base_endpoint_t* bml_endpoint,
 
     return rdma_count;
 }
+
+int mca_pml_ob1_rdma_iov_build (const opal_convertor_t *convertor, struct iovec *iov,
+                                uint32_t *iov_count, unsigned char **base, size_t *span)
+{
+    uint32_t max_segments = MCA_PML_OB1_RDMA_IOV_MAX;
+    unsigned char *lower, *upper;
+    opal_convertor_t raw_convertor;
+    uint32_t count, merged = 0;
+    size_t length;
+    int done;
+
+    if (mca_pml_ob1.rdma_iov_max_segments <= 0 || 0 == convertor->local_size ||
+        !(convertor->flags & CONVERTOR_HOMOGENEOUS) || (convertor->flags & CONVERTOR_CUDA)) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    if (mca_pml_ob1.rdma_iov_max_segments < MCA_PML_OB1_RDMA_IOV_MAX) {
+        max_segments = (uint32_t) mca_pml_ob1.rdma_iov_max_segments;
+    }
+
+    /* walk the layout on a copy, the request convertor keeps its position */
+    OBJ_CONSTRUCT(&raw_convertor, opal_convertor_t);
+    opal_convertor_copy_and_prepare_for_recv (ompi_mpi_local_convertor, convertor->pDesc,
+                                              convertor->count, convertor->pBaseBuf, 0,
+                                              &raw_convertor);
+    count = max_segments;
+    done = opal_convertor_raw (&raw_convertor, iov, &count, &length);
+    opal_convertor_cleanup (&raw_convertor);
+    OBJ_DESTRUCT(&raw_convertor);
+
+    if (!done || 0 == count) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    for (uint32_t i = 0 ; i < count ; ++i) {
+        if (0 == iov[i].iov_len) {
+            continue;
+        }
+
+        if (merged && (unsigned char *) iov[merged - 1].iov_base + iov[merged - 1].iov_len ==
+            (unsigned char *) iov[i].iov_base) {
+            iov[merged - 1].iov_len += iov[i].iov_len;
+        } else {
+            iov[merged++] = iov[i];
+        }
+    }
+
+    if (0 == merged || convertor->local_size / merged < mca_pml_ob1.rdma_iov_min_segment_size) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    /* the segments are in packed order which is not always the address order */
+    lower = (unsigned char *) iov[0].iov_base;
+    upper = lower + iov[0].iov_len;
+    for (uint32_t i = 1 ; i < merged ; ++i) {
+        unsigned char *segment = (unsigned char *) iov[i].iov_base;
+
+        if (segment < lower) {
+            lower = segment;
+        }
+        if (segment + iov[i].iov_len > upper) {
+            upper = segment + iov[i].iov_len;
+        }
+    }
+
+    *iov_count = merged;
+    *base = lower;
+    *span = (size_t) (upper - lower);
+
+    return OMPI_SUCCESS;
+}
+
+static int mca_pml_ob1_rdma_rails_notify (mca_base_pvar_t *pvar, mca_base_pvar_event_t event,
+                                          void *obj_handle, int *count)
+{
+    if (MCA_BASE_PVAR_HANDLE_BIND == event) {
+        /* one value per rail */
+        *count = mca_pml_ob1_rdma_num_rails;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int mca_pml_ob1_rdma_rails_get_index (const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    int *values = (int *) value;
+
+    for (int i = 0 ; i < mca_pml_ob1_rdma_num_rails ; ++i) {
+        values[i] = i;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int mca_pml_ob1_rdma_rails_get_bytes (const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    unsigned long long *values = (unsigned long long *) value;
+
+    for (int i = 0 ; i < mca_pml_ob1_rdma_num_rails ; ++i) {
+        values[i] = (unsigned long long) mca_pml_ob1_rdma_rails[i].bytes;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int mca_pml_ob1_rdma_rails_get_bandwidth (const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    double *values = (double *) value;
+
+    for (int i = 0 ; i < mca_pml_ob1_rdma_num_rails ; ++i) {
+        values[i] = mca_pml_ob1_rdma_rails[i].bandwidth;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+int mca_pml_ob1_rdma_rails_init (void)
+{
+    mca_btl_base_selected_module_t *selected_btl;
+    mca_base_var_enum_value_t *rail_names;
+    mca_base_var_enum_t *rails_enum;
+    int num_rails = 0, rc;
+
+    OPAL_LIST_FOREACH(selected_btl, &mca_btl_base_modules_initialized, mca_btl_base_selected_module_t) {
+        if (selected_btl->btl_module->btl_flags & MCA_BTL_FLAGS_RDMA) {
+            ++num_rails;
+        }
+    }
+
+    if (0 == num_rails) {
+        return OMPI_SUCCESS;
+    }
+
+    mca_pml_ob1_rdma_rails = calloc (num_rails, sizeof (mca_pml_ob1_rdma_rail_t));
+    rail_names = calloc (num_rails + 1, sizeof (mca_base_var_enum_value_t));
+    if (NULL == mca_pml_ob1_rdma_rails || NULL == rail_names) {
+        free (mca_pml_ob1_rdma_rails);
+        mca_pml_ob1_rdma_rails = NULL;
+        free (rail_names);
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* name the rails after their btl component and their index within it */
+    OPAL_LIST_FOREACH(selected_btl, &mca_btl_base_modules_initialized, mca_btl_base_selected_module_t) {
+        mca_btl_base_module_t *btl = selected_btl->btl_module;
+        const char *component_name = btl->btl_component->btl_version.mca_component_name;
+        int index = 0;
+
+        if (!(btl->btl_flags & MCA_BTL_FLAGS_RDMA)) {
+            continue;
+        }
+
+        for (int i = 0 ; i < mca_pml_ob1_rdma_num_rails ; ++i) {
+            if (mca_pml_ob1_rdma_rails[i].btl->btl_component == btl->btl_component) {
+                ++index;
+            }
+        }
+
+        mca_pml_ob1_rdma_rails[mca_pml_ob1_rdma_num_rails].btl = btl;
+        rail_names[mca_pml_ob1_rdma_num_rails].value = mca_pml_ob1_rdma_num_rails;
+        (void) opal_asprintf ((char **) &rail_names[mca_pml_ob1_rdma_num_rails].string, "%s_%d",
+                              component_name, index);
+        ++mca_pml_ob1_rdma_num_rails;
+    }
+
+    rc = mca_base_var_enum_create ("pml_ob1_rdma_rails", rail_names, &rails_enum);
+    for (int i = 0 ; i < mca_pml_ob1_rdma_num_rails ; ++i) {
+        free ((char *) rail_names[i].string);
+    }
+    free (rail_names);
+    if (OPAL_SUCCESS != rc) {
+        return rc;
+    }
+
+    (void) mca_base_component_pvar_register (&mca_pml_ob1_component.pmlm_version, "rdma_rails",
+                                             "Rail (btl module) that corresponds to each slot of the "
+                                             "pml_ob1_rdma_rail_* value arrays", OPAL_INFO_LVL_4,
+                                             MPI_T_PVAR_CLASS_STATE, MCA_BASE_VAR_TYPE_INT, rails_enum,
+                                             MPI_T_BIND_NO_OBJECT,
+                                             MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                             mca_pml_ob1_rdma_rails_get_index, NULL,
+                                             mca_pml_ob1_rdma_rails_notify, NULL);
+    OBJ_RELEASE(rails_enum);
+
+    (void) mca_base_component_pvar_register (&mca_pml_ob1_component.pmlm_version, "rdma_rail_bytes",
+                                             "Number of bytes received by RDMA through each rail",
+                                             OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_COUNTER,
+                                             MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL, MPI_T_BIND_NO_OBJECT,
+                                             MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                             mca_pml_ob1_rdma_rails_get_bytes, NULL,
+                                             mca_pml_ob1_rdma_rails_notify, NULL);
+
+    (void) mca_base_component_pvar_register (&mca_pml_ob1_component.pmlm_version, "rdma_rail_bandwidth",
+                                             "Smoothed RDMA bandwidth (Mbps) observed on each rail",
+                                             OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_LEVEL,
+                                             MCA_BASE_VAR_TYPE_DOUBLE, NULL, MPI_T_BIND_NO_OBJECT,
+                                             MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                             mca_pml_ob1_rdma_rails_get_bandwidth, NULL,
+                                             mca_pml_ob1_rdma_rails_notify, NULL);
+
+    return OMPI_SUCCESS;
+}
+
+void mca_pml_ob1_rdma_rails_fini (void)
+{
+    /* the variables stay registered, they now have no value */
+    mca_pml_ob1_rdma_num_rails = 0;
+    free (mca_pml_ob1_rdma_rails);
+    mca_pml_ob1_rdma_rails = NULL;
+}
+
+static inline double mca_pml_ob1_rdma_smooth (double estimate, double sample)
+{
+    return (0.0 == estimate) ? sample :
+        estimate + mca_pml_ob1.rdma_adaptive_alpha * (sample - estimate);
+}
+
+static inline double mca_pml_ob1_rdma_estimate (mca_bml_base_btl_t *bml_btl)
+{
+    /* rails that did not complete anything yet keep their nominal bandwidth */
+    return (bml_btl->btl_rdma_bandwidth > 0.0) ? bml_btl->btl_rdma_bandwidth :
+        (double) bml_btl->btl->btl_bandwidth;
+}
+
+/*
+ * Set the weights of the rdma btls of an endpoint from their estimated
+ * bandwidth, as bml/r2 does from the nominal one.
+ */
+static void mca_pml_ob1_rdma_reweight (mca_bml_base_btl_array_t *btl_rdma)
+{
+    size_t num_btls = mca_bml_base_btl_array_get_size (btl_rdma);
+    double max_estimate = 0.0, total = 0.0, estimate;
+
+    if (num_btls < 2) {
+        return;
+    }
+
+    for (size_t i = 0 ; i < num_btls ; ++i) {
+        estimate = mca_pml_ob1_rdma_estimate (mca_bml_base_btl_array_get_index (btl_rdma, i));
+        if (estimate > max_estimate) {
+            max_estimate = estimate;
+        }
+    }
+
+    if (0.0 == max_estimate) {
+        return;
+    }
+
+    for (size_t i = 0 ; i < num_btls ; ++i) {
+        estimate = mca_pml_ob1_rdma_estimate (mca_bml_base_btl_array_get_index (btl_rdma, i));
+        total += (estimate > MCA_PML_OB1_RDMA_MIN_SHARE * max_estimate) ? estimate :
+            MCA_PML_OB1_RDMA_MIN_SHARE * max_estimate;
+    }
+
+    for (size_t i = 0 ; i < num_btls ; ++i) {
+        mca_bml_base_btl_t *bml_btl = mca_bml_base_btl_array_get_index (btl_rdma, i);
+
+        estimate = mca_pml_ob1_rdma_estimate (bml_btl);
+        if (estimate < MCA_PML_OB1_RDMA_MIN_SHARE * max_estimate) {
+            estimate = MCA_PML_OB1_RDMA_MIN_SHARE * max_estimate;
+        }
+        bml_btl->btl_weight = (float) (estimate / total);
+    }
+}
+
+void mca_pml_ob1_rdma_complete (mca_bml_base_endpoint_t *bml_endpoint, mca_bml_base_btl_t *bml_btl,
+                                uint64_t start, size_t length)
+{
+    uint64_t now = opal_timer_base_get_usec ();
+    /* the fragments of a rail are pipelined: a fragment only accounts for
+     * the time since the previous completion on the same rail */
+    uint64_t begin = (start > bml_btl->btl_rdma_last) ? start : bml_btl->btl_rdma_last;
+    mca_pml_ob1_rdma_rail_t *rail = NULL;
+    double sample;
+
+    bml_btl->btl_rdma_last = now;
+
+    for (int i = 0 ; i < mca_pml_ob1_rdma_num_rails ; ++i) {
+        if (mca_pml_ob1_rdma_rails[i].btl == bml_btl->btl) {
+            rail = mca_pml_ob1_rdma_rails + i;
+            OPAL_THREAD_ADD_FETCH64(&rail->bytes, (int64_t) length);
+            break;
+        }
+    }
+
+    /* no timer, or a completion under its resolution */
+    if (0 == length || now <= begin) {
+        return;
+    }
+
+    /* bytes per usec to Mbps */
+    sample = (8.0 * (double) length) / (double) (now - begin);
+
+    /* these are statistics, concurrent updates only lose a sample */
+    bml_btl->btl_rdma_bandwidth = mca_pml_ob1_rdma_smooth (bml_btl->btl_rdma_bandwidth, sample);
+    if (NULL != rail) {
+        rail->bandwidth = mca_pml_ob1_rdma_smooth (rail->bandwidth, sample);
+    }
+
+    if (mca_pml_ob1.rdma_adaptive) {
+        mca_pml_ob1_rdma_reweight (&bml_endpoint->btl_rdma);
+    }
+}
+
+void mca_pml_ob1_rdma_rebalance (mca_pml_ob1_com_btl_t *rdma_btls, int num_btls, size_t size)
+{
+    double weight_total = 0;
+
+    for (int i = 0 ; i < num_btls ; ++i) {
+        weight_total += rdma_btls[i].bml_btl->btl_weight;
+    }
+
+    if (weight_total > 0) {
+        mca_pml_ob1_calc_weighted_length (rdma_btls, num_btls, size, weight_total);
+    }
+}
@@ -46,5 +46,39 @@ size_t mca_pml_ob1_rdma_pipeline_btls(struct mca_bml_base_endpoint_t* endpoint,
 
 size_t mca_pml_ob1_rdma_pipeline_btls_count (mca_bml_base_endpoint_t* bml_endpoint);
 
+/* upper bound of pml_ob1_rdma_iov_max_segments */
+#define MCA_PML_OB1_RDMA_IOV_MAX 64
+
+/*
+ * Describe the buffer of a convertor as at most mca_pml_ob1.rdma_iov_max_segments
+ * contiguous segments, in the order of the packed data, for the RGET of
+ * non-contiguous datatypes. Adjacent segments are merged. Returns
+ * OMPI_ERR_NOT_SUPPORTED if the layout needs more segments, if they are
+ * smaller than rdma_iov_min_segment_size on average, or if the data has to be
+ * converted. The span of the segments is returned in base and span.
+ */
+int mca_pml_ob1_rdma_iov_build (const opal_convertor_t *convertor, struct iovec *iov,
+                                uint32_t *iov_count, unsigned char **base, size_t *span);
+
+/*
+ * Bandwidth feedback for the RDMA striping. The receiver times the
+ * completion of each of its RDMA fragments (put pipeline and get) and
+ * keeps a smoothed estimate of the bandwidth delivered by every rail of an
+ * endpoint. When pml_ob1_rdma_adaptive is set the estimates replace the
+ * static btl_bandwidth ratios in the btl_weight of the endpoint rdma
+ * array, which the next messages use, and the remaining part of a
+ * pipelined message is split again each time more fragments are
+ * scheduled. The per rail totals are exported as MPI_T variables.
+ */
+int mca_pml_ob1_rdma_rails_init (void);
+void mca_pml_ob1_rdma_rails_fini (void);
+
+/* Account for a completed RDMA fragment of length bytes posted at start (usec) */
+void mca_pml_ob1_rdma_complete (mca_bml_base_endpoint_t *bml_endpoint, mca_bml_base_btl_t *bml_btl,
+                                uint64_t start, size_t length);
+
+/* Split size bytes again over the btls of a request with the current weights */
+void mca_pml_ob1_rdma_rebalance (mca_pml_ob1_com_btl_t *rdma_btls, int num_btls, size_t size);
+
 #endif
 
@@ -53,6 +53,7 @@ struct mca_pml_ob1_rdma_frag_t {
     mca_pml_ob1_rdma_frag_callback_t cbfunc;
 
     uint64_t rdma_offset;
+    uint64_t rdma_start;  /* when the operation was posted (usec), for the bandwidth feedback */
     void *local_address;
     mca_btl_base_registration_handle_t *local_handle;
 
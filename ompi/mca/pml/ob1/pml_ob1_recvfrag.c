@@ -33,6 +33,7 @@
 
 #include "ompi_config.h"
 
+#include "opal/align.h"
 #include "opal/class/opal_list.h"
 #include "opal/mca/threads/mutex.h"
 #include "opal/prefetch.h"
@@ -49,6 +50,9 @@
 #include "pml_ob1_recvreq.h"
 #include "pml_ob1_sendreq.h"
 #include "pml_ob1_hdr.h"
+#include "pml_ob1_prq_vector.h"
+#include "pml_ob1_adapt.h"
+#include "pml_ob1_flow.h"
 #if OPAL_CUDA_SUPPORT
 #include "opal/mca/common/cuda/common_cuda.h"
 #endif /* OPAL_CUDA_SUPPORT */
@@ -82,6 +86,7 @@ append_frag_to_list(opal_list_t *queue, mca_btl_base_module_t *btl,
         MCA_PML_OB1_RECV_FRAG_ALLOC(frag);
         MCA_PML_OB1_RECV_FRAG_INIT(frag, hdr, segments, num_segments, btl);
     }
+    SPC_HIST_START(&frag->spc_queued);
     opal_list_append(queue, (opal_list_item_t*)frag);
 }
 
@@ -96,6 +101,7 @@ append_frag_to_umq(custom_match_umq *queue, mca_btl_base_module_t *btl,
     MCA_PML_OB1_RECV_FRAG_ALLOC(frag);
     MCA_PML_OB1_RECV_FRAG_INIT(frag, hdr, segments, num_segments, btl);
   }
+  SPC_HIST_START(&frag->spc_queued);
   custom_match_umq_append(queue, hdr->hdr_tag, hdr->hdr_src, frag);
 }
 
@@ -307,6 +313,7 @@ static int mca_pml_ob1_recv_frag_match (mca_btl_base_module_t *btl,
  * @param segments (IN)             Received recv_frag descriptor.
  * @param num_segments (IN)         Flag indicating wether a match was made.
  * @param type (IN)                 Type of the message header.
+ * @param lane (IN)                 The matching lock held is the lock of the peer.
  * @return                          OMPI_SUCCESS or error status on failure.
  */
 static int
@@ -317,7 +324,8 @@ mca_pml_ob1_recv_frag_match_proc (mca_btl_base_module_t *btl,
                                   const mca_btl_base_segment_t *segments,
                                   size_t num_segments,
                                   int type,
-                                  mca_pml_ob1_recv_frag_t *frag);
+                                  mca_pml_ob1_recv_frag_t *frag,
+                                  bool lane);
 
 static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
                                               const mca_pml_ob1_match_hdr_t *hdr,
@@ -348,7 +356,7 @@ int mca_pml_ob1_revoke_comm( struct ompi_communicator_t* ompi_comm, bool coll_on
 
     OBJ_CONSTRUCT(&nack_list, opal_list_t);
 
-    OPAL_THREAD_LOCK(&comm->matching_lock);
+    (void) mca_pml_ob1_comm_match_lock(comm, NULL);
     /* these assignement need to be here because we need the matching_lock */
     ompi_comm->coll_revoked = true;
     if( !coll_only ) ompi_comm->comm_revoked = true;
@@ -410,7 +418,7 @@ int mca_pml_ob1_revoke_comm( struct ompi_communicator_t* ompi_comm, bool coll_on
         if( verbose > 15) mca_pml_ob1_dump(ompi_comm, verbose);
     }
 #endif
-    OPAL_THREAD_UNLOCK(&comm->matching_lock);
+    mca_pml_ob1_comm_match_unlock(comm, NULL, false);
     while( NULL != (it = opal_list_remove_first(&nack_list)) ) {
         mca_pml_ob1_recv_frag_t* frag = (mca_pml_ob1_recv_frag_t*)it;
         mca_pml_ob1_hdr_t* hdr = (mca_pml_ob1_hdr_t*)frag->segments->seg_addr.pval;
@@ -422,7 +430,7 @@ int mca_pml_ob1_revoke_comm( struct ompi_communicator_t* ompi_comm, bool coll_on
                                  "ob1_revoke_comm: sending NACK to %d", hdr->hdr_rndv.hdr_match.hdr_src));
             /* Send a ACK with a NULL request to signify revocation */
             proc = mca_pml_ob1_peer_lookup(ompi_comm, hdr->hdr_rndv.hdr_match.hdr_src);
-            mca_pml_ob1_recv_request_ack_send(NULL, proc->ompi_proc, hdr->hdr_rndv.hdr_src_req.lval, NULL, 0, 0, false);
+            mca_pml_ob1_recv_request_ack_send(NULL, proc->ompi_proc, hdr->hdr_rndv.hdr_src_req.lval, NULL, 0, 0, 0, 0);
         }
         else {
             /* if it's a TYPE_MATCH, the sender is not expecting anything
@@ -447,6 +455,49 @@ mca_pml_ob1_recv_frag_t *check_cantmatch_for_match (mca_pml_ob1_comm_proc_t *pro
     return NULL;
 }
 
+/**
+ * Deliver the messages of a coalesced fragment one by one, as if each of
+ * them had been received in its own fragment. The sender packs the whole
+ * fragment in a single segment.
+ */
+static void mca_pml_ob1_recv_frag_coalesced (mca_btl_base_module_t *btl,
+                                             const mca_btl_base_receive_descriptor_t *descriptor)
+{
+    const mca_btl_base_segment_t *segments = descriptor->des_segments;
+    const mca_pml_ob1_coalesced_hdr_t *hdr = (const mca_pml_ob1_coalesced_hdr_t *) segments->seg_addr.pval;
+    unsigned char *ptr = (unsigned char *) segments->seg_addr.pval + sizeof (*hdr);
+    size_t remaining = segments->seg_len - sizeof (*hdr);
+    mca_btl_base_receive_descriptor_t entry_desc = *descriptor;
+    mca_btl_base_segment_t entry_segment;
+
+    entry_desc.des_segments = &entry_segment;
+    entry_desc.des_segment_count = 1;
+
+    for (int i = 0 ; i < hdr->hdr_count ; ++i) {
+        mca_pml_ob1_coalesced_entry_t entry;
+        size_t entry_size;
+
+        if (OPAL_UNLIKELY(remaining < sizeof (entry))) {
+            break;
+        }
+        memcpy (&entry, ptr, sizeof (entry));
+        entry_size = OPAL_ALIGN(sizeof (entry) + entry.entry_len, MCA_PML_OB1_COALESCED_ALIGN, size_t);
+        if (OPAL_UNLIKELY(sizeof (entry) + entry.entry_len > remaining)) {
+            break;
+        }
+
+        entry_segment.seg_addr.pval = ptr + sizeof (entry);
+        entry_segment.seg_len = entry.entry_len;
+        mca_pml_ob1_recv_frag_callback_match (btl, &entry_desc);
+
+        if (entry_size >= remaining) {
+            break;
+        }
+        ptr += entry_size;
+        remaining -= entry_size;
+    }
+}
+
 void mca_pml_ob1_recv_frag_callback_match (mca_btl_base_module_t *btl,
                                            const mca_btl_base_receive_descriptor_t *descriptor)
 {
@@ -458,12 +509,17 @@ void mca_pml_ob1_recv_frag_callback_match (mca_btl_base_module_t *btl,
     mca_pml_ob1_comm_proc_t *proc;
     size_t num_segments = descriptor->des_segment_count;
     size_t bytes_received = 0;
+    bool lane;
 
     assert(num_segments <= MCA_BTL_DES_MAX_SEGMENTS);
 
     if (OPAL_UNLIKELY(segments->seg_len < OMPI_PML_OB1_MATCH_HDR_LEN)) {
         return;
     }
+    if (OPAL_UNLIKELY(hdr->hdr_common.hdr_flags & MCA_PML_OB1_HDR_FLAGS_COALESCED)) {
+        mca_pml_ob1_recv_frag_coalesced (btl, descriptor);
+        return;
+    }
     ob1_hdr_ntoh(((mca_pml_ob1_hdr_t*) hdr), MCA_PML_OB1_HDR_TYPE_MATCH);
 
     /* communicator pointer */
@@ -501,14 +557,15 @@ void mca_pml_ob1_recv_frag_callback_match (mca_btl_base_module_t *btl,
      * end points) from being processed, and potentially "loosing"
      * the fragment.
      */
-    OB1_MATCHING_LOCK(&comm->matching_lock);
+    lane = mca_pml_ob1_comm_match_lock(comm, proc);
 
 #if OPAL_ENABLE_FT_MPI
     if( OPAL_UNLIKELY((ompi_comm_is_revoked(comm_ptr) && !ompi_request_tag_is_ft(hdr->hdr_tag)) ||
                       (ompi_comm_coll_revoked(comm_ptr) && ompi_request_tag_is_collective(hdr->hdr_tag))) ) {
         /* if it's a TYPE_MATCH, the sender is not expecting anything from us
          * so we are done. */
-        OPAL_THREAD_UNLOCK(&comm->matching_lock);
+        mca_pml_ob1_comm_match_unlock(comm, proc, lane);
+        mca_pml_ob1_flow_delivered (proc);
         OPAL_OUTPUT_VERBOSE((15, ompi_ftmpi_output_handle,
             "ob1_revoke_comm: dropping silently frag from %d", hdr->hdr_src));
         return;
@@ -526,7 +583,7 @@ void mca_pml_ob1_recv_frag_callback_match (mca_btl_base_module_t *btl,
             MCA_PML_OB1_RECV_FRAG_INIT(frag, hdr, segments, num_segments, btl);
             append_frag_to_ordered_list(&proc->frags_cant_match, frag, proc->expected_sequence);
             SPC_RECORD(OMPI_SPC_OUT_OF_SEQUENCE, 1);
-            OB1_MATCHING_UNLOCK(&comm->matching_lock);
+            mca_pml_ob1_comm_match_unlock(comm, proc, lane);
             return;
         }
 
@@ -551,7 +608,7 @@ void mca_pml_ob1_recv_frag_callback_match (mca_btl_base_module_t *btl,
                            hdr->hdr_src, hdr->hdr_tag, PERUSE_RECV);
 
     /* release matching lock before processing fragment */
-    OB1_MATCHING_UNLOCK(&comm->matching_lock);
+    mca_pml_ob1_comm_match_unlock(comm, proc, lane);
 
     if(OPAL_LIKELY(match)) {
         bytes_received = segments->seg_len - OMPI_PML_OB1_MATCH_HDR_LEN;
@@ -620,17 +677,19 @@ void mca_pml_ob1_recv_frag_callback_match (mca_btl_base_module_t *btl,
     if(NULL != proc->frags_cant_match) {
         mca_pml_ob1_recv_frag_t* frag;
 
-        OB1_MATCHING_LOCK(&comm->matching_lock);
+        lane = mca_pml_ob1_comm_match_lock(comm, proc);
         if((frag = check_cantmatch_for_match(proc))) {
             /* mca_pml_ob1_recv_frag_match_proc() will release the lock. */
             mca_pml_ob1_recv_frag_match_proc(frag->btl, comm_ptr, proc,
                                              &frag->hdr.hdr_match,
                                              frag->segments, frag->num_segments,
-                                             frag->hdr.hdr_match.hdr_common.hdr_type, frag);
+                                             frag->hdr.hdr_match.hdr_common.hdr_type, frag, lane);
         } else {
-            OB1_MATCHING_UNLOCK(&comm->matching_lock);
+            mca_pml_ob1_comm_match_unlock(comm, proc, lane);
         }
     }
+
+    mca_pml_ob1_flow_return (comm_ptr, proc);
 }
 
 
@@ -702,6 +761,16 @@ void mca_pml_ob1_recv_frag_callback_ack (mca_btl_base_module_t *btl,
         sendreq->req_throttle_sends = true;
     }
 
+    if (mca_pml_ob1.adaptive_eager) {
+        mca_pml_ob1_adapt_ack (sendreq, btl, hdr->hdr_common.hdr_flags);
+    }
+
+    if (hdr->hdr_ack.hdr_credits) {
+        mca_pml_ob1_flow_grant (mca_pml_ob1_peer_lookup (sendreq->req_send.req_base.req_comm,
+                                                         sendreq->req_send.req_base.req_peer),
+                                hdr->hdr_ack.hdr_credits);
+    }
+
     if (hdr->hdr_ack.hdr_send_size) {
         size = hdr->hdr_ack.hdr_send_size;
     } else {
@@ -865,6 +934,7 @@ static mca_pml_ob1_recv_request_t *match_incomming(const mca_pml_ob1_match_hdr_t
         req_tag = (*match)->req_recv.req_base.req_tag;
         if(req_tag == tag || (req_tag == OMPI_ANY_TAG && tag >= 0)) {
             opal_list_remove_item(queue, (opal_list_item_t*)(*match));
+            OPAL_THREAD_SUB_FETCH_SIZE_T(&comm->posted_receives, 1);
             PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
                     &((*match)->req_recv.req_base), PERUSE_RECV);
             return *match;
@@ -893,6 +963,7 @@ static mca_pml_ob1_recv_request_t *match_incomming_no_any_source (const mca_pml_
 
         if (req_tag == tag || (req_tag == OMPI_ANY_TAG && tag >= 0)) {
             opal_list_remove_item (&proc->specific_receives, (opal_list_item_t *) recv_req);
+            OPAL_THREAD_SUB_FETCH_SIZE_T(&comm->posted_receives, 1);
             PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
                     &(recv_req->req_recv.req_base), PERUSE_RECV);
             return recv_req;
@@ -901,7 +972,43 @@ static mca_pml_ob1_recv_request_t *match_incomming_no_any_source (const mca_pml_
 
     return NULL;
 }
+
+static mca_pml_ob1_recv_request_t *match_incomming_vector (const mca_pml_ob1_match_hdr_t *hdr,
+                                                           mca_pml_ob1_comm_t *comm)
+{
+    mca_pml_ob1_recv_request_t *recv_req;
+
+    recv_req = mca_pml_ob1_prq_vector_find_dequeue (comm->prq_vector, hdr->hdr_tag, hdr->hdr_src);
+    if (NULL != recv_req) {
+        PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
+                                &(recv_req->req_recv.req_base), PERUSE_RECV);
+        /* back to the lists once the burst of receives is over */
+        if (0 == comm->prq_vector->size &&
+            MCA_PML_OB1_MATCHING_AUTO == mca_pml_ob1.matching_engine) {
+            mca_pml_ob1_comm_prq_vector_deactivate (comm);
+        }
+    }
+
+    return recv_req;
+}
+#endif
+
+static inline mca_pml_ob1_recv_request_t *match_posted (const mca_pml_ob1_match_hdr_t *hdr,
+                                                        ompi_communicator_t *comm_ptr,
+                                                        mca_pml_ob1_comm_t *comm,
+                                                        mca_pml_ob1_comm_proc_t *proc)
+{
+#if MCA_PML_OB1_CUSTOM_MATCH
+    return match_incomming(hdr, comm, proc);
+#else
+    if (comm->prq_vector_active) {
+        return match_incomming_vector (hdr, comm);
+    } else if (!OMPI_COMM_CHECK_ASSERT_NO_ANY_SOURCE (comm_ptr)) {
+        return match_incomming(hdr, comm, proc);
+    }
+    return match_incomming_no_any_source (hdr, comm, proc);
 #endif
+}
 
 static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
                                               const mca_pml_ob1_match_hdr_t *hdr,
@@ -919,15 +1026,7 @@ static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
     mca_pml_ob1_comm_t *comm = (mca_pml_ob1_comm_t *)comm_ptr->c_pml_comm;
 
     do {
-#if MCA_PML_OB1_CUSTOM_MATCH
-        match = match_incomming(hdr, comm, proc);
-#else
-        if (!OMPI_COMM_CHECK_ASSERT_NO_ANY_SOURCE (comm_ptr)) {
-            match = match_incomming(hdr, comm, proc);
-        } else {
-            match = match_incomming_no_any_source (hdr, comm, proc);
-        }
-#endif
+        match = match_posted (hdr, comm_ptr, comm, proc);
 
         /* if match found, process data */
         if(OPAL_LIKELY(NULL != match)) {
@@ -954,6 +1053,9 @@ static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
                 match->req_recv.req_base.req_addr = tmp;
                 mca_pml_ob1_recv_request_matched_probe(match, btl, segments,
                                                        num_segments);
+                if (MCA_PML_OB1_HDR_TYPE_MATCH == hdr->hdr_common.hdr_type) {
+                    mca_pml_ob1_flow_delivered (proc);
+                }
                 /* this frag is already processed, so we want to break out
                    of the loop and not end up back on the unexpected queue. */
                 SPC_TIMER_STOP(OMPI_SPC_MATCH_TIME, &timer);
@@ -962,6 +1064,10 @@ static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
 
             PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_MSG_MATCH_POSTED_REQ,
                                     &(match->req_recv.req_base), PERUSE_RECV);
+            mca_pml_ob1_adapt_arrival (proc, false);
+            if (MCA_PML_OB1_HDR_TYPE_MATCH == hdr->hdr_common.hdr_type) {
+                mca_pml_ob1_flow_delivered (proc);
+            }
             SPC_TIMER_STOP(OMPI_SPC_MATCH_TIME, &timer);
             return match;
         }
@@ -977,6 +1083,9 @@ static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
         SPC_RECORD(OMPI_SPC_UNEXPECTED, 1);
         SPC_RECORD(OMPI_SPC_UNEXPECTED_IN_QUEUE, 1);
         SPC_UPDATE_WATERMARK(OMPI_SPC_MAX_UNEXPECTED_IN_QUEUE, OMPI_SPC_UNEXPECTED_IN_QUEUE);
+        mca_pml_ob1_event_raise (mca_pml_ob1.event_unexpected, comm_ptr, hdr->hdr_src, hdr->hdr_tag,
+                                 segments->seg_len);
+        mca_pml_ob1_adapt_arrival (proc, true);
         PERUSE_TRACE_MSG_EVENT(PERUSE_COMM_MSG_INSERT_IN_UNEX_Q, comm_ptr,
                                hdr->hdr_src, hdr->hdr_tag, PERUSE_RECV);
         SPC_TIMER_STOP(OMPI_SPC_MATCH_TIME, &timer);
@@ -984,6 +1093,99 @@ static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
     } while(true);
 }
 
+int mca_pml_ob1_recv_frag_match_self (mca_btl_base_module_t *btl, ompi_communicator_t *comm_ptr,
+                                      mca_pml_ob1_comm_proc_t *proc, int tag, uint16_t seq,
+                                      opal_convertor_t *convertor, size_t size)
+{
+    mca_pml_ob1_comm_t *comm = (mca_pml_ob1_comm_t *)comm_ptr->c_pml_comm;
+    mca_pml_ob1_recv_request_t *match;
+    mca_btl_base_segment_t segments[2];
+    mca_pml_ob1_match_hdr_t hdr;
+    bool lane;
+
+#if OPAL_ENABLE_FT_MPI
+    if (OPAL_UNLIKELY(ompi_comm_is_revoked(comm_ptr) || ompi_comm_coll_revoked(comm_ptr))) {
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+#endif
+
+    mca_pml_ob1_match_hdr_prepare (&hdr, MCA_PML_OB1_HDR_TYPE_MATCH, 0, comm_ptr->c_contextid,
+                                   comm_ptr->c_my_rank, tag, seq);
+    /* the probes only look at the length of the data */
+    segments[0].seg_addr.pval = &hdr;
+    segments[0].seg_len = OMPI_PML_OB1_MATCH_HDR_LEN;
+    segments[1].seg_addr.pval = NULL;
+    segments[1].seg_len = size;
+
+    lane = mca_pml_ob1_comm_match_lock(comm, proc);
+
+    /* the previous messages to self have to be matched first */
+    if (OPAL_UNLIKELY(NULL != proc->frags_cant_match ||
+                      (!OMPI_COMM_CHECK_ASSERT_ALLOW_OVERTAKE(comm_ptr) &&
+                       seq != (uint16_t) proc->expected_sequence))) {
+        mca_pml_ob1_comm_match_unlock(comm, proc, lane);
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
+    PERUSE_TRACE_MSG_EVENT(PERUSE_COMM_MSG_ARRIVED, comm_ptr, hdr.hdr_src, tag, PERUSE_RECV);
+
+    while (NULL != (match = match_posted (&hdr, comm_ptr, comm, proc))) {
+        match->req_recv.req_base.req_proc = proc->ompi_proc;
+        if (OPAL_LIKELY(MCA_PML_REQUEST_PROBE != match->req_recv.req_base.req_type)) {
+            break;
+        }
+        mca_pml_ob1_recv_request_matched_probe(match, btl, segments, 2);
+    }
+
+    /* nothing posted, the message goes through the btl and the unexpected
+     * queue as any other, with the same sequence number */
+    if (NULL == match) {
+        mca_pml_ob1_comm_match_unlock(comm, proc, lane);
+        return OMPI_ERR_NOT_AVAILABLE;
+    }
+
+    if (!OMPI_COMM_CHECK_ASSERT_ALLOW_OVERTAKE(comm_ptr)) {
+        proc->expected_sequence++;
+    }
+    mca_pml_ob1_comm_match_unlock(comm, proc, lane);
+
+    PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_MSG_MATCH_POSTED_REQ,
+                            &(match->req_recv.req_base), PERUSE_RECV);
+
+    if (OPAL_UNLIKELY(MCA_PML_REQUEST_MPROBE == match->req_recv.req_base.req_type)) {
+        /* the mrecv needs the message in a receive frag, as if it was
+         * unexpected */
+        mca_pml_ob1_recv_frag_t *frag;
+        void *packed = NULL;
+
+        if (size > 0) {
+            struct iovec iov = {.iov_base = NULL, .iov_len = size};
+            uint32_t iov_count = 1;
+            size_t max_data = size;
+
+            if (opal_convertor_need_buffers (convertor)) {
+                iov.iov_base = packed = malloc (size);
+                if (OPAL_UNLIKELY(NULL == packed)) {
+                    return OMPI_ERR_OUT_OF_RESOURCE;
+                }
+            }
+            opal_convertor_pack (convertor, &iov, &iov_count, &max_data);
+            segments[1].seg_addr.pval = iov.iov_base;
+        }
+
+        MCA_PML_OB1_RECV_FRAG_ALLOC(frag);
+        MCA_PML_OB1_RECV_FRAG_INIT(frag, &hdr, segments, 2, btl);
+        free (packed);
+
+        match->req_recv.req_base.req_addr = frag;
+        mca_pml_ob1_recv_request_matched_probe(match, btl, frag->segments, frag->num_segments);
+        return OMPI_SUCCESS;
+    }
+
+    mca_pml_ob1_recv_request_progress_self (match, &hdr, convertor, size);
+    return OMPI_SUCCESS;
+}
+
 /**
  * RCS/CTS receive side matching
  *
@@ -1026,6 +1228,7 @@ static int mca_pml_ob1_recv_frag_match (mca_btl_base_module_t *btl,
     ompi_communicator_t *comm_ptr;
     mca_pml_ob1_comm_t *comm;
     mca_pml_ob1_comm_proc_t *proc;
+    bool lane;
 
     /* communicator pointer */
     comm_ptr = ompi_comm_lookup(hdr->hdr_ctx);
@@ -1062,18 +1265,18 @@ static int mca_pml_ob1_recv_frag_match (mca_btl_base_module_t *btl,
      * end points) from being processed, and potentially "loosing"
      * the fragment.
      */
-    OB1_MATCHING_LOCK(&comm->matching_lock);
+    lane = mca_pml_ob1_comm_match_lock(comm, proc);
 
 #if OPAL_ENABLE_FT_MPI
     if( OPAL_UNLIKELY((ompi_comm_is_revoked(comm_ptr) && !ompi_request_tag_is_ft(hdr->hdr_tag) )) ||
                       (ompi_comm_coll_revoked(comm_ptr) && ompi_request_tag_is_collective(hdr->hdr_tag)) ) {
-        OPAL_THREAD_UNLOCK(&comm->matching_lock);
+        mca_pml_ob1_comm_match_unlock(comm, proc, lane);
         if( MCA_PML_OB1_HDR_TYPE_MATCH != hdr->hdr_common.hdr_type ) {
             assert( MCA_PML_OB1_HDR_TYPE_RGET == hdr->hdr_common.hdr_type ||
                     MCA_PML_OB1_HDR_TYPE_RNDV == hdr->hdr_common.hdr_type );
             /* Send a ACK with a NULL request to signify revocation */
             mca_pml_ob1_rendezvous_hdr_t* hdr_rndv = (mca_pml_ob1_rendezvous_hdr_t*) hdr;
-            mca_pml_ob1_recv_request_ack_send(NULL, proc->ompi_proc, hdr_rndv->hdr_src_req.lval, NULL, 0, 0, false);
+            mca_pml_ob1_recv_request_ack_send(NULL, proc->ompi_proc, hdr_rndv->hdr_src_req.lval, NULL, 0, 0, 0, 0);
             OPAL_OUTPUT_VERBOSE((2, ompi_ftmpi_output_handle, "Recvfrag: comm %d is revoked or collectives force errors, sending a NACK to the RDV/RGET match from %d\n", hdr->hdr_ctx, hdr->hdr_src));
         }
         else {
@@ -1100,7 +1303,7 @@ static int mca_pml_ob1_recv_frag_match (mca_btl_base_module_t *btl,
             SPC_RECORD(OMPI_SPC_OOS_IN_QUEUE, 1);
             SPC_UPDATE_WATERMARK(OMPI_SPC_MAX_OOS_IN_QUEUE, OMPI_SPC_OOS_IN_QUEUE);
 
-            OB1_MATCHING_UNLOCK(&comm->matching_lock);
+            mca_pml_ob1_comm_match_unlock(comm, proc, lane);
             return OMPI_SUCCESS;
         }
     }
@@ -1108,7 +1311,7 @@ static int mca_pml_ob1_recv_frag_match (mca_btl_base_module_t *btl,
     /* mca_pml_ob1_recv_frag_match_proc() will release the lock. */
     return mca_pml_ob1_recv_frag_match_proc(btl, comm_ptr, proc, hdr,
                                             segments, num_segments,
-                                            type, NULL);
+                                            type, NULL, lane);
 }
 
 
@@ -1116,8 +1319,9 @@ static int mca_pml_ob1_recv_frag_match (mca_btl_base_module_t *btl,
  * then try to match the next frag in sequence by looking into arrived
  * out of order frags in frags_cant_match list until it can't find one.
  *
- * ATTENTION: THIS FUNCTION MUST BE CALLED WITH COMMUNICATOR LOCK HELD.
- * THE LOCK WILL BE RELEASED UPON RETURN. USE WITH CARE. */
+ * ATTENTION: THIS FUNCTION MUST BE CALLED WITH THE MATCHING LOCK HELD
+ * (mca_pml_ob1_comm_match_lock). THE LOCK WILL BE RELEASED UPON RETURN.
+ * USE WITH CARE. */
 static int
 mca_pml_ob1_recv_frag_match_proc (mca_btl_base_module_t *btl,
                                   ompi_communicator_t* comm_ptr,
@@ -1126,7 +1330,8 @@ mca_pml_ob1_recv_frag_match_proc (mca_btl_base_module_t *btl,
                                   const mca_btl_base_segment_t *segments,
                                   size_t num_segments,
                                   int type,
-                                  mca_pml_ob1_recv_frag_t *frag)
+                                  mca_pml_ob1_recv_frag_t *frag,
+                                  bool lane)
 {
     /* local variables */
     mca_pml_ob1_comm_t *comm = (mca_pml_ob1_comm_t *)comm_ptr->c_pml_comm;
@@ -1161,7 +1366,7 @@ mca_pml_ob1_recv_frag_match_proc (mca_btl_base_module_t *btl,
                            hdr->hdr_src, hdr->hdr_tag, PERUSE_RECV);
 
     /* release matching lock before processing fragment */
-    OB1_MATCHING_UNLOCK(&comm->matching_lock);
+    mca_pml_ob1_comm_match_unlock(comm, proc, lane);
 
     if(OPAL_LIKELY(match)) {
         switch(type) {
@@ -1186,7 +1391,7 @@ mca_pml_ob1_recv_frag_match_proc (mca_btl_base_module_t *btl,
      * may now be used to form new matchs
      */
     if(OPAL_UNLIKELY(NULL != proc->frags_cant_match)) {
-        OB1_MATCHING_LOCK(&comm->matching_lock);
+        lane = mca_pml_ob1_comm_match_lock(comm, proc);
         if((frag = check_cantmatch_for_match(proc))) {
             hdr = &frag->hdr.hdr_match;
             segments = frag->segments;
@@ -1195,7 +1400,7 @@ mca_pml_ob1_recv_frag_match_proc (mca_btl_base_module_t *btl,
             type = hdr->hdr_common.hdr_type;
             goto match_this_frag;
         }
-        OB1_MATCHING_UNLOCK(&comm->matching_lock);
+        mca_pml_ob1_comm_match_unlock(comm, proc, lane);
     }
 
     return OMPI_SUCCESS;
@@ -30,6 +30,8 @@
 
 #include "ompi/mca/pml/ob1/pml_ob1_comm.h"
 #include "ompi/mca/pml/ob1/pml_ob1_hdr.h"
+#include "ompi/mca/pml/ob1/pml_ob1_flow.h"
+#include "ompi/runtime/ompi_spc.h"
 
 BEGIN_C_DECLS
 
@@ -48,6 +50,9 @@ struct mca_pml_ob1_recv_frag_t {
     mca_btl_base_module_t* btl;
     mca_btl_base_segment_t segments[MCA_BTL_DES_MAX_SEGMENTS];
     mca_pml_ob1_buffer_t buffers[MCA_BTL_DES_MAX_SEGMENTS];
+#if SPC_ENABLE == 1
+    opal_timer_t spc_queued;    /* queuing time for the SPC latency histogram */
+#endif
     unsigned char addr[1];
 };
 typedef struct mca_pml_ob1_recv_frag_t mca_pml_ob1_recv_frag_t;
@@ -93,6 +98,7 @@ do {                                                                    \
         memcpy( _ptr, segs[i].seg_addr.pval, segs[i].seg_len);          \
         _ptr += segs[i].seg_len;                                        \
     }                                                                   \
+    mca_pml_ob1_flow_buffered( (ptrdiff_t)_size );                      \
  } while(0)
 
 
@@ -103,6 +109,7 @@ do {                                                                    \
         mca_pml_ob1.allocator->alc_free( mca_pml_ob1.allocator,         \
                                          frag->buffers[0].addr );       \
     }                                                                   \
+    mca_pml_ob1_flow_buffered( -(ptrdiff_t)frag->segments[0].seg_len ); \
     frag->num_segments = 0;                                             \
                                                                         \
     /* return recv_frag */                                              \
@@ -159,6 +166,19 @@ extern void mca_pml_ob1_recv_frag_callback_put (mca_btl_base_module_t *btl,
 extern void mca_pml_ob1_recv_frag_callback_fin (mca_btl_base_module_t *btl,
                                                 const mca_btl_base_receive_descriptor_t *descriptor);
 
+/**
+ * Match a message a process sends to itself directly against its posted
+ * receives, and copy it from the send buffer described by the convertor
+ * into the receive buffer. Returns OMPI_ERR_NOT_AVAILABLE, without using
+ * the sequence number, when there is no posted receive for it or when
+ * previous messages to self are still to be matched.
+ */
+int mca_pml_ob1_recv_frag_match_self (mca_btl_base_module_t *btl,
+                                      ompi_communicator_t *comm_ptr,
+                                      mca_pml_ob1_comm_proc_t *proc,
+                                      int tag, uint16_t seq,
+                                      opal_convertor_t *convertor, size_t size);
+
 /**
  * Extract the next fragment from the cant_match ordered list. This fragment
  * will be the next in sequence.
@@ -31,6 +31,7 @@
 #include "ompi_config.h"
 
 #include "opal/mca/mpool/mpool.h"
+#include "opal/mca/timer/base/base.h"
 #include "opal/util/arch.h"
 #include "ompi/runtime/ompi_spc.h"
 #include "ompi/mca/pml/pml.h"
@@ -40,6 +41,10 @@
 #include "pml_ob1_recvfrag.h"
 #include "pml_ob1_sendreq.h"
 #include "pml_ob1_rdmafrag.h"
+#include "pml_ob1_prq_vector.h"
+#include "pml_ob1_adapt.h"
+#include "pml_ob1_flow.h"
+#include "pml_ob1_tm.h"
 #include "ompi/mca/bml/base/base.h"
 
 #if OPAL_CUDA_SUPPORT
@@ -101,11 +106,18 @@ static int mca_pml_ob1_recv_request_cancel(struct ompi_request_t* ompi_request,
     mca_pml_ob1_recv_request_t* request = (mca_pml_ob1_recv_request_t*)ompi_request;
     ompi_communicator_t *comm = request->req_recv.req_base.req_comm;
     mca_pml_ob1_comm_t *ob1_comm = comm->c_pml_comm;
+    bool tm_posted;
 
     /* The rest should be protected behind the match logic lock */
-    OB1_MATCHING_LOCK(&ob1_comm->matching_lock);
+    (void) mca_pml_ob1_comm_match_lock(ob1_comm, NULL);
     if( REQUEST_COMPLETE(ompi_request) ) {
-        OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+        mca_pml_ob1_comm_match_unlock(ob1_comm, NULL, false);
+        return OMPI_SUCCESS;
+    }
+    tm_posted = NULL != request->req_tm_handle;
+    if( OPAL_UNLIKELY(tm_posted) && !mca_pml_ob1_tm_cancel(request) ) {
+        /* matched in the network, the completion is on its way */
+        mca_pml_ob1_comm_match_unlock(ob1_comm, NULL, false);
         return OMPI_SUCCESS;
     }
     if( !request->req_match_received ) { /* the match has not been already done */
@@ -113,16 +125,22 @@ static int mca_pml_ob1_recv_request_cancel(struct ompi_request_t* ompi_request,
 #if MCA_PML_OB1_CUSTOM_MATCH
         custom_match_prq_cancel(ob1_comm->prq, request);
 #else
-        if( request->req_recv.req_base.req_peer == OMPI_ANY_SOURCE ) {
+        if( OPAL_UNLIKELY(tm_posted) ) {
+            /* it was only posted in the network */
+        } else if( ob1_comm->prq_vector_active ) {
+            mca_pml_ob1_prq_vector_remove(ob1_comm->prq_vector, request);
+        } else if( request->req_recv.req_base.req_peer == OMPI_ANY_SOURCE ) {
             opal_list_remove_item( &ob1_comm->wild_receives, (opal_list_item_t*)request );
+            ob1_comm->posted_receives--;
         } else {
             mca_pml_ob1_comm_proc_t* proc = mca_pml_ob1_peer_lookup (comm, request->req_recv.req_base.req_peer);
             opal_list_remove_item(&proc->specific_receives, (opal_list_item_t*)request);
+            ob1_comm->posted_receives--;
         }
 #endif
         PERUSE_TRACE_COMM_EVENT( PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
                                 &(request->req_recv.req_base), PERUSE_RECV );
-        OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+        mca_pml_ob1_comm_match_unlock(ob1_comm, NULL, false);
 #if OPAL_ENABLE_FT_MPI
         opal_output_verbose(10, ompi_ftmpi_output_handle,
                             "Recv_request_cancel: cancel granted for request %p because it has not matched\n",
@@ -130,7 +148,7 @@ static int mca_pml_ob1_recv_request_cancel(struct ompi_request_t* ompi_request,
 #endif
     }
     else { /* it has matched */
-        OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+        mca_pml_ob1_comm_match_unlock(ob1_comm, NULL, false);
 #if OPAL_ENABLE_FT_MPI
         if( ompi_comm_is_proc_active( comm, request->req_recv.req_base.req_peer,
                                               OMPI_COMM_IS_INTER(comm) ) ) {
@@ -178,6 +196,11 @@ static void mca_pml_ob1_recv_request_construct(mca_pml_ob1_recv_request_t* reque
     request->req_recv.req_base.req_ompi.req_cancel = mca_pml_ob1_recv_request_cancel;
     request->req_rdma_cnt = 0;
     request->local_handle = NULL;
+    request->req_tm_handle = NULL;
+    request->req_tm_bml = NULL;
+#if SPC_ENABLE == 1
+    request->req_spc_start = 0;
+#endif
     OBJ_CONSTRUCT(&request->lock, opal_mutex_t);
 }
 
@@ -219,6 +242,7 @@ static void mca_pml_ob1_put_completion (mca_pml_ob1_rdma_frag_t *frag, int64_t r
 {
     mca_pml_ob1_recv_request_t* recvreq = (mca_pml_ob1_recv_request_t *) frag->rdma_req;
     mca_bml_base_btl_t *bml_btl = frag->rdma_bml;
+    uint64_t rdma_start = frag->rdma_start;
 
     OPAL_THREAD_ADD_FETCH32(&recvreq->req_pipeline_depth, -1);
 
@@ -226,6 +250,12 @@ static void mca_pml_ob1_put_completion (mca_pml_ob1_rdma_frag_t *frag, int64_t r
     MCA_PML_OB1_RDMA_FRAG_RETURN(frag);
 
     if (OPAL_LIKELY(0 < rdma_size)) {
+        mca_pml_ob1_rdma_complete (mca_bml_base_get_endpoint (recvreq->req_recv.req_base.req_proc),
+                                   bml_btl, rdma_start, (size_t) rdma_size);
+
+        mca_pml_ob1_event_raise (mca_pml_ob1.event_rdma_complete, recvreq->req_recv.req_base.req_comm,
+                                 recvreq->req_recv.req_base.req_ompi.req_status.MPI_SOURCE,
+                                 recvreq->req_recv.req_base.req_ompi.req_status.MPI_TAG, (size_t) rdma_size);
 
         /* check completion status */
         OPAL_THREAD_ADD_FETCH_SIZE_T(&recvreq->req_bytes_received, rdma_size);
@@ -248,7 +278,7 @@ static void mca_pml_ob1_put_completion (mca_pml_ob1_rdma_frag_t *frag, int64_t r
 int mca_pml_ob1_recv_request_ack_send_btl(
         ompi_proc_t* proc, mca_bml_base_btl_t* bml_btl,
         uint64_t hdr_src_req, void *hdr_dst_req, uint64_t hdr_send_offset,
-        uint64_t size, bool nordma)
+        uint64_t size, uint8_t hdr_flags, uint16_t credits)
 {
     mca_btl_base_descriptor_t* des;
     mca_pml_ob1_ack_hdr_t* ack;
@@ -265,8 +295,8 @@ int mca_pml_ob1_recv_request_ack_send_btl(
 
     /* fill out header */
     ack = (mca_pml_ob1_ack_hdr_t*)des->des_segments->seg_addr.pval;
-    mca_pml_ob1_ack_hdr_prepare (ack, nordma ? MCA_PML_OB1_HDR_FLAGS_NORDMA : 0,
-                                 hdr_src_req, hdr_dst_req, hdr_send_offset, size);
+    mca_pml_ob1_ack_hdr_prepare (ack, hdr_flags, hdr_src_req, hdr_dst_req, hdr_send_offset, size,
+                                 credits);
 
     ob1_hdr_hton(ack, MCA_PML_OB1_HDR_TYPE_ACK, proc);
 
@@ -352,7 +382,12 @@ static int mca_pml_ob1_recv_request_ack(
     recvreq->req_ack_sent = true;
     return mca_pml_ob1_recv_request_ack_send(btl, proc, hdr->hdr_src_req.lval,
                                              recvreq, recvreq->req_send_offset, 0,
-                                             recvreq->req_send_offset == bytes_received);
+                                             (recvreq->req_send_offset == bytes_received ?
+                                              MCA_PML_OB1_HDR_FLAGS_NORDMA : 0) |
+                                             mca_pml_ob1_adapt_ack_flags (recvreq->req_recv.req_base.req_comm,
+                                                                          hdr->hdr_match.hdr_src),
+                                             mca_pml_ob1_flow_ack_credits (recvreq->req_recv.req_base.req_comm,
+                                                                           hdr->hdr_match.hdr_src));
 }
 
 static int mca_pml_ob1_recv_request_put_frag (mca_pml_ob1_rdma_frag_t *frag);
@@ -362,7 +397,9 @@ static int mca_pml_ob1_recv_request_get_frag_failed (mca_pml_ob1_rdma_frag_t *fr
     mca_pml_ob1_recv_request_t *recvreq = (mca_pml_ob1_recv_request_t *) frag->rdma_req;
     ompi_proc_t *proc = (ompi_proc_t *) recvreq->req_recv.req_base.req_proc;
 
-    if (OMPI_ERR_NOT_AVAILABLE == rc) {
+    /* the sender can only put from a contiguous buffer */
+    if (OMPI_ERR_NOT_AVAILABLE == rc &&
+        !(frag->rdma_hdr.hdr_rget.hdr_rndv.hdr_match.hdr_common.hdr_flags & MCA_PML_OB1_HDR_FLAGS_IOV)) {
         /* get isn't supported for this transfer. tell peer to fallback on put */
         rc = mca_pml_ob1_recv_request_put_frag (frag);
         if (OMPI_SUCCESS == rc){
@@ -387,7 +424,7 @@ static int mca_pml_ob1_recv_request_get_frag_failed (mca_pml_ob1_rdma_frag_t *fr
 
     /* tell peer to fall back on send for this region */
     rc = mca_pml_ob1_recv_request_ack_send(NULL, proc, frag->rdma_hdr.hdr_rget.hdr_rndv.hdr_src_req.lval,
-                                           recvreq, frag->rdma_offset, frag->rdma_length, false);
+                                           recvreq, frag->rdma_offset, frag->rdma_length, 0, 0);
     MCA_PML_OB1_RDMA_FRAG_RETURN(frag);
     return rc;
 }
@@ -421,6 +458,13 @@ static void mca_pml_ob1_rget_completion (mca_btl_base_module_t* btl, struct mca_
             OPAL_THREAD_ADD_FETCH_SIZE_T(&recvreq->req_bytes_received, skipped_bytes);
         }
     } else {
+        mca_pml_ob1_rdma_complete (mca_bml_base_get_endpoint (recvreq->req_recv.req_base.req_proc),
+                                   bml_btl, frag->rdma_start, frag->rdma_length);
+
+        mca_pml_ob1_event_raise (mca_pml_ob1.event_rdma_complete, recvreq->req_recv.req_base.req_comm,
+                                 recvreq->req_recv.req_base.req_ompi.req_status.MPI_SOURCE,
+                                 recvreq->req_recv.req_base.req_ompi.req_status.MPI_TAG, frag->rdma_length);
+
         /* is receive request complete */
         OPAL_THREAD_ADD_FETCH_SIZE_T(&recvreq->req_bytes_received, frag->rdma_length);
         SPC_USER_OR_MPI(recvreq->req_recv.req_base.req_tag, (ompi_spc_value_t)frag->rdma_length,
@@ -677,6 +721,114 @@ void mca_pml_ob1_recv_request_frag_copy_finished( mca_btl_base_module_t* btl,
 }
 #endif /* OPAL_CUDA_SUPPORT */
 
+/*
+ * RGET of a non-contiguous source: get each piece where a segment of the
+ * sender overlaps a segment of the receive buffer, directly in place.
+ * Returns false if the receive buffer does not qualify.
+ */
+
+static bool mca_pml_ob1_recv_request_progress_rget_iov (mca_pml_ob1_recv_request_t *recvreq,
+                                                        mca_btl_base_module_t *btl,
+                                                        const mca_btl_base_segment_t *segments)
+{
+    mca_pml_ob1_rget_hdr_t *hdr = (mca_pml_ob1_rget_hdr_t *) segments->seg_addr.pval;
+    size_t reg_size = btl->btl_registration_handle_size;
+    const unsigned char *remote_segs = (const unsigned char *) (hdr + 1) + reg_size;
+    struct iovec iov[MCA_PML_OB1_RDMA_IOV_MAX];
+    mca_pml_ob1_rget_iov_seg_t remote_seg;
+    mca_pml_ob1_rget_iov_hdr_t iov_hdr;
+    mca_bml_base_endpoint_t *bml_endpoint;
+    size_t span, offset = 0, remote_done = 0, local_done = 0;
+    uint32_t iov_count, remote_index = 0, local_index = 0;
+    mca_bml_base_btl_t *rdma_bml;
+    unsigned char *base;
+
+    if (segments->seg_len < sizeof (*hdr) + reg_size + sizeof (iov_hdr)) {
+        return false;
+    }
+
+    memcpy (&iov_hdr, remote_segs, sizeof (iov_hdr));
+    remote_segs += sizeof (iov_hdr);
+    if (0 == iov_hdr.hdr_seg_count || segments->seg_len < sizeof (*hdr) + reg_size + sizeof (iov_hdr) +
+        iov_hdr.hdr_seg_count * sizeof (remote_seg)) {
+        return false;
+    }
+
+    bml_endpoint = mca_bml_base_get_endpoint (recvreq->req_recv.req_base.req_proc);
+    rdma_bml = mca_bml_base_btl_array_find (&bml_endpoint->btl_rdma, btl);
+    if (NULL == rdma_bml || !(rdma_bml->btl_flags & MCA_BTL_FLAGS_GET) ||
+        recvreq->req_recv.req_base.req_convertor.local_size < hdr->hdr_rndv.hdr_msg_length ||
+        OMPI_SUCCESS != mca_pml_ob1_rdma_iov_build (&recvreq->req_recv.req_base.req_convertor,
+                                                    iov, &iov_count, &base, &span)) {
+        return false;
+    }
+
+    recvreq->remote_req_send = hdr->hdr_rndv.hdr_src_req;
+    recvreq->rdma_bml = rdma_bml;
+
+    /* try to register the span of the receive buffer. as for the contiguous
+     * case, the fragments are registered one by one if this fails */
+    if (rdma_bml->btl->btl_register_mem) {
+        mca_bml_base_register_mem (rdma_bml, base, span, MCA_BTL_REG_FLAG_LOCAL_WRITE |
+                                   MCA_BTL_REG_FLAG_REMOTE_WRITE, &recvreq->local_handle);
+    }
+
+    memcpy (&remote_seg, remote_segs, sizeof (remote_seg));
+
+    while (offset < hdr->hdr_rndv.hdr_msg_length && remote_index < iov_hdr.hdr_seg_count &&
+           local_index < iov_count) {
+        mca_pml_ob1_rdma_frag_t *frag;
+        size_t length;
+
+        length = remote_seg.seg_len - remote_done;
+        if (length > iov[local_index].iov_len - local_done) {
+            length = iov[local_index].iov_len - local_done;
+        }
+        if (length > rdma_bml->btl->btl_get_limit) {
+            length = rdma_bml->btl->btl_get_limit;
+        }
+
+        MCA_PML_OB1_RDMA_FRAG_ALLOC(frag);
+        if (OPAL_UNLIKELY(NULL == frag)) {
+            /* GLB - FIX */
+             OMPI_ERROR_LOG(OMPI_ERR_OUT_OF_RESOURCE);
+             ompi_rte_abort(-1, NULL);
+        }
+
+        memcpy (frag->remote_handle, hdr + 1, reg_size);
+        frag->remote_address = remote_seg.seg_addr + remote_done;
+        frag->local_address = (unsigned char *) iov[local_index].iov_base + local_done;
+
+        frag->rdma_bml = rdma_bml;
+        frag->rdma_hdr.hdr_rget = *hdr;
+        frag->retries       = 0;
+        frag->rdma_req      = recvreq;
+        frag->rdma_state    = MCA_PML_OB1_RDMA_GET;
+        frag->local_handle  = NULL;
+        frag->rdma_offset   = offset;
+        frag->rdma_length   = length;
+        frag->rdma_start    = opal_timer_base_get_usec ();
+
+        if (OMPI_SUCCESS != mca_pml_ob1_recv_request_get_frag (frag)) {
+            break;
+        }
+
+        offset += length;
+        remote_done += length;
+        local_done += length;
+
+        if (remote_done == remote_seg.seg_len && ++remote_index < iov_hdr.hdr_seg_count) {
+            memcpy (&remote_seg, remote_segs + remote_index * sizeof (remote_seg), sizeof (remote_seg));
+            remote_done = 0;
+        }
+        if (local_done == iov[local_index].iov_len && ++local_index < iov_count) {
+            local_done = 0;
+        }
+    }
+
+    return true;
+}
+
 /*
  * Update the recv request status to reflect the number of bytes
  * received and actually delivered to the application.
@@ -701,6 +853,14 @@ void mca_pml_ob1_recv_request_progress_rget( mca_pml_ob1_recv_request_t* recvreq
 
     MCA_PML_OB1_RECV_REQUEST_MATCHED(recvreq, &hdr->hdr_rndv.hdr_match);
 
+    if (hdr->hdr_rndv.hdr_match.hdr_common.hdr_flags & MCA_PML_OB1_HDR_FLAGS_IOV) {
+        if (!mca_pml_ob1_recv_request_progress_rget_iov (recvreq, btl, segments)) {
+            /* all the data will come by copy in/out */
+            mca_pml_ob1_recv_request_ack(recvreq, btl, &hdr->hdr_rndv, 0);
+        }
+        return;
+    }
+
     /* if receive buffer is not contiguous we can't just RDMA read into it, so
      * fall back to copy in/out protocol. It is a pity because buffer on the
      * sender side is already registered. We need to be smarter here, perhaps
@@ -819,6 +979,7 @@ void mca_pml_ob1_recv_request_progress_rget( mca_pml_ob1_recv_request_t* recvreq
         }
 
         prev_sent = frag->rdma_length;
+        frag->rdma_start = opal_timer_base_get_usec ();
 
         /* NTH: TODO -- handle error conditions gracefully */
         rc = mca_pml_ob1_recv_request_get_frag(frag);
@@ -902,6 +1063,41 @@ void mca_pml_ob1_recv_request_progress_rndv( mca_pml_ob1_recv_request_t* recvreq
 
 }
 
+void mca_pml_ob1_recv_request_progress_inplace( mca_pml_ob1_recv_request_t* recvreq,
+                                                mca_btl_base_module_t* btl,
+                                                const mca_pml_ob1_hdr_t* hdr,
+                                                size_t length )
+{
+    size_t bytes_received = (length < recvreq->req_bytes_expected) ? length : recvreq->req_bytes_expected;
+
+    if (MCA_PML_OB1_HDR_TYPE_MATCH == hdr->hdr_common.hdr_type) {
+        recvreq->req_recv.req_bytes_packed = length;
+        MCA_PML_OB1_RECV_REQUEST_MATCHED(recvreq, &hdr->hdr_match);
+        recvreq->req_bytes_received = bytes_received;
+        SPC_USER_OR_MPI(recvreq->req_recv.req_base.req_ompi.req_status.MPI_TAG, (ompi_spc_value_t)bytes_received,
+                        OMPI_SPC_BYTES_RECEIVED_USER, OMPI_SPC_BYTES_RECEIVED_MPI);
+        recv_request_pml_complete(recvreq);
+        return;
+    }
+
+    /* the eager data of the rendezvous starts the contiguous buffer, the
+     * rest comes with the usual protocol */
+    recvreq->req_recv.req_bytes_packed = hdr->hdr_rndv.hdr_msg_length;
+    recvreq->remote_req_send = hdr->hdr_rndv.hdr_src_req;
+    recvreq->req_rdma_offset = bytes_received;
+    MCA_PML_OB1_RECV_REQUEST_MATCHED(recvreq, &hdr->hdr_match);
+    mca_pml_ob1_recv_request_ack(recvreq, btl, &hdr->hdr_rndv, bytes_received);
+    if( 0 < bytes_received ) {
+        OPAL_THREAD_ADD_FETCH_SIZE_T(&recvreq->req_bytes_received, bytes_received);
+        SPC_USER_OR_MPI(recvreq->req_recv.req_base.req_ompi.req_status.MPI_TAG, (ompi_spc_value_t)bytes_received,
+                        OMPI_SPC_BYTES_RECEIVED_USER, OMPI_SPC_BYTES_RECEIVED_MPI);
+    }
+    if(recv_request_pml_complete_check(recvreq) == false &&
+       recvreq->req_rdma_offset < recvreq->req_send_offset) {
+        mca_pml_ob1_recv_request_schedule(recvreq, NULL);
+    }
+}
+
 /*
  * Update the recv request status to reflect the number of bytes
  * received and actually delivered to the application.
@@ -958,6 +1154,100 @@ void mca_pml_ob1_recv_request_progress_match( mca_pml_ob1_recv_request_t* recvre
 }
 
 
+/*
+ * Copy a message sent to self from the send to the receive buffer in a
+ * single pass: the datatype copy when both sides use the same datatype,
+ * otherwise the contiguous side is given to the convertor of the other
+ * one, and only when both are non contiguous a bounce buffer is used.
+ */
+
+#define MCA_PML_OB1_SELF_BOUNCE_SIZE (16 * 1024)
+
+void mca_pml_ob1_recv_request_progress_self( mca_pml_ob1_recv_request_t* recvreq,
+                                             const mca_pml_ob1_match_hdr_t* hdr,
+                                             opal_convertor_t* convertor,
+                                             size_t size )
+{
+    opal_convertor_t *recv_convertor = &recvreq->req_recv.req_base.req_convertor;
+    size_t bytes = size, max_data;
+    struct iovec iov;
+    uint32_t iov_count;
+
+    recvreq->req_recv.req_bytes_packed = size;
+    MCA_PML_OB1_RECV_REQUEST_MATCHED(recvreq, hdr);
+    if (bytes > recvreq->req_bytes_expected) {
+        bytes = recvreq->req_bytes_expected;
+    }
+
+    if (bytes > 0) {
+        MEMCHECKER(
+                   memchecker_call(&opal_memchecker_base_mem_defined,
+                                   recvreq->req_recv.req_base.req_addr,
+                                   recvreq->req_recv.req_base.req_count,
+                                   recvreq->req_recv.req_base.req_datatype);
+                   );
+        OPAL_THREAD_LOCK(&recvreq->lock);
+        if ((convertor->pDesc == recv_convertor->pDesc) &&
+            !((convertor->flags | recv_convertor->flags) & (CONVERTOR_CUDA | CONVERTOR_CUDA_UNIFIED))) {
+            /* whole elements only, anything past them is truncated */
+            size_t count = bytes / convertor->pDesc->size;
+            opal_datatype_copy_content_same_ddt (convertor->pDesc, count,
+                                                 (char *) recv_convertor->pBaseBuf,
+                                                 (char *) convertor->pBaseBuf);
+            bytes = count * convertor->pDesc->size;
+        } else if (!opal_convertor_need_buffers (convertor)) {
+            /* the packing of a contiguous buffer only returns its address */
+            iov.iov_base = NULL;
+            iov.iov_len = bytes;
+            iov_count = 1;
+            max_data = bytes;
+            opal_convertor_pack (convertor, &iov, &iov_count, &max_data);
+            opal_convertor_unpack (recv_convertor, &iov, &iov_count, &max_data);
+            bytes = max_data;
+        } else if (!opal_convertor_need_buffers (recv_convertor)) {
+            iov.iov_base = (IOVBASE_TYPE *) (recv_convertor->pBaseBuf + recv_convertor->pDesc->true_lb);
+            iov.iov_len = bytes;
+            iov_count = 1;
+            max_data = bytes;
+            opal_convertor_pack (convertor, &iov, &iov_count, &max_data);
+            bytes = max_data;
+        } else {
+            unsigned char bounce[MCA_PML_OB1_SELF_BOUNCE_SIZE];
+            size_t done = 0;
+
+            while (done < bytes) {
+                iov.iov_base = (IOVBASE_TYPE *) bounce;
+                iov.iov_len = bytes - done;
+                if (iov.iov_len > sizeof (bounce)) {
+                    iov.iov_len = sizeof (bounce);
+                }
+                iov_count = 1;
+                max_data = iov.iov_len;
+                opal_convertor_pack (convertor, &iov, &iov_count, &max_data);
+                opal_convertor_unpack (recv_convertor, &iov, &iov_count, &max_data);
+                if (0 == max_data) {
+                    break;
+                }
+                done += max_data;
+            }
+            bytes = done;
+        }
+        OPAL_THREAD_UNLOCK(&recvreq->lock);
+        MEMCHECKER(
+                   memchecker_call(&opal_memchecker_base_mem_noaccess,
+                                   recvreq->req_recv.req_base.req_addr,
+                                   recvreq->req_recv.req_base.req_count,
+                                   recvreq->req_recv.req_base.req_datatype);
+                   );
+    }
+
+    recvreq->req_bytes_received = bytes;
+    SPC_USER_OR_MPI(recvreq->req_recv.req_base.req_ompi.req_status.MPI_TAG, (ompi_spc_value_t)bytes,
+                    OMPI_SPC_BYTES_RECEIVED_USER, OMPI_SPC_BYTES_RECEIVED_MPI);
+    recv_request_pml_complete(recvreq);
+}
+
+
 /**
  * Handle completion of a probe request
  */
@@ -1006,6 +1296,11 @@ int mca_pml_ob1_recv_request_schedule_once( mca_pml_ob1_recv_request_t* recvreq,
     size_t bytes_remaining = recvreq->req_send_offset -
         recvreq->req_rdma_offset;
 
+    /* follow the bandwidth observed since the request started */
+    if (mca_pml_ob1.rdma_adaptive && recvreq->req_rdma_cnt > 1 && bytes_remaining > 0) {
+        mca_pml_ob1_rdma_rebalance (recvreq->req_rdma, recvreq->req_rdma_cnt, bytes_remaining);
+    }
+
     /* if starting bml_btl is provided schedule next fragment on it first */
     if(start_bml_btl != NULL) {
         for(i = 0; i < recvreq->req_rdma_cnt; i++) {
@@ -1087,6 +1382,7 @@ int mca_pml_ob1_recv_request_schedule_once( mca_pml_ob1_recv_request_t* recvreq,
         frag->rdma_bml      = bml_btl;
         frag->local_address = data_ptr;
         frag->rdma_offset   = recvreq->req_rdma_offset;
+        frag->rdma_start    = opal_timer_base_get_usec ();
 
         rc = mca_pml_ob1_recv_request_put_frag (frag);
         if (OPAL_LIKELY(OMPI_SUCCESS == rc)) {
@@ -1112,10 +1408,28 @@ int mca_pml_ob1_recv_request_schedule_once( mca_pml_ob1_recv_request_t* recvreq,
     ((MCA_PML_REQUEST_IMPROBE == (R)->req_recv.req_base.req_type) || \
      (MCA_PML_REQUEST_MPROBE == (R)->req_recv.req_base.req_type))
 
-static inline void append_recv_req_to_queue(opal_list_t *queue,
-        mca_pml_ob1_recv_request_t *req)
+#if !MCA_PML_OB1_CUSTOM_MATCH
+static inline void append_recv_req_to_queue(mca_pml_ob1_comm_t *comm, opal_list_t *queue,
+        mca_pml_ob1_recv_request_t *req, bool lane)
 {
-    opal_list_append(queue, (opal_list_item_t*)req);
+    if (comm->prq_vector_active &&
+        OPAL_UNLIKELY(OMPI_SUCCESS != mca_pml_ob1_prq_vector_append(comm->prq_vector, req))) {
+        /* out of memory for the vector queue, go back to the lists */
+        mca_pml_ob1_comm_prq_vector_deactivate(comm);
+    }
+
+    if (!comm->prq_vector_active) {
+        opal_list_append(queue, (opal_list_item_t*)req);
+        /* from a peer lock the activation waits for the next receive posted
+         * under matching_lock, see mca_pml_ob1_comm_match_lock */
+        if (OPAL_UNLIKELY(OPAL_THREAD_ADD_FETCH_SIZE_T(&comm->posted_receives, 1) >=
+                          mca_pml_ob1.matching_vector_threshold) &&
+            MCA_PML_OB1_MATCHING_AUTO == mca_pml_ob1.matching_engine && !lane &&
+            OMPI_SUCCESS != mca_pml_ob1_comm_prq_vector_activate(comm)) {
+            /* try again once as many receives have been posted */
+            comm->posted_receives = 0;
+        }
+    }
 
 #if OMPI_WANT_PERUSE
     /**
@@ -1128,6 +1442,7 @@ static inline void append_recv_req_to_queue(opal_list_t *queue,
     }
 #endif
 }
+#endif  /* !MCA_PML_OB1_CUSTOM_MATCH */
 
 /*
  *  this routine tries to match a posted receive.  If a match is found,
@@ -1261,9 +1576,10 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
 {
     ompi_communicator_t *comm = req->req_recv.req_base.req_comm;
     mca_pml_ob1_comm_t *ob1_comm = comm->c_pml_comm;
-    mca_pml_ob1_comm_proc_t* proc;
+    mca_pml_ob1_comm_proc_t* proc = NULL;
     mca_pml_ob1_recv_frag_t* frag;
     mca_pml_ob1_hdr_t* hdr;
+    bool lane;
 #if MCA_PML_OB1_CUSTOM_MATCH
     custom_match_umq_node* hold_prev;
     custom_match_umq_node* hold_elem;
@@ -1281,10 +1597,24 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
     req->req_rdma_idx = 0;
     req->req_pending = false;
     req->req_ack_sent = false;
+    req->req_tm_handle = NULL;
 
     MCA_PML_BASE_RECV_START(&req->req_recv);
+    /* probes do not always complete, they are not accounted for */
+    if (MCA_PML_REQUEST_RECV == req->req_recv.req_base.req_type) {
+        opal_progress_async_users_increment();
+        SPC_HIST_START(&req->req_spc_start);
+    }
+#if SPC_ENABLE == 1
+    else {
+        req->req_spc_start = 0;
+    }
+#endif
 
-    OB1_MATCHING_LOCK(&ob1_comm->matching_lock);
+    if (OMPI_ANY_SOURCE != req->req_recv.req_base.req_peer) {
+        proc = mca_pml_ob1_peer_lookup (comm, req->req_recv.req_base.req_peer);
+    }
+    lane = mca_pml_ob1_comm_match_lock(ob1_comm, proc);
     /**
      * The laps of time between the ACTIVATE event and the SEARCH_UNEX one include
      * the cost of the request lock.
@@ -1292,8 +1622,14 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
     PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_SEARCH_UNEX_Q_BEGIN,
                             &(req->req_recv.req_base), PERUSE_RECV);
 
-    /* assign sequence number */
-    req->req_recv.req_base.req_sequence = ob1_comm->recv_sequence++;
+    /* assign sequence number, the receives of the other peers may be
+     * posted concurrently */
+    if (OPAL_LIKELY(!lane)) {
+        req->req_recv.req_base.req_sequence = ob1_comm->recv_sequence++;
+    } else {
+        req->req_recv.req_base.req_sequence =
+            (uint32_t) opal_atomic_fetch_add_32((opal_atomic_int32_t *) &ob1_comm->recv_sequence, 1);
+    }
 
 #if OPAL_ENABLE_FT_MPI
     /* if the communicator is not in a good state (revoked or coll_revoked), do not
@@ -1309,7 +1645,7 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
             recv_request_pml_complete( req );
             PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_SEARCH_UNEX_Q_END,
                                     &(req->req_recv.req_base), PERUSE_RECV);
-            OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+            mca_pml_ob1_comm_match_unlock(ob1_comm, proc, lane);
             return;
         }
     }
@@ -1336,7 +1672,6 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
         }
 #endif  /* !OPAL_ENABLE_HETEROGENEOUS_SUPPORT */
     } else {
-        proc = mca_pml_ob1_peer_lookup (comm, req->req_recv.req_base.req_peer);
         req->req_recv.req_base.req_proc = proc->ompi_proc;
 #if MCA_PML_OB1_CUSTOM_MATCH
         frag = recv_req_match_specific_proc(req, proc, &hold_prev, &hold_elem, &hold_index);
@@ -1360,10 +1695,12 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
                                     req->req_recv.req_base.req_tag,
                                     req->req_recv.req_base.req_peer);
 #else
-            append_recv_req_to_queue(queue, req);
+            if (!mca_pml_ob1_tm_post(req, ob1_comm, proc)) {
+                append_recv_req_to_queue(ob1_comm, queue, req, lane);
+            }
 #endif
         req->req_match_received = false;
-        OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+        mca_pml_ob1_comm_match_unlock(ob1_comm, proc, lane);
     } else {
         if(OPAL_LIKELY(!IS_PROB_REQ(req))) {
             PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_MATCH_UNEX,
@@ -1386,7 +1723,11 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
                                   (opal_list_item_t*)frag);
 #endif
             SPC_RECORD(OMPI_SPC_UNEXPECTED_IN_QUEUE, -1);
-            OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+            SPC_HIST_RECORD(OMPI_SPC_HIST_UNEXPECTED, frag->spc_queued);
+            if (MCA_PML_OB1_HDR_TYPE_MATCH == hdr->hdr_common.hdr_type) {
+                mca_pml_ob1_flow_delivered (proc);
+            }
+            mca_pml_ob1_comm_match_unlock(ob1_comm, proc, lane);
 
             switch(hdr->hdr_common.hdr_type) {
             case MCA_PML_OB1_HDR_TYPE_MATCH:
@@ -1406,6 +1747,7 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
             }
 
             MCA_PML_OB1_RECV_FRAG_RETURN(frag);
+            mca_pml_ob1_flow_return (req->req_recv.req_base.req_comm, proc);
 
         } else if (OPAL_UNLIKELY(IS_MPROB_REQ(req))) {
             /* Remove the fragment from the match list, as it's now
@@ -1422,14 +1764,18 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
                                   (opal_list_item_t*)frag);
 #endif
             SPC_RECORD(OMPI_SPC_UNEXPECTED_IN_QUEUE, -1);
-            OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+            SPC_HIST_RECORD(OMPI_SPC_HIST_UNEXPECTED, frag->spc_queued);
+            if (MCA_PML_OB1_HDR_TYPE_MATCH == frag->hdr.hdr_common.hdr_type) {
+                mca_pml_ob1_flow_delivered (proc);
+            }
+            mca_pml_ob1_comm_match_unlock(ob1_comm, proc, lane);
 
             req->req_recv.req_base.req_addr = frag;
             mca_pml_ob1_recv_request_matched_probe(req, frag->btl,
                                                    frag->segments, frag->num_segments);
 
         } else {
-            OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+            mca_pml_ob1_comm_match_unlock(ob1_comm, proc, lane);
             mca_pml_ob1_recv_request_matched_probe(req, frag->btl,
                                                    frag->segments, frag->num_segments);
         }
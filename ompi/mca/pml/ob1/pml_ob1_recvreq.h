@@ -35,7 +35,9 @@
 #include "ompi/proc/proc.h"
 #include "ompi/mca/pml/ob1/pml_ob1_comm.h"
 #include "opal/mca/mpool/base/base.h"
+#include "opal/runtime/opal_progress_threads.h"
 #include "ompi/mca/pml/base/pml_base_recvreq.h"
+#include "ompi/runtime/ompi_spc.h"
 
 BEGIN_C_DECLS
 
@@ -56,6 +58,11 @@ struct mca_pml_ob1_recv_request_t {
     opal_mutex_t lock;
     mca_bml_base_btl_t *rdma_bml;
     mca_btl_base_registration_handle_t *local_handle;
+    void *req_tm_handle;  /**< handle of the receive while posted in the network, see pml_ob1_tm.h */
+    mca_bml_base_btl_t *req_tm_bml;  /**< btl it is posted to */
+#if SPC_ENABLE == 1
+    opal_timer_t req_spc_start;  /**< start of the request for the SPC latency histogram */
+#endif
     /** The size of this array is set from mca_pml_ob1.max_rdma_per_request */
     mca_pml_ob1_com_btl_t req_rdma[];
 };
@@ -126,6 +133,7 @@ do {                                                                \
     do {                                                                              \
         PERUSE_TRACE_COMM_EVENT( PERUSE_COMM_REQ_COMPLETE,                            \
                                  &(recvreq->req_recv.req_base), PERUSE_RECV );        \
+        SPC_HIST_RECORD(OMPI_SPC_HIST_RECV, (recvreq)->req_spc_start);                \
         ompi_request_complete( &(recvreq->req_recv.req_base.req_ompi), true );        \
     } while (0)
 
@@ -161,6 +169,12 @@ recv_request_pml_complete(mca_pml_ob1_recv_request_t *recvreq)
 
     if(false == recvreq->req_recv.req_base.req_pml_complete){
 
+        if (MCA_PML_REQUEST_RECV == recvreq->req_recv.req_base.req_type) {
+            opal_progress_async_users_decrement();
+            SPC_COMM_RECORD_RECV(recvreq->req_recv.req_base.req_comm,
+                                 (ompi_spc_value_t)recvreq->req_bytes_received);
+        }
+
         if(recvreq->req_recv.req_bytes_packed > 0) {
             PERUSE_TRACE_COMM_EVENT( PERUSE_COMM_REQ_XFER_END,
                     &recvreq->req_recv.req_base, PERUSE_RECV );
@@ -321,6 +335,17 @@ void mca_pml_ob1_recv_request_progress_match(
     const mca_btl_base_segment_t* segments,
     size_t num_segments);
 
+/**
+ * Deliver a message sent to self, described by the send convertor,
+ * straight from the send buffer into the receive buffer.
+ */
+
+void mca_pml_ob1_recv_request_progress_self(
+    mca_pml_ob1_recv_request_t* req,
+    const mca_pml_ob1_match_hdr_t* hdr,
+    opal_convertor_t* convertor,
+    size_t size);
+
 /**
  *
  */
@@ -364,6 +389,17 @@ void mca_pml_ob1_recv_request_progress_rget(
     const mca_btl_base_segment_t* segments,
     size_t num_segments);
 
+/**
+ * Progress a MATCH or RNDV message matched in the network, its length
+ * payload bytes already written at the start of the receive buffer.
+ */
+
+void mca_pml_ob1_recv_request_progress_inplace(
+    mca_pml_ob1_recv_request_t* req,
+    struct mca_btl_base_module_t* btl,
+    const mca_pml_ob1_hdr_t* hdr,
+    size_t length);
+
 /**
  *
  */
@@ -409,12 +445,14 @@ static inline void mca_pml_ob1_recv_request_schedule(
     (void)mca_pml_ob1_recv_request_schedule_exclusive(req, start_bml_btl);
 }
 
-#define MCA_PML_OB1_ADD_ACK_TO_PENDING(P, S, D, O, Sz)                  \
+#define MCA_PML_OB1_ADD_ACK_TO_PENDING(P, S, D, O, Sz, F, C)            \
     do {                                                                \
         mca_pml_ob1_pckt_pending_t *_pckt;                              \
                                                                         \
         MCA_PML_OB1_PCKT_PENDING_ALLOC(_pckt);                          \
         _pckt->hdr.hdr_common.hdr_type = MCA_PML_OB1_HDR_TYPE_ACK;      \
+        _pckt->hdr.hdr_common.hdr_flags = (F);                          \
+        _pckt->hdr.hdr_ack.hdr_credits = (C);                           \
         _pckt->hdr.hdr_ack.hdr_src_req.lval = (S);                      \
         _pckt->hdr.hdr_ack.hdr_dst_req.pval = (D);                      \
         _pckt->hdr.hdr_ack.hdr_send_offset = (O);                       \
@@ -429,13 +467,13 @@ static inline void mca_pml_ob1_recv_request_schedule(
 
 int mca_pml_ob1_recv_request_ack_send_btl(ompi_proc_t* proc,
         mca_bml_base_btl_t* bml_btl, uint64_t hdr_src_req, void *hdr_dst_req,
-        uint64_t hdr_rdma_offset, uint64_t size, bool nordma);
+        uint64_t hdr_rdma_offset, uint64_t size, uint8_t hdr_flags, uint16_t credits);
 
 static inline int
 mca_pml_ob1_recv_request_ack_send(mca_btl_base_module_t* btl,
                                   ompi_proc_t* proc,
                                   uint64_t hdr_src_req, void *hdr_dst_req, uint64_t hdr_send_offset,
-                                  uint64_t size, bool nordma)
+                                  uint64_t size, uint8_t hdr_flags, uint16_t credits)
 {
     size_t i;
     mca_bml_base_btl_t* bml_btl;
@@ -452,13 +490,13 @@ mca_pml_ob1_recv_request_ack_send(mca_btl_base_module_t* btl,
         bml_btl = mca_bml_base_btl_array_get_next(&endpoint->btl_eager);
         if( (NULL == btl) || (btl == bml_btl->btl) ) {
             if(mca_pml_ob1_recv_request_ack_send_btl(proc, bml_btl, hdr_src_req,
-                                                     hdr_dst_req, hdr_send_offset, size, nordma) == OMPI_SUCCESS)
+                                                     hdr_dst_req, hdr_send_offset, size, hdr_flags, credits) == OMPI_SUCCESS)
                 return OMPI_SUCCESS;
         }
     }
 
     MCA_PML_OB1_ADD_ACK_TO_PENDING(proc, hdr_src_req, hdr_dst_req,
-                                   hdr_send_offset, size);
+                                   hdr_send_offset, size, hdr_flags, credits);
 
     return OMPI_ERR_OUT_OF_RESOURCE;
 }
@@ -38,6 +38,7 @@
 #include "pml_ob1_sendreq.h"
 #include "pml_ob1_rdmafrag.h"
 #include "pml_ob1_recvreq.h"
+#include "pml_ob1_tm.h"
 #include "ompi/mca/bml/base/base.h"
 
 OBJ_CLASS_INSTANCE(mca_pml_ob1_send_range_t, opal_free_list_item_t,
@@ -175,6 +176,9 @@ static void mca_pml_ob1_send_request_construct(mca_pml_ob1_send_request_t* req)
     req->req_rdma_cnt = 0;
     req->req_throttle_sends = false;
     req->rdma_frag = NULL;
+#if SPC_ENABLE == 1
+    req->req_spc_start = 0;
+#endif
     OBJ_CONSTRUCT(&req->req_send_ranges, opal_list_t);
     OBJ_CONSTRUCT(&req->req_send_range_lock, opal_mutex_t);
 }
@@ -571,7 +575,8 @@ int mca_pml_ob1_send_request_start_buffered(
     MCA_PML_OB1_SEND_REQUEST_MPI_COMPLETE(sendreq, true);
 
     /* send */
-    rc = mca_bml_base_send(bml_btl, des, MCA_PML_OB1_HDR_TYPE_RNDV);
+    rc = mca_pml_ob1_tm_send(sendreq, bml_btl, des, MCA_PML_OB1_HDR_TYPE_RNDV,
+                             sizeof(mca_pml_ob1_rendezvous_hdr_t));
     if( OPAL_LIKELY( rc >= 0 ) ) {
         if( OPAL_LIKELY( 1 == rc ) ) {
             mca_pml_ob1_rndv_completion_request( bml_btl, sendreq, req_bytes_delivered);
@@ -601,7 +606,7 @@ int mca_pml_ob1_send_request_start_copy( mca_pml_ob1_send_request_t* sendreq,
     size_t max_data = size;
     int rc;
 
-    if(NULL != bml_btl->btl->btl_sendi) {
+    if(NULL != bml_btl->btl->btl_sendi && !mca_pml_ob1_tm_sendreq(sendreq)) {
         mca_pml_ob1_match_hdr_t match;
         mca_pml_ob1_match_hdr_prepare (&match, MCA_PML_OB1_HDR_TYPE_MATCH, 0,
                                        sendreq->req_send.req_base.req_comm->c_contextid,
@@ -691,7 +696,8 @@ int mca_pml_ob1_send_request_start_copy( mca_pml_ob1_send_request_t* sendreq,
     des->des_cbfunc = mca_pml_ob1_match_completion_free;
 
     /* send */
-    rc = mca_bml_base_send_status(bml_btl, des, MCA_PML_OB1_HDR_TYPE_MATCH);
+    rc = mca_pml_ob1_tm_send_status(sendreq, bml_btl, des, MCA_PML_OB1_HDR_TYPE_MATCH,
+                                    OMPI_PML_OB1_MATCH_HDR_LEN);
     SPC_USER_OR_MPI(sendreq->req_send.req_base.req_ompi.req_status.MPI_TAG, (ompi_spc_value_t)size,
                     OMPI_SPC_BYTES_SENT_USER, OMPI_SPC_BYTES_SENT_MPI);
     if( OPAL_LIKELY( rc >= OPAL_SUCCESS ) ) {
@@ -753,7 +759,8 @@ int mca_pml_ob1_send_request_start_prepare( mca_pml_ob1_send_request_t* sendreq,
     des->des_cbdata = sendreq;
 
     /* send */
-    rc = mca_bml_base_send(bml_btl, des, MCA_PML_OB1_HDR_TYPE_MATCH);
+    rc = mca_pml_ob1_tm_send(sendreq, bml_btl, des, MCA_PML_OB1_HDR_TYPE_MATCH,
+                             OMPI_PML_OB1_MATCH_HDR_LEN);
     SPC_USER_OR_MPI(sendreq->req_send.req_base.req_ompi.req_status.MPI_TAG, (ompi_spc_value_t)size,
                     OMPI_SPC_BYTES_SENT_USER, OMPI_SPC_BYTES_SENT_MPI);
     if( OPAL_LIKELY( rc >= OPAL_SUCCESS ) ) {
@@ -798,6 +805,10 @@ int mca_pml_ob1_send_request_start_rdma( mca_pml_ob1_send_request_t* sendreq,
                                                     MCA_PML_OB1_HDR_FLAGS_PIN);
     }
 
+    mca_pml_ob1_event_raise (mca_pml_ob1.event_rndv_start, sendreq->req_send.req_base.req_comm,
+                             sendreq->req_send.req_base.req_peer, sendreq->req_send.req_base.req_tag,
+                             sendreq->req_send.req_bytes_packed);
+
     /* at this time ob1 does not support non-contiguous gets. the convertor represents a
      * contiguous block of memory */
     opal_convertor_get_current_pointer (&sendreq->req_send.req_base.req_convertor, &data_ptr);
@@ -860,7 +871,9 @@ int mca_pml_ob1_send_request_start_rdma( mca_pml_ob1_send_request_t* sendreq,
     }
 
     /* send */
-    rc = mca_bml_base_send(bml_btl, des, MCA_PML_OB1_HDR_TYPE_RGET);
+    /* the segment list of the receiver is part of the header */
+    rc = mca_pml_ob1_tm_send(sendreq, bml_btl, des, MCA_PML_OB1_HDR_TYPE_RGET,
+                             des->des_segments->seg_len);
     if (OPAL_UNLIKELY(rc < 0)) {
         MCA_PML_OB1_RDMA_FRAG_RETURN(frag);
         sendreq->rdma_frag = NULL;
@@ -872,6 +885,146 @@ int mca_pml_ob1_send_request_start_rdma( mca_pml_ob1_send_request_t* sendreq,
 }
 
 
+/**
+ *  The buffer is not contiguous but it is made of a few large blocks:
+ *  register their span and let the receiver get the blocks directly.
+ */
+
+int mca_pml_ob1_send_request_start_rdma_iov (mca_pml_ob1_send_request_t *sendreq)
+{
+    mca_bml_base_endpoint_t *bml_endpoint = sendreq->req_endpoint;
+    struct iovec iov[MCA_PML_OB1_RDMA_IOV_MAX];
+    mca_btl_base_registration_handle_t *local_handle = NULL;
+    mca_bml_base_btl_t *bml_btl = NULL;
+    mca_pml_ob1_rget_iov_hdr_t iov_hdr;
+    mca_btl_base_descriptor_t *des;
+    mca_pml_ob1_rdma_frag_t *frag;
+    mca_pml_ob1_rget_hdr_t *hdr;
+    unsigned char *base, *segments;
+    size_t reg_size, span, hdr_size;
+    uint32_t iov_count;
+    int num_btls, num_eager_btls, rc;
+
+    if (0 == mca_pml_ob1.max_rdma_per_request ||
+        OMPI_SUCCESS != mca_pml_ob1_rdma_iov_build (&sendreq->req_send.req_base.req_convertor,
+                                                    iov, &iov_count, &base, &span)) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    /* find a btl that can get from this peer, as mca_pml_ob1_rdma_btls does */
+    num_btls = mca_bml_base_btl_array_get_size (&bml_endpoint->btl_rdma);
+    num_eager_btls = mca_bml_base_btl_array_get_size (&bml_endpoint->btl_eager);
+    for (int n = 0 ; n < num_btls && NULL == bml_btl ; ++n) {
+        mca_bml_base_btl_t *rdma_btl = mca_bml_base_btl_array_get_index (&bml_endpoint->btl_rdma, n);
+        bool ignore = !mca_pml_ob1.use_all_rdma;
+
+        if (!(rdma_btl->btl_flags & MCA_BTL_FLAGS_GET)) {
+            continue;
+        }
+
+        for (int i = 0 ; i < num_eager_btls && ignore ; ++i) {
+            mca_bml_base_btl_t *eager_btl = mca_bml_base_btl_array_get_index (&bml_endpoint->btl_eager, i);
+            if (eager_btl->btl_endpoint == rdma_btl->btl_endpoint) {
+                ignore = false;
+            }
+        }
+
+        if (!ignore) {
+            bml_btl = rdma_btl;
+        }
+    }
+
+    if (NULL == bml_btl) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    reg_size = bml_btl->btl->btl_registration_handle_size;
+    hdr_size = sizeof (*hdr) + reg_size + sizeof (iov_hdr) + iov_count * sizeof (mca_pml_ob1_rget_iov_seg_t);
+    if (hdr_size > bml_btl->btl->btl_eager_limit) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    /* a single registration covers all the segments */
+    if (bml_btl->btl->btl_register_mem) {
+        local_handle = bml_btl->btl->btl_register_mem (bml_btl->btl, bml_btl->btl_endpoint, base,
+                                                       span, MCA_BTL_REG_FLAG_REMOTE_READ);
+        if (NULL == local_handle) {
+            return OMPI_ERR_NOT_SUPPORTED;
+        }
+    }
+
+    /* released by mca_pml_ob1_free_rdma_resources */
+    sendreq->req_rdma[0].bml_btl = bml_btl;
+    sendreq->req_rdma[0].btl_reg = local_handle;
+    sendreq->req_rdma_cnt = 1;
+
+    MCA_PML_OB1_RDMA_FRAG_ALLOC(frag);
+    if (OPAL_UNLIKELY(NULL == frag)) {
+        mca_pml_ob1_free_rdma_resources (sendreq);
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    frag->rdma_req = sendreq;
+    frag->rdma_bml = bml_btl;
+    frag->rdma_length = sendreq->req_send.req_bytes_packed;
+    frag->rdma_bytes_remaining = frag->rdma_length;
+    frag->cbfunc = mca_pml_ob1_rget_completion;
+
+    mca_bml_base_alloc (bml_btl, &des, MCA_BTL_NO_ORDER, hdr_size,
+                        MCA_BTL_DES_FLAGS_PRIORITY | MCA_BTL_DES_FLAGS_BTL_OWNERSHIP |
+                        MCA_BTL_DES_FLAGS_SIGNAL);
+    if (OPAL_UNLIKELY(NULL == des)) {
+        MCA_PML_OB1_RDMA_FRAG_RETURN(frag);
+        mca_pml_ob1_free_rdma_resources (sendreq);
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* save the fragment for the fallback on send */
+    sendreq->rdma_frag = frag;
+
+    hdr = (mca_pml_ob1_rget_hdr_t *) des->des_segments->seg_addr.pval;
+    mca_pml_ob1_rget_hdr_prepare (hdr, MCA_PML_OB1_HDR_FLAGS_IOV | MCA_PML_OB1_HDR_FLAGS_PIN,
+                                  sendreq->req_send.req_base.req_comm->c_contextid,
+                                  sendreq->req_send.req_base.req_comm->c_my_rank,
+                                  sendreq->req_send.req_base.req_tag,
+                                  (uint16_t)sendreq->req_send.req_base.req_sequence,
+                                  sendreq->req_send.req_bytes_packed, sendreq,
+                                  frag, base, local_handle, reg_size);
+
+    /* the segment list follows the registration handle, it may not be aligned */
+    segments = (unsigned char *) (hdr + 1) + reg_size;
+    iov_hdr.hdr_seg_count = iov_count;
+    iov_hdr.hdr_padding = 0;
+    memcpy (segments, &iov_hdr, sizeof (iov_hdr));
+    segments += sizeof (iov_hdr);
+    for (uint32_t i = 0 ; i < iov_count ; ++i) {
+        mca_pml_ob1_rget_iov_seg_t seg = {.seg_addr = (uint64_t) (intptr_t) iov[i].iov_base,
+                                          .seg_len = iov[i].iov_len};
+        memcpy (segments, &seg, sizeof (seg));
+        segments += sizeof (seg);
+    }
+
+    ob1_hdr_hton(hdr, MCA_PML_OB1_HDR_TYPE_RGET, sendreq->req_send.req_base.req_proc);
+
+    des->des_cbfunc = mca_pml_ob1_send_ctl_completion;
+    des->des_cbdata = sendreq;
+
+    PERUSE_TRACE_COMM_EVENT( PERUSE_COMM_REQ_XFER_BEGIN,
+                             &(sendreq->req_send.req_base), PERUSE_SEND );
+
+    rc = mca_pml_ob1_tm_send(sendreq, bml_btl, des, MCA_PML_OB1_HDR_TYPE_RGET,
+                             des->des_segments->seg_len);
+    if (OPAL_UNLIKELY(rc < 0)) {
+        MCA_PML_OB1_RDMA_FRAG_RETURN(frag);
+        sendreq->rdma_frag = NULL;
+        mca_bml_base_free(bml_btl, des);
+        mca_pml_ob1_free_rdma_resources (sendreq);
+        return rc;
+    }
+
+    return OMPI_SUCCESS;
+}
+
 /**
  *  Rendezvous is required. Not doing rdma so eager send up to
  *  the btls eager limit.
@@ -887,6 +1040,10 @@ int mca_pml_ob1_send_request_start_rndv( mca_pml_ob1_send_request_t* sendreq,
     mca_pml_ob1_hdr_t* hdr;
     int rc;
 
+    mca_pml_ob1_event_raise (mca_pml_ob1.event_rndv_start, sendreq->req_send.req_base.req_comm,
+                             sendreq->req_send.req_base.req_peer, sendreq->req_send.req_base.req_tag,
+                             sendreq->req_send.req_bytes_packed);
+
     /* prepare descriptor */
     if(size == 0) {
         mca_bml_base_alloc( bml_btl,
@@ -942,7 +1099,8 @@ int mca_pml_ob1_send_request_start_rndv( mca_pml_ob1_send_request_t* sendreq,
     sendreq->req_state = 2;
 
     /* send */
-    rc = mca_bml_base_send(bml_btl, des, MCA_PML_OB1_HDR_TYPE_RNDV);
+    rc = mca_pml_ob1_tm_send(sendreq, bml_btl, des, MCA_PML_OB1_HDR_TYPE_RNDV,
+                             sizeof(mca_pml_ob1_rendezvous_hdr_t));
     if( OPAL_LIKELY( rc >= 0 ) ) {
         if( OPAL_LIKELY( 1 == rc ) ) {
             mca_pml_ob1_rndv_completion_request( bml_btl, sendreq, size );
@@ -1257,6 +1415,10 @@ static void mca_pml_ob1_put_completion (mca_btl_base_module_t* btl, struct mca_b
                               frag->rdma_hdr.hdr_rdma.hdr_frag, frag->rdma_length,
                               0, 0);
 
+        mca_pml_ob1_event_raise (mca_pml_ob1.event_rdma_complete, sendreq->req_send.req_base.req_comm,
+                                 sendreq->req_send.req_base.req_peer, sendreq->req_send.req_base.req_tag,
+                                 frag->rdma_length);
+
         /* check for request completion */
         OPAL_THREAD_ADD_FETCH_SIZE_T(&sendreq->req_bytes_delivered, frag->rdma_length);
         SPC_USER_OR_MPI(sendreq->req_send.req_base.req_ompi.req_status.MPI_TAG, (ompi_spc_value_t)frag->rdma_length,
@@ -27,13 +27,18 @@
 
 #include "opal/datatype/opal_convertor.h"
 #include "opal/mca/mpool/base/base.h"
+#include "opal/mca/timer/base/base.h"
+#include "opal/runtime/opal_progress_threads.h"
 #include "ompi/mca/pml/base/pml_base_sendreq.h"
+#include "pml_ob1_adapt.h"
+#include "pml_ob1_flow.h"
 #include "pml_ob1_comm.h"
 #include "pml_ob1_hdr.h"
 #include "pml_ob1_rdma.h"
 #include "pml_ob1_rdmafrag.h"
 #include "ompi/mca/bml/bml.h"
 #include "ompi/memchecker.h"
+#include "ompi/runtime/ompi_spc.h"
 
 BEGIN_C_DECLS
 
@@ -57,6 +62,10 @@ struct mca_pml_ob1_send_request_t {
     opal_mutex_t req_send_range_lock;
     opal_list_t req_send_ranges;
     mca_pml_ob1_rdma_frag_t *rdma_frag;
+    uint64_t req_adapt_start;    /**< start of a rendezvous for the per peer bandwidth (usec), 0 if not timed */
+#if SPC_ENABLE == 1
+    opal_timer_t req_spc_start;  /**< start of the request for the SPC latency histogram */
+#endif
     /** The size of this array is set from mca_pml_ob1.max_rdma_per_request */
     mca_pml_ob1_com_btl_t req_rdma[];
 };
@@ -208,6 +217,7 @@ do {
         (sendreq)->req_send.req_bytes_packed;                                        \
    PERUSE_TRACE_COMM_EVENT( PERUSE_COMM_REQ_COMPLETE,                                \
                             &(sendreq->req_send.req_base), PERUSE_SEND);             \
+   SPC_HIST_RECORD(OMPI_SPC_HIST_SEND, (sendreq)->req_spc_start);                    \
                                                                                      \
    ompi_request_complete( &((sendreq)->req_send.req_base.req_ompi), (with_signal) ); \
 } while(0)
@@ -254,6 +264,12 @@ static inline void
 send_request_pml_complete(mca_pml_ob1_send_request_t *sendreq)
 {
     if(false == sendreq->req_send.req_base.req_pml_complete) {
+        opal_progress_async_users_decrement();
+
+        if (0 != sendreq->req_adapt_start) {
+            mca_pml_ob1_adapt_complete (sendreq);
+        }
+
         if(sendreq->req_send.req_bytes_packed > 0) {
             PERUSE_TRACE_COMM_EVENT( PERUSE_COMM_REQ_XFER_END,
                                      &(sendreq->req_send.req_base), PERUSE_SEND);
@@ -377,6 +393,10 @@ int mca_pml_ob1_send_request_start_rdma(
     mca_bml_base_btl_t* bml_btl,
     size_t size);
 
+/* returns OMPI_ERR_NOT_SUPPORTED if the buffer does not qualify */
+int mca_pml_ob1_send_request_start_rdma_iov(
+    mca_pml_ob1_send_request_t* sendreq);
+
 int mca_pml_ob1_send_request_start_rndv(
     mca_pml_ob1_send_request_t* sendreq,
     mca_bml_base_btl_t* bml_btl,
@@ -395,10 +415,25 @@ mca_pml_ob1_send_request_start_btl( mca_pml_ob1_send_request_t* sendreq,
 #if OPAL_CUDA_GDR_SUPPORT
     if (btl->btl_cuda_eager_limit && (sendreq->req_send.req_base.req_convertor.flags & CONVERTOR_CUDA)) {
         eager_limit = btl->btl_cuda_eager_limit - sizeof(mca_pml_ob1_hdr_t);
+    } else {
+#endif /* OPAL_CUDA_GDR_SUPPORT */
+        eager_limit = mca_pml_ob1_adapt_eager_limit (sendreq->req_send.req_base.req_comm,
+                                                     sendreq->req_send.req_base.req_peer, eager_limit);
+#if OPAL_CUDA_GDR_SUPPORT
     }
 #endif /* OPAL_CUDA_GDR_SUPPORT */
 
     if( OPAL_LIKELY(size <= eager_limit) ) {
+        if (OPAL_UNLIKELY(MCA_PML_BASE_SEND_SYNCHRONOUS != sendreq->req_send.req_send_mode &&
+                          !mca_pml_ob1_flow_take (sendreq->req_send.req_base.req_comm,
+                                                  sendreq->req_send.req_base.req_peer))) {
+            /* out of eager credits for the peer, let the receiver pull the data */
+            if (MCA_PML_BASE_SEND_BUFFERED == sendreq->req_send.req_send_mode) {
+                return mca_pml_ob1_send_request_start_buffered(sendreq, bml_btl, 0);
+            }
+            return mca_pml_ob1_send_request_start_rndv(sendreq, bml_btl, 0, 0);
+        }
+
         switch(sendreq->req_send.req_send_mode) {
         case MCA_PML_BASE_SEND_SYNCHRONOUS:
             rc = mca_pml_ob1_send_request_start_rndv(sendreq, bml_btl, size, 0);
@@ -417,7 +452,15 @@ mca_pml_ob1_send_request_start_btl( mca_pml_ob1_send_request_t* sendreq,
             }
             break;
         }
+
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != rc && MCA_PML_BASE_SEND_SYNCHRONOUS != sendreq->req_send.req_send_mode)) {
+            /* the send is retried later and takes a credit again */
+            mca_pml_ob1_flow_untake (sendreq->req_send.req_base.req_comm, sendreq->req_send.req_base.req_peer);
+        }
     } else {
+        if (mca_pml_ob1.adaptive_eager) {
+            sendreq->req_adapt_start = opal_timer_base_get_usec ();
+        }
         size = eager_limit;
         if(OPAL_UNLIKELY(btl->btl_rndv_eager_limit < eager_limit))
             size = btl->btl_rndv_eager_limit;
@@ -448,7 +491,10 @@ mca_pml_ob1_send_request_start_btl( mca_pml_ob1_send_request_t* sendreq,
                 return mca_pml_ob1_send_request_start_cuda(sendreq, bml_btl, size);
             }
 #endif /* OPAL_CUDA_SUPPORT */
-            rc = mca_pml_ob1_send_request_start_rndv(sendreq, bml_btl, size, 0);
+            rc = mca_pml_ob1_send_request_start_rdma_iov(sendreq);
+            if (OMPI_ERR_NOT_SUPPORTED == rc) {
+                rc = mca_pml_ob1_send_request_start_rndv(sendreq, bml_btl, size, 0);
+            }
         }
     }
 
@@ -464,9 +510,14 @@ mca_pml_ob1_send_request_start_seq (mca_pml_ob1_send_request_t* sendreq, mca_bml
     sendreq->req_pipeline_depth = 0;
     sendreq->req_bytes_delivered = 0;
     sendreq->req_pending = MCA_PML_OB1_SEND_PENDING_NONE;
+    sendreq->req_adapt_start = 0;
     sendreq->req_send.req_base.req_sequence = seqn;
 
     MCA_PML_BASE_SEND_START( &sendreq->req_send );
+    opal_progress_async_users_increment();
+    SPC_COMM_RECORD_SEND(sendreq->req_send.req_base.req_comm, sendreq->req_send.req_base.req_peer,
+                         (ompi_spc_value_t)sendreq->req_send.req_bytes_packed);
+    SPC_HIST_START(&sendreq->req_spc_start);
 
     for(size_t i = 0; i < mca_bml_base_btl_array_get_size(&endpoint->btl_eager); i++) {
         mca_bml_base_btl_t* bml_btl;
@@ -0,0 +1,142 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "opal/datatype/opal_convertor.h"
+#include "ompi/communicator/communicator.h"
+
+#include "pml_ob1.h"
+#include "pml_ob1_adapt.h"
+#include "pml_ob1_flow.h"
+#include "pml_ob1_hdr.h"
+#include "pml_ob1_recvreq.h"
+#include "pml_ob1_tm.h"
+
+static void mca_pml_ob1_tm_completion (mca_btl_base_module_t *btl, struct mca_btl_base_endpoint_t *endpoint,
+                                       const void *header, size_t header_size, size_t length,
+                                       void *cbcontext, void *cbdata, int status)
+{
+    mca_pml_ob1_recv_request_t *recvreq = (mca_pml_ob1_recv_request_t *) cbcontext;
+    ompi_communicator_t *comm = recvreq->req_recv.req_base.req_comm;
+    mca_pml_ob1_comm_t *ob1_comm = comm->c_pml_comm;
+    mca_pml_ob1_hdr_t *hdr = (mca_pml_ob1_hdr_t *) header;
+    mca_btl_base_segment_t segment = {.seg_addr.pval = (void *) header, .seg_len = header_size};
+    mca_pml_ob1_comm_proc_t *proc;
+    bool lane;
+
+    ob1_hdr_ntoh (hdr, hdr->hdr_common.hdr_type);
+    proc = mca_pml_ob1_peer_lookup (comm, hdr->hdr_match.hdr_src);
+
+    /* the btl delivers the messages of the peer in order, this one is next */
+    lane = mca_pml_ob1_comm_match_lock (ob1_comm, proc);
+    assert ((uint16_t) hdr->hdr_match.hdr_seq == (uint16_t) proc->expected_sequence ||
+            OMPI_COMM_CHECK_ASSERT_ALLOW_OVERTAKE(comm));
+    proc->expected_sequence++;
+    recvreq->req_tm_handle = NULL;
+    mca_pml_ob1_adapt_arrival (proc, false);
+    if (MCA_PML_OB1_HDR_TYPE_MATCH == hdr->hdr_common.hdr_type) {
+        mca_pml_ob1_flow_delivered (proc);
+    }
+    mca_pml_ob1_comm_match_unlock (ob1_comm, proc, lane);
+
+    if (OPAL_UNLIKELY(OPAL_SUCCESS != status && OPAL_ERR_TRUNCATE != status)) {
+        /* a truncation is reported the usual way, from the lengths */
+        recvreq->req_recv.req_base.req_ompi.req_status.MPI_ERROR = MPI_ERR_INTERN;
+    }
+
+    switch (hdr->hdr_common.hdr_type) {
+    case MCA_PML_OB1_HDR_TYPE_MATCH:
+    case MCA_PML_OB1_HDR_TYPE_RNDV:
+        mca_pml_ob1_recv_request_progress_inplace (recvreq, btl, hdr, length);
+        break;
+    case MCA_PML_OB1_HDR_TYPE_RGET:
+        mca_pml_ob1_recv_request_progress_rget (recvreq, btl, &segment, 1);
+        break;
+    default:
+        assert (0);
+    }
+
+    mca_pml_ob1_flow_return (comm, proc);
+}
+
+bool mca_pml_ob1_tm_post (mca_pml_ob1_recv_request_t *recvreq, mca_pml_ob1_comm_t *ob1_comm,
+                          mca_pml_ob1_comm_proc_t *proc)
+{
+    opal_convertor_t *convertor = &recvreq->req_recv.req_base.req_convertor;
+    ompi_communicator_t *comm = recvreq->req_recv.req_base.req_comm;
+    int peer = recvreq->req_recv.req_base.req_peer, tag = recvreq->req_recv.req_base.req_tag;
+    mca_bml_base_endpoint_t *endpoint;
+    mca_bml_base_btl_t *bml_btl;
+    void *base = NULL;
+    int rc;
+
+    if (!mca_pml_ob1.tag_matching || MCA_PML_REQUEST_RECV != recvreq->req_recv.req_base.req_type ||
+        OMPI_ANY_SOURCE == peer || !mca_pml_ob1_tm_eligible (peer, tag)) {
+        return false;
+    }
+
+#if MCA_PML_OB1_CUSTOM_MATCH
+    (void) ob1_comm;
+    (void) proc;
+    return false;
+#else
+    /* a receive matched in software could match the messages first */
+    if (ob1_comm->prq_vector_active || 0 != opal_list_get_size (&ob1_comm->wild_receives) ||
+        0 != opal_list_get_size (&proc->specific_receives)) {
+        return false;
+    }
+
+    endpoint = mca_bml_base_get_endpoint (proc->ompi_proc);
+    if (NULL == endpoint || !mca_pml_ob1_tm_endpoint (endpoint)) {
+        return false;
+    }
+
+    if (0 != recvreq->req_bytes_expected) {
+        if (opal_convertor_need_buffers (convertor)) {
+            return false;
+        }
+#if OPAL_CUDA_SUPPORT
+        if (convertor->flags & CONVERTOR_CUDA) {
+            return false;
+        }
+#endif /* OPAL_CUDA_SUPPORT */
+        opal_convertor_get_current_pointer (convertor, &base);
+    }
+
+    bml_btl = mca_bml_base_btl_array_get_index (&endpoint->btl_eager, 0);
+    rc = bml_btl->btl->btl_tm_post (bml_btl->btl, bml_btl->btl_endpoint,
+                                    mca_pml_ob1_tm_tag (comm->c_contextid, peer, tag), base,
+                                    recvreq->req_bytes_expected, NULL, mca_pml_ob1_tm_completion,
+                                    recvreq, NULL, &recvreq->req_tm_handle);
+    if (OPAL_SUCCESS != rc) {
+        /* busy delivering unexpected messages, or out of matching entries */
+        recvreq->req_tm_handle = NULL;
+        return false;
+    }
+
+    recvreq->req_tm_bml = bml_btl;
+    return true;
+#endif
+}
+
+bool mca_pml_ob1_tm_cancel (mca_pml_ob1_recv_request_t *recvreq)
+{
+    mca_bml_base_btl_t *bml_btl = recvreq->req_tm_bml;
+
+    if (OPAL_SUCCESS != bml_btl->btl->btl_tm_cancel (bml_btl->btl, recvreq->req_tm_handle)) {
+        return false;
+    }
+
+    recvreq->req_tm_handle = NULL;
+    return true;
+}
@@ -0,0 +1,134 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Matching in the network (MCA_BTL_FLAGS_TAG_MATCHING).
+ *
+ * When pml_ob1_tag_matching is set and the only eager btl to a peer can
+ * match in the network, the first fragment (MATCH, RNDV or RGET) of every
+ * message to the peer with a tag between 0 and MCA_PML_OB1_TM_TAG_MAX goes
+ * through btl_tm_send, tagged with the context, the source and the tag of
+ * the message. The receiver posts the specific receives of such a peer with
+ * btl_tm_post when their buffer is contiguous and no other receive could
+ * match first: no wildcard receive on the communicator and no receive of
+ * the peer in the software queues. The messages that match in the network
+ * land in the receive buffer, with the ob1 header given to
+ * mca_pml_ob1_tm_completion, rendezvous continue with the usual protocols.
+ * The others reach the usual receive callbacks and are matched in software.
+ *
+ * Both sides must select the same btl for each other, and set the same
+ * pml_ob1_tag_matching. The sendi and coalescing paths are not used for
+ * the tagged messages.
+ */
+#ifndef MCA_PML_OB1_TM_H
+#define MCA_PML_OB1_TM_H
+
+#include "ompi_config.h"
+
+#include "opal/mca/btl/btl.h"
+#include "ompi/mca/bml/bml.h"
+
+#include "pml_ob1.h"
+#include "pml_ob1_comm.h"
+#include "pml_ob1_sendreq.h"
+
+BEGIN_C_DECLS
+
+/* largest tag and source rank matched in the network */
+#define MCA_PML_OB1_TM_TAG_MAX  0xffffff
+#define MCA_PML_OB1_TM_RANK_MAX 0xffffff
+
+struct mca_pml_ob1_recv_request_t;
+
+/**
+ * Whether the messages to or from the peer of endpoint are matched in the
+ * network.
+ */
+static inline bool mca_pml_ob1_tm_endpoint (mca_bml_base_endpoint_t *endpoint)
+{
+    return mca_pml_ob1.tag_matching && 1 == mca_bml_base_btl_array_get_size (&endpoint->btl_eager) &&
+        (endpoint->btl_eager.bml_btls[0].btl->btl_flags & MCA_BTL_FLAGS_TAG_MATCHING);
+}
+
+static inline bool mca_pml_ob1_tm_eligible (int src, int tag)
+{
+    return 0 <= tag && tag <= MCA_PML_OB1_TM_TAG_MAX && 0 <= src && src <= MCA_PML_OB1_TM_RANK_MAX;
+}
+
+static inline uint64_t mca_pml_ob1_tm_tag (uint32_t ctx, int src, int tag)
+{
+    return ((uint64_t) (ctx & 0xffff) << 48) | ((uint64_t) src << 24) | (uint64_t) tag;
+}
+
+/**
+ * Whether the first fragment of sendreq goes through btl_tm_send.
+ */
+static inline bool mca_pml_ob1_tm_sendreq (mca_pml_ob1_send_request_t *sendreq)
+{
+    return mca_pml_ob1_tm_endpoint (sendreq->req_endpoint) &&
+        mca_pml_ob1_tm_eligible (sendreq->req_send.req_base.req_comm->c_my_rank,
+                                 sendreq->req_send.req_base.req_tag);
+}
+
+/**
+ * Send the first fragment of sendreq, header_size being the size of its ob1
+ * header. Same return values as mca_bml_base_send_status.
+ */
+static inline int mca_pml_ob1_tm_send_status (mca_pml_ob1_send_request_t *sendreq, mca_bml_base_btl_t *bml_btl,
+                                              mca_btl_base_descriptor_t *des, mca_btl_base_tag_t tag,
+                                              size_t header_size)
+{
+    mca_btl_base_module_t *btl = bml_btl->btl;
+    ompi_communicator_t *comm = sendreq->req_send.req_base.req_comm;
+
+    if (OPAL_LIKELY(!mca_pml_ob1_tm_sendreq (sendreq))) {
+        return mca_bml_base_send_status (bml_btl, des, tag);
+    }
+
+    des->des_context = (void *) bml_btl;
+    return btl->btl_tm_send (btl, bml_btl->btl_endpoint, des, tag,
+                             mca_pml_ob1_tm_tag (comm->c_contextid, comm->c_my_rank,
+                                                 sendreq->req_send.req_base.req_tag),
+                             header_size);
+}
+
+/**
+ * Same as mca_pml_ob1_tm_send_status, with the return values of
+ * mca_bml_base_send.
+ */
+static inline int mca_pml_ob1_tm_send (mca_pml_ob1_send_request_t *sendreq, mca_bml_base_btl_t *bml_btl,
+                                       mca_btl_base_descriptor_t *des, mca_btl_base_tag_t tag,
+                                       size_t header_size)
+{
+    int rc = mca_pml_ob1_tm_send_status (sendreq, bml_btl, des, tag, header_size);
+
+    return (OMPI_ERR_RESOURCE_BUSY == rc) ? OMPI_SUCCESS : rc;
+}
+
+/**
+ * Post recvreq in the network. Called with the matching lock of proc held,
+ * after the unexpected fragments were searched. Returns false if the
+ * request has to be queued in software.
+ */
+bool mca_pml_ob1_tm_post (struct mca_pml_ob1_recv_request_t *recvreq, mca_pml_ob1_comm_t *ob1_comm,
+                          mca_pml_ob1_comm_proc_t *proc);
+
+/**
+ * Cancel a request posted in the network. Called with the matching lock
+ * held. Returns false if the request matched in the network already.
+ */
+bool mca_pml_ob1_tm_cancel (struct mca_pml_ob1_recv_request_t *recvreq);
+
+END_C_DECLS
+
+#endif
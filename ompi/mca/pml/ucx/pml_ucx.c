@@ -1,6 +1,6 @@
 /*
  * Copyright (C) 2001-2011 Mellanox Technologies Ltd. 2001-2011.  ALL RIGHTS RESERVED.
- * Copyright (c) 2016-2020 The University of Tennessee and The University
+ * Copyright (c) 2016-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2018-2019 Research Organization for Information Science
@@ -17,6 +17,8 @@
 #include "pml_ucx.h"
 
 #include "opal/runtime/opal.h"
+#include "opal/mca/threads/thread_usage.h"
+#include "opal/util/printf.h"
 #include "opal/mca/pmix/pmix-internal.h"
 #include "ompi/attribute/attribute.h"
 #include "ompi/message/message.h"
@@ -82,9 +84,16 @@ mca_pml_ucx_module_t ompi_pml_ucx = {
         .pml_flags         = 0 /* flags */
     },
     .ucp_context           = NULL,
-    .ucp_worker            = NULL
+    .ucp_worker            = NULL,
+    .workers               = NULL,
+    .num_workers           = 1
 };
 
+#if OPAL_HAVE_THREAD_LOCAL
+/* The worker this thread posted to last, progressed first */
+static opal_thread_local int mca_pml_ucx_thread_worker = 0;
+#endif
+
 #define PML_UCX_REQ_ALLOCA() \
     ((char *)alloca(ompi_pml_ucx.request_size) + ompi_pml_ucx.request_size);
 
@@ -187,6 +196,94 @@ static int mca_pml_ucx_recv_worker_address(ompi_proc_t *proc,
     return ret;
 }
 
+/* The workers but the first publish their full address under this key */
+static char *mca_pml_ucx_worker_modex_key(int index)
+{
+    char *key = NULL;
+
+    (void)opal_asprintf(&key, "%s.%d", MODEX_KEY, index);
+    return key;
+}
+
+static int mca_pml_ucx_send_workers_address(void)
+{
+    ucp_address_t *address;
+    ucs_status_t status;
+    size_t addrlen;
+    char *key;
+    int i, rc;
+
+    for (i = 1; i < ompi_pml_ucx.num_workers; ++i) {
+        status = ucp_worker_get_address(ompi_pml_ucx.workers[i].ucp_worker,
+                                        &address, &addrlen);
+        if (UCS_OK != status) {
+            PML_UCX_ERROR("Failed to get the address of worker %d", i);
+            return OMPI_ERROR;
+        }
+
+        key = mca_pml_ucx_worker_modex_key(i);
+        if (NULL == key) {
+            rc = OMPI_ERR_OUT_OF_RESOURCE;
+        } else {
+            OPAL_MODEX_SEND_STRING(rc, PMIX_GLOBAL, key, (void*)address, addrlen);
+            free(key);
+        }
+        ucp_worker_release_address(ompi_pml_ucx.workers[i].ucp_worker, address);
+        if (OMPI_SUCCESS != rc) {
+            PML_UCX_ERROR("Open MPI couldn't distribute EP connection details");
+            return OMPI_ERROR;
+        }
+
+        PML_UCX_VERBOSE(2, "Pack worker %d address, size %ld", i, addrlen);
+    }
+
+    return OMPI_SUCCESS;
+}
+
+/* Connect worker to the worker of the same index of proc */
+static ucp_ep_h mca_pml_ucx_worker_connect(mca_pml_ucx_worker_t *worker,
+                                           ompi_proc_t *proc)
+{
+    ucp_ep_params_t ep_params;
+    ucp_address_t *address;
+    ucs_status_t status;
+    size_t addrlen;
+    ucp_ep_h ep;
+    char *key;
+    int ret;
+
+    key = mca_pml_ucx_worker_modex_key(worker->index);
+    if (NULL == key) {
+        return NULL;
+    }
+    OPAL_MODEX_RECV_STRING(ret, key, &proc->super.proc_name,
+                           (uint8_t**)&address, &addrlen);
+    free(key);
+    if (ret < 0) {
+        PML_UCX_ERROR("Failed to receive UCX worker %d address of proc %d: %s (%d)",
+                      worker->index, proc->super.proc_name.vpid,
+                      opal_strerror(ret), ret);
+        return NULL;
+    }
+
+    PML_UCX_VERBOSE(2, "connecting worker %d to proc. %d", worker->index,
+                    proc->super.proc_name.vpid);
+
+    ep_params.field_mask = UCP_EP_PARAM_FIELD_REMOTE_ADDRESS;
+    ep_params.address    = address;
+
+    status = ucp_ep_create(worker->ucp_worker, &ep_params, &ep);
+    free(address);
+    if (UCS_OK != status) {
+        PML_UCX_ERROR("ucp_ep_create(worker=%d, proc=%d) failed: %s",
+                      worker->index, proc->super.proc_name.vpid,
+                      ucs_status_string(status));
+        return NULL;
+    }
+
+    return ep;
+}
+
 int mca_pml_ucx_open(void)
 {
     unsigned major_version, minor_version, release_number;
@@ -282,6 +379,27 @@ int mca_pml_ucx_close(void)
     return OMPI_SUCCESS;
 }
 
+/* Destroy the workers but the first */
+static void mca_pml_ucx_destroy_workers(void)
+{
+    int i;
+
+    if (NULL == ompi_pml_ucx.workers) {
+        return;
+    }
+
+    for (i = 0; i < ompi_pml_ucx.num_workers; ++i) {
+        if ((0 != i) && (NULL != ompi_pml_ucx.workers[i].ucp_worker)) {
+            ucp_worker_destroy(ompi_pml_ucx.workers[i].ucp_worker);
+        }
+        OBJ_DESTRUCT(&ompi_pml_ucx.workers[i].eps);
+        OBJ_DESTRUCT(&ompi_pml_ucx.workers[i].lock);
+    }
+    free(ompi_pml_ucx.workers);
+    ompi_pml_ucx.workers     = NULL;
+    ompi_pml_ucx.num_workers = 1;
+}
+
 int mca_pml_ucx_init(int enable_mpi_threads)
 {
     ucp_worker_params_t params;
@@ -336,6 +454,40 @@ int mca_pml_ucx_init(int enable_mpi_threads)
         goto err_destroy_worker;
     }
 
+    if (ompi_pml_ucx.num_workers < 1) {
+        ompi_pml_ucx.num_workers = 1;
+    }
+    ompi_pml_ucx.workers = calloc(ompi_pml_ucx.num_workers,
+                                  sizeof(*ompi_pml_ucx.workers));
+    if (NULL == ompi_pml_ucx.workers) {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+        goto err_destroy_worker;
+    }
+    for (i = 0; i < ompi_pml_ucx.num_workers; ++i) {
+        ompi_pml_ucx.workers[i].index = i;
+        OBJ_CONSTRUCT(&ompi_pml_ucx.workers[i].eps, opal_hash_table_t);
+        OBJ_CONSTRUCT(&ompi_pml_ucx.workers[i].lock, opal_mutex_t);
+        if (0 == i) {
+            ompi_pml_ucx.workers[i].ucp_worker = ompi_pml_ucx.ucp_worker;
+            continue;
+        }
+
+        opal_hash_table_init(&ompi_pml_ucx.workers[i].eps, 32);
+        status = ucp_worker_create(ompi_pml_ucx.ucp_context, &params,
+                                   &ompi_pml_ucx.workers[i].ucp_worker);
+        if (UCS_OK != status) {
+            PML_UCX_ERROR("Failed to create UCP worker %d", i);
+            ompi_pml_ucx.num_workers = i + 1;
+            rc = OMPI_ERROR;
+            goto err_destroy_workers;
+        }
+    }
+
+    rc = mca_pml_ucx_send_workers_address();
+    if (rc < 0) {
+        goto err_destroy_workers;
+    }
+
     ompi_pml_ucx.datatype_attr_keyval = MPI_KEYVAL_INVALID;
     for (i = 0; i < OMPI_DATATYPE_MAX_PREDEFINED; ++i) {
         ompi_pml_ucx.predefined_types[i] = PML_UCX_DATATYPE_INVALID;
@@ -351,11 +503,14 @@ int mca_pml_ucx_init(int enable_mpi_threads)
 
     opal_progress_register(mca_pml_ucx_progress);
 
-    PML_UCX_VERBOSE(2, "created ucp context %p, worker %p",
+    PML_UCX_VERBOSE(2, "created ucp context %p, worker %p (%d workers)",
                     (void *)ompi_pml_ucx.ucp_context,
-                    (void *)ompi_pml_ucx.ucp_worker);
+                    (void *)ompi_pml_ucx.ucp_worker,
+                    ompi_pml_ucx.num_workers);
     return OMPI_SUCCESS;
 
+err_destroy_workers:
+    mca_pml_ucx_destroy_workers();
 err_destroy_worker:
     ucp_worker_destroy(ompi_pml_ucx.ucp_worker);
 err:
@@ -389,6 +544,8 @@ int mca_pml_ucx_cleanup(void)
     OBJ_DESTRUCT(&ompi_pml_ucx.convs);
     OBJ_DESTRUCT(&ompi_pml_ucx.persistent_reqs);
 
+    mca_pml_ucx_destroy_workers();
+
     if (ompi_pml_ucx.ucp_worker != NULL) {
         ucp_worker_destroy(ompi_pml_ucx.ucp_worker);
         ompi_pml_ucx.ucp_worker = NULL;
@@ -447,12 +604,54 @@ int mca_pml_ucx_add_procs(struct ompi_proc_t **procs, size_t nprocs)
     return OMPI_SUCCESS;
 }
 
+static uint64_t mca_pml_ucx_proc_key(ompi_proc_t *proc)
+{
+    uint64_t key;
+
+    memcpy(&key, &proc->super.proc_name, sizeof(key));
+    return key;
+}
+
+/* Endpoint of rank of a communicator of the workers but the first, the
+ * endpoint is shared by all the communicators of the worker */
+static ucp_ep_h mca_pml_ucx_comm_add_ep(mca_pml_ucx_comm_t *ucx_comm,
+                                        ompi_communicator_t *comm, int rank)
+{
+    ompi_proc_t *proc_peer = ompi_comm_peer_lookup(comm, rank);
+    mca_pml_ucx_worker_t *worker = ucx_comm->worker;
+    uint64_t key = mca_pml_ucx_proc_key(proc_peer);
+    ucp_ep_h ep;
+
+    OPAL_THREAD_LOCK(&worker->lock);
+    if (OPAL_SUCCESS != opal_hash_table_get_value_uint64(&worker->eps, key,
+                                                         (void**)&ep)) {
+        ep = mca_pml_ucx_worker_connect(worker, proc_peer);
+        if (NULL != ep) {
+            opal_hash_table_set_value_uint64(&worker->eps, key, ep);
+        }
+    }
+    OPAL_THREAD_UNLOCK(&worker->lock);
+
+    ucx_comm->eps[rank] = ep;
+    return ep;
+}
+
 __opal_attribute_always_inline__
 static inline ucp_ep_h mca_pml_ucx_get_ep(ompi_communicator_t *comm, int rank)
 {
-    ompi_proc_t *proc_peer = ompi_comm_peer_lookup(comm, rank);
+    mca_pml_ucx_comm_t *ucx_comm = (mca_pml_ucx_comm_t*)comm->c_pml_comm;
+    ompi_proc_t *proc_peer;
     ucp_ep_h ep;
 
+    if (OPAL_UNLIKELY(NULL != ucx_comm)) {
+        ep = ucx_comm->eps[rank];
+        if (OPAL_LIKELY(NULL != ep)) {
+            return ep;
+        }
+        return mca_pml_ucx_comm_add_ep(ucx_comm, comm, rank);
+    }
+
+    proc_peer = ompi_comm_peer_lookup(comm, rank);
     ep = proc_peer->proc_endpoints[OMPI_PROC_ENDPOINT_TAG_PML];
     if (OPAL_LIKELY(NULL != ep)) {
         return ep;
@@ -461,18 +660,64 @@ static inline ucp_ep_h mca_pml_ucx_get_ep(ompi_communicator_t *comm, int rank)
     return mca_pml_ucx_add_proc_common(proc_peer);
 }
 
+/* The worker to post an operation on comm to, remembered as the one this
+ * thread progresses first */
+__opal_attribute_always_inline__
+static inline ucp_worker_h mca_pml_ucx_post_worker(ompi_communicator_t *comm)
+{
+    mca_pml_ucx_comm_t *ucx_comm = (mca_pml_ucx_comm_t*)comm->c_pml_comm;
+
+    if (OPAL_LIKELY(NULL == ucx_comm)) {
+#if OPAL_HAVE_THREAD_LOCAL
+        if (OPAL_UNLIKELY(ompi_pml_ucx.num_workers > 1)) {
+            mca_pml_ucx_thread_worker = 0;
+        }
+#endif
+        return ompi_pml_ucx.ucp_worker;
+    }
+
+#if OPAL_HAVE_THREAD_LOCAL
+    mca_pml_ucx_thread_worker = ucx_comm->worker->index;
+#endif
+    return ucx_comm->worker->ucp_worker;
+}
+
 int mca_pml_ucx_del_procs(struct ompi_proc_t **procs, size_t nprocs)
 {
     ompi_proc_t *proc;
     opal_common_ucx_del_proc_t *del_procs;
     size_t i;
-    int ret;
+    int ret, w;
 
     del_procs = malloc(sizeof(*del_procs) * nprocs);
     if (del_procs == NULL) {
         return OMPI_ERR_OUT_OF_RESOURCE;
     }
 
+    /* The endpoints of the other workers first, the fence below covers
+     * them too */
+    for (w = 1; w < ompi_pml_ucx.num_workers; ++w) {
+        mca_pml_ucx_worker_t *worker = &ompi_pml_ucx.workers[w];
+        void *ep;
+
+        OPAL_THREAD_LOCK(&worker->lock);
+        for (i = 0; i < nprocs; ++i) {
+            uint64_t key = mca_pml_ucx_proc_key(procs[i]);
+
+            del_procs[i].vpid = procs[i]->super.proc_name.vpid;
+            del_procs[i].ep   = NULL;
+            if (OPAL_SUCCESS == opal_hash_table_get_value_uint64(&worker->eps, key, &ep)) {
+                del_procs[i].ep = ep;
+                opal_hash_table_remove_value_uint64(&worker->eps, key);
+            }
+        }
+        OPAL_THREAD_UNLOCK(&worker->lock);
+
+        opal_common_ucx_del_procs_nofence(del_procs, nprocs, OMPI_PROC_MY_NAME->vpid,
+                                          ompi_pml_ucx.num_disconnect,
+                                          worker->ucp_worker);
+    }
+
     for (i = 0; i < nprocs; ++i) {
         proc = procs[i];
         del_procs[i].ep   = proc->proc_endpoints[OMPI_PROC_ENDPOINT_TAG_PML];
@@ -516,21 +761,112 @@ int mca_pml_ucx_enable(bool enable)
     return OMPI_SUCCESS;
 }
 
+/*
+ * With several workers a thread progresses the worker it posted to last,
+ * and one of the others in turn: the threads working on communicators of
+ * different workers do not contend on a worker lock.
+ */
+static int mca_pml_ucx_progress_workers(void)
+{
+#if OPAL_HAVE_THREAD_LOCAL
+    static opal_thread_local unsigned next = 0;
+    int mine = mca_pml_ucx_thread_worker;
+    int other = (int)(++next % ompi_pml_ucx.num_workers);
+    int count;
+
+    count = ucp_worker_progress(ompi_pml_ucx.workers[mine].ucp_worker);
+    if (other != mine) {
+        count += ucp_worker_progress(ompi_pml_ucx.workers[other].ucp_worker);
+    }
+    return count;
+#else
+    int i, count = 0;
+
+    for (i = 0; i < ompi_pml_ucx.num_workers; ++i) {
+        count += ucp_worker_progress(ompi_pml_ucx.workers[i].ucp_worker);
+    }
+    return count;
+#endif
+}
+
 int mca_pml_ucx_progress(void)
 {
-    return ucp_worker_progress(ompi_pml_ucx.ucp_worker);
+    if (OPAL_LIKELY(1 == ompi_pml_ucx.num_workers)) {
+        return ucp_worker_progress(ompi_pml_ucx.ucp_worker);
+    }
+    return mca_pml_ucx_progress_workers();
 }
 
 int mca_pml_ucx_add_comm(struct ompi_communicator_t* comm)
 {
+    int index = (int)(comm->c_contextid % ompi_pml_ucx.num_workers);
+    mca_pml_ucx_comm_t *ucx_comm;
+    int size;
+
+    comm->c_pml_comm = NULL;
+    if (0 == index) {
+        return OMPI_SUCCESS;
+    }
+
+    size     = ompi_comm_remote_size(comm);
+    ucx_comm = calloc(1, sizeof(*ucx_comm) + size * sizeof(ucp_ep_h));
+    if (NULL == ucx_comm) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    ucx_comm->worker = &ompi_pml_ucx.workers[index];
+    ucx_comm->size   = size;
+
+    PML_UCX_VERBOSE(2, "comm %d '%s' uses worker %d", comm->c_contextid,
+                    comm->c_name, index);
+    comm->c_pml_comm = (struct mca_pml_comm_t*)ucx_comm;
     return OMPI_SUCCESS;
 }
 
 int mca_pml_ucx_del_comm(struct ompi_communicator_t* comm)
 {
+    free(comm->c_pml_comm);
+    comm->c_pml_comm = NULL;
     return OMPI_SUCCESS;
 }
 
+#if HAVE_DECL_UCP_TAG_SEND_NBX || HAVE_DECL_UCP_TAG_RECV_NBX
+/* Post the operation with the iov of count elements at buf instead of the
+ * datatype of op_data */
+__opal_attribute_always_inline__
+static inline void mca_pml_ucx_set_iov_param(ucp_request_param_t *param,
+                                             pml_ucx_datatype_t *op_data,
+                                             const void *buf, size_t count,
+                                             ucp_dt_iov_t *iov)
+{
+    mca_pml_ucx_fill_iov(op_data, buf, count, iov);
+    param->op_attr_mask |= UCP_OP_ATTR_FIELD_DATATYPE;
+    param->datatype      = ucp_dt_make_iov();
+}
+
+static void mca_pml_ucx_persistent_init_nbx(mca_pml_ucx_persistent_request_t *req,
+                                            pml_ucx_datatype_t *op_data,
+                                            const ucp_request_param_t *param)
+{
+    size_t iov_count = mca_pml_ucx_get_iov_count(op_data, req->count);
+
+    req->flags  |= MCA_PML_UCX_REQUEST_FLAG_NBX;
+    req->param   = *param;
+    req->data    = req->buffer;
+    req->length  = mca_pml_ucx_get_data_size(op_data, req->count);
+
+    if (iov_count > 0) {
+        /* the buffer does not change, the iov is built once */
+        req->iov = malloc(iov_count * sizeof(*req->iov));
+        if (req->iov != NULL) {
+            mca_pml_ucx_set_iov_param(&req->param, op_data, req->buffer,
+                                      req->count, req->iov);
+            req->data   = req->iov;
+            req->length = iov_count;
+        }
+    }
+}
+#endif
+
 int mca_pml_ucx_irecv_init(void *buf, size_t count, ompi_datatype_t *datatype,
                              int src, int tag, struct ompi_communicator_t* comm,
                              struct ompi_request_t **request)
@@ -554,6 +890,13 @@ int mca_pml_ucx_irecv_init(void *buf, size_t count, ompi_datatype_t *datatype,
 
     PML_UCX_MAKE_RECV_TAG(req->tag, req->recv.tag_mask, tag, src, comm);
 
+#if HAVE_DECL_UCP_TAG_RECV_NBX
+    pml_ucx_datatype_t *op_data = mca_pml_ucx_get_op_data(datatype);
+
+    mca_pml_ucx_persistent_init_nbx(req, op_data, &op_data->op_param.recv);
+    req->param.cb.recv = mca_pml_ucx_precv_nbx_completion;
+#endif
+
     *request = &req->ompi;
     return OMPI_SUCCESS;
 }
@@ -565,21 +908,43 @@ int mca_pml_ucx_irecv(void *buf, size_t count, ompi_datatype_t *datatype,
 #if HAVE_DECL_UCP_TAG_RECV_NBX
     pml_ucx_datatype_t *op_data = mca_pml_ucx_get_op_data(datatype);
     ucp_request_param_t *param  = &op_data->op_param.recv;
+    size_t iov_count            = mca_pml_ucx_get_iov_count(op_data, count);
+    ucp_request_param_t iov_param;
+    ucp_dt_iov_t *iov;
 #endif
 
     ucp_tag_t ucp_tag, ucp_tag_mask;
     ompi_request_t *req;
 
+    ucp_worker_h worker = mca_pml_ucx_post_worker(comm);
+
     PML_UCX_TRACE_RECV("irecv request *%p", buf, count, datatype, src, tag, comm,
                        (void*)request);
 
     PML_UCX_MAKE_RECV_TAG(ucp_tag, ucp_tag_mask, tag, src, comm);
 #if HAVE_DECL_UCP_TAG_RECV_NBX
-    req = (ompi_request_t*)ucp_tag_recv_nbx(ompi_pml_ucx.ucp_worker, buf,
-                                            mca_pml_ucx_get_data_size(op_data, count),
-                                            ucp_tag, ucp_tag_mask, param);
+    if ((iov_count > 0) &&
+        (NULL != (iov = malloc(iov_count * sizeof(*iov))))) {
+        /* the iov is released by the completion callback, which is always
+         * called because of UCP_OP_ATTR_FLAG_NO_IMM_CMPL */
+        iov_param = *param;
+        mca_pml_ucx_set_iov_param(&iov_param, op_data, buf, count, iov);
+        iov_param.op_attr_mask |= UCP_OP_ATTR_FIELD_USER_DATA;
+        iov_param.user_data     = iov;
+        iov_param.cb.recv       = mca_pml_ucx_recv_iov_nbx_completion;
+        req = (ompi_request_t*)ucp_tag_recv_nbx(worker, iov,
+                                                iov_count, ucp_tag, ucp_tag_mask,
+                                                &iov_param);
+        if (UCS_PTR_IS_ERR(req)) {
+            free(iov);
+        }
+    } else {
+        req = (ompi_request_t*)ucp_tag_recv_nbx(worker, buf,
+                                                mca_pml_ucx_get_data_size(op_data, count),
+                                                ucp_tag, ucp_tag_mask, param);
+    }
 #else
-    req = (ompi_request_t*)ucp_tag_recv_nb(ompi_pml_ucx.ucp_worker, buf, count,
+    req = (ompi_request_t*)ucp_tag_recv_nb(worker, buf, count,
                                            mca_pml_ucx_get_datatype(datatype),
                                            ucp_tag, ucp_tag_mask,
                                            mca_pml_ucx_recv_completion);
@@ -606,29 +971,45 @@ int mca_pml_ucx_recv(void *buf, size_t count, ompi_datatype_t *datatype, int src
     ucp_request_param_t *recv_param = &op_data->op_param.recv;
     ucp_request_param_t param;
 
+    size_t iov_count                = mca_pml_ucx_get_iov_count(op_data, count);
+    ucp_dt_iov_t *iov               = NULL;
+
     param.op_attr_mask = UCP_OP_ATTR_FIELD_REQUEST |
                          (recv_param->op_attr_mask & UCP_OP_ATTR_FIELD_DATATYPE);
     param.datatype     = recv_param->datatype;
     param.request      = req;
+
+    if (iov_count > 0) {
+        /* the iov only has to live until the receive completes below */
+        iov = alloca(iov_count * sizeof(*iov));
+        mca_pml_ucx_set_iov_param(&param, op_data, buf, count, iov);
+    }
 #endif
     ucp_tag_t ucp_tag, ucp_tag_mask;
     ucp_tag_recv_info_t info;
     ucs_status_t status;
     int result;
 
+    ucp_worker_h worker = mca_pml_ucx_post_worker(comm);
+
     PML_UCX_TRACE_RECV("%s", buf, count, datatype, src, tag, comm, "recv");
 
     PML_UCX_MAKE_RECV_TAG(ucp_tag, ucp_tag_mask, tag, src, comm);
 #if HAVE_DECL_UCP_TAG_RECV_NBX
-    ucp_tag_recv_nbx(ompi_pml_ucx.ucp_worker, buf,
-                     mca_pml_ucx_get_data_size(op_data, count),
-                     ucp_tag, ucp_tag_mask, &param);
+    if (NULL != iov) {
+        ucp_tag_recv_nbx(worker, iov, iov_count,
+                         ucp_tag, ucp_tag_mask, &param);
+    } else {
+        ucp_tag_recv_nbx(worker, buf,
+                         mca_pml_ucx_get_data_size(op_data, count),
+                         ucp_tag, ucp_tag_mask, &param);
+    }
 #else
-    ucp_tag_recv_nbr(ompi_pml_ucx.ucp_worker, buf, count,
+    ucp_tag_recv_nbr(worker, buf, count,
                      mca_pml_ucx_get_datatype(datatype),
                      ucp_tag, ucp_tag_mask, req);
 #endif
-    MCA_COMMON_UCX_PROGRESS_LOOP(ompi_pml_ucx.ucp_worker) {
+    MCA_COMMON_UCX_PROGRESS_LOOP(worker) {
         status = ucp_request_test(req, &info);
         if (status != UCS_INPROGRESS) {
             result = mca_pml_ucx_set_recv_status_safe(mpi_status, status, &info);
@@ -638,6 +1019,7 @@ int mca_pml_ucx_recv(void *buf, size_t count, ompi_datatype_t *datatype, int src
             ompi_datatype_type_size(datatype, &dt_size);
             SPC_USER_OR_MPI(tag, dt_size*count,
                             OMPI_SPC_BYTES_RECEIVED_USER, OMPI_SPC_BYTES_RECEIVED_MPI);
+            SPC_COMM_RECORD_RECV(comm, (ompi_spc_value_t)info.length);
 #endif
             return result;
         }
@@ -702,6 +1084,18 @@ int mca_pml_ucx_isend_init(const void *buf, size_t count, ompi_datatype_t *datat
         req->datatype.datatype = mca_pml_ucx_get_datatype(datatype);
     }
 
+#if HAVE_DECL_UCP_TAG_SEND_NBX
+    /* synchronous and buffered sends keep going through
+     * mca_pml_ucx_common_send() */
+    if ((MCA_PML_BASE_SEND_BUFFERED != mode) &&
+        (MCA_PML_BASE_SEND_SYNCHRONOUS != mode)) {
+        pml_ucx_datatype_t *op_data = mca_pml_ucx_get_op_data(datatype);
+
+        mca_pml_ucx_persistent_init_nbx(req, op_data, &op_data->op_param.send);
+        req->param.cb.send = mca_pml_ucx_psend_nbx_completion;
+    }
+#endif
+
     *request = &req->ompi;
     return OMPI_SUCCESS;
 }
@@ -785,6 +1179,40 @@ static inline ucs_status_ptr_t mca_pml_ucx_common_send(ucp_ep_h ep, const void *
 }
 
 #if HAVE_DECL_UCP_TAG_SEND_NBX
+/* Nonblocking send of a derived datatype described by an iov. The iov is
+ * released by the completion callback, or here if the send completed in
+ * place or failed */
+static ucs_status_ptr_t
+mca_pml_ucx_send_iov_nbx(ucp_ep_h ep, const void *buf, size_t count,
+                         pml_ucx_datatype_t *op_data, ucp_tag_t tag,
+                         const ucp_request_param_t *param)
+{
+    size_t iov_count = mca_pml_ucx_get_iov_count(op_data, count);
+    ucp_request_param_t iov_param;
+    ucs_status_ptr_t req;
+    ucp_dt_iov_t *iov;
+
+    iov = malloc(iov_count * sizeof(*iov));
+    if (OPAL_UNLIKELY(NULL == iov)) {
+        return ucp_tag_send_nbx(ep, buf,
+                                mca_pml_ucx_get_data_size(op_data, count),
+                                tag, param);
+    }
+
+    iov_param = *param;
+    mca_pml_ucx_set_iov_param(&iov_param, op_data, buf, count, iov);
+    iov_param.op_attr_mask |= UCP_OP_ATTR_FIELD_USER_DATA;
+    iov_param.user_data     = iov;
+    iov_param.cb.send       = mca_pml_ucx_send_iov_nbx_completion;
+
+    req = ucp_tag_send_nbx(ep, iov, iov_count, tag, &iov_param);
+    if ((NULL == req) || UCS_PTR_IS_ERR(req)) {
+        free(iov);
+    }
+
+    return req;
+}
+
 __opal_attribute_always_inline__
 static inline ucs_status_ptr_t
 mca_pml_ucx_common_send_nbx(ucp_ep_h ep, const void *buf,
@@ -802,6 +1230,8 @@ mca_pml_ucx_common_send_nbx(ucp_ep_h ep, const void *buf,
         return ucp_tag_send_sync_nb(ep, buf, count,
                                     mca_pml_ucx_get_datatype(datatype), tag,
                                     (ucp_send_callback_t)param->cb.send);
+    } else if (mca_pml_ucx_get_iov_count(op_data, count) > 0) {
+        return mca_pml_ucx_send_iov_nbx(ep, buf, count, op_data, tag, param);
     } else {
         return ucp_tag_send_nbx(ep, buf,
                                 mca_pml_ucx_get_data_size(op_data, count),
@@ -823,6 +1253,7 @@ int mca_pml_ucx_isend(const void *buf, size_t count, ompi_datatype_t *datatype,
                        mode == MCA_PML_BASE_SEND_BUFFERED ? "b" : "",
                        (void*)request)
 
+    (void)mca_pml_ucx_post_worker(comm);
     ep = mca_pml_ucx_get_ep(comm, dst);
     if (OPAL_UNLIKELY(NULL == ep)) {
         return OMPI_ERROR;
@@ -844,6 +1275,7 @@ int mca_pml_ucx_isend(const void *buf, size_t count, ompi_datatype_t *datatype,
     ompi_datatype_type_size(datatype, &dt_size);
     SPC_USER_OR_MPI(tag, dt_size*count,
                     OMPI_SPC_BYTES_SENT_USER, OMPI_SPC_BYTES_SENT_MPI);
+    SPC_COMM_RECORD_SEND(comm, dst, (ompi_spc_value_t)(dt_size*count));
 #endif
 
     if (req == NULL) {
@@ -862,7 +1294,7 @@ int mca_pml_ucx_isend(const void *buf, size_t count, ompi_datatype_t *datatype,
 }
 
 static inline __opal_attribute_always_inline__ int
-mca_pml_ucx_send_nb(ucp_ep_h ep, const void *buf, size_t count,
+mca_pml_ucx_send_nb(ucp_worker_h worker, ucp_ep_h ep, const void *buf, size_t count,
                     ompi_datatype_t *datatype, ucp_datatype_t ucx_datatype,
                     ucp_tag_t tag, mca_pml_base_send_mode_t mode,
                     ucp_send_callback_t cb)
@@ -876,7 +1308,7 @@ mca_pml_ucx_send_nb(ucp_ep_h ep, const void *buf, size_t count,
         return OMPI_SUCCESS;
     } else if (!UCS_PTR_IS_ERR(req)) {
         PML_UCX_VERBOSE(8, "got request %p", (void*)req);
-        MCA_COMMON_UCX_WAIT_LOOP(req, ompi_pml_ucx.ucp_worker, "ucx send", ompi_request_free(&req));
+        MCA_COMMON_UCX_WAIT_LOOP(req, worker, "ucx send", ompi_request_free(&req));
     } else {
         PML_UCX_ERROR("ucx send failed: %s", ucs_status_string(UCS_PTR_STATUS(req)));
         return OMPI_ERROR;
@@ -885,7 +1317,7 @@ mca_pml_ucx_send_nb(ucp_ep_h ep, const void *buf, size_t count,
 
 #if HAVE_DECL_UCP_TAG_SEND_NBR
 static inline __opal_attribute_always_inline__ int
-mca_pml_ucx_send_nbr(ucp_ep_h ep, const void *buf, size_t count,
+mca_pml_ucx_send_nbr(ucp_worker_h worker, ucp_ep_h ep, const void *buf, size_t count,
                      ompi_datatype_t *datatype, ucp_tag_t tag)
 {
     /* coverity[bad_alloc_arithmetic] */
@@ -899,10 +1331,19 @@ mca_pml_ucx_send_nbr(ucp_ep_h ep, const void *buf, size_t count,
         .datatype     = op_data->op_param.send.datatype,
         .request      = req
     };
-
-    req = ucp_tag_send_nbx(ep, buf,
-                           mca_pml_ucx_get_data_size(op_data, count),
-                           tag, &param);
+    size_t iov_count = mca_pml_ucx_get_iov_count(op_data, count);
+    ucp_dt_iov_t *iov;
+
+    if (iov_count > 0) {
+        /* the iov only has to live until the send completes below */
+        iov = alloca(iov_count * sizeof(*iov));
+        mca_pml_ucx_set_iov_param(&param, op_data, buf, count, iov);
+        req = ucp_tag_send_nbx(ep, iov, iov_count, tag, &param);
+    } else {
+        req = ucp_tag_send_nbx(ep, buf,
+                               mca_pml_ucx_get_data_size(op_data, count),
+                               tag, &param);
+    }
     if (OPAL_LIKELY(req == UCS_OK)) {
         return OMPI_SUCCESS;
     } else if (UCS_PTR_IS_ERR(req)) {
@@ -919,7 +1360,7 @@ mca_pml_ucx_send_nbr(ucp_ep_h ep, const void *buf, size_t count,
     }
 #endif
 
-    MCA_COMMON_UCX_WAIT_LOOP(req, ompi_pml_ucx.ucp_worker, "ucx send nbr", (void)0);
+    MCA_COMMON_UCX_WAIT_LOOP(req, worker, "ucx send nbr", (void)0);
 }
 #endif
 
@@ -927,6 +1368,7 @@ int mca_pml_ucx_send(const void *buf, size_t count, ompi_datatype_t *datatype, i
                      int tag, mca_pml_base_send_mode_t mode,
                      struct ompi_communicator_t* comm)
 {
+    ucp_worker_h worker = mca_pml_ucx_post_worker(comm);
     ucp_ep_h ep;
 
     PML_UCX_TRACE_SEND("%s", buf, count, datatype, dst, tag, mode, comm,
@@ -942,17 +1384,18 @@ int mca_pml_ucx_send(const void *buf, size_t count, ompi_datatype_t *datatype, i
     ompi_datatype_type_size(datatype, &dt_size);
     SPC_USER_OR_MPI(tag, dt_size*count,
                     OMPI_SPC_BYTES_SENT_USER, OMPI_SPC_BYTES_SENT_MPI);
+    SPC_COMM_RECORD_SEND(comm, dst, (ompi_spc_value_t)(dt_size*count));
 #endif
 
 #if HAVE_DECL_UCP_TAG_SEND_NBR
     if (OPAL_LIKELY((MCA_PML_BASE_SEND_BUFFERED != mode) &&
                     (MCA_PML_BASE_SEND_SYNCHRONOUS != mode))) {
-        return mca_pml_ucx_send_nbr(ep, buf, count, datatype,
+        return mca_pml_ucx_send_nbr(worker, ep, buf, count, datatype,
                                     PML_UCX_MAKE_SEND_TAG(tag, comm));
     }
 #endif
 
-    return mca_pml_ucx_send_nb(ep, buf, count, datatype,
+    return mca_pml_ucx_send_nb(worker, ep, buf, count, datatype,
                                mca_pml_ucx_get_datatype(datatype),
                                PML_UCX_MAKE_SEND_TAG(tag, comm), mode,
                                mca_pml_ucx_send_completion);
@@ -963,6 +1406,7 @@ int mca_pml_ucx_iprobe(int src, int tag, struct ompi_communicator_t* comm,
 {
     static unsigned progress_count = 0;
 
+    ucp_worker_h worker = mca_pml_ucx_post_worker(comm);
     ucp_tag_t ucp_tag, ucp_tag_mask;
     ucp_tag_recv_info_t info;
     ucp_tag_message_h ucp_msg;
@@ -970,14 +1414,14 @@ int mca_pml_ucx_iprobe(int src, int tag, struct ompi_communicator_t* comm,
     PML_UCX_TRACE_PROBE("iprobe", src, tag, comm);
 
     PML_UCX_MAKE_RECV_TAG(ucp_tag, ucp_tag_mask, tag, src, comm);
-    ucp_msg = ucp_tag_probe_nb(ompi_pml_ucx.ucp_worker, ucp_tag, ucp_tag_mask,
+    ucp_msg = ucp_tag_probe_nb(worker, ucp_tag, ucp_tag_mask,
                                0, &info);
     if (ucp_msg != NULL) {
         *matched = 1;
         mca_pml_ucx_set_recv_status_safe(mpi_status, UCS_OK, &info);
     } else  {
         (++progress_count % opal_common_ucx.progress_iterations) ?
-            (void)ucp_worker_progress(ompi_pml_ucx.ucp_worker) : opal_progress();
+            (void)ucp_worker_progress(worker) : opal_progress();
         *matched = 0;
     }
     return OMPI_SUCCESS;
@@ -986,6 +1430,7 @@ int mca_pml_ucx_iprobe(int src, int tag, struct ompi_communicator_t* comm,
 int mca_pml_ucx_probe(int src, int tag, struct ompi_communicator_t* comm,
                       ompi_status_public_t* mpi_status)
 {
+    ucp_worker_h worker = mca_pml_ucx_post_worker(comm);
     ucp_tag_t ucp_tag, ucp_tag_mask;
     ucp_tag_recv_info_t info;
     ucp_tag_message_h ucp_msg;
@@ -994,8 +1439,8 @@ int mca_pml_ucx_probe(int src, int tag, struct ompi_communicator_t* comm,
 
     PML_UCX_MAKE_RECV_TAG(ucp_tag, ucp_tag_mask, tag, src, comm);
 
-    MCA_COMMON_UCX_PROGRESS_LOOP(ompi_pml_ucx.ucp_worker) {
-        ucp_msg = ucp_tag_probe_nb(ompi_pml_ucx.ucp_worker, ucp_tag,
+    MCA_COMMON_UCX_PROGRESS_LOOP(worker) {
+        ucp_msg = ucp_tag_probe_nb(worker, ucp_tag,
                                    ucp_tag_mask, 0, &info);
         if (ucp_msg != NULL) {
             mca_pml_ucx_set_recv_status_safe(mpi_status, UCS_OK, &info);
@@ -1010,6 +1455,7 @@ int mca_pml_ucx_improbe(int src, int tag, struct ompi_communicator_t* comm,
 {
     static unsigned progress_count = 0;
 
+    ucp_worker_h worker = mca_pml_ucx_post_worker(comm);
     ucp_tag_t ucp_tag, ucp_tag_mask;
     ucp_tag_recv_info_t info;
     ucp_tag_message_h ucp_msg;
@@ -1017,7 +1463,7 @@ int mca_pml_ucx_improbe(int src, int tag, struct ompi_communicator_t* comm,
     PML_UCX_TRACE_PROBE("improbe", src, tag, comm);
 
     PML_UCX_MAKE_RECV_TAG(ucp_tag, ucp_tag_mask, tag, src, comm);
-    ucp_msg = ucp_tag_probe_nb(ompi_pml_ucx.ucp_worker, ucp_tag, ucp_tag_mask,
+    ucp_msg = ucp_tag_probe_nb(worker, ucp_tag, ucp_tag_mask,
                                1, &info);
     if (ucp_msg != NULL) {
         PML_UCX_MESSAGE_NEW(comm, ucp_msg, &info, message);
@@ -1026,7 +1472,7 @@ int mca_pml_ucx_improbe(int src, int tag, struct ompi_communicator_t* comm,
         mca_pml_ucx_set_recv_status_safe(mpi_status, UCS_OK, &info);
     } else  {
         (++progress_count % opal_common_ucx.progress_iterations) ?
-            (void)ucp_worker_progress(ompi_pml_ucx.ucp_worker) : opal_progress();
+            (void)ucp_worker_progress(worker) : opal_progress();
         *matched = 0;
     }
     return OMPI_SUCCESS;
@@ -1036,6 +1482,7 @@ int mca_pml_ucx_mprobe(int src, int tag, struct ompi_communicator_t* comm,
                          struct ompi_message_t **message,
                          ompi_status_public_t* mpi_status)
 {
+    ucp_worker_h worker = mca_pml_ucx_post_worker(comm);
     ucp_tag_t ucp_tag, ucp_tag_mask;
     ucp_tag_recv_info_t info;
     ucp_tag_message_h ucp_msg;
@@ -1043,8 +1490,8 @@ int mca_pml_ucx_mprobe(int src, int tag, struct ompi_communicator_t* comm,
     PML_UCX_TRACE_PROBE("mprobe", src, tag, comm);
 
     PML_UCX_MAKE_RECV_TAG(ucp_tag, ucp_tag_mask, tag, src, comm);
-    MCA_COMMON_UCX_PROGRESS_LOOP(ompi_pml_ucx.ucp_worker) {
-        ucp_msg = ucp_tag_probe_nb(ompi_pml_ucx.ucp_worker, ucp_tag, ucp_tag_mask,
+    MCA_COMMON_UCX_PROGRESS_LOOP(worker) {
+        ucp_msg = ucp_tag_probe_nb(worker, ucp_tag, ucp_tag_mask,
                                    1, &info);
         if (ucp_msg != NULL) {
             PML_UCX_MESSAGE_NEW(comm, ucp_msg, &info, message);
@@ -1063,7 +1510,8 @@ int mca_pml_ucx_imrecv(void *buf, size_t count, ompi_datatype_t *datatype,
 
     PML_UCX_TRACE_MRECV("imrecv", buf, count, datatype, message);
 
-    req = (ompi_request_t*)ucp_tag_msg_recv_nb(ompi_pml_ucx.ucp_worker, buf, count,
+    req = (ompi_request_t*)ucp_tag_msg_recv_nb(mca_pml_ucx_post_worker((*message)->comm),
+                                               buf, count,
                                                mca_pml_ucx_get_datatype(datatype),
                                                (*message)->req_ptr,
                                                mca_pml_ucx_recv_completion);
@@ -1073,6 +1521,7 @@ int mca_pml_ucx_imrecv(void *buf, size_t count, ompi_datatype_t *datatype,
     }
 
     PML_UCX_VERBOSE(8, "got request %p", (void*)req);
+    req->req_mpi_object.comm = (*message)->comm;
     PML_UCX_MESSAGE_RELEASE(message);
     *request = req;
     return OMPI_SUCCESS;
@@ -1086,7 +1535,8 @@ int mca_pml_ucx_mrecv(void *buf, size_t count, ompi_datatype_t *datatype,
 
     PML_UCX_TRACE_MRECV("mrecv", buf, count, datatype, message);
 
-    req = (ompi_request_t*)ucp_tag_msg_recv_nb(ompi_pml_ucx.ucp_worker, buf, count,
+    req = (ompi_request_t*)ucp_tag_msg_recv_nb(mca_pml_ucx_post_worker((*message)->comm),
+                                               buf, count,
                                                mca_pml_ucx_get_datatype(datatype),
                                                (*message)->req_ptr,
                                                mca_pml_ucx_recv_completion);
@@ -1095,6 +1545,7 @@ int mca_pml_ucx_mrecv(void *buf, size_t count, ompi_datatype_t *datatype,
         return OMPI_ERROR;
     }
 
+    req->req_mpi_object.comm = (*message)->comm;
     PML_UCX_MESSAGE_RELEASE(message);
 
     return ompi_request_wait(&req, status);
@@ -1119,22 +1570,43 @@ int mca_pml_ucx_start(size_t count, ompi_request_t** requests)
         mca_pml_ucx_request_reset(&preq->ompi);
 
         if (preq->flags & MCA_PML_UCX_REQUEST_FLAG_SEND) {
-            tmp_req = (ompi_request_t*)mca_pml_ucx_common_send(preq->send.ep,
-                                                               preq->buffer,
-                                                               preq->count,
-                                                               preq->datatype.ompi_datatype,
-                                                               preq->datatype.datatype,
-                                                               preq->tag,
-                                                               preq->send.mode,
-                                                               mca_pml_ucx_psend_completion);
+#if HAVE_DECL_UCP_TAG_SEND_NBX
+            if (OPAL_LIKELY(preq->flags & MCA_PML_UCX_REQUEST_FLAG_NBX)) {
+                tmp_req = (ompi_request_t*)ucp_tag_send_nbx(preq->send.ep,
+                                                            preq->data,
+                                                            preq->length,
+                                                            preq->tag,
+                                                            &preq->param);
+            } else
+#endif
+            {
+                tmp_req = (ompi_request_t*)mca_pml_ucx_common_send(preq->send.ep,
+                                                                   preq->buffer,
+                                                                   preq->count,
+                                                                   preq->datatype.ompi_datatype,
+                                                                   preq->datatype.datatype,
+                                                                   preq->tag,
+                                                                   preq->send.mode,
+                                                                   mca_pml_ucx_psend_completion);
+            }
         } else {
+            ucp_worker_h worker = mca_pml_ucx_post_worker(preq->ompi.req_mpi_object.comm);
+
             PML_UCX_VERBOSE(8, "start recv request %p", (void*)preq);
-            tmp_req = (ompi_request_t*)ucp_tag_recv_nb(ompi_pml_ucx.ucp_worker,
+#if HAVE_DECL_UCP_TAG_RECV_NBX
+            tmp_req = (ompi_request_t*)ucp_tag_recv_nbx(worker,
+                                                        preq->data, preq->length,
+                                                        preq->tag,
+                                                        preq->recv.tag_mask,
+                                                        &preq->param);
+#else
+            tmp_req = (ompi_request_t*)ucp_tag_recv_nb(worker,
                                                        preq->buffer, preq->count,
                                                        preq->datatype.datatype,
                                                        preq->tag,
                                                        preq->recv.tag_mask,
                                                        mca_pml_ucx_precv_completion);
+#endif
         }
 
         if (tmp_req == NULL) {
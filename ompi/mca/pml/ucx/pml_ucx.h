@@ -18,7 +18,9 @@
 #include "ompi/datatype/ompi_datatype_internal.h"
 #include "ompi/communicator/communicator.h"
 #include "ompi/request/request.h"
+#include "opal/class/opal_hash_table.h"
 #include "opal/mca/common/ucx/common_ucx.h"
+#include "opal/mca/threads/mutex.h"
 
 #include <ucp/api/ucp.h>
 #include "pml_ucx_freelist.h"
@@ -31,11 +33,38 @@
 typedef struct mca_pml_ucx_module           mca_pml_ucx_module_t;
 typedef struct pml_ucx_persistent_request   mca_pml_ucx_persistent_request_t;
 typedef struct pml_ucx_convertor            mca_pml_ucx_convertor_t;
+typedef struct mca_pml_ucx_worker           mca_pml_ucx_worker_t;
+typedef struct mca_pml_ucx_comm             mca_pml_ucx_comm_t;
 
 /*
  * TODO version check
  */
 
+/*
+ * A UCP worker. The traffic of a communicator goes through the worker
+ * (contextid % num_workers) on all the processes, so matching, wildcards
+ * included, stays within one worker.
+ */
+struct mca_pml_ucx_worker {
+    ucp_worker_h              ucp_worker;
+    int                       index;
+
+    /* Endpoints of the workers but the first, by peer process name (the
+     * endpoints of the first worker are in the ompi_proc_t) */
+    opal_hash_table_t         eps;
+    opal_mutex_t              lock;
+};
+
+/*
+ * c_pml_comm of the communicators of the workers but the first: the
+ * endpoints of the peers, set on first use
+ */
+struct mca_pml_ucx_comm {
+    mca_pml_ucx_worker_t     *worker;
+    int                       size;
+    ucp_ep_h                  eps[];
+};
+
 struct mca_pml_ucx_module {
     mca_pml_base_module_t     super;
 
@@ -43,6 +72,10 @@ struct mca_pml_ucx_module {
     ucp_context_h             ucp_context;
     ucp_worker_h              ucp_worker;
 
+    /* Workers, the first one is ucp_worker */
+    mca_pml_ucx_worker_t     *workers;
+    int                       num_workers;
+
     /* Datatypes */
     int                       datatype_attr_keyval;
     ucp_datatype_t            predefined_types[OMPI_DATATYPE_MPI_MAX_PREDEFINED];
@@ -56,6 +89,9 @@ struct mca_pml_ucx_module {
     /* Converters pool */
     mca_pml_ucx_freelist_t    convs;
 
+    /* Largest iov a derived datatype operation is described with */
+    unsigned                  iov_max;
+
     int                       priority;
     bool                      cuda_initialized;
     bool                      request_leak_check;
@@ -130,5 +166,15 @@ int mca_pml_ucx_start(size_t count, ompi_request_t** requests);
 
 int mca_pml_ucx_dump(struct ompi_communicator_t* comm, int verbose);
 
+/* The worker of the traffic of comm */
+__opal_attribute_always_inline__
+static inline ucp_worker_h mca_pml_ucx_comm_worker(ompi_communicator_t *comm)
+{
+    if (OPAL_LIKELY(NULL == comm->c_pml_comm)) {
+        return ompi_pml_ucx.ucp_worker;
+    }
+    return ((mca_pml_ucx_comm_t *)comm->c_pml_comm)->worker->ucp_worker;
+}
+
 
 #endif /* PML_UCX_H_ */
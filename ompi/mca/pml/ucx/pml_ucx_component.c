@@ -65,6 +65,33 @@ static int mca_pml_ucx_component_register(void)
                                            MCA_BASE_VAR_SCOPE_LOCAL,
                                            &ompi_pml_ucx.num_disconnect);
 
+    ompi_pml_ucx.num_workers = 1;
+    (void) mca_base_component_var_register(&mca_pml_ucx_component.pmlm_version, "num_workers",
+                                           "Number of UCP workers. The traffic of a communicator "
+                                           "goes through the worker (context id modulo the number "
+                                           "of workers), so threads working on different "
+                                           "communicators do not share a worker. Must be the same "
+                                           "on all the processes of the job",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &ompi_pml_ucx.num_workers);
+
+#ifdef HAVE_UCP_REQUEST_PARAM_T
+    ompi_pml_ucx.iov_max = 16;
+    (void) mca_base_component_var_register(&mca_pml_ucx_component.pmlm_version, "iov_max",
+                                           "Maximal number of contiguous blocks for which an "
+                                           "operation on a derived datatype is passed to UCX as "
+                                           "an iov instead of being packed by the datatype "
+                                           "engine (0 disables)",
+                                           MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &ompi_pml_ucx.iov_max);
+#else
+    ompi_pml_ucx.iov_max = 0;
+#endif
+
 #if HAVE_DECL_UCP_WORKER_FLAG_IGNORE_REQUEST_LEAK
     ompi_pml_ucx.request_leak_check = false;
     (void) mca_base_component_var_register(&mca_pml_ucx_component.pmlm_version, "request_leak_check",
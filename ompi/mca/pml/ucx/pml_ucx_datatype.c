@@ -147,6 +147,7 @@ int mca_pml_ucx_datatype_attr_del_fn(ompi_datatype_t* datatype, int keyval,
     ucp_datatype_t ucp_datatype = (ucp_datatype_t)attr_val;
 
 #ifdef HAVE_UCP_REQUEST_PARAM_T
+    free(((pml_ucx_datatype_t*)datatype->pml_data)->iov);
     free((void*)datatype->pml_data);
 #else
     PML_UCX_ASSERT((uint64_t)ucp_datatype == datatype->pml_data);
@@ -169,6 +170,64 @@ static inline int mca_pml_ucx_datatype_is_contig(ompi_datatype_t *datatype)
 }
 
 #ifdef HAVE_UCP_REQUEST_PARAM_T
+/* Describe one element of a non-contiguous datatype with at most
+ * pml_ucx_iov_max blocks as an iov template. Larger layouts keep being
+ * packed by the generic datatype */
+static void mca_pml_ucx_init_iov_datatype(pml_ucx_datatype_t *pml_datatype,
+                                          ompi_datatype_t *datatype)
+{
+    opal_convertor_t convertor;
+    struct iovec *iov;
+    uint32_t iov_count, i;
+    ptrdiff_t lb;
+    size_t length;
+    int done;
+
+    pml_datatype->iov       = NULL;
+    pml_datatype->iov_count = 0;
+    pml_datatype->extent    = 0;
+
+    if ((0 == ompi_pml_ucx.iov_max) || ompi_datatype_is_predefined(datatype)) {
+        return;
+    }
+
+    iov = malloc(ompi_pml_ucx.iov_max * sizeof(*iov));
+    if (NULL == iov) {
+        return;
+    }
+
+    /* with a NULL buffer the convertor returns the offsets of the blocks */
+    OBJ_CONSTRUCT(&convertor, opal_convertor_t);
+    opal_convertor_copy_and_prepare_for_send(ompi_proc_local_proc->super.proc_convertor,
+                                             &datatype->super, 1, NULL, 0, &convertor);
+    iov_count = ompi_pml_ucx.iov_max;
+    done      = opal_convertor_raw(&convertor, iov, &iov_count, &length);
+    opal_convertor_cleanup(&convertor);
+    OBJ_DESTRUCT(&convertor);
+
+    if (!done || (0 == iov_count)) {
+        free(iov);
+        return;
+    }
+
+    pml_datatype->iov = malloc(iov_count * sizeof(*pml_datatype->iov));
+    if (NULL == pml_datatype->iov) {
+        free(iov);
+        return;
+    }
+
+    for (i = 0; i < iov_count; ++i) {
+        pml_datatype->iov[i].buffer = iov[i].iov_base;
+        pml_datatype->iov[i].length = iov[i].iov_len;
+    }
+    pml_datatype->iov_count = iov_count;
+    ompi_datatype_get_extent(datatype, &lb, &pml_datatype->extent);
+    free(iov);
+
+    PML_UCX_VERBOSE(7, "datatype %s is described by %u iov entries",
+                    datatype->name, iov_count);
+}
+
 __opal_attribute_always_inline__ static inline
 pml_ucx_datatype_t *mca_pml_ucx_init_nbx_datatype(ompi_datatype_t *datatype,
                                                   ucp_datatype_t ucp_datatype,
@@ -206,6 +265,14 @@ pml_ucx_datatype_t *mca_pml_ucx_init_nbx_datatype(ompi_datatype_t *datatype,
         PML_UCX_DATATYPE_SET_VALUE(pml_datatype, datatype = ucp_datatype);
     }
 
+    if (mca_pml_ucx_datatype_is_contig(datatype)) {
+        pml_datatype->iov       = NULL;
+        pml_datatype->iov_count = 0;
+        pml_datatype->extent    = 0;
+    } else {
+        mca_pml_ucx_init_iov_datatype(pml_datatype, datatype);
+    }
+
     return pml_datatype;
 }
 #endif
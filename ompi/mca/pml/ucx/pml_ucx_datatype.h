@@ -24,6 +24,12 @@ typedef struct {
         ucp_request_param_t bsend;
         ucp_request_param_t recv;
     } op_param;
+    /* Layout of one element of a derived datatype made of a few contiguous
+     * blocks, the buffer of each entry is its offset from the start of the
+     * element. NULL if the datatype is packed by the generic datatype */
+    ucp_dt_iov_t            *iov;
+    size_t                  iov_count;
+    ptrdiff_t               extent;
 } pml_ucx_datatype_t;
 #endif
 
@@ -83,6 +89,33 @@ static inline size_t mca_pml_ucx_get_data_size(pml_ucx_datatype_t *op_data,
 {
     return count << op_data->size_shift;
 }
+
+/* Number of iov entries describing count elements, 0 if the operation has
+ * to use the datatype of op_data */
+__opal_attribute_always_inline__
+static inline size_t mca_pml_ucx_get_iov_count(pml_ucx_datatype_t *op_data,
+                                               size_t count)
+{
+    size_t iov_count = op_data->iov_count * count;
+
+    return (iov_count <= ompi_pml_ucx.iov_max) ? iov_count : 0;
+}
+
+__opal_attribute_always_inline__
+static inline void mca_pml_ucx_fill_iov(pml_ucx_datatype_t *op_data,
+                                        const void *buf, size_t count,
+                                        ucp_dt_iov_t *iov)
+{
+    char *base = (char*)buf;
+    size_t i, j;
+
+    for (i = 0; i < count; ++i, base += op_data->extent) {
+        for (j = 0; j < op_data->iov_count; ++j, ++iov) {
+            iov->buffer = base + (ptrdiff_t)op_data->iov[j].buffer;
+            iov->length = op_data->iov[j].length;
+        }
+    }
+}
 #endif
 
 #endif /* PML_UCX_DATATYPE_H_ */
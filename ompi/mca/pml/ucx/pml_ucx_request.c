@@ -31,7 +31,7 @@ static int mca_pml_ucx_request_free(ompi_request_t **rptr)
 
 static int mca_pml_ucx_request_cancel(ompi_request_t *req, int flag)
 {
-    ucp_request_cancel(ompi_pml_ucx.ucp_worker, req);
+    ucp_request_cancel(mca_pml_ucx_comm_worker(req->req_mpi_object.comm), req);
     return OMPI_SUCCESS;
 }
 
@@ -115,6 +115,22 @@ void mca_pml_ucx_recv_nbx_completion(void *request, ucs_status_t status,
     mca_pml_ucx_recv_completion_internal(request, status, info);
 }
 
+/* user_data is the iov the operation was posted with */
+void mca_pml_ucx_send_iov_nbx_completion(void *request, ucs_status_t status,
+                                         void *user_data)
+{
+    free(user_data);
+    mca_pml_ucx_send_completion_internal(request, status);
+}
+
+void mca_pml_ucx_recv_iov_nbx_completion(void *request, ucs_status_t status,
+                                         const ucp_tag_recv_info_t *info,
+                                         void *user_data)
+{
+    free(user_data);
+    mca_pml_ucx_recv_completion_internal(request, status, info);
+}
+
 static void mca_pml_ucx_persistent_request_detach(mca_pml_ucx_persistent_request_t *preq,
                                                   ompi_request_t *tmp_req)
 {
@@ -169,6 +185,19 @@ void mca_pml_ucx_precv_completion(void *request, ucs_status_t status,
     mca_pml_ucx_preq_completion(tmp_req);
 }
 
+void mca_pml_ucx_psend_nbx_completion(void *request, ucs_status_t status,
+                                      void *user_data)
+{
+    mca_pml_ucx_psend_completion(request, status);
+}
+
+void mca_pml_ucx_precv_nbx_completion(void *request, ucs_status_t status,
+                                      const ucp_tag_recv_info_t *info,
+                                      void *user_data)
+{
+    mca_pml_ucx_precv_completion(request, status, (ucp_tag_recv_info_t*)info);
+}
+
 static void mca_pml_ucx_request_init_common(ompi_request_t* ompi_req,
                                             bool req_persistent,
                                             ompi_request_state_t state,
@@ -220,6 +249,10 @@ static int mca_pml_ucx_persistent_request_free(ompi_request_t **rptr)
          (MCA_PML_BASE_SEND_BUFFERED == preq->send.mode)) {
         OBJ_RELEASE(preq->datatype.ompi_datatype);
     }
+#ifdef HAVE_UCP_REQUEST_PARAM_T
+    free(preq->iov);
+    preq->iov = NULL;
+#endif
     PML_UCX_FREELIST_RETURN(&ompi_pml_ucx.persistent_reqs, &preq->ompi.super);
     *rptr = MPI_REQUEST_NULL;
     return OMPI_SUCCESS;
@@ -230,7 +263,8 @@ static int mca_pml_ucx_persistent_request_cancel(ompi_request_t *req, int flag)
     mca_pml_ucx_persistent_request_t* preq = (mca_pml_ucx_persistent_request_t*)req;
 
     if (preq->tmp_req != NULL) {
-        ucp_request_cancel(ompi_pml_ucx.ucp_worker, preq->tmp_req);
+        ucp_request_cancel(mca_pml_ucx_comm_worker(preq->ompi.req_mpi_object.comm),
+                           preq->tmp_req);
     }
     return OMPI_SUCCESS;
 }
@@ -241,6 +275,9 @@ static void mca_pml_ucx_persisternt_request_construct(mca_pml_ucx_persistent_req
                                     mca_pml_ucx_persistent_request_free,
                                     mca_pml_ucx_persistent_request_cancel);
     req->tmp_req = NULL;
+#ifdef HAVE_UCP_REQUEST_PARAM_T
+    req->iov     = NULL;
+#endif
 }
 
 static void mca_pml_ucx_persisternt_request_destruct(mca_pml_ucx_persistent_request_t* req)
@@ -20,7 +20,9 @@
 enum {
     MCA_PML_UCX_REQUEST_FLAG_SEND         = (1 << 0), /* Persistent send */
     MCA_PML_UCX_REQUEST_FLAG_FREE_CALLED  = (1 << 1),
-    MCA_PML_UCX_REQUEST_FLAG_COMPLETED    = (1 << 2)
+    MCA_PML_UCX_REQUEST_FLAG_COMPLETED    = (1 << 2),
+    MCA_PML_UCX_REQUEST_FLAG_NBX          = (1 << 3)  /* Persistent request with prepared
+                                                         nbx parameters */
 };
 
 /*
@@ -111,6 +113,15 @@ struct pml_ucx_persistent_request {
     struct {
         ucp_tag_t                     tag_mask;
     } recv;
+#ifdef HAVE_UCP_REQUEST_PARAM_T
+    /* Set up once by isend_init/irecv_init so that MPI_Start only posts the
+     * operation: the size in the units of param.datatype and the parameters
+     * with the persistent completion callback */
+    size_t                            length;
+    void                              *data;   /* buffer or iov of the operation */
+    ucp_dt_iov_t                      *iov;
+    ucp_request_param_t               param;
+#endif
 };
 
 
@@ -126,6 +137,13 @@ void mca_pml_ucx_bsend_completion(void *request, ucs_status_t status);
 void mca_pml_ucx_precv_completion(void *request, ucs_status_t status,
                                   ucp_tag_recv_info_t *info);
 
+void mca_pml_ucx_psend_nbx_completion(void *request, ucs_status_t status,
+                                      void *user_data);
+
+void mca_pml_ucx_precv_nbx_completion(void *request, ucs_status_t status,
+                                      const ucp_tag_recv_info_t *info,
+                                      void *user_data);
+
 void mca_pml_ucx_send_nbx_completion(void *request, ucs_status_t status,
                                      void *user_data);
 
@@ -136,6 +154,13 @@ void mca_pml_ucx_recv_nbx_completion(void *request, ucs_status_t status,
                                      const ucp_tag_recv_info_t *info,
                                      void *user_data);
 
+void mca_pml_ucx_send_iov_nbx_completion(void *request, ucs_status_t status,
+                                         void *user_data);
+
+void mca_pml_ucx_recv_iov_nbx_completion(void *request, ucs_status_t status,
+                                         const ucp_tag_recv_info_t *info,
+                                         void *user_data);
+
 void mca_pml_ucx_persistent_request_complete(mca_pml_ucx_persistent_request_t *preq,
                                              ompi_request_t *tmp_req);
 
@@ -30,6 +30,7 @@
 #include "ompi/mca/sharedfp/sharedfp.h"
 #include "ompi/mca/sharedfp/base/base.h"
 #include "ompi/mca/sharedfp/sm/sharedfp_sm.h"
+#include "ompi/mca/osc/base/base.h"
 
 /*
  * *******************************************************************
@@ -69,30 +70,45 @@ int mca_sharedfp_sm_component_init_query(bool enable_progress_threads,
    return OMPI_SUCCESS;
 }
 
-struct mca_sharedfp_base_module_1_0_0_t * mca_sharedfp_sm_component_file_query(ompio_file_t *fh, int *priority)
+bool mca_sharedfp_sm_all_local (ompi_communicator_t *comm)
 {
     int i;
     ompi_proc_t *proc;
-    ompi_communicator_t * comm = fh->f_comm;
     int size = ompi_comm_size(comm);
 
-    *priority = 0;
-
-    /* test, and update priority. All processes have to be
-    ** on a single node.
-    ** original test copied from mca/coll/sm/coll_sm_module.c:
-    */
+    /* original test copied from mca/coll/sm/coll_sm_module.c: */
     ompi_group_t *group = comm->c_local_group;
 
     for (i = 0; i < size; ++i) {
         proc = ompi_group_peer_lookup(group,i);
         if (!OPAL_PROC_ON_LOCAL_NODE(proc->super.proc_flags)){
+            return false;
+        }
+    }
+    return true;
+}
+
+struct mca_sharedfp_base_module_1_0_0_t * mca_sharedfp_sm_component_file_query(ompio_file_t *fh, int *priority)
+{
+    ompi_communicator_t * comm = fh->f_comm;
+
+    *priority = 0;
+
+    /* test, and update priority. With all processes on a single node the
+    ** shared file pointer lives in a shared memory segment, otherwise in
+    ** an RMA window of rank 0, which needs an osc component.
+    */
+    if ( !mca_sharedfp_sm_all_local (comm) ) {
+        if ( 0 >= mca_sharedfp_sm_rma_priority ||
+             opal_list_is_empty (&ompi_osc_base_framework.framework_components) ) {
             opal_output(ompi_sharedfp_base_framework.framework_output,
                         "mca_sharedfp_sm_component_file_query: Disqualifying myself: (%d/%s) "
                         "not all processes are on the same node.",
                         comm->c_contextid, comm->c_name);
             return NULL;
         }
+        *priority = mca_sharedfp_sm_rma_priority;
+        return &sm;
     }
     /* This module can run */
     *priority = mca_sharedfp_sm_priority;
@@ -28,7 +28,8 @@
 #include "ompi/mca/mca.h"
 #include "ompi/mca/sharedfp/sharedfp.h"
 #include "ompi/mca/common/ompio/common_ompio.h"
-#include <semaphore.h>
+#include "ompi/win/win.h"
+#include "opal/sys/atomic.h"
 
 BEGIN_C_DECLS
 
@@ -42,6 +43,7 @@ int mca_sharedfp_sm_module_init (ompio_file_t *file);
 int mca_sharedfp_sm_module_finalize (ompio_file_t *file);
 
 extern int mca_sharedfp_sm_priority;
+extern int mca_sharedfp_sm_rma_priority;
 extern int mca_sharedfp_sm_verbose;
 
 OMPI_MODULE_DECLSPEC extern mca_sharedfp_base_component_2_0_0_t mca_sharedfp_sm_component;
@@ -105,8 +107,7 @@ int mca_sharedfp_sm_iwrite (ompio_file_t *fh,
  *Structures and definitions only for this component
  *--------------------------------------------------------------*/
 struct mca_sharedfp_sm_offset{
-    sem_t mutex;      /* the mutex: a POSIX memory-based unnamed semaphore */
-    long long offset;  /* and the shared file pointer offset */
+    opal_atomic_int64_t offset;  /* the shared file pointer offset, updated atomically */
 };
 
 /*This structure will hang off of the mca_sharedfp_base_data_t's
@@ -117,11 +118,10 @@ struct mca_sharedfp_sm_data
     struct mca_sharedfp_sm_offset * sm_offset_ptr;
     /*save filename so that we can remove the file on close*/
     char * sm_filename;
-    /* The mutex: it will either point to a POSIX memory-based named
-       semaphore, or it will point to the a POSIX memory-based unnamed
-       semaphore located in sm_offset_ptr->mutex. */
-    sem_t *mutex;
-    char *sem_name;    /* Name of the semaphore */
+    /* When the processes span several nodes the shared file pointer is
+       exposed by rank 0 through an RMA window instead of the segment */
+    ompi_win_t *win;
+    OMPI_MPI_OFFSET_TYPE win_offset;
 };
 
 typedef struct mca_sharedfp_sm_data sm_data_global;
@@ -130,6 +130,9 @@ typedef struct mca_sharedfp_sm_data sm_data_global;
 int mca_sharedfp_sm_request_position (ompio_file_t *fh,
                                       int bytes_requested,
                                       OMPI_MPI_OFFSET_TYPE * offset);
+int mca_sharedfp_sm_set_position (ompio_file_t *fh,
+                                  OMPI_MPI_OFFSET_TYPE offset);
+bool mca_sharedfp_sm_all_local (struct ompi_communicator_t *comm);
 /*
  * ******************************************************************
  * ************ functions implemented in this module end ************
@@ -39,6 +39,7 @@ const char *mca_sharedfp_sm_component_version_string =
  * Global variables
  */
 int mca_sharedfp_sm_priority=30;
+int mca_sharedfp_sm_rma_priority=20;
 int mca_sharedfp_sm_verbose=0;
 
 static int sm_register(void);
@@ -78,6 +79,14 @@ static int sm_register(void)
                                            MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY, &mca_sharedfp_sm_priority);
+    mca_sharedfp_sm_rma_priority = 20;
+    (void) mca_base_component_var_register(&mca_sharedfp_sm_component.sharedfpm_version,
+                                           "rma_priority", "Priority of the sm sharedfp component when the "
+                                           "processes span several nodes, the shared file pointer is then "
+                                           "updated with RMA operations. 0 disables it",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_sharedfp_sm_rma_priority);
     mca_sharedfp_sm_verbose = 0;
     (void) mca_base_component_var_register(&mca_sharedfp_sm_component.sharedfpm_version,
                                            "verbose", "Verbosity of the sm sharedfp component",
@@ -40,8 +40,8 @@
 #include "ompi/proc/proc.h"
 #include "ompi/mca/sharedfp/sharedfp.h"
 #include "ompi/mca/sharedfp/base/base.h"
+#include "ompi/mca/osc/osc.h"
 
-#include <semaphore.h>
 #include <sys/mman.h>
 #include <libgen.h>
 #include <unistd.h>
@@ -95,6 +95,31 @@ int mca_sharedfp_sm_file_open (struct ompi_communicator_t *comm,
         return OMPI_ERR_OUT_OF_RESOURCE;
     }
     sm_data->sm_filename=NULL;
+    sm_data->sm_offset_ptr=NULL;
+    sm_data->win=NULL;
+
+    if ( !mca_sharedfp_sm_all_local (comm) ) {
+        /* rank 0 exposes the shared file pointer to the other nodes */
+        sm_data->win_offset = 0;
+        err = ompi_win_create (&sm_data->win_offset, (0 == fh->f_rank) ? sizeof(OMPI_MPI_OFFSET_TYPE) : 0,
+                               sizeof(OMPI_MPI_OFFSET_TYPE), comm, &(MPI_INFO_NULL->super), &sm_data->win);
+        if ( OMPI_SUCCESS != err ) {
+            opal_output(0, "mca_sharedfp_sm_file_open: Error, unable to create the shared file pointer window\n");
+            free(sm_data);
+            free(sh);
+            return err;
+        }
+        err = sm_data->win->w_osc_module->osc_lock_all (MPI_MODE_NOCHECK, sm_data->win);
+        if ( OMPI_SUCCESS != err ) {
+            ompi_win_free (sm_data->win);
+            free(sm_data);
+            free(sh);
+            return err;
+        }
+        sh->selected_module_data = sm_data;
+        fh->f_sharedfp_data = sh;
+        return OMPI_SUCCESS;
+    }
 
 
     /* the shared memory segment is identified opening a file
@@ -173,46 +198,17 @@ int mca_sharedfp_sm_file_open (struct ompi_communicator_t *comm,
         return OMPI_ERROR;
     }
 
-    /* Initialize semaphore so that is shared between processes.           */
-    /* the semaphore is shared by keeping it in the shared memory segment  */
-
-#if defined(HAVE_SEM_OPEN)
-
-#if defined (__APPLE__)
-    sm_data->sem_name = (char*) malloc( sizeof(char) * 32);
-    snprintf(sm_data->sem_name,31,"OMPIO_%s",filename_basename);
-#else
-    sm_data->sem_name = (char*) malloc( sizeof(char) * 253);
-    snprintf(sm_data->sem_name,252,"OMPIO_%s",filename_basename);
-#endif
-
-    if( (sm_data->mutex = sem_open(sm_data->sem_name, O_CREAT, 0644, 1)) != SEM_FAILED ) {
-#elif defined(HAVE_SEM_INIT)
-    sm_data->mutex = &sm_offset_ptr->mutex;
-    if(sem_init(&sm_offset_ptr->mutex, 1, 1) != -1){
-#endif
-        /*If opening was successful*/
-        /*Store the new file handle*/
-        sm_data->sm_offset_ptr = sm_offset_ptr;
-        /* Assign the sm_data to sh->selected_module_data*/
-        sh->selected_module_data   = sm_data;
-        /*remember the shared file handle*/
-        fh->f_sharedfp_data = sh;
-
-        /*write initial zero*/
-        if(fh->f_rank==0){
-            MPI_Offset position=0;
-
-            sem_wait(sm_data->mutex);
-            sm_offset_ptr->offset=position;
-            sem_post(sm_data->mutex);
-        }
-    }else{
-        free(sm_filename);
-        free(sm_data);
-        free(sh);
-        munmap(sm_offset_ptr, sizeof(struct mca_sharedfp_sm_offset));
-        return OMPI_ERROR;
+    /*Store the new file handle*/
+    sm_data->sm_offset_ptr = sm_offset_ptr;
+    /* Assign the sm_data to sh->selected_module_data*/
+    sh->selected_module_data   = sm_data;
+    /*remember the shared file handle*/
+    fh->f_sharedfp_data = sh;
+
+    /*write initial zero*/
+    if(fh->f_rank==0){
+        sm_offset_ptr->offset = 0;
+        opal_atomic_wmb ();
     }
 
     err = comm->c_coll->coll_barrier (comm, comm->c_coll->coll_barrier_module );
@@ -221,16 +217,11 @@ int mca_sharedfp_sm_file_open (struct ompi_communicator_t *comm,
         free(sm_filename);
         free(sm_data);
         free(sh);
+        fh->f_sharedfp_data = NULL;
         munmap(sm_offset_ptr, sizeof(struct mca_sharedfp_sm_offset));
         return err;
     }
 
-#if defined(HAVE_SEM_OPEN)
-    if ( 0 == fh->f_rank ) {
-        sem_unlink ( sm_data->sem_name);
-    }
-#endif
-
     return OMPI_SUCCESS;
 }
 
@@ -255,15 +246,12 @@ int mca_sharedfp_sm_file_close (ompio_file_t *fh)
 
     file_data = (sm_data_global*)(sh->selected_module_data);
     if (file_data)  {
+        if (file_data->win) {
+            file_data->win->w_osc_module->osc_unlock_all (file_data->win);
+            ompi_win_free (file_data->win);
+        }
         /*Close sm handle*/
         if (file_data->sm_offset_ptr) {
-            /* destroy semaphore */
-#if defined(HAVE_SEM_OPEN)
-             sem_close ( file_data->mutex);
-             free (file_data->sem_name);
-#elif defined(HAVE_SEM_INIT)
-            sem_destroy(&file_data->sm_offset_ptr->mutex);
-#endif
             /*Release the shared memory segment.*/
             munmap(file_data->sm_offset_ptr,sizeof(struct mca_sharedfp_sm_offset));
             /*Q: Do we need to delete the file? */
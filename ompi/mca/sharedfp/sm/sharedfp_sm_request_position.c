@@ -24,69 +24,72 @@
 
 #include "mpi.h"
 #include "ompi/constants.h"
+#include "ompi/op/op.h"
+#include "ompi/mca/osc/osc.h"
 #include "ompi/mca/sharedfp/sharedfp.h"
 #include "ompi/mca/sharedfp/base/base.h"
 
-/*use a semaphore to lock the shared memory*/
-#include <semaphore.h>
-
 int mca_sharedfp_sm_request_position(ompio_file_t *fh, 
                                      int bytes_requested,
                                      OMPI_MPI_OFFSET_TYPE *offset)
 {
     int ret = OMPI_SUCCESS;
-    OMPI_MPI_OFFSET_TYPE position = 0;
-    OMPI_MPI_OFFSET_TYPE old_offset;
+    OMPI_MPI_OFFSET_TYPE old_offset, requested = bytes_requested;
     struct mca_sharedfp_sm_data * sm_data = NULL;
-    struct mca_sharedfp_sm_offset * sm_offset_ptr = NULL;
     struct mca_sharedfp_base_data_t *sh = NULL;
 
     sh = fh->f_sharedfp_data;
     sm_data = sh->selected_module_data;
 
     *offset = 0;
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Aquiring lock, rank=%d...",fh->f_rank);
+    if ( NULL != sm_data->win ) {
+        /* the window is locked for the lifetime of the file */
+        ret = sm_data->win->w_osc_module->osc_fetch_and_op (&requested, &old_offset, OMPI_OFFSET_DATATYPE,
+                                                            0, 0, MPI_SUM, sm_data->win);
+        if ( OMPI_SUCCESS == ret ) {
+            ret = sm_data->win->w_osc_module->osc_flush (0, sm_data->win);
+        }
+        if ( OMPI_SUCCESS != ret ) {
+            opal_output(0, "mca_sharedfp_sm_request_position: error %d updating the shared file pointer\n", ret);
+            return ret;
+        }
     }
-
-    sm_offset_ptr = sm_data->sm_offset_ptr;
-
-    /* Aquire an exclusive lock */
-
-    sem_wait(sm_data->mutex);
-
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Succeeded! Acquired sm lock.for rank=%d\n",fh->f_rank);
+    else {
+        old_offset = opal_atomic_fetch_add_64 (&sm_data->sm_offset_ptr->offset, requested);
     }
 
-    old_offset=sm_offset_ptr->offset;
     if ( mca_sharedfp_sm_verbose ) {
         opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Read last_offset=%lld!\n",old_offset);
+                    "old_offset=%lld, bytes_requested=%d, new offset=%lld!\n",old_offset,bytes_requested,
+                    old_offset + requested);
     }
 
-    position = old_offset + bytes_requested;
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "old_offset=%lld, bytes_requested=%d, new offset=%lld!\n",old_offset,bytes_requested,position);
-    }
-    sm_offset_ptr->offset=position;
+    *offset = old_offset;
+
+    return ret;
+}
 
+int mca_sharedfp_sm_set_position (ompio_file_t *fh,
+                                  OMPI_MPI_OFFSET_TYPE offset)
+{
+    int ret = OMPI_SUCCESS;
+    OMPI_MPI_OFFSET_TYPE old_offset;
+    struct mca_sharedfp_sm_data * sm_data = NULL;
+    struct mca_sharedfp_base_data_t *sh = NULL;
 
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Releasing sm lock...rank=%d",fh->f_rank);
-    }
+    sh = fh->f_sharedfp_data;
+    sm_data = sh->selected_module_data;
 
-    sem_post(sm_data->mutex);
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Released lock! released lock.for rank=%d\n",fh->f_rank);
+    if ( NULL != sm_data->win ) {
+        ret = sm_data->win->w_osc_module->osc_fetch_and_op (&offset, &old_offset, OMPI_OFFSET_DATATYPE,
+                                                            0, 0, MPI_REPLACE, sm_data->win);
+        if ( OMPI_SUCCESS == ret ) {
+            ret = sm_data->win->w_osc_module->osc_flush (0, sm_data->win);
+        }
+    }
+    else {
+        (void) opal_atomic_swap_64 (&sm_data->sm_offset_ptr->offset, offset);
     }
-
-    *offset = old_offset;
 
     return ret;
 }
@@ -29,9 +29,6 @@
 #include "ompi/mca/sharedfp/sharedfp.h"
 #include "ompi/mca/sharedfp/base/base.h"
 
-/*use a semaphore to lock the shared memory location*/
-#include <semaphore.h>
-
 int
 mca_sharedfp_sm_seek (ompio_file_t *fh,
                       OMPI_MPI_OFFSET_TYPE off, int whence)
@@ -39,9 +36,6 @@ mca_sharedfp_sm_seek (ompio_file_t *fh,
     int status=0;
     OMPI_MPI_OFFSET_TYPE offset, end_position=0;
     int ret = OMPI_SUCCESS;
-    struct mca_sharedfp_base_data_t *sh = NULL;
-    struct mca_sharedfp_sm_data * sm_data = NULL;
-    struct mca_sharedfp_sm_offset * sm_offset_ptr = NULL;
 
     if( NULL == fh->f_sharedfp_data ) {
         opal_output(ompi_sharedfp_base_framework.framework_output,
@@ -49,7 +43,6 @@ mca_sharedfp_sm_seek (ompio_file_t *fh,
         return OMPI_ERROR;
     }
 
-    sh = fh->f_sharedfp_data;
     offset = off * fh->f_etype_size;
 
     if( 0 == fh->f_rank ){
@@ -104,32 +97,13 @@ mca_sharedfp_sm_seek (ompio_file_t *fh,
         /*-----------------------------------------------------*/
         /* Set Shared file pointer                             */
         /*-----------------------------------------------------*/
-        sm_data = sh->selected_module_data;
-        sm_offset_ptr = sm_data->sm_offset_ptr;
-
-        /*-------------------*/
-        /*lock the file  */
-        /*--------------------*/
-        if ( mca_sharedfp_sm_verbose ) {
-            opal_output(ompi_sharedfp_base_framework.framework_output,
-                        "sharedfp_sm_seek: Aquiring lock, rank=%d...",fh->f_rank); fflush(stdout);
-        }
-
-        /* Aquire an exclusive lock */
-        sm_offset_ptr = sm_data->sm_offset_ptr;
-
-        sem_wait(sm_data->mutex);
-
-        if ( mca_sharedfp_sm_verbose ) {
-            opal_output(ompi_sharedfp_base_framework.framework_output,
-                        "sharedfp_sm_seek: Success! Acquired sm lock.for rank=%d\n",fh->f_rank);
+        if ( OMPI_SUCCESS == ret ) {
+            ret = mca_sharedfp_sm_set_position (fh, offset);
         }
-        sm_offset_ptr->offset=offset;
         if ( mca_sharedfp_sm_verbose ) {
             opal_output(ompi_sharedfp_base_framework.framework_output,
-                        "sharedfp_sm_seek: Releasing sm lock...rank=%d",fh->f_rank); fflush(stdout);
+                        "sharedfp_sm_seek: set the shared file pointer to %lld, rank=%d\n",offset,fh->f_rank);
         }
-        sem_post(sm_data->mutex);
     }
 
     /* since we are only letting process 0, update the current pointer
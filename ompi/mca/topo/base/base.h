@@ -184,6 +184,21 @@ mca_topo_base_dist_graph_create_adjacent(mca_topo_base_module_t* module,
                                          opal_info_t *info, int reorder,
                                          ompi_communicator_t **comm_dist_graph);
 
+/**
+ * Compute the order the neighbor collectives post their requests in: the
+ * off-node neighbors first, so that their transfers overlap with the
+ * shared memory copies to the co-located ones. The relative order of the
+ * edges to a same peer is kept, so duplicate edges still match. Nothing is
+ * stored when all the neighbors are on the same side.
+ */
+OMPI_DECLSPEC int
+mca_topo_base_dist_graph_plan(ompi_communicator_t *comm,
+                              mca_topo_base_comm_dist_graph_2_2_0_t *topo);
+
+/* k-th incoming (resp. outgoing) edge to post, see mca_topo_base_dist_graph_plan */
+#define MCA_TOPO_BASE_DIST_GRAPH_IN(topo, k)  (NULL != (topo)->in_order ? (topo)->in_order[k] : (k))
+#define MCA_TOPO_BASE_DIST_GRAPH_OUT(topo, k) (NULL != (topo)->out_order ? (topo)->out_order[k] : (k))
+
 OMPI_DECLSPEC int
 mca_topo_base_dist_graph_neighbors(ompi_communicator_t *comm,
                                    int maxindegree,
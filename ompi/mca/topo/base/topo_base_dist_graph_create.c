@@ -317,8 +317,10 @@ int mca_topo_base_dist_graph_create(mca_topo_base_module_t* module,
                                               &((*newcomm)->c_topo->mtc.dist_graph));
     if( OMPI_SUCCESS != err ) {
         ompi_comm_free(newcomm);
+        return err;
     }
-    return err;
+
+    return mca_topo_base_dist_graph_plan(*newcomm, (*newcomm)->c_topo->mtc.dist_graph);
 }
 
 static void mca_topo_base_comm_dist_graph_2_2_0_construct(mca_topo_base_comm_dist_graph_2_2_0_t * dist_graph) {
@@ -329,6 +331,10 @@ static void mca_topo_base_comm_dist_graph_2_2_0_construct(mca_topo_base_comm_dis
     dist_graph->indegree = 0;
     dist_graph->outdegree = 0;
     dist_graph->weighted = false;
+    dist_graph->in_order = NULL;
+    dist_graph->out_order = NULL;
+    dist_graph->in_local = 0;
+    dist_graph->out_local = 0;
 }
 
 static void mca_topo_base_comm_dist_graph_2_2_0_destruct(mca_topo_base_comm_dist_graph_2_2_0_t * dist_graph) {
@@ -344,6 +350,12 @@ static void mca_topo_base_comm_dist_graph_2_2_0_destruct(mca_topo_base_comm_dist
     if (NULL != dist_graph->outw) {
         free(dist_graph->outw);
     }
+    if (NULL != dist_graph->in_order) {
+        free(dist_graph->in_order);
+    }
+    if (NULL != dist_graph->out_order) {
+        free(dist_graph->out_order);
+    }
 }
 
 OBJ_CLASS_INSTANCE(mca_topo_base_comm_dist_graph_2_2_0_t, opal_object_t,
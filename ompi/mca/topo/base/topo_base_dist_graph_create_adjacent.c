@@ -99,7 +99,7 @@ int mca_topo_base_dist_graph_create_adjacent(mca_topo_base_module_t* module,
     (*newcomm)->c_topo->reorder        = reorder;
     (*newcomm)->c_flags               |= OMPI_COMM_DIST_GRAPH;
 
-    return OMPI_SUCCESS;
+    return mca_topo_base_dist_graph_plan(*newcomm, topo);
 
  bail_out:
     if (NULL != topo) {
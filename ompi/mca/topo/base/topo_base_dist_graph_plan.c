@@ -0,0 +1,80 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2021      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <stdlib.h>
+
+#include "ompi/communicator/communicator.h"
+#include "ompi/group/group.h"
+#include "ompi/proc/proc.h"
+#include "ompi/mca/topo/base/base.h"
+
+static bool mca_topo_base_peer_is_local(ompi_communicator_t *comm, int rank)
+{
+    ompi_proc_t *proc = ompi_group_get_proc_ptr_raw(comm->c_remote_group, rank);
+
+    if (ompi_proc_is_sentinel(proc)) {
+        /* the procs of the local node are never sentinels (see ompi_proc_complete_init) */
+        return false;
+    }
+
+    return OPAL_PROC_ON_LOCAL_NODE(proc->super.proc_flags);
+}
+
+/* stable partition of the edges, the off-node peers first */
+static int *mca_topo_base_dist_graph_order(ompi_communicator_t *comm, const int *edges,
+                                           int degree, int *nlocal)
+{
+    int *order, nremote = 0;
+
+    *nlocal = 0;
+    if (0 == degree) {
+        return NULL;
+    }
+
+    order = (int *) malloc(2 * degree * sizeof(int));
+    if (NULL == order) {
+        return NULL;
+    }
+
+    for (int i = 0; i < degree; ++i) {
+        if (MPI_PROC_NULL != edges[i] && mca_topo_base_peer_is_local(comm, edges[i])) {
+            order[degree + (*nlocal)++] = i;
+        } else {
+            order[nremote++] = i;
+        }
+    }
+
+    if (0 == *nlocal || 0 == nremote) {
+        /* nothing to reorder */
+        free(order);
+        return NULL;
+    }
+
+    for (int i = 0; i < *nlocal; ++i) {
+        order[nremote + i] = order[degree + i];
+    }
+
+    return order;
+}
+
+int mca_topo_base_dist_graph_plan(ompi_communicator_t *comm,
+                                  mca_topo_base_comm_dist_graph_2_2_0_t *topo)
+{
+    topo->in_order = mca_topo_base_dist_graph_order(comm, topo->in, topo->indegree,
+                                                    &topo->in_local);
+    topo->out_order = mca_topo_base_dist_graph_order(comm, topo->out, topo->outdegree,
+                                                     &topo->out_local);
+
+    return OMPI_SUCCESS;
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_TOPO_NODEBLOCK_H
+#define MCA_TOPO_NODEBLOCK_H
+
+#include "ompi_config.h"
+#include "ompi/mca/topo/topo.h"
+
+/*
+ * The nodeblock component reorders the Cartesian communicators created
+ * with reorder set: the grid is cut in sub-blocks of as many processes as
+ * there are on a node (and each of them in sub-blocks per socket), with
+ * the smallest possible surface, so that most neighbors end up on the same
+ * node. Everything else comes from the base.
+ */
+BEGIN_C_DECLS
+
+typedef struct mca_topo_nodeblock_component_2_2_0_t {
+    mca_topo_base_component_2_2_0_t super;
+
+    int priority;
+    bool socket_blocks;
+} mca_topo_nodeblock_component_2_2_0_t;
+
+/* Public component instance */
+OMPI_MODULE_DECLSPEC extern mca_topo_nodeblock_component_2_2_0_t
+    mca_topo_nodeblock_component;
+
+int mca_topo_nodeblock_cart_create(mca_topo_base_module_t *topo_module,
+                                   ompi_communicator_t* old_comm,
+                                   int ndims,
+                                   const int *dims,
+                                   const int *periods,
+                                   bool reorder,
+                                   ompi_communicator_t** comm_topo);
+
+END_C_DECLS
+
+#endif /* MCA_TOPO_NODEBLOCK_H */
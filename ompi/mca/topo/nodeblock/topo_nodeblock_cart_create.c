@@ -0,0 +1,206 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include <limits.h>
+
+#include "opal/mca/hwloc/base/base.h"
+
+#include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/topo/base/base.h"
+#include "ompi/mca/topo/nodeblock/topo_nodeblock.h"
+
+/*
+ * Look for the block of nelems processes, dividing the grid in every
+ * dimension, with the smallest surface with the other blocks. Returns
+ * the cost of the best block found so far, or -1 if there is none.
+ */
+static int nodeblock_factor(int d, int ndims, const int *dims, const int *periods,
+                            int remain, int nelems, int *cur, int *best, int best_cost)
+{
+    int b, cost, faces, i;
+
+    if( d == ndims - 1 ) {
+        if( 0 != (dims[d] % remain) ) {
+            return best_cost;
+        }
+        cur[d] = remain;
+        for( cost = 0, i = 0; i < ndims; i++ ) {
+            if( dims[i] == cur[i] ) continue;  /* the neighbors are in the block */
+            faces = (periods[i] || (dims[i] / cur[i] > 2)) ? 2 : 1;
+            cost += faces * (nelems / cur[i]);
+        }
+        if( (-1 == best_cost) || (cost < best_cost) ) {
+            memcpy(best, cur, ndims * sizeof(int));
+            best_cost = cost;
+        }
+        return best_cost;
+    }
+    for( b = 1; b <= remain; b++ ) {
+        if( (0 != (remain % b)) || (0 != (dims[d] % b)) ) continue;
+        cur[d] = b;
+        best_cost = nodeblock_factor(d + 1, ndims, dims, periods, remain / b,
+                                     nelems, cur, best, best_cost);
+    }
+    return best_cost;
+}
+
+/* Row-major coordinates of index in a grid, as in mca_topo_base_cart_create */
+static void nodeblock_coords(int index, int ndims, const int *grid, int *coords)
+{
+    int i;
+
+    for( i = ndims - 1; i >= 0; i-- ) {
+        coords[i] = index % grid[i];
+        index /= grid[i];
+    }
+}
+
+/*
+ * The grid is cut in node blocks, laid out in the grid of the nodes, and
+ * each node block in socket blocks. The processes of a node are spread on
+ * the socket blocks in the order of their local ranks, and the new rank of
+ * a process is the rank of its place in the grid.
+ */
+int mca_topo_nodeblock_cart_create(mca_topo_base_module_t *topo_module,
+                                   ompi_communicator_t* old_comm,
+                                   int ndims,
+                                   const int *dims,
+                                   const int *periods,
+                                   bool reorder,
+                                   ompi_communicator_t** comm_topo)
+{
+    ompi_communicator_t *nodecomm = MPI_COMM_NULL, *reordered = NULL;
+    int nprocs = 1, rank, newrank, ppn = 0, lrank = 0, node = 0, is_first = 0;
+    int per_socket, nsockets, vals[2], i, err;
+    int *node_block = NULL, *socket_block = NULL, *grid = NULL, *coords = NULL, *sub = NULL;
+
+    if( !reorder || (0 == ndims) ) {
+        goto no_reorder;
+    }
+    for( i = 0; i < ndims; i++ ) {
+        if( dims[i] <= 0 ) {
+            goto no_reorder;  /* let the base report the error */
+        }
+        nprocs *= dims[i];
+    }
+    if( nprocs > ompi_comm_size(old_comm) ) {
+        goto no_reorder;
+    }
+
+    /* Only the processes part of the grid, as in the base, are counted */
+    rank = ompi_comm_rank(old_comm);
+    err = ompi_comm_split_type(old_comm, (rank < nprocs) ? MPI_COMM_TYPE_SHARED : MPI_UNDEFINED,
+                               rank, NULL, &nodecomm);
+    if( OMPI_SUCCESS != err ) {
+        goto no_reorder;
+    }
+    vals[0] = 0;
+    vals[1] = -INT_MAX;
+    if( MPI_COMM_NULL != nodecomm ) {
+        ppn = ompi_comm_size(nodecomm);
+        lrank = ompi_comm_rank(nodecomm);
+        is_first = (0 == lrank) ? 1 : 0;
+        vals[0] = ppn;
+        vals[1] = -ppn;
+    }
+
+    /* All the nodes must hold as many processes of the grid, and they are
+     * numbered in the order of their lowest rank */
+    err = old_comm->c_coll->coll_allreduce(MPI_IN_PLACE, vals, 2, MPI_INT, MPI_MAX,
+                                           old_comm, old_comm->c_coll->coll_allreduce_module);
+    if( OMPI_SUCCESS != err ) {
+        goto release_and_return;
+    }
+    err = old_comm->c_coll->coll_exscan(&is_first, &node, 1, MPI_INT, MPI_SUM,
+                                        old_comm, old_comm->c_coll->coll_exscan_module);
+    if( OMPI_SUCCESS != err ) {
+        goto release_and_return;
+    }
+    if( 0 == rank ) node = 0;  /* the exscan result is undefined on rank 0 */
+    err = OMPI_ERR_NOT_SUPPORTED;
+    if( (vals[0] != -vals[1]) || (vals[0] <= 1) ) {
+        goto release_and_return;
+    }
+    ppn = vals[0];
+
+    node_block = (int *)malloc(5 * ndims * sizeof(int));
+    if( NULL == node_block ) {
+        err = OMPI_ERR_OUT_OF_RESOURCE;
+        goto release_and_return;
+    }
+    socket_block = node_block + ndims;
+    grid = socket_block + ndims;
+    coords = grid + ndims;
+    sub = coords + ndims;
+
+    /* The same on all the processes, so they all agree to reorder or not */
+    if( -1 == nodeblock_factor(0, ndims, dims, periods, ppn, ppn, sub, node_block, -1) ) {
+        goto release_and_return;
+    }
+
+    /* The sockets only change the order within the node, each node can find
+     * its own socket blocks */
+    per_socket = ppn;
+    if( mca_topo_nodeblock_component.socket_blocks &&
+        (OPAL_SUCCESS == opal_hwloc_base_get_topology()) ) {
+        nsockets = hwloc_get_nbobjs_by_type(opal_hwloc_topology, HWLOC_OBJ_SOCKET);
+        if( (nsockets > 1) && (0 == (ppn % nsockets)) ) {
+            per_socket = ppn / nsockets;
+        }
+    }
+    for( i = 0; i < ndims; i++ ) {
+        grid[i] = (periods[i] && (dims[i] == node_block[i])) ? 1 : 0;
+    }
+    if( (per_socket == ppn) ||
+        (-1 == nodeblock_factor(0, ndims, node_block, grid, per_socket, per_socket,
+                                sub, socket_block, -1)) ) {
+        per_socket = ppn;
+        memcpy(socket_block, node_block, ndims * sizeof(int));
+    }
+
+    newrank = rank;
+    if( MPI_COMM_NULL != nodecomm ) {
+        /* the node block in the grid of the nodes */
+        for( i = 0; i < ndims; i++ ) grid[i] = dims[i] / node_block[i];
+        nodeblock_coords(node, ndims, grid, coords);
+        for( i = 0; i < ndims; i++ ) coords[i] *= node_block[i];
+        /* the socket block in the node block */
+        for( i = 0; i < ndims; i++ ) grid[i] = node_block[i] / socket_block[i];
+        nodeblock_coords(lrank / per_socket, ndims, grid, sub);
+        for( i = 0; i < ndims; i++ ) coords[i] += sub[i] * socket_block[i];
+        /* the process in the socket block */
+        nodeblock_coords(lrank % per_socket, ndims, socket_block, sub);
+        for( newrank = 0, i = 0; i < ndims; i++ ) {
+            newrank = newrank * dims[i] + coords[i] + sub[i];
+        }
+    }
+
+    /* this needs to be optimized but will do for now */
+    err = ompi_comm_split(old_comm, 0, newrank, &reordered, false);
+
+  release_and_return:
+    if( NULL != node_block ) free(node_block);
+    if( MPI_COMM_NULL != nodecomm ) ompi_comm_free(&nodecomm);
+    if( OMPI_SUCCESS == err ) {
+        err = mca_topo_base_cart_create(topo_module, reordered, ndims, dims,
+                                        periods, reorder, comm_topo);
+        ompi_comm_free(&reordered);
+        return err;
+    }
+    /* the reordering is optional */
+  no_reorder:
+    return mca_topo_base_cart_create(topo_module, old_comm, ndims, dims,
+                                     periods, reorder, comm_topo);
+}
@@ -0,0 +1,104 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "ompi/mca/topo/nodeblock/topo_nodeblock.h"
+
+/*
+ * Public string showing the topo nodeblock module version number
+ */
+const char *mca_topo_nodeblock_component_version_string =
+    "Open MPI nodeblock topology MCA component version" OMPI_VERSION;
+
+/*
+ * Local funtions
+ */
+static int init_query(bool enable_progress_threads, bool enable_mpi_threads);
+static struct mca_topo_base_module_t *
+comm_query(const ompi_communicator_t *comm, int *priority, uint32_t type);
+static int nodeblock_register(void);
+
+/*
+ * Public component structure
+ */
+mca_topo_nodeblock_component_2_2_0_t mca_topo_nodeblock_component =
+{
+    .super = {
+        .topoc_version = {
+            MCA_TOPO_BASE_VERSION_2_2_0,
+            .mca_component_name = "nodeblock",
+            .mca_component_major_version = OMPI_MAJOR_VERSION,
+            .mca_component_minor_version = OMPI_MINOR_VERSION,
+            .mca_component_release_version = OMPI_RELEASE_VERSION,
+            .mca_register_component_params = nodeblock_register,
+        },
+
+        .topoc_data = {
+            /* The component is checkpoint ready */
+            MCA_BASE_METADATA_PARAM_CHECKPOINT
+        },
+
+        .topoc_init_query = init_query,
+        .topoc_comm_query = comm_query,
+    },
+    .priority = 50,
+    .socket_blocks = true,
+};
+
+
+static int init_query(bool enable_progress_threads, bool enable_mpi_threads)
+{
+    /* Nothing to do */
+    return OMPI_SUCCESS;
+}
+
+
+static struct mca_topo_base_module_t *
+comm_query(const ompi_communicator_t *comm, int *priority, uint32_t type)
+{
+    mca_topo_base_module_t *nodeblock;
+
+    if( OMPI_COMM_CART != type ) {
+        return NULL;
+    }
+
+    /* Don't use OBJ_NEW, we need to zero the memory or the functions pointers
+     * will not be correctly copied over from the base.
+     */
+    nodeblock = calloc(1, sizeof(mca_topo_base_module_t));
+    if (NULL == nodeblock) {
+        return NULL;
+    }
+    OBJ_CONSTRUCT(nodeblock, mca_topo_base_module_t);
+    nodeblock->topo.cart.cart_create = mca_topo_nodeblock_cart_create;
+
+    *priority = mca_topo_nodeblock_component.priority;
+    nodeblock->type = type;
+    return nodeblock;
+}
+
+static int nodeblock_register(void)
+{
+    mca_base_component_t *c = &mca_topo_nodeblock_component.super.topoc_version;
+
+    (void) mca_base_component_var_register(c, "priority", "Priority of the nodeblock topo component",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_topo_nodeblock_component.priority);
+    (void) mca_base_component_var_register(c, "socket_blocks",
+                                           "Cut the block of each node in sub-blocks per socket, "
+                                           "assuming the consecutive local ranks of a node share a socket",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_topo_nodeblock_component.socket_blocks);
+    return OMPI_SUCCESS;
+}
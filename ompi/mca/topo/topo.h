@@ -108,6 +108,11 @@ typedef struct mca_topo_base_comm_dist_graph_2_2_0_t {
     int *outw;
     int indegree, outdegree;
     bool weighted;
+    /* posting order of the neighbor collectives, NULL for the natural order
+     * (see mca_topo_base_dist_graph_plan) */
+    int *in_order;
+    int *out_order;
+    int in_local, out_local;            /* co-located sources and destinations */
 } mca_topo_base_comm_dist_graph_2_2_0_t;
 typedef mca_topo_base_comm_dist_graph_2_2_0_t mca_topo_base_comm_dist_graph_t;
 
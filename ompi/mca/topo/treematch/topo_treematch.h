@@ -72,6 +72,18 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* module,
                                          const int weights[],
                                          struct opal_info_t *info, int reorder,
                                          ompi_communicator_t **newcomm);
+
+int mca_topo_treematch_cart_create(mca_topo_base_module_t *topo_module,
+                                   ompi_communicator_t* old_comm,
+                                   int ndims,
+                                   const int *dims,
+                                   const int *periods,
+                                   bool reorder,
+                                   ompi_communicator_t** comm_topo);
+
+int mca_topo_treematch_reorder(ompi_communicator_t *comm_old,
+                               mca_topo_base_comm_dist_graph_2_2_0_t *topo,
+                               int reorder_mode, int *newrank);
 /*
  * ******************************************************************
  * ************ functions implemented in this module end ************
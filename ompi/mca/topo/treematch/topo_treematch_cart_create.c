@@ -0,0 +1,98 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "ompi/mca/topo/treematch/topo_treematch.h"
+#include "ompi/mca/topo/base/base.h"
+
+#include "ompi/communicator/communicator.h"
+
+/*
+ * The reordering of a Cartesian topology maps the neighbors of the grid on
+ * the node/socket hierarchy: the grid is turned into the graph of the
+ * neighbors of each process, which is reordered hierarchically, and the
+ * Cartesian communicator is then created on the reordered processes.
+ */
+int mca_topo_treematch_cart_create(mca_topo_base_module_t *topo_module,
+                                   ompi_communicator_t* old_comm,
+                                   int ndims,
+                                   const int *dims,
+                                   const int *periods,
+                                   bool reorder,
+                                   ompi_communicator_t** comm_topo)
+{
+    mca_topo_base_comm_dist_graph_2_2_0_t *graph;
+    ompi_communicator_t *reordered = NULL;
+    int nprocs = 1, rank, newrank, stride, coord, i, err;
+
+    if( !reorder || (0 == ndims) ) {
+        return mca_topo_base_cart_create(topo_module, old_comm, ndims, dims,
+                                         periods, reorder, comm_topo);
+    }
+    for( i = 0; i < ndims; i++ ) {
+        if( dims[i] <= 0 ) {  /* let the base report the error */
+            return mca_topo_base_cart_create(topo_module, old_comm, ndims, dims,
+                                             periods, reorder, comm_topo);
+        }
+        nprocs *= dims[i];
+    }
+    if( nprocs > ompi_comm_size(old_comm) ) {
+        return MPI_ERR_DIMS;
+    }
+
+    graph = OBJ_NEW(mca_topo_base_comm_dist_graph_2_2_0_t);
+    if( NULL == graph ) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    graph->weighted = true;
+
+    /* The processes out of the grid have no neighbor, the one ending up
+     * with their vertices will not be part of the new communicator */
+    rank = ompi_comm_rank(old_comm);
+    if( rank < nprocs ) {
+        graph->out = (int *)malloc(2 * ndims * sizeof(int));
+        graph->outw = (int *)malloc(2 * ndims * sizeof(int));
+        if( (NULL == graph->out) || (NULL == graph->outw) ) {
+            OBJ_RELEASE(graph);
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        /* same row-major ordering as mca_topo_base_cart_create */
+        for( i = ndims - 1, stride = 1; i >= 0; stride *= dims[i--] ) {
+            if( 1 == dims[i] ) continue;
+            coord = (rank / stride) % dims[i];
+            if( (coord > 0) || periods[i] ) {
+                graph->out[graph->outdegree] = rank + (((coord + dims[i] - 1) % dims[i]) - coord) * stride;
+                graph->outw[graph->outdegree++] = 1;
+            }
+            if( (coord < dims[i] - 1) || periods[i] ) {
+                graph->out[graph->outdegree] = rank + (((coord + 1) % dims[i]) - coord) * stride;
+                graph->outw[graph->outdegree++] = 1;
+            }
+        }
+    }
+
+    err = mca_topo_treematch_reorder(old_comm, graph, 2, &newrank);
+    OBJ_RELEASE(graph);
+    if( OMPI_SUCCESS == err ) {
+        err = ompi_comm_split(old_comm, 0, newrank, &reordered, false);
+    }
+    if( OMPI_SUCCESS != err ) {  /* the reordering is optional */
+        return mca_topo_base_cart_create(topo_module, old_comm, ndims, dims,
+                                         periods, reorder, comm_topo);
+    }
+
+    err = mca_topo_base_cart_create(topo_module, reordered, ndims, dims,
+                                    periods, reorder, comm_topo);
+    ompi_comm_free(&reordered);
+    return err;
+}
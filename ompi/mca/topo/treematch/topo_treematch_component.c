@@ -76,26 +76,30 @@ comm_query(const ompi_communicator_t *comm, int *priority, uint32_t type)
 {
     mca_topo_treematch_module_t *treematch;
 
-    if( OMPI_COMM_DIST_GRAPH != type ) {
+    if( (OMPI_COMM_DIST_GRAPH != type) && (OMPI_COMM_CART != type) ) {
         return NULL;
     }
     treematch = OBJ_NEW(mca_topo_treematch_module_t);
     if (NULL == treematch) {
         return NULL;
     }
-    treematch->super.topo.dist_graph.dist_graph_create = mca_topo_treematch_dist_graph_create;
+    if( OMPI_COMM_CART == type ) {
+        treematch->super.topo.cart.cart_create = mca_topo_treematch_cart_create;
+    } else {
+        treematch->super.topo.dist_graph.dist_graph_create = mca_topo_treematch_dist_graph_create;
+    }
 
     /* This component has very low priority -- it's an treematch, after
        all! */
     *priority = 42;
-    treematch->super.type = OMPI_COMM_DIST_GRAPH;
+    treematch->super.type = type;
     return &(treematch->super);
 }
 
 static int mca_topo_treematch_component_register(void)
 {
     (void)mca_base_component_var_register(&mca_topo_treematch_component.super.topoc_version,
-                                          "reorder_mode", "If set the reordering will be done in a partially distributed way (default=0). If partially-distributed only local knowledge will be used, possibly leading to less accurate reordering.", MCA_BASE_VAR_TYPE_INT,
+                                          "reorder_mode", "How the reordering of the distributed graphs is done: 0 centralized (default), 1 partially distributed, only local knowledge will be used, possibly leading to less accurate reordering, 2 hierarchical, the graph is split among the nodes before the reordering within each node. The Cartesian topologies are always reordered hierarchically.", MCA_BASE_VAR_TYPE_INT,
                                           NULL, 0, 0, OPAL_INFO_LVL_2,
                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_topo_treematch_component.reorder_mode);
     return OMPI_SUCCESS;
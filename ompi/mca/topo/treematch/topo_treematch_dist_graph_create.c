@@ -94,6 +94,385 @@ static void dump_double_array( int level, int output_id, char* prolog, char* lin
 }
 #endif
 
+/**
+ * Map the processes of a node on the hardware objects of the node, using the
+ * local communication pattern (num_procs_in_node x num_procs_in_node, indexed
+ * by local rank). Returns the new local rank of each local process.
+ */
+static int *treematch_node_mapping(double *local_pattern, int num_procs_in_node,
+                                   hwloc_obj_t *tracker, int numlevels,
+                                   int num_objs_in_node, int effective_depth,
+                                   int *localrank_to_objnum)
+{
+    tm_topology_t  *tm_topology = NULL;
+    tm_tree_t *comm_tree = NULL;
+    tm_solution_t *sol = NULL;
+    tm_affinity_mat_t *aff_mat = NULL;
+    double **comm_pattern = NULL;
+    int *obj_to_rank_in_lcomm = NULL;
+    hwloc_obj_t object;
+    int *k = NULL;
+    int i, j, idx;
+
+    comm_pattern = (double **)malloc(num_procs_in_node*sizeof(double *));
+    for( i = 0; i < num_procs_in_node; i++ ) {
+        comm_pattern[i] = local_pattern + i * num_procs_in_node;
+    }
+    /* Matrix needs to be symmetric. Beware: as comm_patterns
+     * refers to local_pattern we indirectly alter the content
+     * of local_pattern */
+    for( i = 0; i < num_procs_in_node ; i++ )
+        for( j = i; j < num_procs_in_node ; j++ ) {
+            comm_pattern[i][j] = (comm_pattern[i][j] + comm_pattern[j][i]) / 2;
+            comm_pattern[j][i] = comm_pattern[i][j];
+        }
+
+#ifdef __DEBUG__
+    OPAL_OUTPUT_VERBOSE((10, ompi_topo_base_framework.framework_output,
+                         "========== COMM PATTERN ============= \n"));
+    for(i = 0 ; i < num_procs_in_node ; i++){
+        opal_output_verbose(10, ompi_topo_base_framework.framework_output," %i : ",i);
+        dump_double_array(10, ompi_topo_base_framework.framework_output,
+                          "", "", comm_pattern[i], num_procs_in_node);
+    }
+    opal_output_verbose(10, ompi_topo_base_framework.framework_output,
+                        "======================= \n");
+#endif
+
+    tm_topology  = (tm_topology_t *)malloc(sizeof(tm_topology_t));
+    tm_topology->nb_levels = numlevels;
+    tm_topology->arity     = (int *)calloc(tm_topology->nb_levels, sizeof(int));
+    tm_topology->nb_nodes  = (size_t *)calloc(tm_topology->nb_levels, sizeof(size_t));
+    
+    for(i = 0 ; i < tm_topology->nb_levels ; i++){
+        int nb_objs = hwloc_get_nbobjs_by_depth(opal_hwloc_topology, tracker[i]->depth);
+        tm_topology->nb_nodes[i] = nb_objs;
+        tm_topology->arity[i]    = tracker[i]->arity;
+    }
+
+    
+#ifdef __DEBUG__
+    assert(num_objs_in_node == (int)tm_topology->nb_nodes[tm_topology->nb_levels-1]);
+#endif
+    /* create a table that derives the rank in local (node) comm from the object number */
+    obj_to_rank_in_lcomm = (int *)malloc(num_objs_in_node*sizeof(int));
+    for(i = 0 ; i < num_objs_in_node ; i++) {
+        obj_to_rank_in_lcomm[i] = -1;
+        object = hwloc_get_obj_by_depth(opal_hwloc_topology, effective_depth, i);
+        for( j = 0; j < num_procs_in_node ; j++ )
+            if(localrank_to_objnum[j] == (int)(object->logical_index)) {
+                obj_to_rank_in_lcomm[i] = j;
+                break;
+            }
+    }
+    
+    /* Build process id tab */
+    tm_topology->node_id  = (int *)malloc(num_objs_in_node*sizeof(int));
+    tm_topology->node_rank = (int *)malloc(num_objs_in_node*sizeof(int));
+    for(i = 1 ; i < num_objs_in_node; i++)
+        tm_topology->node_id[i] = tm_topology->node_rank[i] = -1;
+    
+    for( i = 0 ; i < num_objs_in_node ; i++ ) {
+        /*note : we make the hypothesis that logical indexes in hwloc range from
+          0 to N, are contiguous and crescent.  */                   
+        tm_topology->node_id[i] = obj_to_rank_in_lcomm[i];
+        if( obj_to_rank_in_lcomm[i] != -1)
+            tm_topology->node_rank[obj_to_rank_in_lcomm[i]] = i; 
+    }
+    
+    /* unused for now*/
+    tm_topology->cost = (double*)calloc(tm_topology->nb_levels,sizeof(double));
+
+    tm_topology->nb_proc_units = num_objs_in_node;
+    tm_topology->nb_constraints = 0;
+    
+    for(i = 0; i < num_objs_in_node ; i++)
+        if (obj_to_rank_in_lcomm[i] != -1)
+            tm_topology->nb_constraints++;
+    
+    tm_topology->constraints = (int *)calloc(tm_topology->nb_constraints,sizeof(int));
+    for(idx = 0,i = 0; i < num_objs_in_node ; i++)
+        if (obj_to_rank_in_lcomm[i] != -1)
+            tm_topology->constraints[idx++] = obj_to_rank_in_lcomm[i];
+
+    tm_topology->oversub_fact = 1;
+
+#ifdef __DEBUG__
+    assert(num_objs_in_node == (int)tm_topology->nb_nodes[tm_topology->nb_levels-1]);
+    OPAL_OUTPUT_VERBOSE((10, ompi_topo_base_framework.framework_output,
+                         "Levels in topo : %i | num procs in node : %i\n",
+                         tm_topology->nb_levels,num_procs_in_node));
+    for(i = 0; i < tm_topology->nb_levels ; i++) {
+        OPAL_OUTPUT_VERBOSE((10, ompi_topo_base_framework.framework_output,
+                             "Nb objs for level %i : %lu | arity %i\n ",
+                             i, tm_topology->nb_nodes[i],tm_topology->arity[i]));
+    }
+    dump_int_array(10, ompi_topo_base_framework.framework_output,
+                   "", "Obj id ", tm_topology->node_id, tm_topology->nb_nodes[tm_topology->nb_levels-1]);
+    tm_display_topology(tm_topology);
+#endif
+    //tm_optimize_topology(&tm_topology);
+    aff_mat = tm_build_affinity_mat(comm_pattern,num_procs_in_node);
+    comm_tree = tm_build_tree_from_topology(tm_topology,aff_mat, NULL, NULL);
+    sol = tm_compute_mapping(tm_topology, comm_tree);
+
+    assert((int)sol->k_length == num_objs_in_node);
+
+    k = (int *)calloc(sol->k_length, sizeof(int));
+    for(idx = 0 ; idx < (int)sol->k_length ; idx++)
+        k[idx] = sol->k[idx][0];
+
+#ifdef __DEBUG__
+    OPAL_OUTPUT_VERBOSE((10, ompi_topo_base_framework.framework_output,
+                         "====> nb levels : %i\n",tm_topology->nb_levels));
+    dump_int_array(10, ompi_topo_base_framework.framework_output,
+                   "Rank permutation sigma/k : ", "", k, num_procs_in_node);
+    assert(num_procs_in_node == (int)sol->sigma_length);
+    dump_int_array(10, ompi_topo_base_framework.framework_output,
+                   "Matching : ", "", sol->sigma, sol->sigma_length);
+#endif
+    free(obj_to_rank_in_lcomm);
+    free(aff_mat->sum_row);
+    free(aff_mat);
+    free(comm_pattern);
+    tm_free_solution(sol);
+    tm_free_tree(comm_tree);
+    tm_free_topology(tm_topology);
+
+    return k;
+}
+
+/**
+ * Split the vertices of the graph in num_nodes parts, part n holding exactly
+ * node_size[n] vertices, by growing each part breadth-first from the lowest
+ * unassigned vertex. The neighbors of vertex v are nbrs[displs[v]] to
+ * nbrs[displs[v] + degrees[v] - 1]. This is linear in the size of the graph,
+ * and keeps in the same part the vertices close to each other in the graph.
+ */
+static int treematch_grow_parts(int size, const int *degrees, const int *displs,
+                                const int *nbrs, int num_nodes, const int *node_size,
+                                int *assign)
+{
+    int *queue, head, tail, next = 0, need, n, v, i;
+
+    /* a vertex is queued at most once per edge, plus the seeds */
+    queue = (int *)malloc((size + displs[size-1] + degrees[size-1]) * sizeof(int));
+    if (NULL == queue) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    for(v = 0; v < size; v++)
+        assign[v] = -1;
+
+    for(n = 0; n < num_nodes; n++) {
+        need = node_size[n];
+        head = tail = 0;
+        while (need > 0) {
+            if (head == tail) {
+                while (-1 != assign[next]) next++;
+                queue[tail++] = next;
+            }
+            v = queue[head++];
+            if (-1 != assign[v]) continue;
+            assign[v] = n;
+            need--;
+            for(i = 0; i < degrees[v]; i++)
+                if (-1 == assign[nbrs[displs[v] + i]])
+                    queue[tail++] = nbrs[displs[v] + i];
+        }
+    }
+    free(queue);
+    return OMPI_SUCCESS;
+}
+
+/**
+ * Hierarchical reordering: the vertices of the graph are first split among
+ * the nodes, using only the adjacency lists gathered on rank 0 (O(edges), in
+ * place of the O(size^2) communication matrix of the centralized mode). Each
+ * node leader then gets the communication pattern of the vertices of its
+ * node, and maps them on the hardware objects of the node with TreeMatch.
+ * The new rank of a process is the vertex it has been given.
+ */
+static int treematch_hierarchical_reorder(ompi_communicator_t *comm_old,
+                                          mca_topo_base_comm_dist_graph_2_2_0_t *topo,
+                                          int *colors, int num_procs_in_node,
+                                          hwloc_obj_t *tracker, int numlevels,
+                                          int num_objs_in_node, int effective_depth,
+                                          int *localrank_to_objnum, int *newrank)
+{
+    ompi_communicator_t *localcomm = NULL;
+    MPI_Request *reqs = NULL;
+    double *local_pattern = NULL, *row = NULL;
+    int *node_of_rank = NULL, *node_size = NULL, *node_leader = NULL;
+    int *assign = NULL, *pos = NULL, *vlist = NULL, *newranks = NULL, *k = NULL;
+    int *degrees = NULL, *displs = NULL, *nbrs = NULL, *my_nbrs = NULL;
+    int rank, size, node = 0, num_nodes = 0, is_leader, degree, target, i, err;
+
+    rank = ompi_comm_rank(comm_old);
+    size = ompi_comm_size(comm_old);
+
+    if (OMPI_SUCCESS != (err = ompi_comm_split(comm_old, colors[rank], rank,
+                                               &localcomm, false))) {
+        return err;
+    }
+    assert(ompi_comm_size(localcomm) == num_procs_in_node);
+    is_leader = (0 == ompi_comm_rank(localcomm)) ? 1 : 0;
+
+    OPAL_OUTPUT_VERBOSE((10, ompi_topo_base_framework.framework_output,
+                         "========== Hierarchical Reordering ========= \n"));
+
+    /* The nodes are numbered in the order of their leaders, the lowest rank
+     * of each node */
+    if (OMPI_SUCCESS != (err = comm_old->c_coll->coll_exscan(&is_leader, &node, 1, MPI_INT,
+                                                             MPI_SUM, comm_old,
+                                                             comm_old->c_coll->coll_exscan_module)))
+        goto release_and_return;
+    if (0 == rank) node = 0;  /* the exscan result is undefined on rank 0 */
+    if (OMPI_SUCCESS != (err = localcomm->c_coll->coll_bcast(&node, 1, MPI_INT, 0, localcomm,
+                                                             localcomm->c_coll->coll_bcast_module)))
+        goto release_and_return;
+
+    node_of_rank = (int *)malloc(size * sizeof(int));
+    if (OMPI_SUCCESS != (err = comm_old->c_coll->coll_allgather(&node, 1, MPI_INT,
+                                                                node_of_rank, 1, MPI_INT, comm_old,
+                                                                comm_old->c_coll->coll_allgather_module)))
+        goto release_and_return;
+    for(i = 0; i < size; i++)
+        if (node_of_rank[i] >= num_nodes)
+            num_nodes = node_of_rank[i] + 1;
+    node_size = (int *)calloc(num_nodes, sizeof(int));
+    node_leader = (int *)malloc(num_nodes * sizeof(int));
+    for(i = size - 1; i >= 0; i--) {
+        node_size[node_of_rank[i]]++;
+        node_leader[node_of_rank[i]] = i;
+    }
+
+    /* Gather the adjacency lists on rank 0, and split the vertices among the nodes */
+    degree = topo->indegree + topo->outdegree;
+    my_nbrs = (int *)malloc((degree + 1) * sizeof(int));
+    if (topo->indegree > 0)
+        memcpy(my_nbrs, topo->in, topo->indegree * sizeof(int));
+    if (topo->outdegree > 0)
+        memcpy(my_nbrs + topo->indegree, topo->out, topo->outdegree * sizeof(int));
+    if (0 == rank) {
+        degrees = (int *)malloc(size * sizeof(int));
+        displs = (int *)malloc(size * sizeof(int));
+    }
+    if (OMPI_SUCCESS != (err = comm_old->c_coll->coll_gather(&degree, 1, MPI_INT,
+                                                             degrees, 1, MPI_INT, 0, comm_old,
+                                                             comm_old->c_coll->coll_gather_module)))
+        goto release_and_return;
+    if (0 == rank) {
+        displs[0] = 0;
+        for(i = 1; i < size; i++)
+            displs[i] = displs[i-1] + degrees[i-1];
+        nbrs = (int *)malloc((displs[size-1] + degrees[size-1] + 1) * sizeof(int));
+    }
+    if (OMPI_SUCCESS != (err = comm_old->c_coll->coll_gatherv(my_nbrs, degree, MPI_INT,
+                                                              nbrs, degrees, displs, MPI_INT,
+                                                              0, comm_old,
+                                                              comm_old->c_coll->coll_gatherv_module)))
+        goto release_and_return;
+
+    assign = (int *)malloc(size * sizeof(int));
+    if (0 == rank) {
+        err = treematch_grow_parts(size, degrees, displs, nbrs, num_nodes, node_size, assign);
+        /* everybody must take part in the bcast, a failure is reported in assign[0] */
+        if (OMPI_SUCCESS != err) assign[0] = -1;
+    }
+    if (OMPI_SUCCESS != (err = comm_old->c_coll->coll_bcast(assign, size, MPI_INT, 0, comm_old,
+                                                            comm_old->c_coll->coll_bcast_module)))
+        goto release_and_return;
+    if (-1 == assign[0]) {
+        err = OMPI_ERR_OUT_OF_RESOURCE;
+        goto release_and_return;
+    }
+#ifdef __DEBUG__
+    if ( 0 == rank ) {
+        dump_int_array(10, ompi_topo_base_framework.framework_output,
+                       "Vertices to nodes : ", "", assign, size);
+    }
+#endif
+
+    /* Position of each vertex among the vertices given to the same node: the
+     * rows and columns of the communication pattern of the node */
+    pos = (int *)malloc(size * sizeof(int));
+    vlist = (int *)calloc(num_nodes, sizeof(int));  /* per node counters for now */
+    for(i = 0; i < size; i++)
+        pos[i] = vlist[assign[i]]++;
+    free(vlist); vlist = NULL;
+
+    /* Send the weights of my vertex to the leader of the node it is given to */
+    target = assign[rank];
+    row = (double *)calloc(node_size[target], sizeof(double));
+    for(i = 0; i < topo->indegree; i++)
+        if (target == assign[topo->in[i]])
+            row[pos[topo->in[i]]] += (topo->weighted ? topo->inw[i] : 1);
+    for(i = 0; i < topo->outdegree; i++)
+        if (target == assign[topo->out[i]])
+            row[pos[topo->out[i]]] += (topo->weighted ? topo->outw[i] : 1);
+
+    if (is_leader) {
+        vlist = (int *)malloc(num_procs_in_node * sizeof(int));
+        for(i = 0; i < size; i++)
+            if (node == assign[i])
+                vlist[pos[i]] = i;
+        local_pattern = (double *)calloc(num_procs_in_node * num_procs_in_node, sizeof(double));
+        reqs = (MPI_Request *)calloc(num_procs_in_node + 1, sizeof(MPI_Request));
+        for(i = 0; i < num_procs_in_node; i++) {
+            if (OMPI_SUCCESS != (err = MCA_PML_CALL(irecv(local_pattern + i * num_procs_in_node,
+                                                          num_procs_in_node, MPI_DOUBLE, vlist[i],
+                                                          -115, comm_old, &reqs[i]))))
+                goto release_and_return;
+        }
+        if (OMPI_SUCCESS != (err = MCA_PML_CALL(isend(row, node_size[target], MPI_DOUBLE,
+                                                      node_leader[target], -115,
+                                                      MCA_PML_BASE_SEND_STANDARD, comm_old,
+                                                      &reqs[num_procs_in_node]))))
+            goto release_and_return;
+        if (OMPI_SUCCESS != (err = ompi_request_wait_all(num_procs_in_node + 1,
+                                                         reqs, MPI_STATUSES_IGNORE)))
+            goto release_and_return;
+
+        /* Map the vertices of the node on its hardware objects */
+        k = treematch_node_mapping(local_pattern, num_procs_in_node, tracker, numlevels,
+                                   num_objs_in_node, effective_depth, localrank_to_objnum);
+        newranks = (int *)malloc(num_procs_in_node * sizeof(int));
+        for(i = 0; i < num_procs_in_node; i++)
+            newranks[i] = vlist[k[i]];
+#ifdef __DEBUG__
+        dump_int_array(10, ompi_topo_base_framework.framework_output,
+                       "Node new ranks : ", "", newranks, num_procs_in_node);
+#endif
+    } else {
+        if (OMPI_SUCCESS != (err = MCA_PML_CALL(send(row, node_size[target], MPI_DOUBLE,
+                                                     node_leader[target], -115,
+                                                     MCA_PML_BASE_SEND_STANDARD, comm_old))))
+            goto release_and_return;
+    }
+
+    err = localcomm->c_coll->coll_scatter(newranks, 1, MPI_INT, newrank, 1, MPI_INT,
+                                          0, localcomm, localcomm->c_coll->coll_scatter_module);
+
+  release_and_return:
+    if (NULL != reqs) free(reqs);
+    if (NULL != local_pattern) free(local_pattern);
+    if (NULL != row) free(row);
+    if (NULL != node_of_rank) free(node_of_rank);
+    if (NULL != node_size) free(node_size);
+    if (NULL != node_leader) free(node_leader);
+    if (NULL != assign) free(assign);
+    if (NULL != pos) free(pos);
+    if (NULL != vlist) free(vlist);
+    if (NULL != newranks) free(newranks);
+    if (NULL != k) free(k);
+    if (NULL != degrees) free(degrees);  /* only on root */
+    if (NULL != displs) free(displs);
+    if (NULL != nbrs) free(nbrs);
+    if (NULL != my_nbrs) free(my_nbrs);
+    ompi_comm_free(&localcomm);
+    return err;
+}
+
 int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
                                          ompi_communicator_t *comm_old,
                                          int n, const int nodes[],
@@ -102,29 +481,46 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
                                          struct opal_info_t *info, int reorder,
                                          ompi_communicator_t **newcomm)
 {
-    int err;
+    int err, newrank;
 
     if (OMPI_SUCCESS != (err = mca_topo_base_dist_graph_distribute(topo_module, comm_old, n, nodes,
                                                                    degrees, targets, weights,
                                                                    &(topo_module->mtc.dist_graph))))
         return err;
 
-    if(!reorder) {  /* No reorder. Create a new communicator, then   */
-                    /* jump out to attach the dist_graph and return */
-    fallback:
-
-        if( OMPI_SUCCESS == (err = ompi_comm_create(comm_old,
-                                                    comm_old->c_local_group,
-                                                    newcomm))){
-            /* Attach the dist_graph to the newly created communicator */
-            (*newcomm)->c_flags        |= OMPI_COMM_DIST_GRAPH;
-            (*newcomm)->c_topo          = topo_module;
-            (*newcomm)->c_topo->reorder = reorder;
-        }
-        return err;
-    }  /* reorder == yes */
+    /* As the reordering is optional, if we encountered an error during the reordering,
+     * we can safely return with just a duplicate of the original communicator associated
+     * with the topology. */
+    err = OMPI_ERR_NOT_AVAILABLE;
+    if( reorder &&
+        (OMPI_SUCCESS == mca_topo_treematch_reorder(comm_old, topo_module->mtc.dist_graph,
+                                                    mca_topo_treematch_component.reorder_mode,
+                                                    &newrank)) ) {
+        /* this needs to be optimized but will do for now */
+        err = ompi_comm_split(comm_old, 0, newrank, newcomm, false);
+    }
+    if( OMPI_SUCCESS != err )
+        err = ompi_comm_create(comm_old, comm_old->c_local_group, newcomm);
 
-    mca_topo_base_comm_dist_graph_2_2_0_t *topo = NULL;
+    if( OMPI_SUCCESS == err ) {
+        /* Attach the dist_graph to the newly created communicator */
+        (*newcomm)->c_flags        |= OMPI_COMM_DIST_GRAPH;
+        (*newcomm)->c_topo          = topo_module;
+        (*newcomm)->c_topo->reorder = reorder;
+    }
+    return err;
+}
+
+/**
+ * Compute the new rank of the calling process in comm_old, for the graph
+ * described by topo (the adjacency of the vertex of the calling process).
+ * On error the reordering is abandoned, and the ranks should be kept as
+ * they are.
+ */
+int mca_topo_treematch_reorder(ompi_communicator_t *comm_old,
+                               mca_topo_base_comm_dist_graph_2_2_0_t *topo,
+                               int reorder_mode, int *newrank)
+{
     ompi_proc_t *proc = NULL;
     MPI_Request  *reqs = NULL;
     hwloc_cpuset_t set = NULL;
@@ -138,19 +534,18 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
     int depth = 0, effective_depth = 0, obj_rank = -1;
     int num_objs_in_node = 0, num_pus_in_node = 0;
     int numlevels = 0, num_nodes = 0, num_procs_in_node = 0;
-    int rank, size, newrank = -1, hwloc_err, i, j, idx;
+    int rank, size, hwloc_err, i, j, idx, err;
     int oversubscribing_objs = 0, oversubscribed_pus = 0;
     uint32_t val, *pval;
 
     /* We need to know if the processes are bound. We assume all
      * processes are in the same state: all bound or none. */
     if (OPAL_SUCCESS != opal_hwloc_base_get_topology()) {
-        goto fallback;
+        return OMPI_ERR_NOT_AVAILABLE;
     }
     root_obj = hwloc_get_root_obj(opal_hwloc_topology);
-    if (NULL == root_obj) goto fallback;
+    if (NULL == root_obj) return OMPI_ERR_NOT_AVAILABLE;
 
-    topo = topo_module->mtc.dist_graph;
     rank = ompi_comm_rank(comm_old);
     size = ompi_comm_size(comm_old);
 
@@ -205,7 +600,7 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
         free(vpids);
         free(colors);
         free(lindex_to_grank);
-        goto fallback; /* return with success */
+        return OMPI_ERR_NOT_AVAILABLE; /* return with success */
     }
     /* compute local roots ranks in comm_old */
     /* Only the global root needs to do this */
@@ -252,7 +647,7 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
     if( (0 == num_objs_in_node) || (0 == num_pus_in_node) ) {  /* deal with bozo cases: COVERITY 1418505 */
         free(colors);
         free(lindex_to_grank);
-        goto fallback; /* return with success */
+        return OMPI_ERR_NOT_AVAILABLE; /* return with success */
     }
     /* Check for oversubscribing */
     oversubscribing_objs = check_oversubscribing(rank, num_nodes,
@@ -292,7 +687,7 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
                 free(colors);
                 free(lindex_to_grank);
                 hwloc_bitmap_free(set);
-                goto fallback;  /* return with success */
+                return OMPI_ERR_NOT_AVAILABLE;  /* return with success */
             }
 
             hwloc_bitmap_copy(set, object->cpuset);
@@ -320,7 +715,7 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
         free(colors);
         free(lindex_to_grank);
         hwloc_bitmap_free(set);
-        goto fallback;  /* return with success */
+        return OMPI_ERR_NOT_AVAILABLE;  /* return with success */
     }
 
     reqs = (MPI_Request *)calloc(num_procs_in_node-1, sizeof(MPI_Request));
@@ -381,7 +776,7 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
     free(reqs); reqs = NULL;
 
     /* Centralized Reordering */
-    if (0 == mca_topo_treematch_component.reorder_mode) {
+    if (0 == reorder_mode) {
         int *obj_mapping = NULL;
         int num_objs_total = 0;
 
@@ -689,7 +1084,7 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
         /* scatter the ranks */
         /* don't need to convert k from local rank to global rank */
         if (OMPI_SUCCESS != (err = comm_old->c_coll->coll_scatter(k, 1, MPI_INT,
-                                                                  &newrank, 1, MPI_INT,
+                                                                  newrank, 1, MPI_INT,
                                                                   0, comm_old,
                                                                   comm_old->c_coll->coll_scatter_module))) {
             if (NULL != k) { free(k); k = NULL; }
@@ -700,18 +1095,10 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
             free(k);
             k = NULL;
         }
-
-        /* this needs to be optimized but will do for now */
-        if (OMPI_SUCCESS != (err = ompi_comm_split(comm_old, 0, newrank, newcomm, false))) {
-            goto release_and_return;
-        }
-        /* end of TODO */
-
-        /* Attach the dist_graph to the newly created communicator */
-        (*newcomm)->c_flags        |= OMPI_COMM_DIST_GRAPH;
-        (*newcomm)->c_topo          = topo_module;
-        (*newcomm)->c_topo->reorder = reorder;
-
+    } else if (2 == reorder_mode) {  /* hierarchical reordering */
+        err = treematch_hierarchical_reorder(comm_old, topo, colors, num_procs_in_node,
+                                             tracker, numlevels, num_objs_in_node,
+                                             effective_depth, localrank_to_objnum, newrank);
     } else { /* partially distributed reordering */
         int *grank_to_lrank = NULL, *lrank_to_grank = NULL, *marked = NULL;
         int node_position = 0, offset = 0, pos = 0;
@@ -765,143 +1152,14 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
 
         /* The root has now the entire information, so let's crunch it */
         if (rank == lindex_to_grank[0]) {
-            tm_topology_t  *tm_topology = NULL;
-            tm_tree_t *comm_tree = NULL;
-            tm_solution_t *sol = NULL;
-            tm_affinity_mat_t *aff_mat = NULL;
-            double **comm_pattern = NULL;
-            int *obj_to_rank_in_lcomm = NULL;
-
-            comm_pattern = (double **)malloc(num_procs_in_node*sizeof(double *));
-            for( i = 0; i < num_procs_in_node; i++ ) {
-                comm_pattern[i] = local_pattern + i * num_procs_in_node;
-            }
-            /* Matrix needs to be symmetric. Beware: as comm_patterns
-             * refers to local_pattern we indirectly alter the content
-             * of local_pattern */
-            for( i = 0; i < num_procs_in_node ; i++ )
-                for( j = i; j < num_procs_in_node ; j++ ) {
-                    comm_pattern[i][j] = (comm_pattern[i][j] + comm_pattern[j][i]) / 2;
-                    comm_pattern[j][i] = comm_pattern[i][j];
-                }
-
-#ifdef __DEBUG__
-            OPAL_OUTPUT_VERBOSE((10, ompi_topo_base_framework.framework_output,
-                                 "========== COMM PATTERN ============= \n"));
-            for(i = 0 ; i < num_procs_in_node ; i++){
-                opal_output_verbose(10, ompi_topo_base_framework.framework_output," %i : ",i);
-                dump_double_array(10, ompi_topo_base_framework.framework_output,
-                                  "", "", comm_pattern[i], num_procs_in_node);
-            }
-            opal_output_verbose(10, ompi_topo_base_framework.framework_output,
-                                "======================= \n");
-#endif
-
-            tm_topology  = (tm_topology_t *)malloc(sizeof(tm_topology_t));
-            tm_topology->nb_levels = numlevels;
-            tm_topology->arity     = (int *)calloc(tm_topology->nb_levels, sizeof(int));
-            tm_topology->nb_nodes  = (size_t *)calloc(tm_topology->nb_levels, sizeof(size_t));
-            
-            for(i = 0 ; i < tm_topology->nb_levels ; i++){
-                int nb_objs = hwloc_get_nbobjs_by_depth(opal_hwloc_topology, tracker[i]->depth);
-                tm_topology->nb_nodes[i] = nb_objs;
-                tm_topology->arity[i]    = tracker[i]->arity;
-            }
-
-            
-#ifdef __DEBUG__
-            assert(num_objs_in_node == (int)tm_topology->nb_nodes[tm_topology->nb_levels-1]);
-#endif
-            /* create a table that derives the rank in local (node) comm from the object number */
-            obj_to_rank_in_lcomm = (int *)malloc(num_objs_in_node*sizeof(int));
-            for(i = 0 ; i < num_objs_in_node ; i++) {
-                obj_to_rank_in_lcomm[i] = -1;
-                object = hwloc_get_obj_by_depth(opal_hwloc_topology, effective_depth, i);
-                for( j = 0; j < num_procs_in_node ; j++ )
-                    if(localrank_to_objnum[j] == (int)(object->logical_index)) {
-                        obj_to_rank_in_lcomm[i] = j;
-                        break;
-                    }
-            }
-            
-            /* Build process id tab */
-            tm_topology->node_id  = (int *)malloc(num_objs_in_node*sizeof(int));
-            tm_topology->node_rank = (int *)malloc(num_objs_in_node*sizeof(int));
-            for(i = 1 ; i < num_objs_in_node; i++)
-                tm_topology->node_id[i] = tm_topology->node_rank[i] = -1;
-            
-            for( i = 0 ; i < num_objs_in_node ; i++ ) {
-                /*note : we make the hypothesis that logical indexes in hwloc range from
-                  0 to N, are contiguous and crescent.  */                   
-                tm_topology->node_id[i] = obj_to_rank_in_lcomm[i];
-                if( obj_to_rank_in_lcomm[i] != -1)
-                    tm_topology->node_rank[obj_to_rank_in_lcomm[i]] = i; 
-            }
-            
-            /* unused for now*/
-            tm_topology->cost = (double*)calloc(tm_topology->nb_levels,sizeof(double));
-
-            tm_topology->nb_proc_units = num_objs_in_node;
-            tm_topology->nb_constraints = 0;
-            
-            for(i = 0; i < num_objs_in_node ; i++)
-                if (obj_to_rank_in_lcomm[i] != -1)
-                    tm_topology->nb_constraints++;
-            
-            tm_topology->constraints = (int *)calloc(tm_topology->nb_constraints,sizeof(int));
-            for(idx = 0,i = 0; i < num_objs_in_node ; i++)
-                if (obj_to_rank_in_lcomm[i] != -1)
-                    tm_topology->constraints[idx++] = obj_to_rank_in_lcomm[i];
-
-            tm_topology->oversub_fact = 1;
-
-#ifdef __DEBUG__
-            assert(num_objs_in_node == (int)tm_topology->nb_nodes[tm_topology->nb_levels-1]);
-            OPAL_OUTPUT_VERBOSE((10, ompi_topo_base_framework.framework_output,
-                                 "Levels in topo : %i | num procs in node : %i\n",
-                                 tm_topology->nb_levels,num_procs_in_node));
-            for(i = 0; i < tm_topology->nb_levels ; i++) {
-                OPAL_OUTPUT_VERBOSE((10, ompi_topo_base_framework.framework_output,
-                                     "Nb objs for level %i : %lu | arity %i\n ",
-                                     i, tm_topology->nb_nodes[i],tm_topology->arity[i]));
-            }
-            dump_int_array(10, ompi_topo_base_framework.framework_output,
-                           "", "Obj id ", tm_topology->node_id, tm_topology->nb_nodes[tm_topology->nb_levels-1]);
-            tm_display_topology(tm_topology);
-#endif
-            //tm_optimize_topology(&tm_topology);
-            aff_mat = tm_build_affinity_mat(comm_pattern,num_procs_in_node);
-            comm_tree = tm_build_tree_from_topology(tm_topology,aff_mat, NULL, NULL);
-            sol = tm_compute_mapping(tm_topology, comm_tree);
-
-            assert((int)sol->k_length == num_objs_in_node);
-
-            k = (int *)calloc(sol->k_length, sizeof(int));
-            for(idx = 0 ; idx < (int)sol->k_length ; idx++)
-                k[idx] = sol->k[idx][0];
-
-#ifdef __DEBUG__
-            OPAL_OUTPUT_VERBOSE((10, ompi_topo_base_framework.framework_output,
-                                 "====> nb levels : %i\n",tm_topology->nb_levels));
-            dump_int_array(10, ompi_topo_base_framework.framework_output,
-                           "Rank permutation sigma/k : ", "", k, num_procs_in_node);
-            assert(num_procs_in_node == (int)sol->sigma_length);
-            dump_int_array(10, ompi_topo_base_framework.framework_output,
-                           "Matching : ", "", sol->sigma, sol->sigma_length);
-#endif
-            free(obj_to_rank_in_lcomm);
-            free(aff_mat->sum_row);
-            free(aff_mat);
-            free(comm_pattern);
-            tm_free_solution(sol);
-            tm_free_tree(comm_tree);
-            tm_free_topology(tm_topology);
+            k = treematch_node_mapping(local_pattern, num_procs_in_node, tracker, numlevels,
+                                       num_objs_in_node, effective_depth, localrank_to_objnum);
         }
         
         /* Todo : Bcast + group creation */
         /* scatter the ranks */
         if (OMPI_SUCCESS != (err = localcomm->c_coll->coll_scatter(k, 1, MPI_INT,
-                                                                   &newrank, 1, MPI_INT,
+                                                                   newrank, 1, MPI_INT,
                                                                    0, localcomm,
                                                                    localcomm->c_coll->coll_scatter_module))) {
             if (NULL != k) { free(k); k = NULL; };
@@ -930,7 +1188,7 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
           next_iter:
             node_position++;
         }
-        newrank += offset;
+        *newrank += offset;
         free(marked);
 
         if (rank == lindex_to_grank[0]) {
@@ -938,20 +1196,7 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
             k = NULL;
         }
 
-        /* this needs to be optimized but will do for now */
-        if (OMPI_SUCCESS != (err = ompi_comm_split(comm_old, 0, newrank, newcomm, false))) {
-            ompi_comm_free(&localcomm);
-            free(lrank_to_grank);
-            free(grank_to_lrank);
-            goto release_and_return;
-        }
-        /* end of TODO */
-
-        /* Attach the dist_graph to the newly created communicator */
-        (*newcomm)->c_flags        |= OMPI_COMM_DIST_GRAPH;
-        (*newcomm)->c_topo          = topo_module;
-        (*newcomm)->c_topo->reorder = reorder;
-
+        ompi_comm_free(&localcomm);
         free(grank_to_lrank);
         free(lrank_to_grank);
     } /* distributed reordering end */
@@ -965,9 +1210,5 @@ int mca_topo_treematch_dist_graph_create(mca_topo_base_module_t* topo_module,
     if (NULL != nodes_roots) free(nodes_roots);  /* only on root */
     if (NULL != localrank_to_objnum) free(localrank_to_objnum);
     if( NULL != set) hwloc_bitmap_free(set);
-    /* As the reordering is optional, if we encountered an error during the reordering,
-     * we can safely return with just a duplicate of the original communicator associated
-     * with the topology. */
-    if( OMPI_SUCCESS != err ) goto fallback;
-    return OMPI_SUCCESS;
+    return err;
 }
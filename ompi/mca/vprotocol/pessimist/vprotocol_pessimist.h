@@ -40,6 +40,11 @@ typedef struct mca_vprotocol_pessimist_module_t {
     vprotocol_pessimist_mem_event_t *event_buffer;
     size_t event_buffer_length;
     size_t event_buffer_max_length;
+    /* batch on its way to the event logger, and its acknowledgment */
+    vprotocol_pessimist_mem_event_t *event_buffer_inflight;
+    ompi_request_t *el_send_req;
+    ompi_request_t *el_ack_req;
+    vprotocol_pessimist_clock_t el_max_clock;
 
     /* space for allocating events */
     opal_free_list_t events_pool;
@@ -60,7 +65,9 @@ int mca_vprotocol_pessimist_dump(struct ompi_communicator_t* comm, int verbose);
 
 int mca_vprotocol_pessimist_add_procs(struct ompi_proc_t **procs, size_t nprocs);
 int mca_vprotocol_pessimist_del_procs(struct ompi_proc_t **procs, size_t nprocs);
+#ifdef SB_USE_PACK_METHOD
 int mca_vprotocol_pessimist_progress(void);
+#endif
 int mca_vprotocol_pessimist_add_comm(struct ompi_communicator_t* comm);
 int mca_vprotocol_pessimist_del_comm(struct ompi_communicator_t* comm);
 
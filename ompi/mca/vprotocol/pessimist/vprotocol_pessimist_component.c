@@ -14,6 +14,7 @@
 #include "ompi_config.h"
 
 #include "ompi/mca/mca.h"
+#include "opal/runtime/opal_progress.h"
 #include "vprotocol_pessimist.h"
 
 static int mca_vprotocol_pessimist_component_register(void);
@@ -28,6 +29,7 @@ static int _free_list_num;
 static int _free_list_max;
 static int _free_list_inc;
 static int _sender_based_size;
+static int _sender_based_defer_size;
 static int _event_buffer_size;
 static char *_mmap_file_name;
 static int ompi_vprotocol_pessimist_allow_thread_multiple;
@@ -85,6 +87,15 @@ static int mca_vprotocol_pessimist_component_register(void)
                                            "sender_based_chunk", NULL, MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY, &_sender_based_size);
+    _sender_based_defer_size = 4096;
+    (void) mca_base_component_var_register(&mca_vprotocol_pessimist_component.pmlm_version,
+                                           "sender_based_defer_size", "Messages of at least this "
+                                           "many bytes are copied to the sender-based log from the "
+                                           "progress engine or when the send completes, instead of "
+                                           "in the send call (-1 to always copy in the send call)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &_sender_based_defer_size);
     _event_buffer_size = 1024;
     (void) mca_base_component_var_register(&mca_vprotocol_pessimist_component.pmlm_version,
                                            "event_buffer_size", NULL, MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
@@ -165,6 +176,10 @@ mca_vprotocol_pessimist_component_init( int* priority,
     mca_vprotocol_pessimist.event_buffer_length = 0;
     mca_vprotocol_pessimist.event_buffer =
                 (vprotocol_pessimist_mem_event_t *) malloc(_event_buffer_size);
+    mca_vprotocol_pessimist.event_buffer_inflight =
+                (vprotocol_pessimist_mem_event_t *) malloc(_event_buffer_size);
+    mca_vprotocol_pessimist.el_send_req = MPI_REQUEST_NULL;
+    mca_vprotocol_pessimist.el_ack_req = MPI_REQUEST_NULL;
     mca_vprotocol_pessimist.el_comm = MPI_COMM_NULL;
 
     return &mca_vprotocol_pessimist.super;
@@ -174,6 +189,7 @@ static int mca_vprotocol_pessimist_component_finalize(void)
 {
     V_OUTPUT_VERBOSE(500, "vprotocol_pessimist_finalize");
     free(mca_vprotocol_pessimist.event_buffer);
+    free(mca_vprotocol_pessimist.event_buffer_inflight);
     OBJ_DESTRUCT(&mca_vprotocol_pessimist.replay_events);
     OBJ_DESTRUCT(&mca_vprotocol_pessimist.pending_events);
     OBJ_DESTRUCT(&mca_vprotocol_pessimist.events_pool);
@@ -184,10 +200,19 @@ int mca_vprotocol_pessimist_enable(bool enable) {
     if(enable) {
         int ret;
         if((ret = vprotocol_pessimist_sender_based_init(_mmap_file_name,
-                                                 _sender_based_size)) != OMPI_SUCCESS)
+                                                 _sender_based_size,
+                                                 (_sender_based_defer_size < 0) ? SIZE_MAX :
+                                                 (size_t) _sender_based_defer_size)) != OMPI_SUCCESS)
             return ret;
+#ifdef SB_USE_PACK_METHOD
+        opal_progress_register(mca_vprotocol_pessimist_progress);
+#endif
     }
     else {
+#ifdef SB_USE_PACK_METHOD
+        opal_progress_unregister(mca_vprotocol_pessimist_progress);
+#endif
+        vprotocol_pessimist_event_buffer_wait();
         vprotocol_pessimist_sender_based_finalize();
         vprotocol_pessimist_event_logger_disconnect(mca_vprotocol_pessimist.el_comm);
     }
@@ -74,6 +74,61 @@ int vprotocol_pessimist_event_logger_disconnect(ompi_communicator_t *el_comm)
     return OMPI_SUCCESS;
 }
 
+void vprotocol_pessimist_event_buffer_ship(void)
+{
+    int rc;
+    vprotocol_pessimist_mem_event_t *buffer;
+
+    vprotocol_pessimist_event_buffer_wait();
+    if(OPAL_UNLIKELY(ompi_comm_invalid(mca_vprotocol_pessimist.el_comm)))
+    {
+        rc = vprotocol_pessimist_event_logger_connect(0, &mca_vprotocol_pessimist.el_comm);
+        if(OMPI_SUCCESS != rc)
+            OMPI_ERRHANDLER_INVOKE(mca_vprotocol_pessimist.el_comm, rc,
+                                   __FILE__ ": failed to connect to an Event Logger");
+    }
+    rc = mca_pml_v.host_pml.pml_irecv(&mca_vprotocol_pessimist.el_max_clock,
+                                      1, MPI_UNSIGNED_LONG_LONG, 0,
+                                      VPROTOCOL_PESSIMIST_EVENTLOG_ACK,
+                                      mca_vprotocol_pessimist.el_comm,
+                                      &mca_vprotocol_pessimist.el_ack_req);
+    if(OPAL_LIKELY(MPI_SUCCESS == rc))
+        rc = mca_pml_v.host_pml.pml_isend(mca_vprotocol_pessimist.event_buffer,
+                                          mca_vprotocol_pessimist.event_buffer_length *
+                                          sizeof(vprotocol_pessimist_mem_event_t), MPI_BYTE, 0,
+                                          VPROTOCOL_PESSIMIST_EVENTLOG_PUT_EVENTS_CMD,
+                                          MCA_PML_BASE_SEND_STANDARD,
+                                          mca_vprotocol_pessimist.el_comm,
+                                          &mca_vprotocol_pessimist.el_send_req);
+    if(OPAL_UNLIKELY(MPI_SUCCESS != rc))
+        OMPI_ERRHANDLER_INVOKE(mca_vprotocol_pessimist.el_comm, rc,
+                               __FILE__ ": failed logging a set of recovery event");
+
+    /* keep on buffering in the other buffer */
+    buffer = mca_vprotocol_pessimist.event_buffer;
+    mca_vprotocol_pessimist.event_buffer = mca_vprotocol_pessimist.event_buffer_inflight;
+    mca_vprotocol_pessimist.event_buffer_inflight = buffer;
+    mca_vprotocol_pessimist.event_buffer_length = 0;
+}
+
+void vprotocol_pessimist_event_buffer_wait(void)
+{
+    int rc;
+
+    if(MPI_REQUEST_NULL == mca_vprotocol_pessimist.el_send_req)
+        return;
+    rc = mca_pml_v.host_request_fns.req_wait(&mca_vprotocol_pessimist.el_send_req,
+                                             MPI_STATUS_IGNORE);
+    if(OPAL_LIKELY(MPI_SUCCESS == rc))
+        rc = mca_pml_v.host_request_fns.req_wait(&mca_vprotocol_pessimist.el_ack_req,
+                                                 MPI_STATUS_IGNORE);
+    if(OPAL_UNLIKELY(MPI_SUCCESS != rc))
+        OMPI_ERRHANDLER_INVOKE(mca_vprotocol_pessimist.el_comm, rc,
+                               __FILE__ ": failed logging a set of recovery event");
+    mca_vprotocol_pessimist.el_send_req = MPI_REQUEST_NULL;
+    mca_vprotocol_pessimist.el_ack_req = MPI_REQUEST_NULL;
+}
+
 void vprotocol_pessimist_matching_replay(int *src) {
 #if OPAL_ENABLE_DEBUG
     vprotocol_pessimist_clock_t max = 0;
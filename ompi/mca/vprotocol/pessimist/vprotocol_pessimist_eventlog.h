@@ -74,43 +74,15 @@ static inline void vprotocol_pessimist_matching_log_finish(ompi_request_t *req)
     }
 }
 
-#include "ompi/request/request_default.h"
-
-/* Helper macro to actually perform the send to EL. */
-#define __VPROTOCOL_PESSIMIST_SEND_BUFFER() do {                              \
-    if(OPAL_UNLIKELY(mca_vprotocol_pessimist.event_buffer_length))            \
-    {                                                                         \
-        int rc;                                                               \
-        ompi_request_t *req;                                                  \
-        vprotocol_pessimist_clock_t max_clock;                                \
-        if(OPAL_UNLIKELY(ompi_comm_invalid(mca_vprotocol_pessimist.el_comm))) \
-        {                                                                     \
-            rc = vprotocol_pessimist_event_logger_connect(0,                  \
-                                        &mca_vprotocol_pessimist.el_comm);    \
-            if(OMPI_SUCCESS != rc)                                            \
-                OMPI_ERRHANDLER_INVOKE(mca_vprotocol_pessimist.el_comm, rc,   \
-                    __FILE__ ": failed to connect to an Event Logger");       \
-        }                                                                     \
-        rc = mca_pml_v.host_pml.pml_irecv(&max_clock,                         \
-                1, MPI_UNSIGNED_LONG_LONG, 0,                                 \
-                VPROTOCOL_PESSIMIST_EVENTLOG_ACK,                             \
-                mca_vprotocol_pessimist.el_comm, &req);                       \
-        rc = mca_pml_v.host_pml.pml_send(mca_vprotocol_pessimist.event_buffer,\
-                mca_vprotocol_pessimist.event_buffer_length *                 \
-                sizeof(vprotocol_pessimist_mem_event_t), MPI_BYTE, 0,         \
-                VPROTOCOL_PESSIMIST_EVENTLOG_PUT_EVENTS_CMD,                  \
-                MCA_PML_BASE_SEND_STANDARD, mca_vprotocol_pessimist.el_comm); \
-        if(OPAL_UNLIKELY(MPI_SUCCESS != rc))                                  \
-            OMPI_ERRHANDLER_INVOKE(mca_vprotocol_pessimist.el_comm, rc,       \
-                __FILE__ ": failed logging a set of recovery event");         \
-        mca_vprotocol_pessimist.event_buffer_length = 0;                      \
-        rc = mca_pml_v.host_request_fns.req_wait(&req, MPI_STATUS_IGNORE);    \
-        if(OPAL_UNLIKELY(MPI_SUCCESS != rc))                                  \
-            OMPI_ERRHANDLER_INVOKE(mca_vprotocol_pessimist.el_comm, rc,       \
-                __FILE__ ": failed logging a set of recovery event");         \
-    }                                                                         \
-} while(0)
+/** Send the buffered events to the Event Logger, without waiting for them
+  * to be logged. Only one batch is on its way at a time, the events can be
+  * buffered in the other one meanwhile.
+  */
+void vprotocol_pessimist_event_buffer_ship(void);
 
+/** Wait until the batch on its way to the Event Logger is logged
+  */
+void vprotocol_pessimist_event_buffer_wait(void);
 
 /* This function sends any pending event to the Event Logger. All available
  * events are merged into a single message (if small enough).
@@ -151,7 +123,7 @@ static inline void vprotocol_pessimist_event_flush(void)
                 event->u_event;
             if(mca_vprotocol_pessimist.event_buffer_length ==
                mca_vprotocol_pessimist.event_buffer_max_length)
-                __VPROTOCOL_PESSIMIST_SEND_BUFFER();
+                vprotocol_pessimist_event_buffer_ship();
             assert(mca_vprotocol_pessimist.event_buffer_length < mca_vprotocol_pessimist.event_buffer_max_length);
             prv_event = (mca_vprotocol_pessimist_event_t *)
                 opal_list_remove_item(&mca_vprotocol_pessimist.pending_events,
@@ -160,7 +132,11 @@ static inline void vprotocol_pessimist_event_flush(void)
             event = prv_event;
         }
     }
-    __VPROTOCOL_PESSIMIST_SEND_BUFFER();
+    if(OPAL_UNLIKELY(mca_vprotocol_pessimist.event_buffer_length))
+        vprotocol_pessimist_event_buffer_ship();
+    /* The events have to be logged before the next message leaves */
+    if(OPAL_UNLIKELY(MPI_REQUEST_NULL != mca_vprotocol_pessimist.el_send_req))
+        vprotocol_pessimist_event_buffer_wait();
 }
 
 /** Replay matching order according to event list during recovery
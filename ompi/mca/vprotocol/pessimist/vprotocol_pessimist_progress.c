@@ -12,18 +12,13 @@
 #include "vprotocol_pessimist_sender_based.h"
 #include "vprotocol_pessimist.h"
 
-#ifdef SB_USE_PROGRESS_METHOD
+#ifdef SB_USE_PACK_METHOD
 
+/* Registered with opal_progress, after the host PML progress functions:
+ * progress the sender_based copies */
 int mca_vprotocol_pessimist_progress(void)
 {
-    int ret;
-
-    printf("PROGRESS\n");
-    /* First let the real progress take place */
-    ret = mca_pml_v.host_pml.pml_progress();
-    /* Then progess the sender_based copies */
-    vprotocol_pessimist_sb_progress_all_reqs();
-    return ret;
+    return vprotocol_pessimist_sb_progress_all_reqs();
 }
 
 #endif
@@ -80,7 +80,8 @@ static void sb_mmap_free(void)
                      (void *) sb.sb_addr, strerror(errno));
 }
 
-int vprotocol_pessimist_sender_based_init(const char *mmapfile, size_t size)
+int vprotocol_pessimist_sender_based_init(const char *mmapfile, size_t size,
+                                          size_t defer_size)
 {
     char *path;
 #ifdef SB_USE_CONVERTOR_METHOD
@@ -95,7 +96,8 @@ int vprotocol_pessimist_sender_based_init(const char *mmapfile, size_t size)
     sb.sb_pagesize = getpagesize();
     sb.sb_cursor = sb.sb_addr = (uintptr_t) NULL;
     sb.sb_available = 0;
-#ifdef SB_USE_PROGRESS_METHOD
+#ifdef SB_USE_PACK_METHOD
+    sb.sb_defer_size = defer_size;
     OBJ_CONSTRUCT(&sb.sb_sendreq, opal_list_t);
 #endif
 
@@ -112,6 +114,9 @@ void vprotocol_pessimist_sender_based_finalize(void)
     if(((uintptr_t) NULL) != sb.sb_addr)
         sb_mmap_free();
     sb_mmap_file_close();
+#ifdef SB_USE_PACK_METHOD
+    OBJ_DESTRUCT(&sb.sb_sendreq);
+#endif
 }
 
 
@@ -120,6 +125,11 @@ void vprotocol_pessimist_sender_based_finalize(void)
   */
 void vprotocol_pessimist_sender_based_alloc(size_t len)
 {
+#ifdef SB_USE_PACK_METHOD
+    /* the pending copies target the current window */
+    while(!opal_list_is_empty(&sb.sb_sendreq))
+        vprotocol_pessimist_sb_progress_all_reqs();
+#endif
     if(((uintptr_t) NULL) != sb.sb_addr)
         sb_mmap_free();
 #ifdef SB_USE_SELFCOMM_METHOD
@@ -20,9 +20,11 @@
 
 BEGIN_C_DECLS
 
-/** Prepare for using the sender based storage
+/** Prepare for using the sender based storage, the messages of at least
+  * defer_size bytes are copied lazily
   */
-int vprotocol_pessimist_sender_based_init(const char *mmapfile, size_t size);
+int vprotocol_pessimist_sender_based_init(const char *mmapfile, size_t size,
+                                          size_t defer_size);
 
 /** Cleanup mmap etc
   */
@@ -35,28 +37,82 @@ void vprotocol_pessimist_sender_based_alloc(size_t len);
 
 
 /*******************************************************************************
- * Convertor pack (blocking) method (good latency, bad bandwidth)
+ * Convertor pack method (good latency, bad bandwidth). The large messages are
+ * not copied in the send call: the user buffer cannot change until the send
+ * is completed, so they are packed from the progress engine, or when the user
+ * is given the request back.
  */
 #if defined(SB_USE_PACK_METHOD)
-static inline void __SENDER_BASED_METHOD_COPY(mca_pml_base_send_request_t *pmlreq)
+static inline int vprotocol_pessimist_sb_progress_req(mca_pml_base_send_request_t *req)
 {
-    if(0 != pmlreq->req_bytes_packed)
+    mca_vprotocol_pessimist_request_t *ftreq = VPESSIMIST_SEND_FTREQ(req);
+    size_t max_data = 0;
+
+    if(ftreq->sb.bytes_progressed < req->req_bytes_packed)
     {
         opal_convertor_t conv;
-        size_t max_data;
-        size_t zero = 0;
         unsigned int iov_count = 1;
         struct iovec iov;
+        size_t position = ftreq->sb.bytes_progressed;
+        max_data = req->req_bytes_packed - ftreq->sb.bytes_progressed;
+        iov.iov_len = max_data;
+        iov.iov_base = (IOVBASE_TYPE *) (ftreq->sb.cursor + position);
 
-        max_data = iov.iov_len = pmlreq->req_bytes_packed;
-        iov.iov_base = (IOVBASE_TYPE *) VPESSIMIST_SEND_FTREQ(pmlreq)->sb.cursor;
-        opal_convertor_clone_with_position( &pmlreq->req_base.req_convertor,
-                                            &conv, 0, &zero );
+        V_OUTPUT_VERBOSE(80, "pessimist:\tsb\tprgress\t%"PRIpclock"\tsize %lu from position %lu", ftreq->reqid, (unsigned long) max_data, (unsigned long) position);
+        opal_convertor_clone_with_position(&req->req_base.req_convertor,
+                                           &conv, 0, &position );
         opal_convertor_pack(&conv, &iov, &iov_count, &max_data);
+        ftreq->sb.bytes_progressed += max_data;
     }
+    return max_data;
 }
 
-#define __SENDER_BASED_METHOD_FLUSH(REQ)
+static inline void __SENDER_BASED_METHOD_COPY(mca_pml_base_send_request_t *pmlreq)
+{
+    mca_vprotocol_pessimist_request_t *ftreq = VPESSIMIST_SEND_FTREQ(pmlreq);
+
+    ftreq->sb.bytes_progressed = 0;
+    if((0 != pmlreq->req_bytes_packed) &&
+       (pmlreq->req_bytes_packed >= mca_vprotocol_pessimist.sender_based.sb_defer_size))
+    {
+        ftreq->sb.deferred = true;
+        opal_list_append(&mca_vprotocol_pessimist.sender_based.sb_sendreq,
+                         &ftreq->list_item);
+        return;
+    }
+    vprotocol_pessimist_sb_progress_req(pmlreq);
+}
+
+/* Copy the oldest pending message, return 1 if something has been copied */
+static inline int vprotocol_pessimist_sb_progress_all_reqs(void)
+{
+    mca_vprotocol_pessimist_request_t *ftreq;
+
+    if(opal_list_is_empty(&mca_vprotocol_pessimist.sender_based.sb_sendreq))
+        return 0;
+    ftreq = (mca_vprotocol_pessimist_request_t *)
+        opal_list_remove_first(&mca_vprotocol_pessimist.sender_based.sb_sendreq);
+    ftreq->sb.deferred = false;
+    return vprotocol_pessimist_sb_progress_req(VPROTOCOL_SEND_REQ(ftreq)) ? 1 : 0;
+}
+
+static inline void __SENDER_BASED_METHOD_FLUSH(ompi_request_t *req)
+{
+    mca_pml_base_send_request_t *pmlreq = (mca_pml_base_send_request_t *) req;
+
+    if(pmlreq->req_base.req_type == MCA_PML_REQUEST_SEND)
+    {
+        mca_vprotocol_pessimist_request_t *ftreq = VPESSIMIST_SEND_FTREQ(req);
+        if(ftreq->sb.deferred)
+        {
+            opal_list_remove_item(&mca_vprotocol_pessimist.sender_based.sb_sendreq,
+                                  (opal_list_item_t *) ftreq);
+            ftreq->sb.deferred = false;
+            vprotocol_pessimist_sb_progress_req(pmlreq);
+            assert(pmlreq->req_bytes_packed == ftreq->sb.bytes_progressed);
+        }
+    }
+}
 
 
 /*******************************************************************************
@@ -88,78 +144,6 @@ int32_t vprotocol_pessimist_sender_based_convertor_advance(opal_convertor_t*,
      (uintptr_t) ((CONV)->clone_of)))
 
 
-/*******************************************************************************
- * progress method
- */
-#elif defined(SB_USE_PROGRESS_METHOD)
-static inline void __SENDER_BASED_METHOD_COPY(mca_pml_base_send_request_t *req)
-{
-    if(req->req_bytes_packed)
-    {
-        mca_vprotocol_pessimist_send_request_t *ftreq = VPESSIMIST_SEND_FTREQ(req);
-        ftreq->sb.bytes_progressed = 0;
-        opal_list_append(&mca_vprotocol_pessimist.sender_based.sb_sendreq,
-                         &ftreq->list_item);
-    }
-}
-
-static inline int vprotocol_pessimist_sb_progress_req(mca_pml_base_send_request_t *req)
-{
-    mca_vprotocol_pessimist_request_t *ftreq = VPESSIMIST_SEND_FTREQ(req);
-    size_t max_data = 0;
-
-    if(ftreq->sb.bytes_progressed < req->req_bytes_packed)
-    {
-        opal_convertor_t conv;
-        unsigned int iov_count = 1;
-        struct iovec iov;
-        uintptr_t position = ftreq->sb.bytes_progressed;
-        max_data = req->req_bytes_packed - ftreq->sb.bytes_progressed;
-        iov.iov_len = max_data;
-        iov.iov_base = (IOVBASE_TYPE *) (ftreq->sb.cursor + position);
-
-        V_OUTPUT_VERBOSE(80, "pessimist:\tsb\tprgress\t%"PRIpclock"\tsize %lu from position %lu", ftreq->reqid, max_data, position);
-        opal_convertor_clone_with_position(&req->req_base.req_convertor,
-                                           &conv, 0, &position );
-        opal_convertor_pack(&conv, &iov, &iov_count, &max_data);
-        ftreq->sb.bytes_progressed += max_data;
-    }
-    return max_data;
-}
-
-static inline int vprotocol_pessimist_sb_progress_all_reqs(void)
-{
-    int ret = 0;
-
-    /* progress any waiting Sender Based copy */
-    if(!opal_list_is_empty(&mca_vprotocol_pessimist.sender_based.sb_sendreq))
-    {
-        mca_vprotocol_pessimist_request_t *ftreq = (mca_vprotocol_pessimist_request_t *)
-            opal_list_remove_first(&mca_vprotocol_pessimist.sender_based.sb_sendreq);
-        if(vprotocol_pessimist_sb_progress_req(VPROTOCOL_SEND_REQ(ftreq)))
-            ret = 1;
-        opal_list_append(&mca_vprotocol_pessimist.sender_based.sb_sendreq,
-                         &ftreq->list_item);
-    }
-    return ret;
-}
-
-static inline void __SENDER_BASED_METHOD_FLUSH(ompi_request_t *req)
-{
-    mca_pml_base_send_request_t *pmlreq = (mca_pml_base_send_request_t *) req;
-
-    if((pmlreq->req_base.req_type == MCA_PML_REQUEST_SEND) &&
-       pmlreq->req_bytes_packed)
-    {
-        mca_vprotocol_pessimist_request_t *ftreq = VPESSIMIST_SEND_FTREQ(req);
-        assert(!opal_list_is_empty(&mca_vprotocol_pessimist.sender_based.sb_sendreq));
-        opal_list_remove_item(&mca_vprotocol_pessimist.sender_based.sb_sendreq,
-                              (opal_list_item_t *) ftreq);
-        vprotocol_pessimist_sb_progress_req(pmlreq);
-        assert(pmlreq->req_bytes_packed == ftreq->sb.bytes_progressed);
-    }
-}
-
 #endif /* SB_USE_*_METHOD */
 
 
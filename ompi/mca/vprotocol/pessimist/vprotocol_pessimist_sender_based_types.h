@@ -17,10 +17,11 @@
 BEGIN_C_DECLS
 
 /* There is several different ways of packing the data to the sender-based
- * buffer. Just pick one.
+ * buffer. Just pick one. With the pack method, the messages of at least
+ * sb_defer_size bytes are copied later, from the progress engine or at the
+ * latest when the send request is completed.
  */
 #define SB_USE_PACK_METHOD
-#undef SB_USE_PROGRESS_METHOD
 #undef SB_USE_CONVERTOR_METHOD
 
 typedef struct vprotocol_pessimist_sender_based_t
@@ -36,7 +37,8 @@ typedef struct vprotocol_pessimist_sender_based_t
     uintptr_t sb_cursor;    /* current pointer to writeable memory */
     size_t sb_available;    /* available space before end of segment */
 
-#ifdef SB_USE_PROGRESS_METHOD
+#ifdef SB_USE_PACK_METHOD
+    size_t sb_defer_size;   /* smallest message copied lazily */
     opal_list_t sb_sendreq; /* requests that needs to be progressed */
 #endif
 } vprotocol_pessimist_sender_based_t;
@@ -54,6 +56,7 @@ typedef struct vprotocol_pessimist_sender_based_request_t
 {
     uintptr_t cursor;
     size_t bytes_progressed;
+    bool deferred;          /* in the sb_sendreq list, not copied yet */
     convertor_advance_fct_t conv_advance;
     uint32_t conv_flags;
 } vprotocol_pessimist_sender_based_request_t;
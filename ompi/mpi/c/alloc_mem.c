@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2007 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2020 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -26,6 +26,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <strings.h>
 
 #include "ompi/mpi/c/bindings.h"
 #include "ompi/runtime/params.h"
@@ -43,6 +44,16 @@
 
 static const char FUNC_NAME[] = "MPI_Alloc_mem";
 
+/* mpool hints of the values of the mpix_memory_kind info key */
+static const struct {
+    const char *kind;
+    const char *hints;
+} memory_kinds[] = {
+    {"hbw", "mpool=memkind,type=memkind_hbw"},
+    {"default", "mpool=memkind,type=memkind_default"},
+    {"interleave", "mpool=memkind,policy=mempolicy_interleave_all"},
+};
+
 
 int MPI_Alloc_mem(MPI_Aint size, MPI_Info info, void *baseptr)
 {
@@ -77,6 +88,15 @@ int MPI_Alloc_mem(MPI_Aint size, MPI_Info info, void *baseptr)
         (void) ompi_info_get (info, "mpool_hints", &info_str, &flag);
         if (flag) {
             mpool_hints = info_str->string;
+        } else {
+            /* explicit hints win over the memory kind */
+            (void) ompi_info_get (info, "mpix_memory_kind", &info_str, &flag);
+            for (size_t i = 0 ; flag && i < sizeof (memory_kinds) / sizeof (memory_kinds[0]) ; ++i) {
+                if (0 == strcasecmp (info_str->string, memory_kinds[i].kind)) {
+                    mpool_hints = memory_kinds[i].hints;
+                    break;
+                }
+            }
         }
     }
 
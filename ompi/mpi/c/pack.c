@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2007 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2020 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2008 High Performance Computing Center Stuttgart,
@@ -24,6 +24,7 @@
  */
 #include "ompi_config.h"
 #include <stdio.h>
+#include <string.h>
 
 #include "ompi/mpi/c/bindings.h"
 #include "ompi/runtime/params.h"
@@ -32,6 +33,9 @@
 #include "ompi/datatype/ompi_datatype.h"
 #include "opal/datatype/opal_convertor.h"
 #include "ompi/memchecker.h"
+#if OPAL_CUDA_SUPPORT
+#include "opal/mca/common/cuda/common_cuda.h"
+#endif /* OPAL_CUDA_SUPPORT */
 
 #if OMPI_BUILD_MPI_PROFILING
 #if OPAL_HAVE_WEAK_SYMBOLS
@@ -76,6 +80,25 @@ int MPI_Pack(const void *inbuf, int incount, MPI_Datatype datatype,
         OMPI_ERRHANDLER_CHECK(rc, comm, rc, FUNC_NAME);
     }
 
+    /*
+     * A contiguous buffer on the host packs with a single copy, there is no
+     * need to build a convertor.
+     */
+    if( opal_datatype_is_contiguous_memory_layout(&datatype->super, incount)
+#if OPAL_CUDA_SUPPORT
+        && !opal_cuda_check_bufs((char *) outbuf, (char *) inbuf)
+#endif /* OPAL_CUDA_SUPPORT */
+        ) {
+        size = (size_t)incount * datatype->super.size;
+        if( (*position + size) > (unsigned int)outsize ) {
+            return OMPI_ERRHANDLER_INVOKE(comm, MPI_ERR_TRUNCATE, FUNC_NAME);
+        }
+        memcpy( (char*) outbuf + (*position),
+                (const char*) inbuf + datatype->super.true_lb, size );
+        *position += size;
+        return MPI_SUCCESS;
+    }
+
     /*
      * If a datatype's description contains a single element that describes
      * a large vector that path is reasonably optimized in pack/unpack. On
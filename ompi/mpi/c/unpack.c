@@ -2,7 +2,7 @@
  * Copyright (c) 2004-2007 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2020 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2008 High Performance Computing Center Stuttgart,
@@ -21,6 +21,7 @@
  */
 #include "ompi_config.h"
 #include <stdio.h>
+#include <string.h>
 
 #include "ompi/mpi/c/bindings.h"
 #include "ompi/runtime/params.h"
@@ -29,6 +30,9 @@
 #include "ompi/datatype/ompi_datatype.h"
 #include "opal/datatype/opal_convertor.h"
 #include "ompi/memchecker.h"
+#if OPAL_CUDA_SUPPORT
+#include "opal/mca/common/cuda/common_cuda.h"
+#endif /* OPAL_CUDA_SUPPORT */
 
 #if OMPI_BUILD_MPI_PROFILING
 #if OPAL_HAVE_WEAK_SYMBOLS
@@ -78,6 +82,27 @@ int MPI_Unpack(const void *inbuf, int insize, int *position,
         OMPI_ERRHANDLER_CHECK(rc, comm, rc, FUNC_NAME);
     }
 
+    /*
+     * A contiguous buffer on the host unpacks with a single copy, there is
+     * no need to build a convertor.
+     */
+    if( opal_datatype_is_contiguous_memory_layout(&datatype->super, outcount)
+#if OPAL_CUDA_SUPPORT
+        && !opal_cuda_check_bufs((char *) outbuf, (char *) inbuf)
+#endif /* OPAL_CUDA_SUPPORT */
+        ) {
+        if( insize > 0 ) {
+            size = (size_t)outcount * datatype->super.size;
+            if( (*position + size) > (unsigned int)insize ) {
+                return OMPI_ERRHANDLER_INVOKE(comm, MPI_ERR_TRUNCATE, FUNC_NAME);
+            }
+            memcpy( (char*) outbuf + datatype->super.true_lb,
+                    (const char*) inbuf + (*position), size );
+            *position += size;
+        }
+        return MPI_SUCCESS;
+    }
+
    /*
     * If a datatype's description contains a single element that describes
     * a large vector that path is reasonably optimized in pack/unpack. On
@@ -34,6 +34,7 @@
 #include MCA_timer_IMPLEMENTATION_HEADER
 #include "ompi/mpi/c/bindings.h"
 #include "ompi/runtime/mpiruntime.h"
+#include "ompi/runtime/ompi_wtime.h"
 
 #if OMPI_BUILD_MPI_PROFILING
 #if OPAL_HAVE_WEAK_SYMBOLS
@@ -44,6 +45,10 @@
 
 double MPI_Wtick(void)
 {
+    if (ompi_wtime_is_global) {
+        return ompi_wtime_clock.scale;
+    }
+
     /*
      * See https://github.com/open-mpi/ompi/issues/3003
      * to get an idea what's going on here.
@@ -35,6 +35,7 @@
 #include "ompi/mpi/c/bindings.h"
 #include "ompi/runtime/mpiruntime.h"
 #include "ompi/runtime/ompi_spc.h"
+#include "ompi/runtime/ompi_wtime.h"
 
 #if OMPI_BUILD_MPI_PROFILING
 #if OPAL_HAVE_WEAK_SYMBOLS
@@ -65,6 +66,11 @@ double MPI_Wtime(void)
 
     SPC_RECORD(OMPI_SPC_WTIME, 1);
 
+    /* mpi_wtime_global: the cycle counter, on the clock of MPI_COMM_WORLD rank 0 */
+    if (ompi_wtime_is_global) {
+        return ompi_wtime_global();
+    }
+
     /*
      * See https://github.com/open-mpi/ompi/issues/3003 to find out
      * what's happening here.
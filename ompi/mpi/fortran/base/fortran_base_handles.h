@@ -0,0 +1,67 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Inline conversions of the Fortran handles for the bindings on the
+ * critical path (the point-to-point calls, wait and test). They read the
+ * f_to_c tables directly instead of calling PMPI_*_f2c, and return the same
+ * invalid C handle (NULL) for an invalid Fortran handle, the C function
+ * taking the handle reports the error. The checks of MPI_Init are left to
+ * that function as well.
+ */
+
+#ifndef OMPI_FORTRAN_BASE_HANDLES_H
+#define OMPI_FORTRAN_BASE_HANDLES_H
+
+#include "ompi_config.h"
+
+#include "opal/class/opal_pointer_array.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/request/request.h"
+#include "ompi/mpi/fortran/base/fint_2_int.h"
+
+static inline void *ompi_fortran_handle_f2c(opal_pointer_array_t *table, MPI_Fint handle)
+{
+    /* opal_pointer_array_get_item checks the bounds */
+    return opal_pointer_array_get_item(table, OMPI_FINT_2_INT(handle));
+}
+
+static inline MPI_Comm ompi_fortran_comm_f2c(MPI_Fint comm)
+{
+    return (MPI_Comm) ompi_fortran_handle_f2c(&ompi_comm_f_to_c_table, comm);
+}
+
+static inline MPI_Datatype ompi_fortran_type_f2c(MPI_Fint datatype)
+{
+    return (MPI_Datatype) ompi_fortran_handle_f2c(&ompi_datatype_f_to_c_table, datatype);
+}
+
+static inline MPI_Request ompi_fortran_request_f2c(MPI_Fint request)
+{
+    return (MPI_Request) ompi_fortran_handle_f2c(&ompi_request_f_to_c_table, request);
+}
+
+/*
+ * Same as PMPI_Request_c2f for a valid request: the request enters the
+ * f_to_c table the first time it is converted.
+ */
+static inline MPI_Fint ompi_fortran_request_c2f(MPI_Request request)
+{
+    if (MPI_UNDEFINED == request->req_f_to_c_index) {
+        request->req_f_to_c_index = opal_pointer_array_add(&ompi_request_f_to_c_table, request);
+    }
+
+    return OMPI_INT_2_FINT(request->req_f_to_c_index);
+}
+
+#endif /* OMPI_FORTRAN_BASE_HANDLES_H */
@@ -23,6 +23,7 @@
 
 #include "ompi/mpi/fortran/mpif-h/bindings.h"
 #include "ompi/mpi/fortran/base/constants.h"
+#include "ompi/mpi/fortran/base/fortran_base_handles.h"
 
 #if OMPI_BUILD_MPI_PROFILING
 #if OPAL_HAVE_WEAK_SYMBOLS
@@ -72,11 +73,11 @@ void ompi_irecv_f(char *buf, MPI_Fint *count, MPI_Fint *datatype,
 		 MPI_Fint *request, MPI_Fint *ierr)
 {
    int c_ierr;
-   MPI_Datatype c_type = PMPI_Type_f2c(*datatype);
+   MPI_Datatype c_type = ompi_fortran_type_f2c(*datatype);
    MPI_Request c_req;
    MPI_Comm c_comm;
 
-   c_comm = PMPI_Comm_f2c (*comm);
+   c_comm = ompi_fortran_comm_f2c(*comm);
 
    c_ierr = PMPI_Irecv(OMPI_F2C_BOTTOM(buf), OMPI_FINT_2_INT(*count),
                       c_type, OMPI_FINT_2_INT(*source),
@@ -84,6 +85,6 @@ void ompi_irecv_f(char *buf, MPI_Fint *count, MPI_Fint *datatype,
    if (NULL != ierr) *ierr = OMPI_INT_2_FINT(c_ierr);
 
    if (MPI_SUCCESS == c_ierr) {
-      *request = PMPI_Request_c2f(c_req);
+      *request = ompi_fortran_request_c2f(c_req);
    }
 }
@@ -23,6 +23,7 @@
 
 #include "ompi/mpi/fortran/mpif-h/bindings.h"
 #include "ompi/mpi/fortran/base/constants.h"
+#include "ompi/mpi/fortran/base/fortran_base_handles.h"
 
 #if OMPI_BUILD_MPI_PROFILING
 #if OPAL_HAVE_WEAK_SYMBOLS
@@ -70,11 +71,11 @@ OMPI_GENERATE_F77_BINDINGS (MPI_ISEND,
 void ompi_isend_f(char *buf, MPI_Fint *count, MPI_Fint *datatype, MPI_Fint *dest, MPI_Fint *tag, MPI_Fint *comm, MPI_Fint *request, MPI_Fint *ierr)
 {
    int c_ierr;
-   MPI_Datatype c_type = PMPI_Type_f2c(*datatype);
+   MPI_Datatype c_type = ompi_fortran_type_f2c(*datatype);
    MPI_Request c_req;
    MPI_Comm c_comm;
 
-   c_comm = PMPI_Comm_f2c (*comm);
+   c_comm = ompi_fortran_comm_f2c(*comm);
 
    c_ierr = PMPI_Isend(OMPI_F2C_BOTTOM(buf), OMPI_FINT_2_INT(*count),
                       c_type, OMPI_FINT_2_INT(*dest),
@@ -83,6 +84,6 @@ void ompi_isend_f(char *buf, MPI_Fint *count, MPI_Fint *datatype, MPI_Fint *dest
    if (NULL != ierr) *ierr = OMPI_INT_2_FINT(c_ierr);
 
    if (MPI_SUCCESS == c_ierr) {
-      *request = PMPI_Request_c2f(c_req);
+      *request = ompi_fortran_request_c2f(c_req);
    }
 }
@@ -25,6 +25,7 @@
 #include "ompi/mpi/fortran/mpif-h/bindings.h"
 #include "ompi/mpi/fortran/mpif-h/status-conversion.h"
 #include "ompi/mpi/fortran/base/constants.h"
+#include "ompi/mpi/fortran/base/fortran_base_handles.h"
 #include "ompi/communicator/communicator.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -75,8 +76,8 @@ void ompi_recv_f(char *buf, MPI_Fint *count, MPI_Fint *datatype,
                 MPI_Fint *status, MPI_Fint *ierr)
 {
     OMPI_FORTRAN_STATUS_DECLARATION(c_status,c_status2)
-   MPI_Comm c_comm = PMPI_Comm_f2c(*comm);
-   MPI_Datatype c_type = PMPI_Type_f2c(*datatype);
+   MPI_Comm c_comm = ompi_fortran_comm_f2c(*comm);
+   MPI_Datatype c_type = ompi_fortran_type_f2c(*datatype);
    int c_ierr;
 
     OMPI_FORTRAN_STATUS_SET_POINTER(c_status,c_status2,status)
@@ -23,6 +23,7 @@
 
 #include "ompi/mpi/fortran/mpif-h/bindings.h"
 #include "ompi/mpi/fortran/base/constants.h"
+#include "ompi/mpi/fortran/base/fortran_base_handles.h"
 
 #if OMPI_BUILD_MPI_PROFILING
 #if OPAL_HAVE_WEAK_SYMBOLS
@@ -72,8 +73,8 @@ void ompi_send_f(char *buf, MPI_Fint *count, MPI_Fint *datatype,
 {
     int c_ierr;
 
-    MPI_Comm c_comm = PMPI_Comm_f2c(*comm);
-    MPI_Datatype c_type = PMPI_Type_f2c(*datatype);
+    MPI_Comm c_comm = ompi_fortran_comm_f2c(*comm);
+    MPI_Datatype c_type = ompi_fortran_type_f2c(*datatype);
 
     c_ierr = PMPI_Send(OMPI_F2C_BOTTOM(buf), OMPI_FINT_2_INT(*count),
                       c_type, OMPI_FINT_2_INT(*dest),
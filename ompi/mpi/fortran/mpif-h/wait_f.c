@@ -23,6 +23,7 @@
 
 #include "ompi/mpi/fortran/mpif-h/bindings.h"
 #include "ompi/mpi/fortran/base/constants.h"
+#include "ompi/mpi/fortran/base/fortran_base_handles.h"
 
 #if OMPI_BUILD_MPI_PROFILING
 #if OPAL_HAVE_WEAK_SYMBOLS
@@ -70,7 +71,7 @@ OMPI_GENERATE_F77_BINDINGS (MPI_WAIT,
 void ompi_wait_f(MPI_Fint *request, MPI_Fint *status, MPI_Fint *ierr)
 {
     int c_ierr;
-    MPI_Request c_req = PMPI_Request_f2c(*request);
+    MPI_Request c_req = ompi_fortran_request_f2c(*request);
     MPI_Status  c_status;
 
     c_ierr = PMPI_Wait(&c_req, &c_status);
@@ -0,0 +1,63 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi/mpi/tool/mpit-internal.h"
+#include "ompi/info/info.h"
+
+#if OPAL_HAVE_WEAK_SYMBOLS && OMPI_PROFILING_DEFINES
+#pragma weak MPI_T_event_callback_set_info = PMPI_T_event_callback_set_info
+#endif
+
+#if OMPI_PROFILING_DEFINES
+#include "ompi/mpi/tool/profile/defines.h"
+#endif
+
+
+int MPI_T_event_callback_set_info (MPI_T_event_registration event_registration,
+                                   MPI_T_cb_safety cb_safety, MPI_Info info)
+{
+    mca_base_event_callback_t *callback;
+    int ret = MPI_SUCCESS;
+
+    if (!mpit_is_initialized ()) {
+        return MPI_T_ERR_NOT_INITIALIZED;
+    }
+
+    if (MPI_PARAM_CHECK) {
+        if (NULL == event_registration) {
+            return MPI_T_ERR_INVALID_HANDLE;
+        }
+        if (cb_safety < MPI_T_CB_REQUIRE_NONE || cb_safety > MPI_T_CB_REQUIRE_ASYNC_SIGNAL_SAFE) {
+            return MPI_T_ERR_INVALID;
+        }
+    }
+
+    if (MPI_INFO_NULL == info) {
+        return MPI_SUCCESS;
+    }
+
+    ompi_mpit_lock ();
+
+    callback = &event_registration->callbacks[cb_safety];
+    if (NULL == callback->info) {
+        callback->info = OBJ_NEW(opal_info_t);
+    }
+    if (NULL == callback->info) {
+        ret = MPI_T_ERR_MEMORY;
+    } else {
+        ret = ompit_opal_to_mpit_error (opal_info_dup (&info->super, &callback->info));
+    }
+
+    ompi_mpit_unlock ();
+
+    return ret;
+}
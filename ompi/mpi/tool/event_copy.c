@@ -0,0 +1,44 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi/mpi/tool/mpit-internal.h"
+
+#if OPAL_HAVE_WEAK_SYMBOLS && OMPI_PROFILING_DEFINES
+#pragma weak MPI_T_event_copy = PMPI_T_event_copy
+#endif
+
+#if OMPI_PROFILING_DEFINES
+#include "ompi/mpi/tool/profile/defines.h"
+#endif
+
+
+int MPI_T_event_copy (MPI_T_event_instance event_instance, void *buffer)
+{
+    if (!mpit_is_initialized ()) {
+        return MPI_T_ERR_NOT_INITIALIZED;
+    }
+
+    if (MPI_PARAM_CHECK) {
+        if (NULL == event_instance) {
+            return MPI_T_ERR_INVALID_HANDLE;
+        }
+        if (NULL == buffer) {
+            return MPI_T_ERR_INVALID;
+        }
+    }
+
+    /* the elements are laid out at the displacements returned by
+       MPI_T_event_get_info() */
+    memcpy (buffer, event_instance->data, event_instance->event->extent);
+
+    return MPI_SUCCESS;
+}
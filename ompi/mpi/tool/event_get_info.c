@@ -0,0 +1,93 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi/mpi/tool/mpit-internal.h"
+#include "ompi/info/info.h"
+
+#if OPAL_HAVE_WEAK_SYMBOLS && OMPI_PROFILING_DEFINES
+#pragma weak MPI_T_event_get_info = PMPI_T_event_get_info
+#endif
+
+#if OMPI_PROFILING_DEFINES
+#include "ompi/mpi/tool/profile/defines.h"
+#endif
+
+
+int MPI_T_event_get_info (int event_index, char *name, int *name_len, int *verbosity,
+                          MPI_Datatype array_of_datatypes[], MPI_Aint array_of_displacements[],
+                          int *num_elements, MPI_T_enum *enumtype, MPI_Info *info, char *desc,
+                          int *desc_len, int *bind)
+{
+    mca_base_event_t *event;
+    int ret, i, count;
+
+    if (!mpit_is_initialized ()) {
+        return MPI_T_ERR_NOT_INITIALIZED;
+    }
+
+    ompi_mpit_lock ();
+
+    do {
+        /* Find the event. mca_base_event_get() handles the bounds checking. */
+        ret = mca_base_event_get (event_index, &event);
+        if (OMPI_SUCCESS != ret) {
+            ret = (OPAL_ERR_NOT_FOUND == ret) ? MPI_T_ERR_INVALID_INDEX : MPI_T_ERR_INVALID;
+            break;
+        }
+
+        /* Copy name an description */
+        mpit_copy_string (name, name_len, event->name);
+        mpit_copy_string (desc, desc_len, event->description);
+
+        if (verbosity) {
+            *verbosity = event->verbosity;
+        }
+
+        /* The arrays are filled up to the length given in num_elements, the
+           number of elements of the event is returned in it */
+        if (NULL != num_elements) {
+            count = (NULL == array_of_datatypes && NULL == array_of_displacements) ? 0 : *num_elements;
+            for (i = 0 ; i < count && i < event->num_elements ; ++i) {
+                if (NULL != array_of_datatypes) {
+                    (void) ompit_var_type_to_datatype (event->types[i], array_of_datatypes + i);
+                }
+                if (NULL != array_of_displacements) {
+                    array_of_displacements[i] = (MPI_Aint) event->offsets[i];
+                }
+            }
+            *num_elements = event->num_elements;
+        }
+
+        if (NULL != enumtype) {
+            *enumtype = event->enumerator ? (MPI_T_enum) event->enumerator : MPI_T_ENUM_NULL;
+        }
+
+        if (NULL != info) {
+            /* no hints are defined for the events */
+            *info = OBJ_NEW(ompi_info_t);
+            if (NULL == *info) {
+                ret = MPI_T_ERR_MEMORY;
+                break;
+            }
+        }
+
+        if (NULL != bind) {
+            *bind = event->bind;
+        }
+
+        ret = MPI_SUCCESS;
+    } while (0);
+
+    ompi_mpit_unlock ();
+
+    return ret;
+}
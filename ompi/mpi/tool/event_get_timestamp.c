@@ -0,0 +1,42 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi/mpi/tool/mpit-internal.h"
+
+#if OPAL_HAVE_WEAK_SYMBOLS && OMPI_PROFILING_DEFINES
+#pragma weak MPI_T_event_get_timestamp = PMPI_T_event_get_timestamp
+#endif
+
+#if OMPI_PROFILING_DEFINES
+#include "ompi/mpi/tool/profile/defines.h"
+#endif
+
+
+int MPI_T_event_get_timestamp (MPI_T_event_instance event_instance, MPI_Count *event_timestamp)
+{
+    if (!mpit_is_initialized ()) {
+        return MPI_T_ERR_NOT_INITIALIZED;
+    }
+
+    if (MPI_PARAM_CHECK) {
+        if (NULL == event_instance) {
+            return MPI_T_ERR_INVALID_HANDLE;
+        }
+        if (NULL == event_timestamp) {
+            return MPI_T_ERR_INVALID;
+        }
+    }
+
+    *event_timestamp = (MPI_Count) event_instance->timestamp;
+
+    return MPI_SUCCESS;
+}
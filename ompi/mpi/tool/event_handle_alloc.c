@@ -0,0 +1,56 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi/mpi/tool/mpit-internal.h"
+
+#if OPAL_HAVE_WEAK_SYMBOLS && OMPI_PROFILING_DEFINES
+#pragma weak MPI_T_event_handle_alloc = PMPI_T_event_handle_alloc
+#endif
+
+#if OMPI_PROFILING_DEFINES
+#include "ompi/mpi/tool/profile/defines.h"
+#endif
+
+
+int MPI_T_event_handle_alloc (int event_index, void *obj_handle, MPI_Info info,
+                              MPI_T_event_registration *event_registration)
+{
+    mca_base_event_t *event;
+    int ret;
+
+    if (!mpit_is_initialized ()) {
+        return MPI_T_ERR_NOT_INITIALIZED;
+    }
+
+    if (MPI_PARAM_CHECK && NULL == event_registration) {
+        return MPI_T_ERR_INVALID;
+    }
+
+    ompi_mpit_lock ();
+
+    do {
+        ret = mca_base_event_get (event_index, &event);
+        if (OMPI_SUCCESS != ret) {
+            ret = (OPAL_ERR_NOT_FOUND == ret) ? MPI_T_ERR_INVALID_INDEX : MPI_T_ERR_INVALID;
+            break;
+        }
+
+        ret = mca_base_event_handle_alloc (event, obj_handle,
+                                           (MPI_INFO_NULL == info) ? NULL : &info->super,
+                                           event_registration);
+        ret = ompit_opal_to_mpit_error (ret);
+    } while (0);
+
+    ompi_mpit_unlock ();
+
+    return ret;
+}
@@ -0,0 +1,57 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi/mpi/tool/mpit-internal.h"
+#include "ompi/info/info.h"
+
+#if OPAL_HAVE_WEAK_SYMBOLS && OMPI_PROFILING_DEFINES
+#pragma weak MPI_T_event_handle_set_info = PMPI_T_event_handle_set_info
+#endif
+
+#if OMPI_PROFILING_DEFINES
+#include "ompi/mpi/tool/profile/defines.h"
+#endif
+
+
+int MPI_T_event_handle_set_info (MPI_T_event_registration event_registration, MPI_Info info)
+{
+    int ret = MPI_SUCCESS;
+
+    if (!mpit_is_initialized ()) {
+        return MPI_T_ERR_NOT_INITIALIZED;
+    }
+
+    if (MPI_PARAM_CHECK && NULL == event_registration) {
+        return MPI_T_ERR_INVALID_HANDLE;
+    }
+
+    if (MPI_INFO_NULL == info) {
+        return MPI_SUCCESS;
+    }
+
+    ompi_mpit_lock ();
+
+    /* no hints are defined for the events, the keys are only kept to be
+       returned by MPI_T_event_handle_get_info() */
+    if (NULL == event_registration->info) {
+        event_registration->info = OBJ_NEW(opal_info_t);
+    }
+    if (NULL == event_registration->info) {
+        ret = MPI_T_ERR_MEMORY;
+    } else {
+        ret = ompit_opal_to_mpit_error (opal_info_dup (&info->super, &event_registration->info));
+    }
+
+    ompi_mpit_unlock ();
+
+    return ret;
+}
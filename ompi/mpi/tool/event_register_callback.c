@@ -0,0 +1,50 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi/mpi/tool/mpit-internal.h"
+
+#if OPAL_HAVE_WEAK_SYMBOLS && OMPI_PROFILING_DEFINES
+#pragma weak MPI_T_event_register_callback = PMPI_T_event_register_callback
+#endif
+
+#if OMPI_PROFILING_DEFINES
+#include "ompi/mpi/tool/profile/defines.h"
+#endif
+
+
+int MPI_T_event_register_callback (MPI_T_event_registration event_registration,
+                                   MPI_T_cb_safety cb_safety, MPI_Info info, void *user_data,
+                                   MPI_T_event_cb_function *event_cb_function)
+{
+    int ret;
+
+    if (!mpit_is_initialized ()) {
+        return MPI_T_ERR_NOT_INITIALIZED;
+    }
+
+    if (MPI_PARAM_CHECK) {
+        if (NULL == event_registration) {
+            return MPI_T_ERR_INVALID_HANDLE;
+        }
+        if (cb_safety < MPI_T_CB_REQUIRE_NONE || cb_safety > MPI_T_CB_REQUIRE_ASYNC_SIGNAL_SAFE) {
+            return MPI_T_ERR_INVALID;
+        }
+    }
+
+    ompi_mpit_lock ();
+    ret = mca_base_event_register_callback (event_registration, (mca_base_cb_safety_t) cb_safety,
+                                            (MPI_INFO_NULL == info) ? NULL : &info->super,
+                                            user_data, (mca_base_event_cb_fn_t) event_cb_function);
+    ompi_mpit_unlock ();
+
+    return ompit_opal_to_mpit_error (ret);
+}
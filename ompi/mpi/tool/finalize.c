@@ -37,6 +37,9 @@ int MPI_T_finalize (void)
     }
 
     if (0 == --ompi_mpit_init_count) {
+        /* hand the recorded events to the tool before it goes away */
+        (void) mca_base_event_drain ();
+
         (void) ompi_info_close_components ();
 
         int32_t state = ompi_mpi_state;
@@ -18,6 +18,7 @@
 #include "opal/util/string_copy.h"
 #include "opal/mca/base/mca_base_var.h"
 #include "opal/mca/base/mca_base_pvar.h"
+#include "opal/mca/base/mca_base_event.h"
 
 #include "ompi/include/ompi_config.h"
 #include "ompi/runtime/params.h"
@@ -0,0 +1,226 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Completion queues. A request attached to a queue gets a completion
+ * callback (chained with any callback already installed by the library)
+ * pushing it on the queue, so MPIX_Cq_poll only looks at the completed
+ * requests instead of scanning all the outstanding ones like MPI_Testsome.
+ */
+
+#include "ompi_config.h"
+
+#include "opal/class/opal_fifo.h"
+#include "opal/class/opal_free_list.h"
+#include "opal/runtime/opal_progress.h"
+
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/request/grequest.h"
+#include "ompi/request/request.h"
+#include "ompi/mpiext/cq/c/mpiext_cq_c.h"
+
+typedef struct ompi_mpiext_cq_entry_t {
+    opal_free_list_item_t super;
+    ompi_request_t *request;
+    void *user_data;
+    struct ompi_mpiext_cq_t *cq;
+    /* callback installed on the request before it was attached */
+    ompi_request_complete_fn_t prev_cb;
+    void *prev_cb_data;
+} ompi_mpiext_cq_entry_t;
+
+static OBJ_CLASS_INSTANCE(ompi_mpiext_cq_entry_t, opal_free_list_item_t, NULL, NULL);
+
+struct ompi_mpiext_cq_t {
+    opal_fifo_t completed;        /**< entries of the completed requests */
+    opal_free_list_t entries;
+    opal_atomic_int32_t attached; /**< requests attached and not yet drained */
+};
+
+static int ompi_mpiext_cq_complete_cb(ompi_request_t *request)
+{
+    ompi_mpiext_cq_entry_t *entry = (ompi_mpiext_cq_entry_t *) request->req_complete_cb_data;
+    int rc;
+
+    /* run the previous owner of the callback first, with its own data */
+    request->req_complete_cb_data = entry->prev_cb_data;
+    if (NULL != entry->prev_cb) {
+        rc = entry->prev_cb(request);
+        if (OMPI_SUCCESS != rc) {
+            /* not completed after all, stay attached on top of whatever
+             * the callback installed for the next completion */
+            entry->prev_cb = request->req_complete_cb;
+            entry->prev_cb_data = request->req_complete_cb_data;
+            request->req_complete_cb = ompi_mpiext_cq_complete_cb;
+            request->req_complete_cb_data = entry;
+            return rc;
+        }
+    }
+    opal_fifo_push(&entry->cq->completed, &entry->super.super);
+    return OMPI_SUCCESS;
+}
+
+int MPIX_Cq_create(MPIX_Cq *cq)
+{
+    static const char FUNC_NAME[] = "MPIX_Cq_create";
+    struct ompi_mpiext_cq_t *queue;
+    int rc;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if (NULL == cq) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_ARG, FUNC_NAME);
+        }
+    }
+
+    queue = (struct ompi_mpiext_cq_t *) malloc(sizeof(*queue));
+    if (NULL == queue) {
+        return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_NO_MEM, FUNC_NAME);
+    }
+    OBJ_CONSTRUCT(&queue->completed, opal_fifo_t);
+    OBJ_CONSTRUCT(&queue->entries, opal_free_list_t);
+    queue->attached = 0;
+    rc = opal_free_list_init(&queue->entries, sizeof(ompi_mpiext_cq_entry_t),
+                             opal_cache_line_size, OBJ_CLASS(ompi_mpiext_cq_entry_t), 0,
+                             opal_cache_line_size, 64, -1, 64, NULL, 0, NULL, NULL, NULL);
+    if (OPAL_SUCCESS != rc) {
+        OBJ_DESTRUCT(&queue->entries);
+        OBJ_DESTRUCT(&queue->completed);
+        free(queue);
+        return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_NO_MEM, FUNC_NAME);
+    }
+
+    *cq = queue;
+    return MPI_SUCCESS;
+}
+
+int MPIX_Cq_free(MPIX_Cq *cq)
+{
+    static const char FUNC_NAME[] = "MPIX_Cq_free";
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if ((NULL == cq) || (MPIX_CQ_NULL == *cq)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_ARG, FUNC_NAME);
+        }
+    }
+    /* the attached requests point to the queue until they are drained */
+    if (0 != (*cq)->attached) {
+        return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_PENDING, FUNC_NAME);
+    }
+
+    OBJ_DESTRUCT(&(*cq)->entries);
+    OBJ_DESTRUCT(&(*cq)->completed);
+    free(*cq);
+    *cq = MPIX_CQ_NULL;
+    return MPI_SUCCESS;
+}
+
+int MPIX_Cq_attach(MPIX_Cq cq, MPI_Request request, void *user_data)
+{
+    static const char FUNC_NAME[] = "MPIX_Cq_attach";
+    ompi_mpiext_cq_entry_t *entry;
+    int rc;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if (MPIX_CQ_NULL == cq) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_ARG, FUNC_NAME);
+        }
+        if ((MPI_REQUEST_NULL == request) || (OMPI_REQUEST_INACTIVE == request->req_state)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_REQUEST, FUNC_NAME);
+        }
+    }
+
+    entry = (ompi_mpiext_cq_entry_t *) opal_free_list_get(&cq->entries);
+    if (NULL == entry) {
+        return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_NO_MEM, FUNC_NAME);
+    }
+    entry->request = request;
+    entry->user_data = user_data;
+    entry->cq = cq;
+    entry->prev_cb = request->req_complete_cb;
+    entry->prev_cb_data = request->req_complete_cb_data;
+    OPAL_THREAD_ADD_FETCH32(&cq->attached, 1);
+
+    /* pushes the request right away if it is already completed */
+    rc = ompi_request_set_callback(request, ompi_mpiext_cq_complete_cb, entry);
+    return (OMPI_SUCCESS == rc) ? MPI_SUCCESS : OMPI_ERRHANDLER_NOHANDLE_INVOKE(rc, FUNC_NAME);
+}
+
+int MPIX_Cq_poll(MPIX_Cq cq, int maxcount, int *outcount, void *user_data[],
+                 MPI_Status statuses[])
+{
+    static const char FUNC_NAME[] = "MPIX_Cq_poll";
+    ompi_mpiext_cq_entry_t *entry;
+    ompi_request_t *request;
+    int rc = MPI_SUCCESS, done = 0;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if ((MPIX_CQ_NULL == cq) || (maxcount < 0) || (NULL == outcount)
+            || ((maxcount > 0) && (NULL == user_data))) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_ARG, FUNC_NAME);
+        }
+    }
+
+    /* nothing will ever show up */
+    if (0 == cq->attached) {
+        *outcount = MPI_UNDEFINED;
+        return MPI_SUCCESS;
+    }
+
+    if (opal_fifo_is_empty(&cq->completed)) {
+        opal_progress();
+    }
+
+    while ((done < maxcount)
+           && (NULL != (entry = (ompi_mpiext_cq_entry_t *) opal_fifo_pop(&cq->completed)))) {
+        request = entry->request;
+        user_data[done] = entry->user_data;
+        opal_free_list_return(&cq->entries, &entry->super);
+        OPAL_THREAD_ADD_FETCH32(&cq->attached, -1);
+
+        /* the entry is pushed from the completion callback, right before
+         * the completing thread marks the request as completed */
+        while (!REQUEST_COMPLETE(request)) {
+            opal_atomic_rmb();
+        }
+
+        /* as for MPI_Testsome, the query function of generalized requests
+         * must be called even if MPI_STATUSES_IGNORE was provided */
+        if (OMPI_REQUEST_GEN == request->req_type) {
+            ompi_grequest_invoke_query(request, &request->req_status);
+        }
+        if (MPI_STATUSES_IGNORE != statuses) {
+            statuses[done] = request->req_status;
+        }
+        done++;
+
+        if (MPI_SUCCESS != request->req_status.MPI_ERROR) {
+            /* the request is not freed, the application still owns it */
+            rc = MPI_ERR_IN_STATUS;
+            continue;
+        }
+        if (request->req_persistent) {
+            request->req_state = OMPI_REQUEST_INACTIVE;
+        } else {
+            int tmp = ompi_request_free(&request);
+            if (OMPI_SUCCESS != tmp) {
+                *outcount = done;
+                return OMPI_ERRHANDLER_NOHANDLE_INVOKE(tmp, FUNC_NAME);
+            }
+        }
+    }
+
+    *outcount = done;
+    return rc;
+}
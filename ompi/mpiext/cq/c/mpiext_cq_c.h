@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+/* This file is included in <mpi-ext.h>.  It is unnecessary to protect
+   it from multiple inclusion.  Also, you can assume that <mpi.h> has
+   already been included, so all of its types and globals are
+   available. */
+
+/* A completion queue: requests attached to it are pushed on the queue
+   by the library when they complete, MPIX_Cq_poll drains them. */
+typedef struct ompi_mpiext_cq_t *MPIX_Cq;
+
+#define MPIX_CQ_NULL ((MPIX_Cq) 0)
+
+OMPI_DECLSPEC int MPIX_Cq_create(MPIX_Cq *cq);
+OMPI_DECLSPEC int MPIX_Cq_free(MPIX_Cq *cq);
+OMPI_DECLSPEC int MPIX_Cq_attach(MPIX_Cq cq, MPI_Request request, void *user_data);
+OMPI_DECLSPEC int MPIX_Cq_poll(MPIX_Cq cq, int maxcount, int *outcount, void *user_data[],
+                               MPI_Status statuses[]);
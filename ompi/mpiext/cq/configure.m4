@@ -0,0 +1,25 @@
+# -*- shell-script -*-
+#
+# Copyright (c) 2026      The University of Tennessee and The University
+#                         of Tennessee Research Foundation.  All rights
+#                         reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# OMPI_MPIEXT_cq_CONFIG([action-if-found], [action-if-not-found])
+# -----------------------------------------------------------
+AC_DEFUN([OMPI_MPIEXT_cq_CONFIG], [
+    AC_CONFIG_FILES([ompi/mpiext/cq/Makefile])
+    AC_CONFIG_FILES([ompi/mpiext/cq/c/Makefile])
+
+    # This extension can always build, so we just execute $1 if it was
+    # requested.
+    AS_IF([test "$ENABLE_cq" = "1" || \
+           test "$ENABLE_EXT_ALL" = "1"],
+          [$1],
+          [$2])
+])
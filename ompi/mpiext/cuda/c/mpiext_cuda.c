@@ -7,6 +7,9 @@
  * Copyright (c) 2012      Los Alamos National Security, LLC.  All rights
  *                         reserved.
  * Copyright (c) 2015      NVIDIA, Inc. All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -18,10 +21,18 @@
 #include "ompi_config.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "opal/constants.h"
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/mca/part/part.h"
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/request/request.h"
 #include "ompi/mpiext/cuda/c/mpiext_cuda_c.h"
+#if OPAL_CUDA_SUPPORT
+#include "opal/mca/common/cuda/common_cuda.h"
+#endif /* OPAL_CUDA_SUPPORT */
 
 /* If CUDA-aware support is configured in, return 1. Otherwise, return 0.
  * This API may be extended to return more features in the future. */
@@ -29,3 +40,81 @@ int MPIX_Query_cuda_support(void)
 {
     return OPAL_CUDA_SUPPORT;
 }
+
+#if OPAL_CUDA_SUPPORT
+struct ompi_mpiext_cuda_pready_t {
+    ompi_request_t *request;
+    int low;
+    int high;
+};
+typedef struct ompi_mpiext_cuda_pready_t ompi_mpiext_cuda_pready_t;
+
+/* Called by a thread of the CUDA driver once the work enqueued on the
+ * stream before it completed. The pready of the part component only marks
+ * the partitions, the transfers are started by the progress engine, so
+ * nothing here calls back into CUDA. */
+static void ompi_mpiext_cuda_pready_cb(void *data)
+{
+    ompi_mpiext_cuda_pready_t *pready = (ompi_mpiext_cuda_pready_t *) data;
+
+    (void) mca_part.part_pready(pready->low, pready->high, pready->request);
+    free(pready);
+}
+#endif /* OPAL_CUDA_SUPPORT */
+
+static int ompi_mpiext_cuda_pready_stream(int partition_low, int partition_high,
+                                          MPI_Request request, void *stream,
+                                          const char *func_name)
+{
+#if OPAL_CUDA_SUPPORT
+    ompi_mpiext_cuda_pready_t *pready;
+#endif /* OPAL_CUDA_SUPPORT */
+    int rc = OMPI_SUCCESS;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(func_name);
+        if (NULL == request || OMPI_REQUEST_PART != request->req_type) {
+            rc = MPI_ERR_REQUEST;
+        } else if (partition_low < 0 || partition_high < partition_low) {
+            rc = MPI_ERR_ARG;
+        }
+        OMPI_ERRHANDLER_CHECK(rc, MPI_COMM_WORLD, rc, func_name);
+    }
+
+#if OPAL_CUDA_SUPPORT
+    pready = malloc(sizeof(*pready));
+    if (NULL == pready) {
+        return OMPI_ERRHANDLER_INVOKE(MPI_COMM_WORLD, MPI_ERR_NO_MEM, func_name);
+    }
+
+    pready->request = request;
+    pready->low = partition_low;
+    pready->high = partition_high;
+
+    rc = mca_common_cuda_launch_host_func(stream, ompi_mpiext_cuda_pready_cb, pready);
+    if (OPAL_SUCCESS != rc) {
+        free(pready);
+        rc = (OPAL_ERR_NOT_SUPPORTED == rc) ? MPI_ERR_UNSUPPORTED_OPERATION : MPI_ERR_INTERN;
+    }
+#else
+    (void) stream;
+    rc = MPI_ERR_UNSUPPORTED_OPERATION;
+#endif /* OPAL_CUDA_SUPPORT */
+
+    OMPI_ERRHANDLER_RETURN(rc, MPI_COMM_WORLD, rc, func_name);
+}
+
+/* Mark partition of request ready once the work enqueued on stream before
+ * the call completed. */
+int MPIX_Pready_stream(int partition, MPI_Request request, void *stream)
+{
+    return ompi_mpiext_cuda_pready_stream(partition, partition, request, stream,
+                                          "MPIX_Pready_stream");
+}
+
+int MPIX_Pready_range_stream(int partition_low, int partition_high, MPI_Request request,
+                             void *stream)
+{
+    return ompi_mpiext_cuda_pready_stream(partition_low, partition_high, request, stream,
+                                          "MPIX_Pready_range_stream");
+}
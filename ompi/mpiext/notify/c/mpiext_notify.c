@@ -0,0 +1,243 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Notified RMA. The operations go to the osc_put_notify and
+ * osc_get_notify functions of the window module, the counters are the
+ * ones returned by its osc_win_notify_counters, written by the origins
+ * with atomics.
+ */
+
+#include "ompi_config.h"
+
+#include "opal/runtime/opal_progress.h"
+#include "opal/sys/atomic.h"
+
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/mca/osc/osc.h"
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/win/win.h"
+#include "ompi/mpiext/notify/c/mpiext_notify_c.h"
+
+static int ompi_mpiext_notify_check_rma(ompi_win_t *win, int origin_count,
+                                        ompi_datatype_t *origin_datatype, int target_rank,
+                                        MPI_Aint target_disp, int target_count,
+                                        ompi_datatype_t *target_datatype)
+{
+    int rc = OMPI_SUCCESS;
+
+    if (origin_count < 0 || target_count < 0) {
+        rc = MPI_ERR_COUNT;
+    } else if (ompi_win_peer_invalid(win, target_rank) &&
+               (MPI_PROC_NULL != target_rank)) {
+        rc = MPI_ERR_RANK;
+    } else if (NULL == target_datatype ||
+               MPI_DATATYPE_NULL == target_datatype) {
+        rc = MPI_ERR_TYPE;
+    } else if (MPI_WIN_FLAVOR_DYNAMIC != win->w_flavor && target_disp < 0) {
+        rc = MPI_ERR_DISP;
+    } else {
+        OMPI_CHECK_DATATYPE_FOR_ONE_SIDED(rc, origin_datatype, origin_count);
+        if (OMPI_SUCCESS == rc) {
+            OMPI_CHECK_DATATYPE_FOR_ONE_SIDED(rc, target_datatype, target_count);
+        }
+    }
+
+    return rc;
+}
+
+/* the local counter notification_idx of win, NULL if there is none */
+static opal_atomic_int64_t *ompi_mpiext_notify_counter(ompi_win_t *win, int notification_idx)
+{
+    opal_atomic_int64_t *counters = NULL;
+    int count = 0;
+
+    if (NULL == win->w_osc_module->osc_win_notify_counters ||
+        OMPI_SUCCESS != win->w_osc_module->osc_win_notify_counters(win, &counters, &count) ||
+        notification_idx < 0 || notification_idx >= count) {
+        return NULL;
+    }
+
+    return counters + notification_idx;
+}
+
+int MPIX_Put_notify(const void *origin_addr, int origin_count, MPI_Datatype origin_datatype,
+                    int target_rank, MPI_Aint target_disp, int target_count,
+                    MPI_Datatype target_datatype, int notification_idx, MPI_Win win)
+{
+    static const char FUNC_NAME[] = "MPIX_Put_notify";
+    int rc;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+
+        if (ompi_win_invalid(win)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_WIN, FUNC_NAME);
+        }
+        rc = ompi_mpiext_notify_check_rma(win, origin_count, origin_datatype, target_rank,
+                                          target_disp, target_count, target_datatype);
+        if (OMPI_SUCCESS == rc && notification_idx < 0) {
+            rc = MPI_ERR_ARG;
+        }
+        OMPI_ERRHANDLER_CHECK(rc, win, rc, FUNC_NAME);
+    }
+
+    if (NULL == win->w_osc_module->osc_put_notify) {
+        return OMPI_ERRHANDLER_INVOKE(win, MPI_ERR_UNSUPPORTED_OPERATION, FUNC_NAME);
+    }
+
+    if (MPI_PROC_NULL == target_rank) return MPI_SUCCESS;
+
+    rc = win->w_osc_module->osc_put_notify(origin_addr, origin_count, origin_datatype,
+                                           target_rank, target_disp, target_count,
+                                           target_datatype, notification_idx, win);
+    OMPI_ERRHANDLER_RETURN(rc, win, rc, FUNC_NAME);
+}
+
+int MPIX_Get_notify(void *origin_addr, int origin_count, MPI_Datatype origin_datatype,
+                    int target_rank, MPI_Aint target_disp, int target_count,
+                    MPI_Datatype target_datatype, int notification_idx, MPI_Win win)
+{
+    static const char FUNC_NAME[] = "MPIX_Get_notify";
+    int rc;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+
+        if (ompi_win_invalid(win)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_WIN, FUNC_NAME);
+        }
+        rc = ompi_mpiext_notify_check_rma(win, origin_count, origin_datatype, target_rank,
+                                          target_disp, target_count, target_datatype);
+        if (OMPI_SUCCESS == rc && notification_idx < 0) {
+            rc = MPI_ERR_ARG;
+        }
+        OMPI_ERRHANDLER_CHECK(rc, win, rc, FUNC_NAME);
+    }
+
+    if (NULL == win->w_osc_module->osc_get_notify) {
+        return OMPI_ERRHANDLER_INVOKE(win, MPI_ERR_UNSUPPORTED_OPERATION, FUNC_NAME);
+    }
+
+    if (MPI_PROC_NULL == target_rank) return MPI_SUCCESS;
+
+    rc = win->w_osc_module->osc_get_notify(origin_addr, origin_count, origin_datatype,
+                                           target_rank, target_disp, target_count,
+                                           target_datatype, notification_idx, win);
+    OMPI_ERRHANDLER_RETURN(rc, win, rc, FUNC_NAME);
+}
+
+int MPIX_Win_get_notify_value(MPI_Win win, int notification_idx, MPI_Count *value)
+{
+    static const char FUNC_NAME[] = "MPIX_Win_get_notify_value";
+    opal_atomic_int64_t *counter;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+
+        if (ompi_win_invalid(win)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_WIN, FUNC_NAME);
+        } else if (NULL == value) {
+            return OMPI_ERRHANDLER_INVOKE(win, MPI_ERR_ARG, FUNC_NAME);
+        }
+    }
+
+    counter = ompi_mpiext_notify_counter(win, notification_idx);
+    if (NULL == counter) {
+        return OMPI_ERRHANDLER_INVOKE(win, MPI_ERR_ARG, FUNC_NAME);
+    }
+
+    *value = (MPI_Count) opal_atomic_fetch_add_64(counter, 0);
+    /* the data notified is read after the counter */
+    opal_atomic_rmb();
+
+    return MPI_SUCCESS;
+}
+
+int MPIX_Win_set_notify_value(MPI_Win win, int notification_idx, MPI_Count value)
+{
+    static const char FUNC_NAME[] = "MPIX_Win_set_notify_value";
+    opal_atomic_int64_t *counter;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+
+        if (ompi_win_invalid(win)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_WIN, FUNC_NAME);
+        }
+    }
+
+    counter = ompi_mpiext_notify_counter(win, notification_idx);
+    if (NULL == counter) {
+        return OMPI_ERRHANDLER_INVOKE(win, MPI_ERR_ARG, FUNC_NAME);
+    }
+
+    (void) opal_atomic_swap_64(counter, (int64_t) value);
+
+    return MPI_SUCCESS;
+}
+
+int MPIX_Win_notify_test(MPI_Win win, int notification_idx, MPI_Count value, int *flag)
+{
+    static const char FUNC_NAME[] = "MPIX_Win_notify_test";
+    opal_atomic_int64_t *counter;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+
+        if (ompi_win_invalid(win)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_WIN, FUNC_NAME);
+        } else if (NULL == flag) {
+            return OMPI_ERRHANDLER_INVOKE(win, MPI_ERR_ARG, FUNC_NAME);
+        }
+    }
+
+    counter = ompi_mpiext_notify_counter(win, notification_idx);
+    if (NULL == counter) {
+        return OMPI_ERRHANDLER_INVOKE(win, MPI_ERR_ARG, FUNC_NAME);
+    }
+
+    *flag = opal_atomic_fetch_add_64(counter, 0) >= (int64_t) value;
+    if (!*flag) {
+        /* the btl atomics of the origins may need the target to progress */
+        opal_progress();
+        *flag = opal_atomic_fetch_add_64(counter, 0) >= (int64_t) value;
+    }
+    opal_atomic_rmb();
+
+    return MPI_SUCCESS;
+}
+
+int MPIX_Win_notify_wait(MPI_Win win, int notification_idx, MPI_Count value)
+{
+    static const char FUNC_NAME[] = "MPIX_Win_notify_wait";
+    opal_atomic_int64_t *counter;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+
+        if (ompi_win_invalid(win)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_WIN, FUNC_NAME);
+        }
+    }
+
+    counter = ompi_mpiext_notify_counter(win, notification_idx);
+    if (NULL == counter) {
+        return OMPI_ERRHANDLER_INVOKE(win, MPI_ERR_ARG, FUNC_NAME);
+    }
+
+    while (opal_atomic_fetch_add_64(counter, 0) < (int64_t) value) {
+        opal_progress();
+    }
+    opal_atomic_rmb();
+
+    return MPI_SUCCESS;
+}
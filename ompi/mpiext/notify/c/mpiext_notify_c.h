@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+/* This file is included in <mpi-ext.h>.  It is unnecessary to protect
+   it from multiple inclusion.  Also, you can assume that <mpi.h> has
+   already been included, so all of its types and globals are
+   available. */
+
+/* Notified RMA: a put or get that increments a notification counter of
+   the target window once its data is in place. The number of counters
+   of a window is given by the "mpix_num_notifications" info key. */
+OMPI_DECLSPEC int MPIX_Put_notify(const void *origin_addr, int origin_count,
+                                  MPI_Datatype origin_datatype, int target_rank,
+                                  MPI_Aint target_disp, int target_count,
+                                  MPI_Datatype target_datatype, int notification_idx,
+                                  MPI_Win win);
+OMPI_DECLSPEC int MPIX_Get_notify(void *origin_addr, int origin_count,
+                                  MPI_Datatype origin_datatype, int target_rank,
+                                  MPI_Aint target_disp, int target_count,
+                                  MPI_Datatype target_datatype, int notification_idx,
+                                  MPI_Win win);
+OMPI_DECLSPEC int MPIX_Win_get_notify_value(MPI_Win win, int notification_idx, MPI_Count *value);
+OMPI_DECLSPEC int MPIX_Win_set_notify_value(MPI_Win win, int notification_idx, MPI_Count value);
+OMPI_DECLSPEC int MPIX_Win_notify_test(MPI_Win win, int notification_idx, MPI_Count value, int *flag);
+OMPI_DECLSPEC int MPIX_Win_notify_wait(MPI_Win win, int notification_idx, MPI_Count value);
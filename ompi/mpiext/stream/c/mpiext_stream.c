@@ -0,0 +1,426 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ * Stream enqueued operations. Each call enqueues a host function on the
+ * stream; the CUDA driver runs it once the work before it on the stream
+ * completed, and holds the work after it until it returns. The host
+ * function starts the operation through the PML or the collectives of
+ * the communicator (so device buffers go through smcuda and coll/cuda)
+ * and, for the blocking flavors and MPIX_Wait_stream, drives the
+ * progress engine until it completes. The host functions run on a
+ * thread of the driver, hence the MPI_THREAD_MULTIPLE requirement.
+ */
+
+#include "ompi_config.h"
+
+#include <stdlib.h>
+
+#include "opal/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/errhandler/errhandler.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/mca/pml/pml.h"
+#include "ompi/mpi/c/bindings.h"
+#include "ompi/op/op.h"
+#include "ompi/request/request.h"
+#include "ompi/runtime/mpiruntime.h"
+#include "ompi/mpiext/stream/c/mpiext_stream_c.h"
+#if OPAL_CUDA_SUPPORT
+#include "opal/mca/common/cuda/common_cuda.h"
+#endif /* OPAL_CUDA_SUPPORT */
+
+/* Handle of an operation started by the stream. It is the request
+ * returned to the user: the real one does not exist before the stream
+ * reaches the operation. */
+typedef struct ompi_mpiext_stream_request_t {
+    ompi_request_t super;
+    ompi_request_t *inner; /**< started by the stream, NULL before */
+    void *stream;
+} ompi_mpiext_stream_request_t;
+
+static OBJ_CLASS_INSTANCE(ompi_mpiext_stream_request_t, ompi_request_t, NULL, NULL);
+
+typedef enum {
+    OMPI_MPIEXT_STREAM_SEND,
+    OMPI_MPIEXT_STREAM_RECV,
+    OMPI_MPIEXT_STREAM_ISEND,
+    OMPI_MPIEXT_STREAM_IRECV,
+    OMPI_MPIEXT_STREAM_WAIT,
+    OMPI_MPIEXT_STREAM_ALLREDUCE,
+} ompi_mpiext_stream_kind_t;
+
+/* Arguments of an enqueued operation, owned by the host function */
+typedef struct ompi_mpiext_stream_op_t {
+    ompi_mpiext_stream_kind_t kind;
+    const void *sbuf;
+    void *rbuf;
+    int count;
+    ompi_datatype_t *datatype;
+    ompi_op_t *op;
+    int peer;
+    int tag;
+    ompi_communicator_t *comm;
+    MPI_Status *status;
+    ompi_mpiext_stream_request_t *request;
+    const char *func_name;
+} ompi_mpiext_stream_op_t;
+
+static int ompi_mpiext_stream_request_free(ompi_request_t **request)
+{
+    OMPI_REQUEST_FINI(*request);
+    OBJ_RELEASE(*request);
+    *request = MPI_REQUEST_NULL;
+    return OMPI_SUCCESS;
+}
+
+static ompi_mpiext_stream_request_t *ompi_mpiext_stream_request_alloc(ompi_communicator_t *comm,
+                                                                      void *stream)
+{
+    ompi_mpiext_stream_request_t *request = OBJ_NEW(ompi_mpiext_stream_request_t);
+
+    if (NULL == request) {
+        return NULL;
+    }
+    OMPI_REQUEST_INIT(&request->super, false);
+    request->super.req_type = OMPI_REQUEST_PML;
+    request->super.req_state = OMPI_REQUEST_ACTIVE;
+    request->super.req_free = ompi_mpiext_stream_request_free;
+    request->super.req_mpi_object.comm = comm;
+    request->super.req_status = ompi_status_empty;
+    request->inner = NULL;
+    request->stream = stream;
+    return request;
+}
+
+static void ompi_mpiext_stream_op_release(ompi_mpiext_stream_op_t *sop)
+{
+    if (NULL != sop->comm) {
+        OBJ_RELEASE(sop->comm);
+    }
+    if (NULL != sop->datatype) {
+        OMPI_DATATYPE_RELEASE(sop->datatype);
+    }
+    if (NULL != sop->op) {
+        OBJ_RELEASE(sop->op);
+    }
+    if (NULL != sop->request) {
+        OBJ_RELEASE(sop->request);
+    }
+    free(sop);
+}
+
+#if OPAL_CUDA_SUPPORT
+/* Called by a thread of the CUDA driver when the stream reaches the
+ * operation. Errors of the blocking flavors go to the error handler of
+ * the communicator, the ones of a started request to its status. */
+static void ompi_mpiext_stream_cb(void *data)
+{
+    ompi_mpiext_stream_op_t *sop = (ompi_mpiext_stream_op_t *) data;
+    ompi_mpiext_stream_request_t *request = sop->request;
+    int rc = OMPI_SUCCESS;
+
+    switch (sop->kind) {
+    case OMPI_MPIEXT_STREAM_SEND:
+        rc = MCA_PML_CALL(send(sop->sbuf, sop->count, sop->datatype, sop->peer, sop->tag,
+                               MCA_PML_BASE_SEND_STANDARD, sop->comm));
+        break;
+    case OMPI_MPIEXT_STREAM_RECV:
+        rc = MCA_PML_CALL(recv(sop->rbuf, sop->count, sop->datatype, sop->peer, sop->tag,
+                               sop->comm, sop->status));
+        break;
+    case OMPI_MPIEXT_STREAM_ISEND:
+        rc = MCA_PML_CALL(isend(sop->sbuf, sop->count, sop->datatype, sop->peer, sop->tag,
+                                MCA_PML_BASE_SEND_STANDARD, sop->comm, &request->inner));
+        break;
+    case OMPI_MPIEXT_STREAM_IRECV:
+        rc = MCA_PML_CALL(irecv(sop->rbuf, sop->count, sop->datatype, sop->peer, sop->tag,
+                                sop->comm, &request->inner));
+        break;
+    case OMPI_MPIEXT_STREAM_WAIT:
+        if (NULL != request->inner) {
+            rc = ompi_request_wait(&request->inner, sop->status);
+        } else {
+            /* the start failed */
+            rc = request->super.req_status.MPI_ERROR;
+        }
+        break;
+    case OMPI_MPIEXT_STREAM_ALLREDUCE:
+        rc = sop->comm->c_coll->coll_allreduce(sop->sbuf, sop->rbuf, sop->count, sop->datatype,
+                                               sop->op, sop->comm,
+                                               sop->comm->c_coll->coll_allreduce_module);
+        break;
+    }
+
+    if (OMPI_SUCCESS != rc) {
+        if (OMPI_MPIEXT_STREAM_ISEND == sop->kind || OMPI_MPIEXT_STREAM_IRECV == sop->kind) {
+            /* reported by MPIX_Wait_stream */
+            request->inner = NULL;
+            request->super.req_status.MPI_ERROR = ompi_errcode_get_mpi_code(rc);
+        } else {
+            (void) OMPI_ERRHANDLER_INVOKE(sop->comm, ompi_errcode_get_mpi_code(rc),
+                                          sop->func_name);
+        }
+    }
+    if (OMPI_MPIEXT_STREAM_WAIT == sop->kind) {
+        /* last reference, the handle was reset by MPIX_Wait_stream */
+        ompi_request_t *req = &request->super;
+        (void) ompi_mpiext_stream_request_free(&req);
+        sop->request = NULL;
+    }
+    ompi_mpiext_stream_op_release(sop);
+}
+#endif /* OPAL_CUDA_SUPPORT */
+
+/* Hand the operation to the stream. On failure, nothing was enqueued and
+ * the operation is released. */
+static int ompi_mpiext_stream_enqueue(ompi_mpiext_stream_op_t *sop, void *stream)
+{
+    int rc;
+
+#if OPAL_CUDA_SUPPORT
+    rc = mca_common_cuda_launch_host_func(stream, ompi_mpiext_stream_cb, sop);
+    if (OPAL_SUCCESS != rc) {
+        rc = (OPAL_ERR_NOT_SUPPORTED == rc) ? MPI_ERR_UNSUPPORTED_OPERATION : MPI_ERR_INTERN;
+    }
+#else
+    (void) stream;
+    rc = MPI_ERR_UNSUPPORTED_OPERATION;
+#endif /* OPAL_CUDA_SUPPORT */
+
+    if (MPI_SUCCESS != rc) {
+        ompi_mpiext_stream_op_release(sop);
+    }
+    return rc;
+}
+
+static ompi_mpiext_stream_op_t *ompi_mpiext_stream_op_alloc(ompi_mpiext_stream_kind_t kind,
+                                                            ompi_communicator_t *comm,
+                                                            ompi_datatype_t *datatype,
+                                                            const char *func_name)
+{
+    ompi_mpiext_stream_op_t *sop = calloc(1, sizeof(*sop));
+
+    if (NULL == sop) {
+        return NULL;
+    }
+    sop->kind = kind;
+    sop->func_name = func_name;
+    /* the user may free them before the stream gets there */
+    sop->comm = comm;
+    OBJ_RETAIN(comm);
+    if (NULL != datatype) {
+        sop->datatype = datatype;
+        OMPI_DATATYPE_RETAIN(datatype);
+    }
+    return sop;
+}
+
+/* Calls from the threads of the CUDA driver must be allowed */
+static int ompi_mpiext_stream_check_thread(void)
+{
+    return ompi_mpi_thread_multiple ? MPI_SUCCESS : MPI_ERR_UNSUPPORTED_OPERATION;
+}
+
+static int ompi_mpiext_stream_p2p(ompi_mpiext_stream_kind_t kind, void *buf, int count,
+                                  MPI_Datatype type, int peer, int tag, MPI_Comm comm,
+                                  MPI_Status *status, MPI_Request *request, void *stream,
+                                  const char *func_name)
+{
+    bool is_send = (OMPI_MPIEXT_STREAM_SEND == kind || OMPI_MPIEXT_STREAM_ISEND == kind);
+    bool is_request = (OMPI_MPIEXT_STREAM_ISEND == kind || OMPI_MPIEXT_STREAM_IRECV == kind);
+    ompi_mpiext_stream_request_t *sreq = NULL;
+    ompi_mpiext_stream_op_t *sop;
+    int rc = MPI_SUCCESS;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(func_name);
+        if (ompi_comm_invalid(comm)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_COMM, func_name);
+        } else if (count < 0) {
+            rc = MPI_ERR_COUNT;
+        } else if (MPI_DATATYPE_NULL == type || NULL == type) {
+            rc = MPI_ERR_TYPE;
+        } else if (is_send ? (tag < 0 || tag > mca_pml.pml_max_tag)
+                           : (((tag < 0) && (tag != MPI_ANY_TAG)) || (tag > mca_pml.pml_max_tag))) {
+            rc = MPI_ERR_TAG;
+        } else if (ompi_comm_peer_invalid(comm, peer) && (MPI_PROC_NULL != peer) &&
+                   (is_send || MPI_ANY_SOURCE != peer)) {
+            rc = MPI_ERR_RANK;
+        } else if (is_request && NULL == request) {
+            rc = MPI_ERR_REQUEST;
+        } else if (is_send) {
+            OMPI_CHECK_DATATYPE_FOR_SEND(rc, type, count);
+            OMPI_CHECK_USER_BUFFER(rc, buf, type, count);
+        } else {
+            OMPI_CHECK_DATATYPE_FOR_RECV(rc, type, count);
+            OMPI_CHECK_USER_BUFFER(rc, buf, type, count);
+        }
+        OMPI_ERRHANDLER_CHECK(rc, comm, rc, func_name);
+    }
+
+    rc = ompi_mpiext_stream_check_thread();
+    OMPI_ERRHANDLER_CHECK(rc, comm, rc, func_name);
+
+    sop = ompi_mpiext_stream_op_alloc(kind, comm, type, func_name);
+    if (NULL != sop && is_request) {
+        sreq = ompi_mpiext_stream_request_alloc(comm, stream);
+        if (NULL == sreq) {
+            ompi_mpiext_stream_op_release(sop);
+            sop = NULL;
+        } else {
+            /* one reference for the user, one for the host function */
+            OBJ_RETAIN(sreq);
+            sop->request = sreq;
+        }
+    }
+    if (NULL == sop) {
+        return OMPI_ERRHANDLER_INVOKE(comm, MPI_ERR_NO_MEM, func_name);
+    }
+    sop->sbuf = buf;
+    sop->rbuf = buf;
+    sop->count = count;
+    sop->peer = peer;
+    sop->tag = tag;
+    sop->status = status;
+
+    rc = ompi_mpiext_stream_enqueue(sop, stream);
+    if (is_request) {
+        if (MPI_SUCCESS == rc) {
+            *request = &sreq->super;
+        } else {
+            ompi_request_t *req = &sreq->super;
+            (void) ompi_mpiext_stream_request_free(&req);
+            *request = MPI_REQUEST_NULL;
+        }
+    }
+    OMPI_ERRHANDLER_RETURN(rc, comm, rc, func_name);
+}
+
+int MPIX_Send_stream(const void *buf, int count, MPI_Datatype datatype, int dest, int tag,
+                     MPI_Comm comm, void *stream)
+{
+    return ompi_mpiext_stream_p2p(OMPI_MPIEXT_STREAM_SEND, (void *) buf, count, datatype, dest,
+                                  tag, comm, MPI_STATUS_IGNORE, NULL, stream,
+                                  "MPIX_Send_stream");
+}
+
+int MPIX_Recv_stream(void *buf, int count, MPI_Datatype datatype, int source, int tag,
+                     MPI_Comm comm, MPI_Status *status, void *stream)
+{
+    return ompi_mpiext_stream_p2p(OMPI_MPIEXT_STREAM_RECV, buf, count, datatype, source, tag,
+                                  comm, status, NULL, stream, "MPIX_Recv_stream");
+}
+
+int MPIX_Isend_stream(const void *buf, int count, MPI_Datatype datatype, int dest, int tag,
+                      MPI_Comm comm, MPI_Request *request, void *stream)
+{
+    return ompi_mpiext_stream_p2p(OMPI_MPIEXT_STREAM_ISEND, (void *) buf, count, datatype, dest,
+                                  tag, comm, MPI_STATUS_IGNORE, request, stream,
+                                  "MPIX_Isend_stream");
+}
+
+int MPIX_Irecv_stream(void *buf, int count, MPI_Datatype datatype, int source, int tag,
+                      MPI_Comm comm, MPI_Request *request, void *stream)
+{
+    return ompi_mpiext_stream_p2p(OMPI_MPIEXT_STREAM_IRECV, buf, count, datatype, source, tag,
+                                  comm, MPI_STATUS_IGNORE, request, stream,
+                                  "MPIX_Irecv_stream");
+}
+
+/* The request is released by the host function, the handle is reset
+ * right away like MPI_Wait would. */
+int MPIX_Wait_stream(MPI_Request *request, MPI_Status *status, void *stream)
+{
+    static const char FUNC_NAME[] = "MPIX_Wait_stream";
+    ompi_mpiext_stream_request_t *sreq;
+    ompi_mpiext_stream_op_t *sop;
+    ompi_communicator_t *comm;
+    int rc = MPI_SUCCESS;
+
+    if (MPI_PARAM_CHECK) {
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if (NULL == request || MPI_REQUEST_NULL == *request ||
+            ompi_mpiext_stream_request_free != (*request)->req_free) {
+            rc = MPI_ERR_REQUEST;
+        } else if (((ompi_mpiext_stream_request_t *) *request)->stream != stream) {
+            rc = MPI_ERR_ARG;
+        }
+        OMPI_ERRHANDLER_CHECK(rc, MPI_COMM_WORLD, rc, FUNC_NAME);
+    }
+
+    sreq = (ompi_mpiext_stream_request_t *) *request;
+    comm = sreq->super.req_mpi_object.comm;
+
+    rc = ompi_mpiext_stream_check_thread();
+    OMPI_ERRHANDLER_CHECK(rc, comm, rc, FUNC_NAME);
+
+    sop = ompi_mpiext_stream_op_alloc(OMPI_MPIEXT_STREAM_WAIT, comm, NULL, FUNC_NAME);
+    if (NULL == sop) {
+        return OMPI_ERRHANDLER_INVOKE(comm, MPI_ERR_NO_MEM, FUNC_NAME);
+    }
+    OBJ_RETAIN(sreq);
+    sop->request = sreq;
+    sop->status = status;
+
+    rc = ompi_mpiext_stream_enqueue(sop, stream);
+    if (MPI_SUCCESS == rc) {
+        /* the host function releases the request */
+        OBJ_RELEASE(sreq);
+        *request = MPI_REQUEST_NULL;
+    }
+    OMPI_ERRHANDLER_RETURN(rc, comm, rc, FUNC_NAME);
+}
+
+int MPIX_Allreduce_stream(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype,
+                          MPI_Op op, MPI_Comm comm, void *stream)
+{
+    static const char FUNC_NAME[] = "MPIX_Allreduce_stream";
+    ompi_mpiext_stream_op_t *sop;
+    int rc = MPI_SUCCESS;
+
+    if (MPI_PARAM_CHECK) {
+        char *msg;
+
+        OMPI_ERR_INIT_FINALIZE(FUNC_NAME);
+        if (ompi_comm_invalid(comm)) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_COMM, FUNC_NAME);
+        } else if (MPI_OP_NULL == op) {
+            rc = MPI_ERR_OP;
+        } else if (!ompi_op_is_valid(op, datatype, &msg, FUNC_NAME)) {
+            int ret = OMPI_ERRHANDLER_INVOKE(comm, MPI_ERR_OP, msg);
+            free(msg);
+            return ret;
+        } else if ((MPI_IN_PLACE == sendbuf && OMPI_COMM_IS_INTER(comm)) ||
+                   MPI_IN_PLACE == recvbuf) {
+            return OMPI_ERRHANDLER_NOHANDLE_INVOKE(MPI_ERR_BUFFER, FUNC_NAME);
+        } else {
+            OMPI_CHECK_DATATYPE_FOR_SEND(rc, datatype, count);
+        }
+        OMPI_ERRHANDLER_CHECK(rc, comm, rc, FUNC_NAME);
+    }
+
+    rc = ompi_mpiext_stream_check_thread();
+    OMPI_ERRHANDLER_CHECK(rc, comm, rc, FUNC_NAME);
+
+    sop = ompi_mpiext_stream_op_alloc(OMPI_MPIEXT_STREAM_ALLREDUCE, comm, datatype, FUNC_NAME);
+    if (NULL == sop) {
+        return OMPI_ERRHANDLER_INVOKE(comm, MPI_ERR_NO_MEM, FUNC_NAME);
+    }
+    sop->sbuf = sendbuf;
+    sop->rbuf = recvbuf;
+    sop->count = count;
+    sop->op = op;
+    OBJ_RETAIN(op);
+
+    rc = ompi_mpiext_stream_enqueue(sop, stream);
+    OMPI_ERRHANDLER_RETURN(rc, comm, rc, FUNC_NAME);
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+/* This file is included in <mpi-ext.h>.  It is unnecessary to protect
+   it from multiple inclusion.  Also, you can assume that <mpi.h> has
+   already been included, so all of its types and globals are
+   available. */
+
+/* Operations enqueued on a GPU stream, stream being a CUstream or a
+   cudaStream_t.  An operation starts once the work enqueued before it on
+   the stream completed, the work enqueued after it waits for the
+   operation.  The requests of MPIX_Isend_stream and MPIX_Irecv_stream
+   are completed by MPIX_Wait_stream on the same stream. */
+OMPI_DECLSPEC int MPIX_Send_stream(const void *buf, int count, MPI_Datatype datatype,
+                                   int dest, int tag, MPI_Comm comm, void *stream);
+OMPI_DECLSPEC int MPIX_Recv_stream(void *buf, int count, MPI_Datatype datatype,
+                                   int source, int tag, MPI_Comm comm, MPI_Status *status,
+                                   void *stream);
+OMPI_DECLSPEC int MPIX_Isend_stream(const void *buf, int count, MPI_Datatype datatype,
+                                    int dest, int tag, MPI_Comm comm, MPI_Request *request,
+                                    void *stream);
+OMPI_DECLSPEC int MPIX_Irecv_stream(void *buf, int count, MPI_Datatype datatype,
+                                    int source, int tag, MPI_Comm comm, MPI_Request *request,
+                                    void *stream);
+OMPI_DECLSPEC int MPIX_Wait_stream(MPI_Request *request, MPI_Status *status, void *stream);
+OMPI_DECLSPEC int MPIX_Allreduce_stream(const void *sendbuf, void *recvbuf, int count,
+                                        MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
+                                        void *stream);
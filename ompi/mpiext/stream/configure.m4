@@ -0,0 +1,25 @@
+# -*- shell-script -*-
+#
+# Copyright (c) 2026      The University of Tennessee and The University
+#                         of Tennessee Research Foundation.  All rights
+#                         reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# OMPI_MPIEXT_stream_CONFIG([action-if-found], [action-if-not-found])
+# -----------------------------------------------------------
+AC_DEFUN([OMPI_MPIEXT_stream_CONFIG], [
+    AC_CONFIG_FILES([ompi/mpiext/stream/Makefile])
+    AC_CONFIG_FILES([ompi/mpiext/stream/c/Makefile])
+
+    # Like the cuda extension, this one builds without CUDA support:
+    # the functions then return MPI_ERR_UNSUPPORTED_OPERATION.
+    AS_IF([test "$ENABLE_stream" = "1" || \
+           test "$ENABLE_EXT_ALL" = "1"],
+          [$1],
+          [$2])
+])
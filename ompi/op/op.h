@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2006 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2007 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2007 High Performance Computing Center Stuttgart,
@@ -479,6 +479,22 @@ static inline bool ompi_op_is_valid(ompi_op_t * op, ompi_datatype_t * ddt,
 }
 
 
+/**
+ * Number of threads splitting the large reductions of the intrinsic
+ * operations (op_base_parallel_threads), disabled if less than 2.
+ */
+OMPI_DECLSPEC extern int ompi_op_base_parallel_threads;
+
+/**
+ * Split the reduction of count elements of the predefined dtype among
+ * the helper threads, when it is larger than the opm_parallel_min_size
+ * of the module. source2 is NULL for the 2-buffer functions. Returns
+ * false if the caller has to do the reduction itself.
+ */
+OMPI_DECLSPEC bool ompi_op_base_parallel_reduce(ompi_op_t *op, const void *source1,
+                                                const void *source2, void *target, int count,
+                                                ompi_datatype_t *dtype, int dtype_id);
+
 /**
  * Perform a reduction operation.
  *
@@ -546,6 +562,11 @@ static inline void ompi_op_reduce(ompi_op_t * op, void *source,
             dtype_id = ompi_op_ddt_map[dt->id];
         } else {
             dtype_id = ompi_op_ddt_map[dtype->id];
+            if (OPAL_UNLIKELY(1 < ompi_op_base_parallel_threads)
+                && ompi_op_base_parallel_reduce(op, source, NULL, target, count, dtype,
+                                                dtype_id)) {
+                return;
+            }
         }
         op->o_func.intrinsic.fns[dtype_id](source, target,
                                            &count, &dtype,
@@ -573,17 +594,17 @@ static inline void ompi_op_reduce(ompi_op_t * op, void *source,
 static inline void ompi_3buff_op_user (ompi_op_t *op, void * restrict source1, void * restrict source2,
                                        void * restrict result, int count, struct ompi_datatype_t *dtype)
 {
-    ompi_datatype_copy_content_same_ddt (dtype, count, result, source1);
-    op->o_func.c_fn (source2, result, &count, &dtype);
+    ompi_datatype_copy_content_same_ddt (dtype, count, result, source2);
+    ompi_op_reduce (op, source1, result, count, dtype);
 }
 
 /**
  * Perform a reduction operation.
  *
  * @param op The operation (IN)
- * @param source Source1 (input) buffer (IN)
- * @param source Source2 (input) buffer (IN)
- * @param target Target (output) buffer (IN/OUT)
+ * @param source1 Source1 (input) buffer (IN)
+ * @param source2 Source2 (input) buffer (IN)
+ * @param target Target (output) buffer (OUT)
  * @param count Number of elements (IN)
  * @param dtype MPI datatype (IN)
  *
@@ -591,12 +612,15 @@ static inline void ompi_3buff_op_user (ompi_op_t *op, void * restrict source1, v
  * is no return code from this function.
  *
  * Perform a reduction operation with count elements of type dtype in
- * the buffers source and target.  The target buffer obtains the
- * result (i.e., the original values in the target buffer are reduced
- * with the values in the source buffer and the result is stored in
- * the target buffer).
+ * the buffers source1 and source2 and store the result in target,
+ * without modifying the sources. The result is the one of
+ * ompi_op_reduce(op, source1, source2) (source2 plays the role of
+ * the target buffer, which matters for non-commutative operations),
+ * but it saves the copy of source2 into target the caller would
+ * otherwise do first: one read and one write pass over the buffers.
  *
- * This function will *only* be invoked on intrinsic MPI_Ops.
+ * source2 may be the same buffer as target, in which case this is
+ * ompi_op_reduce. Otherwise the three buffers must not overlap.
  *
  * Otherwise, this function is the same as ompi_op_reduce.
  */
@@ -607,20 +631,71 @@ static inline void ompi_3buff_op_reduce(ompi_op_t * op, void *source1,
     void *restrict src1;
     void *restrict src2;
     void *restrict tgt;
+
+    if (source2 == target) {
+        ompi_op_reduce(op, source1, target, count, dtype);
+        return;
+    }
+
     src1 = source1;
     src2 = source2;
     tgt = target;
 
     if (OPAL_LIKELY(ompi_op_is_intrinsic (op))) {
-        op->o_3buff_intrinsic.fns[ompi_op_ddt_map[dtype->id]](src1, src2,
-                                                              tgt, &count,
-                                                              &dtype,
-                                                              op->o_3buff_intrinsic.modules[ompi_op_ddt_map[dtype->id]]);
+        int dtype_id;
+        if (!ompi_datatype_is_predefined(dtype)) {
+            ompi_datatype_t *dt = ompi_datatype_get_single_predefined_type_from_args(dtype);
+            dtype_id = ompi_op_ddt_map[dt->id];
+        } else {
+            dtype_id = ompi_op_ddt_map[dtype->id];
+            if (OPAL_UNLIKELY(1 < ompi_op_base_parallel_threads)
+                && ompi_op_base_parallel_reduce(op, src1, src2, tgt, count, dtype, dtype_id)) {
+                return;
+            }
+        }
+        op->o_3buff_intrinsic.fns[dtype_id](src1, src2, tgt, &count, &dtype,
+                                            op->o_3buff_intrinsic.modules[dtype_id]);
     } else {
         ompi_3buff_op_user (op, src1, src2, tgt, count, dtype);
     }
 }
 
+/**
+ * Perform a reduction operation into a packed buffer.
+ *
+ * @param op The operation (IN)
+ * @param source1 Source1 (input) buffer (IN)
+ * @param source2 Source2 (input) buffer (IN)
+ * @param packed Packed (output) buffer, e.g. a send fragment (OUT)
+ * @param count Number of elements (IN)
+ * @param dtype MPI datatype (IN)
+ *
+ * @returns OMPI_SUCCESS if the result has been stored in packed
+ * @returns OMPI_ERR_NOT_SUPPORTED if the memory layout of dtype is
+ * not contiguous, nothing has been done
+ *
+ * Same as ompi_3buff_op_reduce, except that the result is written
+ * in its packed representation (the one opal_convertor_pack would
+ * produce) starting at packed, so that a reduction can go straight
+ * into a send fragment instead of being reduced in place and packed
+ * afterwards. This is only possible when the packed representation
+ * is the memory layout, the caller keeps its reduce then pack path
+ * for the other datatypes.
+ */
+static inline int ompi_op_reduce_pack(ompi_op_t *op, void *source1, void *source2,
+                                      void *packed, int count, ompi_datatype_t *dtype)
+{
+    ptrdiff_t true_lb, true_extent;
+
+    if (!ompi_datatype_is_contiguous_memory_layout(dtype, count)) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    ompi_datatype_get_true_extent(dtype, &true_lb, &true_extent);
+    ompi_3buff_op_reduce(op, source1, source2, (char *) packed - true_lb, count, dtype);
+    return OMPI_SUCCESS;
+}
+
 END_C_DECLS
 
 #endif /* OMPI_OP_H */
@@ -33,6 +33,7 @@
 #include <strings.h>
 
 #include "ompi/constants.h"
+#include "opal/class/opal_concurrent_hash_table.h"
 #include "opal/datatype/opal_convertor.h"
 #include "opal/mca/threads/mutex.h"
 #include "opal/util/arch.h"
@@ -49,7 +50,14 @@
 
 opal_list_t  ompi_proc_list = {{0}};
 static opal_mutex_t ompi_proc_lock;
-static opal_hash_table_t ompi_proc_hash;
+static opal_concurrent_hash_table_t ompi_proc_hash;
+
+/* The procs of our own job are indexed by vpid, the hash table only holds
+ * the procs of the other jobs. The array is allocated with calloc, so the
+ * pages of the peers never seen are never touched. The lookups in both of
+ * them take no lock, the hash table is safe for concurrent readers. */
+static ompi_proc_t **ompi_proc_job_table = NULL;
+static ompi_vpid_t ompi_proc_job_table_size = 0;
 
 ompi_proc_t* ompi_proc_local_proc = NULL;
 
@@ -64,6 +72,32 @@ OBJ_CLASS_INSTANCE(
     ompi_proc_destruct
 );
 
+/* slot of the proc in the table of our job, NULL if it belongs to another job */
+static inline ompi_proc_t **ompi_proc_job_slot (const opal_process_name_t *proc_name)
+{
+    if (proc_name->jobid == OMPI_PROC_MY_NAME->jobid && proc_name->vpid < ompi_proc_job_table_size) {
+        return ompi_proc_job_table + proc_name->vpid;
+    }
+    return NULL;
+}
+
+static inline uint64_t ompi_proc_hash_key (const opal_process_name_t *proc_name)
+{
+    return ((uint64_t) proc_name->jobid << 32) | (uint64_t) proc_name->vpid;
+}
+
+static inline ompi_proc_t *ompi_proc_lookup_nolock (const opal_process_name_t *proc_name)
+{
+    ompi_proc_t **slot = ompi_proc_job_slot (proc_name), *proc = NULL;
+
+    if (NULL != slot) {
+        return *slot;
+    }
+    (void) opal_concurrent_hash_table_get_value_uint64 (&ompi_proc_hash, ompi_proc_hash_key (proc_name),
+                                                        (void **) &proc);
+    return proc;
+}
+
 
 void ompi_proc_construct(ompi_proc_t* proc)
 {
@@ -89,10 +123,19 @@ void ompi_proc_destruct(ompi_proc_t* proc)
      * the local convertor (who has the reference count increased in the datatype) will not get
      * destroyed here. It will be destroyed later when the ompi_datatype_finalize is called.
      */
+    ompi_proc_t **slot;
+
     OBJ_RELEASE( proc->super.proc_convertor );
     opal_mutex_lock (&ompi_proc_lock);
     opal_list_remove_item(&ompi_proc_list, (opal_list_item_t*)proc);
-    opal_hash_table_remove_value_ptr (&ompi_proc_hash, &proc->super.proc_name, sizeof (proc->super.proc_name));
+    slot = ompi_proc_job_slot (&proc->super.proc_name);
+    if (NULL != slot) {
+        if (proc == *slot) {
+            *slot = NULL;
+        }
+    } else {
+        opal_concurrent_hash_table_remove_value_uint64 (&ompi_proc_hash, ompi_proc_hash_key (&proc->super.proc_name));
+    }
     opal_mutex_unlock (&ompi_proc_lock);
 }
 
@@ -108,14 +151,20 @@ void ompi_proc_destruct(ompi_proc_t* proc)
  */
 static int ompi_proc_allocate (ompi_jobid_t jobid, ompi_vpid_t vpid, ompi_proc_t **procp) {
     ompi_proc_t *proc = OBJ_NEW(ompi_proc_t);
+    ompi_proc_t **slot;
 
     opal_list_append(&ompi_proc_list, (opal_list_item_t*)proc);
 
     OMPI_CAST_RTE_NAME(&proc->super.proc_name)->jobid = jobid;
     OMPI_CAST_RTE_NAME(&proc->super.proc_name)->vpid = vpid;
 
-    opal_hash_table_set_value_ptr (&ompi_proc_hash, &proc->super.proc_name, sizeof (proc->super.proc_name),
-                                   proc);
+    slot = ompi_proc_job_slot (&proc->super.proc_name);
+    if (NULL != slot) {
+        *slot = proc;
+    } else {
+        opal_concurrent_hash_table_set_value_uint64 (&ompi_proc_hash, ompi_proc_hash_key (&proc->super.proc_name),
+                                                     proc);
+    }
 
     /* by default we consider process to be remote */
     proc->super.proc_flags = OPAL_PROC_NON_LOCAL;
@@ -178,27 +227,19 @@ int ompi_proc_complete_init_single (ompi_proc_t *proc)
 
 opal_proc_t *ompi_proc_lookup (const opal_process_name_t proc_name)
 {
-    ompi_proc_t *proc = NULL;
-    int ret;
+    ompi_proc_t *proc = ompi_proc_lookup_nolock (&proc_name);
 
-    /* try to lookup the value in the hash table */
-    ret = opal_hash_table_get_value_ptr (&ompi_proc_hash, &proc_name, sizeof (proc_name), (void **) &proc);
-
-    if (OPAL_SUCCESS == ret) {
-        return &proc->super;
-    }
-
-    return NULL;
+    return (NULL != proc) ? &proc->super : NULL;
 }
 
 static ompi_proc_t *ompi_proc_for_name_nolock (const opal_process_name_t proc_name)
 {
-    ompi_proc_t *proc = NULL;
+    ompi_proc_t *proc;
     int ret;
 
     /* double-check that another competing thread has not added this proc */
-    ret = opal_hash_table_get_value_ptr (&ompi_proc_hash, &proc_name, sizeof (proc_name), (void **) &proc);
-    if (OPAL_SUCCESS == ret) {
+    proc = ompi_proc_lookup_nolock (&proc_name);
+    if (NULL != proc) {
         goto exit;
     }
 
@@ -220,12 +261,11 @@ exit:
 
 opal_proc_t *ompi_proc_for_name (const opal_process_name_t proc_name)
 {
-    ompi_proc_t *proc = NULL;
-    int ret;
+    ompi_proc_t *proc;
 
-    /* try to lookup the value in the hash table */
-    ret = opal_hash_table_get_value_ptr (&ompi_proc_hash, &proc_name, sizeof (proc_name), (void **) &proc);
-    if (OPAL_SUCCESS == ret) {
+    /* try to lookup the value in the tables */
+    proc = ompi_proc_lookup_nolock (&proc_name);
+    if (NULL != proc) {
         return &proc->super;
     }
 
@@ -238,20 +278,25 @@ opal_proc_t *ompi_proc_for_name (const opal_process_name_t proc_name)
 
 int ompi_proc_init(void)
 {
-    int opal_proc_hash_init_size = (ompi_process_info.num_procs < ompi_add_procs_cutoff) ? ompi_process_info.num_procs :
-        1024;
     ompi_proc_t *proc;
     int ret;
 
     OBJ_CONSTRUCT(&ompi_proc_list, opal_list_t);
     OBJ_CONSTRUCT(&ompi_proc_lock, opal_mutex_t);
-    OBJ_CONSTRUCT(&ompi_proc_hash, opal_hash_table_t);
+    OBJ_CONSTRUCT(&ompi_proc_hash, opal_concurrent_hash_table_t);
 
-    ret = opal_hash_table_init (&ompi_proc_hash, opal_proc_hash_init_size);
+    /* only the procs of the other jobs (dynamic processes) go in there */
+    ret = opal_concurrent_hash_table_init (&ompi_proc_hash, 64);
     if (OPAL_SUCCESS != ret) {
         return ret;
     }
 
+    ompi_proc_job_table = (ompi_proc_t **) calloc (ompi_process_info.num_procs, sizeof (ompi_proc_t *));
+    if (NULL == ompi_proc_job_table) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    ompi_proc_job_table_size = ompi_process_info.num_procs;
+
     /* create a proc for the local process */
     ret = ompi_proc_allocate (OMPI_PROC_MY_NAME->jobid, OMPI_PROC_MY_NAME->vpid, &proc);
     if (OMPI_SUCCESS != ret) {
@@ -408,6 +453,9 @@ int ompi_proc_finalize (void)
     OBJ_DESTRUCT(&ompi_proc_list);
     OBJ_DESTRUCT(&ompi_proc_lock);
     OBJ_DESTRUCT(&ompi_proc_hash);
+    free (ompi_proc_job_table);
+    ompi_proc_job_table = NULL;
+    ompi_proc_job_table_size = 0;
 
     return OMPI_SUCCESS;
 }
@@ -569,18 +617,11 @@ ompi_proc_t** ompi_proc_self(size_t* size)
 
 ompi_proc_t * ompi_proc_find ( const ompi_process_name_t * name )
 {
-    ompi_proc_t *proc, *rproc=NULL;
-    ompi_rte_cmp_bitmask_t mask;
+    ompi_proc_t *rproc;
 
     /* return the proc-struct which matches this jobid+process id */
-    mask = OMPI_RTE_CMP_JOBID | OMPI_RTE_CMP_VPID;
     opal_mutex_lock (&ompi_proc_lock);
-    OPAL_LIST_FOREACH(proc, &ompi_proc_list, ompi_proc_t) {
-        if (OPAL_EQUAL == ompi_rte_compare_name_fields(mask, &proc->super.proc_name, name)) {
-            rproc = proc;
-            break;
-        }
-    }
+    rproc = ompi_proc_lookup_nolock (name);
     opal_mutex_unlock (&ompi_proc_lock);
 
     return rproc;
@@ -681,19 +722,12 @@ ompi_proc_pack(ompi_proc_t **proclist, int proclistsize,
 ompi_proc_t *
 ompi_proc_find_and_add(const ompi_process_name_t * name, bool* isnew)
 {
-    ompi_proc_t *proc, *rproc = NULL;
-    ompi_rte_cmp_bitmask_t mask;
+    ompi_proc_t *rproc;
 
     /* return the proc-struct which matches this jobid+process id */
-    mask = OMPI_RTE_CMP_JOBID | OMPI_RTE_CMP_VPID;
     opal_mutex_lock (&ompi_proc_lock);
-    OPAL_LIST_FOREACH(proc, &ompi_proc_list, ompi_proc_t) {
-        if (OPAL_EQUAL == ompi_rte_compare_name_fields(mask, &proc->super.proc_name, name)) {
-            rproc = proc;
-            *isnew = false;
-            break;
-        }
-    }
+    rproc = ompi_proc_lookup_nolock (name);
+    *isnew = false;
 
     /* if we didn't find this proc in the list, create a new
      * proc_t and append it to the list
@@ -211,7 +211,15 @@ int ompi_request_default_test_all(
             REQUEST_COMPLETE(request) ) {
             num_completed++;
         }
-#if OPAL_ENABLE_FT_MPI
+#if !OPAL_ENABLE_FT_MPI
+        else {
+            /* One pending request is enough to fail the test, there is no
+             * need to look at the others (they are checked again at the
+             * next call anyway).
+             */
+            break;
+        }
+#else
         /* Check for dead requests due to process failure */
         /* Special case for MPI_ANY_SOURCE */
         if(OPAL_UNLIKELY( ompi_request_is_failed(request) &&
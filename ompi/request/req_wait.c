@@ -255,7 +255,11 @@ recheck:
             continue;
         }
 
-        if (!OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete, &_tmp_ptr, &sync)) {
+        /* Only the pending requests need the sync: the completed ones are
+         * counted without paying for an atomic on each of them.
+         */
+        if (REQUEST_COMPLETE(request)
+            || !OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete, &_tmp_ptr, &sync)) {
             if( OPAL_LIKELY( REQUEST_COMPLETE(request) ) ) {
                 if( OPAL_UNLIKELY( MPI_SUCCESS != request->req_status.MPI_ERROR ) ) {
                     failed++;
@@ -278,6 +282,12 @@ recheck:
         goto finish;
     }
 
+    if( count == completed ) {
+        /* nothing was attached to the sync, skip the signaling */
+        WAIT_SYNC_SIGNALLED(&sync);
+        goto finish;
+    }
+
     if( 0 != completed ) {
         wait_sync_update(&sync, completed, OPAL_SUCCESS);
     }
@@ -494,7 +504,9 @@ int ompi_request_default_wait_some(size_t count,
             num_requests_null_inactive++;
             continue;
         }
-        indices[num_active_reqs] = OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete, &_tmp_ptr, &sync);
+        /* no atomic for the requests already completed */
+        indices[num_active_reqs] = !REQUEST_COMPLETE(request)
+            && OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete, &_tmp_ptr, &sync);
         if( !indices[num_active_reqs] ) {
             /* If the request is completed go ahead and mark it as such */
             if( REQUEST_COMPLETE(request) ) {
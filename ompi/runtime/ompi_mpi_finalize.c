@@ -50,6 +50,7 @@
 #include "opal/util/event.h"
 #include "opal/util/output.h"
 #include "opal/runtime/opal_progress.h"
+#include "opal/runtime/opal_progress_threads.h"
 #include "opal/mca/base/base.h"
 #include "opal/sys/atomic.h"
 #include "opal/runtime/opal.h"
@@ -280,6 +281,31 @@ int ompi_mpi_finalize(void)
        del_procs behavior around May of 2014 (see
        https://svn.open-mpi.org/trac/ompi/ticket/4669#comment:4 for
        more details). */
+    if (ompi_mpi_fast_finalize) {
+        /* Fast teardown: an MPI barrier along a tree over MPI_COMM_WORLD
+           replaces the RTE fence, so that no process waits on all the
+           others, and the process only leaves the RTE.  The objects,
+           registrations and components are reclaimed by its exit.  Like
+           the fence, the barrier relies on the transports to deliver
+           what they accepted (point #1 above), hence the opt-in. */
+        ompi_communicator_t *comm = &ompi_mpi_comm_world.comm;
+
+        if (!ompi_async_mpi_finalize && 1 < ompi_comm_size(comm)) {
+            ret = ompi_coll_base_barrier_intra_tree(comm, comm->c_coll->coll_barrier_module);
+            if (OMPI_SUCCESS != ret) {
+                OMPI_ERROR_LOG(ret);
+                goto done;
+            }
+        }
+        opal_progress_async_stop();
+
+        if (OMPI_SUCCESS != (ret = ompi_rte_finalize())) {
+            goto done;
+        }
+        ompi_rte_initialized = false;
+        goto done;
+    }
+
     if (!ompi_async_mpi_finalize && !ompi_singleton) {
         active = true;
         OPAL_POST_OBJECT(&active);
@@ -299,6 +325,9 @@ int ompi_mpi_finalize(void)
         OMPI_LAZY_WAIT_FOR_COMPLETION(active);
     }
 
+    /* the communications are over, the rest is torn down by this thread */
+    opal_progress_async_stop();
+
     /* Shut down any bindings-specific issues: C++, F77, F90 */
 
     /* Remove all memory associated by MPI_REGISTER_DATAREP (per
@@ -374,6 +403,9 @@ int ompi_mpi_finalize(void)
         mca_mpool_base_tree_print(ompi_debug_show_mpi_alloc_mem_leaks);
     }
 
+    /* the registrations of the ALLOC_MEM memory go before the btls */
+    mca_mpool_base_alloc_release();
+
     /* Now that all MPI objects dealing with communications are gone,
        shut down MCA types having to do with communications */
     if (OMPI_SUCCESS != (ret = mca_base_framework_close(&ompi_pml_base_framework) ) ) {
@@ -49,6 +49,7 @@
 #include "opal/mca/base/base.h"
 #include "opal/mca/hwloc/base/base.h"
 #include "opal/runtime/opal_progress.h"
+#include "opal/runtime/opal_progress_threads.h"
 #include "opal/mca/threads/threads.h"
 #include "opal/util/arch.h"
 #include "opal/util/argv.h"
@@ -93,6 +94,7 @@
 #include "ompi/mca/io/io.h"
 #include "ompi/mca/io/base/base.h"
 #include "ompi/runtime/ompi_rte.h"
+#include "ompi/runtime/ompi_wtime.h"
 #include "ompi/debuggers/debuggers.h"
 #include "ompi/proc/proc.h"
 #include "ompi/mca/pml/base/pml_base_bsend.h"
@@ -398,11 +400,11 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
     size_t nprocs;
     char *error = NULL;
     volatile bool active;
-    bool background_fence = false;
+    bool background_fence = false, modex_fence = false;
     pmix_info_t info[2];
     pmix_status_t codes[1] = { PMIX_ERR_PROC_ABORTED };
     pmix_status_t rc;
-    OMPI_TIMING_INIT(64);
+    OMPI_TIMING_INIT(256);
     opal_pmix_lock_t mylock;
     opal_process_name_t pname;
 
@@ -455,9 +457,15 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
     }
     OMPI_TIMING_IMPORT_OPAL("opal_init_util");
 
+    /* The async progress thread competes with the application for the internal
+     * state, which must then be protected as with MPI_THREAD_MULTIPLE. */
+    if (OPAL_PROGRESS_ASYNC_NONE != opal_progress_async_mode) {
+        ompi_mpi_thread_multiple = true;
+    }
+
     /* If thread support was enabled, then setup OPAL to allow for them. This must be done
      * early to prevent a race condition that can occur with orte_init(). */
-    if (*provided != MPI_THREAD_SINGLE) {
+    if (*provided != MPI_THREAD_SINGLE || ompi_mpi_thread_multiple) {
         opal_set_using_threads(true);
     }
 
@@ -737,10 +745,10 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
                 }
             }
         } else {
-            /* we want to do the modex - we block at this point, but we must
-             * do so in a manner that allows us to call opal_progress so our
-             * event library can be cycled as we have tied PMIx to that
-             * event base */
+            /* we want to do the modex - we block before the first use of the
+             * remote data (ompi_proc_complete_init), but the initialization
+             * of the local MPI objects below does not need it and can overlap
+             * with the exchange */
             active = true;
             OPAL_POST_OBJECT(&active);
             PMIX_INFO_LOAD(&info[0], PMIX_COLLECT_DATA, &opal_pmix_collect_all_data, PMIX_BOOL);
@@ -750,12 +758,11 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
                 error = "PMIx_Fence() failed";
                 goto error;
             }
-            /* cannot just wait on thread as we need to call opal_progress */
-            OMPI_LAZY_WAIT_FOR_COMPLETION(active);
+            modex_fence = true;
         }
     }
 
-    OMPI_TIMING_NEXT("modex");
+    OMPI_TIMING_NEXT("modex-post");
 
     /* select buffered send allocator component to be used */
     if( OMPI_SUCCESS !=
@@ -785,6 +792,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "mca_part_base_select() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("find-available");
 
     /* io and topo components are not selected here -- see comment
        above about the io and topo frameworks being loaded lazily */
@@ -854,6 +862,14 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "ompi_attr_init() failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("handles-init");
+
+    if (modex_fence) {
+        /* cannot just wait on thread as we need to call opal_progress */
+        OMPI_LAZY_WAIT_FOR_COMPLETION(active);
+        modex_fence = false;
+    }
+    OMPI_TIMING_NEXT("modex");
 
     /* identify the architectures of remote procs and setup
      * their datatype convertors, if required
@@ -862,6 +878,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "ompi_proc_complete_init failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("proc-complete-init");
 
     /* start PML/BTL's */
     ret = MCA_PML_CALL(enable(true));
@@ -869,6 +886,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         error = "PML control failed";
         goto error;
     }
+    OMPI_TIMING_NEXT("pml-enable");
 
     /* some btls/mtls require we call add_procs with all procs in the job.
      * since the btls/mtls have no visibility here it is up to the pml to
@@ -903,6 +921,7 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
 
     MCA_PML_CALL(add_comm(&ompi_mpi_comm_world.comm));
     MCA_PML_CALL(add_comm(&ompi_mpi_comm_self.comm));
+    OMPI_TIMING_NEXT("pml-add-procs");
 
 #if OPAL_ENABLE_FT_MPI
     /* initialize the fault tolerant infrastructure (revoke, detector,
@@ -1028,6 +1047,13 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         goto error;
     }
 
+    /* Set up the clock of MPI_Wtime, synchronized across MPI_COMM_WORLD
+       with mpi_wtime_global */
+    if (OMPI_SUCCESS != (ret = ompi_wtime_init())) {
+        error = "ompi_wtime_init() failed";
+        goto error;
+    }
+
     /* see if yield_when_idle was specified - if so, use it */
     opal_progress_set_yield_when_idle(ompi_mpi_yield_when_idle);
 
@@ -1036,6 +1062,11 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
         opal_progress_set_event_poll_rate(ompi_mpi_event_tick_rate);
     }
 
+    if (OPAL_SUCCESS != (ret = opal_progress_async_start())) {
+        error = "opal_progress_async_start";
+        goto error;
+    }
+
     /* At this point, we are fully configured and in MPI mode.  Any
        communication calls here will work exactly like they would in
        the user's code.  Setup the connections between procs and warm
@@ -1057,6 +1088,10 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
     /* Fall through */
  error:
     if (ret != OMPI_SUCCESS) {
+        if (modex_fence) {
+            /* the fence callback still points to our stack */
+            OMPI_LAZY_WAIT_FOR_COMPLETION(active);
+        }
         /* Only print a message if one was not already printed */
         if (NULL != error && OMPI_ERR_SILENT != ret) {
             const char *err_msg = opal_strerror(ret);
@@ -1091,6 +1126,13 @@ int ompi_mpi_init(int argc, char **argv, int requested, int *provided,
     /* Finish last measurement, output results
      * and clear timing structure */
     OMPI_TIMING_NEXT("barrier-finish");
+    /* per framework and per component breakdown, accumulated by the MCA base
+     * from opal_init on */
+    OMPI_TIMING_IMPORT_OPAL("mca_base_framework_open");
+    OMPI_TIMING_IMPORT_OPAL("open_components");
+    OMPI_TIMING_IMPORT_OPAL("mca_base_select");
+    OMPI_TIMING_IMPORT_OPAL("mca_btl_base_select");
+    OMPI_TIMING_IMPORT_OPAL("mca_pml_base_select");
     OMPI_TIMING_OUT;
     OMPI_TIMING_FINALIZE;
 
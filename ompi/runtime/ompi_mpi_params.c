@@ -67,6 +67,7 @@ char *ompi_mpi_show_mca_params_file = NULL;
 bool ompi_mpi_keep_fqdn_hostnames = false;
 bool ompi_have_sparse_group_storage = OPAL_INT_TO_BOOL(OMPI_GROUP_SPARSE);
 bool ompi_use_sparse_group_storage = OPAL_INT_TO_BOOL(OMPI_GROUP_SPARSE);
+uint32_t ompi_sparse_group_min_size = 1024;
 
 /* if the threads module requires yielding we use that as default but allow it to be overridden */
 bool ompi_mpi_yield_when_idle = OPAL_THREAD_YIELD_WHEN_IDLE_DEFAULT;
@@ -74,9 +75,13 @@ int ompi_mpi_event_tick_rate = -1;
 char *ompi_mpi_show_mca_params_string = NULL;
 bool ompi_mpi_have_sparse_group_storage = !!(OMPI_GROUP_SPARSE);
 bool ompi_mpi_preconnect_mpi = false;
+int ompi_mpi_preconnect_peers = OMPI_MPI_PRECONNECT_ALL;
+uint32_t ompi_mpi_preconnect_hops = 1;
+uint32_t ompi_mpi_preconnect_window = 1;
 
 bool ompi_async_mpi_init = false;
 bool ompi_async_mpi_finalize = false;
+bool ompi_mpi_fast_finalize = false;
 
 #define OMPI_ADD_PROCS_CUTOFF_DEFAULT 0
 uint32_t ompi_add_procs_cutoff = OMPI_ADD_PROCS_CUTOFF_DEFAULT;
@@ -86,7 +91,22 @@ bool ompi_mpi_compat_mpi3 = false;
 
 char *ompi_mpi_spc_attach_string = NULL;
 bool ompi_mpi_spc_dump_enabled = false;
+bool ompi_mpi_spc_comm_enabled = false;
+bool ompi_mpi_spc_histograms_enabled = false;
 uint32_t ompi_pmix_connect_timeout = 0;
+bool ompi_dpm_lazy_add_procs = true;
+uint32_t ompi_comm_split_bucket_min_size = 4096;
+uint32_t ompi_comm_split_bucket_max_color = 256;
+uint32_t ompi_comm_cid_block_size = 8;
+bool ompi_mpi_wtime_global = false;
+uint32_t ompi_mpi_wtime_sync_rounds = 16;
+uint32_t ompi_mpi_wtime_drift_interval = 100000;
+
+static mca_base_var_enum_value_t ompi_mpi_preconnect_peers_values[] = {
+    {OMPI_MPI_PRECONNECT_ALL, "all"},
+    {OMPI_MPI_PRECONNECT_NEIGHBORS, "neighbors"},
+    {OMPI_MPI_PRECONNECT_LEADERS, "leaders"},
+    {0, NULL}};
 
 static bool show_default_mca_params = false;
 static bool show_file_mca_params = false;
@@ -102,6 +122,7 @@ bool ompi_ftmpi_enabled = false;
 
 int ompi_mpi_register_params(void)
 {
+    mca_base_var_enum_t *new_enum;
     int value;
 
 #if OPAL_ENABLE_FT_MPI
@@ -270,6 +291,40 @@ int ompi_mpi_register_params(void)
     mca_base_var_register_synonym(value, "ompi", "mpi", NULL, "preconnect_all",
                                   MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    ompi_mpi_preconnect_peers = OMPI_MPI_PRECONNECT_ALL;
+    (void) mca_base_var_enum_create("ompi_mpi_preconnect_peers", ompi_mpi_preconnect_peers_values,
+                                    &new_enum);
+    (void) mca_base_var_register("ompi", "mpi", NULL, "preconnect_peers",
+                                 "Peers connected with mpi_preconnect_mpi. all: every process, "
+                                 "neighbors: the mpi_preconnect_hops closest ranks on each side "
+                                 "in MPI_COMM_WORLD, leaders: the lowest ranks of the nodes with "
+                                 "each other (default: all)",
+                                 MCA_BASE_VAR_TYPE_INT, new_enum, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                 &ompi_mpi_preconnect_peers);
+    OBJ_RELEASE(new_enum);
+
+    ompi_mpi_preconnect_hops = 1;
+    (void) mca_base_var_register("ompi", "mpi", NULL, "preconnect_hops",
+                                 "Number of ranks connected on each side with "
+                                 "mpi_preconnect_peers=neighbors (default: 1)",
+                                 MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                 &ompi_mpi_preconnect_hops);
+
+    ompi_mpi_preconnect_window = 1;
+    (void) mca_base_var_register("ompi", "mpi", NULL, "preconnect_window",
+                                 "Number of connections each process establishes at a time "
+                                 "with mpi_preconnect_mpi, before waiting for the oldest. Larger "
+                                 "windows wire up faster, at the risk of overwhelming the "
+                                 "connection setup of the network (default: 1)",
+                                 MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                 &ompi_mpi_preconnect_window);
+
     /* Sparse group storage support */
     (void) mca_base_var_register("ompi", "mpi", NULL, "have_sparse_group_storage",
                                  "Whether this Open MPI installation supports storing of data in MPI groups in \"sparse\" formats (good for extremely large process count MPI jobs that create many communicators/groups)",
@@ -294,6 +349,14 @@ int ompi_mpi_register_params(void)
         ompi_use_sparse_group_storage = false;
     }
 
+    ompi_sparse_group_min_size = 1024;
+    (void) mca_base_var_register("ompi", "mpi", NULL, "sparse_group_min_size",
+                                 "Smallest number of processes for which a group is stored in a \"sparse\" format (only relevant if mpi_use_sparse_group_storage is 1)",
+                                 MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &ompi_sparse_group_min_size);
+
     value = mca_base_var_find ("opal", "opal", NULL, "cuda_support");
     if (0 <= value) {
         mca_base_var_register_synonym(value, "ompi", "mpi", NULL, "cuda_support",
@@ -344,6 +407,18 @@ int ompi_mpi_register_params(void)
                                  MCA_BASE_VAR_SCOPE_READONLY,
                                  &ompi_async_mpi_finalize);
 
+    ompi_mpi_fast_finalize = false;
+    (void) mca_base_var_register("ompi", "mpi", NULL, "fast_finalize",
+                                 "Skip the teardown of the MPI objects and of the communication "
+                                 "components in MPI_Finalize: after a tree barrier over "
+                                 "MPI_COMM_WORLD the process only leaves the runtime, and its exit "
+                                 "reclaims the resources. For jobs that exit right after MPI_Finalize "
+                                 "over transports that deliver the messages they accepted",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                 &ompi_mpi_fast_finalize);
+
     value = mca_base_var_find ("opal", "opal", NULL, "abort_delay");
     if (0 <= value) {
         (void) mca_base_var_register_synonym(value, "ompi", "mpi", NULL, "abort_delay",
@@ -380,6 +455,22 @@ int ompi_mpi_register_params(void)
                                  OPAL_INFO_LVL_4,
                                  MCA_BASE_VAR_SCOPE_READONLY,
                                  &ompi_mpi_spc_dump_enabled);
+
+    ompi_mpi_spc_comm_enabled = false;
+    (void) mca_base_var_register("ompi", "mpi", NULL, "spc_comm",
+                                 "A boolean value for whether (true) or not (false) to count the messages and bytes sent and received on each communicator, and the bytes sent to each bucket of peers. The counters are exposed as MPI_T pvars bound to the communicators.",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                 OPAL_INFO_LVL_4,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &ompi_mpi_spc_comm_enabled);
+
+    ompi_mpi_spc_histograms_enabled = false;
+    (void) mca_base_var_register("ompi", "mpi", NULL, "spc_histograms",
+                                 "A boolean value for whether (true) or not (false) to keep the latency histograms of the send and receive requests, of the residency of the unexpected messages and of each algorithm of the coll/tuned collectives. The histograms are exposed as MPI_T pvars, and dumped in MPI_Finalize with mpi_spc_dump_enabled.",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                 OPAL_INFO_LVL_4,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &ompi_mpi_spc_histograms_enabled);
 #endif // SPC_ENABLE
 
     ompi_pmix_connect_timeout = 0; /* infinite timeout - see PMIx standard */
@@ -389,6 +480,72 @@ int ompi_mpi_register_params(void)
                                   0, 0, OPAL_INFO_LVL_3, MCA_BASE_VAR_SCOPE_LOCAL,
                                   &ompi_pmix_connect_timeout);
 
+    ompi_dpm_lazy_add_procs = true;
+    (void) mca_base_var_register ("ompi", "mpi", NULL, "dpm_lazy_add_procs",
+                                  "Add the processes of the remote jobs met in "
+                                  "MPI_Comm_connect/accept and MPI_Comm_spawn to the PML "
+                                  "on their first use instead of when the intercommunicator "
+                                  "is created, when the PML supports it. Default: true",
+                                  MCA_BASE_VAR_TYPE_BOOL, NULL,
+                                  0, 0, OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_LOCAL,
+                                  &ompi_dpm_lazy_add_procs);
+
+    ompi_comm_split_bucket_min_size = 4096;
+    (void) mca_base_var_register ("ompi", "mpi", NULL, "comm_split_bucket_min_size",
+                                  "Smallest intra-communicator for which MPI_Comm_split sends "
+                                  "the (color, key) of each rank to the owner of its color "
+                                  "instead of allgathering them from all ranks (0 disables). "
+                                  "Default: 4096",
+                                  MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL,
+                                  0, 0, OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                  &ompi_comm_split_bucket_min_size);
+
+    ompi_comm_split_bucket_max_color = 256;
+    (void) mca_base_var_register ("ompi", "mpi", NULL, "comm_split_bucket_max_color",
+                                  "Largest color the owner sends the member list to all its "
+                                  "members in the MPI_Comm_split bucket exchange, splits with "
+                                  "larger colors fall back to the allgather. Default: 256",
+                                  MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL,
+                                  0, 0, OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                  &ompi_comm_split_bucket_max_color);
+
+    ompi_comm_cid_block_size = 8;
+    (void) mca_base_var_register ("ompi", "mpi", NULL, "comm_cid_block_size",
+                                  "Number of communicator ids an intra-communicator reserves "
+                                  "at once when one of its children needs one. The next "
+                                  "children then get theirs without communication (1 disables "
+                                  "the reservation). Default: 8",
+                                  MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL,
+                                  0, 0, OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                  &ompi_comm_cid_block_size);
+
+    ompi_mpi_wtime_global = false;
+    (void) mca_base_var_register ("ompi", "mpi", NULL, "wtime_global",
+                                  "Synchronize the clocks of MPI_COMM_WORLD in MPI_Init, so that "
+                                  "MPI_Wtime returns the same time on all the processes and "
+                                  "MPI_WTIME_IS_GLOBAL is true. Default: false",
+                                  MCA_BASE_VAR_TYPE_BOOL, NULL,
+                                  0, 0, OPAL_INFO_LVL_4, MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                  &ompi_mpi_wtime_global);
+
+    ompi_mpi_wtime_sync_rounds = 16;
+    (void) mca_base_var_register ("ompi", "mpi", NULL, "wtime_sync_rounds",
+                                  "Number of ping-pongs of each clock offset estimation of "
+                                  "mpi_wtime_global, the one with the shortest round trip is "
+                                  "kept. Default: 16",
+                                  MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL,
+                                  0, 0, OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                  &ompi_mpi_wtime_sync_rounds);
+
+    ompi_mpi_wtime_drift_interval = 100000;
+    (void) mca_base_var_register ("ompi", "mpi", NULL, "wtime_drift_interval",
+                                  "Microseconds between the two offset estimations from which "
+                                  "mpi_wtime_global derives the drift of each clock; 0 only "
+                                  "estimates the offsets. Default: 100000",
+                                  MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL,
+                                  0, 0, OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                  &ompi_mpi_wtime_drift_interval);
+
     return OMPI_SUCCESS;
 }
 
@@ -10,6 +10,9 @@
  * Copyright (c) 2016      Intel, Inc.  All rights reserved.
  * Copyright (c) 2017      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -21,20 +24,159 @@
 
 #include <stdlib.h>
 
+#include "opal/class/opal_hash_table.h"
+#include "opal/mca/pmix/pmix-internal.h"
 #include "ompi/constants.h"
 #include "ompi/mca/pml/pml.h"
+#include "ompi/mca/pml/base/pml_base_sendreq.h"
 #include "ompi/communicator/communicator.h"
+#include "ompi/request/request.h"
 #include "ompi/runtime/mpiruntime.h"
+#include "ompi/runtime/params.h"
+#include "ompi/runtime/ompi_rte.h"
 #include "ompi/mca/coll/base/coll_base_util.h"
 
+/*
+ * Each round, every process sends to the member of peers (the world
+ * ranks when NULL) round hops to the right and receives from the one
+ * round hops to the left, so both ends of each connection take part in
+ * the same round. Up to ompi_mpi_preconnect_window rounds are in flight
+ * at a time: one bounds the "flooding" that can overwhelm the out-of-band
+ * system used to wire up some networks, leading to poor performance and
+ * hangs, larger ones let the connections of several rounds progress
+ * together (from the async progress thread when there is one).
+ */
+static int ompi_preconnect_rounds (const int *peers, int npeers, int me, int nrounds)
+{
+    int window = (int) ompi_mpi_preconnect_window, posted = 0, active = 0, round, next, prev;
+    char inbuf[1] = {'\0'}, outbuf[1] = {'\0'};
+    ompi_request_t **reqs;
+    int ret = OMPI_SUCCESS, index, slot;
+
+    if (nrounds < 1) {
+        return OMPI_SUCCESS;
+    }
+    if (window < 1) {
+        window = 1;
+    }
+    if (window > nrounds) {
+        window = nrounds;
+    }
+    if (1 == window) {
+        for (round = 1 ; round <= nrounds ; ++round) {
+            next = (me + round) % npeers;
+            prev = (me - round + npeers) % npeers;
+            ret = ompi_coll_base_sendrecv_actual(outbuf, 1, MPI_CHAR,
+                                                 peers ? peers[next] : next, 1,
+                                                 inbuf, 1, MPI_CHAR,
+                                                 peers ? peers[prev] : prev, 1,
+                                                 MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            if (OMPI_SUCCESS != ret) {
+                return ret;
+            }
+        }
+        return OMPI_SUCCESS;
+    }
+
+    /* a receive and a send per slot, the data is never looked at */
+    reqs = (ompi_request_t **) malloc(2 * window * sizeof(ompi_request_t *));
+    if (NULL == reqs) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    for (slot = 0 ; slot < 2 * window ; ++slot) {
+        reqs[slot] = &ompi_request_null.request;
+    }
+
+    slot = 0;
+    do {
+        if (posted < nrounds) {
+            round = ++posted;
+            next = (me + round) % npeers;
+            prev = (me - round + npeers) % npeers;
+            ret = MCA_PML_CALL(irecv(inbuf, 1, MPI_CHAR, peers ? peers[prev] : prev, 1,
+                                     MPI_COMM_WORLD, &reqs[2 * slot]));
+            if (OMPI_SUCCESS != ret) {
+                break;
+            }
+            ret = MCA_PML_CALL(isend(outbuf, 1, MPI_CHAR, peers ? peers[next] : next, 1,
+                                     MCA_PML_BASE_SEND_STANDARD, MPI_COMM_WORLD,
+                                     &reqs[2 * slot + 1]));
+            if (OMPI_SUCCESS != ret) {
+                break;
+            }
+            active += 2;
+            if (posted < window) {
+                ++slot;
+                continue;
+            }
+        }
+
+        /* wait for a slot whose round is over */
+        do {
+            ret = ompi_request_wait_any(2 * window, reqs, &index, MPI_STATUS_IGNORE);
+            if (OMPI_SUCCESS != ret) {
+                break;
+            }
+            --active;
+        } while (active > 0 && &ompi_request_null.request != reqs[index ^ 1]);
+        slot = index / 2;
+    } while (OMPI_SUCCESS == ret && active > 0);
+
+    /* on error the pending requests are left to the abort */
+    free(reqs);
+    return ret;
+}
+
+/*
+ * The lowest world rank of each node, from the node ids of the modex
+ * data of the job. Returns the number of leaders, or -1.
+ */
+static int ompi_preconnect_node_leaders (int comm_size, int **leaders)
+{
+    uint32_t nodeid, *pnodeid = &nodeid;
+    opal_process_name_t name;
+    opal_hash_table_t nodes;
+    int i, count = 0, ret;
+    void *seen;
+
+    *leaders = (int *) malloc(comm_size * sizeof(int));
+    if (NULL == *leaders) {
+        return -1;
+    }
+
+    OBJ_CONSTRUCT(&nodes, opal_hash_table_t);
+    opal_hash_table_init(&nodes, 1024);
+
+    name.jobid = OMPI_PROC_MY_NAME->jobid;
+    for (i = 0 ; i < comm_size ; ++i) {
+        name.vpid = i;
+        OPAL_MODEX_RECV_VALUE(ret, PMIX_NODEID, &name, &pnodeid, PMIX_UINT32);
+        if (PMIX_SUCCESS != ret) {
+            count = -1;
+            break;
+        }
+        if (OPAL_SUCCESS != opal_hash_table_get_value_uint32(&nodes, nodeid, &seen)) {
+            opal_hash_table_set_value_uint32(&nodes, nodeid, (void *) (intptr_t) 1);
+            (*leaders)[count++] = i;
+        }
+    }
+
+    OBJ_DESTRUCT(&nodes);
+    if (0 > count) {
+        free(*leaders);
+        *leaders = NULL;
+    }
+    return count;
+}
+
 int
 ompi_init_preconnect_mpi(void)
 {
     int comm_size = ompi_comm_size(MPI_COMM_WORLD);
     int comm_rank =  ompi_comm_rank(MPI_COMM_WORLD);
-    int param, next, prev, i, ret = OMPI_SUCCESS;
-    char inbuf[1], outbuf[1];
+    int param, nleaders, me, ret = OMPI_SUCCESS;
     const bool *value = NULL;
+    int *leaders = NULL;
 
     param = mca_base_var_find("ompi", "mpi", NULL, "preconnect_mpi");
     if (0 > param) return OMPI_SUCCESS;
@@ -43,29 +185,29 @@ ompi_init_preconnect_mpi(void)
         return OMPI_SUCCESS;
     }
 
-    inbuf[0] = outbuf[0] = '\0';
-
-    /* Each iteration, every process sends to its neighbor i hops to
-       the right and receives from its neighbor i hops to the left.
-       Because send_complete is used, there will only ever be one
-       outstanding send and one outstanding receive in the network at
-       a time for any given process.  This limits any "flooding"
-       effect that can occur with other connection algorithms.  While
-       the flooding algorithms may be a more efficient use of
-       resources, they can overwhelm the out-of-band connection system
-       used to wire up some networks, leading to poor performance and
-       hangs. */
-    for (i = 1 ; i <= comm_size / 2 ; ++i) {
-        next = (comm_rank + i) % comm_size;
-        prev = (comm_rank - i + comm_size) % comm_size;
-
-        ret = ompi_coll_base_sendrecv_actual(outbuf, 1, MPI_CHAR,
-                                             next, 1,
-                                             inbuf, 1, MPI_CHAR,
-                                             prev, 1,
-                                             MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-        if(OMPI_SUCCESS != ret) return ret;
+    switch (ompi_mpi_preconnect_peers) {
+    case OMPI_MPI_PRECONNECT_NEIGHBORS:
+        /* the ranks up to ompi_mpi_preconnect_hops away on each side */
+        if (ompi_mpi_preconnect_hops < (uint32_t) comm_size / 2) {
+            return ompi_preconnect_rounds(NULL, comm_size, comm_rank,
+                                          (int) ompi_mpi_preconnect_hops);
+        }
+        break;
+    case OMPI_MPI_PRECONNECT_LEADERS:
+        /* the leaders of the nodes with each other, the rest is local */
+        nleaders = ompi_preconnect_node_leaders(comm_size, &leaders);
+        if (0 > nleaders) {
+            break;
+        }
+        for (me = 0 ; me < nleaders && leaders[me] != comm_rank ; ++me);
+        if (me < nleaders) {
+            ret = ompi_preconnect_rounds(leaders, nleaders, me, nleaders / 2);
+        }
+        free(leaders);
+        return ret;
+    default:
+        break;
     }
 
-    return ret;
+    return ompi_preconnect_rounds(NULL, comm_size, comm_rank, comm_size / 2);
 }
@@ -18,6 +18,7 @@
 
 #include "ompi_config.h"
 
+#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -28,11 +29,14 @@
 
 #include "ompi/communicator/communicator.h"
 #include "ompi/datatype/ompi_datatype.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
 #include "opal/mca/timer/timer.h"
 #include "opal/mca/base/mca_base_pvar.h"
 #include "opal/util/argv.h"
 #include "opal/util/show_help.h"
 #include "opal/util/output.h"
+#include "opal/util/printf.h"
 
 #if SPC_ENABLE == 1
 
@@ -243,6 +247,314 @@ static int ompi_spc_get_count(const struct mca_base_pvar_t *pvar, void *value, v
     return MPI_SUCCESS;
 }
 
+/* The per communicator counters */
+bool ompi_spc_comm_enabled = false;
+opal_thread_local int ompi_spc_comm_shard = -1;
+static opal_atomic_int32_t ompi_spc_comm_next_shard = 0;
+
+#define OMPI_SPC_COMM_PEER_BYTES_SENT OMPI_SPC_COMM_NUM_COUNTERS
+
+static const ompi_spc_event_t ompi_spc_comm_desc[OMPI_SPC_COMM_NUM_COUNTERS + 1] = {
+    SET_COUNTER_ARRAY(OMPI_SPC_COMM_MESSAGES_SENT, "The number of point-to-point messages sent on the communicator.", false, false),
+    SET_COUNTER_ARRAY(OMPI_SPC_COMM_BYTES_SENT, "The number of bytes sent through point-to-point communications on the communicator.", false, false),
+    SET_COUNTER_ARRAY(OMPI_SPC_COMM_MESSAGES_RECEIVED, "The number of point-to-point messages received on the communicator.", false, false),
+    SET_COUNTER_ARRAY(OMPI_SPC_COMM_BYTES_RECEIVED, "The number of bytes received through point-to-point communications on the communicator.", false, false),
+    SET_COUNTER_ARRAY(OMPI_SPC_COMM_PEER_BYTES_SENT, "The number of bytes sent to each bucket of peers of the communicator. The peers are split in "
+                                                     "contiguous ranges of ranks, one value per range.", false, false)
+};
+
+ompi_spc_comm_t *ompi_spc_comm_alloc(ompi_spc_comm_t **spc)
+{
+    ompi_spc_comm_t *counters = NULL, *expected = NULL;
+
+    if( 0 != posix_memalign((void **)&counters, sizeof(ompi_spc_comm_shard_t), sizeof(*counters)) ) {
+        return NULL;
+    }
+    memset(counters, 0, sizeof(*counters));
+
+    /* Another thread may have raced us to the first update */
+    if( !opal_atomic_compare_exchange_strong_ptr((opal_atomic_intptr_t *)spc, (intptr_t *)&expected,
+                                                 (intptr_t)counters) ) {
+        free(counters);
+        counters = expected;
+    }
+    return counters;
+}
+
+void ompi_spc_comm_shard_init(void)
+{
+    ompi_spc_comm_shard = opal_atomic_fetch_add_32(&ompi_spc_comm_next_shard, 1) % OMPI_SPC_COMM_SHARDS;
+}
+
+void ompi_spc_comm_free(ompi_spc_comm_t *spc)
+{
+    free(spc);
+}
+
+static int ompi_spc_comm_notify(mca_base_pvar_t *pvar, mca_base_pvar_event_t event, void *obj_handle, int *count)
+{
+    if(MCA_BASE_PVAR_HANDLE_BIND == event) {
+        *count = (OMPI_SPC_COMM_PEER_BYTES_SENT == (int)(uintptr_t)pvar->ctx) ? OMPI_SPC_COMM_PEER_BUCKETS : 1;
+    }
+    return MPI_SUCCESS;
+}
+
+/* Sums up the shards of the communicator the pvar is bound to */
+static int ompi_spc_comm_get_count(const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    ompi_communicator_t *comm = (ompi_communicator_t *)obj_handle;
+    long long *counter_value_ptr = (long long*)value;
+    int index = (int)(uintptr_t)pvar->ctx;
+    int count = (OMPI_SPC_COMM_PEER_BYTES_SENT == index) ? OMPI_SPC_COMM_PEER_BUCKETS : 1;
+    int i, j;
+
+    for(j = 0; j < count; j++) {
+        counter_value_ptr[j] = 0;
+    }
+    if( NULL == comm || NULL == comm->c_spc ) {
+        return MPI_SUCCESS;
+    }
+
+    for(i = 0; i < OMPI_SPC_COMM_SHARDS; i++) {
+        ompi_spc_comm_shard_t *shard = &comm->c_spc->shards[i];
+        if( OMPI_SPC_COMM_PEER_BYTES_SENT == index ) {
+            for(j = 0; j < count; j++) {
+                counter_value_ptr[j] += (long long)shard->peer_bytes_sent[j];
+            }
+        } else {
+            counter_value_ptr[0] += (long long)shard->counters[index];
+        }
+    }
+
+    return MPI_SUCCESS;
+}
+
+/* Registers the per communicator counters as MPI_T pvars bound to the communicators */
+static void ompi_spc_comm_init(void)
+{
+    int i, ret;
+
+    if( !ompi_mpi_spc_comm_enabled ) {
+        return;
+    }
+
+    for(i = 0; i <= OMPI_SPC_COMM_NUM_COUNTERS; i++) {
+        ret = mca_base_pvar_register("ompi", "runtime", "spc", ompi_spc_comm_desc[i].counter_name, ompi_spc_comm_desc[i].counter_description,
+                                     OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_COUNTER,
+                                     MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL, MPI_T_BIND_MPI_COMM,
+                                     MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                     ompi_spc_comm_get_count, NULL, ompi_spc_comm_notify, (void*)(uintptr_t)i);
+        if( ret < 0 ) {
+            opal_show_help("help-mpi-runtime.txt", "spc: MPI_T disabled", true);
+            return;
+        }
+    }
+
+    ompi_spc_comm_enabled = true;
+}
+
+/* The latency histograms */
+bool ompi_spc_hist_enabled = false;
+uint64_t ompi_spc_hist_ns_mult = 0;
+ompi_spc_hist_t ompi_spc_hists[OMPI_SPC_HIST_NUM] = {{{0}}};
+
+/* OMPI_SPC_HIST_COLL_ALGS histograms for each collective */
+static ompi_spc_hist_t *ompi_spc_coll_hists = NULL;
+
+static const ompi_spc_event_t ompi_spc_hists_desc[OMPI_SPC_HIST_NUM] = {
+    SET_COUNTER_ARRAY(OMPI_SPC_HIST_SEND, "The histogram of the latencies, from the start to the MPI completion, of the send requests.", false, false),
+    SET_COUNTER_ARRAY(OMPI_SPC_HIST_RECV, "The histogram of the latencies, from the start to the MPI completion, of the receive requests.", false, false),
+    SET_COUNTER_ARRAY(OMPI_SPC_HIST_UNEXPECTED, "The histogram of the time the messages spent in the unexpected message queue.", false, false)
+};
+
+void ompi_spc_coll_hist_record(int coll_id, int algorithm, opal_timer_t cycles)
+{
+    if( 0 == cycles || NULL == ompi_spc_coll_hists ||
+        algorithm < 0 || algorithm >= OMPI_SPC_HIST_COLL_ALGS ) {
+        return;
+    }
+    ompi_spc_hist_record(&ompi_spc_coll_hists[coll_id * OMPI_SPC_HIST_COLL_ALGS + algorithm], cycles);
+}
+
+/* The pvars of the index OMPI_SPC_HIST_NUM + coll_id are the collective ones */
+static ompi_spc_hist_t *ompi_spc_hist_pvar_hists(int index, int *count)
+{
+    if( index < OMPI_SPC_HIST_NUM ) {
+        *count = 1;
+        return &ompi_spc_hists[index];
+    }
+    *count = OMPI_SPC_HIST_COLL_ALGS;
+    return &ompi_spc_coll_hists[(index - OMPI_SPC_HIST_NUM) * OMPI_SPC_HIST_COLL_ALGS];
+}
+
+static int ompi_spc_hist_notify(mca_base_pvar_t *pvar, mca_base_pvar_event_t event, void *obj_handle, int *count)
+{
+    if(MCA_BASE_PVAR_HANDLE_BIND == event) {
+        ompi_spc_hist_pvar_hists((int)(uintptr_t)pvar->ctx, count);
+        *count *= OMPI_SPC_HIST_BUCKETS;
+    }
+    return MPI_SUCCESS;
+}
+
+static int ompi_spc_hist_get_count(const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    long long *counter_value_ptr = (long long*)value;
+    ompi_spc_hist_t *hists;
+    int i, j, count;
+
+    hists = ompi_spc_hist_pvar_hists((int)(uintptr_t)pvar->ctx, &count);
+    for(i = 0; i < count; i++) {
+        for(j = 0; j < OMPI_SPC_HIST_BUCKETS; j++) {
+            counter_value_ptr[i * OMPI_SPC_HIST_BUCKETS + j] = (long long)hists[i].buckets[j];
+        }
+    }
+
+    return MPI_SUCCESS;
+}
+
+/* Registers the histograms as MPI_T pvars, one per point-to-point latency
+ * and one per collective */
+static void ompi_spc_hist_init(void)
+{
+    char *name, *desc, *c;
+    int i, ret;
+
+    if( !ompi_mpi_spc_histograms_enabled || 0 == sys_clock_freq_mhz ) {
+        return;
+    }
+
+    ompi_spc_coll_hists = (ompi_spc_hist_t*)calloc(COLLCOUNT * OMPI_SPC_HIST_COLL_ALGS, sizeof(ompi_spc_hist_t));
+    if( NULL == ompi_spc_coll_hists ) {
+        opal_show_help("help-mpi-runtime.txt", "lib-call-fail", true,
+                       "calloc", __FILE__, __LINE__);
+        return;
+    }
+
+    for(i = 0; i < OMPI_SPC_HIST_NUM + COLLCOUNT; i++) {
+        if( i < OMPI_SPC_HIST_NUM ) {
+            ret = mca_base_pvar_register("ompi", "runtime", "spc", ompi_spc_hists_desc[i].counter_name, ompi_spc_hists_desc[i].counter_description,
+                                         OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_COUNTER,
+                                         MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL, MPI_T_BIND_NO_OBJECT,
+                                         MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                         ompi_spc_hist_get_count, NULL, ompi_spc_hist_notify, (void*)(uintptr_t)i);
+        } else {
+            if( 0 > opal_asprintf(&name, "OMPI_SPC_HIST_COLL_%s", mca_coll_base_colltype_to_str(i - OMPI_SPC_HIST_NUM)) ) {
+                break;
+            }
+            for(c = name; '\0' != *c; c++) {
+                *c = toupper(*c);
+            }
+            if( 0 > opal_asprintf(&desc, "The histograms of the durations of %s, one per coll/tuned algorithm.",
+                                  mca_coll_base_colltype_to_str(i - OMPI_SPC_HIST_NUM)) ) {
+                free(name);
+                break;
+            }
+            ret = mca_base_pvar_register("ompi", "runtime", "spc", name, desc,
+                                         OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_COUNTER,
+                                         MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL, MPI_T_BIND_NO_OBJECT,
+                                         MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                         ompi_spc_hist_get_count, NULL, ompi_spc_hist_notify, (void*)(uintptr_t)i);
+            free(name);
+            free(desc);
+        }
+        if( ret < 0 ) {
+            opal_show_help("help-mpi-runtime.txt", "spc: MPI_T disabled", true);
+            break;
+        }
+    }
+
+    ompi_spc_hist_ns_mult = (UINT64_C(1000) << OMPI_SPC_HIST_NS_SHIFT) / sys_clock_freq_mhz;
+    ompi_spc_hist_enabled = true;
+}
+
+/* The lower bound in ns of a histogram bucket */
+static uint64_t ompi_spc_hist_bucket_ns(int bucket)
+{
+    if( bucket < (1 << OMPI_SPC_HIST_SUB_BITS) ) {
+        return (uint64_t)bucket;
+    }
+    return (uint64_t)((1 << OMPI_SPC_HIST_SUB_BITS) + (bucket & ((1 << OMPI_SPC_HIST_SUB_BITS) - 1)))
+               << ((bucket >> OMPI_SPC_HIST_SUB_BITS) - 1);
+}
+
+/* Prints the count and the percentiles of a histogram summed over the ranks */
+static void ompi_spc_hist_print(const char *name, const long long *buckets)
+{
+    static const double percentiles[] = {0.5, 0.99, 0.999};
+    uint64_t values[3] = {0, 0, 0}, max = 0;
+    long long total = 0, seen = 0;
+    int i, p = 0;
+
+    for(i = 0; i < OMPI_SPC_HIST_BUCKETS; i++) {
+        total += buckets[i];
+    }
+    if( 0 == total ) {
+        return;
+    }
+    for(i = 0; i < OMPI_SPC_HIST_BUCKETS; i++) {
+        if( 0 == buckets[i] ) {
+            continue;
+        }
+        seen += buckets[i];
+        while( p < 3 && seen >= percentiles[p] * total ) {
+            values[p++] = ompi_spc_hist_bucket_ns(i);
+        }
+        max = ompi_spc_hist_bucket_ns(i);
+    }
+    opal_output(0, "%s -> count %lld p50 %" PRIu64 " ns p99 %" PRIu64 " ns p99.9 %" PRIu64 " ns max %" PRIu64 " ns\n",
+                name, total, values[0], values[1], values[2], max);
+}
+
+/* Sums up the histograms of all the ranks onto rank 0 and prints them */
+static void ompi_spc_hist_dump(void)
+{
+    int i, j, count = (OMPI_SPC_HIST_NUM + COLLCOUNT * OMPI_SPC_HIST_COLL_ALGS) * OMPI_SPC_HIST_BUCKETS;
+    long long *recv_buffer = NULL, *send_buffer;
+    char *name;
+
+    send_buffer = (long long*)malloc(count * sizeof(long long));
+    if( 0 == ompi_comm_rank(ompi_spc_comm) ) {
+        recv_buffer = (long long*)malloc(count * sizeof(long long));
+    }
+    if( NULL == send_buffer || (0 == ompi_comm_rank(ompi_spc_comm) && NULL == recv_buffer) ) {
+        opal_show_help("help-mpi-runtime.txt", "lib-call-fail", true,
+                       "malloc", __FILE__, __LINE__);
+        free(send_buffer);
+        free(recv_buffer);
+        return;
+    }
+    for(i = 0; i < OMPI_SPC_HIST_NUM; i++) {
+        for(j = 0; j < OMPI_SPC_HIST_BUCKETS; j++) {
+            send_buffer[i * OMPI_SPC_HIST_BUCKETS + j] = (long long)ompi_spc_hists[i].buckets[j];
+        }
+    }
+    for(i = 0; i < COLLCOUNT * OMPI_SPC_HIST_COLL_ALGS; i++) {
+        for(j = 0; j < OMPI_SPC_HIST_BUCKETS; j++) {
+            send_buffer[(OMPI_SPC_HIST_NUM + i) * OMPI_SPC_HIST_BUCKETS + j] = (long long)ompi_spc_coll_hists[i].buckets[j];
+        }
+    }
+    (void)ompi_spc_comm->c_coll->coll_reduce(send_buffer, recv_buffer, count, MPI_LONG_LONG,
+                                             MPI_SUM, 0, ompi_spc_comm,
+                                             ompi_spc_comm->c_coll->coll_reduce_module);
+
+    if( NULL != recv_buffer ) {
+        opal_output(0, "Open MPI Software-based Performance Counters latency histograms (all ranks):\n");
+        for(i = 0; i < OMPI_SPC_HIST_NUM; i++) {
+            ompi_spc_hist_print(ompi_spc_hists_desc[i].counter_name, &recv_buffer[i * OMPI_SPC_HIST_BUCKETS]);
+        }
+        for(i = 0; i < COLLCOUNT * OMPI_SPC_HIST_COLL_ALGS; i++) {
+            if( 0 > opal_asprintf(&name, "%s algorithm %d", mca_coll_base_colltype_to_str(i / OMPI_SPC_HIST_COLL_ALGS),
+                                  i % OMPI_SPC_HIST_COLL_ALGS) ) {
+                break;
+            }
+            ompi_spc_hist_print(name, &recv_buffer[(OMPI_SPC_HIST_NUM + i) * OMPI_SPC_HIST_BUCKETS]);
+            free(name);
+        }
+        free(recv_buffer);
+    }
+    free(send_buffer);
+}
+
 /* Allocate and initializes the events data structure. */
 static void ompi_spc_events_init(void)
 {
@@ -323,6 +635,9 @@ void ompi_spc_init(void)
     }
 
     opal_argv_free(arg_strings);
+
+    ompi_spc_comm_init();
+    ompi_spc_hist_init();
 }
 
 /* Gathers all of the SPC data onto rank 0 of MPI_COMM_WORLD and prints out all
@@ -397,8 +712,14 @@ void ompi_spc_fini(void)
 {
     if (ompi_mpi_spc_dump_enabled) {
         ompi_spc_dump();
+        if (ompi_spc_hist_enabled) {
+            ompi_spc_hist_dump();
+        }
         ompi_comm_free(&ompi_spc_comm);
     }
+    ompi_spc_hist_enabled = false;
+    free(ompi_spc_coll_hists);
+    ompi_spc_coll_hists = NULL;
 }
 
 /* Converts a counter value that is in cycles to microseconds.
@@ -20,6 +20,7 @@
 #include "opal/sys/atomic.h"
 #include "opal/include/opal/prefetch.h"
 #include "opal/mca/threads/thread_usage.h"
+#include "opal/util/bit_ops.h"
 
 #include MCA_timer_IMPLEMENTATION_HEADER
 
@@ -168,6 +169,62 @@ typedef struct ompi_spc_s{
     bool is_timer_event;
 } ompi_spc_t;
 
+/* The per communicator counters, enabled with the mpi_spc_comm MCA parameter
+ * and exposed as MPI_T pvars bound to the communicators.  The bytes sent are
+ * also accounted per bucket of peers, the peers of a communicator being split
+ * in OMPI_SPC_COMM_PEER_BUCKETS contiguous ranges of ranks.
+ *
+ * The counters of a communicator are allocated on its first update, in a few
+ * cache line aligned shards that the threads are spread over, and they are
+ * only summed up when a pvar is read.
+ */
+typedef enum ompi_spc_comm_counters {
+    OMPI_SPC_COMM_MESSAGES_SENT,
+    OMPI_SPC_COMM_BYTES_SENT,
+    OMPI_SPC_COMM_MESSAGES_RECEIVED,
+    OMPI_SPC_COMM_BYTES_RECEIVED,
+    OMPI_SPC_COMM_NUM_COUNTERS /* This serves as the number of counters.  It must be last. */
+} ompi_spc_comm_counters_t;
+
+#define OMPI_SPC_COMM_PEER_BUCKETS 16
+#define OMPI_SPC_COMM_SHARDS       8
+
+typedef struct ompi_spc_comm_shard_t {
+    opal_atomic_int64_t counters[OMPI_SPC_COMM_NUM_COUNTERS];
+    opal_atomic_int64_t peer_bytes_sent[OMPI_SPC_COMM_PEER_BUCKETS];
+} __opal_attribute_aligned__(64) ompi_spc_comm_shard_t;
+
+typedef struct ompi_spc_comm_t {
+    ompi_spc_comm_shard_t shards[OMPI_SPC_COMM_SHARDS];
+} ompi_spc_comm_t;
+
+/* The latency histograms, enabled with the mpi_spc_histograms MCA parameter
+ * and exposed as MPI_T pvar arrays of OMPI_SPC_HIST_BUCKETS counts.  The
+ * latencies are taken with the cycle counter of the timer framework and
+ * bucketed in nanoseconds with 4 linear sub-buckets per power of 2: bucket
+ * b < 4 counts the latencies of b ns and bucket b >= 4 the latencies in
+ * [(4 + b % 4) << (b / 4 - 1), (5 + b % 4) << (b / 4 - 1)) ns.  The last
+ * bucket also counts everything above 2^30 ns.
+ *
+ * The collective histograms are kept per collective and per algorithm of
+ * coll/tuned, the pvar of a collective holding OMPI_SPC_HIST_COLL_ALGS
+ * histograms one after the other.
+ */
+typedef enum ompi_spc_histograms {
+    OMPI_SPC_HIST_SEND,        /* start of a send request to its MPI completion */
+    OMPI_SPC_HIST_RECV,        /* start of a receive request to its MPI completion */
+    OMPI_SPC_HIST_UNEXPECTED,  /* residency of the messages in the unexpected queue */
+    OMPI_SPC_HIST_NUM /* This serves as the number of histograms.  It must be last. */
+} ompi_spc_histograms_t;
+
+#define OMPI_SPC_HIST_SUB_BITS  2
+#define OMPI_SPC_HIST_BUCKETS   128
+#define OMPI_SPC_HIST_COLL_ALGS 16
+
+typedef struct ompi_spc_hist_t {
+    opal_atomic_int64_t buckets[OMPI_SPC_HIST_BUCKETS];
+} ompi_spc_hist_t;
+
 /* Definitions for using the SPC utility functions throughout the codebase.
  * If SPC_ENABLE is not 1, the macros become no-ops.
  */
@@ -208,6 +265,85 @@ ompi_spc_t ompi_spc_events[OMPI_SPC_NUM_COUNTERS] __opal_attribute_aligned__(siz
 #define SPC_UPDATE_WATERMARK(watermark_enum, value_enum) \
     ompi_spc_update_watermark(watermark_enum, value_enum)
 
+#define SPC_COMM_RECORD_SEND(comm, peer, bytes) \
+    ompi_spc_comm_record_send(&(comm)->c_spc, peer, ompi_comm_remote_size(comm), bytes)
+
+#define SPC_COMM_RECORD_RECV(comm, bytes) \
+    ompi_spc_comm_record_recv(&(comm)->c_spc, bytes)
+
+#define SPC_COMM_FREE(comm) \
+    ompi_spc_comm_free((comm)->c_spc)
+
+#define SPC_HIST_START(cycles) \
+    ompi_spc_hist_start(cycles)
+
+#define SPC_HIST_RECORD(hist_id, cycles) \
+    ompi_spc_hist_record(&ompi_spc_hists[hist_id], cycles)
+
+#define SPC_COLL_HIST_RECORD(coll_id, algorithm, cycles) \
+    ompi_spc_coll_hist_record(coll_id, algorithm, cycles)
+
+OMPI_DECLSPEC extern bool ompi_spc_comm_enabled;
+OMPI_DECLSPEC extern opal_thread_local int ompi_spc_comm_shard;
+
+OMPI_DECLSPEC ompi_spc_comm_t *ompi_spc_comm_alloc(ompi_spc_comm_t **spc);
+OMPI_DECLSPEC void ompi_spc_comm_shard_init(void);
+void ompi_spc_comm_free(ompi_spc_comm_t *spc);
+
+/* The shard of the calling thread in the counters of a communicator */
+static inline
+ompi_spc_comm_shard_t *ompi_spc_comm_get_shard(ompi_spc_comm_t **spc)
+{
+    ompi_spc_comm_t *counters = *spc;
+
+    if( OPAL_UNLIKELY(NULL == counters) ) {
+        counters = ompi_spc_comm_alloc(spc);
+        if( NULL == counters ) {
+            return NULL;
+        }
+    }
+    if( OPAL_UNLIKELY(0 > ompi_spc_comm_shard) ) {
+        ompi_spc_comm_shard_init();
+    }
+    return &counters->shards[ompi_spc_comm_shard];
+}
+
+static inline
+void ompi_spc_comm_record_send(ompi_spc_comm_t **spc, int peer, int size, ompi_spc_value_t bytes)
+{
+    ompi_spc_comm_shard_t *shard;
+
+    if( OPAL_LIKELY(!ompi_spc_comm_enabled) ) {
+        return;
+    }
+    shard = ompi_spc_comm_get_shard(spc);
+    if( NULL == shard ) {
+        return;
+    }
+    OPAL_THREAD_ADD_FETCH64(&shard->counters[OMPI_SPC_COMM_MESSAGES_SENT], 1);
+    OPAL_THREAD_ADD_FETCH64(&shard->counters[OMPI_SPC_COMM_BYTES_SENT], bytes);
+    if( 0 <= peer && peer < size ) {
+        OPAL_THREAD_ADD_FETCH64(&shard->peer_bytes_sent[(int64_t)peer * OMPI_SPC_COMM_PEER_BUCKETS / size],
+                                bytes);
+    }
+}
+
+static inline
+void ompi_spc_comm_record_recv(ompi_spc_comm_t **spc, ompi_spc_value_t bytes)
+{
+    ompi_spc_comm_shard_t *shard;
+
+    if( OPAL_LIKELY(!ompi_spc_comm_enabled) ) {
+        return;
+    }
+    shard = ompi_spc_comm_get_shard(spc);
+    if( NULL == shard ) {
+        return;
+    }
+    OPAL_THREAD_ADD_FETCH64(&shard->counters[OMPI_SPC_COMM_MESSAGES_RECEIVED], 1);
+    OPAL_THREAD_ADD_FETCH64(&shard->counters[OMPI_SPC_COMM_BYTES_RECEIVED], bytes);
+}
+
 
 /* Records an update to a counter using an atomic add operation. */
 static inline
@@ -280,6 +416,54 @@ void ompi_spc_timer_stop(unsigned int event_id, opal_timer_t *cycles)
     }
 }
 
+OMPI_DECLSPEC extern bool ompi_spc_hist_enabled;
+OMPI_DECLSPEC extern uint64_t ompi_spc_hist_ns_mult;
+OMPI_DECLSPEC extern ompi_spc_hist_t ompi_spc_hists[OMPI_SPC_HIST_NUM];
+
+OMPI_DECLSPEC void ompi_spc_coll_hist_record(int coll_id, int algorithm, opal_timer_t cycles);
+
+/* The ns_mult scales the cycles to nanoseconds in 20 bits fixed point */
+#define OMPI_SPC_HIST_NS_SHIFT 20
+
+static inline
+int ompi_spc_hist_bucket(uint64_t ns)
+{
+    int msb;
+
+    if( ns < (1 << OMPI_SPC_HIST_SUB_BITS) ) {
+        return (int)ns;
+    }
+    if( OPAL_UNLIKELY(ns >= (UINT64_C(1) << 30)) ) {
+        return OMPI_SPC_HIST_BUCKETS - 1;
+    }
+    msb = opal_hibit((int)ns, 30);
+    return ((msb - OMPI_SPC_HIST_SUB_BITS + 1) << OMPI_SPC_HIST_SUB_BITS) +
+           (int)((ns >> (msb - OMPI_SPC_HIST_SUB_BITS)) & ((1 << OMPI_SPC_HIST_SUB_BITS) - 1));
+}
+
+/* Stores the start of a latency in 'cycles', 0 if the histograms are off */
+static inline
+void ompi_spc_hist_start(opal_timer_t *cycles)
+{
+    *cycles = 0;
+    if( OPAL_UNLIKELY(ompi_spc_hist_enabled) ) {
+        *cycles = opal_timer_base_get_cycles();
+    }
+}
+
+/* Accounts the latency since 'cycles' in the histogram */
+static inline
+void ompi_spc_hist_record(ompi_spc_hist_t *hist, opal_timer_t cycles)
+{
+    uint64_t ns;
+
+    if( OPAL_LIKELY(0 == cycles) ) {
+        return;
+    }
+    ns = ((uint64_t)(opal_timer_base_get_cycles() - cycles) * ompi_spc_hist_ns_mult) >> OMPI_SPC_HIST_NS_SHIFT;
+    OPAL_THREAD_ADD_FETCH64(&hist->buckets[ompi_spc_hist_bucket(ns)], 1);
+}
+
 
 #else /* SPCs are not enabled */
 
@@ -307,6 +491,24 @@ void ompi_spc_timer_stop(unsigned int event_id, opal_timer_t *cycles)
 #define SPC_UPDATE_WATERMARK(watermark_enum, value_enum) \
     ((void)0)
 
+#define SPC_COMM_RECORD_SEND(comm, peer, bytes) \
+    ((void)0)
+
+#define SPC_COMM_RECORD_RECV(comm, bytes) \
+    ((void)0)
+
+#define SPC_COMM_FREE(comm) \
+    ((void)0)
+
+#define SPC_HIST_START(cycles) \
+    ((void)0)
+
+#define SPC_HIST_RECORD(hist_id, cycles) \
+    ((void)0)
+
+#define SPC_COLL_HIST_RECORD(coll_id, algorithm, cycles) \
+    ((void)0)
+
 #endif
 
 #endif
@@ -0,0 +1,200 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#include "opal/util/output.h"
+#include "ompi/constants.h"
+#include "ompi/attribute/attribute.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/pml/pml.h"
+#include "ompi/runtime/mpiruntime.h"
+#include "ompi/runtime/params.h"
+#include "ompi/runtime/ompi_wtime.h"
+
+ompi_wtime_clock_t ompi_wtime_clock = {.base = 0, .scale = 0.0, .offset = 0.0};
+bool ompi_wtime_is_global = false;
+
+/* the communicators are private, any tag will do */
+#define OMPI_WTIME_TAG 0
+
+/*
+ * Ping-pong with the parent, which answers with its global time.  The
+ * sample with the shortest round trip is kept: the parent read its clock
+ * at the middle of it, within half the round trip.
+ */
+static int ompi_wtime_probe(ompi_communicator_t *comm, int parent,
+                            opal_timer_t *mid, double *gtime)
+{
+    opal_timer_t t0, t1, best = 0;
+    char ping = 0;
+    double g;
+    int ret;
+
+    for (uint32_t i = 0; i < ompi_mpi_wtime_sync_rounds || 0 == i; ++i) {
+        t0 = opal_timer_base_get_cycles();
+        ret = MCA_PML_CALL(send(&ping, 1, MPI_CHAR, parent, OMPI_WTIME_TAG,
+                                MCA_PML_BASE_SEND_STANDARD, comm));
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+        ret = MCA_PML_CALL(recv(&g, 1, MPI_DOUBLE, parent, OMPI_WTIME_TAG,
+                                comm, MPI_STATUS_IGNORE));
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+        t1 = opal_timer_base_get_cycles();
+        if (0 == i || t1 - t0 < best) {
+            best = t1 - t0;
+            *mid = t0 + best / 2;
+            *gtime = g;
+        }
+    }
+    return OMPI_SUCCESS;
+}
+
+static int ompi_wtime_serve(ompi_communicator_t *comm, int child)
+{
+    char ping;
+    double g;
+    int ret;
+
+    for (uint32_t i = 0; i < ompi_mpi_wtime_sync_rounds || 0 == i; ++i) {
+        ret = MCA_PML_CALL(recv(&ping, 1, MPI_CHAR, child, OMPI_WTIME_TAG,
+                                comm, MPI_STATUS_IGNORE));
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+        g = ompi_wtime_global();
+        ret = MCA_PML_CALL(send(&g, 1, MPI_DOUBLE, child, OMPI_WTIME_TAG,
+                                MCA_PML_BASE_SEND_STANDARD, comm));
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+    }
+    return OMPI_SUCCESS;
+}
+
+/*
+ * One estimation over the leaders, along a binomial tree rooted at rank 0
+ * so that a parent is synchronized before it serves its children.  The
+ * first pass sets the offset, the second one (if any) derives the rate
+ * of the counter from the two estimations.
+ */
+static int ompi_wtime_tree_pass(ompi_communicator_t *comm, int pass,
+                                opal_timer_t *mid1, double *g1)
+{
+    int rank = ompi_comm_rank(comm), size = ompi_comm_size(comm);
+    opal_timer_t mid;
+    double g;
+    int ret;
+
+    for (int mask = 1; mask < size; mask <<= 1) {
+        if (rank < mask) {
+            if (rank + mask < size) {
+                ret = ompi_wtime_serve(comm, rank + mask);
+                if (OMPI_SUCCESS != ret) {
+                    return ret;
+                }
+            }
+        } else if (rank < 2 * mask) {
+            ret = ompi_wtime_probe(comm, rank - mask, &mid, &g);
+            if (OMPI_SUCCESS != ret) {
+                return ret;
+            }
+            if (0 == pass) {
+                *mid1 = mid;
+                *g1 = g;
+            } else if (mid != *mid1) {
+                ompi_wtime_clock.scale = (g - *g1) / (double) (int64_t) (mid - *mid1);
+            }
+            ompi_wtime_clock.base = mid;
+            ompi_wtime_clock.offset = g;
+        }
+    }
+    return OMPI_SUCCESS;
+}
+
+static int ompi_wtime_sync(void)
+{
+    ompi_communicator_t *node_comm = NULL, *leaders = NULL;
+    opal_timer_t mid1 = 0;
+    double g1 = 0.0;
+    int ret;
+
+    /* the processes of a node share the counter of their leader */
+    ret = ompi_comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, NULL, &node_comm);
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+    ret = ompi_comm_split(MPI_COMM_WORLD, 0 == ompi_comm_rank(node_comm) ? 0 : MPI_UNDEFINED,
+                          ompi_comm_rank(MPI_COMM_WORLD), &leaders, false);
+    if (OMPI_SUCCESS != ret) {
+        goto cleanup;
+    }
+
+    if (MPI_COMM_NULL != leaders && NULL != leaders) {
+        ret = ompi_wtime_tree_pass(leaders, 0, &mid1, &g1);
+        if (OMPI_SUCCESS == ret && 0 < ompi_mpi_wtime_drift_interval &&
+            1 < ompi_comm_size(leaders)) {
+            usleep(ompi_mpi_wtime_drift_interval);
+            ret = ompi_wtime_tree_pass(leaders, 1, &mid1, &g1);
+        }
+        if (OMPI_SUCCESS != ret) {
+            goto cleanup;
+        }
+    }
+
+    ret = node_comm->c_coll->coll_bcast(&ompi_wtime_clock, sizeof(ompi_wtime_clock), MPI_BYTE,
+                                        0, node_comm, node_comm->c_coll->coll_bcast_module);
+
+ cleanup:
+    if (NULL != leaders && MPI_COMM_NULL != leaders) {
+        ompi_comm_free(&leaders);
+    }
+    ompi_comm_free(&node_comm);
+    return ret;
+}
+
+int ompi_wtime_init(void)
+{
+    int ret;
+
+    ompi_wtime_clock.base = opal_timer_base_get_cycles();
+    ompi_wtime_clock.offset = 0.0;
+    ompi_wtime_clock.scale = 0 == opal_timer_base_get_freq() ? 0.0
+                             : 1.0 / (double) opal_timer_base_get_freq();
+
+    if (!ompi_mpi_wtime_global) {
+        return OMPI_SUCCESS;
+    }
+#if OPAL_TIMER_CYCLE_SUPPORTED
+    ret = ompi_wtime_sync();
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+    ompi_wtime_is_global = true;
+    return ompi_attr_set_fint(COMM_ATTR, MPI_COMM_WORLD, &MPI_COMM_WORLD->c_keyhash,
+                              MPI_WTIME_IS_GLOBAL, 1, true);
+#else
+    if (0 == ompi_comm_rank(MPI_COMM_WORLD)) {
+        opal_output(0, "mpi_wtime_global: no cycle counter on this platform, "
+                    "MPI_Wtime is not synchronized");
+    }
+    (void) ret;
+    return OMPI_SUCCESS;
+#endif /* OPAL_TIMER_CYCLE_SUPPORTED */
+}
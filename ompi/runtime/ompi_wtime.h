@@ -0,0 +1,70 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * Global clock.  With mpi_wtime_global, MPI_Init estimates the offset
+ * (and the drift) of the cycle counter of every node against the one of
+ * MPI_COMM_WORLD rank 0, so that reading the global time only costs a
+ * read of the counter and a multiply-add.  The node leaders are
+ * synchronized along a binomial tree with ping-pongs, the other
+ * processes get the clock model of their leader as they share its
+ * counter.
+ *
+ * Without the synchronization, the model converts the local counter, so
+ * ompi_wtime_global() can always be used to time stamp events, it is
+ * only comparable across nodes when ompi_wtime_is_global is true.
+ */
+
+#ifndef OMPI_RUNTIME_OMPI_WTIME_H
+#define OMPI_RUNTIME_OMPI_WTIME_H
+
+#include "ompi_config.h"
+
+#include MCA_timer_IMPLEMENTATION_HEADER
+
+BEGIN_C_DECLS
+
+/* global time = (counter - base) * scale + offset, in seconds */
+typedef struct ompi_wtime_clock_t {
+    opal_timer_t base;
+    double scale;
+    double offset;
+} ompi_wtime_clock_t;
+
+OMPI_DECLSPEC extern ompi_wtime_clock_t ompi_wtime_clock;
+
+/**
+ * Whether the clock was synchronized across MPI_COMM_WORLD
+ */
+OMPI_DECLSPEC extern bool ompi_wtime_is_global;
+
+/**
+ * Set up the clock model, and synchronize it across MPI_COMM_WORLD with
+ * mpi_wtime_global.  Collective over MPI_COMM_WORLD in the latter case.
+ */
+int ompi_wtime_init(void);
+
+/**
+ * Seconds elapsed since the clock was set up, on the clock of
+ * MPI_COMM_WORLD rank 0 when ompi_wtime_is_global
+ */
+static inline double ompi_wtime_global(void)
+{
+    return (double) (int64_t) (opal_timer_base_get_cycles() - ompi_wtime_clock.base)
+        * ompi_wtime_clock.scale + ompi_wtime_clock.offset;
+}
+
+END_C_DECLS
+
+#endif /* OMPI_RUNTIME_OMPI_WTIME_H */
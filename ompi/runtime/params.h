@@ -140,6 +140,11 @@ OMPI_DECLSPEC extern bool ompi_have_sparse_group_storage;
  */
 OMPI_DECLSPEC extern bool ompi_use_sparse_group_storage;
 
+/**
+ * Smallest group stored in a sparse format when they are used.
+ */
+OMPI_DECLSPEC extern uint32_t ompi_sparse_group_min_size;
+
 /**
  * Cutoff point for calling add_procs for all processes
  */
@@ -157,6 +162,10 @@ OMPI_DECLSPEC extern bool ompi_async_mpi_init;
 /* EXPERIMENTAL: do not perform an RTE barrier at the beginning of MPI_Finalize */
 OMPI_DECLSPEC extern bool ompi_async_mpi_finalize;
 
+/* EXPERIMENTAL: replace the RTE barrier of MPI_Finalize with an MPI tree
+   barrier and skip the teardown, leaving it to the exit of the process */
+OMPI_DECLSPEC extern bool ompi_mpi_fast_finalize;
+
 #if OPAL_ENABLE_FT_MPI
 OMPI_DECLSPEC extern int ompi_ftmpi_output_handle;
 OMPI_DECLSPEC extern bool ompi_ftmpi_enabled;
@@ -175,11 +184,83 @@ OMPI_DECLSPEC extern char * ompi_mpi_spc_attach_string;
  */
 OMPI_DECLSPEC extern bool ompi_mpi_spc_dump_enabled;
 
+/**
+ * A boolean value that determines whether or not to maintain the per
+ * communicator SPC counters.
+ */
+OMPI_DECLSPEC extern bool ompi_mpi_spc_comm_enabled;
+
+/**
+ * A boolean value that determines whether or not to maintain the SPC
+ * latency histograms of the point-to-point requests and collectives.
+ */
+OMPI_DECLSPEC extern bool ompi_mpi_spc_histograms_enabled;
+
+/**
+ * Smallest intra-communicator split with the bucket exchange instead of
+ * the allgather of all (color, key) (0 to disable)
+ */
+OMPI_DECLSPEC extern uint32_t ompi_comm_split_bucket_min_size;
+
+/**
+ * Largest color of the bucket exchange, larger colors use the allgather
+ */
+OMPI_DECLSPEC extern uint32_t ompi_comm_split_bucket_max_color;
+
+/**
+ * Number of cids reserved together by the cid agreement of an
+ * intra-communicator, the extra ones are handed out without communication
+ * to its next children (1 to disable)
+ */
+OMPI_DECLSPEC extern uint32_t ompi_comm_cid_block_size;
+
+/**
+ * Whether MPI_Init synchronizes the clocks of MPI_COMM_WORLD for MPI_Wtime
+ */
+OMPI_DECLSPEC extern bool ompi_mpi_wtime_global;
+
+/**
+ * Ping-pongs of each clock offset estimation
+ */
+OMPI_DECLSPEC extern uint32_t ompi_mpi_wtime_sync_rounds;
+
+/**
+ * Microseconds between the two offset estimations giving the clock drift
+ * (0 to only estimate the offsets)
+ */
+OMPI_DECLSPEC extern uint32_t ompi_mpi_wtime_drift_interval;
+
+/**
+ * Peers connected by mpi_preconnect_mpi
+ */
+enum {
+    OMPI_MPI_PRECONNECT_ALL,
+    OMPI_MPI_PRECONNECT_NEIGHBORS,
+    OMPI_MPI_PRECONNECT_LEADERS,
+};
+OMPI_DECLSPEC extern int ompi_mpi_preconnect_peers;
+
+/**
+ * Ranks connected on each side with OMPI_MPI_PRECONNECT_NEIGHBORS
+ */
+OMPI_DECLSPEC extern uint32_t ompi_mpi_preconnect_hops;
+
+/**
+ * Number of preconnect rounds in flight at a time
+ */
+OMPI_DECLSPEC extern uint32_t ompi_mpi_preconnect_window;
+
 /**
  * Timeout for calls to PMIx_Connect(defaut 0, no timeout)
  */
 OMPI_DECLSPEC extern uint32_t ompi_pmix_connect_timeout;
 
+/**
+ * Whether the processes of the remote jobs met in connect/accept and spawn
+ * are added to the PML on their first use (when the PML allows it)
+ */
+OMPI_DECLSPEC extern bool ompi_dpm_lazy_add_procs;
+
 /**
  * Register MCA parameters used by the MPI layer.
  *
@@ -0,0 +1,477 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal_config.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "opal/class/opal_concurrent_hash_table.h"
+#include "opal/constants.h"
+#include "opal/mca/threads/mutex.h"
+#include "opal/sys/atomic.h"
+#include "opal/util/output.h"
+
+/*
+ * opal_concurrent_hash_table_t
+ *
+ * The table is cut in stripes by the top bits of the hash of the key,
+ * each of them an open addressed table laid out as the Swiss tables:
+ * the slots are in groups of 8, with one control byte per slot, which
+ * is either empty, deleted, or the low 7 bits of the hash of its key.
+ * A probe compares the 8 control bytes of a group at once in a 64 bits
+ * word, only looks at the keys of the slots whose control byte matches,
+ * and moves on to the next group (triangular probing over a power of two
+ * number of groups) until it finds a group with an empty slot. The
+ * removed slots are marked deleted, and they are reclaimed when the
+ * stripe is rehashed.
+ *
+ * The readers take no lock. A writer makes the sequence counter of the
+ * stripe odd while it updates the stripe, and a reader retries when the
+ * counter was odd or changed during its lookup. A rehashed stripe is
+ * filled before it is published, and the old storage is kept until the
+ * table is destructed as readers may still be going through it.
+ */
+
+#define CHT_GROUP_WIDTH     8
+#define CHT_EMPTY           ((uint8_t) 0x80)
+#define CHT_DELETED         ((uint8_t) 0xfe)
+#define CHT_LSBS            0x0101010101010101ULL
+#define CHT_MSBS            0x8080808080808080ULL
+#define CHT_MAX_STRIPES     128
+#define CHT_DEFAULT_STRIPES 16
+
+/* maximum load of 7/8, counting the deleted slots */
+#define CHT_GROWTH(ngroups) ((ngroups) * CHT_GROUP_WIDTH * 7 / 8)
+
+typedef struct opal_concurrent_hash_slot_t {
+    uint64_t key;
+    void *value;
+} opal_concurrent_hash_slot_t;
+
+typedef struct opal_concurrent_hash_array_t {
+    struct opal_concurrent_hash_array_t *next; /* the retired arrays of the stripe */
+    size_t group_mask;                         /* number of groups - 1 */
+    opal_concurrent_hash_slot_t *slots;
+    uint8_t *ctrl;                             /* one control byte per slot */
+} opal_concurrent_hash_array_t;
+
+struct opal_concurrent_hash_stripe_t {
+    opal_atomic_int32_t seq; /* odd while a writer updates the stripe */
+    opal_concurrent_hash_array_t *volatile array;
+    opal_concurrent_hash_array_t *retired;
+    size_t size;        /* number of elements */
+    size_t growth_left; /* empty slots to fill before a rehash */
+    opal_mutex_t lock;  /* serializes the writers */
+};
+typedef struct opal_concurrent_hash_stripe_t opal_concurrent_hash_stripe_t;
+
+static void opal_concurrent_hash_table_construct(opal_concurrent_hash_table_t *ht);
+static void opal_concurrent_hash_table_destruct(opal_concurrent_hash_table_t *ht);
+
+OBJ_CLASS_INSTANCE(opal_concurrent_hash_table_t, opal_object_t,
+                   opal_concurrent_hash_table_construct, opal_concurrent_hash_table_destruct);
+
+/* murmur3 finalizer, all the bits of the key end up in the top and the low bits */
+static inline uint64_t cht_hash(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+static inline opal_concurrent_hash_stripe_t *cht_stripe(opal_concurrent_hash_table_t *ht,
+                                                        uint64_t hash)
+{
+    return ht->cht_stripes + ((hash >> 57) & ht->cht_stripe_mask);
+}
+
+/* the control bytes of a group, the first one in the low byte */
+static inline uint64_t cht_group_load(const uint8_t *ctrl)
+{
+    uint64_t group = 0;
+
+    for (int i = 0; i < CHT_GROUP_WIDTH; ++i) {
+        group |= (uint64_t) ctrl[i] << (8 * i);
+    }
+    return group;
+}
+
+/* the msb of the bytes equal to h2, with a few false positives */
+static inline uint64_t cht_match(uint64_t group, uint8_t h2)
+{
+    uint64_t x = group ^ (CHT_LSBS * h2);
+
+    return (x - CHT_LSBS) & ~x & CHT_MSBS;
+}
+
+static inline uint64_t cht_match_empty(uint64_t group)
+{
+    return group & ~(group << 6) & CHT_MSBS;
+}
+
+static inline uint64_t cht_match_empty_or_deleted(uint64_t group)
+{
+    return group & ~(group << 7) & CHT_MSBS;
+}
+
+/* the index in the group of one of the bytes of a match */
+static inline int cht_match_index(uint64_t match)
+{
+#if OPAL_C_HAVE_BUILTIN_CLZ
+    return (63 - __builtin_clzll(match)) >> 3;
+#else
+    int i = CHT_GROUP_WIDTH - 1;
+
+    while (0 == (match & (0x80ULL << (8 * i)))) {
+        --i;
+    }
+    return i;
+#endif
+}
+
+static opal_concurrent_hash_array_t *cht_array_alloc(size_t ngroups)
+{
+    size_t capacity = ngroups * CHT_GROUP_WIDTH;
+    opal_concurrent_hash_array_t *array;
+
+    array = malloc(sizeof(*array) + capacity * (sizeof(opal_concurrent_hash_slot_t) + 1));
+    if (NULL == array) {
+        return NULL;
+    }
+    array->next = NULL;
+    array->group_mask = ngroups - 1;
+    array->slots = (opal_concurrent_hash_slot_t *) (array + 1);
+    array->ctrl = (uint8_t *) (array->slots + capacity);
+    memset(array->ctrl, CHT_EMPTY, capacity);
+    return array;
+}
+
+/* The probing is bounded by the number of groups, so that a reader
+ * racing with a writer always gets out of it */
+static inline opal_concurrent_hash_slot_t *cht_find(const opal_concurrent_hash_array_t *array,
+                                                    uint64_t key, uint64_t hash)
+{
+    size_t pos = (hash >> 7) & array->group_mask, step = 0;
+    uint8_t h2 = (uint8_t) (hash & 0x7f);
+
+    do {
+        const uint8_t *ctrl = array->ctrl + pos * CHT_GROUP_WIDTH;
+        uint64_t group = cht_group_load(ctrl);
+        uint64_t match = cht_match(group, h2);
+
+        while (0 != match) {
+            int i = cht_match_index(match);
+            opal_concurrent_hash_slot_t *slot = array->slots + pos * CHT_GROUP_WIDTH + i;
+
+            if (h2 == ctrl[i] && key == slot->key) {
+                return slot;
+            }
+            match &= ~(0x80ULL << (8 * i));
+        }
+        if (0 != cht_match_empty(group)) {
+            return NULL;
+        }
+        pos = (pos + ++step) & array->group_mask;
+    } while (step <= array->group_mask);
+
+    return NULL;
+}
+
+/* only called by the writers, there is always a free slot */
+static inline size_t cht_find_free(const opal_concurrent_hash_array_t *array, uint64_t hash)
+{
+    size_t pos = (hash >> 7) & array->group_mask, step = 0;
+    uint64_t match;
+
+    while (0 == (match = cht_match_empty_or_deleted(cht_group_load(array->ctrl + pos * CHT_GROUP_WIDTH)))) {
+        pos = (pos + ++step) & array->group_mask;
+    }
+    return pos * CHT_GROUP_WIDTH + cht_match_index(match);
+}
+
+static inline void cht_write_begin(opal_concurrent_hash_stripe_t *stripe)
+{
+    stripe->seq = stripe->seq + 1;
+    opal_atomic_wmb();
+}
+
+static inline void cht_write_end(opal_concurrent_hash_stripe_t *stripe)
+{
+    opal_atomic_wmb();
+    stripe->seq = stripe->seq + 1;
+}
+
+/* Grow the stripe when it is at least half full, otherwise only get rid
+ * of the deleted slots. Called with the lock of the stripe held. */
+static int cht_rehash(opal_concurrent_hash_stripe_t *stripe)
+{
+    opal_concurrent_hash_array_t *old = stripe->array, *array;
+    size_t capacity = (old->group_mask + 1) * CHT_GROUP_WIDTH, ngroups = old->group_mask + 1;
+
+    if (2 * stripe->size >= capacity) {
+        ngroups *= 2;
+    }
+    array = cht_array_alloc(ngroups);
+    if (NULL == array) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    for (size_t i = 0; i < capacity; ++i) {
+        uint64_t hash;
+        size_t j;
+
+        if (old->ctrl[i] & 0x80) {
+            continue; /* empty or deleted */
+        }
+        hash = cht_hash(old->slots[i].key);
+        j = cht_find_free(array, hash);
+        array->ctrl[j] = (uint8_t) (hash & 0x7f);
+        array->slots[j] = old->slots[i];
+    }
+
+    cht_write_begin(stripe);
+    stripe->array = array;
+    cht_write_end(stripe);
+
+    old->next = stripe->retired;
+    stripe->retired = old;
+    stripe->growth_left = CHT_GROWTH(ngroups) - stripe->size;
+    return OPAL_SUCCESS;
+}
+
+static void cht_stripes_free(opal_concurrent_hash_stripe_t *stripes, unsigned int count)
+{
+    for (unsigned int i = 0; i < count; ++i) {
+        opal_concurrent_hash_array_t *array = stripes[i].retired, *next;
+
+        free(stripes[i].array);
+        for (; NULL != array; array = next) {
+            next = array->next;
+            free(array);
+        }
+        OBJ_DESTRUCT(&stripes[i].lock);
+    }
+    free(stripes);
+}
+
+static void opal_concurrent_hash_table_construct(opal_concurrent_hash_table_t *ht)
+{
+    ht->cht_stripes = NULL;
+    ht->cht_stripe_mask = 0;
+}
+
+static void opal_concurrent_hash_table_destruct(opal_concurrent_hash_table_t *ht)
+{
+    if (NULL != ht->cht_stripes) {
+        cht_stripes_free(ht->cht_stripes, ht->cht_stripe_mask + 1);
+        ht->cht_stripes = NULL;
+    }
+}
+
+int opal_concurrent_hash_table_init(opal_concurrent_hash_table_t *ht, size_t table_size)
+{
+    return opal_concurrent_hash_table_init2(ht, table_size, CHT_DEFAULT_STRIPES);
+}
+
+int opal_concurrent_hash_table_init2(opal_concurrent_hash_table_t *ht, size_t table_size,
+                                     int nstripes)
+{
+    opal_concurrent_hash_stripe_t *stripes;
+    unsigned int count = 1;
+    size_t ngroups = 1, per_stripe;
+
+    if (nstripes > CHT_MAX_STRIPES) {
+        nstripes = CHT_MAX_STRIPES;
+    }
+    while ((int) count < nstripes) {
+        count <<= 1;
+    }
+    per_stripe = (table_size + count - 1) / count;
+    while (CHT_GROWTH(ngroups) < per_stripe) {
+        ngroups <<= 1;
+    }
+
+    stripes = (opal_concurrent_hash_stripe_t *) calloc(count, sizeof(*stripes));
+    if (NULL == stripes) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+    for (unsigned int i = 0; i < count; ++i) {
+        OBJ_CONSTRUCT(&stripes[i].lock, opal_mutex_t);
+        stripes[i].array = cht_array_alloc(ngroups);
+        if (NULL == stripes[i].array) {
+            cht_stripes_free(stripes, i + 1);
+            return OPAL_ERR_OUT_OF_RESOURCE;
+        }
+        stripes[i].growth_left = CHT_GROWTH(ngroups);
+    }
+
+    opal_concurrent_hash_table_destruct(ht);
+    ht->cht_stripes = stripes;
+    ht->cht_stripe_mask = count - 1;
+    return OPAL_SUCCESS;
+}
+
+size_t opal_concurrent_hash_table_get_size(opal_concurrent_hash_table_t *ht)
+{
+    size_t size = 0;
+
+    if (NULL == ht->cht_stripes) {
+        return 0;
+    }
+    for (unsigned int i = 0; i <= ht->cht_stripe_mask; ++i) {
+        size += ht->cht_stripes[i].size;
+    }
+    return size;
+}
+
+int opal_concurrent_hash_table_remove_all(opal_concurrent_hash_table_t *ht)
+{
+    if (NULL == ht->cht_stripes) {
+        return OPAL_SUCCESS;
+    }
+    for (unsigned int i = 0; i <= ht->cht_stripe_mask; ++i) {
+        opal_concurrent_hash_stripe_t *stripe = ht->cht_stripes + i;
+        size_t ngroups;
+
+        OPAL_THREAD_LOCK(&stripe->lock);
+        ngroups = stripe->array->group_mask + 1;
+        cht_write_begin(stripe);
+        memset(stripe->array->ctrl, CHT_EMPTY, ngroups * CHT_GROUP_WIDTH);
+        cht_write_end(stripe);
+        stripe->size = 0;
+        stripe->growth_left = CHT_GROWTH(ngroups);
+        OPAL_THREAD_UNLOCK(&stripe->lock);
+    }
+    return OPAL_SUCCESS;
+}
+
+int opal_concurrent_hash_table_get_value_uint64(opal_concurrent_hash_table_t *ht, uint64_t key,
+                                                void **ptr)
+{
+    uint64_t hash = cht_hash(key);
+    opal_concurrent_hash_stripe_t *stripe;
+    opal_concurrent_hash_slot_t *slot;
+    void *value = NULL;
+    int32_t seq;
+
+#if OPAL_ENABLE_DEBUG
+    if (NULL == ht->cht_stripes) {
+        opal_output(0, "opal_concurrent_hash_table_get_value_uint64:"
+                       "opal_concurrent_hash_table_init() has not been called");
+        return OPAL_ERROR;
+    }
+#endif
+    stripe = cht_stripe(ht, hash);
+
+    do {
+        while (OPAL_UNLIKELY((seq = stripe->seq) & 1)) {
+            /* a writer is updating the stripe */
+        }
+        opal_atomic_rmb();
+        slot = cht_find(stripe->array, key, hash);
+        if (NULL != slot) {
+            value = slot->value;
+        }
+        opal_atomic_rmb();
+    } while (OPAL_UNLIKELY(seq != stripe->seq));
+
+    if (NULL == slot) {
+        return OPAL_ERR_NOT_FOUND;
+    }
+    *ptr = value;
+    return OPAL_SUCCESS;
+}
+
+int opal_concurrent_hash_table_set_value_uint64(opal_concurrent_hash_table_t *ht, uint64_t key,
+                                                void *value)
+{
+    uint64_t hash = cht_hash(key);
+    opal_concurrent_hash_stripe_t *stripe;
+    opal_concurrent_hash_array_t *array;
+    opal_concurrent_hash_slot_t *slot;
+    int ret = OPAL_SUCCESS;
+    size_t index;
+
+#if OPAL_ENABLE_DEBUG
+    if (NULL == ht->cht_stripes) {
+        opal_output(0, "opal_concurrent_hash_table_set_value_uint64:"
+                       "opal_concurrent_hash_table_init() has not been called");
+        return OPAL_ERR_BAD_PARAM;
+    }
+#endif
+    stripe = cht_stripe(ht, hash);
+
+    OPAL_THREAD_LOCK(&stripe->lock);
+    slot = cht_find(stripe->array, key, hash);
+    if (NULL != slot) {
+        cht_write_begin(stripe);
+        slot->value = value;
+        cht_write_end(stripe);
+        goto unlock;
+    }
+
+    if (0 == stripe->growth_left) {
+        ret = cht_rehash(stripe);
+        if (OPAL_SUCCESS != ret) {
+            goto unlock;
+        }
+    }
+    array = stripe->array;
+    index = cht_find_free(array, hash);
+    if (CHT_EMPTY == array->ctrl[index]) {
+        --stripe->growth_left;
+    }
+
+    cht_write_begin(stripe);
+    array->slots[index].key = key;
+    array->slots[index].value = value;
+    array->ctrl[index] = (uint8_t) (hash & 0x7f);
+    cht_write_end(stripe);
+    ++stripe->size;
+
+unlock:
+    OPAL_THREAD_UNLOCK(&stripe->lock);
+    return ret;
+}
+
+int opal_concurrent_hash_table_remove_value_uint64(opal_concurrent_hash_table_t *ht, uint64_t key)
+{
+    uint64_t hash = cht_hash(key);
+    opal_concurrent_hash_stripe_t *stripe;
+    opal_concurrent_hash_slot_t *slot;
+    int ret = OPAL_SUCCESS;
+
+#if OPAL_ENABLE_DEBUG
+    if (NULL == ht->cht_stripes) {
+        opal_output(0, "opal_concurrent_hash_table_remove_value_uint64:"
+                       "opal_concurrent_hash_table_init() has not been called");
+        return OPAL_ERR_BAD_PARAM;
+    }
+#endif
+    stripe = cht_stripe(ht, hash);
+
+    OPAL_THREAD_LOCK(&stripe->lock);
+    slot = cht_find(stripe->array, key, hash);
+    if (NULL == slot) {
+        ret = OPAL_ERR_NOT_FOUND;
+    } else {
+        cht_write_begin(stripe);
+        stripe->array->ctrl[slot - stripe->array->slots] = CHT_DELETED;
+        cht_write_end(stripe);
+        --stripe->size;
+    }
+    OPAL_THREAD_UNLOCK(&stripe->lock);
+    return ret;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/** @file
+ *
+ *  A hash table indexed by uint64_t keys for the read-mostly tables
+ *  shared between threads. The lookups take no lock: each stripe of
+ *  the table is protected by a sequence counter, and the readers retry
+ *  when a writer updated the stripe under them. The writers of the
+ *  different stripes do not contend, the writers of a stripe are
+ *  serialized by its lock.
+ *
+ *  The storage of a stripe is only released when the table is
+ *  destructed, so the values have to be kept alive by the caller for
+ *  as long as a reader may still find them.
+ */
+
+#ifndef OPAL_CONCURRENT_HASH_TABLE_H
+#define OPAL_CONCURRENT_HASH_TABLE_H
+
+#include "opal_config.h"
+
+#include "opal/class/opal_object.h"
+#include <stdint.h>
+
+BEGIN_C_DECLS
+
+OPAL_DECLSPEC OBJ_CLASS_DECLARATION(opal_concurrent_hash_table_t);
+
+struct opal_concurrent_hash_table_t {
+    opal_object_t super;                            /**< subclass of opal_object_t */
+    struct opal_concurrent_hash_stripe_t *cht_stripes; /**< stripes of the table (opaque to users) */
+    unsigned int cht_stripe_mask;                   /**< number of stripes - 1 */
+};
+typedef struct opal_concurrent_hash_table_t opal_concurrent_hash_table_t;
+
+/**
+ *  Initializes the table, must be called before using the table.
+ *
+ *  @param   table   The input hash table (IN).
+ *  @param   size    The expected number of elements, the table
+ *                   grows beyond it as needed (IN).
+ *  @return  OPAL error code.
+ *
+ */
+
+OPAL_DECLSPEC int opal_concurrent_hash_table_init(opal_concurrent_hash_table_t *ht,
+                                                  size_t table_size);
+
+/**
+ *  Initializes the table with a given number of stripes, rounded up
+ *  to a power of two (at most 128).
+ */
+
+OPAL_DECLSPEC int opal_concurrent_hash_table_init2(opal_concurrent_hash_table_t *ht,
+                                                   size_t table_size, int nstripes);
+
+/**
+ *  Returns the number of elements currently stored in the table, as
+ *  seen by the calling thread.
+ *
+ *  @param   table   The input hash table (IN).
+ *  @return  The number of elements in the table.
+ *
+ */
+
+OPAL_DECLSPEC size_t opal_concurrent_hash_table_get_size(opal_concurrent_hash_table_t *ht);
+
+/**
+ *  Remove all elements from the table.
+ *
+ *  @param   table   The input hash table (IN).
+ *  @return  OPAL return code.
+ *
+ */
+
+OPAL_DECLSPEC int opal_concurrent_hash_table_remove_all(opal_concurrent_hash_table_t *ht);
+
+/**
+ *  Retrieve value via uint64_t key, without taking any lock.
+ *
+ *  @param   table   The input hash table (IN).
+ *  @param   key     The input key (IN).
+ *  @param   ptr     The value associated with the key
+ *  @return  integer return code:
+ *           - OPAL_SUCCESS       if key was found
+ *           - OPAL_ERR_NOT_FOUND if key was not found
+ *
+ */
+
+OPAL_DECLSPEC int opal_concurrent_hash_table_get_value_uint64(opal_concurrent_hash_table_t *ht,
+                                                              uint64_t key, void **ptr);
+
+/**
+ *  Set value based on uint64_t key.
+ *
+ *  @param   table   The input hash table (IN).
+ *  @param   key     The input key (IN).
+ *  @param   value   The value to be associated with the key (IN).
+ *  @return  OPAL return code.
+ *
+ */
+
+OPAL_DECLSPEC int opal_concurrent_hash_table_set_value_uint64(opal_concurrent_hash_table_t *ht,
+                                                              uint64_t key, void *value);
+
+/**
+ *  Remove value based on uint64_t key.
+ *
+ *  @param   table   The input hash table (IN).
+ *  @param   key     The input key (IN).
+ *  @return  OPAL return code.
+ *
+ */
+
+OPAL_DECLSPEC int opal_concurrent_hash_table_remove_value_uint64(opal_concurrent_hash_table_t *ht,
+                                                                 uint64_t key);
+
+END_C_DECLS
+
+#endif /* OPAL_CONCURRENT_HASH_TABLE_H */
@@ -24,15 +24,403 @@
 
 #include "opal_config.h"
 
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_SYS_MMAN_H
+#    include <sys/mman.h>
+#endif
+
 #include "opal/align.h"
 #include "opal/class/opal_free_list.h"
+#include "opal/mca/base/mca_base_pvar.h"
+#include "opal/mca/base/mca_base_var.h"
 #include "opal/mca/mpool/base/base.h"
 #include "opal/mca/mpool/mpool.h"
 #include "opal/mca/rcache/rcache.h"
+#include "opal/mca/threads/tsd.h"
+#include "opal/util/minmax.h"
 #include "opal/util/output.h"
 #include "opal/util/sys_limits.h"
 
-typedef struct opal_free_list_item_t opal_free_list_memory_t;
+/* header of each chunk allocated by opal_free_list_grow_st */
+struct opal_free_list_memory_t {
+    opal_free_list_item_t super;
+    /** mpool the chunk itself was allocated from (NULL: malloc) */
+    mca_mpool_base_module_t *head_mpool;
+    /** mpool the payload buffers were allocated from (NULL: malloc) */
+    mca_mpool_base_module_t *mpool;
+};
+typedef struct opal_free_list_memory_t opal_free_list_memory_t;
+
+bool opal_free_list_hugepage = false;
+size_t opal_free_list_hugepage_size = 2 * 1024 * 1024;
+size_t opal_free_list_hugepage_min_size = 1024 * 1024;
+char *opal_free_list_hugepage_hints = "mpool=hugepage";
+
+/* huge page coverage of the free lists using them */
+static opal_atomic_size_t opal_free_list_hugepage_stats[3];
+enum {
+    OPAL_FREE_LIST_BYTES,          /* allocated by the lists with huge pages enabled */
+    OPAL_FREE_LIST_HUGETLB_BYTES,  /* backed by explicit huge pages (mpool/hugepage) */
+    OPAL_FREE_LIST_THP_BYTES,      /* backed by transparent huge pages */
+};
+
+static mca_mpool_base_module_t *opal_free_list_hugepage_mpool = NULL;
+static opal_atomic_int32_t opal_free_list_hugepage_lookup = 0;
+
+unsigned int opal_free_list_thread_cache = 0;
+
+#if OPAL_HAVE_THREAD_LOCAL
+opal_thread_local opal_free_list_magazine_t *opal_free_list_magazines[OPAL_FREE_LIST_TCACHE_MAX];
+/* the thread exit hook is installed */
+static opal_thread_local bool opal_free_list_tcache_registered = false;
+
+/* lists owning the thread cache slots, protected by opal_free_list_tcache_lock */
+static struct {
+    opal_free_list_t *flist;
+    uint64_t generation;
+} opal_free_list_tcache_slots[OPAL_FREE_LIST_TCACHE_MAX];
+static uint64_t opal_free_list_tcache_generation = 0;
+static opal_mutex_t opal_free_list_tcache_lock = OPAL_MUTEX_STATIC_INIT;
+static opal_tsd_key_t opal_free_list_tcache_key;
+static bool opal_free_list_tcache_key_valid = false;
+#endif /* OPAL_HAVE_THREAD_LOCAL */
+
+int opal_free_list_register_params(void)
+{
+    static const char *pvar_names[] = {"free_list_hugepage_candidate_bytes",
+                                       "free_list_hugetlb_bytes", "free_list_thp_bytes"};
+    static const char *pvar_descs[] = {
+        "Bytes allocated by the free lists trying to use huge pages",
+        "Bytes of free list memory backed by explicit huge pages (mpool/hugepage)",
+        "Bytes of free list memory advised to use transparent huge pages"};
+
+    (void) mca_base_var_register("opal", "opal", "free_list", "hugepage",
+                                 "Back the free list chunks (fragments and bounce buffers) with "
+                                 "huge pages: explicit ones from the mpool selected by "
+                                 "opal_free_list_hugepage_hints if any, transparent huge pages "
+                                 "otherwise. Only lists using the default mpool are concerned",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &opal_free_list_hugepage);
+    (void) mca_base_var_register("opal", "opal", "free_list", "hugepage_size",
+                                 "Size of the huge pages backing the free lists. Chunks are "
+                                 "grown to fill whole huge pages",
+                                 MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &opal_free_list_hugepage_size);
+    (void) mca_base_var_register("opal", "opal", "free_list", "hugepage_min_size",
+                                 "Smallest free list growth (in bytes) rounded up to huge pages. "
+                                 "Smaller ones would waste most of the page",
+                                 MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &opal_free_list_hugepage_min_size);
+    (void) mca_base_var_register("opal", "opal", "free_list", "hugepage_hints",
+                                 "mpool hints used to find the explicit huge pages",
+                                 MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0, OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &opal_free_list_hugepage_hints);
+
+    (void) mca_base_var_register("opal", "opal", "free_list", "thread_cache",
+                                 "Number of items each thread keeps for itself in the free lists "
+                                 "with a thread cache (PML requests and BTL fragments). Gets and "
+                                 "returns then avoid the atomic operations on the shared lists. "
+                                 "0 disables the thread caches",
+                                 MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &opal_free_list_thread_cache);
+
+    for (int i = 0; i < 3; ++i) {
+        (void) mca_base_pvar_register("opal", "opal", NULL, pvar_names[i], pvar_descs[i],
+                                      OPAL_INFO_LVL_5, MCA_BASE_PVAR_CLASS_COUNTER,
+                                      MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL,
+                                      MCA_BASE_VAR_BIND_NO_OBJECT,
+                                      MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                      NULL, NULL, NULL,
+                                      (void *) &opal_free_list_hugepage_stats[i]);
+    }
+
+    return OPAL_SUCCESS;
+}
+
+/**
+ * Allocate size bytes (a multiple of the huge page size) backed by huge pages: from the
+ * hugepage mpool if there is one, otherwise anonymous memory advised to use transparent
+ * huge pages. Returns NULL if neither is possible, the caller then falls back to its usual
+ * allocator.
+ */
+static void *opal_free_list_hugepage_alloc(size_t size, mca_mpool_base_module_t **mpool)
+{
+    void *ptr = NULL;
+
+    if (0 == opal_free_list_hugepage_lookup
+        && 0 == opal_atomic_swap_32(&opal_free_list_hugepage_lookup, 1)) {
+        mca_mpool_base_module_t *module = mca_mpool_base_module_lookup(
+            opal_free_list_hugepage_hints);
+        /* the lookup falls back on the default mpool when nothing matches */
+        if (module != mca_mpool_base_default_module) {
+            opal_free_list_hugepage_mpool = module;
+        }
+        opal_atomic_wmb();
+        opal_free_list_hugepage_lookup = 2;
+    }
+
+    if (2 == opal_free_list_hugepage_lookup && NULL != opal_free_list_hugepage_mpool) {
+        ptr = opal_free_list_hugepage_mpool->mpool_alloc(opal_free_list_hugepage_mpool, size,
+                                                         opal_free_list_hugepage_size, 0);
+        if (NULL != ptr) {
+            *mpool = opal_free_list_hugepage_mpool;
+            (void) opal_atomic_add_fetch_size_t(
+                &opal_free_list_hugepage_stats[OPAL_FREE_LIST_HUGETLB_BYTES], size);
+            return ptr;
+        }
+    }
+
+#if defined(HAVE_SYS_MMAN_H) && defined(MADV_HUGEPAGE)
+    if (0 == posix_memalign(&ptr, opal_free_list_hugepage_size, size)) {
+        if (0 == madvise(ptr, size, MADV_HUGEPAGE)) {
+            (void) opal_atomic_add_fetch_size_t(
+                &opal_free_list_hugepage_stats[OPAL_FREE_LIST_THP_BYTES], size);
+        }
+        *mpool = NULL;
+        return ptr;
+    }
+#endif
+
+    return NULL;
+}
+
+/* Number of elements filling whole huge pages, at least num_elements */
+static size_t opal_free_list_hugepage_fill(opal_free_list_t *flist, size_t num_elements,
+                                           size_t head_size, size_t elem_size)
+{
+    const size_t overhead = sizeof(opal_free_list_memory_t) + flist->fl_frag_alignment;
+    const size_t page = opal_free_list_hugepage_size;
+    size_t count;
+
+    count = (OPAL_ALIGN(num_elements * head_size + overhead, page, size_t) - overhead) / head_size;
+    if (0 != elem_size) {
+        count = opal_min(count, OPAL_ALIGN(num_elements * elem_size, page, size_t) / elem_size);
+    }
+    if (flist->fl_max_to_alloc && (flist->fl_num_allocated + count) > flist->fl_max_to_alloc) {
+        count = flist->fl_max_to_alloc - flist->fl_num_allocated;
+    }
+
+    return opal_max(count, num_elements);
+}
+
+#if OPAL_HAVE_THREAD_LOCAL
+/* Hand count items over to the remote list of flist with a single atomic operation. The
+ * chains are only ever taken as a whole (see opal_free_list_tcache_refill) so there is
+ * no ABA problem. */
+static void opal_free_list_tcache_release(opal_free_list_t *flist, opal_free_list_item_t **items,
+                                          unsigned int count)
+{
+    opal_list_item_t *first = &items[0]->super, *last = &items[count - 1]->super;
+    intptr_t head;
+
+    for (unsigned int i = 0; i < count - 1; ++i) {
+        items[i]->super.opal_list_next = &items[i + 1]->super;
+    }
+
+    head = flist->fl_tcache_remote;
+    do {
+        last->opal_list_next = (opal_list_item_t *) head;
+    } while (!opal_atomic_compare_exchange_strong_ptr(&flist->fl_tcache_remote, &head,
+                                                      (intptr_t) first));
+}
+
+/* Called at thread exit with the magazines of the thread */
+static void opal_free_list_tcache_thread_exit(void *value)
+{
+    opal_free_list_magazine_t **magazines = (opal_free_list_magazine_t **) value;
+
+    opal_mutex_lock(&opal_free_list_tcache_lock);
+    for (int i = 0; i < OPAL_FREE_LIST_TCACHE_MAX; ++i) {
+        opal_free_list_magazine_t *mag = magazines[i];
+        if (NULL == mag) {
+            continue;
+        }
+        /* the items of destroyed lists are gone with them */
+        if (0 != mag->count && mag->generation == opal_free_list_tcache_slots[i].generation) {
+            opal_free_list_tcache_release(opal_free_list_tcache_slots[i].flist, mag->items,
+                                          mag->count);
+        }
+        magazines[i] = NULL;
+        free(mag);
+    }
+    opal_mutex_unlock(&opal_free_list_tcache_lock);
+}
+
+/* Magazine of the calling thread for flist, allocated on first use */
+static opal_free_list_magazine_t *opal_free_list_tcache_magazine(opal_free_list_t *flist)
+{
+    opal_free_list_magazine_t *mag = opal_free_list_magazines[flist->fl_tcache_index];
+
+    if (NULL != mag) {
+        if (mag->generation != flist->fl_tcache_generation) {
+            /* left by a destroyed list using the same slot */
+            mag->generation = flist->fl_tcache_generation;
+            mag->count = 0;
+        }
+        return mag;
+    }
+
+    if (!opal_free_list_tcache_registered) {
+        if (OPAL_SUCCESS != opal_tsd_set(opal_free_list_tcache_key, opal_free_list_magazines)) {
+            return NULL;
+        }
+        opal_free_list_tcache_registered = true;
+    }
+
+    mag = (opal_free_list_magazine_t *) malloc(sizeof(*mag) + flist->fl_tcache_size
+                                                                  * sizeof(mag->items[0]));
+    if (NULL != mag) {
+        mag->generation = flist->fl_tcache_generation;
+        mag->count = 0;
+        mag->capacity = flist->fl_tcache_size;
+        opal_free_list_magazines[flist->fl_tcache_index] = mag;
+    }
+
+    return mag;
+}
+
+opal_free_list_item_t *opal_free_list_tcache_refill(opal_free_list_t *flist)
+{
+    opal_free_list_magazine_t *mag = opal_free_list_tcache_magazine(flist);
+    opal_free_list_item_t *item = NULL;
+    opal_list_item_t *chain, *next;
+
+    /* first take back what the other threads released */
+    chain = (opal_list_item_t *) opal_atomic_swap_ptr(&flist->fl_tcache_remote, 0);
+    for (; NULL != chain; chain = next) {
+        next = (opal_list_item_t *) chain->opal_list_next;
+        if (NULL != mag && mag->count < mag->capacity) {
+            mag->items[mag->count++] = (opal_free_list_item_t *) chain;
+        } else {
+            opal_lifo_push_atomic(&flist->super, chain);
+        }
+    }
+
+    if (NULL == mag) {
+        item = (opal_free_list_item_t *) opal_lifo_pop_atomic(&flist->super);
+    } else if (0 == mag->count) {
+        /* then a batch from the shared lifo */
+        for (unsigned int i = 0; i < (mag->capacity + 1) / 2; ++i) {
+            item = (opal_free_list_item_t *) opal_lifo_pop_atomic(&flist->super);
+            if (NULL == item) {
+                break;
+            }
+            mag->items[mag->count++] = item;
+        }
+        item = NULL;
+    }
+
+    if (NULL != mag && 0 != mag->count) {
+        return mag->items[--mag->count];
+    }
+
+    if (NULL == item) {
+        opal_mutex_lock(&flist->fl_lock);
+        opal_free_list_grow_st(flist, flist->fl_num_per_alloc, &item);
+        opal_mutex_unlock(&flist->fl_lock);
+    }
+
+    return item;
+}
+
+void opal_free_list_tcache_flush(opal_free_list_t *flist, opal_free_list_item_t *item)
+{
+    opal_free_list_magazine_t *mag = opal_free_list_tcache_magazine(flist);
+    unsigned int half;
+
+    if (OPAL_UNLIKELY(NULL == mag)) {
+        opal_lifo_push_atomic(&flist->super, &item->super);
+        return;
+    }
+
+    if (mag->count == mag->capacity) {
+        /* release the oldest half, the most recently used items are still hot */
+        half = (mag->capacity + 1) / 2;
+        opal_free_list_tcache_release(flist, mag->items, half);
+        mag->count -= half;
+        memmove(mag->items, mag->items + half, mag->count * sizeof(mag->items[0]));
+    }
+    mag->items[mag->count++] = item;
+}
+
+/* Release the slot of fl and bring back into the lifo the items that can be reached */
+static void opal_free_list_tcache_disable(opal_free_list_t *fl)
+{
+    opal_free_list_magazine_t *mag;
+    opal_list_item_t *chain, *next;
+
+    opal_mutex_lock(&opal_free_list_tcache_lock);
+    opal_free_list_tcache_slots[fl->fl_tcache_index].flist = NULL;
+    opal_free_list_tcache_slots[fl->fl_tcache_index].generation = 0;
+    opal_mutex_unlock(&opal_free_list_tcache_lock);
+
+    mag = opal_free_list_magazines[fl->fl_tcache_index];
+    if (NULL != mag && mag->generation == fl->fl_tcache_generation) {
+        while (0 != mag->count) {
+            opal_lifo_push(&fl->super, &mag->items[--mag->count]->super);
+        }
+    }
+
+    chain = (opal_list_item_t *) opal_atomic_swap_ptr(&fl->fl_tcache_remote, 0);
+    for (; NULL != chain; chain = next) {
+        next = (opal_list_item_t *) chain->opal_list_next;
+        opal_lifo_push(&fl->super, chain);
+    }
+
+    fl->fl_tcache_size = 0;
+    fl->fl_tcache_index = -1;
+}
+#else
+opal_free_list_item_t *opal_free_list_tcache_refill(opal_free_list_t *flist)
+{
+    return NULL;
+}
+
+void opal_free_list_tcache_flush(opal_free_list_t *flist, opal_free_list_item_t *item)
+{
+    opal_lifo_push_atomic(&flist->super, &item->super);
+}
+#endif /* OPAL_HAVE_THREAD_LOCAL */
+
+int opal_free_list_thread_cache_enable(opal_free_list_t *flist)
+{
+#if OPAL_HAVE_THREAD_LOCAL
+    int rc = OPAL_ERR_OUT_OF_RESOURCE;
+
+    if (0 == opal_free_list_thread_cache || 0 != flist->fl_tcache_size) {
+        return OPAL_SUCCESS;
+    }
+
+    opal_mutex_lock(&opal_free_list_tcache_lock);
+    if (!opal_free_list_tcache_key_valid) {
+        rc = opal_tsd_key_create(&opal_free_list_tcache_key, opal_free_list_tcache_thread_exit);
+        if (OPAL_SUCCESS != rc) {
+            opal_mutex_unlock(&opal_free_list_tcache_lock);
+            return rc;
+        }
+        opal_free_list_tcache_key_valid = true;
+        rc = OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    for (int i = 0; i < OPAL_FREE_LIST_TCACHE_MAX; ++i) {
+        if (NULL == opal_free_list_tcache_slots[i].flist) {
+            opal_free_list_tcache_slots[i].flist = flist;
+            opal_free_list_tcache_slots[i].generation = ++opal_free_list_tcache_generation;
+            flist->fl_tcache_index = i;
+            flist->fl_tcache_generation = opal_free_list_tcache_generation;
+            flist->fl_tcache_size = opal_free_list_thread_cache;
+            rc = OPAL_SUCCESS;
+            break;
+        }
+    }
+    opal_mutex_unlock(&opal_free_list_tcache_lock);
+
+    return rc;
+#else
+    return (0 == opal_free_list_thread_cache) ? OPAL_SUCCESS : OPAL_ERR_NOT_SUPPORTED;
+#endif /* OPAL_HAVE_THREAD_LOCAL */
+}
 
 OBJ_CLASS_INSTANCE(opal_free_list_item_t, opal_list_item_t, NULL, NULL);
 
@@ -54,24 +442,35 @@ static void opal_free_list_construct(opal_free_list_t *fl)
     /* default flags */
     fl->fl_rcache_reg_flags = MCA_RCACHE_FLAGS_CACHE_BYPASS | MCA_RCACHE_FLAGS_CUDA_REGISTER_MEM;
     fl->ctx = NULL;
+    fl->fl_hugepage = opal_free_list_hugepage;
+    fl->fl_tcache_size = 0;
+    fl->fl_tcache_index = -1;
+    fl->fl_tcache_generation = 0;
+    fl->fl_tcache_remote = 0;
     OBJ_CONSTRUCT(&(fl->fl_allocations), opal_list_t);
 }
 
 static void opal_free_list_allocation_release(opal_free_list_t *fl, opal_free_list_memory_t *fl_mem)
 {
+    mca_mpool_base_module_t *head_mpool = fl_mem->head_mpool;
+
     if (NULL != fl->fl_rcache) {
-        fl->fl_rcache->rcache_deregister(fl->fl_rcache, fl_mem->registration);
+        fl->fl_rcache->rcache_deregister(fl->fl_rcache, fl_mem->super.registration);
     }
 
-    if (NULL != fl->fl_mpool) {
-        fl->fl_mpool->mpool_free(fl->fl_mpool, fl_mem->ptr);
-    } else if (fl_mem->ptr) {
-        free(fl_mem->ptr);
+    if (NULL != fl_mem->mpool) {
+        fl_mem->mpool->mpool_free(fl_mem->mpool, fl_mem->super.ptr);
+    } else if (fl_mem->super.ptr) {
+        free(fl_mem->super.ptr);
     }
 
     /* destruct the item (we constructed it), then free the memory chunk */
-    OBJ_DESTRUCT(fl_mem);
-    free(fl_mem);
+    OBJ_DESTRUCT(&fl_mem->super);
+    if (NULL != head_mpool) {
+        head_mpool->mpool_free(head_mpool, fl_mem);
+    } else {
+        free(fl_mem);
+    }
 }
 
 static void opal_free_list_destruct(opal_free_list_t *fl)
@@ -87,6 +486,12 @@ static void opal_free_list_destruct(opal_free_list_t *fl)
     }
 #endif
 
+#if OPAL_HAVE_THREAD_LOCAL
+    if (0 != fl->fl_tcache_size) {
+        opal_free_list_tcache_disable(fl);
+    }
+#endif /* OPAL_HAVE_THREAD_LOCAL */
+
     while (NULL != (item = opal_lifo_pop(&(fl->super)))) {
         fl_item = (opal_free_list_item_t *) item;
 
@@ -166,6 +571,8 @@ int opal_free_list_grow_st(opal_free_list_t *flist, size_t num_elements,
     opal_free_list_memory_t *alloc_ptr;
     size_t alloc_size, head_size, elem_size = 0, buffer_size = 0, align = 0;
     mca_rcache_base_registration_t *reg = NULL;
+    mca_mpool_base_module_t *head_mpool = NULL, *mpool = flist->fl_mpool;
+    bool hugepage;
     int rc = OPAL_SUCCESS;
 
     if (flist->fl_max_to_alloc
@@ -202,21 +609,53 @@ int opal_free_list_grow_st(opal_free_list_t *flist, size_t num_elements,
         }
     }
 
+    /* large enough growths of the lists using the default mpool can be backed by huge pages.
+     * They are then extended to fill whole pages. */
+    hugepage = flist->fl_hugepage && mca_mpool_base_default_module == flist->fl_mpool
+               && align <= opal_free_list_hugepage_size
+               && num_elements * (head_size + elem_size) >= opal_free_list_hugepage_min_size;
+    if (hugepage) {
+        num_elements = opal_free_list_hugepage_fill(flist, num_elements, head_size, elem_size);
+        if (0 != elem_size) {
+            buffer_size = OPAL_ALIGN(num_elements * elem_size, opal_free_list_hugepage_size,
+                                     size_t);
+        }
+    }
+
     /* calculate head allocation size */
     alloc_size = num_elements * head_size + sizeof(opal_free_list_memory_t)
                  + flist->fl_frag_alignment;
 
-    alloc_ptr = (opal_free_list_memory_t *) malloc(alloc_size);
-    if (OPAL_UNLIKELY(NULL == alloc_ptr)) {
-        return OPAL_ERR_TEMP_OUT_OF_RESOURCE;
+    alloc_ptr = NULL;
+    if (hugepage) {
+        alloc_size = OPAL_ALIGN(alloc_size, opal_free_list_hugepage_size, size_t);
+        alloc_ptr = (opal_free_list_memory_t *) opal_free_list_hugepage_alloc(alloc_size,
+                                                                              &head_mpool);
+        (void) opal_atomic_add_fetch_size_t(&opal_free_list_hugepage_stats[OPAL_FREE_LIST_BYTES],
+                                            alloc_size + buffer_size);
+    }
+    if (NULL == alloc_ptr) {
+        alloc_ptr = (opal_free_list_memory_t *) malloc(alloc_size);
+        if (OPAL_UNLIKELY(NULL == alloc_ptr)) {
+            return OPAL_ERR_TEMP_OUT_OF_RESOURCE;
+        }
     }
 
     if (0 != flist->fl_payload_buffer_size) {
         /* allocate the rest from the mpool (or use memalign/malloc) */
-        payload_ptr = (unsigned char *) flist->fl_mpool->mpool_alloc(flist->fl_mpool, buffer_size,
-                                                                     align, 0);
+        if (hugepage) {
+            payload_ptr = (unsigned char *) opal_free_list_hugepage_alloc(buffer_size, &mpool);
+        }
+        if (NULL == payload_ptr) {
+            mpool = flist->fl_mpool;
+            payload_ptr = (unsigned char *) mpool->mpool_alloc(mpool, buffer_size, align, 0);
+        }
         if (NULL == payload_ptr) {
-            free(alloc_ptr);
+            if (NULL != head_mpool) {
+                head_mpool->mpool_free(head_mpool, alloc_ptr);
+            } else {
+                free(alloc_ptr);
+            }
             return OPAL_ERR_TEMP_OUT_OF_RESOURCE;
         }
 
@@ -226,8 +665,16 @@ int opal_free_list_grow_st(opal_free_list_t *flist, size_t num_elements,
                                                    flist->fl_rcache_reg_flags,
                                                    MCA_RCACHE_ACCESS_ANY, &reg);
             if (OPAL_UNLIKELY(OPAL_SUCCESS != rc)) {
-                free(alloc_ptr);
-                flist->fl_mpool->mpool_free(flist->fl_mpool, payload_ptr);
+                if (NULL != head_mpool) {
+                    head_mpool->mpool_free(head_mpool, alloc_ptr);
+                } else {
+                    free(alloc_ptr);
+                }
+                if (NULL != mpool) {
+                    mpool->mpool_free(mpool, payload_ptr);
+                } else {
+                    free(payload_ptr);
+                }
 
                 return rc;
             }
@@ -236,11 +683,13 @@ int opal_free_list_grow_st(opal_free_list_t *flist, size_t num_elements,
 
     /* make the alloc_ptr a list item, save the chunk in the allocations list,
      * and have ptr point to memory right after the list item structure */
-    OBJ_CONSTRUCT(alloc_ptr, opal_free_list_item_t);
+    OBJ_CONSTRUCT(&alloc_ptr->super, opal_free_list_item_t);
     opal_list_append(&(flist->fl_allocations), (opal_list_item_t *) alloc_ptr);
 
-    alloc_ptr->registration = reg;
-    alloc_ptr->ptr = payload_ptr;
+    alloc_ptr->super.registration = reg;
+    alloc_ptr->super.ptr = payload_ptr;
+    alloc_ptr->head_mpool = head_mpool;
+    alloc_ptr->mpool = mpool;
 
     ptr = (unsigned char *) alloc_ptr + sizeof(opal_free_list_memory_t);
     ptr = OPAL_ALIGN_PTR(ptr, flist->fl_frag_alignment, unsigned char *);
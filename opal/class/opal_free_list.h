@@ -91,10 +91,62 @@ struct opal_free_list_t {
     opal_free_list_item_init_fn_t item_init;
     /** Initialization function context */
     void *ctx;
+    /** Back the large enough growths with huge pages (defaults to opal_free_list_hugepage,
+     * can be changed between the construction and opal_free_list_init) */
+    bool fl_hugepage;
+    /** Number of items each thread can keep for itself (0: no thread cache, see
+     * opal_free_list_thread_cache_enable) */
+    unsigned int fl_tcache_size;
+    /** Slot of the list in the per-thread caches */
+    int fl_tcache_index;
+    /** Identifies this list in its slot, the magazines of older lists are stale */
+    uint64_t fl_tcache_generation;
+    /** Items released by full thread caches, pushed and taken as whole chains */
+    opal_atomic_intptr_t fl_tcache_remote;
 };
 typedef struct opal_free_list_t opal_free_list_t;
 OPAL_DECLSPEC OBJ_CLASS_DECLARATION(opal_free_list_t);
 
+/** Maximum number of free lists with a thread cache */
+#define OPAL_FREE_LIST_TCACHE_MAX 32
+
+/**
+ * Items a thread keeps for one free list. Gets and returns of the owning
+ * thread only touch its magazine, the shared LIFO is used to refill an empty
+ * magazine (a batch at a time) and items of a full one are handed over to the
+ * remote list of the free list in a single atomic operation.
+ */
+struct opal_free_list_magazine_t {
+    /** generation of the list the items belong to */
+    uint64_t generation;
+    unsigned int count;
+    unsigned int capacity;
+    struct opal_free_list_item_t *items[];
+};
+typedef struct opal_free_list_magazine_t opal_free_list_magazine_t;
+
+#if OPAL_HAVE_THREAD_LOCAL
+OPAL_DECLSPEC extern opal_thread_local opal_free_list_magazine_t
+    *opal_free_list_magazines[OPAL_FREE_LIST_TCACHE_MAX];
+#endif /* OPAL_HAVE_THREAD_LOCAL */
+
+/** Size of the thread caches of the lists opting in (0: disabled) */
+OPAL_DECLSPEC extern unsigned int opal_free_list_thread_cache;
+
+/** Back the free lists using the default mpool with huge pages */
+OPAL_DECLSPEC extern bool opal_free_list_hugepage;
+/** Size of these huge pages */
+OPAL_DECLSPEC extern size_t opal_free_list_hugepage_size;
+/** Smallest growth of a free list backed by huge pages */
+OPAL_DECLSPEC extern size_t opal_free_list_hugepage_min_size;
+/** mpool hints to find explicit huge pages */
+OPAL_DECLSPEC extern char *opal_free_list_hugepage_hints;
+
+/**
+ * Register the MCA parameters and performance variables of the free lists.
+ */
+OPAL_DECLSPEC int opal_free_list_register_params(void);
+
 struct mca_mpool_base_registration_t;
 struct opal_free_list_item_t {
     opal_list_item_t super;
@@ -174,6 +226,44 @@ OPAL_DECLSPEC int opal_free_list_grow_st(opal_free_list_t *flist, size_t num_ele
  */
 OPAL_DECLSPEC int opal_free_list_resize_mt(opal_free_list_t *flist, size_t size);
 
+/**
+ * Put a per-thread cache in front of a free list.
+ *
+ * @param flist    (IN)   Initialized free list.
+ *
+ * @returns OPAL_SUCCESS if the list is cached (or opal_free_list_thread_cache is 0)
+ * @returns OPAL_ERR_NOT_SUPPORTED without thread local storage
+ * @returns OPAL_ERR_OUT_OF_RESOURCE if all the slots are taken
+ *
+ * Once enabled opal_free_list_get_mt and opal_free_list_return_mt work on a
+ * magazine of at most opal_free_list_thread_cache items private to the calling
+ * thread. Items can be returned by any thread. As items sitting in the caches of
+ * other threads are not available, this should only be used on lists without a
+ * meaningful maximum size. Must be called before the list is used by several
+ * threads. Failing to enable the cache is harmless, the list works as usual.
+ */
+OPAL_DECLSPEC int opal_free_list_thread_cache_enable(opal_free_list_t *flist);
+
+/** Refill the empty thread cache of flist, returns an item or NULL (internal) */
+OPAL_DECLSPEC opal_free_list_item_t *opal_free_list_tcache_refill(opal_free_list_t *flist);
+
+/** Release half of the full thread cache of flist and push item (internal) */
+OPAL_DECLSPEC void opal_free_list_tcache_flush(opal_free_list_t *flist,
+                                               opal_free_list_item_t *item);
+
+#if OPAL_HAVE_THREAD_LOCAL
+/* magazine of the calling thread for flist, NULL if none or stale */
+static inline opal_free_list_magazine_t *opal_free_list_tcache(opal_free_list_t *flist)
+{
+    opal_free_list_magazine_t *mag = opal_free_list_magazines[flist->fl_tcache_index];
+
+    if (OPAL_LIKELY(NULL != mag && mag->generation == flist->fl_tcache_generation)) {
+        return mag;
+    }
+    return NULL;
+}
+#endif /* OPAL_HAVE_THREAD_LOCAL */
+
 /**
  * Attemp to obtain an item from a free list.
  *
@@ -189,8 +279,19 @@ OPAL_DECLSPEC int opal_free_list_resize_mt(opal_free_list_t *flist, size_t size)
  */
 static inline opal_free_list_item_t *opal_free_list_get_mt(opal_free_list_t *flist)
 {
-    opal_free_list_item_t *item = (opal_free_list_item_t *) opal_lifo_pop_atomic(&flist->super);
+    opal_free_list_item_t *item;
+
+#if OPAL_HAVE_THREAD_LOCAL
+    if (0 != flist->fl_tcache_size) {
+        opal_free_list_magazine_t *mag = opal_free_list_tcache(flist);
+        if (OPAL_LIKELY(NULL != mag && 0 != mag->count)) {
+            return mag->items[--mag->count];
+        }
+        return opal_free_list_tcache_refill(flist);
+    }
+#endif /* OPAL_HAVE_THREAD_LOCAL */
 
+    item = (opal_free_list_item_t *) opal_lifo_pop_atomic(&flist->super);
     if (OPAL_UNLIKELY(NULL == item)) {
         opal_mutex_lock(&flist->fl_lock);
         opal_free_list_grow_st(flist, flist->fl_num_per_alloc, &item);
@@ -240,7 +341,16 @@ static inline opal_free_list_item_t *opal_free_list_get(opal_free_list_t *flist)
 
 static inline opal_free_list_item_t *opal_free_list_wait_mt(opal_free_list_t *fl)
 {
-    opal_free_list_item_t *item = (opal_free_list_item_t *) opal_lifo_pop_atomic(&fl->super);
+    opal_free_list_item_t *item;
+
+#if OPAL_HAVE_THREAD_LOCAL
+    /* the refill also takes back the items released by the other threads */
+    if (0 != fl->fl_tcache_size && NULL != (item = opal_free_list_get_mt(fl))) {
+        return item;
+    }
+#endif /* OPAL_HAVE_THREAD_LOCAL */
+
+    item = (opal_free_list_item_t *) opal_lifo_pop_atomic(&fl->super);
 
     while (NULL == item) {
         if (!opal_mutex_trylock(&fl->fl_lock)) {
@@ -312,6 +422,19 @@ static inline void opal_free_list_return_mt(opal_free_list_t *flist, opal_free_l
 {
     opal_list_item_t *original;
 
+#if OPAL_HAVE_THREAD_LOCAL
+    /* waiters sleep on the shared LIFO, feed it directly */
+    if (0 != flist->fl_tcache_size && 0 == flist->fl_num_waiting) {
+        opal_free_list_magazine_t *mag = opal_free_list_tcache(flist);
+        if (OPAL_LIKELY(NULL != mag && mag->count < mag->capacity)) {
+            mag->items[mag->count++] = item;
+            return;
+        }
+        opal_free_list_tcache_flush(flist, item);
+        return;
+    }
+#endif /* OPAL_HAVE_THREAD_LOCAL */
+
     original = opal_lifo_push_atomic(&flist->super, &item->super);
     if (&flist->super.opal_lifo_ghost == original) {
         if (flist->fl_num_waiting > 0) {
@@ -26,6 +26,7 @@
 #include "opal_config.h"
 
 #include "opal/class/opal_interval_tree.h"
+#include "opal/mca/threads/thread_usage.h"
 #include <limits.h>
 
 /* Private functions */
@@ -84,13 +85,14 @@ static void opal_interval_tree_construct(opal_interval_tree_t *tree)
     /* set the tree size to zero */
     tree->tree_size = 0;
     tree->lock = 0;
+    tree->sequence = 0;
     tree->reader_count = 0;
+    tree->reader_id = 0;
     tree->epoch = 0;
 
-    /* set all reader epochs to UINT_MAX. this value is used to simplfy
-     * checks against the current epoch. */
+    /* mark all the reader slots unused. the epoch never takes this value. */
     for (int i = 0; i < OPAL_INTERVAL_TREE_MAX_READERS; ++i) {
-        tree->reader_epochs[i] = UINT_MAX;
+        tree->readers[i].epoch = UINT_MAX;
     }
 }
 
@@ -115,39 +117,67 @@ OBJ_CLASS_INSTANCE(opal_interval_tree_t, opal_object_t, opal_interval_tree_const
 
 typedef int32_t opal_interval_tree_token_t;
 
+#if OPAL_HAVE_THREAD_LOCAL
+/* slot last taken by this thread. a thread keeps taking the same slot so
+ * that the readers rarely compete for one. */
+static opal_thread_local opal_interval_tree_token_t opal_interval_tree_reader_hint = -1;
+#endif
+
 /**
  * @brief pick and return a reader slot
  */
 static opal_interval_tree_token_t opal_interval_tree_reader_get_token(opal_interval_tree_t *tree)
 {
-    opal_interval_tree_token_t token = -1;
+    opal_interval_tree_token_t token;
+    int32_t reader_count;
 
-    if (token < 0) {
-        int32_t reader_count = tree->reader_count;
-        /* NTH: could have used an atomic here but all we are after is some distribution of threads
-         * across the reader slots. with high thread counts i see no real performance difference
-         * using atomics. */
+#if OPAL_HAVE_THREAD_LOCAL
+    token = opal_interval_tree_reader_hint;
+    if (OPAL_UNLIKELY(token < 0)) {
         token = tree->reader_id++ % OPAL_INTERVAL_TREE_MAX_READERS;
+    }
+#else
+    /* NTH: could have used an atomic here but all we are after is some distribution of threads
+     * across the reader slots. with high thread counts i see no real performance difference
+     * using atomics. */
+    token = tree->reader_id++ % OPAL_INTERVAL_TREE_MAX_READERS;
+#endif
+
+    /* move on to the next slot instead of waiting for the reader holding
+     * this one. the slot has to be counted before it is taken, the writers
+     * only check the counted slots. */
+    for (;; token = (token + 1) % OPAL_INTERVAL_TREE_MAX_READERS) {
+        if (UINT_MAX != tree->readers[token].epoch) {
+            continue;
+        }
+
+        reader_count = tree->reader_count;
         while (OPAL_UNLIKELY(reader_count <= token)) {
             if (opal_atomic_compare_exchange_strong_32(&tree->reader_count, &reader_count,
                                                        token + 1)) {
                 break;
             }
         }
-    }
 
-    while (
-        !OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_32((opal_atomic_int32_t *) &tree->reader_epochs[token],
-                                                &(int32_t){UINT_MAX}, tree->epoch)) {
+        if (OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_32((opal_atomic_int32_t *) &tree->readers[token].epoch,
+                                                   &(int32_t){UINT_MAX}, tree->epoch)) {
+            break;
+        }
     }
 
+#if OPAL_HAVE_THREAD_LOCAL
+    opal_interval_tree_reader_hint = token;
+#endif
+
     return token;
 }
 
 static void opal_interval_tree_reader_return_token(opal_interval_tree_t *tree,
                                                    opal_interval_tree_token_t token)
 {
-    tree->reader_epochs[token] = UINT_MAX;
+    /* the lookup has to be done reading the tree before the slot is released */
+    opal_atomic_rmb();
+    tree->readers[token].epoch = UINT_MAX;
 }
 
 /* Create the tree */
@@ -168,14 +198,29 @@ static void opal_interval_tree_write_lock(opal_interval_tree_t *tree)
 {
     while (!opal_interval_tree_write_trylock(tree)) {
     }
+
+    /* let the lookups know that the tree is changing under them */
+    ++tree->sequence;
+    opal_atomic_wmb();
 }
 
 static void opal_interval_tree_write_unlock(opal_interval_tree_t *tree)
 {
     opal_atomic_wmb();
+    ++tree->sequence;
     tree->lock = 0;
 }
 
+/* start a new epoch once the removed nodes are unreachable. a reader that
+ * sees the new epoch can not find them. */
+static void opal_interval_tree_epoch_advance(opal_interval_tree_t *tree)
+{
+    opal_atomic_wmb();
+    if (OPAL_UNLIKELY(UINT_MAX == ++tree->epoch)) {
+        tree->epoch = 0;
+    }
+}
+
 static void opal_interval_tree_insert_fixup_helper(opal_interval_tree_t *tree,
                                                    opal_interval_tree_node_t *node)
 {
@@ -317,19 +362,28 @@ static void opal_interval_tree_delete_fixup(opal_interval_tree_t *tree,
 static void opal_interval_tree_gc_clean(opal_interval_tree_t *tree)
 {
     opal_interval_tree_node_t *node, *next;
-    uint32_t oldest_epoch = UINT_MAX;
+    uint32_t epoch = tree->epoch, oldest_age = 0;
+    bool readers = false;
 
     if (0 == opal_list_get_size(&tree->gc_list)) {
         return;
     }
 
+    /* the epochs wrap around, compare their age instead */
+    opal_atomic_mb();
     for (int i = 0; i < tree->reader_count; ++i) {
-        oldest_epoch = (oldest_epoch < tree->reader_epochs[i]) ? oldest_epoch
-                                                               : tree->reader_epochs[i];
+        uint32_t reader_epoch = tree->readers[i].epoch;
+        if (UINT_MAX != reader_epoch) {
+            readers = true;
+            if (epoch - reader_epoch > oldest_age) {
+                oldest_age = epoch - reader_epoch;
+            }
+        }
     }
 
     OPAL_LIST_FOREACH_SAFE (node, next, &tree->gc_list, opal_interval_tree_node_t) {
-        if (node->epoch < oldest_epoch) {
+        /* the readers that entered after the node was removed do not see it */
+        if (!readers || epoch - node->epoch > oldest_age) {
             opal_list_remove_item(&tree->gc_list, &node->super.super);
             opal_free_list_return_st(&tree->free_list, &node->super);
         }
@@ -361,7 +415,6 @@ int opal_interval_tree_insert(opal_interval_tree_t *tree, void *value, uint64_t
     node->low = low;
     node->high = high;
     node->max = high;
-    node->epoch = tree->epoch;
 
     /* insert the node into the tree */
     opal_interval_tree_insert_node(tree, node);
@@ -431,9 +484,17 @@ void *opal_interval_tree_find_overlapping(opal_interval_tree_t *tree, uint64_t l
 {
     opal_interval_tree_token_t token;
     opal_interval_tree_node_t *node;
+    uint32_t sequence;
 
     token = opal_interval_tree_reader_get_token(tree);
-    node = opal_interval_tree_find_node(tree, low, high, NULL);
+    do {
+        sequence = tree->sequence;
+        opal_atomic_rmb();
+        node = opal_interval_tree_find_node(tree, low, high, NULL);
+        opal_atomic_rmb();
+        /* a rotation may have moved the interval out of the path of the lookup,
+         * only the misses during an update have to be checked again */
+    } while (NULL == node && ((sequence & 1) || sequence != tree->sequence));
     opal_interval_tree_reader_return_token(tree, token);
 
     return node ? node->data : NULL;
@@ -472,28 +533,10 @@ static inline void rp_publish(opal_interval_tree_node_t **ptr, opal_interval_tre
     *ptr = node;
 }
 
-static inline void rp_wait_for_readers(opal_interval_tree_t *tree)
-{
-    uint32_t epoch_id = ++tree->epoch;
-
-    /* wait for all readers to see the new tree version */
-    for (int i = 0; i < tree->reader_count; ++i) {
-        while (tree->reader_epochs[i] < epoch_id) {
-        }
-    }
-}
-
-/* waits for all writers to finish with the node then releases the last reference */
-static inline void rp_free_wait(opal_interval_tree_t *tree, opal_interval_tree_node_t *node)
-{
-    rp_wait_for_readers(tree);
-    /* no other threads are working on this node so go ahead and return it */
-    opal_free_list_return_st(&tree->free_list, &node->super);
-}
-
-/* schedules the node for releasing */
+/* schedules the node for releasing once the readers of this epoch are gone */
 static inline void rp_free(opal_interval_tree_t *tree, opal_interval_tree_node_t *node)
 {
+    node->epoch = tree->epoch;
     opal_list_append(&tree->gc_list, &node->super.super);
 }
 
@@ -558,7 +601,7 @@ static void opal_interval_tree_delete_interior(opal_interval_tree_t *tree,
         next_copy->parent = node->parent;
 
         rp_publish(parent_ptr, next_copy);
-        rp_free_wait(tree, node);
+        rp_free(tree, node);
 
         opal_interval_tree_delete_leaf(tree, next);
     } else {
@@ -614,6 +657,7 @@ int opal_interval_tree_delete(opal_interval_tree_t *tree, uint64_t low, uint64_t
 
     --tree->tree_size;
 
+    opal_interval_tree_epoch_advance(tree);
     opal_interval_tree_write_unlock(tree);
 
     return OPAL_SUCCESS;
@@ -686,16 +730,17 @@ static void opal_interval_tree_insert_node(opal_interval_tree_t *tree,
         assert(nill == n || n->parent == parent);
     }
 
-    /* place it on either the left or the right */
+    /* set its parent and children */
+    node->parent = parent;
+
+    /* place it on either the left or the right. the readers may follow the
+     * link as soon as it is set */
     if (-1 == check) {
-        parent->left = node;
+        rp_publish(&parent->left, node);
     } else {
-        parent->right = node;
+        rp_publish(&parent->right, node);
     }
 
-    /* set its parent and children */
-    node->parent = parent;
-
     ++tree->tree_size;
 }
 
@@ -56,7 +56,7 @@ struct opal_interval_tree_node_t {
     struct opal_interval_tree_node_t *parent; /**< the parent node, can be NULL */
     struct opal_interval_tree_node_t *left;   /**< the left child - can be nill */
     struct opal_interval_tree_node_t *right;  /**< the right child - can be nill */
-    /** edit epoch associated with this node */
+    /** epoch in which the node was removed from the tree */
     uint32_t epoch;
     /** data for this interval */
     void *data;
@@ -72,6 +72,16 @@ typedef struct opal_interval_tree_node_t opal_interval_tree_node_t;
 /** maximum number of simultaneous readers */
 #define OPAL_INTERVAL_TREE_MAX_READERS 128
 
+/**
+ * reader slot. each slot has its own cache line so the readers do not
+ * write to the same lines.
+ */
+struct opal_interval_tree_reader_t {
+    opal_atomic_uint32_t epoch; /**< epoch the reader entered in, UINT_MAX if unused */
+    char padding[64 - sizeof(opal_atomic_uint32_t)];
+};
+typedef struct opal_interval_tree_reader_t opal_interval_tree_reader_t;
+
 /**
  * the data structure that holds all the needed information about the tree.
  */
@@ -87,9 +97,10 @@ struct opal_interval_tree_t {
     uint32_t epoch;                   /**< current update epoch */
     opal_atomic_size_t tree_size;     /**< the current size of the tree */
     opal_atomic_int32_t lock;         /**< update lock */
+    opal_atomic_uint32_t sequence;    /**< update count, odd while the tree is updated */
     opal_atomic_int32_t reader_count; /**< current highest reader slot to check */
     volatile uint32_t reader_id;      /**< next reader slot to check */
-    opal_atomic_uint32_t reader_epochs[OPAL_INTERVAL_TREE_MAX_READERS];
+    opal_interval_tree_reader_t readers[OPAL_INTERVAL_TREE_MAX_READERS];
 };
 typedef struct opal_interval_tree_t opal_interval_tree_t;
 
@@ -152,6 +163,9 @@ OPAL_DECLSPEC int opal_interval_tree_insert(opal_interval_tree_t *tree, void *va
  *
  * @retval pointer to the value if found
  * @retval NULL if not found
+ *
+ * The lookup takes no lock. A lookup that misses while the tree is being
+ * updated is retried, as the rebalancing can hide an interval from it.
  */
 OPAL_DECLSPEC void *opal_interval_tree_find_overlapping(opal_interval_tree_t *tree, uint64_t low,
                                                         uint64_t high);
@@ -42,6 +42,17 @@ BEGIN_C_DECLS
 #    define OPAL_HAVE_ATOMIC_COMPARE_EXCHANGE_128 0
 #endif
 
+/* The counted pointers are updated with the 128-bit compare-exchange, unless
+ * load-linked/store-conditional are available. The LSE compare-and-swap pair
+ * is still preferred on Arm servers, where the exclusives keep failing under
+ * contention (on Apple Silicon the LL/SC version remains faster). */
+#if OPAL_HAVE_ATOMIC_COMPARE_EXCHANGE_128 \
+    && (!OPAL_HAVE_ATOMIC_LLSC_PTR || (OPAL_HAVE_ATOMIC_LSE_128 && !defined(__APPLE__)))
+#    define OPAL_LIFO_USE_COMPARE_EXCHANGE_128 1
+#else
+#    define OPAL_LIFO_USE_COMPARE_EXCHANGE_128 0
+#endif
+
 /**
  * Counted pointer to avoid the ABA problem.
  */
@@ -52,7 +63,7 @@ union opal_counted_pointer_t {
         /** list item pointer */
         volatile opal_atomic_intptr_t item;
     } data;
-#if OPAL_HAVE_ATOMIC_COMPARE_EXCHANGE_128 && HAVE_OPAL_INT128_T && !OPAL_HAVE_ATOMIC_LLSC_PTR
+#if OPAL_LIFO_USE_COMPARE_EXCHANGE_128 && HAVE_OPAL_INT128_T
     /** used for atomics when there is a cmpset that can operate on
      * two 64-bit values */
     opal_atomic_int128_t atomic_value;
@@ -61,7 +72,7 @@ union opal_counted_pointer_t {
 };
 typedef union opal_counted_pointer_t opal_counted_pointer_t;
 
-#if OPAL_HAVE_ATOMIC_COMPARE_EXCHANGE_128 && !OPAL_HAVE_ATOMIC_LLSC_PTR
+#if OPAL_LIFO_USE_COMPARE_EXCHANGE_128
 
 /* Add one element to the FIFO. We will return the last head of the list
  * to allow the upper level to detect if this element is the first one in the
@@ -136,7 +147,7 @@ static inline bool opal_lifo_is_empty(opal_lifo_t *lifo)
     return (opal_list_item_t *) lifo->opal_lifo_head.data.item == &lifo->opal_lifo_ghost;
 }
 
-#if OPAL_HAVE_ATOMIC_COMPARE_EXCHANGE_128 && !OPAL_HAVE_ATOMIC_LLSC_PTR
+#if OPAL_LIFO_USE_COMPARE_EXCHANGE_128
 
 /* Add one element to the LIFO. We will return the last head of the list
  * to allow the upper level to detect if this element is the first one in the
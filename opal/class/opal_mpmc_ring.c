@@ -0,0 +1,60 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal_config.h"
+
+#include <stdlib.h>
+
+#include "opal/class/opal_mpmc_ring.h"
+#include "opal/constants.h"
+
+static void opal_mpmc_ring_construct(opal_mpmc_ring_t *ring)
+{
+    ring->ring_cells = NULL;
+    ring->ring_mask = 0;
+    ring->ring_tail = 0;
+    ring->ring_head = 0;
+}
+
+static void opal_mpmc_ring_destruct(opal_mpmc_ring_t *ring)
+{
+    free(ring->ring_cells);
+    ring->ring_cells = NULL;
+}
+
+OBJ_CLASS_INSTANCE(opal_mpmc_ring_t, opal_object_t, opal_mpmc_ring_construct,
+                   opal_mpmc_ring_destruct);
+
+int opal_mpmc_ring_init(opal_mpmc_ring_t *ring, size_t size)
+{
+    size_t count = 2;
+
+    while (count < size) {
+        count <<= 1;
+    }
+
+    ring->ring_cells = (opal_mpmc_ring_cell_t *) malloc(count * sizeof(opal_mpmc_ring_cell_t));
+    if (NULL == ring->ring_cells) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        ring->ring_cells[i].sequence = (int64_t) i;
+        ring->ring_cells[i].item = NULL;
+    }
+    ring->ring_mask = (int64_t) count - 1;
+    ring->ring_tail = 0;
+    ring->ring_head = 0;
+    opal_atomic_wmb();
+
+    return OPAL_SUCCESS;
+}
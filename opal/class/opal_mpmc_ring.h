@@ -0,0 +1,149 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/** @file
+ *
+ *  A bounded multi-producer/multi-consumer queue of pointers. The items
+ *  are kept in an array of cells, each cell carrying a sequence number
+ *  that tells the producers and the consumers whether it is free or full
+ *  for the current lap (D. Vyukov's bounded MPMC queue). A push or a pop
+ *  costs one compare-exchange on the tail or the head and touches one
+ *  cell, with no pointer chasing and no ABA problem, unlike opal_fifo_t.
+ *  The pushes fail when the ring is full.
+ */
+
+#ifndef OPAL_MPMC_RING_H
+#define OPAL_MPMC_RING_H
+
+#include "opal_config.h"
+
+#include "opal/class/opal_object.h"
+#include "opal/constants.h"
+#include "opal/sys/atomic.h"
+
+BEGIN_C_DECLS
+
+struct opal_mpmc_ring_cell_t {
+    /** lap of the cell: the next push expects its position, the next
+     *  pop its position + 1 */
+    opal_atomic_int64_t sequence;
+    void *item;
+};
+typedef struct opal_mpmc_ring_cell_t opal_mpmc_ring_cell_t;
+
+struct opal_mpmc_ring_t {
+    opal_object_t super;
+    opal_mpmc_ring_cell_t *ring_cells; /**< the cells */
+    int64_t ring_mask;                 /**< number of cells - 1 */
+    /* the producers and the consumers do not share the lines of the positions */
+    char ring_pad0[64];
+    opal_atomic_int64_t ring_tail; /**< position of the next push */
+    char ring_pad1[64 - sizeof(opal_atomic_int64_t)];
+    opal_atomic_int64_t ring_head; /**< position of the next pop */
+    char ring_pad2[64 - sizeof(opal_atomic_int64_t)];
+};
+typedef struct opal_mpmc_ring_t opal_mpmc_ring_t;
+
+OPAL_DECLSPEC OBJ_CLASS_DECLARATION(opal_mpmc_ring_t);
+
+/**
+ * Initialize a ring
+ *
+ * @param[in] ring   the ring object
+ * @param[in] size   the capacity of the ring, rounded up to a power of two
+ *
+ * @returns OPAL_SUCCESS or OPAL_ERR_OUT_OF_RESOURCE
+ */
+OPAL_DECLSPEC int opal_mpmc_ring_init(opal_mpmc_ring_t *ring, size_t size);
+
+/**
+ * Push an item on the ring
+ *
+ * @returns OPAL_SUCCESS, or OPAL_ERR_TEMP_OUT_OF_RESOURCE if the ring is full
+ */
+static inline int opal_mpmc_ring_push(opal_mpmc_ring_t *ring, void *item)
+{
+    int64_t pos = ring->ring_tail, sequence;
+    opal_mpmc_ring_cell_t *cell;
+
+    for (;;) {
+        cell = ring->ring_cells + (pos & ring->ring_mask);
+        sequence = cell->sequence;
+        opal_atomic_rmb();
+
+        if (sequence == pos) {
+            /* on failure pos is the current tail */
+            if (opal_atomic_compare_exchange_strong_64(&ring->ring_tail, &pos, pos + 1)) {
+                break;
+            }
+        } else if (sequence < pos) {
+            /* the cell was not popped since the last lap */
+            return OPAL_ERR_TEMP_OUT_OF_RESOURCE;
+        } else {
+            pos = ring->ring_tail;
+        }
+    }
+
+    cell->item = item;
+    opal_atomic_wmb();
+    cell->sequence = pos + 1;
+
+    return OPAL_SUCCESS;
+}
+
+/**
+ * Pop an item from the ring
+ *
+ * @returns the oldest item, or NULL if the ring is empty
+ */
+static inline void *opal_mpmc_ring_pop(opal_mpmc_ring_t *ring)
+{
+    int64_t pos = ring->ring_head, sequence;
+    opal_mpmc_ring_cell_t *cell;
+    void *item;
+
+    for (;;) {
+        cell = ring->ring_cells + (pos & ring->ring_mask);
+        sequence = cell->sequence;
+        opal_atomic_rmb();
+
+        if (sequence == pos + 1) {
+            if (opal_atomic_compare_exchange_strong_64(&ring->ring_head, &pos, pos + 1)) {
+                break;
+            }
+        } else if (sequence < pos + 1) {
+            /* the cell was not pushed in this lap */
+            return NULL;
+        } else {
+            pos = ring->ring_head;
+        }
+    }
+
+    item = cell->item;
+    /* the item has to be read before the cell is handed to the producers */
+    opal_atomic_mb();
+    cell->sequence = pos + ring->ring_mask + 1;
+
+    return item;
+}
+
+/**
+ * Check if the ring is empty, as seen by the calling thread
+ */
+static inline bool opal_mpmc_ring_is_empty(opal_mpmc_ring_t *ring)
+{
+    return ring->ring_head == ring->ring_tail;
+}
+
+END_C_DECLS
+
+#endif /* OPAL_MPMC_RING_H */
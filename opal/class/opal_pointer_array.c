@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2017 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -22,6 +22,7 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "opal/class/opal_pointer_array.h"
 #include "opal/constants.h"
@@ -31,6 +32,12 @@ static void opal_pointer_array_construct(opal_pointer_array_t *);
 static void opal_pointer_array_destruct(opal_pointer_array_t *);
 static bool grow_table(opal_pointer_array_t *table, int at_least);
 
+/* an array of pointers replaced by a grow */
+typedef struct opal_pointer_array_retired_t {
+    struct opal_pointer_array_retired_t *next;
+    void **addr;
+} opal_pointer_array_retired_t;
+
 OBJ_CLASS_INSTANCE(opal_pointer_array_t, opal_object_t, opal_pointer_array_construct,
                    opal_pointer_array_destruct);
 
@@ -47,6 +54,7 @@ static void opal_pointer_array_construct(opal_pointer_array_t *array)
     array->block_size = 8;
     array->free_bits = NULL;
     array->addr = NULL;
+    array->retired = NULL;
 }
 
 /*
@@ -54,6 +62,8 @@ static void opal_pointer_array_construct(opal_pointer_array_t *array)
  */
 static void opal_pointer_array_destruct(opal_pointer_array_t *array)
 {
+    opal_pointer_array_retired_t *retired;
+
     /* free table */
     if (NULL != array->free_bits) {
         free(array->free_bits);
@@ -63,6 +73,11 @@ static void opal_pointer_array_destruct(opal_pointer_array_t *array)
         free(array->addr);
         array->addr = NULL;
     }
+    while (NULL != (retired = array->retired)) {
+        array->retired = retired->next;
+        free(retired->addr);
+        free(retired);
+    }
 
     array->size = 0;
 
@@ -415,9 +430,16 @@ int opal_pointer_array_set_size(opal_pointer_array_t *array, int new_size)
 static bool grow_table(opal_pointer_array_t *table, int at_least)
 {
     int i, new_size, new_size_int;
+    opal_pointer_array_retired_t *retired = NULL;
+    void **addr;
     void *p;
 
     new_size = table->block_size * ((at_least + 1 + table->block_size - 1) / table->block_size);
+    /* at least double, the replaced arrays are kept until the destruction */
+    if ((new_size - table->size) < table->size) {
+        new_size = (table->size <= (table->max_size - table->size)) ? 2 * table->size
+                                                                   : table->max_size;
+    }
     if (new_size >= table->max_size) {
         new_size = table->max_size;
         if (at_least >= table->max_size) {
@@ -425,16 +447,6 @@ static bool grow_table(opal_pointer_array_t *table, int at_least)
         }
     }
 
-    p = (void **) realloc(table->addr, new_size * sizeof(void *));
-    if (NULL == p) {
-        return false;
-    }
-
-    table->number_free += (new_size - table->size);
-    table->addr = (void **) p;
-    for (i = table->size; i < new_size; ++i) {
-        table->addr[i] = NULL;
-    }
     new_size_int = TYPE_ELEM_COUNT(uint64_t, new_size);
     if ((int) (TYPE_ELEM_COUNT(uint64_t, table->size)) != new_size_int) {
         p = (uint64_t *) realloc(table->free_bits, new_size_int * sizeof(uint64_t));
@@ -446,6 +458,37 @@ static bool grow_table(opal_pointer_array_t *table, int at_least)
             table->free_bits[i] = 0;
         }
     }
+
+    /* the readers may still be using the current array, it is copied
+     * instead of reallocated */
+    addr = (void **) malloc(new_size * sizeof(void *));
+    if (NULL != addr && NULL != table->addr) {
+        retired = (opal_pointer_array_retired_t *) malloc(sizeof(opal_pointer_array_retired_t));
+        if (NULL == retired) {
+            free(addr);
+            addr = NULL;
+        }
+    }
+    if (NULL == addr) {
+        return false;
+    }
+    if (0 < table->size) {
+        memcpy(addr, table->addr, table->size * sizeof(void *));
+    }
+    for (i = table->size; i < new_size; ++i) {
+        addr[i] = NULL;
+    }
+    if (NULL != retired) {
+        retired->addr = table->addr;
+        retired->next = table->retired;
+        table->retired = retired;
+    }
+
+    table->number_free += (new_size - table->size);
+    /* publish the array before the size */
+    opal_atomic_wmb();
+    table->addr = addr;
+    opal_atomic_wmb();
     table->size = new_size;
 #if 0
     opal_output(0, "grow_table %p to %d (max_size %d, block %d, number_free %d)\n",
@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2017 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -24,6 +24,11 @@
  * normally expect size_t.  There's some code that makes sure indices
  * don't go above FORTRAN_HANDLE_MAX (which is min(INT_MAX, fortran
  * INTEGER max)), just to be sure.
+ *
+ * The modifications are serialized by the lock, the reads
+ * (opal_pointer_array_get_item) do not take it. A grow publishes a new
+ * array of pointers before the new size, the arrays it replaces being
+ * kept until the destruction for the readers that may still use them.
  */
 
 #ifndef OPAL_POINTER_ARRAY_H
@@ -34,6 +39,7 @@
 #include "opal/class/opal_object.h"
 #include "opal/mca/threads/mutex.h"
 #include "opal/prefetch.h"
+#include "opal/sys/atomic.h"
 
 BEGIN_C_DECLS
 
@@ -62,6 +68,8 @@ struct opal_pointer_array_t {
     uint64_t *free_bits;
     /** pointer to array of pointers */
     void **addr;
+    /** arrays replaced by a grow, released with the array */
+    struct opal_pointer_array_retired_t *retired;
 };
 /**
  * Convenience typedef
@@ -118,19 +126,20 @@ OPAL_DECLSPEC int opal_pointer_array_set_item(opal_pointer_array_t *array, int i
  * @param element_index  Index of element to be returned (IN)
  *
  * @return Error code.  NULL indicates an error.
+ *
+ * Does not take the lock, the element can be read while the array grows.
  */
-
 static inline void *opal_pointer_array_get_item(opal_pointer_array_t *table, int element_index)
 {
-    void *p;
+    void **addr;
 
     if (OPAL_UNLIKELY(0 > element_index || table->size <= element_index)) {
         return NULL;
     }
-    OPAL_THREAD_LOCK(&(table->lock));
-    p = table->addr[element_index];
-    OPAL_THREAD_UNLOCK(&(table->lock));
-    return p;
+    /* the array seen is at least as large as the size seen */
+    opal_atomic_rmb();
+    addr = (void **) ((volatile opal_pointer_array_t *) table)->addr;
+    return ((void *volatile *) addr)[element_index];
 }
 
 /**
@@ -281,6 +281,10 @@ int32_t opal_convertor_pack(opal_convertor_t *pConv, struct iovec *iov, uint32_t
         return 1;
     }
 
+    if (OPAL_UNLIKELY(opal_datatype_parallel_threads > 1)
+        && (iov[0].iov_len >= opal_datatype_parallel_min_size) && (NULL != iov[0].iov_base)) {
+        return opal_convertor_parallel_advance(pConv, iov, out_size, max_data);
+    }
     return pConv->fAdvance(pConv, iov, out_size, max_data);
 }
 
@@ -331,6 +335,10 @@ int32_t opal_convertor_unpack(opal_convertor_t *pConv, struct iovec *iov, uint32
         return 1;
     }
 
+    if (OPAL_UNLIKELY(opal_datatype_parallel_threads > 1)
+        && (iov[0].iov_len >= opal_datatype_parallel_min_size) && (NULL != iov[0].iov_base)) {
+        return opal_convertor_parallel_advance(pConv, iov, out_size, max_data);
+    }
     return pConv->fAdvance(pConv, iov, out_size, max_data);
 }
 
@@ -431,6 +439,10 @@ int32_t opal_convertor_set_position_nocheck(opal_convertor_t *convertor, size_t
     if (OPAL_LIKELY(convertor->flags & OPAL_DATATYPE_FLAG_CONTIGUOUS)) {
         rc = opal_convertor_create_stack_with_pos_contig(convertor, (*position),
                                                          opal_datatype_local_sizes);
+    } else if (convertor->flags & CONVERTOR_STRIDED) {
+        /* the strided functions only use the position */
+        convertor->bConverted = *position;
+        rc = OPAL_SUCCESS;
     } else {
         if ((0 == (*position)) || ((*position) < convertor->bConverted)) {
             rc = opal_convertor_create_stack_at_begining(convertor, opal_datatype_local_sizes);
@@ -571,6 +583,13 @@ size_t opal_convertor_compute_remote_size(opal_convertor_t *pConvertor)
         opal_convertor_create_stack_at_begining(convertor, opal_datatype_local_sizes);          \
     }
 
+/*
+ * The strided pack and unpack (if enabled) for the committed datatypes
+ * with a strided shape, on homogeneous convertors.
+ */
+#define OPAL_CONVERTOR_USE_STRIDED(convertor) \
+    (opal_datatype_strided_kernels && (0 != (convertor)->pDesc->strided.ndims))
+
 int32_t opal_convertor_prepare_for_recv(opal_convertor_t *convertor,
                                         const struct opal_datatype_t *datatype, size_t count,
                                         const void *pUserBuf)
@@ -594,6 +613,9 @@ int32_t opal_convertor_prepare_for_recv(opal_convertor_t *convertor,
         } else {
             if (convertor->pDesc->flags & OPAL_DATATYPE_FLAG_CONTIGUOUS) {
                 convertor->fAdvance = opal_unpack_homogeneous_contig_checksum;
+            } else if (OPAL_CONVERTOR_USE_STRIDED(convertor)) {
+                convertor->flags |= CONVERTOR_STRIDED;
+                convertor->fAdvance = opal_unpack_homogeneous_strided_checksum;
             } else {
                 convertor->fAdvance = opal_generic_simple_unpack_checksum;
             }
@@ -605,6 +627,9 @@ int32_t opal_convertor_prepare_for_recv(opal_convertor_t *convertor,
         } else {
             if (convertor->pDesc->flags & OPAL_DATATYPE_FLAG_CONTIGUOUS) {
                 convertor->fAdvance = opal_unpack_homogeneous_contig;
+            } else if (OPAL_CONVERTOR_USE_STRIDED(convertor)) {
+                convertor->flags |= CONVERTOR_STRIDED;
+                convertor->fAdvance = opal_unpack_homogeneous_strided;
             } else {
                 convertor->fAdvance = opal_generic_simple_unpack;
             }
@@ -641,6 +666,9 @@ int32_t opal_convertor_prepare_for_send(opal_convertor_t *convertor,
                 } else {
                     convertor->fAdvance = opal_pack_homogeneous_contig_with_gaps_checksum;
                 }
+            } else if (OPAL_CONVERTOR_USE_STRIDED(convertor)) {
+                convertor->flags |= CONVERTOR_STRIDED;
+                convertor->fAdvance = opal_pack_homogeneous_strided_checksum;
             } else {
                 convertor->fAdvance = opal_generic_simple_pack_checksum;
             }
@@ -658,6 +686,9 @@ int32_t opal_convertor_prepare_for_send(opal_convertor_t *convertor,
                 } else {
                     convertor->fAdvance = opal_pack_homogeneous_contig_with_gaps;
                 }
+            } else if (OPAL_CONVERTOR_USE_STRIDED(convertor)) {
+                convertor->flags |= CONVERTOR_STRIDED;
+                convertor->fAdvance = opal_pack_homogeneous_strided;
             } else {
                 convertor->fAdvance = opal_generic_simple_pack;
             }
@@ -745,6 +776,9 @@ void opal_convertor_dump(opal_convertor_t *convertor)
     if (convertor->flags & CONVERTOR_WITH_CHECKSUM) {
         opal_output(0, "checksum ");
     }
+    if (convertor->flags & CONVERTOR_STRIDED) {
+        opal_output(0, "strided ");
+    }
     if (convertor->flags & CONVERTOR_CUDA) {
         opal_output(0, "CUDA ");
     }
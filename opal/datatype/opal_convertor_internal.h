@@ -48,6 +48,69 @@ opal_convertor_master_t *opal_convertor_find_or_create_master(uint32_t remote_ar
  */
 void opal_convertor_destroy_masters(void);
 
+/*
+ * Convert the first iovec with the pool of helper threads when it is large enough
+ * (see opal_convertor_parallel.c), or sequentially otherwise. Same interface as the
+ * fAdvance functions. The helpers are stopped by opal_convertor_parallel_finalize.
+ */
+int32_t opal_convertor_parallel_advance(opal_convertor_t *pConv, struct iovec *iov,
+                                        uint32_t *out_size, size_t *max_data);
+void opal_convertor_parallel_finalize(void);
+
+/*
+ * Position in the user buffer of a convertor on a datatype with a strided
+ * shape (see opal_datatype_strided_t). The count of the convertor is one
+ * more dimension, with the extent of the datatype as stride. The position
+ * only depends on the number of bytes already converted, so the pack and
+ * unpack functions working with it do not need the stack.
+ */
+typedef struct opal_convertor_strided_iter_t {
+    unsigned char *block; /**< beginning of the current block */
+    size_t offset;        /**< bytes of the current block already converted */
+    uint32_t ndims;
+    size_t idx[OPAL_DATATYPE_STRIDED_MAX_DIMS + 1];
+    size_t count[OPAL_DATATYPE_STRIDED_MAX_DIMS + 1];
+    ptrdiff_t stride[OPAL_DATATYPE_STRIDED_MAX_DIMS + 1];
+} opal_convertor_strided_iter_t;
+
+static inline void opal_convertor_strided_init(const opal_convertor_t *pConv,
+                                               opal_convertor_strided_iter_t *it)
+{
+    const opal_datatype_t *pData = pConv->pDesc;
+    const opal_datatype_strided_t *shape = &pData->strided;
+    size_t block = pConv->bConverted / shape->blen;
+    uint32_t d;
+
+    it->ndims = shape->ndims + 1;
+    for (d = 0; d < shape->ndims; d++) {
+        it->count[d] = shape->count[d];
+        it->stride[d] = shape->stride[d];
+    }
+    it->count[shape->ndims] = pConv->count;
+    it->stride[shape->ndims] = pData->ub - pData->lb;
+
+    it->offset = pConv->bConverted % shape->blen;
+    it->block = pConv->pBaseBuf + shape->disp;
+    for (d = 0; d < it->ndims; d++) {
+        it->idx[d] = block % it->count[d];
+        block /= it->count[d];
+        it->block += (ptrdiff_t) it->idx[d] * it->stride[d];
+    }
+}
+
+/* Move to the next block along the dimension dim (and propagate the carry) */
+static inline void opal_convertor_strided_next(opal_convertor_strided_iter_t *it, uint32_t dim)
+{
+    for (; dim < it->ndims; dim++) {
+        it->block += it->stride[dim];
+        if (++it->idx[dim] < it->count[dim]) {
+            return;
+        }
+        it->block -= (ptrdiff_t) it->count[dim] * it->stride[dim];
+        it->idx[dim] = 0;
+    }
+}
+
 END_C_DECLS
 
 #endif /* OPAL_CONVERTOR_INTERNAL_HAS_BEEN_INCLUDED */
@@ -0,0 +1,267 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Parallel conversion of large non-contiguous buffers. When enabled (see the
+ * mpi_ddt_parallel_threads MCA parameter) a pack or unpack of more than
+ * mpi_ddt_parallel_min_size bytes in a single iovec is split among a small
+ * pool of helper threads. Each helper works on a clone of the convertor
+ * moved with opal_convertor_set_position at the beginning of its part of the
+ * packed stream, while the calling thread converts the last part with the
+ * original convertor, which therefore ends up exactly where a sequential
+ * conversion would have left it.
+ */
+
+#include "opal_config.h"
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "opal/datatype/opal_convertor.h"
+#include "opal/datatype/opal_convertor_internal.h"
+#include "opal/datatype/opal_datatype_internal.h"
+#include "opal/util/minmax.h"
+#include "opal/util/output.h"
+
+/* do not bother the helpers for less than this */
+#define OPAL_CONVERTOR_PARALLEL_MIN_PART (64 * 1024)
+
+typedef struct {
+    opal_convertor_t convertor; /**< clone positioned at the beginning of the part */
+    struct iovec iov;           /**< the packed part */
+    size_t max_data;            /**< what the helper converted */
+} opal_convertor_parallel_part_t;
+
+static struct {
+    pthread_mutex_t lock;  /**< protects everything below */
+    pthread_cond_t start;  /**< a new job is posted (or the helpers must leave) */
+    pthread_cond_t done;   /**< the last part of the job is completed */
+    pthread_t *threads;
+    int nslots;              /**< number of allocated parts */
+    int nthreads;            /**< number of started helpers */
+    unsigned int generation; /**< incremented for each job */
+    int nparts;              /**< parts of the current job handled by the helpers */
+    int pending;             /**< parts not yet completed */
+    bool stop;
+    opal_convertor_parallel_part_t *parts;
+} opal_convertor_parallel_pool = {.lock = PTHREAD_MUTEX_INITIALIZER,
+                                  .start = PTHREAD_COND_INITIALIZER,
+                                  .done = PTHREAD_COND_INITIALIZER};
+
+/* the pool serves a single conversion at a time, the others go sequential */
+static pthread_mutex_t opal_convertor_parallel_busy = PTHREAD_MUTEX_INITIALIZER;
+
+static void *opal_convertor_parallel_helper(void *arg)
+{
+    const int rank = (int) (intptr_t) arg;
+    unsigned int generation = 0;
+    opal_convertor_parallel_part_t *part;
+    uint32_t iov_count;
+
+    pthread_mutex_lock(&opal_convertor_parallel_pool.lock);
+    while (1) {
+        while (!opal_convertor_parallel_pool.stop
+               && (generation == opal_convertor_parallel_pool.generation)) {
+            pthread_cond_wait(&opal_convertor_parallel_pool.start,
+                              &opal_convertor_parallel_pool.lock);
+        }
+        if (opal_convertor_parallel_pool.stop) {
+            break;
+        }
+        generation = opal_convertor_parallel_pool.generation;
+        if (rank >= opal_convertor_parallel_pool.nparts) {
+            continue; /* not needed for this one */
+        }
+        part = &opal_convertor_parallel_pool.parts[rank];
+        pthread_mutex_unlock(&opal_convertor_parallel_pool.lock);
+
+        iov_count = 1;
+        part->convertor.fAdvance(&part->convertor, &part->iov, &iov_count, &part->max_data);
+
+        pthread_mutex_lock(&opal_convertor_parallel_pool.lock);
+        if (0 == --opal_convertor_parallel_pool.pending) {
+            pthread_cond_signal(&opal_convertor_parallel_pool.done);
+        }
+    }
+    pthread_mutex_unlock(&opal_convertor_parallel_pool.lock);
+    return NULL;
+}
+
+/* Called with the busy lock held */
+static int opal_convertor_parallel_init(void)
+{
+    int nthreads = opal_datatype_parallel_threads - 1; /* the caller works too */
+
+    opal_convertor_parallel_pool.threads = (pthread_t *) malloc(nthreads * sizeof(pthread_t));
+    opal_convertor_parallel_pool.parts = (opal_convertor_parallel_part_t *)
+        malloc(nthreads * sizeof(opal_convertor_parallel_part_t));
+    if ((NULL == opal_convertor_parallel_pool.threads)
+        || (NULL == opal_convertor_parallel_pool.parts)) {
+        goto disable;
+    }
+    for (int i = 0; i < nthreads; i++) {
+        OBJ_CONSTRUCT(&opal_convertor_parallel_pool.parts[i].convertor, opal_convertor_t);
+    }
+    opal_convertor_parallel_pool.nslots = nthreads;
+    for (; opal_convertor_parallel_pool.nthreads < nthreads;
+         opal_convertor_parallel_pool.nthreads++) {
+        if (0 != pthread_create(&opal_convertor_parallel_pool.threads[opal_convertor_parallel_pool
+                                                                         .nthreads],
+                                NULL, opal_convertor_parallel_helper,
+                                (void *) (intptr_t) opal_convertor_parallel_pool.nthreads)) {
+            break;
+        }
+    }
+    if (0 != opal_convertor_parallel_pool.nthreads) {
+        return OPAL_SUCCESS;
+    }
+    for (int i = 0; i < nthreads; i++) {
+        OBJ_DESTRUCT(&opal_convertor_parallel_pool.parts[i].convertor);
+    }
+    opal_convertor_parallel_pool.nslots = 0;
+
+disable:
+    opal_output_verbose(1, opal_datatype_dfd,
+                        "datatype: cannot start the helper threads, parallel conversions are "
+                        "disabled\n");
+    opal_datatype_parallel_threads = 0;
+    free(opal_convertor_parallel_pool.threads);
+    free(opal_convertor_parallel_pool.parts);
+    opal_convertor_parallel_pool.threads = NULL;
+    opal_convertor_parallel_pool.parts = NULL;
+    return OPAL_ERR_OUT_OF_RESOURCE;
+}
+
+void opal_convertor_parallel_finalize(void)
+{
+    if (0 == opal_convertor_parallel_pool.nthreads) {
+        return;
+    }
+    pthread_mutex_lock(&opal_convertor_parallel_pool.lock);
+    opal_convertor_parallel_pool.stop = true;
+    pthread_cond_broadcast(&opal_convertor_parallel_pool.start);
+    pthread_mutex_unlock(&opal_convertor_parallel_pool.lock);
+    for (int i = 0; i < opal_convertor_parallel_pool.nthreads; i++) {
+        pthread_join(opal_convertor_parallel_pool.threads[i], NULL);
+    }
+    for (int i = 0; i < opal_convertor_parallel_pool.nslots; i++) {
+        OBJ_DESTRUCT(&opal_convertor_parallel_pool.parts[i].convertor);
+    }
+    free(opal_convertor_parallel_pool.threads);
+    free(opal_convertor_parallel_pool.parts);
+    opal_convertor_parallel_pool.threads = NULL;
+    opal_convertor_parallel_pool.parts = NULL;
+    opal_convertor_parallel_pool.nslots = 0;
+    opal_convertor_parallel_pool.nthreads = 0;
+    opal_convertor_parallel_pool.stop = false;
+}
+
+/* Move the convertor to *position, or to the beginning of the predefined
+ * element holding it. Send convertors already round down, the receive ones
+ * would leave a partial element that cannot be completed by another thread.
+ */
+static void opal_convertor_parallel_position(opal_convertor_t *convertor, size_t *position)
+{
+    opal_convertor_set_position(convertor, position);
+    if (0 != convertor->partial_length) {
+        *position -= convertor->partial_length;
+        convertor->partial_length = 0;
+        opal_convertor_set_position(convertor, position);
+    }
+}
+
+int32_t opal_convertor_parallel_advance(opal_convertor_t *pConv, struct iovec *iov,
+                                        uint32_t *out_size, size_t *max_data)
+{
+    size_t length = opal_min(iov[0].iov_len, pConv->local_size - pConv->bConverted);
+    size_t start = pConv->bConverted, position, chunk, converted;
+    opal_convertor_parallel_part_t *part;
+    unsigned char *packed = (unsigned char *) iov[0].iov_base;
+    struct iovec last;
+    uint32_t iov_count = 1;
+    int32_t rc;
+    int nparts, i;
+
+    if ((1 != *out_size) || (length < opal_datatype_parallel_min_size)
+        || !(pConv->flags & CONVERTOR_HOMOGENEOUS)
+        || (pConv->flags & (CONVERTOR_WITH_CHECKSUM | CONVERTOR_CUDA))
+        || (0 != pthread_mutex_trylock(&opal_convertor_parallel_busy))) {
+        return pConv->fAdvance(pConv, iov, out_size, max_data);
+    }
+    if ((0 == opal_convertor_parallel_pool.nthreads)
+        && (OPAL_SUCCESS != opal_convertor_parallel_init())) {
+        pthread_mutex_unlock(&opal_convertor_parallel_busy);
+        return pConv->fAdvance(pConv, iov, out_size, max_data);
+    }
+    nparts = (int) opal_min((size_t) opal_convertor_parallel_pool.nthreads + 1,
+                            length / OPAL_CONVERTOR_PARALLEL_MIN_PART);
+    if (nparts < 2) {
+        pthread_mutex_unlock(&opal_convertor_parallel_busy);
+        return pConv->fAdvance(pConv, iov, out_size, max_data);
+    }
+    chunk = length / nparts;
+
+    /* The helpers take the first nparts-1 parts. The first one starts exactly
+     * where the convertor is, the others on the element boundary closest to
+     * their share. Parts are at least OPAL_CONVERTOR_PARALLEL_MIN_PART long,
+     * way longer than any predefined element, so the boundaries never cross.
+     */
+    part = &opal_convertor_parallel_pool.parts[0];
+    opal_convertor_clone(pConv, &part->convertor, 1);
+    part->convertor.partial_length = pConv->partial_length;
+    part->iov.iov_base = (IOVBASE_TYPE *) packed;
+    for (i = 1; i < nparts; i++) {
+        position = start + i * chunk;
+        if (i < (nparts - 1)) {
+            part = &opal_convertor_parallel_pool.parts[i];
+            opal_convertor_clone(pConv, &part->convertor, 0);
+            opal_convertor_parallel_position(&part->convertor, &position);
+            part->iov.iov_base = (IOVBASE_TYPE *) (packed + (position - start));
+        } else {
+            /* the caller converts the last part with the original convertor */
+            opal_convertor_parallel_position(pConv, &position);
+            last.iov_base = (IOVBASE_TYPE *) (packed + (position - start));
+            last.iov_len = start + length - position;
+        }
+        part = &opal_convertor_parallel_pool.parts[i - 1];
+        part->iov.iov_len = (packed + (position - start)) - (unsigned char *) part->iov.iov_base;
+    }
+
+    pthread_mutex_lock(&opal_convertor_parallel_pool.lock);
+    opal_convertor_parallel_pool.nparts = nparts - 1;
+    opal_convertor_parallel_pool.pending = nparts - 1;
+    opal_convertor_parallel_pool.generation++;
+    pthread_cond_broadcast(&opal_convertor_parallel_pool.start);
+    pthread_mutex_unlock(&opal_convertor_parallel_pool.lock);
+
+    rc = pConv->fAdvance(pConv, &last, &iov_count, &converted);
+
+    pthread_mutex_lock(&opal_convertor_parallel_pool.lock);
+    while (0 != opal_convertor_parallel_pool.pending) {
+        pthread_cond_wait(&opal_convertor_parallel_pool.done, &opal_convertor_parallel_pool.lock);
+    }
+    pthread_mutex_unlock(&opal_convertor_parallel_pool.lock);
+
+    for (i = 0; i < (nparts - 1); i++) {
+        part = &opal_convertor_parallel_pool.parts[i];
+        assert(part->max_data == part->iov.iov_len);
+        converted += part->max_data;
+        opal_convertor_cleanup(&part->convertor);
+    }
+    pthread_mutex_unlock(&opal_convertor_parallel_busy);
+
+    iov[0].iov_len = converted;
+    *out_size = 1;
+    *max_data = converted;
+    return rc;
+}
@@ -20,6 +20,8 @@
 
 #include "opal/datatype/opal_convertor_internal.h"
 #include "opal/datatype/opal_datatype_internal.h"
+#include "opal/sys/atomic.h"
+#include "opal/util/minmax.h"
 #include "opal_stdint.h"
 
 #if OPAL_ENABLE_DEBUG
@@ -56,6 +58,230 @@ static inline int opal_convertor_merge_iov(struct iovec *iov, uint32_t *iov_coun
     return 0;
 }
 
+static void opal_datatype_raw_cache_construct(opal_datatype_raw_cache_t *cache)
+{
+    cache->count = 0;
+    cache->iov = NULL;
+}
+
+static void opal_datatype_raw_cache_destruct(opal_datatype_raw_cache_t *cache)
+{
+    free(cache->iov);
+    cache->iov = NULL;
+    cache->count = 0;
+}
+
+OBJ_CLASS_INSTANCE(opal_datatype_raw_cache_t, opal_object_t, opal_datatype_raw_cache_construct,
+                   opal_datatype_raw_cache_destruct);
+
+/* Append a piece to the flattened layout, merging it with the previous one
+ * when they are adjacent. Return 1 once the layout has too many pieces.
+ */
+static inline int opal_datatype_raw_cache_add(opal_datatype_raw_cache_t *cache, size_t *packed,
+                                              ptrdiff_t disp, size_t len)
+{
+    opal_datatype_raw_cache_entry_t *piece;
+
+    *packed += len;
+    if (0 != cache->count) {
+        piece = &cache->iov[cache->count - 1];
+        if (disp == (piece->disp + (ptrdiff_t) piece->len)) {
+            piece->len += len; /* merge with the previous piece */
+            return 0;
+        }
+        if (cache->count == (size_t) opal_datatype_raw_cache_max_iov) {
+            return 1;
+        }
+    }
+    piece = &cache->iov[cache->count++];
+    piece->disp = disp;
+    piece->len = len;
+    piece->packed = *packed - len;
+    return 0;
+}
+
+/* Flatten the elements [pos_desc, end_desc) of the description, displaced by disp */
+static int opal_datatype_raw_cache_walk(opal_datatype_raw_cache_t *cache, size_t *packed,
+                                        const dt_elem_desc_t *description, uint32_t pos_desc,
+                                        uint32_t end_desc, ptrdiff_t disp)
+{
+    while (pos_desc < end_desc) {
+        const dt_elem_desc_t *pElem = &description[pos_desc];
+
+        if (OPAL_DATATYPE_LOOP == pElem->elem.common.type) {
+            const ddt_endloop_desc_t *end_loop = &description[pos_desc + pElem->loop.items].end_loop;
+
+            for (uint32_t i = 0; i < pElem->loop.loops; i++) {
+                ptrdiff_t loop_disp = disp + (ptrdiff_t) i * pElem->loop.extent;
+                if (pElem->loop.common.flags & OPAL_DATATYPE_FLAG_CONTIGUOUS) {
+                    if (opal_datatype_raw_cache_add(cache, packed,
+                                                    loop_disp + end_loop->first_elem_disp,
+                                                    end_loop->size)) {
+                        return 1;
+                    }
+                } else if (opal_datatype_raw_cache_walk(cache, packed, description, pos_desc + 1,
+                                                        pos_desc + pElem->loop.items, loop_disp)) {
+                    return 1;
+                }
+            }
+            pos_desc += pElem->loop.items + 1;
+            continue;
+        }
+        if (pElem->elem.common.flags & OPAL_DATATYPE_FLAG_DATA) {
+            const ddt_elem_desc_t *current = &pElem->elem;
+            size_t blength = current->blocklen
+                             * opal_datatype_basicDatatypes[current->common.type]->size;
+
+            for (size_t i = 0; i < current->count; i++) {
+                if (opal_datatype_raw_cache_add(cache, packed,
+                                                disp + current->disp
+                                                    + (ptrdiff_t) i * current->extent,
+                                                blength)) {
+                    return 1;
+                }
+            }
+        }
+        pos_desc++;
+    }
+    return 0;
+}
+
+/* Return the flattened layout of the datatype, building it on the first call.
+ * Concurrent callers race to install theirs, the losers release their copy.
+ */
+static opal_datatype_raw_cache_t *opal_datatype_raw_cache_get(const opal_datatype_t *pData)
+{
+    opal_datatype_t *datatype = (opal_datatype_t *) pData; /* the cache is not part of the type */
+    opal_datatype_raw_cache_t *cache = pData->raw_cache, *expected = NULL;
+    size_t packed = 0;
+
+    if (NULL != cache) {
+        return cache;
+    }
+    if ((opal_datatype_raw_cache_max_iov <= 0) || (0 == pData->size)
+        || opal_datatype_is_predefined(pData) || !(pData->flags & OPAL_DATATYPE_FLAG_COMMITTED)) {
+        return OPAL_DATATYPE_RAW_CACHE_NONE;
+    }
+
+    cache = OBJ_NEW(opal_datatype_raw_cache_t);
+    cache->iov = (opal_datatype_raw_cache_entry_t *)
+        malloc(opal_datatype_raw_cache_max_iov * sizeof(opal_datatype_raw_cache_entry_t));
+    if ((NULL == cache->iov)
+        || opal_datatype_raw_cache_walk(cache, &packed, pData->opt_desc.desc, 0,
+                                        pData->opt_desc.used, 0)
+        || (packed != pData->size)) {
+        OBJ_RELEASE(cache);
+        cache = OPAL_DATATYPE_RAW_CACHE_NONE;
+    } else {
+        /* give back the unused space */
+        opal_datatype_raw_cache_entry_t *iov = (opal_datatype_raw_cache_entry_t *)
+            realloc(cache->iov, cache->count * sizeof(opal_datatype_raw_cache_entry_t));
+        if (NULL != iov) {
+            cache->iov = iov;
+        }
+    }
+
+    if (!opal_atomic_compare_exchange_strong_ptr((opal_atomic_intptr_t *) &datatype->raw_cache,
+                                                 (intptr_t *) &expected, (intptr_t) cache)) {
+        opal_datatype_raw_cache_release(cache);
+        cache = expected;
+    }
+    return cache;
+}
+
+/* Conclude a raw conversion done without the stack */
+static inline int32_t opal_convertor_raw_complete(opal_convertor_t *pConvertor,
+                                                  uint32_t *iov_count, size_t *length,
+                                                  uint32_t index, size_t sum_iov_len)
+{
+    pConvertor->bConverted += sum_iov_len; /* update the already converted bytes */
+    *length = sum_iov_len;
+    if (pConvertor->bConverted == pConvertor->local_size) {
+        *iov_count = index + 1; /* account for the currently updating iovec */
+        pConvertor->flags |= CONVERTOR_COMPLETED;
+        return 1;
+    }
+    *iov_count = index;
+    return 0;
+}
+
+/* Generate the iovecs from the flattened layout: the position in the
+ * convertor gives the instance of the datatype and the piece to start from,
+ * and each piece is only rebased on the user buffer.
+ */
+static int32_t opal_convertor_raw_cached(opal_convertor_t *pConvertor,
+                                         const opal_datatype_raw_cache_t *cache, struct iovec *iov,
+                                         uint32_t *iov_count, size_t *length)
+{
+    const opal_datatype_t *pData = pConvertor->pDesc;
+    const ptrdiff_t extent = pData->ub - pData->lb;
+    size_t count = pConvertor->bConverted / pData->size;
+    size_t skip = pConvertor->bConverted % pData->size;
+    size_t lo = 0, hi = cache->count, sum_iov_len = 0, len;
+    const opal_datatype_raw_cache_entry_t *piece;
+    unsigned char *source_base;
+    uint32_t index = 0;
+
+    while ((hi - lo) > 1) { /* the piece holding the current position */
+        size_t mid = (lo + hi) / 2;
+        if (cache->iov[mid].packed <= skip) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    iov[index].iov_len = 0;
+    while ((pConvertor->bConverted + sum_iov_len) < pConvertor->local_size) {
+        piece = &cache->iov[lo];
+        skip -= piece->packed;
+        source_base = pConvertor->pBaseBuf + (ptrdiff_t) count * extent + piece->disp + skip;
+        len = piece->len - skip;
+        OPAL_DATATYPE_SAFEGUARD_POINTER(source_base, len, pConvertor->pBaseBuf, pConvertor->pDesc,
+                                        pConvertor->count);
+        DO_DEBUG(opal_output(0, "raw cached iov[%d] = {base %p, length %" PRIsize_t "}\n", index,
+                             (void *) source_base, len););
+        if (opal_convertor_merge_iov(iov, iov_count, (IOVBASE_TYPE *) source_base, len, &index)) {
+            break; /* no more iovec available, bail out */
+        }
+        sum_iov_len += len;
+        if (++lo == cache->count) {
+            lo = 0;
+            count++;
+        }
+        skip = cache->iov[lo].packed;
+    }
+
+    return opal_convertor_raw_complete(pConvertor, iov_count, length, index, sum_iov_len);
+}
+
+/* The strided convertors do not maintain the stack, walk their shape instead */
+static int32_t opal_convertor_raw_strided(opal_convertor_t *pConvertor, struct iovec *iov,
+                                          uint32_t *iov_count, size_t *length)
+{
+    const size_t blen = pConvertor->pDesc->strided.blen;
+    opal_convertor_strided_iter_t it;
+    size_t sum_iov_len = 0, len;
+    uint32_t index = 0;
+
+    opal_convertor_strided_init(pConvertor, &it);
+    iov[index].iov_len = 0;
+    while ((pConvertor->bConverted + sum_iov_len) < pConvertor->local_size) {
+        len = opal_min(blen - it.offset,
+                       pConvertor->local_size - pConvertor->bConverted - sum_iov_len);
+        OPAL_DATATYPE_SAFEGUARD_POINTER(it.block + it.offset, len, pConvertor->pBaseBuf,
+                                        pConvertor->pDesc, pConvertor->count);
+        if (opal_convertor_merge_iov(iov, iov_count, (IOVBASE_TYPE *) (it.block + it.offset), len,
+                                     &index)) {
+            break; /* no more iovec available, bail out */
+        }
+        sum_iov_len += len;
+        it.offset = 0;
+        opal_convertor_strided_next(&it, 0);
+    }
+    return opal_convertor_raw_complete(pConvertor, iov_count, length, index, sum_iov_len);
+}
+
 /**
  * This function always work in local representation. This means no representation
  * conversion (i.e. no heterogeneity) is taken into account, and that all
@@ -73,6 +299,7 @@ int32_t opal_convertor_raw(opal_convertor_t *pConvertor, struct iovec *iov, uint
     unsigned char *source_base; /* origin of the data */
     size_t sum_iov_len = 0;     /* sum of raw data lengths in the iov_len fields */
     uint32_t index = 0;         /* the iov index and a simple counter */
+    opal_datatype_raw_cache_t *cache;
 
     assert((*iov_count) > 0);
     if (OPAL_LIKELY(pConvertor->flags & CONVERTOR_COMPLETED)) {
@@ -99,6 +326,15 @@ int32_t opal_convertor_raw(opal_convertor_t *pConvertor, struct iovec *iov, uint
     DO_DEBUG(opal_output(0, "opal_convertor_raw( %p, {%p, %" PRIu32 "}, %" PRIsize_t " )\n",
                          (void *) pConvertor, (void *) iov, *iov_count, *length););
 
+    if (pConvertor->flags & CONVERTOR_STRIDED) {
+        return opal_convertor_raw_strided(pConvertor, iov, iov_count, length);
+    }
+    /* Repeated conversions of the same datatype only rebase its flattened layout */
+    cache = opal_datatype_raw_cache_get(pData);
+    if (OPAL_DATATYPE_RAW_CACHE_NONE != cache) {
+        return opal_convertor_raw_cached(pConvertor, cache, iov, iov_count, length);
+    }
+
     description = pConvertor->use_desc->desc;
 
     /* For the first step we have to add both displacement to the source. After in the
@@ -22,6 +22,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "opal/util/arch.h"
 
@@ -43,6 +44,73 @@
  * A better way would be to have a conversion registration functionality.
  */
 
+#if defined(__SSSE3__) || defined(__AVX2__)
+#    include <immintrin.h>
+
+/* pshufb masks reversing the bytes of each 2, 4, 8 and 16 bytes element */
+static const uint8_t opal_dt_swap_masks[4][16] = {
+    {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14},
+    {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12},
+    {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8},
+    {15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0}};
+#elif defined(__ARM_NEON)
+#    include <arm_neon.h>
+#endif
+
+/*
+ * Swap the bytes of the 2, 4, 8 or 16 bytes elements a vector at a time,
+ * with the instructions the library is compiled for. Return the number of
+ * elements swapped, the others are left to the scalar loop.
+ */
+static inline size_t opal_dt_swap_bytes_vector(uint8_t *to, const uint8_t *from,
+                                               const size_t size, size_t count)
+{
+    size_t i = 0;
+#if defined(__SSSE3__) || defined(__AVX2__)
+    const size_t length = size * count;
+    const __m128i mask = _mm_loadu_si128(
+        (const __m128i *) opal_dt_swap_masks[2 == size ? 0 : 4 == size ? 1 : 8 == size ? 2 : 3]);
+
+#    if defined(__AVX2__)
+    const __m256i mask2 = _mm256_broadcastsi128_si256(mask);
+    for (; (i + 32) <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *) (from + i));
+        _mm256_storeu_si256((__m256i *) (to + i), _mm256_shuffle_epi8(v, mask2));
+    }
+#    endif /* defined(__AVX2__) */
+    for (; (i + 16) <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *) (from + i));
+        _mm_storeu_si128((__m128i *) (to + i), _mm_shuffle_epi8(v, mask));
+    }
+#elif defined(__ARM_NEON)
+    const size_t length = size * count;
+
+    for (; (i + 16) <= length; i += 16) {
+        uint8x16_t v = vld1q_u8(from + i);
+        switch (size) {
+        case 2:
+            v = vrev16q_u8(v);
+            break;
+        case 4:
+            v = vrev32q_u8(v);
+            break;
+        case 8:
+            v = vrev64q_u8(v);
+            break;
+        default:
+            v = vrev64q_u8(v);
+            v = vextq_u8(v, v, 8);
+        }
+        vst1q_u8(to + i, v);
+    }
+#else
+    (void) to;
+    (void) from;
+    (void) count;
+#endif
+    return i / size;
+}
+
 static inline void opal_dt_swap_bytes(void *to_p, const void *from_p, const size_t size,
                                       size_t count)
 {
@@ -51,6 +119,51 @@ static inline void opal_dt_swap_bytes(void *to_p, const void *from_p, const size
     uint8_t *to = (uint8_t *) to_p;
     uint8_t *from = (uint8_t *) from_p;
 
+    /* The common sizes go through the vector swap and the byteswap helpers,
+     * whatever the count, so that the non-contiguous loops swapping one
+     * element at a time are not penalized either.
+     */
+    switch (size) {
+    case 2:
+    case 4:
+    case 8:
+    case 16:
+        i = opal_dt_swap_bytes_vector(to, from, size, count);
+        to += i * size;
+        from += i * size;
+        count -= i;
+        break;
+    }
+    switch (size) {
+    case 2:
+        for (; count > 0; count--, to += 2, from += 2) {
+            uint16_t v;
+            memcpy(&v, from, 2);
+            v = opal_swap_bytes2(v);
+            memcpy(to, &v, 2);
+        }
+        return;
+    case 4:
+        for (; count > 0; count--, to += 4, from += 4) {
+            uint32_t v;
+            memcpy(&v, from, 4);
+            v = opal_swap_bytes4(v);
+            memcpy(to, &v, 4);
+        }
+        return;
+    case 8:
+        for (; count > 0; count--, to += 8, from += 8) {
+            uint64_t v;
+            memcpy(&v, from, 8);
+            v = opal_swap_bytes8(v);
+            memcpy(to, &v, 8);
+        }
+        return;
+    }
+    if (0 == count) {
+        return;
+    }
+
     /* Do the first element */
     for (i = 0; i < size; i++, back_i--) {
         to[back_i] = from[i];
@@ -93,6 +93,26 @@ BEGIN_C_DECLS
  */
 #define OPAL_DATATYPE_OPTIMIZED_RESTRICTED  0x1000
 
+/**
+ * Shape of the datatypes whose optimized description is one block of
+ * contiguous bytes repeated along up to OPAL_DATATYPE_STRIDED_MAX_DIMS
+ * strides: vectors of fixed blocks, regular indexed types, N-dimensional
+ * subarrays and block distributed darrays, ... It is computed by
+ * opal_datatype_commit, and the homogeneous pack and unpack then compute the
+ * position of each block instead of interpreting the description.
+ */
+#define OPAL_DATATYPE_STRIDED_MAX_DIMS 8
+
+struct opal_datatype_strided_t {
+    uint32_t ndims;  /**< number of strides, 0 if the datatype does not have this shape */
+    uint32_t gather; /**< nonzero if the innermost stride can use vector gathers/scatters */
+    size_t blen;     /**< length in bytes of each block */
+    ptrdiff_t disp;  /**< displacement of the first block */
+    size_t count[OPAL_DATATYPE_STRIDED_MAX_DIMS];     /**< blocks along each stride, innermost first */
+    ptrdiff_t stride[OPAL_DATATYPE_STRIDED_MAX_DIMS]; /**< strides in bytes, innermost first */
+};
+typedef struct opal_datatype_strided_t opal_datatype_strided_t;
+
 /**
  * The number of supported entries in the data-type definition and the
  * associated type.
@@ -109,6 +129,8 @@ struct dt_type_desc_t {
 };
 typedef struct dt_type_desc_t dt_type_desc_t;
 
+struct opal_datatype_raw_cache_t;
+
 /*
  * The datatype description.
  */
@@ -141,9 +163,12 @@ struct opal_datatype_t {
                          layer). This field should never be initialized in homogeneous
                          environments */
     /* --- cacheline 5 boundary (320 bytes) was 32-36 bytes ago --- */
+    opal_datatype_strided_t strided; /**< strided shape, computed at commit */
+    struct opal_datatype_raw_cache_t *raw_cache; /**< flattened layout for opal_convertor_raw,
+                                                      built on first use */
 
-    /* size: 352, cachelines: 6, members: 15 */
-    /* last cacheline: 28-32 bytes */
+    /* size: 432, cachelines: 7, members: 17 */
+    /* last cacheline: 48 bytes */
 };
 
 typedef struct opal_datatype_t opal_datatype_t;
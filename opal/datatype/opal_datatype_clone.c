@@ -45,6 +45,10 @@ int32_t opal_datatype_clone(const opal_datatype_t *src_type, opal_datatype_t *de
     dest_type->flags &= (~OPAL_DATATYPE_FLAG_PREDEFINED);
     dest_type->ptypes = NULL;
     dest_type->desc.desc = temp;
+    /* same layout, share the flattened one */
+    if ((NULL != dest_type->raw_cache) && (OPAL_DATATYPE_RAW_CACHE_NONE != dest_type->raw_cache)) {
+        OBJ_RETAIN(dest_type->raw_cache);
+    }
 
     /**
      * Allow duplication of MPI_UB and MPI_LB.
@@ -55,6 +55,9 @@ static void opal_datatype_construct(opal_datatype_t *pData)
 
     pData->ptypes = NULL;
     pData->loops = 0;
+    pData->strided.ndims = 0;
+    pData->strided.gather = 0;
+    pData->raw_cache = NULL;
 }
 
 static void opal_datatype_destruct(opal_datatype_t *datatype)
@@ -85,6 +88,9 @@ static void opal_datatype_destruct(opal_datatype_t *datatype)
         datatype->ptypes = NULL;
     }
 
+    opal_datatype_raw_cache_release(datatype->raw_cache);
+    datatype->raw_cache = NULL;
+
     /* make sure the name is set to empty */
     datatype->name[0] = '\0';
 }
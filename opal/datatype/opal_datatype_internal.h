@@ -594,6 +594,44 @@ extern bool opal_ddt_copy_debug;
 extern bool opal_ddt_unpack_debug;
 extern bool opal_ddt_pack_debug;
 extern bool opal_ddt_raw_debug;
+extern bool opal_datatype_strided_kernels;
+extern int opal_datatype_raw_cache_max_iov;
+extern int opal_datatype_parallel_threads;
+extern size_t opal_datatype_parallel_min_size;
+
+/**
+ * The layout of one instance of a datatype, flattened into the list of the
+ * contiguous pieces of memory it touches, for opal_convertor_raw. Each entry
+ * also holds the amount of packed data before it, to find the entry matching
+ * a position without walking the list. The cache is built the first time a
+ * raw convertor is used on the datatype (the datatype then holds a reference),
+ * and shared with its clones. Datatypes with more than
+ * opal_datatype_raw_cache_max_iov pieces are marked with
+ * OPAL_DATATYPE_RAW_CACHE_NONE and always walk their description.
+ */
+struct opal_datatype_raw_cache_entry_t {
+    ptrdiff_t disp; /**< displacement of the piece from the beginning of the datatype */
+    size_t len;     /**< length of the piece in bytes */
+    size_t packed;  /**< amount of data in the pieces before this one */
+};
+typedef struct opal_datatype_raw_cache_entry_t opal_datatype_raw_cache_entry_t;
+
+struct opal_datatype_raw_cache_t {
+    opal_object_t super;
+    size_t count;                         /**< number of pieces */
+    opal_datatype_raw_cache_entry_t *iov; /**< the pieces, in the order of the description */
+};
+typedef struct opal_datatype_raw_cache_t opal_datatype_raw_cache_t;
+OBJ_CLASS_DECLARATION(opal_datatype_raw_cache_t);
+
+#define OPAL_DATATYPE_RAW_CACHE_NONE ((opal_datatype_raw_cache_t *) (intptr_t) 1)
+
+static inline void opal_datatype_raw_cache_release(opal_datatype_raw_cache_t *cache)
+{
+    if ((NULL != cache) && (OPAL_DATATYPE_RAW_CACHE_NONE != cache)) {
+        OBJ_RELEASE(cache);
+    }
+}
 
 END_C_DECLS
 #endif /* OPAL_DATATYPE_INTERNAL_H_HAS_BEEN_INCLUDED */
@@ -47,6 +47,10 @@ bool opal_ddt_position_debug = false;
 bool opal_ddt_copy_debug = false;
 bool opal_ddt_raw_debug = false;
 int opal_ddt_verbose = -1; /* Has the datatype verbose it's own output stream */
+bool opal_datatype_strided_kernels = true;
+int opal_datatype_raw_cache_max_iov = 1024;
+int opal_datatype_parallel_threads = 0;
+size_t opal_datatype_parallel_min_size = 16 * 1024 * 1024;
 
 extern int opal_cuda_verbose;
 
@@ -171,9 +175,51 @@ OPAL_DECLSPEC const opal_datatype_t *opal_datatype_basicDatatypes[OPAL_DATATYPE_
 
 int opal_datatype_register_params(void)
 {
-#if OPAL_ENABLE_DEBUG
     int ret;
 
+    ret = mca_base_var_register(
+        "opal", "mpi", NULL, "ddt_strided_kernels",
+        "Whether to use the specialized pack and unpack functions for the datatypes made of "
+        "one block repeated along up to 8 strides (vectors, subarrays, darrays, ...), instead of "
+        "interpreting their description",
+        MCA_BASE_VAR_TYPE_BOOL, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+        MCA_BASE_VAR_SCOPE_LOCAL, &opal_datatype_strided_kernels);
+    if (0 > ret) {
+        return ret;
+    }
+
+    ret = mca_base_var_register(
+        "opal", "mpi", NULL, "ddt_raw_cache_max_iov",
+        "Maximum number of contiguous pieces of a datatype kept in the flattened layout cached "
+        "for the raw (iovec) convertors. Datatypes with more pieces walk their description "
+        "for each raw conversion (0 = disable the cache)",
+        MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+        MCA_BASE_VAR_SCOPE_LOCAL, &opal_datatype_raw_cache_max_iov);
+    if (0 > ret) {
+        return ret;
+    }
+
+    ret = mca_base_var_register(
+        "opal", "mpi", NULL, "ddt_parallel_threads",
+        "Number of threads, including the calling one, converting the large non-contiguous "
+        "pack and unpack operations in parallel (0 or 1 = convert sequentially)",
+        MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+        MCA_BASE_VAR_SCOPE_LOCAL, &opal_datatype_parallel_threads);
+    if (0 > ret) {
+        return ret;
+    }
+
+    ret = mca_base_var_register(
+        "opal", "mpi", NULL, "ddt_parallel_min_size",
+        "Minimum size in bytes of a single pack or unpack operation to be split among the "
+        "threads selected by mpi_ddt_parallel_threads",
+        MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+        MCA_BASE_VAR_SCOPE_LOCAL, &opal_datatype_parallel_min_size);
+    if (0 > ret) {
+        return ret;
+    }
+
+#if OPAL_ENABLE_DEBUG
     ret = mca_base_var_register(
         "opal", "mpi", NULL, "ddt_unpack_debug",
         "Whether to output debugging information in the ddt unpack functions (nonzero = enabled)",
@@ -253,6 +299,7 @@ static void opal_datatype_finalize(void)
      */
     /* clear all master convertors */
     opal_convertor_destroy_masters();
+    opal_convertor_parallel_finalize();
 
     opal_output_close(opal_datatype_dfd);
     opal_datatype_dfd = -1;
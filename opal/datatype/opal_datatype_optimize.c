@@ -24,7 +24,9 @@
 #include "opal_config.h"
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "opal/datatype/opal_convertor.h"
 #include "opal/datatype/opal_datatype.h"
@@ -288,10 +290,229 @@ static int32_t opal_datatype_optimize_short(opal_datatype_t *pData, size_t count
     return OPAL_SUCCESS;
 }
 
+/*
+ * Look for the strided shape (see opal_datatype_strided_t) in the optimized
+ * description: a single element, possibly inside nested loops. The element
+ * gives the block and the innermost stride, each loop one more stride.
+ * Strides that just continue the previous one are merged, so that a 2D
+ * subarray of whole rows is a vector.
+ */
+static void opal_datatype_compute_strided(opal_datatype_t *pData)
+{
+    opal_datatype_strided_t *shape = &pData->strided;
+    const dt_elem_desc_t *pElem = pData->opt_desc.desc;
+    const ddt_elem_desc_t *elem;
+    uint32_t nloops;
+    ptrdiff_t stride;
+    size_t blen, count;
+    int i;
+
+    shape->ndims = 0;
+    shape->gather = 0;
+    if ((pData->flags & (OPAL_DATATYPE_FLAG_CONTIGUOUS | OPAL_DATATYPE_FLAG_OVERLAP))
+        || (0 == pData->size) || (0 == (pData->opt_desc.used & 1))) {
+        return;
+    }
+    nloops = pData->opt_desc.used / 2;
+    for (i = 0; i < (int) nloops; i++) {
+        if ((OPAL_DATATYPE_LOOP != pElem[i].elem.common.type)
+            || (OPAL_DATATYPE_END_LOOP != pElem[2 * nloops - i].elem.common.type)) {
+            return;
+        }
+    }
+    elem = &pElem[nloops].elem;
+    if (!(elem->common.flags & OPAL_DATATYPE_FLAG_DATA) || (OPAL_DATATYPE_LOOP == elem->common.type)
+        || (OPAL_DATATYPE_END_LOOP == elem->common.type)) {
+        return;
+    }
+
+    /* from the element out: drop the strides with a single block, and merge
+     * the contiguous ones */
+    shape->blen = elem->blocklen * opal_datatype_basicDatatypes[elem->common.type]->size;
+    for (i = (int) nloops; i >= 0; i--) {
+        if ((int) nloops == i) {
+            count = elem->count;
+            stride = elem->extent;
+        } else {
+            count = pElem[i].loop.loops;
+            stride = pElem[i].loop.extent;
+        }
+        if (1 == count) {
+            continue;
+        }
+        if (0 == shape->ndims) {
+            if ((ptrdiff_t) shape->blen == stride) {
+                shape->blen *= count;
+                continue;
+            }
+        } else if ((ptrdiff_t) shape->count[shape->ndims - 1] * shape->stride[shape->ndims - 1]
+                   == stride) {
+            shape->count[shape->ndims - 1] *= count;
+            continue;
+        }
+        if (OPAL_DATATYPE_STRIDED_MAX_DIMS == shape->ndims) {
+            shape->ndims = 0;
+            return;
+        }
+        shape->count[shape->ndims] = count;
+        shape->stride[shape->ndims] = stride;
+        shape->ndims++;
+    }
+    shape->disp = elem->disp;
+    blen = shape->blen;
+    for (i = 0; i < (int) shape->ndims; i++) {
+        blen *= shape->count[i];
+    }
+    /* a single block would be contiguous, it is not worth it */
+    if ((0 == shape->ndims) || (0 == shape->blen) || (blen != pData->size)) {
+        shape->ndims = 0;
+        return;
+    }
+    /* Small blocks along a short enough innermost stride can be moved with the
+     * vector gathers/scatters: up to 16 offsets of a vector must fit in 32 bits.
+     */
+    shape->gather = ((4 == shape->blen) || (8 == shape->blen))
+                    && (shape->count[0] >= 4)
+                    && (shape->stride[0] <= (INT32_MAX / 16))
+                    && (shape->stride[0] >= (INT32_MIN / 16));
+}
+
+/* longest pattern of blocks looked for by opal_datatype_fold_desc */
+#define OPAL_DATATYPE_FOLD_MAX_PERIOD 8
+
+/* Can b be generated by repeating a with a different displacement ? */
+static inline bool opal_datatype_fold_same(const ddt_elem_desc_t *a, const ddt_elem_desc_t *b)
+{
+    return (OPAL_DATATYPE_LOOP != b->common.type) && (OPAL_DATATYPE_END_LOOP != b->common.type)
+           && (a->common.type == b->common.type) && (a->common.flags == b->common.flags)
+           && (a->blocklen == b->blocklen) && (a->count == b->count)
+           && ((1 == a->count) || (a->extent == b->extent));
+}
+
+/* Number of repetitions of the period elements starting at pos */
+static uint32_t opal_datatype_fold_count(const dt_elem_desc_t *desc, uint32_t pos, uint32_t used,
+                                         uint32_t period, ptrdiff_t *delta)
+{
+    uint32_t n, i;
+
+    for (i = 0; i < period; i++) {
+        if ((OPAL_DATATYPE_LOOP == desc[pos + i].elem.common.type)
+            || (OPAL_DATATYPE_END_LOOP == desc[pos + i].elem.common.type)) {
+            return 1;
+        }
+    }
+    *delta = desc[pos + period].elem.disp - desc[pos].elem.disp;
+    if (0 == *delta) {
+        return 1;
+    }
+    for (n = 1; pos + (n + 1) * period <= used; n++) {
+        for (i = 0; i < period; i++) {
+            const ddt_elem_desc_t *a = &desc[pos + i].elem, *b = &desc[pos + n * period + i].elem;
+            if (!opal_datatype_fold_same(a, b) || (b->disp != a->disp + (ptrdiff_t) n * *delta)) {
+                return n;
+            }
+        }
+    }
+    return n;
+}
+
+/*
+ * Fold the runs of top level elements repeating with a constant displacement.
+ * Indexed types with millions of blocks (halos of unstructured meshes)
+ * usually follow a few regular patterns: a run of single blocks becomes one
+ * element with a count, a run of groups of up to OPAL_DATATYPE_FOLD_MAX_PERIOD
+ * blocks becomes a loop around the first group. The description is rewritten
+ * in place, it can only shrink. Returns the number of runs folded.
+ */
+static uint32_t opal_datatype_fold_desc(dt_type_desc_t *pDesc)
+{
+    dt_elem_desc_t *desc = pDesc->desc;
+    uint32_t used = pDesc->used, pos = 0, out = 0, folded = 0;
+    uint32_t period, n, cost, best_period, best_n;
+    ptrdiff_t delta, best_delta = 0;
+    ptrdiff_t saved, best_saved;
+
+    while (pos < used) {
+        if (OPAL_DATATYPE_LOOP == desc[pos].elem.common.type) {
+            /* nested loops are kept as they are */
+            n = desc[pos].loop.items + 1;
+            memmove(&desc[out], &desc[pos], n * sizeof(dt_elem_desc_t));
+            out += n;
+            pos += n;
+            continue;
+        }
+        best_period = best_n = 0;
+        best_saved = 0;
+        for (period = 1; (period <= OPAL_DATATYPE_FOLD_MAX_PERIOD) && (pos + 2 * period <= used);
+             period++) {
+            n = opal_datatype_fold_count(desc, pos, used, period, &delta);
+            if (n < 2) {
+                continue;
+            }
+            cost = ((1 == period) && (1 == desc[pos].elem.count)) ? 1 : period + 2;
+            saved = (ptrdiff_t) n * period - cost;
+            if (saved > best_saved) {
+                best_saved = saved;
+                best_period = period;
+                best_n = n;
+                best_delta = delta;
+            }
+        }
+        if (0 == best_period) {
+            desc[out++] = desc[pos++];
+            continue;
+        }
+        if ((1 == best_period) && (1 == desc[pos].elem.count)) {
+            ddt_elem_desc_t elem = desc[pos].elem;
+
+            CREATE_ELEM(&desc[out], elem.common.type, elem.common.flags, elem.blocklen, best_n,
+                        elem.disp, best_delta);
+            out++;
+        } else {
+            size_t size = 0;
+            uint16_t flags = 0xFFFF;
+
+            /* move the first group in the loop, then add the markers around it */
+            memmove(&desc[out + 1], &desc[pos], best_period * sizeof(dt_elem_desc_t));
+            for (period = 1; period <= best_period; period++) {
+                const ddt_elem_desc_t *elem = &desc[out + period].elem;
+                size += elem->count * elem->blocklen
+                        * opal_datatype_basicDatatypes[elem->common.type]->size;
+                flags &= elem->common.flags;
+            }
+            flags &= ~OPAL_DATATYPE_FLAG_CONTIGUOUS;
+            CREATE_LOOP_START(&desc[out], best_n, best_period + 1, best_delta, flags);
+            CREATE_LOOP_END(&desc[out + best_period + 1], best_period + 1,
+                            desc[out + 1].elem.disp, size, flags);
+            out += best_period + 2;
+        }
+        pos += best_n * best_period;
+        folded++;
+    }
+    pDesc->used = out;
+    return folded;
+}
+
+/* Give back the unused part of a description, keeping the fake END_LOOP */
+static void opal_datatype_shrink_desc(dt_type_desc_t *pDesc)
+{
+    dt_elem_desc_t *desc;
+
+    if ((pDesc->used + 1) >= pDesc->length) {
+        return;
+    }
+    desc = (dt_elem_desc_t *) realloc(pDesc->desc, (pDesc->used + 1) * sizeof(dt_elem_desc_t));
+    if (NULL != desc) {
+        pDesc->desc = desc;
+        pDesc->length = pDesc->used + 1;
+    }
+}
+
 int32_t opal_datatype_commit(opal_datatype_t *pData)
 {
     ddt_endloop_desc_t *pLast = &(pData->desc.desc[pData->desc.used].end_loop);
     ptrdiff_t first_elem_disp = 0;
+    uint32_t folded;
 
     if (pData->flags & OPAL_DATATYPE_FLAG_COMMITTED) {
         return OPAL_SUCCESS;
@@ -331,6 +552,7 @@ int32_t opal_datatype_commit(opal_datatype_t *pData)
     /*if( pData->size == (pData->true_ub - pData->true_lb) ) return OPAL_SUCCESS; */
 
     (void) opal_datatype_optimize_short(pData, 1, &(pData->opt_desc));
+    folded = opal_datatype_fold_desc(&(pData->opt_desc));
     if (0 != pData->opt_desc.used) {
         /* let's add a fake element at the end just to avoid useless comparaisons
          * in pack/unpack functions.
@@ -342,5 +564,23 @@ int32_t opal_datatype_commit(opal_datatype_t *pData)
         pLast->first_elem_disp = first_elem_disp;
         pLast->size = pData->size;
     }
+    opal_datatype_shrink_desc(&(pData->opt_desc));
+
+    /* the unoptimized description is kept for the heterogeneous conversions and
+     * to build other types, fold it too.
+     */
+    folded += opal_datatype_fold_desc(&(pData->desc));
+    pLast = &(pData->desc.desc[pData->desc.used].end_loop);
+    pLast->common.type = OPAL_DATATYPE_END_LOOP;
+    pLast->common.flags = 0;
+    pLast->items = pData->desc.used;
+    pLast->first_elem_disp = first_elem_disp;
+    pLast->size = pData->size;
+    opal_datatype_shrink_desc(&(pData->desc));
+    if (0 != folded) {
+        /* the folded runs are top level loops, one more level on the stack */
+        pData->loops += 2;
+    }
+    opal_datatype_compute_strided(pData);
     return OPAL_SUCCESS;
 }
@@ -42,16 +42,22 @@
 #include "opal/datatype/opal_datatype_checksum.h"
 #include "opal/datatype/opal_datatype_pack.h"
 #include "opal/datatype/opal_datatype_prototypes.h"
+#include "opal/util/minmax.h"
+#if OPAL_CUDA_SUPPORT
+#    include "opal/mca/common/cuda/common_cuda.h"
+#endif /* OPAL_CUDA_SUPPORT */
 
 #if defined(CHECKSUM)
 #    define opal_pack_homogeneous_contig_function opal_pack_homogeneous_contig_checksum
 #    define opal_pack_homogeneous_contig_with_gaps_function \
         opal_pack_homogeneous_contig_with_gaps_checksum
+#    define opal_pack_homogeneous_strided_function opal_pack_homogeneous_strided_checksum
 #    define opal_generic_simple_pack_function opal_generic_simple_pack_checksum
 #    define opal_pack_general_function        opal_pack_general_checksum
 #else
 #    define opal_pack_homogeneous_contig_function           opal_pack_homogeneous_contig
 #    define opal_pack_homogeneous_contig_with_gaps_function opal_pack_homogeneous_contig_with_gaps
+#    define opal_pack_homogeneous_strided_function          opal_pack_homogeneous_strided
 #    define opal_generic_simple_pack_function               opal_generic_simple_pack
 #    define opal_pack_general_function                      opal_pack_general
 #endif /* defined(CHECKSUM) */
@@ -233,6 +239,129 @@ update_status_and_return:
     return !!(pConv->flags & CONVERTOR_COMPLETED); /* done or not */
 }
 
+/* The strided versions do not use the stack either: the position of the
+ * current block is computed from pConvertor->bConverted (see
+ * opal_convertor_strided_init). The blocks of the innermost dimension are
+ * copied in a straight loop, with a constant length for the common sizes,
+ * after the vector gathers took what they could for the small blocks.
+ */
+#define OPAL_STRIDED_PACK_BLOCKS(BLEN)                                                         \
+    for (; i < n; i++) {                                                                       \
+        OPAL_DATATYPE_SAFEGUARD_POINTER(it.block, (BLEN), pConv->pBaseBuf, pConv->pDesc,       \
+                                        pConv->count);                                         \
+        MEMCPY_CSUM(packed_buffer, it.block, (BLEN), pConv);                                   \
+        packed_buffer += (BLEN);                                                               \
+        it.block += it.stride[0];                                                              \
+    }
+
+int32_t opal_pack_homogeneous_strided_function(opal_convertor_t *pConv, struct iovec *iov,
+                                               uint32_t *out_size, size_t *max_data)
+{
+    const size_t blen = pConv->pDesc->strided.blen;
+    size_t remaining, length, n, i, initial_bytes_converted = pConv->bConverted;
+    opal_convertor_strided_iter_t it;
+    unsigned char *packed_buffer;
+    uint32_t idx;
+
+    DO_DEBUG(opal_output(0, "pack_homogeneous_strided( pBaseBuf %p, iov_count %d )\n",
+                         (void *) pConv->pBaseBuf, *out_size););
+    opal_convertor_strided_init(pConv, &it);
+
+    /* We can provide directly the pointers in the user buffers (like the convertor_raw) */
+    if (NULL == iov[0].iov_base) {
+        for (idx = 0; (idx < (*out_size)) && (pConv->bConverted < pConv->local_size); idx++) {
+            length = opal_min(blen - it.offset, pConv->local_size - pConv->bConverted);
+            iov[idx].iov_base = (IOVBASE_TYPE *) (it.block + it.offset);
+            iov[idx].iov_len = length;
+            COMPUTE_CSUM(iov[idx].iov_base, iov[idx].iov_len, pConv);
+            pConv->bConverted += length;
+            it.offset = 0;
+            opal_convertor_strided_next(&it, 0);
+        }
+        goto update_status_and_return;
+    }
+
+    for (idx = 0; idx < (*out_size); idx++) {
+        /* Limit the amount of packed data to the data left over on this convertor */
+        remaining = pConv->local_size - pConv->bConverted;
+        if (0 == remaining) {
+            break; /* we're done this time */
+        }
+        if (remaining > iov[idx].iov_len) {
+            remaining = iov[idx].iov_len;
+        }
+        iov[idx].iov_len = remaining;
+        packed_buffer = (unsigned char *) iov[idx].iov_base;
+        pConv->bConverted += remaining;
+
+        while (0 != remaining) {
+            if ((0 == it.offset) && (blen <= remaining)) {
+                /* as many complete blocks of the innermost dimension as possible */
+                n = opal_min(it.count[0] - it.idx[0], remaining / blen);
+                i = 0;
+#if !defined(CHECKSUM)
+                if (pConv->pDesc->strided.gather && !(pConv->flags & CONVERTOR_CUDA)) {
+                    i = pack_strided_gather(&it.block, &packed_buffer, n, blen, it.stride[0]);
+                }
+#    if OPAL_CUDA_SUPPORT
+                else if ((pConv->flags & CONVERTOR_CUDA) && (n > 1)
+                         && (it.stride[0] >= (ptrdiff_t) blen)
+                         && (OPAL_SUCCESS
+                             == opal_cuda_memcpy_2d(packed_buffer, blen, it.block,
+                                                    (size_t) it.stride[0], blen, n, pConv))) {
+                    /* the n blocks in a single copy on the GPU */
+                    packed_buffer += n * blen;
+                    it.block += (ptrdiff_t) n * it.stride[0];
+                    i = n;
+                }
+#    endif /* OPAL_CUDA_SUPPORT */
+#endif /* !defined(CHECKSUM) */
+                switch (blen) {
+                case 4:
+                    OPAL_STRIDED_PACK_BLOCKS(4);
+                    break;
+                case 8:
+                    OPAL_STRIDED_PACK_BLOCKS(8);
+                    break;
+                case 16:
+                    OPAL_STRIDED_PACK_BLOCKS(16);
+                    break;
+                default:
+                    OPAL_STRIDED_PACK_BLOCKS(blen);
+                }
+                remaining -= n * blen;
+                it.idx[0] += n;
+                if (it.idx[0] == it.count[0]) {
+                    it.block -= (ptrdiff_t) it.count[0] * it.stride[0];
+                    it.idx[0] = 0;
+                    opal_convertor_strided_next(&it, 1);
+                }
+                continue;
+            }
+            /* partial block at the beginning or at the end of the fragment */
+            length = opal_min(blen - it.offset, remaining);
+            OPAL_DATATYPE_SAFEGUARD_POINTER(it.block + it.offset, length, pConv->pBaseBuf,
+                                            pConv->pDesc, pConv->count);
+            MEMCPY_CSUM(packed_buffer, it.block + it.offset, length, pConv);
+            packed_buffer += length;
+            remaining -= length;
+            it.offset += length;
+            if (blen == it.offset) {
+                it.offset = 0;
+                opal_convertor_strided_next(&it, 0);
+            }
+        }
+    }
+
+update_status_and_return:
+    *out_size = idx;
+    *max_data = pConv->bConverted - initial_bytes_converted;
+    if (pConv->bConverted == pConv->local_size) {
+        pConv->flags |= CONVERTOR_COMPLETED;
+    }
+    return !!(pConv->flags & CONVERTOR_COMPLETED); /* done or not */
+}
+
 /* The pack/unpack functions need a cleanup. I have to create a proper interface to access
  * all basic functionalities, hence using them as basic blocks for all conversion functions.
  *
@@ -22,6 +22,10 @@
 #include "opal_config.h"
 #include "opal/datatype/opal_datatype_pack_unpack_predefined.h"
 
+#if defined(__AVX2__) || defined(__AVX512F__)
+#    include <immintrin.h>
+#endif
+
 #if !defined(CHECKSUM) && OPAL_CUDA_SUPPORT
 /* Make use of existing macro to do CUDA style memcpy */
 #    undef MEMCPY_CSUM
@@ -193,6 +197,74 @@ static inline void pack_contiguous_loop(opal_convertor_t *CONVERTOR, const dt_el
     *(COUNT) -= _copy_loops;
 }
 
+/**
+ * Gather the small blocks of the innermost stride of a strided datatype (see
+ * opal_datatype_strided_t::gather) with the vector gathers of the ISA the
+ * library is compiled for. ELEM_SIZE is 4 or 8 bytes, and opal_datatype_commit
+ * made sure the offsets of a vector of blocks fit in 32 bits. Return the number
+ * of blocks copied, the leftovers (or all of them without AVX2) are left to the
+ * scalar loop.
+ */
+static inline size_t pack_strided_gather(unsigned char **memory, unsigned char **packed,
+                                         size_t n, size_t elem_size, ptrdiff_t stride)
+{
+    size_t done = 0;
+#if defined(__AVX2__) || defined(__AVX512F__)
+    unsigned char *_memory = *memory, *_packed = *packed;
+
+    if (8 == elem_size) {
+#    if defined(__AVX512F__)
+        const __m512i vidx8 = _mm512_set_epi64(7 * stride, 6 * stride, 5 * stride, 4 * stride,
+                                               3 * stride, 2 * stride, stride, 0);
+        for (; done + 8 <= n; done += 8) {
+            _mm512_storeu_si512((void *) _packed, _mm512_i64gather_epi64(vidx8, _memory, 1));
+            _memory += 8 * stride;
+            _packed += 64;
+        }
+#    endif /* defined(__AVX512F__) */
+#    if defined(__AVX2__)
+        const __m256i vidx4 = _mm256_set_epi64x(3 * stride, 2 * stride, stride, 0);
+        for (; done + 4 <= n; done += 4) {
+            _mm256_storeu_si256((__m256i *) _packed,
+                                _mm256_i64gather_epi64((const long long *) _memory, vidx4, 1));
+            _memory += 4 * stride;
+            _packed += 32;
+        }
+#    endif /* defined(__AVX2__) */
+    } else if (4 == elem_size) {
+        const int s = (int) stride;
+#    if defined(__AVX512F__)
+        const __m512i vidx16 = _mm512_set_epi32(15 * s, 14 * s, 13 * s, 12 * s, 11 * s, 10 * s,
+                                                9 * s, 8 * s, 7 * s, 6 * s, 5 * s, 4 * s, 3 * s,
+                                                2 * s, s, 0);
+        for (; done + 16 <= n; done += 16) {
+            _mm512_storeu_si512((void *) _packed, _mm512_i32gather_epi32(vidx16, _memory, 1));
+            _memory += 16 * stride;
+            _packed += 64;
+        }
+#    endif /* defined(__AVX512F__) */
+#    if defined(__AVX2__)
+        const __m256i vidx8 = _mm256_set_epi32(7 * s, 6 * s, 5 * s, 4 * s, 3 * s, 2 * s, s, 0);
+        for (; done + 8 <= n; done += 8) {
+            _mm256_storeu_si256((__m256i *) _packed,
+                                _mm256_i32gather_epi32((const int *) _memory, vidx8, 1));
+            _memory += 8 * stride;
+            _packed += 32;
+        }
+#    endif /* defined(__AVX2__) */
+    }
+    *memory = _memory;
+    *packed = _packed;
+#else
+    (void) memory;
+    (void) packed;
+    (void) n;
+    (void) elem_size;
+    (void) stride;
+#endif /* defined(__AVX2__) || defined(__AVX512F__) */
+    return done;
+}
+
 #define PACK_PARTIAL_BLOCKLEN(CONVERTOR, /* the convertor */                       \
                               ELEM,      /* the basic element to be packed */      \
                               COUNT,     /* the number of elements */              \
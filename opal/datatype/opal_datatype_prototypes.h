@@ -42,6 +42,10 @@ int32_t opal_pack_homogeneous_contig_with_gaps(opal_convertor_t *pConv, struct i
                                                uint32_t *out_size, size_t *max_data);
 int32_t opal_pack_homogeneous_contig_with_gaps_checksum(opal_convertor_t *pConv, struct iovec *iov,
                                                         uint32_t *out_size, size_t *max_data);
+int32_t opal_pack_homogeneous_strided(opal_convertor_t *pConv, struct iovec *iov,
+                                      uint32_t *out_size, size_t *max_data);
+int32_t opal_pack_homogeneous_strided_checksum(opal_convertor_t *pConv, struct iovec *iov,
+                                               uint32_t *out_size, size_t *max_data);
 int32_t opal_generic_simple_pack(opal_convertor_t *pConvertor, struct iovec *iov,
                                  uint32_t *out_size, size_t *max_data);
 int32_t opal_generic_simple_pack_checksum(opal_convertor_t *pConvertor, struct iovec *iov,
@@ -50,6 +54,10 @@ int32_t opal_unpack_homogeneous_contig(opal_convertor_t *pConv, struct iovec *io
                                        uint32_t *out_size, size_t *max_data);
 int32_t opal_unpack_homogeneous_contig_checksum(opal_convertor_t *pConv, struct iovec *iov,
                                                 uint32_t *out_size, size_t *max_data);
+int32_t opal_unpack_homogeneous_strided(opal_convertor_t *pConv, struct iovec *iov,
+                                        uint32_t *out_size, size_t *max_data);
+int32_t opal_unpack_homogeneous_strided_checksum(opal_convertor_t *pConv, struct iovec *iov,
+                                                 uint32_t *out_size, size_t *max_data);
 int32_t opal_generic_simple_unpack(opal_convertor_t *pConvertor, struct iovec *iov,
                                    uint32_t *out_size, size_t *max_data);
 int32_t opal_generic_simple_unpack_checksum(opal_convertor_t *pConvertor, struct iovec *iov,
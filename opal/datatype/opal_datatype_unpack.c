@@ -44,14 +44,20 @@
 #include "opal/datatype/opal_datatype_checksum.h"
 #include "opal/datatype/opal_datatype_prototypes.h"
 #include "opal/datatype/opal_datatype_unpack.h"
+#include "opal/util/minmax.h"
+#if OPAL_CUDA_SUPPORT
+#    include "opal/mca/common/cuda/common_cuda.h"
+#endif /* OPAL_CUDA_SUPPORT */
 
 #if defined(CHECKSUM)
 #    define opal_unpack_general_function            opal_unpack_general_checksum
 #    define opal_unpack_homogeneous_contig_function opal_unpack_homogeneous_contig_checksum
+#    define opal_unpack_homogeneous_strided_function opal_unpack_homogeneous_strided_checksum
 #    define opal_generic_simple_unpack_function     opal_generic_simple_unpack_checksum
 #else
 #    define opal_unpack_general_function            opal_unpack_general
 #    define opal_unpack_homogeneous_contig_function opal_unpack_homogeneous_contig
+#    define opal_unpack_homogeneous_strided_function opal_unpack_homogeneous_strided
 #    define opal_generic_simple_unpack_function     opal_generic_simple_unpack
 #endif /* defined(CHECKSUM) */
 
@@ -161,6 +167,113 @@ int32_t opal_unpack_homogeneous_contig_function(opal_convertor_t *pConv, struct
     return !!(pConv->flags & CONVERTOR_COMPLETED); /* done or not */
 }
 
+/**
+ * Datatypes with a strided shape (see opal_datatype_strided_t). As in the
+ * contiguous case the stack is not used, the position of the current block
+ * is computed from the bConverted of the convertor. The blocks of the
+ * innermost dimension are copied in a straight loop, with a constant length
+ * for the common sizes, after the vector scatters took what they could for
+ * the small blocks.
+ */
+#define OPAL_STRIDED_UNPACK_BLOCKS(BLEN)                                                       \
+    for (; i < n; i++) {                                                                       \
+        OPAL_DATATYPE_SAFEGUARD_POINTER(it.block, (BLEN), pConv->pBaseBuf, pConv->pDesc,       \
+                                        pConv->count);                                         \
+        MEMCPY_CSUM(it.block, packed_buffer, (BLEN), pConv);                                   \
+        packed_buffer += (BLEN);                                                               \
+        it.block += it.stride[0];                                                              \
+    }
+
+int32_t opal_unpack_homogeneous_strided_function(opal_convertor_t *pConv, struct iovec *iov,
+                                                 uint32_t *out_size, size_t *max_data)
+{
+    const size_t blen = pConv->pDesc->strided.blen;
+    size_t remaining, length, n, i, initial_bytes_converted = pConv->bConverted;
+    opal_convertor_strided_iter_t it;
+    unsigned char *packed_buffer;
+    uint32_t iov_idx;
+
+    DO_DEBUG(opal_output(0, "unpack_homogeneous_strided( pBaseBuf %p, iov_count %d )\n",
+                         (void *) pConv->pBaseBuf, *out_size););
+    opal_convertor_strided_init(pConv, &it);
+
+    for (iov_idx = 0; iov_idx < (*out_size); iov_idx++) {
+        remaining = pConv->local_size - pConv->bConverted;
+        if (0 == remaining) {
+            break; /* we're done this time */
+        }
+        if (remaining > iov[iov_idx].iov_len) {
+            remaining = iov[iov_idx].iov_len;
+        }
+        packed_buffer = (unsigned char *) iov[iov_idx].iov_base;
+        pConv->bConverted += remaining;
+
+        while (0 != remaining) {
+            if ((0 == it.offset) && (blen <= remaining)) {
+                /* as many complete blocks of the innermost dimension as possible */
+                n = opal_min(it.count[0] - it.idx[0], remaining / blen);
+                i = 0;
+#if !defined(CHECKSUM)
+                if (pConv->pDesc->strided.gather && !(pConv->flags & CONVERTOR_CUDA)) {
+                    i = unpack_strided_scatter(&packed_buffer, &it.block, n, blen, it.stride[0]);
+                }
+#    if OPAL_CUDA_SUPPORT
+                else if ((pConv->flags & CONVERTOR_CUDA) && (n > 1)
+                         && (it.stride[0] >= (ptrdiff_t) blen)
+                         && (OPAL_SUCCESS
+                             == opal_cuda_memcpy_2d(it.block, (size_t) it.stride[0], packed_buffer,
+                                                    blen, blen, n, pConv))) {
+                    /* the n blocks in a single copy on the GPU */
+                    packed_buffer += n * blen;
+                    it.block += (ptrdiff_t) n * it.stride[0];
+                    i = n;
+                }
+#    endif /* OPAL_CUDA_SUPPORT */
+#endif /* !defined(CHECKSUM) */
+                switch (blen) {
+                case 4:
+                    OPAL_STRIDED_UNPACK_BLOCKS(4);
+                    break;
+                case 8:
+                    OPAL_STRIDED_UNPACK_BLOCKS(8);
+                    break;
+                case 16:
+                    OPAL_STRIDED_UNPACK_BLOCKS(16);
+                    break;
+                default:
+                    OPAL_STRIDED_UNPACK_BLOCKS(blen);
+                }
+                remaining -= n * blen;
+                it.idx[0] += n;
+                if (it.idx[0] == it.count[0]) {
+                    it.block -= (ptrdiff_t) it.count[0] * it.stride[0];
+                    it.idx[0] = 0;
+                    opal_convertor_strided_next(&it, 1);
+                }
+                continue;
+            }
+            /* partial block at the beginning or at the end of the fragment */
+            length = opal_min(blen - it.offset, remaining);
+            OPAL_DATATYPE_SAFEGUARD_POINTER(it.block + it.offset, length, pConv->pBaseBuf,
+                                            pConv->pDesc, pConv->count);
+            MEMCPY_CSUM(it.block + it.offset, packed_buffer, length, pConv);
+            packed_buffer += length;
+            remaining -= length;
+            it.offset += length;
+            if (blen == it.offset) {
+                it.offset = 0;
+                opal_convertor_strided_next(&it, 0);
+            }
+        }
+    }
+    *out_size = iov_idx;
+    *max_data = pConv->bConverted - initial_bytes_converted;
+    if (pConv->bConverted == pConv->local_size) {
+        pConv->flags |= CONVERTOR_COMPLETED;
+    }
+    return !!(pConv->flags & CONVERTOR_COMPLETED); /* done or not */
+}
+
 /**
  * This function handle partial types. Depending on the send operation it might happens
  * that we receive only a partial type (always predefined type). In fact the outcome is
@@ -21,6 +21,10 @@
 #include "opal_config.h"
 #include "opal/datatype/opal_datatype_pack_unpack_predefined.h"
 
+#if defined(__AVX512F__)
+#    include <immintrin.h>
+#endif
+
 #if !defined(CHECKSUM) && OPAL_CUDA_SUPPORT
 /* Make use of existing macro to do CUDA style memcpy */
 #    undef MEMCPY_CSUM
@@ -193,6 +197,49 @@ static inline void unpack_contiguous_loop(opal_convertor_t *CONVERTOR, const dt_
     *(COUNT) -= _copy_loops;
 }
 
+/**
+ * Scatter the small blocks of the innermost stride of a strided datatype, the
+ * mirror of pack_strided_gather. Only AVX-512 has vector scatters; elsewhere
+ * this returns 0 and the scalar loop does all the blocks.
+ */
+static inline size_t unpack_strided_scatter(unsigned char **packed, unsigned char **memory,
+                                            size_t n, size_t elem_size, ptrdiff_t stride)
+{
+    size_t done = 0;
+#if defined(__AVX512F__)
+    unsigned char *_memory = *memory, *_packed = *packed;
+
+    if (8 == elem_size) {
+        const __m512i vidx8 = _mm512_set_epi64(7 * stride, 6 * stride, 5 * stride, 4 * stride,
+                                               3 * stride, 2 * stride, stride, 0);
+        for (; done + 8 <= n; done += 8) {
+            _mm512_i64scatter_epi64(_memory, vidx8, _mm512_loadu_si512((const void *) _packed), 1);
+            _memory += 8 * stride;
+            _packed += 64;
+        }
+    } else if (4 == elem_size) {
+        const int s = (int) stride;
+        const __m512i vidx16 = _mm512_set_epi32(15 * s, 14 * s, 13 * s, 12 * s, 11 * s, 10 * s,
+                                                9 * s, 8 * s, 7 * s, 6 * s, 5 * s, 4 * s, 3 * s,
+                                                2 * s, s, 0);
+        for (; done + 16 <= n; done += 16) {
+            _mm512_i32scatter_epi32(_memory, vidx16, _mm512_loadu_si512((const void *) _packed), 1);
+            _memory += 16 * stride;
+            _packed += 64;
+        }
+    }
+    *memory = _memory;
+    *packed = _packed;
+#else
+    (void) packed;
+    (void) memory;
+    (void) n;
+    (void) elem_size;
+    (void) stride;
+#endif /* defined(__AVX512F__) */
+    return done;
+}
+
 #define UNPACK_PARTIAL_BLOCKLEN(CONVERTOR, /* the convertor */                       \
                                 ELEM,      /* the basic element to be packed */      \
                                 COUNT,     /* the number of elements */              \
@@ -0,0 +1,56 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#if !defined(OPAL_SYS_ARCH_ATOMIC_LSE_H)
+
+#    define OPAL_SYS_ARCH_ATOMIC_LSE_H
+
+/* 128-bit compare-exchange using the ARMv8.1 LSE compare-and-swap pair.
+ * Compilers either call into libatomic for it or do not report it as lock
+ * free. Unlike the exclusives, a single instruction does not lose its
+ * reservation under contention, so this is the better path for the lifo and
+ * fifo counted pointers on large Arm servers. Only available when the
+ * compiler targets LSE (-march=armv8.1-a or later). */
+#    if OPAL_C_GCC_INLINE_ASSEMBLY && HAVE_OPAL_INT128_T && defined(__ARM_FEATURE_ATOMICS) \
+        && defined(__AARCH64EL__)
+
+#        undef opal_atomic_compare_exchange_strong_128
+#        undef OPAL_HAVE_ATOMIC_COMPARE_EXCHANGE_128
+
+#        define OPAL_HAVE_ATOMIC_COMPARE_EXCHANGE_128 1
+#        define OPAL_HAVE_ATOMIC_LSE_128              1
+
+static inline bool opal_atomic_lse_compare_exchange_strong_128(opal_atomic_int128_t *addr,
+                                                               opal_int128_t *oldval,
+                                                               opal_int128_t newval)
+{
+    /* casp works on pairs of consecutive registers starting at an even one */
+    register uint64_t old_lo __asm__("x0") = (uint64_t) *oldval;
+    register uint64_t old_hi __asm__("x1") = (uint64_t) (*oldval >> 64);
+    register uint64_t new_lo __asm__("x2") = (uint64_t) newval;
+    register uint64_t new_hi __asm__("x3") = (uint64_t) (newval >> 64);
+    opal_int128_t expected = *oldval;
+
+    __asm__ __volatile__("caspal  %0, %1, %2, %3, [%4]   \n"
+                         : "+r"(old_lo), "+r"(old_hi)
+                         : "r"(new_lo), "r"(new_hi), "r"(addr)
+                         : "memory");
+
+    *oldval = (opal_int128_t) (((unsigned __int128) old_hi << 64) | old_lo);
+    return *oldval == expected;
+}
+
+#        define opal_atomic_compare_exchange_strong_128 opal_atomic_lse_compare_exchange_strong_128
+
+#    endif
+
+#endif /* ! OPAL_SYS_ARCH_ATOMIC_LSE_H */
@@ -628,6 +628,11 @@ static inline intptr_t opal_atomic_fetch_sub_ptr(opal_atomic_intptr_t *addr, voi
  * LL/SC fifo and lifo are ~ 2-20x faster than the CAS128 implementation. */
 #if OPAL_ASSEMBLY_ARCH == OPAL_ARM64
 #    include "opal/sys/arm64/atomic_llsc.h"
+#    include "opal/sys/arm64/atomic_lse.h"
+#endif
+
+#if !defined(OPAL_HAVE_ATOMIC_LSE_128)
+#    define OPAL_HAVE_ATOMIC_LSE_128 0
 #endif
 
 #if !defined(OPAL_HAVE_ATOMIC_LLSC_32)
@@ -33,6 +33,7 @@
 #include "opal/mca/mca.h"
 #include "opal/util/argv.h"
 #include "opal/util/output.h"
+#include "opal/util/timings.h"
 
 /*
  * Local functions
@@ -104,6 +105,8 @@ static int open_components(mca_base_framework_t *framework)
                         "mca: base: components_open: opening %s components",
                         framework->framework_name);
 
+    OPAL_TIMING_ENV_INIT(otmng);
+
     /* Traverse the list of components */
     OPAL_LIST_FOREACH_SAFE (cli, next, components, mca_base_component_list_item_t) {
         const mca_base_component_t *component = cli->cli_component;
@@ -115,6 +118,8 @@ static int open_components(mca_base_framework_t *framework)
         if (NULL != component->mca_open_component) {
             /* Call open if register didn't call it already */
             ret = component->mca_open_component();
+            OPAL_TIMING_ENV_NEXT(otmng, "%s_%s", component->mca_type_name,
+                                 component->mca_component_name);
 
             if (OPAL_SUCCESS == ret) {
                 opal_output_verbose(MCA_BASE_VERBOSE_COMPONENT, output_id,
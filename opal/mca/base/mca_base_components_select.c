@@ -29,6 +29,7 @@
 #include "opal/mca/mca.h"
 #include "opal/runtime/opal.h"
 #include "opal/util/output.h"
+#include "opal/util/timings.h"
 
 int mca_base_select(const char *type_name, int output_id, opal_list_t *components_available,
                     mca_base_module_t **best_module, mca_base_component_t **best_component,
@@ -46,6 +47,8 @@ int mca_base_select(const char *type_name, int output_id, opal_list_t *component
     opal_output_verbose(MCA_BASE_VERBOSE_COMPONENT, output_id,
                         "mca:base:select: Auto-selecting %s components", type_name);
 
+    OPAL_TIMING_ENV_INIT(otmng);
+
     /*
      * Traverse the list of available components.
      * For each call their 'query' functions to determine relative priority.
@@ -72,6 +75,7 @@ int mca_base_select(const char *type_name, int output_id, opal_list_t *component
                             component->mca_component_name);
 
         rc = component->mca_query_component(&module, &priority);
+        OPAL_TIMING_ENV_NEXT(otmng, "%s_%s", type_name, component->mca_component_name);
         if (OPAL_ERR_FATAL == rc) {
             /* a fatal error was detected by this component - e.g., the
              * user specified a required element and the component could
@@ -0,0 +1,827 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal/mca/base/mca_base_event.h"
+#include "opal/mca/base/mca_base_vari.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "opal/class/opal_hash_table.h"
+#include "opal/class/opal_pointer_array.h"
+#include "opal/mca/threads/mutex.h"
+#include "opal/mca/threads/thread_usage.h"
+#include "opal/mca/timer/base/base.h"
+#include "opal/runtime/opal_progress.h"
+#include "opal/util/minmax.h"
+
+/* The instances recorded by a thread. The thread is the only one to move
+ * the head, the drain the only one to move the tail. */
+typedef struct mca_base_event_ring_t {
+    struct mca_base_event_ring_t *next;
+    opal_atomic_size_t head;
+    opal_atomic_size_t tail;
+    mca_base_event_instance_t slots[];
+} mca_base_event_ring_t;
+
+int mca_base_event_ring_size = 1024;
+
+static opal_hash_table_t mca_base_event_index_hash;
+static opal_pointer_array_t registered_events;
+static opal_pointer_array_t registered_sources;
+static bool mca_base_event_initialized = false;
+static int event_count = 0;
+static int source_count = 0;
+
+/* Serializes the drains and the changes to the handle lists */
+static opal_mutex_t mca_base_event_lock = OPAL_MUTEX_STATIC_INIT;
+
+/* The handles freed while a drain was running, released at its end */
+static opal_mutex_t mca_base_event_free_lock = OPAL_MUTEX_STATIC_INIT;
+static mca_base_event_registration_t *mca_base_event_freed_handles = NULL;
+
+/* Number of handles with a callback, the drain is a progress callback
+ * while it is not 0 */
+static int mca_base_event_active_handles = 0;
+
+static opal_atomic_intptr_t mca_base_event_rings = 0;
+static opal_atomic_int32_t mca_base_event_any_dropped = 0;
+static opal_thread_local mca_base_event_ring_t *mca_base_event_ring = NULL;
+
+static void mca_base_event_constructor(mca_base_event_t *event);
+static void mca_base_event_destructor(mca_base_event_t *event);
+OBJ_CLASS_INSTANCE(mca_base_event_t, opal_object_t, mca_base_event_constructor,
+                   mca_base_event_destructor);
+
+static void mca_base_event_source_constructor(mca_base_event_source_t *source);
+static void mca_base_event_source_destructor(mca_base_event_source_t *source);
+OBJ_CLASS_INSTANCE(mca_base_event_source_t, opal_object_t, mca_base_event_source_constructor,
+                   mca_base_event_source_destructor);
+
+static void mca_base_event_registration_constructor(mca_base_event_registration_t *registration);
+static void mca_base_event_registration_destructor(mca_base_event_registration_t *registration);
+OBJ_CLASS_INSTANCE(mca_base_event_registration_t, opal_list_item_t,
+                   mca_base_event_registration_constructor,
+                   mca_base_event_registration_destructor);
+
+static uint64_t mca_base_event_default_time(void)
+{
+    return (uint64_t) opal_timer_base_get_cycles();
+}
+
+static int mca_base_event_progress(void)
+{
+    return mca_base_event_drain();
+}
+
+int mca_base_event_init(void)
+{
+    mca_base_event_source_t *source;
+    int ret = OPAL_SUCCESS;
+
+    if (!mca_base_event_initialized) {
+        mca_base_event_initialized = true;
+
+        OBJ_CONSTRUCT(&registered_events, opal_pointer_array_t);
+        opal_pointer_array_init(&registered_events, 128, 2048, 128);
+
+        OBJ_CONSTRUCT(&registered_sources, opal_pointer_array_t);
+        opal_pointer_array_init(&registered_sources, 4, 64, 4);
+
+        OBJ_CONSTRUCT(&mca_base_event_index_hash, opal_hash_table_t);
+        ret = opal_hash_table_init(&mca_base_event_index_hash, 1024);
+        if (OPAL_SUCCESS != ret) {
+            mca_base_event_initialized = false;
+            OBJ_DESTRUCT(&registered_events);
+            OBJ_DESTRUCT(&registered_sources);
+            OBJ_DESTRUCT(&mca_base_event_index_hash);
+            return ret;
+        }
+
+        /* The default source of the timestamps. The rings of the threads
+         * are drained one after the other, so the instances of a source
+         * are not delivered in the order of their timestamps. */
+        source = OBJ_NEW(mca_base_event_source_t);
+        if (NULL == source) {
+            return OPAL_ERR_OUT_OF_RESOURCE;
+        }
+        source->name = strdup("opal_timer");
+        source->description = strdup("Cycle counter of the timer framework");
+        source->ordering = MCA_BASE_SOURCE_UNORDERED;
+        source->ticks_per_second = (uint64_t) opal_timer_base_get_freq();
+        source->max_ticks = UINT64_MAX;
+        source->get_time = mca_base_event_default_time;
+        source->source_index = opal_pointer_array_add(&registered_sources, source);
+        source_count = 1;
+    }
+
+    return ret;
+}
+
+int mca_base_event_finalize(void)
+{
+    mca_base_event_ring_t *ring, *next;
+    int i;
+
+    if (mca_base_event_initialized) {
+        mca_base_event_initialized = false;
+
+        if (0 < mca_base_event_active_handles) {
+            opal_progress_unregister(mca_base_event_progress);
+            mca_base_event_active_handles = 0;
+        }
+
+        for (i = 0; i < event_count; ++i) {
+            mca_base_event_t *event = opal_pointer_array_get_item(&registered_events, i);
+            if (event) {
+                OBJ_RELEASE(event);
+            }
+        }
+        for (i = 0; i < source_count; ++i) {
+            mca_base_event_source_t *source = opal_pointer_array_get_item(&registered_sources, i);
+            if (source) {
+                OBJ_RELEASE(source);
+            }
+        }
+
+        /* The rings of the threads still alive are lost with the pointers
+         * of their thread local storage, they are not reused */
+        for (ring = (mca_base_event_ring_t *) mca_base_event_rings; NULL != ring; ring = next) {
+            next = ring->next;
+            free(ring);
+        }
+        mca_base_event_rings = 0;
+        mca_base_event_ring = NULL;
+
+        event_count = 0;
+        source_count = 0;
+
+        OBJ_DESTRUCT(&registered_events);
+        OBJ_DESTRUCT(&registered_sources);
+        OBJ_DESTRUCT(&mca_base_event_index_hash);
+    }
+
+    return OPAL_SUCCESS;
+}
+
+static int mca_base_event_get_internal(int index, mca_base_event_t **event, bool invalidok)
+{
+    if (index < 0 || index >= event_count) {
+        return OPAL_ERR_VALUE_OUT_OF_BOUNDS;
+    }
+
+    *event = opal_pointer_array_get_item(&registered_events, index);
+
+    /* variables should never be removed per MPI 3.0 § 14.3.7 */
+    assert(*event);
+
+    if (((*event)->flags & MCA_BASE_EVENT_FLAG_INVALID) && !invalidok) {
+        *event = NULL;
+        return OPAL_ERR_NOT_FOUND;
+    }
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_get(int index, mca_base_event_t **event)
+{
+    return mca_base_event_get_internal(index, event, false);
+}
+
+int mca_base_event_get_count(int *count)
+{
+    *count = event_count;
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_find_by_name(const char *full_name, int *index)
+{
+    mca_base_event_t *event;
+    void *tmp;
+    int rc;
+
+    if (!mca_base_event_initialized) {
+        return OPAL_ERR_NOT_FOUND;
+    }
+
+    rc = opal_hash_table_get_value_ptr(&mca_base_event_index_hash, full_name, strlen(full_name),
+                                       &tmp);
+    if (OPAL_SUCCESS != rc) {
+        return rc;
+    }
+
+    rc = mca_base_event_get_internal((int) (uintptr_t) tmp, &event, false);
+    if (OPAL_SUCCESS != rc) {
+        return rc;
+    }
+
+    *index = (int) (uintptr_t) tmp;
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_source_get_count(int *count)
+{
+    *count = source_count;
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_source_get(int index, mca_base_event_source_t **source)
+{
+    if (index < 0 || index >= source_count) {
+        return OPAL_ERR_VALUE_OUT_OF_BOUNDS;
+    }
+
+    *source = opal_pointer_array_get_item(&registered_sources, index);
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_register(const char *project, const char *framework, const char *component,
+                            const char *name, const char *description,
+                            mca_base_var_info_lvl_t verbosity, const mca_base_var_type_t *types,
+                            const size_t *offsets, int num_elements,
+                            mca_base_var_enum_t *enumerator, int bind, mca_base_event_flag_t flags)
+{
+    mca_base_event_t *event;
+    int ret, group_index, event_index, i;
+    size_t extent = 0;
+    char *full_name;
+    void *tmp;
+
+    if (!mca_base_event_initialized) {
+        return OPAL_ERROR;
+    }
+
+    /* ensure the caller did not set an invalid flag */
+    assert(!(flags & 0x3f));
+
+    flags &= ~MCA_BASE_EVENT_FLAG_INVALID;
+
+    if (0 > num_elements || MCA_BASE_EVENT_MAX_ELEMENTS < num_elements) {
+        return OPAL_ERR_BAD_PARAM;
+    }
+    for (i = 0; i < num_elements; ++i) {
+        /* the strings of the variables are not copied with the data */
+        if (MCA_BASE_VAR_TYPE_STRING == types[i] || MCA_BASE_VAR_TYPE_VERSION_STRING == types[i]) {
+            return OPAL_ERR_BAD_PARAM;
+        }
+        extent = opal_max(extent, offsets[i] + ompi_var_type_sizes[types[i]]);
+    }
+    if (MCA_BASE_EVENT_MAX_DATA < extent) {
+        return OPAL_ERR_BAD_PARAM;
+    }
+
+    /* update this assert if more MPIT verbosity levels are added */
+    assert(verbosity >= OPAL_INFO_LVL_1 && verbosity <= OPAL_INFO_LVL_9);
+
+    ret = mca_base_var_generate_full_name4(NULL, framework, component, name, &full_name);
+    if (OPAL_SUCCESS != ret) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* check if this event is already registered */
+    ret = opal_hash_table_get_value_ptr(&mca_base_event_index_hash, full_name, strlen(full_name),
+                                        &tmp);
+    if (OPAL_SUCCESS == ret) {
+        free(full_name);
+        ret = mca_base_event_get_internal((int) (uintptr_t) tmp, &event, true);
+        if (OPAL_SUCCESS != ret) {
+            /* inconsistent internal state */
+            return OPAL_ERROR;
+        }
+
+        if (event->enumerator) {
+            OBJ_RELEASE(event->enumerator);
+        }
+    } else {
+        /* find/register an MCA parameter group for this event */
+        group_index = mca_base_var_group_register(project, framework, component, NULL);
+        if (-1 > group_index) {
+            free(full_name);
+            return group_index;
+        }
+
+        event = OBJ_NEW(mca_base_event_t);
+        if (NULL == event) {
+            free(full_name);
+            return OPAL_ERR_OUT_OF_RESOURCE;
+        }
+        event->name = full_name;
+
+        do {
+            if (NULL != description) {
+                event->description = strdup(description);
+                if (NULL == event->description) {
+                    ret = OPAL_ERR_OUT_OF_RESOURCE;
+                    break;
+                }
+            }
+
+            event_index = opal_pointer_array_add(&registered_events, event);
+            if (0 > event_index) {
+                ret = OPAL_ERR_OUT_OF_RESOURCE;
+                break;
+            }
+            event->event_index = event_index;
+
+            /* add this event to the MCA variable group */
+            if (0 <= group_index) {
+                ret = mca_base_var_group_add_event(group_index, event_index);
+                if (0 > ret) {
+                    break;
+                }
+            }
+
+            opal_hash_table_set_value_ptr(&mca_base_event_index_hash, event->name,
+                                          strlen(event->name),
+                                          (void *) (uintptr_t) event->event_index);
+
+            event_count++;
+            ret = OPAL_SUCCESS;
+        } while (0);
+
+        if (OPAL_SUCCESS != ret) {
+            OBJ_RELEASE(event);
+            return ret;
+        }
+
+        event->group_index = group_index;
+    }
+
+    event->verbosity = verbosity;
+    event->num_elements = num_elements;
+    for (i = 0; i < num_elements; ++i) {
+        event->types[i] = types[i];
+        event->offsets[i] = offsets[i];
+    }
+    event->extent = extent;
+    event->enumerator = enumerator;
+    if (enumerator) {
+        OBJ_RETAIN(enumerator);
+    }
+    event->bind = bind;
+    event->source_index = 0;
+    event->flags = flags;
+
+    return event->event_index;
+}
+
+int mca_base_component_event_register(const mca_base_component_t *component, const char *name,
+                                      const char *description, mca_base_var_info_lvl_t verbosity,
+                                      const mca_base_var_type_t *types, const size_t *offsets,
+                                      int num_elements, mca_base_var_enum_t *enumerator, int bind,
+                                      mca_base_event_flag_t flags)
+{
+    /* invalidate this event if the component's group is deregistered */
+    return mca_base_event_register(component->mca_project_name, component->mca_type_name,
+                                   component->mca_component_name, name, description, verbosity,
+                                   types, offsets, num_elements, enumerator, bind,
+                                   flags | MCA_BASE_EVENT_FLAG_IWG);
+}
+
+int mca_base_event_mark_invalid(int index)
+{
+    mca_base_event_t *event;
+    int ret;
+
+    ret = mca_base_event_get_internal(index, &event, false);
+    if (OPAL_SUCCESS != ret) {
+        return ret;
+    }
+
+    /* the recorded instances are still delivered, no new one is taken */
+    event->flags |= MCA_BASE_EVENT_FLAG_INVALID;
+    event->active = 0;
+
+    return OPAL_SUCCESS;
+}
+
+/* Handle functions */
+
+static bool mca_base_event_has_callback(const mca_base_event_registration_t *registration)
+{
+    for (int i = 0; i < MCA_BASE_CB_SAFETY_MAX; ++i) {
+        if (NULL != registration->callbacks[i].cb) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Accounts a handle gaining (1) or losing (-1) its callbacks, with the
+ * event lock held */
+static void mca_base_event_update_active(mca_base_event_registration_t *registration, int delta)
+{
+    mca_base_event_t *event = registration->event;
+
+    if (!(event->flags & MCA_BASE_EVENT_FLAG_INVALID)) {
+        opal_atomic_add_fetch_32(&event->active, delta);
+    }
+
+    mca_base_event_active_handles += delta;
+    if (1 == delta && 1 == mca_base_event_active_handles) {
+        opal_progress_register_lp(mca_base_event_progress);
+    } else if (-1 == delta && 0 == mca_base_event_active_handles) {
+        opal_progress_unregister(mca_base_event_progress);
+    }
+}
+
+static int mca_base_event_info_dup(opal_info_t *info, opal_info_t **newinfo)
+{
+    *newinfo = OBJ_NEW(opal_info_t);
+    if (NULL == *newinfo) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    return opal_info_dup(info, newinfo);
+}
+
+int mca_base_event_handle_alloc(mca_base_event_t *event, void *obj_handle, opal_info_t *info,
+                                mca_base_event_registration_t **registration)
+{
+    mca_base_event_registration_t *new_registration;
+    int ret;
+
+    if (event->flags & MCA_BASE_EVENT_FLAG_INVALID) {
+        return OPAL_ERR_NOT_FOUND;
+    }
+
+    if (MCA_BASE_VAR_BIND_NO_OBJECT == event->bind) {
+        /* ignore binding object */
+        obj_handle = NULL;
+    } else if (NULL == obj_handle) {
+        return OPAL_ERR_BAD_PARAM;
+    }
+
+    new_registration = OBJ_NEW(mca_base_event_registration_t);
+    if (NULL == new_registration) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    if (NULL != info) {
+        ret = mca_base_event_info_dup(info, &new_registration->info);
+        if (OPAL_SUCCESS != ret) {
+            OBJ_RELEASE(new_registration);
+            return ret;
+        }
+    }
+
+    new_registration->event = event;
+    new_registration->obj_handle = (NULL == obj_handle ? NULL : *(void **) obj_handle);
+
+    opal_mutex_lock(&mca_base_event_lock);
+    opal_list_append(&event->bound_handles, &new_registration->super);
+    opal_mutex_unlock(&mca_base_event_lock);
+
+    *registration = new_registration;
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_register_callback(mca_base_event_registration_t *registration,
+                                     mca_base_cb_safety_t cb_safety, opal_info_t *info,
+                                     void *user_data, mca_base_event_cb_fn_t cb)
+{
+    mca_base_event_callback_t *callback;
+    opal_info_t *new_info = NULL;
+    bool had_callback;
+    int ret;
+
+    if (cb_safety < MCA_BASE_CB_REQUIRE_NONE || cb_safety >= MCA_BASE_CB_SAFETY_MAX) {
+        return OPAL_ERR_BAD_PARAM;
+    }
+
+    if (NULL != info) {
+        ret = mca_base_event_info_dup(info, &new_info);
+        if (OPAL_SUCCESS != ret) {
+            return ret;
+        }
+    }
+
+    opal_mutex_lock(&mca_base_event_lock);
+
+    had_callback = mca_base_event_has_callback(registration);
+
+    callback = &registration->callbacks[cb_safety];
+    if (NULL != callback->info) {
+        OBJ_RELEASE(callback->info);
+    }
+    callback->cb = cb;
+    callback->user_data = user_data;
+    callback->info = new_info;
+
+    if (!registration->freed) {
+        if (!had_callback && NULL != cb) {
+            mca_base_event_update_active(registration, 1);
+        } else if (had_callback && !mca_base_event_has_callback(registration)) {
+            mca_base_event_update_active(registration, -1);
+        }
+    }
+
+    opal_mutex_unlock(&mca_base_event_lock);
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_set_dropped_handler(mca_base_event_registration_t *registration,
+                                       mca_base_event_dropped_cb_fn_t dropped_cb)
+{
+    registration->dropped_cb = dropped_cb;
+    return OPAL_SUCCESS;
+}
+
+static void mca_base_event_handle_release(mca_base_event_registration_t *registration)
+{
+    opal_list_remove_item(&registration->event->bound_handles, &registration->super);
+
+    if (NULL != registration->free_cb) {
+        registration->free_cb(registration, MCA_BASE_CB_REQUIRE_NONE,
+                              registration->free_user_data);
+    }
+
+    OBJ_RELEASE(registration);
+}
+
+int mca_base_event_handle_free(mca_base_event_registration_t *registration, void *user_data,
+                               mca_base_event_free_cb_fn_t free_cb)
+{
+    bool locked;
+
+    /* The drain may be running, possibly on this thread from a callback
+     * of the handle: the handle is then released at the end of the drain */
+    locked = (0 == opal_mutex_trylock(&mca_base_event_lock));
+
+    opal_mutex_lock(&mca_base_event_free_lock);
+    if (!registration->freed) {
+        registration->freed = true;
+        registration->free_cb = free_cb;
+        registration->free_user_data = user_data;
+        if (mca_base_event_has_callback(registration)) {
+            if (locked) {
+                mca_base_event_update_active(registration, -1);
+            } else {
+                /* stop the recording now, the progress callback is
+                 * dropped by the drain */
+                opal_atomic_add_fetch_32(&registration->event->active, -1);
+            }
+        }
+        if (!locked) {
+            registration->next_freed = mca_base_event_freed_handles;
+            mca_base_event_freed_handles = registration;
+        }
+    }
+    opal_mutex_unlock(&mca_base_event_free_lock);
+
+    if (locked) {
+        mca_base_event_handle_release(registration);
+        opal_mutex_unlock(&mca_base_event_lock);
+    }
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_read(const mca_base_event_instance_t *instance, int element_index,
+                        void *buffer)
+{
+    const mca_base_event_t *event = instance->event;
+
+    if (element_index < 0 || element_index >= event->num_elements) {
+        return OPAL_ERR_VALUE_OUT_OF_BOUNDS;
+    }
+
+    memcpy(buffer, instance->data + event->offsets[element_index],
+           ompi_var_type_sizes[event->types[element_index]]);
+
+    return OPAL_SUCCESS;
+}
+
+/* Recording and delivery */
+
+static mca_base_event_ring_t *mca_base_event_ring_create(void)
+{
+    mca_base_event_ring_t *ring;
+    intptr_t head;
+
+    ring = (mca_base_event_ring_t *) calloc(1, sizeof(*ring) + mca_base_event_ring_size
+                                                                   * sizeof(ring->slots[0]));
+    if (NULL == ring) {
+        return NULL;
+    }
+
+    head = mca_base_event_rings;
+    do {
+        ring->next = (mca_base_event_ring_t *) head;
+    } while (!opal_atomic_compare_exchange_strong_ptr(&mca_base_event_rings, &head,
+                                                      (intptr_t) ring));
+
+    mca_base_event_ring = ring;
+
+    return ring;
+}
+
+void mca_base_event_record(mca_base_event_t *event, void *obj, const void *data)
+{
+    mca_base_event_ring_t *ring = mca_base_event_ring;
+    mca_base_event_instance_t *instance;
+    size_t head;
+
+    if (OPAL_UNLIKELY(NULL == ring)) {
+        ring = mca_base_event_ring_create();
+        if (NULL == ring) {
+            return;
+        }
+    }
+
+    head = ring->head;
+    if (OPAL_UNLIKELY(head - ring->tail >= (size_t) mca_base_event_ring_size)) {
+        opal_atomic_add_fetch_size_t(&event->dropped, 1);
+        mca_base_event_any_dropped = 1;
+        return;
+    }
+
+    instance = &ring->slots[head % mca_base_event_ring_size];
+    instance->event = event;
+    instance->obj = obj;
+    instance->timestamp = mca_base_event_default_time();
+    memcpy(instance->data, data, event->extent);
+
+    /* the drain must see the instance before the new head */
+    opal_atomic_wmb();
+    ring->head = head + 1;
+}
+
+/* The lowest safety level a callback was registered with, the drain runs
+ * outside of the locks of the components with the drains serialized, so
+ * each of them can be called */
+static int mca_base_event_pick_callback(const mca_base_event_registration_t *registration)
+{
+    for (int i = 0; i < MCA_BASE_CB_SAFETY_MAX; ++i) {
+        if (NULL != registration->callbacks[i].cb) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void mca_base_event_deliver(mca_base_event_instance_t *instance)
+{
+    mca_base_event_registration_t *registration;
+    mca_base_event_t *event = instance->event;
+    int level;
+
+    OPAL_LIST_FOREACH (registration, &event->bound_handles, mca_base_event_registration_t) {
+        if (registration->freed) {
+            continue;
+        }
+        if (MCA_BASE_VAR_BIND_NO_OBJECT != event->bind
+            && registration->obj_handle != instance->obj) {
+            continue;
+        }
+        level = mca_base_event_pick_callback(registration);
+        if (0 > level) {
+            continue;
+        }
+        registration->callbacks[level].cb(instance, registration, (mca_base_cb_safety_t) level,
+                                          registration->callbacks[level].user_data);
+    }
+}
+
+static void mca_base_event_report_dropped(void)
+{
+    mca_base_event_registration_t *registration;
+    size_t dropped;
+    int i, level;
+
+    mca_base_event_any_dropped = 0;
+    opal_atomic_mb();
+
+    for (i = 0; i < event_count; ++i) {
+        mca_base_event_t *event = opal_pointer_array_get_item(&registered_events, i);
+        if (NULL == event || 0 == event->dropped) {
+            continue;
+        }
+
+        /* the rings may keep dropping while the count is reported */
+        dropped = event->dropped;
+        opal_atomic_add_fetch_size_t(&event->dropped, -dropped);
+
+        /* the object of the lost instances is unknown, all the handles of
+         * the event are told */
+        OPAL_LIST_FOREACH (registration, &event->bound_handles, mca_base_event_registration_t) {
+            if (registration->freed || NULL == registration->dropped_cb) {
+                continue;
+            }
+            level = mca_base_event_pick_callback(registration);
+            registration->dropped_cb(dropped, registration, event->source_index,
+                                     (mca_base_cb_safety_t) opal_max(level, 0),
+                                     (0 <= level) ? registration->callbacks[level].user_data
+                                                  : NULL);
+        }
+    }
+}
+
+int mca_base_event_drain(void)
+{
+    mca_base_event_registration_t *registration;
+    mca_base_event_ring_t *ring;
+    int delivered = 0;
+    size_t head, tail;
+
+    if (0 != opal_mutex_trylock(&mca_base_event_lock)) {
+        return 0;
+    }
+
+    for (ring = (mca_base_event_ring_t *) mca_base_event_rings; NULL != ring; ring = ring->next) {
+        head = ring->head;
+        opal_atomic_rmb();
+        for (tail = ring->tail; tail != head; ++tail) {
+            mca_base_event_deliver(&ring->slots[tail % mca_base_event_ring_size]);
+            /* the slot can be reused once it has been delivered */
+            opal_atomic_wmb();
+            ring->tail = tail + 1;
+            ++delivered;
+        }
+    }
+
+    if (mca_base_event_any_dropped) {
+        mca_base_event_report_dropped();
+    }
+
+    /* release the handles freed during the drain */
+    opal_mutex_lock(&mca_base_event_free_lock);
+    while (NULL != (registration = mca_base_event_freed_handles)) {
+        mca_base_event_freed_handles = registration->next_freed;
+        if (mca_base_event_has_callback(registration)) {
+            /* the event stopped recording when the handle was freed */
+            mca_base_event_active_handles--;
+            if (0 == mca_base_event_active_handles) {
+                opal_progress_unregister(mca_base_event_progress);
+            }
+        }
+        mca_base_event_handle_release(registration);
+    }
+    opal_mutex_unlock(&mca_base_event_free_lock);
+
+    opal_mutex_unlock(&mca_base_event_lock);
+
+    return delivered;
+}
+
+/* Object constructors/destructors */
+
+static void mca_base_event_constructor(mca_base_event_t *event)
+{
+    memset((char *) event + sizeof(event->super), 0, sizeof(*event) - sizeof(event->super));
+    OBJ_CONSTRUCT(&event->bound_handles, opal_list_t);
+}
+
+static void mca_base_event_destructor(mca_base_event_t *event)
+{
+    free(event->name);
+    free(event->description);
+
+    if (NULL != event->enumerator) {
+        OBJ_RELEASE(event->enumerator);
+    }
+
+    OPAL_LIST_DESTRUCT(&event->bound_handles);
+}
+
+static void mca_base_event_source_constructor(mca_base_event_source_t *source)
+{
+    memset((char *) source + sizeof(source->super), 0, sizeof(*source) - sizeof(source->super));
+}
+
+static void mca_base_event_source_destructor(mca_base_event_source_t *source)
+{
+    free(source->name);
+    free(source->description);
+}
+
+static void mca_base_event_registration_constructor(mca_base_event_registration_t *registration)
+{
+    memset((char *) registration + sizeof(registration->super), 0,
+           sizeof(*registration) - sizeof(registration->super));
+}
+
+static void mca_base_event_registration_destructor(mca_base_event_registration_t *registration)
+{
+    for (int i = 0; i < MCA_BASE_CB_SAFETY_MAX; ++i) {
+        if (NULL != registration->callbacks[i].info) {
+            OBJ_RELEASE(registration->callbacks[i].info);
+        }
+    }
+    if (NULL != registration->info) {
+        OBJ_RELEASE(registration->info);
+    }
+}
@@ -0,0 +1,382 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * MCA events, the back-end of the MPI_T event interface.
+ *
+ * An event describes a fixed layout of elements raised by a component
+ * every time something happens in it (a rendezvous starts, a collective
+ * algorithm is selected, ...). Raising an event that nobody listens to
+ * costs a load and a branch. Once a tool has registered a callback on a
+ * handle of the event, every instance is stamped and copied in a ring
+ * buffer owned by the raising thread, without a lock or a call into the
+ * tool. The rings are drained from the progress engine: each instance is
+ * handed to the callbacks of the handles bound to its object, and the
+ * instances lost to a full ring are reported to the dropped handlers.
+ */
+
+#if !defined(OPAL_MCA_BASE_EVENT_H)
+#    define OPAL_MCA_BASE_EVENT_H
+
+#    include "opal/class/opal_list.h"
+#    include "opal/mca/base/mca_base_pvar.h"
+#    include "opal/mca/base/mca_base_var.h"
+#    include "opal/prefetch.h"
+#    include "opal/sys/atomic.h"
+#    include "opal/util/info.h"
+
+BEGIN_C_DECLS
+
+/*
+ * These flags are used when registering a new event.
+ */
+typedef enum {
+    /** Invalidate the event when its group is deregistered (IWG =
+        "invalidate with group"). Set automatically when the event is
+        registered with mca_base_component_event_register(). */
+    MCA_BASE_EVENT_FLAG_IWG = 0x040,
+    /** The event has been invalidated. Can not be passed to
+        mca_base_event_register(). */
+    MCA_BASE_EVENT_FLAG_INVALID = 0x400,
+} mca_base_event_flag_t;
+
+/*
+ * Callback safety levels, in the order of the MPI_T_cb_safety values.
+ */
+typedef enum {
+    MCA_BASE_CB_REQUIRE_NONE,
+    MCA_BASE_CB_REQUIRE_MPI_RESTRICTED,
+    MCA_BASE_CB_REQUIRE_THREAD_SAFE,
+    MCA_BASE_CB_REQUIRE_ASYNC_SIGNAL_SAFE,
+    MCA_BASE_CB_SAFETY_MAX
+} mca_base_cb_safety_t;
+
+/*
+ * Ordering of the timestamps of a source, in the order of the
+ * MPI_T_source_order values.
+ */
+typedef enum {
+    MCA_BASE_SOURCE_ORDERED,
+    MCA_BASE_SOURCE_UNORDERED
+} mca_base_source_order_t;
+
+/** Largest data of an event, the elements must fit in the ring slots */
+#    define MCA_BASE_EVENT_MAX_DATA 64
+
+/** Most elements of an event */
+#    define MCA_BASE_EVENT_MAX_ELEMENTS 16
+
+struct mca_base_event_t;
+struct mca_base_event_instance_t;
+struct mca_base_event_registration_t;
+
+typedef void (*mca_base_event_cb_fn_t)(struct mca_base_event_instance_t *instance,
+                                       struct mca_base_event_registration_t *registration,
+                                       mca_base_cb_safety_t cb_safety, void *user_data);
+
+typedef void (*mca_base_event_dropped_cb_fn_t)(size_t count,
+                                               struct mca_base_event_registration_t *registration,
+                                               int source_index, mca_base_cb_safety_t cb_safety,
+                                               void *user_data);
+
+typedef void (*mca_base_event_free_cb_fn_t)(struct mca_base_event_registration_t *registration,
+                                            mca_base_cb_safety_t cb_safety, void *user_data);
+
+/** Timestamp source of the events */
+typedef struct mca_base_event_source_t {
+    opal_object_t super;
+
+    /** Index of this source */
+    int source_index;
+
+    /** Full name of the source */
+    char *name;
+
+    /** Description of the source */
+    char *description;
+
+    /** Whether the timestamps of the source are in the order of the events */
+    mca_base_source_order_t ordering;
+
+    /** Ticks of the timestamps per second */
+    uint64_t ticks_per_second;
+
+    /** Largest timestamp before it wraps around */
+    uint64_t max_ticks;
+
+    /** Current time of the source */
+    uint64_t (*get_time)(void);
+} mca_base_event_source_t;
+OBJ_CLASS_DECLARATION(mca_base_event_source_t);
+
+typedef struct mca_base_event_t {
+    opal_object_t super;
+
+    /** Index of this event */
+    int event_index;
+
+    /** Full name of the event */
+    char *name;
+
+    /** Description of the event */
+    char *description;
+
+    /** MCA variable group this event belongs to */
+    int group_index;
+
+    /** Verbosity level of the event */
+    mca_base_var_info_lvl_t verbosity;
+
+    /** Types of the elements */
+    mca_base_var_type_t types[MCA_BASE_EVENT_MAX_ELEMENTS];
+
+    /** Offsets of the elements in the data of the event */
+    size_t offsets[MCA_BASE_EVENT_MAX_ELEMENTS];
+
+    /** Number of elements */
+    int num_elements;
+
+    /** Size of the data of the event */
+    size_t extent;
+
+    /** Enumerator for the values of the first element (NULL if none) */
+    mca_base_var_enum_t *enumerator;
+
+    /** Type of object this event is bound to */
+    int bind;
+
+    /** Source of the timestamps of the instances */
+    int source_index;
+
+    /** Flags for this event */
+    mca_base_event_flag_t flags;
+
+    /** Number of handles with at least one callback. The event is only
+        recorded while it is not 0. */
+    opal_atomic_int32_t active;
+
+    /** Number of instances lost to full rings since the last drain */
+    opal_atomic_size_t dropped;
+
+    /** Handles bound to this event */
+    opal_list_t bound_handles;
+} mca_base_event_t;
+OBJ_CLASS_DECLARATION(mca_base_event_t);
+
+/** A recorded event, as handed to the callbacks */
+typedef struct mca_base_event_instance_t {
+    mca_base_event_t *event;
+    void *obj;
+    uint64_t timestamp;
+    unsigned char data[MCA_BASE_EVENT_MAX_DATA];
+} mca_base_event_instance_t;
+
+typedef struct mca_base_event_callback_t {
+    mca_base_event_cb_fn_t cb;
+    void *user_data;
+    opal_info_t *info;
+} mca_base_event_callback_t;
+
+typedef struct mca_base_event_registration_t {
+    opal_list_item_t super;
+
+    /** Event this handle is bound to */
+    mca_base_event_t *event;
+
+    /** Object the instances must be raised on (ignored for unbound events) */
+    void *obj_handle;
+
+    /** Info of the handle */
+    opal_info_t *info;
+
+    /** Callbacks for each safety level */
+    mca_base_event_callback_t callbacks[MCA_BASE_CB_SAFETY_MAX];
+
+    /** Handler of the lost events */
+    mca_base_event_dropped_cb_fn_t dropped_cb;
+
+    /** The handle is being freed, its callbacks are not called anymore */
+    bool freed;
+
+    /** Callback to call once the handle is freed */
+    mca_base_event_free_cb_fn_t free_cb;
+    void *free_user_data;
+
+    /** Next handle waiting for the end of a drain to be released */
+    struct mca_base_event_registration_t *next_freed;
+} mca_base_event_registration_t;
+OBJ_CLASS_DECLARATION(mca_base_event_registration_t);
+
+/**
+ * Register an event
+ *
+ * @param[in] project      Project name
+ * @param[in] framework    Framework name
+ * @param[in] component    Component name
+ * @param[in] name         Event name
+ * @param[in] description  Description of the event
+ * @param[in] verbosity    Verbosity level of the event
+ * @param[in] types        Types of the elements
+ * @param[in] offsets      Offsets of the elements in the data of the event
+ * @param[in] num_elements Number of elements
+ * @param[in] enumerator   Enumerator for the first element (may be NULL)
+ * @param[in] bind         Object type the event is bound to
+ * @param[in] flags        Flags for this event
+ *
+ * @returns index On success returns the index of this event.
+ * @returns OPAL_ERR_BAD_PARAM if the elements do not fit in
+ * MCA_BASE_EVENT_MAX_DATA bytes.
+ *
+ * The data passed to mca_base_event_raise() is laid out as described
+ * by the types and offsets, usually a structure the offsets are taken
+ * from with offsetof(). The instances are timestamped with the default
+ * source, an unordered source on the cycle counter of the timer
+ * framework.
+ */
+OPAL_DECLSPEC int mca_base_event_register(const char *project, const char *framework,
+                                          const char *component, const char *name,
+                                          const char *description,
+                                          mca_base_var_info_lvl_t verbosity,
+                                          const mca_base_var_type_t *types, const size_t *offsets,
+                                          int num_elements, mca_base_var_enum_t *enumerator,
+                                          int bind, mca_base_event_flag_t flags);
+
+/**
+ * Convenience function for registering an event associated with a
+ * component. The event is invalidated with the group of the component.
+ */
+OPAL_DECLSPEC int mca_base_component_event_register(const mca_base_component_t *component,
+                                                    const char *name, const char *description,
+                                                    mca_base_var_info_lvl_t verbosity,
+                                                    const mca_base_var_type_t *types,
+                                                    const size_t *offsets, int num_elements,
+                                                    mca_base_var_enum_t *enumerator, int bind,
+                                                    mca_base_event_flag_t flags);
+
+/**
+ * Find the index of an event from its full name
+ *
+ * @param[in]  full_name Full name of the event
+ * @param[out] index     Index of the event
+ */
+OPAL_DECLSPEC int mca_base_event_find_by_name(const char *full_name, int *index);
+
+/**
+ * Return the number of registered events
+ */
+OPAL_DECLSPEC int mca_base_event_get_count(int *count);
+
+/**
+ * Get the event at an index
+ *
+ * @returns OPAL_ERR_VALUE_OUT_OF_BOUNDS if index is out of range
+ * @returns OPAL_ERR_NOT_FOUND if the event has been invalidated
+ */
+OPAL_DECLSPEC int mca_base_event_get(int index, mca_base_event_t **event);
+
+/**
+ * Mark an event as invalid, it will not be recorded anymore
+ */
+OPAL_DECLSPEC int mca_base_event_mark_invalid(int index);
+
+/**
+ * Return the number of timestamp sources
+ */
+OPAL_DECLSPEC int mca_base_event_source_get_count(int *count);
+
+/**
+ * Get the source at an index
+ */
+OPAL_DECLSPEC int mca_base_event_source_get(int index, mca_base_event_source_t **source);
+
+/* Handle functions */
+
+/**
+ * Allocate a handle on an event, bound to an object
+ *
+ * @param[in]  event         Event to bind the handle to
+ * @param[in]  obj_handle    Pointer to the object of the instances to be
+ *                           delivered (ignored for unbound events)
+ * @param[in]  info          Info of the handle (may be NULL, duplicated)
+ * @param[out] registration  New handle
+ *
+ * Unlike mca_base_event_handle_free(), this function and
+ * mca_base_event_register_callback() must not be called from an event
+ * callback: they wait for the end of the drain.
+ */
+OPAL_DECLSPEC int mca_base_event_handle_alloc(mca_base_event_t *event, void *obj_handle,
+                                              opal_info_t *info,
+                                              mca_base_event_registration_t **registration);
+
+/**
+ * Set or clear (cb = NULL) the callback of a handle for a safety level
+ */
+OPAL_DECLSPEC int mca_base_event_register_callback(mca_base_event_registration_t *registration,
+                                                   mca_base_cb_safety_t cb_safety,
+                                                   opal_info_t *info, void *user_data,
+                                                   mca_base_event_cb_fn_t cb);
+
+/**
+ * Set the handler of the lost instances of a handle
+ */
+OPAL_DECLSPEC int mca_base_event_set_dropped_handler(mca_base_event_registration_t *registration,
+                                                     mca_base_event_dropped_cb_fn_t dropped_cb);
+
+/**
+ * Free a handle
+ *
+ * The handle is released once no drain can call it anymore, free_cb is
+ * then called (if not NULL) with user_data. The callbacks of the handle
+ * may call this function.
+ */
+OPAL_DECLSPEC int mca_base_event_handle_free(mca_base_event_registration_t *registration,
+                                             void *user_data, mca_base_event_free_cb_fn_t free_cb);
+
+/**
+ * Copy an element of an instance to a buffer
+ */
+OPAL_DECLSPEC int mca_base_event_read(const mca_base_event_instance_t *instance,
+                                      int element_index, void *buffer);
+
+/**
+ * Record an instance in the ring of the calling thread (internal)
+ */
+OPAL_DECLSPEC void mca_base_event_record(mca_base_event_t *event, void *obj, const void *data);
+
+/**
+ * Deliver the recorded instances to the callbacks
+ *
+ * Called from the progress engine while events are active and from
+ * MPI_T_finalize. Only one thread drains at a time, the others return.
+ */
+OPAL_DECLSPEC int mca_base_event_drain(void);
+
+/**
+ * Raise an event
+ *
+ * @param[in] event  Event (may be NULL if the registration failed)
+ * @param[in] obj    Object the event happened on (NULL if unbound)
+ * @param[in] data   Data laid out as registered
+ */
+static inline void mca_base_event_raise(mca_base_event_t *event, void *obj, const void *data)
+{
+    if (OPAL_LIKELY(NULL == event || 0 == event->active)) {
+        return;
+    }
+    mca_base_event_record(event, obj, data);
+}
+
+END_C_DECLS
+
+#endif /* OPAL_MCA_BASE_EVENT_H */
@@ -19,6 +19,7 @@
 #include "opal/include/opal/constants.h"
 #include "opal/util/output.h"
 #include "opal/util/printf.h"
+#include "opal/util/timings.h"
 
 #include "mca_base_framework.h"
 #include "mca_base_var.h"
@@ -163,6 +164,8 @@ int mca_base_framework_open(struct mca_base_framework_t *framework, mca_base_ope
 
     assert(NULL != framework);
 
+    OPAL_TIMING_ENV_INIT(otmng);
+
     /* register this framework before opening it */
     ret = mca_base_framework_register(framework, MCA_BASE_REGISTER_DEFAULT);
     if (OPAL_SUCCESS != ret) {
@@ -201,6 +204,8 @@ int mca_base_framework_open(struct mca_base_framework_t *framework, mca_base_ope
         framework->framework_flags |= MCA_BASE_FRAMEWORK_FLAG_OPEN;
     }
 
+    OPAL_TIMING_ENV_NEXT(otmng, "%s_%s", framework->framework_project, framework->framework_name);
+
     return ret;
 }
 
@@ -38,6 +38,7 @@
 #include "opal/constants.h"
 #include "opal/mca/base/base.h"
 #include "opal/mca/base/mca_base_component_repository.h"
+#include "opal/mca/base/mca_base_vari.h"
 #include "opal/mca/installdirs/installdirs.h"
 #include "opal/mca/mca.h"
 #include "opal/runtime/opal.h"
@@ -129,6 +130,17 @@ int mca_base_open(void)
     (void) mca_base_var_register_synonym(var_id, "opal", "mca", NULL, "component_disable_dlopen",
                                          MCA_BASE_VAR_SYN_FLAG_DEPRECATED);
 
+    mca_base_event_ring_size = 1024;
+    (void) mca_base_var_register("opal", "mca", "base", "event_ring_size",
+                                 "Number of MPI_T event instances each thread can record before "
+                                 "they are delivered by the progress engine, the instances raised "
+                                 "on a full ring are reported as dropped (default: 1024)",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &mca_base_event_ring_size);
+    if (mca_base_event_ring_size < 1) {
+        mca_base_event_ring_size = 1;
+    }
+
     /* What verbosity level do we want for the default 0 stream? */
     char *str = getenv("OPAL_OUTPUT_INTERNAL_TO_STDOUT");
     if (NULL != str && str[0] == '1') {
@@ -140,6 +140,13 @@ OPAL_DECLSPEC int mca_base_var_group_add_var(const int group_index, const int pa
  */
 OPAL_DECLSPEC int mca_base_var_group_add_pvar(const int group_index, const int param_index);
 
+/**
+ * \internal
+ *
+ * Add an event to a group
+ */
+OPAL_DECLSPEC int mca_base_var_group_add_event(const int group_index, const int event_index);
+
 /**
  * \internal
  *
@@ -179,6 +186,21 @@ OPAL_DECLSPEC int mca_base_var_group_finalize(void);
 OPAL_DECLSPEC int mca_base_pvar_init(void);
 OPAL_DECLSPEC int mca_base_pvar_finalize(void);
 
+/**
+ * \internal
+ *
+ * Initialize/finalize MCA events
+ */
+OPAL_DECLSPEC int mca_base_event_init(void);
+OPAL_DECLSPEC int mca_base_event_finalize(void);
+
+/**
+ * \internal
+ *
+ * Number of instances each thread can record between two drains
+ */
+OPAL_DECLSPEC extern int mca_base_event_ring_size;
+
 END_C_DECLS
 
 #endif /* OPAL_MCA_BASE_VAR_INTERNAL_H */
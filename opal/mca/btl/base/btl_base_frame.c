@@ -58,6 +58,7 @@ mca_base_var_enum_value_flag_t mca_btl_base_flag_enum_flags[]
        {MCA_BTL_FLAGS_PUT_AM, "put-am", MCA_BTL_FLAGS_PUT},
        {MCA_BTL_FLAGS_GET_AM, "get_am", MCA_BTL_FLAGS_GET},
        {MCA_BTL_FLAGS_ATOMIC_AM_FOP, "atomic-am", MCA_BTL_FLAGS_ATOMIC_FOPS},
+       {MCA_BTL_FLAGS_TAG_MATCHING, "tag-matching", 0},
        {0, NULL, 0}};
 
 mca_base_var_enum_value_flag_t mca_btl_base_atomic_enum_flags[]
@@ -212,6 +212,10 @@ int mca_btl_base_param_verify(mca_btl_base_module_t *module)
         module->btl_flags &= ~MCA_BTL_FLAGS_ATOMIC_OPS;
     }
 
+    if (NULL == module->btl_tm_send || NULL == module->btl_tm_post || NULL == module->btl_tm_cancel) {
+        module->btl_flags &= ~MCA_BTL_FLAGS_TAG_MATCHING;
+    }
+
     if (0 == module->btl_get_limit) {
         module->btl_get_limit = SIZE_MAX;
     }
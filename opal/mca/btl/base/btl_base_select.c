@@ -35,6 +35,7 @@
 #include "opal/util/argv.h"
 #include "opal/util/output.h"
 #include "opal/util/show_help.h"
+#include "opal/util/timings.h"
 
 OBJ_CLASS_INSTANCE(mca_btl_base_selected_module_t, opal_list_item_t, NULL, NULL);
 
@@ -57,6 +58,8 @@ int mca_btl_base_select(bool enable_progress_threads, bool enable_mpi_threads)
     char **include = opal_argv_split(mca_btl_base_include, ',');
     char **exclude = opal_argv_split(mca_btl_base_exclude, ',');
 
+    OPAL_TIMING_ENV_INIT(otmng);
+
     /* Traverse the list of opened modules; call their init
        functions. */
 
@@ -106,6 +109,7 @@ int mca_btl_base_select(bool enable_progress_threads, bool enable_mpi_threads)
                                 component->btl_version.mca_component_name);
         } else {
             modules = component->btl_init(&num_btls, enable_progress_threads, enable_mpi_threads);
+            OPAL_TIMING_ENV_NEXT(otmng, "btl_%s", component->btl_version.mca_component_name);
 
             /* If the component didn't initialize, remove it from the opened
                list and remove it from the component repository */
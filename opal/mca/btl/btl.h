@@ -175,6 +175,7 @@ typedef uint8_t mca_btl_base_tag_t;
  * header file associated with the framework.
  */
 #define MCA_BTL_AM_FRAMEWORK_MASK 0xD0
+#define MCA_BTL_TAG_BML           0x08
 #define MCA_BTL_TAG_BTL_BASE      0x10
 #define MCA_BTL_TAG_BTL           0x20
 #if OPAL_ENABLE_FT_MPI
@@ -261,6 +262,10 @@ typedef uint8_t mca_btl_base_tag_t;
 /* The BTL has active-message based atomics */
 #define MCA_BTL_FLAGS_ATOMIC_AM_FOP 0x400000
 
+/* The BTL can match tagged sends against posted receives in the network
+ * (btl_tm_send, btl_tm_post, btl_tm_cancel) */
+#define MCA_BTL_FLAGS_TAG_MATCHING 0x800000
+
 /* Default exclusivity levels */
 #define MCA_BTL_EXCLUSIVITY_HIGH    (64 * 1024) /* internal loopback */
 #define MCA_BTL_EXCLUSIVITY_DEFAULT 1024 /* GM/IB/etc. */
@@ -1152,6 +1157,104 @@ typedef void (*mca_btl_base_module_dump_fn_t)(struct mca_btl_base_module_t *btl,
 typedef int (*mca_btl_base_module_flush_fn_t)(struct mca_btl_base_module_t *btl,
                                               struct mca_btl_base_endpoint_t *endpoint);
 
+/**
+ * Tag matching completion callback
+ *
+ * @param[in] btl          BTL module
+ * @param[in] endpoint     BTL endpoint the message came from
+ * @param[in] header       Header of the message (see btl_tm_send)
+ * @param[in] header_size  Size of the header
+ * @param[in] length       Size of the payload sent, only the posted size was
+ *                         written if larger
+ * @param[in] cbcontext    Callback context
+ * @param[in] cbdata       Callback data
+ * @param[in] status       OPAL_SUCCESS or error code
+ *
+ * The header is only valid during the callback, which may modify it. The
+ * callback is never called from btl_tm_post or btl_tm_cancel.
+ */
+typedef void (*mca_btl_base_tm_completion_fn_t)(struct mca_btl_base_module_t *btl,
+                                                struct mca_btl_base_endpoint_t *endpoint,
+                                                const void *header, size_t header_size,
+                                                size_t length, void *cbcontext, void *cbdata,
+                                                int status);
+
+/**
+ * Initiate an asynchronous send matched by the network.
+ *
+ * Same as btl_send, the first header_size bytes of the first segment of the
+ * descriptor being a header and the rest the payload. If a receive posted
+ * on the peer with btl_tm_post matches tm_tag, the payload is written in the
+ * posted buffer and the header is passed to its completion callback.
+ * Otherwise the message is delivered to the receive callback of tag, as if
+ * sent with btl_send.
+ *
+ * The tagged and the other sends to an endpoint are delivered in order: the
+ * receive callbacks and the matching completions of the messages of an
+ * endpoint are called in the order of the sends.
+ *
+ * @param btl (IN)         BTL module
+ * @param endpoint (IN)    BTL addressing information
+ * @param descriptor (IN)  Description of the data to be transfered
+ * @param tag (IN)         The tag value used to notify the peer if unmatched
+ * @param tm_tag (IN)      The tag matched against the posted receives
+ * @param header_size (IN) Size of the header
+ *
+ * @retval OPAL_SUCCESS           The descriptor was successfully queued for a send
+ * @retval OPAL_ERROR             The descriptor was NOT successfully queued for a send
+ * @retval OPAL_ERR_RESOURCE_BUSY Same as btl_send
+ */
+typedef int (*mca_btl_base_module_tm_send_fn_t)(struct mca_btl_base_module_t *btl,
+                                                struct mca_btl_base_endpoint_t *endpoint,
+                                                struct mca_btl_base_descriptor_t *descriptor,
+                                                mca_btl_base_tag_t tag, uint64_t tm_tag,
+                                                size_t header_size);
+
+/**
+ * Post a receive matched by the network.
+ *
+ * The receive matches the first tagged send of endpoint with the same
+ * tm_tag that arrives after it is posted. The posts fail while messages
+ * that did not match in the network arrived and their receive callback did
+ * not return yet, so that the caller never posts a receive that one of
+ * these messages should have matched: it has to match them first.
+ *
+ * @param btl (IN)            BTL module
+ * @param endpoint (IN)       BTL addressing information
+ * @param tm_tag (IN)         Tag of the sends to match
+ * @param local_address (IN)  Buffer of the payload
+ * @param size (IN)           Size of the buffer
+ * @param local_handle (IN)   Registration handle of the buffer (may be NULL)
+ * @param cbfunc (IN)         Function to call on completion
+ * @param cbcontext (IN)      Context for the callback
+ * @param cbdata (IN)         Data for callback
+ * @param handle (OUT)        Handle of the posted receive, for btl_tm_cancel
+ *
+ * @retval OPAL_SUCCESS              The receive was posted
+ * @retval OPAL_ERR_RESOURCE_BUSY    Unmatched messages are being delivered
+ * @retval OPAL_ERR_OUT_OF_RESOURCE  The matching lists are full
+ * @retval OPAL_ERR_NOT_AVAILABLE    The receive can not be matched by the
+ *                                   network (size, alignment)
+ */
+typedef int (*mca_btl_base_module_tm_post_fn_t)(
+    struct mca_btl_base_module_t *btl, struct mca_btl_base_endpoint_t *endpoint, uint64_t tm_tag,
+    void *local_address, size_t size, struct mca_btl_base_registration_handle_t *local_handle,
+    mca_btl_base_tm_completion_fn_t cbfunc, void *cbcontext, void *cbdata, void **handle);
+
+/**
+ * Cancel a receive posted with btl_tm_post.
+ *
+ * @param btl (IN)     BTL module
+ * @param handle (IN)  Handle of the posted receive
+ *
+ * @retval OPAL_SUCCESS        The receive was removed, its callback will not
+ *                             be called
+ * @retval OPAL_ERR_NOT_FOUND  The receive matched, its callback was or will
+ *                             be called
+ */
+typedef int (*mca_btl_base_module_tm_cancel_fn_t)(struct mca_btl_base_module_t *btl,
+                                                  void *handle);
+
 /**
  * BTL module interface functions and attributes.
  */
@@ -1225,6 +1328,11 @@ struct mca_btl_base_module_t {
 
     mca_btl_base_module_flush_fn_t btl_flush; /**< flush all previous operations on an endpoint */
 
+    /* tag matching (MCA_BTL_FLAGS_TAG_MATCHING) */
+    mca_btl_base_module_tm_send_fn_t btl_tm_send;
+    mca_btl_base_module_tm_post_fn_t btl_tm_post;
+    mca_btl_base_module_tm_cancel_fn_t btl_tm_cancel;
+
     unsigned char padding[256]; /**< padding to future-proof the btl module */
 };
 typedef struct mca_btl_base_module_t mca_btl_base_module_t;
@@ -157,6 +157,12 @@ struct mca_btl_ofi_component_t {
     int rd_num;
     bool two_sided_enabled;
 
+    /** insert the peer addresses in the address vector on first contact */
+    bool lazy_av;
+
+    /** all contexts of a scalable endpoint share one receive context */
+    bool shared_rx_context;
+
     size_t namelen;
 
     /** All BTL OFI modules (1 per tl) */
@@ -48,6 +48,11 @@ int mca_btl_ofi_afop(struct mca_btl_base_module_t *btl, struct mca_btl_base_endp
 
     ofi_context = get_ofi_context(ofi_btl);
 
+    rc = mca_btl_ofi_endpoint_ready(ofi_btl, btl_endpoint);
+    if (OPAL_UNLIKELY(OPAL_SUCCESS != rc)) {
+        return rc;
+    }
+
     if (flags & MCA_BTL_ATOMIC_FLAG_32BIT) {
         fi_datatype = FI_UINT32;
     }
@@ -99,6 +104,11 @@ int mca_btl_ofi_aop(struct mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *
 
     ofi_context = get_ofi_context(ofi_btl);
 
+    rc = mca_btl_ofi_endpoint_ready(ofi_btl, btl_endpoint);
+    if (OPAL_UNLIKELY(OPAL_SUCCESS != rc)) {
+        return rc;
+    }
+
     if (flags & MCA_BTL_ATOMIC_FLAG_32BIT) {
         fi_datatype = FI_UINT32;
     }
@@ -150,6 +160,11 @@ int mca_btl_ofi_acswap(struct mca_btl_base_module_t *btl, struct mca_btl_base_en
 
     ofi_context = get_ofi_context(ofi_btl);
 
+    rc = mca_btl_ofi_endpoint_ready(ofi_btl, btl_endpoint);
+    if (OPAL_UNLIKELY(OPAL_SUCCESS != rc)) {
+        return rc;
+    }
+
     if (flags & MCA_BTL_ATOMIC_FLAG_32BIT) {
         fi_datatype = FI_UINT32;
     }
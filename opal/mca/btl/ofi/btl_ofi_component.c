@@ -170,6 +170,26 @@ static int mca_btl_ofi_component_register(void)
                                            MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
                                            MCA_BASE_VAR_SCOPE_READONLY, &disable_sep);
 
+    mca_btl_ofi_component.shared_rx_context = false;
+    (void) mca_base_component_var_register(&mca_btl_ofi_component.super.btl_version,
+                                           "shared_rx_context",
+                                           "use a single receive context (and receive buffer "
+                                           "pool) for all the transmit contexts of a scalable "
+                                           "endpoint instead of one per context.",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_btl_ofi_component.shared_rx_context);
+
+    mca_btl_ofi_component.lazy_av = true;
+    (void) mca_base_component_var_register(&mca_btl_ofi_component.super.btl_version, "lazy_av",
+                                           "look up the address of a peer and insert it in the "
+                                           "address vector the first time it is used instead of "
+                                           "in add_procs. This reduces the startup time and the "
+                                           "size of the address vector on large jobs.",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_btl_ofi_component.lazy_av);
+
     mca_btl_ofi_component.progress_threshold = MCA_BTL_OFI_DEFAULT_PROGRESS_THRESHOLD;
     (void)
         mca_base_component_var_register(&mca_btl_ofi_component.super.btl_version,
@@ -484,7 +504,8 @@ static int mca_btl_ofi_init_device(struct fi_info *info)
 
         /* modify the info to let the provider know we are creating x contexts */
         ep_attr->tx_ctx_cnt = num_contexts_to_create;
-        ep_attr->rx_ctx_cnt = num_contexts_to_create;
+        ep_attr->rx_ctx_cnt = mca_btl_ofi_component.shared_rx_context ? 1
+                                                                      : num_contexts_to_create;
 
         /* create scalable endpoint */
         rc = fi_scalable_ep(domain, ofi_info, &ep, NULL);
@@ -576,6 +597,11 @@ static int mca_btl_ofi_init_device(struct fi_info *info)
 
         /* post wildcard recvs */
         for (int i = 0; i < module->num_contexts; i++) {
+            if (NULL == module->contexts[i].rx_ctx) {
+                /* shares the receive context of context 0 */
+                continue;
+            }
+
             rc = mca_btl_ofi_post_recvs((mca_btl_base_module_t *) module, &module->contexts[i],
                                         mca_btl_ofi_component.rd_num);
             if (OPAL_SUCCESS != rc) {
@@ -653,6 +679,12 @@ static int mca_btl_ofi_component_progress(void)
             mca_btl_ofi_context_unlock(context);
         }
 
+        /* the receives of a shared receive context complete on the first context */
+        if (NULL == context->rx_ctx && mca_btl_ofi_context_trylock(module->contexts)) {
+            events += mca_btl_ofi_context_progress(module->contexts);
+            mca_btl_ofi_context_unlock(module->contexts);
+        }
+
         /* if there is nothing to do, try progress other's. */
         if (events == 0) {
             for (int j = 0; j < module->num_contexts; j++) {
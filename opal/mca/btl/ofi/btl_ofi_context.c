@@ -176,12 +176,15 @@ mca_btl_ofi_context_t *mca_btl_ofi_context_alloc_scalable(struct fi_info *info,
 
         /* We don't actually need a receiving context as we only do one-sided.
          * However, sockets provider will hang if we dont have one. It is
-         * also nice to have equal number of tx/rx context. */
-        rc = fi_rx_context(sep, i, &rx_attr, &contexts[i].rx_ctx, NULL);
-        if (0 != rc) {
-            BTL_VERBOSE(
-                ("%s failed fi_rx_context with err=%s", linux_device_name, fi_strerror(-rc)));
-            goto scalable_fail;
+         * also nice to have equal number of tx/rx context. With a shared
+         * receive context only the first context has one. */
+        if (0 == i || !mca_btl_ofi_component.shared_rx_context) {
+            rc = fi_rx_context(sep, i, &rx_attr, &contexts[i].rx_ctx, NULL);
+            if (0 != rc) {
+                BTL_VERBOSE(
+                    ("%s failed fi_rx_context with err=%s", linux_device_name, fi_strerror(-rc)));
+                goto scalable_fail;
+            }
         }
 
         /* create CQ */
@@ -201,7 +204,7 @@ mca_btl_ofi_context_t *mca_btl_ofi_context_alloc_scalable(struct fi_info *info,
         }
 
         /* bind cq to receiving  context */
-        if (TWO_SIDED_ENABLED) {
+        if (TWO_SIDED_ENABLED && NULL != contexts[i].rx_ctx) {
             rc = fi_ep_bind(contexts[i].rx_ctx, (fid_t) contexts[i].cq, FI_RECV);
             if (0 != rc) {
                 BTL_VERBOSE(
@@ -217,10 +220,13 @@ mca_btl_ofi_context_t *mca_btl_ofi_context_alloc_scalable(struct fi_info *info,
             goto scalable_fail;
         }
 
-        rc = fi_enable(contexts[i].rx_ctx);
-        if (0 != rc) {
-            BTL_VERBOSE(("%s failed fi_enable with err=%s", linux_device_name, fi_strerror(-rc)));
-            goto scalable_fail;
+        if (NULL != contexts[i].rx_ctx) {
+            rc = fi_enable(contexts[i].rx_ctx);
+            if (0 != rc) {
+                BTL_VERBOSE(
+                    ("%s failed fi_enable with err=%s", linux_device_name, fi_strerror(-rc)));
+                goto scalable_fail;
+            }
         }
 
         /* initialize freelists. */
@@ -17,7 +17,7 @@
 
 static void mca_btl_ofi_endpoint_construct(mca_btl_ofi_endpoint_t *endpoint)
 {
-    endpoint->peer_addr = 0;
+    endpoint->peer_addr = FI_ADDR_NOTAVAIL;
     OBJ_CONSTRUCT(&endpoint->ep_lock, opal_mutex_t);
 }
 
@@ -47,3 +47,49 @@ mca_btl_base_endpoint_t *mca_btl_ofi_endpoint_create(opal_proc_t *proc, struct f
 
     return (mca_btl_base_endpoint_t *) endpoint;
 }
+
+int mca_btl_ofi_endpoint_insert_addr(mca_btl_ofi_module_t *ofi_btl,
+                                     mca_btl_ofi_endpoint_t *endpoint)
+{
+    size_t namelen = mca_btl_ofi_component.namelen;
+    fi_addr_t peer_addr;
+    char *ep_name = NULL;
+    int rc, count;
+
+    OPAL_THREAD_LOCK(&endpoint->ep_lock);
+    if (FI_ADDR_NOTAVAIL != endpoint->peer_addr) {
+        /* another thread got here first */
+        OPAL_THREAD_UNLOCK(&endpoint->ep_lock);
+        return OPAL_SUCCESS;
+    }
+
+    OPAL_MODEX_RECV(rc, &mca_btl_ofi_component.super.btl_version, &endpoint->ep_proc->proc_name,
+                    (void **) &ep_name, &namelen);
+    if (OPAL_SUCCESS != rc) {
+        OPAL_THREAD_UNLOCK(&endpoint->ep_lock);
+        BTL_ERROR(("error receiving modex"));
+        return rc;
+    }
+
+    /* get peer fi_addr */
+    count = fi_av_insert(ofi_btl->av, /* Address vector to insert */
+                         ep_name,     /* peer name */
+                         1,           /* amount to insert */
+                         &peer_addr,  /* return peer address here */
+                         0,           /* flags */
+                         NULL);       /* context */
+    free(ep_name);
+
+    if (1 != count) {
+        OPAL_THREAD_UNLOCK(&endpoint->ep_lock);
+        BTL_VERBOSE(("fi_av_insert failed with rc = %d", count));
+        return OPAL_ERROR;
+    }
+
+    /* the address is read without the lock */
+    opal_atomic_wmb();
+    endpoint->peer_addr = peer_addr;
+    OPAL_THREAD_UNLOCK(&endpoint->ep_lock);
+
+    return OPAL_SUCCESS;
+}
@@ -40,6 +40,8 @@ struct mca_btl_base_endpoint_t {
     opal_list_item_t super;
 
     struct fid_ep *ofi_endpoint;
+
+    /** address of the peer in the address vector, FI_ADDR_NOTAVAIL until it is inserted */
     fi_addr_t peer_addr;
 
     /** endpoint proc */
@@ -57,6 +59,21 @@ int init_context_freelists(mca_btl_ofi_context_t *context);
 
 mca_btl_base_endpoint_t *mca_btl_ofi_endpoint_create(opal_proc_t *proc, struct fid_ep *ep);
 
+/* look up the name of the peer and insert it in the address vector of the module */
+int mca_btl_ofi_endpoint_insert_addr(mca_btl_ofi_module_t *ofi_btl,
+                                     mca_btl_ofi_endpoint_t *endpoint);
+
+/* make sure the peer address is in the address vector before using it (btl_ofi_lazy_av) */
+static inline int mca_btl_ofi_endpoint_ready(mca_btl_ofi_module_t *ofi_btl,
+                                             mca_btl_ofi_endpoint_t *endpoint)
+{
+    if (OPAL_LIKELY(FI_ADDR_NOTAVAIL != endpoint->peer_addr)) {
+        return OPAL_SUCCESS;
+    }
+
+    return mca_btl_ofi_endpoint_insert_addr(ofi_btl, endpoint);
+}
+
 /* contexts */
 mca_btl_ofi_context_t *mca_btl_ofi_context_alloc_scalable(struct fi_info *info,
                                                           struct fid_domain *domain,
@@ -100,6 +100,11 @@ int mca_btl_ofi_send(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpoi
     /* This tag is the active message tag for the remote side */
     frag->hdr.tag = tag;
 
+    rc = mca_btl_ofi_endpoint_ready(ofi_btl, ofi_ep);
+    if (OPAL_UNLIKELY(OPAL_SUCCESS != rc)) {
+        return rc;
+    }
+
     /* create completion context */
     context = get_ofi_context(ofi_btl);
     comp = mca_btl_ofi_frag_completion_alloc(btl, context, frag, MCA_BTL_OFI_TYPE_SEND);
@@ -74,7 +74,20 @@ static int mca_btl_ofi_add_procs(mca_btl_base_module_t *btl, size_t nprocs,
 
             /* Add this endpoint to the lookup table */
             (void) opal_hash_table_set_value_uint64(&ofi_btl->id_to_endpoint, (intptr_t) proc,
-                                                    (void **) &ep);
+                                                    (void *) peers[i]);
+        }
+
+        if (OPAL_SUCCESS == rc) {
+            /* already in the list and in the address vector or waiting to be */
+            opal_bitmap_set_bit(reachable, i);
+            continue;
+        }
+
+        if (mca_btl_ofi_component.lazy_av) {
+            /* the address is inserted by mca_btl_ofi_endpoint_ready on first contact */
+            opal_list_append(&ofi_btl->endpoints, &peers[i]->super);
+            opal_bitmap_set_bit(reachable, i);
+            continue;
         }
 
         OPAL_MODEX_RECV(rc, &mca_btl_ofi_component.super.btl_version, &peers[i]->ep_proc->proc_name,
@@ -91,6 +104,8 @@ static int mca_btl_ofi_add_procs(mca_btl_base_module_t *btl, size_t nprocs,
                              &peers[i]->peer_addr, /* return peer address here */
                              0,                    /* flags */
                              NULL);                /* context */
+        free(ep_name);
+        ep_name = NULL;
 
         /* if succeed, add this proc and mark reachable */
         if (count == 1) { /* we inserted 1 address. */
@@ -118,12 +133,16 @@ static int mca_btl_ofi_del_procs(mca_btl_base_module_t *btl, size_t nprocs, opal
                                                   (void **) &ep);
 
             if (OPAL_SUCCESS == rc) {
-                /* remove the address from AV. */
-                rc = fi_av_remove(ofi_btl->av, &peers[i]->peer_addr, 1, 0);
-                if (rc < 0) {
-                    /* remove failed. this should not happen. */
-                    /* Lets not crash because we failed to remove an address. */
-                    BTL_ERROR(("fi_av_remove failed with error %d:%s", rc, fi_strerror(-rc)));
+                /* remove the address from AV. with btl_ofi_lazy_av it may never have been
+                 * inserted. */
+                if (FI_ADDR_NOTAVAIL != peers[i]->peer_addr) {
+                    rc = fi_av_remove(ofi_btl->av, &peers[i]->peer_addr, 1, 0);
+                    if (rc < 0) {
+                        /* remove failed. this should not happen. */
+                        /* Lets not crash because we failed to remove an address. */
+                        BTL_ERROR(
+                            ("fi_av_remove failed with error %d:%s", rc, fi_strerror(-rc)));
+                    }
                 }
 
                 /* remove and free MPI endpoint from the list. */
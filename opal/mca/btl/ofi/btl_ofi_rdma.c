@@ -68,6 +68,11 @@ int mca_btl_ofi_get(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpoin
 
     ofi_context = get_ofi_context(ofi_btl);
 
+    rc = mca_btl_ofi_endpoint_ready(ofi_btl, btl_endpoint);
+    if (OPAL_UNLIKELY(OPAL_SUCCESS != rc)) {
+        return rc;
+    }
+
     /* create completion context */
     comp = mca_btl_ofi_rdma_completion_alloc(btl, endpoint, ofi_context, local_address,
                                              local_handle, cbfunc, cbcontext, cbdata,
@@ -113,6 +118,11 @@ int mca_btl_ofi_put(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpoin
 
     ofi_context = get_ofi_context(ofi_btl);
 
+    rc = mca_btl_ofi_endpoint_ready(ofi_btl, btl_endpoint);
+    if (OPAL_UNLIKELY(OPAL_SUCCESS != rc)) {
+        return rc;
+    }
+
     /* create completion context */
     mca_btl_ofi_rdma_completion_t *comp;
     comp = mca_btl_ofi_rdma_completion_alloc(btl, endpoint, ofi_context, local_address,
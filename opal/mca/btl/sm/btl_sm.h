@@ -94,6 +94,17 @@ static inline void sm_memmove(void *dst, void *src, size_t size)
     }
 }
 
+/* pid of a peer, for CMA */
+static inline pid_t mca_btl_sm_endpoint_pid(struct mca_btl_base_endpoint_t *endpoint)
+{
+#if OPAL_BTL_SM_HAVE_XPMEM
+    if (MCA_BTL_SM_XPMEM == mca_btl_sm_component.single_copy_mechanism) {
+        return endpoint->segment_data.xpmem.pid;
+    }
+#endif
+    return endpoint->segment_data.other.seg_ds->seg_cpid;
+}
+
 /**
  * Initiate a send to the peer.
  *
@@ -121,6 +132,15 @@ int mca_btl_sm_sendi(struct mca_btl_base_module_t *btl, struct mca_btl_base_endp
  * @param endpoint (IN)    BTL addressing information
  * @param descriptor (IN)  Description of the data to be transferred
  */
+#if OPAL_BTL_SM_HAVE_XPMEM && OPAL_BTL_SM_HAVE_CMA
+int mca_btl_sm_put_auto(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpoint,
+                        void *local_address, uint64_t remote_address,
+                        mca_btl_base_registration_handle_t *local_handle,
+                        mca_btl_base_registration_handle_t *remote_handle, size_t size, int flags,
+                        int order, mca_btl_base_rdma_completion_fn_t cbfunc, void *cbcontext,
+                        void *cbdata);
+#endif
+
 #if OPAL_BTL_SM_HAVE_XPMEM
 int mca_btl_sm_put_xpmem(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpoint,
                          void *local_address, uint64_t remote_address,
@@ -155,6 +175,15 @@ int mca_btl_sm_put_knem(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *end
  * @param endpoint (IN)    BTL addressing information
  * @param descriptor (IN)  Description of the data to be transferred
  */
+#if OPAL_BTL_SM_HAVE_XPMEM && OPAL_BTL_SM_HAVE_CMA
+int mca_btl_sm_get_auto(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpoint,
+                        void *local_address, uint64_t remote_address,
+                        mca_btl_base_registration_handle_t *local_handle,
+                        mca_btl_base_registration_handle_t *remote_handle, size_t size, int flags,
+                        int order, mca_btl_base_rdma_completion_fn_t cbfunc, void *cbcontext,
+                        void *cbdata);
+#endif
+
 #if OPAL_BTL_SM_HAVE_XPMEM
 int mca_btl_sm_get_xpmem(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpoint,
                          void *local_address, uint64_t remote_address,
@@ -184,6 +213,32 @@ int mca_btl_sm_get_knem(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *end
 
 ino_t mca_btl_sm_get_user_ns_id(void);
 
+/**
+ * Find the NUMA node of this process and bind the segment according to btl_sm_numa_placement.
+ * Called once the segment is attached, before anything is written to it.
+ */
+int mca_btl_sm_numa_init(void);
+
+/**
+ * NUMA node a local peer is bound to, -1 if unknown or if nothing uses it.
+ */
+int mca_btl_sm_numa_peer_node(opal_process_name_t *name);
+
+/**
+ * Move a fast box to the NUMA node of the peer that polls it (receiver placement).
+ */
+void mca_btl_sm_numa_place_fbox(struct mca_btl_base_endpoint_t *ep, void *base, size_t size);
+
+/**
+ * Account for the round trip time of a completed fragment (btl_sm_numa_report).
+ */
+void mca_btl_sm_numa_record(struct mca_btl_sm_frag_t *frag);
+
+/**
+ * Print the round trip times per NUMA node and release them.
+ */
+void mca_btl_sm_numa_report(void);
+
 /**
  * Allocate a segment.
  *
@@ -36,6 +36,7 @@
 #include "opal/util/output.h"
 #include "opal/util/printf.h"
 #include "opal/util/show_help.h"
+#include "opal/util/sys_limits.h"
 
 #include "opal/mca/btl/sm/btl_sm.h"
 #include "opal/mca/btl/sm/btl_sm_fbox.h"
@@ -80,6 +81,12 @@ static mca_base_var_enum_value_t single_copy_mechanisms[] = {
     {.value = MCA_BTL_SM_NONE, .string = "none"},
     {.value = 0, .string = NULL}};
 
+static mca_base_var_enum_value_t numa_placements[] = {
+    {.value = MCA_BTL_SM_NUMA_NONE, .string = "none"},
+    {.value = MCA_BTL_SM_NUMA_LOCAL, .string = "local"},
+    {.value = MCA_BTL_SM_NUMA_RECEIVER, .string = "receiver"},
+    {.value = 0, .string = NULL}};
+
 /*
  * Shared Memory (SM) component instance.
  */
@@ -104,6 +111,24 @@ mca_btl_sm_component_t mca_btl_sm_component = {
         } /* end super */
 };
 
+static mca_base_event_t *mca_btl_sm_event_register(const char *name, const char *description)
+{
+    static const mca_base_var_type_t types[] = {MCA_BASE_VAR_TYPE_INT, MCA_BASE_VAR_TYPE_SIZE_T};
+    static const size_t offsets[] = {offsetof(mca_btl_sm_event_data_t, peer),
+                                     offsetof(mca_btl_sm_event_data_t, bytes)};
+    mca_base_event_t *event = NULL;
+    int index;
+
+    index = mca_base_component_event_register(&mca_btl_sm_component.super.btl_version, name,
+                                              description, OPAL_INFO_LVL_5, types, offsets, 2, NULL,
+                                              MCA_BASE_VAR_BIND_NO_OBJECT, 0);
+    if (0 <= index) {
+        (void) mca_base_event_get(index, &event);
+    }
+
+    return event;
+}
+
 static int mca_btl_sm_component_register(void)
 {
     mca_base_var_enum_t *new_enum;
@@ -155,6 +180,54 @@ static int mca_btl_sm_component_register(void)
                                            MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
                                            MCA_BASE_VAR_SCOPE_LOCAL,
                                            &mca_btl_sm_component.log_attach_align);
+
+    mca_btl_sm_component.xpmem_cache_size = 0;
+    (void) mca_base_component_var_register(&mca_btl_sm_component.super.btl_version,
+                                           "xpmem_cache_size",
+                                           "Maximum number of bytes of the memory of each local "
+                                           "rank kept attached with xpmem. The least recently "
+                                           "used attachments are dropped first (0 = no limit, "
+                                           "default: 0)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_btl_sm_component.xpmem_cache_size);
+
+#    if OPAL_BTL_SM_HAVE_CMA
+    mca_btl_sm_component.single_copy_auto = false;
+    (void) mca_base_component_var_register(&mca_btl_sm_component.super.btl_version,
+                                           "single_copy_auto",
+                                           "Choose between xpmem and CMA for each get/put when "
+                                           "xpmem is the single copy mechanism: CMA is used for "
+                                           "transfers smaller than btl_sm_xpmem_attach_min unless "
+                                           "the remote buffer is already attached or was used "
+                                           "btl_sm_xpmem_reuse_min times (default: false)",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_btl_sm_component.single_copy_auto);
+
+    mca_btl_sm_component.xpmem_attach_min = 1 << 20;
+    (void) mca_base_component_var_register(&mca_btl_sm_component.super.btl_version,
+                                           "xpmem_attach_min",
+                                           "Smallest get/put that always uses xpmem with "
+                                           "btl_sm_single_copy_auto (default: 1M)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_btl_sm_component.xpmem_attach_min);
+
+    mca_btl_sm_component.xpmem_reuse_min = 2;
+    (void) mca_base_component_var_register(&mca_btl_sm_component.super.btl_version,
+                                           "xpmem_reuse_min",
+                                           "Number of get/put to the same remote buffer after "
+                                           "which it is attached with btl_sm_single_copy_auto "
+                                           "(default: 2)",
+                                           MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_btl_sm_component.xpmem_reuse_min);
+#    endif
 #endif
 
 #if OPAL_BTL_SM_HAVE_XPMEM && 64 == MCA_BTL_SM_BITNESS
@@ -212,6 +285,52 @@ static int mca_btl_sm_component_register(void)
                                            MCA_BASE_VAR_SCOPE_LOCAL,
                                            &mca_btl_sm_component.fbox_size);
 
+    mca_btl_sm_component.fbox_adaptive = false;
+    (void) mca_base_component_var_register(&mca_btl_sm_component.super.btl_version,
+                                           "fbox_adaptive",
+                                           "Grow, shrink and reclaim the per-peer fast transfer "
+                                           "buffers based on the traffic to each peer. The memory "
+                                           "used by all the buffers is limited to btl_sm_fbox_max "
+                                           "* btl_sm_fbox_size (default: false)",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_btl_sm_component.fbox_adaptive);
+
+    mca_btl_sm_component.fbox_max_size = 65536;
+    (void) mca_base_component_var_register(&mca_btl_sm_component.super.btl_version,
+                                           "fbox_max_size",
+                                           "Largest per-peer fast transfer buffer when "
+                                           "btl_sm_fbox_adaptive is set. Buffers grow by powers "
+                                           "of two from btl_sm_fbox_size (default: 64k)",
+                                           MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_btl_sm_component.fbox_max_size);
+
+    mca_btl_sm_component.fbox_adapt_interval = 10000;
+    (void) mca_base_component_var_register(&mca_btl_sm_component.super.btl_version,
+                                           "fbox_adapt_interval",
+                                           "Time in microseconds between two samples of the "
+                                           "per-peer traffic when btl_sm_fbox_adaptive is set "
+                                           "(default: 10000)",
+                                           MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_btl_sm_component.fbox_adapt_interval);
+
+    mca_btl_sm_component.fbox_idle_timeout = 1000000;
+    (void) mca_base_component_var_register(&mca_btl_sm_component.super.btl_version,
+                                           "fbox_idle_timeout",
+                                           "Time in microseconds after which the fast transfer "
+                                           "buffer of a peer that is not sent to is reclaimed "
+                                           "when btl_sm_fbox_adaptive is set (0 = never, "
+                                           "default: 1000000)",
+                                           MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_btl_sm_component.fbox_idle_timeout);
+
     (void) mca_base_var_enum_create("btl_sm_single_copy_mechanisms", single_copy_mechanisms,
                                     &new_enum);
 
@@ -227,6 +346,29 @@ static int mca_btl_sm_component_register(void)
                                         &mca_btl_sm_component.single_copy_mechanism);
     OBJ_RELEASE(new_enum);
 
+    (void) mca_base_var_enum_create("btl_sm_numa_placements", numa_placements, &new_enum);
+
+    mca_btl_sm_component.numa_placement = MCA_BTL_SM_NUMA_NONE;
+    (void) mca_base_component_var_register(
+        &mca_btl_sm_component.super.btl_version, "numa_placement",
+        "NUMA placement of the shared memory segment. none: first touch, local: bind the "
+        "receive fifo, fragments and fast boxes to the NUMA node of this process, receiver: "
+        "same as local except each fast box is moved to the NUMA node of the peer that polls "
+        "it (default: none)",
+        MCA_BASE_VAR_TYPE_INT, new_enum, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+        MCA_BASE_VAR_SCOPE_LOCAL, &mca_btl_sm_component.numa_placement);
+    OBJ_RELEASE(new_enum);
+
+    mca_btl_sm_component.numa_report = false;
+    (void) mca_base_component_var_register(&mca_btl_sm_component.super.btl_version, "numa_report",
+                                           "Measure the round trip time of the fragments sent to "
+                                           "the ranks of each NUMA node and print it at "
+                                           "finalize (default: false)",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_btl_sm_component.numa_report);
+
     if (0 == access("/dev/shm", W_OK)) {
         mca_btl_sm_component.backing_directory = "/dev/shm";
     } else {
@@ -284,6 +426,19 @@ static int mca_btl_sm_component_register(void)
     /* Call the BTL based to register its MCA params */
     mca_btl_base_param_register(&mca_btl_sm_component.super.btl_version, &mca_btl_sm.super);
 
+    mca_btl_sm_fbox_register_pvars();
+#if OPAL_BTL_SM_HAVE_XPMEM
+    mca_btl_sm_xpmem_register_pvars();
+#endif
+
+    mca_btl_sm_component.event_send_pending
+        = mca_btl_sm_event_register("send_pending",
+                                    "A fragment was queued because the fifo of the peer was full "
+                                    "(elements: SMP rank of the peer, fragment bytes)");
+    mca_btl_sm_component.event_fbox_setup
+        = mca_btl_sm_event_register("fbox_setup", "A fast box was set up to send to a peer "
+                                                  "(elements: SMP rank of the peer, fast box bytes)");
+
     return OPAL_SUCCESS;
 }
 
@@ -298,7 +453,9 @@ static int mca_btl_sm_component_open(void)
     OBJ_CONSTRUCT(&mca_btl_sm_component.sm_frags_eager, opal_free_list_t);
     OBJ_CONSTRUCT(&mca_btl_sm_component.sm_frags_user, opal_free_list_t);
     OBJ_CONSTRUCT(&mca_btl_sm_component.sm_frags_max_send, opal_free_list_t);
-    OBJ_CONSTRUCT(&mca_btl_sm_component.sm_fboxes, opal_free_list_t);
+    for (int i = 0; i < MCA_BTL_SM_FBOX_CLASSES; ++i) {
+        OBJ_CONSTRUCT(&mca_btl_sm_component.sm_fboxes[i], opal_free_list_t);
+    }
     OBJ_CONSTRUCT(&mca_btl_sm_component.lock, opal_mutex_t);
     OBJ_CONSTRUCT(&mca_btl_sm_component.pending_endpoints, opal_list_t);
     OBJ_CONSTRUCT(&mca_btl_sm_component.pending_fragments, opal_list_t);
@@ -318,7 +475,9 @@ static int mca_btl_sm_component_close(void)
     OBJ_DESTRUCT(&mca_btl_sm_component.sm_frags_eager);
     OBJ_DESTRUCT(&mca_btl_sm_component.sm_frags_user);
     OBJ_DESTRUCT(&mca_btl_sm_component.sm_frags_max_send);
-    OBJ_DESTRUCT(&mca_btl_sm_component.sm_fboxes);
+    for (int i = 0; i < MCA_BTL_SM_FBOX_CLASSES; ++i) {
+        OBJ_DESTRUCT(&mca_btl_sm_component.sm_fboxes[i]);
+    }
     OBJ_DESTRUCT(&mca_btl_sm_component.lock);
     OBJ_DESTRUCT(&mca_btl_sm_component.pending_endpoints);
     OBJ_DESTRUCT(&mca_btl_sm_component.pending_fragments);
@@ -371,6 +530,7 @@ static int mca_btl_base_sm_modex_send(void)
         modex.xpmem.seg_id = mca_btl_sm_component.my_seg_id;
         modex.xpmem.segment_base = mca_btl_sm_component.my_segment;
         modex.xpmem.address_max = mca_btl_sm_component.my_address_max;
+        modex.xpmem.pid = getpid();
 
         modex_size = sizeof(modex.xpmem);
     } else {
@@ -407,6 +567,40 @@ static void mca_btl_sm_select_next_single_copy_mechanism(void)
 }
 #endif
 
+#if OPAL_BTL_SM_HAVE_CMA
+/* Check if we have the proper permissions for CMA */
+static bool mca_btl_sm_cma_permitted(void)
+{
+    char buffer = '0';
+    bool cma_happy = false;
+    int fd;
+
+    /* check system setting for current ptrace scope */
+    fd = open("/proc/sys/kernel/yama/ptrace_scope", O_RDONLY);
+    if (0 <= fd) {
+        read(fd, &buffer, 1);
+        close(fd);
+    }
+
+    /* ptrace scope 0 will allow an attach from any of the process owner's
+     * processes. ptrace scope 1 limits attachers to the process tree
+     * starting at the parent of this process. */
+    if ('0' != buffer) {
+#    if defined PR_SET_PTRACER
+        /* try setting the ptrace scope to allow attach */
+        int ret = prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY, 0, 0, 0);
+        if (0 == ret) {
+            cma_happy = true;
+        }
+#    endif
+    } else {
+        cma_happy = true;
+    }
+
+    return cma_happy;
+}
+#endif
+
 static void mca_btl_sm_check_single_copy(void)
 {
 #if OPAL_BTL_SM_HAVE_XPMEM || OPAL_BTL_SM_HAVE_CMA || OPAL_BTL_SM_HAVE_KNEM
@@ -425,39 +619,19 @@ static void mca_btl_sm_check_single_copy(void)
 
             mca_btl_sm_select_next_single_copy_mechanism();
         }
+#    if OPAL_BTL_SM_HAVE_CMA
+        else if (mca_btl_sm_component.single_copy_auto && mca_btl_sm_cma_permitted()) {
+            /* small transfers to buffers that are not attached use CMA */
+            mca_btl_sm.super.btl_get = mca_btl_sm_get_auto;
+            mca_btl_sm.super.btl_put = mca_btl_sm_put_auto;
+        }
+#    endif
     }
 #endif
 
 #if OPAL_BTL_SM_HAVE_CMA
     if (MCA_BTL_SM_CMA == mca_btl_sm_component.single_copy_mechanism) {
-        /* Check if we have the proper permissions for CMA */
-        char buffer = '0';
-        bool cma_happy = false;
-        int fd;
-
-        /* check system setting for current ptrace scope */
-        fd = open("/proc/sys/kernel/yama/ptrace_scope", O_RDONLY);
-        if (0 <= fd) {
-            read(fd, &buffer, 1);
-            close(fd);
-        }
-
-        /* ptrace scope 0 will allow an attach from any of the process owner's
-         * processes. ptrace scope 1 limits attachers to the process tree
-         * starting at the parent of this process. */
-        if ('0' != buffer) {
-#    if defined PR_SET_PTRACER
-            /* try setting the ptrace scope to allow attach */
-            int ret = prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY, 0, 0, 0);
-            if (0 == ret) {
-                cma_happy = true;
-            }
-#    endif
-        } else {
-            cma_happy = true;
-        }
-
-        if (!cma_happy) {
+        if (!mca_btl_sm_cma_permitted()) {
             mca_btl_sm_select_next_single_copy_mechanism();
 
             if (MCA_BTL_SM_CMA == initial_mechanism) {
@@ -535,6 +709,28 @@ mca_btl_sm_component_init(int *num_btls, bool enable_progress_threads, bool enab
     component->fbox_size = (component->fbox_size + MCA_BTL_SM_FBOX_ALIGNMENT_MASK)
                            & ~MCA_BTL_SM_FBOX_ALIGNMENT_MASK;
 
+    if (MCA_BTL_SM_NUMA_RECEIVER == component->numa_placement) {
+        /* fast boxes are moved a page at a time */
+        const unsigned int page_size = (unsigned int) opal_getpagesize();
+        component->fbox_size = (component->fbox_size + page_size - 1) & ~(page_size - 1);
+    }
+
+    /* size classes of the fast boxes, only the first one is used by default */
+    component->fbox_num_classes = 1;
+    if (component->fbox_adaptive) {
+        while (component->fbox_num_classes < MCA_BTL_SM_FBOX_CLASSES
+               && (component->fbox_size << component->fbox_num_classes)
+                      <= component->fbox_max_size) {
+            ++component->fbox_num_classes;
+        }
+        if (0 == component->fbox_adapt_interval) {
+            component->fbox_adapt_interval = 1;
+        }
+    }
+    component->fbox_bytes_max = (size_t) component->fbox_max * component->fbox_size;
+    component->fbox_bytes_used = 0;
+    component->fbox_last_sample = 0;
+
     if (component->segment_size > (1ul << MCA_BTL_SM_OFFSET_BITS)) {
         component->segment_size = 2ul << MCA_BTL_SM_OFFSET_BITS;
     }
@@ -580,6 +776,8 @@ mca_btl_sm_component_init(int *num_btls, bool enable_progress_threads, bool enab
         }
     }
 
+    (void) mca_btl_sm_numa_init();
+
     /* initialize my fifo */
     sm_fifo_init((struct sm_fifo_t *) component->my_segment);
 
@@ -616,6 +814,9 @@ failed:
 void mca_btl_sm_poll_handle_frag(mca_btl_sm_hdr_t *hdr, struct mca_btl_base_endpoint_t *endpoint)
 {
     if (hdr->flags & MCA_BTL_SM_FLAG_COMPLETE) {
+        if (OPAL_UNLIKELY(mca_btl_sm_component.numa_report)) {
+            mca_btl_sm_numa_record(hdr->frag);
+        }
         mca_btl_sm_frag_complete(hdr->frag);
         return;
     }
@@ -652,7 +853,8 @@ void mca_btl_sm_poll_handle_frag(mca_btl_sm_hdr_t *hdr, struct mca_btl_base_endp
     }
 
     if (OPAL_UNLIKELY(MCA_BTL_SM_FLAG_SETUP_FBOX & hdr->flags)) {
-        mca_btl_sm_endpoint_setup_fbox_recv(endpoint, relative2virtual(hdr->fbox_base));
+        mca_btl_sm_endpoint_setup_fbox_recv(endpoint, relative2virtual(hdr->fbox_base),
+                                            hdr->fbox_size);
         mca_btl_sm_component.fbox_in_endpoints[mca_btl_sm_component.num_fbox_in_endpoints++]
             = endpoint;
     }
@@ -752,6 +954,10 @@ static int mca_btl_sm_component_progress(void)
         count = mca_btl_sm_check_fboxes();
     }
 
+    if (mca_btl_sm_component.fbox_adaptive) {
+        count += mca_btl_sm_fbox_adapt_progress();
+    }
+
     mca_btl_sm_progress_endpoints();
 
     if (SM_FIFO_FREE == mca_btl_sm_component.my_fifo->fifo_head) {
@@ -0,0 +1,330 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2021      Google, LLC. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Adaptive fast boxes (btl_sm_fbox_adaptive).
+ *
+ * The sender samples the traffic to each peer that has a fast box every
+ * btl_sm_fbox_adapt_interval microseconds. A fast box that frequently has no
+ * room (or that is too small for the messages) is replaced by one twice as
+ * large, one that only carries small messages by one half as large, and one
+ * that is not used for btl_sm_fbox_idle_timeout microseconds is reclaimed so
+ * that another peer can get it.
+ *
+ * Retiring a fast box: the sender writes an empty skip message in it and
+ * stops using it. Everything sent afterwards waits on the endpoint pending
+ * list so that it can not overtake what is still in the fast box. The
+ * receiver stops polling the fast box when it reaches the empty skip and
+ * writes MCA_BTL_SM_FBOX_RELEASED in place of its start offset. The sender
+ * then returns the memory to the free list of its size class and the pending
+ * fragments go through the fifo, the first of them sets up the new fast box
+ * when the fast box was resized.
+ */
+
+#include "opal_config.h"
+
+#include <stddef.h>
+
+#include "opal/mca/base/mca_base_pvar.h"
+#include "opal/mca/timer/base/base.h"
+
+#include "opal/mca/btl/sm/btl_sm.h"
+#include "opal/mca/btl/sm/btl_sm_fbox.h"
+
+/** number of progress calls between two looks at the clock */
+#define MCA_BTL_SM_FBOX_ADAPT_POLL 64
+/** minimum number of fifo fallbacks in a sample to grow a fast box */
+#define MCA_BTL_SM_FBOX_GROW_MIN 16
+/** number of consecutive samples with small messages before shrinking a fast box */
+#define MCA_BTL_SM_FBOX_SHRINK_SAMPLES 8
+
+static void mca_btl_sm_fbox_remove_out(unsigned int index)
+{
+    mca_btl_sm_component_t *component = &mca_btl_sm_component;
+
+    component->fbox_out_endpoints[index]
+        = component->fbox_out_endpoints[--component->num_fbox_out_endpoints];
+}
+
+void mca_btl_sm_fbox_release_recv(mca_btl_base_endpoint_t *ep, unsigned int index)
+{
+    mca_btl_sm_component_t *component = &mca_btl_sm_component;
+    uint32_t *startp = ep->fbox_in.startp;
+
+    BTL_VERBOSE(("peer %d released its fast box", ep->peer_smp_rank));
+
+    component->fbox_in_endpoints[index]
+        = component->fbox_in_endpoints[--component->num_fbox_in_endpoints];
+    ep->fbox_in.buffer = NULL;
+    ep->fbox_in.startp = NULL;
+
+    /* the peer can set up a new fast box */
+    opal_atomic_add_fetch_32(&component->my_fifo->fbox_available, 1);
+
+    /* the memory belongs to the peer again once this is written */
+    opal_atomic_mb();
+    startp[0] = MCA_BTL_SM_FBOX_RELEASED;
+}
+
+void mca_btl_sm_fbox_forget(mca_btl_base_endpoint_t *ep)
+{
+    mca_btl_sm_component_t *component = &mca_btl_sm_component;
+
+    OPAL_THREAD_LOCK(&component->lock);
+    for (unsigned int i = 0; i < component->num_fbox_out_endpoints; ++i) {
+        if (component->fbox_out_endpoints[i] == ep) {
+            mca_btl_sm_fbox_remove_out(i);
+            break;
+        }
+    }
+
+    if (component->fbox_adaptive) {
+        component->fbox_bytes_used -= ep->fbox_out.size;
+    }
+
+    if (ep->fbox_out.retiring) {
+        ep->fbox_out.retiring = false;
+        --component->num_fbox_retiring;
+    }
+    OPAL_THREAD_UNLOCK(&component->lock);
+}
+
+/* stop sending to the fast box of {ep}. called with the component lock held */
+static void mca_btl_sm_fbox_retire(mca_btl_base_endpoint_t *ep, int want_class)
+{
+    OPAL_THREAD_LOCK(&ep->lock);
+    if (NULL == ep->fbox_out.buffer || !mca_btl_sm_fbox_write(ep, 0xff, NULL, 0, NULL, 0)) {
+        /* no room for the last message. try again at the next sample */
+        OPAL_THREAD_UNLOCK(&ep->lock);
+        return;
+    }
+
+    BTL_VERBOSE(("retiring fast box of size %u to peer %d (next size class: %d)",
+                 ep->fbox_out.size, ep->peer_smp_rank, want_class));
+
+    ep->fbox_out.want_class = want_class;
+    ep->fbox_out.retiring = true;
+    /* sm_fifo_write_ep checks retiring once it sees no buffer */
+    opal_atomic_wmb();
+    ep->fbox_out.buffer = NULL;
+    OPAL_THREAD_UNLOCK(&ep->lock);
+
+    ++mca_btl_sm_component.num_fbox_retiring;
+}
+
+/* return the fast box of {ep} to its free list if the peer released it. called with the
+ * component lock held */
+static bool mca_btl_sm_fbox_complete_retire(mca_btl_base_endpoint_t *ep, unsigned int index)
+{
+    mca_btl_sm_component_t *component = &mca_btl_sm_component;
+    const int fbox_class = ep->fbox_out.fbox_class;
+
+    if (MCA_BTL_SM_FBOX_RELEASED != ep->fbox_out.startp[0]) {
+        return false;
+    }
+
+    opal_atomic_rmb();
+
+    opal_free_list_return(&component->sm_fboxes[fbox_class], ep->fbox_out.fbox);
+    component->fbox_bytes_used -= ep->fbox_out.size;
+    ep->fbox_out.fbox = NULL;
+    ep->fbox_out.startp = NULL;
+    ep->fbox_out.size = 0;
+    mca_btl_sm_fbox_remove_out(index);
+    --component->num_fbox_retiring;
+
+    /* a resized fast box is set up by the next fragment sent through the fifo, a reclaimed one
+     * once the peer is busy again */
+    ep->send_count = (ep->fbox_out.want_class != fbox_class) ? component->fbox_threshold - 1 : 0;
+
+    opal_atomic_wmb();
+    ep->fbox_out.retiring = false;
+
+    return true;
+}
+
+/* look at the traffic to {ep} since the last sample. called with the component lock held */
+static void mca_btl_sm_fbox_sample(mca_btl_base_endpoint_t *ep, unsigned int idle_limit)
+{
+    mca_btl_sm_component_t *component = &mca_btl_sm_component;
+    const uint64_t msgs = ep->fbox_out.msgs - ep->fbox_out.sample_msgs;
+    const uint64_t bytes = ep->fbox_out.bytes - ep->fbox_out.sample_bytes;
+    const uint64_t misses = ep->fbox_out.misses - ep->fbox_out.sample_misses;
+    const int fbox_class = ep->fbox_out.fbox_class;
+
+    ep->fbox_out.sample_msgs += msgs;
+    ep->fbox_out.sample_bytes += bytes;
+    ep->fbox_out.sample_misses += misses;
+
+    if (ep->fbox_out.retiring) {
+        return;
+    }
+
+    if (0 == msgs && 0 == misses) {
+        if (idle_limit && ++ep->fbox_out.idle_samples >= idle_limit) {
+            mca_btl_sm_fbox_retire(ep, fbox_class);
+        }
+        return;
+    }
+
+    ep->fbox_out.idle_samples = 0;
+
+    /* more than one send in eight did not fit, ask for a larger fast box if the budget allows
+     * to have both for a moment */
+    if (fbox_class + 1 < component->fbox_num_classes && misses >= MCA_BTL_SM_FBOX_GROW_MIN
+        && misses * 8 > msgs) {
+        ep->fbox_out.small_samples = 0;
+        if (component->fbox_bytes_used + ep->fbox_out.size <= component->fbox_bytes_max) {
+            mca_btl_sm_fbox_retire(ep, fbox_class + 1);
+        }
+        return;
+    }
+
+    /* the messages would fit a fast box half as large (they are on average under half its
+     * message size limit) */
+    if (fbox_class > 0 && 0 == misses && bytes <= msgs * (ep->fbox_out.size >> 4)) {
+        if (++ep->fbox_out.small_samples >= MCA_BTL_SM_FBOX_SHRINK_SAMPLES) {
+            mca_btl_sm_fbox_retire(ep, fbox_class - 1);
+        }
+    } else {
+        ep->fbox_out.small_samples = 0;
+    }
+}
+
+int mca_btl_sm_fbox_adapt_progress(void)
+{
+    static int countdown = 0;
+    mca_btl_sm_component_t *component = &mca_btl_sm_component;
+    unsigned int idle_limit;
+    uint64_t now;
+    int count = 0;
+
+    if (OPAL_UNLIKELY(component->num_fbox_retiring)) {
+        OPAL_THREAD_LOCK(&component->lock);
+        for (unsigned int i = 0; i < component->num_fbox_out_endpoints; ++i) {
+            mca_btl_base_endpoint_t *ep = component->fbox_out_endpoints[i];
+            if (ep->fbox_out.retiring && mca_btl_sm_fbox_complete_retire(ep, i)) {
+                /* look at the endpoint that took this one's place */
+                --i;
+                ++count;
+            }
+        }
+        OPAL_THREAD_UNLOCK(&component->lock);
+    }
+
+    if (--countdown > 0 || 0 == component->num_fbox_out_endpoints) {
+        return count;
+    }
+
+    countdown = MCA_BTL_SM_FBOX_ADAPT_POLL;
+
+    now = opal_timer_base_get_usec();
+    if (now - component->fbox_last_sample < component->fbox_adapt_interval) {
+        return count;
+    }
+
+    component->fbox_last_sample = now;
+
+    idle_limit = component->fbox_idle_timeout / component->fbox_adapt_interval;
+    if (component->fbox_idle_timeout && 0 == idle_limit) {
+        idle_limit = 1;
+    }
+
+    OPAL_THREAD_LOCK(&component->lock);
+    for (unsigned int i = 0; i < component->num_fbox_out_endpoints; ++i) {
+        mca_btl_sm_fbox_sample(component->fbox_out_endpoints[i], idle_limit);
+    }
+    OPAL_THREAD_UNLOCK(&component->lock);
+
+    return count;
+}
+
+/*
+ * Performance variables. Each one is an array with one value per local
+ * rank (the value for this process is always 0).
+ */
+
+static int mca_btl_sm_fbox_pvar_notify(struct mca_base_pvar_t *pvar, mca_base_pvar_event_t event,
+                                       void *obj, int *count)
+{
+    if (MCA_BASE_PVAR_HANDLE_BIND == event) {
+        *count = (int) mca_btl_sm_component.num_endpoints;
+    }
+
+    return OPAL_SUCCESS;
+}
+
+static int mca_btl_sm_fbox_pvar_read_size(const struct mca_base_pvar_t *pvar, void *value,
+                                          void *obj)
+{
+    unsigned int *array = (unsigned int *) value;
+
+    for (unsigned int i = 0; i < mca_btl_sm_component.num_endpoints; ++i) {
+        array[i] = mca_btl_sm_component.endpoints[i].fbox_out.size;
+    }
+
+    return OPAL_SUCCESS;
+}
+
+static int mca_btl_sm_fbox_pvar_read_counter(const struct mca_base_pvar_t *pvar, void *value,
+                                             void *obj)
+{
+    const size_t offset = (size_t) pvar->ctx;
+    unsigned long long *array = (unsigned long long *) value;
+
+    for (unsigned int i = 0; i < mca_btl_sm_component.num_endpoints; ++i) {
+        char *base = (char *) (mca_btl_sm_component.endpoints + i);
+        array[i] = *((uint64_t *) (base + offset));
+    }
+
+    return OPAL_SUCCESS;
+}
+
+void mca_btl_sm_register_peer_counter(const char *name, const char *desc, size_t offset)
+{
+    (void) mca_base_component_pvar_register(&mca_btl_sm_component.super.btl_version, name, desc,
+                                            OPAL_INFO_LVL_5, MCA_BASE_PVAR_CLASS_COUNTER,
+                                            MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL,
+                                            MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY
+                                                | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            mca_btl_sm_fbox_pvar_read_counter, NULL,
+                                            mca_btl_sm_fbox_pvar_notify, (void *) offset);
+}
+
+void mca_btl_sm_fbox_register_pvars(void)
+{
+    (void) mca_base_component_pvar_register(&mca_btl_sm_component.super.btl_version,
+                                            "fbox_peer_size",
+                                            "Size of the fast box used to send to each local "
+                                            "rank (0 if there is none)",
+                                            OPAL_INFO_LVL_5, MCA_BASE_PVAR_CLASS_SIZE,
+                                            MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL,
+                                            MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY
+                                                | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            mca_btl_sm_fbox_pvar_read_size, NULL,
+                                            mca_btl_sm_fbox_pvar_notify, NULL);
+
+    mca_btl_sm_register_peer_counter("fbox_peer_msgs",
+                                     "Number of messages sent to each local rank through a "
+                                     "fast box",
+                                     offsetof(mca_btl_base_endpoint_t, fbox_out.msgs));
+    mca_btl_sm_register_peer_counter("fbox_peer_bytes",
+                                     "Number of bytes sent to each local rank through a fast box",
+                                     offsetof(mca_btl_base_endpoint_t, fbox_out.bytes));
+    mca_btl_sm_register_peer_counter("fbox_peer_misses",
+                                     "Number of sends to each local rank that did not fit in its "
+                                     "fast box",
+                                     offsetof(mca_btl_base_endpoint_t, fbox_out.misses));
+    mca_btl_sm_register_peer_counter("fbox_peer_setups",
+                                     "Number of fast boxes set up to send to each local rank",
+                                     offsetof(mca_btl_base_endpoint_t, fbox_out.setups));
+}
@@ -29,17 +29,18 @@
  */
 
 static inline void mca_btl_sm_endpoint_setup_fbox_recv(struct mca_btl_base_endpoint_t *endpoint,
-                                                       void *base)
+                                                       void *base, unsigned int size)
 {
     endpoint->fbox_in.startp = (uint32_t *) base;
     endpoint->fbox_in.start = MCA_BTL_SM_FBOX_ALIGNMENT;
+    endpoint->fbox_in.size = size;
     endpoint->fbox_in.seq = 0;
     opal_atomic_wmb();
     endpoint->fbox_in.buffer = base;
 }
 
 static inline void mca_btl_sm_endpoint_setup_fbox_send(struct mca_btl_base_endpoint_t *endpoint,
-                                                       opal_free_list_item_t *fbox)
+                                                       opal_free_list_item_t *fbox, int fbox_class)
 {
     void *base = fbox->ptr;
 
@@ -49,6 +50,11 @@ static inline void mca_btl_sm_endpoint_setup_fbox_send(struct mca_btl_base_endpo
     endpoint->fbox_out.startp[0] = MCA_BTL_SM_FBOX_ALIGNMENT;
     endpoint->fbox_out.seq = 0;
     endpoint->fbox_out.fbox = fbox;
+    endpoint->fbox_out.fbox_class = fbox_class;
+    endpoint->fbox_out.size = mca_btl_sm_component.fbox_size << fbox_class;
+    endpoint->fbox_out.idle_samples = 0;
+    endpoint->fbox_out.small_samples = 0;
+    ++endpoint->fbox_out.setups;
 
     /* zero out the first header in the fast box */
     memset((char *) base + MCA_BTL_SM_FBOX_ALIGNMENT, 0, MCA_BTL_SM_FBOX_ALIGNMENT);
@@ -90,6 +96,10 @@ typedef union mca_btl_sm_fbox_hdr_t {
 /** macro for checking if the high bit is set */
 #define MCA_BTL_SM_FBOX_OFFSET_HBS(v) (!!((v) &MCA_BTL_SM_FBOX_HB_MASK))
 
+/** start offset written back by a receiver once it stopped polling a fast box. this can never be
+ * a valid offset as offsets are aligned */
+#define MCA_BTL_SM_FBOX_RELEASED 0xffffffffu
+
 void mca_btl_sm_poll_handle_frag(mca_btl_sm_hdr_t *hdr, mca_btl_base_endpoint_t *endpoint);
 
 static inline void mca_btl_sm_fbox_set_header(mca_btl_sm_fbox_hdr_t *hdr, uint16_t tag,
@@ -113,26 +123,19 @@ static inline mca_btl_sm_fbox_hdr_t mca_btl_sm_fbox_read_header(mca_btl_sm_fbox_
     return tmp;
 }
 
-/* attempt to reserve a contiguous segment from the remote ep */
-static inline bool mca_btl_sm_fbox_sendi(mca_btl_base_endpoint_t *ep, unsigned char tag,
+/* attempt to reserve a contiguous segment from the remote ep and write the fragment into it. must
+ * be called with the endpoint lock held and a fast box set up */
+static inline bool mca_btl_sm_fbox_write(mca_btl_base_endpoint_t *ep, unsigned char tag,
                                          void *restrict header, const size_t header_size,
                                          void *restrict payload, const size_t payload_size)
 {
-    const unsigned int fbox_size = mca_btl_sm_component.fbox_size;
+    const unsigned int fbox_size = ep->fbox_out.size;
     size_t size = header_size + payload_size;
     unsigned int start, end, buffer_free;
     size_t data_size = size;
     unsigned char *dst, *data;
     bool hbs, hbm;
 
-    /* don't try to use the per-peer buffer for messages that will fill up more than 25% of the
-     * buffer */
-    if (OPAL_UNLIKELY(NULL == ep->fbox_out.buffer || size > (fbox_size >> 2))) {
-        return false;
-    }
-
-    OPAL_THREAD_LOCK(&ep->lock);
-
     /* the high bit helps determine if the buffer is empty or full */
     hbs = MCA_BTL_SM_FBOX_OFFSET_HBS(ep->fbox_out.end);
     hbm = MCA_BTL_SM_FBOX_OFFSET_HBS(ep->fbox_out.start) == hbs;
@@ -185,7 +188,6 @@ static inline bool mca_btl_sm_fbox_sendi(mca_btl_base_endpoint_t *ep, unsigned c
         if (OPAL_UNLIKELY(buffer_free < size)) {
             ep->fbox_out.end = (hbs << 31) | end;
             opal_atomic_wmb();
-            OPAL_THREAD_UNLOCK(&ep->lock);
             return false;
         }
     }
@@ -196,7 +198,9 @@ static inline bool mca_btl_sm_fbox_sendi(mca_btl_base_endpoint_t *ep, unsigned c
 
     data = dst + sizeof(mca_btl_sm_fbox_hdr_t);
 
-    memcpy(data, header, header_size);
+    if (header_size) {
+        memcpy(data, header, header_size);
+    }
     if (payload) {
         /* inline sends are typically just pml headers (due to MCA_BTL_FLAGS_SEND_INPLACE) */
         memcpy(data + header_size, payload, payload_size);
@@ -219,22 +223,84 @@ static inline bool mca_btl_sm_fbox_sendi(mca_btl_base_endpoint_t *ep, unsigned c
     /* align the buffer */
     ep->fbox_out.end = ((uint32_t) hbs << 31) | end;
     opal_atomic_wmb();
-    OPAL_THREAD_UNLOCK(&ep->lock);
 
     return true;
 }
 
+static inline bool mca_btl_sm_fbox_sendi(mca_btl_base_endpoint_t *ep, unsigned char tag,
+                                         void *restrict header, const size_t header_size,
+                                         void *restrict payload, const size_t payload_size)
+{
+    const size_t size = header_size + payload_size;
+    bool ret;
+
+    if (OPAL_UNLIKELY(NULL == ep->fbox_out.buffer)) {
+        return false;
+    }
+
+    /* don't try to use the per-peer buffer for messages that will fill up more than 25% of the
+     * buffer */
+    if (OPAL_UNLIKELY(size > (ep->fbox_out.size >> 2))) {
+        ++ep->fbox_out.misses;
+        return false;
+    }
+
+    OPAL_THREAD_LOCK(&ep->lock);
+    /* the fast box may have been retired since the check above */
+    if (OPAL_UNLIKELY(NULL == ep->fbox_out.buffer)) {
+        OPAL_THREAD_UNLOCK(&ep->lock);
+        return false;
+    }
+
+    ret = mca_btl_sm_fbox_write(ep, tag, header, header_size, payload, payload_size);
+    if (OPAL_LIKELY(ret)) {
+        ++ep->fbox_out.msgs;
+        ep->fbox_out.bytes += size;
+    } else {
+        ++ep->fbox_out.misses;
+    }
+    OPAL_THREAD_UNLOCK(&ep->lock);
+
+    return ret;
+}
+
+/**
+ * Adaptive mode progress: finish retiring the fast boxes the peers released and periodically
+ * sample the traffic to each peer to resize or reclaim its fast box.
+ */
+int mca_btl_sm_fbox_adapt_progress(void);
+
+/** Drop the send fast box of an endpoint that is being destructed from the bookkeeping */
+void mca_btl_sm_fbox_forget(mca_btl_base_endpoint_t *ep);
+
+/** Register the btl_sm_fbox_peer_* performance variables */
+void mca_btl_sm_fbox_register_pvars(void);
+
+/**
+ * Register a performance variable holding one uint64_t counter per local rank, {offset} is the
+ * offset of the counter in mca_btl_base_endpoint_t.
+ */
+void mca_btl_sm_register_peer_counter(const char *name, const char *desc, size_t offset);
+
+/**
+ * Stop polling the fast box of a peer that retired it and hand it back to the peer. {index} is
+ * the position of the endpoint in mca_btl_sm_component.fbox_in_endpoints, the last endpoint of
+ * the array takes its place.
+ */
+void mca_btl_sm_fbox_release_recv(mca_btl_base_endpoint_t *ep, unsigned int index);
+
 static inline bool mca_btl_sm_check_fboxes(void)
 {
-    const unsigned int fbox_size = mca_btl_sm_component.fbox_size;
     bool processed = false;
 
     for (unsigned int i = 0; i < mca_btl_sm_component.num_fbox_in_endpoints; ++i) {
         mca_btl_base_endpoint_t *ep = mca_btl_sm_component.fbox_in_endpoints[i];
+        const unsigned int fbox_size = ep->fbox_in.size;
         unsigned int start = ep->fbox_in.start & MCA_BTL_SM_FBOX_OFFSET_MASK;
 
         /* save the current high bit state */
         bool hbs = MCA_BTL_SM_FBOX_OFFSET_HBS(ep->fbox_in.start);
+        bool released = false;
         int poll_count;
 
         for (poll_count = 0; poll_count <= MCA_BTL_SM_POLL_COUNT; ++poll_count) {
@@ -281,6 +347,11 @@ static inline bool mca_btl_sm_check_fboxes(void)
                 fifo_value_t *value = (fifo_value_t *) (ep->fbox_in.buffer + start + sizeof(hdr));
                 mca_btl_sm_hdr_t *sm_hdr = relative2virtual(*value);
                 mca_btl_sm_poll_handle_frag(sm_hdr, ep);
+            } else if (OPAL_UNLIKELY(0 == hdr.data.size)) {
+                /* an empty skip is the last message of a retired fast box (skips always cover at
+                 * least one header) */
+                released = true;
+                break;
             }
 
             start = (start + hdr.data.size + sizeof(hdr) + MCA_BTL_SM_FBOX_ALIGNMENT_MASK)
@@ -293,6 +364,14 @@ static inline bool mca_btl_sm_check_fboxes(void)
             }
         }
 
+        if (OPAL_UNLIKELY(released)) {
+            mca_btl_sm_fbox_release_recv(ep, i);
+            /* look at the endpoint that took this one's place */
+            --i;
+            processed = true;
+            continue;
+        }
+
         if (poll_count) {
             BTL_VERBOSE(("left off at offset %u (hbs: %d)", start, hbs));
 
@@ -308,32 +387,89 @@ static inline bool mca_btl_sm_check_fboxes(void)
     return processed;
 }
 
+/**
+ * Get a fast box for a peer. In adaptive mode the size class the peer asks for is used if it fits
+ * in the fast box memory budget, smaller classes are tried otherwise. Called with the component
+ * lock held.
+ */
+static inline opal_free_list_item_t *mca_btl_sm_fbox_alloc(mca_btl_base_endpoint_t *ep,
+                                                          int *fbox_class)
+{
+    mca_btl_sm_component_t *component = &mca_btl_sm_component;
+    opal_free_list_item_t *fbox;
+
+    if (!component->fbox_adaptive) {
+        *fbox_class = 0;
+        return opal_free_list_get(&component->sm_fboxes[0]);
+    }
+
+    for (int i = ep->fbox_out.want_class; i >= 0; --i) {
+        size_t size = (size_t) component->fbox_size << i;
+
+        if (component->fbox_bytes_used + size > component->fbox_bytes_max) {
+            continue;
+        }
+
+        fbox = opal_free_list_get(&component->sm_fboxes[i]);
+        if (NULL != fbox) {
+            component->fbox_bytes_used += size;
+            *fbox_class = i;
+            return fbox;
+        }
+    }
+
+    return NULL;
+}
+
 static inline void mca_btl_sm_try_fbox_setup(mca_btl_base_endpoint_t *ep, mca_btl_sm_hdr_t *hdr)
 {
     if (OPAL_UNLIKELY(NULL == ep->fbox_out.buffer
                       && mca_btl_sm_component.fbox_threshold
                              == OPAL_THREAD_ADD_FETCH_SIZE_T(&ep->send_count, 1))) {
+        bool done = false;
+
         /* protect access to mca_btl_sm_component.segment_offset */
         OPAL_THREAD_LOCK(&mca_btl_sm_component.lock);
 
         /* verify the remote side will accept another fbox */
         if (0 <= opal_atomic_add_fetch_32(&ep->fifo->fbox_available, -1)) {
-            opal_free_list_item_t *fbox = opal_free_list_get(&mca_btl_sm_component.sm_fboxes);
+            opal_free_list_item_t *fbox;
+            int fbox_class;
 
+            fbox = mca_btl_sm_fbox_alloc(ep, &fbox_class);
             if (NULL != fbox) {
+                if (MCA_BTL_SM_NUMA_RECEIVER == mca_btl_sm_component.numa_placement) {
+                    mca_btl_sm_numa_place_fbox(ep, fbox->ptr,
+                                               mca_btl_sm_component.fbox_size << fbox_class);
+                }
+
                 /* zero out the fast box */
-                memset(fbox->ptr, 0, mca_btl_sm_component.fbox_size);
-                mca_btl_sm_endpoint_setup_fbox_send(ep, fbox);
+                memset(fbox->ptr, 0, mca_btl_sm_component.fbox_size << fbox_class);
+                mca_btl_sm_endpoint_setup_fbox_send(ep, fbox, fbox_class);
+                mca_btl_sm_component
+                    .fbox_out_endpoints[mca_btl_sm_component.num_fbox_out_endpoints++] = ep;
 
                 hdr->flags |= MCA_BTL_SM_FLAG_SETUP_FBOX;
                 hdr->fbox_base = virtual2relative((char *) ep->fbox_out.buffer);
-            } else {
-                opal_atomic_add_fetch_32(&ep->fifo->fbox_available, 1);
+                hdr->fbox_size = ep->fbox_out.size;
+                done = true;
+
+                mca_btl_sm_event_data_t data = {.peer = ep->peer_smp_rank,
+                                                .bytes = ep->fbox_out.size};
+                mca_base_event_raise(mca_btl_sm_component.event_fbox_setup, NULL, &data);
             }
 
             opal_atomic_wmb();
         }
 
+        if (!done) {
+            opal_atomic_add_fetch_32(&ep->fifo->fbox_available, 1);
+            if (mca_btl_sm_component.fbox_adaptive) {
+                /* memory may be reclaimed from idle peers, try again later */
+                ep->send_count = 0;
+            }
+        }
+
         OPAL_THREAD_UNLOCK(&mca_btl_sm_component.lock);
     }
 }
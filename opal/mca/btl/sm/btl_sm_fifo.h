@@ -32,6 +32,7 @@
 #include "opal/mca/btl/sm/btl_sm_fbox.h"
 #include "opal/mca/btl/sm/btl_sm_types.h"
 #include "opal/mca/btl/sm/btl_sm_virtual.h"
+#include "opal/mca/timer/base/base.h"
 
 #define sm_item_compare_exchange(x, y, z)                                                   \
     opal_atomic_compare_exchange_strong_ptr((opal_atomic_intptr_t *) (x), (intptr_t *) (y), \
@@ -151,12 +152,21 @@ static inline void sm_fifo_write(sm_fifo_t *fifo, fifo_value_t value)
 static inline bool sm_fifo_write_ep(mca_btl_sm_hdr_t *hdr, struct mca_btl_base_endpoint_t *ep)
 {
     fifo_value_t rhdr = virtual2relative((char *) hdr);
+    if (OPAL_UNLIKELY(mca_btl_sm_component.numa_report)) {
+        hdr->frag->send_time = (uint64_t) opal_timer_base_get_cycles();
+    }
     if (ep->fbox_out.buffer) {
         /* if there is a fast box for this peer then use the fast box to send the fragment header.
          * this is done to ensure fragment ordering */
         opal_atomic_wmb();
         return mca_btl_sm_fbox_sendi(ep, 0xfe, &rhdr, sizeof(rhdr), NULL, 0);
     }
+    opal_atomic_rmb();
+    if (OPAL_UNLIKELY(ep->fbox_out.retiring)) {
+        /* the peer may still have fragments to read from the fast box. wait until it releases
+         * the fast box before using the fifo again */
+        return false;
+    }
     mca_btl_sm_try_fbox_setup(ep, hdr);
     hdr->next = SM_FIFO_FREE;
     sm_fifo_write(ep->fifo, rhdr);
@@ -99,8 +99,7 @@ int mca_btl_sm_get_cma(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endp
      * return any value.
      */
     do {
-        ret = process_vm_readv(endpoint->segment_data.other.seg_ds->seg_cpid, &dst_iov, 1, &src_iov,
-                               1, 0);
+        ret = process_vm_readv(mca_btl_sm_endpoint_pid(endpoint), &dst_iov, 1, &src_iov, 1, 0);
         if (0 > ret) {
             if (ESRCH == errno) {
                 BTL_PEER_ERROR(NULL, ("CMA read %ld, expected %lu, errno = %d\n", (long) ret,
@@ -171,3 +170,21 @@ int mca_btl_sm_get_knem(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *end
     return OPAL_SUCCESS;
 }
 #endif
+
+#if OPAL_BTL_SM_HAVE_XPMEM && OPAL_BTL_SM_HAVE_CMA
+int mca_btl_sm_get_auto(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpoint,
+                        void *local_address, uint64_t remote_address,
+                        mca_btl_base_registration_handle_t *local_handle,
+                        mca_btl_base_registration_handle_t *remote_handle, size_t size, int flags,
+                        int order, mca_btl_base_rdma_completion_fn_t cbfunc, void *cbcontext,
+                        void *cbdata)
+{
+    if (mca_btl_sm_xpmem_prefer(endpoint, remote_address, size)) {
+        return mca_btl_sm_get_xpmem(btl, endpoint, local_address, remote_address, local_handle,
+                                    remote_handle, size, flags, order, cbfunc, cbcontext, cbdata);
+    }
+
+    return mca_btl_sm_get_cma(btl, endpoint, local_address, remote_address, local_handle,
+                              remote_handle, size, flags, order, cbfunc, cbcontext, cbdata);
+}
+#endif
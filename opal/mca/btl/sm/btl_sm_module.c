@@ -30,6 +30,7 @@
 
 #include "opal_config.h"
 #include "opal/util/show_help.h"
+#include "opal/util/sys_limits.h"
 
 #include "opal/mca/btl/sm/btl_sm.h"
 #include "opal/mca/btl/sm/btl_sm_endpoint.h"
@@ -88,6 +89,7 @@ static void sm_btl_exit(mca_btl_sm_t *btl)
 static int sm_btl_first_time_init(mca_btl_sm_t *sm_btl, int n)
 {
     mca_btl_sm_component_t *component = &mca_btl_sm_component;
+    size_t fbox_alignment;
     int rc;
 
     /* generate the endpoints */
@@ -97,6 +99,7 @@ static int sm_btl_first_time_init(mca_btl_sm_t *sm_btl, int n)
         return OPAL_ERR_OUT_OF_RESOURCE;
     }
     component->endpoints[n].peer_smp_rank = -1;
+    component->num_endpoints = n;
 
     component->fbox_in_endpoints = calloc(n + 1, sizeof(void *));
     if (NULL == component->fbox_in_endpoints) {
@@ -104,6 +107,13 @@ static int sm_btl_first_time_init(mca_btl_sm_t *sm_btl, int n)
         return OPAL_ERR_OUT_OF_RESOURCE;
     }
 
+    component->fbox_out_endpoints = calloc(n + 1, sizeof(void *));
+    if (NULL == component->fbox_out_endpoints) {
+        free(component->fbox_in_endpoints);
+        free(component->endpoints);
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
     component->mpool = mca_mpool_basic_create((void *) (component->my_segment
                                                         + MCA_BTL_SM_FIFO_SIZE),
                                               (unsigned long) (mca_btl_sm_component.segment_size
@@ -114,12 +124,22 @@ static int sm_btl_first_time_init(mca_btl_sm_t *sm_btl, int n)
         return OPAL_ERR_OUT_OF_RESOURCE;
     }
 
-    rc = opal_free_list_init(&component->sm_fboxes, sizeof(opal_free_list_item_t), 8,
-                             OBJ_CLASS(opal_free_list_item_t), mca_btl_sm_component.fbox_size,
-                             opal_cache_line_size, 0, mca_btl_sm_component.fbox_max, 4,
-                             component->mpool, 0, NULL, NULL, NULL);
-    if (OPAL_SUCCESS != rc) {
-        return rc;
+    /* fast boxes that are moved to their receiver must not share pages */
+    fbox_alignment = (MCA_BTL_SM_NUMA_RECEIVER == component->numa_placement)
+                         ? (size_t) opal_getpagesize()
+                         : opal_cache_line_size;
+
+    for (int i = 0; i < component->fbox_num_classes; ++i) {
+        /* the larger classes are bounded by the memory budget (see mca_btl_sm_fbox_alloc) */
+        unsigned int fbox_max = component->fbox_max >> i;
+
+        rc = opal_free_list_init(&component->sm_fboxes[i], sizeof(opal_free_list_item_t), 8,
+                                 OBJ_CLASS(opal_free_list_item_t), component->fbox_size << i,
+                                 fbox_alignment, 0, fbox_max ? fbox_max : 1, i ? 1 : 4,
+                                 component->mpool, 0, NULL, NULL, NULL);
+        if (OPAL_SUCCESS != rc) {
+            return rc;
+        }
     }
 
     /* initialize fragment descriptor free lists */
@@ -195,6 +215,9 @@ static int init_sm_endpoint(struct mca_btl_base_endpoint_t **ep_out, struct opal
     OBJ_CONSTRUCT(ep, mca_btl_sm_endpoint_t);
 
     ep->peer_smp_rank = peer_local_rank;
+    ep->numa_node = (peer_local_rank == MCA_BTL_SM_LOCAL_RANK)
+                        ? component->numa_node
+                        : mca_btl_sm_numa_peer_node(&proc->proc_name);
 
     if (peer_local_rank != MCA_BTL_SM_LOCAL_RANK) {
         OPAL_MODEX_RECV_IMMEDIATE(rc, &component->super.btl_version, &proc->proc_name,
@@ -210,6 +233,7 @@ static int init_sm_endpoint(struct mca_btl_base_endpoint_t **ep_out, struct opal
             ep->segment_data.xpmem.apid = xpmem_get(modex->xpmem.seg_id, XPMEM_RDWR,
                                                     XPMEM_PERMIT_MODE, (void *) 0666);
             ep->segment_data.xpmem.address_max = modex->xpmem.address_max;
+            ep->segment_data.xpmem.pid = modex->xpmem.pid;
             (void) sm_get_registation(ep, modex->xpmem.segment_base,
                                       mca_btl_sm_component.segment_size, MCA_RCACHE_FLAGS_PERSIST,
                                       (void **) &ep->segment_base);
@@ -403,18 +427,25 @@ static int sm_finalize(struct mca_btl_base_module_t *btl)
         return OPAL_SUCCESS;
     }
 
+    mca_btl_sm_numa_report();
+
     for (int i = 0; i < (int) (1 + MCA_BTL_SM_NUM_LOCAL_PEERS); ++i) {
         fini_sm_endpoint(component->endpoints + i);
     }
 
     free(component->endpoints);
     component->endpoints = NULL;
+    component->num_endpoints = 0;
 
     sm_btl->btl_inited = false;
 
     free(component->fbox_in_endpoints);
     component->fbox_in_endpoints = NULL;
 
+    free(component->fbox_out_endpoints);
+    component->fbox_out_endpoints = NULL;
+    component->num_fbox_out_endpoints = 0;
+
     if (MCA_BTL_SM_XPMEM != mca_btl_sm_component.single_copy_mechanism) {
         opal_shmem_unlink(&mca_btl_sm_component.seg_ds);
         opal_shmem_segment_detach(&mca_btl_sm_component.seg_ds);
@@ -586,6 +617,18 @@ static void mca_btl_sm_endpoint_constructor(mca_btl_sm_endpoint_t *ep)
     OBJ_CONSTRUCT(&ep->pending_frags_lock, opal_mutex_t);
     ep->fifo = NULL;
     ep->fbox_out.fbox = NULL;
+    ep->fbox_out.size = 0;
+    ep->fbox_out.want_class = 0;
+    ep->fbox_out.retiring = false;
+#if OPAL_BTL_SM_HAVE_XPMEM
+    memset(ep->sc_seen, 0, sizeof(ep->sc_seen));
+    OBJ_CONSTRUCT(&ep->xpmem_cache.lock, opal_mutex_t);
+    OBJ_CONSTRUCT(&ep->xpmem_cache.lru, opal_list_t);
+    ep->xpmem_cache.bytes = 0;
+    ep->xpmem_cache.hits = 0;
+    ep->xpmem_cache.misses = 0;
+    ep->xpmem_cache.evictions = 0;
+#endif
 }
 
 #if OPAL_BTL_SM_HAVE_XPMEM
@@ -615,12 +658,19 @@ static void mca_btl_sm_endpoint_destructor(mca_btl_sm_endpoint_t *ep)
         /* disconnect from the peer's segment */
         opal_shmem_segment_detach(&seg_ds);
     }
+#if OPAL_BTL_SM_HAVE_XPMEM
+    OBJ_DESTRUCT(&ep->xpmem_cache.lru);
+    OBJ_DESTRUCT(&ep->xpmem_cache.lock);
+#endif
     if (ep->fbox_out.fbox) {
-        opal_free_list_return(&mca_btl_sm_component.sm_fboxes, ep->fbox_out.fbox);
+        mca_btl_sm_fbox_forget(ep);
+        opal_free_list_return(&mca_btl_sm_component.sm_fboxes[ep->fbox_out.fbox_class],
+                              ep->fbox_out.fbox);
     }
 
     ep->fbox_in.buffer = ep->fbox_out.buffer = NULL;
     ep->fbox_out.fbox = NULL;
+    ep->fbox_out.size = 0;
     ep->segment_base = NULL;
     ep->fifo = NULL;
 }
@@ -0,0 +1,237 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2021      Google, LLC. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * NUMA placement of the shared memory segment (btl_sm_numa_placement).
+ *
+ * Everything the sm btl shares lives in the segment of one process: its
+ * receive fifo (polled by the owner), the fragments it sends (read once by
+ * the receiver) and the fast boxes it sends through (polled by the
+ * receiver). With the "local" policy the segment is bound to the NUMA node
+ * of the owner. The "receiver" policy additionally moves each fast box to
+ * the NUMA node of the peer that polls it when the fast box is set up, so
+ * that the receiver spins on local memory and only the sender crosses the
+ * interconnect once per message.
+ *
+ * btl_sm_numa_report measures the round trip time of the fragments (from
+ * the time they are posted to the time the receiver returns them) for each
+ * NUMA node the peers are bound to, and prints it at finalize.
+ */
+
+#include "opal_config.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "opal/mca/hwloc/base/base.h"
+#include "opal/mca/timer/base/base.h"
+#include "opal/util/output.h"
+
+#include "opal/mca/btl/sm/btl_sm.h"
+#include "opal/mca/btl/sm/btl_sm_frag.h"
+
+/* logical index of the NUMA node a process is bound to, -1 if it is not bound to exactly one */
+static int mca_btl_sm_numa_node_of(opal_process_name_t *name)
+{
+    const opal_hwloc_base_local_proc_t *proc = opal_hwloc_base_locality_lookup(name);
+    char *loc = NULL, *numa;
+    int rc, node = -1;
+
+    if (NULL != proc) {
+        return proc->numa;
+    }
+
+    /* not one of the local peers of the job (e.g. spawned) */
+    OPAL_MODEX_RECV_VALUE_OPTIONAL(rc, PMIX_LOCALITY_STRING, name, &loc, PMIX_STRING);
+    if (OPAL_SUCCESS != rc || NULL == loc) {
+        return -1;
+    }
+
+    numa = opal_hwloc_base_get_location(loc, HWLOC_OBJ_NODE, 0);
+    if (NULL != numa && NULL == strchr(numa, ',') && NULL == strchr(numa, '-')) {
+        node = (int) strtoul(numa, NULL, 10);
+    }
+
+    free(numa);
+    free(loc);
+
+    return node;
+}
+
+/* NUMA node of this process when the locality string is not available */
+static int mca_btl_sm_numa_node_of_self(void)
+{
+    int node = -1;
+
+    if (NULL == opal_hwloc_my_cpuset) {
+        return -1;
+    }
+
+    for (int i = 0; i < mca_btl_sm_component.num_numa_nodes; ++i) {
+        hwloc_obj_t obj = opal_hwloc_base_get_obj_by_type(opal_hwloc_topology, HWLOC_OBJ_NODE, 0,
+                                                          i, OPAL_HWLOC_AVAILABLE);
+        if (NULL == obj || !hwloc_bitmap_intersects(obj->cpuset, opal_hwloc_my_cpuset)) {
+            continue;
+        }
+
+        if (-1 != node) {
+            /* bound to more than one NUMA node */
+            return -1;
+        }
+
+        node = i;
+    }
+
+    return node;
+}
+
+static int mca_btl_sm_numa_bind(void *base, size_t size, int node, int flags)
+{
+    hwloc_obj_t obj;
+
+    obj = opal_hwloc_base_get_obj_by_type(opal_hwloc_topology, HWLOC_OBJ_NODE, 0, node,
+                                          OPAL_HWLOC_AVAILABLE);
+    if (NULL == obj) {
+        return OPAL_ERR_NOT_FOUND;
+    }
+
+    if (0 != hwloc_set_area_membind(opal_hwloc_topology, base, size, obj->cpuset,
+                                    HWLOC_MEMBIND_BIND, flags)) {
+        BTL_VERBOSE(("could not bind %lu bytes at %p to NUMA node %d", (unsigned long) size,
+                     base, node));
+        return OPAL_ERROR;
+    }
+
+    return OPAL_SUCCESS;
+}
+
+int mca_btl_sm_numa_init(void)
+{
+    mca_btl_sm_component_t *component = &mca_btl_sm_component;
+
+    component->numa_node = -1;
+    component->num_numa_nodes = 0;
+    component->numa_latency = NULL;
+
+    if (MCA_BTL_SM_NUMA_NONE == component->numa_placement && !component->numa_report) {
+        return OPAL_SUCCESS;
+    }
+
+    if (OPAL_SUCCESS != opal_hwloc_base_get_topology()) {
+        BTL_VERBOSE(("no topology available, NUMA placement disabled"));
+        component->numa_placement = MCA_BTL_SM_NUMA_NONE;
+    } else {
+        component->num_numa_nodes = (int) opal_hwloc_base_get_nbobjs_by_type(opal_hwloc_topology,
+                                                                             HWLOC_OBJ_NODE, 0,
+                                                                             OPAL_HWLOC_AVAILABLE);
+        component->numa_node = mca_btl_sm_numa_node_of(&OPAL_PROC_MY_NAME);
+        if (-1 == component->numa_node) {
+            component->numa_node = mca_btl_sm_numa_node_of_self();
+        }
+    }
+
+    if (component->numa_report) {
+        component->numa_latency = calloc(component->num_numa_nodes + 1,
+                                         sizeof(component->numa_latency[0]));
+        if (NULL == component->numa_latency) {
+            component->numa_report = false;
+        }
+    }
+
+    if (MCA_BTL_SM_NUMA_NONE == component->numa_placement) {
+        return OPAL_SUCCESS;
+    }
+
+    if (-1 == component->numa_node) {
+        /* nothing to bind the segment to. the fast boxes can still be moved to their receiver */
+        BTL_VERBOSE(("process is not bound to a single NUMA node, the segment is not bound"));
+        return OPAL_SUCCESS;
+    }
+
+    /* nothing was written to the segment yet so there is nothing to migrate */
+    (void) mca_btl_sm_numa_bind(component->my_segment, component->segment_size,
+                                component->numa_node, 0);
+
+    return OPAL_SUCCESS;
+}
+
+int mca_btl_sm_numa_peer_node(opal_process_name_t *name)
+{
+    if (MCA_BTL_SM_NUMA_NONE == mca_btl_sm_component.numa_placement
+        && !mca_btl_sm_component.numa_report) {
+        return -1;
+    }
+
+    return mca_btl_sm_numa_node_of(name);
+}
+
+void mca_btl_sm_numa_place_fbox(mca_btl_base_endpoint_t *ep, void *base, size_t size)
+{
+    if (-1 == ep->numa_node || ep->numa_node == mca_btl_sm_component.numa_node) {
+        return;
+    }
+
+    /* the fast box may have been used for another peer, move its pages */
+    (void) mca_btl_sm_numa_bind(base, size, ep->numa_node, HWLOC_MEMBIND_MIGRATE);
+}
+
+void mca_btl_sm_numa_record(mca_btl_sm_frag_t *frag)
+{
+    mca_btl_sm_component_t *component = &mca_btl_sm_component;
+    const uint64_t rtt = (uint64_t) opal_timer_base_get_cycles() - frag->send_time;
+    int node = frag->endpoint->numa_node;
+    mca_btl_sm_numa_latency_t *latency;
+
+    if (node < 0 || node >= component->num_numa_nodes) {
+        node = component->num_numa_nodes;
+    }
+
+    latency = component->numa_latency + node;
+    if (0 == latency->count || rtt < latency->min) {
+        latency->min = rtt;
+    }
+    latency->total += rtt;
+    ++latency->count;
+}
+
+void mca_btl_sm_numa_report(void)
+{
+    mca_btl_sm_component_t *component = &mca_btl_sm_component;
+    const double freq = (double) opal_timer_base_get_freq() / 1000000.0;
+
+    if (NULL == component->numa_latency) {
+        return;
+    }
+
+    for (int i = 0; i <= component->num_numa_nodes; ++i) {
+        mca_btl_sm_numa_latency_t *latency = component->numa_latency + i;
+        char node[16] = "unknown";
+
+        if (0 == latency->count) {
+            continue;
+        }
+
+        if (i < component->num_numa_nodes) {
+            snprintf(node, sizeof(node), "%d", i);
+        }
+
+        opal_output(0,
+                    "btl/sm: local rank %d (NUMA node %d) -> NUMA node %s: %" PRIu64
+                    " fragments, round trip min %.2f usec, avg %.2f usec",
+                    MCA_BTL_SM_LOCAL_RANK, component->numa_node, node, latency->count,
+                    (double) latency->min / freq,
+                    (double) latency->total / (double) latency->count / freq);
+    }
+
+    free(component->numa_latency);
+    component->numa_latency = NULL;
+}
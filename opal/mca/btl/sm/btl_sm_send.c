@@ -57,6 +57,10 @@ int mca_btl_sm_send(struct mca_btl_base_module_t *btl, struct mca_btl_base_endpo
 
     /* post the relative address of the descriptor into the peer's fifo */
     if (opal_list_get_size(&endpoint->pending_frags) || !sm_fifo_write_ep(frag->hdr, endpoint)) {
+        mca_btl_sm_event_data_t data = {.peer = endpoint->peer_smp_rank, .bytes = total_size};
+
+        mca_base_event_raise(mca_btl_sm_component.event_send_pending, NULL, &data);
+
         if (frag->base.des_cbfunc) {
             frag->base.des_flags |= MCA_BTL_DES_SEND_ALWAYS_CALLBACK;
         }
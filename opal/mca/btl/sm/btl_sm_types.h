@@ -34,6 +34,7 @@
 
 #include "opal_config.h"
 #include "opal/class/opal_free_list.h"
+#include "opal/mca/base/mca_base_event.h"
 #include "opal/mca/btl/btl.h"
 
 #if OPAL_BTL_SM_HAVE_XPMEM
@@ -59,6 +60,7 @@ union sm_modex_t {
         xpmem_segid_t seg_id;
         void *segment_base;
         uintptr_t address_max;
+        pid_t pid;
     } xpmem;
 #endif
     struct sm_modex_other_t {
@@ -69,6 +71,38 @@ union sm_modex_t {
     } other;
 };
 
+/**
+ * Number of fast box size classes. Class i fast boxes are fbox_size << i bytes, only the first
+ * class is used unless btl_sm_fbox_adaptive is set.
+ */
+#define MCA_BTL_SM_FBOX_CLASSES 5
+
+/**
+ * Number of remote buffers each endpoint remembers to detect the ones that are reused
+ * (btl_sm_single_copy_auto)
+ */
+#define MCA_BTL_SM_SC_SEEN_SIZE 32
+
+/**
+ * NUMA placement policies (btl_sm_numa_placement)
+ */
+enum {
+    MCA_BTL_SM_NUMA_NONE = 0, /**< leave the placement to the first touch */
+    MCA_BTL_SM_NUMA_LOCAL,    /**< bind the whole segment to the NUMA node of this process */
+    MCA_BTL_SM_NUMA_RECEIVER, /**< same as local except each fast box is bound to the NUMA node
+                               *   of the peer that polls it */
+};
+
+/**
+ * Round trip times of the fragments sent to the ranks of a NUMA node (btl_sm_numa_report)
+ */
+struct mca_btl_sm_numa_latency_t {
+    uint64_t count;
+    uint64_t total; /**< sum of the round trip times (timer cycles) */
+    uint64_t min;   /**< shortest round trip time (timer cycles) */
+};
+typedef struct mca_btl_sm_numa_latency_t mca_btl_sm_numa_latency_t;
+
 /**
  * Single copy mechanisms
  */
@@ -87,6 +121,7 @@ typedef struct mca_btl_base_endpoint_t {
         unsigned char *buffer; /**< starting address of peer's fast box out */
         uint32_t *startp;
         unsigned int start;
+        unsigned int size; /**< size of the fast box */
         uint16_t seq;
     } fbox_in;
 
@@ -96,10 +131,24 @@ typedef struct mca_btl_base_endpoint_t {
         unsigned int start, end;
         uint16_t seq;
         opal_free_list_item_t *fbox; /**< fast-box free list item */
+        unsigned int size;           /**< size of the fast box (0 if there is none) */
+        int fbox_class;              /**< size class of the fast box */
+        int want_class;              /**< size class to ask for at the next setup */
+        bool retiring;               /**< waiting for the peer to release the fast box */
+        unsigned int idle_samples;   /**< consecutive samples without traffic */
+        unsigned int small_samples;  /**< consecutive samples that would fit a smaller box */
+        /* statistics (exported as btl_sm_fbox_peer_* performance variables) */
+        uint64_t msgs;   /**< messages sent through fast boxes */
+        uint64_t bytes;  /**< bytes sent through fast boxes */
+        uint64_t misses; /**< sends that fell back to the fifo while a fast box was set up */
+        uint64_t setups; /**< number of fast boxes set up for this peer */
+        /* values of the statistics at the last sample (adaptive mode) */
+        uint64_t sample_msgs, sample_bytes, sample_misses;
     } fbox_out;
 
     uint16_t peer_smp_rank;        /**< my peer's SMP process rank.  Used for accessing
                                     *   SMP specfic data structures. */
+    int numa_node;                 /**< NUMA node the peer is bound to (-1 if unknown) */
     opal_atomic_size_t send_count; /**< number of fragments sent to this peer */
     char *segment_base;            /**< start of the peer's segment (in the address space
                                     *   of this process) */
@@ -114,6 +163,8 @@ typedef struct mca_btl_base_endpoint_t {
         struct {
             xpmem_apid_t apid;     /**< xpmem apid for remote peer */
             uintptr_t address_max; /**< largest address that can be attached */
+            pid_t pid;             /**< pid of remote peer (used for CMA with
+                                    *   btl_sm_single_copy_auto) */
         } xpmem;
 #endif
         struct {
@@ -125,6 +176,24 @@ typedef struct mca_btl_base_endpoint_t {
     opal_mutex_t pending_frags_lock; /**< protect pending_frags */
     opal_list_t pending_frags;       /**< fragments pending fast box space */
     bool waiting;                    /**< endpoint is on the component wait list */
+
+#if OPAL_BTL_SM_HAVE_XPMEM
+    /** remote buffers recently transferred with CMA and how many times (single copy auto) */
+    struct {
+        uintptr_t address;
+        unsigned int count;
+    } sc_seen[MCA_BTL_SM_SC_SEEN_SIZE];
+
+    /** attachments of the peer memory, least recently used first */
+    struct {
+        opal_mutex_t lock;  /**< protects the list, the size and the statistics */
+        opal_list_t lru;    /**< cached registrations (not the persistent segment) */
+        size_t bytes;       /**< bytes attached in the registrations on the lru */
+        uint64_t hits;      /**< lookups satisfied by a cached attachment */
+        uint64_t misses;    /**< lookups that needed a new attachment */
+        uint64_t evictions; /**< attachments dropped to honor btl_sm_xpmem_cache_size */
+    } xpmem_cache;
+#endif
 } mca_btl_base_endpoint_t;
 
 typedef mca_btl_base_endpoint_t mca_btl_sm_endpoint_t;
@@ -153,14 +222,35 @@ struct mca_btl_sm_component_t {
     opal_free_list_t sm_frags_eager;    /**< free list of sm send frags */
     opal_free_list_t sm_frags_max_send; /**< free list of sm max send frags (large fragments) */
     opal_free_list_t sm_frags_user;     /**< free list of small inline frags */
-    opal_free_list_t sm_fboxes;         /**< free list of available fast-boxes */
+    opal_free_list_t sm_fboxes[MCA_BTL_SM_FBOX_CLASSES]; /**< free lists of available fast-boxes
+                                                          *   (one per size class) */
 
     unsigned int
         fbox_threshold; /**< number of sends required before we setup a send fast box for a peer */
     unsigned int fbox_max;  /**< maximum number of send fast boxes to allocate */
     unsigned int fbox_size; /**< size of each peer fast box allocation */
 
+    bool fbox_adaptive;               /**< resize and reclaim fast boxes based on traffic */
+    unsigned int fbox_max_size;       /**< largest fast box in adaptive mode */
+    unsigned int fbox_adapt_interval; /**< time between two traffic samples (usec) */
+    unsigned int fbox_idle_timeout;   /**< time after which an idle fast box is reclaimed (usec) */
+    int fbox_num_classes;             /**< number of fast box size classes in use */
+    size_t fbox_bytes_max;            /**< fast box memory budget (adaptive mode) */
+    size_t fbox_bytes_used;           /**< fast box memory in use (adaptive mode) */
+    uint64_t fbox_last_sample;        /**< time of the last traffic sample */
+
     int single_copy_mechanism; /**< single copy mechanism to use */
+    bool single_copy_auto;     /**< choose between xpmem and CMA for each transfer */
+    size_t xpmem_attach_min;   /**< smallest transfer that is always done with xpmem */
+    unsigned int xpmem_reuse_min; /**< transfers of a remote buffer before it is attached */
+    size_t xpmem_cache_size;   /**< maximum bytes attached per peer (0 = no limit) */
+
+    int numa_placement;        /**< NUMA placement policy of the segment and fast boxes */
+    int numa_node;             /**< NUMA node this process is bound to (-1 if unknown) */
+    int num_numa_nodes;        /**< number of NUMA nodes on this host */
+    bool numa_report;          /**< measure the round trip time to each NUMA node */
+    mca_btl_sm_numa_latency_t *numa_latency; /**< round trip times per NUMA node (the last
+                                              *   entry is for peers on an unknown node) */
 
     int memcpy_limit;             /**< Limit where we switch from memmove to memcpy */
     int log_attach_align;         /**< Log of the alignment for xpmem segments */
@@ -168,9 +258,13 @@ struct mca_btl_sm_component_t {
 
     mca_btl_base_endpoint_t
         *endpoints; /**< array of local endpoints (one for each local peer including myself) */
-    mca_btl_base_endpoint_t **fbox_in_endpoints; /**< array of fast box in endpoints */
-    unsigned int num_fbox_in_endpoints;          /**< number of fast boxes to poll */
-    struct sm_fifo_t *my_fifo;                   /**< pointer to the local fifo */
+    mca_btl_base_endpoint_t **fbox_in_endpoints;  /**< array of fast box in endpoints */
+    unsigned int num_fbox_in_endpoints;           /**< number of fast boxes to poll */
+    mca_btl_base_endpoint_t **fbox_out_endpoints; /**< array of fast box out endpoints */
+    unsigned int num_fbox_out_endpoints;          /**< number of fast boxes set up for peers */
+    unsigned int num_fbox_retiring;               /**< fast boxes waiting to be released */
+    unsigned int num_endpoints;                   /**< size of the endpoints array */
+    struct sm_fifo_t *my_fifo;                    /**< pointer to the local fifo */
 
     opal_list_t pending_endpoints; /**< list of endpoints with pending fragments */
     opal_list_t pending_fragments; /**< fragments pending remote completion */
@@ -182,9 +276,18 @@ struct mca_btl_sm_component_t {
     unsigned int knem_dma_min; /**< minimum size to enable DMA for knem transfers (0 disables) */
 #endif
     mca_mpool_base_module_t *mpool;
+
+    /* MPI_T events, raised with a mca_btl_sm_event_data_t */
+    mca_base_event_t *event_send_pending; /**< a send waits for room in the fifo of a peer */
+    mca_base_event_t *event_fbox_setup;   /**< a fast box was set up for a peer */
 };
 typedef struct mca_btl_sm_component_t mca_btl_sm_component_t;
 
+typedef struct mca_btl_sm_event_data_t {
+    int peer;     /**< SMP rank of the peer */
+    size_t bytes; /**< size of the fragment or of the fast box */
+} mca_btl_sm_event_data_t;
+
 /**
  * SM BTL Interface
  */
@@ -246,6 +349,8 @@ struct mca_btl_sm_hdr_t {
     struct iovec sc_iov;
     /** if the fragment indicates to setup a fast box the base is stored here */
     intptr_t fbox_base;
+    /** size of the fast box to setup */
+    uint32_t fbox_size;
 };
 typedef struct mca_btl_sm_hdr_t mca_btl_sm_hdr_t;
 
@@ -263,6 +368,8 @@ struct mca_btl_sm_frag_t {
     mca_btl_sm_hdr_t *hdr;
     /** free list this fragment was allocated within */
     opal_free_list_t *my_list;
+    /** time the fragment was posted (only with btl_sm_numa_report) */
+    uint64_t send_time;
     /** rdma callback data */
     struct mca_btl_sm_rdma_cbdata_t {
         void *local_address;
@@ -15,6 +15,7 @@
  */
 
 #include "opal/mca/btl/sm/btl_sm.h"
+#include "opal/mca/btl/sm/btl_sm_fbox.h"
 
 #include "opal/include/opal/align.h"
 #include "opal/mca/memchecker/base/base.h"
@@ -117,6 +118,75 @@ static int sm_check_reg(mca_rcache_base_registration_t *reg, void *ctx)
     return 2;
 }
 
+/* the registrations on the lru hold one reference (the cache reference). it is dropped by the
+ * thread that marks the registration invalid, which also takes it off the lru. */
+
+static void sm_xpmem_cache_touch(struct mca_btl_base_endpoint_t *ep,
+                                 mca_rcache_base_registration_t *reg)
+{
+    OPAL_THREAD_LOCK(&ep->xpmem_cache.lock);
+    if (!(MCA_RCACHE_FLAGS_INVALID & reg->flags)) {
+        opal_list_remove_item(&ep->xpmem_cache.lru, &reg->super.super);
+        opal_list_append(&ep->xpmem_cache.lru, &reg->super.super);
+    }
+    ++ep->xpmem_cache.hits;
+    OPAL_THREAD_UNLOCK(&ep->xpmem_cache.lock);
+}
+
+/* take an invalidated registration off the lru, the caller drops the cache reference */
+static void sm_xpmem_cache_remove(struct mca_btl_base_endpoint_t *ep,
+                                  mca_rcache_base_registration_t *reg)
+{
+    OPAL_THREAD_LOCK(&ep->xpmem_cache.lock);
+    opal_list_remove_item(&ep->xpmem_cache.lru, &reg->super.super);
+    ep->xpmem_cache.bytes -= (size_t)(reg->bound - reg->base);
+    OPAL_THREAD_UNLOCK(&ep->xpmem_cache.lock);
+}
+
+/* add a new registration to the lru and evict the least recently used ones over the limit */
+static void sm_xpmem_cache_add(struct mca_btl_base_endpoint_t *ep,
+                               mca_rcache_base_registration_t *reg)
+{
+    const size_t limit = mca_btl_sm_component.xpmem_cache_size;
+    mca_rcache_base_registration_t *victim, *next;
+    opal_list_t evicted;
+
+    OBJ_CONSTRUCT(&evicted, opal_list_t);
+
+    OPAL_THREAD_LOCK(&ep->xpmem_cache.lock);
+    opal_list_append(&ep->xpmem_cache.lru, &reg->super.super);
+    ep->xpmem_cache.bytes += (size_t)(reg->bound - reg->base);
+    ++ep->xpmem_cache.misses;
+
+    if (0 != limit) {
+        OPAL_LIST_FOREACH_SAFE (victim, next, &ep->xpmem_cache.lru,
+                                mca_rcache_base_registration_t) {
+            if (ep->xpmem_cache.bytes <= limit || victim == reg) {
+                break;
+            }
+
+            if (MCA_RCACHE_FLAGS_INVALID
+                & opal_atomic_fetch_or_32(&victim->flags, MCA_RCACHE_FLAGS_INVALID)) {
+                /* being coalesced by another thread, it will take it off the lru */
+                continue;
+            }
+
+            opal_list_remove_item(&ep->xpmem_cache.lru, &victim->super.super);
+            ep->xpmem_cache.bytes -= (size_t)(victim->bound - victim->base);
+            ++ep->xpmem_cache.evictions;
+            opal_list_append(&evicted, &victim->super.super);
+        }
+    }
+    OPAL_THREAD_UNLOCK(&ep->xpmem_cache.lock);
+
+    /* detach outside of the lock. registrations still in use are detached by their last user */
+    while (NULL != (victim = (mca_rcache_base_registration_t *) opal_list_remove_first(&evicted))) {
+        sm_return_registration(victim, ep);
+    }
+
+    OBJ_DESTRUCT(&evicted);
+}
+
 void sm_return_registration(mca_rcache_base_registration_t *reg, struct mca_btl_base_endpoint_t *ep)
 {
     mca_rcache_base_vma_module_t *vma_module = mca_btl_sm_component.vma_module;
@@ -162,9 +232,12 @@ mca_rcache_base_registration_t *sm_get_registation(struct mca_btl_base_endpoint_
     /* several segments may match the base pointer */
     rc = mca_rcache_base_vma_iterate(vma_module, (void *) base, bound - base, true, sm_check_reg,
                                      &check_ctx);
-    if (2 == rc) {
+    if (1 == rc) {
+        sm_xpmem_cache_touch(ep, reg);
+    } else if (2 == rc) {
         bound = bound < (uintptr_t) reg->bound ? (uintptr_t) reg->bound : bound;
         base = base > (uintptr_t) reg->base ? (uintptr_t) reg->base : base;
+        sm_xpmem_cache_remove(ep, reg);
         sm_return_registration(reg, ep);
         reg = NULL;
     }
@@ -195,6 +268,8 @@ mca_rcache_base_registration_t *sm_get_registation(struct mca_btl_base_endpoint_
             opal_memchecker_base_mem_defined(reg->rcache_context, bound - base);
 
             if (!(flags & MCA_RCACHE_FLAGS_PERSIST)) {
+                /* on the lru before it can be found in the vma tree */
+                sm_xpmem_cache_add(ep, reg);
                 mca_rcache_base_vma_insert(vma_module, reg, 0);
             }
         }
@@ -207,33 +282,70 @@ mca_rcache_base_registration_t *sm_get_registation(struct mca_btl_base_endpoint_
     return reg;
 }
 
-struct sm_cleanup_reg_ctx {
-    mca_btl_sm_endpoint_t *ep;
-    opal_list_t *registrations;
-};
+static int sm_check_attached(mca_rcache_base_registration_t *reg, void *ctx)
+{
+    sm_check_reg_ctx_t *sm_ctx = (sm_check_reg_ctx_t *) ctx;
+
+    if ((intptr_t) reg->alloc_base != sm_ctx->ep->peer_smp_rank
+        || (MCA_RCACHE_FLAGS_INVALID & reg->flags)) {
+        return OPAL_SUCCESS;
+    }
+
+    return (sm_ctx->bound <= (uintptr_t) reg->bound && sm_ctx->base >= (uintptr_t) reg->base) ? 1
+                                                                                             : 0;
+}
+
+/* check if the remote range is already attached. nothing is referenced or detached */
+static bool sm_xpmem_is_attached(struct mca_btl_base_endpoint_t *ep, uintptr_t rem_ptr, size_t size)
+{
+    sm_check_reg_ctx_t check_ctx = {.ep = ep, .base = rem_ptr, .bound = rem_ptr + size};
+
+    return 1 == mca_rcache_base_vma_iterate(mca_btl_sm_component.vma_module, (void *) rem_ptr, size,
+                                            true, sm_check_attached, &check_ctx);
+}
 
-static int mca_btl_sm_endpoint_xpmem_rcache_cleanup(mca_rcache_base_registration_t *reg, void *ctx)
+bool mca_btl_sm_xpmem_prefer(struct mca_btl_base_endpoint_t *ep, uint64_t remote_address,
+                             size_t size)
 {
-    struct sm_cleanup_reg_ctx *cleanup_ctx = (struct sm_cleanup_reg_ctx *) ctx;
-    if ((intptr_t) reg->alloc_base == cleanup_ctx->ep->peer_smp_rank) {
-        opal_list_append(cleanup_ctx->registrations, &reg->super.super);
+    mca_btl_sm_component_t *component = &mca_btl_sm_component;
+    unsigned int index;
+
+    /* attaching costs a few system calls and page faults on first touch. it pays off
+     * for large transfers and for buffers that are used again, CMA is cheaper for the
+     * rest */
+    if (size >= component->xpmem_attach_min
+        || sm_xpmem_is_attached(ep, (uintptr_t) remote_address, size)) {
+        return true;
     }
 
-    return OPAL_SUCCESS;
+    /* the table is not protected, a lost update only delays the attachment */
+    index = (unsigned int) ((remote_address >> 6) % MCA_BTL_SM_SC_SEEN_SIZE);
+    if (ep->sc_seen[index].address != (uintptr_t) remote_address) {
+        ep->sc_seen[index].address = (uintptr_t) remote_address;
+        ep->sc_seen[index].count = 0;
+    }
+
+    return ++ep->sc_seen[index].count >= component->xpmem_reuse_min;
 }
 
 void mca_btl_sm_xpmem_cleanup_endpoint(struct mca_btl_base_endpoint_t *ep)
 {
     mca_rcache_base_registration_t *reg;
     opal_list_t registrations;
-    struct sm_cleanup_reg_ctx cleanup_ctx = {.ep = ep, .registrations = &registrations};
 
     OBJ_CONSTRUCT(&registrations, opal_list_t);
 
     /* clean out the registration cache */
-    (void) mca_rcache_base_vma_iterate(mca_btl_sm_component.vma_module, NULL, (size_t) -1, true,
-                                       mca_btl_sm_endpoint_xpmem_rcache_cleanup,
-                                       (void *) &cleanup_ctx);
+    OPAL_THREAD_LOCK(&ep->xpmem_cache.lock);
+    while (NULL
+           != (reg = (mca_rcache_base_registration_t *) opal_list_remove_first(
+                   &ep->xpmem_cache.lru))) {
+        (void) opal_atomic_fetch_or_32(&reg->flags, MCA_RCACHE_FLAGS_INVALID);
+        opal_list_append(&registrations, &reg->super.super);
+    }
+    ep->xpmem_cache.bytes = 0;
+    OPAL_THREAD_UNLOCK(&ep->xpmem_cache.lock);
+
     while (NULL
            != (reg = (mca_rcache_base_registration_t *) opal_list_remove_first(&registrations))) {
         sm_return_registration(reg, ep);
@@ -246,4 +358,20 @@ void mca_btl_sm_xpmem_cleanup_endpoint(struct mca_btl_base_endpoint_t *ep)
     }
 }
 
+void mca_btl_sm_xpmem_register_pvars(void)
+{
+    mca_btl_sm_register_peer_counter("xpmem_peer_hits",
+                                     "Number of get/put to each local rank that found the remote "
+                                     "buffer already attached",
+                                     offsetof(mca_btl_base_endpoint_t, xpmem_cache.hits));
+    mca_btl_sm_register_peer_counter("xpmem_peer_misses",
+                                     "Number of get/put to each local rank that attached the "
+                                     "remote buffer",
+                                     offsetof(mca_btl_base_endpoint_t, xpmem_cache.misses));
+    mca_btl_sm_register_peer_counter("xpmem_peer_evictions",
+                                     "Number of attachments of each local rank dropped to stay "
+                                     "within btl_sm_xpmem_cache_size",
+                                     offsetof(mca_btl_base_endpoint_t, xpmem_cache.evictions));
+}
+
 #endif /* OPAL_BTL_SM_HAVE_XPMEM */
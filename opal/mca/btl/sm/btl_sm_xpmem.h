@@ -36,6 +36,13 @@ void sm_return_registration(mca_rcache_base_registration_t *reg,
                             struct mca_btl_base_endpoint_t *endpoint);
 void mca_btl_sm_xpmem_cleanup_endpoint(struct mca_btl_base_endpoint_t *ep);
 
+/* register the btl_sm_xpmem_peer_* performance variables */
+void mca_btl_sm_xpmem_register_pvars(void);
+
+/* decide whether a transfer should be done with xpmem rather than CMA (btl_sm_single_copy_auto) */
+bool mca_btl_sm_xpmem_prefer(struct mca_btl_base_endpoint_t *ep, uint64_t remote_address,
+                             size_t size);
+
 #endif /* OPAL_BTL_SM_HAVE_XPMEM */
 
 #endif /* MCA_BTL_SM_XPMEM_H */
@@ -49,10 +49,19 @@
 #include "opal/mca/btl/base/base.h"
 #include "opal/mca/btl/btl.h"
 #include "opal/mca/mpool/mpool.h"
+#include "opal/mca/threads/threads.h"
 #include "opal/util/event.h"
 #include "opal/util/fd.h"
 
 #define MCA_BTL_TCP_STATISTICS 0
+
+/* zero copy sends (btl_tcp_zerocopy_min) need the Linux error queue notifications */
+#if defined(HAVE_LINUX_ERRQUEUE_H) && HAVE_DECL_MSG_ZEROCOPY && HAVE_DECL_SO_ZEROCOPY
+#    define MCA_BTL_TCP_ZEROCOPY 1
+#else
+#    define MCA_BTL_TCP_ZEROCOPY 0
+#endif
+
 BEGIN_C_DECLS
 
 extern opal_event_base_t *mca_btl_tcp_event_base;
@@ -88,6 +97,20 @@ extern int mca_btl_tcp_progress_thread_trigger;
         }                                                                                 \
     } while (0)
 
+/**
+ * Additional progress thread (btl_tcp_progress_threads). Each thread runs its
+ * own event base and progresses the endpoints of the modules assigned to it.
+ */
+struct mca_btl_tcp_progress_t {
+    opal_thread_t thread;
+    opal_event_base_t *base;
+    int trigger;             /**< 1 while running, 0 to stop, -1 once stopped */
+    int pipe[2];             /**< closing pipe[1] wakes the thread up to stop */
+    opal_event_t stop_event; /**< read event on pipe[0] */
+    int ifkindex;            /**< interface to bind near, -1 for none */
+};
+typedef struct mca_btl_tcp_progress_t mca_btl_tcp_progress_t;
+
 /**
  * TCP BTL component.
  */
@@ -104,6 +127,9 @@ struct mca_btl_tcp_component_t {
     int tcp_free_list_inc;       /**< number of elements to alloc when growing free lists */
     int tcp_endpoint_cache;      /**< amount of cache on each endpoint */
     opal_proc_table_t tcp_procs; /**< hash table of tcp proc structures */
+    bool tcp_reachable_cache;    /**< reuse the interface matchings of the peers with the
+                                      same interface layout */
+    opal_hash_table_t tcp_matchings; /**< cached interface matchings (see btl_tcp_proc.c) */
     opal_mutex_t tcp_lock;       /**< lock for accessing module state */
     opal_list_t tcp_events;
 
@@ -133,6 +159,14 @@ struct mca_btl_tcp_component_t {
     opal_free_list_t tcp_frag_user;
 
     int tcp_enable_progress_thread; /** Support for tcp progress thread flag */
+    unsigned int tcp_num_progress_threads; /**< number of progress threads (including the one
+                                            *   owning the listen sockets) */
+    bool tcp_progress_thread_bind;         /**< bind each progress thread near its interface */
+    mca_btl_tcp_progress_t *tcp_progress;  /**< progress threads beyond the first one */
+    unsigned int tcp_num_progress;         /**< number of entries in tcp_progress */
+#if MCA_BTL_TCP_ZEROCOPY
+    unsigned int tcp_zerocopy_min; /**< smallest write sent with MSG_ZEROCOPY (0 = never) */
+#endif
 
     opal_event_t tcp_recv_thread_async_event;
     opal_mutex_t tcp_frag_eager_mutex;
@@ -169,6 +203,8 @@ struct mca_btl_tcp_module_t {
     opal_mutex_t tcp_endpoints_mutex;
     opal_list_t tcp_endpoints;
 
+    opal_event_base_t *tcp_event_base; /**< event base progressing the endpoints of this module */
+
     mca_btl_base_module_error_cb_fn_t tcp_error_cb; /**< Upper layer error callback */
 #if MCA_BTL_TCP_STATISTICS
     size_t tcp_bytes_sent;
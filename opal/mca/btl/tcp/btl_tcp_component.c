@@ -64,6 +64,7 @@
 #include "opal/mca/btl/base/base.h"
 #include "opal/mca/btl/base/btl_base_error.h"
 #include "opal/mca/btl/btl.h"
+#include "opal/mca/hwloc/base/base.h"
 #include "opal/mca/mpool/base/base.h"
 #include "opal/mca/pmix/pmix-internal.h"
 #include "opal/mca/reachable/base/base.h"
@@ -309,6 +310,39 @@ static int mca_btl_tcp_component_register(void)
     /* Check if we should support async progress */
     mca_btl_tcp_param_register_int("progress_thread", NULL, 0, OPAL_INFO_LVL_1,
                                    &mca_btl_tcp_component.tcp_enable_progress_thread);
+    mca_btl_tcp_param_register_uint(
+        "progress_threads",
+        "Number of progress threads to use with btl_tcp_progress_thread. The modules (one per "
+        "interface and link, see btl_tcp_links) are spread over the threads and the links of an "
+        "interface get the same weight so that large messages are striped evenly over them "
+        "(default: 1)",
+        1, OPAL_INFO_LVL_4, &mca_btl_tcp_component.tcp_num_progress_threads);
+#if MCA_BTL_TCP_ZEROCOPY
+    mca_btl_tcp_param_register_uint(
+        "zerocopy_min",
+        "Smallest write (in bytes) sent with MSG_ZEROCOPY. The kernel then sends from the "
+        "fragment buffers instead of copying them, at the cost of pinning the pages and of a "
+        "notification once the data is acknowledged, which only pays off for large fragments. "
+        "It is turned off for a connection where the kernel has to copy anyway, like loopback "
+        "(0 = never, default: 0)",
+        0, OPAL_INFO_LVL_5, &mca_btl_tcp_component.tcp_zerocopy_min);
+#endif
+    mca_btl_tcp_component.tcp_progress_thread_bind = false;
+    (void) mca_base_component_var_register(
+        &mca_btl_tcp_component.super.btl_version, "progress_thread_bind",
+        "Bind each progress thread to the cores close to the interface of the first module it "
+        "progresses (default: false)",
+        MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_4, MCA_BASE_VAR_SCOPE_READONLY,
+        &mca_btl_tcp_component.tcp_progress_thread_bind);
+    mca_btl_tcp_component.tcp_reachable_cache = true;
+    (void) mca_base_component_var_register(
+        &mca_btl_tcp_component.super.btl_version, "reachable_cache",
+        "Reuse the matching of the local and remote interfaces for all the peers whose interfaces "
+        "are on the same networks, with the same masks and bandwidths, instead of computing the "
+        "reachability and the matching for each of them. Disable it if the reachability of the "
+        "addresses of a network differs (default: true)",
+        MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_READONLY,
+        &mca_btl_tcp_component.tcp_reachable_cache);
     mca_btl_tcp_component.report_all_unfound_interfaces = false;
     (void) mca_base_component_var_register(
         &mca_btl_tcp_component.super.btl_version, "warn_all_unfound_interfaces",
@@ -375,6 +409,8 @@ static int mca_btl_tcp_component_open(void)
     OBJ_CONSTRUCT(&mca_btl_tcp_component.tcp_frag_max, opal_free_list_t);
     OBJ_CONSTRUCT(&mca_btl_tcp_component.tcp_frag_user, opal_free_list_t);
     opal_proc_table_init(&mca_btl_tcp_component.tcp_procs, 16, 256);
+    OBJ_CONSTRUCT(&mca_btl_tcp_component.tcp_matchings, opal_hash_table_t);
+    opal_hash_table_init(&mca_btl_tcp_component.tcp_matchings, 16);
 
     OBJ_CONSTRUCT(&mca_btl_tcp_component.tcp_frag_eager_mutex, opal_mutex_t);
     OBJ_CONSTRUCT(&mca_btl_tcp_component.tcp_frag_max_mutex, opal_mutex_t);
@@ -406,11 +442,20 @@ static int mca_btl_tcp_component_open(void)
 static int mca_btl_tcp_component_close(void)
 {
     mca_btl_tcp_event_t *event, *next;
+    void *key, *matching;
 
     /**
      * If we have a progress thread we should shut it down before
      * moving forward with the TCP tearing down process.
      */
+    /* the additional progress threads first, they do not own the listen sockets */
+    for (unsigned int i = 0; i < mca_btl_tcp_component.tcp_num_progress; ++i) {
+        mca_btl_tcp_progress_stop(mca_btl_tcp_component.tcp_progress + i);
+    }
+    free(mca_btl_tcp_component.tcp_progress);
+    mca_btl_tcp_component.tcp_progress = NULL;
+    mca_btl_tcp_component.tcp_num_progress = 0;
+
     if ((NULL != mca_btl_tcp_event_base) && (mca_btl_tcp_event_base != opal_sync_event_base)) {
         /* Turn of the progress thread before moving forward */
         if (-1 != mca_btl_tcp_progress_thread_trigger) {
@@ -471,6 +516,9 @@ static int mca_btl_tcp_component_close(void)
                                  opal_proc_local_get()->proc_name);
 
     /* release resources */
+    OPAL_HASH_TABLE_FOREACH_PTR(key, matching, &mca_btl_tcp_component.tcp_matchings,
+                                { free(matching); });
+    OBJ_DESTRUCT(&mca_btl_tcp_component.tcp_matchings);
     OBJ_DESTRUCT(&mca_btl_tcp_component.tcp_procs);
     OBJ_DESTRUCT(&mca_btl_tcp_component.tcp_frag_eager);
     OBJ_DESTRUCT(&mca_btl_tcp_component.tcp_frag_max);
@@ -497,6 +545,9 @@ static int mca_btl_tcp_create(const int if_kindex, const char *if_name)
     int i, if_index;
     struct sockaddr_storage addr;
     bool found = false;
+    /* with several progress threads the links are progressed in parallel, weigh them equally */
+    const bool stripe_links = mca_btl_tcp_component.tcp_enable_progress_thread
+                              && mca_btl_tcp_component.tcp_num_progress_threads > 1;
 
     /*
      * Look for an address on the given device (ie, kindex) which
@@ -576,7 +627,7 @@ static int mca_btl_tcp_create(const int if_kindex, const char *if_name)
         sprintf(param, "latency_%s", if_name);
         mca_btl_tcp_param_register_uint(param, NULL, btl->super.btl_latency, OPAL_INFO_LVL_5,
                                         &btl->super.btl_latency);
-        if (i > 0) {
+        if (i > 0 && !stripe_links) {
             btl->super.btl_bandwidth >>= 1;
             btl->super.btl_latency <<= 1;
         }
@@ -599,14 +650,14 @@ static int mca_btl_tcp_create(const int if_kindex, const char *if_name)
         if (0 == btl->super.btl_bandwidth) {
             unsigned int speed = opal_ethtool_get_speed(if_name);
             btl->super.btl_bandwidth = (speed == 0) ? MCA_BTL_TCP_BTL_BANDWIDTH : speed;
-            if (i > 0) {
+            if (i > 0 && !stripe_links) {
                 btl->super.btl_bandwidth >>= 1;
             }
         }
         /* We have no runtime btl latency detection mechanism. Just set a default. */
         if (0 == btl->super.btl_latency) {
             btl->super.btl_latency = MCA_BTL_TCP_BTL_LATENCY;
-            if (i > 0) {
+            if (i > 0 && !stripe_links) {
                 btl->super.btl_latency <<= 1;
             }
         }
@@ -867,10 +918,48 @@ cleanup:
     return ret;
 }
 
+/*
+ * Bind the calling thread to the cores close to an interface
+ * (btl_tcp_progress_thread_bind). The failures are not fatal.
+ */
+static void mca_btl_tcp_progress_bind(int if_kindex)
+{
+    char if_name[OPAL_IF_NAMESIZE];
+    hwloc_obj_t obj = NULL;
+
+    if (!mca_btl_tcp_component.tcp_progress_thread_bind || 0 > if_kindex
+        || OPAL_SUCCESS != opal_ifkindextoname(if_kindex, if_name, sizeof(if_name))
+        || OPAL_SUCCESS != opal_hwloc_base_get_topology()) {
+        return;
+    }
+
+    while (NULL != (obj = hwloc_get_next_osdev(opal_hwloc_topology, obj))) {
+        if (0 == strcmp(obj->name, if_name)) {
+            break;
+        }
+    }
+
+    if (NULL == obj || NULL == (obj = hwloc_get_non_io_ancestor_obj(opal_hwloc_topology, obj))) {
+        opal_output_verbose(10, opal_btl_base_framework.framework_output,
+                            "btl:tcp: could not find the locality of %s, progress thread not bound",
+                            if_name);
+        return;
+    }
+
+    if (0 != hwloc_set_cpubind(opal_hwloc_topology, obj->cpuset, HWLOC_CPUBIND_THREAD)) {
+        opal_output_verbose(10, opal_btl_base_framework.framework_output,
+                            "btl:tcp: could not bind the progress thread of %s", if_name);
+    }
+}
+
 static void *mca_btl_tcp_progress_thread_engine(opal_object_t *obj)
 {
     opal_thread_t *current_thread = (opal_thread_t *) obj;
 
+    if (0 < mca_btl_tcp_component.tcp_num_btls) {
+        mca_btl_tcp_progress_bind(mca_btl_tcp_component.tcp_btls[0]->tcp_ifkindex);
+    }
+
     while (1 == (*((int *) current_thread->t_arg))) {
         opal_event_loop(mca_btl_tcp_event_base, OPAL_EVLOOP_ONCE);
     }
@@ -894,6 +983,140 @@ static void mca_btl_tcp_component_event_async_handler(int fd, short unused, void
     }
 }
 
+static void *mca_btl_tcp_progress_engine(opal_object_t *obj)
+{
+    mca_btl_tcp_progress_t *progress = (mca_btl_tcp_progress_t *) ((opal_thread_t *) obj)->t_arg;
+
+    mca_btl_tcp_progress_bind(progress->ifkindex);
+
+    while (1 == progress->trigger) {
+        opal_event_loop(progress->base, OPAL_EVLOOP_ONCE);
+    }
+    progress->trigger = -1;
+    return NULL;
+}
+
+static void mca_btl_tcp_progress_stop_handler(int fd, short unused, void *context)
+{
+    mca_btl_tcp_progress_t *progress = (mca_btl_tcp_progress_t *) context;
+    char buffer;
+
+    if (0 == read(fd, &buffer, 1)) {
+        /* the main thread closed the pipe */
+        progress->trigger = 0;
+    }
+}
+
+static int mca_btl_tcp_progress_start(mca_btl_tcp_progress_t *progress, int if_kindex)
+{
+    int rc;
+
+    progress->trigger = -1;
+    progress->ifkindex = if_kindex;
+    progress->pipe[0] = progress->pipe[1] = -1;
+
+    if (NULL == (progress->base = opal_event_base_create())) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+    opal_event_base_priority_init(progress->base, OPAL_EVENT_NUM_PRI);
+
+    if (0 != pipe(progress->pipe)) {
+        opal_event_base_free(progress->base);
+        progress->base = NULL;
+        return OPAL_ERR_IN_ERRNO;
+    }
+
+    opal_event_set(progress->base, &progress->stop_event, progress->pipe[0],
+                   OPAL_EV_READ | OPAL_EV_PERSIST, mca_btl_tcp_progress_stop_handler, progress);
+    opal_event_add(&progress->stop_event, 0);
+
+    OBJ_CONSTRUCT(&progress->thread, opal_thread_t);
+    progress->thread.t_run = mca_btl_tcp_progress_engine;
+    progress->thread.t_arg = progress;
+    progress->trigger = 1;
+    if (OPAL_SUCCESS != (rc = opal_thread_start(&progress->thread))) {
+        progress->trigger = -1;
+        opal_event_del(&progress->stop_event);
+        opal_event_base_free(progress->base);
+        progress->base = NULL;
+        close(progress->pipe[0]);
+        close(progress->pipe[1]);
+        OBJ_DESTRUCT(&progress->thread);
+        return rc;
+    }
+
+    return OPAL_SUCCESS;
+}
+
+static void mca_btl_tcp_progress_stop(mca_btl_tcp_progress_t *progress)
+{
+    void *ret = NULL;
+
+    if (NULL == progress->base) {
+        return;
+    }
+
+    progress->trigger = 0;
+    close(progress->pipe[1]);
+    opal_thread_join(&progress->thread, &ret);
+    OBJ_DESTRUCT(&progress->thread);
+
+    opal_event_del(&progress->stop_event);
+    opal_event_base_free(progress->base);
+    progress->base = NULL;
+    close(progress->pipe[0]);
+}
+
+/*
+ * Give each module the event base that progresses its endpoints, starting the
+ * additional progress threads (btl_tcp_progress_threads) if requested. Module
+ * i is progressed by thread i modulo the number of threads, thread 0 is the
+ * one that also owns the listen sockets. The modules of a thread that could
+ * not be started fall back to thread 0.
+ */
+static void mca_btl_tcp_component_assign_progress(void)
+{
+    mca_btl_tcp_component_t *component = &mca_btl_tcp_component;
+    unsigned int nthreads = 1;
+
+    component->tcp_progress = NULL;
+    component->tcp_num_progress = 0;
+
+    if (0 < mca_btl_tcp_progress_thread_trigger && component->tcp_num_progress_threads > 1) {
+        nthreads = component->tcp_num_progress_threads;
+        if (nthreads > component->tcp_num_btls) {
+            nthreads = component->tcp_num_btls;
+        }
+    }
+
+    if (nthreads > 1) {
+        component->tcp_progress = calloc(nthreads - 1, sizeof(component->tcp_progress[0]));
+        if (NULL == component->tcp_progress) {
+            nthreads = 1;
+        } else {
+            component->tcp_num_progress = nthreads - 1;
+        }
+    }
+
+    for (unsigned int i = 0; i < component->tcp_num_progress; ++i) {
+        int rc = mca_btl_tcp_progress_start(component->tcp_progress + i,
+                                            component->tcp_btls[i + 1]->tcp_ifkindex);
+        if (OPAL_SUCCESS != rc) {
+            BTL_ERROR(("BTL TCP additional progress thread initialization failed (%d)", rc));
+        }
+    }
+
+    for (unsigned int i = 0; i < component->tcp_num_btls; ++i) {
+        mca_btl_tcp_module_t *btl = component->tcp_btls[i];
+        unsigned int thread = i % nthreads;
+
+        btl->tcp_event_base = mca_btl_tcp_event_base;
+        if (0 != thread && NULL != component->tcp_progress[thread - 1].base) {
+            btl->tcp_event_base = component->tcp_progress[thread - 1].base;
+        }
+    }
+}
+
 /*
  * Create a listen socket and bind to all interfaces
  */
@@ -1257,6 +1480,12 @@ mca_btl_base_module_t **mca_btl_tcp_component_init(int *num_btl_modules,
                         mca_btl_tcp_component.tcp_free_list_max,
                         mca_btl_tcp_component.tcp_free_list_inc, NULL, 0, NULL, NULL, NULL);
 
+    if (enable_mpi_threads) {
+        (void) opal_free_list_thread_cache_enable(&mca_btl_tcp_component.tcp_frag_eager);
+        (void) opal_free_list_thread_cache_enable(&mca_btl_tcp_component.tcp_frag_max);
+        (void) opal_free_list_thread_cache_enable(&mca_btl_tcp_component.tcp_frag_user);
+    }
+
     /* create a BTL TCP module for selected interfaces */
     if (OPAL_SUCCESS != (ret = mca_btl_tcp_component_create_instances())) {
         return 0;
@@ -1275,6 +1504,8 @@ mca_btl_base_module_t **mca_btl_tcp_component_init(int *num_btl_modules,
     }
 #endif
 
+    mca_btl_tcp_component_assign_progress();
+
     /* publish TCP parameters with the MCA framework */
     if (OPAL_SUCCESS != (ret = mca_btl_tcp_component_exchange())) {
         return 0;
@@ -52,6 +52,12 @@
 #    include <sys/time.h>
 #endif /* HAVE_SYS_TIME_H */
 #include <time.h>
+#ifdef HAVE_SYS_SOCKET_H
+#    include <sys/socket.h>
+#endif
+#ifdef HAVE_LINUX_ERRQUEUE_H
+#    include <linux/errqueue.h>
+#endif
 
 #include "opal/mca/btl/base/btl_base_error.h"
 #include "opal/util/event.h"
@@ -97,6 +103,11 @@ static void mca_btl_tcp_endpoint_construct(mca_btl_tcp_endpoint_t *endpoint)
     OBJ_CONSTRUCT(&endpoint->endpoint_frags, opal_list_t);
     OBJ_CONSTRUCT(&endpoint->endpoint_send_lock, opal_mutex_t);
     OBJ_CONSTRUCT(&endpoint->endpoint_recv_lock, opal_mutex_t);
+#if MCA_BTL_TCP_ZEROCOPY
+    endpoint->endpoint_zerocopy = false;
+    endpoint->endpoint_zc_next = 0;
+    OBJ_CONSTRUCT(&endpoint->endpoint_zc_frags, opal_list_t);
+#endif
 }
 
 /*
@@ -110,6 +121,9 @@ static void mca_btl_tcp_endpoint_destruct(mca_btl_tcp_endpoint_t *endpoint)
     OBJ_DESTRUCT(&endpoint->endpoint_frags);
     OBJ_DESTRUCT(&endpoint->endpoint_send_lock);
     OBJ_DESTRUCT(&endpoint->endpoint_recv_lock);
+#if MCA_BTL_TCP_ZEROCOPY
+    OBJ_DESTRUCT(&endpoint->endpoint_zc_frags);
+#endif
 }
 
 OBJ_CLASS_INSTANCE(mca_btl_tcp_endpoint_t, opal_list_item_t, mca_btl_tcp_endpoint_construct,
@@ -121,6 +135,9 @@ static int mca_btl_tcp_endpoint_start_connect(mca_btl_base_endpoint_t *);
 static void mca_btl_tcp_endpoint_connected(mca_btl_base_endpoint_t *);
 static void mca_btl_tcp_endpoint_recv_handler(int sd, short flags, void *user);
 static void mca_btl_tcp_endpoint_send_handler(int sd, short flags, void *user);
+#if MCA_BTL_TCP_ZEROCOPY
+static void mca_btl_tcp_endpoint_zerocopy_progress(mca_btl_base_endpoint_t *btl_endpoint);
+#endif
 
 /*
  * diagnostics
@@ -325,7 +342,7 @@ static inline void mca_btl_tcp_endpoint_event_init(mca_btl_base_endpoint_t *btl_
     btl_endpoint->endpoint_cache_pos = btl_endpoint->endpoint_cache;
 #endif /* MCA_BTL_TCP_ENDPOINT_CACHE */
 
-    opal_event_set(mca_btl_tcp_event_base, &btl_endpoint->endpoint_recv_event,
+    opal_event_set(btl_endpoint->endpoint_btl->tcp_event_base, &btl_endpoint->endpoint_recv_event,
                    btl_endpoint->endpoint_sd, OPAL_EV_READ | OPAL_EV_PERSIST,
                    mca_btl_tcp_endpoint_recv_handler, btl_endpoint);
     /**
@@ -333,7 +350,7 @@ static inline void mca_btl_tcp_endpoint_event_init(mca_btl_base_endpoint_t *btl_
      * to avoid missing the connection notification in send_handler due to
      * a local handling of the peer process (which holds the lock).
      */
-    opal_event_set(mca_btl_tcp_event_base, &btl_endpoint->endpoint_send_event,
+    opal_event_set(btl_endpoint->endpoint_btl->tcp_event_base, &btl_endpoint->endpoint_send_event,
                    btl_endpoint->endpoint_sd, OPAL_EV_WRITE | OPAL_EV_PERSIST,
                    mca_btl_tcp_endpoint_send_handler, btl_endpoint);
 }
@@ -347,6 +364,10 @@ int mca_btl_tcp_endpoint_send(mca_btl_base_endpoint_t *btl_endpoint, mca_btl_tcp
 {
     int rc = OPAL_SUCCESS;
 
+#if MCA_BTL_TCP_ZEROCOPY
+    frag->zc_calls = frag->zc_pending = 0;
+#endif
+
     OPAL_THREAD_LOCK(&btl_endpoint->endpoint_send_lock);
     switch (btl_endpoint->endpoint_state) {
     case MCA_BTL_TCP_CONNECTING:
@@ -367,6 +388,14 @@ int mca_btl_tcp_endpoint_send(mca_btl_base_endpoint_t *btl_endpoint, mca_btl_tcp
                 && mca_btl_tcp_frag_send(frag, btl_endpoint->endpoint_sd)) {
                 int btl_ownership = (frag->base.des_flags & MCA_BTL_DES_FLAGS_BTL_OWNERSHIP);
 
+#if MCA_BTL_TCP_ZEROCOPY
+                if (0 != frag->zc_pending) {
+                    /* the kernel still reads the buffers, complete on its notification */
+                    frag->base.des_flags |= MCA_BTL_DES_SEND_ALWAYS_CALLBACK;
+                    opal_list_append(&btl_endpoint->endpoint_zc_frags, (opal_list_item_t *) frag);
+                    break;
+                }
+#endif
                 OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_send_lock);
                 if (frag->base.des_flags & MCA_BTL_DES_SEND_ALWAYS_CALLBACK) {
                     frag->base.des_cbfunc(&frag->btl->super, frag->endpoint, &frag->base, frag->rc);
@@ -517,7 +546,8 @@ void mca_btl_tcp_endpoint_accept(mca_btl_base_endpoint_t *btl_endpoint, struct s
     assert(btl_endpoint->endpoint_sd_next == -1);
     btl_endpoint->endpoint_sd_next = sd;
 
-    opal_event_evtimer_set(mca_btl_tcp_event_base, &btl_endpoint->endpoint_accept_event,
+    opal_event_evtimer_set(btl_endpoint->endpoint_btl->tcp_event_base,
+                           &btl_endpoint->endpoint_accept_event,
                            mca_btl_tcp_endpoint_complete_accept, btl_endpoint);
     opal_event_add(&btl_endpoint->endpoint_accept_event, &now);
 }
@@ -564,6 +594,25 @@ void mca_btl_tcp_endpoint_close(mca_btl_base_endpoint_t *btl_endpoint)
 
     CLOSE_THE_SOCKET(btl_endpoint->endpoint_sd);
     btl_endpoint->endpoint_sd = -1;
+
+#if MCA_BTL_TCP_ZEROCOPY
+    /* no notification will come for the zero copy writes anymore */
+    {
+        mca_btl_tcp_frag_t *frag;
+        while (NULL
+               != (frag = (mca_btl_tcp_frag_t *) opal_list_remove_first(
+                       &btl_endpoint->endpoint_zc_frags))) {
+            frag->base.des_cbfunc(&frag->btl->super, frag->endpoint, &frag->base,
+                                  (MCA_BTL_TCP_FAILED == btl_endpoint->endpoint_state)
+                                      ? OPAL_ERR_UNREACH
+                                      : frag->rc);
+            if (frag->base.des_flags & MCA_BTL_DES_FLAGS_BTL_OWNERSHIP) {
+                MCA_BTL_TCP_FRAG_RETURN(frag);
+            }
+        }
+        btl_endpoint->endpoint_zerocopy = false;
+    }
+#endif
     /**
      * If we keep failing to connect to the peer let the caller know about
      * this situation by triggering the callback on all pending fragments and
@@ -608,6 +657,17 @@ static void mca_btl_tcp_endpoint_connected(mca_btl_base_endpoint_t *btl_endpoint
     btl_endpoint->endpoint_retries = 0;
     MCA_BTL_TCP_ENDPOINT_DUMP(1, btl_endpoint, true, "READY [endpoint_connected]");
 
+#if MCA_BTL_TCP_ZEROCOPY
+    /* the kernel numbers the zero copy writes of each socket from 0 */
+    btl_endpoint->endpoint_zc_next = 0;
+    btl_endpoint->endpoint_zerocopy = false;
+    if (0 != mca_btl_tcp_component.tcp_zerocopy_min) {
+        int optval = 1;
+        btl_endpoint->endpoint_zerocopy = (0 == setsockopt(btl_endpoint->endpoint_sd, SOL_SOCKET,
+                                                           SO_ZEROCOPY, &optval, sizeof(optval)));
+    }
+#endif
+
     if (opal_list_get_size(&btl_endpoint->endpoint_frags) > 0) {
         if (NULL == btl_endpoint->endpoint_send_frag) {
             btl_endpoint->endpoint_send_frag = (mca_btl_tcp_frag_t *) opal_list_remove_first(
@@ -951,6 +1011,15 @@ static void mca_btl_tcp_endpoint_recv_handler(int sd, short flags, void *user)
         return;
     }
 
+#if MCA_BTL_TCP_ZEROCOPY
+    /* zero copy notifications make the socket readable until they are consumed */
+    if (0 != opal_list_get_size(&btl_endpoint->endpoint_zc_frags)
+        || (NULL != btl_endpoint->endpoint_send_frag
+            && 0 != btl_endpoint->endpoint_send_frag->zc_pending)) {
+        mca_btl_tcp_endpoint_zerocopy_progress(btl_endpoint);
+    }
+#endif
+
     /**
      * There is an extremely rare race condition here, that can only be
      * triggered during the initialization. If the two processes start their
@@ -1111,6 +1180,14 @@ static void mca_btl_tcp_endpoint_send_handler(int sd, short flags, void *user)
             btl_endpoint->endpoint_send_frag = (mca_btl_tcp_frag_t *) opal_list_remove_first(
                 &btl_endpoint->endpoint_frags);
 
+#if MCA_BTL_TCP_ZEROCOPY
+            if (0 != frag->zc_pending) {
+                /* the kernel still reads the buffers, complete on its notification */
+                opal_list_append(&btl_endpoint->endpoint_zc_frags, (opal_list_item_t *) frag);
+                continue;
+            }
+#endif
+
             /* if required - update request status and release fragment */
             OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_send_lock);
             assert(frag->base.des_flags & MCA_BTL_DES_SEND_ALWAYS_CALLBACK);
@@ -1150,3 +1227,95 @@ static void mca_btl_tcp_endpoint_send_handler(int sd, short flags, void *user)
     }
     OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_send_lock);
 }
+
+#if MCA_BTL_TCP_ZEROCOPY
+/* number of the zero copy writes of a fragment in the range [lo, hi] */
+static uint32_t mca_btl_tcp_frag_zerocopy_overlap(mca_btl_tcp_frag_t *frag, uint32_t lo,
+                                                  uint32_t hi)
+{
+    /* the numbers wrap around, the writes in flight are always close to each other */
+    int64_t first = (int32_t)(lo - frag->zc_first), last = (int32_t)(hi - frag->zc_first);
+
+    if (first < 0) {
+        first = 0;
+    }
+    if (last > (int64_t) frag->zc_calls - 1) {
+        last = (int64_t) frag->zc_calls - 1;
+    }
+
+    return (last < first) ? 0 : (uint32_t)(last - first + 1);
+}
+
+/*
+ * Consume the zero copy notifications of the socket and complete the
+ * fragments the kernel is done with. Each notification covers a range of
+ * writes, the kernel merges them when it can.
+ */
+static void mca_btl_tcp_endpoint_zerocopy_progress(mca_btl_base_endpoint_t *btl_endpoint)
+{
+    mca_btl_tcp_frag_t *frag, *next;
+    opal_list_t done;
+
+    /* the notifications stay queued (and the socket readable) if another thread has the lock */
+    if (OPAL_THREAD_TRYLOCK(&btl_endpoint->endpoint_send_lock)) {
+        return;
+    }
+
+    OBJ_CONSTRUCT(&done, opal_list_t);
+
+    for (;;) {
+        char control[128];
+        struct msghdr msg = {.msg_control = control, .msg_controllen = sizeof(control)};
+        struct cmsghdr *cmsg;
+
+        if (0 > recvmsg(btl_endpoint->endpoint_sd, &msg, MSG_ERRQUEUE)) {
+            break;
+        }
+
+        for (cmsg = CMSG_FIRSTHDR(&msg); NULL != cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            struct sock_extended_err *serr = (struct sock_extended_err *) CMSG_DATA(cmsg);
+
+            if (SO_EE_ORIGIN_ZEROCOPY != serr->ee_origin || 0 != serr->ee_errno) {
+                continue;
+            }
+
+            if (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+                /* the device could not send from the user pages (loopback for example),
+                 * the kernel copied the data anyway: stop paying for the notifications */
+                btl_endpoint->endpoint_zerocopy = false;
+            }
+
+            if (NULL != btl_endpoint->endpoint_send_frag) {
+                frag = btl_endpoint->endpoint_send_frag;
+                frag->zc_pending -= mca_btl_tcp_frag_zerocopy_overlap(frag, serr->ee_info,
+                                                                      serr->ee_data);
+            }
+            OPAL_LIST_FOREACH (frag, &btl_endpoint->endpoint_zc_frags, mca_btl_tcp_frag_t) {
+                frag->zc_pending -= mca_btl_tcp_frag_zerocopy_overlap(frag, serr->ee_info,
+                                                                      serr->ee_data);
+            }
+        }
+    }
+
+    OPAL_LIST_FOREACH_SAFE (frag, next, &btl_endpoint->endpoint_zc_frags, mca_btl_tcp_frag_t) {
+        if (0 == frag->zc_pending) {
+            opal_list_remove_item(&btl_endpoint->endpoint_zc_frags, (opal_list_item_t *) frag);
+            opal_list_append(&done, (opal_list_item_t *) frag);
+        }
+    }
+    OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_send_lock);
+
+    while (NULL != (frag = (mca_btl_tcp_frag_t *) opal_list_remove_first(&done))) {
+        int btl_ownership = (frag->base.des_flags & MCA_BTL_DES_FLAGS_BTL_OWNERSHIP);
+
+        if (NULL != frag->base.des_cbfunc) {
+            frag->base.des_cbfunc(&frag->btl->super, frag->endpoint, &frag->base, frag->rc);
+        }
+        if (btl_ownership) {
+            MCA_BTL_TCP_FRAG_RETURN(frag);
+        }
+    }
+
+    OBJ_DESTRUCT(&done);
+}
+#endif
@@ -72,6 +72,11 @@ struct mca_btl_base_endpoint_t {
     opal_event_t endpoint_send_event;   /**< event for async processing of send frags */
     opal_event_t endpoint_recv_event;   /**< event for async processing of recv frags */
     bool endpoint_nbo;                  /**< convert headers to network byte order? */
+#if MCA_BTL_TCP_ZEROCOPY
+    bool endpoint_zerocopy;        /**< SO_ZEROCOPY is enabled on the socket */
+    uint32_t endpoint_zc_next;     /**< number the kernel gives to the next zero copy write */
+    opal_list_t endpoint_zc_frags; /**< sent fragments waiting for their zero copy notifications */
+#endif
 };
 
 typedef struct mca_btl_base_endpoint_t mca_btl_base_endpoint_t;
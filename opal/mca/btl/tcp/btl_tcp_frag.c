@@ -42,6 +42,9 @@
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
 #endif /* HAVE_UNISTD_H */
+#ifdef HAVE_SYS_SOCKET_H
+#    include <sys/socket.h>
+#endif
 
 #include "opal/mca/btl/base/btl_base_error.h"
 #include "opal/opal_socket_errno.h"
@@ -101,6 +104,49 @@ size_t mca_btl_tcp_frag_dump(mca_btl_tcp_frag_t *frag, char *msg, char *buf, siz
     return used;
 }
 
+#if MCA_BTL_TCP_ZEROCOPY
+/*
+ * Write the remaining data of the fragment with MSG_ZEROCOPY if it is large
+ * enough. The kernel then sends from the fragment buffers and tells when it
+ * is done with them on the error queue of the socket, see
+ * mca_btl_tcp_endpoint_zerocopy_progress(). Returns -2 if the write was not
+ * attempted.
+ */
+static ssize_t mca_btl_tcp_frag_send_zerocopy(mca_btl_tcp_frag_t *frag, int sd)
+{
+    mca_btl_base_endpoint_t *btl_endpoint = frag->endpoint;
+    struct msghdr msg = {.msg_iov = frag->iov_ptr, .msg_iovlen = frag->iov_cnt};
+    size_t length = 0;
+    ssize_t cnt;
+
+    if (!btl_endpoint->endpoint_zerocopy) {
+        return -2;
+    }
+
+    for (uint32_t i = 0; i < frag->iov_cnt; ++i) {
+        length += frag->iov_ptr[i].iov_len;
+    }
+    if (length < mca_btl_tcp_component.tcp_zerocopy_min) {
+        return -2;
+    }
+
+    cnt = sendmsg(sd, &msg, MSG_ZEROCOPY);
+    if (0 > cnt) {
+        /* out of option memory to track the pages, copy this time */
+        return (ENOBUFS == opal_socket_errno) ? -2 : cnt;
+    }
+
+    if (0 == frag->zc_calls) {
+        frag->zc_first = btl_endpoint->endpoint_zc_next;
+    }
+    ++btl_endpoint->endpoint_zc_next;
+    ++frag->zc_calls;
+    ++frag->zc_pending;
+
+    return cnt;
+}
+#endif
+
 bool mca_btl_tcp_frag_send(mca_btl_tcp_frag_t *frag, int sd)
 {
     ssize_t cnt;
@@ -108,7 +154,11 @@ bool mca_btl_tcp_frag_send(mca_btl_tcp_frag_t *frag, int sd)
 
     /* non-blocking write, but continue if interrupted */
     do {
-        cnt = writev(sd, frag->iov_ptr, frag->iov_cnt);
+#if MCA_BTL_TCP_ZEROCOPY
+        cnt = mca_btl_tcp_frag_send_zerocopy(frag, sd);
+        if (-2 == cnt)
+#endif
+            cnt = writev(sd, frag->iov_ptr, frag->iov_cnt);
         if (cnt < 0) {
             switch (opal_socket_errno) {
             case EINTR:
@@ -58,6 +58,12 @@ struct mca_btl_tcp_frag_t {
     uint16_t next_step;
     int rc;
     opal_free_list_t *my_list;
+#if MCA_BTL_TCP_ZEROCOPY
+    /* zero copy writes of this fragment, numbered by the kernel in the order of the sends */
+    uint32_t zc_first;   /**< number of the first zero copy write */
+    uint32_t zc_calls;   /**< number of zero copy writes */
+    uint32_t zc_pending; /**< zero copy writes the kernel has not released yet */
+#endif
     /* fake rdma completion */
     struct {
         mca_btl_base_rdma_completion_fn_t func;
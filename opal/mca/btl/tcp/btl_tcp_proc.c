@@ -110,6 +110,29 @@ static inline int mca_btl_tcp_proc_is_proc_left(opal_process_name_t a, opal_proc
 #define MCA_BTL_TCP_PROC_LOCAL_VERTEX(index)  (index)
 #define MCA_BTL_TCP_PROC_REMOTE_VERTEX(index) (index + mca_btl_tcp_component.tcp_num_btls)
 
+/* Fill the proc version of a remote address from its modex version */
+static int mca_btl_tcp_proc_set_addr(mca_btl_tcp_addr_t *addr,
+                                     const mca_btl_tcp_modex_addr_t *modex_addr)
+{
+    if (MCA_BTL_TCP_AF_INET == modex_addr->addr_family) {
+        memcpy(&addr->addr_union.addr_inet, modex_addr->addr, sizeof(struct in_addr));
+        addr->addr_family = AF_INET;
+    } else if (MCA_BTL_TCP_AF_INET6 == modex_addr->addr_family) {
+#if OPAL_ENABLE_IPV6
+        memcpy(&addr->addr_union.addr_inet6, modex_addr->addr, sizeof(struct in6_addr));
+        addr->addr_family = AF_INET6;
+#else
+        return OPAL_ERR_NOT_SUPPORTED;
+#endif
+    } else {
+        BTL_ERROR(("Unexpected address family %d", (int) modex_addr->addr_family));
+        return OPAL_ERR_BAD_PARAM;
+    }
+    addr->addr_port = modex_addr->addr_port;
+    addr->addr_ifkindex = modex_addr->addr_ifkindex;
+    return OPAL_SUCCESS;
+}
+
 /* This function builds a graph to match local and remote interfaces
  * together. It also populates the remote proc object.
  *
@@ -159,6 +182,11 @@ static int mca_btl_tcp_proc_create_interface_graph(mca_btl_tcp_proc_t *btl_proc,
     /* the modex and proc structures differ slightly, so copy the
        fields needed in the proc version */
     for (i = 0; i < btl_proc->proc_addr_count; i++) {
+        rc = mca_btl_tcp_proc_set_addr(&btl_proc->proc_addrs[i], &remote_addrs[i]);
+        if (OPAL_SUCCESS != rc) {
+            goto out;
+        }
+
         /* Construct opal_if_t objects for the remote interfaces */
         opal_if_t *interface = OBJ_NEW(opal_if_t);
         if (NULL == interface) {
@@ -166,40 +194,20 @@ static int mca_btl_tcp_proc_create_interface_graph(mca_btl_tcp_proc_t *btl_proc,
             goto out;
         }
 
-        if (MCA_BTL_TCP_AF_INET == remote_addrs[i].addr_family) {
-            memcpy(&btl_proc->proc_addrs[i].addr_union.addr_inet, remote_addrs[i].addr,
-                   sizeof(struct in_addr));
-            btl_proc->proc_addrs[i].addr_family = AF_INET;
-
+        if (AF_INET == btl_proc->proc_addrs[i].addr_family) {
             memcpy(&((struct sockaddr_in *) &(interface->if_addr))->sin_addr, remote_addrs[i].addr,
                    sizeof(struct in_addr));
             ((struct sockaddr *) &(interface->if_addr))->sa_family = AF_INET;
             interface->af_family = AF_INET;
-        } else if (MCA_BTL_TCP_AF_INET6 == remote_addrs[i].addr_family) {
 #if OPAL_ENABLE_IPV6
-            memcpy(&btl_proc->proc_addrs[i].addr_union.addr_inet6, remote_addrs[i].addr,
-                   sizeof(struct in6_addr));
-            btl_proc->proc_addrs[i].addr_family = AF_INET6;
-
+        } else {
             memcpy(&((struct sockaddr_in6 *) &(interface->if_addr))->sin6_addr,
                    remote_addrs[i].addr, sizeof(struct in6_addr));
             ((struct sockaddr *) &(interface->if_addr))->sa_family = AF_INET6;
             interface->af_family = AF_INET6;
-#else
-            rc = OPAL_ERR_NOT_SUPPORTED;
-            OBJ_RELEASE(interface);
-            goto out;
 #endif
-        } else {
-            BTL_ERROR(("Unexpected address family %d", (int) remote_addrs[i].addr_family));
-            rc = OPAL_ERR_BAD_PARAM;
-            OBJ_RELEASE(interface);
-            goto out;
         }
 
-        btl_proc->proc_addrs[i].addr_port = remote_addrs[i].addr_port;
-        btl_proc->proc_addrs[i].addr_ifkindex = remote_addrs[i].addr_ifkindex;
-
         interface->if_mask = remote_addrs[i].addr_mask;
         interface->if_bandwidth = remote_addrs[i].addr_bandwidth;
 
@@ -289,7 +297,8 @@ out:
  */
 static int mca_btl_tcp_proc_store_matched_interfaces(mca_btl_tcp_proc_t *btl_proc,
                                                      int local_proc_is_left, opal_bp_graph_t *graph,
-                                                     int num_matched, int *matched_edges)
+                                                     int num_matched, int *matched_edges,
+                                                     uint32_t *pairs)
 {
     int rc = OPAL_SUCCESS;
     int i, left, right;
@@ -320,11 +329,76 @@ static int mca_btl_tcp_proc_store_matched_interfaces(mca_btl_tcp_proc_t *btl_pro
         }
         opal_hash_table_set_value_uint32(&btl_proc->btl_index_to_endpoint, *local_index,
                                          (void *) remote_addr);
+        if (NULL != pairs) {
+            pairs[2 * i + 0] = *local_index;
+            pairs[2 * i + 1] = (uint32_t) (remote_addr - btl_proc->proc_addrs);
+        }
     }
 out:
     return rc;
 }
 
+/* The matching of the interfaces of two processes only depends on the
+ * networks, masks and bandwidths of the remote interfaces, and on the side of
+ * the graph the local process is on. It is cached with these as the key, most
+ * peers share the same layout and then get their matching without building
+ * nor solving the graph.
+ */
+typedef struct mca_btl_tcp_matching_t {
+    int num_matched;
+    uint32_t pairs[]; /**< btl index and remote address index of each match */
+} mca_btl_tcp_matching_t;
+
+static mca_btl_tcp_modex_addr_t *
+mca_btl_tcp_proc_matching_key(size_t count, const mca_btl_tcp_modex_addr_t *remote_addrs,
+                              int local_proc_is_left)
+{
+    mca_btl_tcp_modex_addr_t *key;
+    size_t i, j;
+    int bits;
+
+    key = (mca_btl_tcp_modex_addr_t *) calloc(count, sizeof(mca_btl_tcp_modex_addr_t));
+    if (NULL == key) {
+        return NULL;
+    }
+    for (i = 0; i < count; i++) {
+        for (j = 0; j < sizeof(key[i].addr); j++) {
+            bits = (int) remote_addrs[i].addr_mask - 8 * (int) j;
+            if (bits <= 0) {
+                break;
+            }
+            key[i].addr[j] = (bits >= 8) ? remote_addrs[i].addr[j]
+                                         : (remote_addrs[i].addr[j] & (0xff << (8 - bits)));
+        }
+        key[i].addr_mask = remote_addrs[i].addr_mask;
+        key[i].addr_bandwidth = remote_addrs[i].addr_bandwidth;
+        key[i].addr_family = remote_addrs[i].addr_family;
+        key[i].padding[0] = (uint8_t) local_proc_is_left;
+    }
+    return key;
+}
+
+static int mca_btl_tcp_proc_apply_matching(mca_btl_tcp_proc_t *btl_proc,
+                                           mca_btl_tcp_modex_addr_t *remote_addrs,
+                                           const mca_btl_tcp_matching_t *matching)
+{
+    int rc, i;
+    size_t j;
+
+    for (j = 0; j < btl_proc->proc_addr_count; j++) {
+        rc = mca_btl_tcp_proc_set_addr(&btl_proc->proc_addrs[j], &remote_addrs[j]);
+        if (OPAL_SUCCESS != rc) {
+            return rc;
+        }
+    }
+    for (i = 0; i < matching->num_matched; i++) {
+        opal_hash_table_set_value_uint32(&btl_proc->btl_index_to_endpoint,
+                                         matching->pairs[2 * i + 0],
+                                         (void *) &btl_proc->proc_addrs[matching->pairs[2 * i + 1]]);
+    }
+    return OPAL_SUCCESS;
+}
+
 static int mca_btl_tcp_proc_handle_modex_addresses(mca_btl_tcp_proc_t *btl_proc,
                                                    mca_btl_tcp_modex_addr_t *remote_addrs,
                                                    int local_proc_is_left)
@@ -333,6 +407,23 @@ static int mca_btl_tcp_proc_handle_modex_addresses(mca_btl_tcp_proc_t *btl_proc,
     int rc = OPAL_SUCCESS;
     int num_matched = 0;
     int *matched_edges = NULL;
+    mca_btl_tcp_modex_addr_t *key = NULL;
+    size_t key_size = btl_proc->proc_addr_count * sizeof(mca_btl_tcp_modex_addr_t);
+    mca_btl_tcp_matching_t *matching = NULL;
+
+    /* without the key, just do without the cache */
+    if (mca_btl_tcp_component.tcp_reachable_cache) {
+        key = mca_btl_tcp_proc_matching_key(btl_proc->proc_addr_count, remote_addrs,
+                                            local_proc_is_left);
+        if (NULL != key
+            && OPAL_SUCCESS
+                   == opal_hash_table_get_value_ptr(&mca_btl_tcp_component.tcp_matchings, key,
+                                                    key_size, (void **) &matching)) {
+            rc = mca_btl_tcp_proc_apply_matching(btl_proc, remote_addrs, matching);
+            matching = NULL; /* owned by the cache */
+            goto cleanup;
+        }
+    }
 
     rc = mca_btl_tcp_proc_create_interface_graph(btl_proc, remote_addrs, local_proc_is_left,
                                                  &graph);
@@ -345,16 +436,34 @@ static int mca_btl_tcp_proc_handle_modex_addresses(mca_btl_tcp_proc_t *btl_proc,
         goto cleanup;
     }
 
+    if (NULL != key) {
+        matching = (mca_btl_tcp_matching_t *) malloc(sizeof(mca_btl_tcp_matching_t)
+                                                     + 2 * num_matched * sizeof(uint32_t));
+        if (NULL != matching) {
+            matching->num_matched = num_matched;
+        }
+    }
     rc = mca_btl_tcp_proc_store_matched_interfaces(btl_proc, local_proc_is_left, graph, num_matched,
-                                                   matched_edges);
+                                                   matched_edges,
+                                                   (NULL != matching) ? matching->pairs : NULL);
     if (rc) {
         goto cleanup;
     }
+    if (NULL != matching) {
+        if (OPAL_SUCCESS
+            == opal_hash_table_set_value_ptr(&mca_btl_tcp_component.tcp_matchings, key, key_size,
+                                             matching)) {
+            matching = NULL; /* now owned by the cache */
+        }
+    }
 
 cleanup:
     if (NULL != graph) {
         opal_bp_graph_free(graph);
     }
+    free(matching);
+    free(matched_edges);
+    free(key);
     return rc;
 }
 
@@ -34,6 +34,15 @@ AC_DEFUN([MCA_opal_btl_tcp_CONFIG],[
                    [AC_INCLUDES_DEFAULT
 #ifdef HAVE_NETINET_IN_H
 #include <netinet/in.h>
+#endif
+		   ])
+
+    # MSG_ZEROCOPY send path (Linux >= 4.14)
+    AC_CHECK_HEADERS([linux/errqueue.h])
+    AC_CHECK_DECLS([MSG_ZEROCOPY, SO_ZEROCOPY], [], [],
+                   [AC_INCLUDES_DEFAULT
+#ifdef HAVE_SYS_SOCKET_H
+#include <sys/socket.h>
 #endif
 		   ])
     OPAL_SUMMARY_ADD([[Transports]],[[TCP]],[[btl_tcp]],[$opal_btl_tcp_happy])
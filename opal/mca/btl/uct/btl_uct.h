@@ -86,7 +86,11 @@ struct mca_btl_uct_module_t {
     /** transport for forming connections (if needed) */
     mca_btl_uct_tl_t *conn_tl;
 
-    /** array containing the am_tl and rdma_tl */
+    /** connected transport for the active messages of the busiest peers when am_tl is
+     * dynamically connected (shares tl index 1 with nothing else) */
+    mca_btl_uct_tl_t *heavy_tl;
+
+    /** array containing the am_tl and rdma_tl (or heavy_tl) */
     mca_btl_uct_tl_t *comm_tls[2];
 
 #if UCT_API >= UCT_VERSION(1, 7)
@@ -117,6 +121,12 @@ struct mca_btl_uct_module_t {
     /** frags that were waiting on connections that are now ready to send */
     opal_list_t pending_frags;
 
+    /** batches of short fragments waiting to be sent */
+    opal_list_t pending_batches;
+
+    /** size of the AM batches (0 if batching is disabled) */
+    size_t am_batch_size;
+
     /** pending connection requests */
     opal_fifo_t pending_connection_reqs;
 };
@@ -149,15 +159,47 @@ struct mca_btl_uct_component_t {
 #if OPAL_C_HAVE__THREAD_LOCAL
     /** bind threads to contexts */
     bool bind_threads_to_contexts;
+
+    /** give each thread a context of its own while there are free ones */
+    bool dedicated_contexts;
+
+    /** contexts currently owned by a thread (one bit per context) */
+    opal_atomic_int64_t context_owners;
+
+    /** next context for the threads that found no free context */
+    opal_atomic_int32_t next_shared_context;
+
+    /** thread specific key used to give the context back when the thread exits */
+    opal_tsd_key_t context_owner_key;
 #endif
 
     /** disable UCX memory hooks */
     bool disable_ucx_memory_hooks;
+
+    /** maximum size of a batch of short active messages (0 disables batching) */
+    size_t am_batch_size;
+
+    /** number of DCIs of each context of the dc transports (0 for the UCX default) */
+    int dc_num_dci;
+
+    /** bytes sent to a peer over dc before its active messages go over rc (0 disables) */
+    size_t dc_rc_threshold;
 };
 typedef struct mca_btl_uct_component_t mca_btl_uct_component_t;
 
 OPAL_MODULE_DECLSPEC extern mca_btl_uct_component_t mca_btl_uct_component;
 
+#if OPAL_C_HAVE__THREAD_LOCAL
+/**
+ * @brief Pick the context of a thread that is not bound to one yet
+ *
+ * With btl_uct_dedicated_contexts the first free context is given to the
+ * calling thread until it exits. Threads that find no free context share
+ * the contexts round-robin.
+ */
+int mca_btl_uct_context_claim(void);
+#endif
+
 struct mca_btl_base_registration_handle_t {
     /** The packed memory handle. The size of this field is defined by UCT. */
     uint8_t packed_handle[1];
@@ -284,6 +326,7 @@ int mca_btl_uct_reg_mem(void *reg_data, void *base, size_t size,
 int mca_btl_uct_dereg_mem(void *reg_data, mca_rcache_base_registration_t *reg);
 
 ucs_status_t mca_btl_uct_am_handler(void *arg, void *data, size_t length, unsigned flags);
+ucs_status_t mca_btl_uct_am_batch_handler(void *arg, void *data, size_t length, unsigned flags);
 
 struct mca_btl_base_endpoint_t *mca_btl_uct_get_ep(struct mca_btl_base_module_t *module,
                                                    opal_proc_t *proc);
@@ -326,6 +369,16 @@ static inline bool mca_btl_uct_tl_supports_conn(mca_btl_uct_tl_t *tl)
            == (UCT_IFACE_FLAG_AM_SHORT | UCT_IFACE_FLAG_CONNECT_TO_IFACE);
 }
 
+/**
+ * @brief Checks if a tl is dynamically connected (one endpoint reaches any peer)
+ *
+ * @param[in] tl  btl/uct tl pointer
+ */
+static inline bool mca_btl_uct_tl_is_dc(mca_btl_uct_tl_t *tl)
+{
+    return 0 == strncmp(tl->uct_tl_name, "dc", 2);
+}
+
 /**
  * @brief Check if tl endpoints need to be connected via a connection tl
  *
@@ -71,6 +71,27 @@ static inline void _mca_btl_uct_send_pack(void *data, void *header, size_t heade
     assert(length == payload_size);
 }
 
+/* copy the header and payload of a btl_sendi call. contiguous payloads are copied directly
+ * instead of going through the convertor. */
+static inline void mca_btl_uct_sendi_copy(void *data, void *header, size_t header_size,
+                                          opal_convertor_t *convertor, size_t payload_size)
+{
+    void *data_ptr;
+
+    if (0 == payload_size || opal_convertor_need_buffers(convertor)) {
+        _mca_btl_uct_send_pack(data, header, header_size, convertor, payload_size);
+        return;
+    }
+
+    if (header_size > 0) {
+        memcpy(data, header, header_size);
+    }
+
+    opal_convertor_get_current_pointer(convertor, &data_ptr);
+    assert(NULL != data_ptr);
+    memcpy((void *) ((intptr_t) data + header_size), data_ptr, payload_size);
+}
+
 struct mca_btl_base_descriptor_t *mca_btl_uct_prepare_src(mca_btl_base_module_t *btl,
                                                           mca_btl_base_endpoint_t *endpoint,
                                                           opal_convertor_t *convertor,
@@ -152,6 +173,198 @@ static size_t mca_btl_uct_send_frag_pack(void *data, void *arg)
     return length;
 }
 
+static void mca_btl_uct_am_batch_construct(mca_btl_uct_am_batch_t *batch)
+{
+    OBJ_CONSTRUCT(&batch->lock, opal_mutex_t);
+    batch->endpoint = NULL;
+    batch->context = NULL;
+    batch->buffer = NULL;
+    batch->used = 0;
+    batch->capacity = 0;
+    batch->count = 0;
+    batch->pending = false;
+}
+
+static void mca_btl_uct_am_batch_destruct(mca_btl_uct_am_batch_t *batch)
+{
+    free(batch->buffer);
+    OBJ_DESTRUCT(&batch->lock);
+}
+
+OBJ_CLASS_INSTANCE(mca_btl_uct_am_batch_t, opal_list_item_t, mca_btl_uct_am_batch_construct,
+                   mca_btl_uct_am_batch_destruct);
+
+static size_t mca_btl_uct_am_batch_pack(void *data, void *arg)
+{
+    mca_btl_uct_am_batch_t *batch = (mca_btl_uct_am_batch_t *) arg;
+
+    memcpy(data, batch->buffer, batch->used);
+    return batch->used;
+}
+
+/* send the fragments in the batch. the caller holds the batch lock. the worker is not
+ * progressed here to avoid calling back into the btl while the batch is locked. */
+static int mca_btl_uct_am_batch_send(mca_btl_uct_module_t *uct_btl, mca_btl_uct_am_batch_t *batch)
+{
+    mca_btl_uct_device_context_t *context = batch->context;
+    uct_ep_h ep_handle = NULL;
+    ssize_t size;
+
+    if (0 == batch->count) {
+        return OPAL_SUCCESS;
+    }
+
+    /* batches are only filled on connected endpoints */
+    (void) mca_btl_uct_endpoint_test_am(uct_btl, batch->endpoint, context, &ep_handle);
+    assert(NULL != ep_handle);
+
+    mca_btl_uct_context_lock(context);
+    size = uct_ep_am_bcopy(ep_handle, MCA_BTL_UCT_FRAG_BATCH, mca_btl_uct_am_batch_pack, batch,
+                           0);
+    mca_btl_uct_context_unlock(context);
+
+    if (OPAL_UNLIKELY(size != (ssize_t) batch->used)) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    batch->used = 0;
+    batch->count = 0;
+
+    return OPAL_SUCCESS;
+}
+
+static mca_btl_uct_am_batch_t *mca_btl_uct_am_batch_get(mca_btl_uct_module_t *uct_btl,
+                                                        mca_btl_base_endpoint_t *endpoint,
+                                                        mca_btl_uct_device_context_t *context)
+{
+    mca_btl_uct_am_batch_t *batch = endpoint->am_batch;
+
+    if (OPAL_LIKELY(NULL != batch)) {
+        return batch;
+    }
+
+    OPAL_THREAD_LOCK(&endpoint->ep_lock);
+    batch = endpoint->am_batch;
+    if (NULL == batch) {
+        batch = OBJ_NEW(mca_btl_uct_am_batch_t);
+        if (OPAL_LIKELY(NULL != batch)) {
+            batch->buffer = malloc(uct_btl->am_batch_size);
+            if (OPAL_UNLIKELY(NULL == batch->buffer)) {
+                OBJ_RELEASE(batch);
+                batch = NULL;
+            } else {
+                batch->capacity = uct_btl->am_batch_size;
+                batch->endpoint = endpoint;
+                batch->context = context;
+                opal_atomic_wmb();
+                endpoint->am_batch = batch;
+            }
+        }
+    }
+    OPAL_THREAD_UNLOCK(&endpoint->ep_lock);
+
+    return batch;
+}
+
+/* add a short message to the batch of the endpoint */
+static int mca_btl_uct_am_batch_add(mca_btl_uct_module_t *uct_btl,
+                                    mca_btl_base_endpoint_t *endpoint,
+                                    mca_btl_uct_device_context_t *context,
+                                    opal_convertor_t *convertor, void *header, size_t header_size,
+                                    size_t payload_size, mca_btl_base_tag_t tag)
+{
+    const size_t total_size = header_size + payload_size;
+    const size_t record_size = sizeof(mca_btl_uct_batch_header_t)
+                               + ((total_size + 7) & ~(size_t) 7);
+    mca_btl_uct_batch_header_t *batch_header;
+    mca_btl_uct_am_batch_t *batch;
+
+    batch = mca_btl_uct_am_batch_get(uct_btl, endpoint, context);
+    if (OPAL_UNLIKELY(NULL == batch || record_size > batch->capacity)) {
+        return OPAL_ERR_NOT_AVAILABLE;
+    }
+
+    OPAL_THREAD_LOCK(&batch->lock);
+    if (batch->used + record_size > batch->capacity
+        && OPAL_SUCCESS != mca_btl_uct_am_batch_send(uct_btl, batch)) {
+        OPAL_THREAD_UNLOCK(&batch->lock);
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    batch_header = (mca_btl_uct_batch_header_t *) ((intptr_t) batch->buffer + batch->used);
+    batch_header->length = (uint32_t) total_size;
+    batch_header->tag = tag;
+    mca_btl_uct_sendi_copy((void *) (batch_header + 1), header, header_size, convertor,
+                           payload_size);
+
+    batch->used += record_size;
+    ++batch->count;
+
+    if (!batch->pending) {
+        batch->pending = true;
+        OPAL_THREAD_LOCK(&uct_btl->lock);
+        opal_list_append(&uct_btl->pending_batches, &batch->super);
+        OPAL_THREAD_UNLOCK(&uct_btl->lock);
+    }
+    OPAL_THREAD_UNLOCK(&batch->lock);
+
+    return OPAL_SUCCESS;
+}
+
+int mca_btl_uct_am_batch_flush(mca_btl_uct_module_t *uct_btl, mca_btl_base_endpoint_t *endpoint)
+{
+    mca_btl_uct_am_batch_t *batch = endpoint->am_batch;
+    int rc;
+
+    if (OPAL_LIKELY(NULL == batch || 0 == batch->count)) {
+        return OPAL_SUCCESS;
+    }
+
+    OPAL_THREAD_LOCK(&batch->lock);
+    rc = mca_btl_uct_am_batch_send(uct_btl, batch);
+    OPAL_THREAD_UNLOCK(&batch->lock);
+
+    return rc;
+}
+
+int mca_btl_uct_am_batch_progress(mca_btl_uct_module_t *uct_btl)
+{
+    mca_btl_uct_am_batch_t *batch, *next;
+    opal_list_t batches;
+    int sent = 0;
+
+    if (0 == opal_list_get_size(&uct_btl->pending_batches)) {
+        return 0;
+    }
+
+    /* the batch lock is taken before the module lock when a batch is queued so work on a
+     * private list */
+    OBJ_CONSTRUCT(&batches, opal_list_t);
+    OPAL_THREAD_LOCK(&uct_btl->lock);
+    opal_list_join(&batches, opal_list_get_end(&batches), &uct_btl->pending_batches);
+    OPAL_THREAD_UNLOCK(&uct_btl->lock);
+
+    OPAL_LIST_FOREACH_SAFE (batch, next, &batches, mca_btl_uct_am_batch_t) {
+        OPAL_THREAD_LOCK(&batch->lock);
+        if (OPAL_SUCCESS == mca_btl_uct_am_batch_send(uct_btl, batch)) {
+            opal_list_remove_item(&batches, &batch->super);
+            batch->pending = false;
+            ++sent;
+        }
+        OPAL_THREAD_UNLOCK(&batch->lock);
+    }
+
+    if (!opal_list_is_empty(&batches)) {
+        OPAL_THREAD_LOCK(&uct_btl->lock);
+        opal_list_join(&uct_btl->pending_batches, opal_list_get_end(&uct_btl->pending_batches),
+                       &batches);
+        OPAL_THREAD_UNLOCK(&uct_btl->lock);
+    }
+    OBJ_DESTRUCT(&batches);
+
+    return sent;
+}
+
 static void mca_btl_uct_append_pending_frag(mca_btl_uct_module_t *uct_btl,
                                             mca_btl_uct_base_frag_t *frag,
                                             mca_btl_uct_device_context_t *context, bool ready)
@@ -177,7 +390,8 @@ int mca_btl_uct_send_frag(mca_btl_uct_module_t *uct_btl, mca_btl_uct_base_frag_t
 
     /* if another thread set this we really don't care too much as this flag is only meant
      * to protect against deep recursion */
-    if (!context->in_am_callback) {
+    if (!context->in_am_callback
+        && OPAL_SUCCESS == mca_btl_uct_am_batch_flush(uct_btl, frag->endpoint)) {
         mca_btl_uct_context_lock(context);
         /* attempt to post the fragment */
         if (NULL != frag->base.super.registration
@@ -196,7 +410,7 @@ int mca_btl_uct_send_frag(mca_btl_uct_module_t *uct_btl, mca_btl_uct_base_frag_t
             /* short message */
             if (1 == frag->base.des_segment_count
                 && (frag->uct_iov.length + 8)
-                       < MCA_BTL_UCT_TL_ATTR(uct_btl->am_tl, 0).cap.am.max_short) {
+                       < MCA_BTL_UCT_TL_ATTR(context->tl, 0).cap.am.max_short) {
                 ucs_status = uct_ep_am_short(ep_handle, MCA_BTL_UCT_FRAG, frag->header.value,
                                              frag->uct_iov.buffer, frag->uct_iov.length);
 
@@ -242,8 +456,11 @@ int mca_btl_uct_send(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpoi
                      mca_btl_base_descriptor_t *descriptor, mca_btl_base_tag_t tag)
 {
     mca_btl_uct_module_t *uct_btl = (mca_btl_uct_module_t *) btl;
-    mca_btl_uct_device_context_t *context = mca_btl_uct_module_get_am_context(uct_btl);
     mca_btl_uct_base_frag_t *frag = (mca_btl_uct_base_frag_t *) descriptor;
+    mca_btl_uct_device_context_t *context
+        = mca_btl_uct_endpoint_am_context(uct_btl, endpoint,
+                                          mca_btl_uct_module_get_am_context(uct_btl),
+                                          frag->uct_iov.length);
     uct_ep_h ep_handle;
     int rc;
 
@@ -290,9 +507,9 @@ static size_t mca_btl_uct_sendi_pack(void *data, void *arg)
     return args->header_size + args->payload_size + 8;
 }
 
-static inline size_t mca_btl_uct_max_sendi(mca_btl_uct_module_t *uct_btl, int context_id)
+static inline size_t mca_btl_uct_max_sendi(mca_btl_uct_device_context_t *context)
 {
-    return MCA_BTL_UCT_TL_ATTR(uct_btl->am_tl, context_id).cap.am.max_bcopy;
+    return context->uct_iface_attr.cap.am.max_bcopy;
 }
 
 int mca_btl_uct_sendi(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpoint,
@@ -301,8 +518,10 @@ int mca_btl_uct_sendi(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpo
                       mca_btl_base_descriptor_t **descriptor)
 {
     mca_btl_uct_module_t *uct_btl = (mca_btl_uct_module_t *) btl;
-    mca_btl_uct_device_context_t *context = mca_btl_uct_module_get_am_context(uct_btl);
     const size_t total_size = header_size + payload_size;
+    mca_btl_uct_device_context_t *context
+        = mca_btl_uct_endpoint_am_context(uct_btl, endpoint,
+                                          mca_btl_uct_module_get_am_context(uct_btl), total_size);
     /* message with header */
     const size_t msg_size = total_size + 8;
     mca_btl_uct_am_header_t am_header;
@@ -312,7 +531,31 @@ int mca_btl_uct_sendi(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpo
 
     rc = mca_btl_uct_endpoint_check_am(uct_btl, endpoint, context, &ep_handle);
     if (OPAL_UNLIKELY(OPAL_SUCCESS != rc
-                      || msg_size > mca_btl_uct_max_sendi(uct_btl, context->context_id))) {
+                      || msg_size > mca_btl_uct_max_sendi(context))) {
+        if (descriptor) {
+            *descriptor = mca_btl_uct_alloc(btl, endpoint, order, total_size, flags);
+        }
+
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* the heavy peers need no batching */
+    rc = OPAL_ERR_NOT_AVAILABLE;
+    if (uct_btl->am_batch_size && context->tl == uct_btl->am_tl
+        && msg_size < (size_t) context->uct_iface_attr.cap.am.max_short) {
+        rc = mca_btl_uct_am_batch_add(uct_btl, endpoint, context, convertor, header, header_size,
+                                      payload_size, tag);
+        if (OPAL_SUCCESS == rc) {
+            return OPAL_SUCCESS;
+        }
+    }
+
+    if (OPAL_ERR_OUT_OF_RESOURCE != rc) {
+        rc = mca_btl_uct_am_batch_flush(uct_btl, endpoint);
+    }
+
+    if (OPAL_UNLIKELY(OPAL_ERR_OUT_OF_RESOURCE == rc)) {
+        /* the batch could not be sent. do not overtake it. */
         if (descriptor) {
             *descriptor = mca_btl_uct_alloc(btl, endpoint, order, total_size, flags);
         }
@@ -326,10 +569,9 @@ int mca_btl_uct_sendi(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpo
     if (0 == payload_size) {
         ucs_status = uct_ep_am_short(ep_handle, MCA_BTL_UCT_FRAG, am_header.value, header,
                                      header_size);
-    } else if (msg_size < (size_t) MCA_BTL_UCT_TL_ATTR(uct_btl->am_tl, context->context_id)
-                              .cap.am.max_short) {
+    } else if (msg_size < (size_t) context->uct_iface_attr.cap.am.max_short) {
         int8_t *data = alloca(total_size);
-        _mca_btl_uct_send_pack(data, header, header_size, convertor, payload_size);
+        mca_btl_uct_sendi_copy(data, header, header_size, convertor, payload_size);
         ucs_status = uct_ep_am_short(ep_handle, MCA_BTL_UCT_FRAG, am_header.value, data,
                                      total_size);
     } else {
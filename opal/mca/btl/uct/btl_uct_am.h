@@ -37,4 +37,17 @@ mca_btl_base_descriptor_t *mca_btl_uct_alloc(mca_btl_base_module_t *btl,
 
 int mca_btl_uct_free(mca_btl_base_module_t *btl, mca_btl_base_descriptor_t *des);
 
+/**
+ * @brief Send the batch of short fragments of an endpoint, if any
+ *
+ * @returns OPAL_SUCCESS if the batch is empty on return
+ * @returns OPAL_ERR_OUT_OF_RESOURCE if the batch could not be sent now
+ */
+int mca_btl_uct_am_batch_flush(mca_btl_uct_module_t *uct_btl, mca_btl_base_endpoint_t *endpoint);
+
+/**
+ * @brief Send the batches that are waiting for the progress engine
+ */
+int mca_btl_uct_am_batch_progress(mca_btl_uct_module_t *uct_btl);
+
 #endif /* !defined(MCA_BTL_UCT_AM_H) */
@@ -90,6 +90,37 @@ static int mca_btl_uct_component_register(void)
                                         OPAL_INFO_LVL_3, MCA_BASE_VAR_SCOPE_ALL,
                                         &mca_btl_uct_component.disable_ucx_memory_hooks);
 
+    mca_btl_uct_component.am_batch_size = 0;
+    (void) mca_base_component_var_register(
+        &mca_btl_uct_component.super.btl_version, "am_batch_size",
+        "Maximum size in bytes of a batch of short active messages. When non-zero, "
+        "short messages sent to the same endpoint with btl_sendi are copied into one "
+        "buffer and sent in a single message when the next one does not fit, when "
+        "another message to the endpoint has to be sent, or from the progress engine. "
+        "The size is limited by the bcopy limit of the transport. (default: 0 -- "
+        "disabled)",
+        MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_4,
+        MCA_BASE_VAR_SCOPE_LOCAL, &mca_btl_uct_component.am_batch_size);
+
+    mca_btl_uct_component.dc_num_dci = 0;
+    (void) mca_base_component_var_register(
+        &mca_btl_uct_component.super.btl_version, "dc_num_dci",
+        "Number of DC initiators of each worker context of the dc transports. The "
+        "contexts reach all their peers through this pool, so its size bounds the "
+        "number of peers a context sends to concurrently. (default: 0 -- UCX default)",
+        MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_4,
+        MCA_BASE_VAR_SCOPE_LOCAL, &mca_btl_uct_component.dc_num_dci);
+
+    mca_btl_uct_component.dc_rc_threshold = 0;
+    (void) mca_base_component_var_register(
+        &mca_btl_uct_component.super.btl_version, "dc_rc_threshold",
+        "Bytes of active messages sent to a peer over a dc transport after which the "
+        "messages to the peer go over a connected (rc) endpoint of the same memory "
+        "domain. Small or rarely used peers stay on dc and need no endpoint of their "
+        "own. Must be the same on all the processes. (default: 0 -- disabled)",
+        MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_4,
+        MCA_BASE_VAR_SCOPE_ALL_EQ, &mca_btl_uct_component.dc_rc_threshold);
+
 #if OPAL_C_HAVE__THREAD_LOCAL
     mca_btl_uct_component.bind_threads_to_contexts = true;
     (void) mca_base_component_var_register(
@@ -99,6 +130,17 @@ static int mca_btl_uct_component_register(void)
         "when threads are used. (default: true)",
         MCA_BASE_VAR_TYPE_BOOL, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_3,
         MCA_BASE_VAR_SCOPE_ALL, &mca_btl_uct_component.bind_threads_to_contexts);
+
+    mca_btl_uct_component.dedicated_contexts = false;
+    (void) mca_base_component_var_register(
+        &mca_btl_uct_component.super.btl_version, "dedicated_contexts",
+        "Give each thread a device context of its own instead of hashing the "
+        "threads over the contexts. The contexts are created the first time "
+        "a thread uses them and are handed to the next new thread when their "
+        "thread exits. Threads beyond btl_uct_num_contexts_per_module share "
+        "the contexts. Requires btl_uct_bind_threads_to_contexts. (default: false)",
+        MCA_BASE_VAR_TYPE_BOOL, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_4,
+        MCA_BASE_VAR_SCOPE_ALL, &mca_btl_uct_component.dedicated_contexts);
 #endif
 
     /* for now we want this component to lose to btl/ugni and btl/vader */
@@ -112,6 +154,48 @@ static void mca_btl_uct_mem_release_cb(void *buf, size_t length, void *cbdata, b
     ucm_vm_munmap(buf, length);
 }
 
+#if OPAL_C_HAVE__THREAD_LOCAL
+static void mca_btl_uct_context_release(void *value)
+{
+    const int context_id = (int) (intptr_t) value - 1;
+
+    /* the context itself is kept (the endpoints hold uct endpoints on it and it may still
+     * have operations in flight). it is given to the next thread that needs one. */
+    (void) opal_atomic_fetch_and_64(&mca_btl_uct_component.context_owners,
+                                    ~((int64_t) 1 << context_id));
+}
+
+int mca_btl_uct_context_claim(void)
+{
+    const int context_count = mca_btl_uct_component.num_contexts_per_module;
+    int64_t owners = mca_btl_uct_component.context_owners;
+
+    for (int context_id = 0; context_id < context_count; ++context_id) {
+        const int64_t bit = (int64_t) 1 << context_id;
+
+        if (owners & bit) {
+            continue;
+        }
+
+        owners = opal_atomic_fetch_or_64(&mca_btl_uct_component.context_owners, bit);
+        if (!(owners & bit)) {
+            if (OPAL_SUCCESS
+                != opal_tsd_setspecific(mca_btl_uct_component.context_owner_key,
+                                        (void *) (intptr_t) (context_id + 1))) {
+                /* the context can not be given back, keep it owned */
+                BTL_VERBOSE(("could not track the owner of context %d", context_id));
+            }
+
+            return context_id;
+        }
+    }
+
+    /* every context belongs to a thread */
+    return opal_atomic_fetch_add_32(&mca_btl_uct_component.next_shared_context, 1)
+           % context_count;
+}
+#endif
+
 static int mca_btl_uct_component_open(void)
 {
     if (0 == mca_btl_uct_component.num_contexts_per_module) {
@@ -137,6 +221,22 @@ static int mca_btl_uct_component_open(void)
         mca_btl_uct_component.num_contexts_per_module = MCA_BTL_UCT_MAX_WORKERS;
     }
 
+#if OPAL_C_HAVE__THREAD_LOCAL
+    if (!mca_btl_uct_component.bind_threads_to_contexts) {
+        mca_btl_uct_component.dedicated_contexts = false;
+    }
+
+    if (mca_btl_uct_component.dedicated_contexts) {
+        mca_btl_uct_component.context_owners = 0;
+        mca_btl_uct_component.next_shared_context = 0;
+        if (OPAL_SUCCESS
+            != opal_tsd_key_create(&mca_btl_uct_component.context_owner_key,
+                                   mca_btl_uct_context_release)) {
+            mca_btl_uct_component.dedicated_contexts = false;
+        }
+    }
+#endif
+
     if (mca_btl_uct_component.disable_ucx_memory_hooks
         && ((OPAL_MEMORY_FREE_SUPPORT | OPAL_MEMORY_MUNMAP_SUPPORT)
             == ((OPAL_MEMORY_FREE_SUPPORT | OPAL_MEMORY_MUNMAP_SUPPORT)
@@ -153,6 +253,13 @@ static int mca_btl_uct_component_open(void)
  */
 static int mca_btl_uct_component_close(void)
 {
+#if OPAL_C_HAVE__THREAD_LOCAL
+    if (mca_btl_uct_component.dedicated_contexts) {
+        (void) opal_tsd_key_delete(mca_btl_uct_component.context_owner_key);
+        mca_btl_uct_component.dedicated_contexts = false;
+    }
+#endif
+
     if (mca_btl_uct_component.disable_ucx_memory_hooks) {
         opal_mem_hooks_unregister_release(mca_btl_uct_mem_release_cb);
     }
@@ -190,6 +297,10 @@ static size_t mca_btl_uct_module_modex_size(mca_btl_uct_module_t *module)
         modex_size += mca_btl_uct_tl_modex_size(module->conn_tl);
     }
 
+    if (module->heavy_tl) {
+        modex_size += mca_btl_uct_tl_modex_size(module->heavy_tl);
+    }
+
     return modex_size;
 }
 
@@ -261,6 +372,10 @@ static int mca_btl_uct_modex_send(void)
             && module->conn_tl != module->am_tl) {
             modex_data += mca_btl_uct_tl_modex_pack(module->conn_tl, modex_data);
         }
+
+        if (module->heavy_tl) {
+            modex_data += mca_btl_uct_tl_modex_pack(module->heavy_tl, modex_data);
+        }
     }
 
     OPAL_MODEX_SEND(rc, PMIX_GLOBAL, &mca_btl_uct_component.super.btl_version, modex, modex_size);
@@ -287,6 +402,7 @@ static mca_btl_uct_module_t *mca_btl_uct_alloc_module(const char *md_name, mca_b
     OBJ_CONSTRUCT(&module->eager_frags, opal_free_list_t);
     OBJ_CONSTRUCT(&module->max_frags, opal_free_list_t);
     OBJ_CONSTRUCT(&module->pending_frags, opal_list_t);
+    OBJ_CONSTRUCT(&module->pending_batches, opal_list_t);
     OBJ_CONSTRUCT(&module->lock, opal_recursive_mutex_t);
     OBJ_CONSTRUCT(&module->pending_connection_reqs, opal_fifo_t);
 
@@ -327,6 +443,37 @@ ucs_status_t mca_btl_uct_am_handler(void *arg, void *data, size_t length, unsign
     return UCS_OK;
 }
 
+ucs_status_t mca_btl_uct_am_batch_handler(void *arg, void *data, size_t length, unsigned flags)
+{
+    mca_btl_uct_device_context_t *tl_context = (mca_btl_uct_device_context_t *) arg;
+    mca_btl_uct_module_t *uct_btl = tl_context->uct_btl;
+
+    /* prevent recursion */
+    tl_context->in_am_callback = true;
+    while (length >= sizeof(mca_btl_uct_batch_header_t)) {
+        mca_btl_uct_batch_header_t *header = (mca_btl_uct_batch_header_t *) data;
+        const size_t record_size = sizeof(*header) + ((header->length + 7) & ~(size_t) 7);
+        mca_btl_active_message_callback_t *reg = mca_btl_base_active_message_trigger
+                                                 + header->tag;
+        mca_btl_base_segment_t seg = {.seg_addr = {.pval = (void *) (header + 1)},
+                                      .seg_len = header->length};
+        mca_btl_base_receive_descriptor_t desc = {.endpoint = NULL,
+                                                  .des_segments = &seg,
+                                                  .des_segment_count = 1,
+                                                  .tag = header->tag,
+                                                  .cbdata = reg->cbdata};
+
+        assert(record_size <= length);
+        reg->cbfunc(&uct_btl->super, &desc);
+
+        data = (void *) ((intptr_t) data + record_size);
+        length -= record_size;
+    }
+    tl_context->in_am_callback = false;
+
+    return UCS_OK;
+}
+
 #if UCT_API >= UCT_VERSION(1, 7)
 static int mca_btl_uct_component_process_uct_md(uct_component_h component,
                                                 uct_md_resource_desc_t *md_desc,
@@ -626,6 +773,8 @@ static int mca_btl_uct_component_progress(void)
             ret += mca_btl_uct_tl_progress(module->am_tl, starting_index);
         }
 
+        ret += mca_btl_uct_tl_progress(module->heavy_tl, starting_index);
+
         if (module->conn_tl) {
             mca_btl_uct_pending_connection_request_t *request;
 
@@ -642,6 +791,9 @@ static int mca_btl_uct_component_progress(void)
             }
         }
 
+        /* batches go first so the pending fragments do not overtake them */
+        ret += mca_btl_uct_am_batch_progress(module);
+
         if (0 != opal_list_get_size(&module->pending_frags)) {
             mca_btl_uct_component_progress_pending(module);
         }
@@ -23,6 +23,9 @@ static void mca_btl_uct_endpoint_construct(mca_btl_uct_endpoint_t *endpoint)
     memset(endpoint->uct_eps, 0,
            sizeof(endpoint->uct_eps[0]) * mca_btl_uct_component.num_contexts_per_module);
     endpoint->conn_ep = NULL;
+    endpoint->am_batch = NULL;
+    endpoint->am_bytes = 0;
+    endpoint->heavy_state = MCA_BTL_UCT_HEAVY_NONE;
     OBJ_CONSTRUCT(&endpoint->ep_lock, opal_recursive_mutex_t);
 }
 
@@ -36,6 +39,10 @@ static void mca_btl_uct_endpoint_destruct(mca_btl_uct_endpoint_t *endpoint)
         }
     }
 
+    if (NULL != endpoint->am_batch) {
+        OBJ_RELEASE(endpoint->am_batch);
+    }
+
     OBJ_DESTRUCT(&endpoint->ep_lock);
 }
 
@@ -70,7 +77,7 @@ static unsigned char *mca_btl_uct_process_modex_tl(unsigned char *modex_data)
 
 static void mca_btl_uct_process_modex(mca_btl_uct_module_t *uct_btl, unsigned char *modex_data,
                                       unsigned char **rdma_tl_data, unsigned char **am_tl_data,
-                                      unsigned char **conn_tl_data)
+                                      unsigned char **conn_tl_data, unsigned char **heavy_tl_data)
 {
     BTL_VERBOSE(("processing remote modex data"));
 
@@ -104,6 +111,16 @@ static void mca_btl_uct_process_modex(mca_btl_uct_module_t *uct_btl, unsigned ch
     } else if (conn_tl_data) {
         *conn_tl_data = NULL;
     }
+
+    if (uct_btl->heavy_tl) {
+        BTL_VERBOSE(("modex contains heavy peer data"));
+        if (heavy_tl_data) {
+            *heavy_tl_data = mca_btl_uct_process_modex_tl(modex_data);
+        }
+        modex_data += *((uint32_t *) modex_data);
+    } else if (heavy_tl_data) {
+        *heavy_tl_data = NULL;
+    }
 }
 
 static inline ucs_status_t mca_btl_uct_ep_create_connected_compat(uct_iface_h iface,
@@ -367,12 +384,11 @@ int mca_btl_uct_endpoint_connect(mca_btl_uct_module_t *uct_btl, mca_btl_uct_endp
                                  int context_id, void *ep_addr, int tl_index)
 {
     mca_btl_uct_tl_endpoint_t *tl_endpoint = endpoint->uct_eps[context_id] + tl_index;
-    mca_btl_uct_tl_t *tl = (uct_btl->rdma_tl && tl_index == uct_btl->rdma_tl->tl_index)
-                               ? uct_btl->rdma_tl
-                               : uct_btl->am_tl;
+    mca_btl_uct_tl_t *tl = uct_btl->comm_tls[tl_index];
     mca_btl_uct_device_context_t *tl_context
         = mca_btl_uct_module_get_tl_context_specific(uct_btl, tl, context_id);
     uint8_t *rdma_tl_data = NULL, *conn_tl_data = NULL, *am_tl_data = NULL, *tl_data;
+    uint8_t *heavy_tl_data = NULL;
     mca_btl_uct_connection_ep_t *conn_ep = NULL;
     mca_btl_uct_modex_t *modex;
     uint8_t *modex_data;
@@ -435,11 +451,15 @@ int mca_btl_uct_endpoint_connect(mca_btl_uct_module_t *uct_btl, mca_btl_uct_endp
             modex_data += strlen((char *) modex_data) + 1;
 
             mca_btl_uct_process_modex(uct_btl, modex_data, &rdma_tl_data, &am_tl_data,
-                                      &conn_tl_data);
+                                      &conn_tl_data, &heavy_tl_data);
             break;
         }
 
-        tl_data = (tl == uct_btl->rdma_tl) ? rdma_tl_data : am_tl_data;
+        if (tl == uct_btl->heavy_tl) {
+            tl_data = heavy_tl_data;
+        } else {
+            tl_data = (tl == uct_btl->rdma_tl) ? rdma_tl_data : am_tl_data;
+        }
 
         if (NULL == tl_data) {
             opal_mutex_unlock(&endpoint->ep_lock);
@@ -473,3 +493,42 @@ int mca_btl_uct_endpoint_connect(mca_btl_uct_module_t *uct_btl, mca_btl_uct_endp
 
     return rc;
 }
+
+mca_btl_uct_device_context_t *mca_btl_uct_endpoint_heavy_context(mca_btl_uct_module_t *uct_btl,
+                                                                 mca_btl_uct_endpoint_t *endpoint,
+                                                                 mca_btl_uct_device_context_t *context)
+{
+    mca_btl_uct_device_context_t *heavy_context;
+    uct_ep_h ep_handle;
+    int rc;
+
+    if (MCA_BTL_UCT_HEAVY_NONE == endpoint->heavy_state) {
+        BTL_VERBOSE(("%" PRIsize_t " bytes sent to %s over %s. switching to %s",
+                     endpoint->am_bytes, OPAL_NAME_PRINT(endpoint->ep_proc->proc_name),
+                     uct_btl->am_tl->uct_tl_name, uct_btl->heavy_tl->uct_tl_name));
+        endpoint->heavy_state = MCA_BTL_UCT_HEAVY_ACTIVE;
+    }
+
+    heavy_context = mca_btl_uct_module_get_tl_context_specific(uct_btl, uct_btl->heavy_tl,
+                                                               context->context_id);
+    if (OPAL_UNLIKELY(NULL == heavy_context)) {
+        endpoint->heavy_state = MCA_BTL_UCT_HEAVY_DISABLED;
+        return context;
+    }
+
+    /* the messages keep going over the am tl while the endpoint connects */
+    rc = mca_btl_uct_endpoint_check(uct_btl, endpoint, heavy_context, &ep_handle,
+                                    uct_btl->heavy_tl->tl_index);
+    if (OPAL_SUCCESS == rc) {
+        return heavy_context;
+    }
+
+    if (OPAL_ERR_OUT_OF_RESOURCE != rc && OPAL_ERR_RESOURCE_BUSY != rc) {
+        BTL_VERBOSE(("could not connect to %s over %s. rc = %d",
+                     OPAL_NAME_PRINT(endpoint->ep_proc->proc_name), uct_btl->heavy_tl->uct_tl_name,
+                     rc));
+        endpoint->heavy_state = MCA_BTL_UCT_HEAVY_DISABLED;
+    }
+
+    return context;
+}
@@ -39,7 +39,7 @@ static inline int mca_btl_uct_endpoint_test_am(mca_btl_uct_module_t *module,
                                                mca_btl_uct_device_context_t *context,
                                                uct_ep_h *ep_handle)
 {
-    int tl_index = module->am_tl->tl_index;
+    int tl_index = context->tl->tl_index;
     int ep_index = context->context_id;
 
     if (OPAL_LIKELY(MCA_BTL_UCT_ENDPOINT_FLAG_CONN_READY
@@ -101,9 +101,46 @@ static inline int mca_btl_uct_endpoint_check_am(mca_btl_uct_module_t *module,
                                                 mca_btl_uct_device_context_t *context,
                                                 uct_ep_h *ep_handle)
 {
-    assert(NULL != module->am_tl);
+    /* the context is one of the am tl or of the heavy tl */
+    assert(context->tl == module->am_tl || context->tl == module->heavy_tl);
     return mca_btl_uct_endpoint_check(module, endpoint, context, ep_handle,
-                                      module->am_tl->tl_index);
+                                      context->tl->tl_index);
+}
+
+mca_btl_uct_device_context_t *mca_btl_uct_endpoint_heavy_context(mca_btl_uct_module_t *module,
+                                                                 mca_btl_uct_endpoint_t *endpoint,
+                                                                 mca_btl_uct_device_context_t *context);
+
+/**
+ * @brief Pick the device context of an active message of size bytes
+ *
+ * @param[in] module      UCT BTL module
+ * @param[in] endpoint    UCT BTL endpoint
+ * @param[in] context     context of the am tl of the calling thread
+ * @param[in] size        message size
+ *
+ * With a heavy tl, the bytes sent to each peer over the dynamically connected
+ * am tl are counted. Once they cross btl_uct_dc_rc_threshold the messages to the
+ * peer go over the connected heavy tl, as soon as its endpoint is connected.
+ */
+static inline mca_btl_uct_device_context_t *
+mca_btl_uct_endpoint_am_context(mca_btl_uct_module_t *module, mca_btl_uct_endpoint_t *endpoint,
+                                mca_btl_uct_device_context_t *context, size_t size)
+{
+    if (OPAL_LIKELY(NULL == module->heavy_tl)
+        || MCA_BTL_UCT_HEAVY_DISABLED == endpoint->heavy_state) {
+        return context;
+    }
+
+    if (MCA_BTL_UCT_HEAVY_NONE == endpoint->heavy_state) {
+        /* concurrent senders may lose some bytes, this only delays the switch */
+        endpoint->am_bytes += size;
+        if (endpoint->am_bytes < mca_btl_uct_component.dc_rc_threshold) {
+            return context;
+        }
+    }
+
+    return mca_btl_uct_endpoint_heavy_context(module, endpoint, context);
 }
 
 END_C_DECLS
@@ -274,6 +274,10 @@ int mca_btl_uct_finalize(mca_btl_base_module_t *btl)
     mca_btl_uct_endpoint_t *endpoint;
     uint64_t key;
 
+    /* the batches are released with their endpoints */
+    while (NULL != opal_list_remove_first(&uct_module->pending_batches)) {
+    }
+
     /* clean up any leftover endpoints */
     OPAL_HASH_TABLE_FOREACH (key, uint64, endpoint, &uct_module->id_to_endpoint) {
         OBJ_RELEASE(endpoint);
@@ -283,6 +287,7 @@ int mca_btl_uct_finalize(mca_btl_base_module_t *btl)
     OBJ_DESTRUCT(&uct_module->eager_frags);
     OBJ_DESTRUCT(&uct_module->max_frags);
     OBJ_DESTRUCT(&uct_module->pending_frags);
+    OBJ_DESTRUCT(&uct_module->pending_batches);
     OBJ_DESTRUCT(&uct_module->lock);
     OBJ_DESTRUCT(&uct_module->pending_connection_reqs);
 
@@ -298,6 +303,10 @@ int mca_btl_uct_finalize(mca_btl_base_module_t *btl)
         OBJ_RELEASE(uct_module->conn_tl);
     }
 
+    if (NULL != uct_module->heavy_tl) {
+        OBJ_RELEASE(uct_module->heavy_tl);
+    }
+
     if (NULL != uct_module->rdma_tl) {
         OBJ_RELEASE(uct_module->rdma_tl);
     }
@@ -18,6 +18,7 @@
 #include "btl_uct_device_context.h"
 #include "opal/util/argv.h"
 #include "opal/util/bit_ops.h"
+#include "opal/util/minmax.h"
 
 #if HAVE_DECL_UCT_CB_FLAG_SYNC
 #    define MCA_BTL_UCT_CB_FLAG_SYNC UCT_CB_FLAG_SYNC
@@ -309,6 +310,7 @@ mca_btl_uct_device_context_t *mca_btl_uct_context_create(mca_btl_uct_module_t *m
 
     context->context_id = context_id;
     context->uct_btl = module;
+    context->tl = tl;
     OBJ_CONSTRUCT(&context->completion_fifo, opal_fifo_t);
     OBJ_CONSTRUCT(&context->mutex, opal_recursive_mutex_t);
     OBJ_CONSTRUCT(&context->rdma_completions, opal_free_list_t);
@@ -348,10 +350,12 @@ mca_btl_uct_device_context_t *mca_btl_uct_context_create(mca_btl_uct_module_t *m
         return NULL;
     }
 
-    if (context_id > 0 && tl == module->am_tl) {
+    if (context_id > 0 && (tl == module->am_tl || tl == module->heavy_tl)) {
         BTL_VERBOSE(("installing AM handler for tl %p context id %d", (void *) tl, context_id));
         uct_iface_set_am_handler(context->uct_iface, MCA_BTL_UCT_FRAG, mca_btl_uct_am_handler,
                                  context, MCA_BTL_UCT_CB_FLAG_SYNC);
+        uct_iface_set_am_handler(context->uct_iface, MCA_BTL_UCT_FRAG_BATCH,
+                                 mca_btl_uct_am_batch_handler, context, MCA_BTL_UCT_CB_FLAG_SYNC);
     }
 
     if (enable_progress) {
@@ -412,6 +416,18 @@ static mca_btl_uct_tl_t *mca_btl_uct_create_tl(mca_btl_uct_module_t *module, mca
 
     (void) uct_md_iface_config_read(md->uct_md, tl_desc->tl_name, NULL, NULL, &tl->uct_tl_config);
 
+    if (mca_btl_uct_component.dc_num_dci > 0 && NULL != tl->uct_tl_config
+        && mca_btl_uct_tl_is_dc(tl)) {
+        char num_dci[16];
+
+        /* each context opens its own interface, hence its own DCI pool */
+        snprintf(num_dci, sizeof(num_dci), "%d", mca_btl_uct_component.dc_num_dci);
+        if (UCS_OK != uct_config_modify(tl->uct_tl_config, "NUM_DCI", num_dci)) {
+            BTL_VERBOSE(("could not set the number of DCIs of tl %s to %s", tl->uct_tl_name,
+                         num_dci));
+        }
+    }
+
     /* always create a 0 context (needed to query) */
     tl->uct_dev_contexts[0] = mca_btl_uct_context_create(module, tl, 0, false);
     if (NULL == tl->uct_dev_contexts[0]) {
@@ -473,6 +489,14 @@ static void mca_btl_uct_set_tl_am(mca_btl_uct_module_t *module, mca_btl_uct_tl_t
 
     uct_iface_set_am_handler(tl->uct_dev_contexts[0]->uct_iface, MCA_BTL_UCT_FRAG,
                              mca_btl_uct_am_handler, tl->uct_dev_contexts[0], UCT_CB_FLAG_ASYNC);
+    uct_iface_set_am_handler(tl->uct_dev_contexts[0]->uct_iface, MCA_BTL_UCT_FRAG_BATCH,
+                             mca_btl_uct_am_batch_handler, tl->uct_dev_contexts[0],
+                             UCT_CB_FLAG_ASYNC);
+
+    if (mca_btl_uct_component.am_batch_size > 0) {
+        module->am_batch_size = opal_min(mca_btl_uct_component.am_batch_size,
+                                         (size_t) MCA_BTL_UCT_TL_ATTR(tl, 0).cap.am.max_bcopy);
+    }
 
     tl->tl_index = (module->rdma_tl && tl != module->rdma_tl) ? 1 : 0;
     module->comm_tls[tl->tl_index] = tl;
@@ -490,6 +514,52 @@ static void mca_btl_uct_set_tl_am(mca_btl_uct_module_t *module, mca_btl_uct_tl_t
     }
 }
 
+/**
+ * @brief Checks if tl can carry the active messages of am_tl to the heavy peers
+ */
+static bool mca_btl_uct_tl_suits_heavy(mca_btl_uct_module_t *module, mca_btl_uct_tl_t *tl)
+{
+    uct_iface_attr_t *am_attr = &MCA_BTL_UCT_TL_ATTR(module->am_tl, 0);
+    uct_iface_attr_t *attr = &MCA_BTL_UCT_TL_ATTR(tl, 0);
+
+    /* the fragments are sized for am_tl */
+    if (tl == module->am_tl || !mca_btl_uct_tl_requires_connection_tl(tl)
+        || (attr->cap.flags & am_attr->cap.flags & (UCT_IFACE_FLAG_AM_SHORT | UCT_IFACE_FLAG_AM_BCOPY
+                                                    | UCT_IFACE_FLAG_AM_ZCOPY))
+               != (am_attr->cap.flags & (UCT_IFACE_FLAG_AM_SHORT | UCT_IFACE_FLAG_AM_BCOPY
+                                         | UCT_IFACE_FLAG_AM_ZCOPY))) {
+        return false;
+    }
+
+    return attr->cap.am.max_short >= am_attr->cap.am.max_short
+           && attr->cap.am.max_bcopy >= am_attr->cap.am.max_bcopy
+           && (!(am_attr->cap.flags & UCT_IFACE_FLAG_AM_ZCOPY)
+               || attr->cap.am.max_zcopy >= am_attr->cap.am.max_zcopy);
+}
+
+static void mca_btl_uct_set_tl_heavy(mca_btl_uct_module_t *module, mca_btl_uct_tl_t *tl)
+{
+    BTL_VERBOSE(("tl %s is suitable for the active messages of the heavy peers of tl %s",
+                 tl->uct_tl_name, module->am_tl->uct_tl_name));
+
+    module->heavy_tl = tl;
+    OBJ_RETAIN(tl);
+
+    uct_iface_set_am_handler(tl->uct_dev_contexts[0]->uct_iface, MCA_BTL_UCT_FRAG,
+                             mca_btl_uct_am_handler, tl->uct_dev_contexts[0], UCT_CB_FLAG_ASYNC);
+    uct_iface_set_am_handler(tl->uct_dev_contexts[0]->uct_iface, MCA_BTL_UCT_FRAG_BATCH,
+                             mca_btl_uct_am_batch_handler, tl->uct_dev_contexts[0],
+                             UCT_CB_FLAG_ASYNC);
+
+    tl->tl_index = 1;
+    module->comm_tls[1] = tl;
+    if (tl->max_device_contexts <= 1) {
+        tl->max_device_contexts = mca_btl_uct_component.num_contexts_per_module;
+    }
+
+    mca_btl_uct_context_enable_progress(tl->uct_dev_contexts[0]);
+}
+
 static int mca_btl_uct_set_tl_conn(mca_btl_uct_module_t *module, mca_btl_uct_tl_t *tl)
 {
     int rc;
@@ -662,6 +732,18 @@ int mca_btl_uct_query_tls(mca_btl_uct_module_t *module, mca_btl_uct_md_t *md,
         module->super.btl_atomic_op = NULL;
     }
 
+    if (mca_btl_uct_component.dc_rc_threshold > 0 && NULL != module->am_tl
+        && mca_btl_uct_tl_is_dc(module->am_tl) && NULL == module->comm_tls[1]
+        && NULL != module->conn_tl) {
+        /* keep the connected endpoints for the peers with the most traffic */
+        OPAL_LIST_FOREACH (tl, &tl_list, mca_btl_uct_tl_t) {
+            if (mca_btl_uct_tl_suits_heavy(module, tl)) {
+                mca_btl_uct_set_tl_heavy(module, tl);
+                break;
+            }
+        }
+    }
+
     if (NULL == module->am_tl) {
         /* no active message tls == no send/recv */
         BTL_VERBOSE(("no active message tl matched supplied filter. disabling send/recv support"));
@@ -676,7 +758,7 @@ int mca_btl_uct_query_tls(mca_btl_uct_module_t *module, mca_btl_uct_md_t *md,
 
     if (!(NULL != module->am_tl && mca_btl_uct_tl_requires_connection_tl(module->am_tl))
         && !(NULL != module->rdma_tl && mca_btl_uct_tl_requires_connection_tl(module->rdma_tl))
-        && module->conn_tl) {
+        && NULL == module->heavy_tl && module->conn_tl) {
         /* no connection tl needed for selected transports */
         OBJ_RELEASE(module->conn_tl);
         module->conn_tl = NULL;
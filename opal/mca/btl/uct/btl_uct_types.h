@@ -18,6 +18,7 @@
 struct mca_btl_uct_module_t;
 struct mca_btl_base_endpoint_t;
 struct mca_btl_uct_base_frag_t;
+struct mca_btl_uct_tl_t;
 
 /* TL endpoint flags */
 /** connection data was received */
@@ -27,11 +28,21 @@ struct mca_btl_uct_base_frag_t;
 /** connection was established */
 #    define MCA_BTL_UCT_ENDPOINT_FLAG_CONN_READY 0x4
 
+/* states of the heavy tl of an endpoint (see mca_btl_uct_endpoint_am_context) */
+/** active messages go over the am tl */
+#    define MCA_BTL_UCT_HEAVY_NONE 0
+/** the traffic to the peer crossed the threshold, the heavy tl is used once connected */
+#    define MCA_BTL_UCT_HEAVY_ACTIVE 1
+/** the peer can not be reached over the heavy tl */
+#    define MCA_BTL_UCT_HEAVY_DISABLED 2
+
 /* AM tags */
 /** BTL fragment */
 #    define MCA_BTL_UCT_FRAG 0x0d
 /** connection request */
 #    define MCA_BTL_UCT_CONNECT_RDMA 0x0e
+/** several BTL fragments packed in one message (see mca_btl_uct_am_batch_t) */
+#    define MCA_BTL_UCT_FRAG_BATCH 0x0f
 
 /** maximum number of modules supported by the btl component */
 #    define MCA_BTL_UCT_MAX_MODULES 16
@@ -134,6 +145,9 @@ struct mca_btl_uct_device_context_t {
     /** btl module this context is associated with */
     struct mca_btl_uct_module_t *uct_btl;
 
+    /** transport this context belongs to */
+    struct mca_btl_uct_tl_t *tl;
+
     /** mutex for protecting the UCT worker */
     opal_recursive_mutex_t mutex;
 
@@ -181,6 +195,66 @@ union mca_btl_uct_am_header_t {
 
 typedef union mca_btl_uct_am_header_t mca_btl_uct_am_header_t;
 
+/**
+ * @brief Header of each fragment in a MCA_BTL_UCT_FRAG_BATCH message
+ *
+ * The fragment data follows the header and is padded to a multiple of
+ * 8 bytes so that the next header is aligned.
+ */
+struct mca_btl_uct_batch_header_t {
+    /** length of the fragment data */
+    uint32_t length;
+
+    /** callback tag */
+    mca_btl_base_tag_t tag;
+
+    /** padding */
+    uint8_t padding[3];
+};
+
+typedef struct mca_btl_uct_batch_header_t mca_btl_uct_batch_header_t;
+
+/**
+ * @brief Fragments waiting to be sent to an endpoint in one message
+ *
+ * Short messages given to btl_sendi are copied here when
+ * btl_uct_am_batch_size is set. The batch is sent when the next message
+ * does not fit, when a message to the endpoint takes another path, or
+ * from the progress engine.
+ */
+struct mca_btl_uct_am_batch_t {
+    /** on the pending_batches list of the module */
+    opal_list_item_t super;
+
+    /** protects the batch */
+    opal_mutex_t lock;
+
+    /** endpoint the batch belongs to */
+    struct mca_btl_base_endpoint_t *endpoint;
+
+    /** device context the batch is sent on */
+    mca_btl_uct_device_context_t *context;
+
+    /** packed fragments */
+    void *buffer;
+
+    /** bytes used in the buffer */
+    size_t used;
+
+    /** size of the buffer */
+    size_t capacity;
+
+    /** number of fragments in the batch */
+    int count;
+
+    /** the batch is on the pending_batches list of the module */
+    bool pending;
+};
+
+typedef struct mca_btl_uct_am_batch_t mca_btl_uct_am_batch_t;
+
+OBJ_CLASS_DECLARATION(mca_btl_uct_am_batch_t);
+
 /**
  * @brief structure to keep track of btl callback
  *
@@ -282,6 +356,15 @@ struct mca_btl_base_endpoint_t {
     /** cached connection endpoint */
     mca_btl_uct_connection_ep_t *conn_ep;
 
+    /** short fragments waiting to be sent together (NULL if batching is disabled) */
+    mca_btl_uct_am_batch_t *am_batch;
+
+    /** bytes of active messages sent to the peer over the am tl */
+    size_t am_bytes;
+
+    /** state of the heavy tl to the peer (MCA_BTL_UCT_HEAVY_*) */
+    int32_t heavy_state;
+
     /** endpoints into UCT for this BTL endpoint */
     mca_btl_uct_tl_endpoint_t uct_eps[][2];
 };
@@ -201,6 +201,14 @@ typedef struct opal_btl_usnic_component_t {
         checking to see if standalone ACKs need to be sent */
     int ack_iteration_delay;
 
+    /** maximum delay of the standalone ACKs of the endpoints that
+        stream segments */
+    int ack_iteration_delay_max;
+
+    /** number of received segments after which an ACK is sent
+        without waiting for the delay */
+    int ack_segment_limit;
+
     /** transport header length for all usNIC devices on this server
         (it is guaranteed that all usNIC devices on a single server
         will have the same underlying transport, and therefore the
@@ -235,6 +235,26 @@ int opal_btl_usnic_ack_send(opal_btl_usnic_module_t *module, opal_btl_usnic_endp
     /* send the ACK */
     opal_btl_usnic_post_ack(module, endpoint, ack);
 
+    /* Adapt the delay of the next standalone ACK to the traffic: an
+       endpoint that reached the segment limit is streaming and can
+       coalesce more, one with a single segment to ACK is not and gets
+       its ACKs sooner. */
+    if (endpoint->endpoint_rcvd_since_ack
+        >= (uint32_t) mca_btl_usnic_component.ack_segment_limit) {
+        endpoint->endpoint_ack_delay *= 2;
+        if (endpoint->endpoint_ack_delay < 1) {
+            endpoint->endpoint_ack_delay = 1;
+        }
+        if (endpoint->endpoint_ack_delay > mca_btl_usnic_component.ack_iteration_delay_max) {
+            endpoint->endpoint_ack_delay = mca_btl_usnic_component.ack_iteration_delay_max;
+        }
+    } else if (endpoint->endpoint_rcvd_since_ack <= 1) {
+        endpoint->endpoint_ack_delay /= 2;
+        if (endpoint->endpoint_ack_delay < mca_btl_usnic_component.ack_iteration_delay) {
+            endpoint->endpoint_ack_delay = mca_btl_usnic_component.ack_iteration_delay;
+        }
+    }
+
     /* Stats */
     ++module->stats.num_ack_sends;
 
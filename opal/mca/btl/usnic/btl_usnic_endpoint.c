@@ -68,6 +68,8 @@ static void endpoint_construct(mca_btl_base_endpoint_t *endpoint)
 
     endpoint->endpoint_next_frag_id = 1;
     endpoint->endpoint_acktime = 0;
+    endpoint->endpoint_rcvd_since_ack = 0;
+    endpoint->endpoint_ack_delay = mca_btl_usnic_component.ack_iteration_delay;
 
     /* endpoint starts not-ready-to-send */
     endpoint->endpoint_ready_to_send = 0;
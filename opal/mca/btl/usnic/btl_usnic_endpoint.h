@@ -173,6 +173,11 @@ typedef struct mca_btl_base_endpoint_t {
      */
     uint64_t endpoint_acktime;
 
+    /* Segments received since the last ACK, and the current delay of
+     * the standalone ACKs (adapted to the traffic of the endpoint) */
+    uint32_t endpoint_rcvd_since_ack;
+    int endpoint_ack_delay;
+
     opal_btl_usnic_seq_t endpoint_next_contig_seq_to_recv; /* n_r */
     opal_btl_usnic_seq_t endpoint_highest_seq_rcvd;        /* n_s */
 
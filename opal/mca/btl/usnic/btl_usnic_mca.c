@@ -244,6 +244,25 @@ int opal_btl_usnic_component_register(void)
                   4, &mca_btl_usnic_component.ack_iteration_delay, REGINT_GE_ZERO,
                   OPAL_INFO_LVL_5));
 
+    CHECK(reg_int("ack_iteration_delay_max",
+                  "Maximum number of times through usNIC \"progress\" function before sending a "
+                  "standalone ACK; the delay of an endpoint grows up to this value while it keeps "
+                  "streaming segments, and falls back to ack_iteration_delay when its traffic is "
+                  "sparse",
+                  64, &mca_btl_usnic_component.ack_iteration_delay_max, REGINT_GE_ZERO,
+                  OPAL_INFO_LVL_5));
+
+    CHECK(reg_int("ack_segment_limit",
+                  "Number of segments received from an endpoint after which an ACK is sent "
+                  "without waiting for the ACK delay",
+                  WINDOW_SIZE / 4, &mca_btl_usnic_component.ack_segment_limit, REGINT_GE_ONE,
+                  OPAL_INFO_LVL_5));
+    if (mca_btl_usnic_component.ack_iteration_delay_max
+        < mca_btl_usnic_component.ack_iteration_delay) {
+        mca_btl_usnic_component.ack_iteration_delay_max = mca_btl_usnic_component
+                                                              .ack_iteration_delay;
+    }
+
     CHECK(reg_int("priority_limit",
                   "Max size of \"priority\" messages (0 = use pre-set defaults; depends on number "
                   "and type of devices available)",
@@ -256,6 +256,7 @@ opal_btl_usnic_remove_from_endpoints_needing_ack(opal_btl_usnic_endpoint_t *endp
                           &endpoint->endpoint_ack_li);
     endpoint->endpoint_ack_needed = false;
     endpoint->endpoint_acktime = 0;
+    endpoint->endpoint_rcvd_since_ack = 0;
 #if MSGDEBUG1
     opal_output(0, "clear ack_needed on %p\n", (void *) endpoint);
 #endif
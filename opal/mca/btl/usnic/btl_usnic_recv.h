@@ -107,10 +107,16 @@ static inline void opal_btl_usnic_update_window(opal_btl_usnic_endpoint_t *endpo
     }
 
     /* A hueristic: set to send this ACK after we have checked our
-       incoming DATA_CHANNEL component.act_iteration_delay times
-       (i.e., so we can piggyback an ACK on an outgoing send) */
-    if (0 == endpoint->endpoint_acktime) {
-        endpoint->endpoint_acktime = get_ticks() + mca_btl_usnic_component.ack_iteration_delay;
+       incoming DATA_CHANNEL endpoint_ack_delay times (i.e., so we can
+       piggyback an ACK on an outgoing send).  Do not hold it once
+       enough segments are waiting for it, the sender window would
+       stall. */
+    ++endpoint->endpoint_rcvd_since_ack;
+    if (endpoint->endpoint_rcvd_since_ack
+        >= (uint32_t) mca_btl_usnic_component.ack_segment_limit) {
+        endpoint->endpoint_acktime = 0;
+    } else if (0 == endpoint->endpoint_acktime) {
+        endpoint->endpoint_acktime = get_ticks() + endpoint->endpoint_ack_delay;
     }
 
     /* Save this incoming segment in the received segmentss array on the
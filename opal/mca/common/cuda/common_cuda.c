@@ -2,7 +2,7 @@
  * Copyright (c) 2004-2006 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2014 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -42,6 +42,7 @@
 #include "opal/mca/dl/base/base.h"
 #include "opal/mca/rcache/base/base.h"
 #include "opal/mca/timer/base/base.h"
+#include "opal/memoryhooks/memory.h"
 #include "opal/runtime/opal_params.h"
 
 #include "common_cuda.h"
@@ -76,6 +77,8 @@ struct cudaFunctionTable {
     int (*cuPointerGetAttribute)(void *, CUpointer_attribute, CUdeviceptr);
     int (*cuMemcpyAsync)(CUdeviceptr, CUdeviceptr, size_t, CUstream);
     int (*cuMemcpy)(CUdeviceptr, CUdeviceptr, size_t);
+    int (*cuMemcpy2DAsync)(const CUDA_MEMCPY2D *, CUstream);
+    int (*cuMemcpy2D)(const CUDA_MEMCPY2D *);
     int (*cuMemAlloc)(CUdeviceptr *, size_t);
     int (*cuMemFree)(CUdeviceptr buf);
     int (*cuCtxGetCurrent)(void *cuContext);
@@ -106,6 +109,9 @@ struct cudaFunctionTable {
 #if OPAL_CUDA_GET_ATTRIBUTES
     int (*cuPointerGetAttributes)(unsigned int, CUpointer_attribute *, void **, CUdeviceptr);
 #endif /* OPAL_CUDA_GET_ATTRIBUTES */
+#if CUDA_VERSION >= 10000
+    int (*cuLaunchHostFunc)(CUstream, CUhostFn, void *); /* optional, NULL if not found */
+#endif /* CUDA_VERSION >= 10000 */
 };
 typedef struct cudaFunctionTable cudaFunctionTable_t;
 static cudaFunctionTable_t cuFunc;
@@ -120,7 +126,13 @@ bool mca_common_cuda_enabled = false;
 static bool mca_common_cuda_register_memory = true;
 static bool mca_common_cuda_warning = false;
 static opal_list_t common_cuda_memory_registrations;
-static CUstream ipcStream = NULL;
+/* The large IPC copies are split in chunks spread over several streams
+ * so that they can use more than one copy engine. */
+#define MCA_COMMON_CUDA_IPC_STREAMS_MAX 8
+static CUstream ipcStreams[MCA_COMMON_CUDA_IPC_STREAMS_MAX];
+static int ipcStream_next = 0;
+static int mca_common_cuda_ipc_streams = 4;
+static size_t mca_common_cuda_ipc_pipeline_size = 4 * 1024 * 1024;
 static CUstream dtohStream = NULL;
 static CUstream htodStream = NULL;
 static CUstream memcpyStream = NULL;
@@ -130,14 +142,36 @@ static opal_mutex_t common_cuda_htod_lock;
 static opal_mutex_t common_cuda_dtoh_lock;
 static opal_mutex_t common_cuda_ipc_lock;
 
+/* Cache of the device allocations recently seen by
+ * mca_common_cuda_is_gpu_buffer, so that the buffers of the repeated
+ * transfers do not query the driver each time.  An entry is dropped when
+ * the range is released (memory hooks) or freed through
+ * mca_common_cuda_free. */
+#define COMMON_CUDA_PTR_CACHE_SIZE 16
+struct common_cuda_ptr_cache_entry_t {
+    uintptr_t base;
+    size_t size;
+    CUcontext ctx;
+    bool managed;
+};
+typedef struct common_cuda_ptr_cache_entry_t common_cuda_ptr_cache_entry_t;
+static common_cuda_ptr_cache_entry_t common_cuda_ptr_cache[COMMON_CUDA_PTR_CACHE_SIZE];
+static int common_cuda_ptr_cache_next = 0;
+static bool common_cuda_ptr_cache_enabled = false;
+static bool mca_common_cuda_ptr_cache = true;
+static opal_mutex_t common_cuda_ptr_cache_lock;
+
 /* Functions called by opal layer - plugged into opal function table */
 static int mca_common_cuda_is_gpu_buffer(const void *, opal_convertor_t *);
 static int mca_common_cuda_memmove(void *, void *, size_t);
 static int mca_common_cuda_cu_memcpy_async(void *, const void *, size_t, opal_convertor_t *);
 static int mca_common_cuda_cu_memcpy(void *, const void *, size_t);
+static int mca_common_cuda_cu_memcpy_2d(void *, size_t, const void *, size_t, size_t, size_t,
+                                        opal_convertor_t *);
 
 /* Function that gets plugged into opal layer */
 static int mca_common_cuda_stage_two_init(opal_common_cuda_function_table_t *);
+static void common_cuda_ptr_cache_mem_cb(void *base, size_t size, void *cbdata, bool from_alloc);
 
 /* Structure to hold memory registrations that are delayed until first
  * call to send or receive a GPU pointer */
@@ -262,6 +296,31 @@ void mca_common_cuda_register_mca_variables(void)
                                  NULL, 0, 0, OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
                                  &cuda_event_max);
 
+    /* Number of streams the IPC copies are spread over */
+    mca_common_cuda_ipc_streams = 4;
+    (void) mca_base_var_register("ompi", "mpi", "common_cuda", "ipc_streams",
+                                 "Number of CUDA streams the large IPC copies are split over "
+                                 "(between 1 and 8)",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &mca_common_cuda_ipc_streams);
+
+    /* Smallest chunk of an IPC copy issued on its own stream */
+    mca_common_cuda_ipc_pipeline_size = 4 * 1024 * 1024;
+    (void) mca_base_var_register("ompi", "mpi", "common_cuda", "ipc_pipeline_size",
+                                 "IPC copies larger than this are split in chunks of at least this "
+                                 "size copied on different streams",
+                                 MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &mca_common_cuda_ipc_pipeline_size);
+
+    /* Cache the device allocations found by the buffer checks */
+    mca_common_cuda_ptr_cache = true;
+    (void) mca_base_var_register("ompi", "mpi", "common_cuda", "pointer_cache",
+                                 "Whether to cache the address ranges of the device buffers "
+                                 "instead of querying the driver on every transfer (only used "
+                                 "when the memory hooks report the released memory)",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &mca_common_cuda_ptr_cache);
+
     /* Use this flag to test cuMemcpyAsync vs cuMemcpy */
     mca_common_cuda_cumemcpy_async = 1;
     (void) mca_base_var_register(
@@ -321,6 +380,7 @@ int mca_common_cuda_stage_one_init(void)
     OBJ_CONSTRUCT(&common_cuda_htod_lock, opal_mutex_t);
     OBJ_CONSTRUCT(&common_cuda_dtoh_lock, opal_mutex_t);
     OBJ_CONSTRUCT(&common_cuda_ipc_lock, opal_mutex_t);
+    OBJ_CONSTRUCT(&common_cuda_ptr_cache_lock, opal_mutex_t);
 
     mca_common_cuda_output = opal_output_open(NULL);
     opal_output_set_verbosity(mca_common_cuda_output, mca_common_cuda_verbose);
@@ -435,6 +495,8 @@ int mca_common_cuda_stage_one_init(void)
     OPAL_CUDA_DLSYM(libcuda_handle, cuStreamWaitEvent);
     OPAL_CUDA_DLSYM(libcuda_handle, cuMemcpyAsync);
     OPAL_CUDA_DLSYM(libcuda_handle, cuMemcpy);
+    OPAL_CUDA_DLSYM(libcuda_handle, cuMemcpy2DAsync);
+    OPAL_CUDA_DLSYM(libcuda_handle, cuMemcpy2D);
     OPAL_CUDA_DLSYM(libcuda_handle, cuMemFree);
     OPAL_CUDA_DLSYM(libcuda_handle, cuMemAlloc);
     OPAL_CUDA_DLSYM(libcuda_handle, cuMemGetAddressRange);
@@ -456,6 +518,19 @@ int mca_common_cuda_stage_one_init(void)
 #if OPAL_CUDA_GET_ATTRIBUTES
     OPAL_CUDA_DLSYM(libcuda_handle, cuPointerGetAttributes);
 #endif /* OPAL_CUDA_GET_ATTRIBUTES */
+#if CUDA_VERSION >= 10000
+    {
+        /* only used by the stream triggered operations, older drivers do without */
+        char *err_msg;
+        void *ptr;
+        if (OPAL_SUCCESS == opal_dl_lookup(libcuda_handle, "cuLaunchHostFunc", &ptr, &err_msg)) {
+            *(void **) (&cuFunc.cuLaunchHostFunc) = ptr;
+        } else {
+            opal_output_verbose(10, mca_common_cuda_output, "CUDA: no cuLaunchHostFunc: %s",
+                                err_msg);
+        }
+    }
+#endif /* CUDA_VERSION >= 10000 */
     return 0;
 }
 
@@ -475,6 +550,7 @@ static int mca_common_cuda_stage_two_init(opal_common_cuda_function_table_t *fta
     ftable->gpu_is_gpu_buffer = &mca_common_cuda_is_gpu_buffer;
     ftable->gpu_cu_memcpy_async = &mca_common_cuda_cu_memcpy_async;
     ftable->gpu_cu_memcpy = &mca_common_cuda_cu_memcpy;
+    ftable->gpu_cu_memcpy_2d = &mca_common_cuda_cu_memcpy_2d;
     ftable->gpu_memmove = &mca_common_cuda_memmove;
     ftable->gpu_malloc = &mca_common_cuda_malloc;
     ftable->gpu_free = &mca_common_cuda_free;
@@ -691,13 +767,20 @@ static int mca_common_cuda_stage_three_init(void)
         OBJ_RELEASE(mem_reg);
     }
 
-    /* Create stream for use in ipc asynchronous copies */
-    res = cuFunc.cuStreamCreate(&ipcStream, 0);
-    if (OPAL_UNLIKELY(res != CUDA_SUCCESS)) {
-        opal_show_help("help-mpi-common-cuda.txt", "cuStreamCreate failed", true,
-                       OPAL_PROC_MY_HOSTNAME, res);
-        rc = OPAL_ERROR;
-        goto cleanup_and_error;
+    /* Create streams for use in ipc asynchronous copies */
+    if (mca_common_cuda_ipc_streams < 1) {
+        mca_common_cuda_ipc_streams = 1;
+    } else if (mca_common_cuda_ipc_streams > MCA_COMMON_CUDA_IPC_STREAMS_MAX) {
+        mca_common_cuda_ipc_streams = MCA_COMMON_CUDA_IPC_STREAMS_MAX;
+    }
+    for (i = 0; i < mca_common_cuda_ipc_streams; i++) {
+        res = cuFunc.cuStreamCreate(&ipcStreams[i], 0);
+        if (OPAL_UNLIKELY(res != CUDA_SUCCESS)) {
+            opal_show_help("help-mpi-common-cuda.txt", "cuStreamCreate failed", true,
+                           OPAL_PROC_MY_HOSTNAME, res);
+            rc = OPAL_ERROR;
+            goto cleanup_and_error;
+        }
     }
 
     /* Create stream for use in dtoh asynchronous copies */
@@ -744,6 +827,17 @@ static int mca_common_cuda_stage_three_init(void)
     opal_output_verbose(20, mca_common_cuda_output, "CUDA: the extra gpu memory check is %s",
                         (mca_common_cuda_gpu_mem_check_workaround == 1) ? "on" : "off");
 
+    /* The cached ranges have to be dropped when they are released */
+    if (mca_common_cuda_ptr_cache
+        && ((OPAL_MEMORY_FREE_SUPPORT | OPAL_MEMORY_MUNMAP_SUPPORT)
+            == ((OPAL_MEMORY_FREE_SUPPORT | OPAL_MEMORY_MUNMAP_SUPPORT)
+                & opal_mem_hooks_support_level()))
+        && OPAL_SUCCESS == opal_mem_hooks_register_release(common_cuda_ptr_cache_mem_cb, NULL)) {
+        common_cuda_ptr_cache_enabled = true;
+    }
+    opal_output_verbose(20, mca_common_cuda_output, "CUDA: the device pointer cache is %s",
+                        common_cuda_ptr_cache_enabled ? "on" : "off");
+
     opal_output_verbose(30, mca_common_cuda_output, "CUDA: initialized");
     opal_atomic_mb(); /* Make sure next statement does not get reordered */
     common_cuda_initialized = true;
@@ -806,6 +900,11 @@ void mca_common_cuda_fini(void)
             20, mca_common_cuda_output,
             "CUDA: mca_common_cuda_fini, cuMemHostUnregister returned %d, ctx_ok=%d", res, ctx_ok);
 
+        if (common_cuda_ptr_cache_enabled) {
+            opal_mem_hooks_unregister_release(common_cuda_ptr_cache_mem_cb);
+            common_cuda_ptr_cache_enabled = false;
+        }
+
         if (NULL != cuda_event_ipc_array) {
             if (ctx_ok) {
                 for (i = 0; i < cuda_event_max; i++) {
@@ -847,8 +946,11 @@ void mca_common_cuda_fini(void)
         if (NULL != cuda_event_dtoh_frag_array) {
             free(cuda_event_dtoh_frag_array);
         }
-        if ((NULL != ipcStream) && ctx_ok) {
-            cuFunc.cuStreamDestroy(ipcStream);
+        for (i = 0; i < MCA_COMMON_CUDA_IPC_STREAMS_MAX; i++) {
+            if ((NULL != ipcStreams[i]) && ctx_ok) {
+                cuFunc.cuStreamDestroy(ipcStreams[i]);
+                ipcStreams[i] = NULL;
+            }
         }
         if ((NULL != dtohStream) && ctx_ok) {
             cuFunc.cuStreamDestroy(dtohStream);
@@ -863,6 +965,7 @@ void mca_common_cuda_fini(void)
         OBJ_DESTRUCT(&common_cuda_htod_lock);
         OBJ_DESTRUCT(&common_cuda_dtoh_lock);
         OBJ_DESTRUCT(&common_cuda_ipc_lock);
+        OBJ_DESTRUCT(&common_cuda_ptr_cache_lock);
         if (NULL != libcuda_handle) {
             opal_dl_close(libcuda_handle);
         }
@@ -1224,13 +1327,17 @@ void mca_common_wait_stream_synchronize(mca_rcache_common_cuda_reg_t *rget_reg)
 
 /*
  * Start the asynchronous copy.  Then record and save away an event that will
- * be queried to indicate the copy has completed.
+ * be queried to indicate the copy has completed.  A large copy is split in
+ * chunks issued on different streams, each chunk records its own event and
+ * only the event of the last chunk carries the frag.  The events are
+ * completed in order so the frag is returned once all its chunks are done.
  */
 int mca_common_cuda_memcpy(void *dst, void *src, size_t amount, char *msg,
                            struct mca_btl_base_descriptor_t *frag, int *done)
 {
     CUresult result;
-    int iter;
+    int iter, nchunks = 1;
+    size_t chunk = amount, offset = 0;
 
     OPAL_THREAD_LOCK(&common_cuda_ipc_lock);
     /* First make sure there is room to store the event.  If not, then
@@ -1255,37 +1362,64 @@ int mca_common_cuda_memcpy(void *dst, void *src, size_t amount, char *msg,
     /* This is the standard way to run.  Running with synchronous copies is available
      * to measure the advantages of asynchronous copies. */
     if (OPAL_LIKELY(mca_common_cuda_async)) {
-        result = cuFunc.cuMemcpyAsync((CUdeviceptr) dst, (CUdeviceptr) src, amount, ipcStream);
-        if (OPAL_UNLIKELY(CUDA_SUCCESS != result)) {
-            opal_show_help("help-mpi-common-cuda.txt", "cuMemcpyAsync failed", true, dst, src,
-                           amount, result);
-            OPAL_THREAD_UNLOCK(&common_cuda_ipc_lock);
-            return OPAL_ERROR;
-        } else {
-            opal_output_verbose(20, mca_common_cuda_output,
-                                "CUDA: cuMemcpyAsync passed: dst=%p, src=%p, size=%d", dst, src,
-                                (int) amount);
-        }
-        result = cuFunc.cuEventRecord(cuda_event_ipc_array[cuda_event_ipc_first_avail], ipcStream);
-        if (OPAL_UNLIKELY(CUDA_SUCCESS != result)) {
-            opal_show_help("help-mpi-common-cuda.txt", "cuEventRecord failed", true,
-                           OPAL_PROC_MY_HOSTNAME, result);
-            OPAL_THREAD_UNLOCK(&common_cuda_ipc_lock);
-            return OPAL_ERROR;
+        if (mca_common_cuda_ipc_streams > 1 && 0 < mca_common_cuda_ipc_pipeline_size
+            && amount > mca_common_cuda_ipc_pipeline_size) {
+            nchunks = (int) ((amount + mca_common_cuda_ipc_pipeline_size - 1)
+                             / mca_common_cuda_ipc_pipeline_size);
+            if (nchunks > mca_common_cuda_ipc_streams) {
+                nchunks = mca_common_cuda_ipc_streams;
+            }
+            /* do not run out of events because of the split */
+            if (nchunks > cuda_event_max - cuda_event_ipc_num_used) {
+                nchunks = cuda_event_max - cuda_event_ipc_num_used;
+            }
+            /* keep the chunks aligned */
+            chunk = ((amount + nchunks - 1) / nchunks + 255) & ~(size_t) 255;
         }
-        cuda_event_ipc_frag_array[cuda_event_ipc_first_avail] = frag;
 
-        /* Bump up the first available slot and number used by 1 */
-        cuda_event_ipc_first_avail++;
-        if (cuda_event_ipc_first_avail >= cuda_event_max) {
-            cuda_event_ipc_first_avail = 0;
+        for (int c = 0; c < nchunks; c++) {
+            CUstream stream = ipcStreams[ipcStream_next];
+            size_t size = (amount - offset < chunk) ? amount - offset : chunk;
+
+            if (++ipcStream_next >= mca_common_cuda_ipc_streams) {
+                ipcStream_next = 0;
+            }
+
+            result = cuFunc.cuMemcpyAsync((CUdeviceptr) dst + offset, (CUdeviceptr) src + offset,
+                                          size, stream);
+            if (OPAL_UNLIKELY(CUDA_SUCCESS != result)) {
+                opal_show_help("help-mpi-common-cuda.txt", "cuMemcpyAsync failed", true, dst, src,
+                               amount, result);
+                OPAL_THREAD_UNLOCK(&common_cuda_ipc_lock);
+                return OPAL_ERROR;
+            } else {
+                opal_output_verbose(20, mca_common_cuda_output,
+                                    "CUDA: cuMemcpyAsync passed: dst=%p, src=%p, size=%d",
+                                    (char *) dst + offset, (char *) src + offset, (int) size);
+            }
+            result = cuFunc.cuEventRecord(cuda_event_ipc_array[cuda_event_ipc_first_avail], stream);
+            if (OPAL_UNLIKELY(CUDA_SUCCESS != result)) {
+                opal_show_help("help-mpi-common-cuda.txt", "cuEventRecord failed", true,
+                               OPAL_PROC_MY_HOSTNAME, result);
+                OPAL_THREAD_UNLOCK(&common_cuda_ipc_lock);
+                return OPAL_ERROR;
+            }
+            cuda_event_ipc_frag_array[cuda_event_ipc_first_avail] = (c == nchunks - 1) ? frag
+                                                                                       : NULL;
+
+            /* Bump up the first available slot and number used by 1 */
+            cuda_event_ipc_first_avail++;
+            if (cuda_event_ipc_first_avail >= cuda_event_max) {
+                cuda_event_ipc_first_avail = 0;
+            }
+            cuda_event_ipc_num_used++;
+            offset += size;
         }
-        cuda_event_ipc_num_used++;
 
         *done = 0;
     } else {
         /* Mimic the async function so they use the same memcpy call. */
-        result = cuFunc.cuMemcpyAsync((CUdeviceptr) dst, (CUdeviceptr) src, amount, ipcStream);
+        result = cuFunc.cuMemcpyAsync((CUdeviceptr) dst, (CUdeviceptr) src, amount, ipcStreams[0]);
         if (OPAL_UNLIKELY(CUDA_SUCCESS != result)) {
             opal_show_help("help-mpi-common-cuda.txt", "cuMemcpyAsync failed", true, dst, src,
                            amount, result);
@@ -1298,7 +1432,8 @@ int mca_common_cuda_memcpy(void *dst, void *src, size_t amount, char *msg,
         }
 
         /* Record an event, then wait for it to complete with calls to cuEventQuery */
-        result = cuFunc.cuEventRecord(cuda_event_ipc_array[cuda_event_ipc_first_avail], ipcStream);
+        result = cuFunc.cuEventRecord(cuda_event_ipc_array[cuda_event_ipc_first_avail],
+                                      ipcStreams[0]);
         if (OPAL_UNLIKELY(CUDA_SUCCESS != result)) {
             opal_show_help("help-mpi-common-cuda.txt", "cuEventRecord failed", true,
                            OPAL_PROC_MY_HOSTNAME, result);
@@ -1458,6 +1593,32 @@ void *mca_common_cuda_get_htod_stream(void)
     return (void *) htodStream;
 }
 
+/**
+ * Enqueue fn(data) on stream: the driver calls it from one of its threads
+ * once the work enqueued before it completed. fn must not call CUDA.
+ */
+int mca_common_cuda_launch_host_func(void *stream, void (*fn)(void *), void *data)
+{
+#if CUDA_VERSION >= 10000
+    int res;
+
+    if (NULL == cuFunc.cuLaunchHostFunc) {
+        return OPAL_ERR_NOT_SUPPORTED;
+    }
+
+    res = cuFunc.cuLaunchHostFunc((CUstream) stream, (CUhostFn) fn, data);
+    if (OPAL_UNLIKELY(CUDA_SUCCESS != res)) {
+        opal_output_verbose(10, mca_common_cuda_output, "CUDA: cuLaunchHostFunc failed: res=%d",
+                            res);
+        return OPAL_ERROR;
+    }
+
+    return OPAL_SUCCESS;
+#else
+    return OPAL_ERR_NOT_SUPPORTED;
+#endif /* CUDA_VERSION >= 10000 */
+}
+
 /*
  * Function is called every time progress is called with the sm BTL.  If there
  * are outstanding events, check to see if one has completed.  If so, hand
@@ -1471,7 +1632,8 @@ int progress_one_cuda_ipc_event(struct mca_btl_base_descriptor_t **frag)
         return 0;
 
     OPAL_THREAD_LOCK(&common_cuda_ipc_lock);
-    if (cuda_event_ipc_num_used > 0) {
+    /* the events of the first chunks of a split copy carry no frag */
+    while (cuda_event_ipc_num_used > 0) {
         opal_output_verbose(20, mca_common_cuda_output,
                             "CUDA: progress_one_cuda_ipc_event, outstanding_events=%d",
                             cuda_event_ipc_num_used);
@@ -1501,6 +1663,9 @@ int progress_one_cuda_ipc_event(struct mca_btl_base_descriptor_t **frag)
         if (cuda_event_ipc_first_used >= cuda_event_max) {
             cuda_event_ipc_first_used = 0;
         }
+        if (NULL == *frag) {
+            continue;
+        }
         /* A return value of 1 indicates an event completed and a frag was returned */
         OPAL_THREAD_UNLOCK(&common_cuda_ipc_lock);
         return 1;
@@ -1691,20 +1856,79 @@ static float mydifftime(opal_timer_t ts_start, opal_timer_t ts_end)
 #endif /* OPAL_ENABLE_DEBUG */
 
 /* Routines that get plugged into the opal datatype code */
+/* Find the cached device allocation containing the buffer */
+static bool common_cuda_ptr_cache_find(uintptr_t addr, common_cuda_ptr_cache_entry_t *entry)
+{
+    bool found = false;
+
+    OPAL_THREAD_LOCK(&common_cuda_ptr_cache_lock);
+    for (int i = 0; i < COMMON_CUDA_PTR_CACHE_SIZE; i++) {
+        if (addr - common_cuda_ptr_cache[i].base < common_cuda_ptr_cache[i].size) {
+            *entry = common_cuda_ptr_cache[i];
+            found = true;
+            break;
+        }
+    }
+    OPAL_THREAD_UNLOCK(&common_cuda_ptr_cache_lock);
+
+    return found;
+}
+
+static void common_cuda_ptr_cache_insert(const common_cuda_ptr_cache_entry_t *entry)
+{
+    OPAL_THREAD_LOCK(&common_cuda_ptr_cache_lock);
+    common_cuda_ptr_cache[common_cuda_ptr_cache_next] = *entry;
+    common_cuda_ptr_cache_next = (common_cuda_ptr_cache_next + 1) % COMMON_CUDA_PTR_CACHE_SIZE;
+    OPAL_THREAD_UNLOCK(&common_cuda_ptr_cache_lock);
+}
+
+/* Drop the cached allocations overlapping a released range */
+static void common_cuda_ptr_cache_invalidate(uintptr_t base, size_t size)
+{
+    OPAL_THREAD_LOCK(&common_cuda_ptr_cache_lock);
+    for (int i = 0; i < COMMON_CUDA_PTR_CACHE_SIZE; i++) {
+        common_cuda_ptr_cache_entry_t *entry = &common_cuda_ptr_cache[i];
+        if (0 != entry->size && base < entry->base + entry->size && entry->base < base + size) {
+            entry->size = 0;
+        }
+    }
+    OPAL_THREAD_UNLOCK(&common_cuda_ptr_cache_lock);
+}
+
+static void common_cuda_ptr_cache_mem_cb(void *base, size_t size, void *cbdata, bool from_alloc)
+{
+    common_cuda_ptr_cache_invalidate((uintptr_t) base, size);
+}
+
 static int mca_common_cuda_is_gpu_buffer(const void *pUserBuf, opal_convertor_t *convertor)
 {
+    common_cuda_ptr_cache_entry_t entry;
     int res;
     CUmemorytype memType = 0;
     CUdeviceptr dbuf = (CUdeviceptr) pUserBuf;
     CUcontext ctx = NULL, memCtx = NULL;
-#if OPAL_CUDA_GET_ATTRIBUTES
     uint32_t isManaged = 0;
+#if OPAL_CUDA_GET_ATTRIBUTES
     /* With CUDA 7.0, we can get multiple attributes with a single call */
     CUpointer_attribute attributes[3] = {CU_POINTER_ATTRIBUTE_MEMORY_TYPE,
                                          CU_POINTER_ATTRIBUTE_CONTEXT,
                                          CU_POINTER_ATTRIBUTE_IS_MANAGED};
     void *attrdata[] = {(void *) &memType, (void *) &memCtx, (void *) &isManaged};
+#endif /* OPAL_CUDA_GET_ATTRIBUTES */
 
+    /* A device allocation that was already checked and is still mapped */
+    if (common_cuda_ptr_cache_enabled && common_cuda_ptr_cache_find((uintptr_t) dbuf, &entry)) {
+        if (entry.managed && NULL != convertor) {
+            convertor->flags |= CONVERTOR_CUDA_UNIFIED;
+        }
+        res = cuFunc.cuCtxGetCurrent(&ctx);
+        if (OPAL_UNLIKELY(CUDA_SUCCESS == res && NULL == ctx)) {
+            (void) cuFunc.cuCtxSetCurrent(entry.ctx);
+        }
+        return 1;
+    }
+
+#if OPAL_CUDA_GET_ATTRIBUTES
     res = cuFunc.cuPointerGetAttributes(3, attributes, attrdata, dbuf);
     OPAL_OUTPUT_VERBOSE((101, mca_common_cuda_output,
                          "dbuf=%p, memType=%d, memCtx=%p, isManaged=%d, res=%d", (void *) dbuf,
@@ -1815,6 +2039,22 @@ static int mca_common_cuda_is_gpu_buffer(const void *pUserBuf, opal_convertor_t
         }
     }
 
+    if (common_cuda_ptr_cache_enabled) {
+        CUdeviceptr pbase;
+        size_t psize;
+
+        if (NULL == memCtx) {
+            (void) cuFunc.cuCtxGetCurrent(&memCtx);
+        }
+        if (CUDA_SUCCESS == cuFunc.cuMemGetAddressRange(&pbase, &psize, dbuf)) {
+            entry.base = (uintptr_t) pbase;
+            entry.size = psize;
+            entry.ctx = memCtx;
+            entry.managed = (1 == isManaged);
+            common_cuda_ptr_cache_insert(&entry);
+        }
+    }
+
     return 1;
 }
 
@@ -1882,6 +2122,48 @@ static int mca_common_cuda_cu_memcpy(void *dest, const void *src, size_t size)
     return OPAL_SUCCESS;
 }
 
+/**
+ * Copy height blocks of width bytes, spitch bytes apart in src, to blocks
+ * dpitch bytes apart in dest, with a single copy of the driver. Same
+ * synchronization as the contiguous copies of the convertor.
+ */
+static int mca_common_cuda_cu_memcpy_2d(void *dest, size_t dpitch, const void *src, size_t spitch,
+                                        size_t width, size_t height, opal_convertor_t *convertor)
+{
+    CUDA_MEMCPY2D copy;
+    CUresult result;
+
+    memset(&copy, 0, sizeof(copy));
+    copy.srcMemoryType = CU_MEMORYTYPE_UNIFIED;
+    copy.srcDevice = (CUdeviceptr) src;
+    copy.srcPitch = spitch;
+    copy.dstMemoryType = CU_MEMORYTYPE_UNIFIED;
+    copy.dstDevice = (CUdeviceptr) dest;
+    copy.dstPitch = dpitch;
+    copy.WidthInBytes = width;
+    copy.Height = height;
+
+    if (convertor->flags & CONVERTOR_CUDA_ASYNC) {
+        return cuFunc.cuMemcpy2DAsync(&copy, (CUstream) convertor->stream);
+    }
+    if (!mca_common_cuda_cumemcpy_async) {
+        return cuFunc.cuMemcpy2D(&copy);
+    }
+    result = cuFunc.cuMemcpy2DAsync(&copy, memcpyStream);
+    if (OPAL_UNLIKELY(CUDA_SUCCESS != result)) {
+        /* the pitch or the sizes are not supported, the caller copies the
+         * blocks one by one */
+        return result;
+    }
+    result = cuFunc.cuStreamSynchronize(memcpyStream);
+    if (OPAL_UNLIKELY(CUDA_SUCCESS != result)) {
+        opal_show_help("help-mpi-common-cuda.txt", "cuStreamSynchronize failed", true,
+                       OPAL_PROC_MY_HOSTNAME, result);
+        return OPAL_ERROR;
+    }
+    return OPAL_SUCCESS;
+}
+
 int mca_common_cuda_malloc(void **dptr, size_t size)
 {
     int res, count = 0;
@@ -1899,6 +2181,9 @@ int mca_common_cuda_free(void *dptr)
 {
     int res;
     if (NULL != dptr) {
+        if (common_cuda_ptr_cache_enabled) {
+            common_cuda_ptr_cache_invalidate((uintptr_t) dptr, 1);
+        }
         res = cuFunc.cuMemFree((CUdeviceptr) dptr);
         if (OPAL_UNLIKELY(res != CUDA_SUCCESS)) {
             opal_output(0, "CUDA: cuMemFree failed: res=%d", res);
@@ -2228,6 +2513,27 @@ void *opal_cuda_memcpy(void *dest, const void *src, size_t size, opal_convertor_
     }
 }
 
+/*
+ * Copy height blocks of width bytes, spitch bytes apart in src, to blocks
+ * dpitch bytes apart in dest, in a single copy on the GPU instead of one per
+ * block. Returns an error if the convertor is not on GPU memory or the
+ * driver cannot do this copy; the caller then copies the blocks one by one.
+ */
+int opal_cuda_memcpy_2d(void *dest, size_t dpitch, const void *src, size_t spitch, size_t width,
+                        size_t height, opal_convertor_t *convertor)
+{
+    if (!(convertor->flags & CONVERTOR_CUDA) || NULL == ftable.gpu_cu_memcpy_2d) {
+        return OPAL_ERR_NOT_SUPPORTED;
+    }
+    if (0 != ftable.gpu_cu_memcpy_2d(dest, dpitch, src, spitch, width, height, convertor)) {
+        opal_output_verbose(10, opal_cuda_output,
+                            "CUDA: 2D copy failed: dest=%p, src=%p, width=%d, height=%d", dest,
+                            src, (int) width, (int) height);
+        return OPAL_ERROR;
+    }
+    return OPAL_SUCCESS;
+}
+
 /*
  * This function is needed in cases where we do not have contiguous
  * datatypes.  The current code has macros that cannot handle a convertor
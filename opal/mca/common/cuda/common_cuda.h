@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2006 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2013 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -67,6 +67,7 @@ OPAL_DECLSPEC int mca_common_cuda_record_htod_event(char *msg,
 
 OPAL_DECLSPEC void *mca_common_cuda_get_dtoh_stream(void);
 OPAL_DECLSPEC void *mca_common_cuda_get_htod_stream(void);
+OPAL_DECLSPEC int mca_common_cuda_launch_host_func(void *stream, void (*fn)(void *), void *data);
 
 OPAL_DECLSPEC int progress_one_cuda_ipc_event(struct mca_btl_base_descriptor_t **);
 OPAL_DECLSPEC int progress_one_cuda_dtoh_event(struct mca_btl_base_descriptor_t **);
@@ -119,6 +120,8 @@ struct opal_common_cuda_function_table {
     int (*gpu_is_gpu_buffer)(const void *, opal_convertor_t *);
     int (*gpu_cu_memcpy_async)(void *, const void *, size_t, opal_convertor_t *);
     int (*gpu_cu_memcpy)(void *, const void *, size_t);
+    int (*gpu_cu_memcpy_2d)(void *, size_t, const void *, size_t, size_t, size_t,
+                            opal_convertor_t *);
     int (*gpu_memmove)(void *, void *, size_t);
     int (*gpu_malloc)(void *, size_t);
     int (*gpu_free)(void *);
@@ -131,6 +134,8 @@ bool opal_cuda_check_one_buf(char *buf, opal_convertor_t *convertor);
 void *opal_cuda_malloc(size_t size, opal_convertor_t *convertor);
 void opal_cuda_free(void *buffer, opal_convertor_t *convertor);
 void *opal_cuda_memcpy(void *dest, const void *src, size_t size, opal_convertor_t *convertor);
+int opal_cuda_memcpy_2d(void *dest, size_t dpitch, const void *src, size_t spitch, size_t width,
+                        size_t height, opal_convertor_t *convertor);
 void *opal_cuda_memcpy_sync(void *dest, const void *src, size_t size);
 void *opal_cuda_memmove(void *dest, void *src, size_t size);
 void opal_cuda_add_initialization_function(int (*fptr)(opal_common_cuda_function_table_t *));
@@ -6,6 +6,9 @@
  *                         reserved.
  * Copyright (c) 2020      Cisco Systems, Inc.  All rights reserved
  * Copyright (c) 2021      Nanook Consulting.  All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -14,6 +17,7 @@
  */
 
 #include <errno.h>
+#include <limits.h>
 #include <unistd.h>
 
 #include "opal_config.h"
@@ -207,63 +211,68 @@ static int check_provider_attr(struct fi_info *provider_info, struct fi_info *pr
     }
 }
 
+/* distance of a NIC whose locality is unknown */
+#define COMMON_OFI_DISTANCE_UNKNOWN UINT_MAX
+
 #if OPAL_OFI_PCI_DATA_AVAILABLE
-/* Check if a process and a pci device share the same cpuset
- *     @param (IN) pci              struct fi_pci_attr pci device attributes,
- *                                  used to find hwloc object for device.
- *
+/* Compute the distance between a process and a pci device
  *     @param (IN) topology         hwloc_topology_t topology to get the cpusets
  *                                  from
  *
- *     @param (OUT)                 returns true if cpusets match and false if
- *                                  cpusets do not match or an error prevents comparison
+ *     @param (IN) proc_cpuset      hwloc_cpuset_t cpuset the process is bound to
+ *
+ *     @param (IN) pci              struct fi_pci_attr pci device attributes,
+ *                                  used to find hwloc object for device.
  *
- *     Uses a pci device to find an ancestor that contains a cpuset, and
- *     determines if it intersects with the cpuset that the process is bound to.
- *     if the process is not bound, or if a cpuset is unavailable for whatever
- *     reason, returns false. Otherwise, returns the result of
- *     hwloc_cpuset_intersects()
+ *     @param (OUT)                 returns the distance, 0 if the cpusets
+ *                                  intersect, COMMON_OFI_DISTANCE_UNKNOWN if an
+ *                                  error prevents comparison
+ *
+ *     Uses a pci device to find an ancestor that contains a cpuset. If it
+ *     intersects with the cpuset that the process is bound to, the device is
+ *     local. Otherwise the distance is the number of hops in the hwloc tree
+ *     between the smallest object covering the process cpuset and the device
+ *     ancestor, so that a NIC on the same package comes before a NIC on
+ *     another package.
  */
-static bool compare_cpusets(hwloc_topology_t topology, struct fi_pci_attr pci)
+static unsigned int get_nic_distance(hwloc_topology_t topology, hwloc_cpuset_t proc_cpuset,
+                                     struct fi_pci_attr pci)
 {
-    bool result = false;
-    int ret;
-    hwloc_bitmap_t proc_cpuset;
-    hwloc_obj_t obj = NULL;
+    hwloc_obj_t obj, proc_obj, common;
 
     /* Cannot find topology info if no topology is found */
-    if (NULL == topology) {
-        return false;
-    }
-
-    /* Allocate memory for proc_cpuset */
-    proc_cpuset = hwloc_bitmap_alloc();
-    if (NULL == proc_cpuset) {
-        return false;
-    }
-
-    /* Fill cpuset with the collection of cpu cores that the process runs on */
-    ret = hwloc_get_cpubind(topology, proc_cpuset, HWLOC_CPUBIND_PROCESS);
-    if (0 > ret) {
-        goto error;
+    if (NULL == topology || NULL == proc_cpuset) {
+        return COMMON_OFI_DISTANCE_UNKNOWN;
     }
 
     /* Get the pci device from bdf */
     obj = hwloc_get_pcidev_by_busid(topology, pci.domain_id, pci.bus_id, pci.device_id,
                                     pci.function_id);
     if (NULL == obj) {
-        goto error;
+        return COMMON_OFI_DISTANCE_UNKNOWN;
     }
 
     /* pcidev objects don't have cpusets so find the first non-io object above */
     obj = hwloc_get_non_io_ancestor_obj(topology, obj);
-    if (NULL != obj) {
-        result = hwloc_bitmap_intersects(proc_cpuset, obj->cpuset);
+    if (NULL == obj) {
+        return COMMON_OFI_DISTANCE_UNKNOWN;
+    }
+
+    if (hwloc_bitmap_intersects(proc_cpuset, obj->cpuset)) {
+        return 0;
+    }
+
+    proc_obj = hwloc_get_obj_covering_cpuset(topology, proc_cpuset);
+    if (NULL == proc_obj) {
+        return COMMON_OFI_DISTANCE_UNKNOWN;
+    }
+
+    common = hwloc_get_common_ancestor_obj(topology, proc_obj, obj);
+    if (NULL == common) {
+        return COMMON_OFI_DISTANCE_UNKNOWN;
     }
 
-error:
-    hwloc_bitmap_free(proc_cpuset);
-    return result;
+    return (unsigned int) (proc_obj->depth - common->depth) + (unsigned int) (obj->depth - common->depth);
 }
 #endif
 
@@ -385,8 +394,11 @@ static uint32_t get_package_rank(opal_process_info_t *process_info)
  *
  *          ii. There is no provider that is local to the process:
  *
- *              (local rank % number of providers of the same type)
- *              is used to select one of these providers
+ *              (local rank % number of providers of the same type that are
+ *              the closest to the process cpuset in the hwloc tree)
+ *              is used to select one of these providers, so that the
+ *              processes of a package share the NICs nearest to it instead
+ *              of spreading over all the NICs of the node.
  *
  *      3. If there is more than 1 providers of the same type in the list, and the BDF data
  *      is not available (the ofi version does not support fi_info.nic or the
@@ -425,10 +437,11 @@ struct fi_info *opal_mca_common_ofi_select_provider(struct fi_info *provider_lis
 #if OPAL_OFI_PCI_DATA_AVAILABLE
     struct fi_pci_attr pci;
 #endif
+    hwloc_cpuset_t proc_cpuset = NULL;
     int ret;
-    uint32_t package_rank;
+    uint32_t package_rank = 0;
     unsigned int num_provider = 0, provider_limit = 0;
-    bool provider_found = false, cpusets_match = false;
+    unsigned int distance, min_distance = COMMON_OFI_DISTANCE_UNKNOWN;
 
     /* Initialize opal_hwloc_topology if it is not already */
     ret = opal_hwloc_base_get_topology();
@@ -436,6 +449,12 @@ struct fi_info *opal_mca_common_ofi_select_provider(struct fi_info *provider_lis
         /* Provider selection can continue but there is no guarantee of locality */
         opal_output_verbose(1, opal_common_ofi.output, "%s:%d:Failed to initialize topology\n",
                             __FILE__, __LINE__);
+    } else if (NULL != (proc_cpuset = hwloc_bitmap_alloc())) {
+        /* Fill cpuset with the collection of cpu cores that the process runs on */
+        if (0 > hwloc_get_cpubind(opal_hwloc_topology, proc_cpuset, HWLOC_CPUBIND_PROCESS)) {
+            hwloc_bitmap_free(proc_cpuset);
+            proc_cpuset = NULL;
+        }
     }
 
     provider_limit = count_providers(provider_list);
@@ -446,6 +465,9 @@ struct fi_info *opal_mca_common_ofi_select_provider(struct fi_info *provider_lis
         opal_output_verbose(1, opal_common_ofi.output,
                             "%s:%d:Failed to allocate memory for provider table\n", __FILE__,
                             __LINE__);
+        if (NULL != proc_cpuset) {
+            hwloc_bitmap_free(proc_cpuset);
+        }
         return provider_list;
     }
 
@@ -454,26 +476,26 @@ struct fi_info *opal_mca_common_ofi_select_provider(struct fi_info *provider_lis
     /* Cycle through remaining fi_info objects, looking for alike providers */
     while (NULL != current_provider) {
         if (!check_provider_attr(provider, current_provider)) {
-            cpusets_match = false;
+            distance = COMMON_OFI_DISTANCE_UNKNOWN;
 #if OPAL_OFI_PCI_DATA_AVAILABLE
             if (NULL != current_provider->nic) {
                 pci = current_provider->nic->bus_attr->attr.pci;
-                cpusets_match = compare_cpusets(opal_hwloc_topology, pci);
+                distance = get_nic_distance(opal_hwloc_topology, proc_cpuset, pci);
             }
 #endif
 
-            /* Reset the list if the cpusets match and no other provider was
-             * found on the same cpuset as the process.
+            /* Reset the list if the provider is closer than all the
+             * providers found so far.
              */
-            if (cpusets_match && !provider_found) {
-                provider_found = true;
+            if (distance < min_distance) {
+                min_distance = distance;
                 num_provider = 0;
             }
 
-            /* Add the provider to the provider list if the cpusets match or if
-             * no other provider was found on the same cpuset as the process.
+            /* Add the provider to the provider list if it is as close as the
+             * closest providers.
              */
-            if (cpusets_match || !provider_found) {
+            if (distance == min_distance) {
                 provider_table[num_provider] = current_provider;
                 num_provider++;
             }
@@ -490,19 +512,16 @@ struct fi_info *opal_mca_common_ofi_select_provider(struct fi_info *provider_lis
         provider = provider_table[num_provider - 1];
     }
 
-#if OPAL_OFI_PCI_DATA_AVAILABLE
-    if (NULL != provider->nic) {
-        pci = provider->nic->bus_attr->attr.pci;
-        cpusets_match = compare_cpusets(opal_hwloc_topology, pci);
-    }
-#endif
-
 #if OPAL_ENABLE_DEBUG
     opal_output_verbose(1, opal_common_ofi.output,
-                        "package rank: %d device: %s cpusets match: %s\n", package_rank,
-                        provider->domain_attr->name, cpusets_match ? "true" : "false");
+                        "package rank: %d device: %s distance: %d\n", package_rank,
+                        provider->domain_attr->name,
+                        (COMMON_OFI_DISTANCE_UNKNOWN == min_distance) ? -1 : (int) min_distance);
 #endif
 
+    if (NULL != proc_cpuset) {
+        hwloc_bitmap_free(proc_cpuset);
+    }
     free(provider_table);
     return provider;
 }
@@ -24,6 +24,8 @@
 
 #include <fnmatch.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <ucm/api/ucm.h>
 
 /***********************************************************************/
@@ -500,3 +502,126 @@ OPAL_DECLSPEC int opal_common_ucx_del_procs(opal_common_ucx_del_proc_t *procs, s
 
     return opal_common_ucx_mca_pmix_fence(worker);
 }
+
+typedef struct {
+    void *base;
+    size_t length;
+    ucp_mem_h memh;
+} opal_common_ucx_shared_mem_t;
+
+static struct {
+    ucp_context_h context;
+    int mt_workers_shared;
+    int refcnt;
+    opal_common_ucx_shared_mem_t *mems;
+    int num_mems;
+} opal_common_ucx_shared = {0};
+
+OPAL_DECLSPEC void opal_common_ucx_shared_ctx_publish(ucp_context_h context, int mt_workers_shared)
+{
+    OPAL_THREAD_LOCK(&opal_common_ucx_mutex);
+    if (NULL == opal_common_ucx_shared.context) {
+        opal_common_ucx_shared.context = context;
+        opal_common_ucx_shared.mt_workers_shared = mt_workers_shared;
+        opal_common_ucx_shared.refcnt = 1;
+    }
+    OPAL_THREAD_UNLOCK(&opal_common_ucx_mutex);
+}
+
+OPAL_DECLSPEC ucp_context_h opal_common_ucx_shared_ctx_retain(int mt_workers_shared)
+{
+    ucp_context_h context = NULL;
+
+    OPAL_THREAD_LOCK(&opal_common_ucx_mutex);
+    if ((NULL != opal_common_ucx_shared.context)
+        && (opal_common_ucx_shared.mt_workers_shared || !mt_workers_shared)) {
+        context = opal_common_ucx_shared.context;
+        opal_common_ucx_shared.refcnt++;
+    }
+    OPAL_THREAD_UNLOCK(&opal_common_ucx_mutex);
+
+    return context;
+}
+
+OPAL_DECLSPEC void opal_common_ucx_shared_ctx_release(ucp_context_h context)
+{
+    OPAL_THREAD_LOCK(&opal_common_ucx_mutex);
+    if (context == opal_common_ucx_shared.context) {
+        if (0 < --opal_common_ucx_shared.refcnt) {
+            OPAL_THREAD_UNLOCK(&opal_common_ucx_mutex);
+            return;
+        }
+        free(opal_common_ucx_shared.mems);
+        memset(&opal_common_ucx_shared, 0, sizeof(opal_common_ucx_shared));
+    }
+    OPAL_THREAD_UNLOCK(&opal_common_ucx_mutex);
+
+    ucp_cleanup(context);
+}
+
+OPAL_DECLSPEC int opal_common_ucx_shared_mem_add(ucp_context_h context, void *base, size_t length,
+                                                 ucp_mem_h memh)
+{
+    opal_common_ucx_shared_mem_t *mems;
+    int rc = OPAL_SUCCESS;
+
+    OPAL_THREAD_LOCK(&opal_common_ucx_mutex);
+    if (context != opal_common_ucx_shared.context) {
+        rc = OPAL_ERR_NOT_FOUND;
+        goto out;
+    }
+
+    mems = realloc(opal_common_ucx_shared.mems,
+                   (opal_common_ucx_shared.num_mems + 1) * sizeof(*mems));
+    if (NULL == mems) {
+        rc = OPAL_ERR_OUT_OF_RESOURCE;
+        goto out;
+    }
+    mems[opal_common_ucx_shared.num_mems].base = base;
+    mems[opal_common_ucx_shared.num_mems].length = length;
+    mems[opal_common_ucx_shared.num_mems].memh = memh;
+    opal_common_ucx_shared.mems = mems;
+    opal_common_ucx_shared.num_mems++;
+
+out:
+    OPAL_THREAD_UNLOCK(&opal_common_ucx_mutex);
+    return rc;
+}
+
+OPAL_DECLSPEC void opal_common_ucx_shared_mem_del(ucp_mem_h memh)
+{
+    int i;
+
+    OPAL_THREAD_LOCK(&opal_common_ucx_mutex);
+    for (i = 0; i < opal_common_ucx_shared.num_mems; i++) {
+        if (opal_common_ucx_shared.mems[i].memh == memh) {
+            opal_common_ucx_shared.mems[i] =
+                opal_common_ucx_shared.mems[--opal_common_ucx_shared.num_mems];
+            break;
+        }
+    }
+    OPAL_THREAD_UNLOCK(&opal_common_ucx_mutex);
+}
+
+OPAL_DECLSPEC ucp_mem_h opal_common_ucx_shared_mem_find(ucp_context_h context, const void *base,
+                                                        size_t length)
+{
+    opal_common_ucx_shared_mem_t *mem;
+    ucp_mem_h memh = NULL;
+    int i;
+
+    OPAL_THREAD_LOCK(&opal_common_ucx_mutex);
+    if (context == opal_common_ucx_shared.context) {
+        for (i = 0; i < opal_common_ucx_shared.num_mems; i++) {
+            mem = &opal_common_ucx_shared.mems[i];
+            if (((uintptr_t) base >= (uintptr_t) mem->base)
+                && ((uintptr_t) base + length <= (uintptr_t) mem->base + mem->length)) {
+                memh = mem->memh;
+                break;
+            }
+        }
+    }
+    OPAL_THREAD_UNLOCK(&opal_common_ucx_mutex);
+
+    return memh;
+}
@@ -128,6 +128,28 @@ OPAL_DECLSPEC int opal_common_ucx_del_procs_nofence(opal_common_ucx_del_proc_t *
                                                     ucp_worker_h worker);
 OPAL_DECLSPEC void opal_common_ucx_mca_var_register(const mca_base_component_t *component);
 
+/*
+ * A UCP context published by a component for the others to create their
+ * workers on, e.g. the context of OSHMEM for the MPI windows. The memory a
+ * component registers on a shared context can be added to it, the other
+ * components then use the memory handle and its rkeys instead of registering
+ * the region a second time. The context is released by every component that
+ * retained it and ucp_cleanup() is done by the last one.
+ */
+OPAL_DECLSPEC void opal_common_ucx_shared_ctx_publish(ucp_context_h context,
+                                                      int mt_workers_shared);
+/* NULL if there is no context published or it was created without the
+ * shared workers asked for */
+OPAL_DECLSPEC ucp_context_h opal_common_ucx_shared_ctx_retain(int mt_workers_shared);
+/* ucp_cleanup() for a context that was never published */
+OPAL_DECLSPEC void opal_common_ucx_shared_ctx_release(ucp_context_h context);
+OPAL_DECLSPEC int opal_common_ucx_shared_mem_add(ucp_context_h context, void *base, size_t length,
+                                                 ucp_mem_h memh);
+OPAL_DECLSPEC void opal_common_ucx_shared_mem_del(ucp_mem_h memh);
+/* The memory handle of the shared context covering the region, or NULL */
+OPAL_DECLSPEC ucp_mem_h opal_common_ucx_shared_mem_find(ucp_context_h context, const void *base,
+                                                        size_t length);
+
 /**
  * Load an integer value of \c size bytes from \c ptr and cast it to uint64_t.
  */
@@ -69,6 +69,8 @@ static opal_common_ucx_winfo_t *_winfo_create(opal_common_ucx_wpool_t *wpool)
     winfo->inflight_ops = NULL;
     winfo->global_inflight_ops = 0;
     winfo->inflight_req = UCS_OK;
+    winfo->ep_dirty = NULL;
+    winfo->dirty = false;
 
     return winfo;
 
@@ -97,6 +99,7 @@ static void _winfo_destructor(opal_common_ucx_winfo_t *winfo)
         }
         free(winfo->endpoints);
         free(winfo->inflight_ops);
+        free(winfo->ep_dirty);
     }
     winfo->endpoints = NULL;
     winfo->comm_size = 0;
@@ -143,6 +146,14 @@ OPAL_DECLSPEC int opal_common_ucx_wpool_init(opal_common_ucx_wpool_t *wpool, int
 
     OBJ_CONSTRUCT(&wpool->mutex, opal_mutex_t);
 
+    /* The workers are created on the context of another component if one
+     * was published, so that the memory it registered can be reused */
+    wpool->ucp_ctx = opal_common_ucx_shared_ctx_retain(enable_mt);
+    if (NULL != wpool->ucp_ctx) {
+        MCA_COMMON_UCX_VERBOSE(1, "using the shared UCP context");
+        goto ucp_ctx_ready;
+    }
+
     status = ucp_config_read("MPI", NULL, &config);
     if (UCS_OK != status) {
         MCA_COMMON_UCX_VERBOSE(1, "ucp_config_read failed: %d", status);
@@ -173,6 +184,7 @@ OPAL_DECLSPEC int opal_common_ucx_wpool_init(opal_common_ucx_wpool_t *wpool, int
         goto err_ucp_init;
     }
 
+ucp_ctx_ready:
     /* create recv worker and add to idle pool */
     OBJ_CONSTRUCT(&wpool->idle_workers, opal_list_t);
     OBJ_CONSTRUCT(&wpool->active_workers, opal_list_t);
@@ -210,7 +222,7 @@ err_get_addr:
 err_worker_create:
     OBJ_DESTRUCT(&wpool->idle_workers);
     OBJ_DESTRUCT(&wpool->active_workers);
-    ucp_cleanup(wpool->ucp_ctx);
+    opal_common_ucx_shared_ctx_release(wpool->ucp_ctx);
 err_ucp_init:
     return rc;
 }
@@ -252,7 +264,7 @@ void opal_common_ucx_wpool_finalize(opal_common_ucx_wpool_t *wpool)
     wpool->dflt_winfo = NULL;
 
     OBJ_DESTRUCT(&wpool->mutex);
-    ucp_cleanup(wpool->ucp_ctx);
+    opal_common_ucx_shared_ctx_release(wpool->ucp_ctx);
     return;
 }
 
@@ -328,6 +340,8 @@ static opal_common_ucx_winfo_t *_wpool_get_winfo(opal_common_ucx_wpool_t *wpool,
 
     winfo->endpoints = calloc(comm_size, sizeof(ucp_ep_h));
     winfo->inflight_ops = calloc(comm_size, sizeof(short));
+    winfo->ep_dirty = calloc(comm_size, sizeof(bool));
+    winfo->dirty = false;
     winfo->comm_size = comm_size;
 
     /* Put the worker on the active list */
@@ -434,10 +448,16 @@ int opal_common_ucx_wpmem_create(opal_common_ucx_ctx_t *ctx, void **mem_base, si
 
     OBJ_CONSTRUCT(&mem->mutex, opal_mutex_t);
 
-    ret = _comm_ucx_wpmem_map(ctx->wpool, mem_base, mem_size, &mem->memh, mem_type);
-    if (ret != OPAL_SUCCESS) {
-        MCA_COMMON_UCX_VERBOSE(1, "_comm_ucx_mem_map failed: %d", ret);
-        goto error_mem_map;
+    if (OPAL_COMMON_UCX_MEM_MAP == mem_type) {
+        mem->memh = opal_common_ucx_shared_mem_find(ctx->wpool->ucp_ctx, *mem_base, mem_size);
+        mem->memh_shared = (NULL != mem->memh);
+    }
+    if (!mem->memh_shared) {
+        ret = _comm_ucx_wpmem_map(ctx->wpool, mem_base, mem_size, &mem->memh, mem_type);
+        if (ret != OPAL_SUCCESS) {
+            MCA_COMMON_UCX_VERBOSE(1, "_comm_ucx_mem_map failed: %d", ret);
+            goto error_mem_map;
+        }
     }
 
     status = ucp_rkey_pack(ctx->wpool->ucp_ctx, mem->memh, &rkey_addr, &rkey_addr_len);
@@ -463,7 +483,9 @@ int opal_common_ucx_wpmem_create(opal_common_ucx_ctx_t *ctx, void **mem_base, si
     return ret;
 
 error_rkey_pack:
-    ucp_mem_unmap(ctx->wpool->ucp_ctx, mem->memh);
+    if (!mem->memh_shared) {
+        ucp_mem_unmap(ctx->wpool->ucp_ctx, mem->memh);
+    }
 error_mem_map:
     free(mem);
     (*mem_ptr) = NULL;
@@ -530,7 +552,9 @@ void opal_common_ucx_wpmem_free(opal_common_ucx_wpmem_t *mem)
     free(mem->mem_addrs);
     free(mem->mem_displs);
 
-    ucp_mem_unmap(mem->ctx->wpool->ucp_ctx, mem->memh);
+    if (!mem->memh_shared) {
+        ucp_mem_unmap(mem->ctx->wpool->ucp_ctx, mem->memh);
+    }
     free(mem);
 }
 
@@ -820,15 +844,27 @@ OPAL_DECLSPEC int opal_common_ucx_wpmem_flush(opal_common_ucx_wpmem_t *mem,
             continue;
         }
         opal_mutex_lock(&winfo->mutex);
+        if ((scope == OPAL_COMMON_UCX_SCOPE_EP) ? !winfo->ep_dirty[target] : !winfo->dirty) {
+            /* nothing was issued through this worker since it was last flushed */
+            opal_mutex_unlock(&winfo->mutex);
+            continue;
+        }
         rc = opal_common_ucx_winfo_flush(winfo, target, OPAL_COMMON_UCX_FLUSH_B, scope, NULL);
         switch (scope) {
         case OPAL_COMMON_UCX_SCOPE_WORKER:
             winfo->global_inflight_ops = 0;
             memset(winfo->inflight_ops, 0, winfo->comm_size * sizeof(short));
+            if (OPAL_SUCCESS == rc) {
+                memset(winfo->ep_dirty, 0, winfo->comm_size * sizeof(bool));
+                winfo->dirty = false;
+            }
             break;
         case OPAL_COMMON_UCX_SCOPE_EP:
             winfo->global_inflight_ops -= winfo->inflight_ops[target];
             winfo->inflight_ops[target] = 0;
+            if (OPAL_SUCCESS == rc) {
+                winfo->ep_dirty[target] = false;
+            }
             break;
         }
         opal_mutex_unlock(&winfo->mutex);
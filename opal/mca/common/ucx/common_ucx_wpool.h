@@ -98,6 +98,8 @@ typedef struct {
 
     /* UCX memory handler */
     ucp_mem_h memh;
+    /* memh belongs to the component that published the UCP context */
+    bool memh_shared;
     char *mem_addrs;
     int *mem_displs;
 
@@ -122,6 +124,11 @@ struct opal_common_ucx_winfo {
     short *inflight_ops;
     short global_inflight_ops;
     ucs_status_ptr_t inflight_req;
+    /* targets with operations that no blocking flush completed yet. unlike
+     * inflight_ops these are not cleared by the periodical non-blocking flushes,
+     * so that a flush can skip the targets that have nothing outstanding */
+    bool *ep_dirty;
+    bool dirty;
 };
 OBJ_CLASS_DECLARATION(opal_common_ucx_winfo_t);
 
@@ -300,6 +307,8 @@ static inline int _periodical_flush_nb(opal_common_ucx_wpmem_t *mem, opal_common
 
     winfo->inflight_ops[target]++;
     winfo->global_inflight_ops++;
+    winfo->ep_dirty[target] = true;
+    winfo->dirty = true;
 
     if (OPAL_UNLIKELY(winfo->inflight_ops[target] >= MCA_COMMON_UCX_PER_TARGET_OPS_THRESHOLD)
         || OPAL_UNLIKELY(winfo->global_inflight_ops >= MCA_COMMON_UCX_GLOBAL_OPS_THRESHOLD)) {
@@ -581,6 +590,66 @@ static inline int opal_common_ucx_wpmem_fetch_nb(opal_common_ucx_wpmem_t *mem,
     return rc;
 }
 
+/* put or get with its own completion: user_req_cb is called once the operation
+ * completed locally (the buffer of a put can be reused, the data of a get has
+ * arrived). remote completion of a put still requires a flush */
+static inline int opal_common_ucx_wpmem_putget_nb(opal_common_ucx_wpmem_t *mem,
+                                                  opal_common_ucx_op_t op, int target, void *buffer,
+                                                  size_t len, uint64_t rem_addr,
+                                                  opal_common_ucx_user_req_handler_t user_req_cb,
+                                                  void *user_req_ptr)
+{
+    ucp_ep_h ep = NULL;
+    ucp_rkey_h rkey = NULL;
+    opal_common_ucx_winfo_t *winfo = NULL;
+    opal_common_ucx_request_t *req = NULL;
+    int rc = OPAL_SUCCESS;
+    char *called_func = "";
+
+    rc = opal_common_ucx_tlocal_fetch(mem, target, &ep, &rkey, &winfo);
+    if (OPAL_UNLIKELY(OPAL_SUCCESS != rc)) {
+        MCA_COMMON_UCX_ERROR("tlocal_fetch failed: %d", rc);
+        return rc;
+    }
+
+    /* Perform the operation */
+    opal_mutex_lock(&winfo->mutex);
+    switch (op) {
+    case OPAL_COMMON_UCX_PUT:
+        req = ucp_put_nb(ep, buffer, len, rem_addr, rkey, opal_common_ucx_req_completion);
+        called_func = "ucp_put_nb";
+        break;
+    case OPAL_COMMON_UCX_GET:
+        req = ucp_get_nb(ep, buffer, len, rem_addr, rkey, opal_common_ucx_req_completion);
+        called_func = "ucp_get_nb";
+        break;
+    }
+
+    if (OPAL_UNLIKELY(UCS_PTR_IS_ERR(req))) {
+        MCA_COMMON_UCX_ERROR("%s failed: %d", called_func, UCS_PTR_STATUS(req));
+        rc = OPAL_ERROR;
+        goto out;
+    }
+
+    if (UCS_PTR_IS_PTR(req)) {
+        req->ext_req = user_req_ptr;
+        req->ext_cb = user_req_cb;
+        req->winfo = winfo;
+    } else if (user_req_cb != NULL) {
+        (*user_req_cb)(user_req_ptr);
+    }
+
+    rc = _periodical_flush_nb(mem, winfo, target);
+    if (OPAL_UNLIKELY(OPAL_SUCCESS != rc)) {
+        MCA_COMMON_UCX_VERBOSE(1, "_incr_and_check_inflight_ops failed: %d", rc);
+    }
+
+out:
+    opal_mutex_unlock(&winfo->mutex);
+
+    return rc;
+}
+
 END_C_DECLS
 
 #endif // COMMON_UCX_WPOOL_H
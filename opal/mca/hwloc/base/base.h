@@ -17,6 +17,7 @@
 #include "opal_config.h"
 
 #include "opal/mca/hwloc/hwloc-internal.h"
+#include "opal/util/proc.h"
 
 #if HWLOC_API_VERSION < 0x20000
 #    define HWLOC_OBJ_L3CACHE HWLOC_OBJ_CACHE
@@ -240,6 +241,52 @@ OPAL_DECLSPEC opal_hwloc_locality_t opal_hwloc_compute_relative_locality(char *l
 
 OPAL_DECLSPEC int opal_hwloc_base_topology_set_flags(hwloc_topology_t topology, unsigned long flags,
                                                      bool io);
+
+/**
+ * Locality of a process on this node. The objects are logical indexes,
+ * -1 when the process is not bound to exactly one object of the type
+ * (or the device cannot be found).
+ */
+typedef struct {
+    opal_process_name_t name;
+    int local_rank;
+    int package;
+    int numa;
+    int l3;
+    int core;
+    int nic; /**< nearest network OS device */
+    int gpu; /**< nearest GPU or coprocessor OS device */
+} opal_hwloc_base_local_proc_t;
+
+/* distance between two local processes, the smaller the closer */
+enum {
+    OPAL_HWLOC_BASE_DISTANCE_SELF = 0,
+    OPAL_HWLOC_BASE_DISTANCE_CORE,
+    OPAL_HWLOC_BASE_DISTANCE_L3CACHE,
+    OPAL_HWLOC_BASE_DISTANCE_NUMA,
+    OPAL_HWLOC_BASE_DISTANCE_PACKAGE,
+    OPAL_HWLOC_BASE_DISTANCE_NODE
+};
+
+/**
+ * Build the locality table of the local processes. It is built once
+ * (the first call of any of the functions below does it) and released
+ * when the hwloc framework is closed.
+ */
+OPAL_DECLSPEC int opal_hwloc_base_locality_init(void);
+OPAL_DECLSPEC void opal_hwloc_base_locality_finalize(void);
+
+/* number of local processes, 0 if the table is not available */
+OPAL_DECLSPEC int opal_hwloc_base_locality_num_local(void);
+
+/* locality of a local process by local rank, or by name. NULL if unknown */
+OPAL_DECLSPEC const opal_hwloc_base_local_proc_t *opal_hwloc_base_locality_get(int local_rank);
+OPAL_DECLSPEC const opal_hwloc_base_local_proc_t *
+opal_hwloc_base_locality_lookup(const opal_process_name_t *name);
+
+/* distance between two local processes (OPAL_HWLOC_BASE_DISTANCE_*) */
+OPAL_DECLSPEC int opal_hwloc_base_locality_distance(int local_rank1, int local_rank2);
+
 END_C_DECLS
 
 #endif /* OPAL_HWLOC_BASE_H */
@@ -268,6 +268,8 @@ static int opal_hwloc_base_close(void)
         return ret;
     }
 
+    opal_hwloc_base_locality_finalize();
+
     /* free memory */
     if (NULL != opal_hwloc_my_cpuset) {
         hwloc_bitmap_free(opal_hwloc_my_cpuset);
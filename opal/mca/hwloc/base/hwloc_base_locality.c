@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Locality of the processes sharing the node: the package, NUMA node,
+ * L3 cache and core each local process is bound to, the network and
+ * GPU devices closest to it, and the distance between any two of them.
+ *
+ * The table is built once, the first time a component asks for it,
+ * from the locality strings PMIx stores for the node so that the
+ * components no longer parse them (and query the modex) on their own.
+ */
+
+#include "opal_config.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "opal/constants.h"
+#include "opal/mca/hwloc/base/base.h"
+#include "opal/mca/pmix/pmix-internal.h"
+#include "opal/mca/threads/mutex.h"
+#include "opal/util/argv.h"
+#include "opal/util/proc.h"
+
+#if HWLOC_API_VERSION < 0x20000
+#    define OPAL_HWLOC_LOCALITY_L3 HWLOC_OBJ_CACHE, 3
+#else
+#    define OPAL_HWLOC_LOCALITY_L3 HWLOC_OBJ_L3CACHE, 0
+#endif
+
+static opal_mutex_t opal_hwloc_base_locality_lock = OPAL_MUTEX_STATIC_INIT;
+static volatile bool opal_hwloc_base_locality_ready = false;
+static int opal_hwloc_base_locality_rc = OPAL_SUCCESS;
+static int opal_hwloc_base_locality_count = 0;
+static opal_hwloc_base_local_proc_t *opal_hwloc_base_locality_procs = NULL;
+static uint8_t *opal_hwloc_base_locality_distances = NULL;
+
+/* the only object of a type in a locality string, -1 if there are none or several */
+static int locality_index(char *loc, hwloc_obj_type_t type, unsigned level)
+{
+    char *list = opal_hwloc_base_get_location(loc, type, level);
+    hwloc_bitmap_t set;
+    int index = -1;
+
+    if (NULL == list) {
+        return -1;
+    }
+
+    set = hwloc_bitmap_alloc();
+    if (NULL != set && 0 == hwloc_bitmap_list_sscanf(set, list) && 1 == hwloc_bitmap_weight(set)) {
+        index = hwloc_bitmap_first(set);
+    }
+
+    if (NULL != set) {
+        hwloc_bitmap_free(set);
+    }
+    free(list);
+
+    return index;
+}
+
+/* index, among the OS devices of the same kind, of the first one attached
+ * below the NUMA node of the process (else below its package) */
+static int locality_nearest_osdev(const opal_hwloc_base_local_proc_t *proc, bool gpu)
+{
+    hwloc_cpuset_t numa = NULL, package = NULL;
+    hwloc_obj_t osdev = NULL, obj;
+    int index = 0, near_package = -1;
+
+    if (NULL == opal_hwloc_topology) {
+        return -1;
+    }
+
+    if (0 <= proc->numa
+        && NULL != (obj = hwloc_get_obj_by_type(opal_hwloc_topology, HWLOC_OBJ_NODE, proc->numa))) {
+        numa = obj->cpuset;
+    }
+    if (0 <= proc->package
+        && NULL
+               != (obj = hwloc_get_obj_by_type(opal_hwloc_topology, HWLOC_OBJ_SOCKET, proc->package))) {
+        package = obj->cpuset;
+    }
+    if (NULL == numa && NULL == package) {
+        return -1;
+    }
+
+    while (NULL != (osdev = hwloc_get_next_osdev(opal_hwloc_topology, osdev))) {
+        hwloc_obj_osdev_type_t type = osdev->attr->osdev.type;
+
+        if (gpu ? (HWLOC_OBJ_OSDEV_GPU != type && HWLOC_OBJ_OSDEV_COPROC != type)
+                : (HWLOC_OBJ_OSDEV_OPENFABRICS != type && HWLOC_OBJ_OSDEV_NETWORK != type)) {
+            continue;
+        }
+
+        obj = hwloc_get_non_io_ancestor_obj(opal_hwloc_topology, osdev);
+        if (NULL != obj && NULL != obj->cpuset) {
+            if (NULL != numa && hwloc_bitmap_isincluded(obj->cpuset, numa)) {
+                return index;
+            }
+            if (-1 == near_package && NULL != package
+                && hwloc_bitmap_isincluded(obj->cpuset, package)) {
+                near_package = index;
+            }
+        }
+        ++index;
+    }
+
+    return near_package;
+}
+
+static uint8_t locality_distance(const opal_hwloc_base_local_proc_t *a,
+                                 const opal_hwloc_base_local_proc_t *b)
+{
+    if (a == b) {
+        return OPAL_HWLOC_BASE_DISTANCE_SELF;
+    }
+    if (0 <= a->core && a->core == b->core) {
+        return OPAL_HWLOC_BASE_DISTANCE_CORE;
+    }
+    if (0 <= a->l3 && a->l3 == b->l3) {
+        return OPAL_HWLOC_BASE_DISTANCE_L3CACHE;
+    }
+    if (0 <= a->numa && a->numa == b->numa) {
+        return OPAL_HWLOC_BASE_DISTANCE_NUMA;
+    }
+    if (0 <= a->package && a->package == b->package) {
+        return OPAL_HWLOC_BASE_DISTANCE_PACKAGE;
+    }
+    return OPAL_HWLOC_BASE_DISTANCE_NODE;
+}
+
+static int locality_compare_rank(const void *a, const void *b)
+{
+    return ((const opal_hwloc_base_local_proc_t *) a)->local_rank
+           - ((const opal_hwloc_base_local_proc_t *) b)->local_rank;
+}
+
+static int opal_hwloc_base_locality_setup(void)
+{
+    opal_process_name_t name = {.jobid = OPAL_PROC_MY_NAME.jobid, .vpid = OPAL_VPID_WILDCARD};
+    opal_hwloc_base_local_proc_t *procs;
+    char *val = NULL, **peers;
+    int rc, count;
+
+    OPAL_MODEX_RECV_VALUE(rc, PMIX_LOCAL_PEERS, &name, &val, PMIX_STRING);
+    if (OPAL_SUCCESS != rc || NULL == val) {
+        return OPAL_ERR_NOT_FOUND;
+    }
+    peers = opal_argv_split(val, ',');
+    free(val);
+    count = opal_argv_count(peers);
+    if (0 == count) {
+        opal_argv_free(peers);
+        return OPAL_ERR_NOT_FOUND;
+    }
+
+    procs = (opal_hwloc_base_local_proc_t *) calloc(count, sizeof(*procs));
+    opal_hwloc_base_locality_distances = (uint8_t *) malloc((size_t) count * count);
+    if (NULL == procs || NULL == opal_hwloc_base_locality_distances) {
+        free(procs);
+        free(opal_hwloc_base_locality_distances);
+        opal_hwloc_base_locality_distances = NULL;
+        opal_argv_free(peers);
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+    for (int i = 0; i < count; ++i) {
+        opal_hwloc_base_local_proc_t proc = {.local_rank = -1};
+        uint16_t local_rank, *ptr = &local_rank;
+        char *loc = NULL;
+
+        proc.name.jobid = OPAL_PROC_MY_NAME.jobid;
+        proc.name.vpid = (opal_vpid_t) strtoul(peers[i], NULL, 10);
+
+        OPAL_MODEX_RECV_VALUE_OPTIONAL(rc, PMIX_LOCAL_RANK, &proc.name, &ptr, PMIX_UINT16);
+        if (OPAL_SUCCESS == rc) {
+            proc.local_rank = local_rank;
+        }
+
+        if (proc.name.vpid == OPAL_PROC_MY_NAME.vpid && NULL != opal_process_info.locality) {
+            loc = strdup(opal_process_info.locality);
+        } else {
+            OPAL_MODEX_RECV_VALUE_OPTIONAL(rc, PMIX_LOCALITY_STRING, &proc.name, &loc, PMIX_STRING);
+            if (OPAL_SUCCESS != rc) {
+                loc = NULL;
+            }
+        }
+        proc.package = locality_index(loc, HWLOC_OBJ_SOCKET, 0);
+        proc.numa = locality_index(loc, HWLOC_OBJ_NODE, 0);
+        proc.l3 = locality_index(loc, OPAL_HWLOC_LOCALITY_L3);
+        proc.core = locality_index(loc, HWLOC_OBJ_CORE, 0);
+        proc.nic = locality_nearest_osdev(&proc, false);
+        proc.gpu = locality_nearest_osdev(&proc, true);
+        free(loc);
+
+        procs[i] = proc;
+    }
+    opal_argv_free(peers);
+
+    /* the table is indexed by local rank, the ranks are 0 to count - 1
+     * unless PMIx did not provide them all */
+    qsort(procs, count, sizeof(*procs), locality_compare_rank);
+    for (int i = 0; i < count; ++i) {
+        procs[i].local_rank = i;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        for (int j = 0; j < count; ++j) {
+            opal_hwloc_base_locality_distances[i * count + j] = locality_distance(procs + i,
+                                                                                  procs + j);
+        }
+    }
+
+    opal_hwloc_base_locality_procs = procs;
+    opal_hwloc_base_locality_count = count;
+
+    return OPAL_SUCCESS;
+}
+
+int opal_hwloc_base_locality_init(void)
+{
+    if (opal_hwloc_base_locality_ready) {
+        return opal_hwloc_base_locality_rc;
+    }
+
+    opal_mutex_lock(&opal_hwloc_base_locality_lock);
+    if (!opal_hwloc_base_locality_ready) {
+        opal_hwloc_base_locality_rc = opal_hwloc_base_locality_setup();
+        opal_atomic_wmb();
+        opal_hwloc_base_locality_ready = true;
+    }
+    opal_mutex_unlock(&opal_hwloc_base_locality_lock);
+
+    return opal_hwloc_base_locality_rc;
+}
+
+void opal_hwloc_base_locality_finalize(void)
+{
+    free(opal_hwloc_base_locality_procs);
+    free(opal_hwloc_base_locality_distances);
+    opal_hwloc_base_locality_procs = NULL;
+    opal_hwloc_base_locality_distances = NULL;
+    opal_hwloc_base_locality_count = 0;
+    opal_hwloc_base_locality_rc = OPAL_SUCCESS;
+    opal_hwloc_base_locality_ready = false;
+}
+
+int opal_hwloc_base_locality_num_local(void)
+{
+    if (OPAL_SUCCESS != opal_hwloc_base_locality_init()) {
+        return 0;
+    }
+    return opal_hwloc_base_locality_count;
+}
+
+const opal_hwloc_base_local_proc_t *opal_hwloc_base_locality_get(int local_rank)
+{
+    if (OPAL_SUCCESS != opal_hwloc_base_locality_init() || local_rank < 0
+        || local_rank >= opal_hwloc_base_locality_count) {
+        return NULL;
+    }
+    return opal_hwloc_base_locality_procs + local_rank;
+}
+
+const opal_hwloc_base_local_proc_t *opal_hwloc_base_locality_lookup(const opal_process_name_t *name)
+{
+    if (OPAL_SUCCESS != opal_hwloc_base_locality_init()) {
+        return NULL;
+    }
+    for (int i = 0; i < opal_hwloc_base_locality_count; ++i) {
+        if (opal_hwloc_base_locality_procs[i].name.vpid == name->vpid
+            && opal_hwloc_base_locality_procs[i].name.jobid == name->jobid) {
+            return opal_hwloc_base_locality_procs + i;
+        }
+    }
+    return NULL;
+}
+
+int opal_hwloc_base_locality_distance(int local_rank1, int local_rank2)
+{
+    int count = opal_hwloc_base_locality_num_local();
+
+    if (local_rank1 < 0 || local_rank1 >= count || local_rank2 < 0 || local_rank2 >= count) {
+        return OPAL_HWLOC_BASE_DISTANCE_NODE;
+    }
+    return opal_hwloc_base_locality_distances[local_rank1 * count + local_rank2];
+}
@@ -63,6 +63,12 @@ extern opal_list_t mca_mpool_base_modules;
 extern mca_mpool_base_module_t *mca_mpool_base_default_module;
 extern int mca_mpool_base_default_priority;
 
+/* MPI_Alloc_mem: register the memory with the registration caches, largest
+ * allocation kept on free and most bytes kept */
+extern bool mca_mpool_base_alloc_register;
+extern size_t mca_mpool_base_alloc_pool_max;
+extern size_t mca_mpool_base_alloc_pool_limit;
+
 OPAL_DECLSPEC extern mca_base_framework_t opal_mpool_base_framework;
 
 END_C_DECLS
@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2006 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -28,17 +28,147 @@
 #include "mpool_base_tree.h"
 #include "opal/align.h"
 #include "opal/mca/mpool/mpool.h"
+#include "opal/mca/rcache/base/base.h"
 #include "opal/mca/threads/mutex.h"
 #include "opal/util/info.h"
 #include <stdint.h>
 #include <string.h>
 
+/* smallest size class of the pool, and number of classes */
+#define MCA_MPOOL_BASE_POOL_MIN_SHIFT 12
+#define MCA_MPOOL_BASE_POOL_CLASSES   40
+
+bool mca_mpool_base_alloc_register = true;
+size_t mca_mpool_base_alloc_pool_max = 0;
+size_t mca_mpool_base_alloc_pool_limit = 0;
+
+/* freed allocations kept for reuse, by size class, with their registrations */
+static opal_list_t mca_mpool_base_pool[MCA_MPOOL_BASE_POOL_CLASSES];
+static size_t mca_mpool_base_pool_bytes = 0;
+static opal_mutex_t mca_mpool_base_pool_lock;
+
+void mca_mpool_base_alloc_init(void)
+{
+    for (int i = 0; i < MCA_MPOOL_BASE_POOL_CLASSES; ++i) {
+        OBJ_CONSTRUCT(&mca_mpool_base_pool[i], opal_list_t);
+    }
+    OBJ_CONSTRUCT(&mca_mpool_base_pool_lock, opal_mutex_t);
+    mca_mpool_base_pool_bytes = 0;
+}
+
+void mca_mpool_base_alloc_fini(void)
+{
+    for (int i = 0; i < MCA_MPOOL_BASE_POOL_CLASSES; ++i) {
+        OBJ_DESTRUCT(&mca_mpool_base_pool[i]);
+    }
+    OBJ_DESTRUCT(&mca_mpool_base_pool_lock);
+}
+
+static inline size_t mca_mpool_base_pool_class_size(int pool_class)
+{
+    return (size_t) 1 << (pool_class + MCA_MPOOL_BASE_POOL_MIN_SHIFT);
+}
+
+/* size class of an allocation of size bytes, -1 if it is not pooled */
+static int mca_mpool_base_pool_class(size_t size)
+{
+    int pool_class = 0;
+
+    if (0 == mca_mpool_base_alloc_pool_limit || size > mca_mpool_base_alloc_pool_max) {
+        return -1;
+    }
+
+    while (mca_mpool_base_pool_class_size(pool_class) < size) {
+        if (++pool_class == MCA_MPOOL_BASE_POOL_CLASSES) {
+            return -1;
+        }
+    }
+
+    return pool_class;
+}
+
+static mca_mpool_base_tree_item_t *mca_mpool_base_pool_get(mca_mpool_base_module_t *mpool,
+                                                           int pool_class)
+{
+    mca_mpool_base_tree_item_t *item;
+
+    OPAL_THREAD_LOCK(&mca_mpool_base_pool_lock);
+    OPAL_LIST_FOREACH (item, &mca_mpool_base_pool[pool_class], mca_mpool_base_tree_item_t) {
+        /* memory of the same kind */
+        if (item->mpool == mpool) {
+            opal_list_remove_item(&mca_mpool_base_pool[pool_class], &item->super.super);
+            mca_mpool_base_pool_bytes -= mca_mpool_base_pool_class_size(pool_class);
+            OPAL_THREAD_UNLOCK(&mca_mpool_base_pool_lock);
+            return item;
+        }
+    }
+    OPAL_THREAD_UNLOCK(&mca_mpool_base_pool_lock);
+
+    return NULL;
+}
+
+static bool mca_mpool_base_pool_put(mca_mpool_base_tree_item_t *item)
+{
+    size_t size = mca_mpool_base_pool_class_size(item->pool_class);
+    bool kept = false;
+
+    OPAL_THREAD_LOCK(&mca_mpool_base_pool_lock);
+    if (mca_mpool_base_pool_bytes + size <= mca_mpool_base_alloc_pool_limit) {
+        opal_list_append(&mca_mpool_base_pool[item->pool_class], &item->super.super);
+        mca_mpool_base_pool_bytes += size;
+        kept = true;
+    }
+    OPAL_THREAD_UNLOCK(&mca_mpool_base_pool_lock);
+
+    return kept;
+}
+
+/* register the memory of item with the registration caches of the btls, the
+ * communications in it then find a registration in the cache */
+static void mca_mpool_base_register_item(mca_mpool_base_tree_item_t *item, size_t size)
+{
+    mca_rcache_base_selected_module_t *sm;
+    const char *name;
+
+    if (!mca_mpool_base_alloc_register) {
+        return;
+    }
+
+    OPAL_LIST_FOREACH (sm, &mca_rcache_base_modules, mca_rcache_base_selected_module_t) {
+        if (MCA_MPOOL_BASE_TREE_MAX == item->count) {
+            break;
+        }
+
+        /* device memory only */
+        name = sm->rcache_component->rcache_version.mca_component_name;
+        if (0 == strcmp(name, "gpusm") || 0 == strcmp(name, "rgpusm")) {
+            continue;
+        }
+
+        if (OPAL_SUCCESS == sm->rcache_module->rcache_register(sm->rcache_module, item->key, size, 0,
+                                                               MCA_RCACHE_ACCESS_ANY,
+                                                               &item->regs[item->count])) {
+            item->rcaches[item->count++] = sm->rcache_module;
+        }
+    }
+}
+
 static void unregister_tree_item(mca_mpool_base_tree_item_t *mpool_tree_item)
 {
     mca_mpool_base_module_t *mpool;
 
+    for (int i = 0; i < mpool_tree_item->count; ++i) {
+        mpool_tree_item->rcaches[i]->rcache_deregister(mpool_tree_item->rcaches[i],
+                                                       mpool_tree_item->regs[i]);
+    }
+    mpool_tree_item->count = 0;
+
     mpool = mpool_tree_item->mpool;
-    mpool->mpool_free(mpool, mpool_tree_item->key);
+    if (NULL != mpool) {
+        mpool->mpool_free(mpool, mpool_tree_item->key);
+    } else {
+        free(mpool_tree_item->key);
+    }
 }
 
 /**
@@ -51,6 +181,10 @@ static void unregister_tree_item(mca_mpool_base_tree_item_t *mpool_tree_item)
  * fail to register the region will be ignored. The mpool name can optionally be
  * specified in the info object.
  *
+ * Allocations up to mpool_base_alloc_pool_max are rounded up to a power of two
+ * and served first from the ones freed earlier with the same mpool, which are
+ * still registered.
+ *
  * @param size the size of the memory area to allocate
  * @param info an info object which tells us what kind of memory to allocate
  *
@@ -61,10 +195,21 @@ void *mca_mpool_base_alloc(size_t size, opal_info_t *info, const char *hints)
 {
     mca_mpool_base_tree_item_t *mpool_tree_item = NULL;
     mca_mpool_base_module_t *mpool;
+    int pool_class = mca_mpool_base_pool_class(size);
+    size_t alloc_size = size;
     void *mem = NULL;
-#if defined(TODO_BTL_GB)
-    int flag = 0;
-#endif /* defined(TODO_BTL_GB) */
+
+    mpool = mca_mpool_base_module_lookup(hints);
+
+    if (pool_class >= 0) {
+        mpool_tree_item = mca_mpool_base_pool_get(mpool, pool_class);
+        if (NULL != mpool_tree_item) {
+            mpool_tree_item->num_bytes = size;
+            mca_mpool_base_tree_insert(mpool_tree_item);
+            return mpool_tree_item->key;
+        }
+        alloc_size = mca_mpool_base_pool_class_size(pool_class);
+    }
 
     mpool_tree_item = mca_mpool_base_tree_item_get();
     if (!mpool_tree_item) {
@@ -73,23 +218,30 @@ void *mca_mpool_base_alloc(size_t size, opal_info_t *info, const char *hints)
 
     mpool_tree_item->num_bytes = size;
     mpool_tree_item->count = 0;
+    mpool_tree_item->pool_class = pool_class;
+    mpool_tree_item->mpool = NULL;
 
-    mpool = mca_mpool_base_module_lookup(hints);
     if (NULL != mpool) {
-        mem = mpool->mpool_alloc(mpool, size, OPAL_ALIGN_MIN, 0);
+        mem = mpool->mpool_alloc(mpool, alloc_size, OPAL_ALIGN_MIN, 0);
     }
 
     if (NULL == mem) {
-        /* fall back on malloc */
-        mem = malloc(size);
-
-        mca_mpool_base_tree_item_put(mpool_tree_item);
+        /* fall back on malloc, the memory can still be registered and pooled */
+        mem = malloc(alloc_size);
+        if (NULL == mem) {
+            mca_mpool_base_tree_item_put(mpool_tree_item);
+            return NULL;
+        }
+        /* the pool keys on the mpool it was asked for */
+        mpool_tree_item->pool_class = -1;
     } else {
         mpool_tree_item->mpool = mpool;
-        mpool_tree_item->key = mem;
-        mca_mpool_base_tree_insert(mpool_tree_item);
     }
 
+    mpool_tree_item->key = mem;
+    mca_mpool_base_register_item(mpool_tree_item, alloc_size);
+    mca_mpool_base_tree_insert(mpool_tree_item);
+
     return mem;
 }
 
@@ -120,9 +272,31 @@ int mca_mpool_base_free(void *base)
 
     rc = mca_mpool_base_tree_delete(mpool_tree_item);
     if (OPAL_SUCCESS == rc) {
+        if (mpool_tree_item->pool_class >= 0 && mca_mpool_base_pool_put(mpool_tree_item)) {
+            return OPAL_SUCCESS;
+        }
         unregister_tree_item(mpool_tree_item);
         mca_mpool_base_tree_item_put(mpool_tree_item);
     }
 
     return rc;
 }
+
+void mca_mpool_base_alloc_release(void)
+{
+    mca_mpool_base_tree_item_t *item;
+
+    OPAL_THREAD_LOCK(&mca_mpool_base_pool_lock);
+    for (int i = 0; i < MCA_MPOOL_BASE_POOL_CLASSES; ++i) {
+        while (NULL != (item = (mca_mpool_base_tree_item_t *)
+                        opal_list_remove_first(&mca_mpool_base_pool[i]))) {
+            unregister_tree_item(item);
+            mca_mpool_base_tree_item_put(item);
+        }
+    }
+    mca_mpool_base_pool_bytes = 0;
+    OPAL_THREAD_UNLOCK(&mca_mpool_base_pool_lock);
+
+    /* the memory still allocated stays valid, unregistered */
+    mca_mpool_base_tree_deregister();
+}
@@ -71,6 +71,28 @@ static int mca_mpool_base_register(mca_base_register_flag_t flags)
                                  NULL, 0, MCA_BASE_VAR_FLAG_INTERNAL, OPAL_INFO_LVL_9,
                                  MCA_BASE_VAR_SCOPE_LOCAL, &mca_mpool_base_default_priority);
 
+    mca_mpool_base_alloc_register = true;
+    (void) mca_base_var_register("opal", "mpool", "base", "alloc_register",
+                                 "Register the memory of MPI_Alloc_mem with the registration caches "
+                                 "of the btls when it is allocated (default: true)",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                 MCA_BASE_VAR_SCOPE_LOCAL, &mca_mpool_base_alloc_register);
+
+    mca_mpool_base_alloc_pool_max = 64 * 1024 * 1024;
+    (void) mca_base_var_register("opal", "mpool", "base", "alloc_pool_max",
+                                 "Largest MPI_Alloc_mem allocation kept, registered, on MPI_Free_mem "
+                                 "for reuse. The pooled allocations are rounded up to a power of two "
+                                 "(default: 64MB)",
+                                 MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                 MCA_BASE_VAR_SCOPE_LOCAL, &mca_mpool_base_alloc_pool_max);
+
+    mca_mpool_base_alloc_pool_limit = 256 * 1024 * 1024;
+    (void) mca_base_var_register("opal", "mpool", "base", "alloc_pool_limit",
+                                 "Most bytes of freed MPI_Alloc_mem allocations kept for reuse, 0 "
+                                 "disables the pool (default: 256MB)",
+                                 MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                 MCA_BASE_VAR_SCOPE_LOCAL, &mca_mpool_base_alloc_pool_limit);
+
     return OPAL_SUCCESS;
 }
 
@@ -96,6 +118,7 @@ static int mca_mpool_base_open(mca_base_open_flag_t flags)
 
     /* setup tree for tracking MPI_Alloc_mem */
     mca_mpool_base_tree_init();
+    mca_mpool_base_alloc_init();
 
     return OPAL_SUCCESS;
 }
@@ -105,6 +128,9 @@ static int mca_mpool_base_close(void)
     opal_list_item_t *item;
     mca_mpool_base_selected_module_t *sm;
 
+    /* no-op if ompi_mpi_finalize did it already */
+    mca_mpool_base_alloc_release();
+
     /* Finalize all the mpool components and free their list items */
 
     while (NULL != (item = opal_list_remove_first(&mca_mpool_base_modules))) {
@@ -125,6 +151,7 @@ static int mca_mpool_base_close(void)
        OMPI RTE program, or [possibly] multiple if this is opal_info) */
     (void) mca_base_framework_components_close(&opal_mpool_base_framework, NULL);
 
+    mca_mpool_base_alloc_fini();
     mca_mpool_base_tree_fini();
 
     return OPAL_SUCCESS;
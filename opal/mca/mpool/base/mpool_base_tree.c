@@ -167,6 +167,32 @@ void mca_mpool_base_tree_item_put(mca_mpool_base_tree_item_t *item)
     opal_free_list_return(&mca_mpool_base_tree_item_free_list, &item->super);
 }
 
+static int deregister_condition(void *value)
+{
+    return 0 != ((mca_mpool_base_tree_item_t *) value)->count;
+}
+
+static void deregister_action(void *key, void *value)
+{
+    mca_mpool_base_tree_item_t *item = (mca_mpool_base_tree_item_t *) value;
+
+    for (int i = 0; i < item->count; ++i) {
+        item->rcaches[i]->rcache_deregister(item->rcaches[i], item->regs[i]);
+    }
+    item->count = 0;
+}
+
+/*
+ * Drop the registrations of the memory the user did not free, before the
+ * registration caches go away with the btls
+ */
+void mca_mpool_base_tree_deregister(void)
+{
+    OPAL_THREAD_LOCK(&tree_lock);
+    opal_rb_tree_traverse(&mca_mpool_base_tree, deregister_condition, deregister_action);
+    OPAL_THREAD_UNLOCK(&tree_lock);
+}
+
 /*
  * Print a show_help kind of message for an items still left in the
  * tree
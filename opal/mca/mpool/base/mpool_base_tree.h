@@ -50,6 +50,7 @@ struct mca_mpool_base_tree_item_t {
     mca_rcache_base_module_t *rcaches[MCA_MPOOL_BASE_TREE_MAX];    /**< the registration caches */
     mca_rcache_base_registration_t *regs[MCA_MPOOL_BASE_TREE_MAX]; /**< the registrations */
     uint8_t count; /**< length of the mpools/regs array */
+    int pool_class; /**< size class of the pool the memory returns to, -1 if none */
 };
 typedef struct mca_mpool_base_tree_item_t mca_mpool_base_tree_item_t;
 
@@ -86,6 +87,17 @@ mca_mpool_base_tree_item_t *mca_mpool_base_tree_item_get(void);
  */
 void mca_mpool_base_tree_item_put(mca_mpool_base_tree_item_t *item);
 
+/*
+ * setup/teardown the pool of the freed allocations
+ */
+void mca_mpool_base_alloc_init(void);
+void mca_mpool_base_alloc_fini(void);
+
+/*
+ * drop the registrations of all the items left in the tree
+ */
+void mca_mpool_base_tree_deregister(void);
+
 /*
  * For debugging, print a show_help kind of message if there are items
  * left in the tree. The argument is the number of items to be printed
@@ -159,6 +159,13 @@ OPAL_DECLSPEC void *mca_mpool_base_alloc(size_t size, struct opal_info_t *info,
  */
 OPAL_DECLSPEC int mca_mpool_base_free(void *base);
 
+/**
+ * Release the memory kept for reuse by mca_mpool_base_free, and drop the
+ * registrations of the memory allocated by mca_mpool_base_alloc. Must be
+ * called before the btls (and their registration caches) are closed.
+ */
+OPAL_DECLSPEC void mca_mpool_base_alloc_release(void);
+
 /**
  * Function for the red black tree to compare 2 keys
  *
@@ -38,9 +38,79 @@
 
 #include "opal/mca/mca.h"
 #include "opal/memoryhooks/memory.h"
+#include "opal/sys/atomic.h"
 
 static char msg[512];
 
+/*
+ * Counting filter over the chunks of the address space covered by the
+ * registrations of the vma trees, so that a release of memory that was never
+ * registered does not walk the rcaches. The counter of a chunk may be shared
+ * by other chunks (false positives only cost the slow path); the
+ * registrations spanning more chunks than there are counters are counted as
+ * wide, and as long as one exists every release takes the slow path.
+ */
+#define MCA_RCACHE_BASE_MEM_FILTER_BITS        13
+#define MCA_RCACHE_BASE_MEM_FILTER_SIZE        (1 << MCA_RCACHE_BASE_MEM_FILTER_BITS)
+#define MCA_RCACHE_BASE_MEM_FILTER_CHUNK_SHIFT 21
+
+static opal_atomic_int32_t mca_rcache_base_mem_filter[MCA_RCACHE_BASE_MEM_FILTER_SIZE];
+static opal_atomic_int32_t mca_rcache_base_mem_filter_wide = 0;
+
+static inline size_t mca_rcache_base_mem_filter_index(uint64_t chunk)
+{
+    return (size_t) ((chunk * 0x9e3779b97f4a7c15ULL) >> (64 - MCA_RCACHE_BASE_MEM_FILTER_BITS));
+}
+
+static inline void mca_rcache_base_mem_filter_update(void *base, size_t size, int32_t delta)
+{
+    uint64_t first = (uintptr_t) base >> MCA_RCACHE_BASE_MEM_FILTER_CHUNK_SHIFT;
+    uint64_t last = ((uintptr_t) base + size - 1) >> MCA_RCACHE_BASE_MEM_FILTER_CHUNK_SHIFT;
+
+    if (last - first >= MCA_RCACHE_BASE_MEM_FILTER_SIZE) {
+        opal_atomic_add_fetch_32(&mca_rcache_base_mem_filter_wide, delta);
+        return;
+    }
+
+    for (uint64_t chunk = first; chunk <= last; ++chunk) {
+        opal_atomic_add_fetch_32(mca_rcache_base_mem_filter + mca_rcache_base_mem_filter_index(chunk),
+                                 delta);
+    }
+}
+
+void mca_rcache_base_mem_filter_add(void *base, size_t size)
+{
+    if (size) {
+        mca_rcache_base_mem_filter_update(base, size, 1);
+    }
+}
+
+void mca_rcache_base_mem_filter_remove(void *base, size_t size)
+{
+    if (size) {
+        mca_rcache_base_mem_filter_update(base, size, -1);
+    }
+}
+
+/* true if [base, base + size) may overlap a registration */
+static inline bool mca_rcache_base_mem_filter_check(void *base, size_t size)
+{
+    uint64_t first = (uintptr_t) base >> MCA_RCACHE_BASE_MEM_FILTER_CHUNK_SHIFT;
+    uint64_t last = ((uintptr_t) base + size - 1) >> MCA_RCACHE_BASE_MEM_FILTER_CHUNK_SHIFT;
+
+    if (0 != mca_rcache_base_mem_filter_wide || last - first >= MCA_RCACHE_BASE_MEM_FILTER_SIZE) {
+        return true;
+    }
+
+    for (uint64_t chunk = first; chunk <= last; ++chunk) {
+        if (0 != mca_rcache_base_mem_filter[mca_rcache_base_mem_filter_index(chunk)]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /*
  *  memory hook callback, called when memory is free'd out from under
  *  us.  Be wary of the from_alloc flag -- if you're called with
@@ -58,6 +128,11 @@ void mca_rcache_base_mem_cb(void *base, size_t size, void *cbdata, bool from_all
         return;
     }
 
+    /* most of the releases are of memory that was never registered */
+    if (!mca_rcache_base_mem_filter_check(base, size)) {
+        return;
+    }
+
     OPAL_LIST_FOREACH (current, &mca_rcache_base_modules, mca_rcache_base_selected_module_t) {
         if (current->rcache_module->rcache_invalidate_range != NULL) {
             rc = current->rcache_module->rcache_invalidate_range(current->rcache_module, base,
@@ -33,6 +33,13 @@ BEGIN_C_DECLS
  */
 void mca_rcache_base_mem_cb(void *base, size_t size, void *cbdata, bool from_alloc);
 
+/*
+ *  record the ranges of the registrations, the callback returns at once
+ *  for the releases that overlap none of them
+ */
+void mca_rcache_base_mem_filter_add(void *base, size_t size);
+void mca_rcache_base_mem_filter_remove(void *base, size_t size);
+
 END_C_DECLS
 
 #endif /* MCA_RCACHE_BASE_MEM_CB_H */
@@ -30,6 +30,7 @@
 #include "opal/mca/memory/memory.h"
 #include "opal/mca/rcache/base/base.h"
 #include "opal/mca/rcache/rcache.h"
+#include "opal/mca/rcache/base/rcache_base_mem_cb.h"
 #include "rcache_base_vma.h"
 #include "rcache_base_vma_tree.h"
 
@@ -120,11 +121,15 @@ int mca_rcache_base_vma_insert(mca_rcache_base_vma_module_t *vma_module,
         return rc;
     }
 
+    /* the filter must cover the region before a release can find it in the tree */
+    mca_rcache_base_mem_filter_add(reg->base, reg_size);
     rc = mca_rcache_base_vma_tree_insert(vma_module, reg, limit);
     if (OPAL_LIKELY(OPAL_SUCCESS == rc)) {
         /* If we successfully registered, then tell the memory manager
            to start monitoring this region */
         opal_memory->memoryc_register(reg->base, (uint64_t) reg_size, (uint64_t)(uintptr_t) reg);
+    } else {
+        mca_rcache_base_mem_filter_remove(reg->base, reg_size);
     }
 
     return rc;
@@ -135,9 +140,15 @@ int mca_rcache_base_vma_delete(mca_rcache_base_vma_module_t *vma_module,
 {
     /* Tell the memory manager that we no longer care about this
        region */
+    int rc;
+
     opal_memory->memoryc_deregister(reg->base, (uint64_t)(reg->bound - reg->base),
                                     (uint64_t)(uintptr_t) reg);
-    return mca_rcache_base_vma_tree_delete(vma_module, reg);
+    rc = mca_rcache_base_vma_tree_delete(vma_module, reg);
+    if (OPAL_SUCCESS == rc) {
+        mca_rcache_base_mem_filter_remove(reg->base, reg->bound - reg->base + 1);
+    }
+    return rc;
 }
 
 int mca_rcache_base_vma_iterate(mca_rcache_base_vma_module_t *vma_module, unsigned char *base,
@@ -37,6 +37,7 @@
 #endif
 
 #define MCA_RCACHE_GRDMA_REG_FLAG_IN_LRU MCA_RCACHE_FLAGS_MOD_RESV0
+#define MCA_RCACHE_GRDMA_REG_FLAG_RECENT MCA_RCACHE_FLAGS_MOD_RESV1
 
 BEGIN_C_DECLS
 
@@ -45,18 +46,46 @@ struct mca_rcache_grdma_cache_t {
     char *cache_name;
     opal_list_t lru_list;
     opal_lifo_t gc_lifo;
+    /** registered memory waiting in gc_lifo (bytes) */
+    opal_atomic_size_t gc_pending;
     mca_rcache_base_vma_module_t *vma_module;
 };
 typedef struct mca_rcache_grdma_cache_t mca_rcache_grdma_cache_t;
 
 OBJ_CLASS_DECLARATION(mca_rcache_grdma_cache_t);
 
+/**
+ * Statistics of all the grdma modules, exposed as MPI_T performance variables.
+ */
+struct mca_rcache_grdma_stats_t {
+    opal_atomic_int64_t hits;            /**< lookups satisfied by a cached registration */
+    opal_atomic_int64_t misses;          /**< lookups requiring a new registration */
+    opal_atomic_int64_t evictions;       /**< unused registrations evicted from the LRU */
+    opal_atomic_int64_t registrations;   /**< successful calls to register_mem */
+    opal_atomic_int64_t deregistrations; /**< successful calls to deregister_mem */
+    opal_atomic_int64_t register_usec;   /**< time spent in register_mem */
+    opal_atomic_int64_t deregister_usec; /**< time spent in deregister_mem */
+    opal_atomic_size_t bytes_pinned;     /**< memory currently registered */
+    size_t bytes_pinned_max;             /**< high watermark of bytes_pinned */
+};
+typedef struct mca_rcache_grdma_stats_t mca_rcache_grdma_stats_t;
+
 struct mca_rcache_grdma_component_t {
     mca_rcache_base_component_t super;
     opal_list_t caches;
     char *rcache_name;
     bool print_stats;
     int leave_pinned;
+    /** stale registrations released per call to the progress engine */
+    int gc_batch_size;
+    /** stale registered memory above which the registration path releases it */
+    size_t gc_max_pending;
+    /** maximum amount of registered memory (0: no limit) */
+    size_t max_pinned;
+    /** seconds between two summaries of the statistics (0: never) */
+    int stats_interval;
+    opal_atomic_int64_t last_summary;
+    mca_rcache_grdma_stats_t stats;
 };
 typedef struct mca_rcache_grdma_component_t mca_rcache_grdma_component_t;
 
@@ -83,5 +112,16 @@ typedef struct mca_rcache_grdma_module_t mca_rcache_grdma_module_t;
 void mca_rcache_grdma_module_init(mca_rcache_grdma_module_t *rcache,
                                   mca_rcache_grdma_cache_t *cache);
 
+/*
+ *  Low priority progress function releasing the stale registrations and printing the
+ *  periodic summary.
+ */
+int mca_rcache_grdma_progress(void);
+
+/*
+ *  Print the statistics of all the grdma modules.
+ */
+void mca_rcache_grdma_print_summary(void);
+
 END_C_DECLS
 #endif
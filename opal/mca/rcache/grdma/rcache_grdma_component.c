@@ -26,6 +26,8 @@
 #include "opal_config.h"
 #include "opal/mca/base/base.h"
 #include "opal/runtime/opal_params.h"
+#include "opal/mca/timer/base/base.h"
+#include "opal/runtime/opal_progress.h"
 #include "rcache_grdma.h"
 #ifdef HAVE_UNISTD_H
 #    include <unistd.h>
@@ -39,6 +41,7 @@
 static int grdma_open(void);
 static int grdma_close(void);
 static int grdma_register(void);
+static void grdma_register_pvars(void);
 static mca_rcache_base_module_t *grdma_init(struct mca_rcache_base_resources_t *resources);
 
 mca_rcache_grdma_component_t mca_rcache_grdma_component = {{
@@ -70,6 +73,13 @@ static int grdma_open(void)
 {
     OBJ_CONSTRUCT(&mca_rcache_grdma_component.caches, opal_list_t);
 
+    memset(&mca_rcache_grdma_component.stats, 0, sizeof(mca_rcache_grdma_component.stats));
+    mca_rcache_grdma_component.last_summary = (int64_t) opal_timer_base_get_usec();
+    if (mca_rcache_grdma_component.gc_batch_size > 0
+        || mca_rcache_grdma_component.stats_interval > 0) {
+        (void) opal_progress_register_lp(mca_rcache_grdma_progress);
+    }
+
     return OPAL_SUCCESS;
 }
 
@@ -82,11 +92,108 @@ static int grdma_register(void)
         NULL, 0, 0, OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
         &mca_rcache_grdma_component.print_stats);
 
+    mca_rcache_grdma_component.gc_batch_size = 16;
+    (void) mca_base_component_var_register(
+        &mca_rcache_grdma_component.super.rcache_version, "gc_batch_size",
+        "Maximum number of stale registrations (invalidated by munmap/free) released by each "
+        "low priority call to the progress engine. 0 releases all of them on the next "
+        "registration attempt instead",
+        MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
+        &mca_rcache_grdma_component.gc_batch_size);
+
+    mca_rcache_grdma_component.gc_max_pending = 256 * 1024 * 1024;
+    (void) mca_base_component_var_register(
+        &mca_rcache_grdma_component.super.rcache_version, "gc_max_pending",
+        "Amount of stale registered memory (in bytes) above which the next registration attempt "
+        "releases all the stale registrations without waiting for the progress engine",
+        MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
+        &mca_rcache_grdma_component.gc_max_pending);
+
+    mca_rcache_grdma_component.max_pinned = 0;
+    (void) mca_base_component_var_register(
+        &mca_rcache_grdma_component.super.rcache_version, "max_pinned",
+        "Maximum amount of memory (in bytes) registered by all the grdma modules. Unused "
+        "registrations are evicted, least recently used first, to stay below it and "
+        "registrations that do not fit fail. Set it below RLIMIT_MEMLOCK or the NIC translation "
+        "table limits (0: no limit)",
+        MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_READONLY,
+        &mca_rcache_grdma_component.max_pinned);
+
+    mca_rcache_grdma_component.stats_interval = 0;
+    (void) mca_base_component_var_register(
+        &mca_rcache_grdma_component.super.rcache_version, "stats_interval",
+        "Print a summary of the registration cache statistics every this many seconds "
+        "(0: never)",
+        MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_9, MCA_BASE_VAR_SCOPE_READONLY,
+        &mca_rcache_grdma_component.stats_interval);
+
+    grdma_register_pvars();
+
     return OPAL_SUCCESS;
 }
 
+static void grdma_register_counter(const char *name, const char *desc, int var_class,
+                                   opal_atomic_int64_t *counter)
+{
+    (void) mca_base_component_pvar_register(&mca_rcache_grdma_component.super.rcache_version,
+                                            name, desc, OPAL_INFO_LVL_4, var_class,
+                                            MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL,
+                                            MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY
+                                                | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL, (void *) counter);
+}
+
+static void grdma_register_pvars(void)
+{
+    mca_rcache_grdma_stats_t *stats = &mca_rcache_grdma_component.stats;
+
+    grdma_register_counter("cache_hits", "Number of registration requests satisfied by a cached "
+                           "registration", MCA_BASE_PVAR_CLASS_COUNTER, &stats->hits);
+    grdma_register_counter("cache_misses", "Number of registration requests that required a new "
+                           "registration", MCA_BASE_PVAR_CLASS_COUNTER, &stats->misses);
+    grdma_register_counter("evictions", "Number of unused registrations evicted from the "
+                           "cache", MCA_BASE_PVAR_CLASS_COUNTER, &stats->evictions);
+    grdma_register_counter("registrations", "Number of memory registrations",
+                           MCA_BASE_PVAR_CLASS_COUNTER, &stats->registrations);
+    grdma_register_counter("deregistrations", "Number of memory deregistrations",
+                           MCA_BASE_PVAR_CLASS_COUNTER, &stats->deregistrations);
+    grdma_register_counter("register_time", "Time spent registering memory (microseconds)",
+                           MCA_BASE_PVAR_CLASS_TIMER, &stats->register_usec);
+    grdma_register_counter("deregister_time", "Time spent deregistering memory (microseconds)",
+                           MCA_BASE_PVAR_CLASS_TIMER, &stats->deregister_usec);
+
+    (void) mca_base_component_pvar_register(&mca_rcache_grdma_component.super.rcache_version,
+                                            "bytes_pinned",
+                                            "Number of bytes currently registered by the grdma "
+                                            "modules",
+                                            OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_SIZE,
+                                            MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL,
+                                            MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY
+                                                | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL, (void *) &stats->bytes_pinned);
+    (void) mca_base_component_pvar_register(&mca_rcache_grdma_component.super.rcache_version,
+                                            "bytes_pinned_max",
+                                            "Maximum number of bytes registered at once by the "
+                                            "grdma modules",
+                                            OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_HIGHWATERMARK,
+                                            MCA_BASE_VAR_TYPE_UNSIGNED_LONG, NULL,
+                                            MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY
+                                                | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL, (void *) &stats->bytes_pinned_max);
+}
+
 static int grdma_close(void)
 {
+    if (mca_rcache_grdma_component.gc_batch_size > 0
+        || mca_rcache_grdma_component.stats_interval > 0) {
+        (void) opal_progress_unregister(mca_rcache_grdma_progress);
+    }
+    if (mca_rcache_grdma_component.print_stats || mca_rcache_grdma_component.stats_interval > 0) {
+        mca_rcache_grdma_print_summary();
+    }
     OPAL_LIST_DESTRUCT(&mca_rcache_grdma_component.caches);
     return OPAL_SUCCESS;
 }
@@ -45,6 +45,7 @@
 #include "opal/mca/rcache/rcache.h"
 
 #include "opal/align.h"
+#include "opal/mca/timer/base/base.h"
 #include "opal/util/sys_limits.h"
 #include "rcache_grdma.h"
 
@@ -74,6 +75,56 @@ static inline bool registration_is_cacheable(mca_rcache_base_registration_t *reg
     return registration_flags_cacheable(reg->flags);
 }
 
+static inline void mca_rcache_grdma_stat_add(opal_atomic_int64_t *stat, int64_t value)
+{
+    (void) opal_atomic_fetch_add_64(stat, value);
+}
+
+/* Register/deregister through the resource callbacks, accounting for the time spent and the
+ * memory pinned. */
+static inline int mca_rcache_grdma_register_mem(mca_rcache_grdma_module_t *rcache_grdma,
+                                                mca_rcache_base_registration_t *grdma_reg)
+{
+    mca_rcache_grdma_stats_t *stats = &mca_rcache_grdma_component.stats;
+    size_t size = grdma_reg->bound - grdma_reg->base + 1, pinned;
+    opal_timer_t start = opal_timer_base_get_usec();
+    int rc;
+
+    rc = rcache_grdma->resources.register_mem(rcache_grdma->resources.reg_data, grdma_reg->base,
+                                              size, grdma_reg);
+    mca_rcache_grdma_stat_add(&stats->register_usec,
+                              (int64_t)(opal_timer_base_get_usec() - start));
+    if (OPAL_SUCCESS == rc) {
+        mca_rcache_grdma_stat_add(&stats->registrations, 1);
+        pinned = opal_atomic_add_fetch_size_t(&stats->bytes_pinned, size);
+        /* racy, but a high watermark does not need to be exact */
+        if (pinned > stats->bytes_pinned_max) {
+            stats->bytes_pinned_max = pinned;
+        }
+    }
+
+    return rc;
+}
+
+static inline int mca_rcache_grdma_deregister_mem(mca_rcache_grdma_module_t *rcache_grdma,
+                                                  mca_rcache_base_registration_t *grdma_reg)
+{
+    mca_rcache_grdma_stats_t *stats = &mca_rcache_grdma_component.stats;
+    opal_timer_t start = opal_timer_base_get_usec();
+    int rc;
+
+    rc = rcache_grdma->resources.deregister_mem(rcache_grdma->resources.reg_data, grdma_reg);
+    mca_rcache_grdma_stat_add(&stats->deregister_usec,
+                              (int64_t)(opal_timer_base_get_usec() - start));
+    if (OPAL_SUCCESS == rc) {
+        mca_rcache_grdma_stat_add(&stats->deregistrations, 1);
+        (void) opal_atomic_sub_fetch_size_t(&stats->bytes_pinned,
+                                            grdma_reg->bound - grdma_reg->base + 1);
+    }
+
+    return rc;
+}
+
 #if OPAL_CUDA_GDR_SUPPORT
 static int check_for_cuda_freed_memory(mca_rcache_base_module_t *rcache, void *addr, size_t size);
 #endif /* OPAL_CUDA_GDR_SUPPORT */
@@ -132,18 +183,60 @@ void mca_rcache_grdma_module_init(mca_rcache_grdma_module_t *rcache,
                         32, NULL, 0, NULL, NULL, NULL);
 }
 
+static inline void mca_rcache_grdma_remove_from_lru(mca_rcache_grdma_module_t *rcache_grdma,
+                                                    mca_rcache_base_registration_t *grdma_reg)
+{
+    /* opal lists are not thread safe at this time so we must lock :'( */
+    opal_mutex_lock(&rcache_grdma->cache->vma_module->vma_lock);
+    if (grdma_reg->flags & MCA_RCACHE_GRDMA_REG_FLAG_IN_LRU) {
+        opal_list_remove_item(&rcache_grdma->cache->lru_list, (opal_list_item_t *) grdma_reg);
+        /* clear the LRU flag */
+        opal_atomic_fetch_and_32((opal_atomic_int32_t *) &grdma_reg->flags,
+                                 ~MCA_RCACHE_GRDMA_REG_FLAG_IN_LRU);
+    }
+    opal_mutex_unlock(&rcache_grdma->cache->vma_module->vma_lock);
+}
+
+/* Take a reference on a registration found in the vma tree. The tree is walked without the
+ * vma lock, so the registration may be concurrently claimed for destruction: a negative
+ * reference count or the invalid flag mean it cannot be used anymore. */
+static inline bool mca_rcache_grdma_reg_get(mca_rcache_base_registration_t *grdma_reg)
+{
+    int32_t ref_count = grdma_reg->ref_count;
+
+    do {
+        if (ref_count < 0 || (grdma_reg->flags & MCA_RCACHE_FLAGS_INVALID)) {
+            return false;
+        }
+    } while (!opal_atomic_compare_exchange_strong_32(&grdma_reg->ref_count, &ref_count,
+                                                     ref_count + 1));
+    return true;
+}
+
+/* Claim an unused registration for destruction. Fails if another thread still (or again)
+ * holds a reference, or already claimed it. */
+static inline bool mca_rcache_grdma_reg_claim(mca_rcache_base_registration_t *grdma_reg)
+{
+    int32_t ref_count = 0;
+
+    return opal_atomic_compare_exchange_strong_32(&grdma_reg->ref_count, &ref_count, -1);
+}
+
 static inline int dereg_mem(mca_rcache_base_registration_t *reg)
 {
     mca_rcache_grdma_module_t *rcache_grdma = (mca_rcache_grdma_module_t *) reg->rcache;
     int rc;
 
+    if (reg->flags & MCA_RCACHE_GRDMA_REG_FLAG_IN_LRU) {
+        mca_rcache_grdma_remove_from_lru(rcache_grdma, reg);
+    }
     reg->ref_count = 0;
 
     if (!(reg->flags & MCA_RCACHE_FLAGS_CACHE_BYPASS)) {
         mca_rcache_base_vma_delete(rcache_grdma->cache->vma_module, reg);
     }
 
-    rc = rcache_grdma->resources.deregister_mem(rcache_grdma->resources.reg_data, reg);
+    rc = mca_rcache_grdma_deregister_mem(rcache_grdma, reg);
     if (OPAL_LIKELY(OPAL_SUCCESS == rc)) {
         opal_free_list_return_mt(&rcache_grdma->reg_list, (opal_free_list_item_t *) reg);
     }
@@ -153,54 +246,117 @@ static inline int dereg_mem(mca_rcache_base_registration_t *reg)
     return rc;
 }
 
-static inline void do_unregistration_gc(mca_rcache_base_module_t *rcache)
+/* Deregister up to max (all if max is 0) of the stale registrations of the cache */
+static inline int do_unregistration_gc(mca_rcache_grdma_cache_t *cache, int max)
 {
-    mca_rcache_grdma_module_t *rcache_grdma = (mca_rcache_grdma_module_t *) rcache;
-    opal_list_item_t *item;
+    mca_rcache_base_registration_t *reg;
+    int count = 0;
 
     /* Remove registration from garbage collection list before deregistering it */
-    while (NULL != (item = opal_lifo_pop_atomic(&rcache_grdma->cache->gc_lifo))) {
+    while ((0 == max || count < max)
+           && NULL != (reg = (mca_rcache_base_registration_t *) opal_lifo_pop_atomic(
+                           &cache->gc_lifo))) {
         OPAL_OUTPUT_VERBOSE((MCA_BASE_VERBOSE_TRACE, opal_rcache_base_framework.framework_output,
-                             "deleting stale registration %p", (void *) item));
-        dereg_mem((mca_rcache_base_registration_t *) item);
+                             "deleting stale registration %p", (void *) reg));
+        (void) opal_atomic_sub_fetch_size_t(&cache->gc_pending, reg->bound - reg->base + 1);
+        dereg_mem(reg);
+        count++;
+    }
+
+    return count;
+}
+
+void mca_rcache_grdma_print_summary(void)
+{
+    mca_rcache_grdma_stats_t *stats = &mca_rcache_grdma_component.stats;
+
+    opal_output(0,
+                "%s grdma: summary (hits/misses/evictions/registrations/deregistrations): "
+                "%lld/%lld/%lld/%lld/%lld, register/deregister time %.3f/%.3f s, "
+                "pinned %lu bytes (max %lu)\n",
+                OPAL_NAME_PRINT(OPAL_PROC_MY_NAME), (long long) stats->hits,
+                (long long) stats->misses, (long long) stats->evictions,
+                (long long) stats->registrations, (long long) stats->deregistrations,
+                (double) stats->register_usec / 1e6, (double) stats->deregister_usec / 1e6,
+                (unsigned long) stats->bytes_pinned, (unsigned long) stats->bytes_pinned_max);
+}
+
+int mca_rcache_grdma_progress(void)
+{
+    mca_rcache_grdma_cache_t *cache;
+    int count = 0;
+
+    if (mca_rcache_grdma_component.gc_batch_size > 0) {
+        OPAL_LIST_FOREACH (cache, &mca_rcache_grdma_component.caches, mca_rcache_grdma_cache_t) {
+            if (!opal_lifo_is_empty(&cache->gc_lifo)) {
+                count += do_unregistration_gc(cache, mca_rcache_grdma_component.gc_batch_size);
+            }
+        }
+    }
+
+    if (mca_rcache_grdma_component.stats_interval > 0) {
+        int64_t now = (int64_t) opal_timer_base_get_usec();
+        int64_t last = mca_rcache_grdma_component.last_summary;
+
+        /* the thread moving the date forward prints */
+        if (now - last >= (int64_t) mca_rcache_grdma_component.stats_interval * 1000000
+            && opal_atomic_compare_exchange_strong_64(&mca_rcache_grdma_component.last_summary,
+                                                      &last, now)) {
+            mca_rcache_grdma_print_summary();
+        }
+    }
+
+    return count;
+}
+
+/* Called before each registration: the stale registrations are normally released in batches
+ * from the progress engine, unless they pin more memory than allowed. */
+static inline void mca_rcache_grdma_check_gc(mca_rcache_grdma_cache_t *cache)
+{
+    if ((0 == mca_rcache_grdma_component.gc_batch_size
+         || cache->gc_pending > mca_rcache_grdma_component.gc_max_pending)
+        && !opal_lifo_is_empty(&cache->gc_lifo)) {
+        (void) do_unregistration_gc(cache, 0);
     }
 }
 
+/*
+ * Pick an unused registration to evict. The registrations stay in the LRU while in use so that
+ * taking and releasing a reference does not need the vma lock: the released ones are only
+ * marked as recently used, and get a second chance at the end of the list when they reach its
+ * head, as do the ones still in use.
+ */
 static inline mca_rcache_base_registration_t *
 mca_rcache_grdma_remove_lru_head(mca_rcache_grdma_cache_t *cache)
 {
     mca_rcache_base_registration_t *old_reg;
-    int32_t old_flags;
+    size_t scan;
 
-    do {
-        opal_mutex_lock(&cache->vma_module->vma_lock);
+    opal_mutex_lock(&cache->vma_module->vma_lock);
+    scan = 2 * opal_list_get_size(&cache->lru_list);
+    while (scan-- > 0) {
         old_reg = (mca_rcache_base_registration_t *) opal_list_remove_first(&cache->lru_list);
         if (NULL == old_reg) {
-            opal_mutex_unlock(&cache->vma_module->vma_lock);
             break;
         }
 
-        do {
-            int32_t new_flags;
-            old_flags = old_reg->flags;
+        if (!(old_reg->flags & MCA_RCACHE_GRDMA_REG_FLAG_RECENT)
+            && mca_rcache_grdma_reg_claim(old_reg)) {
             /* registration has been selected for removal and is no longer in the LRU. mark it
              * as such. */
-            new_flags = (old_flags & ~MCA_RCACHE_GRDMA_REG_FLAG_IN_LRU) | MCA_RCACHE_FLAGS_INVALID;
-            if (opal_atomic_compare_exchange_strong_32((opal_atomic_int32_t *) &old_reg->flags,
-                                                       &old_flags, new_flags)) {
-                break;
-            }
-        } while (1);
-        opal_mutex_unlock(&cache->vma_module->vma_lock);
-
-        if (old_flags & MCA_RCACHE_FLAGS_INVALID) {
-            /* registration was already invalidated. in this case its fate is being determined
-             * by another thread. */
-            continue;
+            opal_atomic_fetch_and_32((opal_atomic_int32_t *) &old_reg->flags,
+                                     ~MCA_RCACHE_GRDMA_REG_FLAG_IN_LRU);
+            opal_atomic_fetch_or_32((opal_atomic_int32_t *) &old_reg->flags,
+                                    MCA_RCACHE_FLAGS_INVALID);
+            opal_mutex_unlock(&cache->vma_module->vma_lock);
+            return old_reg;
         }
 
-        return old_reg;
-    } while (1);
+        opal_atomic_fetch_and_32((opal_atomic_int32_t *) &old_reg->flags,
+                                 ~MCA_RCACHE_GRDMA_REG_FLAG_RECENT);
+        opal_list_append(&cache->lru_list, (opal_list_item_t *) old_reg);
+    }
+    opal_mutex_unlock(&cache->vma_module->vma_lock);
 
     return NULL;
 }
@@ -219,6 +375,7 @@ static inline bool mca_rcache_grdma_evict_lru_local(mca_rcache_grdma_cache_t *ca
 
     (void) dereg_mem(old_reg);
     rcache_grdma->stat_evicted++;
+    mca_rcache_grdma_stat_add(&mca_rcache_grdma_component.stats.evictions, 1);
 
     return true;
 }
@@ -255,24 +412,6 @@ static inline void mca_rcache_grdma_add_to_lru(mca_rcache_grdma_module_t *rcache
     opal_mutex_unlock(&rcache_grdma->cache->vma_module->vma_lock);
 }
 
-static inline void mca_rcache_grdma_remove_from_lru(mca_rcache_grdma_module_t *rcache_grdma,
-                                                    mca_rcache_base_registration_t *grdma_reg)
-{
-    /* if the reference count was observed to be 0 (which must be the case for this
-     * function to be called then some thread deregistered the region. it may be the
-     * case that the deregistration is still ongoing so wait until the deregistration
-     * thread has marked this registration as being in the lru before continuing */
-    while (!(grdma_reg->flags & MCA_RCACHE_GRDMA_REG_FLAG_IN_LRU)) {
-    }
-
-    /* opal lists are not thread safe at this time so we must lock :'( */
-    opal_mutex_lock(&rcache_grdma->cache->vma_module->vma_lock);
-    opal_list_remove_item(&rcache_grdma->cache->lru_list, (opal_list_item_t *) grdma_reg);
-    /* clear the LRU flag */
-    grdma_reg->flags &= ~MCA_RCACHE_GRDMA_REG_FLAG_IN_LRU;
-    opal_mutex_unlock(&rcache_grdma->cache->vma_module->vma_lock);
-}
-
 static int mca_rcache_grdma_check_cached(mca_rcache_base_registration_t *grdma_reg, void *ctx)
 {
     mca_rcache_base_find_args_t *args = (mca_rcache_base_find_args_t *) ctx;
@@ -290,21 +429,62 @@ static int mca_rcache_grdma_check_cached(mca_rcache_base_registration_t *grdma_r
         return mca_rcache_grdma_add_to_gc(grdma_reg);
     }
 
-    int32_t ref_cnt = opal_atomic_fetch_add_32(&grdma_reg->ref_count, 1);
-    args->reg = grdma_reg;
-
-    if (0 == ref_cnt) {
-        mca_rcache_grdma_remove_from_lru(rcache_grdma, grdma_reg);
+    if (!mca_rcache_grdma_reg_get(grdma_reg)) {
+        /* being destroyed by another thread */
+        return 0;
     }
+    args->reg = grdma_reg;
 
     /* This segment fits fully within an existing segment. */
     (void) opal_atomic_fetch_add_32((opal_atomic_int32_t *) &rcache_grdma->stat_cache_hit, 1);
+    mca_rcache_grdma_stat_add(&mca_rcache_grdma_component.stats.hits, 1);
     OPAL_OUTPUT_VERBOSE((MCA_BASE_VERBOSE_TRACE, opal_rcache_base_framework.framework_output,
                          "returning existing registration %p. references %d", (void *) grdma_reg,
-                         ref_cnt));
+                         grdma_reg->ref_count));
     return 1;
 }
 
+static int mca_rcache_grdma_check_found(mca_rcache_base_registration_t *grdma_reg, void *ctx)
+{
+    mca_rcache_base_find_args_t *args = (mca_rcache_base_find_args_t *) ctx;
+
+    if (&args->rcache_grdma->super != grdma_reg->rcache
+        || !(mca_rcache_grdma_component.leave_pinned || (grdma_reg->flags & MCA_RCACHE_FLAGS_PERSIST)
+             || (grdma_reg->base == args->base && grdma_reg->bound == args->bound))) {
+        return 0;
+    }
+
+    if (!mca_rcache_grdma_reg_get(grdma_reg)) {
+        return 0;
+    }
+    args->reg = grdma_reg;
+
+    return 1;
+}
+
+/* Honor the pinned memory budget (if any) before registering size more bytes: release the
+ * stale registrations, then evict the least recently used ones. The check is not atomic with
+ * the registration, concurrent registrations can overshoot the budget by a little. */
+static bool mca_rcache_grdma_make_room(mca_rcache_grdma_module_t *rcache_grdma, size_t size)
+{
+    const size_t max_pinned = mca_rcache_grdma_component.max_pinned;
+
+    if (0 == max_pinned) {
+        return true;
+    }
+    if (size > max_pinned) {
+        return false;
+    }
+    while (mca_rcache_grdma_component.stats.bytes_pinned + size > max_pinned) {
+        if (0 == do_unregistration_gc(rcache_grdma->cache, 0)
+            && !mca_rcache_grdma_evict(&rcache_grdma->super)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 /*
  * register memory
  */
@@ -338,7 +518,7 @@ static int mca_rcache_grdma_register(mca_rcache_base_module_t *rcache, void *add
     }
 #endif /* OPAL_CUDA_GDR_SUPPORT */
 
-    do_unregistration_gc(rcache);
+    mca_rcache_grdma_check_gc(rcache_grdma->cache);
 
     /* look through existing regs if not persistent registration requested.
      * Persistent registration are always registered and placed in the cache */
@@ -360,6 +540,7 @@ static int mca_rcache_grdma_register(mca_rcache_base_module_t *rcache, void *add
         access_flags = find_args.access_flags;
 
         OPAL_THREAD_ADD_FETCH32((opal_atomic_int32_t *) &rcache_grdma->stat_cache_miss, 1);
+        mca_rcache_grdma_stat_add(&mca_rcache_grdma_component.stats.misses, 1);
     }
 
     item = opal_free_list_get_mt(&rcache_grdma->reg_list);
@@ -380,11 +561,17 @@ static int mca_rcache_grdma_register(mca_rcache_base_module_t *rcache, void *add
     }
 #endif /* OPAL_CUDA_GDR_SUPPORT */
 
-    while (OPAL_ERR_OUT_OF_RESOURCE
-           == (rc = rcache_grdma->resources.register_mem(rcache_grdma->resources.reg_data, base,
-                                                         bound - base + 1, grdma_reg))) {
-        /* try to remove one unused reg and retry */
-        if (!mca_rcache_grdma_evict(rcache)) {
+    if (OPAL_UNLIKELY(!mca_rcache_grdma_make_room(rcache_grdma, bound - base + 1))) {
+        OPAL_OUTPUT_VERBOSE((MCA_BASE_VERBOSE_INFO, opal_rcache_base_framework.framework_output,
+                             "cannot register {%p, %p}: the pinned memory budget is exhausted",
+                             (void *) base, (void *) bound));
+        opal_free_list_return_mt(&rcache_grdma->reg_list, item);
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    while (OPAL_ERR_OUT_OF_RESOURCE == (rc = mca_rcache_grdma_register_mem(rcache_grdma, grdma_reg))) {
+        /* release the stale registrations, or else one unused reg, and retry */
+        if (0 == do_unregistration_gc(rcache_grdma->cache, 0) && !mca_rcache_grdma_evict(rcache)) {
             break;
         }
     }
@@ -395,6 +582,11 @@ static int mca_rcache_grdma_register(mca_rcache_base_module_t *rcache, void *add
     }
 
     if (false == bypass_cache) {
+        /* cached registrations are in the LRU, in use or not, for their whole life */
+        if (registration_flags_cacheable(flags)) {
+            mca_rcache_grdma_add_to_lru(rcache_grdma, grdma_reg);
+        }
+
         /* Unless explicitly requested by the caller always store the
          * registration in the rcache. This will speed up the case where
          * no leave pinned protocol is in use but the same segment is in
@@ -402,7 +594,10 @@ static int mca_rcache_grdma_register(mca_rcache_base_module_t *rcache, void *add
          * here is !mca_rcache_grdma_component.leave_pinned. */
         rc = mca_rcache_base_vma_insert(rcache_grdma->cache->vma_module, grdma_reg, 0);
         if (OPAL_UNLIKELY(rc != OPAL_SUCCESS)) {
-            rcache_grdma->resources.deregister_mem(rcache_grdma->resources.reg_data, grdma_reg);
+            if (grdma_reg->flags & MCA_RCACHE_GRDMA_REG_FLAG_IN_LRU) {
+                mca_rcache_grdma_remove_from_lru(rcache_grdma, grdma_reg);
+            }
+            mca_rcache_grdma_deregister_mem(rcache_grdma, grdma_reg);
             opal_free_list_return_mt(&rcache_grdma->reg_list, item);
             return rc;
         }
@@ -422,31 +617,30 @@ static int mca_rcache_grdma_find(mca_rcache_base_module_t *rcache, void *addr, s
 {
     mca_rcache_grdma_module_t *rcache_grdma = (mca_rcache_grdma_module_t *) rcache;
     unsigned long page_size = opal_getpagesize();
-    unsigned char *base, *bound;
+    mca_rcache_base_find_args_t find_args = {.reg = NULL, .rcache_grdma = rcache_grdma};
     int rc;
 
-    base = OPAL_DOWN_ALIGN_PTR(addr, page_size, unsigned char *);
-    bound = OPAL_ALIGN_PTR((intptr_t) addr + size - 1, page_size, unsigned char *);
+    if (0 == size) {
+        return OPAL_ERROR;
+    }
 
-    opal_mutex_lock(&rcache_grdma->cache->vma_module->vma_lock);
+    find_args.base = OPAL_DOWN_ALIGN_PTR(addr, page_size, unsigned char *);
+    find_args.bound = OPAL_ALIGN_PTR((intptr_t) addr + size - 1, page_size, unsigned char *);
 
-    rc = mca_rcache_base_vma_find(rcache_grdma->cache->vma_module, base, bound - base + 1, reg);
-    if (NULL != *reg
-        && (mca_rcache_grdma_component.leave_pinned || ((*reg)->flags & MCA_RCACHE_FLAGS_PERSIST)
-            || ((*reg)->base == base && (*reg)->bound == bound))) {
+    /* the tree supports concurrent readers, only the reference needs care */
+    rc = mca_rcache_base_vma_iterate(rcache_grdma->cache->vma_module, find_args.base,
+                                     find_args.bound - find_args.base + 1, true,
+                                     mca_rcache_grdma_check_found, (void *) &find_args);
+    *reg = find_args.reg;
+    if (NULL != *reg) {
         assert(((void *) (*reg)->bound) >= addr);
-        if (0 == (*reg)->ref_count && mca_rcache_grdma_component.leave_pinned) {
-            opal_list_remove_item(&rcache_grdma->cache->lru_list, (opal_list_item_t *) (*reg));
-        }
-        rcache_grdma->stat_cache_found++;
-        opal_atomic_add_fetch_32(&(*reg)->ref_count, 1);
+        (void) opal_atomic_fetch_add_32((opal_atomic_int32_t *) &rcache_grdma->stat_cache_found, 1);
     } else {
-        rcache_grdma->stat_cache_notfound++;
+        (void) opal_atomic_fetch_add_32((opal_atomic_int32_t *) &rcache_grdma->stat_cache_notfound,
+                                        1);
     }
 
-    opal_mutex_unlock(&rcache_grdma->cache->vma_module->vma_lock);
-
-    return rc;
+    return (1 == rc || OPAL_SUCCESS == rc) ? OPAL_SUCCESS : rc;
 }
 
 static int mca_rcache_grdma_deregister(mca_rcache_base_module_t *rcache,
@@ -467,7 +661,17 @@ static int mca_rcache_grdma_deregister(mca_rcache_base_module_t *rcache,
     }
 
     if (registration_is_cacheable(reg)) {
-        mca_rcache_grdma_add_to_lru(rcache_grdma, reg);
+        /* still in the LRU, only mark it as recently used */
+        opal_atomic_fetch_or_32((opal_atomic_int32_t *) &reg->flags,
+                                MCA_RCACHE_GRDMA_REG_FLAG_RECENT);
+        if (!(reg->flags & MCA_RCACHE_FLAGS_INVALID)) {
+            return OPAL_SUCCESS;
+        }
+        /* invalidated while we held the reference, we have to destroy it */
+    }
+
+    if (!mca_rcache_grdma_reg_claim(reg)) {
+        /* another thread took a reference, or is already destroying it */
         return OPAL_SUCCESS;
     }
 
@@ -486,18 +690,20 @@ static int mca_rcache_grdma_add_to_gc(mca_rcache_base_registration_t *grdma_reg)
     uint32_t flags = opal_atomic_fetch_or_32((opal_atomic_int32_t *) &grdma_reg->flags,
                                              MCA_RCACHE_FLAGS_INVALID);
 
-    if ((flags & MCA_RCACHE_FLAGS_INVALID) || 0 != grdma_reg->ref_count) {
-        /* nothing to do */
+    if ((flags & MCA_RCACHE_FLAGS_INVALID) || !mca_rcache_grdma_reg_claim(grdma_reg)) {
+        /* nothing to do, the last reference will destroy it */
         return OPAL_SUCCESS;
     }
 
     /* This may be called from free() so avoid recursively calling into free by just
      * shifting this registration into the garbage collection list. The cleanup will
-     * be done on the next registration attempt. */
-    if (registration_flags_cacheable(flags)) {
+     * be done in batches from the progress engine, or on the next registration attempt. */
+    if (flags & MCA_RCACHE_GRDMA_REG_FLAG_IN_LRU) {
         mca_rcache_grdma_remove_from_lru(rcache_grdma, grdma_reg);
     }
 
+    (void) opal_atomic_add_fetch_size_t(&rcache_grdma->cache->gc_pending,
+                                        grdma_reg->bound - grdma_reg->base + 1);
     opal_lifo_push_atomic(&rcache_grdma->cache->gc_lifo, (opal_list_item_t *) grdma_reg);
 
     return OPAL_SUCCESS;
@@ -512,7 +718,7 @@ static int gc_add(mca_rcache_base_registration_t *grdma_reg, void *ctx)
         return OPAL_SUCCESS;
     }
 
-    if (grdma_reg->ref_count && grdma_reg->base == args->base) {
+    if (grdma_reg->ref_count > 0 && grdma_reg->base == args->base) {
         /* attempted to remove an active registration. to handle cases where part of
          * an active registration has been unmapped we check if the bases match. this
          * *hopefully* will suppress erroneously emitted errors. if we can't suppress
@@ -578,11 +784,11 @@ static void mca_rcache_grdma_finalize(mca_rcache_base_module_t *rcache)
                     (long) mca_rcache_base_vma_size(rcache_grdma->cache->vma_module));
     }
 
-    do_unregistration_gc(&rcache_grdma->super);
+    do_unregistration_gc(rcache_grdma->cache, 0);
 
     (void) mca_rcache_base_vma_iterate(rcache_grdma->cache->vma_module, NULL, (size_t) -1, true,
                                        gc_add, (void *) rcache);
-    do_unregistration_gc(rcache);
+    do_unregistration_gc(rcache_grdma->cache, 0);
 
     OBJ_RELEASE(rcache_grdma->cache);
 
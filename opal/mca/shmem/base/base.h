@@ -2,7 +2,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2006 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -131,6 +131,45 @@ OPAL_DECLSPEC extern char *opal_shmem_base_RUNTIME_QUERY_hint;
  */
 OPAL_DECLSPEC extern mca_base_framework_t opal_shmem_base_framework;
 
+/* ////////////////////////////////////////////////////////////////////////// */
+/* Node-wide arena */
+/* ////////////////////////////////////////////////////////////////////////// */
+
+/**
+ * Size of the node-wide arena (0 disables it). When enabled, the segments
+ * are carved from a single file shared by all the processes of the job on
+ * the node, instead of one backing file each. The file is sparse, only the
+ * pages that are touched use memory.
+ */
+OPAL_DECLSPEC extern size_t opal_shmem_base_arena_size;
+
+/**
+ * Directory of the arena file
+ */
+OPAL_DECLSPEC extern char *opal_shmem_base_arena_directory;
+
+/**
+ * Carve a segment of the given size from the arena of this job, creating
+ * or attaching it on first use.
+ *
+ * @retval OPAL_SUCCESS the segment is carved, ds_buf is valid
+ * @retval OPAL_ERR_NOT_AVAILABLE the arena is disabled or full, the
+ *         segment must be created by the module
+ * @retval OPAL_ERROR the arena could not be created or attached
+ */
+int opal_shmem_base_arena_segment_create(opal_shmem_ds_t *ds_buf, size_t size);
+
+/**
+ * Attach the arena segment ds_buf (created by any process of the node),
+ * mapping its arena first if needed.
+ */
+void *opal_shmem_base_arena_segment_attach(opal_shmem_ds_t *ds_buf);
+
+/**
+ * Unmap the arenas. The segments carved from them are gone.
+ */
+void opal_shmem_base_arena_finalize(void);
+
 END_C_DECLS
 
 #endif /* OPAL_BASE_SHMEM_H */
@@ -0,0 +1,324 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Node-wide shared memory arena. The first process of the job on the node
+ * that needs a segment creates a single sparse backing file, the others
+ * attach it, and every segment is carved from it with a bump allocator
+ * kept in the arena header. Thousands of backing files (and as many
+ * open/ftruncate/mmap at startup) become one file and one mapping per
+ * process.
+ *
+ * The arena is initialized under a temporary name and published with
+ * link(2), which fails if another process published first: whoever opens
+ * the final name sees an initialized arena, there is nothing to wait for.
+ *
+ * The space of the segments is not reused: detach and unlink are no-ops on
+ * an arena segment, the memory is released with the arena at the end of
+ * the job. When the arena is full, the segments fall back to the module.
+ */
+
+#include "opal_config.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+
+#include "opal/align.h"
+#include "opal/class/opal_list.h"
+#include "opal/constants.h"
+#include "opal/mca/pmix/pmix-internal.h"
+#include "opal/mca/shmem/base/base.h"
+#include "opal/mca/shmem/shmem.h"
+#include "opal/mca/threads/mutex.h"
+#include "opal/sys/atomic.h"
+#include "opal/util/output.h"
+#include "opal/util/printf.h"
+#include "opal/util/proc.h"
+#include "opal/util/string_copy.h"
+#include "opal/util/sys_limits.h"
+
+#define OPAL_SHMEM_ARENA_MAGIC 0x4f504153484d4131ull /* "OPASHMA1" */
+
+/* segments of at least this size start on a (huge page) boundary of this
+ * size, a file offset aligned on a huge page can be mapped by one */
+#define OPAL_SHMEM_ARENA_LARGE_ALIGN (2 * 1024 * 1024)
+
+/* at the start of the arena, in shared memory */
+typedef struct {
+    uint64_t magic;
+    uint64_t size;
+    opal_atomic_int64_t next; /**< offset of the first free byte */
+} opal_shmem_base_arena_hdr_t;
+
+/* an arena mapped by this process */
+typedef struct {
+    opal_list_item_t super;
+    char *path;
+    opal_shmem_base_arena_hdr_t *hdr;
+    size_t size;
+} opal_shmem_base_arena_t;
+
+static void arena_construct(opal_shmem_base_arena_t *arena)
+{
+    arena->path = NULL;
+    arena->hdr = NULL;
+    arena->size = 0;
+}
+
+static void arena_destruct(opal_shmem_base_arena_t *arena)
+{
+    if (NULL != arena->hdr) {
+        (void) munmap((void *) arena->hdr, arena->size);
+    }
+    free(arena->path);
+}
+
+static OBJ_CLASS_INSTANCE(opal_shmem_base_arena_t, opal_list_item_t, arena_construct,
+                          arena_destruct);
+
+/* protects everything below */
+static opal_mutex_t arena_lock = OPAL_MUTEX_STATIC_INIT;
+/* the mapped arenas (the one of this job and those of the other jobs we
+ * attached segments from) */
+static opal_list_t arena_list;
+static bool arena_list_initialized = false;
+/* the arena of this job, NULL until the first segment */
+static opal_shmem_base_arena_t *my_arena = NULL;
+/* the arena of this job could not be created, don't try again */
+static bool my_arena_failed = false;
+
+/* map the arena at path, NULL on failure */
+static opal_shmem_base_arena_t *arena_open(const char *path)
+{
+    opal_shmem_base_arena_t *arena;
+    struct stat st;
+    void *base;
+    int fd;
+
+    if (-1 == (fd = open(path, O_RDWR))) {
+        opal_output_verbose(10, opal_shmem_base_framework.framework_output,
+                            "shmem: base: cannot open the arena %s: %s", path, strerror(errno));
+        return NULL;
+    }
+    if ((0 != fstat(fd, &st))
+        || ((size_t) st.st_size < sizeof(opal_shmem_base_arena_hdr_t))
+        || (MAP_FAILED
+            == (base = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)))) {
+        opal_output_verbose(10, opal_shmem_base_framework.framework_output,
+                            "shmem: base: cannot map the arena %s: %s", path, strerror(errno));
+        close(fd);
+        return NULL;
+    }
+    close(fd);
+
+    if ((OPAL_SHMEM_ARENA_MAGIC != ((opal_shmem_base_arena_hdr_t *) base)->magic)
+        || ((size_t) st.st_size != ((opal_shmem_base_arena_hdr_t *) base)->size)) {
+        opal_output_verbose(10, opal_shmem_base_framework.framework_output,
+                            "shmem: base: %s is not an arena", path);
+        munmap(base, st.st_size);
+        return NULL;
+    }
+
+    arena = OBJ_NEW(opal_shmem_base_arena_t);
+    if (NULL == arena || NULL == (arena->path = strdup(path))) {
+        munmap(base, st.st_size);
+        if (NULL != arena) {
+            OBJ_RELEASE(arena);
+        }
+        return NULL;
+    }
+    arena->hdr = (opal_shmem_base_arena_hdr_t *) base;
+    arena->size = st.st_size;
+    opal_list_append(&arena_list, &arena->super);
+
+    return arena;
+}
+
+/* create and publish the arena at path, or attach it if another process
+ * published it first */
+static opal_shmem_base_arena_t *arena_create(const char *path)
+{
+    const size_t size = OPAL_ALIGN(opal_shmem_base_arena_size, OPAL_SHMEM_ARENA_LARGE_ALIGN,
+                                   size_t);
+    opal_shmem_base_arena_hdr_t *hdr = MAP_FAILED;
+    char *tmp_path = NULL;
+    int fd = -1, rc;
+
+    if (0 > opal_asprintf(&tmp_path, "%s.%d", path, (int) getpid())) {
+        return NULL;
+    }
+    if ((-1 == (fd = open(tmp_path, O_CREAT | O_EXCL | O_RDWR, 0600)))
+        || (0 != ftruncate(fd, size))
+        || (MAP_FAILED
+            == (hdr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)))) {
+        opal_output_verbose(10, opal_shmem_base_framework.framework_output,
+                            "shmem: base: cannot create the arena %s: %s", tmp_path,
+                            strerror(errno));
+        goto out;
+    }
+
+    hdr->size = size;
+    hdr->next = opal_getpagesize();
+    hdr->magic = OPAL_SHMEM_ARENA_MAGIC;
+
+    /* the file is complete, publish it */
+    rc = link(tmp_path, path);
+    if (0 == rc) {
+        opal_pmix_register_cleanup((char *) path, false, false, false);
+        opal_output_verbose(10, opal_shmem_base_framework.framework_output,
+                            "shmem: base: created the arena %s (%lu bytes)", path,
+                            (unsigned long) size);
+    } else if (EEXIST != errno) {
+        opal_output_verbose(10, opal_shmem_base_framework.framework_output,
+                            "shmem: base: cannot publish the arena %s: %s", path,
+                            strerror(errno));
+    }
+
+out:
+    if (MAP_FAILED != hdr) {
+        munmap((void *) hdr, size);
+    }
+    if (-1 != fd) {
+        close(fd);
+        unlink(tmp_path);
+    }
+    free(tmp_path);
+
+    /* ours or not, the published arena is mapped the same way */
+    return arena_open(path);
+}
+
+static opal_shmem_base_arena_t *arena_lookup(const char *path)
+{
+    opal_shmem_base_arena_t *arena;
+
+    if (!arena_list_initialized) {
+        OBJ_CONSTRUCT(&arena_list, opal_list_t);
+        arena_list_initialized = true;
+    }
+    OPAL_LIST_FOREACH (arena, &arena_list, opal_shmem_base_arena_t) {
+        if (0 == strcmp(arena->path, path)) {
+            return arena;
+        }
+    }
+    return NULL;
+}
+
+static opal_shmem_base_arena_t *arena_get_mine(void)
+{
+    const char *dir = (NULL != opal_shmem_base_arena_directory) ? opal_shmem_base_arena_directory
+                                                                : opal_process_info.job_session_dir;
+    char *path;
+
+    if (NULL != my_arena || my_arena_failed) {
+        return my_arena;
+    }
+
+    if ((NULL == dir)
+        || (0 > opal_asprintf(&path, "%s" OPAL_PATH_SEP "shmem_arena.%s.%u.%x", dir,
+                              opal_process_info.nodename, (unsigned int) geteuid(),
+                              OPAL_PROC_MY_NAME.jobid))) {
+        my_arena_failed = true;
+        return NULL;
+    }
+    if (NULL == (my_arena = arena_lookup(path))) {
+        my_arena = arena_create(path);
+    }
+    free(path);
+    my_arena_failed = (NULL == my_arena);
+
+    return my_arena;
+}
+
+int opal_shmem_base_arena_segment_create(opal_shmem_ds_t *ds_buf, size_t size)
+{
+    const int64_t align = (size >= OPAL_SHMEM_ARENA_LARGE_ALIGN) ? OPAL_SHMEM_ARENA_LARGE_ALIGN
+                                                                 : opal_getpagesize();
+    opal_shmem_base_arena_t *arena;
+    int64_t start, next;
+
+    if ((0 == opal_shmem_base_arena_size) || (0 == size)) {
+        return OPAL_ERR_NOT_AVAILABLE;
+    }
+
+    opal_mutex_lock(&arena_lock);
+    arena = arena_get_mine();
+    opal_mutex_unlock(&arena_lock);
+    if (NULL == arena) {
+        return OPAL_ERR_NOT_AVAILABLE;
+    }
+
+    /* the other processes of the node allocate concurrently */
+    next = arena->hdr->next;
+    do {
+        start = OPAL_ALIGN(next, align, int64_t);
+        if ((uint64_t) (start + size) > arena->hdr->size) {
+            opal_output_verbose(10, opal_shmem_base_framework.framework_output,
+                                "shmem: base: the arena %s is full, %lu bytes requested",
+                                arena->path, (unsigned long) size);
+            return OPAL_ERR_NOT_AVAILABLE;
+        }
+    } while (!opal_atomic_compare_exchange_strong_64(&arena->hdr->next, &next,
+                                                     start + (int64_t) size));
+
+    ds_buf->seg_cpid = getpid();
+    OPAL_SHMEM_DS_RESET_FLAGS(ds_buf);
+    ds_buf->seg_id = OPAL_SHMEM_DS_ID_INVALID;
+    ds_buf->seg_size = size;
+    ds_buf->seg_offset = (size_t) start;
+    ds_buf->seg_base_addr = (char *) arena->hdr + start;
+    (void) opal_string_copy(ds_buf->seg_name, arena->path, OPAL_PATH_MAX);
+    OPAL_SHMEM_DS_SET_VALID(ds_buf);
+    ds_buf->flags |= OPAL_SHMEM_DS_FLAGS_ARENA;
+
+    OPAL_OUTPUT_VERBOSE((70, opal_shmem_base_framework.framework_output,
+                         "shmem: base: carved %lu bytes at offset %lu of the arena %s",
+                         (unsigned long) size, (unsigned long) start, arena->path));
+
+    return OPAL_SUCCESS;
+}
+
+void *opal_shmem_base_arena_segment_attach(opal_shmem_ds_t *ds_buf)
+{
+    opal_shmem_base_arena_t *arena;
+
+    opal_mutex_lock(&arena_lock);
+    if (NULL == (arena = arena_lookup(ds_buf->seg_name))) {
+        arena = arena_open(ds_buf->seg_name);
+    }
+    opal_mutex_unlock(&arena_lock);
+
+    if ((NULL == arena) || ((ds_buf->seg_offset + ds_buf->seg_size) > arena->size)) {
+        return NULL;
+    }
+    ds_buf->seg_base_addr = (char *) arena->hdr + ds_buf->seg_offset;
+
+    return ds_buf->seg_base_addr;
+}
+
+void opal_shmem_base_arena_finalize(void)
+{
+    opal_mutex_lock(&arena_lock);
+    if (arena_list_initialized) {
+        OPAL_LIST_DESTRUCT(&arena_list);
+        arena_list_initialized = false;
+    }
+    my_arena = NULL;
+    my_arena_failed = false;
+    opal_mutex_unlock(&arena_lock);
+}
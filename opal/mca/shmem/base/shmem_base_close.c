@@ -35,6 +35,7 @@ int opal_shmem_base_close(void)
     if (NULL != opal_shmem_base_module && NULL != opal_shmem_base_module->module_finalize) {
         opal_shmem_base_module->module_finalize();
     }
+    opal_shmem_base_arena_finalize();
 
     opal_shmem_base_selected = false;
     opal_shmem_base_component = NULL;
@@ -2,7 +2,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2005 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -40,6 +40,8 @@
  * globals
  */
 char *opal_shmem_base_RUNTIME_QUERY_hint = NULL;
+size_t opal_shmem_base_arena_size = 0;
+char *opal_shmem_base_arena_directory = NULL;
 
 /* ////////////////////////////////////////////////////////////////////////// */
 /**
@@ -64,6 +66,33 @@ static int opal_shmem_base_register(mca_base_register_flag_t flags)
                                           MCA_BASE_VAR_FLAG_INTERNAL, OPAL_INFO_LVL_9,
                                           MCA_BASE_VAR_SCOPE_ALL,
                                           &opal_shmem_base_RUNTIME_QUERY_hint);
+    if (0 > ret) {
+        return ret;
+    }
+
+    opal_shmem_base_arena_size = 0;
+    ret = mca_base_framework_var_register(&opal_shmem_base_framework, "arena_size",
+                                          "Size in bytes of the node-wide shared memory arena "
+                                          "(0 disables it). When enabled, the shared memory "
+                                          "segments of all the components are carved from a "
+                                          "single sparse backing file per job and node instead "
+                                          "of one file per segment. The space of the released "
+                                          "segments is not reused, the segments are created in "
+                                          "their own file when the arena is full. Must be the "
+                                          "same on all the processes of the node (default: 0)",
+                                          MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                          MCA_BASE_VAR_SCOPE_LOCAL, &opal_shmem_base_arena_size);
+    if (0 > ret) {
+        return ret;
+    }
+
+    opal_shmem_base_arena_directory = NULL;
+    ret = mca_base_framework_var_register(&opal_shmem_base_framework, "arena_directory",
+                                          "Directory of the node-wide shared memory arena "
+                                          "(default: the job session directory)",
+                                          MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                          MCA_BASE_VAR_SCOPE_LOCAL,
+                                          &opal_shmem_base_arena_directory);
 
     return (0 > ret) ? ret : OPAL_SUCCESS;
 }
@@ -2,7 +2,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2006 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -21,6 +21,8 @@
 
 #include "opal_config.h"
 
+#include <string.h>
+
 #include "opal/constants.h"
 #include "opal/mca/shmem/base/base.h"
 #include "opal/mca/shmem/shmem.h"
@@ -32,6 +34,11 @@ int opal_shmem_segment_create(opal_shmem_ds_t *ds_buf, const char *file_name, si
         return OPAL_ERROR;
     }
 
+    /* carve it from the node-wide arena when there is one */
+    if (OPAL_SUCCESS == opal_shmem_base_arena_segment_create(ds_buf, size)) {
+        return OPAL_SUCCESS;
+    }
+
     return opal_shmem_base_module->segment_create(ds_buf, file_name, size);
 }
 
@@ -42,6 +49,11 @@ int opal_shmem_ds_copy(const opal_shmem_ds_t *from, opal_shmem_ds_t *to)
         return OPAL_ERROR;
     }
 
+    if (OPAL_SHMEM_DS_IS_ARENA(from)) {
+        memcpy(to, from, sizeof(opal_shmem_ds_t));
+        return OPAL_SUCCESS;
+    }
+
     return opal_shmem_base_module->ds_copy(from, to);
 }
 
@@ -52,6 +64,10 @@ void *opal_shmem_segment_attach(opal_shmem_ds_t *ds_buf)
         return NULL;
     }
 
+    if (OPAL_SHMEM_DS_IS_ARENA(ds_buf)) {
+        return opal_shmem_base_arena_segment_attach(ds_buf);
+    }
+
     return opal_shmem_base_module->segment_attach(ds_buf);
 }
 
@@ -62,6 +78,13 @@ int opal_shmem_segment_detach(opal_shmem_ds_t *ds_buf)
         return OPAL_ERROR;
     }
 
+    if (OPAL_SHMEM_DS_IS_ARENA(ds_buf)) {
+        /* the arena stays mapped until the framework is closed */
+        memset(ds_buf, 0, sizeof(opal_shmem_ds_t));
+        ds_buf->seg_id = OPAL_SHMEM_DS_ID_INVALID;
+        return OPAL_SUCCESS;
+    }
+
     return opal_shmem_base_module->segment_detach(ds_buf);
 }
 
@@ -72,5 +95,12 @@ int opal_shmem_unlink(opal_shmem_ds_t *ds_buf)
         return OPAL_ERROR;
     }
 
+    if (OPAL_SHMEM_DS_IS_ARENA(ds_buf)) {
+        /* the backing file is the arena, it is removed at the end of the job */
+        ds_buf->seg_id = OPAL_SHMEM_DS_ID_INVALID;
+        OPAL_SHMEM_DS_INVALIDATE(ds_buf);
+        return OPAL_SUCCESS;
+    }
+
     return opal_shmem_base_module->unlink(ds_buf);
 }
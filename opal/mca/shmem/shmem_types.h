@@ -2,7 +2,7 @@
  * Copyright (c) 2004-2008 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2005 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -49,6 +49,12 @@ BEGIN_C_DECLS
  */
 #define OPAL_SHMEM_DS_FLAGS_VALID 0x01
 
+/**
+ * flag indicating that the segment is carved from the node-wide arena
+ * named seg_name, at seg_offset
+ */
+#define OPAL_SHMEM_DS_FLAGS_ARENA 0x02
+
 /**
  * 0x1* - reserved for internal flags. that is, flags that will NOT be
  * propagated via ds_copy during inter-process information sharing.
@@ -94,6 +100,11 @@ BEGIN_C_DECLS
  */
 #define OPAL_SHMEM_DS_IS_VALID(ds_buf) ((ds_buf)->flags & OPAL_SHMEM_DS_FLAGS_VALID)
 
+/**
+ * evaluates to 1 if the segment is carved from the node-wide arena
+ */
+#define OPAL_SHMEM_DS_IS_ARENA(ds_buf) ((ds_buf)->flags & OPAL_SHMEM_DS_FLAGS_ARENA)
+
 typedef uint8_t opal_shmem_ds_flag_t;
 
 struct opal_shmem_ds_t {
@@ -107,6 +118,8 @@ struct opal_shmem_ds_t {
     size_t seg_size;
     /* base address of shared memory segment */
     void *seg_base_addr;
+    /* offset of the segment in the arena (OPAL_SHMEM_DS_FLAGS_ARENA only) */
+    size_t seg_offset;
     /* path to backing store -- last element so we can easily calculate the
      * "real" size of opal_shmem_ds_t. that is, the amount of the struct that
      * is actually being used. for example: if seg_name is something like:
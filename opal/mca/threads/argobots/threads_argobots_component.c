@@ -28,7 +28,9 @@
 #include "opal/mca/threads/thread.h"
 #include "opal/mca/threads/threads.h"
 
+static int opal_threads_argobots_register(void);
 static int opal_threads_argobots_open(void);
+static int opal_threads_argobots_close(void);
 
 const opal_threads_base_component_1_0_0_t mca_threads_argobots_component = {
     /* First, the mca_component_t struct containing meta information
@@ -43,14 +45,36 @@ const opal_threads_base_component_1_0_0_t mca_threads_argobots_component = {
                                   OPAL_RELEASE_VERSION),
 
             .mca_open_component = opal_threads_argobots_open,
+            .mca_close_component = opal_threads_argobots_close,
+            .mca_register_component_params = opal_threads_argobots_register,
         },
     .threadsc_data =
         {/* The component is checkpoint ready */
          MCA_BASE_METADATA_PARAM_CHECKPOINT},
 };
 
+static int opal_threads_argobots_register(void)
+{
+    (void) mca_base_component_var_register(&mca_threads_argobots_component.threadsc_version,
+                                           "progress_xstream",
+                                           "Rank of the execution stream running a thread "
+                                           "dedicated to the progress. The threads waiting for "
+                                           "their requests then suspend instead of progressing "
+                                           "(-1: the waiting threads progress themselves)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &opal_threads_argobots_progress_xstream);
+    return OPAL_SUCCESS;
+}
+
 int opal_threads_argobots_open(void)
 {
     opal_threads_argobots_ensure_init();
     return OPAL_SUCCESS;
 }
+
+static int opal_threads_argobots_close(void)
+{
+    opal_threads_argobots_progress_finalize();
+    return OPAL_SUCCESS;
+}
@@ -29,7 +29,10 @@
 #include "opal/mca/threads/argobots/threads_argobots.h"
 #include "opal/mca/threads/threads.h"
 #include "opal/mca/threads/tsd.h"
+#include "opal/mca/threads/wait_sync.h"
 #include "opal/prefetch.h"
+#include "opal/runtime/opal_progress.h"
+#include "opal/sys/atomic.h"
 #include "opal/util/output.h"
 #include "opal/util/sys_limits.h"
 
@@ -103,6 +106,76 @@ int opal_thread_start(opal_thread_t *t)
     return (ABT_SUCCESS == rc) ? OPAL_SUCCESS : OPAL_ERROR;
 }
 
+/*
+ * Progress thread: it progresses as long as some thread waits for a sync, and
+ * yields to the other threads of its execution stream in between.
+ */
+enum {
+    OPAL_ARGOBOTS_PROGRESS_UNAVAILABLE = -1,
+    OPAL_ARGOBOTS_PROGRESS_NONE = 0,
+    OPAL_ARGOBOTS_PROGRESS_STARTING,
+    OPAL_ARGOBOTS_PROGRESS_RUNNING,
+};
+
+int opal_threads_argobots_progress_xstream = -1;
+static opal_atomic_int32_t progress_state = OPAL_ARGOBOTS_PROGRESS_NONE;
+static volatile bool progress_stop = false;
+static ABT_thread progress_thread = ABT_THREAD_NULL;
+
+static void opal_threads_argobots_progress(void *arg)
+{
+    while (!progress_stop) {
+        if (NULL != wait_sync_list) {
+            opal_progress();
+        }
+        ABT_thread_yield();
+    }
+}
+
+bool opal_thread_progress_delegated(void)
+{
+    int32_t state = progress_state;
+    ABT_xstream xstream;
+
+    if (OPAL_LIKELY(OPAL_ARGOBOTS_PROGRESS_RUNNING == state
+                    || OPAL_ARGOBOTS_PROGRESS_UNAVAILABLE == state)) {
+        return OPAL_ARGOBOTS_PROGRESS_RUNNING == state;
+    }
+    /* The first waiter starts the progress thread */
+    if (OPAL_ARGOBOTS_PROGRESS_NONE == state
+        && opal_atomic_compare_exchange_strong_32(&progress_state, &state,
+                                                  OPAL_ARGOBOTS_PROGRESS_STARTING)) {
+        state = OPAL_ARGOBOTS_PROGRESS_UNAVAILABLE;
+        if (opal_threads_argobots_progress_xstream >= 0
+            && ABT_SUCCESS == ABT_xstream_get_by_rank(opal_threads_argobots_progress_xstream,
+                                                      &xstream)
+            && ABT_SUCCESS == ABT_thread_create_on_xstream(xstream,
+                                                           opal_threads_argobots_progress, NULL,
+                                                           ABT_THREAD_ATTR_NULL,
+                                                           &progress_thread)) {
+            state = OPAL_ARGOBOTS_PROGRESS_RUNNING;
+        }
+        opal_atomic_wmb();
+        progress_state = state;
+        return OPAL_ARGOBOTS_PROGRESS_RUNNING == state;
+    }
+    while (OPAL_ARGOBOTS_PROGRESS_STARTING == progress_state) {
+        ABT_thread_yield();
+    }
+    return OPAL_ARGOBOTS_PROGRESS_RUNNING == progress_state;
+}
+
+void opal_threads_argobots_progress_finalize(void)
+{
+    if (OPAL_ARGOBOTS_PROGRESS_RUNNING == progress_state) {
+        progress_stop = true;
+        /* waits for the termination of the thread */
+        ABT_thread_free(&progress_thread);
+        progress_stop = false;
+    }
+    progress_state = OPAL_ARGOBOTS_PROGRESS_NONE;
+}
+
 OBJ_CLASS_DECLARATION(opal_thread_t);
 
 int opal_tsd_key_create(opal_tsd_key_t *key, opal_tsd_destructor_t destructor)
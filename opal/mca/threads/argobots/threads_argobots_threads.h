@@ -45,4 +45,14 @@ static inline void opal_thread_yield(void)
     ABT_thread_yield();
 }
 
+/* Argobots are user-level threads, a waiting thread must not block the
+ * execution stream it runs on */
+#define OPAL_THREAD_USER_LEVEL 1
+
+/* The progress can be driven by a thread of its own, on the execution stream
+ * designated by threads_argobots_progress_xstream. Returns true when this
+ * thread runs, the threads waiting for their requests can then just suspend. */
+#define OPAL_THREAD_HAVE_PROGRESS_THREAD 1
+OPAL_DECLSPEC bool opal_thread_progress_delegated(void);
+
 #endif /* OPAL_MCA_THREADS_ARGOBOTS_THREADS_ARGOBOTS_THREADS_H */
@@ -16,7 +16,21 @@
  * $HEADER$
  */
 
+#include "opal_config.h"
+
+#include <time.h>
+#if defined(HAVE_LINUX_FUTEX_H) && defined(HAVE_SYS_SYSCALL_H)
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#    if defined(SYS_futex)
+#        define WAIT_SYNC_HAVE_FUTEX 1
+#    endif
+#endif
+
 #include "opal/mca/threads/wait_sync.h"
+#include "opal/mca/timer/base/base.h"
+#include "opal/util/minmax.h"
 
 static opal_mutex_t wait_sync_lock = OPAL_MUTEX_STATIC_INIT;
 ompi_wait_sync_t *wait_sync_list = NULL; /* not static for inline "wait_sync_st" */
@@ -56,6 +70,86 @@ static opal_atomic_int32_t num_thread_in_progress = 0;
         opal_thread_internal_mutex_unlock(&(who)->lock);     \
     } while (0)
 
+/* Average (1/8 weight) of the duration of the recent adaptive waits, in usec.
+ * Updated without atomics, a lost update only slows down the adaptation. */
+static volatile opal_timer_t wait_sync_latency = 0;
+
+/* Sleep on the count of the sync until a completion changes it or the sleep
+ * timeout expires. Without futexes the thread only naps for the timeout. */
+static void wait_sync_sleep(ompi_wait_sync_t *sync, int32_t count)
+{
+#if defined(OPAL_THREAD_USER_LEVEL)
+    /* Sleeping would block all the threads of the execution stream, let them
+     * run instead */
+    (void) sync;
+    (void) count;
+    opal_thread_yield();
+#else
+    struct timespec timeout = {.tv_sec = opal_wait_sync_sleep_usec / 1000000,
+                               .tv_nsec = (opal_wait_sync_sleep_usec % 1000000) * 1000};
+#    if WAIT_SYNC_HAVE_FUTEX
+    (void) syscall(SYS_futex, (int32_t *) &sync->count, FUTEX_WAIT_PRIVATE, count, &timeout,
+                   NULL, 0);
+#    else
+    (void) sync;
+    (void) count;
+    (void) nanosleep(&timeout, NULL);
+#    endif
+#endif /* OPAL_THREAD_USER_LEVEL */
+}
+
+void wait_sync_wake_sleeper(ompi_wait_sync_t *sync)
+{
+#if WAIT_SYNC_HAVE_FUTEX && !defined(OPAL_THREAD_USER_LEVEL)
+    (void) syscall(SYS_futex, (int32_t *) &sync->count, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+    (void) sync;
+#endif
+}
+
+/* When the completions usually arrive within the spin window, spin twice as
+ * long as they take to catch them without a wakeup. When they do not, the
+ * spinning is wasted: go to sleep quickly.
+ */
+static inline opal_timer_t wait_sync_spin_budget(void)
+{
+    opal_timer_t latency = wait_sync_latency;
+
+    if (latency > (opal_timer_t) opal_wait_sync_spin_max) {
+        return (opal_timer_t) opal_wait_sync_spin_min;
+    }
+    return opal_min(opal_max(2 * latency, (opal_timer_t) opal_wait_sync_spin_min),
+                    (opal_timer_t) opal_wait_sync_spin_max);
+}
+
+/* Progress until the sync completes, going to sleep when nothing happens for
+ * the spin budget. The completion (wait_sync_update from any thread, including
+ * the TCP or the asynchronous progress threads) wakes this thread directly,
+ * otherwise it wakes up after opal_wait_sync_sleep_usec and polls again.
+ */
+static void wait_sync_progress_adaptive(ompi_wait_sync_t *sync)
+{
+    opal_timer_t start = opal_timer_base_get_usec(), deadline;
+    int32_t count;
+
+    deadline = start + wait_sync_spin_budget();
+    while (sync->count > 0) {
+        opal_progress();
+        if (opal_timer_base_get_usec() < deadline) {
+            continue;
+        }
+        sync->sleeping = 1;
+        opal_atomic_mb();
+        if ((count = sync->count) > 0) {
+            wait_sync_sleep(sync, count);
+        }
+        sync->sleeping = 0;
+        /* poll a little after each wakeup before sleeping again */
+        deadline = opal_timer_base_get_usec() + (opal_timer_t) opal_wait_sync_spin_min;
+    }
+    wait_sync_latency = (7 * wait_sync_latency + (opal_timer_base_get_usec() - start)) / 8;
+}
+
 int ompi_sync_wait_mt(ompi_wait_sync_t *sync)
 {
     /* Don't stop if the waiting synchronization is completed. We avoid the
@@ -66,6 +160,14 @@ int ompi_sync_wait_mt(ompi_wait_sync_t *sync)
         return (0 == sync->status) ? OPAL_SUCCESS : OPAL_ERROR;
     }
 
+#if defined(OPAL_THREAD_HAVE_PROGRESS_THREAD)
+    /* A thread of its own drives the progress, just suspend until the
+     * completion. Checked before locking, it may have to start the thread. */
+    bool delegated = opal_thread_progress_delegated();
+#else
+    const bool delegated = false;
+#endif
+
     /* lock so nobody can signal us during the list updating */
     opal_thread_internal_mutex_lock(&sync->lock);
 
@@ -97,7 +199,8 @@ int ompi_sync_wait_mt(ompi_wait_sync_t *sync)
      *  - our sync has been triggered.
      */
 check_status:
-    if (sync != wait_sync_list && num_thread_in_progress >= opal_max_thread_in_progress) {
+    if (delegated
+        || (sync != wait_sync_list && num_thread_in_progress >= opal_max_thread_in_progress)) {
         opal_thread_internal_cond_wait(&sync->condition, &sync->lock);
 
         /**
@@ -110,15 +213,20 @@ check_status:
             opal_thread_internal_mutex_unlock(&sync->lock);
             goto i_am_done;
         }
-        /* either promoted, or spurious wakeup ! */
+        /* either promoted, or spurious wakeup ! (only the latter for a
+         * delegated progress) */
         goto check_status;
     }
     opal_thread_internal_mutex_unlock(&sync->lock);
 
     OPAL_THREAD_ADD_FETCH32(&num_thread_in_progress, 1);
-    while (sync->count > 0) { /* progress till completion */
-        /* don't progress with the sync lock locked or you'll deadlock */
-        opal_progress();
+    if (OPAL_WAIT_SYNC_SPIN == opal_wait_sync_policy) {
+        while (sync->count > 0) { /* progress till completion */
+            /* don't progress with the sync lock locked or you'll deadlock */
+            opal_progress();
+        }
+    } else {
+        wait_sync_progress_adaptive(sync);
     }
     OPAL_THREAD_ADD_FETCH32(&num_thread_in_progress, -1);
 
@@ -46,4 +46,8 @@ static inline void opal_thread_yield(void)
     qthread_yield();
 }
 
+/* Qthreads are user-level threads, a waiting thread must not block the
+ * shepherd it runs on */
+#define OPAL_THREAD_USER_LEVEL 1
+
 #endif /* OPAL_MCA_THREADS_QTHREADS_THREADS_QTHREADS_THREADS_H */
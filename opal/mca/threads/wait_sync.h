@@ -39,6 +39,17 @@ BEGIN_C_DECLS
 
 extern int opal_max_thread_in_progress;
 
+/* How the thread in charge of the progress waits for its sync */
+enum {
+    OPAL_WAIT_SYNC_SPIN = 0, /**< call opal_progress until completion */
+    OPAL_WAIT_SYNC_ADAPTIVE, /**< spin for a while, then sleep until woken up */
+};
+
+extern int opal_wait_sync_policy;
+extern int opal_wait_sync_spin_min;   /**< usec */
+extern int opal_wait_sync_spin_max;   /**< usec */
+extern int opal_wait_sync_sleep_usec; /**< upper bound of a single sleep */
+
 typedef struct ompi_wait_sync_t {
     opal_atomic_int32_t count;
     int32_t status;
@@ -47,6 +58,7 @@ typedef struct ompi_wait_sync_t {
     struct ompi_wait_sync_t *next;
     struct ompi_wait_sync_t *prev;
     volatile bool signaling;
+    volatile int32_t sleeping; /**< the owner sleeps on count (adaptive policy) */
 } ompi_wait_sync_t;
 
 #define SYNC_WAIT(sync) (opal_using_threads() ? ompi_sync_wait_mt(sync) : sync_wait_st(sync))
@@ -77,8 +89,16 @@ typedef struct ompi_wait_sync_t {
         opal_thread_internal_mutex_destroy(&(sync)->lock);     \
     }
 
+/* The sleeping owner must be woken up before signaling is cleared, the
+ * sync can be released right after. */
 #define WAIT_SYNC_SIGNAL(sync)                                \
     if (opal_using_threads()) {                               \
+        if (OPAL_WAIT_SYNC_SPIN != opal_wait_sync_policy) {   \
+            opal_atomic_mb();                                 \
+            if ((sync)->sleeping) {                           \
+                wait_sync_wake_sleeper(sync);                 \
+            }                                                 \
+        }                                                     \
         opal_thread_internal_mutex_lock(&(sync)->lock);       \
         opal_thread_internal_cond_signal(&(sync)->condition); \
         opal_thread_internal_mutex_unlock(&(sync)->lock);     \
@@ -94,6 +114,8 @@ typedef struct ompi_wait_sync_t {
 OPAL_DECLSPEC extern ompi_wait_sync_t *wait_sync_list;
 
 OPAL_DECLSPEC int ompi_sync_wait_mt(ompi_wait_sync_t *sync);
+/* wake up the thread sleeping in the adaptive policy on this sync */
+OPAL_DECLSPEC void wait_sync_wake_sleeper(ompi_wait_sync_t *sync);
 static inline int sync_wait_st(ompi_wait_sync_t *sync)
 {
     assert(NULL == wait_sync_list);
@@ -115,6 +137,7 @@ static inline int sync_wait_st(ompi_wait_sync_t *sync)
         (sync)->prev = NULL;                                       \
         (sync)->status = 0;                                        \
         (sync)->signaling = (0 != (c));                            \
+        (sync)->sleeping = 0;                                      \
         if (opal_using_threads()) {                                \
             opal_thread_internal_cond_init(&(sync)->condition);    \
             opal_thread_internal_mutex_init(&(sync)->lock, false); \
@@ -36,14 +36,17 @@
 #include <signal.h>
 #include <time.h>
 
+#include "opal/class/opal_free_list.h"
 #include "opal/constants.h"
 #include "opal/datatype/opal_datatype.h"
 #include "opal/mca/base/mca_base_var.h"
 #include "opal/mca/shmem/base/base.h"
 #include "opal/mca/threads/mutex.h"
 #include "opal/mca/threads/threads.h"
+#include "opal/mca/threads/wait_sync.h"
 #include "opal/runtime/opal.h"
 #include "opal/runtime/opal_params.h"
+#include "opal/runtime/opal_progress_threads.h"
 #include "opal/util/opal_environ.h"
 #include "opal/util/printf.h"
 #include "opal/util/show_help.h"
@@ -73,6 +76,10 @@ bool opal_abort_print_stack = false;
 int opal_abort_delay = 0;
 
 int opal_max_thread_in_progress = 1;
+int opal_wait_sync_policy = OPAL_WAIT_SYNC_SPIN;
+int opal_wait_sync_spin_min = 2;
+int opal_wait_sync_spin_max = 100;
+int opal_wait_sync_sleep_usec = 1000;
 
 static bool opal_register_done = false;
 
@@ -83,8 +90,20 @@ static void opal_deregister_params(void)
     opal_register_done = false;
 }
 
+static mca_base_var_enum_value_t opal_async_progress_modes[] = {
+    {OPAL_PROGRESS_ASYNC_NONE, "none"},
+    {OPAL_PROGRESS_ASYNC_ALWAYS, "always"},
+    {OPAL_PROGRESS_ASYNC_HYBRID, "hybrid"},
+    {0, NULL}};
+
+static mca_base_var_enum_value_t opal_wait_sync_policies[] = {
+    {OPAL_WAIT_SYNC_SPIN, "spin"},
+    {OPAL_WAIT_SYNC_ADAPTIVE, "adaptive"},
+    {0, NULL}};
+
 int opal_register_params(void)
 {
+    mca_base_var_enum_t *new_enum;
     int ret;
     char *string = NULL;
 
@@ -172,6 +191,45 @@ int opal_register_params(void)
                                 &opal_progress_yield_when_idle);
 #endif
 
+    (void) mca_base_var_register("opal", "opal", "progress", "adaptive",
+                                 "Adapt the polling of the progress callbacks to their activity: "
+                                 "the one that reported events last is polled first and those "
+                                 "without events for opal_progress_backoff_threshold calls are "
+                                 "polled exponentially less often",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                 OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_LOCAL, &opal_progress_adaptive);
+    (void) mca_base_var_register("opal", "opal", "progress", "backoff_threshold",
+                                 "Number of calls without events before a progress callback "
+                                 "starts backing off (with opal_progress_adaptive)",
+                                 MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0,
+                                 MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_6,
+                                 MCA_BASE_VAR_SCOPE_LOCAL, &opal_progress_backoff_threshold);
+    (void) mca_base_var_register("opal", "opal", "progress", "backoff_max",
+                                 "Maximum number of calls an idle progress callback is skipped "
+                                 "(with opal_progress_adaptive). Bounds the latency added to a "
+                                 "transport waking up",
+                                 MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, 0,
+                                 MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_6,
+                                 MCA_BASE_VAR_SCOPE_LOCAL, &opal_progress_backoff_max);
+
+    (void) mca_base_var_enum_create("opal_async_progress_modes", opal_async_progress_modes,
+                                    &new_enum);
+    (void) mca_base_var_register("opal", "opal", NULL, "async_progress",
+                                 "Progress the communications from a helper thread. none: only "
+                                 "when the application calls into the library, always: the "
+                                 "helper polls all the time, hybrid: the helper only polls while "
+                                 "operations are outstanding. The library then behaves "
+                                 "internally as with MPI_THREAD_MULTIPLE",
+                                 MCA_BASE_VAR_TYPE_INT, new_enum, 0, 0, OPAL_INFO_LVL_4,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &opal_progress_async_mode);
+    OBJ_RELEASE(new_enum);
+    (void) mca_base_var_register("opal", "opal", NULL, "async_progress_core",
+                                 "Core (logical index) the async progress thread is bound to, "
+                                 "-1 leaves it unbound. Preferably a core not used by the "
+                                 "application",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_4,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &opal_progress_async_core);
+
 #if OPAL_ENABLE_DEBUG
     opal_progress_debug = false;
     ret = mca_base_var_register("opal", "opal", "progress", "debug",
@@ -358,6 +416,44 @@ int opal_register_params(void)
                                  MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_8,
                                  MCA_BASE_VAR_SCOPE_READONLY, &opal_max_thread_in_progress);
 
+    (void) mca_base_var_enum_create("opal_wait_sync_policies", opal_wait_sync_policies, &new_enum);
+    (void) mca_base_var_register("opal", "opal", NULL, "wait_sync_policy",
+                                 "How the thread driving the progress waits for its requests: "
+                                 "\"spin\" calls opal_progress until completion, \"adaptive\" "
+                                 "spins for a duration adapted to the recent completion latency "
+                                 "then sleeps until the completion wakes it up (default: spin)",
+                                 MCA_BASE_VAR_TYPE_INT, new_enum, 0, 0, OPAL_INFO_LVL_5,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &opal_wait_sync_policy);
+    OBJ_RELEASE(new_enum);
+    (void) mca_base_var_register("opal", "opal", NULL, "wait_sync_spin_min",
+                                 "Minimum spinning time (usec) of the adaptive wait policy, also "
+                                 "used after each wakeup",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_8,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &opal_wait_sync_spin_min);
+    (void) mca_base_var_register("opal", "opal", NULL, "wait_sync_spin_max",
+                                 "Maximum spinning time (usec) of the adaptive wait policy",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_8,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &opal_wait_sync_spin_max);
+    (void) mca_base_var_register("opal", "opal", NULL, "wait_sync_sleep_usec",
+                                 "Longest sleep (usec) of the adaptive wait policy before polling "
+                                 "again when no completion wakes the thread up",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_8,
+                                 MCA_BASE_VAR_SCOPE_READONLY, &opal_wait_sync_sleep_usec);
+    if (opal_wait_sync_spin_min < 0) {
+        opal_wait_sync_spin_min = 0;
+    }
+    if (opal_wait_sync_spin_max < opal_wait_sync_spin_min) {
+        opal_wait_sync_spin_max = opal_wait_sync_spin_min;
+    }
+    if (opal_wait_sync_sleep_usec < 1) {
+        opal_wait_sync_sleep_usec = 1;
+    }
+
+    ret = opal_free_list_register_params();
+    if (OPAL_SUCCESS != ret) {
+        return ret;
+    }
+
     /* The ddt engine has a few parameters */
     ret = opal_datatype_register_params();
     if (OPAL_SUCCESS != ret) {
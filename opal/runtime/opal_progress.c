@@ -27,14 +27,19 @@
 
 #include "opal_config.h"
 
+#include <stddef.h>
+
 #include "opal/constants.h"
+#include "opal/mca/base/mca_base_pvar.h"
 #include "opal/mca/base/mca_base_var.h"
 #include "opal/mca/threads/threads.h"
 #include "opal/mca/timer/base/base.h"
 #include "opal/runtime/opal.h"
 #include "opal/runtime/opal_params.h"
 #include "opal/runtime/opal_progress.h"
+#include "opal/runtime/opal_progress_threads.h"
 #include "opal/util/event.h"
+#include "opal/util/minmax.h"
 #include "opal/util/output.h"
 
 #define OPAL_PROGRESS_USE_TIMERS       (OPAL_TIMER_CYCLE_SUPPORTED || OPAL_TIMER_USEC_SUPPORTED)
@@ -49,21 +54,56 @@ bool opal_progress_debug = false;
  */
 static int opal_progress_event_flag = OPAL_EVLOOP_ONCE | OPAL_EVLOOP_NONBLOCK;
 int opal_progress_spin_count = 10000;
+bool opal_progress_adaptive = false;
+unsigned int opal_progress_backoff_threshold = 8;
+unsigned int opal_progress_backoff_max = 64;
 
 /*
  * Local variables
  */
 static opal_atomic_lock_t progress_lock;
 
+/* scheduling state and statistics of a registered callback. They are only
+ * maintained when the adaptive scheduling is enabled or the statistics are
+ * being read (see opal_progress_run). Updates are not atomic, racing threads
+ * may lose some of them: this is only used as a hint. */
+typedef struct opal_progress_cb_state_t {
+    opal_progress_callback_t cb;
+    /** idle calls since the last event */
+    uint32_t idle;
+    /** number of calls skipped after the last idle call */
+    uint32_t backoff;
+    /** calls left to skip */
+    uint32_t skip;
+    uint64_t calls;
+    /** calls reporting events */
+    uint64_t hits;
+    uint64_t events;
+    /** time spent in the callback (timer units) */
+    uint64_t time;
+    /** next retired state */
+    struct opal_progress_cb_state_t *next;
+} opal_progress_cb_state_t;
+
 /* callbacks to progress */
-static volatile opal_progress_callback_t *callbacks = NULL;
+static opal_progress_cb_state_t *volatile *callbacks = NULL;
 static size_t callbacks_len = 0;
 static size_t callbacks_size = 0;
 
-static volatile opal_progress_callback_t *callbacks_lp = NULL;
+static opal_progress_cb_state_t *volatile *callbacks_lp = NULL;
 static size_t callbacks_lp_len = 0;
 static size_t callbacks_lp_size = 0;
 
+/* high priority callback polled first (the last one that reported events) */
+static opal_progress_cb_state_t *volatile opal_progress_hot = NULL;
+/* unregistered states, another thread may still be using them. Freed at finalize */
+static opal_progress_cb_state_t *opal_progress_retired = NULL;
+/* number of started handles on the statistics */
+static opal_atomic_int32_t opal_progress_instrumented = 0;
+
+/* number of values of the statistics pvars */
+#define OPAL_PROGRESS_STATS_MAX 64
+
 /* do we want to yield() if nothing happened */
 bool opal_progress_yield_when_idle = false;
 
@@ -97,26 +137,145 @@ static int fake_cb(void)
     return 0;
 }
 
+static opal_progress_cb_state_t fake_state = {.cb = fake_cb};
+
 static int _opal_progress_unregister(opal_progress_callback_t cb,
-                                     volatile opal_progress_callback_t *callback_array,
+                                     opal_progress_cb_state_t *volatile *callback_array,
                                      size_t *callback_array_len);
 
 static void opal_progress_finalize(void)
 {
+    opal_progress_cb_state_t *state;
+
     /* free memory associated with the callbacks */
     opal_atomic_lock(&progress_lock);
 
+    for (size_t i = 0; i < callbacks_len; ++i) {
+        free(callbacks[i]);
+    }
     callbacks_len = 0;
     callbacks_size = 0;
     free((void *) callbacks);
     callbacks = NULL;
 
+    for (size_t i = 0; i < callbacks_lp_len; ++i) {
+        free(callbacks_lp[i]);
+    }
     callbacks_lp_len = 0;
     callbacks_lp_size = 0;
     free((void *) callbacks_lp);
     callbacks_lp = NULL;
 
+    while (NULL != (state = opal_progress_retired)) {
+        opal_progress_retired = state->next;
+        free(state);
+    }
+    opal_progress_hot = NULL;
+
+    opal_atomic_unlock(&progress_lock);
+}
+
+#if OPAL_PROGRESS_USE_TIMERS
+static inline opal_timer_t opal_progress_now(void)
+{
+#    if OPAL_PROGRESS_ONLY_USEC_NATIVE
+    return opal_timer_base_get_usec();
+#    else
+    return opal_timer_base_get_cycles();
+#    endif /* OPAL_PROGRESS_ONLY_USEC_NATIVE */
+}
+#endif /* OPAL_PROGRESS_USE_TIMERS */
+
+/*
+ * Performance variables. Each one is an array of OPAL_PROGRESS_STATS_MAX
+ * values, one per registered callback: the high priority ones in their
+ * polling order followed by the low priority ones, zero past the last one.
+ */
+
+static int opal_progress_pvar_notify(struct mca_base_pvar_t *pvar, mca_base_pvar_event_t event,
+                                     void *obj, int *count)
+{
+    switch (event) {
+    case MCA_BASE_PVAR_HANDLE_BIND:
+        *count = OPAL_PROGRESS_STATS_MAX;
+        break;
+    case MCA_BASE_PVAR_HANDLE_START:
+        (void) opal_atomic_add_fetch_32(&opal_progress_instrumented, 1);
+        break;
+    case MCA_BASE_PVAR_HANDLE_STOP:
+        (void) opal_atomic_sub_fetch_32(&opal_progress_instrumented, 1);
+        break;
+    default:
+        break;
+    }
+
+    return OPAL_SUCCESS;
+}
+
+static uint64_t opal_progress_stat(const opal_progress_cb_state_t *state, size_t offset)
+{
+    uint64_t value = *(const uint64_t *) ((const char *) state + offset);
+
+    if (offsetof(opal_progress_cb_state_t, time) == offset) {
+#if OPAL_PROGRESS_USE_TIMERS && !OPAL_PROGRESS_ONLY_USEC_NATIVE
+        /* report microseconds */
+        value = (uint64_t) ((double) value * 1000000.0 / (double) opal_timer_base_get_freq());
+#elif !OPAL_PROGRESS_USE_TIMERS
+        value = 0;
+#endif
+    }
+
+    return value;
+}
+
+static int opal_progress_pvar_read(const struct mca_base_pvar_t *pvar, void *value, void *obj)
+{
+    const size_t offset = (size_t) pvar->ctx;
+    unsigned long long *array = (unsigned long long *) value;
+    size_t n = 0;
+
+    opal_atomic_lock(&progress_lock);
+    for (size_t i = 0; i < callbacks_len && n < OPAL_PROGRESS_STATS_MAX; ++i) {
+        array[n++] = opal_progress_stat(callbacks[i], offset);
+    }
+    for (size_t i = 0; i < callbacks_lp_len && n < OPAL_PROGRESS_STATS_MAX; ++i) {
+        array[n++] = opal_progress_stat(callbacks_lp[i], offset);
+    }
     opal_atomic_unlock(&progress_lock);
+
+    for (; n < OPAL_PROGRESS_STATS_MAX; ++n) {
+        array[n] = 0;
+    }
+
+    return OPAL_SUCCESS;
+}
+
+static void opal_progress_register_pvars(void)
+{
+    static const struct {
+        const char *name;
+        const char *desc;
+        int var_class;
+        size_t offset;
+    } pvars[] = {
+        {"callback_calls", "Number of calls of each progress callback",
+         MCA_BASE_PVAR_CLASS_COUNTER, offsetof(opal_progress_cb_state_t, calls)},
+        {"callback_hits", "Number of calls of each progress callback reporting events",
+         MCA_BASE_PVAR_CLASS_COUNTER, offsetof(opal_progress_cb_state_t, hits)},
+        {"callback_events", "Number of events reported by each progress callback",
+         MCA_BASE_PVAR_CLASS_COUNTER, offsetof(opal_progress_cb_state_t, events)},
+        {"callback_time", "Time spent in each progress callback (microseconds)",
+         MCA_BASE_PVAR_CLASS_TIMER, offsetof(opal_progress_cb_state_t, time)},
+    };
+
+    for (size_t i = 0; i < sizeof(pvars) / sizeof(pvars[0]); ++i) {
+        (void) mca_base_pvar_register("opal", "opal", "progress", pvars[i].name, pvars[i].desc,
+                                      OPAL_INFO_LVL_5, pvars[i].var_class,
+                                      MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL,
+                                      MCA_BASE_VAR_BIND_NO_OBJECT, MCA_BASE_PVAR_FLAG_READONLY,
+                                      opal_progress_pvar_read, NULL, opal_progress_pvar_notify,
+                                      (void *) pvars[i].offset);
+    }
 }
 
 /* init the progress engine - called from orte_init */
@@ -148,13 +307,15 @@ int opal_progress_init(void)
     }
 
     for (size_t i = 0; i < callbacks_size; ++i) {
-        callbacks[i] = fake_cb;
+        callbacks[i] = &fake_state;
     }
 
     for (size_t i = 0; i < callbacks_lp_size; ++i) {
-        callbacks_lp[i] = fake_cb;
+        callbacks_lp[i] = &fake_state;
     }
 
+    opal_progress_register_pvars();
+
     OPAL_OUTPUT(
         (debug_output, "progress: initialized event flag to: %x", opal_progress_event_flag));
     OPAL_OUTPUT((debug_output, "progress: initialized yield_when_idle to: %s",
@@ -202,6 +363,69 @@ static int opal_progress_events(void)
     return events;
 }
 
+static inline int opal_progress_call(opal_progress_cb_state_t *state, bool high_priority)
+{
+    int events;
+
+#if OPAL_PROGRESS_USE_TIMERS
+    /* only timed while the statistics are being read */
+    if (0 != opal_progress_instrumented) {
+        opal_timer_t start = opal_progress_now();
+        events = state->cb();
+        state->time += opal_progress_now() - start;
+    } else
+#endif /* OPAL_PROGRESS_USE_TIMERS */
+    {
+        events = state->cb();
+    }
+    state->calls++;
+    if (events > 0) {
+        state->hits++;
+        state->events += events;
+        state->idle = 0;
+        state->backoff = 0;
+        if (high_priority) {
+            opal_progress_hot = state;
+        }
+    } else if (opal_progress_adaptive
+               && (0 != state->backoff || ++state->idle >= opal_progress_backoff_threshold)) {
+        /* nothing for a while: poll it exponentially less often */
+        state->backoff = opal_min(state->backoff ? 2 * state->backoff : 1,
+                                  opal_progress_backoff_max);
+        state->skip = state->backoff;
+    }
+
+    return events;
+}
+
+/* Instrumented flavor of the callback loop. With the adaptive scheduling the
+ * high priority callback that reported events last is polled first, and idle
+ * callbacks skip up to opal_progress_backoff_max calls. */
+static int opal_progress_run(opal_progress_cb_state_t *volatile *cbs, size_t len,
+                             bool high_priority)
+{
+    opal_progress_cb_state_t *hot = NULL;
+    int events = 0;
+
+    if (high_priority && opal_progress_adaptive && NULL != (hot = opal_progress_hot)) {
+        events += opal_progress_call(hot, true);
+    }
+
+    for (size_t i = 0; i < len; ++i) {
+        opal_progress_cb_state_t *state = cbs[i];
+        if (state == hot) {
+            continue;
+        }
+        if (0 != state->skip) {
+            --state->skip;
+            continue;
+        }
+        events += opal_progress_call(state, high_priority);
+    }
+
+    return events;
+}
+
 /*
  * Progress the event library and any functions that have registered to
  * be called.  We don't propogate errors from the progress functions,
@@ -216,12 +440,26 @@ static int opal_progress_events(void)
 void opal_progress(void)
 {
     static uint32_t num_calls = 0;
+    const bool instrumented = opal_progress_adaptive || 0 != opal_progress_instrumented;
     size_t i;
     int events = 0;
 
+    /* the async progress thread is polling: leave the work to it instead of
+     * competing for the locks of the callbacks */
+    if (OPAL_UNLIKELY(opal_progress_async_polling) && !opal_progress_async_self()) {
+        if (opal_progress_yield_when_idle) {
+            opal_thread_yield();
+        }
+        return;
+    }
+
     /* progress all registered callbacks */
-    for (i = 0; i < callbacks_len; ++i) {
-        events += (callbacks[i])();
+    if (instrumented) {
+        events += opal_progress_run(callbacks, callbacks_len, true);
+    } else {
+        for (i = 0; i < callbacks_len; ++i) {
+            events += (callbacks[i]->cb)();
+        }
     }
 
     /* Run low priority callbacks and events once every 8 calls to opal_progress().
@@ -231,8 +469,12 @@ void opal_progress(void)
      * it's not a problem.
      */
     if (((num_calls++) & 0x7) == 0) {
-        for (i = 0; i < callbacks_lp_len; ++i) {
-            events += (callbacks_lp[i])();
+        if (instrumented) {
+            events += opal_progress_run(callbacks_lp, callbacks_lp_len, false);
+        } else {
+            for (i = 0; i < callbacks_lp_len; ++i) {
+                events += (callbacks_lp[i]->cb)();
+            }
         }
 
         opal_progress_events();
@@ -352,10 +594,10 @@ void opal_progress_set_event_poll_rate(int polltime)
 }
 
 static int opal_progress_find_cb(opal_progress_callback_t cb,
-                                 volatile opal_progress_callback_t *cbs, size_t cbs_len)
+                                 opal_progress_cb_state_t *volatile *cbs, size_t cbs_len)
 {
     for (size_t i = 0; i < cbs_len; ++i) {
-        if (cbs[i] == cb) {
+        if (cbs[i]->cb == cb) {
             return (int) i;
         }
     }
@@ -364,21 +606,29 @@ static int opal_progress_find_cb(opal_progress_callback_t cb,
 }
 
 static int _opal_progress_register(opal_progress_callback_t cb,
-                                   volatile opal_progress_callback_t **cbs, size_t *cbs_size,
+                                   opal_progress_cb_state_t *volatile **cbs, size_t *cbs_size,
                                    size_t *cbs_len)
 {
+    opal_progress_cb_state_t *state;
     int ret = OPAL_SUCCESS;
 
     if (OPAL_ERR_NOT_FOUND != opal_progress_find_cb(cb, *cbs, *cbs_len)) {
         return OPAL_SUCCESS;
     }
 
+    state = (opal_progress_cb_state_t *) calloc(1, sizeof(*state));
+    if (NULL == state) {
+        return OPAL_ERR_TEMP_OUT_OF_RESOURCE;
+    }
+    state->cb = cb;
+
     /* see if we need to allocate more space */
     if (*cbs_len + 1 > *cbs_size) {
-        opal_progress_callback_t *tmp, *old;
+        opal_progress_cb_state_t **tmp, **old;
 
-        tmp = (opal_progress_callback_t *) malloc(sizeof(tmp[0]) * 2 * *cbs_size);
+        tmp = (opal_progress_cb_state_t **) malloc(sizeof(tmp[0]) * 2 * *cbs_size);
         if (tmp == NULL) {
+            free(state);
             return OPAL_ERR_TEMP_OUT_OF_RESOURCE;
         }
 
@@ -388,14 +638,14 @@ static int _opal_progress_register(opal_progress_callback_t cb,
         }
 
         for (size_t i = *cbs_len; i < 2 * *cbs_size; ++i) {
-            tmp[i] = fake_cb;
+            tmp[i] = &fake_state;
         }
 
         opal_atomic_wmb();
 
         /* swap out callback array */
-        old = (opal_progress_callback_t *) opal_atomic_swap_ptr((opal_atomic_intptr_t *) cbs,
-                                                                (intptr_t) tmp);
+        old = (opal_progress_cb_state_t **) opal_atomic_swap_ptr((opal_atomic_intptr_t *) cbs,
+                                                                 (intptr_t) tmp);
 
         opal_atomic_wmb();
 
@@ -403,7 +653,7 @@ static int _opal_progress_register(opal_progress_callback_t cb,
         *cbs_size *= 2;
     }
 
-    cbs[0][*cbs_len] = cb;
+    cbs[0][*cbs_len] = state;
     ++*cbs_len;
 
     opal_atomic_wmb();
@@ -442,14 +692,24 @@ int opal_progress_register_lp(opal_progress_callback_t cb)
 }
 
 static int _opal_progress_unregister(opal_progress_callback_t cb,
-                                     volatile opal_progress_callback_t *callback_array,
+                                     opal_progress_cb_state_t *volatile *callback_array,
                                      size_t *callback_array_len)
 {
+    opal_progress_cb_state_t *state;
     int ret = opal_progress_find_cb(cb, callback_array, *callback_array_len);
     if (OPAL_ERR_NOT_FOUND == ret) {
         return ret;
     }
 
+    /* another thread may still be calling it, keep the state around but make it harmless */
+    state = callback_array[ret];
+    state->cb = fake_cb;
+    state->next = opal_progress_retired;
+    opal_progress_retired = state;
+    if (opal_progress_hot == state) {
+        opal_progress_hot = NULL;
+    }
+
     /* If we found the function we're unregistering: If callbacks_len
        is 0, we're not goig to do anything interesting anyway, so
        skip.  If callbacks_len is 1, it will soon be 0, so no need to
@@ -462,7 +722,7 @@ static int _opal_progress_unregister(opal_progress_callback_t cb,
     }
 
     --*callback_array_len;
-    callback_array[*callback_array_len] = fake_cb;
+    callback_array[*callback_array_len] = &fake_state;
 
     return OPAL_SUCCESS;
 }
@@ -164,6 +164,13 @@ OPAL_DECLSPEC extern int opal_progress_spin_count;
 /* do we want to call sched_yield() if nothing happened */
 OPAL_DECLSPEC extern bool opal_progress_yield_when_idle;
 
+/* poll first the callback that reported events last, and back off the idle ones */
+OPAL_DECLSPEC extern bool opal_progress_adaptive;
+/* idle calls before an idle callback starts backing off */
+OPAL_DECLSPEC extern unsigned int opal_progress_backoff_threshold;
+/* maximum number of calls skipped by an idle callback */
+OPAL_DECLSPEC extern unsigned int opal_progress_backoff_max;
+
 /**
  * Progress until flag is true or poll iterations completed
  */
@@ -20,11 +20,17 @@
 #    include <string.h>
 #endif
 
+#include <pthread.h>
+
 #include "opal/class/opal_list.h"
+#include "opal/mca/hwloc/base/base.h"
 #include "opal/mca/threads/threads.h"
+#include "opal/runtime/opal.h"
+#include "opal/runtime/opal_progress.h"
 #include "opal/util/error.h"
 #include "opal/util/event.h"
 #include "opal/util/fd.h"
+#include "opal/util/output.h"
 
 #include "opal/runtime/opal_progress_threads.h"
 
@@ -291,3 +297,143 @@ int opal_progress_thread_resume(const char *name)
 
     return OPAL_ERR_NOT_FOUND;
 }
+
+/*
+ * Asynchronous progress: a helper thread calling opal_progress()
+ */
+
+int opal_progress_async_mode = OPAL_PROGRESS_ASYNC_NONE;
+int opal_progress_async_core = -1;
+volatile bool opal_progress_async_polling = false;
+opal_atomic_int32_t opal_progress_async_users = 0;
+
+#if OPAL_HAVE_THREAD_LOCAL
+static opal_thread_local bool opal_progress_async_is_engine = false;
+#endif /* OPAL_HAVE_THREAD_LOCAL */
+
+static struct {
+    pthread_mutex_t lock; /**< protects sleeping and the wake ups */
+    pthread_cond_t wakeup;
+    volatile bool active;
+    volatile bool sleeping;
+    bool started;
+    opal_thread_t engine;
+} opal_progress_async = {.lock = PTHREAD_MUTEX_INITIALIZER, .wakeup = PTHREAD_COND_INITIALIZER};
+
+/* Bind the helper to opal_async_progress_core. The failures are not fatal. */
+static void opal_progress_async_bind(void)
+{
+    hwloc_obj_t obj;
+
+    if (0 > opal_progress_async_core || OPAL_SUCCESS != opal_hwloc_base_get_topology()) {
+        return;
+    }
+
+    obj = hwloc_get_obj_by_type(opal_hwloc_topology, HWLOC_OBJ_CORE,
+                                (unsigned int) opal_progress_async_core);
+    if (NULL == obj
+        || 0 != hwloc_set_cpubind(opal_hwloc_topology, obj->cpuset, HWLOC_CPUBIND_THREAD)) {
+        opal_output_verbose(10, 0, "progress: could not bind the async progress thread to core %d",
+                            opal_progress_async_core);
+    }
+}
+
+static void *opal_progress_async_engine(opal_object_t *obj)
+{
+#if OPAL_HAVE_THREAD_LOCAL
+    opal_progress_async_is_engine = true;
+#endif /* OPAL_HAVE_THREAD_LOCAL */
+    opal_progress_async_bind();
+
+    while (opal_progress_async.active) {
+        if (OPAL_PROGRESS_ASYNC_HYBRID == opal_progress_async_mode
+            && 0 >= opal_progress_async_users) {
+            /* nothing outstanding: let the application threads progress and sleep
+             * until the next operation is started */
+            opal_progress_async_polling = false;
+            pthread_mutex_lock(&opal_progress_async.lock);
+            opal_progress_async.sleeping = true;
+            opal_atomic_mb(); /* publish sleeping before looking at the users */
+            while (opal_progress_async.active && 0 >= opal_progress_async_users) {
+                pthread_cond_wait(&opal_progress_async.wakeup, &opal_progress_async.lock);
+            }
+            opal_progress_async.sleeping = false;
+            pthread_mutex_unlock(&opal_progress_async.lock);
+            continue;
+        }
+
+        opal_progress_async_polling = true;
+        opal_progress();
+    }
+    opal_progress_async_polling = false;
+
+    return OPAL_THREAD_CANCELLED;
+}
+
+void opal_progress_async_wakeup(void)
+{
+    /* increments are full barriers, sleeping is accurate enough here */
+    if (opal_progress_async.sleeping) {
+        pthread_mutex_lock(&opal_progress_async.lock);
+        pthread_cond_signal(&opal_progress_async.wakeup);
+        pthread_mutex_unlock(&opal_progress_async.lock);
+    }
+}
+
+bool opal_progress_async_self(void)
+{
+#if OPAL_HAVE_THREAD_LOCAL
+    return opal_progress_async_is_engine;
+#else
+    return opal_progress_async.started && opal_thread_self_compare(&opal_progress_async.engine);
+#endif /* OPAL_HAVE_THREAD_LOCAL */
+}
+
+int opal_progress_async_start(void)
+{
+    int rc;
+
+    if (OPAL_PROGRESS_ASYNC_NONE == opal_progress_async_mode || opal_progress_async.started) {
+        return OPAL_SUCCESS;
+    }
+
+    if (!opal_using_threads()) {
+        opal_output_verbose(1, 0, "progress: async progress needs thread support, disabled");
+        opal_progress_async_mode = OPAL_PROGRESS_ASYNC_NONE;
+        return OPAL_SUCCESS;
+    }
+
+    OBJ_CONSTRUCT(&opal_progress_async.engine, opal_thread_t);
+    opal_progress_async.engine.t_run = opal_progress_async_engine;
+    opal_progress_async.engine.t_arg = NULL;
+    opal_progress_async.active = true;
+    opal_progress_async.started = true;
+    opal_atomic_wmb();
+
+    if (OPAL_SUCCESS != (rc = opal_thread_start(&opal_progress_async.engine))) {
+        OPAL_ERROR_LOG(rc);
+        opal_progress_async.active = false;
+        opal_progress_async.started = false;
+        OBJ_DESTRUCT(&opal_progress_async.engine);
+        opal_progress_async_mode = OPAL_PROGRESS_ASYNC_NONE;
+    }
+
+    return OPAL_SUCCESS;
+}
+
+void opal_progress_async_stop(void)
+{
+    if (!opal_progress_async.started) {
+        return;
+    }
+
+    pthread_mutex_lock(&opal_progress_async.lock);
+    opal_progress_async.active = false;
+    pthread_cond_signal(&opal_progress_async.wakeup);
+    pthread_mutex_unlock(&opal_progress_async.lock);
+
+    opal_thread_join(&opal_progress_async.engine, NULL);
+    OBJ_DESTRUCT(&opal_progress_async.engine);
+    opal_progress_async.started = false;
+    opal_progress_async_polling = false;
+}
@@ -15,6 +15,8 @@
 
 #include "opal_config.h"
 
+#include "opal/prefetch.h"
+#include "opal/sys/atomic.h"
 #include "opal/util/event.h"
 
 /**
@@ -68,4 +70,66 @@ OPAL_DECLSPEC int opal_progress_thread_pause(const char *name);
  */
 OPAL_DECLSPEC int opal_progress_thread_resume(const char *name);
 
+/**
+ * Asynchronous progress modes (opal_async_progress).
+ */
+enum {
+    /** opal_progress() is only called by the application threads */
+    OPAL_PROGRESS_ASYNC_NONE,
+    /** a helper thread calls opal_progress() all the time */
+    OPAL_PROGRESS_ASYNC_ALWAYS,
+    /** the helper thread only polls while operations are outstanding */
+    OPAL_PROGRESS_ASYNC_HYBRID
+};
+
+OPAL_DECLSPEC extern int opal_progress_async_mode;
+/** Core the helper thread is bound to (-1: not bound) */
+OPAL_DECLSPEC extern int opal_progress_async_core;
+/** The helper thread is polling, the other threads can leave the progress to it */
+OPAL_DECLSPEC extern volatile bool opal_progress_async_polling;
+/** Number of outstanding operations (hybrid mode) */
+OPAL_DECLSPEC extern opal_atomic_int32_t opal_progress_async_users;
+
+/**
+ * Start the asynchronous progress thread if opal_async_progress asks for it.
+ *
+ * The thread calls opal_progress() in a loop, so the whole stack must be
+ * thread safe (opal_using_threads()) by then. While it is polling the calls
+ * to opal_progress() from the other threads return immediately instead of
+ * competing with it for the locks of the progress callbacks.
+ *
+ * Returns OPAL_SUCCESS if the thread was started or is not needed.
+ */
+OPAL_DECLSPEC int opal_progress_async_start(void);
+
+/**
+ * Stop the asynchronous progress thread (if any).
+ */
+OPAL_DECLSPEC void opal_progress_async_stop(void);
+
+/** Is the calling thread the asynchronous progress thread */
+OPAL_DECLSPEC bool opal_progress_async_self(void);
+
+/** Wake the helper up for the first outstanding operation (internal) */
+OPAL_DECLSPEC void opal_progress_async_wakeup(void);
+
+/**
+ * Account for an operation needing progress (hybrid mode). Each increment must
+ * be matched by a decrement when the operation completes.
+ */
+static inline void opal_progress_async_users_increment(void)
+{
+    if (OPAL_UNLIKELY(OPAL_PROGRESS_ASYNC_HYBRID == opal_progress_async_mode)
+        && 1 == opal_atomic_add_fetch_32(&opal_progress_async_users, 1)) {
+        opal_progress_async_wakeup();
+    }
+}
+
+static inline void opal_progress_async_users_decrement(void)
+{
+    if (OPAL_UNLIKELY(OPAL_PROGRESS_ASYNC_HYBRID == opal_progress_async_mode)) {
+        (void) opal_atomic_sub_fetch_32(&opal_progress_async_users, 1);
+    }
+}
+
 #endif
@@ -2,7 +2,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2006 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -43,6 +43,220 @@
 
 #define INTALIGNED(v) (((intptr_t) v & 3) ? false : true)
 
+/*
+ * Word kernels shared by the checksum functions below: copy (or not) count
+ * words of any alignment and return their sum. The sum of the words is
+ * computed in several lanes and folded at the end, which gives the same
+ * result modulo 2^N as the sequential sum, so the checksums do not depend
+ * on the kernel used. On x86_64 the AVX2 kernels are used when the
+ * processor supports them (checked at run time, the rest of the file is
+ * built for the baseline), on aarch64 the NEON ones always are.
+ */
+#if defined(__x86_64__) && (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5))) \
+    && !defined(__NVCOMPILER) && !defined(__PGI)
+#    define OPAL_CRC_HAVE_AVX2 1
+#    include <immintrin.h>
+#else
+#    define OPAL_CRC_HAVE_AVX2 0
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#    define OPAL_CRC_HAVE_NEON 1
+#    include <arm_neon.h>
+#else
+#    define OPAL_CRC_HAVE_NEON 0
+#endif
+
+/* below this number of words the vector kernels are not worth it */
+#define OPAL_CRC_VECTOR_MIN_WORDS 16
+
+#define OPAL_CRC_GENERIC_KERNELS(TYPE, NAME)                                                 \
+    static TYPE opal_crc_copy_sum_##NAME##_generic(TYPE *dest, const TYPE *src, size_t count) \
+    {                                                                                        \
+        TYPE s0 = 0, s1 = 0, s2 = 0, s3 = 0, w[4];                                           \
+        size_t i = 0;                                                                        \
+        for (; (i + 4) <= count; i += 4) {                                                   \
+            memcpy(w, src + i, sizeof(w));                                                   \
+            memcpy(dest + i, w, sizeof(w));                                                  \
+            s0 += w[0];                                                                      \
+            s1 += w[1];                                                                      \
+            s2 += w[2];                                                                      \
+            s3 += w[3];                                                                      \
+        }                                                                                    \
+        for (; i < count; i++) {                                                             \
+            memcpy(w, src + i, sizeof(TYPE));                                                \
+            memcpy(dest + i, w, sizeof(TYPE));                                               \
+            s0 += w[0];                                                                      \
+        }                                                                                    \
+        return s0 + s1 + s2 + s3;                                                            \
+    }                                                                                        \
+                                                                                             \
+    static TYPE opal_crc_sum_##NAME##_generic(const TYPE *src, size_t count)                 \
+    {                                                                                        \
+        TYPE s0 = 0, s1 = 0, s2 = 0, s3 = 0, w[4];                                           \
+        size_t i = 0;                                                                        \
+        for (; (i + 4) <= count; i += 4) {                                                   \
+            memcpy(w, src + i, sizeof(w));                                                   \
+            s0 += w[0];                                                                      \
+            s1 += w[1];                                                                      \
+            s2 += w[2];                                                                      \
+            s3 += w[3];                                                                      \
+        }                                                                                    \
+        for (; i < count; i++) {                                                             \
+            memcpy(w, src + i, sizeof(TYPE));                                                \
+            s0 += w[0];                                                                      \
+        }                                                                                    \
+        return s0 + s1 + s2 + s3;                                                            \
+    }
+
+OPAL_CRC_GENERIC_KERNELS(unsigned int, int)
+OPAL_CRC_GENERIC_KERNELS(unsigned long, long)
+
+#if OPAL_CRC_HAVE_AVX2
+/* ADD is the lane addition for the size of TYPE */
+#    define OPAL_CRC_AVX2_KERNELS(TYPE, NAME, ADD)                                             \
+        __attribute__((target("avx2"))) static TYPE                                           \
+        opal_crc_fold_##NAME##_avx2(__m256i acc)                                              \
+        {                                                                                     \
+            TYPE lanes[sizeof(__m256i) / sizeof(TYPE)], sum = 0;                              \
+            _mm256_storeu_si256((__m256i *) lanes, acc);                                      \
+            for (size_t l = 0; l < (sizeof(__m256i) / sizeof(TYPE)); l++) {                   \
+                sum += lanes[l];                                                              \
+            }                                                                                 \
+            return sum;                                                                       \
+        }                                                                                     \
+                                                                                              \
+        __attribute__((target("avx2"))) static TYPE                                           \
+        opal_crc_copy_sum_##NAME##_avx2(TYPE *dest, const TYPE *src, size_t count)            \
+        {                                                                                     \
+            const size_t step = 2 * sizeof(__m256i) / sizeof(TYPE);                           \
+            __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();             \
+            size_t i = 0;                                                                     \
+            for (; (i + step) <= count; i += step) {                                          \
+                __m256i v0 = _mm256_loadu_si256((const __m256i *) (src + i));                 \
+                __m256i v1 = _mm256_loadu_si256((const __m256i *) (src + i + step / 2));      \
+                _mm256_storeu_si256((__m256i *) (dest + i), v0);                              \
+                _mm256_storeu_si256((__m256i *) (dest + i + step / 2), v1);                   \
+                acc0 = ADD(acc0, v0);                                                         \
+                acc1 = ADD(acc1, v1);                                                         \
+            }                                                                                 \
+            return opal_crc_fold_##NAME##_avx2(ADD(acc0, acc1))                               \
+                   + opal_crc_copy_sum_##NAME##_generic(dest + i, src + i, count - i);        \
+        }                                                                                     \
+                                                                                              \
+        __attribute__((target("avx2"))) static TYPE                                           \
+        opal_crc_sum_##NAME##_avx2(const TYPE *src, size_t count)                             \
+        {                                                                                     \
+            const size_t step = 2 * sizeof(__m256i) / sizeof(TYPE);                           \
+            __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();             \
+            size_t i = 0;                                                                     \
+            for (; (i + step) <= count; i += step) {                                          \
+                acc0 = ADD(acc0, _mm256_loadu_si256((const __m256i *) (src + i)));            \
+                acc1 = ADD(acc1, _mm256_loadu_si256((const __m256i *) (src + i + step / 2))); \
+            }                                                                                 \
+            return opal_crc_fold_##NAME##_avx2(ADD(acc0, acc1))                               \
+                   + opal_crc_sum_##NAME##_generic(src + i, count - i);                       \
+        }
+
+OPAL_CRC_AVX2_KERNELS(unsigned int, int, _mm256_add_epi32)
+OPAL_CRC_AVX2_KERNELS(unsigned long, long, _mm256_add_epi64)
+
+static int opal_crc_avx2_usable = -1;
+
+static inline bool opal_crc_use_avx2(size_t count)
+{
+    if (count < OPAL_CRC_VECTOR_MIN_WORDS) {
+        return false;
+    }
+    if (opal_crc_avx2_usable < 0) {
+        /* also checks that the OS saves the AVX state */
+        opal_crc_avx2_usable = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return (1 == opal_crc_avx2_usable);
+}
+#endif /* OPAL_CRC_HAVE_AVX2 */
+
+#if OPAL_CRC_HAVE_NEON
+/* VTYPE, LOAD, STORE, ADD and FOLD are the NEON type and operations for
+ * 128 bits of ETYPE, the element type of the same size as TYPE */
+#    define OPAL_CRC_NEON_KERNELS(TYPE, NAME, ETYPE, VTYPE, LOAD, STORE, ADD, DUP, FOLD)  \
+        static TYPE opal_crc_copy_sum_##NAME##_neon(TYPE *dest, const TYPE *src,           \
+                                                    size_t count)                          \
+        {                                                                                  \
+            const size_t step = 2 * 16 / sizeof(TYPE);                                     \
+            VTYPE acc0 = DUP(0), acc1 = DUP(0);                                            \
+            size_t i = 0;                                                                  \
+            for (; (i + step) <= count; i += step) {                                       \
+                VTYPE v0 = LOAD((const ETYPE *) (src + i));                                \
+                VTYPE v1 = LOAD((const ETYPE *) (src + i + step / 2));                     \
+                STORE((ETYPE *) (dest + i), v0);                                           \
+                STORE((ETYPE *) (dest + i + step / 2), v1);                                \
+                acc0 = ADD(acc0, v0);                                                      \
+                acc1 = ADD(acc1, v1);                                                      \
+            }                                                                              \
+            return (TYPE) FOLD(ADD(acc0, acc1))                                            \
+                   + opal_crc_copy_sum_##NAME##_generic(dest + i, src + i, count - i);     \
+        }                                                                                  \
+                                                                                           \
+        static TYPE opal_crc_sum_##NAME##_neon(const TYPE *src, size_t count)              \
+        {                                                                                  \
+            const size_t step = 2 * 16 / sizeof(TYPE);                                     \
+            VTYPE acc0 = DUP(0), acc1 = DUP(0);                                            \
+            size_t i = 0;                                                                  \
+            for (; (i + step) <= count; i += step) {                                       \
+                acc0 = ADD(acc0, LOAD((const ETYPE *) (src + i)));                         \
+                acc1 = ADD(acc1, LOAD((const ETYPE *) (src + i + step / 2)));              \
+            }                                                                              \
+            return (TYPE) FOLD(ADD(acc0, acc1))                                            \
+                   + opal_crc_sum_##NAME##_generic(src + i, count - i);                    \
+        }
+
+OPAL_CRC_NEON_KERNELS(unsigned int, int, uint32_t, uint32x4_t, vld1q_u32, vst1q_u32, vaddq_u32,
+                      vdupq_n_u32, vaddvq_u32)
+OPAL_CRC_NEON_KERNELS(unsigned long, long, uint64_t, uint64x2_t, vld1q_u64, vst1q_u64, vaddq_u64,
+                      vdupq_n_u64, vaddvq_u64)
+#endif /* OPAL_CRC_HAVE_NEON */
+
+#if OPAL_CRC_HAVE_AVX2
+#    define OPAL_CRC_USE_VECTOR(COUNT) opal_crc_use_avx2(COUNT)
+#    define OPAL_CRC_VECTOR(FN)        FN##_avx2
+#elif OPAL_CRC_HAVE_NEON
+#    define OPAL_CRC_USE_VECTOR(COUNT) ((COUNT) >= OPAL_CRC_VECTOR_MIN_WORDS)
+#    define OPAL_CRC_VECTOR(FN)        FN##_neon
+#else
+#    define OPAL_CRC_USE_VECTOR(COUNT) false
+#    define OPAL_CRC_VECTOR(FN)        FN##_generic
+#endif
+
+/* The entry points, they advance the pointers past the count words */
+#define OPAL_CRC_KERNELS(TYPE, NAME)                                                   \
+    static inline TYPE opal_crc_copy_sum_##NAME(TYPE **dest, TYPE **src, size_t count) \
+    {                                                                                  \
+        TYPE sum;                                                                      \
+        if (OPAL_CRC_USE_VECTOR(count)) {                                              \
+            sum = OPAL_CRC_VECTOR(opal_crc_copy_sum_##NAME)(*dest, *src, count);       \
+        } else {                                                                       \
+            sum = opal_crc_copy_sum_##NAME##_generic(*dest, *src, count);              \
+        }                                                                              \
+        *dest += count;                                                                \
+        *src += count;                                                                 \
+        return sum;                                                                    \
+    }                                                                                  \
+                                                                                       \
+    static inline TYPE opal_crc_sum_##NAME(TYPE **src, size_t count)                   \
+    {                                                                                  \
+        TYPE sum;                                                                      \
+        if (OPAL_CRC_USE_VECTOR(count)) {                                              \
+            sum = OPAL_CRC_VECTOR(opal_crc_sum_##NAME)(*src, count);                   \
+        } else {                                                                       \
+            sum = opal_crc_sum_##NAME##_generic(*src, count);                          \
+        }                                                                              \
+        *src += count;                                                                 \
+        return sum;                                                                    \
+    }
+
+OPAL_CRC_KERNELS(unsigned int, int)
+OPAL_CRC_KERNELS(unsigned long, long)
+
 /*
  * this version of bcopy_csum() looks a little too long, but it
  * handles cumulative checksumming for arbitrary lengths and address
@@ -80,13 +294,8 @@ unsigned long opal_bcopy_csum_partial(const void *source, void *destination, siz
                 csum += (temp - *lastPartialLong);
                 copylen -= sizeof(unsigned long) - *lastPartialLength;
                 /* now we have an unaligned source and an unaligned destination */
-                for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                    memcpy(&temp, src, sizeof(temp));
-                    src++;
-                    csum += temp;
-                    memcpy(dest, &temp, sizeof(temp));
-                    dest++;
-                }
+                csum += opal_crc_copy_sum_long(&dest, &src, copylen / sizeof(*src));
+                copylen %= sizeof(*src);
                 *lastPartialLength = 0;
                 *lastPartialLong = 0;
             } else { /* NO, we don't... */
@@ -101,10 +310,8 @@ unsigned long opal_bcopy_csum_partial(const void *source, void *destination, siz
             }
         } else { /* fast path... */
             size_t numLongs = copylen / sizeof(unsigned long);
-            for (i = 0; i < numLongs; i++) {
-                csum += *src;
-                *dest++ = *src++;
-            }
+            i = numLongs;
+            csum += opal_crc_copy_sum_long(&dest, &src, i);
             *lastPartialLong = 0;
             *lastPartialLength = 0;
             if (WORDALIGNED(copylen) && (csumlenresidue == 0)) {
@@ -127,24 +334,8 @@ unsigned long opal_bcopy_csum_partial(const void *source, void *destination, siz
                 csum += (temp - *lastPartialLong);
                 copylen -= sizeof(unsigned long) - *lastPartialLength;
                 /* now we have an unaligned source and an unknown alignment for our destination */
-                if (WORDALIGNED(dest)) {
-                    size_t numLongs = copylen / sizeof(unsigned long);
-                    for (i = 0; i < numLongs; i++) {
-                        memcpy(&temp, src, sizeof(temp));
-                        src++;
-                        csum += temp;
-                        *dest++ = temp;
-                    }
-                    copylen -= i * sizeof(unsigned long);
-                } else {
-                    for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                        memcpy(&temp, src, sizeof(temp));
-                        src++;
-                        csum += temp;
-                        memcpy(dest, &temp, sizeof(temp));
-                        dest++;
-                    }
-                }
+                csum += opal_crc_copy_sum_long(&dest, &src, copylen / sizeof(*src));
+                copylen %= sizeof(*src);
                 *lastPartialLong = 0;
                 *lastPartialLength = 0;
             } else { /* NO, we don't... */
@@ -158,12 +349,8 @@ unsigned long opal_bcopy_csum_partial(const void *source, void *destination, siz
                 copylen = 0;
             }
         } else {
-            for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                temp = *src++;
-                csum += temp;
-                memcpy(dest, &temp, sizeof(temp));
-                dest++;
-            }
+            csum += opal_crc_copy_sum_long(&dest, &src, copylen / sizeof(*src));
+            copylen %= sizeof(*src);
             *lastPartialLong = 0;
             *lastPartialLength = 0;
         }
@@ -181,26 +368,10 @@ unsigned long opal_bcopy_csum_partial(const void *source, void *destination, siz
                 csum += (temp - *lastPartialLong);
                 copylen -= sizeof(unsigned long) - *lastPartialLength;
                 /* now we have a source of unknown alignment and a unaligned destination */
-                if (WORDALIGNED(src)) {
-                    for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                        temp = *src++;
-                        csum += temp;
-                        memcpy(dest, &temp, sizeof(temp));
-                        dest++;
-                    }
-                    *lastPartialLong = 0;
-                    *lastPartialLength = 0;
-                } else {
-                    for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                        memcpy(&temp, src, sizeof(temp));
-                        src++;
-                        csum += temp;
-                        memcpy(dest, &temp, sizeof(temp));
-                        dest++;
-                    }
-                    *lastPartialLength = 0;
-                    *lastPartialLong = 0;
-                }
+                csum += opal_crc_copy_sum_long(&dest, &src, copylen / sizeof(*src));
+                copylen %= sizeof(*src);
+                *lastPartialLong = 0;
+                *lastPartialLength = 0;
             } else { /* NO, we don't... */
                 memcpy(((char *) &temp + *lastPartialLength), src, copylen);
                 memcpy(dest, ((char *) &temp + *lastPartialLength), copylen);
@@ -212,12 +383,8 @@ unsigned long opal_bcopy_csum_partial(const void *source, void *destination, siz
                 copylen = 0;
             }
         } else {
-            for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                memcpy(&temp, src, sizeof(temp));
-                src++;
-                csum += temp;
-                *dest++ = temp;
-            }
+            csum += opal_crc_copy_sum_long(&dest, &src, copylen / sizeof(*src));
+            copylen %= sizeof(*src);
             *lastPartialLength = 0;
             *lastPartialLong = 0;
         }
@@ -235,22 +402,8 @@ unsigned long opal_bcopy_csum_partial(const void *source, void *destination, siz
                 csum += (temp - *lastPartialLong);
                 copylen -= sizeof(unsigned long) - *lastPartialLength;
                 /* now we have an unknown alignment for our source and destination */
-                if (WORDALIGNED(src) && WORDALIGNED(dest)) {
-                    size_t numLongs = copylen / sizeof(unsigned long);
-                    for (i = 0; i < numLongs; i++) {
-                        csum += *src;
-                        *dest++ = *src++;
-                    }
-                    copylen -= i * sizeof(unsigned long);
-                } else { /* safe but slower for all other alignments */
-                    for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                        memcpy(&temp, src, sizeof(temp));
-                        src++;
-                        csum += temp;
-                        memcpy(dest, &temp, sizeof(temp));
-                        dest++;
-                    }
-                }
+                csum += opal_crc_copy_sum_long(&dest, &src, copylen / sizeof(*src));
+                copylen %= sizeof(*src);
                 *lastPartialLong = 0;
                 *lastPartialLength = 0;
             } else { /* NO, we don't... */
@@ -264,13 +417,8 @@ unsigned long opal_bcopy_csum_partial(const void *source, void *destination, siz
                 copylen = 0;
             }
         } else {
-            for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                memcpy(&temp, src, sizeof(temp));
-                src++;
-                csum += temp;
-                memcpy(dest, &temp, sizeof(temp));
-                dest++;
-            }
+            csum += opal_crc_copy_sum_long(&dest, &src, copylen / sizeof(*src));
+            copylen %= sizeof(*src);
             *lastPartialLength = 0;
             *lastPartialLong = 0;
         }
@@ -356,17 +504,8 @@ unsigned long opal_bcopy_csum_partial(const void *source, void *destination, siz
             *lastPartialLength = 0;
             *lastPartialLong = 0;
         }
-        if (WORDALIGNED(src)) {
-            for (i = 0; i < csumlenresidue / sizeof(unsigned long); i++) {
-                csum += *src++;
-            }
-        } else {
-            for (i = 0; i < csumlenresidue / sizeof(unsigned long); i++) {
-                memcpy(&temp, src, sizeof(temp));
-                csum += temp;
-                src++;
-            }
-        }
+        i = csumlenresidue / sizeof(unsigned long);
+        csum += opal_crc_sum_long(&src, i);
         csumlenresidue -= i * sizeof(unsigned long);
         if (csumlenresidue) {
             temp = 0;
@@ -407,13 +546,8 @@ unsigned int opal_bcopy_uicsum_partial(const void *source, void *destination, si
                 csum += (temp - *lastPartialInt);
                 copylen -= sizeof(unsigned int) - *lastPartialLength;
                 /* now we have an unaligned source and an unaligned destination */
-                for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                    memcpy(&temp, src, sizeof(temp));
-                    src++;
-                    csum += temp;
-                    memcpy(dest, &temp, sizeof(temp));
-                    dest++;
-                }
+                csum += opal_crc_copy_sum_int(&dest, &src, copylen / sizeof(*src));
+                copylen %= sizeof(*src);
                 *lastPartialLength = 0;
                 *lastPartialInt = 0;
             } else { /* NO, we don't... */
@@ -428,10 +562,8 @@ unsigned int opal_bcopy_uicsum_partial(const void *source, void *destination, si
             }
         } else { /* fast path... */
             size_t numLongs = copylen / sizeof(unsigned int);
-            for (i = 0; i < numLongs; i++) {
-                csum += *src;
-                *dest++ = *src++;
-            }
+            i = numLongs;
+            csum += opal_crc_copy_sum_int(&dest, &src, i);
             *lastPartialInt = 0;
             *lastPartialLength = 0;
             if (INTALIGNED(copylen) && (csumlenresidue == 0)) {
@@ -453,24 +585,8 @@ unsigned int opal_bcopy_uicsum_partial(const void *source, void *destination, si
                 csum += (temp - *lastPartialInt);
                 copylen -= sizeof(unsigned int) - *lastPartialLength;
                 /* now we have an unaligned source and an unknown alignment for our destination */
-                if (INTALIGNED(dest)) {
-                    size_t numLongs = copylen / sizeof(unsigned int);
-                    for (i = 0; i < numLongs; i++) {
-                        memcpy(&temp, src, sizeof(temp));
-                        src++;
-                        csum += temp;
-                        *dest++ = temp;
-                    }
-                    copylen -= i * sizeof(unsigned int);
-                } else {
-                    for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                        memcpy(&temp, src, sizeof(temp));
-                        src++;
-                        csum += temp;
-                        memcpy(dest, &temp, sizeof(temp));
-                        dest++;
-                    }
-                }
+                csum += opal_crc_copy_sum_int(&dest, &src, copylen / sizeof(*src));
+                copylen %= sizeof(*src);
                 *lastPartialInt = 0;
                 *lastPartialLength = 0;
             } else { /* NO, we don't... */
@@ -484,12 +600,8 @@ unsigned int opal_bcopy_uicsum_partial(const void *source, void *destination, si
                 copylen = 0;
             }
         } else {
-            for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                temp = *src++;
-                csum += temp;
-                memcpy(dest, &temp, sizeof(temp));
-                dest++;
-            }
+            csum += opal_crc_copy_sum_int(&dest, &src, copylen / sizeof(*src));
+            copylen %= sizeof(*src);
             *lastPartialInt = 0;
             *lastPartialLength = 0;
         }
@@ -506,26 +618,10 @@ unsigned int opal_bcopy_uicsum_partial(const void *source, void *destination, si
                 csum += (temp - *lastPartialInt);
                 copylen -= sizeof(unsigned int) - *lastPartialLength;
                 /* now we have a source of unknown alignment and a unaligned destination */
-                if (INTALIGNED(src)) {
-                    for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                        temp = *src++;
-                        csum += temp;
-                        memcpy(dest, &temp, sizeof(temp));
-                        dest++;
-                    }
-                    *lastPartialInt = 0;
-                    *lastPartialLength = 0;
-                } else {
-                    for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                        memcpy(&temp, src, sizeof(temp));
-                        src++;
-                        csum += temp;
-                        memcpy(dest, &temp, sizeof(temp));
-                        dest++;
-                    }
-                    *lastPartialLength = 0;
-                    *lastPartialInt = 0;
-                }
+                csum += opal_crc_copy_sum_int(&dest, &src, copylen / sizeof(*src));
+                copylen %= sizeof(*src);
+                *lastPartialInt = 0;
+                *lastPartialLength = 0;
             } else { /* NO, we don't... */
                 memcpy(((char *) &temp + *lastPartialLength), src, copylen);
                 memcpy(dest, ((char *) &temp + *lastPartialLength), copylen);
@@ -537,12 +633,8 @@ unsigned int opal_bcopy_uicsum_partial(const void *source, void *destination, si
                 copylen = 0;
             }
         } else {
-            for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                memcpy(&temp, src, sizeof(temp));
-                src++;
-                csum += temp;
-                *dest++ = temp;
-            }
+            csum += opal_crc_copy_sum_int(&dest, &src, copylen / sizeof(*src));
+            copylen %= sizeof(*src);
             *lastPartialLength = 0;
             *lastPartialInt = 0;
         }
@@ -559,22 +651,8 @@ unsigned int opal_bcopy_uicsum_partial(const void *source, void *destination, si
                 csum += (temp - *lastPartialInt);
                 copylen -= sizeof(unsigned int) - *lastPartialLength;
                 /* now we have an unknown alignment for our source and destination */
-                if (INTALIGNED(src) && INTALIGNED(dest)) {
-                    size_t numLongs = copylen / sizeof(unsigned int);
-                    for (i = 0; i < numLongs; i++) {
-                        csum += *src;
-                        *dest++ = *src++;
-                    }
-                    copylen -= i * sizeof(unsigned int);
-                } else { /* safe but slower for all other alignments */
-                    for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                        memcpy(&temp, src, sizeof(temp));
-                        src++;
-                        csum += temp;
-                        memcpy(dest, &temp, sizeof(temp));
-                        dest++;
-                    }
-                }
+                csum += opal_crc_copy_sum_int(&dest, &src, copylen / sizeof(*src));
+                copylen %= sizeof(*src);
                 *lastPartialInt = 0;
                 *lastPartialLength = 0;
             } else { /* NO, we don't... */
@@ -588,13 +666,8 @@ unsigned int opal_bcopy_uicsum_partial(const void *source, void *destination, si
                 copylen = 0;
             }
         } else {
-            for (; copylen >= sizeof(*src); copylen -= sizeof(*src)) {
-                memcpy(&temp, src, sizeof(temp));
-                src++;
-                csum += temp;
-                memcpy(dest, &temp, sizeof(temp));
-                dest++;
-            }
+            csum += opal_crc_copy_sum_int(&dest, &src, copylen / sizeof(*src));
+            copylen %= sizeof(*src);
             *lastPartialLength = 0;
             *lastPartialInt = 0;
         }
@@ -683,17 +756,8 @@ unsigned int opal_bcopy_uicsum_partial(const void *source, void *destination, si
             *lastPartialLength = 0;
             *lastPartialInt = 0;
         }
-        if (INTALIGNED(src)) {
-            for (i = 0; i < csumlenresidue / sizeof(unsigned int); i++) {
-                csum += *src++;
-            }
-        } else {
-            for (i = 0; i < csumlenresidue / sizeof(unsigned int); i++) {
-                memcpy(&temp, src, sizeof(temp));
-                csum += temp;
-                src++;
-            }
-        }
+        i = csumlenresidue / sizeof(unsigned int);
+        csum += opal_crc_sum_int(&src, i);
         csumlenresidue -= i * sizeof(unsigned int);
         if (csumlenresidue) {
             temp = 0;
@@ -731,11 +795,8 @@ unsigned long opal_csum_partial(const void *source, size_t csumlen, unsigned lon
                 csum += (temp - *lastPartialLong);
                 csumlen -= sizeof(unsigned long) - *lastPartialLength;
                 /* now we have an unaligned source */
-                for (i = 0; i < csumlen / sizeof(unsigned long); i++) {
-                    memcpy(&temp, src, sizeof(temp));
-                    csum += temp;
-                    src++;
-                }
+                i = csumlen / sizeof(unsigned long);
+                csum += opal_crc_sum_long(&src, i);
                 csumlen -= i * sizeof(unsigned long);
                 *lastPartialLong = 0;
                 *lastPartialLength = 0;
@@ -749,9 +810,8 @@ unsigned long opal_csum_partial(const void *source, size_t csumlen, unsigned lon
             }
         } else { /* fast path... */
             size_t numLongs = csumlen / sizeof(unsigned long);
-            for (i = 0; i < numLongs; i++) {
-                csum += *src++;
-            }
+            i = numLongs;
+            csum += opal_crc_sum_long(&src, i);
             *lastPartialLong = 0;
             *lastPartialLength = 0;
             if (WORDALIGNED(csumlen)) {
@@ -770,23 +830,11 @@ unsigned long opal_csum_partial(const void *source, size_t csumlen, unsigned lon
                 csum += (temp - *lastPartialLong);
                 csumlen -= sizeof(unsigned long) - *lastPartialLength;
                 /* now we have a source of unknown alignment */
-                if (WORDALIGNED(src)) {
-                    for (i = 0; i < csumlen / sizeof(unsigned long); i++) {
-                        csum += *src++;
-                    }
-                    csumlen -= i * sizeof(unsigned long);
-                    *lastPartialLong = 0;
-                    *lastPartialLength = 0;
-                } else {
-                    for (i = 0; i < csumlen / sizeof(unsigned long); i++) {
-                        memcpy(&temp, src, sizeof(temp));
-                        csum += temp;
-                        src++;
-                    }
-                    csumlen -= i * sizeof(unsigned long);
-                    *lastPartialLong = 0;
-                    *lastPartialLength = 0;
-                }
+                i = csumlen / sizeof(unsigned long);
+                csum += opal_crc_sum_long(&src, i);
+                csumlen -= i * sizeof(unsigned long);
+                *lastPartialLong = 0;
+                *lastPartialLength = 0;
             } else { /* NO, we don't... */
                 memcpy(((char *) &temp + *lastPartialLength), src, csumlen);
                 src = (unsigned long *) ((char *) src + csumlen);
@@ -796,11 +844,8 @@ unsigned long opal_csum_partial(const void *source, size_t csumlen, unsigned lon
                 csumlen = 0;
             }
         } else {
-            for (; csumlen >= sizeof(*src); csumlen -= sizeof(*src)) {
-                memcpy(&temp, src, sizeof(temp));
-                src++;
-                csum += temp;
-            }
+            csum += opal_crc_sum_long(&src, csumlen / sizeof(*src));
+            csumlen %= sizeof(*src);
             *lastPartialLength = 0;
             *lastPartialLong = 0;
         }
@@ -866,11 +911,8 @@ unsigned int opal_uicsum_partial(const void *source, size_t csumlen, unsigned in
                 csum += (temp - *lastPartialInt);
                 csumlen -= sizeof(unsigned int) - *lastPartialLength;
                 /* now we have an unaligned source */
-                for (i = 0; i < csumlen / sizeof(unsigned int); i++) {
-                    memcpy(&temp, src, sizeof(temp));
-                    csum += temp;
-                    src++;
-                }
+                i = csumlen / sizeof(unsigned int);
+                csum += opal_crc_sum_int(&src, i);
                 csumlen -= i * sizeof(unsigned int);
                 *lastPartialInt = 0;
                 *lastPartialLength = 0;
@@ -884,9 +926,8 @@ unsigned int opal_uicsum_partial(const void *source, size_t csumlen, unsigned in
             }
         } else { /* fast path... */
             size_t numLongs = csumlen / sizeof(unsigned int);
-            for (i = 0; i < numLongs; i++) {
-                csum += *src++;
-            }
+            i = numLongs;
+            csum += opal_crc_sum_int(&src, i);
             *lastPartialInt = 0;
             *lastPartialLength = 0;
             if (INTALIGNED(csumlen)) {
@@ -905,23 +946,11 @@ unsigned int opal_uicsum_partial(const void *source, size_t csumlen, unsigned in
                 csum += (temp - *lastPartialInt);
                 csumlen -= sizeof(unsigned int) - *lastPartialLength;
                 /* now we have a source of unknown alignment */
-                if (INTALIGNED(src)) {
-                    for (i = 0; i < csumlen / sizeof(unsigned int); i++) {
-                        csum += *src++;
-                    }
-                    csumlen -= i * sizeof(unsigned int);
-                    *lastPartialInt = 0;
-                    *lastPartialLength = 0;
-                } else {
-                    for (i = 0; i < csumlen / sizeof(unsigned int); i++) {
-                        memcpy(&temp, src, sizeof(temp));
-                        csum += temp;
-                        src++;
-                    }
-                    csumlen -= i * sizeof(unsigned int);
-                    *lastPartialInt = 0;
-                    *lastPartialLength = 0;
-                }
+                i = csumlen / sizeof(unsigned int);
+                csum += opal_crc_sum_int(&src, i);
+                csumlen -= i * sizeof(unsigned int);
+                *lastPartialInt = 0;
+                *lastPartialLength = 0;
             } else { /* NO, we don't... */
                 memcpy(((char *) &temp + *lastPartialLength), src, csumlen);
                 src = (unsigned int *) ((char *) src + csumlen);
@@ -931,11 +960,8 @@ unsigned int opal_uicsum_partial(const void *source, size_t csumlen, unsigned in
                 csumlen = 0;
             }
         } else {
-            for (; csumlen >= sizeof(*src); csumlen -= sizeof(*src)) {
-                memcpy(&temp, src, sizeof(temp));
-                src++;
-                csum += temp;
-            }
+            csum += opal_crc_sum_int(&src, csumlen / sizeof(*src));
+            csumlen %= sizeof(*src);
             *lastPartialLength = 0;
             *lastPartialInt = 0;
         }
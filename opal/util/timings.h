@@ -58,16 +58,15 @@ opal_timing_ts_func_t opal_timing_ts_func(opal_timer_type_t type);
                 (_nm)->error = 1;                                                 \
             }                                                                     \
             ptr = getenv((_nm)->id);                                              \
-            if (NULL == ptr || strcmp(ptr, "1")) {                                \
-                (_nm)->enabled = 0;                                               \
-            }                                                                     \
+            (_nm)->enabled = (NULL != ptr && 0 == strcmp(ptr, "1"));              \
             (_nm)->get_ts = opal_timing_ts_func(type);                            \
             ptr = getenv("OPAL_TIMING_ENABLE");                                   \
             if (NULL != ptr) {                                                    \
                 (_nm)->enabled = atoi(ptr);                                       \
             }                                                                     \
+            /* carry on after the measurements of the previous calls */           \
             (_nm)->cntr = 0;                                                      \
-            ptr = getenv((_nm)->id);                                              \
+            ptr = getenv((_nm)->cntr_env);                                        \
             if (NULL != ptr) {                                                    \
                 (_nm)->cntr = atoi(ptr);                                          \
             }                                                                     \
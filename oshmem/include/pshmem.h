@@ -70,6 +70,24 @@ OSHMEM_DECLSPEC  void *pshmem_ptr(const void *ptr, int pe);
 OSHMEM_DECLSPEC int pshmem_ctx_create(long options, shmem_ctx_t *ctx);
 OSHMEM_DECLSPEC void pshmem_ctx_destroy(shmem_ctx_t ctx);
 
+/*
+ * Team management routines
+ */
+OSHMEM_DECLSPEC int pshmem_team_my_pe(shmem_team_t team);
+OSHMEM_DECLSPEC int pshmem_team_n_pes(shmem_team_t team);
+OSHMEM_DECLSPEC int pshmem_team_get_config(shmem_team_t team, long config_mask, shmem_team_config_t *config);
+OSHMEM_DECLSPEC int pshmem_team_translate_pe(shmem_team_t src_team, int src_pe, shmem_team_t dest_team);
+OSHMEM_DECLSPEC int pshmem_team_split_strided(shmem_team_t parent_team, int start, int stride, int size,
+                                              const shmem_team_config_t *config, long config_mask,
+                                              shmem_team_t *new_team);
+OSHMEM_DECLSPEC int pshmem_team_split_2d(shmem_team_t parent_team, int xrange,
+                                         const shmem_team_config_t *xaxis_config, long xaxis_mask,
+                                         shmem_team_t *xaxis_team,
+                                         const shmem_team_config_t *yaxis_config, long yaxis_mask,
+                                         shmem_team_t *yaxis_team);
+OSHMEM_DECLSPEC void pshmem_team_destroy(shmem_team_t team);
+OSHMEM_DECLSPEC int pshmem_team_sync(shmem_team_t team);
+
 /*
  * Elemental put routines
  */
@@ -1508,6 +1526,514 @@ OSHMEM_DECLSPEC void pshmem_longlong_inc(long long *target, int pe);
             long long*:   pshmem_longlong_inc)(dst, pe)
 #endif
 
+/* Non-blocking fetching atomics, the fetched value is available after quiet */
+
+/* Atomic Fetch (non-blocking) */
+OSHMEM_DECLSPEC void pshmem_ctx_int_atomic_fetch_nbi(shmem_ctx_t ctx, int *fetch, const int *source, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_long_atomic_fetch_nbi(shmem_ctx_t ctx, long *fetch, const long *source, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_longlong_atomic_fetch_nbi(shmem_ctx_t ctx, long long *fetch, const long long *source, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint_atomic_fetch_nbi(shmem_ctx_t ctx, unsigned int *fetch, const unsigned int *source, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulong_atomic_fetch_nbi(shmem_ctx_t ctx, unsigned long *fetch, const unsigned long *source, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulonglong_atomic_fetch_nbi(shmem_ctx_t ctx, unsigned long long *fetch, const unsigned long long *source, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_float_atomic_fetch_nbi(shmem_ctx_t ctx, float *fetch, const float *source, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_double_atomic_fetch_nbi(shmem_ctx_t ctx, double *fetch, const double *source, int pe);
+
+OSHMEM_DECLSPEC void pshmem_int_atomic_fetch_nbi(int *fetch, const int *source, int pe);
+OSHMEM_DECLSPEC void pshmem_long_atomic_fetch_nbi(long *fetch, const long *source, int pe);
+OSHMEM_DECLSPEC void pshmem_longlong_atomic_fetch_nbi(long long *fetch, const long long *source, int pe);
+OSHMEM_DECLSPEC void pshmem_uint_atomic_fetch_nbi(unsigned int *fetch, const unsigned int *source, int pe);
+OSHMEM_DECLSPEC void pshmem_ulong_atomic_fetch_nbi(unsigned long *fetch, const unsigned long *source, int pe);
+OSHMEM_DECLSPEC void pshmem_ulonglong_atomic_fetch_nbi(unsigned long long *fetch, const unsigned long long *source, int pe);
+OSHMEM_DECLSPEC void pshmem_float_atomic_fetch_nbi(float *fetch, const float *source, int pe);
+OSHMEM_DECLSPEC void pshmem_double_atomic_fetch_nbi(double *fetch, const double *source, int pe);
+#if OSHMEM_HAVE_C11
+#define pshmem_atomic_fetch_nbi(...)                                          \
+    _Generic(&*(__OSHMEM_VAR_ARG1(__VA_ARGS__)),                              \
+            shmem_ctx_t:  _Generic((__OSHMEM_VAR_ARG2(__VA_ARGS__)),          \
+                int*:                pshmem_ctx_int_atomic_fetch_nbi,         \
+                long*:               pshmem_ctx_long_atomic_fetch_nbi,        \
+                long long*:          pshmem_ctx_longlong_atomic_fetch_nbi,    \
+                unsigned int*:       pshmem_ctx_uint_atomic_fetch_nbi,        \
+                unsigned long*:      pshmem_ctx_ulong_atomic_fetch_nbi,       \
+                unsigned long long*: pshmem_ctx_ulonglong_atomic_fetch_nbi,   \
+                float*:              pshmem_ctx_float_atomic_fetch_nbi,       \
+                double*:             pshmem_ctx_double_atomic_fetch_nbi,      \
+                default:             __oshmem_datatype_ignore),               \
+            int*:                pshmem_int_atomic_fetch_nbi,                 \
+            long*:               pshmem_long_atomic_fetch_nbi,                \
+            long long*:          pshmem_longlong_atomic_fetch_nbi,            \
+            unsigned int*:       pshmem_uint_atomic_fetch_nbi,                \
+            unsigned long*:      pshmem_ulong_atomic_fetch_nbi,               \
+            unsigned long long*: pshmem_ulonglong_atomic_fetch_nbi,           \
+            float*:              pshmem_float_atomic_fetch_nbi,               \
+            double*:             pshmem_double_atomic_fetch_nbi)(__VA_ARGS__)
+#endif
+
+/* Atomic conditional swap (non-blocking) */
+OSHMEM_DECLSPEC void pshmem_ctx_int_atomic_compare_swap_nbi(shmem_ctx_t ctx, int *fetch, int *target, int cond, int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_long_atomic_compare_swap_nbi(shmem_ctx_t ctx, long *fetch, long *target, long cond, long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_longlong_atomic_compare_swap_nbi(shmem_ctx_t ctx, long long *fetch, long long *target, long long cond, long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint_atomic_compare_swap_nbi(shmem_ctx_t ctx, unsigned int *fetch, unsigned int *target, unsigned int cond, unsigned int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulong_atomic_compare_swap_nbi(shmem_ctx_t ctx, unsigned long *fetch, unsigned long *target, unsigned long cond, unsigned long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulonglong_atomic_compare_swap_nbi(shmem_ctx_t ctx, unsigned long long *fetch, unsigned long long *target, unsigned long long cond, unsigned long long value, int pe);
+
+OSHMEM_DECLSPEC void pshmem_int_atomic_compare_swap_nbi(int *fetch, int *target, int cond, int value, int pe);
+OSHMEM_DECLSPEC void pshmem_long_atomic_compare_swap_nbi(long *fetch, long *target, long cond, long value, int pe);
+OSHMEM_DECLSPEC void pshmem_longlong_atomic_compare_swap_nbi(long long *fetch, long long *target, long long cond, long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_uint_atomic_compare_swap_nbi(unsigned int *fetch, unsigned int *target, unsigned int cond, unsigned int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ulong_atomic_compare_swap_nbi(unsigned long *fetch, unsigned long *target, unsigned long cond, unsigned long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ulonglong_atomic_compare_swap_nbi(unsigned long long *fetch, unsigned long long *target, unsigned long long cond, unsigned long long value, int pe);
+#if OSHMEM_HAVE_C11
+#define pshmem_atomic_compare_swap_nbi(...)                                             \
+    _Generic(&*(__OSHMEM_VAR_ARG1(__VA_ARGS__)),                                        \
+            shmem_ctx_t:  _Generic((__OSHMEM_VAR_ARG2(__VA_ARGS__)),                    \
+                int*:                pshmem_ctx_int_atomic_compare_swap_nbi,            \
+                long*:               pshmem_ctx_long_atomic_compare_swap_nbi,           \
+                long long*:          pshmem_ctx_longlong_atomic_compare_swap_nbi,       \
+                unsigned int*:       pshmem_ctx_uint_atomic_compare_swap_nbi,           \
+                unsigned long*:      pshmem_ctx_ulong_atomic_compare_swap_nbi,          \
+                unsigned long long*: pshmem_ctx_ulonglong_atomic_compare_swap_nbi,      \
+                default:             __oshmem_datatype_ignore),                         \
+            int*:                pshmem_int_atomic_compare_swap_nbi,                    \
+            long*:               pshmem_long_atomic_compare_swap_nbi,                   \
+            long long*:          pshmem_longlong_atomic_compare_swap_nbi,               \
+            unsigned int*:       pshmem_uint_atomic_compare_swap_nbi,                   \
+            unsigned long*:      pshmem_ulong_atomic_compare_swap_nbi,                  \
+            unsigned long long*: pshmem_ulonglong_atomic_compare_swap_nbi)(__VA_ARGS__)
+#endif
+
+/* Atomic swap (non-blocking) */
+OSHMEM_DECLSPEC void pshmem_ctx_int_atomic_swap_nbi(shmem_ctx_t ctx, int *fetch, int *target, int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_long_atomic_swap_nbi(shmem_ctx_t ctx, long *fetch, long *target, long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_longlong_atomic_swap_nbi(shmem_ctx_t ctx, long long *fetch, long long *target, long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint_atomic_swap_nbi(shmem_ctx_t ctx, unsigned int *fetch, unsigned int *target, unsigned int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulong_atomic_swap_nbi(shmem_ctx_t ctx, unsigned long *fetch, unsigned long *target, unsigned long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulonglong_atomic_swap_nbi(shmem_ctx_t ctx, unsigned long long *fetch, unsigned long long *target, unsigned long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_float_atomic_swap_nbi(shmem_ctx_t ctx, float *fetch, float *target, float value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_double_atomic_swap_nbi(shmem_ctx_t ctx, double *fetch, double *target, double value, int pe);
+
+OSHMEM_DECLSPEC void pshmem_int_atomic_swap_nbi(int *fetch, int *target, int value, int pe);
+OSHMEM_DECLSPEC void pshmem_long_atomic_swap_nbi(long *fetch, long *target, long value, int pe);
+OSHMEM_DECLSPEC void pshmem_longlong_atomic_swap_nbi(long long *fetch, long long *target, long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_uint_atomic_swap_nbi(unsigned int *fetch, unsigned int *target, unsigned int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ulong_atomic_swap_nbi(unsigned long *fetch, unsigned long *target, unsigned long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ulonglong_atomic_swap_nbi(unsigned long long *fetch, unsigned long long *target, unsigned long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_float_atomic_swap_nbi(float *fetch, float *target, float value, int pe);
+OSHMEM_DECLSPEC void pshmem_double_atomic_swap_nbi(double *fetch, double *target, double value, int pe);
+#if OSHMEM_HAVE_C11
+#define pshmem_atomic_swap_nbi(...)                                          \
+    _Generic(&*(__OSHMEM_VAR_ARG1(__VA_ARGS__)),                             \
+            shmem_ctx_t:  _Generic((__OSHMEM_VAR_ARG2(__VA_ARGS__)),         \
+                int*:                pshmem_ctx_int_atomic_swap_nbi,         \
+                long*:               pshmem_ctx_long_atomic_swap_nbi,        \
+                long long*:          pshmem_ctx_longlong_atomic_swap_nbi,    \
+                unsigned int*:       pshmem_ctx_uint_atomic_swap_nbi,        \
+                unsigned long*:      pshmem_ctx_ulong_atomic_swap_nbi,       \
+                unsigned long long*: pshmem_ctx_ulonglong_atomic_swap_nbi,   \
+                float*:              pshmem_ctx_float_atomic_swap_nbi,       \
+                double*:             pshmem_ctx_double_atomic_swap_nbi,      \
+                default:             __oshmem_datatype_ignore),              \
+            int*:                pshmem_int_atomic_swap_nbi,                 \
+            long*:               pshmem_long_atomic_swap_nbi,                \
+            long long*:          pshmem_longlong_atomic_swap_nbi,            \
+            unsigned int*:       pshmem_uint_atomic_swap_nbi,                \
+            unsigned long*:      pshmem_ulong_atomic_swap_nbi,               \
+            unsigned long long*: pshmem_ulonglong_atomic_swap_nbi,           \
+            float*:              pshmem_float_atomic_swap_nbi,               \
+            double*:             pshmem_double_atomic_swap_nbi)(__VA_ARGS__)
+#endif
+
+/* Atomic Fetch&Inc (non-blocking) */
+OSHMEM_DECLSPEC void pshmem_ctx_int_atomic_fetch_inc_nbi(shmem_ctx_t ctx, int *fetch, int *target, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_long_atomic_fetch_inc_nbi(shmem_ctx_t ctx, long *fetch, long *target, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_longlong_atomic_fetch_inc_nbi(shmem_ctx_t ctx, long long *fetch, long long *target, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint_atomic_fetch_inc_nbi(shmem_ctx_t ctx, unsigned int *fetch, unsigned int *target, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulong_atomic_fetch_inc_nbi(shmem_ctx_t ctx, unsigned long *fetch, unsigned long *target, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulonglong_atomic_fetch_inc_nbi(shmem_ctx_t ctx, unsigned long long *fetch, unsigned long long *target, int pe);
+
+OSHMEM_DECLSPEC void pshmem_int_atomic_fetch_inc_nbi(int *fetch, int *target, int pe);
+OSHMEM_DECLSPEC void pshmem_long_atomic_fetch_inc_nbi(long *fetch, long *target, int pe);
+OSHMEM_DECLSPEC void pshmem_longlong_atomic_fetch_inc_nbi(long long *fetch, long long *target, int pe);
+OSHMEM_DECLSPEC void pshmem_uint_atomic_fetch_inc_nbi(unsigned int *fetch, unsigned int *target, int pe);
+OSHMEM_DECLSPEC void pshmem_ulong_atomic_fetch_inc_nbi(unsigned long *fetch, unsigned long *target, int pe);
+OSHMEM_DECLSPEC void pshmem_ulonglong_atomic_fetch_inc_nbi(unsigned long long *fetch, unsigned long long *target, int pe);
+#if OSHMEM_HAVE_C11
+#define pshmem_atomic_fetch_inc_nbi(...)                                             \
+    _Generic(&*(__OSHMEM_VAR_ARG1(__VA_ARGS__)),                                     \
+            shmem_ctx_t:  _Generic((__OSHMEM_VAR_ARG2(__VA_ARGS__)),                 \
+                int*:                pshmem_ctx_int_atomic_fetch_inc_nbi,            \
+                long*:               pshmem_ctx_long_atomic_fetch_inc_nbi,           \
+                long long*:          pshmem_ctx_longlong_atomic_fetch_inc_nbi,       \
+                unsigned int*:       pshmem_ctx_uint_atomic_fetch_inc_nbi,           \
+                unsigned long*:      pshmem_ctx_ulong_atomic_fetch_inc_nbi,          \
+                unsigned long long*: pshmem_ctx_ulonglong_atomic_fetch_inc_nbi,      \
+                default:             __oshmem_datatype_ignore),                      \
+            int*:                pshmem_int_atomic_fetch_inc_nbi,                    \
+            long*:               pshmem_long_atomic_fetch_inc_nbi,                   \
+            long long*:          pshmem_longlong_atomic_fetch_inc_nbi,               \
+            unsigned int*:       pshmem_uint_atomic_fetch_inc_nbi,                   \
+            unsigned long*:      pshmem_ulong_atomic_fetch_inc_nbi,                  \
+            unsigned long long*: pshmem_ulonglong_atomic_fetch_inc_nbi)(__VA_ARGS__)
+#endif
+
+/* Atomic Fetch&Add (non-blocking) */
+OSHMEM_DECLSPEC void pshmem_ctx_int_atomic_fetch_add_nbi(shmem_ctx_t ctx, int *fetch, int *target, int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_long_atomic_fetch_add_nbi(shmem_ctx_t ctx, long *fetch, long *target, long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_longlong_atomic_fetch_add_nbi(shmem_ctx_t ctx, long long *fetch, long long *target, long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint_atomic_fetch_add_nbi(shmem_ctx_t ctx, unsigned int *fetch, unsigned int *target, unsigned int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulong_atomic_fetch_add_nbi(shmem_ctx_t ctx, unsigned long *fetch, unsigned long *target, unsigned long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulonglong_atomic_fetch_add_nbi(shmem_ctx_t ctx, unsigned long long *fetch, unsigned long long *target, unsigned long long value, int pe);
+
+OSHMEM_DECLSPEC void pshmem_int_atomic_fetch_add_nbi(int *fetch, int *target, int value, int pe);
+OSHMEM_DECLSPEC void pshmem_long_atomic_fetch_add_nbi(long *fetch, long *target, long value, int pe);
+OSHMEM_DECLSPEC void pshmem_longlong_atomic_fetch_add_nbi(long long *fetch, long long *target, long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_uint_atomic_fetch_add_nbi(unsigned int *fetch, unsigned int *target, unsigned int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ulong_atomic_fetch_add_nbi(unsigned long *fetch, unsigned long *target, unsigned long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ulonglong_atomic_fetch_add_nbi(unsigned long long *fetch, unsigned long long *target, unsigned long long value, int pe);
+#if OSHMEM_HAVE_C11
+#define pshmem_atomic_fetch_add_nbi(...)                                             \
+    _Generic(&*(__OSHMEM_VAR_ARG1(__VA_ARGS__)),                                     \
+            shmem_ctx_t:  _Generic((__OSHMEM_VAR_ARG2(__VA_ARGS__)),                 \
+                int*:                pshmem_ctx_int_atomic_fetch_add_nbi,            \
+                long*:               pshmem_ctx_long_atomic_fetch_add_nbi,           \
+                long long*:          pshmem_ctx_longlong_atomic_fetch_add_nbi,       \
+                unsigned int*:       pshmem_ctx_uint_atomic_fetch_add_nbi,           \
+                unsigned long*:      pshmem_ctx_ulong_atomic_fetch_add_nbi,          \
+                unsigned long long*: pshmem_ctx_ulonglong_atomic_fetch_add_nbi,      \
+                default:             __oshmem_datatype_ignore),                      \
+            int*:                pshmem_int_atomic_fetch_add_nbi,                    \
+            long*:               pshmem_long_atomic_fetch_add_nbi,                   \
+            long long*:          pshmem_longlong_atomic_fetch_add_nbi,               \
+            unsigned int*:       pshmem_uint_atomic_fetch_add_nbi,                   \
+            unsigned long*:      pshmem_ulong_atomic_fetch_add_nbi,                  \
+            unsigned long long*: pshmem_ulonglong_atomic_fetch_add_nbi)(__VA_ARGS__)
+#endif
+
+/* Atomic Fetch&And (non-blocking) */
+OSHMEM_DECLSPEC void pshmem_ctx_int_atomic_fetch_and_nbi(shmem_ctx_t ctx, int *fetch, int *target, int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_long_atomic_fetch_and_nbi(shmem_ctx_t ctx, long *fetch, long *target, long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_longlong_atomic_fetch_and_nbi(shmem_ctx_t ctx, long long *fetch, long long *target, long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint_atomic_fetch_and_nbi(shmem_ctx_t ctx, unsigned int *fetch, unsigned int *target, unsigned int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulong_atomic_fetch_and_nbi(shmem_ctx_t ctx, unsigned long *fetch, unsigned long *target, unsigned long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulonglong_atomic_fetch_and_nbi(shmem_ctx_t ctx, unsigned long long *fetch, unsigned long long *target, unsigned long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_int32_atomic_fetch_and_nbi(shmem_ctx_t ctx, int32_t *fetch, int32_t *target, int32_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_int64_atomic_fetch_and_nbi(shmem_ctx_t ctx, int64_t *fetch, int64_t *target, int64_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint32_atomic_fetch_and_nbi(shmem_ctx_t ctx, uint32_t *fetch, uint32_t *target, uint32_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint64_atomic_fetch_and_nbi(shmem_ctx_t ctx, uint64_t *fetch, uint64_t *target, uint64_t value, int pe);
+
+OSHMEM_DECLSPEC void pshmem_int_atomic_fetch_and_nbi(int *fetch, int *target, int value, int pe);
+OSHMEM_DECLSPEC void pshmem_long_atomic_fetch_and_nbi(long *fetch, long *target, long value, int pe);
+OSHMEM_DECLSPEC void pshmem_longlong_atomic_fetch_and_nbi(long long *fetch, long long *target, long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_uint_atomic_fetch_and_nbi(unsigned int *fetch, unsigned int *target, unsigned int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ulong_atomic_fetch_and_nbi(unsigned long *fetch, unsigned long *target, unsigned long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ulonglong_atomic_fetch_and_nbi(unsigned long long *fetch, unsigned long long *target, unsigned long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_int32_atomic_fetch_and_nbi(int32_t *fetch, int32_t *target, int32_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_int64_atomic_fetch_and_nbi(int64_t *fetch, int64_t *target, int64_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_uint32_atomic_fetch_and_nbi(uint32_t *fetch, uint32_t *target, uint32_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_uint64_atomic_fetch_and_nbi(uint64_t *fetch, uint64_t *target, uint64_t value, int pe);
+#if OSHMEM_HAVE_C11
+#define pshmem_atomic_fetch_and_nbi(...)                                             \
+    _Generic(&*(__OSHMEM_VAR_ARG1(__VA_ARGS__)),                                     \
+            shmem_ctx_t:  _Generic((__OSHMEM_VAR_ARG2(__VA_ARGS__)),                 \
+                int*:                pshmem_ctx_int_atomic_fetch_and_nbi,            \
+                long*:               pshmem_ctx_long_atomic_fetch_and_nbi,           \
+                long long*:          pshmem_ctx_longlong_atomic_fetch_and_nbi,       \
+                unsigned int*:       pshmem_ctx_uint_atomic_fetch_and_nbi,           \
+                unsigned long*:      pshmem_ctx_ulong_atomic_fetch_and_nbi,          \
+                unsigned long long*: pshmem_ctx_ulonglong_atomic_fetch_and_nbi,      \
+                default:             __oshmem_datatype_ignore),                      \
+            int*:                pshmem_int_atomic_fetch_and_nbi,                    \
+            long*:               pshmem_long_atomic_fetch_and_nbi,                   \
+            long long*:          pshmem_longlong_atomic_fetch_and_nbi,               \
+            unsigned int*:       pshmem_uint_atomic_fetch_and_nbi,                   \
+            unsigned long*:      pshmem_ulong_atomic_fetch_and_nbi,                  \
+            unsigned long long*: pshmem_ulonglong_atomic_fetch_and_nbi)(__VA_ARGS__)
+#endif
+
+/* Atomic Fetch&Or (non-blocking) */
+OSHMEM_DECLSPEC void pshmem_ctx_int_atomic_fetch_or_nbi(shmem_ctx_t ctx, int *fetch, int *target, int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_long_atomic_fetch_or_nbi(shmem_ctx_t ctx, long *fetch, long *target, long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_longlong_atomic_fetch_or_nbi(shmem_ctx_t ctx, long long *fetch, long long *target, long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint_atomic_fetch_or_nbi(shmem_ctx_t ctx, unsigned int *fetch, unsigned int *target, unsigned int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulong_atomic_fetch_or_nbi(shmem_ctx_t ctx, unsigned long *fetch, unsigned long *target, unsigned long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulonglong_atomic_fetch_or_nbi(shmem_ctx_t ctx, unsigned long long *fetch, unsigned long long *target, unsigned long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_int32_atomic_fetch_or_nbi(shmem_ctx_t ctx, int32_t *fetch, int32_t *target, int32_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_int64_atomic_fetch_or_nbi(shmem_ctx_t ctx, int64_t *fetch, int64_t *target, int64_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint32_atomic_fetch_or_nbi(shmem_ctx_t ctx, uint32_t *fetch, uint32_t *target, uint32_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint64_atomic_fetch_or_nbi(shmem_ctx_t ctx, uint64_t *fetch, uint64_t *target, uint64_t value, int pe);
+
+OSHMEM_DECLSPEC void pshmem_int_atomic_fetch_or_nbi(int *fetch, int *target, int value, int pe);
+OSHMEM_DECLSPEC void pshmem_long_atomic_fetch_or_nbi(long *fetch, long *target, long value, int pe);
+OSHMEM_DECLSPEC void pshmem_longlong_atomic_fetch_or_nbi(long long *fetch, long long *target, long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_uint_atomic_fetch_or_nbi(unsigned int *fetch, unsigned int *target, unsigned int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ulong_atomic_fetch_or_nbi(unsigned long *fetch, unsigned long *target, unsigned long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ulonglong_atomic_fetch_or_nbi(unsigned long long *fetch, unsigned long long *target, unsigned long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_int32_atomic_fetch_or_nbi(int32_t *fetch, int32_t *target, int32_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_int64_atomic_fetch_or_nbi(int64_t *fetch, int64_t *target, int64_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_uint32_atomic_fetch_or_nbi(uint32_t *fetch, uint32_t *target, uint32_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_uint64_atomic_fetch_or_nbi(uint64_t *fetch, uint64_t *target, uint64_t value, int pe);
+#if OSHMEM_HAVE_C11
+#define pshmem_atomic_fetch_or_nbi(...)                                             \
+    _Generic(&*(__OSHMEM_VAR_ARG1(__VA_ARGS__)),                                    \
+            shmem_ctx_t:  _Generic((__OSHMEM_VAR_ARG2(__VA_ARGS__)),                \
+                int*:                pshmem_ctx_int_atomic_fetch_or_nbi,            \
+                long*:               pshmem_ctx_long_atomic_fetch_or_nbi,           \
+                long long*:          pshmem_ctx_longlong_atomic_fetch_or_nbi,       \
+                unsigned int*:       pshmem_ctx_uint_atomic_fetch_or_nbi,           \
+                unsigned long*:      pshmem_ctx_ulong_atomic_fetch_or_nbi,          \
+                unsigned long long*: pshmem_ctx_ulonglong_atomic_fetch_or_nbi,      \
+                default:             __oshmem_datatype_ignore),                     \
+            int*:                pshmem_int_atomic_fetch_or_nbi,                    \
+            long*:               pshmem_long_atomic_fetch_or_nbi,                   \
+            long long*:          pshmem_longlong_atomic_fetch_or_nbi,               \
+            unsigned int*:       pshmem_uint_atomic_fetch_or_nbi,                   \
+            unsigned long*:      pshmem_ulong_atomic_fetch_or_nbi,                  \
+            unsigned long long*: pshmem_ulonglong_atomic_fetch_or_nbi)(__VA_ARGS__)
+#endif
+
+/* Atomic Fetch&Xor (non-blocking) */
+OSHMEM_DECLSPEC void pshmem_ctx_int_atomic_fetch_xor_nbi(shmem_ctx_t ctx, int *fetch, int *target, int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_long_atomic_fetch_xor_nbi(shmem_ctx_t ctx, long *fetch, long *target, long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_longlong_atomic_fetch_xor_nbi(shmem_ctx_t ctx, long long *fetch, long long *target, long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint_atomic_fetch_xor_nbi(shmem_ctx_t ctx, unsigned int *fetch, unsigned int *target, unsigned int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulong_atomic_fetch_xor_nbi(shmem_ctx_t ctx, unsigned long *fetch, unsigned long *target, unsigned long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_ulonglong_atomic_fetch_xor_nbi(shmem_ctx_t ctx, unsigned long long *fetch, unsigned long long *target, unsigned long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_int32_atomic_fetch_xor_nbi(shmem_ctx_t ctx, int32_t *fetch, int32_t *target, int32_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_int64_atomic_fetch_xor_nbi(shmem_ctx_t ctx, int64_t *fetch, int64_t *target, int64_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint32_atomic_fetch_xor_nbi(shmem_ctx_t ctx, uint32_t *fetch, uint32_t *target, uint32_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_ctx_uint64_atomic_fetch_xor_nbi(shmem_ctx_t ctx, uint64_t *fetch, uint64_t *target, uint64_t value, int pe);
+
+OSHMEM_DECLSPEC void pshmem_int_atomic_fetch_xor_nbi(int *fetch, int *target, int value, int pe);
+OSHMEM_DECLSPEC void pshmem_long_atomic_fetch_xor_nbi(long *fetch, long *target, long value, int pe);
+OSHMEM_DECLSPEC void pshmem_longlong_atomic_fetch_xor_nbi(long long *fetch, long long *target, long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_uint_atomic_fetch_xor_nbi(unsigned int *fetch, unsigned int *target, unsigned int value, int pe);
+OSHMEM_DECLSPEC void pshmem_ulong_atomic_fetch_xor_nbi(unsigned long *fetch, unsigned long *target, unsigned long value, int pe);
+OSHMEM_DECLSPEC void pshmem_ulonglong_atomic_fetch_xor_nbi(unsigned long long *fetch, unsigned long long *target, unsigned long long value, int pe);
+OSHMEM_DECLSPEC void pshmem_int32_atomic_fetch_xor_nbi(int32_t *fetch, int32_t *target, int32_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_int64_atomic_fetch_xor_nbi(int64_t *fetch, int64_t *target, int64_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_uint32_atomic_fetch_xor_nbi(uint32_t *fetch, uint32_t *target, uint32_t value, int pe);
+OSHMEM_DECLSPEC void pshmem_uint64_atomic_fetch_xor_nbi(uint64_t *fetch, uint64_t *target, uint64_t value, int pe);
+#if OSHMEM_HAVE_C11
+#define pshmem_atomic_fetch_xor_nbi(...)                                             \
+    _Generic(&*(__OSHMEM_VAR_ARG1(__VA_ARGS__)),                                     \
+            shmem_ctx_t:  _Generic((__OSHMEM_VAR_ARG2(__VA_ARGS__)),                 \
+                int*:                pshmem_ctx_int_atomic_fetch_xor_nbi,            \
+                long*:               pshmem_ctx_long_atomic_fetch_xor_nbi,           \
+                long long*:          pshmem_ctx_longlong_atomic_fetch_xor_nbi,       \
+                unsigned int*:       pshmem_ctx_uint_atomic_fetch_xor_nbi,           \
+                unsigned long*:      pshmem_ctx_ulong_atomic_fetch_xor_nbi,          \
+                unsigned long long*: pshmem_ctx_ulonglong_atomic_fetch_xor_nbi,      \
+                default:             __oshmem_datatype_ignore),                      \
+            int*:                pshmem_int_atomic_fetch_xor_nbi,                    \
+            long*:               pshmem_long_atomic_fetch_xor_nbi,                   \
+            long long*:          pshmem_longlong_atomic_fetch_xor_nbi,               \
+            unsigned int*:       pshmem_uint_atomic_fetch_xor_nbi,                   \
+            unsigned long*:      pshmem_ulong_atomic_fetch_xor_nbi,                  \
+            unsigned long long*: pshmem_ulonglong_atomic_fetch_xor_nbi)(__VA_ARGS__)
+#endif
+
+/*
+ * Put-with-signal routines
+ */
+OSHMEM_DECLSPEC  void pshmem_ctx_char_put_signal(shmem_ctx_t ctx, char *target, const char *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_short_put_signal(shmem_ctx_t ctx, short *target, const short *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_int_put_signal(shmem_ctx_t ctx, int *target, const int *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_long_put_signal(shmem_ctx_t ctx, long *target, const long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_longlong_put_signal(shmem_ctx_t ctx, long long *target, const long long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_schar_put_signal(shmem_ctx_t ctx, signed char *target, const signed char *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_uchar_put_signal(shmem_ctx_t ctx, unsigned char *target, const unsigned char *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_ushort_put_signal(shmem_ctx_t ctx, unsigned short *target, const unsigned short *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_uint_put_signal(shmem_ctx_t ctx, unsigned int *target, const unsigned int *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_ulong_put_signal(shmem_ctx_t ctx, unsigned long *target, const unsigned long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_ulonglong_put_signal(shmem_ctx_t ctx, unsigned long long *target, const unsigned long long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_float_put_signal(shmem_ctx_t ctx, float *target, const float *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_double_put_signal(shmem_ctx_t ctx, double *target, const double *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_longdouble_put_signal(shmem_ctx_t ctx, long double *target, const long double *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_int8_put_signal(shmem_ctx_t ctx, int8_t *target, const int8_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_int16_put_signal(shmem_ctx_t ctx, int16_t *target, const int16_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_int32_put_signal(shmem_ctx_t ctx, int32_t *target, const int32_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_int64_put_signal(shmem_ctx_t ctx, int64_t *target, const int64_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_uint8_put_signal(shmem_ctx_t ctx, uint8_t *target, const uint8_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_uint16_put_signal(shmem_ctx_t ctx, uint16_t *target, const uint16_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_uint32_put_signal(shmem_ctx_t ctx, uint32_t *target, const uint32_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_uint64_put_signal(shmem_ctx_t ctx, uint64_t *target, const uint64_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_size_put_signal(shmem_ctx_t ctx, size_t *target, const size_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_ptrdiff_put_signal(shmem_ctx_t ctx, ptrdiff_t *target, const ptrdiff_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+
+OSHMEM_DECLSPEC  void pshmem_char_put_signal(char *target, const char *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_short_put_signal(short *target, const short *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_int_put_signal(int *target, const int *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_long_put_signal(long *target, const long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_longlong_put_signal(long long *target, const long long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_schar_put_signal(signed char *target, const signed char *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_uchar_put_signal(unsigned char *target, const unsigned char *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ushort_put_signal(unsigned short *target, const unsigned short *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_uint_put_signal(unsigned int *target, const unsigned int *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ulong_put_signal(unsigned long *target, const unsigned long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ulonglong_put_signal(unsigned long long *target, const unsigned long long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_float_put_signal(float *target, const float *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_double_put_signal(double *target, const double *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_longdouble_put_signal(long double *target, const long double *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_int8_put_signal(int8_t *target, const int8_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_int16_put_signal(int16_t *target, const int16_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_int32_put_signal(int32_t *target, const int32_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_int64_put_signal(int64_t *target, const int64_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_uint8_put_signal(uint8_t *target, const uint8_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_uint16_put_signal(uint16_t *target, const uint16_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_uint32_put_signal(uint32_t *target, const uint32_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_uint64_put_signal(uint64_t *target, const uint64_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_size_put_signal(size_t *target, const size_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ptrdiff_put_signal(ptrdiff_t *target, const ptrdiff_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+#if OSHMEM_HAVE_C11
+#define pshmem_put_signal(...)                                              \
+    _Generic(&*(__OSHMEM_VAR_ARG1(__VA_ARGS__)),                            \
+            shmem_ctx_t: _Generic(&*(__OSHMEM_VAR_ARG2(__VA_ARGS__)),       \
+                char*:               pshmem_ctx_char_put_signal,            \
+                short*:              pshmem_ctx_short_put_signal,           \
+                int*:                pshmem_ctx_int_put_signal,             \
+                long*:               pshmem_ctx_long_put_signal,            \
+                long long*:          pshmem_ctx_longlong_put_signal,        \
+                signed char*:        pshmem_ctx_schar_put_signal,           \
+                unsigned char*:      pshmem_ctx_uchar_put_signal,           \
+                unsigned short*:     pshmem_ctx_ushort_put_signal,          \
+                unsigned int*:       pshmem_ctx_uint_put_signal,            \
+                unsigned long*:      pshmem_ctx_ulong_put_signal,           \
+                unsigned long long*: pshmem_ctx_ulonglong_put_signal,       \
+                float*:              pshmem_ctx_float_put_signal,           \
+                double*:             pshmem_ctx_double_put_signal,          \
+                long double*:        pshmem_ctx_longdouble_put_signal,      \
+                default:             __oshmem_datatype_ignore),             \
+            char*:               pshmem_char_put_signal,                    \
+            short*:              pshmem_short_put_signal,                   \
+            int*:                pshmem_int_put_signal,                     \
+            long*:               pshmem_long_put_signal,                    \
+            long long*:          pshmem_longlong_put_signal,                \
+            signed char*:        pshmem_schar_put_signal,                   \
+            unsigned char*:      pshmem_uchar_put_signal,                   \
+            unsigned short*:     pshmem_ushort_put_signal,                  \
+            unsigned int*:       pshmem_uint_put_signal,                    \
+            unsigned long*:      pshmem_ulong_put_signal,                   \
+            unsigned long long*: pshmem_ulonglong_put_signal,               \
+            float*:              pshmem_float_put_signal,                   \
+            double*:             pshmem_double_put_signal,                  \
+            long double*:        pshmem_longdouble_put_signal)(__VA_ARGS__)
+#endif
+
+OSHMEM_DECLSPEC  void pshmem_ctx_put8_signal(shmem_ctx_t ctx, void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_put16_signal(shmem_ctx_t ctx, void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_put32_signal(shmem_ctx_t ctx, void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_put64_signal(shmem_ctx_t ctx, void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_put128_signal(shmem_ctx_t ctx, void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_putmem_signal(shmem_ctx_t ctx, void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+
+OSHMEM_DECLSPEC  void pshmem_put8_signal(void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_put16_signal(void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_put32_signal(void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_put64_signal(void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_put128_signal(void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_putmem_signal(void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+
+OSHMEM_DECLSPEC  void pshmem_ctx_char_put_signal_nbi(shmem_ctx_t ctx, char *target, const char *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_short_put_signal_nbi(shmem_ctx_t ctx, short *target, const short *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_int_put_signal_nbi(shmem_ctx_t ctx, int *target, const int *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_long_put_signal_nbi(shmem_ctx_t ctx, long *target, const long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_longlong_put_signal_nbi(shmem_ctx_t ctx, long long *target, const long long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_schar_put_signal_nbi(shmem_ctx_t ctx, signed char *target, const signed char *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_uchar_put_signal_nbi(shmem_ctx_t ctx, unsigned char *target, const unsigned char *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_ushort_put_signal_nbi(shmem_ctx_t ctx, unsigned short *target, const unsigned short *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_uint_put_signal_nbi(shmem_ctx_t ctx, unsigned int *target, const unsigned int *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_ulong_put_signal_nbi(shmem_ctx_t ctx, unsigned long *target, const unsigned long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_ulonglong_put_signal_nbi(shmem_ctx_t ctx, unsigned long long *target, const unsigned long long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_float_put_signal_nbi(shmem_ctx_t ctx, float *target, const float *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_double_put_signal_nbi(shmem_ctx_t ctx, double *target, const double *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_longdouble_put_signal_nbi(shmem_ctx_t ctx, long double *target, const long double *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_int8_put_signal_nbi(shmem_ctx_t ctx, int8_t *target, const int8_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_int16_put_signal_nbi(shmem_ctx_t ctx, int16_t *target, const int16_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_int32_put_signal_nbi(shmem_ctx_t ctx, int32_t *target, const int32_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_int64_put_signal_nbi(shmem_ctx_t ctx, int64_t *target, const int64_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_uint8_put_signal_nbi(shmem_ctx_t ctx, uint8_t *target, const uint8_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_uint16_put_signal_nbi(shmem_ctx_t ctx, uint16_t *target, const uint16_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_uint32_put_signal_nbi(shmem_ctx_t ctx, uint32_t *target, const uint32_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_uint64_put_signal_nbi(shmem_ctx_t ctx, uint64_t *target, const uint64_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_size_put_signal_nbi(shmem_ctx_t ctx, size_t *target, const size_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_ptrdiff_put_signal_nbi(shmem_ctx_t ctx, ptrdiff_t *target, const ptrdiff_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+
+OSHMEM_DECLSPEC  void pshmem_char_put_signal_nbi(char *target, const char *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_short_put_signal_nbi(short *target, const short *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_int_put_signal_nbi(int *target, const int *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_long_put_signal_nbi(long *target, const long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_longlong_put_signal_nbi(long long *target, const long long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_schar_put_signal_nbi(signed char *target, const signed char *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_uchar_put_signal_nbi(unsigned char *target, const unsigned char *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ushort_put_signal_nbi(unsigned short *target, const unsigned short *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_uint_put_signal_nbi(unsigned int *target, const unsigned int *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ulong_put_signal_nbi(unsigned long *target, const unsigned long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ulonglong_put_signal_nbi(unsigned long long *target, const unsigned long long *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_float_put_signal_nbi(float *target, const float *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_double_put_signal_nbi(double *target, const double *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_longdouble_put_signal_nbi(long double *target, const long double *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_int8_put_signal_nbi(int8_t *target, const int8_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_int16_put_signal_nbi(int16_t *target, const int16_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_int32_put_signal_nbi(int32_t *target, const int32_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_int64_put_signal_nbi(int64_t *target, const int64_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_uint8_put_signal_nbi(uint8_t *target, const uint8_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_uint16_put_signal_nbi(uint16_t *target, const uint16_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_uint32_put_signal_nbi(uint32_t *target, const uint32_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_uint64_put_signal_nbi(uint64_t *target, const uint64_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_size_put_signal_nbi(size_t *target, const size_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ptrdiff_put_signal_nbi(ptrdiff_t *target, const ptrdiff_t *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+#if OSHMEM_HAVE_C11
+#define pshmem_put_signal_nbi(...)                                          \
+    _Generic(&*(__OSHMEM_VAR_ARG1(__VA_ARGS__)),                            \
+            shmem_ctx_t: _Generic(&*(__OSHMEM_VAR_ARG2(__VA_ARGS__)),       \
+                char*:               pshmem_ctx_char_put_signal_nbi,        \
+                short*:              pshmem_ctx_short_put_signal_nbi,       \
+                int*:                pshmem_ctx_int_put_signal_nbi,         \
+                long*:               pshmem_ctx_long_put_signal_nbi,        \
+                long long*:          pshmem_ctx_longlong_put_signal_nbi,    \
+                signed char*:        pshmem_ctx_schar_put_signal_nbi,       \
+                unsigned char*:      pshmem_ctx_uchar_put_signal_nbi,       \
+                unsigned short*:     pshmem_ctx_ushort_put_signal_nbi,      \
+                unsigned int*:       pshmem_ctx_uint_put_signal_nbi,        \
+                unsigned long*:      pshmem_ctx_ulong_put_signal_nbi,       \
+                unsigned long long*: pshmem_ctx_ulonglong_put_signal_nbi,   \
+                float*:              pshmem_ctx_float_put_signal_nbi,       \
+                double*:             pshmem_ctx_double_put_signal_nbi,      \
+                long double*:        pshmem_ctx_longdouble_put_signal_nbi,  \
+                default:             __oshmem_datatype_ignore),             \
+            char*:               pshmem_char_put_signal_nbi,                \
+            short*:              pshmem_short_put_signal_nbi,               \
+            int*:                pshmem_int_put_signal_nbi,                 \
+            long*:               pshmem_long_put_signal_nbi,                \
+            long long*:          pshmem_longlong_put_signal_nbi,            \
+            signed char*:        pshmem_schar_put_signal_nbi,               \
+            unsigned char*:      pshmem_uchar_put_signal_nbi,               \
+            unsigned short*:     pshmem_ushort_put_signal_nbi,              \
+            unsigned int*:       pshmem_uint_put_signal_nbi,                \
+            unsigned long*:      pshmem_ulong_put_signal_nbi,               \
+            unsigned long long*: pshmem_ulonglong_put_signal_nbi,           \
+            float*:              pshmem_float_put_signal_nbi,               \
+            double*:             pshmem_double_put_signal_nbi,              \
+            long double*:        pshmem_longdouble_put_signal_nbi)(__VA_ARGS__)
+#endif
+
+OSHMEM_DECLSPEC  void pshmem_ctx_put8_signal_nbi(shmem_ctx_t ctx, void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_put16_signal_nbi(shmem_ctx_t ctx, void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_put32_signal_nbi(shmem_ctx_t ctx, void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_put64_signal_nbi(shmem_ctx_t ctx, void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_put128_signal_nbi(shmem_ctx_t ctx, void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_ctx_putmem_signal_nbi(shmem_ctx_t ctx, void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+
+OSHMEM_DECLSPEC  void pshmem_put8_signal_nbi(void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_put16_signal_nbi(void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_put32_signal_nbi(void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_put64_signal_nbi(void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_put128_signal_nbi(void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+OSHMEM_DECLSPEC  void pshmem_putmem_signal_nbi(void *target, const void *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe);
+
+OSHMEM_DECLSPEC  uint64_t pshmem_signal_fetch(const uint64_t *sig_addr);
+OSHMEM_DECLSPEC  uint64_t pshmem_signal_wait_until(uint64_t *sig_addr, int cmp, uint64_t cmp_value);
+
 /*
  * Lock functions
  */
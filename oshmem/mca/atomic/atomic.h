@@ -216,6 +216,47 @@ struct mca_atomic_base_module_1_0_0_t {
                         uint64_t value,
                         size_t size,
                         int pe);
+
+    /* Non-blocking fetching operations: the result is written to prev
+     * by the time the next quiet on the context returns. Optional, the
+     * base falls back to the blocking operations if not provided. */
+    int (*atomic_fadd_nb)(shmem_ctx_t ctx,
+                          void *target,
+                          void *prev,
+                          uint64_t value,
+                          size_t size,
+                          int pe);
+    int (*atomic_fand_nb)(shmem_ctx_t ctx,
+                          void *target,
+                          void *prev,
+                          uint64_t value,
+                          size_t size,
+                          int pe);
+    int (*atomic_for_nb)(shmem_ctx_t ctx,
+                         void *target,
+                         void *prev,
+                         uint64_t value,
+                         size_t size,
+                         int pe);
+    int (*atomic_fxor_nb)(shmem_ctx_t ctx,
+                          void *target,
+                          void *prev,
+                          uint64_t value,
+                          size_t size,
+                          int pe);
+    int (*atomic_swap_nb)(shmem_ctx_t ctx,
+                          void *target,
+                          void *prev,
+                          uint64_t value,
+                          size_t size,
+                          int pe);
+    int (*atomic_cswap_nb)(shmem_ctx_t ctx,
+                           void *target,
+                           void *prev,
+                           uint64_t cond,
+                           uint64_t value,
+                           size_t size,
+                           int pe);
 };
 typedef struct mca_atomic_base_module_1_0_0_t mca_atomic_base_module_1_0_0_t;
 
@@ -43,6 +43,13 @@ static void atomic_base_module_construct(mca_atomic_base_module_t *m)
     /* Atomic function pointers */
     m->atomic_fadd = NULL;
     m->atomic_cswap = NULL;
+    /* Optional non-blocking fetching operations */
+    m->atomic_fadd_nb  = NULL;
+    m->atomic_fand_nb  = NULL;
+    m->atomic_for_nb   = NULL;
+    m->atomic_fxor_nb  = NULL;
+    m->atomic_swap_nb  = NULL;
+    m->atomic_cswap_nb = NULL;
 }
 
 OBJ_CLASS_INSTANCE(mca_atomic_base_module_t, opal_object_t,
@@ -64,6 +64,47 @@ static int query_1_0_0(const mca_atomic_base_component_1_0_0_t * atomic_componen
  */
 static OBJ_CLASS_INSTANCE(avail_com_t, opal_list_item_t, NULL, NULL);
 
+/*
+ * Non-blocking fetching operations of the modules not providing them:
+ * complete the operation right away.
+ */
+static int atomic_base_fadd_nb(shmem_ctx_t ctx, void *target, void *prev,
+                               uint64_t value, size_t size, int pe)
+{
+    return mca_atomic.atomic_fadd(ctx, target, prev, value, size, pe);
+}
+
+static int atomic_base_fand_nb(shmem_ctx_t ctx, void *target, void *prev,
+                               uint64_t value, size_t size, int pe)
+{
+    return mca_atomic.atomic_fand(ctx, target, prev, value, size, pe);
+}
+
+static int atomic_base_for_nb(shmem_ctx_t ctx, void *target, void *prev,
+                              uint64_t value, size_t size, int pe)
+{
+    return mca_atomic.atomic_for(ctx, target, prev, value, size, pe);
+}
+
+static int atomic_base_fxor_nb(shmem_ctx_t ctx, void *target, void *prev,
+                               uint64_t value, size_t size, int pe)
+{
+    return mca_atomic.atomic_fxor(ctx, target, prev, value, size, pe);
+}
+
+static int atomic_base_swap_nb(shmem_ctx_t ctx, void *target, void *prev,
+                               uint64_t value, size_t size, int pe)
+{
+    return mca_atomic.atomic_swap(ctx, target, prev, value, size, pe);
+}
+
+static int atomic_base_cswap_nb(shmem_ctx_t ctx, void *target, void *prev,
+                                uint64_t cond, uint64_t value, size_t size, int pe)
+{
+    return mca_atomic.atomic_cswap(ctx, target, (uint64_t *)prev, cond, value,
+                                   size, pe);
+}
+
 /*
  * This function is called at the initialization.
  * It is used to select which atomic component will be
@@ -105,6 +146,25 @@ int mca_atomic_base_select(void)
             !(mca_atomic.atomic_cswap) || !(mca_atomic.atomic_swap)) {
             return OSHMEM_ERR_NOT_FOUND;
         }
+
+        if (!mca_atomic.atomic_fadd_nb) {
+            mca_atomic.atomic_fadd_nb = atomic_base_fadd_nb;
+        }
+        if (!mca_atomic.atomic_fand_nb) {
+            mca_atomic.atomic_fand_nb = atomic_base_fand_nb;
+        }
+        if (!mca_atomic.atomic_for_nb) {
+            mca_atomic.atomic_for_nb = atomic_base_for_nb;
+        }
+        if (!mca_atomic.atomic_fxor_nb) {
+            mca_atomic.atomic_fxor_nb = atomic_base_fxor_nb;
+        }
+        if (!mca_atomic.atomic_swap_nb) {
+            mca_atomic.atomic_swap_nb = atomic_base_swap_nb;
+        }
+        if (!mca_atomic.atomic_cswap_nb) {
+            mca_atomic.atomic_cswap_nb = atomic_base_cswap_nb;
+        }
     }
 
     /* Done with the list from the check_components() call so release it. */
@@ -15,6 +15,7 @@
 
 #include "opal/mca/common/ucx/common_ucx.h"
 #include "opal/mca/mca.h"
+#include "opal/sys/atomic.h"
 #include "oshmem/mca/atomic/atomic.h"
 #include "oshmem/util/oshmem_util.h"
 
@@ -42,6 +43,103 @@ int mca_atomic_ucx_finalize(void);
 mca_atomic_base_module_t*
 mca_atomic_ucx_query(int *priority);
 
+/* CPU atomics on the symmetric segments mapped by spml:ucx */
+enum {
+    MCA_ATOMIC_UCX_DIRECT_ADD,
+    MCA_ATOMIC_UCX_DIRECT_AND,
+    MCA_ATOMIC_UCX_DIRECT_OR,
+    MCA_ATOMIC_UCX_DIRECT_XOR,
+    MCA_ATOMIC_UCX_DIRECT_SWAP
+};
+
+static inline void *mca_atomic_ucx_direct_ptr(spml_ucx_mkey_t *ucx_mkey, uint64_t rva)
+{
+    if (!mca_spml_self->direct_atomics) {
+        return NULL;
+    }
+    return mca_spml_ucx_mkey_ptr(ucx_mkey, (void *)rva);
+}
+
+static inline uint64_t mca_atomic_ucx_direct_fop(void *ptr, uint64_t value,
+                                                 size_t size, int op)
+{
+    if (8 == size) {
+        opal_atomic_int64_t *addr = (opal_atomic_int64_t *)ptr;
+        int64_t val = (int64_t)value;
+
+        switch (op) {
+        case MCA_ATOMIC_UCX_DIRECT_ADD:
+            return (uint64_t)opal_atomic_fetch_add_64(addr, val);
+        case MCA_ATOMIC_UCX_DIRECT_AND:
+            return (uint64_t)opal_atomic_fetch_and_64(addr, val);
+        case MCA_ATOMIC_UCX_DIRECT_OR:
+            return (uint64_t)opal_atomic_fetch_or_64(addr, val);
+        case MCA_ATOMIC_UCX_DIRECT_XOR:
+            return (uint64_t)opal_atomic_fetch_xor_64(addr, val);
+        default:
+            return (uint64_t)opal_atomic_swap_64(addr, val);
+        }
+    } else {
+        opal_atomic_int32_t *addr = (opal_atomic_int32_t *)ptr;
+        int32_t val = (int32_t)value;
+
+        switch (op) {
+        case MCA_ATOMIC_UCX_DIRECT_ADD:
+            return (uint32_t)opal_atomic_fetch_add_32(addr, val);
+        case MCA_ATOMIC_UCX_DIRECT_AND:
+            return (uint32_t)opal_atomic_fetch_and_32(addr, val);
+        case MCA_ATOMIC_UCX_DIRECT_OR:
+            return (uint32_t)opal_atomic_fetch_or_32(addr, val);
+        case MCA_ATOMIC_UCX_DIRECT_XOR:
+            return (uint32_t)opal_atomic_fetch_xor_32(addr, val);
+        default:
+            return (uint32_t)opal_atomic_swap_32(addr, val);
+        }
+    }
+}
+
+static inline void mca_atomic_ucx_direct_store_prev(void *prev, uint64_t value, size_t size)
+{
+    if (8 == size) {
+        *(uint64_t *)prev = value;
+    } else {
+        *(uint32_t *)prev = (uint32_t)value;
+    }
+}
+
+/* Account a non-blocking fetching operation posted to the pe. The request
+ * is released right away, its reply lands in the user buffer at the latest
+ * when the ctx is flushed by quiet. Posting many of them in a row (e.g.
+ * fetch_inc on the PEs of a histogram) lets UCX pipeline them on the NIC,
+ * the worker is progressed every nb_get_progress_thresh operations only to
+ * bound the number of the outstanding replies. */
+static inline int mca_atomic_ucx_nb_posted(mca_spml_ucx_ctx_t *ucx_ctx, int pe,
+                                           ucs_status_ptr_t status_ptr)
+{
+    unsigned long i;
+
+    if (UCS_PTR_IS_ERR(status_ptr)) {
+        return ucx_status_to_oshmem(UCS_PTR_STATUS(status_ptr));
+    }
+
+    if (UCS_PTR_IS_PTR(status_ptr)) {
+        ucp_request_free(status_ptr);
+        mca_spml_ucx_remote_op_posted(ucx_ctx, pe);
+    }
+
+    if (mca_spml_self->nb_get_progress_thresh &&
+        (++ucx_ctx->nb_progress_cnt > mca_spml_self->nb_get_progress_thresh)) {
+        for (i = 0; i < mca_spml_self->nb_ucp_worker_progress; i++) {
+            if (!ucp_worker_progress(ucx_ctx->ucp_worker[0])) {
+                ucx_ctx->nb_progress_cnt = 0;
+                break;
+            }
+        }
+    }
+
+    return OSHMEM_SUCCESS;
+}
+
 int mca_atomic_ucx_cswap(shmem_ctx_t ctx,
                          void *target,
                          uint64_t *prev,
@@ -49,6 +147,13 @@ int mca_atomic_ucx_cswap(shmem_ctx_t ctx,
                          uint64_t value,
                          size_t size,
                          int pe);
+int mca_atomic_ucx_cswap_nb(shmem_ctx_t ctx,
+                            void *target,
+                            void *prev,
+                            uint64_t cond,
+                            uint64_t value,
+                            size_t size,
+                            int pe);
 
 struct mca_atomic_ucx_module_t {
     mca_atomic_base_module_t super;
@@ -19,18 +19,21 @@
 
 #include "atomic_ucx.h"
 
-int mca_atomic_ucx_cswap(shmem_ctx_t ctx,
-                         void *target,
-                         uint64_t *prev,
-                         uint64_t cond,
-                         uint64_t value,
-                         size_t size,
-                         int pe)
+static inline
+int mca_atomic_ucx_cswap_common(shmem_ctx_t ctx,
+                                void *target,
+                                void *prev,
+                                uint64_t cond,
+                                uint64_t value,
+                                size_t size,
+                                int pe,
+                                bool nb)
 {
     ucs_status_ptr_t status_ptr;
     spml_ucx_mkey_t *ucx_mkey;
     uint64_t rva;
-    mca_spml_ucx_ctx_t *ucx_ctx = (mca_spml_ucx_ctx_t *)ctx;
+    void *ptr;
+    mca_spml_ucx_ctx_t *ucx_ctx = mca_spml_ucx_ctx_resolve(ctx, mca_spml_self);
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
     ucp_request_param_t param = {
         .op_attr_mask = UCP_OP_ATTR_FIELD_DATATYPE |
@@ -47,8 +50,26 @@ int mca_atomic_ucx_cswap(shmem_ctx_t ctx,
 
     assert(NULL != prev);
 
-    *prev      = value;
-    ucx_mkey   = mca_spml_ucx_get_mkey(ctx, pe, target, (void *)&rva, mca_spml_self);
+    /* the reply buffer provides the swapped value */
+    mca_atomic_ucx_direct_store_prev(prev, value, size);
+    ucx_mkey   = mca_spml_ucx_get_mkey((shmem_ctx_t)ucx_ctx, pe, target, (void *)&rva,
+                                       mca_spml_self);
+    ptr        = mca_atomic_ucx_direct_ptr(ucx_mkey, rva);
+    if (NULL != ptr) {
+        if (8 == size) {
+            int64_t old = (int64_t)cond;
+            opal_atomic_compare_exchange_strong_64((opal_atomic_int64_t *)ptr, &old,
+                                                   (int64_t)value);
+            mca_atomic_ucx_direct_store_prev(prev, (uint64_t)old, size);
+        } else {
+            int32_t old = (int32_t)cond;
+            opal_atomic_compare_exchange_strong_32((opal_atomic_int32_t *)ptr, &old,
+                                                   (int32_t)value);
+            mca_atomic_ucx_direct_store_prev(prev, (uint32_t)old, size);
+        }
+        return OSHMEM_SUCCESS;
+    }
+
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
     status_ptr = ucp_atomic_op_nbx(ucx_ctx->ucp_peers[pe].ucp_conn,
                                    UCP_ATOMIC_OP_CSWAP, &cond, 1, rva,
@@ -60,6 +81,10 @@ int mca_atomic_ucx_cswap(shmem_ctx_t ctx,
                                      opal_common_ucx_empty_complete_cb);
 #endif
 
+    if (nb) {
+        return mca_atomic_ucx_nb_posted(ucx_ctx, pe, status_ptr);
+    }
+
     if (OPAL_LIKELY(!UCS_PTR_IS_ERR(status_ptr))) {
         mca_spml_ucx_remote_op_posted(ucx_ctx, pe);
     }
@@ -71,3 +96,27 @@ int mca_atomic_ucx_cswap(shmem_ctx_t ctx,
                                         "ucp_atomic_fetch_nb");
 #endif
 }
+
+int mca_atomic_ucx_cswap(shmem_ctx_t ctx,
+                         void *target,
+                         uint64_t *prev,
+                         uint64_t cond,
+                         uint64_t value,
+                         size_t size,
+                         int pe)
+{
+    return mca_atomic_ucx_cswap_common(ctx, target, prev, cond, value,
+                                       size, pe, false);
+}
+
+int mca_atomic_ucx_cswap_nb(shmem_ctx_t ctx,
+                            void *target,
+                            void *prev,
+                            uint64_t cond,
+                            uint64_t value,
+                            size_t size,
+                            int pe)
+{
+    return mca_atomic_ucx_cswap_common(ctx, target, prev, cond, value,
+                                       size, pe, true);
+}
@@ -49,6 +49,7 @@ int mca_atomic_ucx_op(shmem_ctx_t ctx,
                       uint64_t value,
                       size_t size,
                       int pe,
+                      int direct_op,
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
                       ucp_atomic_op_t op)
 #else
@@ -58,14 +59,21 @@ int mca_atomic_ucx_op(shmem_ctx_t ctx,
     ucs_status_t status;
     spml_ucx_mkey_t *ucx_mkey;
     uint64_t rva;
-    mca_spml_ucx_ctx_t *ucx_ctx = (mca_spml_ucx_ctx_t *)ctx;
+    void *ptr;
+    mca_spml_ucx_ctx_t *ucx_ctx = mca_spml_ucx_ctx_resolve(ctx, mca_spml_self);
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
     ucs_status_ptr_t status_ptr;
 #endif
 
     assert((8 == size) || (4 == size));
 
-    ucx_mkey = mca_spml_ucx_get_mkey(ctx, pe, target, (void *)&rva, mca_spml_self);
+    ucx_mkey = mca_spml_ucx_get_mkey((shmem_ctx_t)ucx_ctx, pe, target, (void *)&rva,
+                                     mca_spml_self);
+    ptr      = mca_atomic_ucx_direct_ptr(ucx_mkey, rva);
+    if (NULL != ptr) {
+        (void)mca_atomic_ucx_direct_fop(ptr, value, size, direct_op);
+        return OSHMEM_SUCCESS;
+    }
 
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
     status_ptr = ucp_atomic_op_nbx(ucx_ctx->ucp_peers[pe].ucp_conn,
@@ -94,6 +102,8 @@ int mca_atomic_ucx_fop(shmem_ctx_t ctx,
                        uint64_t value,
                        size_t size,
                        int pe,
+                       int direct_op,
+                       bool nb,
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
                        ucp_atomic_op_t op)
 #else
@@ -103,7 +113,8 @@ int mca_atomic_ucx_fop(shmem_ctx_t ctx,
     ucs_status_ptr_t status_ptr;
     spml_ucx_mkey_t *ucx_mkey;
     uint64_t rva;
-    mca_spml_ucx_ctx_t *ucx_ctx = (mca_spml_ucx_ctx_t *)ctx;
+    void *ptr;
+    mca_spml_ucx_ctx_t *ucx_ctx = mca_spml_ucx_ctx_resolve(ctx, mca_spml_self);
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
     ucp_request_param_t param = {
         .op_attr_mask = UCP_OP_ATTR_FIELD_DATATYPE |
@@ -115,10 +126,22 @@ int mca_atomic_ucx_fop(shmem_ctx_t ctx,
 
     assert((8 == size) || (4 == size));
 
-    ucx_mkey = mca_spml_ucx_get_mkey(ctx, pe, target, (void *)&rva, mca_spml_self);
+    ucx_mkey = mca_spml_ucx_get_mkey((shmem_ctx_t)ucx_ctx, pe, target, (void *)&rva,
+                                     mca_spml_self);
+    ptr      = mca_atomic_ucx_direct_ptr(ucx_mkey, rva);
+    if (NULL != ptr) {
+        mca_atomic_ucx_direct_store_prev(prev,
+                                         mca_atomic_ucx_direct_fop(ptr, value, size, direct_op),
+                                         size);
+        return OSHMEM_SUCCESS;
+    }
+
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
     status_ptr = ucp_atomic_op_nbx(ucx_ctx->ucp_peers[pe].ucp_conn, op, &value, 1,
                                    rva, ucx_mkey->rkey, &param);
+    if (nb) {
+        return mca_atomic_ucx_nb_posted(ucx_ctx, pe, status_ptr);
+    }
     return opal_common_ucx_wait_request(status_ptr, ucx_ctx->ucp_worker[0],
                                         "ucp_atomic_op_nbx");
 #else
@@ -126,6 +149,9 @@ int mca_atomic_ucx_fop(shmem_ctx_t ctx,
                                      op, value, prev, size,
                                      rva, ucx_mkey->rkey,
                                      opal_common_ucx_empty_complete_cb);
+    if (nb) {
+        return mca_atomic_ucx_nb_posted(ucx_ctx, pe, status_ptr);
+    }
     return opal_common_ucx_wait_request(status_ptr, ucx_ctx->ucp_worker[0],
                                         "ucp_atomic_fetch_nb");
 #endif
@@ -138,9 +164,11 @@ static int mca_atomic_ucx_add(shmem_ctx_t ctx,
                               int pe)
 {
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
-    return mca_atomic_ucx_op(ctx, target, value, size, pe, UCP_ATOMIC_OP_ADD);
+    return mca_atomic_ucx_op(ctx, target, value, size, pe,
+                             MCA_ATOMIC_UCX_DIRECT_ADD, UCP_ATOMIC_OP_ADD);
 #else
-    return mca_atomic_ucx_op(ctx, target, value, size, pe, UCP_ATOMIC_POST_OP_ADD);
+    return mca_atomic_ucx_op(ctx, target, value, size, pe,
+                             MCA_ATOMIC_UCX_DIRECT_ADD, UCP_ATOMIC_POST_OP_ADD);
 #endif
 }
 
@@ -151,9 +179,11 @@ static int mca_atomic_ucx_and(shmem_ctx_t ctx,
                               int pe)
 {
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
-    return mca_atomic_ucx_op(ctx, target, value, size, pe, UCP_ATOMIC_OP_AND);
+    return mca_atomic_ucx_op(ctx, target, value, size, pe,
+                             MCA_ATOMIC_UCX_DIRECT_AND, UCP_ATOMIC_OP_AND);
 #elif HAVE_DECL_UCP_ATOMIC_POST_OP_AND
-    return mca_atomic_ucx_op(ctx, target, value, size, pe, UCP_ATOMIC_POST_OP_AND);
+    return mca_atomic_ucx_op(ctx, target, value, size, pe,
+                             MCA_ATOMIC_UCX_DIRECT_AND, UCP_ATOMIC_POST_OP_AND);
 #else
     return OSHMEM_ERR_NOT_IMPLEMENTED;
 #endif
@@ -166,9 +196,11 @@ static int mca_atomic_ucx_or(shmem_ctx_t ctx,
                               int pe)
 {
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
-    return mca_atomic_ucx_op(ctx, target, value, size, pe, UCP_ATOMIC_OP_OR);
+    return mca_atomic_ucx_op(ctx, target, value, size, pe,
+                             MCA_ATOMIC_UCX_DIRECT_OR, UCP_ATOMIC_OP_OR);
 #elif HAVE_DECL_UCP_ATOMIC_POST_OP_OR
-    return mca_atomic_ucx_op(ctx, target, value, size, pe, UCP_ATOMIC_POST_OP_OR);
+    return mca_atomic_ucx_op(ctx, target, value, size, pe,
+                             MCA_ATOMIC_UCX_DIRECT_OR, UCP_ATOMIC_POST_OP_OR);
 #else
     return OSHMEM_ERR_NOT_IMPLEMENTED;
 #endif
@@ -181,9 +213,11 @@ static int mca_atomic_ucx_xor(shmem_ctx_t ctx,
                               int pe)
 {
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
-    return mca_atomic_ucx_op(ctx, target, value, size, pe, UCP_ATOMIC_OP_XOR);
+    return mca_atomic_ucx_op(ctx, target, value, size, pe,
+                             MCA_ATOMIC_UCX_DIRECT_XOR, UCP_ATOMIC_OP_XOR);
 #elif HAVE_DECL_UCP_ATOMIC_POST_OP_XOR
-    return mca_atomic_ucx_op(ctx, target, value, size, pe, UCP_ATOMIC_POST_OP_XOR);
+    return mca_atomic_ucx_op(ctx, target, value, size, pe,
+                             MCA_ATOMIC_UCX_DIRECT_XOR, UCP_ATOMIC_POST_OP_XOR);
 #else
     return OSHMEM_ERR_NOT_IMPLEMENTED;
 #endif
@@ -197,9 +231,11 @@ static int mca_atomic_ucx_fadd(shmem_ctx_t ctx,
                                int pe)
 {
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
-    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe, UCP_ATOMIC_OP_ADD);
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_ADD, false, UCP_ATOMIC_OP_ADD);
 #else
-    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe, UCP_ATOMIC_FETCH_OP_FADD);
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_ADD, false, UCP_ATOMIC_FETCH_OP_FADD);
 #endif
 }
 
@@ -211,9 +247,11 @@ static int mca_atomic_ucx_fand(shmem_ctx_t ctx,
                                int pe)
 {
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
-    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe, UCP_ATOMIC_OP_AND);
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_AND, false, UCP_ATOMIC_OP_AND);
 #elif HAVE_DECL_UCP_ATOMIC_FETCH_OP_FAND
-    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe, UCP_ATOMIC_FETCH_OP_FAND);
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_AND, false, UCP_ATOMIC_FETCH_OP_FAND);
 #else
     return OSHMEM_ERR_NOT_IMPLEMENTED;
 #endif
@@ -227,9 +265,11 @@ static int mca_atomic_ucx_for(shmem_ctx_t ctx,
                                int pe)
 {
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
-    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe, UCP_ATOMIC_OP_OR);
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_OR, false, UCP_ATOMIC_OP_OR);
 #elif HAVE_DECL_UCP_ATOMIC_FETCH_OP_FOR
-    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe, UCP_ATOMIC_FETCH_OP_FOR);
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_OR, false, UCP_ATOMIC_FETCH_OP_FOR);
 #else
     return OSHMEM_ERR_NOT_IMPLEMENTED;
 #endif
@@ -243,9 +283,11 @@ static int mca_atomic_ucx_fxor(shmem_ctx_t ctx,
                                int pe)
 {
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
-    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe, UCP_ATOMIC_OP_XOR);
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_XOR, false, UCP_ATOMIC_OP_XOR);
 #elif HAVE_DECL_UCP_ATOMIC_FETCH_OP_FXOR
-    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe, UCP_ATOMIC_FETCH_OP_FXOR);
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_XOR, false, UCP_ATOMIC_FETCH_OP_FXOR);
 #else
     return OSHMEM_ERR_NOT_IMPLEMENTED;
 #endif
@@ -259,12 +301,99 @@ static int mca_atomic_ucx_swap(shmem_ctx_t ctx,
                                int pe)
 {
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
-    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe, UCP_ATOMIC_OP_SWAP);
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_SWAP, false, UCP_ATOMIC_OP_SWAP);
+#else
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_SWAP, false, UCP_ATOMIC_FETCH_OP_SWAP);
+#endif
+}
+
+static int mca_atomic_ucx_fadd_nb(shmem_ctx_t ctx,
+                                  void *target,
+                                  void *prev,
+                                  uint64_t value,
+                                  size_t size,
+                                  int pe)
+{
+#if HAVE_DECL_UCP_ATOMIC_OP_NBX
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_ADD, true, UCP_ATOMIC_OP_ADD);
+#else
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_ADD, true, UCP_ATOMIC_FETCH_OP_FADD);
+#endif
+}
+
+static int mca_atomic_ucx_fand_nb(shmem_ctx_t ctx,
+                                  void *target,
+                                  void *prev,
+                                  uint64_t value,
+                                  size_t size,
+                                  int pe)
+{
+#if HAVE_DECL_UCP_ATOMIC_OP_NBX
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_AND, true, UCP_ATOMIC_OP_AND);
+#elif HAVE_DECL_UCP_ATOMIC_FETCH_OP_FAND
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_AND, true, UCP_ATOMIC_FETCH_OP_FAND);
+#else
+    return OSHMEM_ERR_NOT_IMPLEMENTED;
+#endif
+}
+
+static int mca_atomic_ucx_for_nb(shmem_ctx_t ctx,
+                                  void *target,
+                                  void *prev,
+                                  uint64_t value,
+                                  size_t size,
+                                  int pe)
+{
+#if HAVE_DECL_UCP_ATOMIC_OP_NBX
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_OR, true, UCP_ATOMIC_OP_OR);
+#elif HAVE_DECL_UCP_ATOMIC_FETCH_OP_FOR
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_OR, true, UCP_ATOMIC_FETCH_OP_FOR);
+#else
+    return OSHMEM_ERR_NOT_IMPLEMENTED;
+#endif
+}
+
+static int mca_atomic_ucx_fxor_nb(shmem_ctx_t ctx,
+                                  void *target,
+                                  void *prev,
+                                  uint64_t value,
+                                  size_t size,
+                                  int pe)
+{
+#if HAVE_DECL_UCP_ATOMIC_OP_NBX
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_XOR, true, UCP_ATOMIC_OP_XOR);
+#elif HAVE_DECL_UCP_ATOMIC_FETCH_OP_FXOR
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_XOR, true, UCP_ATOMIC_FETCH_OP_FXOR);
 #else
-    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe, UCP_ATOMIC_FETCH_OP_SWAP);
+    return OSHMEM_ERR_NOT_IMPLEMENTED;
 #endif
 }
 
+static int mca_atomic_ucx_swap_nb(shmem_ctx_t ctx,
+                                  void *target,
+                                  void *prev,
+                                  uint64_t value,
+                                  size_t size,
+                                  int pe)
+{
+#if HAVE_DECL_UCP_ATOMIC_OP_NBX
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_SWAP, true, UCP_ATOMIC_OP_SWAP);
+#else
+    return mca_atomic_ucx_fop(ctx, target, prev, value, size, pe,
+                              MCA_ATOMIC_UCX_DIRECT_SWAP, true, UCP_ATOMIC_FETCH_OP_SWAP);
+#endif
+}
 
 mca_atomic_base_module_t *
 mca_atomic_ucx_query(int *priority)
@@ -285,6 +414,12 @@ mca_atomic_ucx_query(int *priority)
         module->super.atomic_fxor  = mca_atomic_ucx_fxor;
         module->super.atomic_swap  = mca_atomic_ucx_swap;
         module->super.atomic_cswap = mca_atomic_ucx_cswap;
+        module->super.atomic_fadd_nb  = mca_atomic_ucx_fadd_nb;
+        module->super.atomic_fand_nb  = mca_atomic_ucx_fand_nb;
+        module->super.atomic_for_nb   = mca_atomic_ucx_for_nb;
+        module->super.atomic_fxor_nb  = mca_atomic_ucx_fxor_nb;
+        module->super.atomic_swap_nb  = mca_atomic_ucx_swap_nb;
+        module->super.atomic_cswap_nb = mca_atomic_ucx_cswap_nb;
         return &(module->super);
     }
 
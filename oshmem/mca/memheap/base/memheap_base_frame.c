@@ -43,7 +43,8 @@ static int mca_memheap_base_register(mca_base_register_flag_t flags)
                                  "memheap",
                                  "base",
                                  "key_exchange",
-                                 "0|1 - disabled, enabled(default) force memory keys exchange",
+                                 "0|1 - disabled, enabled(default) force memory keys exchange. "
+                                 "If disabled the keys of a PE are requested from it on the first access",
                                  MCA_BASE_VAR_TYPE_INT,
                                  NULL,
                                  0,
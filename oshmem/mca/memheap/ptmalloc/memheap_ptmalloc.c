@@ -18,6 +18,7 @@
 #include "oshmem/mca/memheap/base/base.h"
 #include "opal/class/opal_hash_table.h"
 #include "opal/class/opal_object.h"
+#include "opal/util/minmax.h"
 
 mca_memheap_ptmalloc_module_t memheap_ptmalloc = {
     {
@@ -40,6 +41,201 @@ mca_memheap_ptmalloc_module_t memheap_ptmalloc = {
     100   /* priority */
 };
 
+static inline size_t _slab_block_size(int cls)
+{
+    return (size_t)1 << (cls + MEMHEAP_PTMALLOC_SLAB_MIN_SHIFT);
+}
+
+static inline unsigned int _slab_nblocks(int cls)
+{
+    return (unsigned int)(memheap_ptmalloc.slab_size / _slab_block_size(cls));
+}
+
+static void _slab_init(void)
+{
+    size_t max;
+    size_t slab_size;
+    int cls;
+
+    memset(memheap_ptmalloc.classes, 0, sizeof(memheap_ptmalloc.classes));
+    memheap_ptmalloc.slab_classes = 0;
+    if (0 >= memheap_ptmalloc.slab_max) {
+        return;
+    }
+
+    for (max = _slab_block_size(0), cls = 1;
+         (max < (size_t)memheap_ptmalloc.slab_max) && (cls < MEMHEAP_PTMALLOC_SLAB_MAX_CLASSES);
+         max <<= 1, cls++);
+    for (slab_size = 4096; slab_size < (size_t)memheap_ptmalloc.slab_size; slab_size <<= 1);
+
+    /* A slab holds a few blocks of the largest class at least */
+    if (slab_size < 8 * max) {
+        slab_size = 8 * max;
+    }
+    memheap_ptmalloc.slab_max     = (int)max;
+    memheap_ptmalloc.slab_size    = (int)slab_size;
+    memheap_ptmalloc.slab_classes = cls;
+
+    OBJ_CONSTRUCT(&memheap_ptmalloc.slabs, opal_hash_table_t);
+    opal_hash_table_init(&memheap_ptmalloc.slabs, 64);
+
+    MEMHEAP_VERBOSE(5, "size classes up to %zu bytes in slabs of %zu bytes",
+                    max, slab_size);
+}
+
+static inline int _slab_class(size_t size)
+{
+    int cls;
+
+    if ((0 == size) || (size > (size_t)memheap_ptmalloc.slab_max)) {
+        return -1;
+    }
+    for (cls = 0; _slab_block_size(cls) < size; cls++);
+    return cls;
+}
+
+static inline void _slab_link(memheap_ptmalloc_slab_t *slab)
+{
+    memheap_ptmalloc_class_t *c = &memheap_ptmalloc.classes[slab->cls];
+
+    slab->prev = NULL;
+    slab->next = c->partial;
+    if (NULL != c->partial) {
+        c->partial->prev = slab;
+    }
+    c->partial = slab;
+}
+
+static inline void _slab_unlink(memheap_ptmalloc_slab_t *slab)
+{
+    memheap_ptmalloc_class_t *c = &memheap_ptmalloc.classes[slab->cls];
+
+    if (NULL != slab->prev) {
+        slab->prev->next = slab->next;
+    } else {
+        c->partial = slab->next;
+    }
+    if (NULL != slab->next) {
+        slab->next->prev = slab->prev;
+    }
+    slab->next = slab->prev = NULL;
+}
+
+static memheap_ptmalloc_slab_t *_slab_find(void *ptr)
+{
+    memheap_ptmalloc_slab_t *slab;
+    uint64_t base;
+
+    if (0 == memheap_ptmalloc.slab_classes) {
+        return NULL;
+    }
+
+    base = (uint64_t)(uintptr_t)ptr & ~((uint64_t)memheap_ptmalloc.slab_size - 1);
+    if (OPAL_SUCCESS != opal_hash_table_get_value_uint64(&memheap_ptmalloc.slabs,
+                                                         base, (void **)&slab)) {
+        return NULL;
+    }
+    return slab;
+}
+
+static void _slab_release(memheap_ptmalloc_slab_t *slab)
+{
+    opal_hash_table_remove_value_uint64(&memheap_ptmalloc.slabs,
+                                        (uint64_t)(uintptr_t)slab->base);
+    dlfree(slab->base);
+    free(slab);
+}
+
+static void *_slab_alloc(int cls)
+{
+    memheap_ptmalloc_class_t *c = &memheap_ptmalloc.classes[cls];
+    memheap_ptmalloc_slab_t *slab = c->partial;
+    void *ptr;
+
+    if (NULL == slab) {
+        slab = c->spare;
+        c->spare = NULL;
+        if (NULL == slab) {
+            slab = (memheap_ptmalloc_slab_t *)calloc(1, sizeof(*slab));
+            if (NULL == slab) {
+                return NULL;
+            }
+            slab->cls  = cls;
+            slab->base = dlmemalign(memheap_ptmalloc.slab_size, memheap_ptmalloc.slab_size);
+            if ((NULL == slab->base) ||
+                (OPAL_SUCCESS != opal_hash_table_set_value_uint64(&memheap_ptmalloc.slabs,
+                                                                  (uint64_t)(uintptr_t)slab->base,
+                                                                  slab))) {
+                if (NULL != slab->base) {
+                    dlfree(slab->base);
+                }
+                free(slab);
+                return NULL;
+            }
+        }
+        _slab_link(slab);
+    }
+
+    if (NULL != slab->free_list) {
+        ptr = slab->free_list;
+        slab->free_list = *(void **)ptr;
+    } else {
+        ptr = slab->base + slab->bump * _slab_block_size(cls);
+        slab->bump++;
+    }
+    if (++slab->used == _slab_nblocks(cls)) {
+        _slab_unlink(slab);
+    }
+    return ptr;
+}
+
+static void _slab_free(memheap_ptmalloc_slab_t *slab, void *ptr)
+{
+    memheap_ptmalloc_class_t *c = &memheap_ptmalloc.classes[slab->cls];
+
+    if (slab->used == _slab_nblocks(slab->cls)) {
+        _slab_link(slab);
+    }
+    *(void **)ptr = slab->free_list;
+    slab->free_list = ptr;
+    if (0 != --slab->used) {
+        return;
+    }
+
+    /* Keep one empty slab to not bounce the chunk between dlmalloc and
+     * the class on alloc/free loops, give the others back */
+    _slab_unlink(slab);
+    if (NULL == c->spare) {
+        slab->free_list = NULL;
+        slab->bump      = 0;
+        c->spare        = slab;
+    } else {
+        _slab_release(slab);
+    }
+}
+
+static void _slab_finalize(void)
+{
+    memheap_ptmalloc_slab_t *slab;
+    int cls;
+
+    if (0 == memheap_ptmalloc.slab_classes) {
+        return;
+    }
+
+    /* The chunks are in the symmetric heap which goes away as a whole */
+    for (cls = 0; cls < memheap_ptmalloc.slab_classes; cls++) {
+        while (NULL != (slab = memheap_ptmalloc.classes[cls].partial)) {
+            _slab_unlink(slab);
+            free(slab);
+        }
+        free(memheap_ptmalloc.classes[cls].spare);
+        memheap_ptmalloc.classes[cls].spare = NULL;
+    }
+    OBJ_DESTRUCT(&memheap_ptmalloc.slabs);
+    memheap_ptmalloc.slab_classes = 0;
+}
+
 /* Memory Heap Buddy Implementation */
 /**
  * Initialize the Memory Heap
@@ -56,6 +252,7 @@ int mca_memheap_ptmalloc_module_init(memheap_context_t *context)
     memheap_ptmalloc.cur_size = 0;
     memheap_ptmalloc.max_size = context->user_size + context->private_size;
     memheap_ptmalloc.max_alloc_size = context->user_size;
+    _slab_init();
 
     MEMHEAP_VERBOSE(1,
                     "symmetric heap memory (user+private): %llu bytes",
@@ -73,13 +270,17 @@ int mca_memheap_ptmalloc_module_init(memheap_context_t *context)
  */
 int mca_memheap_ptmalloc_alloc(size_t size, void** p_buff)
 {
+    int cls;
+
     if (size > memheap_ptmalloc.max_alloc_size) {
         *p_buff = 0;
         return OSHMEM_ERR_OUT_OF_RESOURCE;
     }
 
+    cls = _slab_class(size);
+
     OPAL_THREAD_LOCK(&memheap_ptmalloc.lock);
-    *p_buff = dlmalloc(size);
+    *p_buff = (0 <= cls) ? _slab_alloc(cls) : dlmalloc(size);
     OPAL_THREAD_UNLOCK(&memheap_ptmalloc.lock);
 
     if (NULL == *p_buff)
@@ -91,6 +292,8 @@ int mca_memheap_ptmalloc_alloc(size_t size, void** p_buff)
 
 int mca_memheap_ptmalloc_align(size_t align, size_t size, void **p_buff)
 {
+    int cls;
+
     if (size > memheap_ptmalloc.max_alloc_size) {
         *p_buff = 0;
         return OSHMEM_ERR_OUT_OF_RESOURCE;
@@ -107,8 +310,11 @@ int mca_memheap_ptmalloc_align(size_t align, size_t size, void **p_buff)
         return OSHMEM_ERROR;
     }
 
+    /* The blocks are aligned to their class size */
+    cls = _slab_class(opal_max(size, align));
+
     OPAL_THREAD_LOCK(&memheap_ptmalloc.lock);
-    *p_buff = dlmemalign(align, size);
+    *p_buff = (0 <= cls) ? _slab_alloc(cls) : dlmemalign(align, size);
     OPAL_THREAD_UNLOCK(&memheap_ptmalloc.lock);
 
     if (NULL == *p_buff)
@@ -122,13 +328,29 @@ int mca_memheap_ptmalloc_realloc(size_t new_size,
                                  void *p_buff,
                                  void **p_new_buff)
 {
+    memheap_ptmalloc_slab_t *slab;
+    int cls;
+
     if (new_size > memheap_ptmalloc.max_alloc_size) {
         *p_new_buff = 0;
         return OSHMEM_ERR_OUT_OF_RESOURCE;
     }
 
     OPAL_THREAD_LOCK(&memheap_ptmalloc.lock);
-    *p_new_buff = dlrealloc(p_buff, new_size);
+    slab = (NULL != p_buff) ? _slab_find(p_buff) : NULL;
+    if (NULL == slab) {
+        cls = (NULL == p_buff) ? _slab_class(new_size) : -1;
+        *p_new_buff = (0 <= cls) ? _slab_alloc(cls) : dlrealloc(p_buff, new_size);
+    } else if ((0 < new_size) && (new_size <= _slab_block_size(slab->cls))) {
+        *p_new_buff = p_buff;
+    } else {
+        cls = _slab_class(new_size);
+        *p_new_buff = (0 <= cls) ? _slab_alloc(cls) : dlmalloc(new_size);
+        if (NULL != *p_new_buff) {
+            memcpy(*p_new_buff, p_buff, opal_min(new_size, _slab_block_size(slab->cls)));
+            _slab_free(slab, p_buff);
+        }
+    }
     OPAL_THREAD_UNLOCK(&memheap_ptmalloc.lock);
 
     if (!*p_new_buff)
@@ -144,8 +366,15 @@ int mca_memheap_ptmalloc_realloc(size_t new_size,
  */
 int mca_memheap_ptmalloc_free(void* ptr)
 {
+    memheap_ptmalloc_slab_t *slab;
+
     OPAL_THREAD_LOCK(&memheap_ptmalloc.lock);
-    dlfree(ptr);
+    slab = (NULL != ptr) ? _slab_find(ptr) : NULL;
+    if (NULL != slab) {
+        _slab_free(slab, ptr);
+    } else {
+        dlfree(ptr);
+    }
     OPAL_THREAD_UNLOCK(&memheap_ptmalloc.lock);
     return OSHMEM_SUCCESS;
 }
@@ -153,6 +382,7 @@ int mca_memheap_ptmalloc_free(void* ptr)
 int mca_memheap_ptmalloc_finalize()
 {
     MEMHEAP_VERBOSE(5, "deregistering symmetric heap");
+    _slab_finalize();
     return OSHMEM_SUCCESS;
 }
 
@@ -42,6 +42,31 @@ BEGIN_C_DECLS
  * At the moment we do not support growing/returning heap based memory to OS.
  */
 
+/*
+ * Small allocations are served from slabs of power of two size classes,
+ * which dlmalloc hands out in slab_size aligned chunks. A block is aligned
+ * to its class size, and the slab a block belongs to is found by masking
+ * its address. The slabs are carved in the order of the allocations, so
+ * the addresses stay symmetric just like the ones of dlmalloc.
+ */
+#define MEMHEAP_PTMALLOC_SLAB_MIN_SHIFT     4
+#define MEMHEAP_PTMALLOC_SLAB_MAX_CLASSES   16
+
+typedef struct memheap_ptmalloc_slab {
+    struct memheap_ptmalloc_slab *next; /* in the partial list of the class */
+    struct memheap_ptmalloc_slab *prev;
+    char *base;
+    void *free_list;                    /* linked through the freed blocks */
+    unsigned int bump;                  /* first block never handed out */
+    unsigned int used;
+    int cls;
+} memheap_ptmalloc_slab_t;
+
+typedef struct memheap_ptmalloc_class {
+    memheap_ptmalloc_slab_t *partial;   /* slabs with free blocks */
+    memheap_ptmalloc_slab_t *spare;     /* an empty slab kept for reuse */
+} memheap_ptmalloc_class_t;
+
 /* Structure for managing shmem symmetric heap */
 struct mca_memheap_ptmalloc_module_t {
     mca_memheap_base_module_t super;
@@ -51,6 +76,11 @@ struct mca_memheap_ptmalloc_module_t {
     size_t max_size;
     size_t max_alloc_size;
     opal_mutex_t lock; /** Part of the allocator */
+    int slab_max;           /** Largest size served from slabs, 0 to disable */
+    int slab_size;
+    int slab_classes;
+    memheap_ptmalloc_class_t classes[MEMHEAP_PTMALLOC_SLAB_MAX_CLASSES];
+    opal_hash_table_t slabs;
 };
 
 typedef struct mca_memheap_ptmalloc_module_t mca_memheap_ptmalloc_module_t;
@@ -22,6 +22,7 @@ static int mca_memheap_ptmalloc_component_query(mca_base_module_t **module,
                                                 int *priority);
 
 static int _basic_open(void);
+static int _basic_register(void);
 
 mca_memheap_base_component_t mca_memheap_ptmalloc_component = {
     .memheap_version = {
@@ -34,6 +35,7 @@ mca_memheap_base_component_t mca_memheap_ptmalloc_component = {
         .mca_open_component = _basic_open,
         .mca_close_component = mca_memheap_ptmalloc_component_close,
         .mca_query_component = mca_memheap_ptmalloc_component_query,
+        .mca_register_component_params = _basic_register,
     },
     .memheap_data = {
         /* The component is checkpoint ready */
@@ -48,6 +50,33 @@ static int _basic_open(void)
     return OSHMEM_SUCCESS;
 }
 
+static int _basic_register(void)
+{
+    mca_base_component_t *comp = &mca_memheap_ptmalloc_component.memheap_version;
+
+    memheap_ptmalloc.slab_max = 1024;
+    (void) mca_base_component_var_register(comp,
+                                           "slab_max",
+                                           "Largest allocation in bytes served from the size class slabs, "
+                                           "rounded up to a power of two (0 - disabled)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &memheap_ptmalloc.slab_max);
+
+    memheap_ptmalloc.slab_size = 65536;
+    (void) mca_base_component_var_register(comp,
+                                           "slab_size",
+                                           "Size in bytes of the slabs the small allocations are carved from, "
+                                           "rounded up to a power of two",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &memheap_ptmalloc.slab_size);
+
+    return OSHMEM_SUCCESS;
+}
+
 /* query component */
 static int
 mca_memheap_ptmalloc_component_query(mca_base_module_t **module, int *priority)
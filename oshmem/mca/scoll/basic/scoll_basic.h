@@ -38,6 +38,7 @@ mca_scoll_basic_component;
 extern int mca_scoll_basic_priority_param;
 OSHMEM_DECLSPEC extern int mca_scoll_basic_param_barrier_algorithm;
 extern int mca_scoll_basic_param_broadcast_algorithm;
+extern int mca_scoll_basic_param_broadcast_segment;
 extern int mca_scoll_basic_param_collect_algorithm;
 extern int mca_scoll_basic_param_reduce_algorithm;
 
@@ -34,6 +34,12 @@ static int _algorithm_binomial_tree(struct oshmem_group_t *group,
                                      const void *source,
                                      size_t nlong,
                                      long *pSync);
+static int _algorithm_pipeline(struct oshmem_group_t *group,
+                               int PE_root,
+                               void *target,
+                               const void *source,
+                               size_t nlong,
+                               long *pSync);
 
 int mca_scoll_basic_broadcast(struct oshmem_group_t *group,
                               int PE_root,
@@ -85,6 +91,16 @@ int mca_scoll_basic_broadcast(struct oshmem_group_t *group,
                                                    pSync);
                     break;
                 }
+            case SCOLL_ALG_BROADCAST_PIPELINE:
+                {
+                    rc = _algorithm_pipeline(group,
+                                             PE_root,
+                                             target,
+                                             source,
+                                             nlong,
+                                             pSync);
+                    break;
+                }
             default:
                 {
                     rc = _algorithm_binomial_tree(group,
@@ -258,3 +274,124 @@ static int _algorithm_binomial_tree(struct oshmem_group_t *group,
 
     return rc;
 }
+
+/*
+ The Pipelined Chain algorithm.
+ PEs form a chain starting at the root and data is sent down the chain in
+ segments of mca_scoll_basic_param_broadcast_segment bytes. A PE forwards
+ a segment as soon as it arrives, so all links of the chain are busy at the
+ same time. pSync[0] counts the bytes received, pSync[1] carries the
+ message size.
+ Outlay:
+ The game scales with NP + nlong / segment and uses 2 bytes of memory.
+ It is intended for large messages.
+ */
+static int _algorithm_pipeline(struct oshmem_group_t *group,
+                               int PE_root,
+                               void *target,
+                               const void *source,
+                               size_t nlong,
+                               long *pSync)
+{
+    int rc = OSHMEM_SUCCESS;
+    long value = SHMEM_SYNC_READY;
+    int root_id = oshmem_proc_group_find_id(group, PE_root);
+    int my_id = oshmem_proc_group_find_id(group, group->my_pe);
+    int vrank = (my_id + group->proc_count - root_id) % group->proc_count;
+    int next_pe = -1;
+    size_t segment = (size_t)mca_scoll_basic_param_broadcast_segment;
+    size_t received = 0;
+    size_t sent = 0;
+    size_t len = 0;
+
+    SCOLL_VERBOSE(12, "[#%d] Broadcast algorithm: Pipeline", group->my_pe);
+    SCOLL_VERBOSE(15,
+                  "[#%d] pSync[0] = %ld root = #%d",
+                  group->my_pe, pSync[0], PE_root);
+
+    if (0 == segment) {
+        segment = nlong;
+    }
+
+    if (vrank + 1 < group->proc_count) {
+        next_pe = oshmem_proc_pe(group->proc_array[(my_id + 1) % group->proc_count]);
+    }
+
+    pSync[0] = SHMEM_SYNC_READY;
+    if (vrank > 0) {
+        /* The first update of the counter follows the message size */
+        SCOLL_VERBOSE(14, "[#%d] wait", group->my_pe);
+        rc = MCA_SPML_CALL(wait((void*)pSync, SHMEM_CMP_NE, (void*)&value, SHMEM_LONG));
+        if (OSHMEM_SUCCESS != rc) {
+            return rc;
+        }
+        nlong = (size_t) pSync[1];
+        received = (size_t) pSync[0];
+    } else {
+        received = nlong;
+    }
+
+    if (next_pe >= 0) {
+        SCOLL_VERBOSE(14,
+                      "[#%d] check remote pe is ready to receive #%d",
+                      group->my_pe, next_pe);
+        do {
+            rc = MCA_SPML_CALL(get(oshmem_ctx_default, (void*)pSync, sizeof(value),
+                                   (void*)&value, next_pe));
+        } while ((OSHMEM_SUCCESS == rc) && (value != SHMEM_SYNC_READY));
+        if (OSHMEM_SUCCESS != rc) {
+            return rc;
+        }
+
+        value = (long)nlong;
+        rc = MCA_SPML_CALL(put(oshmem_ctx_default, (void*)(pSync + 1), sizeof(value),
+                               (void*)&value, next_pe));
+        if (OSHMEM_SUCCESS != rc) {
+            return rc;
+        }
+    }
+
+    do {
+        /* Forward what has been received so far */
+        while ((next_pe >= 0) && (sent < received)) {
+            len = received - sent;
+            len = (len > segment) ? segment : len;
+
+            SCOLL_VERBOSE(15, "[#%d] send %zu bytes at %zu to #%d",
+                          group->my_pe, len, sent, next_pe);
+            rc = MCA_SPML_CALL(put(oshmem_ctx_default, (char *)target + sent, len,
+                                   (vrank == 0 ? (char *)source : (char *)target) + sent,
+                                   next_pe));
+            if (OSHMEM_SUCCESS != rc) {
+                return rc;
+            }
+            MCA_SPML_CALL(fence(oshmem_ctx_default));
+
+            sent += len;
+            value = (long)sent;
+            rc = MCA_SPML_CALL(put(oshmem_ctx_default, (void*)pSync, sizeof(value),
+                                   (void*)&value, next_pe));
+            if (OSHMEM_SUCCESS != rc) {
+                return rc;
+            }
+        }
+
+        if (received < nlong) {
+            value = (long)received;
+            rc = MCA_SPML_CALL(wait((void*)pSync, SHMEM_CMP_GT, (void*)&value, SHMEM_LONG));
+            if (OSHMEM_SUCCESS != rc) {
+                return rc;
+            }
+            received = (size_t) pSync[0];
+        }
+    } while ((received < nlong) || ((next_pe >= 0) && (sent < nlong)));
+
+    /* A zero size message still has to be signalled down the chain */
+    if ((next_pe >= 0) && (0 == nlong)) {
+        value = 0;
+        rc = MCA_SPML_CALL(put(oshmem_ctx_default, (void*)pSync, sizeof(value),
+                               (void*)&value, next_pe));
+    }
+
+    return rc;
+}
@@ -30,6 +30,7 @@ const char *mca_scoll_basic_component_version_string =
 int mca_scoll_basic_priority_param = -1;
 int mca_scoll_basic_param_barrier_algorithm = SCOLL_ALG_BARRIER_ADAPTIVE;
 int mca_scoll_basic_param_broadcast_algorithm = SCOLL_ALG_BROADCAST_BINOMIAL;
+int mca_scoll_basic_param_broadcast_segment = 8192;
 int mca_scoll_basic_param_collect_algorithm =
         SCOLL_ALG_COLLECT_RECURSIVE_DOUBLING;
 int mca_scoll_basic_param_reduce_algorithm = SCOLL_ALG_REDUCE_RECURSIVE_DOUBLING;
@@ -106,9 +107,10 @@ static int basic_register(void)
                                            &mca_scoll_basic_param_barrier_algorithm);
 
     sprintf(help_msg,
-            "Algorithm selection for Broadcast (%d - Central Counter, %d - Binomial)",
+            "Algorithm selection for Broadcast (%d - Central Counter, %d - Binomial, %d - Pipeline)",
             SCOLL_ALG_BROADCAST_CENTRAL_COUNTER,
-            SCOLL_ALG_BROADCAST_BINOMIAL);
+            SCOLL_ALG_BROADCAST_BINOMIAL,
+            SCOLL_ALG_BROADCAST_PIPELINE);
     (void) mca_base_component_var_register(comp,
                                            "broadcast_alg",
                                            help_msg,
@@ -117,6 +119,14 @@ static int basic_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_scoll_basic_param_broadcast_algorithm);
 
+    (void) mca_base_component_var_register(comp,
+                                           "broadcast_segment",
+                                           "Segment size in bytes of the Pipeline Broadcast algorithm (0 - no segmentation)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_scoll_basic_param_broadcast_segment);
+
     sprintf(help_msg,
             "Algorithm selection for Collect (%d - Central Counter, %d - Tournament, %d - Recursive Doubling, %d - Ring)",
             SCOLL_ALG_COLLECT_CENTRAL_COUNTER,
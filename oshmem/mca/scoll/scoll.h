@@ -101,6 +101,7 @@ typedef int
 
 #define SCOLL_ALG_BROADCAST_CENTRAL_COUNTER     0
 #define SCOLL_ALG_BROADCAST_BINOMIAL            1
+#define SCOLL_ALG_BROADCAST_PIPELINE            2
 
 #define SCOLL_ALG_COLLECT_CENTRAL_COUNTER       0
 #define SCOLL_ALG_COLLECT_TOURNAMENT            1
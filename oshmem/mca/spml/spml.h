@@ -343,6 +343,32 @@ typedef int (*mca_spml_base_module_put_all_nb_fn_t)(void *dest,
                                                     size_t size,
                                                     long *counter);
 
+/**
+ *  Put data to a remote PE and update a signal on the same PE once the
+ *  data is delivered (OpenSHMEM 1.5 put-with-signal).
+ *
+ *  @param ctx       The context object this routine is working on.
+ *  @param dst_addr  The address on the remote PE.
+ *  @param size      The number of bytes to be put.
+ *  @param src_addr  The local address of the data.
+ *  @param sig_addr  The address of the signal on the remote PE.
+ *  @param signal    The value used to update the signal.
+ *  @param sig_op    SHMEM_SIGNAL_SET or SHMEM_SIGNAL_ADD.
+ *  @param dst       The remote PE.
+ *  @return          OSHMEM_SUCCESS or failure status.
+ *
+ *  The blocking variant returns when src_addr can be reused, the
+ *  non-blocking one when the operations are posted. Both complete at quiet.
+ */
+typedef int (*mca_spml_base_module_put_signal_fn_t)(shmem_ctx_t ctx,
+                                                    void *dst_addr,
+                                                    size_t size,
+                                                    void *src_addr,
+                                                    uint64_t *sig_addr,
+                                                    uint64_t signal,
+                                                    int sig_op,
+                                                    int dst);
+
 /**
  * Assures ordering of delivery of put() requests
  *
@@ -411,6 +437,8 @@ struct mca_spml_base_module_1_0_0_t {
 
     mca_spml_base_module_memuse_hook_fn_t spml_memuse_hook;
     mca_spml_base_module_put_all_nb_fn_t  spml_put_all_nb;
+    mca_spml_base_module_put_signal_fn_t  spml_put_signal;
+    mca_spml_base_module_put_signal_fn_t  spml_put_signal_nb;
     void *self;
 };
 
@@ -21,7 +21,9 @@
 #include "oshmem_config.h"
 #include "opal/datatype/opal_convertor.h"
 #include "opal/mca/common/ucx/common_ucx.h"
+#include "opal/sys/atomic.h"
 #include "opal/util/opal_environ.h"
+#include "opal/util/proc.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/mca/pml/pml.h"
 
@@ -44,6 +46,8 @@
 #define SPML_UCX_PUT_DEBUG    0
 #endif
 
+static spml_ucx_mkey_t *mca_spml_ucx_get_mkey_slow(shmem_ctx_t ctx, int pe, void *va, void **rva);
+
 mca_spml_ucx_t mca_spml_ucx = {
     .super = {
         /* Init mca_spml_base_module_t */
@@ -71,6 +75,8 @@ mca_spml_ucx_t mca_spml_ucx = {
         .spml_rmkey_ptr     = mca_spml_ucx_rmkey_ptr,
         .spml_memuse_hook   = mca_spml_ucx_memuse_hook,
         .spml_put_all_nb    = mca_spml_ucx_put_all_nb,
+        .spml_put_signal    = mca_spml_ucx_put_signal,
+        .spml_put_signal_nb = mca_spml_ucx_put_signal_nb,
         .self               = (void*)&mca_spml_ucx
     },
 
@@ -78,14 +84,50 @@ mca_spml_ucx_t mca_spml_ucx = {
     .num_disconnect         = 1,
     .heap_reg_nb            = 0,
     .enabled                = 0,
-    .get_mkey_slow          = NULL
+    .get_mkey_slow          = mca_spml_ucx_get_mkey_slow,
+    .get_thread_ctx         = mca_spml_ucx_thread_ctx
 };
 
+/* Fetch the keys of the segment of va from pe on the first access */
+static spml_ucx_mkey_t *mca_spml_ucx_get_mkey_slow(shmem_ctx_t ctx, int pe, void *va, void **rva)
+{
+    mca_spml_ucx_ctx_t *ucx_ctx = (mca_spml_ucx_ctx_t *)ctx;
+    spml_ucx_cached_mkey_t *mkey;
+    map_segment_t *s;
+    sshmem_mkey_t *smkey;
+
+    s = memheap_find_va(va);
+    if (OPAL_UNLIKELY(NULL == s)) {
+        SPML_UCX_ERROR("pe=%d: %p is not a symmetric address", pe, va);
+        return NULL;
+    }
+
+    /* Makes an OOB request to pe unless another context already did,
+     * the reply is unpacked into ctx */
+    smkey = mca_memheap_base_get_cached_mkey(ctx, pe, va, 0, rva);
+    if (OPAL_UNLIKELY(NULL == smkey)) {
+        SPML_UCX_ERROR("pe=%d: failed to get the keys of segment %d", pe,
+                       (int)(s - memheap_map->mem_segs));
+        return NULL;
+    }
+
+    mkey = &ucx_ctx->ucp_peers[pe].mkeys[s - memheap_map->mem_segs];
+    if (!map_segment_is_va_in(&mkey->super.super, va)) {
+        mca_spml_ucx_rmkey_unpack(ctx, smkey, s - memheap_map->mem_segs, pe, 0);
+    }
+
+    *rva = map_segment_va2rva(&mkey->super, va);
+    return &mkey->key;
+}
+
 mca_spml_ucx_ctx_t mca_spml_ucx_ctx_default = {
     .ucp_worker         = NULL,
     .ucp_peers          = NULL,
     .options            = 0,
-    .synchronized_quiet = false
+    .synchronized_quiet = false,
+    .track_put_ops      = false,
+    .flush_reqs         = NULL,
+    .signal_reply       = 0
 };
 
 #if HAVE_DECL_UCP_ATOMIC_OP_NBX
@@ -254,7 +296,12 @@ int mca_spml_ucx_init_put_op_mask(mca_spml_ucx_ctx_t *ctx, size_t nprocs)
 {
     int res;
 
-    if (mca_spml_ucx.synchronized_quiet) {
+    ctx->track_put_ops    = false;
+    ctx->put_proc_indexes = NULL;
+    ctx->flush_reqs       = NULL;
+    ctx->put_proc_count   = 0;
+
+    if (mca_spml_ucx.synchronized_quiet || mca_spml_ucx.quiet_ep_flush_max) {
         ctx->put_proc_indexes = malloc(nprocs * sizeof(*ctx->put_proc_indexes));
         if (NULL == ctx->put_proc_indexes) {
             return OSHMEM_ERR_OUT_OF_RESOURCE;
@@ -268,7 +315,18 @@ int mca_spml_ucx_init_put_op_mask(mca_spml_ucx_ctx_t *ctx, size_t nprocs)
             return res;
         }
 
-        ctx->put_proc_count = 0;
+        if (mca_spml_ucx.quiet_ep_flush_max) {
+            ctx->flush_reqs = calloc(mca_spml_ucx.quiet_ep_flush_max,
+                                     sizeof(*ctx->flush_reqs));
+            if (NULL == ctx->flush_reqs) {
+                OBJ_DESTRUCT(&ctx->put_op_bitmap);
+                free(ctx->put_proc_indexes);
+                ctx->put_proc_indexes = NULL;
+                return OSHMEM_ERR_OUT_OF_RESOURCE;
+            }
+        }
+
+        ctx->track_put_ops = true;
     }
 
     return OSHMEM_SUCCESS;
@@ -276,9 +334,13 @@ int mca_spml_ucx_init_put_op_mask(mca_spml_ucx_ctx_t *ctx, size_t nprocs)
 
 int mca_spml_ucx_clear_put_op_mask(mca_spml_ucx_ctx_t *ctx)
 {
-    if (mca_spml_ucx.synchronized_quiet && ctx->put_proc_indexes) {
+    if (ctx->track_put_ops) {
         OBJ_DESTRUCT(&ctx->put_op_bitmap);
         free(ctx->put_proc_indexes);
+        free(ctx->flush_reqs);
+        ctx->put_proc_indexes = NULL;
+        ctx->flush_reqs       = NULL;
+        ctx->track_put_ops    = false;
     }
 
     return OSHMEM_SUCCESS;
@@ -363,7 +425,8 @@ int mca_spml_ucx_add_procs(ompi_proc_t** procs, size_t nprocs)
         OSHMEM_PROC_DATA(procs[i])->transport_ids = spml_ucx_transport_ids;
 
         for (j = 0; j < MCA_MEMHEAP_MAX_SEGMENTS; j++) {
-            mca_spml_ucx_ctx_default.ucp_peers[i].mkeys[j].key.rkey = NULL;
+            mca_spml_ucx_ctx_default.ucp_peers[i].mkeys[j].key.rkey   = NULL;
+            mca_spml_ucx_ctx_default.ucp_peers[i].mkeys[j].key.mapped = false;
         }
     }
 
@@ -377,6 +440,11 @@ int mca_spml_ucx_add_procs(ompi_proc_t** procs, size_t nprocs)
     free(wk_addr_len);
     free(wk_local_addr);
 
+    if (mca_spml_ucx.direct_atomics < 0) {
+        mca_spml_ucx.direct_atomics = mca_spml_ucx.direct_rma &&
+                                      (nprocs == (size_t)opal_process_info.num_local_peers + 1);
+    }
+
     SPML_UCX_VERBOSE(50, "*** ADDED PROCS ***");
 
     opal_common_ucx_mca_proc_added();
@@ -427,6 +495,7 @@ void mca_spml_ucx_rmkey_free(sshmem_mkey_t *mkey)
         return;
     }
     ucx_mkey = (spml_ucx_mkey_t *)(mkey->spml_context);
+    ucx_mkey->mapped = false;
     ucp_rkey_destroy(ucx_mkey->rkey);
 }
 
@@ -434,14 +503,27 @@ void *mca_spml_ucx_rmkey_ptr(const void *dst_addr, sshmem_mkey_t *mkey, int pe)
 {
 #if (((UCP_API_MAJOR >= 1) && (UCP_API_MINOR >= 3)) || (UCP_API_MAJOR >= 2))
     void *rva;
+    void *ptr;
     ucs_status_t err;
+    map_segment_t *mem_seg;
     spml_ucx_mkey_t *ucx_mkey = (spml_ucx_mkey_t *)(mkey->spml_context);
 
-    err = ucp_rkey_ptr(ucx_mkey->rkey, (uint64_t)dst_addr, &rva);
+    mem_seg = memheap_find_va((void *)dst_addr);
+    if (OPAL_UNLIKELY(NULL == mem_seg)) {
+        return NULL;
+    }
+    rva = memheap_va2rva((void *)dst_addr, mem_seg->super.va_base, mkey->va_base);
+
+    /* same mapping the put/get fast path uses */
+    if (ucx_mkey->mapped) {
+        return mca_spml_ucx_mkey_ptr(ucx_mkey, rva);
+    }
+
+    err = ucp_rkey_ptr(ucx_mkey->rkey, (uint64_t)rva, &ptr);
     if (UCS_OK != err) {
         return NULL;
     }
-    return rva;
+    return ptr;
 #else
     return NULL;
 #endif
@@ -574,6 +656,9 @@ sshmem_mkey_t *mca_spml_ucx_register(void* addr,
         goto error_unmap;
     }
 
+    /* The MPI windows over the segment use the same registration */
+    opal_common_ucx_shared_mem_add(mca_spml_ucx.ucp_context, addr, size, ucx_mkey->mem_h);
+
     mkeys[0].len     = len;
     mkeys[0].va_base = addr;
     *count = 1;
@@ -607,11 +692,13 @@ int mca_spml_ucx_deregister(sshmem_mkey_t *mkeys)
         return OSHMEM_ERROR;
     }
 
+    opal_common_ucx_shared_mem_del(ucx_mkey->mem_h);
     if (MAP_SEGMENT_ALLOC_UCX != mem_seg->type) {
         ucp_mem_unmap(mca_spml_ucx.ucp_context, ucx_mkey->mem_h);
     }
     ucp_rkey_destroy(ucx_mkey->rkey);
-    ucx_mkey->rkey = NULL;
+    ucx_mkey->rkey   = NULL;
+    ucx_mkey->mapped = false;
 
     if (0 < mkeys[0].len) {
         ucp_rkey_buffer_release(mkeys[0].u.data);
@@ -712,6 +799,10 @@ static int mca_spml_ucx_ctx_create_common(long options, mca_spml_ucx_ctx_t **ucx
         }
 
         for (j = 0; j < memheap_map->n_segments; j++) {
+            /* fetched on the first access if the keys were not exchanged */
+            if (NULL == memheap_map->mem_segs[j].mkeys_cache[i]) {
+                continue;
+            }
             mkey = &memheap_map->mem_segs[j].mkeys_cache[i][0];
             ucx_mkey = &ucx_ctx->ucp_peers[i].mkeys[j].key;
             if (mkey->u.data) {
@@ -788,7 +879,7 @@ int mca_spml_ucx_ctx_create(long options, shmem_ctx_t *ctx)
     if (!(options & SHMEM_CTX_PRIVATE)) {
         SHMEM_MUTEX_LOCK(mca_spml_ucx.internal_mutex);
         _ctx_add(active_array, ucx_ctx);
-        if (active_array->ctxs_count == 0) {
+        if (active_array->ctxs_count == 1) {
             opal_progress_register(spml_ucx_ctx_progress);
         }
         SHMEM_MUTEX_UNLOCK(mca_spml_ucx.internal_mutex);
@@ -813,17 +904,87 @@ void mca_spml_ucx_ctx_destroy(shmem_ctx_t ctx)
     SHMEM_MUTEX_UNLOCK(mca_spml_ucx.internal_mutex);
 }
 
+/* The implicit context of the calling thread, created on its first
+ * operation on the default context. The contexts of the threads that
+ * exited are reused. */
+mca_spml_ucx_ctx_t *mca_spml_ucx_thread_ctx(void)
+{
+    mca_spml_ucx_ctx_t *ucx_ctx = NULL;
+    int i, rc;
+
+    opal_tsd_tracked_key_get(&mca_spml_ucx.thread_ctx_key, (void **)&ucx_ctx);
+    if (OPAL_LIKELY(NULL != ucx_ctx)) {
+        return ucx_ctx;
+    }
+
+    SHMEM_MUTEX_LOCK(mca_spml_ucx.internal_mutex);
+    for (i = 0; i < mca_spml_ucx.idle_array.ctxs_count; i++) {
+        if (0 == mca_spml_ucx.idle_array.ctxs[i]->options) {
+            ucx_ctx = mca_spml_ucx.idle_array.ctxs[i];
+            _ctx_remove(&mca_spml_ucx.idle_array, ucx_ctx, i);
+            break;
+        }
+    }
+    SHMEM_MUTEX_UNLOCK(mca_spml_ucx.internal_mutex);
+
+    if (NULL == ucx_ctx) {
+        pthread_mutex_lock(&mca_spml_ucx.ctx_create_mutex);
+        rc = mca_spml_ucx_ctx_create_common(0, &ucx_ctx);
+        pthread_mutex_unlock(&mca_spml_ucx.ctx_create_mutex);
+        if (OSHMEM_SUCCESS != rc) {
+            /* keep this thread on the shared context */
+            SPML_UCX_VERBOSE(1, "failed to create a thread context, using the default context");
+            opal_tsd_tracked_key_set(&mca_spml_ucx.thread_ctx_key, &mca_spml_ucx_ctx_default);
+            return &mca_spml_ucx_ctx_default;
+        }
+    }
+
+    SHMEM_MUTEX_LOCK(mca_spml_ucx.internal_mutex);
+    _ctx_add(&mca_spml_ucx.active_array, ucx_ctx);
+    if (mca_spml_ucx.active_array.ctxs_count == 1) {
+        opal_progress_register(spml_ucx_ctx_progress);
+    }
+    _ctx_add(&mca_spml_ucx.thread_array, ucx_ctx);
+    SHMEM_MUTEX_UNLOCK(mca_spml_ucx.internal_mutex);
+
+    opal_tsd_tracked_key_set(&mca_spml_ucx.thread_ctx_key, ucx_ctx);
+    return ucx_ctx;
+}
+
+/* Thread exit: complete the operations of the thread and keep its context
+ * for reuse */
+void mca_spml_ucx_thread_ctx_release(void *ctx)
+{
+    if ((NULL == ctx) || (ctx == (void *)&mca_spml_ucx_ctx_default)) {
+        return;
+    }
+
+    SHMEM_MUTEX_LOCK(mca_spml_ucx.internal_mutex);
+    _ctx_remove(&mca_spml_ucx.thread_array, (mca_spml_ucx_ctx_t *)ctx, 0);
+    SHMEM_MUTEX_UNLOCK(mca_spml_ucx.internal_mutex);
+
+    mca_spml_ucx_ctx_destroy((shmem_ctx_t)ctx);
+}
+
 int mca_spml_ucx_get(shmem_ctx_t ctx, void *src_addr, size_t size, void *dst_addr, int src)
 {
     void *rva;
-    spml_ucx_mkey_t *ucx_mkey = mca_spml_ucx_get_mkey(ctx, src, src_addr, &rva, &mca_spml_ucx);
-    mca_spml_ucx_ctx_t *ucx_ctx = (mca_spml_ucx_ctx_t *)ctx;
+    void *ptr;
+    mca_spml_ucx_ctx_t *ucx_ctx = mca_spml_ucx_ctx_resolve(ctx, &mca_spml_ucx);
+    spml_ucx_mkey_t *ucx_mkey = mca_spml_ucx_get_mkey((shmem_ctx_t)ucx_ctx, src, src_addr, &rva,
+                                                      &mca_spml_ucx);
 #if (HAVE_DECL_UCP_GET_NBX || HAVE_DECL_UCP_GET_NB)
     ucs_status_ptr_t request;
 #else
     ucs_status_t status;
 #endif
 
+    ptr = mca_spml_ucx_mkey_ptr(ucx_mkey, rva);
+    if (NULL != ptr) {
+        memcpy(dst_addr, ptr, size);
+        return OSHMEM_SUCCESS;
+    }
+
 #if HAVE_DECL_UCP_GET_NBX
     request = ucp_get_nbx(ucx_ctx->ucp_peers[src].ucp_conn, dst_addr, size,
                           (uint64_t)rva, ucx_mkey->rkey, &mca_spml_ucx_request_param);
@@ -839,16 +1000,24 @@ int mca_spml_ucx_get(shmem_ctx_t ctx, void *src_addr, size_t size, void *dst_add
 #endif
 }
 
-int mca_spml_ucx_get_nb(shmem_ctx_t ctx, void *src_addr, size_t size, void *dst_addr, int src, void **handle)
+static inline int mca_spml_ucx_ctx_get_nb(mca_spml_ucx_ctx_t *ucx_ctx, void *src_addr,
+                                          size_t size, void *dst_addr, int src)
 {
     void *rva;
+    void *ptr;
     ucs_status_t status;
-    spml_ucx_mkey_t *ucx_mkey = mca_spml_ucx_get_mkey(ctx, src, src_addr, &rva, &mca_spml_ucx);
-    mca_spml_ucx_ctx_t *ucx_ctx = (mca_spml_ucx_ctx_t *)ctx;
+    spml_ucx_mkey_t *ucx_mkey = mca_spml_ucx_get_mkey((shmem_ctx_t)ucx_ctx, src, src_addr, &rva,
+                                                      &mca_spml_ucx);
 #if HAVE_DECL_UCP_GET_NBX
     ucs_status_ptr_t status_ptr;
 #endif
 
+    ptr = mca_spml_ucx_mkey_ptr(ucx_mkey, rva);
+    if (NULL != ptr) {
+        memcpy(dst_addr, ptr, size);
+        return OSHMEM_SUCCESS;
+    }
+
 #if HAVE_DECL_UCP_GET_NBX
     status_ptr = ucp_get_nbx(ucx_ctx->ucp_peers[src].ucp_conn, dst_addr, size,
                              (uint64_t)rva, ucx_mkey->rkey, &mca_spml_ucx_request_param);
@@ -862,20 +1031,37 @@ int mca_spml_ucx_get_nb(shmem_ctx_t ctx, void *src_addr, size_t size, void *dst_
     status = ucp_get_nbi(ucx_ctx->ucp_peers[src].ucp_conn, dst_addr, size,
                      (uint64_t)rva, ucx_mkey->rkey);
 #endif
+    if (UCS_INPROGRESS == status) {
+        mca_spml_ucx_remote_op_posted(ucx_ctx, src);
+    }
     return ucx_status_to_oshmem_nb(status);
 }
 
+int mca_spml_ucx_get_nb(shmem_ctx_t ctx, void *src_addr, size_t size, void *dst_addr, int src, void **handle)
+{
+    return mca_spml_ucx_ctx_get_nb(mca_spml_ucx_ctx_resolve(ctx, &mca_spml_ucx),
+                                   src_addr, size, dst_addr, src);
+}
+
 int mca_spml_ucx_get_nb_wprogress(shmem_ctx_t ctx, void *src_addr, size_t size, void *dst_addr, int src, void **handle)
 {
     unsigned int i;
     void *rva;
+    void *ptr;
     ucs_status_t status;
-    spml_ucx_mkey_t *ucx_mkey = mca_spml_ucx_get_mkey(ctx, src, src_addr, &rva, &mca_spml_ucx);
-    mca_spml_ucx_ctx_t *ucx_ctx = (mca_spml_ucx_ctx_t *)ctx;
+    mca_spml_ucx_ctx_t *ucx_ctx = mca_spml_ucx_ctx_resolve(ctx, &mca_spml_ucx);
+    spml_ucx_mkey_t *ucx_mkey = mca_spml_ucx_get_mkey((shmem_ctx_t)ucx_ctx, src, src_addr, &rva,
+                                                      &mca_spml_ucx);
 #if HAVE_DECL_UCP_GET_NBX
     ucs_status_ptr_t status_ptr;
 #endif
 
+    ptr = mca_spml_ucx_mkey_ptr(ucx_mkey, rva);
+    if (NULL != ptr) {
+        memcpy(dst_addr, ptr, size);
+        return OSHMEM_SUCCESS;
+    }
+
 #if HAVE_DECL_UCP_GET_NBX
     status_ptr = ucp_get_nbx(ucx_ctx->ucp_peers[src].ucp_conn,
                              dst_addr, size, (uint64_t)rva,
@@ -890,6 +1076,9 @@ int mca_spml_ucx_get_nb_wprogress(shmem_ctx_t ctx, void *src_addr, size_t size,
     status = ucp_get_nbi(ucx_ctx->ucp_peers[src].ucp_conn, dst_addr, size,
                      (uint64_t)rva, ucx_mkey->rkey);
 #endif
+    if (UCS_INPROGRESS == status) {
+        mca_spml_ucx_remote_op_posted(ucx_ctx, src);
+    }
 
     if (++ucx_ctx->nb_progress_cnt > mca_spml_ucx.nb_get_progress_thresh) {
         for (i = 0; i < mca_spml_ucx.nb_ucp_worker_progress; i++) {
@@ -906,8 +1095,10 @@ int mca_spml_ucx_get_nb_wprogress(shmem_ctx_t ctx, void *src_addr, size_t size,
 int mca_spml_ucx_put(shmem_ctx_t ctx, void* dst_addr, size_t size, void* src_addr, int dst)
 {
     void *rva;
-    spml_ucx_mkey_t *ucx_mkey = mca_spml_ucx_get_mkey(ctx, dst, dst_addr, &rva, &mca_spml_ucx);
-    mca_spml_ucx_ctx_t *ucx_ctx = (mca_spml_ucx_ctx_t *)ctx;
+    void *ptr;
+    mca_spml_ucx_ctx_t *ucx_ctx = mca_spml_ucx_ctx_resolve(ctx, &mca_spml_ucx);
+    spml_ucx_mkey_t *ucx_mkey = mca_spml_ucx_get_mkey((shmem_ctx_t)ucx_ctx, dst, dst_addr, &rva,
+                                                      &mca_spml_ucx);
     int res;
 #if (HAVE_DECL_UCP_PUT_NBX || HAVE_DECL_UCP_PUT_NB)
     ucs_status_ptr_t request;
@@ -915,6 +1106,12 @@ int mca_spml_ucx_put(shmem_ctx_t ctx, void* dst_addr, size_t size, void* src_add
     ucs_status_t status;
 #endif
 
+    ptr = mca_spml_ucx_mkey_ptr(ucx_mkey, rva);
+    if (NULL != ptr) {
+        memcpy(ptr, src_addr, size);
+        return OSHMEM_SUCCESS;
+    }
+
 #if HAVE_DECL_UCP_PUT_NBX
     request = ucp_put_nbx(ucx_ctx->ucp_peers[dst].ucp_conn, src_addr, size,
                           (uint64_t)rva, ucx_mkey->rkey, &mca_spml_ucx_request_param);
@@ -939,13 +1136,21 @@ int mca_spml_ucx_put(shmem_ctx_t ctx, void* dst_addr, size_t size, void* src_add
 int mca_spml_ucx_put_nb(shmem_ctx_t ctx, void* dst_addr, size_t size, void* src_addr, int dst, void **handle)
 {
     void *rva;
-    spml_ucx_mkey_t *ucx_mkey = mca_spml_ucx_get_mkey(ctx, dst, dst_addr, &rva, &mca_spml_ucx);
-    mca_spml_ucx_ctx_t *ucx_ctx = (mca_spml_ucx_ctx_t *)ctx;
+    void *ptr;
+    mca_spml_ucx_ctx_t *ucx_ctx = mca_spml_ucx_ctx_resolve(ctx, &mca_spml_ucx);
+    spml_ucx_mkey_t *ucx_mkey = mca_spml_ucx_get_mkey((shmem_ctx_t)ucx_ctx, dst, dst_addr, &rva,
+                                                      &mca_spml_ucx);
     ucs_status_t status;
 #if HAVE_DECL_UCP_PUT_NBX
     ucs_status_ptr_t status_ptr;
 #endif
 
+    ptr = mca_spml_ucx_mkey_ptr(ucx_mkey, rva);
+    if (NULL != ptr) {
+        memcpy(ptr, src_addr, size);
+        return OSHMEM_SUCCESS;
+    }
+
 #if HAVE_DECL_UCP_PUT_NBX
     status_ptr = ucp_put_nbx(ucx_ctx->ucp_peers[dst].ucp_conn,
                              src_addr, size, (uint64_t)rva,
@@ -971,13 +1176,21 @@ int mca_spml_ucx_put_nb_wprogress(shmem_ctx_t ctx, void* dst_addr, size_t size,
 {
     unsigned int i;
     void *rva;
+    void *ptr;
     ucs_status_t status;
-    spml_ucx_mkey_t *ucx_mkey = mca_spml_ucx_get_mkey(ctx, dst, dst_addr, &rva, &mca_spml_ucx);
-    mca_spml_ucx_ctx_t *ucx_ctx = (mca_spml_ucx_ctx_t *)ctx;
+    mca_spml_ucx_ctx_t *ucx_ctx = mca_spml_ucx_ctx_resolve(ctx, &mca_spml_ucx);
+    spml_ucx_mkey_t *ucx_mkey = mca_spml_ucx_get_mkey((shmem_ctx_t)ucx_ctx, dst, dst_addr, &rva,
+                                                      &mca_spml_ucx);
 #if HAVE_DECL_UCP_PUT_NBX
     ucs_status_ptr_t status_ptr;
 #endif
 
+    ptr = mca_spml_ucx_mkey_ptr(ucx_mkey, rva);
+    if (NULL != ptr) {
+        memcpy(ptr, src_addr, size);
+        return OSHMEM_SUCCESS;
+    }
+
 #if HAVE_DECL_UCP_PUT_NBX
     status_ptr = ucp_put_nbx(ucx_ctx->ucp_peers[dst].ucp_conn, src_addr, size,
                              (uint64_t)rva, ucx_mkey->rkey,
@@ -1008,14 +1221,128 @@ int mca_spml_ucx_put_nb_wprogress(shmem_ctx_t ctx, void* dst_addr, size_t size,
     return ucx_status_to_oshmem_nb(status);
 }
 
+static int mca_spml_ucx_put_signal_common(shmem_ctx_t ctx, void *dst_addr, size_t size,
+                                          void *src_addr, uint64_t *sig_addr,
+                                          uint64_t signal, int sig_op, int dst, bool nb)
+{
+    mca_spml_ucx_ctx_t *ucx_ctx = mca_spml_ucx_ctx_resolve(ctx, &mca_spml_ucx);
+    spml_ucx_mkey_t *ucx_mkey;
+    void *rva;
+    void *data_ptr;
+    void *sig_ptr;
+    int res;
+#if HAVE_DECL_UCP_ATOMIC_OP_NBX
+    ucp_request_param_t param = {
+        .op_attr_mask = UCP_OP_ATTR_FIELD_DATATYPE |
+                        UCP_OP_ATTR_FIELD_REPLY_BUFFER,
+        .datatype     = ucp_dt_make_contig(sizeof(uint64_t)),
+        .reply_buffer = &ucx_ctx->signal_reply
+    };
+#endif
+    ucs_status_ptr_t status_ptr;
+
+    if (OPAL_UNLIKELY((SHMEM_SIGNAL_SET != sig_op) && (SHMEM_SIGNAL_ADD != sig_op))) {
+        SPML_UCX_ERROR("invalid signal operation %d", sig_op);
+        return OSHMEM_ERR_BAD_PARAM;
+    }
+
+    ucx_mkey = mca_spml_ucx_get_mkey((shmem_ctx_t)ucx_ctx, dst, dst_addr, &rva,
+                                     &mca_spml_ucx);
+    data_ptr = mca_spml_ucx_mkey_ptr(ucx_mkey, rva);
+
+    if (nb) {
+        res = mca_spml_ucx_put_nb((shmem_ctx_t)ucx_ctx, dst_addr, size, src_addr, dst, NULL);
+    } else {
+        res = mca_spml_ucx_put((shmem_ctx_t)ucx_ctx, dst_addr, size, src_addr, dst);
+    }
+    if (OPAL_UNLIKELY(OSHMEM_SUCCESS != res)) {
+        return res;
+    }
+
+    ucx_mkey = mca_spml_ucx_get_mkey((shmem_ctx_t)ucx_ctx, dst, sig_addr, &rva,
+                                     &mca_spml_ucx);
+
+    /* The data went through memory, so can the signal as long as it does
+     * not race with NIC atomics on the same location */
+    sig_ptr = mca_spml_ucx.direct_atomics ? mca_spml_ucx_mkey_ptr(ucx_mkey, rva) : NULL;
+    if ((NULL != data_ptr) && (NULL != sig_ptr)) {
+        opal_atomic_wmb();
+        if (SHMEM_SIGNAL_SET == sig_op) {
+            (void)opal_atomic_swap_64((opal_atomic_int64_t *)sig_ptr, (int64_t)signal);
+        } else {
+            (void)opal_atomic_fetch_add_64((opal_atomic_int64_t *)sig_ptr, (int64_t)signal);
+        }
+        return OSHMEM_SUCCESS;
+    }
+
+    /* Order the signal after the data. On the transports which keep the
+     * order of the operations this does not cost a round trip. */
+    res = mca_spml_ucx_fence((shmem_ctx_t)ucx_ctx);
+    if (OPAL_UNLIKELY(OSHMEM_SUCCESS != res)) {
+        return res;
+    }
+
+    /* SET is a swap whose result lands in a per context scratch word, so
+     * the signal does not have to wait for the reply */
+#if HAVE_DECL_UCP_ATOMIC_OP_NBX
+    status_ptr = ucp_atomic_op_nbx(ucx_ctx->ucp_peers[dst].ucp_conn,
+                                   (SHMEM_SIGNAL_SET == sig_op) ?
+                                       UCP_ATOMIC_OP_SWAP : UCP_ATOMIC_OP_ADD,
+                                   &signal, 1, (uint64_t)rva, ucx_mkey->rkey,
+                                   &param);
+#else
+    if (SHMEM_SIGNAL_ADD == sig_op) {
+        status_ptr = UCS_STATUS_PTR(ucp_atomic_post(ucx_ctx->ucp_peers[dst].ucp_conn,
+                                                    UCP_ATOMIC_POST_OP_ADD, signal,
+                                                    sizeof(uint64_t), (uint64_t)rva,
+                                                    ucx_mkey->rkey));
+    } else {
+        status_ptr = ucp_atomic_fetch_nb(ucx_ctx->ucp_peers[dst].ucp_conn,
+                                         UCP_ATOMIC_FETCH_OP_SWAP, signal,
+                                         &ucx_ctx->signal_reply, sizeof(uint64_t),
+                                         (uint64_t)rva, ucx_mkey->rkey,
+                                         opal_common_ucx_empty_complete_cb);
+    }
+#endif
+    if (UCS_PTR_IS_ERR(status_ptr)) {
+        return ucx_status_to_oshmem(UCS_PTR_STATUS(status_ptr));
+    }
+    if (UCS_PTR_IS_PTR(status_ptr)) {
+        ucp_request_free(status_ptr);
+    }
+    mca_spml_ucx_remote_op_posted(ucx_ctx, dst);
+
+    return OSHMEM_SUCCESS;
+}
+
+int mca_spml_ucx_put_signal(shmem_ctx_t ctx, void *dst_addr, size_t size, void *src_addr,
+                            uint64_t *sig_addr, uint64_t signal, int sig_op, int dst)
+{
+    return mca_spml_ucx_put_signal_common(ctx, dst_addr, size, src_addr, sig_addr,
+                                          signal, sig_op, dst, false);
+}
+
+int mca_spml_ucx_put_signal_nb(shmem_ctx_t ctx, void *dst_addr, size_t size, void *src_addr,
+                               uint64_t *sig_addr, uint64_t signal, int sig_op, int dst)
+{
+    return mca_spml_ucx_put_signal_common(ctx, dst_addr, size, src_addr, sig_addr,
+                                          signal, sig_op, dst, true);
+}
+
 int mca_spml_ucx_fence(shmem_ctx_t ctx)
 {
     ucs_status_t err;
     unsigned int i = 0;
-    mca_spml_ucx_ctx_t *ucx_ctx = (mca_spml_ucx_ctx_t *)ctx;
+    mca_spml_ucx_ctx_t *ucx_ctx = mca_spml_ucx_ctx_resolve(ctx, &mca_spml_ucx);
 
     opal_atomic_wmb();
 
+    /* nothing is in flight since the last quiet. Otherwise UCX only
+     * flushes the transports that do not order the operations. */
+    if (ucx_ctx->track_put_ops && (0 == ucx_ctx->put_proc_count)) {
+        return OSHMEM_SUCCESS;
+    }
+
     for (i=0; i < ucx_ctx->ucp_workers; i++) {
         if (ucx_ctx->ucp_worker[i] != NULL) {
             err = ucp_worker_fence(ucx_ctx->ucp_worker[i]);
@@ -1029,45 +1356,103 @@ int mca_spml_ucx_fence(shmem_ctx_t ctx)
     return OSHMEM_SUCCESS;
 }
 
-int mca_spml_ucx_quiet(shmem_ctx_t ctx)
+/* Flush the endpoints of the PEs with operations in flight, all the
+ * flushes are posted before waiting for any of them */
+static int mca_spml_ucx_flush_eps(mca_spml_ucx_ctx_t *ucx_ctx)
+{
+    unsigned i;
+    int ret = OSHMEM_SUCCESS;
+#if HAVE_DECL_UCP_EP_FLUSH_NBX
+    ucp_request_param_t param = {0};
+    ucs_status_ptr_t request;
+    unsigned nreqs = 0;
+
+    for (i = 0; i < ucx_ctx->put_proc_count; i++) {
+        request = ucp_ep_flush_nbx(ucx_ctx->ucp_peers[ucx_ctx->put_proc_indexes[i]].ucp_conn,
+                                   &param);
+        if (OPAL_UNLIKELY(UCS_PTR_IS_ERR(request))) {
+            SPML_UCX_ERROR("ucp_ep_flush_nbx failed: %s",
+                           ucs_status_string(UCS_PTR_STATUS(request)));
+            ret = OSHMEM_ERROR;
+            break;
+        }
+        if (UCS_PTR_IS_PTR(request)) {
+            ucx_ctx->flush_reqs[nreqs++] = request;
+        }
+    }
+
+    for (i = 0; i < nreqs; i++) {
+        if (OPAL_SUCCESS != opal_common_ucx_wait_request(ucx_ctx->flush_reqs[i],
+                                                         ucx_ctx->ucp_worker[0],
+                                                         "ucp_ep_flush_nbx")) {
+            ret = OSHMEM_ERROR;
+        }
+    }
+#else
+    for (i = 0; i < ucx_ctx->put_proc_count; i++) {
+        ret = opal_common_ucx_ep_flush(ucx_ctx->ucp_peers[ucx_ctx->put_proc_indexes[i]].ucp_conn,
+                                       ucx_ctx->ucp_worker[0]);
+        if (OPAL_SUCCESS != ret) {
+            ret = OSHMEM_ERROR;
+            break;
+        }
+    }
+#endif
+
+    return ret;
+}
+
+static int mca_spml_ucx_ctx_quiet(mca_spml_ucx_ctx_t *ucx_ctx)
 {
     int flush_get_data;
     int ret;
     unsigned i;
     int idx;
-    mca_spml_ucx_ctx_t *ucx_ctx = (mca_spml_ucx_ctx_t *)ctx;
 
     if (mca_spml_ucx.synchronized_quiet) {
         for (i = 0; i < ucx_ctx->put_proc_count; i++) {
             idx = ucx_ctx->put_proc_indexes[i];
-            ret = mca_spml_ucx_get_nb(ctx,
-                                      ucx_ctx->ucp_peers[idx].mkeys->super.super.va_base,
-                                      sizeof(flush_get_data), &flush_get_data, idx, NULL);
+            ret = mca_spml_ucx_ctx_get_nb(ucx_ctx,
+                                          ucx_ctx->ucp_peers[idx].mkeys->super.super.va_base,
+                                          sizeof(flush_get_data), &flush_get_data, idx);
             if (OMPI_SUCCESS != ret) {
                 oshmem_shmem_abort(-1);
                 return ret;
             }
-
-            opal_bitmap_clear_bit(&ucx_ctx->put_op_bitmap, idx);
         }
-        ucx_ctx->put_proc_count = 0;
     }
 
     opal_atomic_wmb();
 
-    for (i = 0; i < ucx_ctx->ucp_workers; i++) {
-        if (ucx_ctx->ucp_worker[i] != NULL) {
-            ret = opal_common_ucx_worker_flush(ucx_ctx->ucp_worker[i]);
-            if (OMPI_SUCCESS != ret) {
-                 oshmem_shmem_abort(-1);
-                 return ret;
+    if (ucx_ctx->track_put_ops &&
+        (ucx_ctx->put_proc_count <= mca_spml_ucx.quiet_ep_flush_max)) {
+        ret = mca_spml_ucx_flush_eps(ucx_ctx);
+        if (OSHMEM_SUCCESS != ret) {
+            oshmem_shmem_abort(-1);
+            return ret;
+        }
+    } else {
+        for (i = 0; i < ucx_ctx->ucp_workers; i++) {
+            if (ucx_ctx->ucp_worker[i] != NULL) {
+                ret = opal_common_ucx_worker_flush(ucx_ctx->ucp_worker[i]);
+                if (OMPI_SUCCESS != ret) {
+                     oshmem_shmem_abort(-1);
+                     return ret;
+                }
             }
         }
     }
 
+    if (ucx_ctx->track_put_ops) {
+        for (i = 0; i < ucx_ctx->put_proc_count; i++) {
+            opal_bitmap_clear_bit(&ucx_ctx->put_op_bitmap, ucx_ctx->put_proc_indexes[i]);
+        }
+        ucx_ctx->put_proc_count = 0;
+    }
+
     /* If put_all_nb op/s is/are being executed asynchronously, need to wait its
      * completion as well. */
-    if (ctx == oshmem_ctx_default) {
+    if ((shmem_ctx_t)ucx_ctx == oshmem_ctx_default) {
         while (mca_spml_ucx.aux_refcnt) {
             opal_progress();
         }
@@ -1078,6 +1463,27 @@ int mca_spml_ucx_quiet(shmem_ctx_t ctx)
     return OSHMEM_SUCCESS;
 }
 
+int mca_spml_ucx_quiet(shmem_ctx_t ctx)
+{
+    int i, ret;
+
+    /* The implicit contexts of all the threads stand for the default
+     * context, e.g. shmem_barrier_all has to complete all of them */
+    if ((ctx == oshmem_ctx_default) && mca_spml_ucx.thread_ctxs) {
+        SHMEM_MUTEX_LOCK(mca_spml_ucx.internal_mutex);
+        for (i = 0; i < mca_spml_ucx.thread_array.ctxs_count; i++) {
+            ret = mca_spml_ucx_ctx_quiet(mca_spml_ucx.thread_array.ctxs[i]);
+            if (OSHMEM_SUCCESS != ret) {
+                SHMEM_MUTEX_UNLOCK(mca_spml_ucx.internal_mutex);
+                return ret;
+            }
+        }
+        SHMEM_MUTEX_UNLOCK(mca_spml_ucx.internal_mutex);
+    }
+
+    return mca_spml_ucx_ctx_quiet((mca_spml_ucx_ctx_t *)ctx);
+}
+
 /* blocking receive */
 int mca_spml_ucx_recv(void* buf, size_t size, int src)
 {
@@ -1180,7 +1586,7 @@ int mca_spml_ucx_put_all_nb(void *dest, const void *source, size_t size, long *c
         }
         ctx = (shmem_ctx_t)mca_spml_ucx.aux_ctx;
     } else {
-        ctx = oshmem_ctx_default;
+        ctx = (shmem_ctx_t)mca_spml_ucx_ctx_resolve(oshmem_ctx_default, &mca_spml_ucx);
     }
 
     assert(ctx != NULL); /* make coverity happy */
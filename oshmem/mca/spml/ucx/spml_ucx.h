@@ -34,9 +34,12 @@
 #include "opal/class/opal_free_list.h"
 #include "opal/class/opal_list.h"
 #include "opal/class/opal_bitmap.h"
+#include "opal/mca/threads/tsd.h"
 
 #include "opal/mca/common/ucx/common_ucx.h"
 
+#include <stddef.h>
+
 #include <ucp/api/ucp.h>
 
 BEGIN_C_DECLS
@@ -51,6 +54,10 @@ BEGIN_C_DECLS
 struct spml_ucx_mkey {
     ucp_rkey_h rkey;
     ucp_mem_h  mem_h;
+    /* the segment of the peer is mapped into the address space of this
+     * process at remote address + mapped_offset */
+    bool       mapped;
+    ptrdiff_t  mapped_offset;
 }; 
 typedef struct spml_ucx_mkey spml_ucx_mkey_t;
 
@@ -76,12 +83,16 @@ struct mca_spml_ucx_ctx {
     int                     *put_proc_indexes;
     unsigned                 put_proc_count;
     bool                     synchronized_quiet;
+    bool                     track_put_ops;   /* put_proc_indexes lists the PEs to flush */
+    ucs_status_ptr_t        *flush_reqs;
+    uint64_t                 signal_reply;    /* discarded result of SHMEM_SIGNAL_SET */
 };
 typedef struct mca_spml_ucx_ctx mca_spml_ucx_ctx_t;
 
 extern mca_spml_ucx_ctx_t mca_spml_ucx_ctx_default;
 
 typedef spml_ucx_mkey_t * (*mca_spml_ucx_get_mkey_slow_fn_t)(shmem_ctx_t ctx, int pe, void *va, void **rva);
+typedef mca_spml_ucx_ctx_t * (*mca_spml_ucx_get_thread_ctx_fn_t)(void);
 
 typedef struct mca_spml_ucx_ctx_array {
     int                      ctxs_count;
@@ -117,6 +128,21 @@ struct mca_spml_ucx {
     unsigned long            nb_ucp_worker_progress;
     unsigned int             ucp_workers;
     unsigned int             ucp_worker_cnt;
+    /* Load/store access to the peers whose segments are mapped */
+    bool                     direct_rma;
+    int                      direct_atomics;
+    /* Implicit per thread contexts the default context is redirected to
+     * under SHMEM_THREAD_MULTIPLE, except for the thread that created it */
+    bool                     thread_ctxs;
+    pthread_t                main_thread;
+    opal_tsd_tracked_key_t   thread_ctx_key;
+    mca_spml_ucx_ctx_array_t thread_array;
+    mca_spml_ucx_get_thread_ctx_fn_t get_thread_ctx;
+    /* quiet flushes the endpoints of up to this number of PEs instead of
+     * the worker */
+    unsigned int             quiet_ep_flush_max;
+    /* The UCP context and the heap registration are shared with osc/ucx */
+    bool                     share_ctx;
 };
 typedef struct mca_spml_ucx mca_spml_ucx_t;
 
@@ -126,6 +152,8 @@ extern int mca_spml_ucx_enable(bool enable);
 extern int mca_spml_ucx_ctx_create(long options,
                                    shmem_ctx_t *ctx);
 extern void mca_spml_ucx_ctx_destroy(shmem_ctx_t ctx);
+extern mca_spml_ucx_ctx_t *mca_spml_ucx_thread_ctx(void);
+extern void mca_spml_ucx_thread_ctx_release(void *ctx);
 extern int mca_spml_ucx_get(shmem_ctx_t ctx,
                               void* dst_addr,
                               size_t size,
@@ -177,6 +205,23 @@ extern int mca_spml_ucx_put_all_nb(void *target,
                                    size_t size,
                                    long *counter);
 
+extern int mca_spml_ucx_put_signal(shmem_ctx_t ctx,
+                                   void *dst_addr,
+                                   size_t size,
+                                   void *src_addr,
+                                   uint64_t *sig_addr,
+                                   uint64_t signal,
+                                   int sig_op,
+                                   int dst);
+extern int mca_spml_ucx_put_signal_nb(shmem_ctx_t ctx,
+                                      void *dst_addr,
+                                      size_t size,
+                                      void *src_addr,
+                                      uint64_t *sig_addr,
+                                      uint64_t signal,
+                                      int sig_op,
+                                      int dst);
+
 extern sshmem_mkey_t *mca_spml_ucx_register(void* addr,
                                                 size_t size,
                                                 uint64_t shmid,
@@ -215,6 +260,28 @@ static inline void mca_spml_ucx_aux_unlock(void)
     }
 }
 
+/* Check whether the transport maps the segment of the peer, e.g. shared
+ * memory transports of the node-local peers, so that it can be accessed
+ * with plain loads and stores */
+static inline void mca_spml_ucx_map_mkey(spml_ucx_cached_mkey_t *mkey)
+{
+#if (((UCP_API_MAJOR >= 1) && (UCP_API_MINOR >= 3)) || (UCP_API_MAJOR >= 2))
+    void *ptr;
+
+    mkey->key.mapped = false;
+    if (!mca_spml_ucx.direct_rma || (NULL == mkey->key.rkey)) {
+        return;
+    }
+
+    if (UCS_OK == ucp_rkey_ptr(mkey->key.rkey, (uint64_t)mkey->super.rva_base, &ptr)) {
+        mkey->key.mapped        = true;
+        mkey->key.mapped_offset = (char *)ptr - (char *)mkey->super.rva_base;
+    }
+#else
+    mkey->key.mapped = false;
+#endif
+}
+
 static inline void mca_spml_ucx_cache_mkey(mca_spml_ucx_ctx_t *ucx_ctx,
                                            sshmem_mkey_t *mkey, uint32_t segno, int dst_pe)
 {
@@ -222,6 +289,7 @@ static inline void mca_spml_ucx_cache_mkey(mca_spml_ucx_ctx_t *ucx_ctx,
 
     peer = &(ucx_ctx->ucp_peers[dst_pe]);
     mkey_segment_init(&peer->mkeys[segno].super, mkey, segno);
+    mca_spml_ucx_map_mkey(&peer->mkeys[segno]);
 }
 
 static inline spml_ucx_mkey_t * 
@@ -232,11 +300,35 @@ mca_spml_ucx_get_mkey(shmem_ctx_t ctx, int pe, void *va, void **rva, mca_spml_uc
 
     mkey = ucx_ctx->ucp_peers[pe].mkeys;
     mkey = (spml_ucx_cached_mkey_t *)map_segment_find_va(&mkey->super.super, sizeof(*mkey), va);
-    assert(mkey != NULL);
+    if (OPAL_UNLIKELY(NULL == mkey)) {
+        /* the keys were not exchanged at startup */
+        return module->get_mkey_slow(ctx, pe, va, rva);
+    }
     *rva = map_segment_va2rva(&mkey->super, va);
     return &mkey->key;
 }
 
+/* Local address of the remote address rva, NULL if the segment has to be
+ * accessed through UCX */
+static inline void *mca_spml_ucx_mkey_ptr(spml_ucx_mkey_t *ucx_mkey, void *rva)
+{
+    if (!ucx_mkey->mapped) {
+        return NULL;
+    }
+    return (char *)rva + ucx_mkey->mapped_offset;
+}
+
+/* The context the operations on ctx go to */
+static inline mca_spml_ucx_ctx_t *
+mca_spml_ucx_ctx_resolve(shmem_ctx_t ctx, mca_spml_ucx_t *module)
+{
+    if (OPAL_LIKELY(!module->thread_ctxs || (ctx != oshmem_ctx_default) ||
+                    pthread_equal(pthread_self(), module->main_thread))) {
+        return (mca_spml_ucx_ctx_t *)ctx;
+    }
+    return module->get_thread_ctx();
+}
+
 static inline int ucx_status_to_oshmem(ucs_status_t status)
 {
 #if OSHMEM_PARAM_CHECK == 1
@@ -257,7 +349,7 @@ static inline int ucx_status_to_oshmem_nb(ucs_status_t status)
 
 static inline void mca_spml_ucx_remote_op_posted(mca_spml_ucx_ctx_t *ctx, int dst)
 {
-    if (OPAL_UNLIKELY(ctx->synchronized_quiet)) {
+    if (ctx->track_put_ops) {
         if (!opal_bitmap_is_set_bit(&ctx->put_op_bitmap, dst)) {
             ctx->put_proc_indexes[ctx->put_proc_count++] = dst;
             opal_bitmap_set_bit(&ctx->put_op_bitmap, dst);
@@ -22,6 +22,7 @@
 #include "oshmem/mca/spml/base/base.h"
 #include "spml_ucx_component.h"
 #include "oshmem/mca/spml/ucx/spml_ucx.h"
+#include "opal/mca/common/ucx/common_ucx_wpool.h"
 
 #include "opal/util/opal_environ.h"
 #include "opal/runtime/opal_progress_threads.h"
@@ -180,6 +181,26 @@ static int mca_spml_ucx_component_register(void)
                                     "Number of ucp workers per default context",
                                     &mca_spml_ucx.ucp_workers);
 
+    mca_spml_ucx_param_register_bool("direct_rma", 1,
+                                     "Use plain loads and stores for put and get to the peers whose symmetric segments the UCX transport maps into the process, e.g. the node-local peers",
+                                     &mca_spml_ucx.direct_rma);
+
+    mca_spml_ucx_param_register_int("direct_atomics", -1,
+                                    "Use CPU atomics on the mapped symmetric segments (-1 - when all the PEs are on the same node, 0 - never, 1 - always). CPU atomics are not atomic with respect to the network atomics the remote PEs use, so only force them when UCX_ATOMIC_MODE=cpu",
+                                    &mca_spml_ucx.direct_atomics);
+
+    mca_spml_ucx_param_register_bool("thread_ctxs", 1,
+                                     "With SHMEM_THREAD_MULTIPLE, give each thread but the main one an implicit private context for the operations on the default context",
+                                     &mca_spml_ucx.thread_ctxs);
+
+    mca_spml_ucx_param_register_uint("quiet_ep_flush_max", 64,
+                                     "Maximum number of PEs with operations in flight for which quiet flushes their endpoints instead of the whole worker (0 - always flush the worker)",
+                                     &mca_spml_ucx.quiet_ep_flush_max);
+
+    mca_spml_ucx_param_register_bool("share_ctx", 1,
+                                     "Let the MPI one-sided windows run on the UCP context of OSHMEM, the windows over the symmetric heap then use its memory registration and remote keys instead of registering the memory again. The UCX configuration is then taken from the OSHMEM_ prefixed UCX variables",
+                                     &mca_spml_ucx.share_ctx);
+
     opal_common_ucx_mca_var_register(&mca_spml_ucx_component.spmlm_version);
 
     return OSHMEM_SUCCESS;
@@ -283,12 +304,26 @@ static int spml_ucx_init(void)
     params.field_mask       |= UCP_PARAM_FIELD_ESTIMATED_NUM_PPN;
 #endif
 
+    /* The MPI windows create their workers on the context, so it has to
+     * carry the requests of the worker pool */
+    if (mca_spml_ucx.share_ctx) {
+        params.field_mask   |= UCP_PARAM_FIELD_REQUEST_INIT |
+                               UCP_PARAM_FIELD_REQUEST_SIZE;
+        params.request_init  = opal_common_ucx_req_init;
+        params.request_size  = sizeof(opal_common_ucx_request_t);
+    }
+
     err = ucp_init(&params, ucp_config, &mca_spml_ucx.ucp_context);
     ucp_config_release(ucp_config);
     if (UCS_OK != err) {
         return OSHMEM_ERROR;
     }
 
+    if (mca_spml_ucx.share_ctx) {
+        opal_common_ucx_shared_ctx_publish(mca_spml_ucx.ucp_context,
+                                           params.mt_workers_shared);
+    }
+
     attr.field_mask = UCP_ATTR_FIELD_THREAD_MODE;
     err = ucp_context_query(mca_spml_ucx.ucp_context, &attr);
     if (err != UCS_OK) {
@@ -306,6 +341,10 @@ static int spml_ucx_init(void)
                                             sizeof(mca_spml_ucx_ctx_t *));
     mca_spml_ucx.idle_array.ctxs = calloc(mca_spml_ucx.idle_array.ctxs_num,
                                           sizeof(mca_spml_ucx_ctx_t *));
+    mca_spml_ucx.thread_array.ctxs_count = 0;
+    mca_spml_ucx.thread_array.ctxs_num   = MCA_SPML_UCX_CTXS_ARRAY_SIZE;
+    mca_spml_ucx.thread_array.ctxs       = calloc(mca_spml_ucx.thread_array.ctxs_num,
+                                                  sizeof(mca_spml_ucx_ctx_t *));
 
     SHMEM_MUTEX_INIT(mca_spml_ucx.internal_mutex);
     pthread_mutex_init(&mca_spml_ucx.ctx_create_mutex, NULL);
@@ -335,6 +374,16 @@ static int spml_ucx_init(void)
         oshmem_mpi_thread_provided = SHMEM_THREAD_SINGLE;
     }
 
+    if (oshmem_mpi_thread_provided != SHMEM_THREAD_MULTIPLE) {
+        mca_spml_ucx.thread_ctxs = false;
+    }
+    if (mca_spml_ucx.thread_ctxs) {
+        mca_spml_ucx.main_thread = pthread_self();
+        OBJ_CONSTRUCT(&mca_spml_ucx.thread_ctx_key, opal_tsd_tracked_key_t);
+        opal_tsd_tracked_key_set_destructor(&mca_spml_ucx.thread_ctx_key,
+                                            mca_spml_ucx_thread_ctx_release);
+    }
+
     if (mca_spml_ucx.async_progress) {
         pthread_spin_init(&mca_spml_ucx.async_lock, 0);
         mca_spml_ucx.async_event_base = opal_progress_thread_init(NULL);
@@ -437,6 +486,13 @@ static int mca_spml_ucx_component_fini(void)
         pthread_spin_destroy(&mca_spml_ucx.async_lock);
     }
 
+    /* the thread contexts are in the active list */
+    if (mca_spml_ucx.thread_ctxs) {
+        opal_tsd_tracked_key_set_destructor(&mca_spml_ucx.thread_ctx_key, NULL);
+        OBJ_DESTRUCT(&mca_spml_ucx.thread_ctx_key);
+        mca_spml_ucx.thread_ctxs = false;
+    }
+
     /* delete context objects from list */
     for (i = 0; i < mca_spml_ucx.active_array.ctxs_count; i++) {
         _ctx_cleanup(mca_spml_ucx.active_array.ctxs[i]);
@@ -499,13 +555,15 @@ static int mca_spml_ucx_component_fini(void)
 
     free(mca_spml_ucx.active_array.ctxs);
     free(mca_spml_ucx.idle_array.ctxs);
+    free(mca_spml_ucx.thread_array.ctxs);
     free(mca_spml_ucx.aux_ctx);
 
     SHMEM_MUTEX_DESTROY(mca_spml_ucx.internal_mutex);
     pthread_mutex_destroy(&mca_spml_ucx.ctx_create_mutex);
 
     if (mca_spml_ucx.ucp_context) {
-        ucp_cleanup(mca_spml_ucx.ucp_context);
+        /* the context lives on until the MPI windows are done with it */
+        opal_common_ucx_shared_ctx_release(mca_spml_ucx.ucp_context);
         mca_spml_ucx.ucp_context = NULL;
     }
 
@@ -27,6 +27,10 @@ typedef struct mca_sshmem_mmap_component_t {
     int priority;
     int is_anonymous;
     int is_start_addr_fixed;
+    /* huge pages usage of the anonymous mapping [0 - off, 1 - on, -1 - auto] */
+    int use_hp;
+    /* huge page size, 0 for the default one of the system */
+    size_t hp_size;
 } mca_sshmem_mmap_component_t;
 
 OSHMEM_MODULE_DECLSPEC extern mca_sshmem_mmap_component_t
@@ -120,6 +120,25 @@ mmap_register(void)
                                     OPAL_INFO_LVL_4,
                                     MCA_BASE_VAR_SCOPE_ALL_EQ,
                                     &mca_sshmem_mmap_component.is_start_addr_fixed);
+
+   mca_sshmem_mmap_component.use_hp = 0;
+   mca_base_component_var_register (&mca_sshmem_mmap_component.super.base_version,
+                                    "use_hp", "Huge pages usage for anonymous sshmem "
+                                    "[0 - off, 1 - on, -1 - auto] (default: 0)", MCA_BASE_VAR_TYPE_INT,
+                                    NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                    OPAL_INFO_LVL_4,
+                                    MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                    &mca_sshmem_mmap_component.use_hp);
+
+   mca_sshmem_mmap_component.hp_size = 0;
+   mca_base_component_var_register (&mca_sshmem_mmap_component.super.base_version,
+                                    "hp_size", "Huge page size in bytes, e.g. 2097152 or 1073741824 "
+                                    "(default: 0 - the default huge page size of the system)",
+                                    MCA_BASE_VAR_TYPE_SIZE_T,
+                                    NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                    OPAL_INFO_LVL_4,
+                                    MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                    &mca_sshmem_mmap_component.hp_size);
     return OSHMEM_SUCCESS;
 }
 
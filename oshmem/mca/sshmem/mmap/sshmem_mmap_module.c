@@ -13,6 +13,7 @@
 #include "oshmem_config.h"
 
 #include <errno.h>
+#include <stdio.h>
 #ifdef HAVE_FCNTL_H
 #include <fcntl.h>
 #endif  /* HAVE_FCNTL_H */
@@ -109,6 +110,84 @@ module_finalize(void)
 }
 
 
+/*
+ * Get the default huge page size of the system
+ */
+static size_t sshmem_mmap_gethugepagesize(void)
+{
+    static size_t huge_page_size = 0;
+    char buf[256];
+    int size_kb;
+    FILE *f;
+
+    /* Cache the huge page size value */
+    if (huge_page_size == 0) {
+        f = fopen("/proc/meminfo", "r");
+        if (f != NULL) {
+            while (fgets(buf, sizeof(buf), f)) {
+                if (sscanf(buf, "Hugepagesize: %d kB", &size_kb) == 1) {
+                    huge_page_size = size_kb * 1024L;
+                    break;
+                }
+            }
+            fclose(f);
+        }
+
+        if (huge_page_size == 0) {
+            huge_page_size = 2 * 1024L *1024L;
+        }
+    }
+
+    return huge_page_size;
+}
+
+/*
+ * The flags asking for huge pages, 0 if they can not be used. The size and
+ * start address of the segment are rounded to the huge page size, which
+ * also keeps the registration of the heap on large page boundaries.
+ */
+static int
+segment_hp_flags(size_t *size, uintptr_t *start)
+{
+    int flags = 0;
+#if defined(MAP_HUGETLB)
+    size_t hp_size = mca_sshmem_mmap_component.hp_size;
+    int shift;
+
+    if ((0 == mca_sshmem_mmap_component.use_hp) ||
+        !mca_sshmem_mmap_component.is_anonymous) {
+        return 0;
+    }
+
+    if (0 == hp_size) {
+        hp_size = sshmem_mmap_gethugepagesize();
+    } else if (hp_size & (hp_size - 1)) {
+        OPAL_OUTPUT_VERBOSE(
+              (10, oshmem_sshmem_base_framework.framework_output,
+               "huge page size %llu is not a power of two, using regular pages",
+               (unsigned long long)hp_size));
+        return 0;
+    }
+
+    flags = MAP_HUGETLB;
+#if defined(MAP_HUGE_SHIFT)
+    if (0 != mca_sshmem_mmap_component.hp_size) {
+        for (shift = 0; ((size_t)1 << shift) < hp_size; shift++);
+        flags |= shift << MAP_HUGE_SHIFT;
+    }
+#else
+    (void)shift;
+#endif
+
+    *size  = (*size + hp_size - 1) & ~(hp_size - 1);
+    *start = (*start + hp_size - 1) & ~((uintptr_t)hp_size - 1);
+#else
+    (void)size;
+    (void)start;
+#endif
+    return flags;
+}
+
 static int
 segment_create(map_segment_t *ds_buf,
                const char *file_name,
@@ -116,6 +195,9 @@ segment_create(map_segment_t *ds_buf,
 {
     int rc = OSHMEM_SUCCESS;
     void *addr = NULL;
+    uintptr_t start = (uintptr_t)mca_sshmem_base_start_address;
+    size_t hp_size = size;
+    int hp_flags;
 
     assert(ds_buf);
 
@@ -126,16 +208,48 @@ segment_create(map_segment_t *ds_buf,
     /* init the contents of map_segment_t */
     shmem_ds_reset(ds_buf);
 
-    addr = mmap((void *)mca_sshmem_base_start_address,
-                size,
-                PROT_READ | PROT_WRITE,
-                MAP_PRIVATE |
+    addr = MAP_FAILED;
+    hp_flags = segment_hp_flags(&hp_size, &start);
+    if (0 != hp_flags) {
+        addr = mmap((void *)start,
+                    hp_size,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE |
 #if defined(MAP_ANONYMOUS)
-                MAP_ANONYMOUS |
+                    MAP_ANONYMOUS |
 #endif
-                MAP_FIXED,
-                -1,
-                0);
+                    MAP_FIXED | hp_flags,
+                    -1,
+                    0);
+        if (MAP_FAILED != addr) {
+            size = hp_size;
+        } else if (-1 == mca_sshmem_mmap_component.use_hp) {
+            /* Hopefully it failed because there are not enough huge pages
+             * on the system */
+            OPAL_OUTPUT_VERBOSE(
+                    (10, oshmem_sshmem_base_framework.framework_output,
+                     "failed to allocate %llu bytes with huge pages. "
+                     "Using regular pages", (unsigned long long)hp_size));
+        }
+    } else if (1 == mca_sshmem_mmap_component.use_hp) {
+        errno = ENOTSUP;
+    }
+
+    if ((MAP_FAILED == addr) &&
+        ((0 == hp_flags) ? (1 != mca_sshmem_mmap_component.use_hp) :
+                           (-1 == mca_sshmem_mmap_component.use_hp))) {
+        /* The same start on the PEs with and without huge pages */
+        addr = mmap((void *)start,
+                    size,
+                    PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE |
+#if defined(MAP_ANONYMOUS)
+                    MAP_ANONYMOUS |
+#endif
+                    MAP_FIXED,
+                    -1,
+                    0);
+    }
 
     if (MAP_FAILED == addr) {
         opal_show_help("help-oshmem-sshmem.txt",
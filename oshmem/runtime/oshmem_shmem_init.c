@@ -60,6 +60,7 @@
 #include "oshmem/shmem/shmem_api_logger.h"
 
 #include "oshmem/shmem/shmem_lock.h"
+#include "oshmem/shmem/shmem_team.h"
 
 #ifdef HAVE_SYS_MMAN_H
 #include <sys/mman.h>
@@ -175,6 +176,12 @@ int oshmem_shmem_init(int argc, char **argv, int requested, int *provided)
         }
         OMPI_TIMING_NEXT("shmem_lock_init");
 
+        if (OSHMEM_SUCCESS != shmem_team_init()) {
+            SHMEM_API_ERROR( "shmem_team_init() failed");
+            return OSHMEM_ERROR;
+        }
+        OMPI_TIMING_NEXT("shmem_team_init");
+
         /* this is a collective op, implies barrier */
         MCA_MEMHEAP_CALL(get_all_mkeys());
         OMPI_TIMING_NEXT("get_all_mkeys()");
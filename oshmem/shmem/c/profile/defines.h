@@ -70,6 +70,14 @@
  */
 #define shmem_ctx_create             pshmem_ctx_create
 #define shmem_ctx_destroy            pshmem_ctx_destroy
+#define shmem_team_my_pe             pshmem_team_my_pe
+#define shmem_team_n_pes             pshmem_team_n_pes
+#define shmem_team_get_config        pshmem_team_get_config
+#define shmem_team_translate_pe      pshmem_team_translate_pe
+#define shmem_team_split_strided     pshmem_team_split_strided
+#define shmem_team_split_2d          pshmem_team_split_2d
+#define shmem_team_destroy           pshmem_team_destroy
+#define shmem_team_sync              pshmem_team_sync
 
 /*
  * Elemental put routines
@@ -951,6 +959,277 @@
 #define shmemx_int32_inc             pshmemx_int32_inc
 #define shmemx_int64_inc             pshmemx_int64_inc
 
+/* Non-blocking fetching atomics */
+#define shmem_ctx_int_atomic_fetch_nbi           pshmem_ctx_int_atomic_fetch_nbi
+#define shmem_ctx_long_atomic_fetch_nbi          pshmem_ctx_long_atomic_fetch_nbi
+#define shmem_ctx_longlong_atomic_fetch_nbi      pshmem_ctx_longlong_atomic_fetch_nbi
+#define shmem_ctx_uint_atomic_fetch_nbi          pshmem_ctx_uint_atomic_fetch_nbi
+#define shmem_ctx_ulong_atomic_fetch_nbi         pshmem_ctx_ulong_atomic_fetch_nbi
+#define shmem_ctx_ulonglong_atomic_fetch_nbi     pshmem_ctx_ulonglong_atomic_fetch_nbi
+#define shmem_ctx_float_atomic_fetch_nbi         pshmem_ctx_float_atomic_fetch_nbi
+#define shmem_ctx_double_atomic_fetch_nbi        pshmem_ctx_double_atomic_fetch_nbi
+#define shmem_int_atomic_fetch_nbi               pshmem_int_atomic_fetch_nbi
+#define shmem_long_atomic_fetch_nbi              pshmem_long_atomic_fetch_nbi
+#define shmem_longlong_atomic_fetch_nbi          pshmem_longlong_atomic_fetch_nbi
+#define shmem_uint_atomic_fetch_nbi              pshmem_uint_atomic_fetch_nbi
+#define shmem_ulong_atomic_fetch_nbi             pshmem_ulong_atomic_fetch_nbi
+#define shmem_ulonglong_atomic_fetch_nbi         pshmem_ulonglong_atomic_fetch_nbi
+#define shmem_float_atomic_fetch_nbi             pshmem_float_atomic_fetch_nbi
+#define shmem_double_atomic_fetch_nbi            pshmem_double_atomic_fetch_nbi
+
+#define shmem_ctx_int_atomic_compare_swap_nbi    pshmem_ctx_int_atomic_compare_swap_nbi
+#define shmem_ctx_long_atomic_compare_swap_nbi   pshmem_ctx_long_atomic_compare_swap_nbi
+#define shmem_ctx_longlong_atomic_compare_swap_nbi pshmem_ctx_longlong_atomic_compare_swap_nbi
+#define shmem_ctx_uint_atomic_compare_swap_nbi   pshmem_ctx_uint_atomic_compare_swap_nbi
+#define shmem_ctx_ulong_atomic_compare_swap_nbi  pshmem_ctx_ulong_atomic_compare_swap_nbi
+#define shmem_ctx_ulonglong_atomic_compare_swap_nbi pshmem_ctx_ulonglong_atomic_compare_swap_nbi
+#define shmem_int_atomic_compare_swap_nbi        pshmem_int_atomic_compare_swap_nbi
+#define shmem_long_atomic_compare_swap_nbi       pshmem_long_atomic_compare_swap_nbi
+#define shmem_longlong_atomic_compare_swap_nbi   pshmem_longlong_atomic_compare_swap_nbi
+#define shmem_uint_atomic_compare_swap_nbi       pshmem_uint_atomic_compare_swap_nbi
+#define shmem_ulong_atomic_compare_swap_nbi      pshmem_ulong_atomic_compare_swap_nbi
+#define shmem_ulonglong_atomic_compare_swap_nbi  pshmem_ulonglong_atomic_compare_swap_nbi
+
+#define shmem_ctx_int_atomic_swap_nbi            pshmem_ctx_int_atomic_swap_nbi
+#define shmem_ctx_long_atomic_swap_nbi           pshmem_ctx_long_atomic_swap_nbi
+#define shmem_ctx_longlong_atomic_swap_nbi       pshmem_ctx_longlong_atomic_swap_nbi
+#define shmem_ctx_uint_atomic_swap_nbi           pshmem_ctx_uint_atomic_swap_nbi
+#define shmem_ctx_ulong_atomic_swap_nbi          pshmem_ctx_ulong_atomic_swap_nbi
+#define shmem_ctx_ulonglong_atomic_swap_nbi      pshmem_ctx_ulonglong_atomic_swap_nbi
+#define shmem_ctx_float_atomic_swap_nbi          pshmem_ctx_float_atomic_swap_nbi
+#define shmem_ctx_double_atomic_swap_nbi         pshmem_ctx_double_atomic_swap_nbi
+#define shmem_int_atomic_swap_nbi                pshmem_int_atomic_swap_nbi
+#define shmem_long_atomic_swap_nbi               pshmem_long_atomic_swap_nbi
+#define shmem_longlong_atomic_swap_nbi           pshmem_longlong_atomic_swap_nbi
+#define shmem_uint_atomic_swap_nbi               pshmem_uint_atomic_swap_nbi
+#define shmem_ulong_atomic_swap_nbi              pshmem_ulong_atomic_swap_nbi
+#define shmem_ulonglong_atomic_swap_nbi          pshmem_ulonglong_atomic_swap_nbi
+#define shmem_float_atomic_swap_nbi              pshmem_float_atomic_swap_nbi
+#define shmem_double_atomic_swap_nbi             pshmem_double_atomic_swap_nbi
+
+#define shmem_ctx_int_atomic_fetch_inc_nbi       pshmem_ctx_int_atomic_fetch_inc_nbi
+#define shmem_ctx_long_atomic_fetch_inc_nbi      pshmem_ctx_long_atomic_fetch_inc_nbi
+#define shmem_ctx_longlong_atomic_fetch_inc_nbi  pshmem_ctx_longlong_atomic_fetch_inc_nbi
+#define shmem_ctx_uint_atomic_fetch_inc_nbi      pshmem_ctx_uint_atomic_fetch_inc_nbi
+#define shmem_ctx_ulong_atomic_fetch_inc_nbi     pshmem_ctx_ulong_atomic_fetch_inc_nbi
+#define shmem_ctx_ulonglong_atomic_fetch_inc_nbi pshmem_ctx_ulonglong_atomic_fetch_inc_nbi
+#define shmem_int_atomic_fetch_inc_nbi           pshmem_int_atomic_fetch_inc_nbi
+#define shmem_long_atomic_fetch_inc_nbi          pshmem_long_atomic_fetch_inc_nbi
+#define shmem_longlong_atomic_fetch_inc_nbi      pshmem_longlong_atomic_fetch_inc_nbi
+#define shmem_uint_atomic_fetch_inc_nbi          pshmem_uint_atomic_fetch_inc_nbi
+#define shmem_ulong_atomic_fetch_inc_nbi         pshmem_ulong_atomic_fetch_inc_nbi
+#define shmem_ulonglong_atomic_fetch_inc_nbi     pshmem_ulonglong_atomic_fetch_inc_nbi
+
+#define shmem_ctx_int_atomic_fetch_add_nbi       pshmem_ctx_int_atomic_fetch_add_nbi
+#define shmem_ctx_long_atomic_fetch_add_nbi      pshmem_ctx_long_atomic_fetch_add_nbi
+#define shmem_ctx_longlong_atomic_fetch_add_nbi  pshmem_ctx_longlong_atomic_fetch_add_nbi
+#define shmem_ctx_uint_atomic_fetch_add_nbi      pshmem_ctx_uint_atomic_fetch_add_nbi
+#define shmem_ctx_ulong_atomic_fetch_add_nbi     pshmem_ctx_ulong_atomic_fetch_add_nbi
+#define shmem_ctx_ulonglong_atomic_fetch_add_nbi pshmem_ctx_ulonglong_atomic_fetch_add_nbi
+#define shmem_int_atomic_fetch_add_nbi           pshmem_int_atomic_fetch_add_nbi
+#define shmem_long_atomic_fetch_add_nbi          pshmem_long_atomic_fetch_add_nbi
+#define shmem_longlong_atomic_fetch_add_nbi      pshmem_longlong_atomic_fetch_add_nbi
+#define shmem_uint_atomic_fetch_add_nbi          pshmem_uint_atomic_fetch_add_nbi
+#define shmem_ulong_atomic_fetch_add_nbi         pshmem_ulong_atomic_fetch_add_nbi
+#define shmem_ulonglong_atomic_fetch_add_nbi     pshmem_ulonglong_atomic_fetch_add_nbi
+
+#define shmem_ctx_int_atomic_fetch_and_nbi       pshmem_ctx_int_atomic_fetch_and_nbi
+#define shmem_ctx_long_atomic_fetch_and_nbi      pshmem_ctx_long_atomic_fetch_and_nbi
+#define shmem_ctx_longlong_atomic_fetch_and_nbi  pshmem_ctx_longlong_atomic_fetch_and_nbi
+#define shmem_ctx_uint_atomic_fetch_and_nbi      pshmem_ctx_uint_atomic_fetch_and_nbi
+#define shmem_ctx_ulong_atomic_fetch_and_nbi     pshmem_ctx_ulong_atomic_fetch_and_nbi
+#define shmem_ctx_ulonglong_atomic_fetch_and_nbi pshmem_ctx_ulonglong_atomic_fetch_and_nbi
+#define shmem_ctx_int32_atomic_fetch_and_nbi     pshmem_ctx_int32_atomic_fetch_and_nbi
+#define shmem_ctx_int64_atomic_fetch_and_nbi     pshmem_ctx_int64_atomic_fetch_and_nbi
+#define shmem_ctx_uint32_atomic_fetch_and_nbi    pshmem_ctx_uint32_atomic_fetch_and_nbi
+#define shmem_ctx_uint64_atomic_fetch_and_nbi    pshmem_ctx_uint64_atomic_fetch_and_nbi
+#define shmem_int_atomic_fetch_and_nbi           pshmem_int_atomic_fetch_and_nbi
+#define shmem_long_atomic_fetch_and_nbi          pshmem_long_atomic_fetch_and_nbi
+#define shmem_longlong_atomic_fetch_and_nbi      pshmem_longlong_atomic_fetch_and_nbi
+#define shmem_uint_atomic_fetch_and_nbi          pshmem_uint_atomic_fetch_and_nbi
+#define shmem_ulong_atomic_fetch_and_nbi         pshmem_ulong_atomic_fetch_and_nbi
+#define shmem_ulonglong_atomic_fetch_and_nbi     pshmem_ulonglong_atomic_fetch_and_nbi
+#define shmem_int32_atomic_fetch_and_nbi         pshmem_int32_atomic_fetch_and_nbi
+#define shmem_int64_atomic_fetch_and_nbi         pshmem_int64_atomic_fetch_and_nbi
+#define shmem_uint32_atomic_fetch_and_nbi        pshmem_uint32_atomic_fetch_and_nbi
+#define shmem_uint64_atomic_fetch_and_nbi        pshmem_uint64_atomic_fetch_and_nbi
+
+#define shmem_ctx_int_atomic_fetch_or_nbi        pshmem_ctx_int_atomic_fetch_or_nbi
+#define shmem_ctx_long_atomic_fetch_or_nbi       pshmem_ctx_long_atomic_fetch_or_nbi
+#define shmem_ctx_longlong_atomic_fetch_or_nbi   pshmem_ctx_longlong_atomic_fetch_or_nbi
+#define shmem_ctx_uint_atomic_fetch_or_nbi       pshmem_ctx_uint_atomic_fetch_or_nbi
+#define shmem_ctx_ulong_atomic_fetch_or_nbi      pshmem_ctx_ulong_atomic_fetch_or_nbi
+#define shmem_ctx_ulonglong_atomic_fetch_or_nbi  pshmem_ctx_ulonglong_atomic_fetch_or_nbi
+#define shmem_ctx_int32_atomic_fetch_or_nbi      pshmem_ctx_int32_atomic_fetch_or_nbi
+#define shmem_ctx_int64_atomic_fetch_or_nbi      pshmem_ctx_int64_atomic_fetch_or_nbi
+#define shmem_ctx_uint32_atomic_fetch_or_nbi     pshmem_ctx_uint32_atomic_fetch_or_nbi
+#define shmem_ctx_uint64_atomic_fetch_or_nbi     pshmem_ctx_uint64_atomic_fetch_or_nbi
+#define shmem_int_atomic_fetch_or_nbi            pshmem_int_atomic_fetch_or_nbi
+#define shmem_long_atomic_fetch_or_nbi           pshmem_long_atomic_fetch_or_nbi
+#define shmem_longlong_atomic_fetch_or_nbi       pshmem_longlong_atomic_fetch_or_nbi
+#define shmem_uint_atomic_fetch_or_nbi           pshmem_uint_atomic_fetch_or_nbi
+#define shmem_ulong_atomic_fetch_or_nbi          pshmem_ulong_atomic_fetch_or_nbi
+#define shmem_ulonglong_atomic_fetch_or_nbi      pshmem_ulonglong_atomic_fetch_or_nbi
+#define shmem_int32_atomic_fetch_or_nbi          pshmem_int32_atomic_fetch_or_nbi
+#define shmem_int64_atomic_fetch_or_nbi          pshmem_int64_atomic_fetch_or_nbi
+#define shmem_uint32_atomic_fetch_or_nbi         pshmem_uint32_atomic_fetch_or_nbi
+#define shmem_uint64_atomic_fetch_or_nbi         pshmem_uint64_atomic_fetch_or_nbi
+
+#define shmem_ctx_int_atomic_fetch_xor_nbi       pshmem_ctx_int_atomic_fetch_xor_nbi
+#define shmem_ctx_long_atomic_fetch_xor_nbi      pshmem_ctx_long_atomic_fetch_xor_nbi
+#define shmem_ctx_longlong_atomic_fetch_xor_nbi  pshmem_ctx_longlong_atomic_fetch_xor_nbi
+#define shmem_ctx_uint_atomic_fetch_xor_nbi      pshmem_ctx_uint_atomic_fetch_xor_nbi
+#define shmem_ctx_ulong_atomic_fetch_xor_nbi     pshmem_ctx_ulong_atomic_fetch_xor_nbi
+#define shmem_ctx_ulonglong_atomic_fetch_xor_nbi pshmem_ctx_ulonglong_atomic_fetch_xor_nbi
+#define shmem_ctx_int32_atomic_fetch_xor_nbi     pshmem_ctx_int32_atomic_fetch_xor_nbi
+#define shmem_ctx_int64_atomic_fetch_xor_nbi     pshmem_ctx_int64_atomic_fetch_xor_nbi
+#define shmem_ctx_uint32_atomic_fetch_xor_nbi    pshmem_ctx_uint32_atomic_fetch_xor_nbi
+#define shmem_ctx_uint64_atomic_fetch_xor_nbi    pshmem_ctx_uint64_atomic_fetch_xor_nbi
+#define shmem_int_atomic_fetch_xor_nbi           pshmem_int_atomic_fetch_xor_nbi
+#define shmem_long_atomic_fetch_xor_nbi          pshmem_long_atomic_fetch_xor_nbi
+#define shmem_longlong_atomic_fetch_xor_nbi      pshmem_longlong_atomic_fetch_xor_nbi
+#define shmem_uint_atomic_fetch_xor_nbi          pshmem_uint_atomic_fetch_xor_nbi
+#define shmem_ulong_atomic_fetch_xor_nbi         pshmem_ulong_atomic_fetch_xor_nbi
+#define shmem_ulonglong_atomic_fetch_xor_nbi     pshmem_ulonglong_atomic_fetch_xor_nbi
+#define shmem_int32_atomic_fetch_xor_nbi         pshmem_int32_atomic_fetch_xor_nbi
+#define shmem_int64_atomic_fetch_xor_nbi         pshmem_int64_atomic_fetch_xor_nbi
+#define shmem_uint32_atomic_fetch_xor_nbi        pshmem_uint32_atomic_fetch_xor_nbi
+#define shmem_uint64_atomic_fetch_xor_nbi        pshmem_uint64_atomic_fetch_xor_nbi
+
+/*
+ * Put-with-signal routines
+ */
+#define shmem_ctx_char_put_signal                 pshmem_ctx_char_put_signal
+#define shmem_ctx_short_put_signal                pshmem_ctx_short_put_signal
+#define shmem_ctx_int_put_signal                  pshmem_ctx_int_put_signal
+#define shmem_ctx_long_put_signal                 pshmem_ctx_long_put_signal
+#define shmem_ctx_longlong_put_signal             pshmem_ctx_longlong_put_signal
+#define shmem_ctx_schar_put_signal                pshmem_ctx_schar_put_signal
+#define shmem_ctx_uchar_put_signal                pshmem_ctx_uchar_put_signal
+#define shmem_ctx_ushort_put_signal               pshmem_ctx_ushort_put_signal
+#define shmem_ctx_uint_put_signal                 pshmem_ctx_uint_put_signal
+#define shmem_ctx_ulong_put_signal                pshmem_ctx_ulong_put_signal
+#define shmem_ctx_ulonglong_put_signal            pshmem_ctx_ulonglong_put_signal
+#define shmem_ctx_float_put_signal                pshmem_ctx_float_put_signal
+#define shmem_ctx_double_put_signal               pshmem_ctx_double_put_signal
+#define shmem_ctx_longdouble_put_signal           pshmem_ctx_longdouble_put_signal
+#define shmem_ctx_int8_put_signal                 pshmem_ctx_int8_put_signal
+#define shmem_ctx_int16_put_signal                pshmem_ctx_int16_put_signal
+#define shmem_ctx_int32_put_signal                pshmem_ctx_int32_put_signal
+#define shmem_ctx_int64_put_signal                pshmem_ctx_int64_put_signal
+#define shmem_ctx_uint8_put_signal                pshmem_ctx_uint8_put_signal
+#define shmem_ctx_uint16_put_signal               pshmem_ctx_uint16_put_signal
+#define shmem_ctx_uint32_put_signal               pshmem_ctx_uint32_put_signal
+#define shmem_ctx_uint64_put_signal               pshmem_ctx_uint64_put_signal
+#define shmem_ctx_size_put_signal                 pshmem_ctx_size_put_signal
+#define shmem_ctx_ptrdiff_put_signal              pshmem_ctx_ptrdiff_put_signal
+
+#define shmem_char_put_signal                     pshmem_char_put_signal
+#define shmem_short_put_signal                    pshmem_short_put_signal
+#define shmem_int_put_signal                      pshmem_int_put_signal
+#define shmem_long_put_signal                     pshmem_long_put_signal
+#define shmem_longlong_put_signal                 pshmem_longlong_put_signal
+#define shmem_schar_put_signal                    pshmem_schar_put_signal
+#define shmem_uchar_put_signal                    pshmem_uchar_put_signal
+#define shmem_ushort_put_signal                   pshmem_ushort_put_signal
+#define shmem_uint_put_signal                     pshmem_uint_put_signal
+#define shmem_ulong_put_signal                    pshmem_ulong_put_signal
+#define shmem_ulonglong_put_signal                pshmem_ulonglong_put_signal
+#define shmem_float_put_signal                    pshmem_float_put_signal
+#define shmem_double_put_signal                   pshmem_double_put_signal
+#define shmem_longdouble_put_signal               pshmem_longdouble_put_signal
+#define shmem_int8_put_signal                     pshmem_int8_put_signal
+#define shmem_int16_put_signal                    pshmem_int16_put_signal
+#define shmem_int32_put_signal                    pshmem_int32_put_signal
+#define shmem_int64_put_signal                    pshmem_int64_put_signal
+#define shmem_uint8_put_signal                    pshmem_uint8_put_signal
+#define shmem_uint16_put_signal                   pshmem_uint16_put_signal
+#define shmem_uint32_put_signal                   pshmem_uint32_put_signal
+#define shmem_uint64_put_signal                   pshmem_uint64_put_signal
+#define shmem_size_put_signal                     pshmem_size_put_signal
+#define shmem_ptrdiff_put_signal                  pshmem_ptrdiff_put_signal
+
+#define shmem_ctx_put8_signal                     pshmem_ctx_put8_signal
+#define shmem_ctx_put16_signal                    pshmem_ctx_put16_signal
+#define shmem_ctx_put32_signal                    pshmem_ctx_put32_signal
+#define shmem_ctx_put64_signal                    pshmem_ctx_put64_signal
+#define shmem_ctx_put128_signal                   pshmem_ctx_put128_signal
+#define shmem_ctx_putmem_signal                   pshmem_ctx_putmem_signal
+
+#define shmem_put8_signal                         pshmem_put8_signal
+#define shmem_put16_signal                        pshmem_put16_signal
+#define shmem_put32_signal                        pshmem_put32_signal
+#define shmem_put64_signal                        pshmem_put64_signal
+#define shmem_put128_signal                       pshmem_put128_signal
+#define shmem_putmem_signal                       pshmem_putmem_signal
+
+#define shmem_ctx_char_put_signal_nbi             pshmem_ctx_char_put_signal_nbi
+#define shmem_ctx_short_put_signal_nbi            pshmem_ctx_short_put_signal_nbi
+#define shmem_ctx_int_put_signal_nbi              pshmem_ctx_int_put_signal_nbi
+#define shmem_ctx_long_put_signal_nbi             pshmem_ctx_long_put_signal_nbi
+#define shmem_ctx_longlong_put_signal_nbi         pshmem_ctx_longlong_put_signal_nbi
+#define shmem_ctx_schar_put_signal_nbi            pshmem_ctx_schar_put_signal_nbi
+#define shmem_ctx_uchar_put_signal_nbi            pshmem_ctx_uchar_put_signal_nbi
+#define shmem_ctx_ushort_put_signal_nbi           pshmem_ctx_ushort_put_signal_nbi
+#define shmem_ctx_uint_put_signal_nbi             pshmem_ctx_uint_put_signal_nbi
+#define shmem_ctx_ulong_put_signal_nbi            pshmem_ctx_ulong_put_signal_nbi
+#define shmem_ctx_ulonglong_put_signal_nbi        pshmem_ctx_ulonglong_put_signal_nbi
+#define shmem_ctx_float_put_signal_nbi            pshmem_ctx_float_put_signal_nbi
+#define shmem_ctx_double_put_signal_nbi           pshmem_ctx_double_put_signal_nbi
+#define shmem_ctx_longdouble_put_signal_nbi       pshmem_ctx_longdouble_put_signal_nbi
+#define shmem_ctx_int8_put_signal_nbi             pshmem_ctx_int8_put_signal_nbi
+#define shmem_ctx_int16_put_signal_nbi            pshmem_ctx_int16_put_signal_nbi
+#define shmem_ctx_int32_put_signal_nbi            pshmem_ctx_int32_put_signal_nbi
+#define shmem_ctx_int64_put_signal_nbi            pshmem_ctx_int64_put_signal_nbi
+#define shmem_ctx_uint8_put_signal_nbi            pshmem_ctx_uint8_put_signal_nbi
+#define shmem_ctx_uint16_put_signal_nbi           pshmem_ctx_uint16_put_signal_nbi
+#define shmem_ctx_uint32_put_signal_nbi           pshmem_ctx_uint32_put_signal_nbi
+#define shmem_ctx_uint64_put_signal_nbi           pshmem_ctx_uint64_put_signal_nbi
+#define shmem_ctx_size_put_signal_nbi             pshmem_ctx_size_put_signal_nbi
+#define shmem_ctx_ptrdiff_put_signal_nbi          pshmem_ctx_ptrdiff_put_signal_nbi
+
+#define shmem_char_put_signal_nbi                 pshmem_char_put_signal_nbi
+#define shmem_short_put_signal_nbi                pshmem_short_put_signal_nbi
+#define shmem_int_put_signal_nbi                  pshmem_int_put_signal_nbi
+#define shmem_long_put_signal_nbi                 pshmem_long_put_signal_nbi
+#define shmem_longlong_put_signal_nbi             pshmem_longlong_put_signal_nbi
+#define shmem_schar_put_signal_nbi                pshmem_schar_put_signal_nbi
+#define shmem_uchar_put_signal_nbi                pshmem_uchar_put_signal_nbi
+#define shmem_ushort_put_signal_nbi               pshmem_ushort_put_signal_nbi
+#define shmem_uint_put_signal_nbi                 pshmem_uint_put_signal_nbi
+#define shmem_ulong_put_signal_nbi                pshmem_ulong_put_signal_nbi
+#define shmem_ulonglong_put_signal_nbi            pshmem_ulonglong_put_signal_nbi
+#define shmem_float_put_signal_nbi                pshmem_float_put_signal_nbi
+#define shmem_double_put_signal_nbi               pshmem_double_put_signal_nbi
+#define shmem_longdouble_put_signal_nbi           pshmem_longdouble_put_signal_nbi
+#define shmem_int8_put_signal_nbi                 pshmem_int8_put_signal_nbi
+#define shmem_int16_put_signal_nbi                pshmem_int16_put_signal_nbi
+#define shmem_int32_put_signal_nbi                pshmem_int32_put_signal_nbi
+#define shmem_int64_put_signal_nbi                pshmem_int64_put_signal_nbi
+#define shmem_uint8_put_signal_nbi                pshmem_uint8_put_signal_nbi
+#define shmem_uint16_put_signal_nbi               pshmem_uint16_put_signal_nbi
+#define shmem_uint32_put_signal_nbi               pshmem_uint32_put_signal_nbi
+#define shmem_uint64_put_signal_nbi               pshmem_uint64_put_signal_nbi
+#define shmem_size_put_signal_nbi                 pshmem_size_put_signal_nbi
+#define shmem_ptrdiff_put_signal_nbi              pshmem_ptrdiff_put_signal_nbi
+
+#define shmem_ctx_put8_signal_nbi                 pshmem_ctx_put8_signal_nbi
+#define shmem_ctx_put16_signal_nbi                pshmem_ctx_put16_signal_nbi
+#define shmem_ctx_put32_signal_nbi                pshmem_ctx_put32_signal_nbi
+#define shmem_ctx_put64_signal_nbi                pshmem_ctx_put64_signal_nbi
+#define shmem_ctx_put128_signal_nbi               pshmem_ctx_put128_signal_nbi
+#define shmem_ctx_putmem_signal_nbi               pshmem_ctx_putmem_signal_nbi
+
+#define shmem_put8_signal_nbi                     pshmem_put8_signal_nbi
+#define shmem_put16_signal_nbi                    pshmem_put16_signal_nbi
+#define shmem_put32_signal_nbi                    pshmem_put32_signal_nbi
+#define shmem_put64_signal_nbi                    pshmem_put64_signal_nbi
+#define shmem_put128_signal_nbi                   pshmem_put128_signal_nbi
+#define shmem_putmem_signal_nbi                   pshmem_putmem_signal_nbi
+
+#define shmem_signal_fetch                        pshmem_signal_fetch
+#define shmem_signal_wait_until                   pshmem_signal_wait_until
+
 /*
  * Lock functions
  */
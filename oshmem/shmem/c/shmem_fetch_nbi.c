@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2026      Mellanox Technologies, Inc.
+ *                         All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+#include "oshmem_config.h"
+
+#include "oshmem/constants.h"
+#include "oshmem/include/shmem.h"
+
+#include "oshmem/runtime/runtime.h"
+
+#include "oshmem/mca/atomic/atomic.h"
+
+/*
+ * Non-blocking fetching atomic operations (OpenSHMEM 1.5).
+ * These routines perform the same operation as their blocking counterparts
+ * but return without waiting for the fetched value, which is written to
+ * fetch by the time the next shmem_quiet (or shmem_ctx_quiet on ctx) returns.
+ * Back to back operations to different PEs are then pipelined by the
+ * transport instead of paying a round trip each.
+ */
+#define DO_SHMEM_TYPE_ATOMIC_FETCH_OP_NBI(ctx, op, fetch, target, value, pe) do { \
+        int rc = OSHMEM_SUCCESS;                                    \
+                                                                    \
+        RUNTIME_CHECK_INIT();                                       \
+        RUNTIME_CHECK_PE(pe);                                       \
+        RUNTIME_CHECK_ADDR(target);                                 \
+                                                                    \
+        rc = MCA_ATOMIC_CALL(op(                                    \
+            ctx,                                                    \
+            (void*)target,                                          \
+            (void*)fetch,                                           \
+            OSHMEM_ATOMIC_PTR_2_INT(&value, sizeof(value)),         \
+            sizeof(*fetch),                                         \
+            pe));                                                   \
+        RUNTIME_CHECK_RC(rc);                                       \
+    } while (0)
+
+#define DO_SHMEM_TYPE_ATOMIC_COMPARE_SWAP_NBI(ctx, fetch, target, cond, value, pe) do { \
+        int rc = OSHMEM_SUCCESS;                                    \
+                                                                    \
+        RUNTIME_CHECK_INIT();                                       \
+        RUNTIME_CHECK_PE(pe);                                       \
+        RUNTIME_CHECK_ADDR(target);                                 \
+                                                                    \
+        rc = MCA_ATOMIC_CALL(cswap_nb(                              \
+            ctx,                                                    \
+            (void*)target,                                          \
+            (void*)fetch,                                           \
+            OSHMEM_ATOMIC_PTR_2_INT(&cond, sizeof(cond)),           \
+            OSHMEM_ATOMIC_PTR_2_INT(&value, sizeof(value)),         \
+            sizeof(*fetch),                                         \
+            pe));                                                   \
+        RUNTIME_CHECK_RC(rc);                                       \
+    } while (0)
+
+#define SHMEM_CTX_TYPE_ATOMIC_FETCH_NBI(type_name, type, prefix)    \
+    void prefix##_ctx_##type_name##_atomic_fetch_nbi(shmem_ctx_t ctx, type *fetch, const type *source, int pe) \
+    {                                                               \
+        type value = 0;                                             \
+        DO_SHMEM_TYPE_ATOMIC_FETCH_OP_NBI(ctx, fadd_nb, fetch, source, \
+                                          value, pe);               \
+    }
+
+#define SHMEM_TYPE_ATOMIC_FETCH_NBI(type_name, type, prefix)        \
+    void prefix##_##type_name##_atomic_fetch_nbi(type *fetch, const type *source, int pe) \
+    {                                                               \
+        type value = 0;                                             \
+        DO_SHMEM_TYPE_ATOMIC_FETCH_OP_NBI(oshmem_ctx_default, fadd_nb, \
+                                          fetch, source, value, pe); \
+    }
+
+#define SHMEM_CTX_TYPE_ATOMIC_COMPARE_SWAP_NBI(type_name, type, prefix) \
+    void prefix##_ctx_##type_name##_atomic_compare_swap_nbi(shmem_ctx_t ctx, type *fetch, type *target, type cond, type value, int pe) \
+    {                                                               \
+        DO_SHMEM_TYPE_ATOMIC_COMPARE_SWAP_NBI(ctx, fetch, target,   \
+                                              cond, value, pe);     \
+    }
+
+#define SHMEM_TYPE_ATOMIC_COMPARE_SWAP_NBI(type_name, type, prefix) \
+    void prefix##_##type_name##_atomic_compare_swap_nbi(type *fetch, type *target, type cond, type value, int pe) \
+    {                                                               \
+        DO_SHMEM_TYPE_ATOMIC_COMPARE_SWAP_NBI(oshmem_ctx_default,   \
+                                              fetch, target, cond,  \
+                                              value, pe);           \
+    }
+
+#define SHMEM_CTX_TYPE_ATOMIC_FETCH_INC_NBI(type_name, type, prefix) \
+    void prefix##_ctx_##type_name##_atomic_fetch_inc_nbi(shmem_ctx_t ctx, type *fetch, type *target, int pe) \
+    {                                                               \
+        type value = 1;                                             \
+        DO_SHMEM_TYPE_ATOMIC_FETCH_OP_NBI(ctx, fadd_nb, fetch, target, \
+                                          value, pe);               \
+    }
+
+#define SHMEM_TYPE_ATOMIC_FETCH_INC_NBI(type_name, type, prefix)    \
+    void prefix##_##type_name##_atomic_fetch_inc_nbi(type *fetch, type *target, int pe) \
+    {                                                               \
+        type value = 1;                                             \
+        DO_SHMEM_TYPE_ATOMIC_FETCH_OP_NBI(oshmem_ctx_default, fadd_nb, \
+                                          fetch, target, value, pe); \
+    }
+
+/* fetch_add, fetch_and, fetch_or, fetch_xor and swap */
+#define SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(type_name, type, prefix, name, op) \
+    void prefix##_ctx_##type_name##_atomic_##name##_nbi(shmem_ctx_t ctx, type *fetch, type *target, type value, int pe) \
+    {                                                               \
+        DO_SHMEM_TYPE_ATOMIC_FETCH_OP_NBI(ctx, op##_nb, fetch, target, \
+                                          value, pe);               \
+    }
+
+#define SHMEM_TYPE_ATOMIC_FOP_NBI(type_name, type, prefix, name, op) \
+    void prefix##_##type_name##_atomic_##name##_nbi(type *fetch, type *target, type value, int pe) \
+    {                                                               \
+        DO_SHMEM_TYPE_ATOMIC_FETCH_OP_NBI(oshmem_ctx_default, op##_nb, \
+                                          fetch, target, value, pe); \
+    }
+
+#if OSHMEM_PROFILING
+#include "oshmem/include/pshmem.h"
+#pragma weak shmem_ctx_int_atomic_fetch_nbi = pshmem_ctx_int_atomic_fetch_nbi
+#pragma weak shmem_ctx_long_atomic_fetch_nbi = pshmem_ctx_long_atomic_fetch_nbi
+#pragma weak shmem_ctx_longlong_atomic_fetch_nbi = pshmem_ctx_longlong_atomic_fetch_nbi
+#pragma weak shmem_ctx_uint_atomic_fetch_nbi = pshmem_ctx_uint_atomic_fetch_nbi
+#pragma weak shmem_ctx_ulong_atomic_fetch_nbi = pshmem_ctx_ulong_atomic_fetch_nbi
+#pragma weak shmem_ctx_ulonglong_atomic_fetch_nbi = pshmem_ctx_ulonglong_atomic_fetch_nbi
+#pragma weak shmem_ctx_float_atomic_fetch_nbi = pshmem_ctx_float_atomic_fetch_nbi
+#pragma weak shmem_ctx_double_atomic_fetch_nbi = pshmem_ctx_double_atomic_fetch_nbi
+#pragma weak shmem_int_atomic_fetch_nbi = pshmem_int_atomic_fetch_nbi
+#pragma weak shmem_long_atomic_fetch_nbi = pshmem_long_atomic_fetch_nbi
+#pragma weak shmem_longlong_atomic_fetch_nbi = pshmem_longlong_atomic_fetch_nbi
+#pragma weak shmem_uint_atomic_fetch_nbi = pshmem_uint_atomic_fetch_nbi
+#pragma weak shmem_ulong_atomic_fetch_nbi = pshmem_ulong_atomic_fetch_nbi
+#pragma weak shmem_ulonglong_atomic_fetch_nbi = pshmem_ulonglong_atomic_fetch_nbi
+#pragma weak shmem_float_atomic_fetch_nbi = pshmem_float_atomic_fetch_nbi
+#pragma weak shmem_double_atomic_fetch_nbi = pshmem_double_atomic_fetch_nbi
+
+#pragma weak shmem_ctx_int_atomic_compare_swap_nbi = pshmem_ctx_int_atomic_compare_swap_nbi
+#pragma weak shmem_ctx_long_atomic_compare_swap_nbi = pshmem_ctx_long_atomic_compare_swap_nbi
+#pragma weak shmem_ctx_longlong_atomic_compare_swap_nbi = pshmem_ctx_longlong_atomic_compare_swap_nbi
+#pragma weak shmem_ctx_uint_atomic_compare_swap_nbi = pshmem_ctx_uint_atomic_compare_swap_nbi
+#pragma weak shmem_ctx_ulong_atomic_compare_swap_nbi = pshmem_ctx_ulong_atomic_compare_swap_nbi
+#pragma weak shmem_ctx_ulonglong_atomic_compare_swap_nbi = pshmem_ctx_ulonglong_atomic_compare_swap_nbi
+#pragma weak shmem_int_atomic_compare_swap_nbi = pshmem_int_atomic_compare_swap_nbi
+#pragma weak shmem_long_atomic_compare_swap_nbi = pshmem_long_atomic_compare_swap_nbi
+#pragma weak shmem_longlong_atomic_compare_swap_nbi = pshmem_longlong_atomic_compare_swap_nbi
+#pragma weak shmem_uint_atomic_compare_swap_nbi = pshmem_uint_atomic_compare_swap_nbi
+#pragma weak shmem_ulong_atomic_compare_swap_nbi = pshmem_ulong_atomic_compare_swap_nbi
+#pragma weak shmem_ulonglong_atomic_compare_swap_nbi = pshmem_ulonglong_atomic_compare_swap_nbi
+
+#pragma weak shmem_ctx_int_atomic_swap_nbi = pshmem_ctx_int_atomic_swap_nbi
+#pragma weak shmem_ctx_long_atomic_swap_nbi = pshmem_ctx_long_atomic_swap_nbi
+#pragma weak shmem_ctx_longlong_atomic_swap_nbi = pshmem_ctx_longlong_atomic_swap_nbi
+#pragma weak shmem_ctx_uint_atomic_swap_nbi = pshmem_ctx_uint_atomic_swap_nbi
+#pragma weak shmem_ctx_ulong_atomic_swap_nbi = pshmem_ctx_ulong_atomic_swap_nbi
+#pragma weak shmem_ctx_ulonglong_atomic_swap_nbi = pshmem_ctx_ulonglong_atomic_swap_nbi
+#pragma weak shmem_ctx_float_atomic_swap_nbi = pshmem_ctx_float_atomic_swap_nbi
+#pragma weak shmem_ctx_double_atomic_swap_nbi = pshmem_ctx_double_atomic_swap_nbi
+#pragma weak shmem_int_atomic_swap_nbi = pshmem_int_atomic_swap_nbi
+#pragma weak shmem_long_atomic_swap_nbi = pshmem_long_atomic_swap_nbi
+#pragma weak shmem_longlong_atomic_swap_nbi = pshmem_longlong_atomic_swap_nbi
+#pragma weak shmem_uint_atomic_swap_nbi = pshmem_uint_atomic_swap_nbi
+#pragma weak shmem_ulong_atomic_swap_nbi = pshmem_ulong_atomic_swap_nbi
+#pragma weak shmem_ulonglong_atomic_swap_nbi = pshmem_ulonglong_atomic_swap_nbi
+#pragma weak shmem_float_atomic_swap_nbi = pshmem_float_atomic_swap_nbi
+#pragma weak shmem_double_atomic_swap_nbi = pshmem_double_atomic_swap_nbi
+
+#pragma weak shmem_ctx_int_atomic_fetch_inc_nbi = pshmem_ctx_int_atomic_fetch_inc_nbi
+#pragma weak shmem_ctx_long_atomic_fetch_inc_nbi = pshmem_ctx_long_atomic_fetch_inc_nbi
+#pragma weak shmem_ctx_longlong_atomic_fetch_inc_nbi = pshmem_ctx_longlong_atomic_fetch_inc_nbi
+#pragma weak shmem_ctx_uint_atomic_fetch_inc_nbi = pshmem_ctx_uint_atomic_fetch_inc_nbi
+#pragma weak shmem_ctx_ulong_atomic_fetch_inc_nbi = pshmem_ctx_ulong_atomic_fetch_inc_nbi
+#pragma weak shmem_ctx_ulonglong_atomic_fetch_inc_nbi = pshmem_ctx_ulonglong_atomic_fetch_inc_nbi
+#pragma weak shmem_int_atomic_fetch_inc_nbi = pshmem_int_atomic_fetch_inc_nbi
+#pragma weak shmem_long_atomic_fetch_inc_nbi = pshmem_long_atomic_fetch_inc_nbi
+#pragma weak shmem_longlong_atomic_fetch_inc_nbi = pshmem_longlong_atomic_fetch_inc_nbi
+#pragma weak shmem_uint_atomic_fetch_inc_nbi = pshmem_uint_atomic_fetch_inc_nbi
+#pragma weak shmem_ulong_atomic_fetch_inc_nbi = pshmem_ulong_atomic_fetch_inc_nbi
+#pragma weak shmem_ulonglong_atomic_fetch_inc_nbi = pshmem_ulonglong_atomic_fetch_inc_nbi
+
+#pragma weak shmem_ctx_int_atomic_fetch_add_nbi = pshmem_ctx_int_atomic_fetch_add_nbi
+#pragma weak shmem_ctx_long_atomic_fetch_add_nbi = pshmem_ctx_long_atomic_fetch_add_nbi
+#pragma weak shmem_ctx_longlong_atomic_fetch_add_nbi = pshmem_ctx_longlong_atomic_fetch_add_nbi
+#pragma weak shmem_ctx_uint_atomic_fetch_add_nbi = pshmem_ctx_uint_atomic_fetch_add_nbi
+#pragma weak shmem_ctx_ulong_atomic_fetch_add_nbi = pshmem_ctx_ulong_atomic_fetch_add_nbi
+#pragma weak shmem_ctx_ulonglong_atomic_fetch_add_nbi = pshmem_ctx_ulonglong_atomic_fetch_add_nbi
+#pragma weak shmem_int_atomic_fetch_add_nbi = pshmem_int_atomic_fetch_add_nbi
+#pragma weak shmem_long_atomic_fetch_add_nbi = pshmem_long_atomic_fetch_add_nbi
+#pragma weak shmem_longlong_atomic_fetch_add_nbi = pshmem_longlong_atomic_fetch_add_nbi
+#pragma weak shmem_uint_atomic_fetch_add_nbi = pshmem_uint_atomic_fetch_add_nbi
+#pragma weak shmem_ulong_atomic_fetch_add_nbi = pshmem_ulong_atomic_fetch_add_nbi
+#pragma weak shmem_ulonglong_atomic_fetch_add_nbi = pshmem_ulonglong_atomic_fetch_add_nbi
+
+#pragma weak shmem_ctx_int_atomic_fetch_and_nbi = pshmem_ctx_int_atomic_fetch_and_nbi
+#pragma weak shmem_ctx_long_atomic_fetch_and_nbi = pshmem_ctx_long_atomic_fetch_and_nbi
+#pragma weak shmem_ctx_longlong_atomic_fetch_and_nbi = pshmem_ctx_longlong_atomic_fetch_and_nbi
+#pragma weak shmem_ctx_uint_atomic_fetch_and_nbi = pshmem_ctx_uint_atomic_fetch_and_nbi
+#pragma weak shmem_ctx_ulong_atomic_fetch_and_nbi = pshmem_ctx_ulong_atomic_fetch_and_nbi
+#pragma weak shmem_ctx_ulonglong_atomic_fetch_and_nbi = pshmem_ctx_ulonglong_atomic_fetch_and_nbi
+#pragma weak shmem_ctx_int32_atomic_fetch_and_nbi = pshmem_ctx_int32_atomic_fetch_and_nbi
+#pragma weak shmem_ctx_int64_atomic_fetch_and_nbi = pshmem_ctx_int64_atomic_fetch_and_nbi
+#pragma weak shmem_ctx_uint32_atomic_fetch_and_nbi = pshmem_ctx_uint32_atomic_fetch_and_nbi
+#pragma weak shmem_ctx_uint64_atomic_fetch_and_nbi = pshmem_ctx_uint64_atomic_fetch_and_nbi
+#pragma weak shmem_int_atomic_fetch_and_nbi = pshmem_int_atomic_fetch_and_nbi
+#pragma weak shmem_long_atomic_fetch_and_nbi = pshmem_long_atomic_fetch_and_nbi
+#pragma weak shmem_longlong_atomic_fetch_and_nbi = pshmem_longlong_atomic_fetch_and_nbi
+#pragma weak shmem_uint_atomic_fetch_and_nbi = pshmem_uint_atomic_fetch_and_nbi
+#pragma weak shmem_ulong_atomic_fetch_and_nbi = pshmem_ulong_atomic_fetch_and_nbi
+#pragma weak shmem_ulonglong_atomic_fetch_and_nbi = pshmem_ulonglong_atomic_fetch_and_nbi
+#pragma weak shmem_int32_atomic_fetch_and_nbi = pshmem_int32_atomic_fetch_and_nbi
+#pragma weak shmem_int64_atomic_fetch_and_nbi = pshmem_int64_atomic_fetch_and_nbi
+#pragma weak shmem_uint32_atomic_fetch_and_nbi = pshmem_uint32_atomic_fetch_and_nbi
+#pragma weak shmem_uint64_atomic_fetch_and_nbi = pshmem_uint64_atomic_fetch_and_nbi
+
+#pragma weak shmem_ctx_int_atomic_fetch_or_nbi = pshmem_ctx_int_atomic_fetch_or_nbi
+#pragma weak shmem_ctx_long_atomic_fetch_or_nbi = pshmem_ctx_long_atomic_fetch_or_nbi
+#pragma weak shmem_ctx_longlong_atomic_fetch_or_nbi = pshmem_ctx_longlong_atomic_fetch_or_nbi
+#pragma weak shmem_ctx_uint_atomic_fetch_or_nbi = pshmem_ctx_uint_atomic_fetch_or_nbi
+#pragma weak shmem_ctx_ulong_atomic_fetch_or_nbi = pshmem_ctx_ulong_atomic_fetch_or_nbi
+#pragma weak shmem_ctx_ulonglong_atomic_fetch_or_nbi = pshmem_ctx_ulonglong_atomic_fetch_or_nbi
+#pragma weak shmem_ctx_int32_atomic_fetch_or_nbi = pshmem_ctx_int32_atomic_fetch_or_nbi
+#pragma weak shmem_ctx_int64_atomic_fetch_or_nbi = pshmem_ctx_int64_atomic_fetch_or_nbi
+#pragma weak shmem_ctx_uint32_atomic_fetch_or_nbi = pshmem_ctx_uint32_atomic_fetch_or_nbi
+#pragma weak shmem_ctx_uint64_atomic_fetch_or_nbi = pshmem_ctx_uint64_atomic_fetch_or_nbi
+#pragma weak shmem_int_atomic_fetch_or_nbi = pshmem_int_atomic_fetch_or_nbi
+#pragma weak shmem_long_atomic_fetch_or_nbi = pshmem_long_atomic_fetch_or_nbi
+#pragma weak shmem_longlong_atomic_fetch_or_nbi = pshmem_longlong_atomic_fetch_or_nbi
+#pragma weak shmem_uint_atomic_fetch_or_nbi = pshmem_uint_atomic_fetch_or_nbi
+#pragma weak shmem_ulong_atomic_fetch_or_nbi = pshmem_ulong_atomic_fetch_or_nbi
+#pragma weak shmem_ulonglong_atomic_fetch_or_nbi = pshmem_ulonglong_atomic_fetch_or_nbi
+#pragma weak shmem_int32_atomic_fetch_or_nbi = pshmem_int32_atomic_fetch_or_nbi
+#pragma weak shmem_int64_atomic_fetch_or_nbi = pshmem_int64_atomic_fetch_or_nbi
+#pragma weak shmem_uint32_atomic_fetch_or_nbi = pshmem_uint32_atomic_fetch_or_nbi
+#pragma weak shmem_uint64_atomic_fetch_or_nbi = pshmem_uint64_atomic_fetch_or_nbi
+
+#pragma weak shmem_ctx_int_atomic_fetch_xor_nbi = pshmem_ctx_int_atomic_fetch_xor_nbi
+#pragma weak shmem_ctx_long_atomic_fetch_xor_nbi = pshmem_ctx_long_atomic_fetch_xor_nbi
+#pragma weak shmem_ctx_longlong_atomic_fetch_xor_nbi = pshmem_ctx_longlong_atomic_fetch_xor_nbi
+#pragma weak shmem_ctx_uint_atomic_fetch_xor_nbi = pshmem_ctx_uint_atomic_fetch_xor_nbi
+#pragma weak shmem_ctx_ulong_atomic_fetch_xor_nbi = pshmem_ctx_ulong_atomic_fetch_xor_nbi
+#pragma weak shmem_ctx_ulonglong_atomic_fetch_xor_nbi = pshmem_ctx_ulonglong_atomic_fetch_xor_nbi
+#pragma weak shmem_ctx_int32_atomic_fetch_xor_nbi = pshmem_ctx_int32_atomic_fetch_xor_nbi
+#pragma weak shmem_ctx_int64_atomic_fetch_xor_nbi = pshmem_ctx_int64_atomic_fetch_xor_nbi
+#pragma weak shmem_ctx_uint32_atomic_fetch_xor_nbi = pshmem_ctx_uint32_atomic_fetch_xor_nbi
+#pragma weak shmem_ctx_uint64_atomic_fetch_xor_nbi = pshmem_ctx_uint64_atomic_fetch_xor_nbi
+#pragma weak shmem_int_atomic_fetch_xor_nbi = pshmem_int_atomic_fetch_xor_nbi
+#pragma weak shmem_long_atomic_fetch_xor_nbi = pshmem_long_atomic_fetch_xor_nbi
+#pragma weak shmem_longlong_atomic_fetch_xor_nbi = pshmem_longlong_atomic_fetch_xor_nbi
+#pragma weak shmem_uint_atomic_fetch_xor_nbi = pshmem_uint_atomic_fetch_xor_nbi
+#pragma weak shmem_ulong_atomic_fetch_xor_nbi = pshmem_ulong_atomic_fetch_xor_nbi
+#pragma weak shmem_ulonglong_atomic_fetch_xor_nbi = pshmem_ulonglong_atomic_fetch_xor_nbi
+#pragma weak shmem_int32_atomic_fetch_xor_nbi = pshmem_int32_atomic_fetch_xor_nbi
+#pragma weak shmem_int64_atomic_fetch_xor_nbi = pshmem_int64_atomic_fetch_xor_nbi
+#pragma weak shmem_uint32_atomic_fetch_xor_nbi = pshmem_uint32_atomic_fetch_xor_nbi
+#pragma weak shmem_uint64_atomic_fetch_xor_nbi = pshmem_uint64_atomic_fetch_xor_nbi
+#include "oshmem/shmem/c/profile/defines.h"
+#endif
+
+SHMEM_CTX_TYPE_ATOMIC_FETCH_NBI(int, int, shmem)
+SHMEM_CTX_TYPE_ATOMIC_FETCH_NBI(long, long, shmem)
+SHMEM_CTX_TYPE_ATOMIC_FETCH_NBI(longlong, long long, shmem)
+SHMEM_CTX_TYPE_ATOMIC_FETCH_NBI(uint, unsigned int, shmem)
+SHMEM_CTX_TYPE_ATOMIC_FETCH_NBI(ulong, unsigned long, shmem)
+SHMEM_CTX_TYPE_ATOMIC_FETCH_NBI(ulonglong, unsigned long long, shmem)
+SHMEM_CTX_TYPE_ATOMIC_FETCH_NBI(float, float, shmem)
+SHMEM_CTX_TYPE_ATOMIC_FETCH_NBI(double, double, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_NBI(int, int, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_NBI(long, long, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_NBI(longlong, long long, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_NBI(uint, unsigned int, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_NBI(ulong, unsigned long, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_NBI(ulonglong, unsigned long long, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_NBI(float, float, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_NBI(double, double, shmem)
+
+SHMEM_CTX_TYPE_ATOMIC_COMPARE_SWAP_NBI(int, int, shmem)
+SHMEM_CTX_TYPE_ATOMIC_COMPARE_SWAP_NBI(long, long, shmem)
+SHMEM_CTX_TYPE_ATOMIC_COMPARE_SWAP_NBI(longlong, long long, shmem)
+SHMEM_CTX_TYPE_ATOMIC_COMPARE_SWAP_NBI(uint, unsigned int, shmem)
+SHMEM_CTX_TYPE_ATOMIC_COMPARE_SWAP_NBI(ulong, unsigned long, shmem)
+SHMEM_CTX_TYPE_ATOMIC_COMPARE_SWAP_NBI(ulonglong, unsigned long long, shmem)
+SHMEM_TYPE_ATOMIC_COMPARE_SWAP_NBI(int, int, shmem)
+SHMEM_TYPE_ATOMIC_COMPARE_SWAP_NBI(long, long, shmem)
+SHMEM_TYPE_ATOMIC_COMPARE_SWAP_NBI(longlong, long long, shmem)
+SHMEM_TYPE_ATOMIC_COMPARE_SWAP_NBI(uint, unsigned int, shmem)
+SHMEM_TYPE_ATOMIC_COMPARE_SWAP_NBI(ulong, unsigned long, shmem)
+SHMEM_TYPE_ATOMIC_COMPARE_SWAP_NBI(ulonglong, unsigned long long, shmem)
+
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(int, int, shmem, swap, swap)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(long, long, shmem, swap, swap)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(longlong, long long, shmem, swap, swap)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(uint, unsigned int, shmem, swap, swap)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(ulong, unsigned long, shmem, swap, swap)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(ulonglong, unsigned long long, shmem, swap, swap)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(float, float, shmem, swap, swap)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(double, double, shmem, swap, swap)
+SHMEM_TYPE_ATOMIC_FOP_NBI(int, int, shmem, swap, swap)
+SHMEM_TYPE_ATOMIC_FOP_NBI(long, long, shmem, swap, swap)
+SHMEM_TYPE_ATOMIC_FOP_NBI(longlong, long long, shmem, swap, swap)
+SHMEM_TYPE_ATOMIC_FOP_NBI(uint, unsigned int, shmem, swap, swap)
+SHMEM_TYPE_ATOMIC_FOP_NBI(ulong, unsigned long, shmem, swap, swap)
+SHMEM_TYPE_ATOMIC_FOP_NBI(ulonglong, unsigned long long, shmem, swap, swap)
+SHMEM_TYPE_ATOMIC_FOP_NBI(float, float, shmem, swap, swap)
+SHMEM_TYPE_ATOMIC_FOP_NBI(double, double, shmem, swap, swap)
+
+SHMEM_CTX_TYPE_ATOMIC_FETCH_INC_NBI(int, int, shmem)
+SHMEM_CTX_TYPE_ATOMIC_FETCH_INC_NBI(long, long, shmem)
+SHMEM_CTX_TYPE_ATOMIC_FETCH_INC_NBI(longlong, long long, shmem)
+SHMEM_CTX_TYPE_ATOMIC_FETCH_INC_NBI(uint, unsigned int, shmem)
+SHMEM_CTX_TYPE_ATOMIC_FETCH_INC_NBI(ulong, unsigned long, shmem)
+SHMEM_CTX_TYPE_ATOMIC_FETCH_INC_NBI(ulonglong, unsigned long long, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_INC_NBI(int, int, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_INC_NBI(long, long, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_INC_NBI(longlong, long long, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_INC_NBI(uint, unsigned int, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_INC_NBI(ulong, unsigned long, shmem)
+SHMEM_TYPE_ATOMIC_FETCH_INC_NBI(ulonglong, unsigned long long, shmem)
+
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(int, int, shmem, fetch_add, fadd)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(long, long, shmem, fetch_add, fadd)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(longlong, long long, shmem, fetch_add, fadd)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(uint, unsigned int, shmem, fetch_add, fadd)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(ulong, unsigned long, shmem, fetch_add, fadd)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(ulonglong, unsigned long long, shmem, fetch_add, fadd)
+SHMEM_TYPE_ATOMIC_FOP_NBI(int, int, shmem, fetch_add, fadd)
+SHMEM_TYPE_ATOMIC_FOP_NBI(long, long, shmem, fetch_add, fadd)
+SHMEM_TYPE_ATOMIC_FOP_NBI(longlong, long long, shmem, fetch_add, fadd)
+SHMEM_TYPE_ATOMIC_FOP_NBI(uint, unsigned int, shmem, fetch_add, fadd)
+SHMEM_TYPE_ATOMIC_FOP_NBI(ulong, unsigned long, shmem, fetch_add, fadd)
+SHMEM_TYPE_ATOMIC_FOP_NBI(ulonglong, unsigned long long, shmem, fetch_add, fadd)
+
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(int, int, shmem, fetch_and, fand)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(long, long, shmem, fetch_and, fand)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(longlong, long long, shmem, fetch_and, fand)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(uint, unsigned int, shmem, fetch_and, fand)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(ulong, unsigned long, shmem, fetch_and, fand)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(ulonglong, unsigned long long, shmem, fetch_and, fand)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(int32, int32_t, shmem, fetch_and, fand)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(int64, int64_t, shmem, fetch_and, fand)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(uint32, uint32_t, shmem, fetch_and, fand)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(uint64, uint64_t, shmem, fetch_and, fand)
+SHMEM_TYPE_ATOMIC_FOP_NBI(int, int, shmem, fetch_and, fand)
+SHMEM_TYPE_ATOMIC_FOP_NBI(long, long, shmem, fetch_and, fand)
+SHMEM_TYPE_ATOMIC_FOP_NBI(longlong, long long, shmem, fetch_and, fand)
+SHMEM_TYPE_ATOMIC_FOP_NBI(uint, unsigned int, shmem, fetch_and, fand)
+SHMEM_TYPE_ATOMIC_FOP_NBI(ulong, unsigned long, shmem, fetch_and, fand)
+SHMEM_TYPE_ATOMIC_FOP_NBI(ulonglong, unsigned long long, shmem, fetch_and, fand)
+SHMEM_TYPE_ATOMIC_FOP_NBI(int32, int32_t, shmem, fetch_and, fand)
+SHMEM_TYPE_ATOMIC_FOP_NBI(int64, int64_t, shmem, fetch_and, fand)
+SHMEM_TYPE_ATOMIC_FOP_NBI(uint32, uint32_t, shmem, fetch_and, fand)
+SHMEM_TYPE_ATOMIC_FOP_NBI(uint64, uint64_t, shmem, fetch_and, fand)
+
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(int, int, shmem, fetch_or, for)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(long, long, shmem, fetch_or, for)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(longlong, long long, shmem, fetch_or, for)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(uint, unsigned int, shmem, fetch_or, for)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(ulong, unsigned long, shmem, fetch_or, for)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(ulonglong, unsigned long long, shmem, fetch_or, for)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(int32, int32_t, shmem, fetch_or, for)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(int64, int64_t, shmem, fetch_or, for)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(uint32, uint32_t, shmem, fetch_or, for)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(uint64, uint64_t, shmem, fetch_or, for)
+SHMEM_TYPE_ATOMIC_FOP_NBI(int, int, shmem, fetch_or, for)
+SHMEM_TYPE_ATOMIC_FOP_NBI(long, long, shmem, fetch_or, for)
+SHMEM_TYPE_ATOMIC_FOP_NBI(longlong, long long, shmem, fetch_or, for)
+SHMEM_TYPE_ATOMIC_FOP_NBI(uint, unsigned int, shmem, fetch_or, for)
+SHMEM_TYPE_ATOMIC_FOP_NBI(ulong, unsigned long, shmem, fetch_or, for)
+SHMEM_TYPE_ATOMIC_FOP_NBI(ulonglong, unsigned long long, shmem, fetch_or, for)
+SHMEM_TYPE_ATOMIC_FOP_NBI(int32, int32_t, shmem, fetch_or, for)
+SHMEM_TYPE_ATOMIC_FOP_NBI(int64, int64_t, shmem, fetch_or, for)
+SHMEM_TYPE_ATOMIC_FOP_NBI(uint32, uint32_t, shmem, fetch_or, for)
+SHMEM_TYPE_ATOMIC_FOP_NBI(uint64, uint64_t, shmem, fetch_or, for)
+
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(int, int, shmem, fetch_xor, fxor)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(long, long, shmem, fetch_xor, fxor)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(longlong, long long, shmem, fetch_xor, fxor)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(uint, unsigned int, shmem, fetch_xor, fxor)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(ulong, unsigned long, shmem, fetch_xor, fxor)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(ulonglong, unsigned long long, shmem, fetch_xor, fxor)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(int32, int32_t, shmem, fetch_xor, fxor)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(int64, int64_t, shmem, fetch_xor, fxor)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(uint32, uint32_t, shmem, fetch_xor, fxor)
+SHMEM_CTX_TYPE_ATOMIC_FOP_NBI(uint64, uint64_t, shmem, fetch_xor, fxor)
+SHMEM_TYPE_ATOMIC_FOP_NBI(int, int, shmem, fetch_xor, fxor)
+SHMEM_TYPE_ATOMIC_FOP_NBI(long, long, shmem, fetch_xor, fxor)
+SHMEM_TYPE_ATOMIC_FOP_NBI(longlong, long long, shmem, fetch_xor, fxor)
+SHMEM_TYPE_ATOMIC_FOP_NBI(uint, unsigned int, shmem, fetch_xor, fxor)
+SHMEM_TYPE_ATOMIC_FOP_NBI(ulong, unsigned long, shmem, fetch_xor, fxor)
+SHMEM_TYPE_ATOMIC_FOP_NBI(ulonglong, unsigned long long, shmem, fetch_xor, fxor)
+SHMEM_TYPE_ATOMIC_FOP_NBI(int32, int32_t, shmem, fetch_xor, fxor)
+SHMEM_TYPE_ATOMIC_FOP_NBI(int64, int64_t, shmem, fetch_xor, fxor)
+SHMEM_TYPE_ATOMIC_FOP_NBI(uint32, uint32_t, shmem, fetch_xor, fxor)
+SHMEM_TYPE_ATOMIC_FOP_NBI(uint64, uint64_t, shmem, fetch_xor, fxor)
@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2026      Mellanox Technologies, Inc.
+ *                         All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+#include "oshmem_config.h"
+
+#include "oshmem/constants.h"
+#include "oshmem/include/shmem.h"
+
+#include "oshmem/runtime/runtime.h"
+
+#include "oshmem/mca/spml/spml.h"
+#include "oshmem/mca/atomic/atomic.h"
+
+/*
+ * The put-with-signal routines copy data to a remote PE and then update a
+ * signal object on the same PE: the signal is delivered after the data, so
+ * a PE waiting on the signal finds the data in place. With SHMEM_SIGNAL_SET
+ * the signal is atomically set to the value, with SHMEM_SIGNAL_ADD the
+ * value is atomically added to it. The blocking routines return when the
+ * source buffer can be reused, the _nbi ones after posting the operations,
+ * which complete at the next shmem_quiet.
+ */
+#define DO_SHMEM_PUT_SIGNAL(ctx, fn, target, source, size, sig_addr, signal, sig_op, pe) do { \
+        int rc = OSHMEM_SUCCESS;                                    \
+                                                                    \
+        RUNTIME_CHECK_INIT();                                       \
+        RUNTIME_CHECK_PE(pe);                                       \
+        RUNTIME_CHECK_ADDR(target);                                 \
+        RUNTIME_CHECK_ADDR(sig_addr);                               \
+                                                                    \
+        rc = MCA_SPML_CALL(fn(                                      \
+            ctx,                                                    \
+            (void *)target,                                         \
+            size,                                                   \
+            (void *)source,                                         \
+            sig_addr,                                               \
+            signal,                                                 \
+            sig_op,                                                 \
+            pe));                                                   \
+        RUNTIME_CHECK_RC(rc);                                       \
+    } while (0)
+
+#define SHMEM_CTX_TYPE_PUT_SIGNAL(type_name, type, suffix, fn)      \
+    void shmem_ctx##type_name##_put_signal##suffix(shmem_ctx_t ctx, type *target, const type *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe) \
+    {                                                               \
+        DO_SHMEM_PUT_SIGNAL(ctx, fn, target, source, len * sizeof(type), \
+                            sig_addr, signal, sig_op, pe);          \
+        return ;                                                    \
+    }
+
+#define SHMEM_TYPE_PUT_SIGNAL(type_name, type, suffix, fn)          \
+    void shmem##type_name##_put_signal##suffix(type *target, const type *source, size_t len, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe) \
+    {                                                               \
+        DO_SHMEM_PUT_SIGNAL(oshmem_ctx_default, fn, target, source, \
+                            len * sizeof(type), sig_addr, signal,   \
+                            sig_op, pe);                            \
+        return ;                                                    \
+    }
+
+#define SHMEM_CTX_PUTMEM_SIGNAL(name, element_size, suffix, fn)     \
+    void shmem_ctx##name##_signal##suffix(shmem_ctx_t ctx, void *target, const void *source, size_t nelems, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe) \
+    {                                                               \
+        DO_SHMEM_PUT_SIGNAL(ctx, fn, target, source,                \
+                            nelems * element_size, sig_addr, signal, \
+                            sig_op, pe);                            \
+        return ;                                                    \
+    }
+
+#define SHMEM_PUTMEM_SIGNAL(name, element_size, suffix, fn)         \
+    void shmem##name##_signal##suffix(void *target, const void *source, size_t nelems, uint64_t *sig_addr, uint64_t signal, int sig_op, int pe) \
+    {                                                               \
+        DO_SHMEM_PUT_SIGNAL(oshmem_ctx_default, fn, target, source, \
+                            nelems * element_size, sig_addr, signal, \
+                            sig_op, pe);                            \
+        return ;                                                    \
+    }
+
+#if OSHMEM_PROFILING
+#include "oshmem/include/pshmem.h"
+#pragma weak shmem_ctx_char_put_signal            = pshmem_ctx_char_put_signal
+#pragma weak shmem_ctx_short_put_signal           = pshmem_ctx_short_put_signal
+#pragma weak shmem_ctx_int_put_signal             = pshmem_ctx_int_put_signal
+#pragma weak shmem_ctx_long_put_signal            = pshmem_ctx_long_put_signal
+#pragma weak shmem_ctx_longlong_put_signal        = pshmem_ctx_longlong_put_signal
+#pragma weak shmem_ctx_schar_put_signal           = pshmem_ctx_schar_put_signal
+#pragma weak shmem_ctx_uchar_put_signal           = pshmem_ctx_uchar_put_signal
+#pragma weak shmem_ctx_ushort_put_signal          = pshmem_ctx_ushort_put_signal
+#pragma weak shmem_ctx_uint_put_signal            = pshmem_ctx_uint_put_signal
+#pragma weak shmem_ctx_ulong_put_signal           = pshmem_ctx_ulong_put_signal
+#pragma weak shmem_ctx_ulonglong_put_signal       = pshmem_ctx_ulonglong_put_signal
+#pragma weak shmem_ctx_float_put_signal           = pshmem_ctx_float_put_signal
+#pragma weak shmem_ctx_double_put_signal          = pshmem_ctx_double_put_signal
+#pragma weak shmem_ctx_longdouble_put_signal      = pshmem_ctx_longdouble_put_signal
+#pragma weak shmem_ctx_int8_put_signal            = pshmem_ctx_int8_put_signal
+#pragma weak shmem_ctx_int16_put_signal           = pshmem_ctx_int16_put_signal
+#pragma weak shmem_ctx_int32_put_signal           = pshmem_ctx_int32_put_signal
+#pragma weak shmem_ctx_int64_put_signal           = pshmem_ctx_int64_put_signal
+#pragma weak shmem_ctx_uint8_put_signal           = pshmem_ctx_uint8_put_signal
+#pragma weak shmem_ctx_uint16_put_signal          = pshmem_ctx_uint16_put_signal
+#pragma weak shmem_ctx_uint32_put_signal          = pshmem_ctx_uint32_put_signal
+#pragma weak shmem_ctx_uint64_put_signal          = pshmem_ctx_uint64_put_signal
+#pragma weak shmem_ctx_size_put_signal            = pshmem_ctx_size_put_signal
+#pragma weak shmem_ctx_ptrdiff_put_signal         = pshmem_ctx_ptrdiff_put_signal
+
+#pragma weak shmem_char_put_signal                = pshmem_char_put_signal
+#pragma weak shmem_short_put_signal               = pshmem_short_put_signal
+#pragma weak shmem_int_put_signal                 = pshmem_int_put_signal
+#pragma weak shmem_long_put_signal                = pshmem_long_put_signal
+#pragma weak shmem_longlong_put_signal            = pshmem_longlong_put_signal
+#pragma weak shmem_schar_put_signal               = pshmem_schar_put_signal
+#pragma weak shmem_uchar_put_signal               = pshmem_uchar_put_signal
+#pragma weak shmem_ushort_put_signal              = pshmem_ushort_put_signal
+#pragma weak shmem_uint_put_signal                = pshmem_uint_put_signal
+#pragma weak shmem_ulong_put_signal               = pshmem_ulong_put_signal
+#pragma weak shmem_ulonglong_put_signal           = pshmem_ulonglong_put_signal
+#pragma weak shmem_float_put_signal               = pshmem_float_put_signal
+#pragma weak shmem_double_put_signal              = pshmem_double_put_signal
+#pragma weak shmem_longdouble_put_signal          = pshmem_longdouble_put_signal
+#pragma weak shmem_int8_put_signal                = pshmem_int8_put_signal
+#pragma weak shmem_int16_put_signal               = pshmem_int16_put_signal
+#pragma weak shmem_int32_put_signal               = pshmem_int32_put_signal
+#pragma weak shmem_int64_put_signal               = pshmem_int64_put_signal
+#pragma weak shmem_uint8_put_signal               = pshmem_uint8_put_signal
+#pragma weak shmem_uint16_put_signal              = pshmem_uint16_put_signal
+#pragma weak shmem_uint32_put_signal              = pshmem_uint32_put_signal
+#pragma weak shmem_uint64_put_signal              = pshmem_uint64_put_signal
+#pragma weak shmem_size_put_signal                = pshmem_size_put_signal
+#pragma weak shmem_ptrdiff_put_signal             = pshmem_ptrdiff_put_signal
+
+#pragma weak shmem_ctx_put8_signal = pshmem_ctx_put8_signal
+#pragma weak shmem_ctx_put16_signal = pshmem_ctx_put16_signal
+#pragma weak shmem_ctx_put32_signal = pshmem_ctx_put32_signal
+#pragma weak shmem_ctx_put64_signal = pshmem_ctx_put64_signal
+#pragma weak shmem_ctx_put128_signal = pshmem_ctx_put128_signal
+#pragma weak shmem_ctx_putmem_signal = pshmem_ctx_putmem_signal
+
+#pragma weak shmem_put8_signal = pshmem_put8_signal
+#pragma weak shmem_put16_signal = pshmem_put16_signal
+#pragma weak shmem_put32_signal = pshmem_put32_signal
+#pragma weak shmem_put64_signal = pshmem_put64_signal
+#pragma weak shmem_put128_signal = pshmem_put128_signal
+#pragma weak shmem_putmem_signal = pshmem_putmem_signal
+
+#pragma weak shmem_ctx_char_put_signal_nbi        = pshmem_ctx_char_put_signal_nbi
+#pragma weak shmem_ctx_short_put_signal_nbi       = pshmem_ctx_short_put_signal_nbi
+#pragma weak shmem_ctx_int_put_signal_nbi         = pshmem_ctx_int_put_signal_nbi
+#pragma weak shmem_ctx_long_put_signal_nbi        = pshmem_ctx_long_put_signal_nbi
+#pragma weak shmem_ctx_longlong_put_signal_nbi    = pshmem_ctx_longlong_put_signal_nbi
+#pragma weak shmem_ctx_schar_put_signal_nbi       = pshmem_ctx_schar_put_signal_nbi
+#pragma weak shmem_ctx_uchar_put_signal_nbi       = pshmem_ctx_uchar_put_signal_nbi
+#pragma weak shmem_ctx_ushort_put_signal_nbi      = pshmem_ctx_ushort_put_signal_nbi
+#pragma weak shmem_ctx_uint_put_signal_nbi        = pshmem_ctx_uint_put_signal_nbi
+#pragma weak shmem_ctx_ulong_put_signal_nbi       = pshmem_ctx_ulong_put_signal_nbi
+#pragma weak shmem_ctx_ulonglong_put_signal_nbi   = pshmem_ctx_ulonglong_put_signal_nbi
+#pragma weak shmem_ctx_float_put_signal_nbi       = pshmem_ctx_float_put_signal_nbi
+#pragma weak shmem_ctx_double_put_signal_nbi      = pshmem_ctx_double_put_signal_nbi
+#pragma weak shmem_ctx_longdouble_put_signal_nbi  = pshmem_ctx_longdouble_put_signal_nbi
+#pragma weak shmem_ctx_int8_put_signal_nbi        = pshmem_ctx_int8_put_signal_nbi
+#pragma weak shmem_ctx_int16_put_signal_nbi       = pshmem_ctx_int16_put_signal_nbi
+#pragma weak shmem_ctx_int32_put_signal_nbi       = pshmem_ctx_int32_put_signal_nbi
+#pragma weak shmem_ctx_int64_put_signal_nbi       = pshmem_ctx_int64_put_signal_nbi
+#pragma weak shmem_ctx_uint8_put_signal_nbi       = pshmem_ctx_uint8_put_signal_nbi
+#pragma weak shmem_ctx_uint16_put_signal_nbi      = pshmem_ctx_uint16_put_signal_nbi
+#pragma weak shmem_ctx_uint32_put_signal_nbi      = pshmem_ctx_uint32_put_signal_nbi
+#pragma weak shmem_ctx_uint64_put_signal_nbi      = pshmem_ctx_uint64_put_signal_nbi
+#pragma weak shmem_ctx_size_put_signal_nbi        = pshmem_ctx_size_put_signal_nbi
+#pragma weak shmem_ctx_ptrdiff_put_signal_nbi     = pshmem_ctx_ptrdiff_put_signal_nbi
+
+#pragma weak shmem_char_put_signal_nbi            = pshmem_char_put_signal_nbi
+#pragma weak shmem_short_put_signal_nbi           = pshmem_short_put_signal_nbi
+#pragma weak shmem_int_put_signal_nbi             = pshmem_int_put_signal_nbi
+#pragma weak shmem_long_put_signal_nbi            = pshmem_long_put_signal_nbi
+#pragma weak shmem_longlong_put_signal_nbi        = pshmem_longlong_put_signal_nbi
+#pragma weak shmem_schar_put_signal_nbi           = pshmem_schar_put_signal_nbi
+#pragma weak shmem_uchar_put_signal_nbi           = pshmem_uchar_put_signal_nbi
+#pragma weak shmem_ushort_put_signal_nbi          = pshmem_ushort_put_signal_nbi
+#pragma weak shmem_uint_put_signal_nbi            = pshmem_uint_put_signal_nbi
+#pragma weak shmem_ulong_put_signal_nbi           = pshmem_ulong_put_signal_nbi
+#pragma weak shmem_ulonglong_put_signal_nbi       = pshmem_ulonglong_put_signal_nbi
+#pragma weak shmem_float_put_signal_nbi           = pshmem_float_put_signal_nbi
+#pragma weak shmem_double_put_signal_nbi          = pshmem_double_put_signal_nbi
+#pragma weak shmem_longdouble_put_signal_nbi      = pshmem_longdouble_put_signal_nbi
+#pragma weak shmem_int8_put_signal_nbi            = pshmem_int8_put_signal_nbi
+#pragma weak shmem_int16_put_signal_nbi           = pshmem_int16_put_signal_nbi
+#pragma weak shmem_int32_put_signal_nbi           = pshmem_int32_put_signal_nbi
+#pragma weak shmem_int64_put_signal_nbi           = pshmem_int64_put_signal_nbi
+#pragma weak shmem_uint8_put_signal_nbi           = pshmem_uint8_put_signal_nbi
+#pragma weak shmem_uint16_put_signal_nbi          = pshmem_uint16_put_signal_nbi
+#pragma weak shmem_uint32_put_signal_nbi          = pshmem_uint32_put_signal_nbi
+#pragma weak shmem_uint64_put_signal_nbi          = pshmem_uint64_put_signal_nbi
+#pragma weak shmem_size_put_signal_nbi            = pshmem_size_put_signal_nbi
+#pragma weak shmem_ptrdiff_put_signal_nbi         = pshmem_ptrdiff_put_signal_nbi
+
+#pragma weak shmem_ctx_put8_signal_nbi = pshmem_ctx_put8_signal_nbi
+#pragma weak shmem_ctx_put16_signal_nbi = pshmem_ctx_put16_signal_nbi
+#pragma weak shmem_ctx_put32_signal_nbi = pshmem_ctx_put32_signal_nbi
+#pragma weak shmem_ctx_put64_signal_nbi = pshmem_ctx_put64_signal_nbi
+#pragma weak shmem_ctx_put128_signal_nbi = pshmem_ctx_put128_signal_nbi
+#pragma weak shmem_ctx_putmem_signal_nbi = pshmem_ctx_putmem_signal_nbi
+
+#pragma weak shmem_put8_signal_nbi = pshmem_put8_signal_nbi
+#pragma weak shmem_put16_signal_nbi = pshmem_put16_signal_nbi
+#pragma weak shmem_put32_signal_nbi = pshmem_put32_signal_nbi
+#pragma weak shmem_put64_signal_nbi = pshmem_put64_signal_nbi
+#pragma weak shmem_put128_signal_nbi = pshmem_put128_signal_nbi
+#pragma weak shmem_putmem_signal_nbi = pshmem_putmem_signal_nbi
+
+#pragma weak shmem_signal_fetch = pshmem_signal_fetch
+#pragma weak shmem_signal_wait_until = pshmem_signal_wait_until
+#include "oshmem/shmem/c/profile/defines.h"
+#endif
+
+SHMEM_CTX_TYPE_PUT_SIGNAL(_char, char, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_short, short, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_int, int, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_long, long, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_longlong, long long, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_schar, signed char, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_uchar, unsigned char, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_ushort, unsigned short, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_uint, unsigned int, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_ulong, unsigned long, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_ulonglong, unsigned long long, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_float, float, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_double, double, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_longdouble, long double, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_int8, int8_t, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_int16, int16_t, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_int32, int32_t, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_int64, int64_t, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_uint8, uint8_t, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_uint16, uint16_t, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_uint32, uint32_t, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_uint64, uint64_t, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_size, size_t, , put_signal)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_ptrdiff, ptrdiff_t, , put_signal)
+
+SHMEM_TYPE_PUT_SIGNAL(_char, char, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_short, short, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_int, int, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_long, long, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_longlong, long long, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_schar, signed char, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_uchar, unsigned char, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_ushort, unsigned short, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_uint, unsigned int, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_ulong, unsigned long, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_ulonglong, unsigned long long, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_float, float, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_double, double, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_longdouble, long double, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_int8, int8_t, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_int16, int16_t, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_int32, int32_t, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_int64, int64_t, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_uint8, uint8_t, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_uint16, uint16_t, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_uint32, uint32_t, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_uint64, uint64_t, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_size, size_t, , put_signal)
+SHMEM_TYPE_PUT_SIGNAL(_ptrdiff, ptrdiff_t, , put_signal)
+
+SHMEM_CTX_PUTMEM_SIGNAL(_put8, 1, , put_signal)
+SHMEM_CTX_PUTMEM_SIGNAL(_put16, 2, , put_signal)
+SHMEM_CTX_PUTMEM_SIGNAL(_put32, 4, , put_signal)
+SHMEM_CTX_PUTMEM_SIGNAL(_put64, 8, , put_signal)
+SHMEM_CTX_PUTMEM_SIGNAL(_put128, 16, , put_signal)
+SHMEM_CTX_PUTMEM_SIGNAL(_putmem, 1, , put_signal)
+
+SHMEM_PUTMEM_SIGNAL(_put8, 1, , put_signal)
+SHMEM_PUTMEM_SIGNAL(_put16, 2, , put_signal)
+SHMEM_PUTMEM_SIGNAL(_put32, 4, , put_signal)
+SHMEM_PUTMEM_SIGNAL(_put64, 8, , put_signal)
+SHMEM_PUTMEM_SIGNAL(_put128, 16, , put_signal)
+SHMEM_PUTMEM_SIGNAL(_putmem, 1, , put_signal)
+
+SHMEM_CTX_TYPE_PUT_SIGNAL(_char, char, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_short, short, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_int, int, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_long, long, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_longlong, long long, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_schar, signed char, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_uchar, unsigned char, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_ushort, unsigned short, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_uint, unsigned int, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_ulong, unsigned long, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_ulonglong, unsigned long long, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_float, float, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_double, double, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_longdouble, long double, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_int8, int8_t, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_int16, int16_t, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_int32, int32_t, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_int64, int64_t, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_uint8, uint8_t, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_uint16, uint16_t, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_uint32, uint32_t, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_uint64, uint64_t, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_size, size_t, _nbi, put_signal_nb)
+SHMEM_CTX_TYPE_PUT_SIGNAL(_ptrdiff, ptrdiff_t, _nbi, put_signal_nb)
+
+SHMEM_TYPE_PUT_SIGNAL(_char, char, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_short, short, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_int, int, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_long, long, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_longlong, long long, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_schar, signed char, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_uchar, unsigned char, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_ushort, unsigned short, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_uint, unsigned int, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_ulong, unsigned long, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_ulonglong, unsigned long long, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_float, float, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_double, double, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_longdouble, long double, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_int8, int8_t, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_int16, int16_t, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_int32, int32_t, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_int64, int64_t, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_uint8, uint8_t, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_uint16, uint16_t, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_uint32, uint32_t, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_uint64, uint64_t, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_size, size_t, _nbi, put_signal_nb)
+SHMEM_TYPE_PUT_SIGNAL(_ptrdiff, ptrdiff_t, _nbi, put_signal_nb)
+
+SHMEM_CTX_PUTMEM_SIGNAL(_put8, 1, _nbi, put_signal_nb)
+SHMEM_CTX_PUTMEM_SIGNAL(_put16, 2, _nbi, put_signal_nb)
+SHMEM_CTX_PUTMEM_SIGNAL(_put32, 4, _nbi, put_signal_nb)
+SHMEM_CTX_PUTMEM_SIGNAL(_put64, 8, _nbi, put_signal_nb)
+SHMEM_CTX_PUTMEM_SIGNAL(_put128, 16, _nbi, put_signal_nb)
+SHMEM_CTX_PUTMEM_SIGNAL(_putmem, 1, _nbi, put_signal_nb)
+
+SHMEM_PUTMEM_SIGNAL(_put8, 1, _nbi, put_signal_nb)
+SHMEM_PUTMEM_SIGNAL(_put16, 2, _nbi, put_signal_nb)
+SHMEM_PUTMEM_SIGNAL(_put32, 4, _nbi, put_signal_nb)
+SHMEM_PUTMEM_SIGNAL(_put64, 8, _nbi, put_signal_nb)
+SHMEM_PUTMEM_SIGNAL(_put128, 16, _nbi, put_signal_nb)
+SHMEM_PUTMEM_SIGNAL(_putmem, 1, _nbi, put_signal_nb)
+
+uint64_t shmem_signal_fetch(const uint64_t *sig_addr)
+{
+    int rc;
+    uint64_t value = 0;
+
+    RUNTIME_CHECK_INIT();
+    RUNTIME_CHECK_ADDR(sig_addr);
+
+    /* Atomic with respect to the signal updates of the other PEs */
+    rc = MCA_ATOMIC_CALL(fadd(oshmem_ctx_default, (void *)sig_addr, &value, 0,
+                              sizeof(value), oshmem_my_proc_id()));
+    RUNTIME_CHECK_RC(rc);
+
+    return value;
+}
+
+uint64_t shmem_signal_wait_until(uint64_t *sig_addr, int cmp, uint64_t cmp_value)
+{
+    int rc;
+
+    RUNTIME_CHECK_INIT();
+    RUNTIME_CHECK_ADDR(sig_addr);
+
+    rc = MCA_SPML_CALL(wait((void *)sig_addr, cmp, (void *)&cmp_value, SHMEM_INT64_T));
+    RUNTIME_CHECK_RC(rc);
+
+    return shmem_signal_fetch(sig_addr);
+}
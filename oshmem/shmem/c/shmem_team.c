@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026      Mellanox Technologies, Inc.
+ *                         All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "oshmem_config.h"
+
+#include <stdlib.h>
+
+#include "oshmem/constants.h"
+#include "oshmem/include/shmem.h"
+#include "oshmem/runtime/runtime.h"
+
+#include "oshmem/shmem/shmem_api_logger.h"
+#include "oshmem/shmem/shmem_team.h"
+#include "oshmem/mca/memheap/memheap.h"
+#include "oshmem/mca/memheap/base/base.h"
+#include "oshmem/mca/scoll/scoll.h"
+#include "oshmem/op/op.h"
+
+shmem_team_t oshmem_team_world = SHMEM_TEAM_INVALID;
+shmem_team_t oshmem_team_shared = SHMEM_TEAM_INVALID;
+
+static oshmem_team_psync_t *team_psync_pool = NULL;
+
+/* The slots this PE is not a member of a team on */
+static uint64_t team_free_slots = 0;
+
+static void team_psync_reset(oshmem_team_psync_t *psync)
+{
+    int i;
+
+    for (i = 0; i < SHMEM_BARRIER_SYNC_SIZE; i++) {
+        psync->barrier[i] = _SHMEM_SYNC_VALUE;
+    }
+    for (i = 0; i < SHMEM_REDUCE_SYNC_SIZE; i++) {
+        psync->reduce[i] = _SHMEM_SYNC_VALUE;
+    }
+}
+
+static oshmem_team_t *team_create(int start, int stride, int size, int slot,
+                                  const shmem_team_config_t *config,
+                                  long config_mask)
+{
+    oshmem_team_t *team;
+
+    team = (oshmem_team_t *)calloc(1, sizeof(*team));
+    if (NULL == team) {
+        return NULL;
+    }
+
+    team->start  = start;
+    team->stride = (1 == size) ? 1 : stride;
+    team->size   = size;
+    team->my_pe  = oshmem_team_pe(team, oshmem_my_proc_id());
+    team->slot   = slot;
+    team->psync  = &team_psync_pool[slot];
+    if ((NULL != config) && (config_mask & SHMEM_TEAM_NUM_CONTEXTS)) {
+        team->config      = *config;
+        team->config_mask = SHMEM_TEAM_NUM_CONTEXTS;
+    }
+
+    if (OSHMEM_TEAM_WORLD_SLOT == slot) {
+        team->group = oshmem_group_all;
+    } else {
+        team->group = oshmem_proc_group_create(start, team->stride, size);
+        if (NULL == team->group) {
+            free(team);
+            return NULL;
+        }
+    }
+
+    team_free_slots &= ~(UINT64_C(1) << slot);
+    return team;
+}
+
+/* The node-local PEs, if they are strided */
+static void team_shared_layout(int *start, int *stride, int *size)
+{
+    int my_pe = oshmem_my_proc_id();
+    int n_pes = oshmem_num_procs();
+    int last  = -1;
+    int pe;
+
+    *start  = -1;
+    *stride = 1;
+    *size   = 0;
+    for (pe = 0; pe < n_pes; pe++) {
+        if ((pe != my_pe) &&
+            !OPAL_PROC_ON_LOCAL_NODE(oshmem_proc_group_all(pe)->super.proc_flags)) {
+            continue;
+        }
+        if (0 == *size) {
+            *start = pe;
+        } else if (1 == *size) {
+            *stride = pe - last;
+        } else if (pe - last != *stride) {
+            *start  = my_pe;
+            *stride = 1;
+            *size   = 1;
+            return;
+        }
+        last = pe;
+        (*size)++;
+    }
+}
+
+int shmem_team_init(void)
+{
+    void *ptr = NULL;
+    oshmem_team_t *team;
+    int start, stride, size;
+    int i;
+
+    MCA_MEMHEAP_CALL(private_alloc(OSHMEM_TEAM_MAX * sizeof(*team_psync_pool), &ptr));
+    if (NULL == ptr) {
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+    team_psync_pool = (oshmem_team_psync_t *)ptr;
+    for (i = 0; i < OSHMEM_TEAM_MAX; i++) {
+        team_psync_reset(&team_psync_pool[i]);
+    }
+    team_free_slots = ~UINT64_C(0);
+
+    team = team_create(0, 1, oshmem_num_procs(), OSHMEM_TEAM_WORLD_SLOT, NULL, 0);
+    if (NULL == team) {
+        return OSHMEM_ERROR;
+    }
+    oshmem_team_world = (shmem_team_t)team;
+
+    /* The shared teams of the nodes are disjoint, they can all use the
+     * same slot */
+    team_shared_layout(&start, &stride, &size);
+    team = team_create(start, stride, size, OSHMEM_TEAM_SHARED_SLOT, NULL, 0);
+    if (NULL == team) {
+        return OSHMEM_ERROR;
+    }
+    oshmem_team_shared = (shmem_team_t)team;
+
+    return OSHMEM_SUCCESS;
+}
+
+static void team_release(oshmem_team_t *team)
+{
+    if (team->group != oshmem_group_all) {
+        oshmem_proc_group_destroy(team->group);
+    }
+    team_free_slots |= UINT64_C(1) << team->slot;
+    free(team);
+}
+
+int shmem_team_finalize(void)
+{
+    if (SHMEM_TEAM_INVALID != oshmem_team_shared) {
+        team_release((oshmem_team_t *)oshmem_team_shared);
+        oshmem_team_shared = SHMEM_TEAM_INVALID;
+    }
+    if (SHMEM_TEAM_INVALID != oshmem_team_world) {
+        team_release((oshmem_team_t *)oshmem_team_world);
+        oshmem_team_world = SHMEM_TEAM_INVALID;
+    }
+    if (NULL != team_psync_pool) {
+        MCA_MEMHEAP_CALL(private_free(team_psync_pool));
+        team_psync_pool = NULL;
+    }
+
+    return OSHMEM_SUCCESS;
+}
+
+int oshmem_team_split(oshmem_team_t *parent, int start, int stride, int size,
+                      const shmem_team_config_t *config, long config_mask,
+                      oshmem_team_t **new_team)
+{
+    oshmem_team_psync_t *psync = parent->psync;
+    oshmem_group_t *group = parent->group;
+    oshmem_team_t *team = NULL;
+    int slot;
+    int rc;
+
+    *new_team = NULL;
+
+    /* Agree on a slot free on all the PEs of the parent */
+    psync->free_src = (int64_t)team_free_slots;
+    rc = group->g_scoll.scoll_reduce(group, oshmem_op_and_int64,
+                                     &psync->free_dst, &psync->free_src,
+                                     sizeof(psync->free_src), psync->reduce,
+                                     psync->wrk, SCOLL_DEFAULT_ALG);
+    if (OSHMEM_SUCCESS != rc) {
+        return rc;
+    }
+    for (slot = 0; slot < OSHMEM_TEAM_MAX; slot++) {
+        if ((uint64_t)psync->free_dst & (UINT64_C(1) << slot)) {
+            break;
+        }
+    }
+
+    /* The reduction scratch of the parent is reused by the next split */
+    rc = group->g_scoll.scoll_barrier(group, psync->barrier, SCOLL_DEFAULT_ALG);
+    if (OSHMEM_SUCCESS != rc) {
+        return rc;
+    }
+
+    if (0 >= size) {
+        return OSHMEM_SUCCESS;
+    }
+    if (OSHMEM_TEAM_MAX == slot) {
+        SHMEM_API_ERROR("no more than %d teams can share a PE", OSHMEM_TEAM_MAX);
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+
+    team = team_create(oshmem_team_world_pe(parent, start), parent->stride * stride,
+                       size, slot, config, config_mask);
+    if (NULL == team) {
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+
+    *new_team = team;
+    return OSHMEM_SUCCESS;
+}
+
+void oshmem_team_destroy(oshmem_team_t *team)
+{
+    /* Nobody may still be using the work arrays of the slot when it is
+     * handed to another team */
+    team->group->g_scoll.scoll_barrier(team->group, team->psync->barrier,
+                                       SCOLL_DEFAULT_ALG);
+    team_release(team);
+}
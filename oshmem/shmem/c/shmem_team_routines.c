@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026      Mellanox Technologies, Inc.
+ *                         All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+#include "oshmem_config.h"
+
+#include "oshmem/constants.h"
+#include "oshmem/include/shmem.h"
+
+#include "oshmem/runtime/runtime.h"
+
+#include "opal/util/minmax.h"
+
+#include "oshmem/shmem/shmem_team.h"
+
+#if OSHMEM_PROFILING
+#include "oshmem/include/pshmem.h"
+#pragma weak shmem_team_my_pe = pshmem_team_my_pe
+#pragma weak shmem_team_n_pes = pshmem_team_n_pes
+#pragma weak shmem_team_get_config = pshmem_team_get_config
+#pragma weak shmem_team_translate_pe = pshmem_team_translate_pe
+#pragma weak shmem_team_split_strided = pshmem_team_split_strided
+#pragma weak shmem_team_split_2d = pshmem_team_split_2d
+#pragma weak shmem_team_destroy = pshmem_team_destroy
+#pragma weak shmem_team_sync = pshmem_team_sync
+#include "oshmem/shmem/c/profile/defines.h"
+#endif
+
+int shmem_team_my_pe(shmem_team_t team)
+{
+    if (SHMEM_TEAM_INVALID == team) {
+        return -1;
+    }
+    return ((oshmem_team_t *)team)->my_pe;
+}
+
+int shmem_team_n_pes(shmem_team_t team)
+{
+    if (SHMEM_TEAM_INVALID == team) {
+        return -1;
+    }
+    return ((oshmem_team_t *)team)->size;
+}
+
+int shmem_team_get_config(shmem_team_t team, long config_mask,
+                          shmem_team_config_t *config)
+{
+    oshmem_team_t *oteam = (oshmem_team_t *)team;
+
+    if (SHMEM_TEAM_INVALID == team) {
+        return -1;
+    }
+    if (config_mask & SHMEM_TEAM_NUM_CONTEXTS) {
+        config->num_contexts = (oteam->config_mask & SHMEM_TEAM_NUM_CONTEXTS) ?
+                               oteam->config.num_contexts : 0;
+    }
+    return 0;
+}
+
+int shmem_team_translate_pe(shmem_team_t src_team, int src_pe,
+                            shmem_team_t dest_team)
+{
+    oshmem_team_t *src = (oshmem_team_t *)src_team;
+
+    if ((SHMEM_TEAM_INVALID == src_team) || (SHMEM_TEAM_INVALID == dest_team) ||
+        (0 > src_pe) || (src_pe >= src->size)) {
+        return -1;
+    }
+    return oshmem_team_pe((oshmem_team_t *)dest_team,
+                          oshmem_team_world_pe(src, src_pe));
+}
+
+int shmem_team_split_strided(shmem_team_t parent_team, int start, int stride,
+                             int size, const shmem_team_config_t *config,
+                             long config_mask, shmem_team_t *new_team)
+{
+    oshmem_team_t *parent = (oshmem_team_t *)parent_team;
+    oshmem_team_t *team;
+    int my_pe;
+    int rc;
+
+    RUNTIME_CHECK_INIT();
+
+    *new_team = SHMEM_TEAM_INVALID;
+    if (SHMEM_TEAM_INVALID == parent_team) {
+        return -1;
+    }
+    if ((0 > start) || (0 >= size) || ((1 < size) && (0 >= stride)) ||
+        (start + (size - 1) * ((1 < size) ? stride : 0) >= parent->size)) {
+        return -1;
+    }
+
+    /* The PEs out of the new team still take part in the slot agreement */
+    my_pe = parent->my_pe - start;
+    if ((0 > my_pe) || ((1 < size) && (0 != (my_pe % stride))) ||
+        (((1 < size) ? my_pe / stride : my_pe) >= size)) {
+        size = 0;
+    }
+
+    rc = oshmem_team_split(parent, start, stride, size, config, config_mask, &team);
+    if (OSHMEM_SUCCESS != rc) {
+        return -1;
+    }
+    *new_team = (shmem_team_t)team;
+    return 0;
+}
+
+int shmem_team_split_2d(shmem_team_t parent_team, int xrange,
+                        const shmem_team_config_t *xaxis_config, long xaxis_mask,
+                        shmem_team_t *xaxis_team,
+                        const shmem_team_config_t *yaxis_config, long yaxis_mask,
+                        shmem_team_t *yaxis_team)
+{
+    oshmem_team_t *parent = (oshmem_team_t *)parent_team;
+    oshmem_team_t *team;
+    int x, y;
+    int rc;
+
+    RUNTIME_CHECK_INIT();
+
+    *xaxis_team = SHMEM_TEAM_INVALID;
+    *yaxis_team = SHMEM_TEAM_INVALID;
+    if ((SHMEM_TEAM_INVALID == parent_team) || (0 >= xrange)) {
+        return -1;
+    }
+    if (xrange > parent->size) {
+        xrange = parent->size;
+    }
+
+    /* Every PE asks for its own row and column, they do not overlap */
+    x = parent->my_pe % xrange;
+    y = parent->my_pe / xrange;
+
+    rc = oshmem_team_split(parent, y * xrange, 1,
+                           opal_min(xrange, parent->size - y * xrange),
+                           xaxis_config, xaxis_mask, &team);
+    if (OSHMEM_SUCCESS != rc) {
+        return -1;
+    }
+    *xaxis_team = (shmem_team_t)team;
+
+    rc = oshmem_team_split(parent, x, xrange,
+                           (parent->size - x + xrange - 1) / xrange,
+                           yaxis_config, yaxis_mask, &team);
+    if (OSHMEM_SUCCESS != rc) {
+        return -1;
+    }
+    *yaxis_team = (shmem_team_t)team;
+    return 0;
+}
+
+void shmem_team_destroy(shmem_team_t team)
+{
+    RUNTIME_CHECK_INIT();
+
+    if ((SHMEM_TEAM_INVALID == team) || (SHMEM_TEAM_WORLD == team) ||
+        (SHMEM_TEAM_SHARED == team)) {
+        return;
+    }
+    oshmem_team_destroy((oshmem_team_t *)team);
+}
+
+int shmem_team_sync(shmem_team_t team)
+{
+    oshmem_team_t *oteam = (oshmem_team_t *)team;
+    int rc;
+
+    RUNTIME_CHECK_INIT();
+
+    if (SHMEM_TEAM_INVALID == team) {
+        return -1;
+    }
+    rc = oteam->group->g_scoll.scoll_barrier(oteam->group, oteam->psync->barrier,
+                                             SCOLL_DEFAULT_ALG);
+    return (OSHMEM_SUCCESS == rc) ? 0 : -1;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026      Mellanox Technologies, Inc.
+ *                         All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * OpenSHMEM teams. Every team is a strided set of world PEs: the teams are
+ * split with a stride from a strided parent, and SHMEM_TEAM_SHARED falls
+ * back to the calling PE alone if the PEs of the node are not strided. So
+ * the translation of the PE numbers is arithmetic and the teams need no
+ * proc tables of their own, the collectives of a team run on the cached
+ * oshmem group of its PEs.
+ *
+ * Each team owns a slot of a symmetric pool of work arrays, with the pSync
+ * of its barrier and the scratch of the slot agreement of the splits done
+ * from it. A slot is free on all the PEs of the parent when a team is split,
+ * so the collectives of the teams sharing PEs never step on each other.
+ */
+#ifndef SHMEM_TEAM_H
+#define SHMEM_TEAM_H
+
+#include "oshmem_config.h"
+
+#include "oshmem/include/shmem.h"
+#include "oshmem/proc/proc.h"
+
+/* The free slots are tracked in one 64-bit word */
+#define OSHMEM_TEAM_MAX         64
+
+#define OSHMEM_TEAM_WORLD_SLOT  0
+#define OSHMEM_TEAM_SHARED_SLOT 1
+
+typedef struct oshmem_team_psync {
+    long barrier[SHMEM_BARRIER_SYNC_SIZE];
+    long reduce[SHMEM_REDUCE_SYNC_SIZE];
+    int64_t wrk[SHMEM_REDUCE_MIN_WRKDATA_SIZE];
+    int64_t free_src;
+    int64_t free_dst;
+} oshmem_team_psync_t;
+
+typedef struct oshmem_team {
+    int start;                  /* world PE of team PE 0 */
+    int stride;                 /* in world PEs, 1 for a team of one PE */
+    int size;
+    int my_pe;
+    shmem_team_config_t config;
+    long config_mask;
+    int slot;
+    oshmem_team_psync_t *psync;
+    oshmem_group_t *group;
+} oshmem_team_t;
+
+int shmem_team_init(void);
+int shmem_team_finalize(void);
+
+/**
+ * Collective over the parent team: every PE of the parent calls it with the
+ * team it belongs to, PEs in parent numbering. The teams requested in one
+ * call must not overlap. new_team is SHMEM_TEAM_INVALID on the PEs whose
+ * size is 0.
+ */
+int oshmem_team_split(oshmem_team_t *parent, int start, int stride, int size,
+                      const shmem_team_config_t *config, long config_mask,
+                      oshmem_team_t **new_team);
+
+void oshmem_team_destroy(oshmem_team_t *team);
+
+static inline int oshmem_team_world_pe(const oshmem_team_t *team, int pe)
+{
+    return team->start + pe * team->stride;
+}
+
+/* The team PE of a world PE, or -1 if it is not in the team */
+static inline int oshmem_team_pe(const oshmem_team_t *team, int world_pe)
+{
+    int offset = world_pe - team->start;
+
+    if ((offset < 0) || (0 != (offset % team->stride)) ||
+        (offset / team->stride >= team->size)) {
+        return -1;
+    }
+    return offset / team->stride;
+}
+
+#endif /*SHMEM_TEAM_H*/
@@ -0,0 +1,507 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Latency, message rate and registration costs of a single BTL module,
+ * below the pml. MPI is only used to set up the runtime, the modex and the
+ * bml endpoints (this requires --mca pml ob1) and to exchange the
+ * registration handles, the measured operations go straight to the module:
+ *
+ *   mpirun -n 2 --mca pml ob1 ./btl_bench -b sm
+ *
+ * Ranks 0 and 1 run the benchmark, the others (if any) only wait. The
+ * results are printed by rank 0 as CSV:
+ *
+ *   btl,test,threads,bytes,usec,msg_per_sec
+ *
+ * with the tests
+ *   sendi, send     half round trip of a ping-pong on MCA_BTL_TAG_USR
+ *   rate_sendi,     messages per second of a window of messages, sent by
+ *   rate_send       1 to -t threads
+ *   put, get        completion time of one operation
+ *   fop_add         completion time of a 64-bit fetch-and-add
+ *   register,       cost of btl_register_mem and btl_deregister_mem on a
+ *   deregister      new buffer (the bytes column is the buffer size)
+ *
+ * The tests not supported by the module are skipped.
+ */
+
+#include "ompi_config.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "mpi.h"
+
+#include "opal/mca/btl/btl.h"
+#include "opal/runtime/opal_progress.h"
+#include "opal/sys/atomic.h"
+
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/bml/base/base.h"
+#include "ompi/mca/bml/bml.h"
+#include "ompi/proc/proc.h"
+
+#define BENCH_TAG MCA_BTL_TAG_USR
+
+static mca_btl_base_module_t *btl;
+static struct mca_btl_base_endpoint_t *endpoint;
+static MPI_Comm bench_comm; /**< ranks 0 and 1 */
+static int rank;
+
+static opal_atomic_int32_t received;
+static opal_atomic_int32_t completed;
+
+static int iterations = 1000;
+static int window = 256;
+static int max_threads = 1;
+static size_t max_size = 1 << 22;
+
+static void bench_recv_cb(mca_btl_base_module_t *module,
+                          const mca_btl_base_receive_descriptor_t *descriptor)
+{
+    (void) module;
+    (void) descriptor;
+    opal_atomic_add_fetch_32(&received, 1);
+}
+
+static void bench_rdma_cb(mca_btl_base_module_t *module, struct mca_btl_base_endpoint_t *ep,
+                          void *local_address, mca_btl_base_registration_handle_t *local_handle,
+                          void *context, void *cbdata, int status)
+{
+    (void) module;
+    (void) ep;
+    (void) local_address;
+    (void) local_handle;
+    (void) context;
+    (void) cbdata;
+    if (OPAL_SUCCESS != status) {
+        fprintf(stderr, "btl_bench: rdma operation failed with %d\n", status);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    opal_atomic_add_fetch_32(&completed, 1);
+}
+
+static void bench_wait(opal_atomic_int32_t *counter, int32_t value)
+{
+    while (*counter < value) {
+        opal_progress();
+    }
+}
+
+static void bench_send(void *buffer, size_t size, bool immediate)
+{
+    const uint32_t flags = MCA_BTL_DES_FLAGS_PRIORITY | MCA_BTL_DES_FLAGS_BTL_OWNERSHIP;
+    mca_btl_base_descriptor_t *des;
+    int rc;
+
+    if (immediate) {
+        while (OPAL_SUCCESS
+               != btl->btl_sendi(btl, endpoint, NULL, buffer, size, 0, MCA_BTL_NO_ORDER, flags,
+                                 BENCH_TAG, NULL)) {
+            opal_progress();
+        }
+        return;
+    }
+
+    while (NULL == (des = btl->btl_alloc(btl, endpoint, MCA_BTL_NO_ORDER, size, flags))) {
+        opal_progress();
+    }
+    memcpy(des->des_segments[0].seg_addr.pval, buffer, size);
+    des->des_segments[0].seg_len = size;
+    rc = btl->btl_send(btl, endpoint, des, BENCH_TAG);
+    if ((rc < 0) && (OPAL_ERR_RESOURCE_BUSY != rc)) {
+        fprintf(stderr, "btl_bench: btl_send failed with %d\n", rc);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+}
+
+static void bench_report(const char *test, int threads, size_t bytes, double usec, double rate)
+{
+    printf("%s,%s,%d,%zu,%.3f,%.0f\n", btl->btl_component->btl_version.mca_component_name, test,
+           threads, bytes, usec, rate);
+    fflush(stdout);
+}
+
+static void bench_pingpong(const char *test, bool immediate, char *buffer, size_t limit)
+{
+    for (size_t size = 1; size <= limit; size <<= 1) {
+        double start = 0.0;
+
+        MPI_Barrier(bench_comm);
+        received = 0;
+        MPI_Barrier(bench_comm);
+        for (int i = 0; i < iterations + 1; i++) {
+            if (1 == i) {
+                start = MPI_Wtime(); /* the first round trip is warmup */
+            }
+            if (0 == rank) {
+                bench_send(buffer, size, immediate);
+                bench_wait(&received, i + 1);
+            } else {
+                bench_wait(&received, i + 1);
+                bench_send(buffer, size, immediate);
+            }
+        }
+        if (0 == rank) {
+            bench_report(test, 1, size, (MPI_Wtime() - start) * 1e6 / (2.0 * iterations), 0.0);
+        }
+    }
+}
+
+typedef struct {
+    char *buffer;
+    size_t size;
+    bool immediate;
+    int count;
+} bench_rate_arg_t;
+
+static void *bench_rate_thread(void *arg)
+{
+    bench_rate_arg_t *rate = (bench_rate_arg_t *) arg;
+
+    for (int i = 0; i < rate->count; i++) {
+        bench_send(rate->buffer, rate->size, rate->immediate);
+    }
+    return NULL;
+}
+
+static void bench_rate(const char *test, bool immediate, char *buffer, size_t limit)
+{
+    pthread_t threads[max_threads];
+    bench_rate_arg_t arg;
+
+    for (int nthreads = 1; nthreads <= max_threads; nthreads <<= 1) {
+        for (size_t size = 1; size <= limit; size <<= 1) {
+            const int per_thread = window / nthreads;
+            double start = 0.0, elapsed;
+            int32_t expected = 0;
+
+            arg = (bench_rate_arg_t){.buffer = buffer, .size = size, .immediate = immediate,
+                                     .count = per_thread};
+            MPI_Barrier(bench_comm);
+            received = 0;
+            MPI_Barrier(bench_comm);
+            for (int i = 0; i < iterations / 10 + 1; i++) {
+                if (1 == i) {
+                    start = MPI_Wtime();
+                }
+                if (0 == rank) {
+                    for (int t = 0; t < nthreads; t++) {
+                        pthread_create(&threads[t], NULL, bench_rate_thread, &arg);
+                    }
+                    for (int t = 0; t < nthreads; t++) {
+                        pthread_join(threads[t], NULL);
+                    }
+                    bench_wait(&received, i + 1); /* the window is delivered */
+                } else {
+                    expected += per_thread * nthreads;
+                    bench_wait(&received, expected);
+                    bench_send(buffer, 1, immediate);
+                }
+            }
+            if (0 == rank) {
+                const double messages = (double) (iterations / 10) * per_thread * nthreads;
+
+                elapsed = MPI_Wtime() - start;
+                bench_report(test, nthreads, size, elapsed * 1e6 / messages, messages / elapsed);
+            }
+        }
+    }
+}
+
+typedef struct {
+    uint64_t address;
+    char handle[];
+} bench_remote_t;
+
+static void bench_rdma(char *buffer, mca_btl_base_registration_handle_t *local_handle)
+{
+    const size_t handle_size = btl->btl_registration_handle_size;
+    const size_t remote_size = sizeof(bench_remote_t) + handle_size;
+    bench_remote_t *local = calloc(1, remote_size), *remote = calloc(1, remote_size);
+    mca_btl_base_registration_handle_t *remote_handle = NULL;
+    size_t limit;
+    int rc;
+
+    local->address = (uint64_t) (uintptr_t) buffer;
+    if (handle_size) {
+        memcpy(local->handle, local_handle, handle_size);
+        remote_handle = (mca_btl_base_registration_handle_t *) remote->handle;
+    }
+    MPI_Sendrecv(local, remote_size, MPI_BYTE, !rank, 0, remote, remote_size, MPI_BYTE, !rank, 0,
+                 bench_comm, MPI_STATUS_IGNORE);
+
+    for (int op = 0; op < 2; op++) {
+        const bool put = (0 == op);
+
+        if (!(btl->btl_flags & (put ? MCA_BTL_FLAGS_PUT : MCA_BTL_FLAGS_GET))) {
+            continue;
+        }
+        limit = put ? btl->btl_put_limit : btl->btl_get_limit;
+        for (size_t size = 1; (size <= max_size) && (size <= limit); size <<= 1) {
+            double start = 0.0;
+
+            MPI_Barrier(bench_comm);
+            if (0 == rank) {
+                completed = 0;
+                for (int i = 0; i < iterations + 1; i++) {
+                    if (1 == i) {
+                        start = MPI_Wtime();
+                    }
+                    do {
+                        rc = put ? btl->btl_put(btl, endpoint, buffer, remote->address, local_handle,
+                                                remote_handle, size, 0, MCA_BTL_NO_ORDER,
+                                                bench_rdma_cb, NULL, NULL)
+                                 : btl->btl_get(btl, endpoint, buffer, remote->address, local_handle,
+                                                remote_handle, size, 0, MCA_BTL_NO_ORDER,
+                                                bench_rdma_cb, NULL, NULL);
+                        if (OPAL_ERR_OUT_OF_RESOURCE == rc) {
+                            opal_progress();
+                        }
+                    } while (OPAL_ERR_OUT_OF_RESOURCE == rc);
+                    if (1 == rc) {
+                        opal_atomic_add_fetch_32(&completed, 1);
+                    } else if (OPAL_SUCCESS != rc) {
+                        break; /* size or alignment restrictions */
+                    }
+                    bench_wait(&completed, i + 1);
+                }
+                if (OPAL_SUCCESS == rc || 1 == rc) {
+                    bench_report(put ? "put" : "get", 1, size,
+                                 (MPI_Wtime() - start) * 1e6 / iterations, 0.0);
+                }
+            }
+            /* the target progresses too, for the btls emulating rdma */
+            MPI_Barrier(bench_comm);
+        }
+    }
+
+    if ((btl->btl_flags & MCA_BTL_FLAGS_ATOMIC_FOPS)
+        && (btl->btl_atomic_flags & MCA_BTL_ATOMIC_SUPPORTS_ADD)) {
+        double start = 0.0;
+
+        MPI_Barrier(bench_comm);
+        if (0 == rank) {
+            completed = 0;
+            for (int i = 0; i < iterations + 1; i++) {
+                if (1 == i) {
+                    start = MPI_Wtime();
+                }
+                do {
+                    rc = btl->btl_atomic_fop(btl, endpoint, buffer, remote->address, local_handle,
+                                             remote_handle, MCA_BTL_ATOMIC_ADD, 1, 0,
+                                             MCA_BTL_NO_ORDER, bench_rdma_cb, NULL, NULL);
+                    if (OPAL_ERR_OUT_OF_RESOURCE == rc) {
+                        opal_progress();
+                    }
+                } while (OPAL_ERR_OUT_OF_RESOURCE == rc);
+                if (1 == rc) {
+                    opal_atomic_add_fetch_32(&completed, 1);
+                } else if (OPAL_SUCCESS != rc) {
+                    break;
+                }
+                bench_wait(&completed, i + 1);
+            }
+            if (OPAL_SUCCESS == rc || 1 == rc) {
+                bench_report("fop_add", 1, sizeof(uint64_t),
+                             (MPI_Wtime() - start) * 1e6 / iterations, 0.0);
+            }
+        }
+        MPI_Barrier(bench_comm);
+    }
+
+    free(local);
+    free(remote);
+}
+
+static void bench_registration(void)
+{
+    for (size_t size = 4096; size <= max_size; size <<= 1) {
+        const int count = (iterations < 100) ? iterations : 100;
+        double reg = 0.0, dereg = 0.0, start;
+
+        for (int i = 0; i < count; i++) {
+            /* a new buffer each time, the registration cache has nothing for it */
+            char *buffer = malloc(size);
+            mca_btl_base_registration_handle_t *handle;
+
+            memset(buffer, 0, size);
+            start = MPI_Wtime();
+            handle = btl->btl_register_mem(btl, MCA_BTL_ENDPOINT_ANY, buffer, size,
+                                           MCA_BTL_REG_FLAG_ACCESS_ANY);
+            reg += MPI_Wtime() - start;
+            if (NULL == handle) {
+                free(buffer);
+                return;
+            }
+            start = MPI_Wtime();
+            btl->btl_deregister_mem(btl, handle);
+            dereg += MPI_Wtime() - start;
+            free(buffer);
+        }
+        bench_report("register", 1, size, reg * 1e6 / count, 0.0);
+        bench_report("deregister", 1, size, dereg * 1e6 / count, 0.0);
+    }
+}
+
+static mca_btl_base_module_t *bench_find_btl(mca_bml_base_endpoint_t *bml_endpoint,
+                                             const char *name, struct mca_btl_base_endpoint_t **ep)
+{
+    mca_bml_base_btl_array_t *arrays[] = {&bml_endpoint->btl_eager, &bml_endpoint->btl_send,
+                                          &bml_endpoint->btl_rdma};
+
+    for (size_t a = 0; a < sizeof(arrays) / sizeof(arrays[0]); a++) {
+        for (size_t i = 0; i < mca_bml_base_btl_array_get_size(arrays[a]); i++) {
+            mca_bml_base_btl_t *bml_btl = mca_bml_base_btl_array_get_index(arrays[a], i);
+
+            if ((NULL == name)
+                || (0 == strcmp(name, bml_btl->btl->btl_component->btl_version.mca_component_name))) {
+                *ep = bml_btl->btl_endpoint;
+                return bml_btl->btl;
+            }
+        }
+    }
+    return NULL;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s [-b btl] [-s max_bytes] [-i iterations] [-w window] [-t threads]\n"
+            "  -b  btl component to measure (default: the first eager btl to rank 1)\n"
+            "  -s  largest message (default %zu)\n"
+            "  -i  iterations per size (default %d)\n"
+            "  -w  messages per window in the rate tests (default %d)\n"
+            "  -t  largest number of sending threads (default %d)\n",
+            name, max_size, iterations, window, max_threads);
+}
+
+int main(int argc, char *argv[])
+{
+    mca_btl_base_registration_handle_t *handle = NULL;
+    mca_bml_base_endpoint_t *bml_endpoint;
+    const char *name = NULL;
+    int size, provided, found, c;
+    char *buffer;
+
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    while (-1 != (c = getopt(argc, argv, "b:s:i:w:t:h"))) {
+        switch (c) {
+        case 'b':
+            name = optarg;
+            break;
+        case 's':
+            max_size = strtoull(optarg, NULL, 0);
+            break;
+        case 'i':
+            iterations = atoi(optarg);
+            break;
+        case 'w':
+            window = atoi(optarg);
+            break;
+        case 't':
+            max_threads = atoi(optarg);
+            break;
+        default:
+            if (0 == rank) {
+                usage(argv[0]);
+            }
+            MPI_Finalize();
+            return 1;
+        }
+    }
+    if ((size < 2) || (iterations < 10) || (window < 1) || (max_threads < 1)) {
+        if (0 == rank) {
+            usage(argv[0]);
+            fprintf(stderr, "btl_bench needs at least 2 ranks, 10 iterations and 1 thread\n");
+        }
+        MPI_Finalize();
+        return 1;
+    }
+    if (MPI_THREAD_MULTIPLE != provided) {
+        max_threads = 1;
+    }
+    if (window < max_threads) {
+        window = max_threads;
+    }
+
+    found = 0;
+    if (rank < 2) {
+        if (!mca_bml_base_inited()) {
+            if (0 == rank) {
+                fprintf(stderr, "btl_bench: the bml is not used, run with --mca pml ob1\n");
+            }
+        } else {
+            bml_endpoint = mca_bml_base_get_endpoint(ompi_comm_peer_lookup(MPI_COMM_WORLD, !rank));
+            if ((NULL != bml_endpoint)
+                && (NULL != (btl = bench_find_btl(bml_endpoint, name, &endpoint)))) {
+                found = 1;
+            } else if (0 == rank) {
+                fprintf(stderr, "btl_bench: no %s btl to rank 1\n", name ? name : "");
+            }
+        }
+    } else {
+        found = 1;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &found, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    if (!found) {
+        MPI_Finalize();
+        return 1;
+    }
+
+    MPI_Comm_split(MPI_COMM_WORLD, (rank < 2) ? 0 : MPI_UNDEFINED, rank, &bench_comm);
+    if (rank < 2) {
+        mca_bml.bml_register(BENCH_TAG, bench_recv_cb, NULL);
+
+        buffer = malloc(max_size);
+        memset(buffer, 0, max_size);
+        if (NULL != btl->btl_register_mem) {
+            handle = btl->btl_register_mem(btl, endpoint, buffer, max_size,
+                                           MCA_BTL_REG_FLAG_ACCESS_ANY);
+        }
+        if (0 == rank) {
+            printf("btl,test,threads,bytes,usec,msg_per_sec\n");
+        }
+
+        if (NULL != btl->btl_sendi) {
+            bench_pingpong("sendi", true, buffer, btl->btl_eager_limit);
+        }
+        bench_pingpong("send", false, buffer, btl->btl_eager_limit);
+        if (NULL != btl->btl_sendi) {
+            bench_rate("rate_sendi", true, buffer, btl->btl_eager_limit);
+        }
+        bench_rate("rate_send", false, buffer, btl->btl_eager_limit);
+        if ((NULL == btl->btl_register_mem) || (NULL != handle)) {
+            bench_rdma(buffer, handle);
+        }
+        if ((0 == rank) && (NULL != btl->btl_register_mem)) {
+            bench_registration();
+        }
+
+        MPI_Barrier(bench_comm);
+        if (NULL != handle) {
+            btl->btl_deregister_mem(btl, handle);
+        }
+        free(buffer);
+        MPI_Comm_free(&bench_comm);
+    }
+
+    MPI_Finalize();
+    return 0;
+}
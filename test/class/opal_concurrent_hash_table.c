@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal_config.h"
+
+#include "opal/class/opal_concurrent_hash_table.h"
+#include "opal/constants.h"
+#include "opal/mca/threads/threads.h"
+#include "opal/runtime/opal.h"
+#include "support.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEST_KEY_COUNT      10000
+#define TEST_READER_COUNT   4
+#define TEST_WRITER_COUNT   2
+#define TEST_ITERATIONS     200000
+
+/* the value of a key, so that a reader can tell a torn lookup */
+#define TEST_VALUE(key) ((void *) (uintptr_t) ((key) * 2 + 1))
+
+/* spread the keys over the whole 64 bits */
+#define TEST_KEY(i) (((uint64_t) (i) << 32) | (uint64_t) (i) * 7)
+
+typedef struct {
+    opal_concurrent_hash_table_t *table;
+    int id;
+} test_arg_t;
+
+static opal_atomic_int32_t writers_done = 0;
+static opal_atomic_int32_t reader_errors = 0;
+
+static void test_single_thread(void)
+{
+    opal_concurrent_hash_table_t table;
+    void *value;
+    int errors = 0, rc;
+
+    OBJ_CONSTRUCT(&table, opal_concurrent_hash_table_t);
+    /* a small table, it has to grow many times */
+    rc = opal_concurrent_hash_table_init2(&table, 16, 4);
+    test_verify_int(OPAL_SUCCESS, rc);
+
+    for (uint64_t i = 0; i < TEST_KEY_COUNT; ++i) {
+        rc = opal_concurrent_hash_table_set_value_uint64(&table, TEST_KEY(i), TEST_VALUE(i));
+        if (OPAL_SUCCESS != rc) {
+            ++errors;
+        }
+    }
+    test_verify_int(0, errors);
+    test_verify_int(TEST_KEY_COUNT, (int) opal_concurrent_hash_table_get_size(&table));
+
+    for (uint64_t i = 0; i < TEST_KEY_COUNT; ++i) {
+        rc = opal_concurrent_hash_table_get_value_uint64(&table, TEST_KEY(i), &value);
+        if (OPAL_SUCCESS != rc || TEST_VALUE(i) != value) {
+            ++errors;
+        }
+    }
+    test_verify_int(0, errors);
+
+    /* replace the value of the even keys, remove the odd ones */
+    for (uint64_t i = 0; i < TEST_KEY_COUNT; ++i) {
+        if (i & 1) {
+            rc = opal_concurrent_hash_table_remove_value_uint64(&table, TEST_KEY(i));
+        } else {
+            rc = opal_concurrent_hash_table_set_value_uint64(&table, TEST_KEY(i), TEST_VALUE(i + 1));
+        }
+        if (OPAL_SUCCESS != rc) {
+            ++errors;
+        }
+    }
+    test_verify_int(0, errors);
+    test_verify_int(TEST_KEY_COUNT / 2, (int) opal_concurrent_hash_table_get_size(&table));
+
+    for (uint64_t i = 0; i < TEST_KEY_COUNT; ++i) {
+        rc = opal_concurrent_hash_table_get_value_uint64(&table, TEST_KEY(i), &value);
+        if (i & 1) {
+            errors += (OPAL_ERR_NOT_FOUND != rc);
+        } else {
+            errors += (OPAL_SUCCESS != rc || TEST_VALUE(i + 1) != value);
+        }
+    }
+    test_verify_int(0, errors);
+    test_verify_int(OPAL_ERR_NOT_FOUND,
+                    opal_concurrent_hash_table_remove_value_uint64(&table, TEST_KEY(1)));
+
+    /* the deleted slots are reused */
+    for (int round = 0; round < 10; ++round) {
+        for (uint64_t i = 1; i < TEST_KEY_COUNT; i += 2) {
+            errors += (OPAL_SUCCESS != opal_concurrent_hash_table_set_value_uint64(&table, TEST_KEY(i),
+                                                                                   TEST_VALUE(i)));
+        }
+        for (uint64_t i = 1; i < TEST_KEY_COUNT; i += 2) {
+            errors += (OPAL_SUCCESS != opal_concurrent_hash_table_remove_value_uint64(&table, TEST_KEY(i)));
+        }
+    }
+    test_verify_int(0, errors);
+    test_verify_int(TEST_KEY_COUNT / 2, (int) opal_concurrent_hash_table_get_size(&table));
+
+    rc = opal_concurrent_hash_table_remove_all(&table);
+    test_verify_int(OPAL_SUCCESS, rc);
+    test_verify_int(0, (int) opal_concurrent_hash_table_get_size(&table));
+    test_verify_int(OPAL_ERR_NOT_FOUND,
+                    opal_concurrent_hash_table_get_value_uint64(&table, TEST_KEY(0), &value));
+
+    OBJ_DESTRUCT(&table);
+}
+
+/* each writer owns the keys of its parity and keeps adding and removing
+ * them, the first half of the keys is never removed */
+static void *test_writer(opal_object_t *arg)
+{
+    opal_thread_t *t = (opal_thread_t *) arg;
+    opal_concurrent_hash_table_t *table = ((test_arg_t *) t->t_arg)->table;
+    int id = ((test_arg_t *) t->t_arg)->id;
+
+    for (int iter = 0; iter < TEST_ITERATIONS; ++iter) {
+        uint64_t i = TEST_KEY_COUNT / 2 + ((uint64_t) iter * TEST_WRITER_COUNT + id) % (TEST_KEY_COUNT / 2);
+
+        if (OPAL_SUCCESS != opal_concurrent_hash_table_remove_value_uint64(table, TEST_KEY(i))) {
+            (void) opal_concurrent_hash_table_set_value_uint64(table, TEST_KEY(i), TEST_VALUE(i));
+        }
+    }
+    opal_atomic_add_fetch_32(&writers_done, 1);
+    return NULL;
+}
+
+static void *test_reader(opal_object_t *arg)
+{
+    opal_thread_t *t = (opal_thread_t *) arg;
+    opal_concurrent_hash_table_t *table = ((test_arg_t *) t->t_arg)->table;
+    uint64_t i = ((test_arg_t *) t->t_arg)->id;
+    void *value;
+    int rc;
+
+    while (TEST_WRITER_COUNT != writers_done) {
+        i = (i + 7919) % TEST_KEY_COUNT;
+        rc = opal_concurrent_hash_table_get_value_uint64(table, TEST_KEY(i), &value);
+        if (OPAL_SUCCESS == rc) {
+            if (TEST_VALUE(i) != value) {
+                opal_atomic_add_fetch_32(&reader_errors, 1);
+            }
+        } else if (i < TEST_KEY_COUNT / 2) {
+            opal_atomic_add_fetch_32(&reader_errors, 1);
+        }
+    }
+    return NULL;
+}
+
+static void test_multi_thread(void)
+{
+    opal_thread_t threads[TEST_READER_COUNT + TEST_WRITER_COUNT];
+    test_arg_t args[TEST_READER_COUNT + TEST_WRITER_COUNT];
+    opal_concurrent_hash_table_t table;
+    void *ret;
+    int rc;
+
+    OBJ_CONSTRUCT(&table, opal_concurrent_hash_table_t);
+    rc = opal_concurrent_hash_table_init2(&table, 16, 4);
+    test_verify_int(OPAL_SUCCESS, rc);
+    for (uint64_t i = 0; i < TEST_KEY_COUNT / 2; ++i) {
+        (void) opal_concurrent_hash_table_set_value_uint64(&table, TEST_KEY(i), TEST_VALUE(i));
+    }
+
+    opal_set_using_threads(true);
+    for (int i = 0; i < TEST_READER_COUNT + TEST_WRITER_COUNT; ++i) {
+        OBJ_CONSTRUCT(&threads[i], opal_thread_t);
+        threads[i].t_run = (i < TEST_WRITER_COUNT) ? test_writer : test_reader;
+        args[i].table = &table;
+        args[i].id = i;
+        threads[i].t_arg = &args[i];
+        opal_thread_start(threads + i);
+    }
+    for (int i = 0; i < TEST_READER_COUNT + TEST_WRITER_COUNT; ++i) {
+        opal_thread_join(threads + i, &ret);
+        OBJ_DESTRUCT(&threads[i]);
+    }
+    opal_set_using_threads(false);
+
+    test_verify_int(0, reader_errors);
+    OBJ_DESTRUCT(&table);
+}
+
+int main(int argc, char **argv)
+{
+    int rc;
+
+    test_init("opal_concurrent_hash_table_t");
+
+    rc = opal_init_util(&argc, &argv);
+    test_verify_int(OPAL_SUCCESS, rc);
+    if (OPAL_SUCCESS != rc) {
+        test_finalize();
+        exit(1);
+    }
+
+    test_single_thread();
+    test_multi_thread();
+
+    opal_finalize_util();
+
+    return test_finalize();
+}
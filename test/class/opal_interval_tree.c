@@ -0,0 +1,223 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal_config.h"
+
+#include "opal/class/opal_interval_tree.h"
+#include "opal/constants.h"
+#include "opal/mca/threads/threads.h"
+#include "opal/runtime/opal.h"
+#include "support.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define TEST_INTERVAL_COUNT 4096
+#define TEST_READER_COUNT   4
+#define TEST_WRITER_COUNT   2
+#define TEST_ITERATIONS     50000
+
+/* every interval is a page, the churn of the writers is above the stable ones */
+#define TEST_LOW(i)  ((uint64_t) (i) << 12)
+#define TEST_HIGH(i) (TEST_LOW(i) + 4095)
+#define TEST_DATA(i) ((void *) (uintptr_t) ((i) + 1))
+
+#if !defined(timersub)
+#    define timersub(a, b, r)                           \
+        do {                                            \
+            (r)->tv_sec = (a)->tv_sec - (b)->tv_sec;    \
+            if ((a)->tv_usec < (b)->tv_usec) {          \
+                (r)->tv_sec--;                          \
+                (a)->tv_usec += 1000000;                \
+            }                                           \
+            (r)->tv_usec = (a)->tv_usec - (b)->tv_usec; \
+        } while (0)
+#endif
+
+typedef struct {
+    opal_interval_tree_t *tree;
+    int id;
+    uint64_t count;
+} test_arg_t;
+
+static opal_atomic_int32_t writers_done = 0;
+static opal_atomic_int32_t reader_misses = 0;
+
+static int test_count_cb(uint64_t low, uint64_t high, void *data, void *ctx)
+{
+    ++*(int *) ctx;
+    return OPAL_SUCCESS;
+}
+
+static void test_single_thread(void)
+{
+    opal_interval_tree_t tree;
+    int errors = 0, count, rc;
+
+    OBJ_CONSTRUCT(&tree, opal_interval_tree_t);
+    rc = opal_interval_tree_init(&tree);
+    test_verify_int(OPAL_SUCCESS, rc);
+
+    for (int i = 0; i < TEST_INTERVAL_COUNT; ++i) {
+        errors += (OPAL_SUCCESS
+                   != opal_interval_tree_insert(&tree, TEST_DATA(i), TEST_LOW(i), TEST_HIGH(i)));
+    }
+    test_verify_int(0, errors);
+    test_verify_int(TEST_INTERVAL_COUNT, (int) opal_interval_tree_size(&tree));
+    test_verify("the tree is balanced", opal_interval_tree_verify(&tree));
+
+    for (int i = 0; i < TEST_INTERVAL_COUNT; ++i) {
+        errors += (TEST_DATA(i)
+                   != opal_interval_tree_find_overlapping(&tree, TEST_LOW(i) + 16, TEST_HIGH(i) - 16));
+    }
+    test_verify_int(0, errors);
+
+    /* remove the odd intervals */
+    for (int i = 1; i < TEST_INTERVAL_COUNT; i += 2) {
+        errors += (OPAL_SUCCESS
+                   != opal_interval_tree_delete(&tree, TEST_LOW(i), TEST_HIGH(i), TEST_DATA(i)));
+    }
+    test_verify_int(0, errors);
+    test_verify_int(TEST_INTERVAL_COUNT / 2, (int) opal_interval_tree_size(&tree));
+    test_verify("the tree is balanced", opal_interval_tree_verify(&tree));
+    test_verify_int(OPAL_ERR_NOT_FOUND,
+                    opal_interval_tree_delete(&tree, TEST_LOW(1), TEST_HIGH(1), TEST_DATA(1)));
+
+    for (int i = 0; i < TEST_INTERVAL_COUNT; ++i) {
+        void *data = opal_interval_tree_find_overlapping(&tree, TEST_LOW(i), TEST_HIGH(i));
+        errors += (data != ((i & 1) ? NULL : TEST_DATA(i)));
+    }
+    test_verify_int(0, errors);
+
+    count = 0;
+    rc = opal_interval_tree_traverse(&tree, TEST_LOW(0), TEST_HIGH(TEST_INTERVAL_COUNT - 1), true,
+                                     test_count_cb, &count);
+    test_verify_int(OPAL_SUCCESS, rc);
+    test_verify_int(TEST_INTERVAL_COUNT / 2, count);
+
+    OBJ_DESTRUCT(&tree);
+}
+
+/* each writer keeps inserting and removing its own intervals */
+static void *test_writer(opal_object_t *arg)
+{
+    opal_thread_t *t = (opal_thread_t *) arg;
+    test_arg_t *targ = (test_arg_t *) t->t_arg;
+    int base = TEST_INTERVAL_COUNT * (targ->id + 1);
+
+    for (int iter = 0; iter < TEST_ITERATIONS; ++iter) {
+        int i = base + iter % TEST_INTERVAL_COUNT;
+
+        if (iter >= TEST_INTERVAL_COUNT) {
+            (void) opal_interval_tree_delete(targ->tree, TEST_LOW(i), TEST_HIGH(i), TEST_DATA(i));
+        }
+        (void) opal_interval_tree_insert(targ->tree, TEST_DATA(i), TEST_LOW(i), TEST_HIGH(i));
+        ++targ->count;
+    }
+    opal_atomic_add_fetch_32(&writers_done, 1);
+    return NULL;
+}
+
+/* the stable intervals must be found whatever the writers do */
+static void *test_reader(opal_object_t *arg)
+{
+    opal_thread_t *t = (opal_thread_t *) arg;
+    test_arg_t *targ = (test_arg_t *) t->t_arg;
+    int i = targ->id;
+
+    while (TEST_WRITER_COUNT != writers_done) {
+        i = (i + 7919) % TEST_INTERVAL_COUNT;
+        if (TEST_DATA(i) != opal_interval_tree_find_overlapping(targ->tree, TEST_LOW(i), TEST_HIGH(i))) {
+            opal_atomic_add_fetch_32(&reader_misses, 1);
+        }
+        ++targ->count;
+    }
+    return NULL;
+}
+
+static void test_multi_thread(void)
+{
+    opal_thread_t threads[TEST_READER_COUNT + TEST_WRITER_COUNT];
+    test_arg_t args[TEST_READER_COUNT + TEST_WRITER_COUNT];
+    uint64_t finds = 0, updates = 0;
+    struct timeval start, stop, total;
+    opal_interval_tree_t tree;
+    double seconds;
+    void *ret;
+    int rc;
+
+    OBJ_CONSTRUCT(&tree, opal_interval_tree_t);
+    rc = opal_interval_tree_init(&tree);
+    test_verify_int(OPAL_SUCCESS, rc);
+    for (int i = 0; i < TEST_INTERVAL_COUNT; ++i) {
+        (void) opal_interval_tree_insert(&tree, TEST_DATA(i), TEST_LOW(i), TEST_HIGH(i));
+    }
+
+    opal_set_using_threads(true);
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < TEST_READER_COUNT + TEST_WRITER_COUNT; ++i) {
+        OBJ_CONSTRUCT(&threads[i], opal_thread_t);
+        threads[i].t_run = (i < TEST_WRITER_COUNT) ? test_writer : test_reader;
+        args[i].tree = &tree;
+        args[i].id = i;
+        args[i].count = 0;
+        threads[i].t_arg = &args[i];
+        opal_thread_start(threads + i);
+    }
+    for (int i = 0; i < TEST_READER_COUNT + TEST_WRITER_COUNT; ++i) {
+        opal_thread_join(threads + i, &ret);
+        OBJ_DESTRUCT(&threads[i]);
+        if (i < TEST_WRITER_COUNT) {
+            updates += args[i].count;
+        } else {
+            finds += args[i].count;
+        }
+    }
+    gettimeofday(&stop, NULL);
+    opal_set_using_threads(false);
+
+    timersub(&stop, &start, &total);
+    seconds = (double) total.tv_sec + (double) total.tv_usec * 1e-6;
+    printf("Concurrent test. Readers: %d Writers: %d Time: %d s %d us, "
+           "%.0f finds/s %.0f insert+delete/s\n",
+           TEST_READER_COUNT, TEST_WRITER_COUNT, (int) total.tv_sec, (int) total.tv_usec,
+           (double) finds / seconds, (double) updates / seconds);
+
+    test_verify_int(0, reader_misses);
+    test_verify_int(TEST_INTERVAL_COUNT * (TEST_WRITER_COUNT + 1),
+                    (int) opal_interval_tree_size(&tree));
+    test_verify("the tree is balanced", opal_interval_tree_verify(&tree));
+    OBJ_DESTRUCT(&tree);
+}
+
+int main(int argc, char **argv)
+{
+    int rc;
+
+    test_init("opal_interval_tree_t");
+
+    rc = opal_init_util(&argc, &argv);
+    test_verify_int(OPAL_SUCCESS, rc);
+    if (OPAL_SUCCESS != rc) {
+        test_finalize();
+        exit(1);
+    }
+
+    test_single_thread();
+    test_multi_thread();
+
+    opal_finalize_util();
+
+    return test_finalize();
+}
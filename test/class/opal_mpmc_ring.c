@@ -0,0 +1,188 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal_config.h"
+
+#include "opal/class/opal_mpmc_ring.h"
+#include "opal/constants.h"
+#include "opal/mca/threads/threads.h"
+#include "opal/runtime/opal.h"
+#include "support.h"
+
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#define TEST_RING_SIZE      256
+#define TEST_PRODUCER_COUNT 4
+#define TEST_CONSUMER_COUNT 4
+#define TEST_ITEM_COUNT     100000
+
+/* the items are never NULL, the producer is in the low bits */
+#define TEST_ITEM(producer, i) ((void *) (((uintptr_t) (i) + 1) << 8 | (uintptr_t) (producer)))
+#define TEST_ITEM_PRODUCER(item) ((int) ((uintptr_t) (item) & 0xff))
+#define TEST_ITEM_INDEX(item)    ((int64_t) ((uintptr_t) (item) >> 8) - 1)
+
+#if !defined(timersub)
+#    define timersub(a, b, r)                           \
+        do {                                            \
+            (r)->tv_sec = (a)->tv_sec - (b)->tv_sec;    \
+            if ((a)->tv_usec < (b)->tv_usec) {          \
+                (r)->tv_sec--;                          \
+                (a)->tv_usec += 1000000;                \
+            }                                           \
+            (r)->tv_usec = (a)->tv_usec - (b)->tv_usec; \
+        } while (0)
+#endif
+
+static opal_mpmc_ring_t ring;
+static opal_atomic_int32_t consumed = 0;
+static opal_atomic_int32_t order_errors = 0;
+static opal_atomic_int32_t *seen;
+
+static void test_single_thread(void)
+{
+    opal_mpmc_ring_t small;
+    int errors = 0, rc;
+
+    OBJ_CONSTRUCT(&small, opal_mpmc_ring_t);
+    /* rounded up to 8 */
+    rc = opal_mpmc_ring_init(&small, 5);
+    test_verify_int(OPAL_SUCCESS, rc);
+    test_verify("new ring is empty", opal_mpmc_ring_is_empty(&small));
+    test_verify("pop from an empty ring", NULL == opal_mpmc_ring_pop(&small));
+
+    /* go around the ring a few times */
+    for (int lap = 0; lap < 4; ++lap) {
+        for (int i = 0; i < 8; ++i) {
+            errors += (OPAL_SUCCESS != opal_mpmc_ring_push(&small, TEST_ITEM(0, i)));
+        }
+        errors += (OPAL_ERR_TEMP_OUT_OF_RESOURCE != opal_mpmc_ring_push(&small, TEST_ITEM(0, 8)));
+        for (int i = 0; i < 8; ++i) {
+            errors += (TEST_ITEM(0, i) != opal_mpmc_ring_pop(&small));
+        }
+        errors += (NULL != opal_mpmc_ring_pop(&small));
+    }
+    test_verify_int(0, errors);
+    test_verify("ring is empty", opal_mpmc_ring_is_empty(&small));
+
+    OBJ_DESTRUCT(&small);
+}
+
+static void *test_producer(opal_object_t *arg)
+{
+    opal_thread_t *t = (opal_thread_t *) arg;
+    int id = (int) (intptr_t) t->t_arg;
+
+    for (int i = 0; i < TEST_ITEM_COUNT; ++i) {
+        while (OPAL_SUCCESS != opal_mpmc_ring_push(&ring, TEST_ITEM(id, i))) {
+            /* full, let the consumers run */
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/* every item is seen once, and in the order of its producer */
+static void *test_consumer(opal_object_t *arg)
+{
+    int64_t last[TEST_PRODUCER_COUNT];
+    void *item;
+
+    for (int i = 0; i < TEST_PRODUCER_COUNT; ++i) {
+        last[i] = -1;
+    }
+
+    while (TEST_PRODUCER_COUNT * TEST_ITEM_COUNT != consumed) {
+        item = opal_mpmc_ring_pop(&ring);
+        if (NULL == item) {
+            sched_yield();
+            continue;
+        }
+        int producer = TEST_ITEM_PRODUCER(item);
+        int64_t index = TEST_ITEM_INDEX(item);
+        if (index <= last[producer]) {
+            opal_atomic_add_fetch_32(&order_errors, 1);
+        }
+        last[producer] = index;
+        opal_atomic_add_fetch_32(seen + producer * TEST_ITEM_COUNT + index, 1);
+        opal_atomic_add_fetch_32(&consumed, 1);
+    }
+    return NULL;
+}
+
+static void test_multi_thread(void)
+{
+    opal_thread_t threads[TEST_PRODUCER_COUNT + TEST_CONSUMER_COUNT];
+    struct timeval start, stop, total;
+    int errors = 0, rc;
+    void *ret;
+
+    seen = calloc(TEST_PRODUCER_COUNT * TEST_ITEM_COUNT, sizeof(seen[0]));
+    OBJ_CONSTRUCT(&ring, opal_mpmc_ring_t);
+    rc = opal_mpmc_ring_init(&ring, TEST_RING_SIZE);
+    test_verify_int(OPAL_SUCCESS, rc);
+
+    opal_set_using_threads(true);
+    gettimeofday(&start, NULL);
+    for (int i = 0; i < TEST_PRODUCER_COUNT + TEST_CONSUMER_COUNT; ++i) {
+        OBJ_CONSTRUCT(&threads[i], opal_thread_t);
+        threads[i].t_run = (i < TEST_PRODUCER_COUNT) ? test_producer : test_consumer;
+        threads[i].t_arg = (void *) (intptr_t) i;
+        opal_thread_start(threads + i);
+    }
+    for (int i = 0; i < TEST_PRODUCER_COUNT + TEST_CONSUMER_COUNT; ++i) {
+        opal_thread_join(threads + i, &ret);
+        OBJ_DESTRUCT(&threads[i]);
+    }
+    gettimeofday(&stop, NULL);
+    opal_set_using_threads(false);
+
+    timersub(&stop, &start, &total);
+    printf("All threads finished. Producers: %d Consumers: %d Time: %d s %d us %d nsec/item\n",
+           TEST_PRODUCER_COUNT, TEST_CONSUMER_COUNT, (int) total.tv_sec, (int) total.tv_usec,
+           (int) ((total.tv_sec * 1000000 + total.tv_usec) * 1000
+                  / (TEST_PRODUCER_COUNT * TEST_ITEM_COUNT)));
+
+    for (int i = 0; i < TEST_PRODUCER_COUNT * TEST_ITEM_COUNT; ++i) {
+        errors += (1 != seen[i]);
+    }
+    test_verify_int(0, errors);
+    test_verify_int(0, order_errors);
+    test_verify("ring is empty", opal_mpmc_ring_is_empty(&ring));
+
+    OBJ_DESTRUCT(&ring);
+    free((void *) seen);
+}
+
+int main(int argc, char **argv)
+{
+    int rc;
+
+    test_init("opal_mpmc_ring_t");
+
+    rc = opal_init_util(&argc, &argv);
+    test_verify_int(OPAL_SUCCESS, rc);
+    if (OPAL_SUCCESS != rc) {
+        test_finalize();
+        exit(1);
+    }
+
+    test_single_thread();
+    test_multi_thread();
+
+    opal_finalize_util();
+
+    return test_finalize();
+}
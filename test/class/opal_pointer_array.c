@@ -25,6 +25,7 @@
 
 #include "opal_config.h"
 #include <assert.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -167,6 +168,31 @@ static void test(bool thread_usage)
     OBJ_RELEASE(array);
     assert(NULL == array);
 
+    /* the elements survive the grows */
+    array = OBJ_NEW(opal_pointer_array_t);
+    assert(array);
+    opal_pointer_array_init(array, 0, INT_MAX, 2);
+    error_cnt = 0;
+    for (i = 0; i < 1000; i++) {
+        if (i != opal_pointer_array_add(array, (void *) (uintptr_t)(i + 1))) {
+            error_cnt++;
+        }
+        if ((void *) (uintptr_t) 1 != opal_pointer_array_get_item(array, 0)
+            || (void *) (uintptr_t)(i + 1) != opal_pointer_array_get_item(array, i)) {
+            error_cnt++;
+        }
+    }
+    if (NULL != opal_pointer_array_get_item(array, opal_pointer_array_get_size(array))) {
+        error_cnt++;
+    }
+    if (0 == error_cnt) {
+        test_success();
+    } else {
+        test_failure(" data check after grow ");
+    }
+    OBJ_RELEASE(array);
+    assert(NULL == array);
+
     free(test_data);
 }
 
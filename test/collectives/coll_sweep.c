@@ -0,0 +1,642 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+  Time every algorithm of the tuned collective component, for each
+  collective, message size and segment size, in a single job.
+
+  To be run as:
+
+  mpirun -np 64 --mca coll_tuned_use_dynamic_rules 1 ./coll_sweep [options]
+
+  The algorithm and the segment size of a collective are forced with the
+  coll_tuned_<collective>_algorithm and coll_tuned_<collective>_algorithm_segmentsize
+  control variables, written through MPI_T before a communicator is
+  duplicated: coll/tuned reads them when the communicator is created.
+  Algorithm 0 ("ignore") times the default decision. The collectives are
+  timed on MPI_COMM_WORLD, on the node communicators (all the nodes at
+  once) and on the communicator of the first process of each node, the
+  last two being the communicators coll/han builds.
+
+  Rank 0 writes:
+    <prefix>.csv          every measurement, the time of the slowest process
+    <prefix>.tuned.rules  the fastest algorithm for each communicator and
+                          message size, for coll_tuned_dynamic_rules_filename
+    <prefix>.han.rules    sends the node and leader communicators of coll/han
+                          to coll/tuned (and so to the rules above), for
+                          coll_han_dynamic_rules_filename
+
+  The message size is the size of the block of one process, the rules use
+  the size coll/tuned computes for its decision (the whole buffer of the
+  collectives exchanging a block with every process).
+*/
+
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* from ompi/mca/coll/base/coll_base_functions.h */
+enum {
+    COLL_ALLGATHER = 0,
+    COLL_ALLREDUCE = 2,
+    COLL_ALLTOALL = 3,
+    COLL_BARRIER = 6,
+    COLL_BCAST = 7,
+    COLL_GATHER = 9,
+    COLL_REDUCE = 11,
+    COLL_REDUCESCATTERBLOCK = 13,
+    COLL_SCATTER = 15
+};
+
+/* from ompi/mca/coll/han/coll_han_dynamic.h */
+enum { HAN_INTRA_NODE = 0, HAN_INTER_NODE = 1 };
+
+#define MAX_SIZES    32
+#define MAX_SEGSIZES 16
+#define MAX_LEVELS   3
+#define NAME_LEN     256
+
+typedef struct {
+    const char *name;  /* as in the coll_tuned_<name>_algorithm variables */
+    int id;            /* collective identifier of the rules files */
+    int per_process;   /* the buffers hold a block for each process */
+    int reduction;     /* MPI_FLOAT and MPI_SUM instead of MPI_BYTE */
+    int han;           /* coll/han has dynamic rules for it */
+} coll_t;
+
+static const coll_t colls[] = {
+    {"allgather", COLL_ALLGATHER, 1, 0, 1},
+    {"allreduce", COLL_ALLREDUCE, 0, 1, 1},
+    {"alltoall", COLL_ALLTOALL, 1, 0, 1},
+    {"barrier", COLL_BARRIER, 0, 0, 1},
+    {"bcast", COLL_BCAST, 0, 0, 1},
+    {"gather", COLL_GATHER, 1, 0, 1},
+    {"reduce", COLL_REDUCE, 0, 1, 1},
+    {"reduce_scatter_block", COLL_REDUCESCATTERBLOCK, 1, 1, 1},
+    {"scatter", COLL_SCATTER, 1, 0, 1},
+};
+#define NCOLLS ((int) (sizeof(colls) / sizeof(colls[0])))
+
+typedef struct {
+    const char *name;
+    MPI_Comm comm;  /* MPI_COMM_NULL on the processes not taking part */
+    int size;       /* size of the communicator of rank 0 */
+} level_t;
+
+typedef struct {
+    int alg;
+    int segsize;
+    double time;
+} best_t;
+
+static int rank, world_size;
+static size_t sizes[MAX_SIZES];
+static int nsizes;
+static int segsizes[MAX_SEGSIZES];
+static int nsegsizes;
+static int iterations = 20, warmup = 2;
+static size_t max_buffer = 256 * 1024 * 1024;
+static void *sbuf, *rbuf;
+
+static void usage(const char *argv0)
+{
+    if (0 == rank) {
+        fprintf(stderr,
+                "Usage: %s [-c coll[,coll...]] [-m min] [-M max] [-s seg[,seg...]]\n"
+                "          [-i iterations] [-w warmup] [-b max_buffer] [-o prefix]\n",
+                argv0);
+    }
+    MPI_Abort(MPI_COMM_WORLD, 1);
+}
+
+static int cvar_index(const char *name)
+{
+    int index;
+
+    if (MPI_SUCCESS != MPI_T_cvar_get_index(name, &index)) {
+        return -1;
+    }
+    return index;
+}
+
+static int cvar_read_int(const char *name, int *value)
+{
+    MPI_T_cvar_handle handle;
+    int index = cvar_index(name), count;
+
+    if (index < 0 || MPI_SUCCESS != MPI_T_cvar_handle_alloc(index, NULL, &handle, &count)) {
+        return -1;
+    }
+    *value = 0; /* the booleans only write the first byte */
+    MPI_T_cvar_read(handle, value);
+    MPI_T_cvar_handle_free(&handle);
+    return 0;
+}
+
+static void cvar_write_int(const char *name, int value)
+{
+    MPI_T_cvar_handle handle;
+    int index = cvar_index(name), count;
+
+    if (index < 0 || MPI_SUCCESS != MPI_T_cvar_handle_alloc(index, NULL, &handle, &count)) {
+        fprintf(stderr, "coll_sweep: cannot access the control variable %s\n", name);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    if (MPI_SUCCESS != MPI_T_cvar_write(handle, &value)) {
+        fprintf(stderr, "coll_sweep: cannot write the control variable %s\n", name);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    MPI_T_cvar_handle_free(&handle);
+}
+
+/* the algorithms of a collective, from the enumeration of its variable */
+static int coll_algorithms(const coll_t *coll, int **values, char ***names)
+{
+    char name[NAME_LEN], item[NAME_LEN];
+    int index, verbosity, bind, scope, num, len, i;
+    MPI_Datatype datatype;
+    MPI_T_enum enumtype;
+
+    snprintf(name, sizeof(name), "coll_tuned_%s_algorithm", coll->name);
+    if ((index = cvar_index(name)) < 0) {
+        return 0;
+    }
+    len = sizeof(item);
+    MPI_T_cvar_get_info(index, item, &len, &verbosity, &datatype, &enumtype, NULL, NULL, &bind,
+                        &scope);
+    if (MPI_T_ENUM_NULL == enumtype) {
+        return 0;
+    }
+    len = sizeof(item);
+    MPI_T_enum_get_info(enumtype, &num, item, &len);
+    *values = (int *) malloc(num * sizeof(int));
+    *names = (char **) malloc(num * sizeof(char *));
+    for (i = 0; i < num; i++) {
+        len = sizeof(item);
+        MPI_T_enum_get_item(enumtype, i, &(*values)[i], item, &len);
+        (*names)[i] = strdup(item);
+    }
+    return num;
+}
+
+static int parse_list(char *arg, long *values, int max)
+{
+    char *token, *save = NULL;
+    int n = 0;
+
+    for (token = strtok_r(arg, ",", &save); NULL != token && n < max;
+         token = strtok_r(NULL, ",", &save)) {
+        values[n++] = strtol(token, NULL, 0);
+    }
+    return n;
+}
+
+/* size of the message the decision of coll/tuned is made on */
+static size_t rule_size(const coll_t *coll, size_t msg, int comm_size)
+{
+    if (COLL_BARRIER == coll->id) {
+        return 0;
+    }
+    return coll->per_process ? msg * (size_t) comm_size : msg;
+}
+
+static int run_coll(const coll_t *coll, MPI_Comm comm, size_t msg)
+{
+    MPI_Datatype dtype = coll->reduction ? MPI_FLOAT : MPI_BYTE;
+    int count = (int) (coll->reduction ? msg / sizeof(float) : msg);
+
+    switch (coll->id) {
+    case COLL_ALLGATHER:
+        return MPI_Allgather(sbuf, count, dtype, rbuf, count, dtype, comm);
+    case COLL_ALLREDUCE:
+        return MPI_Allreduce(sbuf, rbuf, count, dtype, MPI_SUM, comm);
+    case COLL_ALLTOALL:
+        return MPI_Alltoall(sbuf, count, dtype, rbuf, count, dtype, comm);
+    case COLL_BARRIER:
+        return MPI_Barrier(comm);
+    case COLL_BCAST:
+        return MPI_Bcast(sbuf, count, dtype, 0, comm);
+    case COLL_GATHER:
+        return MPI_Gather(sbuf, count, dtype, rbuf, count, dtype, 0, comm);
+    case COLL_REDUCE:
+        return MPI_Reduce(sbuf, rbuf, count, dtype, MPI_SUM, 0, comm);
+    case COLL_REDUCESCATTERBLOCK:
+        return MPI_Reduce_scatter_block(sbuf, rbuf, count, dtype, MPI_SUM, comm);
+    case COLL_SCATTER:
+        return MPI_Scatter(sbuf, count, dtype, rbuf, count, dtype, 0, comm);
+    }
+    return MPI_ERR_ARG;
+}
+
+/* average time of the slowest process, on rank 0 of comm, or a negative
+ * time if the algorithm does not support the communicator or the message */
+static double time_coll(const coll_t *coll, MPI_Comm comm, MPI_Comm check, size_t msg)
+{
+    double start, elapsed, slowest = 0.0;
+    int i, failed, any_failed;
+
+    /* the processes agree on the failure on the communicator created
+     * before the algorithm was forced */
+    failed = (MPI_SUCCESS != run_coll(coll, comm, msg));
+    MPI_Allreduce(&failed, &any_failed, 1, MPI_INT, MPI_MAX, check);
+    if (any_failed) {
+        return -1.0;
+    }
+    for (i = 0; i < warmup; i++) {
+        run_coll(coll, comm, msg);
+    }
+    MPI_Barrier(comm);
+    start = MPI_Wtime();
+    for (i = 0; i < iterations; i++) {
+        run_coll(coll, comm, msg);
+    }
+    elapsed = (MPI_Wtime() - start) / iterations;
+    MPI_Reduce(&elapsed, &slowest, 1, MPI_DOUBLE, MPI_MAX, 0, comm);
+    return slowest;
+}
+
+/* the message sizes of coll the buffers of a communicator of comm_size hold */
+static int coll_nsizes(const coll_t *coll, int comm_size)
+{
+    int n;
+
+    if (COLL_BARRIER == coll->id) {
+        return 1;
+    }
+    for (n = 0; n < nsizes; n++) {
+        if (sizes[n] * (coll->per_process ? (size_t) comm_size : 1) > max_buffer) {
+            break;
+        }
+    }
+    return n;
+}
+
+static void sweep(const coll_t *coll, level_t *level, FILE *csv, best_t *best)
+{
+    char name[NAME_LEN], segname[NAME_LEN];
+    int nalgs, a, s, m, n, segsize;
+    char **alg_names;
+    int *algs;
+    MPI_Comm comm;
+    size_t msg;
+    double t;
+
+    nalgs = coll_algorithms(coll, &algs, &alg_names);
+    if (0 == nalgs) {
+        return;
+    }
+    snprintf(name, sizeof(name), "coll_tuned_%s_algorithm", coll->name);
+    snprintf(segname, sizeof(segname), "coll_tuned_%s_algorithm_segmentsize", coll->name);
+    n = coll_nsizes(coll, level->size);
+    for (m = 0; m < n; m++) {
+        best[m].time = -1.0;
+    }
+
+    for (a = 0; a < nalgs; a++) {
+        for (s = 0; s < nsegsizes; s++) {
+            segsize = segsizes[s];
+            /* the default decision and the barrier do not segment */
+            if (0 != segsize && (0 == algs[a] || COLL_BARRIER == coll->id)) {
+                continue;
+            }
+            cvar_write_int(name, algs[a]);
+            if (COLL_BARRIER != coll->id) {
+                cvar_write_int(segname, segsize);
+            }
+            if (MPI_COMM_NULL != level->comm) {
+                MPI_Comm_dup(level->comm, &comm);
+                MPI_Comm_set_errhandler(comm, MPI_ERRORS_RETURN);
+                for (m = 0; m < n; m++) {
+                    msg = (COLL_BARRIER == coll->id) ? 0 : sizes[m];
+                    /* a segment larger than the message is no segment */
+                    if (0 != segsize && (size_t) segsize >= msg) {
+                        continue;
+                    }
+                    if (coll->reduction && 0 != msg % sizeof(float)) {
+                        continue;
+                    }
+                    t = time_coll(coll, comm, level->comm, msg);
+                    if (t < 0.0) {
+                        continue;
+                    }
+                    if (0 == rank) {
+                        fprintf(csv, "%s,%s,%d,%zu,%d,%s,%d,%.3f\n", coll->name, level->name,
+                                level->size, msg, algs[a], alg_names[a], segsize, t * 1e6);
+                        fflush(csv);
+                        if (best[m].time < 0.0 || t < best[m].time) {
+                            best[m].alg = algs[a];
+                            best[m].segsize = segsize;
+                            best[m].time = t;
+                        }
+                    }
+                }
+                MPI_Comm_free(&comm);
+            }
+            MPI_Barrier(MPI_COMM_WORLD);
+        }
+    }
+    /* back to the default decision */
+    cvar_write_int(name, 0);
+    if (COLL_BARRIER != coll->id) {
+        cvar_write_int(segname, 0);
+    }
+
+    for (a = 0; a < nalgs; a++) {
+        free(alg_names[a]);
+    }
+    free(alg_names);
+    free(algs);
+}
+
+/* the fan in/out of the rules, the default of the forced algorithms */
+static int coll_faninout(const coll_t *coll, int alg)
+{
+    char name[NAME_LEN], **alg_names;
+    int value = 0, nalgs, *algs, a, chain = 0;
+
+    if (COLL_BARRIER == coll->id) {
+        return 0;
+    }
+    nalgs = coll_algorithms(coll, &algs, &alg_names);
+    for (a = 0; a < nalgs; a++) {
+        if (algs[a] == alg && NULL != strstr(alg_names[a], "chain")) {
+            chain = 1;
+        }
+        free(alg_names[a]);
+    }
+    if (0 < nalgs) {
+        free(alg_names);
+        free(algs);
+    }
+    snprintf(name, sizeof(name), "coll_tuned_%s_algorithm_%s_fanout", coll->name,
+             chain ? "chain" : "tree");
+    if (0 != cvar_read_int(name, &value) || value < 0) {
+        value = 0;
+    }
+    return value;
+}
+
+static void write_tuned_rules(const char *fname, level_t *levels, int nlevels,
+                              best_t (*best)[MAX_LEVELS][MAX_SIZES], const int *selected,
+                              int nselected)
+{
+    int c, l, m, n, nrules, prev, ncolls = 0, order[MAX_LEVELS], i, j, tmp;
+    const coll_t *coll;
+    FILE *f;
+
+    if (NULL == (f = fopen(fname, "w"))) {
+        fprintf(stderr, "coll_sweep: cannot open %s\n", fname);
+        return;
+    }
+    /* the communicator sizes of a collective come in increasing order */
+    for (l = 0; l < nlevels; l++) {
+        order[l] = l;
+    }
+    for (i = 0; i < nlevels; i++) {
+        for (j = i + 1; j < nlevels; j++) {
+            if (levels[order[j]].size < levels[order[i]].size) {
+                tmp = order[i];
+                order[i] = order[j];
+                order[j] = tmp;
+            }
+        }
+    }
+    for (c = 0; c < nselected; c++) {
+        ncolls += (best[c][0][0].time >= 0.0);
+    }
+
+    fprintf(f, "%d # number of collectives\n", ncolls);
+    for (c = 0; c < nselected; c++) {
+        coll = &colls[selected[c]];
+        if (best[c][0][0].time < 0.0) {
+            continue;
+        }
+        fprintf(f, "%d # %s\n", coll->id, coll->name);
+        fprintf(f, "%d # number of communicator sizes\n", nlevels);
+        for (i = 0; i < nlevels; i++) {
+            l = order[i];
+            n = coll_nsizes(coll, levels[l].size);
+            /* one rule for each change of the fastest algorithm */
+            for (nrules = 0, prev = -1, m = 0; m < n; m++) {
+                if (best[c][l][m].time < 0.0) {
+                    continue;
+                }
+                if (prev < 0 || best[c][l][m].alg != best[c][l][prev].alg
+                    || best[c][l][m].segsize != best[c][l][prev].segsize) {
+                    nrules++;
+                }
+                prev = m;
+            }
+            fprintf(f, "%d # communicator size (%s)\n", levels[l].size, levels[l].name);
+            fprintf(f, "%d # number of message sizes\n", nrules);
+            for (nrules = 0, prev = -1, m = 0; m < n; m++) {
+                if (best[c][l][m].time < 0.0) {
+                    continue;
+                }
+                if (prev < 0 || best[c][l][m].alg != best[c][l][prev].alg
+                    || best[c][l][m].segsize != best[c][l][prev].segsize) {
+                    /* the first rule starts at 0 */
+                    fprintf(f, "%zu %d %d %d # message size, algorithm, faninout, segment size\n",
+                            (0 == nrules) ? (size_t) 0 : rule_size(coll, sizes[m], levels[l].size),
+                            best[c][l][m].alg, coll_faninout(coll, best[c][l][m].alg),
+                            best[c][l][m].segsize);
+                    nrules++;
+                }
+                prev = m;
+            }
+        }
+    }
+    fclose(f);
+}
+
+static void write_han_rules(const char *fname, const int *selected, int nselected, int han_levels)
+{
+    int c, ncolls = 0;
+    FILE *f;
+
+    if (0 == han_levels) {
+        return;
+    }
+    if (NULL == (f = fopen(fname, "w"))) {
+        fprintf(stderr, "coll_sweep: cannot open %s\n", fname);
+        return;
+    }
+    for (c = 0; c < nselected; c++) {
+        ncolls += colls[selected[c]].han;
+    }
+    fprintf(f, "%d # number of collectives\n", ncolls);
+    for (c = 0; c < nselected; c++) {
+        if (!colls[selected[c]].han) {
+            continue;
+        }
+        fprintf(f, "%s\n", colls[selected[c]].name);
+        fprintf(f, "2 # number of topological levels\n");
+        fprintf(f, "%d # intra node\n1\n1\n1\n0 tuned\n", HAN_INTRA_NODE);
+        fprintf(f, "%d # inter node\n1\n1\n1\n0 tuned\n", HAN_INTER_NODE);
+    }
+    fclose(f);
+}
+
+int main(int argc, char *argv[])
+{
+    long list[MAX_SIZES > MAX_SEGSIZES ? MAX_SIZES : MAX_SEGSIZES];
+    int selected[NCOLLS], nselected = 0, nlevels = 0, provided, opt, value, c, l, n;
+    size_t min_size = 4, max_size = 1024 * 1024, msg;
+    const char *prefix = "coll_sweep";
+    char *coll_list = NULL, fname[NAME_LEN], *token, *save = NULL;
+    MPI_Comm node_comm, leader_comm;
+    level_t levels[MAX_LEVELS];
+    best_t (*best)[MAX_LEVELS][MAX_SIZES];
+    int node_size, node_rank, nnodes;
+    FILE *csv = NULL;
+
+    MPI_Init(&argc, &argv);
+    MPI_T_init_thread(MPI_THREAD_SINGLE, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+
+    segsizes[0] = 0;
+    nsegsizes = 1;
+    while (-1 != (opt = getopt(argc, argv, "c:m:M:s:i:w:b:o:h"))) {
+        switch (opt) {
+        case 'c':
+            coll_list = optarg;
+            break;
+        case 'm':
+            min_size = strtoul(optarg, NULL, 0);
+            break;
+        case 'M':
+            max_size = strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            n = parse_list(optarg, list, MAX_SEGSIZES);
+            for (nsegsizes = 0; nsegsizes < n; nsegsizes++) {
+                segsizes[nsegsizes] = (int) list[nsegsizes];
+            }
+            break;
+        case 'i':
+            iterations = atoi(optarg);
+            break;
+        case 'w':
+            warmup = atoi(optarg);
+            break;
+        case 'b':
+            max_buffer = strtoul(optarg, NULL, 0);
+            break;
+        case 'o':
+            prefix = optarg;
+            break;
+        default:
+            usage(argv[0]);
+        }
+    }
+    if (0 == min_size || min_size > max_size || iterations < 1 || 0 == nsegsizes) {
+        usage(argv[0]);
+    }
+    for (nsizes = 0, msg = min_size; msg <= max_size && nsizes < MAX_SIZES; msg *= 2) {
+        sizes[nsizes++] = msg;
+    }
+
+    for (c = 0; c < NCOLLS; c++) {
+        if (NULL == coll_list) {
+            selected[nselected++] = c;
+        }
+    }
+    for (token = (NULL == coll_list) ? NULL : strtok_r(coll_list, ",", &save); NULL != token;
+         token = strtok_r(NULL, ",", &save)) {
+        for (c = 0; c < NCOLLS && 0 != strcmp(token, colls[c].name); c++)
+            ;
+        if (NCOLLS == c) {
+            if (0 == rank) {
+                fprintf(stderr, "coll_sweep: unknown collective %s\n", token);
+            }
+            usage(argv[0]);
+        }
+        selected[nselected++] = c;
+    }
+
+    if (0 != cvar_read_int("coll_tuned_use_dynamic_rules", &value) || 0 == value) {
+        if (0 == rank) {
+            fprintf(stderr, "coll_sweep: run with --mca coll_tuned_use_dynamic_rules 1, "
+                            "the algorithms of coll/tuned cannot be forced otherwise\n");
+        }
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    /* the communicators of coll/han: the processes of a node, and the
+     * first process of each node */
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node_comm);
+    MPI_Comm_size(node_comm, &node_size);
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_split(MPI_COMM_WORLD, (0 == node_rank) ? 0 : MPI_UNDEFINED, rank, &leader_comm);
+    nnodes = 0;
+    if (MPI_COMM_NULL != leader_comm) {
+        MPI_Comm_size(leader_comm, &nnodes);
+    }
+    MPI_Bcast(&node_size, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Bcast(&nnodes, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+    levels[nlevels++] = (level_t){"world", MPI_COMM_WORLD, world_size};
+    if (1 < node_size && node_size < world_size) {
+        levels[nlevels++] = (level_t){"node", node_comm, node_size};
+    }
+    if (1 < nnodes && nnodes < world_size) {
+        levels[nlevels++] = (level_t){"leaders", leader_comm, nnodes};
+    }
+
+    sbuf = malloc(max_buffer);
+    rbuf = malloc(max_buffer);
+    best = calloc(nselected, sizeof(*best));
+    if (NULL == sbuf || NULL == rbuf || NULL == best) {
+        fprintf(stderr, "coll_sweep: cannot allocate the buffers\n");
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    memset(sbuf, 1, max_buffer);
+    memset(rbuf, 0, max_buffer);
+
+    if (0 == rank) {
+        snprintf(fname, sizeof(fname), "%s.csv", prefix);
+        if (NULL == (csv = fopen(fname, "w"))) {
+            fprintf(stderr, "coll_sweep: cannot open %s\n", fname);
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        fprintf(csv, "collective,communicator,communicator_size,message_size,algorithm,"
+                     "algorithm_name,segment_size,time_us\n");
+    }
+
+    for (c = 0; c < nselected; c++) {
+        for (l = 0; l < nlevels; l++) {
+            sweep(&colls[selected[c]], &levels[l], csv, best[c][l]);
+        }
+    }
+
+    if (0 == rank) {
+        fclose(csv);
+        snprintf(fname, sizeof(fname), "%s.tuned.rules", prefix);
+        write_tuned_rules(fname, levels, nlevels, best, selected, nselected);
+        snprintf(fname, sizeof(fname), "%s.han.rules", prefix);
+        write_han_rules(fname, selected, nselected, nlevels > 1);
+    }
+
+    free(best);
+    free(sbuf);
+    free(rbuf);
+    if (MPI_COMM_NULL != leader_comm) {
+        MPI_Comm_free(&leader_comm);
+    }
+    MPI_Comm_free(&node_comm);
+    MPI_T_finalize();
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,339 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * Pack and unpack bandwidth of the datatype engine for the usual shapes:
+ * contiguous, vectors, indexed, struct, subarray, darray and resized
+ * types, from host memory and, when the library has CUDA support, from GPU
+ * memory. One CSV line per shape and memory:
+ *
+ *   shape,memory,bytes,pack_GBps,unpack_GBps
+ *
+ *   ddt_bench [-s bytes] [-i iterations] [-o results.csv] [-b baseline.csv [-t percent]]
+ *
+ * With a baseline (a previous output), the shapes more than percent
+ * (default 10) slower than the baseline are reported and the exit status
+ * is 1.
+ */
+
+#include "ompi_config.h"
+#include "mpi.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "opal/datatype/opal_convertor.h"
+#if OPAL_CUDA_SUPPORT
+#    include "opal/mca/common/cuda/common_cuda.h"
+#endif /* OPAL_CUDA_SUPPORT */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_SHAPES 16
+
+typedef struct {
+    const char *name;
+    MPI_Datatype type;
+    int count;
+} shape_t;
+
+typedef struct {
+    char shape[64];
+    char memory[8];
+    double pack, unpack;
+} result_t;
+
+static double bench(MPI_Datatype type, int count, void *array, void *packed, size_t size,
+                    int iterations, int unpack)
+{
+    opal_convertor_t *convertor;
+    struct iovec iov;
+    uint32_t iov_count;
+    size_t max_data;
+    double start = 0.0;
+    int i;
+
+    convertor = opal_convertor_create(opal_local_arch, 0);
+    /* the first iteration warms up the caches and the engine */
+    for (i = -1; i < iterations; i++) {
+        if (0 == i) {
+            start = MPI_Wtime();
+        }
+        iov.iov_base = packed;
+        iov.iov_len = size;
+        max_data = size;
+        iov_count = 1;
+        if (unpack) {
+            opal_convertor_prepare_for_recv(convertor, &type->super, count, array);
+            opal_convertor_unpack(convertor, &iov, &iov_count, &max_data);
+        } else {
+            opal_convertor_prepare_for_send(convertor, &type->super, count, array);
+            opal_convertor_pack(convertor, &iov, &iov_count, &max_data);
+        }
+    }
+    start = MPI_Wtime() - start;
+    OBJ_RELEASE(convertor);
+    return (double) size * iterations / (start > 0.0 ? start : 1e-9) / 1e9;
+}
+
+/* the shapes, each one moving about target bytes */
+static int build_shapes(shape_t *shapes, size_t target)
+{
+    int n = 0, i, nd = (int) (target / sizeof(double)), side, nblocks, *blens, *displs;
+    int sizes[3], subsizes[3], starts[3], gsizes[2], distribs[2], dargs[2], psizes[2];
+    int sblens[3] = {1, 1, 3};
+    MPI_Aint sdispls[3] = {0, 8, 16};
+    MPI_Datatype stypes[3] = {MPI_INT, MPI_DOUBLE, MPI_CHAR}, tmp;
+
+    shapes[n].name = "contiguous";
+    MPI_Type_contiguous(nd, MPI_DOUBLE, &shapes[n].type);
+    shapes[n++].count = 1;
+
+    shapes[n].name = "vector_2of4";
+    MPI_Type_vector(nd / 2, 2, 4, MPI_DOUBLE, &shapes[n].type);
+    shapes[n++].count = 1;
+
+    shapes[n].name = "vector_512of1024";
+    MPI_Type_vector(nd / 512, 512, 1024, MPI_DOUBLE, &shapes[n].type);
+    shapes[n++].count = 1;
+
+    /* irregular blocks of 1 to 8 doubles, separated by gaps of 1 to 3 */
+    nblocks = nd / 4;
+    blens = (int *) malloc(nblocks * sizeof(int));
+    displs = (int *) malloc(nblocks * sizeof(int));
+    for (i = 0; i < nblocks; i++) {
+        blens[i] = 1 + (i * 7) % 8;
+        displs[i] = (0 == i) ? 0 : displs[i - 1] + blens[i - 1] + 1 + i % 3;
+    }
+    for (i = 0; i < nblocks && displs[i] + blens[i] <= 2 * nd; i++)
+        ;
+    shapes[n].name = "indexed";
+    MPI_Type_indexed(i, blens, displs, MPI_DOUBLE, &shapes[n].type);
+    shapes[n++].count = 1;
+
+    for (i = 0; i < nblocks; i++) {
+        displs[i] = 6 * i;
+    }
+    shapes[n].name = "indexed_block_4of6";
+    MPI_Type_create_indexed_block(nd / 4, 4, displs, MPI_DOUBLE, &shapes[n].type);
+    shapes[n++].count = 1;
+    free(blens);
+    free(displs);
+
+    /* {int, double, char[3]} with its padding */
+    shapes[n].name = "struct";
+    MPI_Type_create_struct(3, sblens, sdispls, stypes, &tmp);
+    MPI_Type_create_resized(tmp, 0, 24, &shapes[n].type);
+    MPI_Type_free(&tmp);
+    shapes[n++].count = (int) (target / 15);
+
+    /* the interior of a cube */
+    for (side = 2; (size_t) side * side * side * sizeof(double) < target; side++)
+        ;
+    for (i = 0; i < 3; i++) {
+        sizes[i] = side + 2;
+        subsizes[i] = side;
+        starts[i] = 1;
+    }
+    shapes[n].name = "subarray_3d";
+    MPI_Type_create_subarray(3, sizes, subsizes, starts, MPI_ORDER_C, MPI_DOUBLE,
+                             &shapes[n].type);
+    shapes[n++].count = 1;
+
+    /* the block of rank 0 in a 2x2 grid, cyclic by 2 in the columns */
+    for (side = 2; (size_t) side * side * sizeof(double) < 4 * target; side += 2)
+        ;
+    gsizes[0] = gsizes[1] = side;
+    distribs[0] = MPI_DISTRIBUTE_BLOCK;
+    distribs[1] = MPI_DISTRIBUTE_CYCLIC;
+    dargs[0] = MPI_DISTRIBUTE_DFLT_DARG;
+    dargs[1] = 2;
+    psizes[0] = psizes[1] = 2;
+    shapes[n].name = "darray_2d";
+    MPI_Type_create_darray(4, 0, 2, gsizes, distribs, dargs, psizes, MPI_ORDER_C, MPI_DOUBLE,
+                           &shapes[n].type);
+    shapes[n++].count = 1;
+
+    /* every other double */
+    shapes[n].name = "resized";
+    MPI_Type_create_resized(MPI_DOUBLE, 0, 2 * sizeof(double), &shapes[n].type);
+    shapes[n++].count = nd;
+
+    for (i = 0; i < n; i++) {
+        MPI_Type_commit(&shapes[i].type);
+    }
+    return n;
+}
+
+static int run_shape(shape_t *shape, const char *memory, int iterations, FILE *out,
+                     result_t *result)
+{
+    MPI_Aint lb, extent, true_lb, true_extent;
+    size_t size, span;
+    void *array = NULL, *packed = NULL;
+    int type_size;
+
+    MPI_Type_size(shape->type, &type_size);
+    MPI_Type_get_extent(shape->type, &lb, &extent);
+    MPI_Type_get_true_extent(shape->type, &true_lb, &true_extent);
+    size = (size_t) type_size * shape->count;
+    span = (size_t) true_lb + (size_t) (shape->count - 1) * extent + true_extent;
+
+    if (0 == strcmp(memory, "host")) {
+        array = calloc(1, span);
+        packed = malloc(size);
+    }
+#if OPAL_CUDA_SUPPORT
+    else if (0 != mca_common_cuda_malloc(&array, span) || 0 != mca_common_cuda_malloc(&packed, size)) {
+        mca_common_cuda_free(array);
+        return -1;
+    }
+#endif /* OPAL_CUDA_SUPPORT */
+    if (NULL == array || NULL == packed) {
+        free(array);
+        free(packed);
+        return -1;
+    }
+
+    snprintf(result->shape, sizeof(result->shape), "%s", shape->name);
+    snprintf(result->memory, sizeof(result->memory), "%s", memory);
+    result->pack = bench(shape->type, shape->count, array, packed, size, iterations, 0);
+    result->unpack = bench(shape->type, shape->count, array, packed, size, iterations, 1);
+    fprintf(out, "%s,%s,%zu,%.3f,%.3f\n", result->shape, result->memory, size, result->pack,
+            result->unpack);
+    fflush(out);
+
+    if (0 == strcmp(memory, "host")) {
+        free(array);
+        free(packed);
+    }
+#if OPAL_CUDA_SUPPORT
+    else {
+        mca_common_cuda_free(array);
+        mca_common_cuda_free(packed);
+    }
+#endif /* OPAL_CUDA_SUPPORT */
+    return 0;
+}
+
+/* the regressions against a previous output */
+static int compare(const char *fname, const result_t *results, int nresults, double tolerance)
+{
+    char line[256], shape[64], memory[8];
+    int i, regressions = 0;
+    double pack, unpack;
+    size_t size;
+    FILE *f;
+
+    if (NULL == (f = fopen(fname, "r"))) {
+        fprintf(stderr, "ddt_bench: cannot open the baseline %s\n", fname);
+        return 1;
+    }
+    while (NULL != fgets(line, sizeof(line), f)) {
+        if (5 != sscanf(line, "%63[^,],%7[^,],%zu,%lf,%lf", shape, memory, &size, &pack, &unpack)) {
+            continue; /* the header */
+        }
+        for (i = 0; i < nresults; i++) {
+            if (0 != strcmp(shape, results[i].shape) || 0 != strcmp(memory, results[i].memory)) {
+                continue;
+            }
+            if (results[i].pack < pack * (1.0 - tolerance / 100.0)) {
+                fprintf(stderr, "ddt_bench: %s %s pack regressed from %.3f to %.3f GB/s\n", shape,
+                        memory, pack, results[i].pack);
+                regressions++;
+            }
+            if (results[i].unpack < unpack * (1.0 - tolerance / 100.0)) {
+                fprintf(stderr, "ddt_bench: %s %s unpack regressed from %.3f to %.3f GB/s\n",
+                        shape, memory, unpack, results[i].unpack);
+                regressions++;
+            }
+        }
+    }
+    fclose(f);
+    return regressions ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *baseline = NULL, *output = NULL, *memories[] = {"host", "gpu"};
+    int iterations = 20, nshapes, nresults = 0, nmemories = 1, opt, i, m, rc = 0;
+    size_t target = 8 * 1024 * 1024;
+    result_t results[2 * MAX_SHAPES];
+    shape_t shapes[MAX_SHAPES];
+    double tolerance = 10.0;
+    FILE *out = stdout;
+
+    MPI_Init(&argc, &argv);
+
+    while (-1 != (opt = getopt(argc, argv, "s:i:o:b:t:"))) {
+        switch (opt) {
+        case 's':
+            target = strtoul(optarg, NULL, 0);
+            break;
+        case 'i':
+            iterations = atoi(optarg);
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        case 'b':
+            baseline = optarg;
+            break;
+        case 't':
+            tolerance = atof(optarg);
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-s bytes] [-i iterations] [-o results.csv] "
+                            "[-b baseline.csv [-t percent]]\n", argv[0]);
+            MPI_Finalize();
+            return 1;
+        }
+    }
+    if (target < 4096 || iterations < 1) {
+        fprintf(stderr, "ddt_bench: at least 4096 bytes and one iteration\n");
+        MPI_Finalize();
+        return 1;
+    }
+    if (NULL != output && NULL == (out = fopen(output, "w"))) {
+        fprintf(stderr, "ddt_bench: cannot open %s\n", output);
+        MPI_Finalize();
+        return 1;
+    }
+#if OPAL_CUDA_SUPPORT
+    if (mca_common_cuda_enabled) {
+        nmemories = 2;
+    }
+#endif /* OPAL_CUDA_SUPPORT */
+
+    nshapes = build_shapes(shapes, target);
+    fprintf(out, "shape,memory,bytes,pack_GBps,unpack_GBps\n");
+    for (m = 0; m < nmemories; m++) {
+        for (i = 0; i < nshapes; i++) {
+            if (0 == run_shape(&shapes[i], memories[m], iterations, out, &results[nresults])) {
+                nresults++;
+            }
+        }
+    }
+    if (stdout != out) {
+        fclose(out);
+    }
+    for (i = 0; i < nshapes; i++) {
+        MPI_Type_free(&shapes[i].type);
+    }
+
+    if (NULL != baseline) {
+        rc = compare(baseline, results, nresults, tolerance);
+    }
+
+    MPI_Finalize();
+    return rc;
+}
@@ -0,0 +1,186 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * Exercise the strided pack/unpack kernels selected at commit time for
+ * vector, subarray and darray shapes. Every element of the user buffer holds its own
+ * index, so the packed stream can be checked against the indices expected
+ * from the shape, whatever the fragment sizes used to produce it.
+ */
+
+#include "ompi_config.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "opal/datatype/opal_convertor.h"
+#include "opal/runtime/opal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COUNT 3
+
+static int check_type(const char *name, ompi_datatype_t *type, const int *expected,
+                      int nexpected, int nelems)
+{
+    opal_convertor_t *convertor;
+    struct iovec iov;
+    uint32_t iov_count;
+    size_t max_data, size, length, total, chunk;
+    ptrdiff_t extent, lb;
+    int *array, *packed, i, errors = 0;
+
+    opal_datatype_commit(&type->super);
+    opal_datatype_type_size(&type->super, &size);
+    opal_datatype_get_extent(&type->super, &lb, &extent);
+    total = size * COUNT;
+
+    array = (int *) malloc(extent * COUNT);
+    packed = (int *) malloc(total);
+    for (i = 0; i < nelems * COUNT; i++) {
+        array[i] = i;
+    }
+
+    for (chunk = 1; chunk <= total; chunk = chunk * 3 + 1) {
+        memset(packed, 0xff, total);
+        convertor = opal_convertor_create(opal_local_arch, 0);
+        opal_convertor_prepare_for_send(convertor, &type->super, COUNT, array);
+        for (length = 0; length < total; length += max_data) {
+            iov.iov_base = (char *) packed + length;
+            iov.iov_len = chunk;
+            max_data = iov.iov_len;
+            iov_count = 1;
+            opal_convertor_pack(convertor, &iov, &iov_count, &max_data);
+        }
+        OBJ_RELEASE(convertor);
+        for (i = 0; i < (int) (total / sizeof(int)); i++) {
+            int want = expected[i % nexpected] + (i / nexpected) * (int) (extent / sizeof(int));
+            if (packed[i] != want) {
+                fprintf(stderr, "%s: pack chunk %" PRIsize_t " element %d found %d expected %d\n",
+                        name, chunk, i, packed[i], want);
+                errors++;
+                break;
+            }
+        }
+
+        memset(array, 0xff, extent * COUNT);
+        convertor = opal_convertor_create(opal_local_arch, 0);
+        opal_convertor_prepare_for_recv(convertor, &type->super, COUNT, array);
+        for (length = 0; length < total; length += max_data) {
+            iov.iov_base = (char *) packed + length;
+            iov.iov_len = chunk;
+            max_data = iov.iov_len;
+            iov_count = 1;
+            opal_convertor_unpack(convertor, &iov, &iov_count, &max_data);
+        }
+        OBJ_RELEASE(convertor);
+        for (i = 0; i < (int) (total / sizeof(int)); i++) {
+            int want = expected[i % nexpected] + (i / nexpected) * (int) (extent / sizeof(int));
+            if (array[want] != want) {
+                fprintf(stderr, "%s: unpack chunk %" PRIsize_t " element %d found %d expected %d\n",
+                        name, chunk, want, array[want], want);
+                errors++;
+                break;
+            }
+        }
+        /* restore the source for the next fragment size */
+        for (i = 0; i < nelems * COUNT; i++) {
+            array[i] = i;
+        }
+    }
+
+    printf("%s: %s (strided %s)\n", name, errors ? "FAILED" : "ok",
+           type->super.strided.ndims ? "yes" : "no");
+    free(array);
+    free(packed);
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    ompi_datatype_t *type;
+    int sizes[3] = {5, 7, 9}, subsizes[3] = {3, 4, 5}, starts[3] = {1, 2, 3};
+    int sizes4[4] = {3, 4, 5, 6}, subsizes4[4] = {2, 2, 3, 4}, starts4[4] = {1, 1, 2, 1};
+    int gsizes[2] = {8, 12}, distribs[2] = {MPI_DISTRIBUTE_CYCLIC, MPI_DISTRIBUTE_CYCLIC};
+    int dargs[2] = {2, 3}, psizes[2] = {2, 2};
+    int expected[3 * 4 * 5], n, i, j, k, l, errors = 0;
+
+    opal_init_util(NULL, NULL);
+    ompi_datatype_init();
+
+    /* vector of 6 blocks of 3 ints with a stride of 5 ints */
+    ompi_datatype_create_vector(6, 3, 5, &ompi_mpi_int.dt, &type);
+    for (n = 0, i = 0; i < 6; i++) {
+        for (j = 0; j < 3; j++) {
+            expected[n++] = i * 5 + j;
+        }
+    }
+    errors += check_type("vector", type, expected, n, 6 * 5 - 2);
+    OBJ_RELEASE(type);
+
+    /* 2D subarray, C order */
+    ompi_datatype_create_subarray(2, sizes, subsizes, starts, MPI_ORDER_C, &ompi_mpi_int.dt, &type);
+    for (n = 0, i = 0; i < subsizes[0]; i++) {
+        for (j = 0; j < subsizes[1]; j++) {
+            expected[n++] = (starts[0] + i) * sizes[1] + starts[1] + j;
+        }
+    }
+    errors += check_type("subarray2d", type, expected, n, sizes[0] * sizes[1]);
+    OBJ_RELEASE(type);
+
+    /* 3D subarray, C order */
+    ompi_datatype_create_subarray(3, sizes, subsizes, starts, MPI_ORDER_C, &ompi_mpi_int.dt, &type);
+    for (n = 0, i = 0; i < subsizes[0]; i++) {
+        for (j = 0; j < subsizes[1]; j++) {
+            for (k = 0; k < subsizes[2]; k++) {
+                expected[n++] = ((starts[0] + i) * sizes[1] + starts[1] + j) * sizes[2] + starts[2]
+                                + k;
+            }
+        }
+    }
+    errors += check_type("subarray3d", type, expected, n, sizes[0] * sizes[1] * sizes[2]);
+    OBJ_RELEASE(type);
+
+    /* 4D subarray, Fortran order */
+    ompi_datatype_create_subarray(4, sizes4, subsizes4, starts4, MPI_ORDER_FORTRAN,
+                                  &ompi_mpi_int.dt, &type);
+    for (n = 0, l = 0; l < subsizes4[3]; l++) {
+        for (k = 0; k < subsizes4[2]; k++) {
+            for (j = 0; j < subsizes4[1]; j++) {
+                for (i = 0; i < subsizes4[0]; i++) {
+                    expected[n++] = (((starts4[3] + l) * sizes4[2] + starts4[2] + k) * sizes4[1]
+                                     + starts4[1] + j) * sizes4[0] + starts4[0] + i;
+                }
+            }
+        }
+    }
+    errors += check_type("subarray4d", type, expected, n,
+                         sizes4[0] * sizes4[1] * sizes4[2] * sizes4[3]);
+    OBJ_RELEASE(type);
+
+    /* 2D block-cyclic darray, C order, last process of a 2x2 grid */
+    ompi_datatype_create_darray(4, 3, 2, gsizes, distribs, dargs, psizes, MPI_ORDER_C,
+                                &ompi_mpi_int.dt, &type);
+    for (n = 0, i = 0; i < gsizes[0]; i++) {
+        for (j = 0; j < gsizes[1]; j++) {
+            if ((1 == (i / dargs[0]) % psizes[0]) && (1 == (j / dargs[1]) % psizes[1])) {
+                expected[n++] = i * gsizes[1] + j;
+            }
+        }
+    }
+    errors += check_type("darray2d", type, expected, n, gsizes[0] * gsizes[1]);
+    OBJ_RELEASE(type);
+
+    ompi_datatype_finalize();
+    opal_finalize_util();
+
+    return errors ? 1 : 0;
+}
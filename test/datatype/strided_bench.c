@@ -0,0 +1,130 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * Compare the pack and unpack bandwidth of small-block vectors of doubles
+ * through the generic engine, the scalar strided kernels and the vector
+ * gathers/scatters of the strided kernels (when the library is compiled for
+ * AVX2/AVX-512). The path is selected by overriding the strided shape that
+ * opal_datatype_commit computed.
+ *
+ *   strided_bench [count [stride [iterations]]]
+ */
+
+#include "ompi_config.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "opal/datatype/opal_convertor.h"
+#include "opal/runtime/opal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_SYS_TIME_H
+#    include <sys/time.h>
+#endif
+
+#define TIMER_DATA_TYPE struct timeval
+#define GET_TIME(TV)    gettimeofday(&(TV), NULL)
+#define ELAPSED_TIME(TSTART, TEND) \
+    (((TEND).tv_sec - (TSTART).tv_sec) * 1000000 + ((TEND).tv_usec - (TSTART).tv_usec))
+
+static const char *path_names[] = {"generic", "strided", "gather"};
+
+static long bench(ompi_datatype_t *type, int count, void *array, void *packed, size_t size,
+                  int iterations, int unpack)
+{
+    TIMER_DATA_TYPE start, end;
+    opal_convertor_t *convertor;
+    struct iovec iov;
+    uint32_t iov_count;
+    size_t max_data;
+    int i;
+
+    convertor = opal_convertor_create(opal_local_arch, 0);
+    GET_TIME(start);
+    for (i = 0; i < iterations; i++) {
+        iov.iov_base = packed;
+        iov.iov_len = size;
+        max_data = size;
+        iov_count = 1;
+        if (unpack) {
+            opal_convertor_prepare_for_recv(convertor, &type->super, count, array);
+            opal_convertor_unpack(convertor, &iov, &iov_count, &max_data);
+        } else {
+            opal_convertor_prepare_for_send(convertor, &type->super, count, array);
+            opal_convertor_pack(convertor, &iov, &iov_count, &max_data);
+        }
+    }
+    GET_TIME(end);
+    OBJ_RELEASE(convertor);
+    return ELAPSED_TIME(start, end);
+}
+
+int main(int argc, char *argv[])
+{
+    int count = 1 << 16, stride = 8, iterations = 100, blen, path;
+    opal_datatype_strided_t shape;
+    ompi_datatype_t *type;
+    ptrdiff_t extent, lb;
+    void *array, *packed;
+    size_t size;
+    long pack_us, unpack_us;
+
+    if (argc > 1) {
+        count = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        stride = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        iterations = atoi(argv[3]);
+    }
+
+    opal_init_util(NULL, NULL);
+    ompi_datatype_init();
+
+    printf("%8s %8s %8s %12s %12s\n", "blen", "stride", "path", "pack MB/s", "unpack MB/s");
+    for (blen = 1; blen <= 4 && blen < stride; blen++) {
+        ompi_datatype_create_vector(count, blen, stride, &ompi_mpi_double.dt, &type);
+        opal_datatype_commit(&type->super);
+        opal_datatype_type_size(&type->super, &size);
+        opal_datatype_get_extent(&type->super, &lb, &extent);
+        array = calloc(1, extent);
+        packed = malloc(size);
+        shape = type->super.strided;
+
+        for (path = 0; path < 3; path++) {
+            type->super.strided = shape;
+            if (0 == path) {
+                type->super.strided.ndims = 0;
+            } else if (1 == path) {
+                type->super.strided.gather = 0;
+            } else if (!shape.gather) {
+                continue;
+            }
+            pack_us = bench(type, 1, array, packed, size, iterations, 0);
+            unpack_us = bench(type, 1, array, packed, size, iterations, 1);
+            printf("%8d %8d %8s %12.1f %12.1f\n", blen, stride, path_names[path],
+                   (double) size * iterations / (pack_us ? pack_us : 1),
+                   (double) size * iterations / (unpack_us ? unpack_us : 1));
+        }
+        type->super.strided = shape;
+        free(array);
+        free(packed);
+        OBJ_RELEASE(type);
+    }
+
+    ompi_datatype_finalize();
+    opal_finalize_util();
+
+    return 0;
+}